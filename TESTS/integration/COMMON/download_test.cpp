@@ -28,6 +28,7 @@
 #include "greentea-client/test_env.h"
 #include <string>
 #include "download_test.h"
+#include "perf_metrics.h"
 
 #define MAX_THREADS 5
 
@@ -210,6 +211,56 @@ size_t download_test(NetworkInterface *interface, const unsigned char *data, siz
             f_received_bytes / (timer.read() * 1024.),
             timer.read());
 
+    char name[32];
+    if (thread_id == 0) {
+        snprintf(name, sizeof(name), "net_tcp_kbps_%u", buff_size);
+    } else {
+        snprintf(name, sizeof(name), "net_tcp_kbps_%u_t%" PRIu32, buff_size, thread_id);
+    }
+    perf_report(name, perf_kbps(received_bytes, timer.elapsed_time().count()), PERF_HIGHER_IS_BETTER);
+
     return received_bytes;
 }
+
+void request_latency_test(NetworkInterface *interface, size_t iterations)
+{
+    TEST_ASSERT_MESSAGE(iterations <= MAX_LATENCY_SAMPLES, "too many iterations");
+
+    static uint32_t connect_us[MAX_LATENCY_SAMPLES];
+    static uint32_t request_us[MAX_LATENCY_SAMPLES];
+
+    SocketAddress tcp_addr;
+    nsapi_error_t err = interface->gethostbyname(dl_host, &tcp_addr);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(NSAPI_ERROR_OK, err, "failed to resolve host");
+    tcp_addr.set_port(80);
+
+    char *request = g_request_buffer[0];
+    size_t req_len = snprintf(request, REQ_BUF_SIZE - 1, req_template, dl_path, dl_host);
+
+    for (size_t i = 0; i < iterations; i++) {
+        TCPSocket tcpsocket;
+        err = tcpsocket.open(interface);
+        TEST_ASSERT_EQUAL_INT_MESSAGE(NSAPI_ERROR_OK, err, "unable to open socket");
+        tcpsocket.set_timeout(10000);
+
+        Timer timer;
+        timer.start();
+        err = tcpsocket.connect(tcp_addr);
+        TEST_ASSERT_EQUAL_INT_MESSAGE(NSAPI_ERROR_OK, err, "failed to connect");
+        connect_us[i] = timer.elapsed_time().count();
+
+        // From the request to the first byte of the response
+        timer.reset();
+        nsapi_size_or_error_t result = tcpsocket.send(request, req_len);
+        TEST_ASSERT_EQUAL_INT_MESSAGE(req_len, result, "failed to send");
+        result = tcpsocket.recv(g_receive_buffer, RECV_BUF_SIZE);
+        TEST_ASSERT_MESSAGE(result > 0, "failed to read socket");
+        request_us[i] = timer.elapsed_time().count();
+
+        tcpsocket.close();
+    }
+
+    perf_report_latency("net_tcp_connect", connect_us, iterations);
+    perf_report_latency("net_tcp_request", request_us, iterations);
+}
 #endif // INTEGRATION_TESTS
@@ -26,3 +26,10 @@
 #define TRACE_GROUP "GRNT"
 size_t download_test(NetworkInterface *interface, const unsigned char *data, size_t data_length, size_t buff_size, uint32_t thread_id = 0);
 
+#define MAX_LATENCY_SAMPLES 100
+
+/* Connect and request the file iterations times, and report the latency
+ * percentiles of the connection and of the first byte of the response
+ */
+void request_latency_test(NetworkInterface *interface, size_t iterations);
+
@@ -25,8 +25,27 @@
 #include "mbed.h"
 #include "unity/unity.h"
 #include "file_test.h"
+#include "perf_metrics.h"
 
-void file_test_write(const char *file, size_t offset, const unsigned char *data, size_t data_length, size_t block_size)
+static void report_throughput(const char *operation, size_t block_size, uint32_t thread_id, size_t length, Timer &timer)
+{
+    char name[32];
+    if (thread_id == 0) {
+        snprintf(name, sizeof(name), "fs_%s_kbps_%u", operation, block_size);
+    } else {
+        snprintf(name, sizeof(name), "fs_%s_kbps_%u_t%" PRIu32, operation, block_size, thread_id);
+    }
+    perf_report(name, perf_kbps(length, timer.elapsed_time().count()), PERF_HIGHER_IS_BETTER);
+}
+
+// Same sequence of offsets on every run, for comparable results
+static size_t next_block(uint32_t *state, size_t blocks)
+{
+    *state = *state * 1664525 + 1013904223;
+    return (*state >> 8) % blocks;
+}
+
+void file_test_write(const char *file, size_t offset, const unsigned char *data, size_t data_length, size_t block_size, uint32_t thread_id)
 {
     char filename[255] = { 0 };
     snprintf(filename, 255, "/sd/%s", file);
@@ -61,9 +80,10 @@ void file_test_write(const char *file, size_t offset, const unsigned char *data,
     timer.stop();
     tr_info("[FS] Wrote: \"%s\" %.2fKB (%.2fKB/s, %.2f secs)", file,
             float(data_length) / 1024, float(data_length) / timer.read() / 1024, timer.read());
+    report_throughput("write", block_size, thread_id, data_length, timer);
 }
 
-void file_test_read(const char *file, size_t offset, const unsigned char *data, size_t data_length, size_t block_size)
+void file_test_read(const char *file, size_t offset, const unsigned char *data, size_t data_length, size_t block_size, uint32_t thread_id)
 {
     char filename[255] = { 0 };
     snprintf(filename, 255, "/sd/%s", file);
@@ -99,10 +119,82 @@ void file_test_read(const char *file, size_t offset, const unsigned char *data,
     result = fclose(output);
     TEST_ASSERT_EQUAL_INT_MESSAGE(0, result, "could not close file");
 
+    timer.stop();
     free(buffer);
 
     tr_info("[FS] Read : \"%s\" %.2fKB (%.2fKB/s, %.2f secs)", file,
             float(data_length) / 1024, float(data_length) / timer.read() / 1024, timer.read());
+    report_throughput("read", block_size, thread_id, data_length, timer);
+}
+
+void file_test_random_write(const char *file, const unsigned char *data, size_t data_length, size_t block_size, size_t count)
+{
+    char filename[255] = { 0 };
+    snprintf(filename, 255, "/sd/%s", file);
+
+    size_t blocks = data_length / block_size;
+    TEST_ASSERT_MESSAGE(blocks > 0, "file smaller than a block");
+
+    FILE *output = fopen(filename, "r+");
+    TEST_ASSERT_NOT_NULL_MESSAGE(output, "could not open file");
+
+    Timer timer;
+    timer.start();
+
+    uint32_t state = 1;
+    for (size_t i = 0; i < count; i++) {
+        size_t offset = next_block(&state, blocks) * block_size;
+
+        int result = fseek(output, offset, SEEK_SET);
+        TEST_ASSERT_EQUAL_INT_MESSAGE(0, result, "could not seek to location");
+
+        size_t written = fwrite(&data[offset], sizeof(unsigned char), block_size, output);
+        TEST_ASSERT_EQUAL_UINT_MESSAGE(block_size, written, "failed to write");
+    }
+
+    int result = fclose(output);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(0, result, "could not close file");
+
+    timer.stop();
+    report_throughput("random_write", block_size, 0, count * block_size, timer);
+}
+
+void file_test_random_read(const char *file, const unsigned char *data, size_t data_length, size_t block_size, size_t count)
+{
+    char filename[255] = { 0 };
+    snprintf(filename, 255, "/sd/%s", file);
+
+    size_t blocks = data_length / block_size;
+    TEST_ASSERT_MESSAGE(blocks > 0, "file smaller than a block");
+
+    FILE *output = fopen(filename, "r");
+    TEST_ASSERT_NOT_NULL_MESSAGE(output, "could not open file");
+
+    char *buffer = (char *) malloc(block_size);
+    TEST_ASSERT_NOT_NULL_MESSAGE(buffer, "could not allocate buffer");
+
+    Timer timer;
+    timer.start();
+
+    uint32_t state = 2;
+    for (size_t i = 0; i < count; i++) {
+        size_t offset = next_block(&state, blocks) * block_size;
+
+        int result = fseek(output, offset, SEEK_SET);
+        TEST_ASSERT_EQUAL_INT_MESSAGE(0, result, "could not seek to location");
+
+        size_t read = fread(buffer, sizeof(char), block_size, output);
+        TEST_ASSERT_EQUAL_MESSAGE(read, block_size, "failed to read");
+        TEST_ASSERT_EQUAL_STRING_LEN_MESSAGE(buffer, &data[offset], block_size, "character mismatch");
+    }
+
+    int result = fclose(output);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(0, result, "could not close file");
+
+    timer.stop();
+    free(buffer);
+
+    report_throughput("random_read", block_size, 0, count * block_size, timer);
 }
 
 #endif //#if INTEGRATION_TESTS
@@ -24,6 +24,13 @@
 
 #define TRACE_GROUP "GRNT"
 
-void file_test_write(const char *file, size_t offset, const unsigned char *data, size_t data_length, size_t block_size);
+void file_test_write(const char *file, size_t offset, const unsigned char *data, size_t data_length, size_t block_size, uint32_t thread_id = 0);
 
-void file_test_read(const char *file, size_t offset, const unsigned char *data, size_t data_length, size_t block_size);
+void file_test_read(const char *file, size_t offset, const unsigned char *data, size_t data_length, size_t block_size, uint32_t thread_id = 0);
+
+/* Rewrite, then read back, count blocks at pseudo-random block aligned offsets
+ * of a file written by file_test_write, keeping its contents
+ */
+void file_test_random_write(const char *file, const unsigned char *data, size_t data_length, size_t block_size, size_t count);
+
+void file_test_random_read(const char *file, const unsigned char *data, size_t data_length, size_t block_size, size_t count);
@@ -0,0 +1,111 @@
+/*
+ * mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#if INTEGRATION_TESTS && MBED_CONF_RTOS_PRESENT
+
+#include "mbed.h"
+#include "mbed_trace.h"
+#include "unity/unity.h"
+#include "greentea-client/test_env.h"
+#include <algorithm>
+#include "perf_metrics.h"
+
+#define TRACE_GROUP "PERF"
+
+#ifndef MBED_CONF_APP_PERF_BASELINES
+#define MBED_CONF_APP_PERF_BASELINES ""
+#endif
+
+#ifndef MBED_CONF_APP_PERF_TOLERANCE
+#define MBED_CONF_APP_PERF_TOLERANCE 20
+#endif
+
+#define KEY_SIZE 64
+
+// Serializes the key-value pairs of the threaded tests
+static SingletonPtr<PlatformMutex> perf_mutex;
+
+static bool find_baseline(const char *name, uint32_t *baseline)
+{
+    size_t name_length = strlen(name);
+    const char *entry = MBED_CONF_APP_PERF_BASELINES;
+    while (*entry) {
+        if (strncmp(entry, name, name_length) == 0 && entry[name_length] == '=') {
+            *baseline = strtoul(&entry[name_length + 1], nullptr, 10);
+            return true;
+        }
+        entry = strchr(entry, ',');
+        if (!entry) {
+            break;
+        }
+        entry++;
+    }
+    return false;
+}
+
+void perf_report(const char *name, uint32_t value, perf_direction_t direction)
+{
+    char key[KEY_SIZE];
+    snprintf(key, sizeof(key), "perf_%s", name);
+
+    perf_mutex->lock();
+    greentea_send_kv(key, value);
+    perf_mutex->unlock();
+
+    uint32_t baseline;
+    if (!find_baseline(name, &baseline)) {
+        tr_info("[PERF] %s: %" PRIu32, name, value);
+        return;
+    }
+
+    tr_info("[PERF] %s: %" PRIu32 " (baseline %" PRIu32 ")", name, value, baseline);
+    if (direction == PERF_HIGHER_IS_BETTER) {
+        uint64_t limit = uint64_t(baseline) * (100 - MBED_CONF_APP_PERF_TOLERANCE) / 100;
+        TEST_ASSERT_MESSAGE(value >= limit, "performance below baseline");
+    } else {
+        uint64_t limit = uint64_t(baseline) * (100 + MBED_CONF_APP_PERF_TOLERANCE) / 100;
+        TEST_ASSERT_MESSAGE(value <= limit, "performance below baseline");
+    }
+}
+
+void perf_report_latency(const char *name, uint32_t *samples_us, size_t count)
+{
+    static const uint32_t percentiles[] = { 50, 90, 99 };
+
+    TEST_ASSERT_MESSAGE(count > 0, "no latency samples");
+    std::sort(samples_us, samples_us + count);
+
+    char key[KEY_SIZE];
+    for (uint32_t percentile : percentiles) {
+        // Nearest rank
+        size_t rank = (percentile * count + 99) / 100;
+        snprintf(key, sizeof(key), "%s_p%" PRIu32 "_us", name, percentile);
+        perf_report(key, samples_us[rank - 1], PERF_LOWER_IS_BETTER);
+    }
+}
+
+uint32_t perf_kbps(size_t length, uint64_t elapsed_us)
+{
+    if (elapsed_us == 0) {
+        elapsed_us = 1;
+    }
+    return uint32_t(uint64_t(length) * 1000000 / 1024 / elapsed_us);
+}
+
+#endif // INTEGRATION_TESTS && MBED_CONF_RTOS_PRESENT
@@ -0,0 +1,47 @@
+/*
+ * mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Performance metrics of the integration tests.
+ *
+ * Each metric is sent to the host as a greentea key-value pair, with the key
+ * prefixed by "perf_", and checked against the target's baseline. Baselines
+ * are set in the "perf-baselines" config of target_extended.json, as a list
+ * of "<name>=<value>" separated by commas, for example
+ * "net_tcp_kbps_1024=300,fs_write_kbps_4096=120". A metric more than
+ * "perf-tolerance" percent worse than its baseline fails the test, and a
+ * metric without a baseline is only reported.
+ */
+#include <stddef.h>
+#include <stdint.h>
+
+enum perf_direction_t {
+    PERF_HIGHER_IS_BETTER,  // throughput
+    PERF_LOWER_IS_BETTER    // latency
+};
+
+void perf_report(const char *name, uint32_t value, perf_direction_t direction);
+
+/* Report the 50th, 90th and 99th percentiles of samples in microseconds,
+ * as "<name>_p50_us" and so on. The samples are sorted in place.
+ */
+void perf_report_latency(const char *name, uint32_t *samples_us, size_t count);
+
+/* Throughput in KiB/s of a transfer of length bytes in elapsed_us */
+uint32_t perf_kbps(size_t length, uint64_t elapsed_us);
@@ -132,6 +132,25 @@ static control_t test_block_size_16k(const size_t call_count)
     return CaseNext;
 }
 
+#define RANDOM_IO_COUNT 64
+
+static control_t test_random_256(const size_t call_count)
+{
+    file_test_write("mbed-file-test-0.txt", 0, story, sizeof(story), 256);
+    file_test_random_write("mbed-file-test-0.txt", story, sizeof(story), 256, RANDOM_IO_COUNT);
+    file_test_random_read("mbed-file-test-0.txt", story, sizeof(story), 256, RANDOM_IO_COUNT);
+
+    return CaseNext;
+}
+static control_t test_random_4k(const size_t call_count)
+{
+    file_test_write("mbed-file-test-0.txt", 0, story, sizeof(story), 4 * 1024);
+    file_test_random_write("mbed-file-test-0.txt", story, sizeof(story), 4 * 1024, RANDOM_IO_COUNT);
+    file_test_random_read("mbed-file-test-0.txt", story, sizeof(story), 4 * 1024, RANDOM_IO_COUNT);
+
+    return CaseNext;
+}
+
 utest::v1::status_t greentea_setup(const size_t number_of_cases)
 {
     GREENTEA_SETUP(5 * 60, "default_auto");
@@ -148,6 +167,8 @@ Case cases[] = {
     Case(TEST_BLOCK_DEVICE_TYPE "+" TEST_FILESYSTEM_TYPE " 1 file, buff  1024", test_block_size_1k),
     Case(TEST_BLOCK_DEVICE_TYPE "+" TEST_FILESYSTEM_TYPE " 1 file, buff  4096", test_block_size_4k),
     Case(TEST_BLOCK_DEVICE_TYPE "+" TEST_FILESYSTEM_TYPE " 1 file, buff 16384", test_block_size_16k),
+    Case(TEST_BLOCK_DEVICE_TYPE "+" TEST_FILESYSTEM_TYPE " 1 file, random  256", test_random_256),
+    Case(TEST_BLOCK_DEVICE_TYPE "+" TEST_FILESYSTEM_TYPE " 1 file, random 4096", test_random_4k),
 };
 
 Specification specification(greentea_setup, cases);
@@ -81,8 +81,8 @@ void file_fn(size_t *block_size)
     uint32_t thread_id = core_util_atomic_incr_u32(&thread_counter, 1);
     char filename[255] = { 0 };
     snprintf(filename, 255, "%s%" PRIu32 "%s", fname_prefix, thread_id, fname_postfix);
-    file_test_write(filename, 0, story, sizeof(story), *block_size);
-    file_test_read(filename, 0, story, sizeof(story), *block_size);
+    file_test_write(filename, 0, story, sizeof(story), *block_size, thread_id);
+    file_test_read(filename, 0, story, sizeof(story), *block_size, thread_id);
     print_memory_info();
 }
 
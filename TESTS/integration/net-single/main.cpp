@@ -110,6 +110,13 @@ static control_t download_4k(const size_t call_count)
     return CaseNext;
 }
 
+static control_t request_latency(const size_t call_count)
+{
+    request_latency_test(interface, 20);
+
+    return CaseNext;
+}
+
 utest::v1::status_t greentea_setup(const size_t number_of_cases)
 {
     GREENTEA_SETUP(8 * 60, "default_auto");
@@ -124,6 +131,7 @@ Case cases[] = {
     Case(TEST_NETWORK_TYPE "  1024 buffer", download_1k),
     Case(TEST_NETWORK_TYPE "  4096 buffer", download_4k),
 #endif
+    Case(TEST_NETWORK_TYPE " request latency", request_latency),
 };
 
 Specification specification(greentea_setup, cases);
@@ -113,8 +113,8 @@ void file_fn(size_t buffer)
     uint32_t thread_id = core_util_atomic_incr_u32(&thread_counter, 1);
     char filename[255] = { 0 };
     snprintf(filename, 255, "mbed-file-test-%" PRIu32 ".txt", thread_id);
-    file_test_write(filename, 0, story, sizeof(story), buffer);
-    file_test_read(filename, 0, story, sizeof(story), buffer);
+    file_test_write(filename, 0, story, sizeof(story), buffer, thread_id);
+    file_test_read(filename, 0, story, sizeof(story), buffer, thread_id);
 }
 void file_1b_fn()
 {
@@ -93,7 +93,8 @@ ATHandler::ATHandler(FileHandle *fh, EventQueue &queue, mbed::chrono::millisecon
     _queue(queue),
     _ref_count(1),
     _oob_string_max_length(0),
-    _oobs(NULL),
+    _oobs(),
+    _urc_stats(),
     _max_resp_length(MAX_RESP_LENGTH)
 {
     ATHandler_stub::process_oob_urc = false;
@@ -112,6 +113,15 @@ bool ATHandler::get_debug() const
     return ATHandler_stub::debug_on;
 }
 
+ATHandler::urc_stats_t ATHandler::get_urc_stats() const
+{
+    return _urc_stats;
+}
+
+void ATHandler::reset_urc_stats()
+{
+}
+
 ATHandler::~ATHandler()
 {
     ATHandler_stub::urc_handlers.clear();
@@ -206,6 +216,11 @@ ssize_t ATHandler::read_bytes(uint8_t *buf, size_t len)
     return ATHandler_stub::ssize_value;
 }
 
+ssize_t ATHandler::read_binary_data(uint8_t *buf, size_t len)
+{
+    return ATHandler_stub::ssize_value;
+}
+
 ssize_t ATHandler::read_string(char *buf, size_t size, bool read_even_stop_tag)
 {
     buf[0] = '\0';
@@ -330,6 +345,14 @@ size_t ATHandler::write_bytes(const uint8_t *param, size_t len)
     return ATHandler_stub::size_value;
 }
 
+size_t ATHandler::write_binary_data(const uint8_t *data, size_t len, const char *prompt)
+{
+    if (ATHandler_stub::return_given_size) {
+        return len;
+    }
+    return ATHandler_stub::size_value;
+}
+
 void ATHandler::cmd_stop()
 {
 }
@@ -369,6 +392,10 @@ void ATHandler::cmd_start_stop(const char *cmd, const char *cmd_chr, const char
 {
 }
 
+void ATHandler::cmd_append(const char *cmd, const char *cmd_chr, const char *format, ...)
+{
+}
+
 nsapi_error_t ATHandler::at_cmd_discard(const char *cmd, const char *cmd_chr,
                                         const char *format, ...)
 {
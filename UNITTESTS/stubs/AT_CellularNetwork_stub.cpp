@@ -30,6 +30,7 @@ using namespace mbed_cellular_util;
 nsapi_error_t AT_CellularNetwork_stub::nsapi_error_value = 0;
 int AT_CellularNetwork_stub::fail_counter = 0;
 int AT_CellularNetwork_stub::set_registration_urc_fail_counter = 0;
+int AT_CellularNetwork_stub::set_registration_urc_call_count = 0;
 int AT_CellularNetwork_stub::get_registration_params_fail_counter = 0;
 
 AT_CellularNetwork::AT_CellularNetwork(ATHandler &atHandler, AT_CellularDevice &device) : _at(atHandler), _device(device)
@@ -46,6 +47,7 @@ void AT_CellularNetwork::attach(Callback<void(nsapi_event_t, intptr_t)> status_c
 
 nsapi_error_t AT_CellularNetwork::set_registration_urc(RegistrationType type, bool urc_on)
 {
+    AT_CellularNetwork_stub::set_registration_urc_call_count++;
     if (AT_CellularNetwork_stub::set_registration_urc_fail_counter) {
         AT_CellularNetwork_stub::set_registration_urc_fail_counter--;
         return NSAPI_ERROR_DEVICE_ERROR;
@@ -75,6 +77,20 @@ nsapi_error_t AT_CellularNetwork::get_registration_params(RegistrationType type,
     return NSAPI_ERROR_OK;
 }
 
+nsapi_error_t AT_CellularNetwork::get_registration_params(const RegistrationType *types, registration_params_t *reg_params, int count)
+{
+    nsapi_error_t err = NSAPI_ERROR_OK;
+    for (int i = 0; i < count; i++) {
+        reg_params[i] = registration_params_t();
+        if (get_registration_params(types[i], reg_params[i]) == NSAPI_ERROR_OK) {
+            reg_params[i]._type = types[i];
+        } else {
+            err = NSAPI_ERROR_DEVICE_ERROR;
+        }
+    }
+    return err;
+}
+
 nsapi_error_t AT_CellularNetwork::get_registration_params(registration_params_t &reg_params)
 {
     return NSAPI_ERROR_OK;
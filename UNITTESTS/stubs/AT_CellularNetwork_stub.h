@@ -23,6 +23,7 @@ namespace AT_CellularNetwork_stub {
 extern nsapi_error_t nsapi_error_value;
 extern int fail_counter;
 extern int set_registration_urc_fail_counter;
+extern int set_registration_urc_call_count;
 extern int get_registration_params_fail_counter;
 }
 
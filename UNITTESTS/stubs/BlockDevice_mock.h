@@ -40,6 +40,9 @@ public:
     MOCK_CONST_METHOD2(is_valid_read, bool(bd_addr_t, bd_size_t));
     MOCK_CONST_METHOD2(is_valid_program, bool(bd_addr_t, bd_size_t));
     MOCK_CONST_METHOD2(is_valid_erase, bool(bd_addr_t, bd_size_t));
+    MOCK_CONST_METHOD2(get_mapped_address, const void *(bd_addr_t, bd_size_t));
+    MOCK_CONST_METHOD2(is_erased, bool(bd_addr_t, bd_size_t));
+    MOCK_CONST_METHOD0(get_capabilities, uint32_t());
     MOCK_CONST_METHOD0(get_type, const char *());
 };
 
@@ -26,7 +26,7 @@ static inline uint32_t align_down(bd_size_t val, bd_size_t size)
     return 0;
 }
 
-BufferedBlockDevice::BufferedBlockDevice(BlockDevice *bd)
+BufferedBlockDevice::BufferedBlockDevice(BlockDevice *bd, uint32_t cache_entries)
 {
 }
 
@@ -99,7 +99,26 @@ int BufferedBlockDevice::get_erase_value() const
     return 0;
 }
 
+const void *BufferedBlockDevice::get_mapped_address(bd_addr_t addr, bd_size_t size) const
+{
+    return NULL;
+}
+
 bd_size_t BufferedBlockDevice::size() const
 {
     return 0;
 }
+
+void BufferedBlockDevice::reset_cache_counts()
+{
+}
+
+bd_size_t BufferedBlockDevice::get_cache_hit_count() const
+{
+    return 0;
+}
+
+bd_size_t BufferedBlockDevice::get_cache_miss_count() const
+{
+    return 0;
+}
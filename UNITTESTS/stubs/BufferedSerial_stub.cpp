@@ -38,6 +38,11 @@ ssize_t BufferedSerial::write(const void *buffer, size_t length)
     return 0;
 }
 
+ssize_t BufferedSerial::writev(const struct iovec *iov, int iovcnt)
+{
+    return 0;
+}
+
 off_t BufferedSerial::seek(off_t offset, int whence)
 {
     return -ESPIPE;
@@ -49,3 +49,11 @@ uint32_t rtos::EventFlags::wait_any(uint32_t flags, uint32_t timeout, bool clear
     }
     return 0;
 }
+uint32_t rtos::EventFlags::wait_any_until(uint32_t flags, Kernel::Clock::time_point abs_time, bool clear)
+{
+    return wait_any(flags, 0, clear);
+}
+uint32_t rtos::EventFlags::wait_any_for(uint32_t flags, Kernel::Clock::duration_u32 rel_time, bool clear)
+{
+    return wait_any(flags, rel_time.count(), clear);
+}
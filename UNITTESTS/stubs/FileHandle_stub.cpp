@@ -24,6 +24,16 @@ off_t FileHandle::size()
     return 0;
 }
 
+ssize_t FileHandle::readv(const struct iovec *iov, int iovcnt)
+{
+    return 0;
+}
+
+ssize_t FileHandle::writev(const struct iovec *iov, int iovcnt)
+{
+    return 0;
+}
+
 std::FILE *fdopen(FileHandle *fh, const char *mode)
 {
     return NULL;
@@ -319,6 +319,11 @@ void LoRaMac::set_tx_ongoing(bool ongoing)
 {
 }
 
+uint8_t LoRaMac::get_max_tx_payload_size()
+{
+    return 0;
+}
+
 void LoRaMac::reset_ongoing_tx(bool reset_pending)
 {
 }
@@ -537,4 +542,17 @@ lorawan_status_t LoRaMac::get_last_rx_beacon(loramac_beacon_t &beacon)
 lorawan_status_t LoRaMac::set_ping_slot_info(uint8_t periodicity)
 {
     return LoRaMac_stub::status_value;
-}
\ No newline at end of file
+}
+void LoRaMac::get_session(loramac_session_t &session, bool is_otaa)
+{
+}
+
+lorawan_status_t LoRaMac::restore_session(const loramac_session_t &session, bool is_otaa)
+{
+    return LoRaMac_stub::status_value;
+}
+
+uint32_t LoRaMac::get_ul_frame_counter() const
+{
+    return 0;
+}
@@ -117,6 +117,13 @@ int16_t LoRaWANStack::handle_tx(const uint8_t port, const uint8_t *data,
     return 0;
 }
 
+int16_t LoRaWANStack::handle_queued_tx(const uint8_t port, const uint8_t *data,
+                                       uint16_t length, uint8_t flags,
+                                       uint8_t priority, bool aggregate)
+{
+    return 0;
+}
+
 int16_t LoRaWANStack::handle_rx(uint8_t *data, uint16_t length, uint8_t &port, int &flags, bool validate_params)
 {
     return 0;
@@ -339,4 +346,13 @@ lorawan_status_t LoRaWANStack::enable_beacon_acquisition()
 lorawan_status_t LoRaWANStack::get_last_rx_beacon(loramac_beacon_t &beacon)
 {
     return LORAWAN_STATUS_NO_BEACON_FOUND;
-}
\ No newline at end of file
+}
+lorawan_status_t LoRaWANStack::set_session_store(mbed::KVStore *store)
+{
+    return LORAWAN_STATUS_OK;
+}
+
+lorawan_status_t LoRaWANStack::remove_stored_session()
+{
+    return LORAWAN_STATUS_OK;
+}
@@ -32,6 +32,11 @@ osStatus rtos::Mutex::lock()
     return osOK;
 }
 
+bool rtos::Mutex::trylock()
+{
+    return true;
+}
+
 osStatus rtos::Mutex::unlock()
 {
     return osOK;
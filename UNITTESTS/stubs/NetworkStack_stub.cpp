@@ -62,6 +62,39 @@ nsapi_error_t NetworkStack::getsockopt(void *handle, int level, int optname, voi
     return NSAPI_ERROR_UNSUPPORTED;
 }
 
+nsapi_size_or_error_t NetworkStack::socket_sendmsg(nsapi_socket_t handle, const SocketAddress *address,
+                                                   mbed::Span<const nsapi_iovec_t> iov)
+{
+    return NSAPI_ERROR_UNSUPPORTED;
+}
+
+nsapi_size_or_error_t NetworkStack::socket_recvmsg(nsapi_socket_t handle, SocketAddress *address,
+                                                   mbed::Span<const nsapi_iovec_t> iov)
+{
+    return NSAPI_ERROR_UNSUPPORTED;
+}
+
+nsapi_size_or_error_t NetworkStack::socket_recvfrom_batch(nsapi_socket_t handle,
+                                                          mbed::Span<nsapi_datagram_t> datagrams)
+{
+    return NSAPI_ERROR_UNSUPPORTED;
+}
+
+NetStackMemoryManager *NetworkStack::get_memory_manager()
+{
+    return NULL;
+}
+
+nsapi_size_or_error_t NetworkStack::socket_send_buf(nsapi_socket_t handle, net_stack_mem_buf_t *buf)
+{
+    return NSAPI_ERROR_UNSUPPORTED;
+}
+
+nsapi_size_or_error_t NetworkStack::socket_recv_buf(nsapi_socket_t handle, net_stack_mem_buf_t **buf)
+{
+    return NSAPI_ERROR_UNSUPPORTED;
+}
+
 // Conversion function for network stacks
 NetworkStack *nsapi_create_stack(nsapi_stack_t *stack)
 {
@@ -100,3 +100,27 @@ bd_size_t ProfilingBlockDevice::get_erase_count() const
 {
     return 0;
 }
+
+void ProfilingBlockDevice::get_op_stats(profile_op op, op_stats *stats) const
+{
+}
+
+uint32_t ProfilingBlockDevice::get_latency_avg(profile_op op) const
+{
+    return 0;
+}
+
+uint32_t ProfilingBlockDevice::get_latency_percentile(profile_op op, uint32_t percent) const
+{
+    return 0;
+}
+
+bd_size_t ProfilingBlockDevice::get_region_size() const
+{
+    return 0;
+}
+
+size_t ProfilingBlockDevice::snapshot(uint8_t *buf, size_t size) const
+{
+    return 0;
+}
@@ -61,4 +61,19 @@ void SocketStats::stats_update_recv_bytes(const Socket *const reference_id, size
 {
     return;
 }
+
+void SocketStats::stats_update_send_blocked_time(const Socket *const reference_id, uint32_t blocked_ms)
+{
+    return;
+}
+
+void SocketStats::stats_update_recv_blocked_time(const Socket *const reference_id, uint32_t blocked_ms)
+{
+    return;
+}
+
+void SocketStats::stats_update_tcp_info(const Socket *const reference_id, const nsapi_tcp_info_t &info)
+{
+    return;
+}
 #endif
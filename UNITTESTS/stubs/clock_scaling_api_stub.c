@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2021 Arm Limited and affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "hal/clock_scaling_api.h"
+
+#if DEVICE_CLOCK_SCALING
+
+static uint8_t _level = 0;
+
+uint8_t clock_scaling_level_count(void)
+{
+    return 3;
+}
+
+uint32_t clock_scaling_frequency(uint8_t level)
+{
+    if (level >= 3) {
+        return 0;
+    }
+    return 80000000 >> level;
+}
+
+uint8_t clock_scaling_get_level(void)
+{
+    return _level;
+}
+
+int clock_scaling_set_level(uint8_t level)
+{
+    if (level >= 3) {
+        return -1;
+    }
+    _level = level;
+    return 0;
+}
+
+#endif // DEVICE_CLOCK_SCALING
@@ -35,7 +35,17 @@ bool core_util_atomic_cas_u16(volatile uint16_t *ptr, uint16_t *expectedCurrentV
 
 bool core_util_atomic_cas_u32(volatile uint32_t *ptr, uint32_t *expectedCurrentValue, uint32_t desiredValue)
 {
-    return false;
+    if (*ptr != *expectedCurrentValue) {
+        *expectedCurrentValue = *ptr;
+        return false;
+    }
+    *ptr = desiredValue;
+    return true;
+}
+
+bool core_util_atomic_compare_exchange_weak_u32(volatile uint32_t *ptr, uint32_t *expectedCurrentValue, uint32_t desiredValue)
+{
+    return core_util_atomic_cas_u32(ptr, expectedCurrentValue, desiredValue);
 }
 
 
@@ -213,12 +223,17 @@ uint64_t core_util_atomic_exchange_u64(volatile uint64_t *valuePtr, uint64_t des
 
 bool core_util_atomic_cas_u64(volatile uint64_t *ptr, uint64_t *expectedCurrentValue, uint64_t desiredValue)
 {
-    return false;
+    if (*ptr != *expectedCurrentValue) {
+        *expectedCurrentValue = *ptr;
+        return false;
+    }
+    *ptr = desiredValue;
+    return true;
 }
 
 bool core_util_atomic_compare_exchange_weak_u64(volatile uint64_t *ptr, uint64_t *expectedCurrentValue, uint64_t desiredValue)
 {
-    return false;
+    return core_util_atomic_cas_u64(ptr, expectedCurrentValue, desiredValue);
 }
 
 uint64_t core_util_atomic_incr_u64(volatile uint64_t *valuePtr, uint64_t delta)
@@ -428,6 +428,12 @@ struct pollfd {
     short revents;
 };
 
+/* sys/uio.h defines */
+struct iovec {
+    void *iov_base;     ///< Start of the buffer
+    size_t iov_len;     ///< Size of the buffer in bytes
+};
+
 }
 
 #endif //RETARGET_H
@@ -122,6 +122,9 @@
 #error "OS Tickrate must be 1000 for system timing"
 #endif
 
+// Sampled stack statistics track the stack pointer at context switches
+// instead of painting the stacks and scanning them
+#if !defined(MBED_STACK_STATS_SAMPLED)
 #if !defined(OS_STACK_WATERMARK) && (defined(MBED_STACK_STATS_ENABLED) || defined(MBED_ALL_STATS_ENABLED))
 #define OS_STACK_WATERMARK          1
 #endif
@@ -129,6 +132,7 @@
 #if !defined(OS_STACK_WATERMARK) && defined(MBED_THREAD_STATS_ENABLED)
 #define OS_STACK_WATERMARK          1
 #endif
+#endif
 
 
 #define OS_IDLE_THREAD_TZ_MOD_ID     1
@@ -158,6 +162,8 @@
 //#define EVR_RTX_SEMAPHORE_ERROR_DISABLE
 //#define EVR_RTX_MEMORY_POOL_ERROR_DISABLE
 //#define EVR_RTX_MESSAGE_QUEUE_ERROR_DISABLE
+//Thread created and switched events are used by thread statistics to account run time,
+//and by sampled stack statistics to track the stack pointer
 
 //Following events are NOT used by Mbed-OS, you may enable them if needed for debug purposes
 #define EVR_RTX_MEMORY_INIT_DISABLE
@@ -188,7 +194,9 @@
 #define EVR_RTX_KERNEL_GET_SYS_TIMER_COUNT_DISABLE
 #define EVR_RTX_KERNEL_GET_SYS_TIMER_FREQ_DISABLE
 #define EVR_RTX_THREAD_NEW_DISABLE
+#if !defined(MBED_THREAD_STATS_ENABLED) && !defined(MBED_ALL_STATS_ENABLED) && !defined(MBED_STACK_STATS_SAMPLED)
 #define EVR_RTX_THREAD_CREATED_DISABLE
+#endif
 #define EVR_RTX_THREAD_GET_NAME_DISABLE
 #define EVR_RTX_THREAD_GET_ID_DISABLE
 #define EVR_RTX_THREAD_GET_STATE_DISABLE
@@ -209,7 +217,9 @@
 #define EVR_RTX_THREAD_BLOCKED_DISABLE
 #define EVR_RTX_THREAD_UNBLOCKED_DISABLE
 #define EVR_RTX_THREAD_PREEMPTED_DISABLE
+#if !defined(MBED_THREAD_STATS_ENABLED) && !defined(MBED_ALL_STATS_ENABLED) && !defined(MBED_STACK_STATS_SAMPLED)
 #define EVR_RTX_THREAD_SWITCHED_DISABLE
+#endif
 #define EVR_RTX_THREAD_DESTROYED_DISABLE
 #define EVR_RTX_THREAD_GET_COUNT_DISABLE
 #define EVR_RTX_THREAD_ENUMERATE_DISABLE
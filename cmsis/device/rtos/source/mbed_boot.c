@@ -63,6 +63,7 @@
 #include "mbed_boot.h"
 #include "mbed_error.h"
 #include "mbed_mpu_mgmt.h"
+#include "mbed_stats.h"
 
 int main(void);
 static void mbed_cpy_nvic(void);
@@ -83,22 +84,32 @@ void mbed_init(void)
     SCnSCB->ACTLR |= SCnSCB_ACTLR_DISDEFWBUF_Msk;
 #endif
 #endif
+    mbed_stats_boot_mark(MBED_BOOT_PHASE_INIT);
     mbed_mpu_manager_init();
+#if MBED_CONF_PLATFORM_HOT_CODE_IN_RAM && !defined(MBED_CONF_PLATFORM_HOT_CODE_SECTION)
+    // MBED_HOT functions were copied to RAM, which the MPU makes execute never
+    mbed_mpu_manager_lock_ram_execution();
+#endif
     mbed_cpy_nvic();
     mbed_sdk_init();
+    mbed_stats_boot_mark(MBED_BOOT_PHASE_SDK_INIT);
 #if DEVICE_USTICKER && MBED_CONF_TARGET_INIT_US_TICKER_AT_BOOT
     us_ticker_init();
 #endif
     mbed_rtos_init();
+    mbed_stats_boot_mark(MBED_BOOT_PHASE_RTOS_INIT);
 }
 
 void mbed_start(void)
 {
+    mbed_stats_boot_mark(MBED_BOOT_PHASE_RTOS_START);
     mbed_rtos_init_singleton_mutex();
     mbed_tfm_init();
     mbed_toolchain_init();
+    mbed_stats_boot_mark(MBED_BOOT_PHASE_STATIC_INIT);
     mbed_main();
     mbed_error_initialize();
+    mbed_stats_boot_mark(MBED_BOOT_PHASE_MAIN);
     main();
 }
 
@@ -23,6 +23,8 @@
 #include "mbed_error.h"
 #include "mbed_critical.h"
 #include "mbed_boot.h"
+#include "rtos/source/rtos_stack_pool.h"
+#include "rtx_lib.h"
 
 #if defined(FEATURE_TFM)
 #include "FEATURE_TFM/interface/include/tfm_ns_lock.h"
@@ -36,6 +38,66 @@ osThreadAttr_t _main_thread_attr;
 MBED_ALIGN(8) char _main_stack[MBED_CONF_APP_MAIN_STACK_SIZE];
 mbed_rtos_storage_thread_t _main_obj __attribute__((section(".bss.os.thread.cb")));
 
+#if defined(MBED_CONF_RTOS_THREAD_STACK_POOL_SIZE) && MBED_CONF_RTOS_THREAD_STACK_POOL_SIZE > 0
+/* RTX memory pool: 16 bytes of header and end marker, and 8 bytes in front of each block */
+#define STACK_POOL_HEADER_SIZE  16U
+#define STACK_POOL_BLOCK_SIZE(size) ((((size) + 8U) + 7U) & ~7U)
+
+#ifdef MBED_CONF_RTOS_THREAD_STACK_POOL_SECTION
+MBED_SECTION(MBED_CONF_RTOS_THREAD_STACK_POOL_SECTION)
+#endif
+MBED_ALIGN(8) static uint8_t stack_pool[STACK_POOL_HEADER_SIZE + MBED_CONF_RTOS_THREAD_STACK_POOL_SIZE];
+static mbed_stats_heap_t stack_pool_stats;
+static bool stack_pool_ready;
+
+void *rtos_stack_pool_alloc(uint32_t size)
+{
+    void *stack;
+
+    core_util_critical_section_enter();
+    if (!stack_pool_ready) {
+        osRtxMemoryInit(stack_pool, sizeof(stack_pool));
+        stack_pool_ready = true;
+    }
+    stack = osRtxMemoryAlloc(stack_pool, size, 0U);
+    if (stack != NULL) {
+        stack_pool_stats.current_size += STACK_POOL_BLOCK_SIZE(size);
+        stack_pool_stats.total_size += STACK_POOL_BLOCK_SIZE(size);
+        stack_pool_stats.alloc_cnt++;
+        if (stack_pool_stats.current_size > stack_pool_stats.max_size) {
+            stack_pool_stats.max_size = stack_pool_stats.current_size;
+        }
+    } else {
+        stack_pool_stats.alloc_fail_cnt++;
+    }
+    core_util_critical_section_exit();
+
+    return stack;
+}
+
+void rtos_stack_pool_free(void *stack, uint32_t size)
+{
+    if (stack == NULL) {
+        return;
+    }
+
+    core_util_critical_section_enter();
+    osRtxMemoryFree(stack_pool, stack);
+    stack_pool_stats.current_size -= STACK_POOL_BLOCK_SIZE(size);
+    stack_pool_stats.alloc_cnt--;
+    core_util_critical_section_exit();
+}
+
+void rtos_stack_pool_get_stats(mbed_stats_heap_t *stats)
+{
+    core_util_critical_section_enter();
+    *stats = stack_pool_stats;
+    stats->reserved_size = MBED_CONF_RTOS_THREAD_STACK_POOL_SIZE;
+    stats->overhead_size = STACK_POOL_HEADER_SIZE;
+    core_util_critical_section_exit();
+}
+#endif
+
 osMutexId_t               singleton_mutex_id;
 mbed_rtos_storage_mutex_t singleton_mutex_obj;
 
@@ -24,18 +24,99 @@
 #include "RTX_Config.h"
 #include "rtos/source/rtos_handlers.h"
 #include "rtos/source/rtos_idle.h"
+#include "platform/mbed_stats.h"
 
 #ifdef RTE_Compiler_EventRecorder
 #include "EventRecorder.h"              // Keil::Compiler:Event Recorder
 // Used from rtx_evr.c
 #define EvtRtxThreadExit               EventID(EventLevelAPI, 0xF2U, 0x19U)
 #define EvtRtxThreadTerminate          EventID(EventLevelAPI, 0xF2U, 0x1AU)
+#define EvtRtxThreadCreated_Addr       EventID(EventLevelOp,  0xF2U, 0x03U)
+#define EvtRtxThreadCreated_Name       EventID(EventLevelOp,  0xF2U, 0x2CU)
+#define EvtRtxThreadSwitched           EventID(EventLevelOp,  0xF2U, 0x19U)
+#endif
+
+#if defined(MBED_THREAD_STATS_ENABLED)
+typedef struct {
+    osThreadId_t id;
+    uint64_t run_ticks;
+    uint64_t sampled_ticks;
+} thread_run_time_t;
+
+// Run time in system timer ticks of the threads created so far, a slot is
+// claimed when the thread is created and released when it terminates
+static thread_run_time_t thread_run_times[MBED_MAX_THREAD_RUN_TIMES];
+static uint32_t last_switch_ticks;
+
+static thread_run_time_t *thread_run_time_find(osThreadId_t id)
+{
+    for (int i = 0; i < MBED_MAX_THREAD_RUN_TIMES; i++) {
+        if (thread_run_times[i].id == id) {
+            return &thread_run_times[i];
+        }
+    }
+    return NULL;
+}
+
+// Charge the running thread with the time since the previous switch, called
+// from the kernel or with the kernel locked
+static void thread_run_time_update(void)
+{
+    uint32_t now = osKernelGetSysTimerCount();
+    osThreadId_t running = osRtxInfo.thread.run.curr;
+    if (running != NULL) {
+        thread_run_time_t *entry = thread_run_time_find(running);
+        if (entry != NULL) {
+            entry->run_ticks += now - last_switch_ticks;
+        }
+    }
+    last_switch_ticks = now;
+}
+
+static uint64_t ticks_to_us(uint64_t ticks)
+{
+    uint32_t freq = osKernelGetSysTimerFreq();
+    return (ticks / freq) * 1000000 + (ticks % freq) * 1000000 / freq;
+}
+#endif
+
+#if defined(MBED_STACK_STATS_SAMPLED)
+typedef struct {
+    osThreadId_t id;
+    uint32_t min_sp;
+} thread_stack_mark_t;
+
+// Lowest stack pointer saved by each thread switched out so far, a slot is
+// claimed when the thread is created and released when it terminates
+static thread_stack_mark_t thread_stack_marks[MBED_MAX_THREAD_RUN_TIMES];
+
+static thread_stack_mark_t *thread_stack_mark_find(osThreadId_t id)
+{
+    for (int i = 0; i < MBED_MAX_THREAD_RUN_TIMES; i++) {
+        if (thread_stack_marks[i].id == id) {
+            return &thread_stack_marks[i];
+        }
+    }
+    return NULL;
+}
 #endif
 
 static void (*terminate_hook)(osThreadId_t id);
 
 static void thread_terminate_hook(osThreadId_t id)
 {
+#if defined(MBED_THREAD_STATS_ENABLED)
+    thread_run_time_t *entry = thread_run_time_find(id);
+    if (entry != NULL) {
+        entry->id = NULL;
+    }
+#endif
+#if defined(MBED_STACK_STATS_SAMPLED)
+    thread_stack_mark_t *mark = thread_stack_mark_find(id);
+    if (mark != NULL) {
+        mark->id = NULL;
+    }
+#endif
     if (terminate_hook) {
         terminate_hook(id);
     }
@@ -46,6 +127,53 @@ void rtos_attach_thread_terminate_hook(void (*fptr)(osThreadId_t id))
     terminate_hook = fptr;
 }
 
+#if defined(MBED_THREAD_STATS_ENABLED)
+uint64_t rtos_thread_run_time(osThreadId_t id, uint64_t *sample)
+{
+    uint64_t run_ticks = 0;
+    uint64_t sample_ticks = 0;
+    int32_t lock = osKernelLock();
+
+    thread_run_time_update();
+    thread_run_time_t *entry = thread_run_time_find(id);
+    if (entry != NULL && id != NULL) {
+        run_ticks = entry->run_ticks;
+        sample_ticks = run_ticks - entry->sampled_ticks;
+        if (sample != NULL) {
+            entry->sampled_ticks = run_ticks;
+        }
+    }
+
+    osKernelRestoreLock(lock);
+    if (sample != NULL) {
+        *sample = ticks_to_us(sample_ticks);
+    }
+    return ticks_to_us(run_ticks);
+}
+#endif
+
+#if defined(MBED_STACK_STATS_SAMPLED)
+uint32_t rtos_thread_stack_high_water(osThreadId_t id)
+{
+    uint32_t used = 0;
+    int32_t lock = osKernelLock();
+
+    thread_stack_mark_t *mark = thread_stack_mark_find(id);
+    if (mark != NULL && id != NULL) {
+        os_thread_t *thread = (os_thread_t *)id;
+        uint32_t sp = mark->min_sp;
+        // The saved stack pointer of the running thread is out of date
+        if (id == osRtxInfo.thread.run.curr && __get_PSP() < sp) {
+            sp = __get_PSP();
+        }
+        used = (uint32_t)thread->stack_mem + thread->stack_size - sp;
+    }
+
+    osKernelRestoreLock(lock);
+    return used;
+}
+#endif
+
 __NO_RETURN void osRtxIdleThread(void *argument)
 {
     rtos_idle_loop();
@@ -179,3 +307,50 @@ void EvrRtxThreadTerminate(osThreadId_t thread_id)
     EventRecord2(EvtRtxThreadTerminate, (uint32_t)thread_id, 0U);
 #endif
 }
+
+#if defined(MBED_THREAD_STATS_ENABLED) || defined(MBED_STACK_STATS_SAMPLED)
+void EvrRtxThreadCreated(osThreadId_t thread_id, uint32_t thread_addr, const char *name)
+{
+#if defined(MBED_THREAD_STATS_ENABLED)
+    thread_run_time_t *entry = thread_run_time_find(NULL);
+    if (entry != NULL) {
+        entry->id = thread_id;
+        entry->run_ticks = 0;
+        entry->sampled_ticks = 0;
+    }
+#endif
+#if defined(MBED_STACK_STATS_SAMPLED)
+    thread_stack_mark_t *mark = thread_stack_mark_find(NULL);
+    if (mark != NULL) {
+        mark->id = thread_id;
+        mark->min_sp = ((os_thread_t *)thread_id)->sp;
+    }
+#endif
+#if (!defined(EVR_RTX_DISABLE) && (OS_EVR_THREAD != 0) && !defined(EVR_RTX_THREAD_CREATED_DISABLE) && defined(RTE_Compiler_EventRecorder))
+    if (name != NULL) {
+        EventRecord2(EvtRtxThreadCreated_Name, (uint32_t)thread_id, (uint32_t)name);
+    } else {
+        EventRecord2(EvtRtxThreadCreated_Addr, (uint32_t)thread_id, thread_addr);
+    }
+#endif
+}
+
+// RTX hook which gets called when the kernel switches to another thread,
+// before osRtxInfo.thread.run.curr is updated
+void EvrRtxThreadSwitched(osThreadId_t thread_id)
+{
+#if defined(MBED_THREAD_STATS_ENABLED)
+    thread_run_time_update();
+#endif
+#if defined(MBED_STACK_STATS_SAMPLED)
+    // The thread switched in saved its stack pointer when it was switched out
+    thread_stack_mark_t *mark = thread_stack_mark_find(thread_id);
+    if (mark != NULL && ((os_thread_t *)thread_id)->sp < mark->min_sp) {
+        mark->min_sp = ((os_thread_t *)thread_id)->sp;
+    }
+#endif
+#if (!defined(EVR_RTX_DISABLE) && (OS_EVR_THREAD != 0) && !defined(EVR_RTX_THREAD_SWITCHED_DISABLE) && defined(RTE_Compiler_EventRecorder))
+    EventRecord2(EvtRtxThreadSwitched, (uint32_t)thread_id, 0U);
+#endif
+}
+#endif
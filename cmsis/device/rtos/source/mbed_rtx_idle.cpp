@@ -42,6 +42,15 @@ extern "C" {
 
 #if MBED_CONF_TARGET_TICKLESS_FROM_US_TICKER && !DEVICE_USTICKER
 #error Microsecond ticker required when MBED_CONF_TARGET_TICKLESS_FROM_US_TICKER is true
+#endif
+
+    // Shortest idle time, in milliseconds, for which deep sleep saves energy
+    // over sleep. When set, the idle hook predicts how long the system stays
+    // idle from the next deadline and how early recent sleeps ended, and only
+    // allows deep sleep if it's at least that long. 0 leaves the choice to
+    // the sleep manager alone.
+#ifndef MBED_CONF_RTOS_IDLE_DEEP_SLEEP_BREAK_EVEN
+#define MBED_CONF_RTOS_IDLE_DEEP_SLEEP_BREAK_EVEN 0
 #endif
 
     // Setup OS Tick timer to generate periodic RTOS Kernel Ticks
@@ -130,13 +139,53 @@ extern "C" {
         return core_util_atomic_load_u8(&osRtxInfo.kernel.pendSV);
     }
 
+#if MBED_CONF_RTOS_IDLE_DEEP_SLEEP_BREAK_EVEN > 0
+    // Running average of the part of the requested sleep actually slept, in
+    // 1/256ths: interrupts which keep waking the system early bring it down
+    static uint32_t idle_sleep_ratio = 256;
+
+    // Deep sleep costs more than sleep to enter and leave, so it's only worth
+    // it if the system is likely to stay idle for the break-even time
+    static bool idle_deep_sleep_worthwhile(rtos::Kernel::Clock::duration_u32 ticks_to_sleep)
+    {
+        if (ticks_to_sleep == rtos::Kernel::wait_for_u32_forever) {
+            return true;
+        }
+        uint64_t expected = (uint64_t)ticks_to_sleep.count() * idle_sleep_ratio / 256;
+        return expected >= MBED_CONF_RTOS_IDLE_DEEP_SLEEP_BREAK_EVEN;
+    }
+
+    static void idle_sleep_record(rtos::Kernel::Clock::duration_u32 ticks_to_sleep,
+                                  rtos::Kernel::Clock::duration_u32 ticks_slept)
+    {
+        if (ticks_to_sleep == rtos::Kernel::wait_for_u32_forever || ticks_to_sleep.count() == 0) {
+            return;
+        }
+        uint32_t ratio = ticks_slept >= ticks_to_sleep ? 256 :
+                         (uint32_t)((uint64_t)ticks_slept.count() * 256 / ticks_to_sleep.count());
+        idle_sleep_ratio = (idle_sleep_ratio * 7 + ratio) / 8;
+    }
+#endif
+
     static void default_idle_hook(void)
     {
         rtos::Kernel::Clock::duration_u32 ticks_to_sleep{osKernelSuspend()};
+#if MBED_CONF_RTOS_IDLE_DEEP_SLEEP_BREAK_EVEN > 0
+        bool deep_sleep_vetoed = !idle_deep_sleep_worthwhile(ticks_to_sleep);
+        if (deep_sleep_vetoed) {
+            sleep_manager_lock_deep_sleep();
+        }
+#endif
         // osKernelSuspend will call OS_Tick_Disable, cancelling the tick, which frees
         // up the os timer for the timed sleep
         rtos::Kernel::Clock::duration_u32 ticks_slept = mbed::internal::do_timed_sleep_relative_to_acknowledged_ticks(ticks_to_sleep, rtos_event_pending);
         MBED_ASSERT(ticks_slept < rtos::Kernel::wait_for_u32_max);
+#if MBED_CONF_RTOS_IDLE_DEEP_SLEEP_BREAK_EVEN > 0
+        if (deep_sleep_vetoed) {
+            sleep_manager_unlock_deep_sleep();
+        }
+        idle_sleep_record(ticks_to_sleep, ticks_slept);
+#endif
         osKernelResume(ticks_slept.count());
     }
 
@@ -28,6 +28,7 @@
 #include "ble/gap/AdvertisingDataSimpleBuilder.h"
 #include "ble/gap/AdvertisingDataTypes.h"
 #include "ble/gap/AdvertisingParameters.h"
+#include "ble/gap/AdvertisingReportFilter.h"
 #include "ble/gap/ConnectionParameters.h"
 #include "ble/gap/ScanParameters.h"
 #include "ble/gap/Events.h"
@@ -352,6 +353,25 @@ public:
         {
         }
 
+        /**
+         * Called with a batch of advertising reports, when the filter set
+         * with setAdvertisingReportFilter() batches them.
+         *
+         * The default implementation calls onAdvertisingReport() for each
+         * report.
+         *
+         * @param reports Advertising reports. They and their payloads are
+         * valid for the duration of the call only.
+         *
+         * @see AdvertisingReportFilter::setBatchSize()
+         */
+        virtual void onAdvertisingReports(mbed::Span<const AdvertisingReportEvent> reports)
+        {
+            for (const AdvertisingReportEvent &report : reports) {
+                onAdvertisingReport(report);
+            }
+        }
+
         /**
          * Called when scan times out.
          *
@@ -885,6 +905,21 @@ public:
      * @retval BLE_ERROR_NONE if successfully stopped scanning procedure.
      */
     ble_error_t stopScan();
+
+    /**
+     * Set the filter applied by the host to advertising reports.
+     *
+     * It drops the reports the application is not interested in before they
+     * are dispatched, and can group the remaining ones in batches.
+     *
+     * @param filter The filter; a default constructed one removes filtering.
+     *
+     * @retval BLE_ERROR_NONE on success.
+     * @retval BLE_ERROR_INVALID_STATE if scanning is in progress.
+     * @retval BLE_ERROR_NO_MEM if the deduplication set or the batch could
+     * not be allocated. No filter is applied then.
+     */
+    ble_error_t setAdvertisingReportFilter(const AdvertisingReportFilter &filter);
 #endif // BLE_ROLE_OBSERVER
 
 #if BLE_ROLE_OBSERVER
@@ -1169,6 +1204,36 @@ public:
         connection_handle_t connectionHandle,
         local_disconnection_reason_t reason
     );
+
+    /**
+     * Tune the connections to their traffic.
+     *
+     * The host measures the GATT server traffic of each connection, the
+     * notifications and indications sent, their backlog in the
+     * notification queue and the writes received, over
+     * MBED_CONF_BLE_API_IMPLEMENTATION_CONNECTION_TUNING_PERIOD ms. From
+     * that it classes the link as idle, low or high demand, and updates the
+     * connection interval and slave latency to the values the policy uses
+     * for that demand. The first time a link is in high demand, the longest
+     * data length and the LE 2M PHY are requested too, if the controller
+     * supports them.
+     *
+     * Demand rises as soon as it is measured, and falls after
+     * MBED_CONF_BLE_API_IMPLEMENTATION_CONNECTION_TUNING_HOLD periods at the
+     * lower demand, so that bursts do not cause an update each.
+     *
+     * @param policy The bias of the values used; NONE stops the tuning
+     * and leaves the connections with their current parameters.
+     *
+     * @retval BLE_ERROR_NONE on success.
+     *
+     * @note The updates are visible through
+     * EventHandler::onConnectionParametersUpdateComplete(),
+     * EventHandler::onDataLengthChange() and
+     * EventHandler::onPhyUpdateComplete(). Updates requested by the
+     * application are replaced at the next change of demand.
+     */
+    ble_error_t setConnectionTuningPolicy(connection_tuning_policy_t policy);
 #endif // BLE_FEATURE_CONNECTABLE
 #if BLE_FEATURE_PHY_MANAGEMENT
     /**
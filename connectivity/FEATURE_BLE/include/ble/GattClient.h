@@ -459,6 +459,39 @@ public:
         const uint8_t *value
     ) const;
 
+    /**
+     * Queue a write command (write without response) on an attribute value.
+     *
+     * The value is copied. The queue feeds write commands to the stack as it
+     * sends them, keeping a few of them outstanding per connection, so the
+     * link is kept busy without the application guessing when to send the
+     * next one.
+     *
+     * The completion of each command is reported to the handlers registered
+     * through onDataWritten() with the operation set to
+     * GattWriteCallbackParams::OP_WRITE_CMD. This is when the application can
+     * queue more data. Queued commands are dropped when the connection closes.
+     *
+     * @note Do not mix write() and queueWriteCommand() commands on the same
+     * attribute.
+     *
+     * @param[in] connHandle Handle of the connection used to send the command.
+     * @param[in] attributeHandle Handle of the attribute value to write.
+     * @param[in] length Number of bytes present in @p value, at most the size
+     * of the MTU minus three.
+     * @param[in] value Data buffer to write to attributeHandle.
+     *
+     * @return BLE_ERROR_NONE if the command has been queued,
+     * BLE_ERROR_PARAM_OUT_OF_RANGE if the value does not fit the MTU,
+     * BLE_ERROR_NO_MEM if the queue of the connection is full.
+     */
+    ble_error_t queueWriteCommand(
+        ble::connection_handle_t connHandle,
+        GattAttribute::Handle_t attributeHandle,
+        size_t length,
+        const uint8_t *value
+    );
+
     /* Event callback handlers. */
 
     /**
@@ -436,6 +436,41 @@ public:
         bool localOnly = false
     );
 
+    /**
+     * Queue a notification of a characteristic value to a client.
+     *
+     * Unlike write(), this neither stores the value in the attribute nor
+     * updates other clients: the value is copied once, into a stack buffer,
+     * and queued. Queued notifications are passed to the controller back to
+     * back, as fast as its ACL buffers are released, so several of them can
+     * go in one connection event. This suits streaming data at high rates.
+     *
+     * EventHandler::onDataSent() is called as each notification leaves the
+     * queue, which is when the application can queue the next one. Queued
+     * notifications are dropped when the client disables them or the
+     * connection closes.
+     *
+     * @note Do not mix write() and queueNotification() updates of the same
+     * characteristic to the same client.
+     *
+     * @param[in] connectionHandle Connection handle of the client.
+     * @param[in] attributeHandle Handle of the characteristic value.
+     * @param[in] value A pointer to a buffer holding the value to send.
+     * @param[in] size Size of the value, at most the ATT MTU minus 3.
+     *
+     * @return BLE_ERROR_NONE if the notification has been queued,
+     * BLE_ERROR_INVALID_STATE if the client has not enabled notifications of
+     * the characteristic, BLE_ERROR_NO_MEM if the queue of the connection is
+     * full or no stack buffer is available, BLE_ERROR_INVALID_PARAM if the
+     * attribute cannot be notified or the value does not fit the MTU.
+     */
+    ble_error_t queueNotification(
+        ble::connection_handle_t connectionHandle,
+        GattAttribute::Handle_t attributeHandle,
+        const uint8_t *value,
+        uint16_t size
+    );
+
     /**
      * Determine if one of the connected clients has subscribed to notifications
      * or indications of the characteristic in input.
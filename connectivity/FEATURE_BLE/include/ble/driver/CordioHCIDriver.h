@@ -48,12 +48,98 @@ struct buf_pool_desc_t {
     {
     }
 
+    /**
+     * Create a new memory pool description from a description built at runtime
+     * @param buffer the Buffer used by the memory pool.
+     * @param buffer_size the size of the buffer
+     * @param pool_desc How the memory is split
+     * @param pool_count the number of pools in pool_desc
+     */
+    buf_pool_desc_t(
+        uint8_t *buffer,
+        size_t buffer_size,
+        const wsfBufPoolDesc_t *pool_desc,
+        size_t pool_count
+    ) : buffer_memory(buffer), buffer_size(buffer_size),
+        pool_description(pool_desc), pool_count(pool_count)
+    {
+    }
+
     uint8_t* buffer_memory;         /// Pointer to the buffer memory
     size_t buffer_size;             /// Size of the buffer
     const wsfBufPoolDesc_t* pool_description;   /// Pointer to the first element describing the pool
     size_t pool_count;      /// Number of pools
 };
 
+/**
+ * Usage statistics of a memory pool used by the Cordio stack.
+ */
+struct buf_pool_stats_t {
+    uint16_t buffer_size;           /// Size of the buffers of the pool
+    uint8_t buffer_count;           /// Number of buffers in the pool
+    uint8_t allocated;              /// Number of buffers currently allocated
+    uint8_t max_allocated;          /// Highest number of buffers allocated at once
+    uint16_t max_requested_size;    /// Largest size requested from the pool
+    uint16_t failures;              /// Allocations that fitted this pool but failed, saturating
+};
+
+/**
+ * Replace the memory pools described by the HCI driver.
+ *
+ * This lets the pools be sized at runtime, for instance from the statistics
+ * returned by cordio_get_buffer_pool_stats() in the field.
+ *
+ * @param desc The memory and pools to use. The memory and the pool
+ * description must remain valid while the stack runs.
+ *
+ * @return BLE_ERROR_NONE on success or BLE_ERROR_INVALID_STATE if the stack
+ * pools are already set up: this must be called before the first call to
+ * BLE::Instance().
+ */
+ble_error_t cordio_set_buffer_pool_description(const buf_pool_desc_t &desc);
+
+/**
+ * Get the usage statistics of the memory pools used by the Cordio stack.
+ *
+ * @param[out] stats Array filled with the statistics of each pool, from the
+ * smallest buffers to the largest. Allocations larger than any pool are counted
+ * as failures of the last one.
+ * @param count Number of elements in stats.
+ *
+ * @return The number of pools, which can be more than count.
+ *
+ * @note The high allocation watermark and the largest requested size are only
+ * tracked when the stack is built with WSF_BUF_STATS.
+ */
+size_t cordio_get_buffer_pool_stats(buf_pool_stats_t *stats, size_t count);
+
+/**
+ * Statistics of the dispatch of the Cordio stack events.
+ */
+struct dispatch_stats_t {
+    uint32_t dispatch_count;        /// Number of dispatcher passes
+    uint32_t latency_count;         /// Number of wake ups measured
+    uint64_t total_latency_us;      /// Sum of the times from wake up signal to dispatch
+    uint32_t max_latency_us;        /// Longest time from wake up signal to dispatch
+    uint32_t budget_exhausted;      /// Wake ups which left events to the next one
+};
+
+/**
+ * Get the statistics of the dispatch of the Cordio stack events.
+ *
+ * The latency measured is the time between the stack signalling it has
+ * events to process and the dispatcher running: it grows with whatever shares
+ * the event queue, or the thread priority, of the stack.
+ *
+ * @param[out] stats The statistics since the last reset.
+ */
+void cordio_get_dispatch_stats(dispatch_stats_t &stats);
+
+/**
+ * Reset the statistics of the dispatch of the Cordio stack events.
+ */
+void cordio_reset_dispatch_stats();
+
 /**
  * Base class of the HCI driver use by the BLE port of the Cordio stack.
  * This class provide to the stack:
@@ -24,6 +24,24 @@
 #include "drivers/UnbufferedSerial.h"
 #include "ble/driver/CordioHCITransportDriver.h"
 
+/**
+ * Receive the HCI packets with asynchronous (DMA when the target supports it)
+ * UART reads framed by the H4 packet headers, rather than one byte per interrupt.
+ */
+#ifndef MBED_CONF_CORDIO_H4_ASYNC_RX
+#define MBED_CONF_CORDIO_H4_ASYNC_RX 0
+#endif
+
+/**
+ * Size of the buffer the asynchronous reads land in, packet payloads larger
+ * than it are read in several parts.
+ */
+#ifndef MBED_CONF_CORDIO_H4_RX_BUFFER_SIZE
+#define MBED_CONF_CORDIO_H4_RX_BUFFER_SIZE 64
+#endif
+
+#define H4_ASYNC_RX (DEVICE_SERIAL_ASYNCH && MBED_CONF_CORDIO_H4_ASYNC_RX)
+
 namespace ble {
 
 /**
@@ -66,11 +84,41 @@ public:
     uint16_t write(uint8_t type, uint16_t len, uint8_t *pData) override;
 
 private:
+#if H4_ASYNC_RX
+    // SerialBase exposes the asynchronous API that UnbufferedSerial hides.
+    // It doesn't lock either, the peripheral is accessed in interrupt context.
+    class AsyncSerial : public mbed::SerialBase {
+    public:
+        AsyncSerial(PinName tx, PinName rx, int baud) : SerialBase(tx, rx, baud) { }
+
+        int putc(int c)
+        {
+            return _base_putc(c);
+        }
+    };
+
+    enum rx_state_t {
+        RX_TYPE,
+        RX_HEADER,
+        RX_PAYLOAD
+    };
+
+    void start_read(rx_state_t state, uint16_t length);
+    void on_read_complete(int event);
+
+    AsyncSerial uart;
+    uint8_t rx_buffer[MBED_CONF_CORDIO_H4_RX_BUFFER_SIZE];
+    rx_state_t rx_state;
+    uint8_t rx_type;
+    uint16_t rx_length;
+    uint16_t rx_remaining;
+#else
     void on_controller_irq();
 
     // Use UnbufferedSerial as we don't require locking primitives.
     // We access the peripheral in interrupt context.
     mbed::UnbufferedSerial uart;
+#endif
     PinName cts;
     PinName rts;
 };
@@ -0,0 +1,193 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MBED_GAP_ADVERTISING_REPORT_FILTER_H__
+#define MBED_GAP_ADVERTISING_REPORT_FILTER_H__
+
+#include <cstdint>
+
+#include "ble/common/blecommon.h"
+#include "ble/common/BLETypes.h"
+#include "ble/common/UUID.h"
+#include "ble/gap/Types.h"
+
+namespace ble {
+
+/**
+ * @addtogroup ble
+ * @{
+ * @addtogroup gap
+ * @{
+ */
+
+/**
+ * Host side filter applied to advertising reports before they reach the
+ * application.
+ *
+ * Reports are dropped by the host, before Gap::EventHandler::onAdvertisingReport()
+ * is called, when:
+ *   - their RSSI is below the threshold set with setMinRssi().
+ *   - their payload does not list the service UUID set with setServiceUuid().
+ *   - their peer address is not in the addresses added with addPeerAddress(),
+ *     if any was added. The address compared is the identity address when
+ *     the host resolved it.
+ *   - with setDeduplication(), the same peer already reported the same
+ *     payload since the scan started.
+ *
+ * Reports which pass can be delivered in batches of setBatchSize() reports to
+ * Gap::EventHandler::onAdvertisingReports(), one call per batch instead of one
+ * call per report.
+ *
+ * A default constructed filter lets every report through, one at a time.
+ *
+ * @see Gap::setAdvertisingReportFilter()
+ */
+class AdvertisingReportFilter {
+public:
+    AdvertisingReportFilter() :
+        _min_rssi(-127),
+        _service_uuid(UUID::ShortUUIDBytes_t(BLE_UUID_UNKNOWN)),
+        _address_count(0),
+        _deduplication(false),
+        _batch_size(1)
+    {
+    }
+
+    /**
+     * Drop reports received with a lower RSSI.
+     *
+     * @param min_rssi Lowest RSSI reported, in dBm. Reports without RSSI
+     * are kept.
+     */
+    AdvertisingReportFilter &setMinRssi(rssi_t min_rssi)
+    {
+        _min_rssi = min_rssi;
+        return *this;
+    }
+
+    /**
+     * Only report peers which list a service in their payload.
+     *
+     * @param uuid The 16-bit or 128-bit UUID of the service, or
+     * BLE_UUID_UNKNOWN to report any peer.
+     */
+    AdvertisingReportFilter &setServiceUuid(const UUID &uuid)
+    {
+        _service_uuid = uuid;
+        return *this;
+    }
+
+    /**
+     * Only report the peers added.
+     *
+     * @param address Address of the peer.
+     *
+     * @return BLE_ERROR_NONE on success, BLE_ERROR_NO_MEM if
+     * MBED_CONF_BLE_API_IMPLEMENTATION_ADVERTISING_REPORT_FILTER_ADDRESSES
+     * addresses were already added.
+     */
+    ble_error_t addPeerAddress(const address_t &address)
+    {
+        if (_address_count == MBED_CONF_BLE_API_IMPLEMENTATION_ADVERTISING_REPORT_FILTER_ADDRESSES) {
+            return BLE_ERROR_NO_MEM;
+        }
+        _addresses[_address_count++] = address;
+        return BLE_ERROR_NONE;
+    }
+
+    /**
+     * Report a peer and payload pair once per scan.
+     *
+     * Unlike duplicates_filter_t::ENABLE, the comparison covers the payload
+     * and is done by the host, so it is not bound to the controller's table.
+     */
+    AdvertisingReportFilter &setDeduplication(bool enable = true)
+    {
+        _deduplication = enable;
+        return *this;
+    }
+
+    /**
+     * Deliver reports in batches.
+     *
+     * @param batch_size Reports per call to
+     * Gap::EventHandler::onAdvertisingReports(), clamped to
+     * MBED_CONF_BLE_API_IMPLEMENTATION_ADVERTISING_REPORT_BATCH_SIZE. 1
+     * delivers each report on its own.
+     *
+     * @note Reports with a payload larger than
+     * MBED_CONF_BLE_API_IMPLEMENTATION_ADVERTISING_REPORT_BATCH_PAYLOAD_SIZE
+     * are delivered on their own. A partial batch is delivered when the scan
+     * stops or times out.
+     */
+    AdvertisingReportFilter &setBatchSize(uint8_t batch_size)
+    {
+        _batch_size = batch_size ? batch_size : 1;
+        return *this;
+    }
+
+    rssi_t getMinRssi() const
+    {
+        return _min_rssi;
+    }
+
+    const UUID &getServiceUuid() const
+    {
+        return _service_uuid;
+    }
+
+    bool isPeerAddressAccepted(const address_t &address) const
+    {
+        if (_address_count == 0) {
+            return true;
+        }
+        for (uint8_t i = 0; i < _address_count; i++) {
+            if (_addresses[i] == address) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool isDeduplicationEnabled() const
+    {
+        return _deduplication;
+    }
+
+    uint8_t getBatchSize() const
+    {
+        return _batch_size;
+    }
+
+private:
+    rssi_t _min_rssi;
+    UUID _service_uuid;
+    address_t _addresses[MBED_CONF_BLE_API_IMPLEMENTATION_ADVERTISING_REPORT_FILTER_ADDRESSES];
+    uint8_t _address_count;
+    bool _deduplication;
+    uint8_t _batch_size;
+};
+
+/**
+ * @}
+ * @}
+ */
+
+} // namespace ble
+
+#endif //ifndef MBED_GAP_ADVERTISING_REPORT_FILTER_H__
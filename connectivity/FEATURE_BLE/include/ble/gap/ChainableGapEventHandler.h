@@ -53,6 +53,10 @@ public:
         execute_on_all(&ble::Gap::EventHandler::onAdvertisingReport, event);
     }
 
+    void onAdvertisingReports(mbed::Span<const ble::AdvertisingReportEvent> reports) override {
+        execute_on_all(&ble::Gap::EventHandler::onAdvertisingReports, reports);
+    }
+
     void onScanTimeout(const ble::ScanTimeoutEvent &event) override {
         execute_on_all(&ble::Gap::EventHandler::onScanTimeout, event);
     }
@@ -990,6 +990,48 @@ struct central_privacy_configuration_t {
 };
 
 
+/**
+ * Bias of the policy which tunes the connections to their traffic.
+ *
+ * @see Gap::setConnectionTuningPolicy()
+ */
+struct connection_tuning_policy_t : SafeEnum<connection_tuning_policy_t, uint8_t> {
+    /// enumeration of connection_tuning_policy_t values
+    enum type {
+        /**
+         * The connections keep the parameters they are given.
+         */
+        NONE,
+
+        /**
+         * Short connection intervals without slave latency, widened only
+         * slightly when the link is idle.
+         */
+        LATENCY,
+
+        /**
+         * The shortest intervals while data flows, the longest data length
+         * and the LE 2M PHY.
+         */
+        THROUGHPUT,
+
+        /**
+         * Long intervals and slave latency when the link is idle, shortened
+         * only while data flows.
+         */
+        POWER
+    };
+
+    /**
+     * Construct a new connection_tuning_policy_t value.
+     *
+     * @param value The value of the connection_tuning_policy_t created.
+     */
+    connection_tuning_policy_t(type value) : SafeEnum(value)
+    {
+    }
+};
+
 /**
  * @}
  * @}
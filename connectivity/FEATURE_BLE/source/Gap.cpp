@@ -180,6 +180,11 @@ ble_error_t Gap::setScanParameters(const ScanParameters &params)
     return impl->setScanParameters(params);
 }
 
+ble_error_t Gap::setAdvertisingReportFilter(const AdvertisingReportFilter &filter)
+{
+    return impl->setAdvertisingReportFilter(filter);
+}
+
 
 ble_error_t Gap::startScan(
     scan_duration_t duration,
@@ -357,6 +362,12 @@ ble_error_t Gap::disconnect(
     return impl->disconnect(connectionHandle, reason);
 }
 
+
+ble_error_t Gap::setConnectionTuningPolicy(connection_tuning_policy_t policy)
+{
+    return impl->setConnectionTuningPolicy(policy);
+}
+
 #endif // BLE_FEATURE_CONNECTABLE
 #if BLE_FEATURE_PHY_MANAGEMENT
 
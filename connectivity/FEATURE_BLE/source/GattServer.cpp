@@ -75,6 +75,16 @@ ble_error_t GattServer::write(
     return impl->write(connectionHandle, attributeHandle, value, size, localOnly);
 }
 
+ble_error_t GattServer::queueNotification(
+    ble::connection_handle_t connectionHandle,
+    GattAttribute::Handle_t attributeHandle,
+    const uint8_t *value,
+    uint16_t size
+)
+{
+    return impl->queueNotification(connectionHandle, attributeHandle, value, size);
+}
+
 ble_error_t GattServer::areUpdatesEnabled(
     const GattCharacteristic &characteristic,
     bool *enabledP
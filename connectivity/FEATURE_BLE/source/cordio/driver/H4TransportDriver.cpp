@@ -17,8 +17,18 @@
 
 #if DEVICE_SERIAL && DEVICE_SERIAL_FC
 
+#include <algorithm>
+
 #include "ble/driver/H4TransportDriver.h"
 
+// H4 packet types and header lengths, as in hci_defs.h
+#define H4_CMD_TYPE     0x01
+#define H4_ACL_TYPE     0x02
+#define H4_EVT_TYPE     0x04
+#define H4_CMD_HDR_LEN  3
+#define H4_ACL_HDR_LEN  4
+#define H4_EVT_HDR_LEN  2
+
 namespace ble {
 
 H4TransportDriver::H4TransportDriver(PinName tx, PinName rx, PinName cts, PinName rts, int baud) :
@@ -38,13 +48,24 @@ void H4TransportDriver::initialize()
         /* cts */ cts
     );
 
+#if H4_ASYNC_RX
+    // Flow control holds the controller back between two reads
+    uart.set_dma_usage_rx(DMA_USAGE_OPPORTUNISTIC);
+    start_read(RX_TYPE, 1);
+#else
     uart.attach(
         mbed::callback(this, &H4TransportDriver::on_controller_irq),
         mbed::SerialBase::RxIrq
     );
+#endif
 }
 
-void H4TransportDriver::terminate() {  }
+void H4TransportDriver::terminate()
+{
+#if H4_ASYNC_RX
+    uart.abort_read();
+#endif
+}
 
 uint16_t H4TransportDriver::write(uint8_t type, uint16_t len, uint8_t *pData)
 {
@@ -52,21 +73,102 @@ uint16_t H4TransportDriver::write(uint8_t type, uint16_t len, uint8_t *pData)
     while (i < len + 1) {
         uint8_t to_write = i == 0 ? type : pData[i - 1];
         while (uart.writeable() == 0);
+#if H4_ASYNC_RX
+        uart.putc(to_write);
+#else
         uart.write(&to_write, 1);
+#endif
         ++i;
     }
     return len;
 }
 
+#if H4_ASYNC_RX
+void H4TransportDriver::start_read(rx_state_t state, uint16_t length)
+{
+    rx_state = state;
+    rx_length = std::min(length, (uint16_t) sizeof(rx_buffer));
+    uart.read(rx_buffer, rx_length, mbed::callback(this, &H4TransportDriver::on_read_complete));
+}
+
+void H4TransportDriver::on_read_complete(int event)
+{
+    // The read is always completed in full, there is nothing to salvage from an error
+    if (!(event & SERIAL_EVENT_RX_COMPLETE)) {
+        start_read(RX_TYPE, 1);
+        return;
+    }
+
+    // Hand over the whole read at once
+    on_data_received(rx_buffer, rx_length);
+
+    // Then read up to the end of the next part of the packet
+    switch (rx_state) {
+        case RX_TYPE:
+            rx_type = rx_buffer[0];
+            switch (rx_type) {
+                case H4_CMD_TYPE:
+                    start_read(RX_HEADER, H4_CMD_HDR_LEN);
+                    break;
+                case H4_ACL_TYPE:
+                    start_read(RX_HEADER, H4_ACL_HDR_LEN);
+                    break;
+                case H4_EVT_TYPE:
+                    start_read(RX_HEADER, H4_EVT_HDR_LEN);
+                    break;
+                default:
+                    // Unknown packet, the receiver deals with the byte
+                    start_read(RX_TYPE, 1);
+                    break;
+            }
+            break;
+
+        case RX_HEADER:
+            // The payload length is the last field of every header, on one byte but for ACL packets
+            if (rx_type == H4_ACL_TYPE) {
+                rx_remaining = rx_buffer[2] | (rx_buffer[3] << 8);
+            } else {
+                rx_remaining = rx_buffer[rx_length - 1];
+            }
+            if (rx_remaining == 0) {
+                start_read(RX_TYPE, 1);
+            } else {
+                start_read(RX_PAYLOAD, rx_remaining);
+            }
+            break;
+
+        case RX_PAYLOAD:
+            rx_remaining -= rx_length;
+            if (rx_remaining == 0) {
+                start_read(RX_TYPE, 1);
+            } else {
+                start_read(RX_PAYLOAD, rx_remaining);
+            }
+            break;
+    }
+}
+#else
 void H4TransportDriver::on_controller_irq()
 {
+    uint8_t buffer[16];
+    uint16_t count = 0;
+
+    // Drain the UART, handing the bytes over in bursts rather than one by one
     while (uart.readable()) {
-        uint8_t char_received;
-        if (uart.read(&char_received, 1)) {
-            on_data_received(&char_received, 1);
+        if (uart.read(&buffer[count], 1)) {
+            count++;
+        }
+        if (count == sizeof(buffer)) {
+            on_data_received(buffer, count);
+            count = 0;
         }
     }
+
+    if (count) {
+        on_data_received(buffer, count);
+    }
 }
+#endif
 
 } // namespace ble
 
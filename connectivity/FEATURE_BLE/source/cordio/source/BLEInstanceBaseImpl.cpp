@@ -16,9 +16,12 @@
  * limitations under the License.
  */
 
+#include <algorithm>
+
 #include "platform/CriticalSectionLock.h"
 #include "hal/us_ticker_api.h"
 #include "platform/mbed_assert.h"
+#include "platform/mbed_atomic.h"
 
 #include "ble/BLE.h"
 #include "ble/driver/CordioHCIDriver.h"
@@ -62,6 +65,77 @@ wsfHandlerId_t stack_handler_id;
 uint8_t *SystemHeapStart;
 uint32_t SystemHeapSize;
 
+namespace {
+
+/* Memory pools set at runtime, used instead of the HCI driver ones when set */
+ble::buf_pool_desc_t custom_buf_pool_desc(nullptr, 0, nullptr, 0);
+bool buf_pools_set_up = false;
+
+/* Buffer size of each pool and the allocation failures they've seen */
+uint8_t buf_pool_count = 0;
+uint16_t buf_pool_sizes[WSF_BUF_STATS_MAX_POOL];
+uint16_t buf_pool_failures[WSF_BUF_STATS_MAX_POOL];
+
+void on_buf_diagnostic(WsfBufDiag_t *info)
+{
+    if (info->type != WSF_BUF_ALLOC_FAILED || buf_pool_count == 0) {
+        return;
+    }
+
+    // Blame the smallest pool that could have served the request
+    uint8_t pool = 0;
+    while (pool < buf_pool_count - 1 && buf_pool_sizes[pool] < info->param.alloc.len) {
+        pool++;
+    }
+
+    // Allocations also fail from interrupt context
+    if (core_util_atomic_load_u16(&buf_pool_failures[pool]) != UINT16_MAX) {
+        core_util_atomic_incr_u16(&buf_pool_failures[pool], 1);
+    }
+}
+
+} // namespace
+
+ble_error_t ble::cordio_set_buffer_pool_description(const buf_pool_desc_t &desc)
+{
+    if (buf_pools_set_up) {
+        return BLE_ERROR_INVALID_STATE;
+    }
+    custom_buf_pool_desc = desc;
+    return BLE_ERROR_NONE;
+}
+
+size_t ble::cordio_get_buffer_pool_stats(buf_pool_stats_t *stats, size_t count)
+{
+    // Make sure the pools are set up
+    ble::impl::BLEInstanceBase::deviceInstance();
+
+    WsfBufPoolStat_t pool_stats[WSF_BUF_STATS_MAX_POOL];
+    uint8_t pool_count = WsfBufGetNumPool();
+    WsfBufGetPoolStats(pool_stats, pool_count);
+
+    for (size_t i = 0; i < count && i < pool_count; i++) {
+        stats[i].buffer_size = pool_stats[i].bufSize;
+        stats[i].buffer_count = pool_stats[i].numBuf;
+        stats[i].allocated = pool_stats[i].numAlloc;
+        stats[i].max_allocated = pool_stats[i].maxAlloc;
+        stats[i].max_requested_size = pool_stats[i].maxReqLen;
+        stats[i].failures = core_util_atomic_load_u16(&buf_pool_failures[i]);
+    }
+
+    return pool_count;
+}
+
+void ble::cordio_get_dispatch_stats(dispatch_stats_t &stats)
+{
+    ble::impl::BLEInstanceBase::deviceInstance().getDispatchStats(stats);
+}
+
+void ble::cordio_reset_dispatch_stats()
+{
+    ble::impl::BLEInstanceBase::deviceInstance().resetDispatchStats();
+}
+
 /**
  * Weak definition of ble_cordio_get_hci_driver.
  * A runtime error is generated if the user does not define any
@@ -94,12 +168,13 @@ extern "C" void hci_mbed_os_handle_reset_sequence(uint8_t *msg)
 }
 
 /*
- * This function will signal to the user code by calling signalEventsToProcess.
+ * This function will signal to the user code, or to the stack thread, by
+ * calling signalEventsToProcess.
  * It is registered and called into the Wsf Stack.
  */
 extern "C" MBED_WEAK void wsf_mbed_ble_signal_event(void)
 {
-    BLE::Instance().signalEventsToProcess();
+    ble::impl::BLEInstanceBase::deviceInstance().signalEventsToProcess();
 }
 
 /**
@@ -114,10 +189,20 @@ ble::BLEInstanceBase *ble::createBLEInstance()
 namespace ble {
 namespace impl {
 
+#if CORDIO_DEDICATED_THREAD
+static const uint32_t STACK_THREAD_EVENT_FLAG = 1;
+#endif
+
 BLEInstanceBase::BLEInstanceBase(CordioHCIDriver &hci_driver) :
     initialization_status(NOT_INITIALIZED),
     _event_queue(),
-    _last_update_us(0)
+    _last_update_us(0),
+    _signal_time_us(0),
+    _signal_pending(false),
+    _dispatch_stats()
+#if CORDIO_DEDICATED_THREAD
+    , _thread(MBED_CONF_CORDIO_THREAD_PRIORITY, MBED_CONF_CORDIO_THREAD_STACK_SIZE, nullptr, "cordio")
+#endif
 {
     _hci_driver = &hci_driver;
     stack_setup();
@@ -142,6 +227,14 @@ ble_error_t BLEInstanceBase::init(
 {
     switch (initialization_status) {
         case NOT_INITIALIZED:
+#if CORDIO_DEDICATED_THREAD
+            if (_thread.get_id() == nullptr) {
+                if (_thread.start(mbed::callback(this, &BLEInstanceBase::thread_loop)) != osOK) {
+                    return BLE_ERROR_NO_MEM;
+                }
+                _thread.flags_set(STACK_THREAD_EVENT_FLAG);
+            }
+#endif
             _timer.reset();
             _timer.start();
             _event_queue.initialize(this);
@@ -337,7 +430,41 @@ void BLEInstanceBase::waitForEvent()
 
 void BLEInstanceBase::processEvents()
 {
-    callDispatcher();
+#if !CORDIO_DEDICATED_THREAD
+    dispatch();
+#endif
+}
+
+void BLEInstanceBase::signalEventsToProcess()
+{
+    {
+        mbed::CriticalSectionLock critical_section;
+        if (!_signal_pending) {
+            _signal_pending = true;
+            _signal_time_us = _timer.elapsed_time().count();
+        }
+    }
+
+#if CORDIO_DEDICATED_THREAD
+    // Until init() starts the thread, the signal is kept pending
+    if (_thread.get_id() != nullptr) {
+        _thread.flags_set(STACK_THREAD_EVENT_FLAG);
+    }
+#else
+    BLE::Instance().signalEventsToProcess();
+#endif
+}
+
+void BLEInstanceBase::getDispatchStats(dispatch_stats_t &stats) const
+{
+    mbed::CriticalSectionLock critical_section;
+    stats = _dispatch_stats;
+}
+
+void BLEInstanceBase::resetDispatchStats()
+{
+    mbed::CriticalSectionLock critical_section;
+    _dispatch_stats = dispatch_stats_t();
 }
 
 void BLEInstanceBase::stack_handler(wsfEventMask_t event, wsfMsgHdr_t *msg)
@@ -446,10 +573,36 @@ void BLEInstanceBase::connection_handler(dmEvt_t *dm_event)
         case DM_CONN_OPEN_IND:
             /* set up CCC table with uninitialized (all zero) values */
             AttsCccInitTable(connId, nullptr);
+#if MBED_CONF_BLE_API_IMPLEMENTATION_CONNECTION_DATA_LENGTH
+            /* longer link layer packets carry more ATT payload per connection event */
+            if (HciGetLeSupFeat() & HCI_LE_SUP_FEAT_DATA_LEN_EXT) {
+                DmConnSetDataLen(
+                    connId,
+                    MBED_CONF_BLE_API_IMPLEMENTATION_CONNECTION_DATA_LENGTH,
+                    /* transmit time on the 1M PHY, in us */
+                    (MBED_CONF_BLE_API_IMPLEMENTATION_CONNECTION_DATA_LENGTH + 14) * 8
+                );
+            }
+#endif
+#if BLE_FEATURE_PHY_MANAGEMENT && MBED_CONF_BLE_API_IMPLEMENTATION_CONNECTION_PREFER_2M_PHY
+            if (HciGetLeSupFeat() & HCI_LE_SUP_FEAT_LE_2M_PHY) {
+                DmSetPhy(
+                    connId,
+                    HCI_ALL_PHY_ALL_PREFERENCES,
+                    HCI_PHY_LE_2M_BIT,
+                    HCI_PHY_LE_2M_BIT,
+                    HCI_PHY_OPTIONS_NONE
+                );
+            }
+#endif
             break;
         case DM_CONN_CLOSE_IND:
             /* clear CCC table on connection close */
             AttsCccClearTable(connId);
+            ble::impl::GattServer::getInstance().drop_notifications(connId);
+#if BLE_FEATURE_GATT_CLIENT
+            deviceInstance().getGattClientImpl().drop_write_commands(connId);
+#endif // BLE_FEATURE_GATT_CLIENT
             break;
         default:
             break;
@@ -467,7 +620,9 @@ void BLEInstanceBase::stack_setup()
 
     wsfHandlerId_t handlerId;
 
-    buf_pool_desc_t buf_pool_desc = _hci_driver->get_buffer_pool_description();
+    buf_pool_desc_t buf_pool_desc = custom_buf_pool_desc.buffer_memory ?
+        custom_buf_pool_desc : _hci_driver->get_buffer_pool_description();
+    buf_pools_set_up = true;
 
     // use the buffer for the WSF heap
     SystemHeapStart = buf_pool_desc.buffer_memory;
@@ -479,6 +634,13 @@ void BLEInstanceBase::stack_setup()
     // Raise assert if not enough memory was allocated
     MBED_ASSERT(bytes_used != 0);
 
+    // Keep track of the allocation failures of each pool
+    buf_pool_count = std::min(buf_pool_desc.pool_count, (size_t) WSF_BUF_STATS_MAX_POOL);
+    for (uint8_t i = 0; i < buf_pool_count; i++) {
+        buf_pool_sizes[i] = buf_pool_desc.pool_description[i].len;
+    }
+    WsfBufDiagRegister(on_buf_diagnostic);
+
     SystemHeapStart += bytes_used;
     SystemHeapSize -= bytes_used;
 
@@ -633,13 +795,58 @@ void BLEInstanceBase::start_stack_reset()
     DmDevReset();
 }
 
+void BLEInstanceBase::dispatch()
+{
+    for (uint32_t pass = 0; pass < MBED_CONF_CORDIO_DISPATCH_BUDGET; ++pass) {
+        callDispatcher();
+        if (!core_util_atomic_load_bool(&_signal_pending)) {
+            return;
+        }
+    }
+
+    // Events came in the meantime, the wake up they signalled processes them
+    mbed::CriticalSectionLock critical_section;
+    _dispatch_stats.budget_exhausted++;
+}
+
+#if CORDIO_DEDICATED_THREAD
+void BLEInstanceBase::thread_loop()
+{
+    while (true) {
+        rtos::ThisThread::flags_wait_any(STACK_THREAD_EVENT_FLAG);
+        dispatch();
+
+        // Let the threads of the same priority run before the next batch
+        if (core_util_atomic_load_bool(&_signal_pending)) {
+            rtos::ThisThread::yield();
+        }
+    }
+}
+#endif
+
 void BLEInstanceBase::callDispatcher()
 {
+    uint64_t elapsed_us;
+
+    {
+        mbed::CriticalSectionLock critical_section;
+        elapsed_us = _timer.elapsed_time().count();
+        _timer.reset();
+
+        if (_signal_pending) {
+            _signal_pending = false;
+            uint64_t latency_us = elapsed_us > _signal_time_us ? elapsed_us - _signal_time_us : 0;
+            _dispatch_stats.latency_count++;
+            _dispatch_stats.total_latency_us += latency_us;
+            _dispatch_stats.max_latency_us = std::max<uint64_t>(_dispatch_stats.max_latency_us, latency_us);
+        }
+        _dispatch_stats.dispatch_count++;
+    }
+
     // process the external event queue
     _event_queue.process();
 
-    _last_update_us += (uint64_t) _timer.elapsed_time().count();
-    _timer.reset();
+    _last_update_us += elapsed_us;
 
     uint64_t last_update_ms = (_last_update_us / 1000);
     wsfTimerTicks_t wsf_ticks = (last_update_ms / WSF_MS_PER_TICK);
@@ -47,6 +47,40 @@
 
 #include "drivers/LowPowerTimer.h"
 
+/**
+ * Run the stack on a thread of its own rather than from the event queue
+ * servicing BLE::processEvents(). Events handlers are then called from that
+ * thread.
+ */
+#ifndef MBED_CONF_CORDIO_DEDICATED_THREAD
+#define MBED_CONF_CORDIO_DEDICATED_THREAD 0
+#endif
+
+// Priority of the stack thread
+#ifndef MBED_CONF_CORDIO_THREAD_PRIORITY
+#define MBED_CONF_CORDIO_THREAD_PRIORITY osPriorityAboveNormal
+#endif
+
+// Stack size of the stack thread
+#ifndef MBED_CONF_CORDIO_THREAD_STACK_SIZE
+#define MBED_CONF_CORDIO_THREAD_STACK_SIZE OS_STACK_SIZE
+#endif
+
+/**
+ * Maximum number of passes of the stack dispatcher for each wake up while
+ * events keep coming; the rest is left to the next wake up.
+ */
+#ifndef MBED_CONF_CORDIO_DISPATCH_BUDGET
+#define MBED_CONF_CORDIO_DISPATCH_BUDGET 1
+#endif
+
+#define CORDIO_DEDICATED_THREAD (MBED_CONF_RTOS_PRESENT && MBED_CONF_CORDIO_DEDICATED_THREAD)
+
+#if CORDIO_DEDICATED_THREAD
+#include "rtos/Thread.h"
+#include "rtos/ThisThread.h"
+#endif
+
 namespace ble {
 
 class PalSigningMonitor;
@@ -175,6 +209,21 @@ public:
      */
     void processEvents() final;
 
+    /**
+     * Wake up the stack, from the user event queue or from the stack thread.
+     */
+    void signalEventsToProcess() final;
+
+    /**
+     * @see ble::cordio_get_dispatch_stats
+     */
+    void getDispatchStats(dispatch_stats_t &stats) const;
+
+    /**
+     * @see ble::cordio_reset_dispatch_stats
+     */
+    void resetDispatchStats();
+
 private:
     static void stack_handler(wsfEventMask_t event, wsfMsgHdr_t *msg);
 
@@ -190,6 +239,12 @@ private:
 
     void callDispatcher();
 
+    void dispatch();
+
+#if CORDIO_DEDICATED_THREAD
+    void thread_loop();
+#endif
+
     static CordioHCIDriver *_hci_driver;
     static FunctionPointerWithContext<::BLE::InitializationCompleteCallbackContext *> _init_callback;
 
@@ -202,6 +257,15 @@ private:
     mutable ble::impl::PalEventQueue _event_queue;
     mbed::LowPowerTimer _timer;
     uint64_t _last_update_us;
+
+    // Time of the first signal not yet dispatched, on _timer
+    uint64_t _signal_time_us;
+    bool _signal_pending;
+    dispatch_stats_t _dispatch_stats;
+
+#if CORDIO_DEDICATED_THREAD
+    rtos::Thread _thread;
+#endif
 };
 
 } // namespace impl
@@ -57,6 +57,14 @@ static const uint8_t UPDATE_PROPERTIES =
 
 static const uint16_t CONNECTION_ID_LIMIT = 0x100;
 
+/*
+ * Report the traffic of a connection to the connection tuning of Gap.
+ */
+void record_traffic(connection_handle_t connection, uint16_t length, uint8_t backlog = 0)
+{
+    BLEInstanceBase::deviceInstance().getGapImpl().record_connection_traffic(connection, length, backlog);
+}
+
 } // end of anonymous namespace
 
 GattServer &GattServer::getInstance()
@@ -740,10 +748,12 @@ ble_error_t GattServer::write(
                 uint16_t cccd_config = AttsCccEnabled(conn_id, cccd_index);
                 if (cccd_config & ATT_CLIENT_CFG_NOTIFY) {
                     AttsHandleValueNtf(conn_id, att_handle, len, (uint8_t *) buffer);
+                    record_traffic(conn_id, len);
                     updates_sent++;
                 }
                 if (cccd_config & ATT_CLIENT_CFG_INDICATE) {
                     AttsHandleValueInd(conn_id, att_handle, len, (uint8_t *) buffer);
+                    record_traffic(conn_id, len);
                     updates_sent++;
                 }
             }
@@ -793,10 +803,12 @@ ble_error_t GattServer::write(
         uint16_t cccEnabled = AttsCccEnabled(connection, cccd_index);
         if (cccEnabled & ATT_CLIENT_CFG_NOTIFY) {
             AttsHandleValueNtf(connection, att_handle, len, (uint8_t *) buffer);
+            record_traffic(connection, len);
             updates_sent++;
         }
         if (cccEnabled & ATT_CLIENT_CFG_INDICATE) {
             AttsHandleValueInd(connection, att_handle, len, (uint8_t *) buffer);
+            record_traffic(connection, len);
             updates_sent++;
         }
     }
@@ -805,6 +817,114 @@ ble_error_t GattServer::write(
     return BLE_ERROR_NONE;
 }
 
+ble_error_t GattServer::queueNotification(
+    connection_handle_t connection,
+    GattAttribute::Handle_t att_handle,
+    const uint8_t *value,
+    uint16_t len
+)
+{
+    if (connection == DM_CONN_ID_NONE || connection > DM_CONN_MAX || !DmConnInUse(connection)) {
+        return BLE_ERROR_INVALID_STATE;
+    }
+
+    uint8_t cccd_index;
+    if (!get_cccd_index_by_value_handle(att_handle, cccd_index)) {
+        return BLE_ERROR_INVALID_PARAM;
+    }
+
+    if (len > AttGetMtu(connection) - ATT_VALUE_NTF_LEN) {
+        return BLE_ERROR_INVALID_PARAM;
+    }
+
+    if (!(AttsCccEnabled(connection, cccd_index) & ATT_CLIENT_CFG_NOTIFY) ||
+        !is_update_authorized(connection, att_handle)) {
+        return BLE_ERROR_INVALID_STATE;
+    }
+
+    notification_queue_t &queue = _notification_queues[connection - 1];
+    if (queue.count == MBED_CONF_BLE_API_IMPLEMENTATION_NOTIFICATION_QUEUE_SIZE) {
+        record_traffic(connection, 0, queue.count);
+        return BLE_ERROR_NO_MEM;
+    }
+
+    // The value is copied once, in the buffer the stack sends it from
+    uint8_t *buffer = (uint8_t *) AttMsgAlloc(len, ATT_PDU_VALUE_NTF);
+    if (!buffer) {
+        return BLE_ERROR_NO_MEM;
+    }
+    memcpy(buffer, value, len);
+
+    pending_notification_t &entry =
+        queue.entries[(queue.head + queue.count) % MBED_CONF_BLE_API_IMPLEMENTATION_NOTIFICATION_QUEUE_SIZE];
+    entry.value = buffer;
+    entry.handle = att_handle;
+    entry.length = len;
+    queue.count++;
+
+    if (!queue.in_flight) {
+        send_next_notification(connection);
+    }
+
+    return BLE_ERROR_NONE;
+}
+
+void GattServer::send_next_notification(connection_handle_t connection)
+{
+    notification_queue_t &queue = _notification_queues[connection - 1];
+    if (!queue.count) {
+        return;
+    }
+
+    pending_notification_t entry = queue.entries[queue.head];
+    queue.head = (queue.head + 1) % MBED_CONF_BLE_API_IMPLEMENTATION_NOTIFICATION_QUEUE_SIZE;
+    queue.count--;
+
+    // set before sending, the confirmation may be reported from within the call
+    queue.in_flight = entry.handle;
+    AttsHandleValueNtfZeroCpy(connection, entry.handle, entry.length, entry.value);
+    record_traffic(connection, entry.length, queue.count);
+}
+
+void GattServer::on_value_confirmation(connection_handle_t connection, GattAttribute::Handle_t value_handle)
+{
+    if (connection == DM_CONN_ID_NONE || connection > DM_CONN_MAX) {
+        return;
+    }
+
+    notification_queue_t &queue = _notification_queues[connection - 1];
+    if (queue.in_flight && queue.in_flight == value_handle) {
+        queue.in_flight = 0;
+        send_next_notification(connection);
+    }
+}
+
+void GattServer::drop_notifications(connection_handle_t connection, GattAttribute::Handle_t value_handle)
+{
+    if (connection == DM_CONN_ID_NONE || connection > DM_CONN_MAX) {
+        return;
+    }
+
+    notification_queue_t &queue = _notification_queues[connection - 1];
+    uint8_t kept = 0;
+    for (uint8_t i = 0; i < queue.count; i++) {
+        pending_notification_t &entry =
+            queue.entries[(queue.head + i) % MBED_CONF_BLE_API_IMPLEMENTATION_NOTIFICATION_QUEUE_SIZE];
+        if (value_handle && entry.handle != value_handle) {
+            queue.entries[(queue.head + kept) % MBED_CONF_BLE_API_IMPLEMENTATION_NOTIFICATION_QUEUE_SIZE] = entry;
+            kept++;
+        } else {
+            AttMsgFree(entry.value, ATT_PDU_VALUE_NTF);
+        }
+    }
+    queue.count = kept;
+
+    // the stack owns the buffer in flight and reports it, or drops it with the link
+    if (!value_handle) {
+        queue.in_flight = 0;
+    }
+}
+
 ble_error_t GattServer::areUpdatesEnabled(
     const GattCharacteristic &characteristic,
     bool *enabled
@@ -967,6 +1087,10 @@ ble_error_t GattServer::reset(ble::GattServer* server)
     _auth_callbacks_count = 0;
     _auth_callbacks = nullptr;
 
+    for (dmConnId_t conn_id = 1; conn_id <= DM_CONN_MAX; conn_id++) {
+        drop_notifications(conn_id);
+    }
+
     AttsCccRegister(cccd_cnt, (attsCccSet_t *) cccds, cccd_cb);
 
     return BLE_ERROR_NONE;
@@ -979,6 +1103,13 @@ void GattServer::cccd_cb(attsCccEvt_t *evt)
             GattServerEvents::GATT_EVENT_UPDATES_ENABLED :
             GattServerEvents::GATT_EVENT_UPDATES_DISABLED;
 
+    if (!(evt->value & ATT_CLIENT_CFG_NOTIFY)) {
+        GattServer &server = getInstance();
+        if (evt->idx < server.cccd_cnt) {
+            server.drop_notifications(evt->hdr.param, server.cccd_handles[evt->idx]);
+        }
+    }
+
     getInstance().handleEvent(evt_type, evt->hdr.param, evt->handle);
 }
 
@@ -989,8 +1120,12 @@ void GattServer::att_cb(const attEvt_t *evt)
         if (handler) {
             handler->onAttMtuChange(evt->hdr.param, evt->mtu);
         }
-    } else if (evt->hdr.status == ATT_SUCCESS && evt->hdr.event == ATTS_HANDLE_VALUE_CNF) {
-        getInstance().handleEvent(GattServerEvents::GATT_EVENT_DATA_SENT, evt->hdr.param, evt->handle);
+    } else if (evt->hdr.event == ATTS_HANDLE_VALUE_CNF) {
+        if (evt->hdr.status == ATT_SUCCESS) {
+            getInstance().handleEvent(GattServerEvents::GATT_EVENT_DATA_SENT, evt->hdr.param, evt->handle);
+        }
+        // a queued notification has left the stack, whatever the status
+        getInstance().on_value_confirmation(evt->hdr.param, evt->handle);
     }
 }
 
@@ -1112,6 +1247,8 @@ uint8_t GattServer::atts_write_cb(
             break;
     }
 
+    record_traffic(connId, len);
+
     if (write_happened) {
         GattWriteCallbackParams write_params = {
             connId,
@@ -1453,6 +1590,7 @@ GattServer::GattServer() :
     cccd_values(),
     cccd_handles(),
     cccd_cnt(0),
+    _notification_queues(),
     _auth_callbacks(nullptr),
     _auth_callbacks_count(0),
     generic_access_service(),
@@ -102,6 +102,13 @@ public:
         bool localOnly = false
     );
 
+    ble_error_t queueNotification(
+        ble::connection_handle_t connectionHandle,
+        GattAttribute::Handle_t attributeHandle,
+        const uint8_t *value,
+        uint16_t size
+    );
+
     ble_error_t areUpdatesEnabled(
         const GattCharacteristic &characteristic,
         bool *enabledP
@@ -215,6 +222,11 @@ public:
 
     static uint8_t atts_auth_cb(dmConnId_t connId, uint8_t permit, uint16_t handle);
 
+    /**
+     * Drop the notifications queued for a connection, when it closes.
+     */
+    void drop_notifications(connection_handle_t connection, GattAttribute::Handle_t value_handle = 0);
+
     void set_signing_event_handler(
         PalSigningMonitorEventHandler *signing_event_handler
     ) override;
@@ -295,6 +307,10 @@ private:
 
     bool is_update_authorized(connection_handle_t connection, GattAttribute::Handle_t value_handle);
 
+    void send_next_notification(connection_handle_t connection);
+
+    void on_value_confirmation(connection_handle_t connection, GattAttribute::Handle_t value_handle);
+
     struct alloc_block_t {
         alloc_block_t *next;
         uint8_t data[1];
@@ -305,6 +321,20 @@ private:
         internal_service_t *next;
     };
 
+    struct pending_notification_t {
+        uint8_t *value;     // allocated with AttMsgAlloc()
+        uint16_t handle;
+        uint16_t length;
+    };
+
+    struct notification_queue_t {
+        pending_notification_t entries[MBED_CONF_BLE_API_IMPLEMENTATION_NOTIFICATION_QUEUE_SIZE];
+        uint8_t head;
+        uint8_t count;
+        // handle of the notification passed to the stack, 0 if none
+        uint16_t in_flight;
+    };
+
 private:
     /**
      * Event handler provided by the application.
@@ -367,6 +397,9 @@ private:
     uint16_t cccd_handles[MBED_CONF_BLE_API_IMPLEMENTATION_MAX_CCCD_COUNT];
     uint8_t cccd_cnt;
 
+    // indexed by connection ID - 1
+    notification_queue_t _notification_queues[DM_CONN_MAX];
+
     char_auth_callback *_auth_callbacks;
     uint8_t _auth_callbacks_count;
 
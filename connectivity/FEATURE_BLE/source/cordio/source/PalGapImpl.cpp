@@ -470,6 +470,17 @@ ble_error_t PalGap::disconnect(
     return BLE_ERROR_NONE;
 }
 
+
+ble_error_t PalGap::set_data_length(
+    connection_handle_t connection,
+    uint16_t tx_octets,
+    uint16_t tx_time
+)
+{
+    DmConnSetDataLen(connection, tx_octets, tx_time);
+    return BLE_ERROR_NONE;
+}
+
 #endif // BLE_FEATURE_CONNECTABLE
 
 #if BLE_FEATURE_PHY_MANAGEMENT
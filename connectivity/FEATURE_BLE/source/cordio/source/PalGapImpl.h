@@ -155,6 +155,12 @@ public:
         connection_handle_t connection,
         local_disconnection_reason_t disconnection_reason
     ) final;
+
+    ble_error_t set_data_length(
+        connection_handle_t connection,
+        uint16_t tx_octets,
+        uint16_t tx_time
+    ) final;
 #endif // BLE_FEATURE_CONNECTABLE
 
 #if BLE_FEATURE_PHY_MANAGEMENT
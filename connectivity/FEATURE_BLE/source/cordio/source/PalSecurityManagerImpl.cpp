@@ -56,15 +56,18 @@ ble_error_t PalSecurityManager::initialize()
     _default_passkey = 0;
 #if BLE_FEATURE_SECURE_CONNECTIONS
     _lesc_keys_generated = false;
+#if MBED_CONF_BLE_API_IMPLEMENTATION_LESC_KEY_ROTATION
+    _next_lesc_keys_ready = false;
+#endif
 #endif // BLE_FEATURE_SECURE_CONNECTIONS
 #if BLE_FEATURE_SIGNING
     memset(_peer_csrks, 0, sizeof(_peer_csrks));
 #endif
 
-#if 0
-    // FIXME: need help from the stack or local calculation
-    // generate a new set of keys
-    DmSecGenerateEccKeyReq();
+#if BLE_FEATURE_SECURE_CONNECTIONS
+    // The stack computes the key pair in its event loop, so that it is
+    // ready before the first pairing rather than computed during it
+    generate_lesc_keys();
 #endif
 
     return BLE_ERROR_NONE;
@@ -89,6 +92,41 @@ ble_error_t PalSecurityManager::reset()
     return BLE_ERROR_NONE;
 }
 
+#if BLE_FEATURE_SECURE_CONNECTIONS
+void PalSecurityManager::generate_lesc_keys()
+{
+    // a single request at a time, the stack reports each with DM_SEC_ECC_KEY_IND
+    if (_lesc_keys_pending) {
+        return;
+    }
+    _lesc_keys_pending = true;
+    DmSecGenerateEccKeyReq();
+}
+
+
+void PalSecurityManager::install_lesc_keys(const secEccKey_t &key)
+{
+    DmSecSetEccKey(const_cast<secEccKey_t *>(&key));
+    memcpy(_public_key_x, key.pubKey_x, sizeof(_public_key_x));
+    _lesc_keys_generated = true;
+}
+
+
+void PalSecurityManager::rotate_lesc_keys()
+{
+#if MBED_CONF_BLE_API_IMPLEMENTATION_LESC_KEY_ROTATION
+    // The spec recommends a new key pair for each pairing. Once the
+    // precomputed one is used, the next one is generated while the link is
+    // idle. OOB data generated before the switch is no longer valid.
+    if (_next_lesc_keys_ready) {
+        _next_lesc_keys_ready = false;
+        install_lesc_keys(_next_lesc_keys);
+    }
+    generate_lesc_keys();
+#endif
+}
+#endif // BLE_FEATURE_SECURE_CONNECTIONS
+
 ////////////////////////////////////////////////////////////////////////////
 // Feature support
 //
@@ -555,12 +593,18 @@ bool PalSecurityManager::sm_handler(const wsfMsgHdr_t *msg)
             auto *evt = (dmSecPairCmplIndEvt_t *) msg;
             // Note: authentication and bonding flags present in the auth field
             handler->on_pairing_completed(evt->hdr.param);
+#if BLE_FEATURE_SECURE_CONNECTIONS
+            self.rotate_lesc_keys();
+#endif
             return true;
         }
 
         case DM_SEC_PAIR_FAIL_IND: {
             connection_handle_t connection = msg->param;
             uint8_t status = msg->status;
+#if BLE_FEATURE_SECURE_CONNECTIONS
+            self.rotate_lesc_keys();
+#endif
 
             if (status >= pairing_failure_t::PASSKEY_ENTRY_FAILED &&
                 status <= pairing_failure_t::CROSS_TRANSPORT_KEY_DERIVATION_OR_GENERATION_NOT_ALLOWED) {
@@ -752,9 +796,19 @@ bool PalSecurityManager::sm_handler(const wsfMsgHdr_t *msg)
 
         case DM_SEC_ECC_KEY_IND: {
             auto *evt = (secEccMsg_t *) msg;
-            DmSecSetEccKey(&evt->data.key);
-            memcpy(self._public_key_x, evt->data.key.pubKey_x, sizeof(self._public_key_x));
-            self._lesc_keys_generated = true;
+            self._lesc_keys_pending = false;
+#if MBED_CONF_BLE_API_IMPLEMENTATION_LESC_KEY_ROTATION
+            if (self._lesc_keys_generated) {
+                // keep it for the pairing after the current key pair's
+                self._next_lesc_keys = evt->data.key;
+                self._next_lesc_keys_ready = true;
+                return true;
+            }
+            self.install_lesc_keys(evt->data.key);
+            self.generate_lesc_keys();
+#else
+            self.install_lesc_keys(evt->data.key);
+#endif
             return true;
         }
 
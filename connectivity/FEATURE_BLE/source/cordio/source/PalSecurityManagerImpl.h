@@ -329,13 +329,28 @@ private:
     void cleanup_peer_csrks();
 #endif // BLE_FEATURE_SIGNING
 
+#if BLE_FEATURE_SECURE_CONNECTIONS
+    void generate_lesc_keys();
+
+    void install_lesc_keys(const secEccKey_t &key);
+
+    void rotate_lesc_keys();
+#endif // BLE_FEATURE_SECURE_CONNECTIONS
+
     PalSecurityManagerEventHandler *_pal_event_handler;
 
     bool _use_default_passkey;
     passkey_num_t _default_passkey;
 #if BLE_FEATURE_SECURE_CONNECTIONS
     bool _lesc_keys_generated = false;
+    // a key pair generation is running in the stack
+    bool _lesc_keys_pending = false;
     uint8_t _public_key_x[SEC_ECC_KEY_LEN] = {0};
+#if MBED_CONF_BLE_API_IMPLEMENTATION_LESC_KEY_ROTATION
+    // key pair generated ahead of the next pairing
+    bool _next_lesc_keys_ready = false;
+    secEccKey_t _next_lesc_keys;
+#endif
 #endif // BLE_FEATURE_SECURE_CONNECTIONS
     irk_t _irk;
 #if BLE_FEATURE_SIGNING
@@ -239,11 +239,18 @@ void hciTrSerialRxIncoming(uint8_t *pBuf, uint8_t len)
     /* --- Data State --- */
     else if (stateRx == HCI_RX_STATE_DATA)
     {
-      /* write incoming byte to allocated buffer */
+      /* PORTING: copy as much of the payload as the incoming buffer holds at once */
+      uint16_t cpyLen = (iRx - 1 < len) ? iRx - 1 : len;
+
+      /* write incoming bytes to allocated buffer */
       *pDataRx++ = dataByte;
+      memcpy(pDataRx, pBuf, cpyLen);
+      pDataRx += cpyLen;
+      pBuf += cpyLen;
+      len -= cpyLen;
 
       /* determine if entire packet has been read */
-      iRx--;
+      iRx -= cpyLen + 1;
       if (iRx == 0)
       {
         stateRx = HCI_RX_STATE_COMPLETE;
@@ -129,6 +129,37 @@ bool is_preferred_connection_params_valid(const Gap::PreferredConnectionParams_t
 
     return true;
 }
+
+/* Traffic demand measured on a connection, over a tuning period */
+enum : uint8_t {
+    demand_idle,
+    demand_low,
+    demand_high,
+    demand_unknown
+};
+
+struct connection_tuning_profile_t {
+    uint16_t interval_min;
+    uint16_t interval_max;
+    uint16_t latency;
+    uint16_t supervision_timeout;
+};
+
+/*
+ * Connection parameters used by each connection_tuning_policy_t for each
+ * demand. Intervals are in 1.25 ms, supervision timeouts in 10 ms and above
+ * (1 + latency) * interval_max * 2.
+ */
+const connection_tuning_profile_t connection_tuning_profiles[3][3] = {
+    /* LATENCY: 30-50 ms, 15-30 ms, 7.5-15 ms */
+    { { 24, 40, 0, 400 }, { 12, 24, 0, 400 }, { 6, 12, 0, 400 } },
+    /* THROUGHPUT: 50-100 ms, 20-40 ms, 7.5-15 ms */
+    { { 40, 80, 0, 400 }, { 16, 32, 0, 400 }, { 6, 12, 0, 400 } },
+    /* POWER: 400-500 ms latency 4, 100-150 ms latency 2, 30-50 ms */
+    { { 320, 400, 4, 600 }, { 80, 120, 2, 600 }, { 24, 40, 0, 600 } }
+};
+
+const uint16_t connection_tuning_data_length = 251;
 #endif // BLE_FEATURE_CONNECTABLE
 
 /**
@@ -510,6 +541,7 @@ ble_error_t Gap::stopScan()
     }
 
     _scan_timeout.detach();
+    flush_advertising_reports();
 
     return BLE_ERROR_NONE;
 }
@@ -854,6 +886,148 @@ ble_error_t Gap::disconnect(
 {
     return _pal_gap.disconnect(connectionHandle, reason);
 }
+
+
+ble_error_t Gap::setConnectionTuningPolicy(connection_tuning_policy_t policy)
+{
+    _connection_tuning_ticker.detach();
+    _connection_tuning_policy = policy;
+
+    // the next period applies the parameters of the demand measured
+    for (ConnectionTuning &tuning : _connection_tuning) {
+        tuning.demand = demand_unknown;
+        tuning.lower_periods = 0;
+        tuning.max_backlog = 0;
+        tuning.bytes = 0;
+    }
+
+    if (policy != connection_tuning_policy_t::NONE) {
+        _connection_tuning_ticker.attach(
+            [this]() { _event_queue.post([this] { tune_connections(); }); },
+            milliseconds(MBED_CONF_BLE_API_IMPLEMENTATION_CONNECTION_TUNING_PERIOD)
+        );
+    }
+
+    return BLE_ERROR_NONE;
+}
+
+
+void Gap::record_connection_traffic(
+    connection_handle_t connection,
+    uint16_t length,
+    uint8_t backlog
+)
+{
+    if (_connection_tuning_policy == connection_tuning_policy_t::NONE) {
+        return;
+    }
+
+    ConnectionTuning *tuning = get_connection_tuning(connection);
+    if (!tuning) {
+        return;
+    }
+
+    tuning->bytes += length;
+    tuning->max_backlog = std::max(tuning->max_backlog, backlog);
+}
+
+
+Gap::ConnectionTuning *Gap::get_connection_tuning(connection_handle_t connection)
+{
+    for (ConnectionTuning &tuning : _connection_tuning) {
+        if (tuning.in_use && tuning.handle == connection) {
+            return &tuning;
+        }
+    }
+    return nullptr;
+}
+
+
+void Gap::tune_connections()
+{
+    if (_connection_tuning_policy == connection_tuning_policy_t::NONE) {
+        return;
+    }
+
+    for (ConnectionTuning &tuning : _connection_tuning) {
+        if (!tuning.in_use) {
+            continue;
+        }
+
+        uint8_t demand = demand_low;
+        if (!tuning.bytes && !tuning.max_backlog) {
+            demand = demand_idle;
+        } else if (tuning.max_backlog > 1 ||
+            tuning.bytes * 1000 >= (uint32_t) MBED_CONF_BLE_API_IMPLEMENTATION_CONNECTION_TUNING_HIGH_RATE *
+            MBED_CONF_BLE_API_IMPLEMENTATION_CONNECTION_TUNING_PERIOD) {
+            demand = demand_high;
+        }
+        tuning.bytes = 0;
+        tuning.max_backlog = 0;
+
+        if (demand == tuning.demand) {
+            tuning.lower_periods = 0;
+            continue;
+        }
+
+        // rise at once, fall once the lower demand held for a while
+        if (tuning.demand != demand_unknown && demand < tuning.demand &&
+            ++tuning.lower_periods < MBED_CONF_BLE_API_IMPLEMENTATION_CONNECTION_TUNING_HOLD) {
+            continue;
+        }
+
+        if (apply_connection_tuning(tuning, demand)) {
+            tuning.lower_periods = 0;
+        }
+    }
+}
+
+
+bool Gap::apply_connection_tuning(ConnectionTuning &tuning, uint8_t demand)
+{
+    // a procedure in progress, try again next period
+    if (tuning.update_pending) {
+        return false;
+    }
+
+    const connection_tuning_profile_t &profile =
+        connection_tuning_profiles[_connection_tuning_policy.value() - 1][demand];
+    ble_error_t err = _pal_gap.connection_parameters_update(
+        tuning.handle,
+        profile.interval_min,
+        profile.interval_max,
+        profile.latency,
+        profile.supervision_timeout,
+        /* minimum_connection_event_length */ 0,
+        /* maximum_connection_event_length */ 0
+    );
+    if (err) {
+        return false;
+    }
+    tuning.update_pending = true;
+    tuning.demand = demand;
+
+    // fewer, shorter packets for the same data, whatever the bias
+    if (demand == demand_high && !tuning.link_upgraded) {
+        tuning.link_upgraded = true;
+        if (_pal_gap.is_feature_supported(controller_supported_features_t::LE_DATA_PACKET_LENGTH_EXTENSION)) {
+            _pal_gap.set_data_length(
+                tuning.handle,
+                connection_tuning_data_length,
+                /* transmit time on the 1M PHY, in us */
+                (connection_tuning_data_length + 14) * 8
+            );
+        }
+#if BLE_FEATURE_PHY_MANAGEMENT
+        if (_pal_gap.is_feature_supported(controller_supported_features_t::LE_2M_PHY)) {
+            phy_set_t phys(/* 1M */ false, /* 2M */ true, /* coded */ false);
+            _pal_gap.set_phy(tuning.handle, phys, phys, coded_symbol_per_bit_t::UNDEFINED);
+        }
+#endif // BLE_FEATURE_PHY_MANAGEMENT
+    }
+
+    return true;
+}
 #endif // BLE_FEATURE_CONNECTABLE
 
 #if BLE_FEATURE_WHITELIST
@@ -1093,8 +1267,22 @@ ble_error_t Gap::reset()
 
 #if BLE_ROLE_OBSERVER
     _scan_timeout.detach();
+    delete[] _report_hashes;
+    _report_hashes = nullptr;
+    free(_report_batch);
+    _report_batch = nullptr;
+    _report_batch_count = 0;
+    _report_filter = AdvertisingReportFilter();
 #endif
 
+#if BLE_FEATURE_CONNECTABLE
+    _connection_tuning_ticker.detach();
+    _connection_tuning_policy = connection_tuning_policy_t::NONE;
+    for (ConnectionTuning &tuning : _connection_tuning) {
+        tuning = ConnectionTuning();
+    }
+#endif // BLE_FEATURE_CONNECTABLE
+
 #if BLE_ROLE_BROADCASTER
 #if BLE_FEATURE_EXTENDED_ADVERTISING
     if (is_extended_advertising_available()) {
@@ -1249,6 +1437,7 @@ void Gap::on_scan_timeout()
 
     _scan_state = ScanState::idle;
     _scan_requested = false;
+    flush_advertising_reports();
 
     if (_event_handler) {
         _event_handler->onScanTimeout(ScanTimeoutEvent());
@@ -1421,6 +1610,16 @@ void Gap::on_connection_complete(const GapConnectionCompleteEvent &e)
     }
 #endif // BLE_ROLE_PERIPHERAL
 
+    for (ConnectionTuning &tuning : _connection_tuning) {
+        if (!tuning.in_use) {
+            tuning = ConnectionTuning();
+            tuning.handle = e.connection_handle;
+            tuning.in_use = true;
+            tuning.demand = demand_unknown;
+            break;
+        }
+    }
+
     ConnectionCompleteEvent event(
         BLE_ERROR_NONE,
         e.connection_handle,
@@ -1445,6 +1644,11 @@ void Gap::on_connection_complete(const GapConnectionCompleteEvent &e)
 void Gap::on_disconnection_complete(const GapDisconnectionCompleteEvent &e)
 {
     if (e.status == hci_error_code_t::SUCCESS) {
+        ConnectionTuning *tuning = get_connection_tuning(e.connection_handle);
+        if (tuning) {
+            tuning->in_use = false;
+        }
+
         // signal internal stack
         if (_connection_event_handler) {
             _connection_event_handler->on_disconnected(
@@ -1498,6 +1702,11 @@ void Gap::on_connection_parameter_request(const GapRemoteConnectionParameterRequ
 
 void Gap::on_connection_update(const GapConnectionUpdateEvent &e)
 {
+    ConnectionTuning *tuning = get_connection_tuning(e.connection_handle);
+    if (tuning) {
+        tuning->update_pending = false;
+    }
+
     if (!_event_handler) {
         return;
     }
@@ -2617,6 +2826,10 @@ void Gap::signal_advertising_report(
     AdvertisingReportEvent& event
 )
 {
+    if (!is_advertising_report_accepted(event)) {
+        return;
+    }
+
 #if BLE_FEATURE_PRIVACY
 #if BLE_GAP_HOST_BASED_PRIVATE_ADDRESS_RESOLUTION
     bool address_resolved = false;
@@ -2706,10 +2919,179 @@ void Gap::signal_advertising_report(
     }
 #endif // BLE_GAP_HOST_BASED_PRIVATE_ADDRESS_RESOLUTION
 #endif // BLE_FEATURE_PRIVACY
-    _event_handler->onAdvertisingReport(
-        event
+    dispatch_advertising_report(event);
+}
+
+bool Gap::is_advertising_report_accepted(const AdvertisingReportEvent &event) const
+{
+    /* 127 is a report without RSSI */
+    if (event.getRssi() != 127 && event.getRssi() < _report_filter.getMinRssi()) {
+        return false;
+    }
+
+    const UUID &uuid = _report_filter.getServiceUuid();
+    if (uuid.shortOrLong() == UUID::UUID_TYPE_SHORT && uuid.getShortUUID() == BLE_UUID_UNKNOWN) {
+        return true;
+    }
+
+    AdvertisingDataParser parser(event.getPayload());
+    while (parser.hasNext()) {
+        AdvertisingDataParser::element_t element = parser.next();
+        const mbed::Span<const uint8_t> &value = element.value;
+
+        if (uuid.shortOrLong() == UUID::UUID_TYPE_SHORT &&
+            (element.type == adv_data_type_t::INCOMPLETE_LIST_16BIT_SERVICE_IDS ||
+             element.type == adv_data_type_t::COMPLETE_LIST_16BIT_SERVICE_IDS)) {
+            for (ptrdiff_t i = 0; i + 1 < value.size(); i += 2) {
+                if (((value[i + 1] << 8) | value[i]) == uuid.getShortUUID()) {
+                    return true;
+                }
+            }
+        } else if (uuid.shortOrLong() == UUID::UUID_TYPE_LONG &&
+            (element.type == adv_data_type_t::INCOMPLETE_LIST_128BIT_SERVICE_IDS ||
+             element.type == adv_data_type_t::COMPLETE_LIST_128BIT_SERVICE_IDS)) {
+            const ptrdiff_t uuid_size = UUID::LENGTH_OF_LONG_UUID;
+            for (ptrdiff_t i = 0; i + uuid_size <= value.size(); i += uuid_size) {
+                if (memcmp(value.data() + i, uuid.getBaseUUID(), uuid_size) == 0) {
+                    return true;
+                }
+            }
+        }
+    }
+
+    return false;
+}
+
+bool Gap::is_duplicate_advertising_report(const AdvertisingReportEvent &event)
+{
+    /* FNV-1a over the peer and the payload */
+    uint32_t hash = 2166136261u;
+    auto mix = [&hash](const uint8_t *data, size_t size) {
+        for (size_t i = 0; i < size; i++) {
+            hash = (hash ^ data[i]) * 16777619u;
+        }
+    };
+    const uint8_t address_type = event.getPeerAddressType().value();
+    mix(&address_type, sizeof(address_type));
+    mix(event.getPeerAddress().data(), event.getPeerAddress().size());
+    mix(event.getPayload().data(), event.getPayload().size());
+    if (hash == 0) {
+        hash = 1;
+    }
+
+    const size_t size = MBED_CONF_BLE_API_IMPLEMENTATION_ADVERTISING_REPORT_DEDUP_SIZE;
+    for (size_t i = 0; i < size; i++) {
+        uint32_t &slot = _report_hashes[(hash + i) % size];
+        if (slot == hash) {
+            return true;
+        }
+        if (slot == 0) {
+            slot = hash;
+            return false;
+        }
+    }
+
+    /* the set is full, start over with this report */
+    memset(_report_hashes, 0, size * sizeof(uint32_t));
+    _report_hashes[hash % size] = hash;
+    return false;
+}
+
+uint8_t Gap::get_advertising_report_batch_size() const
+{
+    return std::min<uint8_t>(
+        _report_filter.getBatchSize(),
+        MBED_CONF_BLE_API_IMPLEMENTATION_ADVERTISING_REPORT_BATCH_SIZE
     );
 }
+
+void Gap::dispatch_advertising_report(const AdvertisingReportEvent &event)
+{
+    if (!_report_filter.isPeerAddressAccepted(event.getPeerAddress())) {
+        return;
+    }
+
+    if (_report_hashes && is_duplicate_advertising_report(event)) {
+        return;
+    }
+
+    const mbed::Span<const uint8_t> &payload = event.getPayload();
+    if (!_report_batch || payload.size() > MBED_CONF_BLE_API_IMPLEMENTATION_ADVERTISING_REPORT_BATCH_PAYLOAD_SIZE) {
+        /* keep the reports in order */
+        flush_advertising_reports();
+        if (_event_handler) {
+            _event_handler->onAdvertisingReport(event);
+        }
+        return;
+    }
+
+    const uint8_t batch_size = get_advertising_report_batch_size();
+    auto *events = reinterpret_cast<AdvertisingReportEvent *>(_report_batch);
+    uint8_t *payload_copy = _report_batch + batch_size * sizeof(AdvertisingReportEvent) +
+        _report_batch_count * MBED_CONF_BLE_API_IMPLEMENTATION_ADVERTISING_REPORT_BATCH_PAYLOAD_SIZE;
+
+    memcpy(payload_copy, payload.data(), payload.size());
+    AdvertisingReportEvent *copy = new(&events[_report_batch_count]) AdvertisingReportEvent(event);
+    copy->setAdvertisingData(mbed::make_const_Span(payload_copy, payload.size()));
+
+    if (++_report_batch_count == batch_size) {
+        flush_advertising_reports();
+    }
+}
+
+void Gap::flush_advertising_reports()
+{
+    if (!_report_batch_count) {
+        return;
+    }
+
+    const uint8_t count = _report_batch_count;
+    _report_batch_count = 0;
+
+    if (_event_handler) {
+        _event_handler->onAdvertisingReports(mbed::make_const_Span(
+            reinterpret_cast<const AdvertisingReportEvent *>(_report_batch),
+            count
+        ));
+    }
+}
+
+ble_error_t Gap::setAdvertisingReportFilter(const AdvertisingReportFilter &filter)
+{
+    if (_scan_state != ScanState::idle) {
+        return BLE_ERROR_INVALID_STATE;
+    }
+
+    delete[] _report_hashes;
+    _report_hashes = nullptr;
+    free(_report_batch);
+    _report_batch = nullptr;
+    _report_batch_count = 0;
+    _report_filter = filter;
+
+    if (filter.isDeduplicationEnabled()) {
+        _report_hashes = new(std::nothrow) uint32_t[MBED_CONF_BLE_API_IMPLEMENTATION_ADVERTISING_REPORT_DEDUP_SIZE]();
+        if (!_report_hashes) {
+            _report_filter = AdvertisingReportFilter();
+            return BLE_ERROR_NO_MEM;
+        }
+    }
+
+    const uint8_t batch_size = get_advertising_report_batch_size();
+    if (batch_size > 1) {
+        _report_batch = (uint8_t *) malloc(batch_size * (
+            sizeof(AdvertisingReportEvent) + MBED_CONF_BLE_API_IMPLEMENTATION_ADVERTISING_REPORT_BATCH_PAYLOAD_SIZE
+        ));
+        if (!_report_batch) {
+            delete[] _report_hashes;
+            _report_hashes = nullptr;
+            _report_filter = AdvertisingReportFilter();
+            return BLE_ERROR_NO_MEM;
+        }
+    }
+
+    return BLE_ERROR_NONE;
+}
 #endif //BLE_ROLE_OBSERVER
 
 #if BLE_FEATURE_PRIVACY && BLE_GAP_HOST_BASED_PRIVATE_ADDRESS_RESOLUTION
@@ -2749,7 +3131,7 @@ void Gap::conclude_signal_advertising_report_after_address_resolution(
         return;
     }
 
-    _event_handler->onAdvertisingReport(event);
+    dispatch_advertising_report(event);
 }
 #endif // BLE_ROLE_OBSERVER
 #endif // BLE_FEATURE_PRIVACY && BLE_GAP_HOST_BASED_PRIVATE_ADDRESS_RESOLUTION
@@ -2938,6 +3320,11 @@ void Gap::on_connection_update_complete(
     uint16_t supervision_timeout
 )
 {
+    ConnectionTuning *tuning = get_connection_tuning(connection_handle);
+    if (tuning) {
+        tuning->update_pending = false;
+    }
+
     if (!_event_handler) {
         return;
     }
@@ -3057,6 +3444,9 @@ ble_error_t Gap::startScan(
 
     /* only initiate scan if we're not already busy */
     if (_scan_state == ScanState::idle) {
+        if (_report_hashes) {
+            memset(_report_hashes, 0, MBED_CONF_BLE_API_IMPLEMENTATION_ADVERTISING_REPORT_DEDUP_SIZE * sizeof(uint32_t));
+        }
         ble_error_t ret = initiate_scan();
         if (ret != BLE_ERROR_NONE) {
             return ret;
@@ -35,6 +35,7 @@
 #include "ble/gap/ScanParameters.h"
 #include "ble/gap/AdvertisingParameters.h"
 #include "ble/gap/Events.h"
+#include "ble/gap/AdvertisingReportFilter.h"
 
 #include "source/pal/PalGap.h"
 #include "source/pal/PalConnectionMonitor.h"
@@ -186,6 +187,8 @@ public:
 
     ble_error_t stopScan();
 
+    ble_error_t setAdvertisingReportFilter(const AdvertisingReportFilter &filter);
+
 #endif // BLE_ROLE_OBSERVER
 
 #if BLE_ROLE_OBSERVER
@@ -274,6 +277,8 @@ public:
         local_disconnection_reason_t reason
     );
 
+    ble_error_t setConnectionTuningPolicy(connection_tuning_policy_t policy);
+
 #endif // BLE_FEATURE_CONNECTABLE
 #if BLE_FEATURE_PHY_MANAGEMENT
 
@@ -359,6 +364,19 @@ public:
 
     ble::address_t getRandomStaticAddress();
 
+#if BLE_FEATURE_CONNECTABLE
+    /*
+     * API reserved for GATT to report the traffic of a connection to the
+     * connection tuning policy: the bytes sent or received, and the
+     * notifications still queued.
+     */
+    void record_connection_traffic(
+        connection_handle_t connection,
+        uint16_t length,
+        uint8_t backlog
+    );
+#endif // BLE_FEATURE_CONNECTABLE
+
 #endif // !defined(DOXYGEN_ONLY)
 
     /* ===================================================================== */
@@ -590,6 +608,14 @@ private:
     );
 
     void on_connection_update(const GapConnectionUpdateEvent &e);
+
+    struct ConnectionTuning;
+
+    ConnectionTuning *get_connection_tuning(connection_handle_t connection);
+
+    void tune_connections();
+
+    bool apply_connection_tuning(ConnectionTuning &tuning, uint8_t demand);
 #endif // BLE_FEATURE_CONNECTABLE
 
     void on_unexpected_error(const GapUnexpectedErrorEvent &e);
@@ -676,6 +702,26 @@ private:
      */
     void signal_advertising_report(AdvertisingReportEvent& report);
 
+    /** Check the report against the RSSI and service filters, which do not
+     * depend on the address resolution.
+     */
+    bool is_advertising_report_accepted(const AdvertisingReportEvent &report) const;
+
+    /** Check if the peer already sent this payload since the scan started
+     * and record it otherwise.
+     */
+    bool is_duplicate_advertising_report(const AdvertisingReportEvent &report);
+
+    /** Pass the report to the application after the address filter, either
+     * alone or in a batch.
+     */
+    void dispatch_advertising_report(const AdvertisingReportEvent &report);
+
+    /** Pass the batched reports to the application. */
+    void flush_advertising_reports();
+
+    uint8_t get_advertising_report_batch_size() const;
+
 #if BLE_FEATURE_PRIVACY && BLE_GAP_HOST_BASED_PRIVATE_ADDRESS_RESOLUTION
     /** Pass the advertising report to the application after privacy resolution completed.
      *
@@ -913,6 +959,13 @@ private:
 
     bool _scan_requested = false;
 
+    AdvertisingReportFilter _report_filter;
+    /* hashes of the reports seen since the scan started, 0 marks a free slot */
+    uint32_t *_report_hashes = nullptr;
+    /* batched events, followed by the copies of their payloads */
+    uint8_t *_report_batch = nullptr;
+    uint8_t _report_batch_count = 0;
+
 #if BLE_GAP_HOST_BASED_PRIVATE_ADDRESS_RESOLUTION
     enum class ConnectionToHostResolvedAddressState : uint8_t {
         idle,
@@ -929,6 +982,28 @@ private:
     mbed::LowPowerTimeout _scan_timeout;
     mbed::LowPowerTicker _address_rotation_ticker;
 
+#if BLE_FEATURE_CONNECTABLE
+    struct ConnectionTuning {
+        connection_handle_t handle;
+        bool in_use;
+        /* waiting for the result of a connection update */
+        bool update_pending;
+        /* data length and PHY requested */
+        bool link_upgraded;
+        /* demand the parameters are set for */
+        uint8_t demand;
+        /* consecutive periods measured below that demand */
+        uint8_t lower_periods;
+        /* traffic of the current period */
+        uint8_t max_backlog;
+        uint32_t bytes;
+    };
+
+    connection_tuning_policy_t _connection_tuning_policy = connection_tuning_policy_t::NONE;
+    ConnectionTuning _connection_tuning[DM_CONN_MAX] = {};
+    mbed::LowPowerTicker _connection_tuning_ticker;
+#endif // BLE_FEATURE_CONNECTABLE
+
     bool _initiating = false;
 
     template<size_t bit_size>
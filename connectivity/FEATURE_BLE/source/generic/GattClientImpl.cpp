@@ -1011,6 +1011,16 @@ struct GattClient::DescriptorDiscoveryControlBlock final : public ProcedureContr
 };
 
 
+struct GattClient::WriteCommandEntry {
+    WriteCommandEntry *next;
+    connection_handle_t connection;
+    GattAttribute::Handle_t handle;
+    uint16_t length;
+    bool sent;
+    uint8_t *value;     // follows the entry
+};
+
+
 GattClient::GattClient(PalGattClient &pal_client) :
     eventHandler(nullptr),
     _pal_client(pal_client),
@@ -1019,6 +1029,7 @@ GattClient::GattClient(PalGattClient &pal_client) :
     _signing_event_handler(nullptr),
 #endif
     control_blocks(nullptr),
+    _write_commands(nullptr),
     _is_reseting(false)
 {
     _pal_client.when_server_message_received(
@@ -1294,6 +1305,122 @@ ble_error_t GattClient::write(
 }
 
 
+ble_error_t GattClient::queueWriteCommand(
+    connection_handle_t connection_handle,
+    GattAttribute::Handle_t attribute_handle,
+    size_t length,
+    const uint8_t *value
+)
+{
+    if (_is_reseting) {
+        return BLE_ERROR_INVALID_STATE;
+    }
+
+    if (length > (uint16_t) (get_mtu(connection_handle) - WRITE_HEADER_LENGTH)) {
+        return BLE_ERROR_PARAM_OUT_OF_RANGE;
+    }
+
+    size_t queued = 0;
+    WriteCommandEntry **tail = &_write_commands;
+    while (*tail) {
+        if ((*tail)->connection == connection_handle) {
+            queued++;
+        }
+        tail = &(*tail)->next;
+    }
+
+    if (queued >= MBED_CONF_BLE_API_IMPLEMENTATION_WRITE_COMMAND_QUEUE_SIZE) {
+        return BLE_ERROR_NO_MEM;
+    }
+
+    auto *entry = (WriteCommandEntry *) malloc(sizeof(WriteCommandEntry) + length);
+    if (entry == nullptr) {
+        return BLE_ERROR_NO_MEM;
+    }
+    entry->next = nullptr;
+    entry->connection = connection_handle;
+    entry->handle = attribute_handle;
+    entry->length = length;
+    entry->sent = false;
+    entry->value = reinterpret_cast<uint8_t *>(entry + 1);
+    memcpy(entry->value, value, length);
+    *tail = entry;
+
+    send_write_commands(connection_handle);
+
+    return BLE_ERROR_NONE;
+}
+
+
+void GattClient::send_write_commands(connection_handle_t connection)
+{
+    while (true) {
+        WriteCommandEntry *next = nullptr;
+        size_t in_flight = 0;
+        for (WriteCommandEntry *entry = _write_commands; entry; entry = entry->next) {
+            if (entry->connection != connection) {
+                continue;
+            }
+            if (!entry->sent) {
+                next = entry;
+                break;
+            }
+            in_flight++;
+        }
+
+        if (!next || in_flight >= MBED_CONF_BLE_API_IMPLEMENTATION_WRITE_COMMAND_CREDITS) {
+            return;
+        }
+
+        next->sent = true;
+        ble_error_t err = _pal_client.write_without_response(
+            connection,
+            next->handle,
+            make_const_Span(next->value, next->length)
+        );
+
+        if (err) {
+            GattWriteCallbackParams response = {
+                connection,
+                next->handle,
+                GattWriteCallbackParams::OP_WRITE_CMD,
+                err,
+                0
+            };
+            remove_write_command(next);
+            processWriteResponse(&response);
+        }
+    }
+}
+
+
+void GattClient::remove_write_command(WriteCommandEntry *entry)
+{
+    for (WriteCommandEntry **it = &_write_commands; *it; it = &(*it)->next) {
+        if (*it == entry) {
+            *it = entry->next;
+            free(entry);
+            return;
+        }
+    }
+}
+
+
+void GattClient::drop_write_commands(connection_handle_t connection)
+{
+    WriteCommandEntry **it = &_write_commands;
+    while (*it) {
+        WriteCommandEntry *entry = *it;
+        if (entry->connection == connection) {
+            *it = entry->next;
+            free(entry);
+        } else {
+            it = &entry->next;
+        }
+    }
+}
+
+
 void GattClient::onServiceDiscoveryTermination(
     ServiceDiscovery::TerminationCallback_t callback
 )
@@ -1412,6 +1539,9 @@ ble_error_t GattClient::reset()
     while (control_blocks) {
         control_blocks->abort(this);
     }
+    while (_write_commands) {
+        remove_write_command(_write_commands);
+    }
     _is_reseting = false;
 
     return BLE_ERROR_NONE;
@@ -1454,6 +1584,18 @@ void GattClient::on_write_command_sent(
         status
     };
 
+    // the oldest queued command sent on this attribute has left the stack,
+    // which frees a credit for the next one
+    for (WriteCommandEntry *entry = _write_commands; entry; entry = entry->next) {
+        if (entry->connection == connection_handle && entry->sent) {
+            if (entry->handle == attribute_handle) {
+                remove_write_command(entry);
+                send_write_commands(connection_handle);
+            }
+            break;
+        }
+    }
+
     this->processWriteResponse(&response);
 }
 
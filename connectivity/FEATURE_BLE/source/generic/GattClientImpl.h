@@ -97,6 +97,13 @@ public:
         const uint8_t *value
     ) const;
 
+    ble_error_t queueWriteCommand(
+        ble::connection_handle_t connHandle,
+        GattAttribute::Handle_t attributeHandle,
+        size_t length,
+        const uint8_t *value
+    );
+
     /* Event callback handlers. */
 
     void onDataRead(ReadCallback_t callback);
@@ -153,6 +160,11 @@ public:
 
     void processHVXEvent(const GattHVXCallbackParams *params);
 
+    /**
+     * Drop the write commands queued for a connection, when it closes.
+     */
+    void drop_write_commands(connection_handle_t connection);
+
 private:
     /* Disallow copy and assignment. */
     GattClient(const GattClient &);
@@ -191,6 +203,7 @@ private:
     struct ReadControlBlock;
     struct WriteControlBlock;
     struct DescriptorDiscoveryControlBlock;
+    struct WriteCommandEntry;
 
     ProcedureControlBlock *get_control_block(connection_handle_t connection);
 
@@ -212,6 +225,10 @@ private:
 
     uint16_t get_mtu(connection_handle_t connection) const;
 
+    void send_write_commands(connection_handle_t connection);
+
+    void remove_write_command(WriteCommandEntry *entry);
+
 private:
     /**
      * Event handler provided by the application.
@@ -246,6 +263,7 @@ private:
     ServiceDiscovery::TerminationCallback_t _termination_callback;
     PalSigningMonitorEventHandler *_signing_event_handler;
     mutable ProcedureControlBlock *control_blocks;
+    WriteCommandEntry *_write_commands;
     bool _is_reseting;
 
 private:
@@ -52,6 +52,13 @@ typedef SecurityDb::entry_handle_t entry_handle_t;
 KVStoreSecurityDb::KVStoreSecurityDb()
     : SecurityDb() {
     memset(_entries, 0, sizeof(_entries));
+#if MBED_CONF_BLE_API_IMPLEMENTATION_KVSTORE_SECURITY_DB_CACHE
+    memset(_cache, 0, sizeof(_cache));
+    memset(_dirty, 0, sizeof(_dirty));
+    _dirty_local = 0;
+    memset(_stored_entries, 0, sizeof(_stored_entries));
+    _stored_local_sign_counter = 0;
+#endif
 }
 
 KVStoreSecurityDb::~KVStoreSecurityDb()
@@ -139,7 +146,7 @@ void KVStoreSecurityDb::set_entry_local_ltk(
     SecurityEntryKeys_t* current_entry = read_in_entry_local_keys(db_handle);
     current_entry->ltk = ltk;
 
-    db_write_entry(current_entry, DB_ENTRY_LOCAL_KEYS, get_index(entry));
+    store_entry(current_entry, DB_ENTRY_LOCAL_KEYS, get_index(entry), DIRTY_LOCAL_KEYS);
 }
 
 void KVStoreSecurityDb::set_entry_local_ediv_rand(
@@ -157,7 +164,7 @@ void KVStoreSecurityDb::set_entry_local_ediv_rand(
     current_entry->ediv = ediv;
     current_entry->rand = rand;
 
-    db_write_entry(current_entry, DB_ENTRY_LOCAL_KEYS, get_index(entry));
+    store_entry(current_entry, DB_ENTRY_LOCAL_KEYS, get_index(entry), DIRTY_LOCAL_KEYS);
 }
 
 /* peer's keys */
@@ -179,7 +186,7 @@ void KVStoreSecurityDb::set_entry_peer_ltk(
     SecurityEntryKeys_t* current_entry = read_in_entry_peer_keys(db_handle);
     current_entry->ltk = ltk;
 
-    db_write_entry(current_entry, DB_ENTRY_PEER_KEYS, get_index(entry));
+    store_entry(current_entry, DB_ENTRY_PEER_KEYS, get_index(entry), DIRTY_PEER_KEYS);
 }
 
 void KVStoreSecurityDb::set_entry_peer_ediv_rand(
@@ -197,7 +204,7 @@ void KVStoreSecurityDb::set_entry_peer_ediv_rand(
     current_entry->ediv = ediv;
     current_entry->rand = rand;
 
-    db_write_entry(current_entry, DB_ENTRY_PEER_KEYS, get_index(entry));
+    store_entry(current_entry, DB_ENTRY_PEER_KEYS, get_index(entry), DIRTY_PEER_KEYS);
 }
 
 void KVStoreSecurityDb::set_entry_peer_irk(
@@ -215,7 +222,7 @@ void KVStoreSecurityDb::set_entry_peer_irk(
     SecurityEntryIdentity_t* current_entry = read_in_entry_peer_identity(db_handle);
     current_entry->irk = irk;
 
-    db_write_entry(current_entry, DB_ENTRY_PEER_IDENTITY, get_index(entry));
+    store_entry(current_entry, DB_ENTRY_PEER_IDENTITY, get_index(entry), DIRTY_PEER_IDENTITY);
 }
 
 void KVStoreSecurityDb::set_entry_peer_bdaddr(
@@ -233,7 +240,7 @@ void KVStoreSecurityDb::set_entry_peer_bdaddr(
     current_entry->identity_address = peer_address;
     current_entry->identity_address_is_public = address_is_public;
 
-    db_write_entry(current_entry, DB_ENTRY_PEER_IDENTITY, get_index(entry));
+    store_entry(current_entry, DB_ENTRY_PEER_IDENTITY, get_index(entry), DIRTY_PEER_IDENTITY);
 }
 
 void KVStoreSecurityDb::set_entry_peer_csrk(
@@ -251,7 +258,7 @@ void KVStoreSecurityDb::set_entry_peer_csrk(
     SecurityEntrySigning_t* current_entry = read_in_entry_peer_signing(db_handle);
     current_entry->csrk = csrk;
 
-    db_write_entry(current_entry, DB_ENTRY_PEER_SIGNING, get_index(entry));
+    store_entry(current_entry, DB_ENTRY_PEER_SIGNING, get_index(entry), DIRTY_PEER_SIGNING);
 }
 
 void KVStoreSecurityDb::set_entry_peer_sign_counter(
@@ -270,7 +277,11 @@ void KVStoreSecurityDb::set_local_csrk(
 )
 {
     this->SecurityDb::set_local_csrk(csrk);
+#if MBED_CONF_BLE_API_IMPLEMENTATION_KVSTORE_SECURITY_DB_CACHE
+    _dirty_local |= DIRTY_LOCAL_CSRK;
+#else
     db_write(&_local_csrk, DB_LOCAL_CSRK);
+#endif
 }
 
 void KVStoreSecurityDb::set_local_identity(
@@ -280,7 +291,11 @@ void KVStoreSecurityDb::set_local_identity(
 )
 {
     this->SecurityDb::set_local_identity(irk, identity_address, public_address);
+#if MBED_CONF_BLE_API_IMPLEMENTATION_KVSTORE_SECURITY_DB_CACHE
+    _dirty_local |= DIRTY_LOCAL_IDENTITY;
+#else
     db_write(&_local_identity, DB_LOCAL_IDENTITY);
+#endif
 }
 
 /* saving and loading from nvm */
@@ -293,6 +308,14 @@ void KVStoreSecurityDb::restore()
 
     if (!restore_toggle) {
         erase_db();
+#if MBED_CONF_BLE_API_IMPLEMENTATION_KVSTORE_SECURITY_DB_CACHE
+        /* the storage now holds zeros, as a default constructed db does */
+        memset(_cache, 0, sizeof(_cache));
+        memset(_dirty, 0, sizeof(_dirty));
+        _dirty_local = DIRTY_LOCAL_IDENTITY | DIRTY_LOCAL_CSRK;
+        memset(_stored_entries, 0, sizeof(_stored_entries));
+        _stored_local_sign_counter = 0;
+#endif
         return;
     }
 
@@ -300,6 +323,21 @@ void KVStoreSecurityDb::restore()
     db_read(&_local_identity, DB_LOCAL_IDENTITY);
     db_read(&_local_csrk, DB_LOCAL_CSRK);
     db_read(&_local_sign_counter, DB_LOCAL_SIGN_COUNT);
+
+#if MBED_CONF_BLE_API_IMPLEMENTATION_KVSTORE_SECURITY_DB_CACHE
+    /* load all the keys once, reconnections then do not read the storage */
+    for (uint8_t index = 0; index < BLE_SECURITY_DATABASE_MAX_ENTRIES; ++index) {
+        cached_entry_t &cache = _cache[index];
+        db_read_entry(&cache.local_keys, DB_ENTRY_LOCAL_KEYS, index);
+        db_read_entry(&cache.peer_identity, DB_ENTRY_PEER_IDENTITY, index);
+        db_read_entry(&cache.peer_keys, DB_ENTRY_PEER_KEYS, index);
+        db_read_entry(&cache.peer_signing, DB_ENTRY_PEER_SIGNING, index);
+    }
+    memset(_dirty, 0, sizeof(_dirty));
+    _dirty_local = 0;
+    memcpy(_stored_entries, _entries, sizeof(_entries));
+    _stored_local_sign_counter = _local_sign_counter;
+#endif
 }
 
 void KVStoreSecurityDb::sync(entry_handle_t db_handle)
@@ -309,12 +347,56 @@ void KVStoreSecurityDb::sync(entry_handle_t db_handle)
         return;
     }
 
+#if MBED_CONF_BLE_API_IMPLEMENTATION_KVSTORE_SECURITY_DB_CACHE
+    flush();
+#else
     /* all entries are stored in a single key so we store them all*/
     db_write(&_entries, DB_ENTRIES);
     db_write(&_local_identity, DB_LOCAL_IDENTITY);
     db_write(&_local_csrk, DB_LOCAL_CSRK);
     db_write(&_local_sign_counter, DB_LOCAL_SIGN_COUNT);
+#endif
+}
+
+#if MBED_CONF_BLE_API_IMPLEMENTATION_KVSTORE_SECURITY_DB_CACHE
+void KVStoreSecurityDb::flush()
+{
+    for (uint8_t index = 0; index < BLE_SECURITY_DATABASE_MAX_ENTRIES; ++index) {
+        cached_entry_t &cache = _cache[index];
+        const uint8_t dirty = _dirty[index];
+        if (dirty & DIRTY_LOCAL_KEYS) {
+            db_write_entry(&cache.local_keys, DB_ENTRY_LOCAL_KEYS, index);
+        }
+        if (dirty & DIRTY_PEER_IDENTITY) {
+            db_write_entry(&cache.peer_identity, DB_ENTRY_PEER_IDENTITY, index);
+        }
+        if (dirty & DIRTY_PEER_KEYS) {
+            db_write_entry(&cache.peer_keys, DB_ENTRY_PEER_KEYS, index);
+        }
+        if (dirty & DIRTY_PEER_SIGNING) {
+            db_write_entry(&cache.peer_signing, DB_ENTRY_PEER_SIGNING, index);
+        }
+        _dirty[index] = 0;
+    }
+
+    /* flags and counters are modified in place, compare them to what was stored */
+    if (memcmp(_entries, _stored_entries, sizeof(_entries))) {
+        db_write(&_entries, DB_ENTRIES);
+        memcpy(_stored_entries, _entries, sizeof(_entries));
+    }
+    if (_dirty_local & DIRTY_LOCAL_IDENTITY) {
+        db_write(&_local_identity, DB_LOCAL_IDENTITY);
+    }
+    if (_dirty_local & DIRTY_LOCAL_CSRK) {
+        db_write(&_local_csrk, DB_LOCAL_CSRK);
+    }
+    _dirty_local = 0;
+    if (_local_sign_counter != _stored_local_sign_counter) {
+        db_write(&_local_sign_counter, DB_LOCAL_SIGN_COUNT);
+        _stored_local_sign_counter = _local_sign_counter;
+    }
 }
+#endif // MBED_CONF_BLE_API_IMPLEMENTATION_KVSTORE_SECURITY_DB_CACHE
 
 void KVStoreSecurityDb::set_restore(bool reload)
 {
@@ -344,12 +426,17 @@ void KVStoreSecurityDb::reset_entry(entry_handle_t db_handle)
         return;
     }
 
+#if MBED_CONF_BLE_API_IMPLEMENTATION_KVSTORE_SECURITY_DB_CACHE
+    memset(&_cache[get_index(entry)], 0, sizeof(cached_entry_t));
+    _dirty[get_index(entry)] |= DIRTY_ALL;
+#else
     uint8_t zero_buffer[sizeof(SecurityEntryKeys_t)] = {0};
 
     db_write_entry((SecurityEntryKeys_t*)zero_buffer, DB_ENTRY_LOCAL_KEYS, get_index(entry));
     db_write_entry((SecurityEntryIdentity_t*)zero_buffer, DB_ENTRY_PEER_IDENTITY, get_index(entry));
     db_write_entry((SecurityEntryKeys_t*)zero_buffer, DB_ENTRY_PEER_KEYS, get_index(entry));
     db_write_entry((SecurityEntrySigning_t*)zero_buffer, DB_ENTRY_PEER_SIGNING, get_index(entry));
+#endif
 
     entry->flags = SecurityDistributionFlags_t();
     entry->peer_sign_counter = 0;
@@ -362,10 +449,14 @@ SecurityEntryIdentity_t* KVStoreSecurityDb::read_in_entry_peer_identity(entry_ha
         return nullptr;
     }
 
+#if MBED_CONF_BLE_API_IMPLEMENTATION_KVSTORE_SECURITY_DB_CACHE
+    return &_cache[get_index(entry)].peer_identity;
+#else
     SecurityEntryIdentity_t* identity = reinterpret_cast<SecurityEntryIdentity_t*>(_buffer);
     db_read_entry(identity, DB_ENTRY_PEER_IDENTITY, get_index(entry));
 
     return identity;
+#endif
 };
 
 SecurityEntryKeys_t* KVStoreSecurityDb::read_in_entry_peer_keys(entry_handle_t db_handle)
@@ -375,10 +466,14 @@ SecurityEntryKeys_t* KVStoreSecurityDb::read_in_entry_peer_keys(entry_handle_t d
         return nullptr;
     }
 
+#if MBED_CONF_BLE_API_IMPLEMENTATION_KVSTORE_SECURITY_DB_CACHE
+    return &_cache[get_index(entry)].peer_keys;
+#else
     SecurityEntryKeys_t* keys = reinterpret_cast<SecurityEntryKeys_t*>(_buffer);
     db_read_entry(keys, DB_ENTRY_PEER_KEYS, get_index(entry));
 
     return keys;
+#endif
 };
 
 SecurityEntryKeys_t* KVStoreSecurityDb::read_in_entry_local_keys(entry_handle_t db_handle)
@@ -388,10 +483,14 @@ SecurityEntryKeys_t* KVStoreSecurityDb::read_in_entry_local_keys(entry_handle_t
         return nullptr;
     }
 
+#if MBED_CONF_BLE_API_IMPLEMENTATION_KVSTORE_SECURITY_DB_CACHE
+    return &_cache[get_index(entry)].local_keys;
+#else
     SecurityEntryKeys_t* keys = reinterpret_cast<SecurityEntryKeys_t*>(_buffer);
     db_read_entry(keys, DB_ENTRY_LOCAL_KEYS, get_index(entry));
 
     return keys;
+#endif
 };
 
 SecurityEntrySigning_t* KVStoreSecurityDb::read_in_entry_peer_signing(entry_handle_t db_handle)
@@ -401,13 +500,17 @@ SecurityEntrySigning_t* KVStoreSecurityDb::read_in_entry_peer_signing(entry_hand
         return nullptr;
     }
 
+#if MBED_CONF_BLE_API_IMPLEMENTATION_KVSTORE_SECURITY_DB_CACHE
+    SecurityEntrySigning_t* signing = &_cache[get_index(entry)].peer_signing;
+#else
     /* only read in the csrk */
     csrk_t* csrk = reinterpret_cast<csrk_t*>(_buffer);
     db_read_entry(csrk, DB_ENTRY_PEER_SIGNING,get_index(entry));
 
+    SecurityEntrySigning_t* signing = reinterpret_cast<SecurityEntrySigning_t*>(_buffer);
+#endif
 
     /* use the counter held in memory */
-    SecurityEntrySigning_t* signing = reinterpret_cast<SecurityEntrySigning_t*>(_buffer);
     signing->counter = entry->peer_sign_counter;
 
     return signing;
@@ -40,6 +40,30 @@ private:
         sign_count_t peer_sign_counter;
     };
 
+#if MBED_CONF_BLE_API_IMPLEMENTATION_KVSTORE_SECURITY_DB_CACHE
+    /* copy of the keys of an entry held in RAM */
+    struct cached_entry_t {
+        SecurityEntryKeys_t local_keys;
+        SecurityEntryIdentity_t peer_identity;
+        SecurityEntryKeys_t peer_keys;
+        SecurityEntrySigning_t peer_signing;
+    };
+#endif // MBED_CONF_BLE_API_IMPLEMENTATION_KVSTORE_SECURITY_DB_CACHE
+
+    /* keys of an entry written by the next sync() */
+    enum : uint8_t {
+        DIRTY_LOCAL_KEYS = 1 << 0,
+        DIRTY_PEER_IDENTITY = 1 << 1,
+        DIRTY_PEER_KEYS = 1 << 2,
+        DIRTY_PEER_SIGNING = 1 << 3,
+        DIRTY_ALL = 0x0F
+    };
+
+    enum : uint8_t {
+        DIRTY_LOCAL_IDENTITY = 1 << 0,
+        DIRTY_LOCAL_CSRK = 1 << 1
+    };
+
     static constexpr uint8_t KVSTORESECURITYDB_VERSION = 1;
 
     static constexpr size_t DB_PREFIX_SIZE = 7 + sizeof (STR(MBED_CONF_STORAGE_DEFAULT_KV)) - 1;
@@ -105,6 +129,19 @@ private:
         MBED_ASSERT(ret == MBED_SUCCESS && size == sizeof(T));
     }
 
+    /* write the key now, or mark it for the next sync() when cached */
+    template<class T>
+    void store_entry(T *value, const char* key, uint8_t index, uint8_t dirty) {
+#if MBED_CONF_BLE_API_IMPLEMENTATION_KVSTORE_SECURITY_DB_CACHE
+        (void)value;
+        (void)key;
+        _dirty[index] |= dirty;
+#else
+        (void)dirty;
+        db_write_entry(value, key, index);
+#endif
+    }
+
     static void create_key(char* full_key, const char* key) {
         memcpy(full_key, DB_PREFIX, DB_PREFIX_SIZE);
         memcpy(full_key + DB_PREFIX_SIZE, key, DB_KEY_SIZE);
@@ -224,10 +261,26 @@ private:
      */
     static bool erase_db();
 
+#if MBED_CONF_BLE_API_IMPLEMENTATION_KVSTORE_SECURITY_DB_CACHE
+    /**
+     * Write the keys which changed since they were last stored.
+     */
+    void flush();
+#endif
+
 private:
     entry_t _entries[BLE_SECURITY_DATABASE_MAX_ENTRIES];
     uint8_t _buffer[sizeof(SecurityEntryKeys_t)];
 
+#if MBED_CONF_BLE_API_IMPLEMENTATION_KVSTORE_SECURITY_DB_CACHE
+    cached_entry_t _cache[BLE_SECURITY_DATABASE_MAX_ENTRIES];
+    uint8_t _dirty[BLE_SECURITY_DATABASE_MAX_ENTRIES];
+    uint8_t _dirty_local;
+    /* last stored values of the keys modified without notice */
+    entry_t _stored_entries[BLE_SECURITY_DATABASE_MAX_ENTRIES];
+    sign_count_t _stored_local_sign_counter;
+#endif
+
     uint8_t get_index(entry_t *entry)
     {
         return  entry - _entries;
@@ -1579,6 +1579,31 @@ public:
         connection_handle_t connection,
         local_disconnection_reason_t disconnection_reason
     ) = 0;
+
+    /**
+     * Suggest the largest link layer payload the controller sends on a
+     * connection.
+     *
+     * The data length change is reported to on_data_length_change once
+     * negotiated with the peer.
+     *
+     * @param connection Handle of the connection.
+     *
+     * @param tx_octets Payload in octets, in the range [27 : 251].
+     *
+     * @param tx_time Maximum transmission time of a packet in us, in the
+     * range [328 : 17040].
+     *
+     * @return BLE_ERROR_NONE if the request has been successfully sent or the
+     * appropriate error otherwise.
+     *
+     * @note: See Bluetooth 5 Vol 2 PartE: 7.8.33 LE Set Data Length command.
+     */
+    virtual ble_error_t set_data_length(
+        connection_handle_t connection,
+        uint16_t tx_octets,
+        uint16_t tx_time
+    ) = 0;
 #endif
 
     /**
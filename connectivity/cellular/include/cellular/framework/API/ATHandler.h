@@ -52,6 +52,10 @@ extern const char *CRLF;
 
 #define BUFF_SIZE 32
 
+#ifndef MBED_CONF_CELLULAR_AT_HANDLER_BUFFER_SIZE
+#define MBED_CONF_CELLULAR_AT_HANDLER_BUFFER_SIZE BUFF_SIZE
+#endif
+
 /* AT Error types enumeration */
 enum DeviceErrorType {
     DeviceErrorTypeNoError = 0,
@@ -214,6 +218,22 @@ public:
      */
     void cmd_start_stop(const char *cmd, const char *cmd_chr, const char *format = "", ...);
 
+    /**
+     * @brief cmd_append Starts an AT command line with the given command, or appends the command to the line
+     *        started by a previous cmd_append() separating it with ';'. Finish the line with cmd_stop().
+     *        Modems execute the commands of one command line in order (ITU-T V.250), reply with their information
+     *        responses in the same order and end with a single final result code, so independent commands cost
+     *        one round trip. Read each response with resp_start() using the command prefix, in command order,
+     *        and finish with resp_stop(). The modem stops executing the line at the first failing command.
+     *        NOTE: Does not lock ATHandler for process!
+     *
+     * @param cmd AT command in form +<CMD> (will be used also in response reading, no extra chars allowed)
+     * @param cmd_chr Char to be added to specific AT command: '?', '=' or ''. Will be used as such so '=1' is valid as well.
+     * @param format Format string for variadic arguments to be added to AT command; No separator needed.
+     *        Use %d for integer, %s for string and %b for byte string (requires 2 arguments: string and length)
+     */
+    void cmd_append(const char *cmd, const char *cmd_chr, const char *format = "", ...);
+
     /**
      * @brief at_cmd_str Send an AT command and read a single string response. Locks and unlocks ATHandler for operation
      * @param cmd AT command in form +<CMD> (will be used also in response reading, no extra chars allowed)
@@ -282,6 +302,20 @@ public:
      */
     size_t write_bytes(const uint8_t *data, size_t len);
 
+    /** Write a socket payload as raw bytes, after the modem has prompted for it.
+     *  For modems with a binary data mode, where the send command gives the payload length
+     *  and the modem answers with a prompt such as ">". This takes half the bytes on the
+     *  UART of write_hex_string, and no conversion.
+     *  In case of failure, the last error is set.
+     *
+     *  @param data     payload to be written to modem
+     *  @param len      length of the payload
+     *  @param prompt   prompt to wait for before writing, or NULL if the modem does not prompt
+     *
+     *  @return         number of bytes successfully written
+     */
+    size_t write_binary_data(const uint8_t *data, size_t len, const char *prompt = ">");
+
     /** Sets the stop tag for the current scope (response/information response/element)
      *  Parameter's reading routines will stop the reading when such tag is found and will set the found flag.
      *  Consume routines will read everything until such tag is found.
@@ -328,6 +362,17 @@ public:
      */
     ssize_t read_bytes(uint8_t *buf, size_t len);
 
+    /** Reads a socket payload subparameter of known length as raw bytes, for example the data
+     *  following the length in a receive response of a modem in binary data mode.
+     *  Skips the quotation marks around the payload if there are any, and the delimiter after it.
+     *  The payload may contain the delimiter or stop tag, so it is not searched for them.
+     *
+     *  @param buf output buffer for the read
+     *  @param len length of the payload, as given by the modem
+     *  @return number of successfully read bytes or -1 in case of error
+     */
+    ssize_t read_binary_data(uint8_t *buf, size_t len);
+
     /** Reads chars from reading buffer. Terminates with null. Skips the quotation marks.
      *  Stops on delimiter or stop tag.
      *
@@ -433,6 +478,23 @@ public: // just for debugging
      */
     bool get_debug() const;
 
+    /** URC dispatch statistics */
+    struct urc_stats_t {
+        uint32_t count;                                 /**< URCs dispatched */
+        rtos::Kernel::Clock::duration total_time;       /**< Time spent in URC callbacks */
+        rtos::Kernel::Clock::duration max_time;         /**< Longest single URC callback */
+    };
+
+    /** Get URC dispatch statistics since creation or the last reset_urc_stats()
+     *
+     *  @return URC dispatch statistics
+     */
+    urc_stats_t get_urc_stats() const;
+
+    /** Reset URC dispatch statistics
+     */
+    void reset_urc_stats();
+
 private: //Private structs & enums
     struct tag_t {
         char tag[7];
@@ -511,6 +573,9 @@ private: //Private functions
     // Reads from serial to receiving buffer.
     // Returns true on successful read OR false on timeout.
     bool fill_buffer(bool wait_for_timeout = true);
+    // Reads from serial straight to buf, bypassing the receiving buffer.
+    // Returns number of bytes read OR 0 on timeout.
+    size_t read_serial(void *buf, size_t size, bool wait_for_timeout = true);
 
     void set_tag(tag_t *tag_dest, const char *tag_seq);
 
@@ -520,6 +585,10 @@ private: //Private functions
     // If URC match sets the scope to information response and after urc's cb returns
     // finishes the information response scope(consumes to CRLF).
     bool match_urc();
+    // Matches the receiving buffer content against the URCs of one bucket.
+    bool match_urc_list(oob_t *oob);
+    // Returns the bucket of URC prefix, URCs shorter than URC_KEY_LENGTH share the last bucket.
+    oob_t **urc_bucket(const char *prefix, size_t prefix_len);
     // Checks if any of the error strings are matching the receiving buffer content.
     bool match_error();
     // Checks if current char in buffer matches ch and consumes it,
@@ -590,7 +659,12 @@ private: //Member variables
     uint16_t _oob_string_max_length;
     char *_output_delimiter;
 
-    oob_t *_oobs;
+    // URC handlers hashed by the first URC_KEY_LENGTH chars of their prefix,
+    // so an incoming line is compared only against the URCs that can match it
+    static const int URC_BUCKETS = 16;
+    static const size_t URC_KEY_LENGTH = 3;
+    oob_t *_oobs[URC_BUCKETS + 1];
+    urc_stats_t _urc_stats;
     mbed::chrono::milliseconds_u32 _at_timeout;
     mbed::chrono::milliseconds_u32 _previous_at_timeout;
 
@@ -601,7 +675,7 @@ private: //Member variables
     bool _is_fh_usable;
 
     // should fit any prefix and int
-    char _recv_buff[BUFF_SIZE];
+    char _recv_buff[MBED_CONF_CELLULAR_AT_HANDLER_BUFFER_SIZE];
     // reading position
     size_t _recv_len;
     // reading length
@@ -633,6 +707,8 @@ private: //Member variables
     char _info_resp_prefix[BUFF_SIZE];
     bool _debug_on;
     bool _cmd_start;
+    // command line started with cmd_append() and not yet stopped
+    bool _cmd_appending;
     bool _use_delimiter;
 
     // time when a command or an URC processing was started
@@ -372,6 +372,36 @@ public:
     */
     virtual nsapi_error_t get_registration_params(RegistrationType type, registration_params_t &reg_params) = 0;
 
+    /** Gets the current network registration parameters of several registration types.
+    *   Implementations may query all of them from the modem at once.
+    *
+    *  @param types        registration types to get
+    *  @param reg_params   array of count elements, filled in the order of types. Types that are
+    *                      not supported by the modem are left with _type C_MAX.
+    *  @param count        number of types
+    *  @return             NSAPI_ERROR_OK on success
+    *                      NSAPI_ERROR_UNSUPPORTED if the modem supports none of the types
+    *                      NSAPI_ERROR_DEVICE_ERROR on failure
+    */
+    virtual nsapi_error_t get_registration_params(const RegistrationType *types, registration_params_t *reg_params, int count)
+    {
+        nsapi_error_t err = NSAPI_ERROR_UNSUPPORTED;
+        for (int i = 0; i < count; i++) {
+            reg_params[i] = registration_params_t();
+            nsapi_error_t ret = get_registration_params(types[i], reg_params[i]);
+            if (ret == NSAPI_ERROR_OK) {
+                reg_params[i]._type = types[i];
+                if (err == NSAPI_ERROR_UNSUPPORTED) {
+                    err = NSAPI_ERROR_OK;
+                }
+            } else if (ret != NSAPI_ERROR_UNSUPPORTED) {
+                reg_params[i]._type = C_MAX;
+                err = ret;
+            }
+        }
+        return err;
+    }
+
     /** Set discontinuous reception time on cellular device.
      *
      *  @remark See 3GPP TS 27.007 eDRX for details.
@@ -92,6 +92,8 @@ public: // CellularNetwork
 
     virtual nsapi_error_t get_registration_params(RegistrationType type, registration_params_t &reg_params);
 
+    virtual nsapi_error_t get_registration_params(const RegistrationType *types, registration_params_t *reg_params, int count);
+
     virtual nsapi_error_t set_receive_period(int mode, EDRXAccessTechnology act_type, uint8_t edrx_value);
 
     virtual nsapi_error_t set_packet_domain_event_reporting(bool on);
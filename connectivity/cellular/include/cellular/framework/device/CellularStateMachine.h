@@ -143,7 +143,7 @@ public:
 private:
     bool power_on();
     bool open_sim();
-    bool get_network_registration(CellularNetwork::RegistrationType type, CellularNetwork::RegistrationStatus &status, bool &is_registered);
+    bool get_network_registration(const CellularNetwork::registration_params_t &reg_params, CellularNetwork::RegistrationStatus &status, bool &is_registered);
     bool is_registered();
     bool device_ready();
 
@@ -191,6 +191,8 @@ private:
     cell_callback_data_t _cb_data;
     cellular_connection_status_t _current_event;
     int _status;
+    // modem has been set up since it was powered on, so connecting again can skip the setup
+    bool _modem_configured;
     PlatformMutex _mutex;
 
     // Cellular state timeouts
@@ -577,6 +577,53 @@ nsapi_error_t AT_CellularNetwork::get_registration_params(RegistrationType type,
     return _at.unlock_return_error();
 }
 
+nsapi_error_t AT_CellularNetwork::get_registration_params(const RegistrationType *types, registration_params_t *reg_params, int count)
+{
+    bool supported = false;
+
+    _at.lock();
+
+    // Query all types in one command line, e.g. AT+CEREG?;+CGREG?
+    for (int n = 0; n < count; n++) {
+        int i = (int)types[n];
+        MBED_ASSERT(i >= 0 && i < C_MAX);
+
+        reg_params[n] = registration_params_t();
+        if (_device.get_property((AT_CellularDevice::CellularProperty)at_reg[i].type)) {
+            _at.cmd_append(at_reg[i].cmd, "?");
+            supported = true;
+        }
+    }
+
+    if (!supported) {
+        _at.unlock();
+        return NSAPI_ERROR_UNSUPPORTED;
+    }
+
+    _at.cmd_stop();
+
+    // Responses come in the order of the commands
+    for (int n = 0; n < count; n++) {
+        int i = (int)types[n];
+        if (!_device.get_property((AT_CellularDevice::CellularProperty)at_reg[i].type)) {
+            continue;
+        }
+        _at.resp_start(at_reg[i].urc_prefix);
+        (void)_at.read_int(); // ignore urc mode subparam
+        read_reg_params(types[n], reg_params[n]);
+        _reg_params = reg_params[n];
+    }
+    _at.resp_stop();
+
+    nsapi_error_t err = _at.unlock_return_error();
+    if (err != NSAPI_ERROR_OK) {
+        for (int n = 0; n < count; n++) {
+            reg_params[n]._type = C_MAX;
+        }
+    }
+    return err;
+}
+
 int AT_CellularNetwork::calculate_active_time(const char *active_time_string, int active_time_length)
 {
     if (active_time_length != ONE_BYTE_BINARY) {
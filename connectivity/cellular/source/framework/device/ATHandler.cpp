@@ -19,6 +19,7 @@
 #include <stdio.h>
 #include <limits.h>
 #include <errno.h>
+#include <algorithm>
 #include "ATHandler.h"
 #include "mbed_poll.h"
 #include "FileHandle.h"
@@ -49,6 +50,9 @@ using namespace std::chrono_literals;
 #define DEBUG_MAXLEN 60
 #define DEBUG_END_MARK "..\r"
 
+MBED_STATIC_ASSERT(MBED_CONF_CELLULAR_AT_HANDLER_BUFFER_SIZE >= BUFF_SIZE,
+                   "cellular.at-handler-buffer-size must fit any prefix and int");
+
 const char *mbed::OK = "OK\r\n";
 const uint8_t OK_LENGTH = 4;
 const char *mbed::CRLF = "\r\n";
@@ -84,7 +88,7 @@ ATHandler::ATHandler(FileHandle *fh, EventQueue &queue, mbed::chrono::millisecon
     _last_err(NSAPI_ERROR_OK),
     _last_3gpp_error(0),
     _oob_string_max_length(0),
-    _oobs(NULL),
+    _oobs(),
     _at_timeout(timeout),
     _previous_at_timeout(timeout),
     _at_send_delay(send_delay),
@@ -99,11 +103,13 @@ ATHandler::ATHandler(FileHandle *fh, EventQueue &queue, mbed::chrono::millisecon
     _max_resp_length(MAX_RESP_LENGTH),
     _debug_on(DEBUG_AT_ENABLED),
     _cmd_start(false),
+    _cmd_appending(false),
     _use_delimiter(true),
     _start_time(),
     _event_id(0)
 {
     clear_error();
+    reset_urc_stats();
 
     if (output_delimiter) {
         _output_delimiter = new char[strlen(output_delimiter) + 1];
@@ -144,10 +150,12 @@ ATHandler::~ATHandler()
 #endif // AT_HANDLER_MUTEX
     }
 
-    while (_oobs) {
-        struct oob_t *oob = _oobs;
-        _oobs = oob->next;
-        delete oob;
+    for (int i = 0; i <= URC_BUCKETS; i++) {
+        while (_oobs[i]) {
+            struct oob_t *oob = _oobs[i];
+            _oobs[i] = oob->next;
+            delete oob;
+        }
     }
     if (_output_delimiter) {
         delete [] _output_delimiter;
@@ -172,6 +180,18 @@ void ATHandler::set_debug(bool debug_on)
     _debug_on = debug_on;
 }
 
+ATHandler::urc_stats_t ATHandler::get_urc_stats() const
+{
+    return _urc_stats;
+}
+
+void ATHandler::reset_urc_stats()
+{
+    _urc_stats.count = 0;
+    _urc_stats.total_time = 0s;
+    _urc_stats.max_time = 0s;
+}
+
 bool ATHandler::get_debug() const
 {
     return _debug_on;
@@ -218,23 +238,25 @@ void ATHandler::set_urc_handler(const char *prefix, Callback<void()> callback)
         }
     }
 
+    oob_t **bucket = urc_bucket(prefix, prefix_len);
     oob->prefix = prefix;
     oob->prefix_len = prefix_len;
     oob->cb = callback;
-    oob->next = _oobs;
-    _oobs = oob;
+    oob->next = *bucket;
+    *bucket = oob;
 }
 
 void ATHandler::remove_urc_handler(const char *prefix)
 {
-    struct oob_t *current = _oobs;
+    oob_t **bucket = urc_bucket(prefix, strlen(prefix));
+    struct oob_t *current = *bucket;
     struct oob_t *prev = NULL;
     while (current) {
         if (strcmp(prefix, current->prefix) == 0) {
             if (prev) {
                 prev->next = current->next;
             } else {
-                _oobs = current->next;
+                *bucket = current->next;
             }
             delete current;
             break;
@@ -244,9 +266,22 @@ void ATHandler::remove_urc_handler(const char *prefix)
     }
 }
 
+ATHandler::oob_t **ATHandler::urc_bucket(const char *prefix, size_t prefix_len)
+{
+    if (prefix_len < URC_KEY_LENGTH) {
+        return &_oobs[URC_BUCKETS];
+    }
+
+    uint32_t hash = 0;
+    for (size_t i = 0; i < URC_KEY_LENGTH; i++) {
+        hash = hash * 31 + (uint8_t)prefix[i];
+    }
+    return &_oobs[hash & (URC_BUCKETS - 1)];
+}
+
 bool ATHandler::find_urc_handler(const char *prefix)
 {
-    struct oob_t *oob = _oobs;
+    struct oob_t *oob = *urc_bucket(prefix, strlen(prefix));
     while (oob) {
         if (strcmp(prefix, oob->prefix) == 0) {
             return true;
@@ -338,7 +373,7 @@ void ATHandler::process_oob()
                 if (!(_fileHandle->readable() || (_recv_pos < _recv_len))) {
                     break; // we have nothing to read anymore
                 }
-            } else if (mem_str(_recv_buff, _recv_len, CRLF, CRLF_LENGTH)) { // If no match found, look for CRLF and consume everything up to CRLF
+            } else if (mem_str(_recv_buff + _recv_pos, _recv_len - _recv_pos, CRLF, CRLF_LENGTH)) { // If no match found, look for CRLF and consume everything up to CRLF
                 _at_timeout = PROCESS_URC_TIME;
                 consume_to_tag(CRLF, true);
             } else {
@@ -393,29 +428,40 @@ int ATHandler::poll_timeout(bool wait_for_timeout)
     return timeout.count();
 }
 
-bool ATHandler::fill_buffer(bool wait_for_timeout)
+size_t ATHandler::read_serial(void *buf, size_t size, bool wait_for_timeout)
 {
-    // Reset buffer when full
-    if (sizeof(_recv_buff) == _recv_len) {
-        tr_warn("AT overflow");
-        debug_print(_recv_buff, _recv_len, AT_ERR);
-        reset_buffer();
-    }
-
     pollfh fhs;
     fhs.fh = _fileHandle;
     fhs.events = POLLIN;
     int count = poll(&fhs, 1, poll_timeout(wait_for_timeout));
     if (count > 0 && (fhs.revents & POLLIN)) {
-        ssize_t len = _fileHandle->read(_recv_buff + _recv_len, sizeof(_recv_buff) - _recv_len);
+        ssize_t len = _fileHandle->read(buf, size);
         if (len > 0) {
-            debug_print(_recv_buff + _recv_len, len, AT_RX);
-            _recv_len += len;
-            return true;
+            debug_print((const char *)buf, len, AT_RX);
+            return len;
         }
     }
 
-    return false;
+    return 0;
+}
+
+bool ATHandler::fill_buffer(bool wait_for_timeout)
+{
+    // Make room by dropping what is already read, and reset buffer when full of unread data
+    if (sizeof(_recv_buff) == _recv_len) {
+        if (_recv_pos > 0) {
+            rewind_buffer();
+        } else {
+            tr_warn("AT overflow");
+            debug_print(_recv_buff, _recv_len, AT_ERR);
+            reset_buffer();
+        }
+    }
+
+    size_t len = read_serial(_recv_buff + _recv_len, sizeof(_recv_buff) - _recv_len, wait_for_timeout);
+    _recv_len += len;
+
+    return len > 0;
 }
 
 int ATHandler::get_char()
@@ -470,16 +516,23 @@ void ATHandler::skip_param(ssize_t len, uint32_t count)
         return;
     }
 
-    for (uint32_t i = 0; i < count; i++) {
-        ssize_t read_len = 0;
-        while (read_len < len) {
-            int c = get_char();
-            if (c == -1) {
+    if (len <= 0) {
+        return;
+    }
+
+    size_t remaining = len * count;
+    while (remaining) {
+        if (_recv_pos == _recv_len) {
+            reset_buffer();
+            if (!fill_buffer()) {
+                tr_warn("AT timeout");
                 set_error(NSAPI_ERROR_DEVICE_ERROR);
                 return;
             }
-            read_len++;
         }
+        size_t skip_len = std::min(remaining, _recv_len - _recv_pos);
+        _recv_pos += skip_len;
+        remaining -= skip_len;
     }
     return;
 }
@@ -498,14 +551,29 @@ ssize_t ATHandler::read_bytes(uint8_t *buf, size_t len)
     }
 
     size_t read_len = 0;
-    for (; read_len < len; read_len++) {
-        int c = get_char();
-        if (c == -1) {
-            set_error(NSAPI_ERROR_DEVICE_ERROR);
-            _debug_on = debug_on;
-            return -1;
+    while (read_len < len) {
+        if (_recv_pos == _recv_len) {
+            reset_buffer();
+            size_t filled;
+            // Large payloads, e.g. socket data, are read straight to the caller's buffer
+            if (len - read_len >= sizeof(_recv_buff)) {
+                filled = read_serial(buf + read_len, len - read_len);
+                read_len += filled;
+            } else {
+                filled = fill_buffer();
+            }
+            if (!filled) {
+                tr_warn("AT timeout");
+                set_error(NSAPI_ERROR_DEVICE_ERROR);
+                _debug_on = debug_on;
+                return -1;
+            }
+            continue;
         }
-        buf[read_len] = c;
+        size_t copy_len = std::min(len - read_len, _recv_len - _recv_pos);
+        memcpy(buf + read_len, _recv_buff + _recv_pos, copy_len);
+        _recv_pos += copy_len;
+        read_len += copy_len;
     }
 
 #if DEBUG_AT_ENABLED
@@ -520,6 +588,31 @@ ssize_t ATHandler::read_bytes(uint8_t *buf, size_t len)
     return read_len;
 }
 
+ssize_t ATHandler::read_binary_data(uint8_t *buf, size_t len)
+{
+    if (!ok_to_proceed() || !_stop_tag || _stop_tag->found) {
+        return -1;
+    }
+
+    bool quoted = consume_char('\"');
+    if (_last_err) {
+        return -1;
+    }
+
+    ssize_t read_len = read_bytes(buf, len);
+    if (read_len < 0) {
+        return -1;
+    }
+
+    if (quoted) {
+        (void)consume_char('\"');
+    }
+    // step over the delimiter, like the other parameter reads do
+    (void)consume_char(_delimiter);
+
+    return read_len;
+}
+
 ssize_t ATHandler::read_string(char *buf, size_t size, bool read_even_stop_tag)
 {
     if (!ok_to_proceed() || !_stop_tag || (_stop_tag->found && read_even_stop_tag == false)) {
@@ -766,11 +859,8 @@ void ATHandler::set_scope(ScopeType scope_type)
     }
 }
 
-// should match from recv_pos?
 bool ATHandler::match(const char *str, size_t size)
 {
-    rewind_buffer();
-
     if ((_recv_len - _recv_pos) < size) {
         return false;
     }
@@ -785,16 +875,31 @@ bool ATHandler::match(const char *str, size_t size)
 
 bool ATHandler::match_urc()
 {
-    rewind_buffer();
+    size_t len = _recv_len - _recv_pos;
+    if (len >= URC_KEY_LENGTH && match_urc_list(*urc_bucket(_recv_buff + _recv_pos, len))) {
+        return true;
+    }
+    return match_urc_list(_oobs[URC_BUCKETS]);
+}
+
+bool ATHandler::match_urc_list(oob_t *oob)
+{
     size_t prefix_len = 0;
-    for (struct oob_t *oob = _oobs; oob; oob = oob->next) {
+    for (; oob; oob = oob->next) {
         prefix_len = oob->prefix_len;
-        if (_recv_len >= prefix_len) {
+        if (_recv_len - _recv_pos >= prefix_len) {
             if (match(oob->prefix, prefix_len)) {
                 set_scope(InfoType);
                 if (oob->cb) {
+                    auto start = rtos::Kernel::Clock::now();
                     oob->cb();
+                    auto elapsed = rtos::Kernel::Clock::now() - start;
+                    _urc_stats.total_time += elapsed;
+                    if (elapsed > _urc_stats.max_time) {
+                        _urc_stats.max_time = elapsed;
+                    }
                 }
+                _urc_stats.count++;
                 information_response_stop();
                 return true;
             }
@@ -925,7 +1030,7 @@ void ATHandler::resp(const char *prefix, bool check_urc)
         }
 
         // If no match found, look for CRLF and consume everything up to and including CRLF
-        if (mem_str(_recv_buff, _recv_len, CRLF, CRLF_LENGTH)) {
+        if (mem_str(_recv_buff + _recv_pos, _recv_len - _recv_pos, CRLF, CRLF_LENGTH)) {
             // If no prefix, return on CRLF - means data to read
             if (!prefix || (prefix && !strlen(prefix))) {
                 return;
@@ -1045,32 +1150,30 @@ bool ATHandler::consume_char(char ch)
 
 bool ATHandler::consume_to_tag(const char *tag, bool consume_tag)
 {
-    size_t match_pos = 0;
     size_t tag_length = strlen(tag);
 
     while (true) {
-        int c = get_char();
-        if (c == -1) {
-            tr_debug("consume_to_tag not found");
-            return false;
-        }
-        if (c == tag[match_pos]) {
-            match_pos++;
-        } else if (match_pos != 0) {
-            match_pos = 0;
-            if (c == tag[match_pos]) {
-                match_pos++;
+        const char *found = mem_str(_recv_buff + _recv_pos, _recv_len - _recv_pos, tag, tag_length);
+        if (found) {
+            _recv_pos = found - _recv_buff;
+            if (consume_tag) {
+                _recv_pos += tag_length;
             }
+            return true;
         }
-        if (match_pos == tag_length) {
-            break;
-        }
-    }
 
-    if (!consume_tag) {
-        _recv_pos -= tag_length;
+        // Keep what may be the start of the tag, so that the whole tag is in buffer once found
+        size_t keep_len = std::min(tag_length - 1, _recv_len - _recv_pos);
+        _recv_pos = _recv_len - keep_len;
+        rewind_buffer();
+        if (!fill_buffer()) {
+            reset_buffer();
+            tr_warn("AT timeout");
+            set_error(NSAPI_ERROR_DEVICE_ERROR);
+            tr_debug("consume_to_tag not found");
+            return false;
+        }
     }
-    return true;
 }
 
 bool ATHandler::consume_to_stop_tag()
@@ -1123,7 +1226,7 @@ void ATHandler::resp_stop()
                 }
 
                 // If no URC nor stop_tag found, look for CRLF and consume everything up to and including CRLF
-                if (mem_str(_recv_buff, _recv_len, CRLF, CRLF_LENGTH)) {
+                if (mem_str(_recv_buff + _recv_pos, _recv_len - _recv_pos, CRLF, CRLF_LENGTH)) {
                     consume_to_tag(CRLF, true);
                     // If stop tag is CRLF we have to stop reading/consuming the buffer
                     if (!strncmp(CRLF, _stop_tag->tag, _stop_tag->len)) {
@@ -1173,12 +1276,21 @@ ATHandler::ScopeType ATHandler::get_scope()
 
 const char *ATHandler::mem_str(const char *dest, size_t dest_len, const char *src, size_t src_len)
 {
-    if (dest_len >= src_len) {
-        for (size_t i = 0; i < dest_len - src_len + 1; ++i) {
-            if (memcmp(dest + i, src, src_len) == 0) {
-                return dest + i;
-            }
+    if (src_len == 0) {
+        return dest;
+    }
+
+    // Let memchr find candidates for the first char, it is much faster than comparing at every position
+    while (dest_len >= src_len) {
+        const char *first = (const char *)memchr(dest, src[0], dest_len - src_len + 1);
+        if (!first) {
+            break;
+        }
+        if (memcmp(first + 1, src + 1, src_len - 1) == 0) {
+            return first;
         }
+        dest_len -= first + 1 - dest;
+        dest = first + 1;
     }
     return NULL;
 }
@@ -1196,6 +1308,7 @@ void ATHandler::cmd_start(const char *cmd)
     (void)write(cmd, strlen(cmd));
 
     _cmd_start = true;
+    _cmd_appending = false;
 }
 
 void ATHandler::handle_args(const char *format, std::va_list list)
@@ -1256,6 +1369,26 @@ void ATHandler::cmd_start_stop(const char *cmd, const char *cmd_chr, const char
     cmd_stop();
 }
 
+void ATHandler::cmd_append(const char *cmd, const char *cmd_chr, const char *format, ...)
+{
+    if (!_cmd_appending) {
+        handle_start(cmd, cmd_chr);
+        _cmd_appending = true;
+    } else if (ok_to_proceed()) {
+        (void)write(";", 1);
+        (void)write(cmd, strlen(cmd));
+        if (cmd_chr) {
+            (void)write(cmd_chr, strlen(cmd_chr));
+        }
+        _cmd_start = true;
+    }
+
+    va_list list;
+    va_start(list, format);
+    handle_args(format, list);
+    va_end(list);
+}
+
 nsapi_error_t ATHandler::at_cmd_str(const char *cmd, const char *cmd_chr, char *resp_buf, size_t buf_size, const char *format, ...)
 {
     MBED_ASSERT(strlen(cmd) < BUFF_SIZE);
@@ -1362,6 +1495,7 @@ void ATHandler::write_string(const char *param, bool useQuotations)
 
 void ATHandler::cmd_stop()
 {
+    _cmd_appending = false;
     if (!ok_to_proceed()) {
         return;
     }
@@ -1385,6 +1519,22 @@ size_t ATHandler::write_bytes(const uint8_t *data, size_t len)
     return write(data, len);
 }
 
+size_t ATHandler::write_binary_data(const uint8_t *data, size_t len, const char *prompt)
+{
+    if (!ok_to_proceed()) {
+        return 0;
+    }
+
+    if (prompt) {
+        resp_start(prompt);
+        if (!ok_to_proceed()) {
+            return 0;
+        }
+    }
+
+    return write(data, len);
+}
+
 size_t ATHandler::write(const void *data, size_t len)
 {
     pollfh fhs;
@@ -1559,11 +1709,17 @@ void ATHandler::write_hex_string(const char *str, size_t size)
     }
 
     (void) write("\"", 1);
-    char hexbuf[2];
-    for (size_t i = 0; i < size; i++) {
-        hexbuf[0] = hex_values[((str[i]) >> 4) & 0x0F];
-        hexbuf[1] = hex_values[(str[i]) & 0x0F];
-        write(hexbuf, 2);
+    // Convert in chunks, rather than polling and writing the file handle for every byte
+    char hexbuf[2 * BUFF_SIZE];
+    for (size_t i = 0; i < size;) {
+        size_t hexlen = 0;
+        for (; i < size && hexlen < sizeof(hexbuf); i++) {
+            hexbuf[hexlen++] = hex_values[((str[i]) >> 4) & 0x0F];
+            hexbuf[hexlen++] = hex_values[(str[i]) & 0x0F];
+        }
+        if (write(hexbuf, hexlen) != hexlen) {
+            return;
+        }
     }
     (void) write("\"", 1);
 }
@@ -61,7 +61,8 @@ CellularStateMachine::CellularStateMachine(CellularDevice &device, events::Event
     _start_time(rand() % (MBED_CONF_CELLULAR_RANDOM_MAX_START_DELAY)),
 #endif // MBED_CONF_CELLULAR_RANDOM_MAX_START_DELAY
     _event_timeout(-1s), _event_id(-1), _plmn(0), _command_success(false),
-    _is_retry(false), _cb_data(), _current_event(CellularDeviceReady), _status(0)
+    _is_retry(false), _cb_data(), _current_event(CellularDeviceReady), _status(0),
+    _modem_configured(false)
 {
 
     // set initial retry values in seconds
@@ -106,6 +107,7 @@ void CellularStateMachine::stop()
     tr_debug("CellularStateMachine stop");
     reset();
     _event_id = STM_STOPPED;
+    _modem_configured = false;
 }
 
 bool CellularStateMachine::power_on()
@@ -184,8 +186,18 @@ bool CellularStateMachine::is_registered()
 
     // accept only CGREG/CEREG. CREG is for circuit switch network changed. If we accept CREG attach will fail if also
     // CGREG/CEREG is not registered.
-    for (int type = 0; type < CellularNetwork::C_REG; type++) {
-        if (get_network_registration((CellularNetwork::RegistrationType) type, status, is_registered)) {
+    const CellularNetwork::RegistrationType types[] = { CellularNetwork::C_EREG, CellularNetwork::C_GREG };
+    const int type_count = sizeof(types) / sizeof(types[0]);
+    CellularNetwork::registration_params_t reg_params[type_count];
+
+    // Both are asked from the modem at once
+    _cb_data.error = _network.get_registration_params(types, reg_params, type_count);
+    if (_cb_data.error != NSAPI_ERROR_OK && _cb_data.error != NSAPI_ERROR_UNSUPPORTED) {
+        tr_warn("Get network registration failed!");
+    }
+
+    for (int i = 0; i < type_count; i++) {
+        if (get_network_registration(reg_params[i], status, is_registered)) {
             if (is_registered) {
                 break;
             }
@@ -201,18 +213,14 @@ bool CellularStateMachine::is_registered()
     return is_registered || _status;
 }
 
-bool CellularStateMachine::get_network_registration(CellularNetwork::RegistrationType type,
+bool CellularStateMachine::get_network_registration(const CellularNetwork::registration_params_t &reg_params,
                                                     CellularNetwork::RegistrationStatus &status, bool &is_registered)
 {
     is_registered = false;
     bool is_roaming = false;
-    CellularNetwork::registration_params_t reg_params;
-    _cb_data.error = _network.get_registration_params(type, reg_params);
 
-    if (_cb_data.error != NSAPI_ERROR_OK) {
-        if (_cb_data.error != NSAPI_ERROR_UNSUPPORTED) {
-            tr_warn("Get network registration failed (type %d)!", type);
-        }
+    // Not supported by the modem or not read
+    if (reg_params._type == CellularNetwork::C_MAX) {
         return false;
     }
     status = reg_params._status;
@@ -311,6 +319,7 @@ void CellularStateMachine::state_init()
     _cb_data.error = _cellularDevice.is_ready();
     _status = _cb_data.error ? 0 : DEVICE_READY;
     if (_cb_data.error != NSAPI_ERROR_OK) {
+        _modem_configured = false;
         _event_timeout = _start_time;
         if (_start_time > 0s) {
             tr_info("Startup delay %d s", _start_time.count());
@@ -325,6 +334,7 @@ void CellularStateMachine::state_power_on()
 {
     change_timeout(_state_timeout_power_on);
     tr_info("Modem power ON (timeout %d ms)", _state_timeout_power_on.count());
+    _modem_configured = false;
     if (power_on()) {
         enter_to_state(STATE_DEVICE_READY);
     } else {
@@ -338,12 +348,15 @@ bool CellularStateMachine::device_ready()
     tr_info("Modem ready");
 
 #ifdef MBED_CONF_CELLULAR_RADIO_ACCESS_TECHNOLOGY
-    MBED_ASSERT(MBED_CONF_CELLULAR_RADIO_ACCESS_TECHNOLOGY >= CellularNetwork::RAT_GSM &&
-                MBED_CONF_CELLULAR_RADIO_ACCESS_TECHNOLOGY < CellularNetwork::RAT_UNKNOWN);
-    nsapi_error_t err = _network.set_access_technology((CellularNetwork::RadioAccessTechnology)MBED_CONF_CELLULAR_RADIO_ACCESS_TECHNOLOGY);
-    if (err != NSAPI_ERROR_OK && err != NSAPI_ERROR_UNSUPPORTED) {
-        tr_warning("Failed to set access technology to %d", MBED_CONF_CELLULAR_RADIO_ACCESS_TECHNOLOGY);
-        return false;
+    // access technology is kept by the modem until it's powered off
+    if (!_modem_configured) {
+        MBED_ASSERT(MBED_CONF_CELLULAR_RADIO_ACCESS_TECHNOLOGY >= CellularNetwork::RAT_GSM &&
+                    MBED_CONF_CELLULAR_RADIO_ACCESS_TECHNOLOGY < CellularNetwork::RAT_UNKNOWN);
+        nsapi_error_t err = _network.set_access_technology((CellularNetwork::RadioAccessTechnology)MBED_CONF_CELLULAR_RADIO_ACCESS_TECHNOLOGY);
+        if (err != NSAPI_ERROR_OK && err != NSAPI_ERROR_UNSUPPORTED) {
+            tr_warning("Failed to set access technology to %d", MBED_CONF_CELLULAR_RADIO_ACCESS_TECHNOLOGY);
+            return false;
+        }
     }
 #endif // MBED_CONF_CELLULAR_DEBUG_AT
 
@@ -365,10 +378,10 @@ void CellularStateMachine::state_device_ready()
         if (_cb_data.error == NSAPI_ERROR_OK) {
 
 #if MBED_CONF_MBED_TRACE_ENABLE
-            CellularInformation *info = _cellularDevice.open_information();
-
-            char *buf = new (std::nothrow) char[2048]; // size from 3GPP TS 27.007
+            // modem identity doesn't change while it's powered, so it's logged once
+            char *buf = _modem_configured ? NULL : new (std::nothrow) char[2048]; // size from 3GPP TS 27.007
             if (buf) {
+                CellularInformation *info = _cellularDevice.open_information();
                 if (info->get_manufacturer(buf, 2048) == NSAPI_ERROR_OK) {
                     tr_info("Modem manufacturer: %s", buf);
                 }
@@ -379,8 +392,8 @@ void CellularStateMachine::state_device_ready()
                     tr_info("Modem revision: %s", buf);
                 }
                 delete[] buf;
+                _cellularDevice.close_information();
             }
-            _cellularDevice.close_information();
 #endif // MBED_CONF_MBED_TRACE_ENABLE
 
             if (device_ready()) {
@@ -390,6 +403,7 @@ void CellularStateMachine::state_device_ready()
                 tr_warning("Power cycle CellularDevice and restart connecting");
                 (void) _cellularDevice.soft_power_off();
                 (void) _cellularDevice.hard_power_off();
+                _modem_configured = false;
                 _status = 0;
                 _is_retry = true;
                 enter_to_state(STATE_INIT);
@@ -410,17 +424,20 @@ void CellularStateMachine::state_sim_pin()
     change_timeout(_state_timeout_sim_pin);
     tr_info("Setup SIM (timeout %d ms)", _state_timeout_sim_pin.count());
     if (open_sim()) {
-        bool success = false;
-        for (int type = 0; type < CellularNetwork::C_MAX; type++) {
-            _cb_data.error = _network.set_registration_urc((CellularNetwork::RegistrationType)type, true);
-            if (!_cb_data.error && (type == CellularNetwork::C_EREG || type == CellularNetwork::C_GREG)) {
-                success = true;
+        // URC's and event reporting stay enabled until the modem is powered off
+        if (!_modem_configured) {
+            bool success = false;
+            for (int type = 0; type < CellularNetwork::C_MAX; type++) {
+                _cb_data.error = _network.set_registration_urc((CellularNetwork::RegistrationType)type, true);
+                if (!_cb_data.error && (type == CellularNetwork::C_EREG || type == CellularNetwork::C_GREG)) {
+                    success = true;
+                }
+            }
+            if (!success) {
+                tr_error("Failed to set CEREG/CGREG URC's for registration");
+                retry_state_or_fail();
+                return;
             }
-        }
-        if (!success) {
-            tr_error("Failed to set CEREG/CGREG URC's for registration");
-            retry_state_or_fail();
-            return;
         }
         if (_network.is_active_context()) { // check if context was already activated
             tr_debug("Active context found.");
@@ -434,11 +451,14 @@ void CellularStateMachine::state_sim_pin()
 
         // if packet domain event reporting is not set it's not a stopper. We might lack some events when we are
         // dropped from the network.
-        _cb_data.error = _network.set_packet_domain_event_reporting(true);
-        if (_cb_data.error == NSAPI_STATUS_ERROR_UNSUPPORTED) {
-            tr_warning("Packet domain event reporting not supported!");
-        } else if (_cb_data.error) {
-            tr_warning("Packet domain event reporting set failed!");
+        if (!_modem_configured) {
+            _cb_data.error = _network.set_packet_domain_event_reporting(true);
+            if (_cb_data.error == NSAPI_STATUS_ERROR_UNSUPPORTED) {
+                tr_warning("Packet domain event reporting not supported!");
+            } else if (_cb_data.error) {
+                tr_warning("Packet domain event reporting set failed!");
+            }
+            _modem_configured = true;
         }
         enter_to_state(STATE_SIGNAL_QUALITY);
     } else {
@@ -485,7 +505,7 @@ void CellularStateMachine::state_registering()
 
 void CellularStateMachine::state_attaching()
 {
-    if (_status != ATTACHED_TO_NETWORK) {
+    if (!(_status & ATTACHED_TO_NETWORK)) {
         change_timeout(_state_timeout_connect);
         tr_info("Attaching network (timeout %d ms)", _state_timeout_connect.count());
         _cb_data.error = _network.set_attach();
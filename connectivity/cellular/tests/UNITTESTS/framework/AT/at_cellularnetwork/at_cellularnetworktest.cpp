@@ -295,6 +295,35 @@ static void disconnect_cb(nsapi_event_t ev, intptr_t intptr)
     }
 }
 
+TEST_F(TestAT_CellularNetwork, test_AT_CellularNetwork_get_registration_params_multiple)
+{
+    EventQueue que;
+    FileHandle_stub fh1;
+    ATHandler at(&fh1, que, 0, ",");
+
+    AT_CellularNetwork cn(at, *_dev);
+    ATHandler_stub::nsapi_error_value = NSAPI_ERROR_OK;
+    ATHandler_stub::int_value = 3;
+    const CellularNetwork::RegistrationType types[] = { CellularNetwork::C_EREG, CellularNetwork::C_GREG };
+    CellularNetwork::registration_params_t reg_params[2];
+
+    ASSERT_EQ(NSAPI_ERROR_OK, cn.get_registration_params(types, reg_params, 2));
+    EXPECT_EQ(reg_params[0]._type, CellularNetwork::C_EREG);
+    EXPECT_EQ(reg_params[0]._status, CellularNetwork::RegistrationDenied);
+    EXPECT_EQ(reg_params[0]._act, CellularNetwork::RAT_EGPRS);
+    // CGREG is not supported by the device, so it is left out of the command line
+    EXPECT_EQ(reg_params[1]._type, CellularNetwork::C_MAX);
+    EXPECT_EQ(reg_params[1]._status, CellularNetwork::StatusNotAvailable);
+
+    const CellularNetwork::RegistrationType unsupported[] = { CellularNetwork::C_GREG };
+    ASSERT_EQ(NSAPI_ERROR_UNSUPPORTED, cn.get_registration_params(unsupported, reg_params, 1));
+
+    ATHandler_stub::nsapi_error_value = NSAPI_ERROR_DEVICE_ERROR;
+    ASSERT_EQ(NSAPI_ERROR_DEVICE_ERROR, cn.get_registration_params(types, reg_params, 2));
+    EXPECT_EQ(reg_params[0]._type, CellularNetwork::C_MAX);
+    EXPECT_EQ(reg_params[1]._type, CellularNetwork::C_MAX);
+}
+
 TEST_F(TestAT_CellularNetwork, test_AT_CellularNetwork_registration_status_change)
 {
     EventQueue que;
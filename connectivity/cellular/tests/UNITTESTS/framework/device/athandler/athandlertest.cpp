@@ -257,6 +257,52 @@ TEST_F(TestATHandler, test_ATHandler_process_oob)
     filehandle_stub_table = NULL;
 }
 
+TEST_F(TestATHandler, test_ATHandler_process_oob_urc_buckets)
+{
+    EventQueue que;
+    FileHandle_stub fh1;
+
+    ATHandler at(&fh1, que, 0, ",");
+    at.set_at_timeout(10);
+
+    at.set_urc_handler("+CEREG:", &urc2_callback);
+    at.set_urc_handler("+CGREG:", &urc2_callback);
+    at.set_urc_handler("+QIURC:", &urc_callback);
+    at.set_urc_handler("+QIOPEN:", &urc2_callback);
+    at.set_urc_handler("+", &urc2_callback);
+
+    char table[] = "+QIURC: \"recv\",0\r\n\0";
+    filehandle_stub_table = table;
+    filehandle_stub_table_pos = 0;
+    mbed_poll_stub::revents_value = POLLIN;
+    mbed_poll_stub::int_value = 1;
+    filehandle_stub_short_value_counter = 1;
+    fh1.short_value = POLLIN;
+    at.process_oob();
+
+    // Longer prefix in its own bucket wins over the short one
+    EXPECT_EQ(1, urc_callback_count);
+    ATHandler::urc_stats_t stats = at.get_urc_stats();
+    EXPECT_EQ(1, stats.count);
+
+    // Removing the URC from its bucket leaves the short prefix to match
+    at.set_urc_handler("+QIURC:", NULL);
+    filehandle_stub_table_pos = 0;
+    filehandle_stub_short_value_counter = 1;
+    at.process_oob();
+    EXPECT_EQ(1, urc_callback_count);
+    EXPECT_EQ(2, at.get_urc_stats().count);
+
+    at.reset_urc_stats();
+    stats = at.get_urc_stats();
+    EXPECT_EQ(0, stats.count);
+    EXPECT_TRUE(stats.max_time == rtos::Kernel::Clock::duration::zero());
+
+    filehandle_stub_short_value_counter = 0;
+    filehandle_stub_table_pos = 0;
+    filehandle_stub_table = NULL;
+}
+
 TEST_F(TestATHandler, test_ATHandler_flush)
 {
     EventQueue que;
@@ -508,6 +554,39 @@ TEST_F(TestATHandler, test_ATHandler_read_bytes)
     EXPECT_EQ(NSAPI_ERROR_DEVICE_ERROR, at.get_last_error());
 }
 
+TEST_F(TestATHandler, test_ATHandler_read_bytes_large)
+{
+    EventQueue que;
+    FileHandle_stub fh1;
+
+    ATHandler at(&fh1, que, 0, ",");
+    uint8_t buf[48];
+
+    char table[] = "0123456789abcdef0123456789abcdef0123456789abcdefOK\r\n\0";
+    filehandle_stub_table = table;
+    filehandle_stub_table_pos = 0;
+    mbed_poll_stub::revents_value = POLLIN;
+    mbed_poll_stub::int_value = 1;
+
+    // Payload larger than the receiving buffer is read straight to the caller's buffer
+    EXPECT_EQ(40, at.read_bytes(buf, 40));
+    EXPECT_TRUE(!memcmp(buf, table, 40));
+    EXPECT_EQ(filehandle_stub_table_pos, 40);
+
+    // Rest goes through the receiving buffer
+    EXPECT_EQ(8, at.read_bytes(buf, 8));
+    EXPECT_TRUE(!memcmp(buf, table + 40, 8));
+    EXPECT_EQ(filehandle_stub_table_pos, strlen(table));
+
+    // Partly buffered payload is copied first, then read directly
+    at.flush();
+    filehandle_stub_table_pos = 0;
+    EXPECT_EQ(4, at.read_bytes(buf, 4));
+    EXPECT_EQ(44, at.read_bytes(buf, 44));
+    EXPECT_TRUE(!memcmp(buf, table + 4, 44));
+    EXPECT_EQ(NSAPI_ERROR_OK, at.get_last_error());
+}
+
 TEST_F(TestATHandler, test_ATHandler_read_string)
 {
     EventQueue que;
@@ -561,7 +640,7 @@ TEST_F(TestATHandler, test_ATHandler_read_string)
     filehandle_stub_table_pos = 0;
     mbed_poll_stub::revents_value = POLLIN;
     mbed_poll_stub::int_value = 1;
-    char buf3[1];
+    char buf3[2];
     // Set _stop_tag to resp_stop(OKCRLF)
     at.resp_start();
     // OK because after CRLF matched there is more data to read ending in CRLF
@@ -785,6 +864,56 @@ TEST_F(TestATHandler, test_ATHandler_read_string_with_delimiter)
     EXPECT_STREQ("20/04/05,15:38:57+12", buf1);
 }
 
+TEST_F(TestATHandler, test_ATHandler_read_binary_data)
+{
+    EventQueue que;
+    FileHandle_stub fh1;
+    filehandle_stub_table = NULL;
+    filehandle_stub_table_pos = 0;
+
+    ATHandler at(&fh1, que, 0, ",");
+    uint8_t buf[8];
+
+    // *** Unquoted, payload contains the delimiter and part of the stop tag ***
+    at.clear_error();
+    char table1[] = "a,b\r\nOK,5\r\nOK\r\n";
+    at.flush();
+    filehandle_stub_table = table1;
+    filehandle_stub_table_pos = 0;
+    mbed_poll_stub::revents_value = POLLIN;
+    mbed_poll_stub::int_value = 1;
+    // Set _stop_tag to resp_stop(OKCRLF)
+    at.resp_start();
+    EXPECT_EQ(7, at.read_binary_data(buf, 7));
+    EXPECT_TRUE(!memcmp(buf, "a,b\r\nOK", 7));
+    EXPECT_EQ(5, at.read_int());
+    at.resp_stop();
+    EXPECT_EQ(NSAPI_ERROR_OK, at.get_last_error());
+
+    // *** Quoted ***
+    at.clear_error();
+    char table2[] = "\"x\"y\",1\r\nOK\r\n";
+    at.flush();
+    filehandle_stub_table = table2;
+    filehandle_stub_table_pos = 0;
+    at.resp_start();
+    EXPECT_EQ(3, at.read_binary_data(buf, 3));
+    EXPECT_TRUE(!memcmp(buf, "x\"y", 3));
+    EXPECT_EQ(1, at.read_int());
+    at.resp_stop();
+    EXPECT_EQ(NSAPI_ERROR_OK, at.get_last_error());
+
+    // *** Shorter than the given length ***
+    at.clear_error();
+    char table3[] = "abc";
+    at.flush();
+    filehandle_stub_table = table3;
+    filehandle_stub_table_pos = 0;
+    at.resp_start();
+    EXPECT_EQ(-1, at.read_binary_data(buf, 8));
+    EXPECT_EQ(NSAPI_ERROR_DEVICE_ERROR, at.get_last_error());
+}
+
 TEST_F(TestATHandler, test_ATHandler_read_hex_string)
 {
     EventQueue que;
@@ -1262,6 +1391,36 @@ TEST_F(TestATHandler, test_ATHandler_cmd_start_stop)
     at.cmd_start_stop("+CREG", "=1,", "%d%s%b", 3, "test", byte, 4);
 }
 
+TEST_F(TestATHandler, test_ATHandler_cmd_append)
+{
+    EventQueue que;
+    FileHandle_stub fh1;
+
+    ATHandler at(&fh1, que, 0, ",");
+    mbed_poll_stub::revents_value = POLLOUT;
+    mbed_poll_stub::int_value = 1;
+
+    // AT+CEREG? on one write, then ;+CGREG? as three
+    fh1.size_value = 100;
+    at.cmd_append("+CEREG", "?");
+    EXPECT_EQ(99, fh1.size_value);
+    at.cmd_append("+CGREG", "?");
+    EXPECT_EQ(96, fh1.size_value);
+    at.cmd_stop();
+    EXPECT_EQ(NSAPI_ERROR_OK, at.get_last_error());
+
+    // A new command line starts after cmd_stop
+    fh1.size_value = 100;
+    at.cmd_append("+CREG", "=", "%d", 2);
+    EXPECT_EQ(98, fh1.size_value);
+    at.cmd_append("+CEREG", "=", "%d", 2);
+    EXPECT_EQ(94, fh1.size_value);
+    at.cmd_stop();
+    EXPECT_EQ(NSAPI_ERROR_OK, at.get_last_error());
+
+    mbed_poll_stub::revents_value = POLLIN;
+}
+
 TEST_F(TestATHandler, test_ATHandler_at_cmd_str)
 {
     EventQueue que;
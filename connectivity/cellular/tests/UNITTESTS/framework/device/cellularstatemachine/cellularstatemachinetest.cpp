@@ -403,7 +403,50 @@ TEST_F(TestCellularStateMachine, test_run_to_state)
     dev = NULL;
 }
 
+TEST_F(TestCellularStateMachine, test_reconnect_skips_modem_setup)
+{
+    UT_CellularStateMachine ut;
+    FileHandle_stub fh1;
+
+    CellularDevice *dev = new AT_CellularDevice(&fh1);
+    EXPECT_TRUE(dev);
+
+    CellularStateMachine *stm = ut.create_state_machine(*dev, *dev->get_queue(), *dev->open_network());
+    EXPECT_TRUE(stm);
+
+    ASSERT_EQ(NSAPI_ERROR_OK, ut.start_dispatch());
+
+    struct equeue_event ptr;
+    equeue_stub.void_ptr = &ptr;
+    equeue_stub.call_cb_immediately = true;
+    ut.set_cellular_callback(&cellular_callback);
+
+    UT_CellularState current_state;
+    UT_CellularState target_state;
+    AT_CellularNetwork_stub::set_registration_urc_call_count = 0;
+    ASSERT_EQ(NSAPI_ERROR_OK, ut.run_to_device_sim_ready());
+    (void)ut.get_current_status(current_state, target_state);
+    ASSERT_EQ(UT_STATE_SIM_PIN, current_state);
+    EXPECT_LT(0, AT_CellularNetwork_stub::set_registration_urc_call_count);
+    ut.reset();
 
+    // modem stayed powered, URC's are still set
+    AT_CellularNetwork_stub::set_registration_urc_call_count = 0;
+    ASSERT_EQ(NSAPI_ERROR_OK, ut.run_to_device_sim_ready());
+    (void)ut.get_current_status(current_state, target_state);
+    ASSERT_EQ(UT_STATE_SIM_PIN, current_state);
+    EXPECT_EQ(0, AT_CellularNetwork_stub::set_registration_urc_call_count);
 
+    // stopping may power off the modem so setup is done again
+    ut.stop();
+    ASSERT_EQ(NSAPI_ERROR_OK, ut.start_dispatch());
+    ASSERT_EQ(NSAPI_ERROR_OK, ut.run_to_device_sim_ready());
+    (void)ut.get_current_status(current_state, target_state);
+    ASSERT_EQ(UT_STATE_SIM_PIN, current_state);
+    EXPECT_LT(0, AT_CellularNetwork_stub::set_registration_urc_call_count);
 
+    ut.delete_state_machine();
 
+    delete dev;
+    dev = NULL;
+}
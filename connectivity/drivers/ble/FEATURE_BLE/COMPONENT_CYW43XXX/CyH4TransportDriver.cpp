@@ -113,10 +113,20 @@ static void on_controller_irq(void *callback_arg, cyhal_uart_event_t event)
     cyhal_uart_t *uart_obj = (cyhal_uart_t *)callback_arg;
     sleep_manager_lock_deep_sleep();
 
+    uint8_t buffer[16];
+    uint16_t count = 0;
+
+    // Drain the UART, handing the bytes over in bursts rather than one by one
     while (cyhal_uart_readable(uart_obj)) {
-        uint8_t char_received;
-        cyhal_uart_getc(uart_obj, &char_received, 0);
-        CyH4TransportDriver::on_data_received(&char_received, 1);
+        cyhal_uart_getc(uart_obj, &buffer[count++], 0);
+        if (count == sizeof(buffer)) {
+            CyH4TransportDriver::on_data_received(buffer, count);
+            count = 0;
+        }
+    }
+
+    if (count) {
+        CyH4TransportDriver::on_data_received(buffer, count);
     }
 
     sleep_manager_unlock_deep_sleep();
@@ -370,8 +370,7 @@ nsapi_size_or_error_t QUECTEL_BG96_CellularStack::socket_sendto_impl(CellularSoc
         }
     }
 
-    _at.resp_start(">");
-    _at.write_bytes((uint8_t *)data, size);
+    _at.write_binary_data((uint8_t *)data, size);
     _at.resp_start();
     _at.set_stop_tag("\r\n");
     // Possible responses are SEND OK, SEND FAIL or ERROR.
@@ -429,8 +429,7 @@ nsapi_size_or_error_t QUECTEL_M26_CellularStack::socket_sendto_impl(CellularSock
 
     _at.cmd_start_stop("+QISEND", "=", "%d%d", socket->id, sent_len);
 
-    _at.resp_start(">");
-    _at.write_bytes((uint8_t *)data, sent_len);
+    _at.write_binary_data((uint8_t *)data, sent_len);
     _at.resp_start();
     _at.set_stop_tag("\r\n");
     // Possible responses are SEND OK, SEND FAIL or ERROR.
@@ -248,8 +248,14 @@ bool Kinetis_EMAC::low_level_init_successful()
     config.interrupt = kENET_RxFrameInterrupt | kENET_TxFrameInterrupt;
     config.rxMaxFrameLen = ENET_ETH_MAX_FLEN;
     config.macSpecialConfig = kENET_ControlFlowControlEnable;
+#if MBED_CONF_KINETIS_EMAC_CHECKSUM_OFFLOAD
+    /* Relies on the default store and forward mode */
+    config.txAccelerConfig = kENET_TxAccelIpCheckEnabled | kENET_TxAccelProtoCheckEnabled;
+    config.rxAccelerConfig = kENET_RxAccelMacCheckEnabled | kENET_RxAccelIpCheckEnabled | kENET_RxAccelProtoCheckEnabled;
+#else
     config.txAccelerConfig = 0;
     config.rxAccelerConfig = kENET_RxAccelMacCheckEnabled;
+#endif
     ENET_Init(ENET, &g_handle, &config, &buffCfg, hwaddr, sysClock);
 
     ENET_SetCallback(&g_handle, &Kinetis_EMAC::ethernet_callback, this);
@@ -527,6 +533,16 @@ uint32_t Kinetis_EMAC::get_align_preference() const
     return ENET_BUFF_ALIGNMENT;
 }
 
+uint32_t Kinetis_EMAC::get_checksum_offload() const
+{
+#if MBED_CONF_KINETIS_EMAC_CHECKSUM_OFFLOAD
+    return CHECKSUM_OFFLOAD_TX_IP | CHECKSUM_OFFLOAD_TX_UDP | CHECKSUM_OFFLOAD_TX_TCP | CHECKSUM_OFFLOAD_TX_ICMP |
+           CHECKSUM_OFFLOAD_RX_IP | CHECKSUM_OFFLOAD_RX_UDP | CHECKSUM_OFFLOAD_RX_TCP | CHECKSUM_OFFLOAD_RX_ICMP;
+#else
+    return 0;
+#endif
+}
+
 void Kinetis_EMAC::get_ifname(char *name, uint8_t size) const
 {
     memcpy(name, KINETIS_ETH_IF_NAME, (size < sizeof(KINETIS_ETH_IF_NAME)) ? size : sizeof(KINETIS_ETH_IF_NAME));
@@ -44,6 +44,13 @@ public:
      */
     virtual uint32_t get_align_preference() const;
 
+    /**
+     * Gets checksum offload capabilities
+     *
+     * @return         Bitmask of checksum_offload_t flags handled in hardware
+     */
+    virtual uint32_t get_checksum_offload() const;
+
     /**
      * Return interface name
      *
@@ -47,6 +47,7 @@
 #include "imx_emac_config.h"
 #include "imx_emac.h"
 #include "mbed_power_mgmt.h"
+#include "platform/mbed_dcache.h"
 
 using namespace std::chrono;
 
@@ -205,7 +206,7 @@ bool Kinetis_EMAC::low_level_init_successful()
         }
 
         rx_ptr[i] = (uint32_t *)memory_manager->get_ptr(rx_buff[i]);
-        SCB_InvalidateDCache_by_Addr(rx_ptr[i], ENET_ALIGN(ENET_ETH_MAX_FLEN, ENET_BUFF_ALIGNMENT));
+        mbed_dcache_invalidate(rx_ptr[i], ENET_ALIGN(ENET_ETH_MAX_FLEN, ENET_BUFF_ALIGNMENT));
     }
 
     tx_consume_index = tx_produce_index = 0;
@@ -279,7 +280,7 @@ emac_mem_buf_t *Kinetis_EMAC::low_level_input(int idx)
 
         /* Zero-copy */
         p = rx_buff[idx];
-        SCB_InvalidateDCache_by_Addr(rx_ptr[idx], length);
+        mbed_dcache_invalidate(rx_ptr[idx], length);
         memory_manager->set_len(p, length);
 
         /* Attempt to queue new buffer */
@@ -298,7 +299,7 @@ emac_mem_buf_t *Kinetis_EMAC::low_level_input(int idx)
 
         rx_buff[idx] = temp_rxbuf;
         rx_ptr[idx] = (uint32_t *)memory_manager->get_ptr(rx_buff[idx]);
-        SCB_InvalidateDCache_by_Addr(rx_ptr[idx], ENET_ALIGN(ENET_ETH_MAX_FLEN, ENET_BUFF_ALIGNMENT));
+        mbed_dcache_invalidate(rx_ptr[idx], ENET_ALIGN(ENET_ETH_MAX_FLEN, ENET_BUFF_ALIGNMENT));
 
         update_read_buffer((uint8_t *)rx_ptr[idx]);
     }
@@ -403,7 +404,7 @@ bool Kinetis_EMAC::link_out(emac_mem_buf_t *buf)
         buf = copy_buf;
     }
 
-    SCB_CleanDCache_by_Addr(static_cast<uint32_t *>(memory_manager->get_ptr(buf)), memory_manager->get_len(buf));
+    mbed_dcache_clean(memory_manager->get_ptr(buf), memory_manager->get_len(buf));
 
     /* Check if a descriptor is available for the transfer (wait 10ms before dropping the buffer) */
     if (!xTXDCountSem.try_acquire_for(10)) {
@@ -27,6 +27,7 @@
 #include "netsocket/nsapi_types.h"
 #include "platform/mbed_power_mgmt.h"
 #include "platform/mbed_error.h"
+#include "platform/mbed_dcache.h"
 
 #include "stm32xx_emac_config.h"
 #include "stm32xx_emac.h"
@@ -97,6 +98,18 @@ __ALIGN_BEGIN uint8_t Rx_Buff[ETH_RXBUFNB][ETH_RX_BUF_SIZE] __ALIGN_END; /* Ethe
 #endif
 __ALIGN_BEGIN uint8_t Tx_Buff[ETH_TXBUFNB][ETH_TX_BUF_SIZE] __ALIGN_END; /* Ethernet Transmit Buffer */
 
+#if MBED_CONF_STM32_EMAC_ETH_ZERO_COPY
+
+/* Rx buffers are invalidated as a whole, so round them up to full cache lines */
+#define ETH_ZC_RX_BUF_SIZE      MBED_DMA_SIZE(ETH_RX_BUF_SIZE)
+
+/* Time to wait for the DMA to release a zero-copy frame */
+#define ETH_ZC_TX_TIMEOUT_MS    50U
+
+static emac_mem_buf_t *Rx_Mem[ETH_RXBUFNB]; /* Memory manager buffers lent to the Rx DMA descriptors */
+
+#endif // MBED_CONF_STM32_EMAC_ETH_ZERO_COPY
+
 #else // ETH_IP_VERSION_V2
 
 #if defined ( __ICCARM__ ) /*!< IAR Compiler */
@@ -275,6 +288,9 @@ STM32_EMAC::STM32_EMAC()
 #ifdef ETH_IP_VERSION_V2
     , phy_status(0)
 #endif
+#if MBED_CONF_STM32_EMAC_ETH_ZERO_COPY && !defined(ETH_IP_VERSION_V2)
+    , rx_zero_copy(false)
+#endif
 {
 }
 
@@ -317,7 +333,12 @@ bool STM32_EMAC::low_level_init_successful()
 #endif
     EthHandle.Init.MACAddr = &MACAddr[0];
     EthHandle.Init.RxMode = ETH_RXINTERRUPT_MODE;
+#if MBED_CONF_STM32_EMAC_ETH_CHECKSUM_OFFLOAD
+    /* Frames failing the check are dropped by the DMA in store and forward mode */
+    EthHandle.Init.ChecksumMode = ETH_CHECKSUM_BY_HARDWARE;
+#else
     EthHandle.Init.ChecksumMode = ETH_CHECKSUM_BY_SOFTWARE;
+#endif
     EthHandle.Init.MediaInterface = MBED_CONF_STM32_EMAC_ETH_PHY_MEDIA_INTERFACE;
     tr_info("power_up: PHY Addr %u AutoNeg %u", EthHandle.Init.PhyAddress, EthHandle.Init.AutoNegotiation);
     tr_debug("MAC Addr %02x:%02x:%02x:%02x:%02x:%02x", MACAddr[0], MACAddr[1], MACAddr[2], MACAddr[3], MACAddr[4], MACAddr[5]);
@@ -351,6 +372,12 @@ bool STM32_EMAC::low_level_init_successful()
         return false;
     }
 
+#if MBED_CONF_STM32_EMAC_ETH_ZERO_COPY
+    /* Point the Rx descriptors at buffers that can be passed up the stack as they are */
+    rx_zero_copy = rx_zero_copy_init();
+    tr_info("ETH Rx zero-copy %s", rx_zero_copy ? "enabled" : "disabled");
+#endif
+
     /* Configure MAC */
     _eth_config_mac(&EthHandle);
 
@@ -425,6 +452,9 @@ bool STM32_EMAC::low_level_init_successful()
 bool STM32_EMAC::link_out(emac_mem_buf_t *buf)
 #ifndef ETH_IP_VERSION_V2
 {
+#if MBED_CONF_STM32_EMAC_ETH_ZERO_COPY
+    return tx_zero_copy_out(buf);
+#else
     bool success = true;
     emac_mem_buf_t *q;
     uint8_t *buffer = reinterpret_cast<uint8_t *>(EthHandle.TxDesc->Buffer1Addr);
@@ -501,6 +531,7 @@ error:
     TXLockMutex.unlock();
 
     return success;
+#endif // MBED_CONF_STM32_EMAC_ETH_ZERO_COPY
 }
 #else // ETH_IP_VERSION_V2
 {
@@ -596,35 +627,43 @@ int STM32_EMAC::low_level_input(emac_mem_buf_t **buf)
 
     dmarxdesc = EthHandle.RxFrameInfos.FSRxDesc;
 
-    if (len > 0 && len <= ETH_RX_BUF_SIZE) {
-        tr_debug_deep("low_level_input len %u", len);
-        /* Allocate a memory buffer chain from buffer pool */
-        *buf = memory_manager->alloc_pool(len, 0);
-    }
+#if MBED_CONF_STM32_EMAC_ETH_ZERO_COPY
+    if (rx_zero_copy) {
+        /* Pass the DMA buffers up and give the descriptors fresh ones */
+        rx_zero_copy_input(buf);
+    } else
+#endif
+    {
+        if (len > 0 && len <= ETH_RX_BUF_SIZE) {
+            tr_debug_deep("low_level_input len %u", len);
+            /* Allocate a memory buffer chain from buffer pool */
+            *buf = memory_manager->alloc_pool(len, 0);
+        }
 
-    if (*buf != NULL) {
-        dmarxdesc = EthHandle.RxFrameInfos.FSRxDesc;
-        bufferoffset = 0;
-        for (q = *buf; q != NULL; q = memory_manager->get_next(q)) {
-            byteslefttocopy = memory_manager->get_len(q);
-            payloadoffset = 0;
-
-            /* Check if the length of bytes to copy in current pbuf is bigger than Rx buffer size*/
-            while ((byteslefttocopy + bufferoffset) > ETH_RX_BUF_SIZE) {
-                /* Copy data to pbuf */
-                memcpy(static_cast<uint8_t *>(memory_manager->get_ptr(q)) + payloadoffset, static_cast<uint8_t *>(buffer) + bufferoffset, ETH_RX_BUF_SIZE - bufferoffset);
-
-                /* Point to next descriptor */
-                dmarxdesc = reinterpret_cast<ETH_DMADescTypeDef *>(dmarxdesc->Buffer2NextDescAddr);
-                buffer = reinterpret_cast<uint8_t *>(dmarxdesc->Buffer1Addr);
-
-                byteslefttocopy = byteslefttocopy - (ETH_RX_BUF_SIZE - bufferoffset);
-                payloadoffset = payloadoffset + (ETH_RX_BUF_SIZE - bufferoffset);
-                bufferoffset = 0;
+        if (*buf != NULL) {
+            dmarxdesc = EthHandle.RxFrameInfos.FSRxDesc;
+            bufferoffset = 0;
+            for (q = *buf; q != NULL; q = memory_manager->get_next(q)) {
+                byteslefttocopy = memory_manager->get_len(q);
+                payloadoffset = 0;
+
+                /* Check if the length of bytes to copy in current pbuf is bigger than Rx buffer size*/
+                while ((byteslefttocopy + bufferoffset) > ETH_RX_BUF_SIZE) {
+                    /* Copy data to pbuf */
+                    memcpy(static_cast<uint8_t *>(memory_manager->get_ptr(q)) + payloadoffset, static_cast<uint8_t *>(buffer) + bufferoffset, ETH_RX_BUF_SIZE - bufferoffset);
+
+                    /* Point to next descriptor */
+                    dmarxdesc = reinterpret_cast<ETH_DMADescTypeDef *>(dmarxdesc->Buffer2NextDescAddr);
+                    buffer = reinterpret_cast<uint8_t *>(dmarxdesc->Buffer1Addr);
+
+                    byteslefttocopy = byteslefttocopy - (ETH_RX_BUF_SIZE - bufferoffset);
+                    payloadoffset = payloadoffset + (ETH_RX_BUF_SIZE - bufferoffset);
+                    bufferoffset = 0;
+                }
+                /* Copy remaining data in pbuf */
+                memcpy(static_cast<uint8_t *>(memory_manager->get_ptr(q)) + payloadoffset, static_cast<uint8_t *>(buffer) + bufferoffset, byteslefttocopy);
+                bufferoffset = bufferoffset + byteslefttocopy;
             }
-            /* Copy remaining data in pbuf */
-            memcpy(static_cast<uint8_t *>(memory_manager->get_ptr(q)) + payloadoffset, static_cast<uint8_t *>(buffer) + bufferoffset, byteslefttocopy);
-            bufferoffset = bufferoffset + byteslefttocopy;
         }
     }
 
@@ -663,10 +702,8 @@ int STM32_EMAC::low_level_input(emac_mem_buf_t **buf)
         /* Build Rx descriptor to be ready for next data reception */
         HAL_ETH_BuildRxDescriptors(&EthHandle);
 
-#if !(defined(DUAL_CORE) && defined(CORE_CM4))
         /* Invalidate data cache for ETH Rx Buffers */
-        SCB_InvalidateDCache_by_Addr((uint32_t *)RxBuff.buffer, frameLength);
-#endif
+        mbed_dcache_invalidate(RxBuff.buffer, frameLength);
 
         *buf = pbuf_alloc(PBUF_RAW, frameLength, PBUF_POOL);
         if (*buf) {
@@ -680,6 +717,230 @@ int STM32_EMAC::low_level_input(emac_mem_buf_t **buf)
 }
 #endif // ETH_IP_VERSION_V2
 
+#if MBED_CONF_STM32_EMAC_ETH_ZERO_COPY && !defined(ETH_IP_VERSION_V2)
+/**
+ * Allocates a contiguous buffer the DMA can receive a full frame into.
+ *
+ * @return the buffer, or NULL if out of memory
+ */
+emac_mem_buf_t *STM32_EMAC::rx_buf_alloc()
+{
+    const uint32_t align = get_align_preference();
+    emac_mem_buf_t *buf = NULL;
+
+    /* A descriptor needs a single segment, so only use the pool if one unit holds a full frame */
+    if (memory_manager->get_pool_alloc_unit(align) >= ETH_ZC_RX_BUF_SIZE) {
+        buf = memory_manager->alloc_pool(ETH_ZC_RX_BUF_SIZE, align);
+    }
+    if (buf == NULL) {
+        buf = memory_manager->alloc_heap(ETH_ZC_RX_BUF_SIZE, align);
+    }
+    if (buf != NULL) {
+        /* No dirty line may be evicted on top of what the DMA writes */
+        mbed_dcache_clean_invalidate(memory_manager->get_ptr(buf), ETH_ZC_RX_BUF_SIZE);
+    }
+    return buf;
+}
+
+/**
+ * Attaches a memory manager buffer to every Rx DMA descriptor.
+ *
+ * @return true if all descriptors got a buffer, false if the static Rx_Buff is kept
+ */
+bool STM32_EMAC::rx_zero_copy_init()
+{
+    for (uint32_t i = 0; i < ETH_RXBUFNB; i++) {
+        if (Rx_Mem[i] == NULL) {
+            Rx_Mem[i] = rx_buf_alloc();
+        }
+        if (Rx_Mem[i] == NULL) {
+            tr_warning("Rx zero-copy: out of memory for descriptor %u", i);
+            for (uint32_t j = 0; j < ETH_RXBUFNB; j++) {
+                if (Rx_Mem[j] != NULL) {
+                    memory_manager->free(Rx_Mem[j]);
+                    Rx_Mem[j] = NULL;
+                }
+            }
+            return false;
+        }
+    }
+
+    /* DMA is not started yet, descriptors can be modified in place */
+    for (uint32_t i = 0; i < ETH_RXBUFNB; i++) {
+        DMARxDscrTab[i].Buffer1Addr = reinterpret_cast<uint32_t>(memory_manager->get_ptr(Rx_Mem[i]));
+    }
+    return true;
+}
+
+/**
+ * Takes the buffers of the received frame off its descriptors and refills them.
+ *
+ * Replacement buffers are allocated first: if that fails, the frame is dropped
+ * and the descriptors keep their buffers, so the ring never runs dry.
+ *
+ * @param buf Set to the received frame, left NULL if it was dropped
+ */
+void STM32_EMAC::rx_zero_copy_input(emac_mem_buf_t **buf)
+{
+    emac_mem_buf_t *fresh[ETH_RXBUFNB];
+    __IO ETH_DMADescTypeDef *dmarxdesc = EthHandle.RxFrameInfos.FSRxDesc;
+    const uint32_t segcount = EthHandle.RxFrameInfos.SegCount;
+    uint32_t byteslefttotake = EthHandle.RxFrameInfos.length;
+    uint32_t i;
+
+    if (byteslefttotake == 0 || segcount > ETH_RXBUFNB) {
+        return;
+    }
+
+    for (i = 0; i < segcount; i++) {
+        fresh[i] = rx_buf_alloc();
+        if (fresh[i] == NULL) {
+            tr_debug_deep("low_level_input no buffer, frame dropped");
+            while (i > 0) {
+                memory_manager->free(fresh[--i]);
+            }
+            return;
+        }
+    }
+
+    tr_debug_deep("low_level_input zero-copy len %u", byteslefttotake);
+    for (i = 0; i < segcount; i++) {
+        const uint32_t idx = dmarxdesc - DMARxDscrTab;
+        const uint32_t seglen = byteslefttotake < ETH_RX_BUF_SIZE ? byteslefttotake : ETH_RX_BUF_SIZE;
+        emac_mem_buf_t *q = Rx_Mem[idx];
+
+        /* Drop lines speculatively fetched while the DMA was writing */
+        mbed_dcache_invalidate(memory_manager->get_ptr(q), ETH_ZC_RX_BUF_SIZE);
+        memory_manager->set_len(q, seglen);
+        byteslefttotake -= seglen;
+        if (*buf == NULL) {
+            *buf = q;
+        } else {
+            memory_manager->cat(*buf, q);
+        }
+
+        Rx_Mem[idx] = fresh[i];
+        dmarxdesc->Buffer1Addr = reinterpret_cast<uint32_t>(memory_manager->get_ptr(fresh[i]));
+        dmarxdesc = reinterpret_cast<ETH_DMADescTypeDef *>(dmarxdesc->Buffer2NextDescAddr);
+    }
+}
+
+/**
+ * Transmits a frame straight from its memory buffers.
+ *
+ * Each segment gets its own Tx descriptor. The stack may hand over buffers
+ * referencing application data, so this waits for the DMA to release the
+ * descriptors before freeing the frame, as the ETH_IP_VERSION_V2 path does.
+ * Chains longer than the ring are copied into the static Tx_Buff instead.
+ *
+ * @param buf the MAC packet to send
+ * @return true if the packet was sent
+ */
+bool STM32_EMAC::tx_zero_copy_out(emac_mem_buf_t *buf)
+{
+    bool success = true;
+    ETH_DMADescTypeDef *desc[ETH_TXBUFNB];
+    uint32_t segcount = 0;
+    uint32_t count = 0;
+    emac_mem_buf_t *q;
+
+    /* Get exclusive access */
+    TXLockMutex.lock();
+
+    for (q = buf; q != NULL; q = memory_manager->get_next(q)) {
+        if (memory_manager->get_len(q) > 0) {
+            segcount++;
+        }
+    }
+    if (segcount == 0) {
+        success = false;
+        goto error;
+    }
+
+    /* Collect the descriptors first so nothing is handed over for a frame that doesn't fit */
+    desc[0] = EthHandle.TxDesc;
+    count = segcount <= ETH_TXBUFNB ? segcount : 1;
+    for (uint32_t i = 0; i < count; i++) {
+        if (i > 0) {
+            desc[i] = reinterpret_cast<ETH_DMADescTypeDef *>(desc[i - 1]->Buffer2NextDescAddr);
+        }
+        if ((desc[i]->Status & ETH_DMATXDESC_OWN) != (uint32_t)RESET) {
+            success = false;
+            goto error;
+        }
+        desc[i]->Status &= ~(ETH_DMATXDESC_FS | ETH_DMATXDESC_LS);
+    }
+
+    if (segcount > ETH_TXBUFNB) {
+        uint8_t *buffer = Tx_Buff[desc[0] - DMATxDscrTab];
+        uint32_t framelength = memory_manager->copy_from_buf(buffer, ETH_TX_BUF_SIZE, buf);
+
+        mbed_dcache_clean(buffer, framelength);
+        desc[0]->Buffer1Addr = reinterpret_cast<uint32_t>(buffer);
+        desc[0]->ControlBufferSize = (framelength & ETH_DMATXDESC_TBS1);
+    } else {
+        uint32_t i = 0;
+        for (q = buf; q != NULL; q = memory_manager->get_next(q)) {
+            const uint32_t len = memory_manager->get_len(q);
+            if (len == 0) {
+                continue;
+            }
+            mbed_dcache_clean(memory_manager->get_ptr(q), len);
+            desc[i]->Buffer1Addr = reinterpret_cast<uint32_t>(memory_manager->get_ptr(q));
+            desc[i]->ControlBufferSize = (len & ETH_DMATXDESC_TBS1);
+            i++;
+        }
+    }
+    desc[0]->Status |= ETH_DMATXDESC_FS;
+    desc[count - 1]->Status |= ETH_DMATXDESC_LS;
+
+    /* Hand over the first descriptor last so the DMA never starts on a partial frame */
+    __DMB();
+    for (uint32_t i = count - 1; i > 0; i--) {
+        desc[i]->Status |= ETH_DMATXDESC_OWN;
+    }
+    __DMB();
+    desc[0]->Status |= ETH_DMATXDESC_OWN;
+    EthHandle.TxDesc = reinterpret_cast<ETH_DMADescTypeDef *>(desc[count - 1]->Buffer2NextDescAddr);
+    __DMB();
+
+    /* When Tx Buffer unavailable flag is set: clear it and resume transmission */
+    if ((EthHandle.Instance->DMASR & ETH_DMASR_TBUS) != (uint32_t)RESET) {
+        EthHandle.Instance->DMASR = ETH_DMASR_TBUS;
+        EthHandle.Instance->DMATPDR = 0;
+    }
+
+    {
+        const uint32_t tickstart = HAL_GetTick();
+        while ((desc[count - 1]->Status & ETH_DMATXDESC_OWN) != (uint32_t)RESET) {
+            if ((HAL_GetTick() - tickstart) > ETH_ZC_TX_TIMEOUT_MS) {
+                tr_error("Tx zero-copy: DMA timeout");
+                success = false;
+                break;
+            }
+        }
+    }
+
+error:
+
+    /* When Transmit Underflow flag is set, clear it and issue a Transmit Poll Demand to resume transmission */
+    if ((EthHandle.Instance->DMASR & ETH_DMASR_TUS) != (uint32_t)RESET) {
+        /* Clear TUS ETHERNET DMA flag */
+        EthHandle.Instance->DMASR = ETH_DMASR_TUS;
+
+        /* Resume DMA transmission*/
+        EthHandle.Instance->DMATPDR = 0;
+    }
+
+    memory_manager->free(buf);
+
+    /* Restore access */
+    TXLockMutex.unlock();
+
+    return success;
+}
+#endif // MBED_CONF_STM32_EMAC_ETH_ZERO_COPY && !ETH_IP_VERSION_V2
+
 /** \brief  Attempt to read a packet from the EMAC interface.
  *
  */
@@ -923,7 +1184,22 @@ uint32_t STM32_EMAC::get_mtu_size() const
 
 uint32_t STM32_EMAC::get_align_preference() const
 {
+#if MBED_CONF_STM32_EMAC_ETH_ZERO_COPY && !defined(ETH_IP_VERSION_V2)
+    return MBED_DCACHE_LINE_SIZE;
+#else
     return 0;
+#endif
+}
+
+uint32_t STM32_EMAC::get_checksum_offload() const
+{
+#if MBED_CONF_STM32_EMAC_ETH_CHECKSUM_OFFLOAD
+    /* ETH_IP_VERSION_V2 inserts through TxConfig and drops bad frames with the HAL defaults */
+    return CHECKSUM_OFFLOAD_TX_IP | CHECKSUM_OFFLOAD_TX_UDP | CHECKSUM_OFFLOAD_TX_TCP | CHECKSUM_OFFLOAD_TX_ICMP |
+           CHECKSUM_OFFLOAD_RX_IP | CHECKSUM_OFFLOAD_RX_UDP | CHECKSUM_OFFLOAD_RX_TCP | CHECKSUM_OFFLOAD_RX_ICMP;
+#else
+    return 0;
+#endif
 }
 
 void STM32_EMAC::get_ifname(char *name, uint8_t size) const
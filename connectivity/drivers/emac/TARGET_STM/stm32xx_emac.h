@@ -44,6 +44,13 @@ public:
      */
     virtual uint32_t get_align_preference() const;
 
+    /**
+     * Gets checksum offload capabilities
+     *
+     * @return         Bitmask of checksum_offload_t flags handled in hardware
+     */
+    virtual uint32_t get_checksum_offload() const;
+
     /**
      * Return interface name
      *
@@ -161,6 +168,12 @@ private:
     void phy_task();
     void enable_interrupts();
     void disable_interrupts();
+#if MBED_CONF_STM32_EMAC_ETH_ZERO_COPY && !defined(ETH_IP_VERSION_V2)
+    emac_mem_buf_t *rx_buf_alloc();
+    bool rx_zero_copy_init();
+    void rx_zero_copy_input(emac_mem_buf_t **buf);
+    bool tx_zero_copy_out(emac_mem_buf_t *buf);
+#endif
 
     mbed_rtos_storage_thread_t thread_cb;
 #if defined (STM32F767xx) || defined (STM32F769xx) || defined (STM32F777xx)\
@@ -173,6 +186,9 @@ private:
     emac_link_input_cb_t emac_link_input_cb; /**< Callback for incoming data */
     emac_link_state_change_cb_t emac_link_state_cb; /**< Link state change callback */
     EMACMemoryManager *memory_manager; /**< Memory manager */
+#if MBED_CONF_STM32_EMAC_ETH_ZERO_COPY && !defined(ETH_IP_VERSION_V2)
+    bool rx_zero_copy; /**< Rx descriptors point at memory manager buffers */
+#endif
 
     uint32_t phy_status;
     int phy_task_handle; /**< Handle for phy task event */
@@ -78,6 +78,10 @@ static int aes_set_key(mbedtls_aes_context *ctx,
         return (MBEDTLS_ERR_THREADING_MUTEX_ERROR);
     }
 #endif /* MBEDTLS_THREADING_C */
+#if defined(ST_CRYP_DMA)
+    crypto_engine_job_t owner;
+    cryp_acquire(&owner);
+#endif /* ST_CRYP_DMA */
 
     /* include the appropriate instance name */
 #if defined (AES)
@@ -129,6 +133,10 @@ static int aes_set_key(mbedtls_aes_context *ctx,
     ctx->ctx_save_cr = ctx->hcryp_aes.Instance->CR;
 
 exit :
+#if defined(ST_CRYP_DMA)
+    cryp_release(&owner);
+#endif /* ST_CRYP_DMA */
+
     /* Free context access */
 #if defined(MBEDTLS_THREADING_C)
     if (mbedtls_mutex_unlock(&cryp_mutex) != 0) {
@@ -338,6 +346,10 @@ int mbedtls_aes_crypt_ecb(mbedtls_aes_context *ctx,
         return (MBEDTLS_ERR_THREADING_MUTEX_ERROR);
     }
 #endif /* MBEDTLS_THREADING_C */
+#if defined(ST_CRYP_DMA)
+    crypto_engine_job_t owner;
+    cryp_acquire(&owner);
+#endif /* ST_CRYP_DMA */
 
     /* allow multi-context of CRYP use: restore context */
     ctx->hcryp_aes.Instance->CR = ctx->ctx_save_cr;
@@ -375,6 +387,10 @@ int mbedtls_aes_crypt_ecb(mbedtls_aes_context *ctx,
     ctx->ctx_save_cr = ctx->hcryp_aes.Instance->CR;
 
 exit:
+#if defined(ST_CRYP_DMA)
+    cryp_release(&owner);
+#endif /* ST_CRYP_DMA */
+
     /* Free context access */
 #if defined(MBEDTLS_THREADING_C)
     if (mbedtls_mutex_unlock(&cryp_mutex) != 0) {
@@ -419,6 +435,10 @@ int mbedtls_aes_crypt_cbc(mbedtls_aes_context *ctx,
         return (MBEDTLS_ERR_THREADING_MUTEX_ERROR);
     }
 #endif /* MBEDTLS_THREADING_C */
+#if defined(ST_CRYP_DMA)
+    crypto_engine_job_t owner;
+    cryp_acquire(&owner);
+#endif /* ST_CRYP_DMA */
 
     /* allow multi-context of CRYP use: restore context */
     ctx->hcryp_aes.Instance->CR = ctx->ctx_save_cr;
@@ -472,6 +492,10 @@ int mbedtls_aes_crypt_cbc(mbedtls_aes_context *ctx,
     ctx->ctx_save_cr = ctx->hcryp_aes.Instance->CR;
 
 exit:
+#if defined(ST_CRYP_DMA)
+    cryp_release(&owner);
+#endif /* ST_CRYP_DMA */
+
     /* Free context access */
 #if defined(MBEDTLS_THREADING_C)
     if (mbedtls_mutex_unlock(&cryp_mutex) != 0) {
@@ -105,6 +105,10 @@ int mbedtls_ccm_setkey(mbedtls_ccm_context *ctx,
         return (MBEDTLS_ERR_THREADING_MUTEX_ERROR);
     }
 #endif /* MBEDTLS_THREADING_C */
+#if defined(ST_CRYP_DMA)
+    crypto_engine_job_t owner;
+    cryp_acquire(&owner);
+#endif /* ST_CRYP_DMA */
 
     switch (keybits) {
         case 128:
@@ -161,6 +165,10 @@ int mbedtls_ccm_setkey(mbedtls_ccm_context *ctx,
     ctx->ctx_save_cr = ctx->hcryp_ccm.Instance->CR;
 
 exit :
+#if defined(ST_CRYP_DMA)
+    cryp_release(&owner);
+#endif /* ST_CRYP_DMA */
+
     /* Free context access */
 #if defined(MBEDTLS_THREADING_C)
     if (mbedtls_mutex_unlock(&cryp_mutex) != 0) {
@@ -292,6 +300,10 @@ static int ccm_auth_crypt(mbedtls_ccm_context *ctx, int mode, size_t length,
         return (MBEDTLS_ERR_THREADING_MUTEX_ERROR);
     }
 #endif /* MBEDTLS_THREADING_C */
+#if defined(ST_CRYP_DMA)
+    crypto_engine_job_t owner;
+    cryp_acquire(&owner);
+#endif /* ST_CRYP_DMA */
 
     /* allow multi-context of CRYP use: restore context */
     ctx->hcryp_ccm.Instance->CR = ctx->ctx_save_cr;
@@ -348,6 +360,16 @@ static int ccm_auth_crypt(mbedtls_ccm_context *ctx, int mode, size_t length,
     }
 
     /* blocks (B) associated to the plaintext message (P) */
+#if defined(ST_CRYP_DMA)
+    /* CCM has no streaming, the whole message goes by DMA or not at all */
+    if (length != 0 && cryp_dma_length(input, output, length) == length) {
+        if (cryp_dma_crypt(&ctx->hcryp_ccm, &owner, mode == CCM_DECRYPT,
+                           input, length, output) != 0) {
+            ret = MBEDTLS_ERR_PLATFORM_HW_ACCEL_FAILED;
+            goto free_block;
+        }
+    } else
+#endif /* ST_CRYP_DMA */
     if (mode == CCM_DECRYPT) {
         if (HAL_CRYP_Decrypt(&ctx->hcryp_ccm,
                              (uint32_t *)input,
@@ -390,6 +412,10 @@ free_block:
     }
 
 exit:
+#if defined(ST_CRYP_DMA)
+    cryp_release(&owner);
+#endif /* ST_CRYP_DMA */
+
     /* Free context access */
 #if defined(MBEDTLS_THREADING_C)
     if (mbedtls_mutex_unlock(&cryp_mutex) != 0) {
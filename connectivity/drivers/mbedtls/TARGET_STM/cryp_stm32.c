@@ -41,6 +41,32 @@ unsigned char cryp_mutex_started = 0;
 
 unsigned int cryp_context_count = 0;
 
+#if defined(ST_CRYP_DMA)
+#include "mbedtls/platform.h"
+#include "platform/mbed_dcache.h"
+
+/* CRYP_IN and CRYP_OUT requests are on channel 2 of DMA2 streams 6 and 5 */
+#define ST_CRYP_DMA_IN_STREAM   DMA2_Stream6
+#define ST_CRYP_DMA_IN_IRQ      DMA2_Stream6_IRQn
+#define ST_CRYP_DMA_OUT_STREAM  DMA2_Stream5
+#define ST_CRYP_DMA_OUT_IRQ     DMA2_Stream5_IRQn
+#define ST_CRYP_DMA_CHANNEL     DMA_CHANNEL_2
+
+/* The HAL size argument is 16 bits wide */
+#define ST_CRYP_DMA_MAX_LENGTH  0xFFE0U
+
+#if MBED_DCACHE_PRESENT
+#define ST_CRYP_DMA_ALIGN       MBED_DCACHE_LINE_SIZE   /* do not share cache lines with the CPU */
+#else
+#define ST_CRYP_DMA_ALIGN       16U                     /* whole AES blocks */
+#endif
+
+crypto_engine_t cryp_engine;
+
+static DMA_HandleTypeDef cryp_dma_in;
+static DMA_HandleTypeDef cryp_dma_out;
+#endif /* ST_CRYP_DMA */
+
 /* Functions -----------------------------------------------------------------*/
 
 /* Implementation that should never be optimized out by the compiler */
@@ -53,6 +79,104 @@ void cryp_zeroize(void *v, size_t n)
 }
 
 
+#if defined(ST_CRYP_DMA)
+static void cryp_dma_in_irq(void)
+{
+    HAL_DMA_IRQHandler(&cryp_dma_in);
+}
+
+static void cryp_dma_out_irq(void)
+{
+    HAL_DMA_IRQHandler(&cryp_dma_out);
+}
+
+static void cryp_dma_setup(DMA_HandleTypeDef *hdma, DMA_Stream_TypeDef *stream, uint32_t direction)
+{
+    hdma->Instance = stream;
+    hdma->Init.Channel = ST_CRYP_DMA_CHANNEL;
+    hdma->Init.Direction = direction;
+    hdma->Init.PeriphInc = DMA_PINC_DISABLE;
+    hdma->Init.MemInc = DMA_MINC_ENABLE;
+    hdma->Init.PeriphDataAlignment = DMA_PDATAALIGN_WORD;
+    hdma->Init.MemDataAlignment = DMA_MDATAALIGN_WORD;
+    hdma->Init.Mode = DMA_NORMAL;
+    hdma->Init.Priority = DMA_PRIORITY_HIGH;
+    hdma->Init.FIFOMode = DMA_FIFOMODE_ENABLE;
+    hdma->Init.FIFOThreshold = DMA_FIFO_THRESHOLD_HALFFULL;
+    hdma->Init.MemBurst = DMA_MBURST_SINGLE;
+    hdma->Init.PeriphBurst = DMA_PBURST_SINGLE;
+    HAL_DMA_Init(hdma);
+}
+
+void cryp_acquire(crypto_engine_job_t *owner)
+{
+    crypto_engine_job_init(owner, NULL, NULL, NULL);
+    crypto_engine_acquire(&cryp_engine, owner);
+}
+
+void cryp_release(crypto_engine_job_t *owner)
+{
+    crypto_engine_release(&cryp_engine);
+    crypto_engine_job_free(owner);
+}
+
+size_t cryp_dma_length(const unsigned char *input, const unsigned char *output, size_t length)
+{
+    if (length < MBED_CONF_MBEDTLS_STM_DMA_THRESHOLD ||
+            (((uint32_t) input | (uint32_t) output) & (ST_CRYP_DMA_ALIGN - 1)) != 0) {
+        return 0;
+    }
+    return length - (length % ST_CRYP_DMA_ALIGN);
+}
+
+int cryp_dma_crypt(CRYP_HandleTypeDef *hcryp, crypto_engine_job_t *owner, int decrypt,
+                   const unsigned char *input, size_t length, unsigned char *output)
+{
+    HAL_StatusTypeDef status;
+    int ret = 0;
+
+    /* Contexts have their own handles, the DMA serves the current one */
+    __HAL_LINKDMA(hcryp, hdmain, cryp_dma_in);
+    __HAL_LINKDMA(hcryp, hdmaout, cryp_dma_out);
+
+    mbed_dcache_clean(input, length);
+    mbed_dcache_clean_invalidate(output, length);
+
+    while (length > 0 && ret == 0) {
+        uint16_t chunk = length > ST_CRYP_DMA_MAX_LENGTH ? ST_CRYP_DMA_MAX_LENGTH : length;
+
+        crypto_engine_transfer(owner);
+        if (decrypt) {
+            status = HAL_CRYP_Decrypt_DMA(hcryp, (uint32_t *) input, chunk, (uint32_t *) output);
+        } else {
+            status = HAL_CRYP_Encrypt_DMA(hcryp, (uint32_t *) input, chunk, (uint32_t *) output);
+        }
+        if (status != HAL_OK) {
+            return (MBEDTLS_ERR_PLATFORM_HW_ACCEL_FAILED);
+        }
+        ret = crypto_engine_wait(owner);
+
+        mbed_dcache_invalidate(output, chunk);
+        input += chunk;
+        output += chunk;
+        length -= chunk;
+    }
+
+    return (ret);
+}
+
+/* Called by the HAL from the DMA interrupts */
+void HAL_CRYP_OutCpltCallback(CRYP_HandleTypeDef *hcryp)
+{
+    crypto_engine_complete(&cryp_engine, 0);
+}
+
+void HAL_CRYP_ErrorCallback(CRYP_HandleTypeDef *hcryp)
+{
+    crypto_engine_complete(&cryp_engine, MBEDTLS_ERR_PLATFORM_HW_ACCEL_FAILED);
+}
+#endif /* ST_CRYP_DMA */
+
 /* HAL function that should be implemented in the user file */
 /**
   * @brief CRYP MSP Initialization
@@ -91,6 +215,20 @@ void HAL_CRYP_MspInit(CRYP_HandleTypeDef *hcryp)
     /* Release the CRYP Peripheral Clock Reset */
     __HAL_RCC_CRYP_RELEASE_RESET();
 #endif /* AES */
+
+#if defined(ST_CRYP_DMA)
+    /* Every context handle gets here once, the streams are set up once */
+    if (cryp_dma_in.Instance == NULL) {
+        __HAL_RCC_DMA2_CLK_ENABLE();
+        cryp_dma_setup(&cryp_dma_in, ST_CRYP_DMA_IN_STREAM, DMA_MEMORY_TO_PERIPH);
+        cryp_dma_setup(&cryp_dma_out, ST_CRYP_DMA_OUT_STREAM, DMA_PERIPH_TO_MEMORY);
+
+        NVIC_SetVector(ST_CRYP_DMA_IN_IRQ, (uint32_t) cryp_dma_in_irq);
+        HAL_NVIC_EnableIRQ(ST_CRYP_DMA_IN_IRQ);
+        NVIC_SetVector(ST_CRYP_DMA_OUT_IRQ, (uint32_t) cryp_dma_out_irq);
+        HAL_NVIC_EnableIRQ(ST_CRYP_DMA_OUT_IRQ);
+    }
+#endif /* ST_CRYP_DMA */
 }
 
 /**
@@ -110,6 +248,16 @@ void HAL_CRYP_MspDeInit(CRYP_HandleTypeDef *hcryp)
     /* Disable CRYP clock */
     __HAL_RCC_CRYP_CLK_DISABLE();
 #endif /* AES */
+
+#if defined(ST_CRYP_DMA)
+    if (cryp_dma_in.Instance != NULL) {
+        HAL_NVIC_DisableIRQ(ST_CRYP_DMA_IN_IRQ);
+        HAL_NVIC_DisableIRQ(ST_CRYP_DMA_OUT_IRQ);
+        HAL_DMA_DeInit(&cryp_dma_in);
+        HAL_DMA_DeInit(&cryp_dma_out);
+        cryp_dma_in.Instance = NULL;
+    }
+#endif /* ST_CRYP_DMA */
 }
 #endif /* MBEDTLS_AES_ALT or MBEDTLS_CCM_ALT or MBEDTLS_GCM_ALT */
 #endif /* ! TARGET_STM32L4 */
@@ -34,6 +34,12 @@ extern "C" {
 #include "mbedtls/threading.h"
 #endif
 
+/* DMA is wired for the CRYP peripheral of the STM32F4 and STM32F7 */
+#if defined(CRYP) && (defined(TARGET_STM32F4) || defined(TARGET_STM32F7)) && MBED_CONF_MBEDTLS_STM_CRYPTO_DMA
+#define ST_CRYP_DMA
+#include "crypto_engine.h"
+#endif
+
 /* macros --------------------------------------------------------------------*/
 /*
  * 32-bit integer manipulation macros (big endian)
@@ -80,6 +86,21 @@ extern unsigned int cryp_context_count;
 /* functions prototypes ------------------------------------------------------*/
 extern void cryp_zeroize(void *v, size_t n);
 
+#if defined(ST_CRYP_DMA)
+extern crypto_engine_t cryp_engine;
+
+/* Take the CRYP for the calling thread, in turn with other contexts */
+extern void cryp_acquire(crypto_engine_job_t *owner);
+extern void cryp_release(crypto_engine_job_t *owner);
+
+/* Leading part of a message worth handing to the DMA, 0 if none */
+extern size_t cryp_dma_length(const unsigned char *input, const unsigned char *output, size_t length);
+
+/* Process whole blocks by DMA, the calling thread sleeps meanwhile */
+extern int cryp_dma_crypt(CRYP_HandleTypeDef *hcryp, crypto_engine_job_t *owner, int decrypt,
+                          const unsigned char *input, size_t length, unsigned char *output);
+#endif /* ST_CRYP_DMA */
+
 #ifdef __cplusplus
 }
 #endif
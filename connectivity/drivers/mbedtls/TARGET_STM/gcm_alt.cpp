@@ -87,6 +87,10 @@ int mbedtls_gcm_setkey(mbedtls_gcm_context *ctx,
         return (MBEDTLS_ERR_THREADING_MUTEX_ERROR);
     }
 #endif /* MBEDTLS_THREADING_C */
+#if defined(ST_CRYP_DMA)
+    crypto_engine_job_t owner;
+    cryp_acquire(&owner);
+#endif /* ST_CRYP_DMA */
 
     switch (keybits) {
         case 128:
@@ -141,6 +145,10 @@ int mbedtls_gcm_setkey(mbedtls_gcm_context *ctx,
     ctx->ctx_save_cr = ctx->hcryp_gcm.Instance->CR;
 
 exit :
+#if defined(ST_CRYP_DMA)
+    cryp_release(&owner);
+#endif /* ST_CRYP_DMA */
+
     /* Free context access */
 #if defined(MBEDTLS_THREADING_C)
     if (mbedtls_mutex_unlock(&cryp_mutex) != 0) {
@@ -194,6 +202,10 @@ int mbedtls_gcm_starts(mbedtls_gcm_context *ctx,
         return (MBEDTLS_ERR_THREADING_MUTEX_ERROR);
     }
 #endif /* MBEDTLS_THREADING_C */
+#if defined(ST_CRYP_DMA)
+    crypto_engine_job_t owner;
+    cryp_acquire(&owner);
+#endif /* ST_CRYP_DMA */
 
     if (HAL_CRYP_Init(&ctx->hcryp_gcm) != HAL_OK) {
         ret = MBEDTLS_ERR_PLATFORM_HW_ACCEL_FAILED;
@@ -249,6 +261,10 @@ int mbedtls_gcm_starts(mbedtls_gcm_context *ctx,
     ctx->ctx_save_cr = ctx->hcryp_gcm.Instance->CR;
 
 exit:
+#if defined(ST_CRYP_DMA)
+    cryp_release(&owner);
+#endif /* ST_CRYP_DMA */
+
     /* Free context access */
 #if defined(MBEDTLS_THREADING_C)
     if (mbedtls_mutex_unlock(&cryp_mutex) != 0) {
@@ -291,12 +307,38 @@ int mbedtls_gcm_update(mbedtls_gcm_context *ctx,
         return (MBEDTLS_ERR_THREADING_MUTEX_ERROR);
     }
 #endif /* MBEDTLS_THREADING_C */
+#if defined(ST_CRYP_DMA)
+    crypto_engine_job_t owner;
+    cryp_acquire(&owner);
+#endif /* ST_CRYP_DMA */
 
     /* allow multi-context of CRYP use: restore context */
     ctx->hcryp_gcm.Instance->CR = ctx->ctx_save_cr;
 
     ctx->len += length;
 
+#if defined(ST_CRYP_DMA)
+    /* Whole blocks of long messages go by DMA, while other threads run */
+    {
+        size_t dma_length = cryp_dma_length(input, output, length);
+
+        if (dma_length != 0) {
+            if (cryp_dma_crypt(&ctx->hcryp_gcm, &owner, ctx->mode == MBEDTLS_GCM_DECRYPT,
+                               input, dma_length, output) != 0) {
+                ret = MBEDTLS_ERR_PLATFORM_HW_ACCEL_FAILED;
+                goto exit;
+            }
+            input += dma_length;
+            output += dma_length;
+            length -= dma_length;
+        }
+    }
+
+    if (length == 0) {
+        goto save_context;
+    }
+#endif /* ST_CRYP_DMA */
+
 #if !defined(STM32_AAD_ANY_LENGTH_SUPPORT)
     /* compute remaining data (data buffer in word) */
     if ((length % AAD_WORD_ALIGN) != 0U) {
@@ -350,10 +392,17 @@ int mbedtls_gcm_update(mbedtls_gcm_context *ctx,
 #endif
     }
 
+#if defined(ST_CRYP_DMA)
+save_context:
+#endif
     /* allow multi-context of CRYP : save context */
     ctx->ctx_save_cr = ctx->hcryp_gcm.Instance->CR;
 
 exit:
+#if defined(ST_CRYP_DMA)
+    cryp_release(&owner);
+#endif /* ST_CRYP_DMA */
+
     /* Free context access */
 #if defined(MBEDTLS_THREADING_C)
     if (mbedtls_mutex_unlock(&cryp_mutex) != 0) {
@@ -385,6 +434,10 @@ int mbedtls_gcm_finish(mbedtls_gcm_context *ctx,
         return (MBEDTLS_ERR_THREADING_MUTEX_ERROR);
     }
 #endif /* MBEDTLS_THREADING_C */
+#if defined(ST_CRYP_DMA)
+    crypto_engine_job_t owner;
+    cryp_acquire(&owner);
+#endif /* ST_CRYP_DMA */
 
     /* allow multi-context of CRYP use: restore context */
     ctx->hcryp_gcm.Instance->CR = ctx->ctx_save_cr;
@@ -406,6 +459,10 @@ int mbedtls_gcm_finish(mbedtls_gcm_context *ctx,
     ctx->ctx_save_cr = ctx->hcryp_gcm.Instance->CR;
 
 exit:
+#if defined(ST_CRYP_DMA)
+    cryp_release(&owner);
+#endif /* ST_CRYP_DMA */
+
     /* Free context access */
 #if defined(MBEDTLS_THREADING_C)
     if (mbedtls_mutex_unlock(&cryp_mutex) != 0) {
@@ -39,6 +39,25 @@ unsigned char hash_mutex_started = 0;
 
 unsigned int hash_context_count = 0;
 
+#if defined(ST_HASH_DMA)
+#include "mbedtls/platform.h"
+#include "platform/mbed_dcache.h"
+
+/* HASH_IN requests are on channel 2 of DMA2 stream 7 */
+#define ST_HASH_DMA_STREAM      DMA2_Stream7
+#define ST_HASH_DMA_IRQ         DMA2_Stream7_IRQn
+#define ST_HASH_DMA_CHANNEL     DMA_CHANNEL_2
+
+/* A DMA stream moves at most 65535 words */
+#define ST_HASH_DMA_MAX_LENGTH  0x3FFC0U
+
+#define ST_HASH_DMA_ALIGN       MBED_DCACHE_LINE_SIZE
+
+crypto_engine_t hash_engine;
+
+static DMA_HandleTypeDef hash_dma_in;
+#endif /* ST_HASH_DMA */
+
 /* Functions -----------------------------------------------------------------*/
 
 /* Implementation that should never be optimized out by the compiler */
@@ -50,6 +69,79 @@ void hash_zeroize(void *v, size_t n)
     }
 }
 
+#if defined(ST_HASH_DMA)
+static void hash_dma_irq(void)
+{
+    HAL_DMA_IRQHandler(&hash_dma_in);
+}
+
+void hash_acquire(crypto_engine_job_t *owner)
+{
+    crypto_engine_job_init(owner, NULL, NULL, NULL);
+    crypto_engine_acquire(&hash_engine, owner);
+}
+
+void hash_release(crypto_engine_job_t *owner)
+{
+    crypto_engine_release(&hash_engine);
+    crypto_engine_job_free(owner);
+}
+
+size_t hash_dma_length(const unsigned char *input, size_t length, size_t block_size)
+{
+    if (length < MBED_CONF_MBEDTLS_STM_DMA_THRESHOLD ||
+            ((uint32_t) input & (ST_HASH_DMA_ALIGN - 1)) != 0) {
+        return 0;
+    }
+    return length - (length % block_size);
+}
+
+int hash_dma_accumulate(HASH_HandleTypeDef *hhash, crypto_engine_job_t *owner, uint32_t algo,
+                        const unsigned char *input, size_t length)
+{
+    HAL_StatusTypeDef status;
+    int ret = 0;
+
+    /* Contexts have their own handles, the DMA serves the current one */
+    __HAL_LINKDMA(hhash, hdmain, hash_dma_in);
+
+    mbed_dcache_clean(input, length);
+
+    /* Multiple DMA transfers: no digest calculation at the end of each */
+    __HAL_HASH_SET_MDMAT();
+
+    while (length > 0 && ret == 0) {
+        uint32_t chunk = length > ST_HASH_DMA_MAX_LENGTH ? ST_HASH_DMA_MAX_LENGTH : length;
+
+        crypto_engine_transfer(owner);
+        status = HASH_Start_DMA(hhash, (uint8_t *) input, chunk, algo);
+        if (status != HAL_OK) {
+            ret = MBEDTLS_ERR_PLATFORM_HW_ACCEL_FAILED;
+            break;
+        }
+        ret = crypto_engine_wait(owner);
+
+        input += chunk;
+        length -= chunk;
+    }
+
+    __HAL_HASH_RESET_MDMAT();
+
+    return (ret);
+}
+
+/* Called by the HAL from the DMA interrupt */
+void HAL_HASH_InCpltCallback(HASH_HandleTypeDef *hhash)
+{
+    crypto_engine_complete(&hash_engine, 0);
+}
+
+void HAL_HASH_ErrorCallback(HASH_HandleTypeDef *hhash)
+{
+    crypto_engine_complete(&hash_engine, MBEDTLS_ERR_PLATFORM_HW_ACCEL_FAILED);
+}
+#endif /* ST_HASH_DMA */
+
 /* HAL function that should be implemented in the user file */
 /**
 * @brief HASH MSP Initialization
@@ -61,6 +153,30 @@ void HAL_HASH_MspInit(HASH_HandleTypeDef *hhash)
 {
     /* Peripheral clock enable */
     __HAL_RCC_HASH_CLK_ENABLE();
+
+#if defined(ST_HASH_DMA)
+    /* Every context handle gets here once, the stream is set up once */
+    if (hash_dma_in.Instance == NULL) {
+        __HAL_RCC_DMA2_CLK_ENABLE();
+        hash_dma_in.Instance = ST_HASH_DMA_STREAM;
+        hash_dma_in.Init.Channel = ST_HASH_DMA_CHANNEL;
+        hash_dma_in.Init.Direction = DMA_MEMORY_TO_PERIPH;
+        hash_dma_in.Init.PeriphInc = DMA_PINC_DISABLE;
+        hash_dma_in.Init.MemInc = DMA_MINC_ENABLE;
+        hash_dma_in.Init.PeriphDataAlignment = DMA_PDATAALIGN_WORD;
+        hash_dma_in.Init.MemDataAlignment = DMA_MDATAALIGN_WORD;
+        hash_dma_in.Init.Mode = DMA_NORMAL;
+        hash_dma_in.Init.Priority = DMA_PRIORITY_HIGH;
+        hash_dma_in.Init.FIFOMode = DMA_FIFOMODE_ENABLE;
+        hash_dma_in.Init.FIFOThreshold = DMA_FIFO_THRESHOLD_HALFFULL;
+        hash_dma_in.Init.MemBurst = DMA_MBURST_SINGLE;
+        hash_dma_in.Init.PeriphBurst = DMA_PBURST_SINGLE;
+        HAL_DMA_Init(&hash_dma_in);
+
+        NVIC_SetVector(ST_HASH_DMA_IRQ, (uint32_t) hash_dma_irq);
+        HAL_NVIC_EnableIRQ(ST_HASH_DMA_IRQ);
+    }
+#endif /* ST_HASH_DMA */
 }
 
 /**
@@ -73,6 +189,14 @@ void HAL_HASH_MspDeInit(HASH_HandleTypeDef *hhash)
 {
     /* Peripheral clock disable */
     __HAL_RCC_HASH_CLK_DISABLE();
+
+#if defined(ST_HASH_DMA)
+    if (hash_dma_in.Instance != NULL) {
+        HAL_NVIC_DisableIRQ(ST_HASH_DMA_IRQ);
+        HAL_DMA_DeInit(&hash_dma_in);
+        hash_dma_in.Instance = NULL;
+    }
+#endif /* ST_HASH_DMA */
 }
 
 #endif /* MBEDTLS_SHA1_ALT or MBEDTLS_SHA256_ALT or MBEDTLS_MD5_ALT */
\ No newline at end of file
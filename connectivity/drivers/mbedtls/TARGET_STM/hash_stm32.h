@@ -33,6 +33,12 @@ extern "C" {
 #include "mbedtls/threading.h"
 #endif
 
+/* DMA is wired for the HASH peripheral of the STM32F4 and STM32F7 */
+#if defined(HASH_CR_MDMAT) && (defined(TARGET_STM32F4) || defined(TARGET_STM32F7)) && MBED_CONF_MBEDTLS_STM_CRYPTO_DMA
+#define ST_HASH_DMA
+#include "crypto_engine.h"
+#endif
+
 /* macros --------------------------------------------------------------------*/
 /* constants -----------------------------------------------------------------*/
 #define ST_HASH_TIMEOUT ((uint32_t) 1000)  /* TO in ms for the hash processor */
@@ -49,6 +55,21 @@ extern unsigned int hash_context_count;
 /* functions prototypes ------------------------------------------------------*/
 extern void hash_zeroize(void *v, size_t n);
 
+#if defined(ST_HASH_DMA)
+extern crypto_engine_t hash_engine;
+
+/* Take the HASH for the calling thread, in turn with other contexts */
+extern void hash_acquire(crypto_engine_job_t *owner);
+extern void hash_release(crypto_engine_job_t *owner);
+
+/* Leading part of a message worth handing to the DMA, 0 if none */
+extern size_t hash_dma_length(const unsigned char *input, size_t length, size_t block_size);
+
+/* Accumulate whole blocks by DMA, the calling thread sleeps meanwhile */
+extern int hash_dma_accumulate(HASH_HandleTypeDef *hhash, crypto_engine_job_t *owner, uint32_t algo,
+                               const unsigned char *input, size_t length);
+#endif /* ST_HASH_DMA */
+
 #ifdef __cplusplus
 }
 #endif
@@ -100,6 +100,10 @@ int mbedtls_md5_starts_ret(mbedtls_md5_context *ctx)
         return (ret);
     }
 #endif /* MBEDTLS_THREADING_C */
+#if defined(ST_HASH_DMA)
+    crypto_engine_job_t owner;
+    hash_acquire(&owner);
+#endif /* ST_HASH_DMA */
 
     /* HASH Configuration */
     if (HAL_HASH_DeInit(&ctx->hhash) != HAL_OK) {
@@ -116,6 +120,10 @@ int mbedtls_md5_starts_ret(mbedtls_md5_context *ctx)
     HAL_HASH_ContextSaving(&ctx->hhash, (uint8_t *)ctx->ctx_save_regs);
 
 exit :
+#if defined(ST_HASH_DMA)
+    hash_release(&owner);
+#endif /* ST_HASH_DMA */
+
     /* Free context access */
 #if defined(MBEDTLS_THREADING_C)
     if (mbedtls_mutex_unlock(&hash_mutex) != 0) {
@@ -139,6 +147,10 @@ int mbedtls_internal_md5_process(mbedtls_md5_context *ctx,
         return (ret);
     }
 #endif /* MBEDTLS_THREADING_C */
+#if defined(ST_HASH_DMA)
+    crypto_engine_job_t owner;
+    hash_acquire(&owner);
+#endif /* ST_HASH_DMA */
 
     /* restore hw context */
     HAL_HASH_ContextRestoring(&ctx->hhash, (uint8_t *)ctx->ctx_save_regs);
@@ -154,6 +166,10 @@ int mbedtls_internal_md5_process(mbedtls_md5_context *ctx,
     HAL_HASH_ContextSaving(&ctx->hhash, (uint8_t *)ctx->ctx_save_regs);
 
 exit :
+#if defined(ST_HASH_DMA)
+    hash_release(&owner);
+#endif /* ST_HASH_DMA */
+
     /* Free context access */
 #if defined(MBEDTLS_THREADING_C)
     if (mbedtls_mutex_unlock(&hash_mutex) != 0) {
@@ -179,6 +195,10 @@ int mbedtls_md5_update_ret(mbedtls_md5_context *ctx,
         return (ret);
     }
 #endif /* MBEDTLS_THREADING_C */
+#if defined(ST_HASH_DMA)
+    crypto_engine_job_t owner;
+    hash_acquire(&owner);
+#endif /* ST_HASH_DMA */
 
     /* restore hw context */
     HAL_HASH_ContextRestoring(&ctx->hhash, (uint8_t *)ctx->ctx_save_regs);
@@ -225,6 +245,10 @@ int mbedtls_md5_update_ret(mbedtls_md5_context *ctx,
     HAL_HASH_ContextSaving(&ctx->hhash, (uint8_t *)ctx->ctx_save_regs);
 
 exit :
+#if defined(ST_HASH_DMA)
+    hash_release(&owner);
+#endif /* ST_HASH_DMA */
+
     /* Free context access */
 #if defined(MBEDTLS_THREADING_C)
     if (mbedtls_mutex_unlock(&hash_mutex) != 0) {
@@ -247,6 +271,10 @@ int mbedtls_md5_finish_ret(mbedtls_md5_context *ctx, unsigned char output[32])
         return (ret);
     }
 #endif /* MBEDTLS_THREADING_C */
+#if defined(ST_HASH_DMA)
+    crypto_engine_job_t owner;
+    hash_acquire(&owner);
+#endif /* ST_HASH_DMA */
 
     /* restore hw context */
     HAL_HASH_ContextRestoring(&ctx->hhash, (uint8_t *)ctx->ctx_save_regs);
@@ -265,6 +293,10 @@ int mbedtls_md5_finish_ret(mbedtls_md5_context *ctx, unsigned char output[32])
     ctx->sbuf_len = 0;
 
 exit :
+#if defined(ST_HASH_DMA)
+    hash_release(&owner);
+#endif /* ST_HASH_DMA */
+
     /* Free context access */
 #if defined(MBEDTLS_THREADING_C)
     if (mbedtls_mutex_unlock(&hash_mutex) != 0) {
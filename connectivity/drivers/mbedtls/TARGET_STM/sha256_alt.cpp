@@ -102,6 +102,10 @@ int mbedtls_sha256_starts_ret(mbedtls_sha256_context *ctx, int is224)
         return (ret);
     }
 #endif /* MBEDTLS_THREADING_C */
+#if defined(ST_HASH_DMA)
+    crypto_engine_job_t owner;
+    hash_acquire(&owner);
+#endif /* ST_HASH_DMA */
 
     /* HASH Configuration */
     if (HAL_HASH_DeInit(&ctx->hhash) != HAL_OK) {
@@ -120,6 +124,10 @@ int mbedtls_sha256_starts_ret(mbedtls_sha256_context *ctx, int is224)
     HAL_HASH_ContextSaving(&ctx->hhash, (uint8_t *)ctx->ctx_save_regs);
 
 exit :
+#if defined(ST_HASH_DMA)
+    hash_release(&owner);
+#endif /* ST_HASH_DMA */
+
     /* Free context access */
 #if defined(MBEDTLS_THREADING_C)
     if (mbedtls_mutex_unlock(&hash_mutex) != 0) {
@@ -143,6 +151,10 @@ int mbedtls_internal_sha256_process(mbedtls_sha256_context *ctx,
         return (ret);
     }
 #endif /* MBEDTLS_THREADING_C */
+#if defined(ST_HASH_DMA)
+    crypto_engine_job_t owner;
+    hash_acquire(&owner);
+#endif /* ST_HASH_DMA */
 
     /* restore hw context */
     HAL_HASH_ContextRestoring(&ctx->hhash, (uint8_t *)ctx->ctx_save_regs);
@@ -167,6 +179,10 @@ int mbedtls_internal_sha256_process(mbedtls_sha256_context *ctx,
     HAL_HASH_ContextSaving(&ctx->hhash, (uint8_t *)ctx->ctx_save_regs);
 
 exit :
+#if defined(ST_HASH_DMA)
+    hash_release(&owner);
+#endif /* ST_HASH_DMA */
+
     /* Free context access */
 #if defined(MBEDTLS_THREADING_C)
     if (mbedtls_mutex_unlock(&hash_mutex) != 0) {
@@ -192,6 +208,10 @@ int mbedtls_sha256_update_ret(mbedtls_sha256_context *ctx,
         return (ret);
     }
 #endif /* MBEDTLS_THREADING_C */
+#if defined(ST_HASH_DMA)
+    crypto_engine_job_t owner;
+    hash_acquire(&owner);
+#endif /* ST_HASH_DMA */
 
     /* restore hw context */
     HAL_HASH_ContextRestoring(&ctx->hhash, (uint8_t *)ctx->ctx_save_regs);
@@ -226,6 +246,21 @@ int mbedtls_sha256_update_ret(mbedtls_sha256_context *ctx,
         /* Process following input data
                      with size multiple of ST_SHA256_BLOCK_SIZE bytes */
         size_t iter = currentlen / ST_SHA256_BLOCK_SIZE;
+#if defined(ST_HASH_DMA)
+        /* Long messages go by DMA, while other threads run */
+        if (iter != 0 && hash_dma_length(input + ST_SHA256_BLOCK_SIZE - ctx->sbuf_len,
+                                         iter * ST_SHA256_BLOCK_SIZE,
+                                         ST_SHA256_BLOCK_SIZE) != 0) {
+            if (hash_dma_accumulate(&ctx->hhash, &owner,
+                                    ctx->is224 == 0 ? HASH_ALGOSELECTION_SHA256 : HASH_ALGOSELECTION_SHA224,
+                                    input + ST_SHA256_BLOCK_SIZE - ctx->sbuf_len,
+                                    iter * ST_SHA256_BLOCK_SIZE) != 0) {
+                ret = MBEDTLS_ERR_PLATFORM_HW_ACCEL_FAILED;
+                goto exit;
+            }
+            iter = 0;
+        }
+#endif /* ST_HASH_DMA */
         if (iter != 0) {
             if (ctx->is224 == 0) {
                 if (HAL_HASHEx_SHA256_Accmlt(&ctx->hhash,
@@ -256,6 +291,10 @@ int mbedtls_sha256_update_ret(mbedtls_sha256_context *ctx,
     HAL_HASH_ContextSaving(&ctx->hhash, (uint8_t *)ctx->ctx_save_regs);
 
 exit :
+#if defined(ST_HASH_DMA)
+    hash_release(&owner);
+#endif /* ST_HASH_DMA */
+
     /* Free context access */
 #if defined(MBEDTLS_THREADING_C)
     if (mbedtls_mutex_unlock(&hash_mutex) != 0) {
@@ -279,6 +318,10 @@ int mbedtls_sha256_finish_ret(mbedtls_sha256_context *ctx,
         return (ret);
     }
 #endif /* MBEDTLS_THREADING_C */
+#if defined(ST_HASH_DMA)
+    crypto_engine_job_t owner;
+    hash_acquire(&owner);
+#endif /* ST_HASH_DMA */
 
     /* restore hw context */
     HAL_HASH_ContextRestoring(&ctx->hhash, (uint8_t *)ctx->ctx_save_regs);
@@ -308,6 +351,10 @@ int mbedtls_sha256_finish_ret(mbedtls_sha256_context *ctx,
     ctx->sbuf_len = 0;
 
 exit :
+#if defined(ST_HASH_DMA)
+    hash_release(&owner);
+#endif /* ST_HASH_DMA */
+
     /* Free context access */
 #if defined(MBEDTLS_THREADING_C)
     if (mbedtls_mutex_unlock(&hash_mutex) != 0) {
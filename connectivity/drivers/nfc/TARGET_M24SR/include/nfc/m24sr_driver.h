@@ -472,6 +472,13 @@ public:
         return MAX_NDEF_SIZE;
     }
 
+    /** @see NFCEEPROMDriver::write_page_size
+     */
+    virtual size_t write_page_size()
+    {
+        return _max_write_bytes;
+    }
+
     /** @see NFCEEPROMDriver::start_session
      */
     virtual void start_session(bool force = true)
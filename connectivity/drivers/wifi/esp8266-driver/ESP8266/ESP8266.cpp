@@ -47,6 +47,7 @@ ESP8266::ESP8266(PinName tx, PinName rx, bool debug, PinName rts, PinName cts)
     : _sdk_v(-1, -1, -1),
       _at_v(-1, -1, -1),
       _tcp_passive(false),
+      _tcp_send_buffered(false),
       _callback(),
       _serial(tx, rx, MBED_CONF_ESP8266_SERIAL_BAUDRATE),
       _serial_rts(rts),
@@ -105,9 +106,15 @@ ESP8266::ESP8266(PinName tx, PinName rx, bool debug, PinName rts, PinName cts)
         _sock_i[i].open = false;
         _sock_i[i].proto = NSAPI_UDP;
         _sock_i[i].tcp_data = NULL;
+        _sock_i[i].tcp_data_len = 0;
         _sock_i[i].tcp_data_avbl = 0;
         _sock_i[i].tcp_data_rcvd = 0;
+        _sock_i[i].tcp_ring = NULL;
+        _sock_i[i].tcp_ring_head = 0;
+        _sock_i[i].tcp_ring_len = 0;
         _sock_i[i].send_fail = false;
+        _sock_i[i].send_segment = 0;
+        _sock_i[i].send_segment_acked = 0;
     }
 
     _scan_r.res = NULL;
@@ -346,6 +353,18 @@ bool ESP8266::cond_enable_tcp_passive_mode()
     return done;
 }
 
+bool ESP8266::cond_enable_tcp_send_buffered()
+{
+#if MBED_CONF_ESP8266_TCP_SEND_BUFFERED
+    _tcp_send_buffered = !FW_AT_LEAST_VERSION(_at_v.major, _at_v.minor, _at_v.patch, 0, ESP8266_AT_VERSION_NO_SEND_BUFFER);
+    if (!_tcp_send_buffered) {
+        tr_warning("AT+CIPSENDBUF not available in AT firmware v%d, TCP sends are not buffered.", _at_v.major);
+    }
+#endif
+
+    return true;
+}
+
 
 nsapi_error_t ESP8266::connect(const char *ap, const char *passPhrase)
 {
@@ -694,6 +713,10 @@ bool ESP8266::dns_lookup(const char *name, char *ip)
 
 nsapi_size_or_error_t ESP8266::send(int id, const void *data, uint32_t amount)
 {
+    if (_sock_i[id].proto == NSAPI_TCP && _tcp_send_buffered) {
+        return _send_buffered(id, data, amount);
+    }
+
     if (_sock_i[id].proto == NSAPI_TCP) {
         if (_sock_sending_id >= 0 && _sock_sending_id < SOCKET_COUNT) {
             if (!_sock_i[id].send_fail) {
@@ -805,6 +828,78 @@ END:
     return ret;
 }
 
+nsapi_size_or_error_t ESP8266::_send_buffered(int id, const void *data, uint32_t amount)
+{
+    nsapi_error_t ret = NSAPI_ERROR_DEVICE_ERROR;
+    int segment = -1;
+    int segment_acked = -1;
+    int bytes_confirmed = 0;
+
+    // +CIPSENDBUF takes up to 2048 bytes at a time, like +CIPSEND
+    if (amount > 2048) {
+        amount = 2048;
+    }
+
+    _smutex.lock();
+    // Segments are queued in the modem's TCP send buffer, so unlike send() this doesn't wait
+    // for the previous segment's 'SEND OK'. The modem reports '<id>,<segment>,SEND OK' for
+    // each segment, and the last successful segment in the reply to the next +CIPSENDBUF.
+    set_timeout(ESP8266_SEND_TIMEOUT);
+    _busy = false;
+    _error = false;
+    if (!_parser.send("AT+CIPSENDBUF=%d,%" PRIu32, id, amount)) {
+        tr_debug("send(): AT+CIPSENDBUF failed.");
+        goto END;
+    }
+
+    if (!_parser.recv("%d,%d\n", &segment, &segment_acked) || !_parser.recv(">")) {
+        // The modem's send buffer is full
+        tr_debug("send(): Didn't get \">\"");
+        ret = NSAPI_ERROR_WOULD_BLOCK;
+        goto END;
+    }
+    _sock_i[id].send_segment_acked = segment_acked;
+
+    if (_parser.write((char *)data, (int)amount) < 0) {
+        tr_debug("send(): Failed to write serial data");
+        // Serial is not working, serious error, reset needed.
+        ret = NSAPI_ERROR_DEVICE_ERROR;
+        goto END;
+    }
+
+    if (!_parser.recv("Recv %d bytes", &bytes_confirmed)) {
+        tr_debug("send(): Bytes not confirmed.");
+        ret = NSAPI_ERROR_WOULD_BLOCK;
+    } else {
+        _sock_i[id].send_segment = segment;
+        tr_debug("send(): Segment %d queued, %d in flight.", segment, segment - segment_acked);
+        ret = bytes_confirmed;
+    }
+
+END:
+    _process_oob(ESP8266_RECV_TIMEOUT, true); // Drain USART receive register to avoid data overrun
+
+    if (_busy && ret < 0) {
+        ret = NSAPI_ERROR_WOULD_BLOCK;
+        tr_debug("send(): Modem busy.");
+    }
+
+    if (_error) {
+        ret = NSAPI_ERROR_CONNECTION_LOST;
+        tr_debug("send(): Connection disrupted.");
+    }
+
+    if (!_sock_i[id].open && ret < 0) {
+        ret = NSAPI_ERROR_CONNECTION_LOST;
+        tr_debug("send(): Socket %d closed abruptly.", id);
+    }
+
+    set_timeout();
+    _smutex.unlock();
+
+    return ret;
+}
+
 void ESP8266::_oob_packet_hdlr()
 {
     int id;
@@ -837,6 +932,29 @@ void ESP8266::_oob_packet_hdlr()
         }
     }
 
+    if (_sock_i[id].proto == NSAPI_TCP) {
+        // A recv_tcp() is waiting with nothing buffered ahead, read straight into its buffer
+        if (_sock_i[id].tcp_data && !_tcp_buffered(id)) {
+            uint32_t len = (uint32_t)amount < _sock_i[id].tcp_data_len ? amount : _sock_i[id].tcp_data_len;
+
+            if (_parser.read(_sock_i[id].tcp_data, len) < (int)len) {
+                return;
+            }
+            _sock_i[id].tcp_data += len;
+            _sock_i[id].tcp_data_len -= len;
+            _sock_i[id].tcp_data_rcvd = (_sock_i[id].tcp_data_rcvd > 0 ? _sock_i[id].tcp_data_rcvd : 0) + len;
+
+            amount -= len;
+            if (amount == 0) {
+                return;
+            }
+        }
+#if MBED_CONF_ESP8266_TCP_RING_SIZE > 0
+        _tcp_ring_put(id, amount);
+        return;
+#endif
+    }
+
     pdu_len = sizeof(struct packet) + amount;
 
     if ((_heap_usage + pdu_len) > MBED_CONF_ESP8266_SOCKET_BUFSIZE) {
@@ -950,8 +1068,101 @@ BUSY:
     return ret;
 }
 
+bool ESP8266::_tcp_buffered(int id)
+{
+#if MBED_CONF_ESP8266_TCP_RING_SIZE > 0
+    return _sock_i[id].tcp_ring_len > 0;
+#else
+    for (struct packet *p = _packets; p; p = p->next) {
+        if (p->id == id) {
+            return true;
+        }
+    }
+    return false;
+#endif
+}
+
+#if MBED_CONF_ESP8266_TCP_RING_SIZE > 0
+void ESP8266::_tcp_ring_put(int id, uint32_t amount)
+{
+    const uint32_t size = MBED_CONF_ESP8266_TCP_RING_SIZE;
+    struct _sock_info &sock = _sock_i[id];
+
+    if (!sock.tcp_ring) {
+        if ((_heap_usage + size) > MBED_CONF_ESP8266_SOCKET_BUFSIZE) {
+            tr_debug("\"esp8266.socket-bufsize\"-limit exceeded, packet dropped");
+            return;
+        }
+        sock.tcp_ring = (char *)malloc(size);
+        if (!sock.tcp_ring) {
+            tr_debug("_tcp_ring_put(): Out of memory, unable to allocate memory for ring.");
+            return;
+        }
+        _heap_usage += size;
+        sock.tcp_ring_head = 0;
+        sock.tcp_ring_len = 0;
+    }
+
+    if (amount > size - sock.tcp_ring_len) {
+        tr_debug("_tcp_ring_put(): socket %d ring full, packet dropped", id);
+        return;
+    }
+
+    // Free space may wrap around the end of the ring
+    uint32_t tail = (sock.tcp_ring_head + sock.tcp_ring_len) % size;
+    uint32_t first = amount < size - tail ? amount : size - tail;
+
+    if (_parser.read(sock.tcp_ring + tail, first) < (int)first) {
+        return;
+    }
+    if (amount > first && _parser.read(sock.tcp_ring, amount - first) < (int)(amount - first)) {
+        return;
+    }
+    sock.tcp_ring_len += amount;
+}
+
+uint32_t ESP8266::_tcp_ring_get(int id, void *data, uint32_t amount)
+{
+    const uint32_t size = MBED_CONF_ESP8266_TCP_RING_SIZE;
+    struct _sock_info &sock = _sock_i[id];
+
+    uint32_t len = amount < sock.tcp_ring_len ? amount : sock.tcp_ring_len;
+    uint32_t first = len < size - sock.tcp_ring_head ? len : size - sock.tcp_ring_head;
+
+    memcpy(data, sock.tcp_ring + sock.tcp_ring_head, first);
+    memcpy((char *)data + first, sock.tcp_ring, len - first);
+
+    sock.tcp_ring_head = (sock.tcp_ring_head + len) % size;
+    sock.tcp_ring_len -= len;
+
+    return len;
+}
+#endif
+
+int32_t ESP8266::_process_oob_tcp(int id, void *data, uint32_t amount, duration<uint32_t, milli> timeout, bool all)
+{
+    if (_tcp_buffered(id)) {
+        _process_oob(timeout, all);
+        return NSAPI_ERROR_WOULD_BLOCK;
+    }
+
+    // Let _oob_packet_hdlr() read the socket's payload straight into data
+    _sock_i[id].tcp_data = (char *)data;
+    _sock_i[id].tcp_data_len = amount;
+    _sock_i[id].tcp_data_rcvd = NSAPI_ERROR_WOULD_BLOCK;
+
+    _process_oob(timeout, all);
+
+    _sock_i[id].tcp_data = NULL;
+    _sock_i[id].tcp_data_len = 0;
+
+    return _sock_i[id].tcp_data_rcvd;
+}
+
 int32_t ESP8266::recv_tcp(int id, void *data, uint32_t amount, duration<uint32_t, milli> timeout)
 {
+    int32_t ret;
+
     if (_tcp_passive) {
         return _recv_tcp_passive(id, data, amount, timeout);
     }
@@ -960,9 +1171,20 @@ int32_t ESP8266::recv_tcp(int id, void *data, uint32_t amount, duration<uint32_t
 
     // No flow control, drain the USART receive register ASAP to avoid data overrun
     if (_serial_rts == NC) {
-        _process_oob(timeout, true);
+        ret = _process_oob_tcp(id, data, amount, timeout, true);
+        if (ret > 0) {
+            _smutex.unlock();
+            return ret;
+        }
     }
 
+#if MBED_CONF_ESP8266_TCP_RING_SIZE > 0
+    if (_sock_i[id].tcp_ring_len > 0) {
+        ret = _tcp_ring_get(id, data, amount);
+        _smutex.unlock();
+        return ret;
+    }
+#else
     // check if any packets are ready for us
     for (struct packet **p = &_packets; *p; p = &(*p)->next) {
         if ((*p)->id == id) {
@@ -994,18 +1216,20 @@ int32_t ESP8266::recv_tcp(int id, void *data, uint32_t amount, duration<uint32_t
             }
         }
     }
+#endif
     if (!_sock_i[id].open) {
         _smutex.unlock();
         return 0;
     }
 
     // Flow control, read from USART receive register only when no more data is buffered, and as little as possible
+    ret = NSAPI_ERROR_WOULD_BLOCK;
     if (_serial_rts != NC) {
-        _process_oob(timeout, false);
+        ret = _process_oob_tcp(id, data, amount, timeout, false);
     }
     _smutex.unlock();
 
-    return NSAPI_ERROR_WOULD_BLOCK;
+    return ret;
 }
 
 int32_t ESP8266::recv_udp(struct esp8266_socket *socket, void *data, uint32_t amount, duration<uint32_t, milli> timeout)
@@ -1074,12 +1298,16 @@ void ESP8266::_clear_socket_packets(int id)
             p = &(*p)->next;
         }
     }
-    if (id == ESP8266_ALL_SOCKET_IDS) {
-        for (int id = 0; id < 5; id++) {
-            _sock_i[id].tcp_data_avbl = 0;
+    for (int i = 0; i < SOCKET_COUNT; i++) {
+        if (i == id || id == ESP8266_ALL_SOCKET_IDS) {
+            _sock_i[i].tcp_data_avbl = 0;
+            if (_sock_i[i].tcp_ring) {
+                free(_sock_i[i].tcp_ring);
+                _sock_i[i].tcp_ring = NULL;
+                _heap_usage -= MBED_CONF_ESP8266_TCP_RING_SIZE;
+            }
+            _sock_i[i].tcp_ring_len = 0;
         }
-    } else {
-        _sock_i[id].tcp_data_avbl = 0;
     }
 }
 
@@ -1089,6 +1317,8 @@ void ESP8266::_clear_socket_sending(int id)
         _sock_sending_id = -1;
     }
     _sock_i[id].send_fail = false;
+    _sock_i[id].send_segment = 0;
+    _sock_i[id].send_segment_acked = 0;
 }
 
 bool ESP8266::close(int id)
@@ -1133,7 +1363,7 @@ void ESP8266::set_timeout(duration<uint32_t, milli> timeout)
 
 bool ESP8266::readable()
 {
-    return _serial.FileHandle::readable();
+    return _parser.readable();
 }
 
 bool ESP8266::writeable()
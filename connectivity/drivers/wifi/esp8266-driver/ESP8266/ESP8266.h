@@ -66,6 +66,8 @@
 #define ESP8266_AT_VERSION_MAJOR ESP8266_AT_VERSION/1000000
 #define ESP8266_AT_VERSION_TCP_PASSIVE_MODE 1070000
 #define ESP8266_AT_VERSION_WIFI_SCAN_CHANGE 1060000
+// AT+CIPSENDBUF was dropped from AT firmware v2
+#define ESP8266_AT_VERSION_NO_SEND_BUFFER 2000000
 
 #define FW_AT_LEAST_VERSION(MAJOR,MINOR,PATCH,NUSED/*Not used*/,REF) \
     (((MAJOR)*1000000+(MINOR)*10000+(PATCH)*100) >= REF ? true : false)
@@ -464,6 +466,12 @@ public:
      */
     bool cond_enable_tcp_passive_mode();
 
+    /*
+     * Uses AT+CIPSENDBUF for TCP if enabled with esp8266.tcp-send-buffered,
+     * on AT firmware v1 which has it
+     */
+    bool cond_enable_tcp_send_buffered();
+
     /**
      * For executing OOB processing on background
      *
@@ -501,6 +509,8 @@ private:
 
     // FW version specific settings and functionalities
     bool _tcp_passive;
+    bool _tcp_send_buffered;
+    nsapi_size_or_error_t _send_buffered(int id, const void *data, uint32_t amount);
     int32_t _recv_tcp_passive(int id, void *data, uint32_t amount, std::chrono::duration<uint32_t, std::milli> timeout);
     mbed::Callback<void()> _callback;
 
@@ -528,6 +538,10 @@ private:
     } *_packets, * *_packets_end;
     void _clear_socket_packets(int id);
     void _clear_socket_sending(int id);
+    bool _tcp_buffered(int id);
+    void _tcp_ring_put(int id, uint32_t amount);
+    uint32_t _tcp_ring_get(int id, void *data, uint32_t amount);
+    int32_t _process_oob_tcp(int id, void *data, uint32_t amount, std::chrono::duration<uint32_t, std::milli> timeout, bool all);
     int _sock_active_id;
 
     // Memory statistics
@@ -578,9 +592,15 @@ private:
         bool open;
         nsapi_protocol_t proto;
         char *tcp_data;
+        uint32_t tcp_data_len; // Space left in tcp_data for +IPD payload
         int32_t tcp_data_avbl; // Data waiting on modem
         int32_t tcp_data_rcvd;
+        char *tcp_ring;        // Receive ring, MBED_CONF_ESP8266_TCP_RING_SIZE bytes
+        uint32_t tcp_ring_head;
+        uint32_t tcp_ring_len;
         bool send_fail;     // Received 'SEND FAIL'. Expect user will close the socket.
+        int send_segment;        // Last segment queued with AT+CIPSENDBUF
+        int send_segment_acked;  // Last segment the modem reported sent successfully
     };
     struct _sock_info _sock_i[SOCKET_COUNT];
 
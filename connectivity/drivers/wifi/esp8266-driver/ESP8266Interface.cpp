@@ -746,6 +746,9 @@ nsapi_error_t ESP8266Interface::_init(void)
         if (!_esp.cond_enable_tcp_passive_mode()) {
             return NSAPI_ERROR_DEVICE_ERROR;
         }
+        if (!_esp.cond_enable_tcp_send_buffered()) {
+            return NSAPI_ERROR_DEVICE_ERROR;
+        }
         if (!_esp.startup(ESP8266::WIFIMODE_STATION)) {
             return NSAPI_ERROR_DEVICE_ERROR;
         }
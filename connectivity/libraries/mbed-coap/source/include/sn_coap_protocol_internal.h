@@ -41,6 +41,20 @@ struct sn_coap_hdr_;
 #define COAP_OPTION_URI_PORT_NONE                   (-1) /**< Internal value to represent no Uri-Port option */
 #define COAP_OPTION_BLOCK_NONE                      (-1) /**< Internal value to represent no Block1/2 option */
 
+/* * For message lookup * */
+#ifndef SN_COAP_MSG_ID_HASH_SIZE
+#define SN_COAP_MSG_ID_HASH_SIZE                    16 /**< Buckets of the resend and duplicate message tables, a power of two */
+#endif
+#define SN_COAP_MSG_ID_HASH(msg_id)                 ((msg_id) & (SN_COAP_MSG_ID_HASH_SIZE - 1))
+
+/* * For blockwise transfers * */
+#ifndef SN_COAP_BLOCK_BUFFER_POOL_SIZE
+#define SN_COAP_BLOCK_BUFFER_POOL_SIZE              2 /**< Packet buffers of blocks kept for the next blocks, 0 to allocate each time */
+#endif
+#ifndef SN_COAP_BLOCK_BUFFER_HEADROOM
+#define SN_COAP_BLOCK_BUFFER_HEADROOM               64 /**< Room for header and options in the pooled packet buffers of blocks */
+#endif
+
 int8_t prepare_blockwise_message(struct coap_s *handle, struct sn_coap_hdr_ *coap_hdr_ptr);
 
 /* Structure which is stored to Linked list for message sending purposes */
@@ -52,6 +66,7 @@ typedef struct coap_send_msg_ {
 
     void                *param;             /* Extra parameter that will be passed to TX/RX callback functions */
 
+    struct coap_send_msg_ *hash_next;       /* Next message in the same bucket of the Message ID table */
     ns_list_link_t      link;
 } coap_send_msg_s;
 
@@ -65,6 +80,7 @@ typedef struct coap_duplication_info_ {
     uint8_t             *packet_ptr;
     sn_nsdl_addr_s      *address;
     void                *param;
+    struct coap_duplication_info_ *hash_next; /* Next info in the same bucket of the Message ID table */
     ns_list_link_t      link;
 } coap_duplication_info_s;
 
@@ -113,17 +129,24 @@ struct coap_s {
 
     #if ENABLE_RESENDINGS /* If Message resending is not used at all, this part of code will not be compiled */
         coap_send_msg_list_t linked_list_resent_msgs; /* Active resending messages are stored to this Linked list */
+        coap_send_msg_s *hash_resent_msgs[SN_COAP_MSG_ID_HASH_SIZE]; /* And hashed on Message ID */
         uint16_t count_resent_msgs;
+        uint32_t size_resent_msgs;
     #endif
 
     #if SN_COAP_DUPLICATION_MAX_MSGS_COUNT /* If Message duplication detection is not used at all, this part of code will not be compiled */
         coap_duplication_info_list_t  linked_list_duplication_msgs; /* Messages for duplicated messages detection is stored to this Linked list */
+        coap_duplication_info_s       *hash_duplication_msgs[SN_COAP_MSG_ID_HASH_SIZE]; /* And hashed on Message ID */
         uint16_t                      count_duplication_msgs;
     #endif
 
     #if SN_COAP_BLOCKWISE_ENABLED || SN_COAP_MAX_BLOCKWISE_PAYLOAD_SIZE /* If Message blockwise is not enabled, this part of code will not be compiled */
         coap_blockwise_msg_list_t     linked_list_blockwise_sent_msgs; /* Blockwise message to to be sent is stored to this Linked list */
         coap_blockwise_payload_list_t linked_list_blockwise_received_payloads; /* Blockwise payload to to be received is stored to this Linked list */
+        #if SN_COAP_BLOCK_BUFFER_POOL_SIZE
+            uint8_t *block_buffer_pool[SN_COAP_BLOCK_BUFFER_POOL_SIZE]; /* Free packet buffers of block size plus headroom */
+            uint8_t block_buffer_pool_count;
+        #endif
     #endif
 
     uint32_t system_time;    /* System time seconds */
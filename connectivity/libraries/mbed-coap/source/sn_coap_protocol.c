@@ -52,6 +52,7 @@ static void                  sn_coap_protocol_linked_list_duplication_info_store
 static coap_duplication_info_s *sn_coap_protocol_linked_list_duplication_info_search(const struct coap_s *handle, const sn_nsdl_addr_s *scr_addr_ptr, const uint16_t msg_id);
 static void                  sn_coap_protocol_linked_list_duplication_info_remove_old_ones(struct coap_s *handle);
 static void                  sn_coap_protocol_duplication_info_free(struct coap_s *handle, coap_duplication_info_s *duplication_info_ptr);
+static void                  sn_coap_protocol_linked_list_duplication_info_unlink(struct coap_s *handle, coap_duplication_info_s *duplication_info_ptr);
 static bool                  sn_coap_protocol_update_duplicate_package_data(const struct coap_s *handle, const sn_nsdl_addr_s *dst_addr_ptr, const sn_coap_hdr_s *coap_msg_ptr, const int16_t data_size, const uint8_t *dst_packet_data_ptr);
 static bool                  sn_coap_protocol_update_duplicate_package_data_all(const struct coap_s *handle, const sn_nsdl_addr_s *dst_addr_ptr, const sn_coap_hdr_s *coap_msg_ptr, const int16_t data_size, const uint8_t *dst_packet_data_ptr);
 
@@ -71,6 +72,9 @@ static bool                     sn_coap_handle_last_blockwise(struct coap_s *han
 static sn_coap_hdr_s            *sn_coap_protocol_copy_header(struct coap_s *handle, const sn_coap_hdr_s *source_header_ptr);
 static coap_blockwise_msg_s     *search_sent_blockwise_message(struct coap_s *handle, uint16_t msg_id);
 static int16_t                  store_blockwise_copy(struct coap_s *handle, const sn_coap_hdr_s *src_coap_msg_ptr, void *param, uint16_t original_payload_len, bool copy_payload);
+static uint8_t                  *sn_coap_protocol_block_buffer_get(struct coap_s *handle, uint16_t size);
+static void                     sn_coap_protocol_block_buffer_put(struct coap_s *handle, uint8_t *buffer_ptr, uint16_t size);
+static void                     sn_coap_protocol_block_buffer_pool_clear(struct coap_s *handle);
 #endif
 
 #if ENABLE_RESENDINGS
@@ -78,7 +82,8 @@ static uint8_t               sn_coap_protocol_linked_list_send_msg_store(struct
 static void                  sn_coap_protocol_linked_list_send_msg_remove(struct coap_s *handle, const sn_nsdl_addr_s *src_addr_ptr, uint16_t msg_id);
 static coap_send_msg_s      *sn_coap_protocol_allocate_mem_for_msg(struct coap_s *handle, sn_nsdl_addr_s *dst_addr_ptr, uint16_t packet_data_len);
 static void                  sn_coap_protocol_release_allocated_send_msg_mem(struct coap_s *handle, coap_send_msg_s *freed_send_msg_ptr);
-static uint16_t              sn_coap_count_linked_list_size(const coap_send_msg_list_t *linked_list_ptr);
+static void                  sn_coap_protocol_linked_list_send_msg_add(struct coap_s *handle, coap_send_msg_s *stored_msg_ptr);
+static void                  sn_coap_protocol_linked_list_send_msg_unlink(struct coap_s *handle, coap_send_msg_s *stored_msg_ptr);
 static uint32_t              sn_coap_calculate_new_resend_time(const uint32_t current_time, const uint8_t interval, const uint8_t counter);
 #endif
 
@@ -106,7 +111,7 @@ int8_t sn_coap_protocol_destroy(struct coap_s *handle)
 #if SN_COAP_DUPLICATION_MAX_MSGS_COUNT /* If Message duplication detection is not used at all, this part of code will not be compiled */
     ns_list_foreach_safe(coap_duplication_info_s, tmp, &handle->linked_list_duplication_msgs) {
 
-        ns_list_remove(&handle->linked_list_duplication_msgs, tmp);
+        sn_coap_protocol_linked_list_duplication_info_unlink(handle, tmp);
 
         sn_coap_protocol_duplication_info_free(handle, tmp);
     }
@@ -119,6 +124,8 @@ int8_t sn_coap_protocol_destroy(struct coap_s *handle)
     sn_coap_protocol_clear_sent_blockwise_messages(handle);
 
     sn_coap_protocol_clear_received_blockwise_messages(handle);
+
+    sn_coap_protocol_block_buffer_pool_clear(handle);
 #endif
 
     handle->sn_coap_protocol_free(handle);
@@ -211,6 +218,8 @@ int8_t sn_coap_protocol_set_block_size(struct coap_s *handle, uint16_t block_siz
         case 256:
         case 512:
         case 1024:
+            // Pooled buffers are sized for the old block size
+            sn_coap_protocol_block_buffer_pool_clear(handle);
             handle->sn_coap_block_data_size = block_size;
             return 0;
         default:
@@ -315,9 +324,8 @@ void sn_coap_protocol_clear_retransmission_buffer(struct coap_s *handle)
         return;
     }
     ns_list_foreach_safe(coap_send_msg_s, tmp, &handle->linked_list_resent_msgs) {
-        ns_list_remove(&handle->linked_list_resent_msgs, tmp);
+        sn_coap_protocol_linked_list_send_msg_unlink(handle, tmp);
         sn_coap_protocol_release_allocated_send_msg_mem(handle, tmp);
-        --handle->count_resent_msgs;
     }
 #endif
 }
@@ -328,15 +336,11 @@ int8_t sn_coap_protocol_delete_retransmission(struct coap_s *handle, uint16_t ms
     if (handle == NULL) {
         return -1;
     }
-    ns_list_foreach_safe(coap_send_msg_s, tmp, &handle->linked_list_resent_msgs) {
-        if (tmp->send_msg_ptr.packet_ptr) {
-            uint16_t temp_msg_id = read_packet_msg_id(tmp);
-            if (temp_msg_id == msg_id) {
-                ns_list_remove(&handle->linked_list_resent_msgs, tmp);
-                --handle->count_resent_msgs;
-                sn_coap_protocol_release_allocated_send_msg_mem(handle, tmp);
-                return 0;
-            }
+    for (coap_send_msg_s *tmp = handle->hash_resent_msgs[SN_COAP_MSG_ID_HASH(msg_id)]; tmp; tmp = tmp->hash_next) {
+        if (read_packet_msg_id(tmp) == msg_id) {
+            sn_coap_protocol_linked_list_send_msg_unlink(handle, tmp);
+            sn_coap_protocol_release_allocated_send_msg_mem(handle, tmp);
+            return 0;
         }
     }
 #endif
@@ -357,8 +361,7 @@ int8_t sn_coap_protocol_delete_retransmission_by_token(struct coap_s *handle, co
             if (memcmp(&stored_msg->send_msg_ptr.packet_ptr[4], token, stored_token_len) == 0) {
 
                 tr_debug("sn_coap_protocol_delete_retransmission_by_token - removed msg_id: %" PRIu16, read_packet_msg_id(stored_msg));
-                ns_list_remove(&handle->linked_list_resent_msgs, stored_msg);
-                --handle->count_resent_msgs;
+                sn_coap_protocol_linked_list_send_msg_unlink(handle, stored_msg);
 
                 /* Free memory of stored message */
                 sn_coap_protocol_release_allocated_send_msg_mem(handle, stored_msg);
@@ -673,10 +676,8 @@ sn_coap_hdr_s *sn_coap_protocol_parse(struct coap_s *handle, sn_nsdl_addr_s *src
                 coap_duplication_info_s *stored_duplication_info_ptr = ns_list_get_first(&handle->linked_list_duplication_msgs);
 
                 // Remove oldest stored duplication message for getting room for new duplication message
-                sn_coap_protocol_linked_list_duplication_info_remove(handle,
-                                                                     stored_duplication_info_ptr->address->addr_ptr,
-                                                                     stored_duplication_info_ptr->address->port,
-                                                                     stored_duplication_info_ptr->msg_id);
+                sn_coap_protocol_linked_list_duplication_info_unlink(handle, stored_duplication_info_ptr);
+                sn_coap_protocol_duplication_info_free(handle, stored_duplication_info_ptr);
             }
 
             // Store Duplication info to Linked list
@@ -878,8 +879,7 @@ rescan:
 
 
                 /* Remove message from Linked list */
-                ns_list_remove(&handle->linked_list_resent_msgs, stored_msg_ptr);
-                --handle->count_resent_msgs;
+                sn_coap_protocol_linked_list_send_msg_unlink(handle, stored_msg_ptr);
 
                 /* If RX callback have been defined.. */
                 if (handle->sn_coap_rx_callback != 0) {
@@ -958,7 +958,7 @@ static uint8_t sn_coap_protocol_linked_list_send_msg_store(struct coap_s *handle
 
     /* Count resending queue size, if buffer size is defined */
     if (handle->sn_coap_resending_queue_bytes > 0) {
-        if ((sn_coap_count_linked_list_size(&handle->linked_list_resent_msgs) + send_packet_data_len) > handle->sn_coap_resending_queue_bytes) {
+        if ((handle->size_resent_msgs + send_packet_data_len) > handle->sn_coap_resending_queue_bytes) {
             tr_error("sn_coap_protocol_linked_list_send_msg_store - resend buffer size reached!");
             return 0;
         }
@@ -990,9 +990,52 @@ static uint8_t sn_coap_protocol_linked_list_send_msg_store(struct coap_s *handle
     stored_msg_ptr->param = param;
 
     /* Storing Resending message to Linked list */
+    sn_coap_protocol_linked_list_send_msg_add(handle, stored_msg_ptr);
+    return 1;
+}
+
+/**************************************************************************//**
+ * \fn static void sn_coap_protocol_linked_list_send_msg_add(struct coap_s *handle, coap_send_msg_s *stored_msg_ptr)
+ *
+ * \brief Adds resending message to the end of Linked list and to its Message ID bucket
+ *
+ * \param *stored_msg_ptr is message to be added, with its packet data filled
+ *****************************************************************************/
+
+static void sn_coap_protocol_linked_list_send_msg_add(struct coap_s *handle, coap_send_msg_s *stored_msg_ptr)
+{
+    /* Buckets are kept in Linked list order too, the oldest message is found first */
+    coap_send_msg_s **bucket_ptr = &handle->hash_resent_msgs[SN_COAP_MSG_ID_HASH(read_packet_msg_id(stored_msg_ptr))];
+    while (*bucket_ptr) {
+        bucket_ptr = &(*bucket_ptr)->hash_next;
+    }
+    stored_msg_ptr->hash_next = NULL;
+    *bucket_ptr = stored_msg_ptr;
+
     ns_list_add_to_end(&handle->linked_list_resent_msgs, stored_msg_ptr);
     ++handle->count_resent_msgs;
-    return 1;
+    handle->size_resent_msgs += stored_msg_ptr->send_msg_ptr.packet_len;
+}
+
+/**************************************************************************//**
+ * \fn static void sn_coap_protocol_linked_list_send_msg_unlink(struct coap_s *handle, coap_send_msg_s *stored_msg_ptr)
+ *
+ * \brief Removes resending message from Linked list and its Message ID bucket, without freeing it
+ *
+ * \param *stored_msg_ptr is message to be removed
+ *****************************************************************************/
+
+static void sn_coap_protocol_linked_list_send_msg_unlink(struct coap_s *handle, coap_send_msg_s *stored_msg_ptr)
+{
+    coap_send_msg_s **bucket_ptr = &handle->hash_resent_msgs[SN_COAP_MSG_ID_HASH(read_packet_msg_id(stored_msg_ptr))];
+    while (*bucket_ptr != stored_msg_ptr) {
+        bucket_ptr = &(*bucket_ptr)->hash_next;
+    }
+    *bucket_ptr = stored_msg_ptr->hash_next;
+
+    ns_list_remove(&handle->linked_list_resent_msgs, stored_msg_ptr);
+    --handle->count_resent_msgs;
+    handle->size_resent_msgs -= stored_msg_ptr->send_msg_ptr.packet_len;
 }
 
 
@@ -1007,8 +1050,8 @@ static uint8_t sn_coap_protocol_linked_list_send_msg_store(struct coap_s *handle
 
 static void sn_coap_protocol_linked_list_send_msg_remove(struct coap_s *handle, const sn_nsdl_addr_s *src_addr_ptr, uint16_t msg_id)
 {
-    /* Loop all stored resending messages in Linked list */
-    ns_list_foreach(coap_send_msg_s, stored_msg_ptr, &handle->linked_list_resent_msgs) {
+    /* Loop stored resending messages with the same Message ID hash */
+    for (coap_send_msg_s *stored_msg_ptr = handle->hash_resent_msgs[SN_COAP_MSG_ID_HASH(msg_id)]; stored_msg_ptr; stored_msg_ptr = stored_msg_ptr->hash_next) {
         /* Get message ID from stored resending message */
         uint16_t temp_msg_id = read_packet_msg_id(stored_msg_ptr);
         /* If message's Message ID is same than is searched */
@@ -1018,8 +1061,7 @@ static void sn_coap_protocol_linked_list_send_msg_remove(struct coap_s *handle,
             if (compare_port(src_addr_ptr, &stored_msg_ptr->send_msg_ptr.dst_addr_ptr)) {
                 /* * * Message found * * */
                 /* Remove message from Linked list */
-                ns_list_remove(&handle->linked_list_resent_msgs, stored_msg_ptr);
-                --handle->count_resent_msgs;
+                sn_coap_protocol_linked_list_send_msg_unlink(handle, stored_msg_ptr);
 
                 /* Free memory of stored message */
                 sn_coap_protocol_release_allocated_send_msg_mem(handle, stored_msg_ptr);
@@ -1114,12 +1156,37 @@ static void sn_coap_protocol_linked_list_duplication_info_store(struct coap_s *h
     stored_duplication_info_ptr->msg_id = msg_id;
 
     stored_duplication_info_ptr->param = param;
-    /* * * * Storing Duplication info to Linked list * * * */
+    /* * * * Storing Duplication info to Linked list, and to the end of its Message ID bucket * * * */
+    coap_duplication_info_s **bucket_ptr = &handle->hash_duplication_msgs[SN_COAP_MSG_ID_HASH(msg_id)];
+    while (*bucket_ptr) {
+        bucket_ptr = &(*bucket_ptr)->hash_next;
+    }
+    *bucket_ptr = stored_duplication_info_ptr;
 
     ns_list_add_to_end(&handle->linked_list_duplication_msgs, stored_duplication_info_ptr);
     ++handle->count_duplication_msgs;
 }
 
+/**************************************************************************//**
+ * \fn static void sn_coap_protocol_linked_list_duplication_info_unlink(struct coap_s *handle, coap_duplication_info_s *duplication_info_ptr)
+ *
+ * \brief Removes Duplication info from Linked list and its Message ID bucket, without freeing it
+ *
+ * \param *duplication_info_ptr is Duplication info to be removed
+ *****************************************************************************/
+
+static void sn_coap_protocol_linked_list_duplication_info_unlink(struct coap_s *handle, coap_duplication_info_s *duplication_info_ptr)
+{
+    coap_duplication_info_s **bucket_ptr = &handle->hash_duplication_msgs[SN_COAP_MSG_ID_HASH(duplication_info_ptr->msg_id)];
+    while (*bucket_ptr != duplication_info_ptr) {
+        bucket_ptr = &(*bucket_ptr)->hash_next;
+    }
+    *bucket_ptr = duplication_info_ptr->hash_next;
+
+    ns_list_remove(&handle->linked_list_duplication_msgs, duplication_info_ptr);
+    --handle->count_duplication_msgs;
+}
+
 /**************************************************************************//**
  * \fn static coap_duplication_info_s *sn_coap_protocol_linked_list_duplication_info_search(const struct coap_s *handle, const sn_nsdl_addr_s *scr_addr_ptr, const uint16_t msg_id)
  *
@@ -1134,8 +1201,9 @@ static void sn_coap_protocol_linked_list_duplication_info_store(struct coap_s *h
 static coap_duplication_info_s* sn_coap_protocol_linked_list_duplication_info_search(const struct coap_s *handle,
         const sn_nsdl_addr_s *addr_ptr, const uint16_t msg_id)
 {
-    /* Loop all nodes in Linked list for searching Message ID */
-    ns_list_foreach(coap_duplication_info_s, stored_duplication_info_ptr, &handle->linked_list_duplication_msgs) {
+    /* Loop nodes with the same Message ID hash */
+    for (coap_duplication_info_s *stored_duplication_info_ptr = handle->hash_duplication_msgs[SN_COAP_MSG_ID_HASH(msg_id)];
+            stored_duplication_info_ptr; stored_duplication_info_ptr = stored_duplication_info_ptr->hash_next) {
         /* If message's Message ID is same than is searched */
         if (stored_duplication_info_ptr->msg_id == msg_id) {
             /* If message's Source address & port is same than is searched */
@@ -1162,11 +1230,13 @@ static void sn_coap_protocol_linked_list_duplication_info_remove_old_ones(struct
     ns_list_foreach_safe(coap_duplication_info_s, removed_duplication_info_ptr, &handle->linked_list_duplication_msgs) {
         if ((handle->system_time - removed_duplication_info_ptr->timestamp)  > SN_COAP_DUPLICATION_MAX_TIME_MSGS_STORED) {
             /* * * * Old Duplication info found, remove it from Linked list * * * */
-            ns_list_remove(&handle->linked_list_duplication_msgs, removed_duplication_info_ptr);
-            --handle->count_duplication_msgs;
+            sn_coap_protocol_linked_list_duplication_info_unlink(handle, removed_duplication_info_ptr);
 
             /* Free memory of stored Duplication info */
             sn_coap_protocol_duplication_info_free(handle, removed_duplication_info_ptr);
+        } else {
+            /* Linked list is in storing order, the rest are newer */
+            break;
         }
     }
 }
@@ -1176,8 +1246,9 @@ static void sn_coap_protocol_linked_list_duplication_info_remove_old_ones(struct
 void sn_coap_protocol_linked_list_duplication_info_remove(struct coap_s *handle, const uint8_t *scr_addr_ptr, const uint16_t port, const uint16_t msg_id)
 {
 #if SN_COAP_DUPLICATION_MAX_MSGS_COUNT
-    /* Loop all stored duplication messages in Linked list */
-    ns_list_foreach(coap_duplication_info_s, removed_duplication_info_ptr, &handle->linked_list_duplication_msgs) {
+    /* Loop stored duplication messages with the same Message ID hash */
+    for (coap_duplication_info_s *removed_duplication_info_ptr = handle->hash_duplication_msgs[SN_COAP_MSG_ID_HASH(msg_id)];
+            removed_duplication_info_ptr; removed_duplication_info_ptr = removed_duplication_info_ptr->hash_next) {
         /* If message's Address is same than is searched */
         if (0 == memcmp(scr_addr_ptr,
                         removed_duplication_info_ptr->address->addr_ptr,
@@ -1188,8 +1259,7 @@ void sn_coap_protocol_linked_list_duplication_info_remove(struct coap_s *handle,
                 if (removed_duplication_info_ptr->msg_id == msg_id) {
                     /* * * * Correct Duplication info found, remove it from Linked list * * * */
                     tr_info("sn_coap_protocol_linked_list_duplication_info_remove - message id %d removed", msg_id);
-                    ns_list_remove(&handle->linked_list_duplication_msgs, removed_duplication_info_ptr);
-                    --handle->count_duplication_msgs;
+                    sn_coap_protocol_linked_list_duplication_info_unlink(handle, removed_duplication_info_ptr);
 
                     /* Free memory of stored Duplication info */
                     sn_coap_protocol_duplication_info_free(handle, removed_duplication_info_ptr);
@@ -1287,29 +1357,19 @@ static void sn_coap_protocol_linked_list_blockwise_payload_store(struct coap_s *
         uint16_t new_len = stored_blockwise_payload_ptr->payload_len + payload_len;
         tr_debug("sn_coap_protocol_linked_list_blockwise_payload_store - reallocate from %d to %d", stored_blockwise_payload_ptr->payload_len, new_len);
 
-        uint8_t *temp_ptr = handle->sn_coap_protocol_malloc(stored_blockwise_payload_ptr->payload_len);
-        if (temp_ptr == NULL) {
-            tr_error("sn_coap_protocol_linked_list_blockwise_payload_store - failed to allocate temp buffer!");
-            sn_coap_protocol_linked_list_blockwise_payload_remove(handle, stored_blockwise_payload_ptr);
-            return;
-        }
-
-        memcpy(temp_ptr, stored_blockwise_payload_ptr->payload_ptr, stored_blockwise_payload_ptr->payload_len);
-
-        handle->sn_coap_protocol_free(stored_blockwise_payload_ptr->payload_ptr);
-        stored_blockwise_payload_ptr->payload_ptr = handle->sn_coap_protocol_malloc(new_len);
-
-        if (stored_blockwise_payload_ptr->payload_ptr == NULL) {
+        // Copied straight from the old payload, which is freed afterwards
+        uint8_t *new_payload_ptr = handle->sn_coap_protocol_malloc(new_len);
+        if (new_payload_ptr == NULL) {
             tr_error("sn_coap_protocol_linked_list_blockwise_payload_store - failed to reallocate payload!");
-            handle->sn_coap_protocol_free(temp_ptr);
             sn_coap_protocol_linked_list_blockwise_payload_remove(handle, stored_blockwise_payload_ptr);
             return;
         }
 
-        memcpy(stored_blockwise_payload_ptr->payload_ptr, temp_ptr, stored_blockwise_payload_ptr->payload_len);
-        memcpy(stored_blockwise_payload_ptr->payload_ptr + stored_blockwise_payload_ptr->payload_len, payload_ptr, payload_len);
+        memcpy(new_payload_ptr, stored_blockwise_payload_ptr->payload_ptr, stored_blockwise_payload_ptr->payload_len);
+        memcpy(new_payload_ptr + stored_blockwise_payload_ptr->payload_len, payload_ptr, payload_len);
+        handle->sn_coap_protocol_free(stored_blockwise_payload_ptr->payload_ptr);
+        stored_blockwise_payload_ptr->payload_ptr = new_payload_ptr;
         stored_blockwise_payload_ptr->payload_len = new_len;
-        handle->sn_coap_protocol_free(temp_ptr);
 
     } else {
         stored_blockwise_payload_ptr = NULL;
@@ -1643,27 +1703,68 @@ static void sn_coap_protocol_release_allocated_send_msg_mem(struct coap_s *handl
     }
 }
 
+#endif
+
+#if SN_COAP_BLOCKWISE_ENABLED || SN_COAP_MAX_BLOCKWISE_PAYLOAD_SIZE
+
 /**************************************************************************//**
- * \fn static uint16_t sn_coap_count_linked_list_size(const coap_send_msg_list_t *linked_list_ptr)
+ * \fn static uint8_t *sn_coap_protocol_block_buffer_get(struct coap_s *handle, uint16_t size)
  *
- * \brief Counts total message size of all messages in linked list
+ * \brief Allocates Packet data buffer for a block, from the pool if it fits one
  *
- * \param const coap_send_msg_list_t *linked_list_ptr pointer to linked list
+ * \param size is length of needed Packet data
+ *
+ * \return pointer to buffer, to be released with sn_coap_protocol_block_buffer_put()
  *****************************************************************************/
-static uint16_t sn_coap_count_linked_list_size(const coap_send_msg_list_t *linked_list_ptr)
-{
-    uint16_t total_size = 0;
 
-    ns_list_foreach(coap_send_msg_s, stored_msg_ptr, linked_list_ptr) {
-        total_size += stored_msg_ptr->send_msg_ptr.packet_len;
+static uint8_t *sn_coap_protocol_block_buffer_get(struct coap_s *handle, uint16_t size)
+{
+#if SN_COAP_BLOCK_BUFFER_POOL_SIZE
+    uint16_t pooled_size = handle->sn_coap_block_data_size + SN_COAP_BLOCK_BUFFER_HEADROOM;
+    if (size <= pooled_size) {
+        if (handle->block_buffer_pool_count) {
+            return handle->block_buffer_pool[--handle->block_buffer_pool_count];
+        }
+        // Allocated to the pooled size, for the next blocks to reuse
+        size = pooled_size;
     }
-
-    return total_size;
+#endif
+    return handle->sn_coap_protocol_malloc(size);
 }
 
+/**************************************************************************//**
+ * \fn static void sn_coap_protocol_block_buffer_put(struct coap_s *handle, uint8_t *buffer_ptr, uint16_t size)
+ *
+ * \brief Releases Packet data buffer of a block, to the pool if there is room
+ *
+ * \param *buffer_ptr is buffer from sn_coap_protocol_block_buffer_get(), or NULL
+ * \param size is length given to sn_coap_protocol_block_buffer_get()
+ *****************************************************************************/
+
+static void sn_coap_protocol_block_buffer_put(struct coap_s *handle, uint8_t *buffer_ptr, uint16_t size)
+{
+#if SN_COAP_BLOCK_BUFFER_POOL_SIZE
+    if (buffer_ptr && size <= handle->sn_coap_block_data_size + SN_COAP_BLOCK_BUFFER_HEADROOM &&
+            handle->block_buffer_pool_count < SN_COAP_BLOCK_BUFFER_POOL_SIZE) {
+        handle->block_buffer_pool[handle->block_buffer_pool_count++] = buffer_ptr;
+        return;
+    }
+#else
+    (void) size;
 #endif
+    handle->sn_coap_protocol_free(buffer_ptr);
+}
 
-#if SN_COAP_BLOCKWISE_ENABLED || SN_COAP_MAX_BLOCKWISE_PAYLOAD_SIZE
+static void sn_coap_protocol_block_buffer_pool_clear(struct coap_s *handle)
+{
+#if SN_COAP_BLOCK_BUFFER_POOL_SIZE
+    while (handle->block_buffer_pool_count) {
+        handle->sn_coap_protocol_free(handle->block_buffer_pool[--handle->block_buffer_pool_count]);
+    }
+#else
+    (void) handle;
+#endif
+}
 
 static coap_blockwise_msg_s* search_sent_blockwise_message(struct coap_s *handle, uint16_t msg_id)
 {
@@ -1821,7 +1922,7 @@ static sn_coap_hdr_s *sn_coap_handle_blockwise_message(struct coap_s *handle, sn
                     /* Build and send block message */
                     dst_packed_data_needed_mem = sn_coap_builder_calc_needed_packet_data_size_2(src_coap_blockwise_ack_msg_ptr, handle->sn_coap_block_data_size);
 
-                    dst_ack_packet_data_ptr = handle->sn_coap_protocol_malloc(dst_packed_data_needed_mem);
+                    dst_ack_packet_data_ptr = sn_coap_protocol_block_buffer_get(handle, dst_packed_data_needed_mem);
                     if (!dst_ack_packet_data_ptr) {
                         tr_error("sn_coap_handle_blockwise_message - (send block1) failed to allocate ack message!");
                         handle->sn_coap_protocol_free(src_coap_blockwise_ack_msg_ptr->options_list_ptr);
@@ -1846,7 +1947,7 @@ static sn_coap_hdr_s *sn_coap_handle_blockwise_message(struct coap_s *handle, sn
                     }
 #endif
 
-                    handle->sn_coap_protocol_free(dst_ack_packet_data_ptr);
+                    sn_coap_protocol_block_buffer_put(handle, dst_ack_packet_data_ptr, dst_packed_data_needed_mem);
                     dst_ack_packet_data_ptr = 0;
 
                     stored_blockwise_msg_temp_ptr->coap_msg_ptr->payload_len = original_payload_len;
@@ -1944,7 +2045,7 @@ static sn_coap_hdr_s *sn_coap_handle_blockwise_message(struct coap_s *handle, sn
 
                 dst_packed_data_needed_mem = sn_coap_builder_calc_needed_packet_data_size_2(src_coap_blockwise_ack_msg_ptr, handle->sn_coap_block_data_size);
 
-                dst_ack_packet_data_ptr = handle->sn_coap_protocol_malloc(dst_packed_data_needed_mem);
+                dst_ack_packet_data_ptr = sn_coap_protocol_block_buffer_get(handle, dst_packed_data_needed_mem);
                 if (!dst_ack_packet_data_ptr) {
                     tr_error("sn_coap_handle_blockwise_message - (recv block1) message allocation failed!");
                     handle->sn_coap_protocol_free(src_coap_blockwise_ack_msg_ptr->options_list_ptr);
@@ -1962,7 +2063,7 @@ static sn_coap_hdr_s *sn_coap_handle_blockwise_message(struct coap_s *handle, sn
                                                                     dst_packed_data_needed_mem,
                                                                     dst_ack_packet_data_ptr)) {
                     sn_coap_parser_release_allocated_coap_msg_mem(handle, src_coap_blockwise_ack_msg_ptr);
-                    handle->sn_coap_protocol_free(dst_ack_packet_data_ptr);
+                    sn_coap_protocol_block_buffer_put(handle, dst_ack_packet_data_ptr, dst_packed_data_needed_mem);
                     return NULL;
                 }
 #endif
@@ -1984,7 +2085,7 @@ static sn_coap_hdr_s *sn_coap_handle_blockwise_message(struct coap_s *handle, sn
                 handle->sn_coap_tx_callback(dst_ack_packet_data_ptr, dst_packed_data_needed_mem, src_addr_ptr, param);
 
                 sn_coap_parser_release_allocated_coap_msg_mem(handle, src_coap_blockwise_ack_msg_ptr);
-                handle->sn_coap_protocol_free(dst_ack_packet_data_ptr);
+                sn_coap_protocol_block_buffer_put(handle, dst_ack_packet_data_ptr, dst_packed_data_needed_mem);
                 dst_ack_packet_data_ptr = 0;
 
                 received_coap_msg_ptr->coap_status = COAP_STATUS_PARSER_BLOCKWISE_MSG_RECEIVING;
@@ -2095,7 +2196,7 @@ static sn_coap_hdr_s *sn_coap_handle_blockwise_message(struct coap_s *handle, sn
                     dst_packed_data_needed_mem = sn_coap_builder_calc_needed_packet_data_size_2(src_coap_blockwise_ack_msg_ptr, handle->sn_coap_block_data_size);
 
                     /* Then allocate memory for Packet data */
-                    dst_ack_packet_data_ptr = sn_coap_protocol_calloc(handle, dst_packed_data_needed_mem);
+                    dst_ack_packet_data_ptr = sn_coap_protocol_block_buffer_get(handle, dst_packed_data_needed_mem);
 
                     if (dst_ack_packet_data_ptr == NULL) {
                         tr_error("sn_coap_handle_blockwise_message - (send block2) failed to allocate packet!");
@@ -2106,7 +2207,7 @@ static sn_coap_hdr_s *sn_coap_handle_blockwise_message(struct coap_s *handle, sn
                     /* * * Then build Acknowledgement message to Packed data * * */
                     if ((sn_coap_builder_2(dst_ack_packet_data_ptr, src_coap_blockwise_ack_msg_ptr, handle->sn_coap_block_data_size)) < 0) {
                         tr_error("sn_coap_handle_blockwise_message - (send block2) builder failed!");
-                        handle->sn_coap_protocol_free(dst_ack_packet_data_ptr);
+                        sn_coap_protocol_block_buffer_put(handle, dst_ack_packet_data_ptr, dst_packed_data_needed_mem);
                         sn_coap_parser_release_allocated_coap_msg_mem(handle, src_coap_blockwise_ack_msg_ptr);
                         return NULL;
                     }
@@ -2117,7 +2218,7 @@ static sn_coap_hdr_s *sn_coap_handle_blockwise_message(struct coap_s *handle, sn
                     stored_blockwise_msg_ptr = sn_coap_protocol_calloc(handle, sizeof(coap_blockwise_msg_s));
                     if (!stored_blockwise_msg_ptr) {
                         tr_error("sn_coap_handle_blockwise_message - (send block2) failed to allocate blockwise message!");
-                        handle->sn_coap_protocol_free(dst_ack_packet_data_ptr);
+                        sn_coap_protocol_block_buffer_put(handle, dst_ack_packet_data_ptr, dst_packed_data_needed_mem);
                         sn_coap_parser_release_allocated_coap_msg_mem(handle, src_coap_blockwise_ack_msg_ptr);
                         return 0;
                     }
@@ -2140,7 +2241,7 @@ static sn_coap_hdr_s *sn_coap_handle_blockwise_message(struct coap_s *handle, sn
                             dst_ack_packet_data_ptr,
                             resend_time, param);
 #endif
-                    handle->sn_coap_protocol_free(dst_ack_packet_data_ptr);
+                    sn_coap_protocol_block_buffer_put(handle, dst_ack_packet_data_ptr, dst_packed_data_needed_mem);
                     dst_ack_packet_data_ptr = 0;
                 }
 
@@ -2239,7 +2340,7 @@ static sn_coap_hdr_s *sn_coap_handle_blockwise_message(struct coap_s *handle, sn
                 /* Build and send block message */
                 dst_packed_data_needed_mem = sn_coap_builder_calc_needed_packet_data_size_2(src_coap_blockwise_ack_msg_ptr, handle->sn_coap_block_data_size);
 
-                dst_ack_packet_data_ptr = handle->sn_coap_protocol_malloc(dst_packed_data_needed_mem);
+                dst_ack_packet_data_ptr = sn_coap_protocol_block_buffer_get(handle, dst_packed_data_needed_mem);
                 if (!dst_ack_packet_data_ptr) {
                     tr_error("sn_coap_handle_blockwise_message - (recv block2) failed to allocate packet!");
                     handle->sn_coap_protocol_free(original_payload_ptr);
@@ -2258,14 +2359,14 @@ static sn_coap_hdr_s *sn_coap_handle_blockwise_message(struct coap_s *handle, sn
                                                                         dst_packed_data_needed_mem,
                                                                         dst_ack_packet_data_ptr)) {
                     sn_coap_parser_release_allocated_coap_msg_mem(handle, src_coap_blockwise_ack_msg_ptr);
-                    handle->sn_coap_protocol_free(dst_ack_packet_data_ptr);
+                    sn_coap_protocol_block_buffer_put(handle, dst_ack_packet_data_ptr, dst_packed_data_needed_mem);
                     return NULL;
                 }
 #endif
 
                 handle->sn_coap_tx_callback(dst_ack_packet_data_ptr, dst_packed_data_needed_mem, src_addr_ptr, param);
 
-                handle->sn_coap_protocol_free(dst_ack_packet_data_ptr);
+                sn_coap_protocol_block_buffer_put(handle, dst_ack_packet_data_ptr, dst_packed_data_needed_mem);
                 dst_ack_packet_data_ptr = 0;
 
                 stored_blockwise_msg_temp_ptr->coap_msg_ptr->payload_len = original_payload_len;
@@ -22,8 +22,17 @@
 #define NEXT_HEADER_UDP     0x11
 #define NEXT_HEADER_ICMP6   0x3A
 
-extern uint16_t ip_fcf_v(uint_fast8_t count, const ns_iovec_t vec[static count]);
-extern uint16_t ipv6_fcf(const uint8_t src_address[static 16], const uint8_t dest_address[static 16],
-                         uint16_t data_length, const uint8_t data_ptr[static data_length],  uint8_t next_protocol);
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern uint16_t ip_fcf_v(uint_fast8_t count, const ns_iovec_t *vec);
+extern uint16_t ipv6_fcf(const uint8_t src_address[__static 16], const uint8_t dest_address[__static 16],
+                         uint16_t data_length, const uint8_t *data_ptr,  uint8_t next_protocol);
+extern uint16_t ip_fcf_update(uint16_t checksum, uint16_t old_value, uint16_t new_value);
+
+#ifdef __cplusplus
+}
+#endif
 
 #endif
@@ -86,6 +86,8 @@ typedef struct ns_dyn_mem_tracker_lib_conf_s {
     uint16_t to_permanent_allocators_count;                             /**< To permanent allocators array count */
     uint16_t max_snap_shot_allocators_count;                            /**< Snap shot of maximum memory used by allocators array count */
     uint16_t to_permanent_steps_count;                                  /**< How many steps before moving block to permanent allocators list */
+    uint32_t *size_histogram;                                           /**< Allocations by size, entry n counting 2^n to 2^(n+1)-1 bytes, or NULL */
+    uint16_t size_histogram_count;                                      /**< Size histogram count, last entry counting all larger allocations */
 } ns_dyn_mem_tracker_lib_conf_t;
 
 int8_t ns_dyn_mem_tracker_lib_alloc(ns_dyn_mem_tracker_lib_conf_t *conf, void *caller_addr, const char *function, uint32_t line, void *block, uint32_t alloc_size);
@@ -14,8 +14,72 @@
  * limitations under the License.
  */
 #include "stdint.h"
+#include "stddef.h"
 #include "ip_fsc.h"
 
+#if defined __BYTE_ORDER__ && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+#define FSC_TO_BE16(x) (x)
+#else
+#define FSC_TO_BE16(x) ((uint16_t)(((x) << 8) | ((x) >> 8)))
+#endif
+
+#define FSC_SWAP16(x) ((uint_fast16_t)((((x) << 8) | ((x) >> 8)) & 0xffff))
+
+/* Fold a one's complement sum down to 16 bits */
+static uint_fast16_t ip_fcf_fold(uint64_t acc)
+{
+    acc = (acc >> 32) + (acc & 0xffffffff);
+    acc = (acc >> 32) + (acc & 0xffffffff);
+    uint32_t acc32 = (uint32_t) acc;
+    acc32 = (acc32 >> 16) + (acc32 & 0xffff);
+    acc32 = (acc32 >> 16) + (acc32 & 0xffff);
+    return acc32;
+}
+
+/* One's complement sum of 16-bit words in native byte order, of data
+ * starting on a 16-bit boundary; a final odd byte is padded with zero.
+ *
+ * The sum is independent of byte order except for a final byte swap, so
+ * the body is added a 32-bit word at a time, four words per iteration.
+ */
+static uint_fast16_t ip_fcf_sum(const uint8_t *data_ptr, uint_fast16_t data_length)
+{
+    uint64_t acc = 0;
+
+    if (((uintptr_t) data_ptr & 2) && data_length >= 2) {
+        acc += *(const uint16_t *) data_ptr;
+        data_ptr += 2;
+        data_length -= 2;
+    }
+
+    const uint32_t *word_ptr = (const uint32_t *) data_ptr;
+    while (data_length >= 16) {
+        acc += (uint64_t) word_ptr[0] + word_ptr[1] + word_ptr[2] + word_ptr[3];
+        word_ptr += 4;
+        data_length -= 16;
+    }
+    while (data_length >= 4) {
+        acc += *word_ptr++;
+        data_length -= 4;
+    }
+
+    data_ptr = (const uint8_t *) word_ptr;
+    if (data_length >= 2) {
+        acc += *(const uint16_t *) data_ptr;
+        data_ptr += 2;
+        data_length -= 2;
+    }
+    if (data_length) {
+        union {
+            uint16_t word;
+            uint8_t byte[2];
+        } tail = { .byte = { data_ptr[0], 0 } };
+        acc += tail.word;
+    }
+
+    return ip_fcf_fold(acc);
+}
+
 /** \brief Compute IP checksum for arbitary data
  *
  * Compute an IP checksum, given a arbitrary gather list.
@@ -23,40 +87,59 @@
  * See ipv6_fcf for discussion of use.
  *
  * This will work for any arbitrary gather list - it can handle odd
- * alignments. The one limitation is that the 32-bit accumulator limits
- * it to basically 64K of total data.
+ * alignments and odd lengths. The data of each element is summed 32 bits
+ * at a time from its first aligned word.
  */
-uint16_t ip_fcf_v(uint_fast8_t count, const ns_iovec_t vec[static count])
+uint16_t ip_fcf_v(uint_fast8_t count, const ns_iovec_t *vec)
 {
     uint_fast32_t acc32 = 0;
     bool odd = false;
     while (count) {
         const uint8_t *data_ptr = vec->iov_base;
         uint_fast16_t data_length = vec->iov_len;
-        if (odd && data_length > 0) {
-            acc32 += *data_ptr++;
+        // A byte at an odd address is summed alone, the rest is aligned
+        if (data_length && ((uintptr_t) data_ptr & 1)) {
+            union {
+                uint16_t word;
+                uint8_t byte[2];
+            } head = { .byte = { odd ? 0 : data_ptr[0], odd ? data_ptr[0] : 0 } };
+            acc32 += head.word;
+            data_ptr++;
             data_length--;
-            odd = false;
-        }
-        while (data_length >= 2) {
-            acc32 += (uint_fast16_t) data_ptr[0] << 8 | data_ptr[1];
-            data_ptr += 2;
-            data_length -= 2;
+            odd = !odd;
         }
         if (data_length) {
-            acc32 += (uint_fast16_t) data_ptr[0] << 8;
-            odd = true;
+            // Data at an odd offset in the sum pairs up with the other byte
+            uint_fast16_t sum16 = ip_fcf_sum(data_ptr, data_length);
+            acc32 += odd ? FSC_SWAP16(sum16) : sum16;
+            if (data_length & 1) {
+                odd = !odd;
+            }
         }
         vec++;
         count--;
     }
 
-    // Fold down up to 0xffff carries in the 32-bit accumulator
-    acc32 = (acc32 >> 16) + (acc32 & 0xffff);
+    uint16_t sum16 = ip_fcf_fold(acc32);
+    return ~FSC_TO_BE16(sum16);
+}
 
-    // Could be one more carry from the previous addition (result <= 0x1fffe)
-    uint16_t sum16 = (uint16_t)((acc32 >> 16) + (acc32 & 0xffff));
-    return ~sum16;
+/** \brief Update an IP checksum for a changed 16-bit field
+ *
+ * Adjust a checksum, as stored in a packet, for a 16-bit word of the data
+ * it covers changing from old_value to new_value, without recomputing it
+ * over all the data (RFC 1624). Changes of a single byte are passed as the
+ * 16-bit word holding it, and longer changes one word at a time.
+ *
+ * The values are in host order, as read with common_read_16_bit.
+ */
+uint16_t ip_fcf_update(uint16_t checksum, uint16_t old_value, uint16_t new_value)
+{
+    // HC' = ~(~HC + ~m + m')
+    uint_fast32_t acc32 = (uint16_t) ~checksum + (uint16_t) ~old_value + new_value;
+    acc32 = (acc32 >> 16) + (acc32 & 0xffff);
+    acc32 = (acc32 >> 16) + (acc32 & 0xffff);
+    return ~acc32;
 }
 
 /** \brief Compute IPv6 checksum
@@ -75,7 +158,7 @@ uint16_t ip_fcf_v(uint_fast8_t count, const ns_iovec_t vec[static count])
  * checksum 0xFFFF.
  */
 uint16_t ipv6_fcf(const uint8_t src_address[static 16], const uint8_t dest_address[static 16],
-                  uint16_t data_length, const uint8_t data_ptr[static data_length],  uint8_t next_protocol)
+                  uint16_t data_length, const uint8_t *data_ptr,  uint8_t next_protocol)
 {
     // Use gather vector to lay out IPv6 pseudo-header (RFC 2460) and data
     uint8_t hdr_data[] = { data_length >> 8, data_length, 0, next_protocol };
@@ -21,6 +21,15 @@
 #include <stdlib.h>
 #include "ns_list.h"
 
+/* Keep holes in free lists by size class instead of one address ordered list,
+ * so that allocation and free take constant time however fragmented the heap.
+ * Temporary and long period allocations then still come from opposite ends
+ * of the hole found, but not from opposite ends of the heap.
+ */
+#ifndef NSDYNMEM_SEGREGATED_FREE_LISTS
+#define NSDYNMEM_SEGREGATED_FREE_LISTS 0
+#endif
+
 #ifndef STANDARD_MALLOC
 typedef enum mem_stat_update_t {
     DEV_HEAP_ALLOC_OK,
@@ -37,13 +46,24 @@ typedef int ns_mem_word_size_t; // internal signed heap block size type
 // Amount of memory regions
 #define REGION_COUNT 3
 
+#if NSDYNMEM_SEGREGATED_FREE_LISTS==1
+// Hole size classes, class n holding holes of 2^n to 2^(n+1)-1 words,
+// and the last class all larger holes
+#define BIN_COUNT 16
+#endif
+
 /* struct for book keeping variables */
 struct ns_mem_book {
     ns_mem_word_size_t     *heap_main[REGION_COUNT];
     ns_mem_word_size_t     *heap_main_end[REGION_COUNT];
     mem_stat_t *mem_stat_info_ptr;
     void (*heap_failure_callback)(heap_fail_t);
+#if NSDYNMEM_SEGREGATED_FREE_LISTS==1
+    NS_LIST_HEAD(hole_t, link) bins[BIN_COUNT];
+    uint32_t bins_used;                              /* Bit n set if bins[n] is not empty */
+#else
     NS_LIST_HEAD(hole_t, link) holes_list;
+#endif
     ns_mem_heap_size_t heap_size;
     ns_mem_heap_size_t temporary_alloc_heap_limit;   /* Amount of reserved heap temporary alloc can't exceed */
 };
@@ -66,6 +86,71 @@ static NS_INLINE ns_mem_word_size_t *block_start_from_hole(hole_t *start)
     return ((ns_mem_word_size_t *)start) - 1;
 }
 
+#if NSDYNMEM_SEGREGATED_FREE_LISTS==1
+static NS_INLINE int size_class(ns_mem_word_size_t size)
+{
+#if defined __GNUC__
+    int n = 31 - __builtin_clz((uint32_t) size);
+#else
+    int n = 0;
+    while (size >>= 1) {
+        n++;
+    }
+#endif
+    return n < BIN_COUNT ? n : BIN_COUNT - 1;
+}
+
+static NS_INLINE int lowest_bin(uint32_t bins)
+{
+#if defined __GNUC__
+    return __builtin_ctz(bins);
+#else
+    int n = 0;
+    while (!(bins & 1)) {
+        bins >>= 1;
+        n++;
+    }
+    return n;
+#endif
+}
+
+// Holes are filed by their size, so add them once their size is written
+static void hole_add(ns_mem_book_t *book, hole_t *hole)
+{
+    int bin = size_class(-*block_start_from_hole(hole));
+    ns_list_add_to_start(&book->bins[bin], hole);
+    book->bins_used |= 1U << bin;
+}
+
+// Remove holes before their size is changed
+static void hole_remove(ns_mem_book_t *book, hole_t *hole)
+{
+    int bin = size_class(-*block_start_from_hole(hole));
+    ns_list_remove(&book->bins[bin], hole);
+    if (ns_list_is_empty(&book->bins[bin])) {
+        book->bins_used &= ~(1U << bin);
+    }
+}
+
+// Find a hole of at least data_size words: the latest hole of the same size
+// class if it's big enough, or else one of the smallest larger class
+static hole_t *hole_find(ns_mem_book_t *book, ns_mem_word_size_t data_size)
+{
+    int bin = size_class(data_size);
+    hole_t *hole = ns_list_get_first(&book->bins[bin]);
+    if (bin == BIN_COUNT - 1) {
+        // Last class has no upper bound, so search it for a hole big enough
+        while (hole && -*block_start_from_hole(hole) < data_size) {
+            hole = ns_list_get_next(&book->bins[bin], hole);
+        }
+    } else if (!hole || -*block_start_from_hole(hole) < data_size) {
+        uint32_t larger_bins = book->bins_used & ~((2U << bin) - 1);
+        hole = larger_bins ? ns_list_get_first(&book->bins[lowest_bin(larger_bins)]) : NULL;
+    }
+    return hole;
+}
+#endif
+
 static void heap_failure(ns_mem_book_t *book, heap_fail_t reason)
 {
     if (book->heap_failure_callback) {
@@ -161,8 +246,16 @@ ns_mem_book_t *ns_mem_init(void *heap, ns_mem_heap_size_t h_size,
     *ptr = -(temp_int);
     book->heap_main_end[0] = ptr;
 
+#if NSDYNMEM_SEGREGATED_FREE_LISTS==1
+    for (int i = 0; i < BIN_COUNT; i++) {
+        ns_list_init(&book->bins[i]);
+    }
+    book->bins_used = 0;
+    hole_add(book, hole_from_block_start(book->heap_main[0]));
+#else
     ns_list_init(&book->holes_list);
     ns_list_add_to_start(&book->holes_list, hole_from_block_start(book->heap_main[0]));
+#endif
 
     if (info_ptr) {
         book->mem_stat_info_ptr = info_ptr;
@@ -211,8 +304,21 @@ int ns_mem_region_add(ns_mem_book_t *book, void *region_ptr, ns_mem_heap_size_t
     block_ptr += (temp_int + 1);    // now block_ptr points to end of block
     *block_ptr = -(temp_int);
 
-    // find place for the new hole from the holes list
     hole_t *hole_to_add = hole_from_block_start(region_ptr);
+#if NSDYNMEM_SEGREGATED_FREE_LISTS==1
+    if (ns_dyn_mem_region_find(book, region_ptr, 0) >= 0) {
+        // trying to add memory block that is already in the heap!
+        return -2;
+    }
+
+    // save region
+    if (ns_dyn_mem_region_save(book, region_ptr, (region_size / (sizeof(ns_mem_word_size_t))) - 1) != 0) {
+        return -3;
+    }
+
+    hole_add(book, hole_to_add);
+#else
+    // find place for the new hole from the holes list
     hole_t *previous_hole = NULL;
     ns_list_foreach(hole_t, hole_in_list_ptr, &book->holes_list) {
         if (hole_in_list_ptr < hole_to_add) {
@@ -234,6 +340,7 @@ int ns_mem_region_add(ns_mem_book_t *book, void *region_ptr, ns_mem_heap_size_t
     } else {
         ns_list_add_to_start(&book->holes_list, hole_to_add);
     }
+#endif
 
     // adjust total heap size with new hole
     book->heap_size += region_size;
@@ -382,6 +489,18 @@ static void *ns_mem_internal_alloc(ns_mem_book_t *book, const ns_mem_block_size_
         goto done;
     }
 
+#if NSDYNMEM_SEGREGATED_FREE_LISTS==1
+    hole_t *found_hole = hole_find(book, data_size);
+    if (found_hole) {
+        ns_mem_word_size_t *p = block_start_from_hole(found_hole);
+        if (ns_mem_block_validate(p) != 0 || *p >= 0) {
+            //Validation failed, or this supposed hole has positive (allocated) size
+            heap_failure(book, NS_DYN_MEM_HEAP_SECTOR_CORRUPTED);
+        } else {
+            block_ptr = p;
+        }
+    }
+#else
     // ns_list_foreach, either forwards or backwards, result to ptr
     for (hole_t *cur_hole = direction > 0 ? ns_list_get_first(&book->holes_list)
                             : ns_list_get_last(&book->holes_list);
@@ -401,11 +520,16 @@ static void *ns_mem_internal_alloc(ns_mem_book_t *book, const ns_mem_block_size_
             break;
         }
     }
+#endif
 
     if (!block_ptr) {
         goto done;
     }
 
+#if NSDYNMEM_SEGREGATED_FREE_LISTS==1
+    hole_remove(book, hole_from_block_start(block_ptr));
+#endif
+
     // Separate declaration from initialization to keep IAR happy as the gotos skip this block.
     ns_mem_word_size_t block_data_size;
     block_data_size = -*block_ptr;
@@ -415,6 +539,7 @@ static void *ns_mem_internal_alloc(ns_mem_book_t *book, const ns_mem_block_size_
         //There is enough room for a new hole so create it first
         if (direction > 0) {
             hole_ptr = block_ptr + 1 + data_size + 1;
+#if NSDYNMEM_SEGREGATED_FREE_LISTS!=1
             // Hole will be left at end of area.
             // Would like to just replace this block_ptr with new descriptor, but
             // they could overlap, so ns_list_replace might fail
@@ -426,6 +551,7 @@ static void *ns_mem_internal_alloc(ns_mem_book_t *book, const ns_mem_block_size_
             } else {
                 ns_list_add_to_start(&book->holes_list, hole_from_block_start(hole_ptr));
             }
+#endif
         } else {
             hole_ptr = block_ptr;
             // Hole remains at start of area - keep existing descriptor in place.
@@ -434,10 +560,15 @@ static void *ns_mem_internal_alloc(ns_mem_book_t *book, const ns_mem_block_size_
 
         hole_ptr[0] = -hole_size;
         hole_ptr[1 + hole_size] = -hole_size;
+#if NSDYNMEM_SEGREGATED_FREE_LISTS==1
+        hole_add(book, hole_from_block_start(hole_ptr));
+#endif
     } else {
         // Not enough room for a left-over hole, so use the whole block
         data_size = block_data_size;
+#if NSDYNMEM_SEGREGATED_FREE_LISTS!=1
         ns_list_remove(&book->holes_list, hole_from_block_start(block_ptr));
+#endif
     }
     block_ptr[0] = data_size;
     block_ptr[1 + data_size] = data_size;
@@ -547,6 +678,20 @@ static void ns_mem_free_and_merge_with_adjacent_blocks(ns_mem_book_t *book, ns_m
     }
 
     hole_t *to_add = hole_from_block_start(start);
+#if NSDYNMEM_SEGREGATED_FREE_LISTS==1
+    // Neighbour holes are filed by their old sizes, refile the merged hole
+    if (existing_start) {
+        hole_remove(book, existing_start);
+    }
+    if (existing_end) {
+        hole_remove(book, existing_end);
+    }
+    *start = -merged_data_size;
+    *end = -merged_data_size;
+    if (merged_data_size >= HOLE_T_SIZE) {
+        hole_add(book, to_add);
+    }
+#else
     hole_t *before = NULL;
     if (existing_end) {
         // Extending hole described by "existing_end" downwards.
@@ -584,6 +729,7 @@ static void ns_mem_free_and_merge_with_adjacent_blocks(ns_mem_book_t *book, ns_m
     }
     *start = -merged_data_size;
     *end = -merged_data_size;
+#endif
 }
 #endif
 
@@ -39,6 +39,14 @@ int8_t ns_dyn_mem_tracker_lib_alloc(ns_dyn_mem_tracker_lib_conf_t *conf, void *c
 
     platform_enter_critical();
 
+    if (conf->size_histogram != NULL && conf->size_histogram_count > 0) {
+        uint16_t size_class = 0;
+        while ((alloc_size >> size_class) > 1 && size_class < conf->size_histogram_count - 1) {
+            size_class++;
+        }
+        conf->size_histogram[size_class]++;
+    }
+
     // If dynamic memory blocks are not set, calls allocator
     if (conf->mem_blocks == NULL) {
         conf->mem_blocks = conf->alloc_mem_blocks(conf->mem_blocks, &conf->mem_blocks_count);
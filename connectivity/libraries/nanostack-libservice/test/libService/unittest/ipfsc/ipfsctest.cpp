@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2021 ARM Limited. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "CppUTest/TestHarness.h"
+#include "ip_fsc.h"
+#include "common_functions.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+// Plain 16 bits at a time sum, as the checksum is defined
+static uint16_t reference_fcf(const uint8_t *data, uint16_t length)
+{
+    uint32_t acc = 0;
+    for (uint16_t i = 0; i < length; i++) {
+        acc += (i & 1) ? data[i] : data[i] << 8;
+    }
+    while (acc >> 16) {
+        acc = (acc >> 16) + (acc & 0xffff);
+    }
+    return ~acc;
+}
+
+TEST_GROUP(ipfsc)
+{
+    void setup() {
+    }
+
+    void teardown() {
+    }
+};
+
+TEST(ipfsc, rfc1071_example)
+{
+    uint8_t data[] = { 0x00, 0x01, 0xf2, 0x03, 0xf4, 0xf5, 0xf6, 0xf7 };
+    ns_iovec_t vec = { data, sizeof data };
+    CHECK(ip_fcf_v(1, &vec) == (uint16_t) ~0xddf2);
+}
+
+TEST(ipfsc, alignments_and_lengths)
+{
+    uint8_t buffer[300];
+    for (unsigned i = 0; i < sizeof buffer; i++) {
+        buffer[i] = rand();
+    }
+    for (unsigned offset = 0; offset < 8; offset++) {
+        for (uint16_t length = 0; length < 260; length++) {
+            ns_iovec_t vec = { buffer + offset, length };
+            CHECK(ip_fcf_v(1, &vec) == reference_fcf(buffer + offset, length));
+        }
+    }
+}
+
+TEST(ipfsc, gather_list_with_odd_lengths)
+{
+    uint8_t flat[100];
+    uint8_t buffer[120];
+    for (unsigned i = 0; i < sizeof buffer; i++) {
+        buffer[i] = rand();
+    }
+    // Split the data in pieces of odd lengths at odd addresses
+    ns_iovec_t vec[4] = {
+        { buffer + 1, 7 },
+        { buffer + 10, 33 },
+        { buffer + 45, 1 },
+        { buffer + 51, 59 },
+    };
+    uint16_t length = 0;
+    for (int i = 0; i < 4; i++) {
+        memcpy(flat + length, vec[i].iov_base, vec[i].iov_len);
+        length += vec[i].iov_len;
+    }
+    CHECK(ip_fcf_v(4, vec) == reference_fcf(flat, length));
+}
+
+TEST(ipfsc, valid_checksum_sums_to_zero)
+{
+    uint8_t src[16] = { 0xfe, 0x80, 0, 0, 0, 0, 0, 0, 0x02, 0x11, 0x22, 0xff, 0xfe, 0x33, 0x44, 0x55 };
+    uint8_t dst[16] = { 0xff, 0x02, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0x01 };
+    uint8_t icmp[13] = { 0x80, 0x00, 0x00, 0x00, 0x12, 0x34, 0x00, 0x01, 'h', 'e', 'l', 'l', 'o' };
+    common_write_16_bit(ipv6_fcf(src, dst, sizeof icmp, icmp, NEXT_HEADER_ICMP6), icmp + 2);
+    CHECK(ipv6_fcf(src, dst, sizeof icmp, icmp, NEXT_HEADER_ICMP6) == 0);
+}
+
+TEST(ipfsc, update_matches_recomputed)
+{
+    uint8_t data[40];
+    for (unsigned i = 0; i < sizeof data; i++) {
+        data[i] = rand();
+    }
+    ns_iovec_t vec = { data, sizeof data };
+    for (int i = 0; i < 100; i++) {
+        uint16_t checksum = ip_fcf_v(1, &vec);
+        uint8_t *field = data + (rand() % (sizeof data / 2)) * 2;
+        uint16_t old_value = common_read_16_bit(field);
+        uint16_t new_value = rand();
+        common_write_16_bit(new_value, field);
+        uint16_t updated = ip_fcf_update(checksum, old_value, new_value);
+        uint16_t recomputed = ip_fcf_v(1, &vec);
+        // Both forms of zero are valid one's complement results
+        CHECK(updated == recomputed || ((updated == 0 || updated == 0xffff) && (recomputed == 0 || recomputed == 0xffff)));
+    }
+}
@@ -227,6 +227,15 @@
 #define PPP_FCS_TABLE                   1
 #endif
 
+/**
+ * PPPOS_INPUT_BUFSIZE: Size of the buffer serial data is read into before
+ * being passed to pppos_input(). Larger reads let the deframer copy longer
+ * runs of data at a time. The buffer is on the PPP thread stack.
+ */
+#ifndef PPPOS_INPUT_BUFSIZE
+#define PPPOS_INPUT_BUFSIZE             64
+#endif
+
 /**
  * PAP_SUPPORT==1: Support PAP.
  */
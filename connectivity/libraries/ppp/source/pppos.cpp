@@ -64,6 +64,7 @@ static void pppos_input_callback(void *arg);
 static void pppos_input_free_current_packet(pppos_pcb *pppos);
 static void pppos_input_drop(pppos_pcb *pppos);
 static err_t pppos_output_append(pppos_pcb *pppos, err_t err, struct pbuf *nb, u8_t c, u8_t accm, u16_t *fcs);
+static err_t pppos_output_append_block(pppos_pcb *pppos, err_t err, struct pbuf *nb, const u8_t *s, u16_t n, u16_t *fcs);
 static err_t pppos_output_last(pppos_pcb *pppos, err_t err, struct pbuf *nb, u16_t *fcs);
 
 /* Callbacks structure for PPP core */
@@ -140,6 +141,47 @@ ppp_get_fcs(u8_t byte)
 #define PPP_FCS(fcs, c) (((fcs) >> 8) ^ ppp_get_fcs(((fcs) ^ (c)) & 0xff))
 #endif /* PPP_FCS_TABLE */
 
+/* Word at a time test for octets the ACCM can select: control characters,
+ * PPP_ESCAPE and PPP_FLAG. It may report octets that do not need escaping,
+ * but never misses one that does. */
+#define PPPOS_ONES                  0x01010101UL
+#define PPPOS_HAS_ZERO(w)           (((w) - PPPOS_ONES) & ~(w) & (PPPOS_ONES * 0x80))
+#define PPPOS_HAS_LESS(w, n)        (((w) - PPPOS_ONES * (n)) & ~(w) & (PPPOS_ONES * 0x80))
+#define PPPOS_HAS_BYTE(w, c)        PPPOS_HAS_ZERO((w) ^ (PPPOS_ONES * (c)))
+
+/*
+ * pppos_clear_run - number of octets at s, up to l, that need no escaping
+ * with the given ACCM.
+ */
+static int
+pppos_clear_run(const u8_t *accm, const u8_t *s, int l)
+{
+  const bool ctrl = accm[0] | accm[1] | accm[2] | accm[3];
+  int n = 0;
+
+  while (l - n >= (int)sizeof(u32_t)) {
+    u32_t w;
+    memcpy(&w, s + n, sizeof w);
+    if (PPPOS_HAS_BYTE(w, PPP_FLAG) || PPPOS_HAS_BYTE(w, PPP_ESCAPE) || (ctrl && PPPOS_HAS_LESS(w, PPP_TRANS))) {
+      break;
+    }
+    n += sizeof(u32_t);
+  }
+  while (n < l && !ESCAPE_P(accm, s[n])) {
+    n++;
+  }
+  return n;
+}
+
+static u16_t
+pppos_fcs_block(u16_t fcs, const u8_t *s, int l)
+{
+  while (l-- > 0) {
+    fcs = PPP_FCS(fcs, *s++);
+  }
+  return fcs;
+}
+
 /*
  * Values for FCS calculations.
  */
@@ -220,10 +262,7 @@ pppos_write(ppp_pcb *ppp, void *ctx, struct pbuf *p)
   fcs_out = PPP_INITFCS;
   s = (u8_t*)p->payload;
   n = p->len;
-
-  while (n-- > 0) {
-    err = pppos_output_append(pppos, err,  nb, *s++, 1, &fcs_out);
-  }
+  err = pppos_output_append_block(pppos, err, nb, s, n, &fcs_out);
 
   err = pppos_output_last(pppos, err, nb, &fcs_out);
   if (err == ERR_OK) {
@@ -289,9 +328,7 @@ pppos_netif_output(ppp_pcb *ppp, void *ctx, struct pbuf *pb, u16_t protocol)
       u16_t n = mem_mngr->get_len(p);
       u8_t *s = (u8_t*) mem_mngr->get_ptr(p);
 
-      while (n-- > 0) {
-        err = pppos_output_append(pppos, err, nb, *s++, 1, &fcs_out);
-      }
+      err = pppos_output_append_block(pppos, err, nb, s, n, &fcs_out);
   }
 
   err = pppos_output_last(pppos, err, nb, &fcs_out);
@@ -492,6 +529,22 @@ pppos_input(ppp_pcb *ppp, u8_t *s, int l)
       return;
     }
     escaped = ESCAPE_P(pppos->in_accm, cur_char);
+
+    /* Data octets that need no unescaping go straight into the current pbuf,
+     * a run at a time, up to the next special character or the end of the pbuf. */
+    if (!escaped && !pppos->in_escaped && pppos->in_state == PDDATA && pppos->in_tail != NULL
+        && pppos->in_tail->len < pppos->in_tail->tot_len) {
+      int room = pppos->in_tail->tot_len - pppos->in_tail->len;
+      int run = 1 + pppos_clear_run(pppos->in_accm, s, (l < room - 1) ? l : room - 1);
+      PPPOS_UNPROTECT(lev);
+
+      memcpy((u8_t*)pppos->in_tail->payload + pppos->in_tail->len, s - 1, run);
+      pppos->in_tail->len += run;
+      pppos->in_fcs = pppos_fcs_block(pppos->in_fcs, s - 1, run);
+      s += run - 1;
+      l -= run - 1;
+      continue;
+    }
     PPPOS_UNPROTECT(lev);
     /* Handle special characters. */
     if (escaped) {
@@ -856,6 +909,34 @@ pppos_output_append(pppos_pcb *pppos, err_t err, struct pbuf *nb, u8_t c, u8_t a
   return ERR_OK;
 }
 
+/*
+ * pppos_output_append_block - append n data characters to the pbuf, updating
+ * the FCS. Runs of characters that need no escaping are copied in one go,
+ * others go through pppos_output_append().
+ */
+static err_t
+pppos_output_append_block(pppos_pcb *pppos, err_t err, struct pbuf *nb, const u8_t *s, u16_t n, u16_t *fcs)
+{
+  while (err == ERR_OK && n > 0) {
+    int room = nb->tot_len - nb->len;
+    int run = (room < 2) ? 0 : pppos_clear_run(pppos->out_accm, s, (n < room) ? n : room);
+
+    if (run == 0) {
+      err = pppos_output_append(pppos, err, nb, *s++, 1, fcs);
+      n--;
+      continue;
+    }
+
+    memcpy((u8_t*)nb->payload + nb->len, s, run);
+    nb->len += run;
+    *fcs = pppos_fcs_block(*fcs, s, run);
+    s += run;
+    n -= run;
+  }
+
+  return err;
+}
+
 static err_t
 pppos_output_last(pppos_pcb *pppos, err_t err, struct pbuf *nb, u16_t *fcs)
 {
@@ -198,6 +198,38 @@ public:
      */
     lorawan_status_t disconnect();
 
+    /** Keep the session across resets.
+     *
+     * Once connected, the device address, session keys and frame counters are
+     * written to the given KVStore, for example a TDBStore. A later connect()
+     * with the same credentials then resumes the session without a new join,
+     * or for ABP, continues from the stored frame counters.
+     *
+     * To spare the flash, the uplink frame counter is not written on every
+     * uplink. Each write reserves the next MBED_CONF_LORA_SESSION_COUNTER_RESERVE
+     * counters, and after a reset the device continues after them. disconnect()
+     * stores the exact counter. As the store holds the session keys, a
+     * SecureStore is preferable.
+     *
+     * If the network no longer knows the session, the application must call
+     * remove_stored_session() and connect again to join.
+     *
+     * @param store     KVStore to hold the session, or NULL to stop storing it.
+     *
+     * @return          LORAWAN_STATUS_OK on success, or a negative error code on failure:
+     *                  LORAWAN_STATUS_BUSY if a connection is in progress or established.
+     */
+    lorawan_status_t set_session_store(mbed::KVStore *store);
+
+    /** Remove the session kept with set_session_store(), so that the next
+     *  connect() joins the network again.
+     *
+     * @return          LORAWAN_STATUS_OK on success, or a negative error code on failure:
+     *                  LORAWAN_STATUS_NO_OP if there is no session store or it failed,
+     *                  LORAWAN_STATUS_BUSY if a connection is in progress or established.
+     */
+    lorawan_status_t remove_stored_session();
+
     /** Validate the connectivity with the network.
      *
      * Application may use this API to submit a request to the stack for validation of its connectivity
@@ -410,6 +442,42 @@ public:
      */
     int16_t send(uint8_t port, const uint8_t *data, uint16_t length, int flags);
 
+    /** Queue a message to gateway
+     *
+     * Unlike send(), the message does not have to wait for the previous one to
+     * complete: it is copied into a queue of MBED_CONF_LORA_UPLINK_QUEUE_SIZE
+     * messages and sent as soon as the messages ahead of it are done and the
+     * duty cycle allows. A TX_DONE, TX_ERROR, TX_TIMEOUT or TX_SCHEDULING_ERROR
+     * event is sent for each frame.
+     *
+     * @param port          The application port number, see send().
+     *
+     * @param data          A pointer to the data being sent. The data is copied to the queue.
+     *
+     * @param length        The size of data in bytes, at most MBED_CONF_LORA_UPLINK_QUEUE_ENTRY_SIZE.
+     *
+     * @param flags         The type of message, see send().
+     *
+     * @param priority      Messages with a higher priority are sent first, messages
+     *                      of the same priority in the order they were queued.
+     *
+     * @param aggregate     Allow sending the message in the same frame as other
+     *                      messages of the same port, flags and priority queued
+     *                      with aggregate set, when they fit into one frame. The
+     *                      payloads are concatenated, so the application on the
+     *                      network side has to be able to split them.
+     *
+     * @return              The number of bytes sent or queued, or a negative error code on failure:
+     *                      LORAWAN_STATUS_NOT_INITIALIZED   if system is not initialized with initialize(),
+     *                      LORAWAN_STATUS_NO_ACTIVE_SESSIONS if connection is not open,
+     *                      LORAWAN_STATUS_WOULD_BLOCK       if the queue is full,
+     *                      LORAWAN_STATUS_PORT_INVALID      if trying to send to an invalid port (e.g. to 0)
+     *                      LORAWAN_STATUS_LENGTH_ERROR      if the message is too large for the queue,
+     *                      LORAWAN_STATUS_PARAMETER_INVALID if NULL data pointer is given or flags are invalid.
+     */
+    int16_t queue_send(uint8_t port, const uint8_t *data, uint16_t length, int flags,
+                       uint8_t priority = 0, bool aggregate = false);
+
     /** Receives a message from the Network Server on a specific port.
      *
      * @param port          The application port number. Port numbers 0 and 224 are reserved,
@@ -590,6 +658,7 @@ public:
      * the system can cancel the outstanding outgoing packet. Otherwise, the system is
      * busy sending and can't be held back. The system will not try to resend if the
      * outgoing message was a CONFIRMED message even if the ack is not received.
+     * Messages waiting in the queue of queue_send() are dropped.
      *
      * @return              LORAWAN_STATUS_OK if the sending is canceled, otherwise
      *                      other negative error code if request failed:
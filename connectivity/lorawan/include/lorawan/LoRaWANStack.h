@@ -52,6 +52,39 @@
 #include "system/lorawan_data_structures.h"
 #include "LoRaRadio.h"
 
+/**
+ * Number of messages the uplink queue holds, see LoRaWANStack::handle_queued_tx()
+ */
+#ifndef MBED_CONF_LORA_UPLINK_QUEUE_SIZE
+#define MBED_CONF_LORA_UPLINK_QUEUE_SIZE        4
+#endif
+
+/**
+ * Largest message, or aggregate of messages, held by one queue entry
+ */
+#ifndef MBED_CONF_LORA_UPLINK_QUEUE_ENTRY_SIZE
+#define MBED_CONF_LORA_UPLINK_QUEUE_ENTRY_SIZE  51
+#endif
+
+/**
+ * Uplink frame counters covered by each write of the stored session, see
+ * LoRaWANStack::set_session_store()
+ */
+#ifndef MBED_CONF_LORA_SESSION_COUNTER_RESERVE
+#define MBED_CONF_LORA_SESSION_COUNTER_RESERVE  32
+#endif
+
+/**
+ * Key of the stored session in the KVStore
+ */
+#ifndef MBED_CONF_LORA_SESSION_STORE_KEY
+#define MBED_CONF_LORA_SESSION_STORE_KEY        "lora_session"
+#endif
+
+namespace mbed {
+class KVStore;
+}
+
 class LoRaPHY;
 
 /** LoRaWANStack Class
@@ -90,6 +123,38 @@ public:
      */
     lorawan_status_t set_lora_callbacks(const lorawan_app_callbacks_t *callbacks);
 
+    /** Keep the session across resets in a KVStore
+     *
+     * Once connected, the session is written to the store: device address,
+     * session keys and frame counters. A later connect() with the same
+     * credentials resumes it instead of joining again, or for ABP restores
+     * the frame counters.
+     *
+     * Rather than writing on every uplink, each write reserves the next
+     * MBED_CONF_LORA_SESSION_COUNTER_RESERVE uplink frame counters, and
+     * stores the counter following them. After a reset the uplink counter
+     * resumes there, skipping the unused part of the reservation, so a
+     * frame counter is never sent twice. shutdown() stores the exact
+     * counter.
+     *
+     * The store holds the session keys, a SecureStore keeps them confidential.
+     *
+     * @param store     KVStore to hold the session, e.g. a TDBStore, or
+     *                  NULL to stop storing the session.
+     *
+     * @return          LORAWAN_STATUS_OK on success,
+     *                  LORAWAN_STATUS_BUSY if a connection is in progress or established.
+     */
+    lorawan_status_t set_session_store(mbed::KVStore *store);
+
+    /** Remove the stored session, the next connect() joins again
+     *
+     * @return          LORAWAN_STATUS_OK on success,
+     *                  LORAWAN_STATUS_NO_OP if there is no session store,
+     *                  LORAWAN_STATUS_BUSY if a connection is in progress or established.
+     */
+    lorawan_status_t remove_stored_session();
+
     /** Connect OTAA or ABP using Mbed-OS config system
      *
      * @return    For ABP:  If everything goes well, LORAWAN_STATUS_OK is returned for first call followed by
@@ -244,6 +309,41 @@ public:
                       uint16_t length, uint8_t flags,
                       bool null_allowed = false, bool allow_port_0 = false);
 
+    /** Queue a message to the gateway
+     *
+     * Sends the message right away if nothing is queued or ongoing, like
+     * handle_tx(). Otherwise the message is copied into the uplink queue and
+     * sent once the messages ahead of it are done, in the order of priority
+     * and then of queueing. The link layer then picks the first channel whose
+     * band is out of its duty-cycle time-off, and waits for the earliest one
+     * if none is.
+     *
+     * @param port              The application port number, see handle_tx().
+     *
+     * @param data              A pointer to the data being sent. The data is
+     *                          copied.
+     *
+     * @param length            The size of data in bytes, at most
+     *                          MBED_CONF_LORA_UPLINK_QUEUE_ENTRY_SIZE.
+     *
+     * @param flags             The type of message, see handle_tx().
+     *
+     * @param priority          Messages with a higher priority are sent first.
+     *
+     * @param aggregate         Allow appending the message to a queued message
+     *                          of the same port, flags and priority, which
+     *                          also allowed it, as long as both fit into one
+     *                          frame at the current data rate. The receiver
+     *                          has to be able to split the payloads.
+     *
+     * @return                  The number of bytes sent or queued, or
+     *                          LORAWAN_STATUS_WOULD_BLOCK if the queue is
+     *                          full, or a negative error code on failure.
+     */
+    int16_t handle_queued_tx(uint8_t port, const uint8_t *data,
+                             uint16_t length, uint8_t flags,
+                             uint8_t priority, bool aggregate);
+
     /** Receives a message from the Network Server.
      *
      * @param data              A pointer to buffer where the received data will be
@@ -389,7 +489,8 @@ public:
     /** Stops sending
      *
      * Stop sending any outstanding messages if they are not yet queued for
-     * transmission, i.e., if the backoff timer is nhot elapsed yet.
+     * transmission, i.e., if the backoff timer is nhot elapsed yet. Messages
+     * in the uplink queue are dropped as well.
      *
      * @return               LORAWAN_STATUS_OK if the transmission is cancelled.
      *                       LORAWAN_STATUS_BUSY otherwise.
@@ -566,6 +667,12 @@ private:
      */
     lorawan_status_t handle_connect(bool is_otaa);
 
+    /**
+     * Session persistence, see set_session_store()
+     */
+    bool restore_session(bool is_otaa);
+    void store_session(uint32_t ul_frame_counter);
+
 
     /** Send event to application.
      *
@@ -621,6 +728,22 @@ private:
 
     void process_beacon_event(loramac_beacon_status_t status, const loramac_beacon_t *beacon);
 
+    /**
+     * Uplink queue handling
+     */
+    void schedule_queued_uplink(void);
+    void send_queued_uplink(void);
+    void drop_queued_uplink(uint8_t index);
+
+    typedef struct {
+        uint8_t port;
+        uint8_t flags;
+        uint8_t priority;
+        bool aggregate;
+        uint16_t length;
+        uint8_t data[MBED_CONF_LORA_UPLINK_QUEUE_ENTRY_SIZE];
+    } uplink_queue_entry_t;
+
 private:
     LoRaMac _loramac;
 
@@ -664,6 +787,14 @@ private:
     bool _ping_slot_info_requested;
     bool _device_time_requested;
     lorawan_time_t _last_beacon_rx_time;
+
+    // sorted by priority, the next message to send first
+    uplink_queue_entry_t _uplink_queue[MBED_CONF_LORA_UPLINK_QUEUE_SIZE];
+    uint8_t _uplink_queue_count;
+
+    mbed::KVStore *_session_store;
+    // uplink frame counter the stored session resumes at
+    uint32_t _session_ul_limit;
 };
 
 #endif /* LORAWANSTACK_H_ */
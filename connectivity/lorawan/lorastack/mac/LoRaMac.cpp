@@ -116,7 +116,12 @@ LoRaMac::LoRaMac()
       _device_class(CLASS_A),
       _prev_qos_level(LORAWAN_DEFAULT_QOS),
       _demod_ongoing(false),
-      _mod_ongoing(false)
+      _mod_ongoing(false),
+      _rx_window1_scheduled(0),
+      _rx_window2_scheduled(0),
+      _rx_wakeup_latency(0),
+      _rx_wakeup_deviation(0),
+      _rx_wakeup_samples(0)
 {
     _params.rejoin_forced = false;
     _params.forced_datarate = DR_0;
@@ -796,12 +801,12 @@ void LoRaMac::on_radio_tx_done(lorawan_time_t timestamp)
     if (_params.is_rx_window_enabled == true) {
         lorawan_time_t time_diff = _lora_time.get_current_time() - timestamp;
         // start timer after which rx1_window will get opened
-        _lora_time.start(_params.timers.rx_window1_timer,
-                         _params.rx_window1_delay - time_diff);
+        _rx_window1_scheduled = start_rx_window_timer(_params.timers.rx_window1_timer,
+                                                      _params.rx_window1_delay - time_diff);
 
         // start timer after which rx2_window will get opened
-        _lora_time.start(_params.timers.rx_window2_timer,
-                         _params.rx_window2_delay - time_diff);
+        _rx_window2_scheduled = start_rx_window_timer(_params.timers.rx_window2_timer,
+                                                      _params.rx_window2_delay - time_diff);
 
         // If class C and an Unconfirmed messgae is outgoing,
         // this will start a timer which will invoke rx2 would be
@@ -1051,6 +1056,77 @@ void LoRaMac::on_backoff_timer_expiry(void)
     }
 }
 
+lorawan_time_t LoRaMac::start_rx_window_timer(timer_event_t &timer, uint32_t delay)
+{
+    const lorawan_time_t scheduled_time = _lora_time.get_current_time() + delay;
+#if MBED_CONF_LORA_RX_WAKEUP_CALIBRATION
+    uint32_t compensation = MIN((uint32_t)(_rx_wakeup_latency >> 3),
+                                (uint32_t) MBED_CONF_LORA_RX_WAKEUP_COMPENSATION_MAX);
+    delay = (delay > compensation) ? delay - compensation : 0;
+#endif
+    _lora_time.start(timer, delay);
+    return scheduled_time;
+}
+
+void LoRaMac::calibrate_rx_wakeup(lorawan_time_t scheduled_time)
+{
+#if MBED_CONF_LORA_RX_WAKEUP_CALIBRATION
+    const uint32_t compensation = MIN((uint32_t)(_rx_wakeup_latency >> 3),
+                                      (uint32_t) MBED_CONF_LORA_RX_WAKEUP_COMPENSATION_MAX);
+    // the timer was started early by the compensation, so the latency of
+    // the queue is how late it ran relative to that earlier time
+    int32_t sample = (int32_t)(_lora_time.get_current_time() - scheduled_time) + compensation;
+    if (sample < 0) {
+        sample = 0;
+    }
+    sample = MIN(sample, (int32_t) MBED_CONF_LORA_RX_WAKEUP_COMPENSATION_MAX);
+
+    if (_rx_wakeup_samples == 0) {
+        _rx_wakeup_latency = sample << 3;
+        _rx_wakeup_deviation = sample << 2;
+    } else {
+        int32_t error = (sample << 3) - _rx_wakeup_latency;
+        _rx_wakeup_latency += error >> 3;
+        if (error < 0) {
+            error = -error;
+        }
+        _rx_wakeup_deviation += (error - _rx_wakeup_deviation) >> 2;
+    }
+
+    if (_rx_wakeup_samples < UINT8_MAX) {
+        _rx_wakeup_samples++;
+    }
+#else
+    (void) scheduled_time;
+#endif
+}
+
+uint32_t LoRaMac::get_rx_timing_error(void)
+{
+#if MBED_CONF_LORA_RX_WAKEUP_CALIBRATION
+    // The latency is compensated for, what remains is its variation. Until a
+    // few windows were measured, keep to the configured worst case.
+    if (_rx_wakeup_samples >= 4) {
+        // 1 ms for the tick granularity, plus 4 mean deviations
+        return MIN(1 + (uint32_t)(_rx_wakeup_deviation >> 1),
+                   (uint32_t) MBED_CONF_LORA_MAX_SYS_RX_ERROR);
+    }
+#endif
+    return MBED_CONF_LORA_MAX_SYS_RX_ERROR;
+}
+
+void LoRaMac::on_rx_window1_timer_expiry(void)
+{
+    calibrate_rx_wakeup(_rx_window1_scheduled);
+    open_rx1_window();
+}
+
+void LoRaMac::on_rx_window2_timer_expiry(void)
+{
+    calibrate_rx_wakeup(_rx_window2_scheduled);
+    open_rx2_window();
+}
+
 void LoRaMac::open_rx1_window(void)
 {
     if (!set_rx_slot(RX_SLOT_WIN_1)) {
@@ -1393,14 +1469,14 @@ lorawan_status_t LoRaMac::schedule_tx()
     tr_debug("TX: Channel=%d, TX DR=%d, RX1 DR=%d",
              _params.channel, _params.sys_params.channel_data_rate, rx1_dr);
 
+    const uint32_t rx_error = get_rx_timing_error();
+
     _lora_phy->compute_rx_win_params(rx1_dr, MBED_CONF_LORA_DOWNLINK_PREAMBLE_LENGTH,
-                                     MBED_CONF_LORA_MAX_SYS_RX_ERROR,
-                                     &_params.rx_window1_config);
+                                     rx_error, &_params.rx_window1_config);
 
     _lora_phy->compute_rx_win_params(_params.sys_params.rx2_channel.datarate,
                                      MBED_CONF_LORA_DOWNLINK_PREAMBLE_LENGTH,
-                                     MBED_CONF_LORA_MAX_SYS_RX_ERROR,
-                                     &_params.rx_window2_config);
+                                     rx_error, &_params.rx_window2_config);
 
     if (mac_hdr.bits.mtype == FRAME_TYPE_JOIN_REQ || mac_hdr.bits.mtype == FRAME_TYPE_REJOIN_REQUEST) {
         _params.rx_window1_delay = _params.sys_params.join_accept_delay1
@@ -1927,6 +2003,62 @@ lorawan_status_t LoRaMac::join(bool is_otaa)
     return send_join_request();
 }
 
+void LoRaMac::get_session(loramac_session_t &session, bool is_otaa)
+{
+    memset(&session, 0, sizeof(session));
+    session.is_otaa = is_otaa;
+    if (is_otaa && _params.dev_eui) {
+        memcpy(session.dev_eui, _params.dev_eui, sizeof(session.dev_eui));
+    }
+    session.net_id = _params.net_id;
+    session.dev_addr = _params.dev_addr;
+    session.ul_frame_counter = _params.ul_frame_counter;
+    session.dl_frame_counter = _params.dl_frame_counter;
+    session.app_dl_frame_counter = _params.app_dl_frame_counter;
+    session.recv_delay1 = _params.sys_params.recv_delay1;
+    session.rx1_dr_offset = _params.sys_params.rx1_dr_offset;
+    session.rx2_datarate = _params.sys_params.rx2_channel.datarate;
+    session.server_type = _params.server_type;
+    _lora_crypto.get_session_keys(session);
+}
+
+lorawan_status_t LoRaMac::restore_session(const loramac_session_t &session, bool is_otaa)
+{
+    if (session.is_otaa != is_otaa) {
+        return LORAWAN_STATUS_PARAMETER_INVALID;
+    }
+
+    if (is_otaa) {
+        // The session must have been joined with the DevEUI being connected
+        if (!_params.dev_eui || memcmp(session.dev_eui, _params.dev_eui, sizeof(session.dev_eui)) != 0) {
+            return LORAWAN_STATUS_PARAMETER_INVALID;
+        }
+
+        _params.net_id = session.net_id;
+        _params.dev_addr = session.dev_addr;
+        _params.server_type = (server_type_t) session.server_type;
+        _params.sys_params.recv_delay1 = session.recv_delay1;
+        _params.sys_params.recv_delay2 = session.recv_delay1 + 1000;
+        _params.sys_params.rx1_dr_offset = session.rx1_dr_offset;
+        _params.sys_params.rx2_channel.datarate = session.rx2_datarate;
+        _lora_crypto.set_session_keys(session);
+    } else if (session.dev_addr != _params.dev_addr) {
+        // ABP keys come from the credentials, only the counters are restored
+        return LORAWAN_STATUS_PARAMETER_INVALID;
+    }
+
+    _params.ul_frame_counter = session.ul_frame_counter;
+    _params.dl_frame_counter = session.dl_frame_counter;
+    _params.app_dl_frame_counter = session.app_dl_frame_counter;
+
+    return LORAWAN_STATUS_OK;
+}
+
+uint32_t LoRaMac::get_ul_frame_counter() const
+{
+    return _params.ul_frame_counter;
+}
+
 lorawan_status_t LoRaMac::rejoin(join_req_type_t rejoin_type, bool is_forced, uint8_t datarate)
 {
     _params.join_request_type = rejoin_type;
@@ -2246,9 +2378,9 @@ lorawan_status_t LoRaMac::initialize(EventQueue *queue,
     _lora_time.init(_params.timers.backoff_timer,
                     mbed::callback(this, &LoRaMac::on_backoff_timer_expiry));
     _lora_time.init(_params.timers.rx_window1_timer,
-                    mbed::callback(this, &LoRaMac::open_rx1_window));
+                    mbed::callback(this, &LoRaMac::on_rx_window1_timer_expiry));
     _lora_time.init(_params.timers.rx_window2_timer,
-                    mbed::callback(this, &LoRaMac::open_rx2_window));
+                    mbed::callback(this, &LoRaMac::on_rx_window2_timer_expiry));
     _lora_time.init(_params.timers.ack_timeout_timer,
                     mbed::callback(this, &LoRaMac::on_ack_timeout_timer_event));
 
@@ -2316,6 +2448,20 @@ uint8_t LoRaMac::get_max_possible_tx_size(uint8_t fopts_len)
     return max_possible_payload_size;
 }
 
+uint8_t LoRaMac::get_max_tx_payload_size()
+{
+    uint16_t fopts_len = _mac_commands.get_mac_cmd_length()
+                         + _mac_commands.get_repeat_commands_length();
+    uint16_t allowed_frm_payload_size = _lora_phy->get_max_payload(_params.sys_params.channel_data_rate,
+                                                                   _params.is_repeater_supported);
+
+    if (allowed_frm_payload_size > MBED_CONF_LORA_TX_MAX_SIZE) {
+        allowed_frm_payload_size = MBED_CONF_LORA_TX_MAX_SIZE;
+    }
+
+    return (allowed_frm_payload_size > fopts_len) ? allowed_frm_payload_size - fopts_len : 0;
+}
+
 bool LoRaMac::nwk_joined()
 {
     return _is_nwk_joined;
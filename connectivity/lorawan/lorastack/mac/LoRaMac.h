@@ -56,6 +56,22 @@
 
 #include "platform/ScopedLock.h"
 
+/**
+ * Enables measuring how late the EventQueue runs the RX window timers, so that
+ * the timers can be started that much earlier and the windows sized for the
+ * measured timing error instead of MBED_CONF_LORA_MAX_SYS_RX_ERROR.
+ */
+#ifndef MBED_CONF_LORA_RX_WAKEUP_CALIBRATION
+#define MBED_CONF_LORA_RX_WAKEUP_CALIBRATION    1
+#endif
+
+/**
+ * Upper bound, in ms, of the early start applied to the RX window timers.
+ */
+#ifndef MBED_CONF_LORA_RX_WAKEUP_COMPENSATION_MAX
+#define MBED_CONF_LORA_RX_WAKEUP_COMPENSATION_MAX   30
+#endif
+
 /** LoRaMac Class
  * Implementation of LoRaWAN MAC layer
  */
@@ -277,6 +293,14 @@ public:
      */
     void set_tx_ongoing(bool ongoing);
 
+    /**
+     * @brief get_max_tx_payload_size Gets the largest FRMPayload the next
+     *        frame can carry at the current data rate, next to the MAC
+     *        commands already pending.
+     * @return Size in bytes.
+     */
+    uint8_t get_max_tx_payload_size();
+
     /**
      * @brief reset_ongoing_tx Resets _ongoing_tx_msg.
      * @param reset_pending If true resets pending size also.
@@ -424,6 +448,34 @@ public:
      */
     bool continue_sending_process(void);
 
+    /**
+     * @brief get_session Copy out the state of the current session
+     *
+     * @param session   [out]   Session to fill in
+     * @param is_otaa   [in]    True if the session was established with OTAA
+     */
+    void get_session(loramac_session_t &session, bool is_otaa);
+
+    /**
+     * @brief restore_session Restore a session saved with get_session()
+     *
+     * @details Must be called after prepare_join(), with the credentials
+     *          the session was established with. The device is joined
+     *          with join(false) afterwards, as for ABP.
+     *
+     * @param session   [in]    Session to restore
+     * @param is_otaa   [in]    True if the credentials given to prepare_join() are OTAA
+     *
+     * @return  LORAWAN_STATUS_OK on success, LORAWAN_STATUS_PARAMETER_INVALID
+     *          if the session belongs to other credentials
+     */
+    lorawan_status_t restore_session(const loramac_session_t &session, bool is_otaa);
+
+    /**
+     * @brief get_ul_frame_counter Counter of the next uplink frame
+     */
+    uint32_t get_ul_frame_counter() const;
+
     /**
      * Read-only access to MAC primitive blocks
      */
@@ -628,6 +680,32 @@ private:
      */
     void on_backoff_timer_expiry(void);
 
+    /**
+     * Callback functions to be executed when the RX window timers expire.
+     * They record how late the timer ran and open the window.
+     */
+    void on_rx_window1_timer_expiry(void);
+    void on_rx_window2_timer_expiry(void);
+
+    /**
+     * Feeds the wake-up latency estimate with the lateness of a timer.
+     *
+     * @param scheduled_time    Time at which the timer was due.
+     */
+    void calibrate_rx_wakeup(lorawan_time_t scheduled_time);
+
+    /**
+     * Gets the timing error, in ms, the RX1 and RX2 windows are sized for.
+     */
+    uint32_t get_rx_timing_error(void);
+
+    /**
+     * Starts an RX window timer early by the measured wake-up latency.
+     *
+     * @return Time at which the timer is due.
+     */
+    lorawan_time_t start_rx_window_timer(timer_event_t &timer, uint32_t delay);
+
     /**
      * At the end of an RX1 window timer, an RX1 window is opened using this method.
      */
@@ -820,6 +898,16 @@ private:
     bool _demod_ongoing;
 
     bool _mod_ongoing;
+
+    /**
+     * RX window timer calibration. Latency and its mean deviation are kept
+     * in 1/8 ms, the same way TCP smooths its round-trip time.
+     */
+    lorawan_time_t _rx_window1_scheduled;
+    lorawan_time_t _rx_window2_scheduled;
+    uint16_t _rx_wakeup_latency;
+    uint16_t _rx_wakeup_deviation;
+    uint8_t _rx_wakeup_samples;
 };
 
 #endif // MBED_LORAWAN_MAC_H__
@@ -38,7 +38,7 @@
  */
 #define APPKEY_KEY_LENGTH                           128
 
-LoRaMacCrypto::LoRaMacCrypto() : _dev_addr(0)
+LoRaMacCrypto::LoRaMacCrypto() : _aes_next_slot(0), _cmac_next_slot(0), _dev_addr(0)
 {
 #if defined(MBEDTLS_PLATFORM_C)
     int ret = mbedtls_platform_setup(NULL);
@@ -47,10 +47,22 @@ LoRaMacCrypto::LoRaMacCrypto() : _dev_addr(0)
     }
 #endif /* MBEDTLS_PLATFORM_C */
     memset(&_keys, 0, sizeof(_keys));
+
+    for (uint8_t i = 0; i < SESSION_KEY_SLOTS; i++) {
+        _aes_slots[i].ready = false;
+        mbedtls_aes_init(&_aes_slots[i].ctx);
+        _cmac_slots[i].ready = false;
+        mbedtls_cipher_init(&_cmac_slots[i].ctx);
+    }
 }
 
 LoRaMacCrypto::~LoRaMacCrypto()
 {
+    for (uint8_t i = 0; i < SESSION_KEY_SLOTS; i++) {
+        mbedtls_aes_free(&_aes_slots[i].ctx);
+        mbedtls_cipher_free(&_cmac_slots[i].ctx);
+    }
+
 #if defined(MBEDTLS_PLATFORM_C)
     mbedtls_platform_teardown(NULL);
 #endif /* MBEDTLS_PLATFORM_C */
@@ -79,6 +91,76 @@ lorawan_status_t LoRaMacCrypto::set_keys(uint8_t *nwk_key, uint8_t *app_key, uin
     return LORAWAN_STATUS_OK;
 }
 
+int LoRaMacCrypto::get_session_aes(const uint8_t *key, mbedtls_aes_context **ctx)
+{
+    int ret;
+
+    for (uint8_t i = 0; i < SESSION_KEY_SLOTS; i++) {
+        if (_aes_slots[i].ready && memcmp(_aes_slots[i].key, key, sizeof(_aes_slots[i].key)) == 0) {
+            *ctx = &_aes_slots[i].ctx;
+            return 0;
+        }
+    }
+
+    // New key, e.g. after a join: replace the oldest one
+    aes_slot_t *slot = &_aes_slots[_aes_next_slot];
+    _aes_next_slot = (_aes_next_slot + 1) % SESSION_KEY_SLOTS;
+
+    slot->ready = false;
+    mbedtls_aes_free(&slot->ctx);
+    mbedtls_aes_init(&slot->ctx);
+
+    ret = mbedtls_aes_setkey_enc(&slot->ctx, key, APPKEY_KEY_LENGTH);
+    if (0 != ret) {
+        return ret;
+    }
+
+    memcpy(slot->key, key, sizeof(slot->key));
+    slot->ready = true;
+    *ctx = &slot->ctx;
+    return 0;
+}
+
+int LoRaMacCrypto::get_session_cmac(const uint8_t *key, mbedtls_cipher_context_t **ctx)
+{
+    int ret;
+
+    for (uint8_t i = 0; i < SESSION_KEY_SLOTS; i++) {
+        if (_cmac_slots[i].ready && memcmp(_cmac_slots[i].key, key, sizeof(_cmac_slots[i].key)) == 0) {
+            *ctx = &_cmac_slots[i].ctx;
+            // keeps the key, drops the state of the previous message
+            return mbedtls_cipher_cmac_reset(*ctx);
+        }
+    }
+
+    cmac_slot_t *slot = &_cmac_slots[_cmac_next_slot];
+    _cmac_next_slot = (_cmac_next_slot + 1) % SESSION_KEY_SLOTS;
+
+    slot->ready = false;
+    mbedtls_cipher_free(&slot->ctx);
+    mbedtls_cipher_init(&slot->ctx);
+
+    const mbedtls_cipher_info_t *cipher_info = mbedtls_cipher_info_from_type(MBEDTLS_CIPHER_AES_128_ECB);
+    if (NULL == cipher_info) {
+        return MBEDTLS_ERR_CIPHER_ALLOC_FAILED;
+    }
+
+    ret = mbedtls_cipher_setup(&slot->ctx, cipher_info);
+    if (0 != ret) {
+        return ret;
+    }
+
+    ret = mbedtls_cipher_cmac_starts(&slot->ctx, key, APPKEY_KEY_LENGTH);
+    if (0 != ret) {
+        return ret;
+    }
+
+    memcpy(slot->key, key, sizeof(slot->key));
+    slot->ready = true;
+    *ctx = &slot->ctx;
+    return 0;
+}
+
 int LoRaMacCrypto::compute_mic(const uint8_t *buffer, uint16_t size,
                                uint32_t args, uint32_t address,
                                uint8_t dir, uint32_t seq_counter,
@@ -142,45 +224,30 @@ int LoRaMacCrypto::compute_mic(const uint8_t *buffer, uint16_t size,
 
     mic_block[15] = size & 0xFF;
 
-    mbedtls_cipher_init(aes_cmac_ctx);
-
-    const mbedtls_cipher_info_t *cipher_info = mbedtls_cipher_info_from_type(MBEDTLS_CIPHER_AES_128_ECB);
-
-    if (NULL != cipher_info) {
-        ret = mbedtls_cipher_setup(aes_cmac_ctx, cipher_info);
-        if (0 != ret) {
-            goto exit;
-        }
-
-        ret = mbedtls_cipher_cmac_starts(aes_cmac_ctx, key, APPKEY_KEY_LENGTH);
-        if (0 != ret) {
-            goto exit;
-        }
-
-        ret = mbedtls_cipher_cmac_update(aes_cmac_ctx, mic_block, sizeof(mic_block));
-        if (0 != ret) {
-            goto exit;
-        }
+    mbedtls_cipher_context_t *cmac_ctx;
+    ret = get_session_cmac(key, &cmac_ctx);
+    if (0 != ret) {
+        return ret;
+    }
 
-        ret = mbedtls_cipher_cmac_update(aes_cmac_ctx, buffer, size & 0xFF);
-        if (0 != ret) {
-            goto exit;
-        }
+    ret = mbedtls_cipher_cmac_update(cmac_ctx, mic_block, sizeof(mic_block));
+    if (0 != ret) {
+        return ret;
+    }
 
-        ret = mbedtls_cipher_cmac_finish(aes_cmac_ctx, computed_mic);
-        if (0 != ret) {
-            goto exit;
-        }
+    ret = mbedtls_cipher_cmac_update(cmac_ctx, buffer, size & 0xFF);
+    if (0 != ret) {
+        return ret;
+    }
 
-        *mic = (uint32_t)((uint32_t) computed_mic[3] << 24
-                          | (uint32_t) computed_mic[2] << 16
-                          | (uint32_t) computed_mic[1] << 8 | (uint32_t) computed_mic[0]);
-    } else {
-        ret = MBEDTLS_ERR_CIPHER_ALLOC_FAILED;
+    ret = mbedtls_cipher_cmac_finish(cmac_ctx, computed_mic);
+    if (0 != ret) {
+        return ret;
     }
 
-exit:
-    mbedtls_cipher_free(aes_cmac_ctx);
+    *mic = (uint32_t)((uint32_t) computed_mic[3] << 24
+                      | (uint32_t) computed_mic[2] << 16
+                      | (uint32_t) computed_mic[1] << 8 | (uint32_t) computed_mic[0]);
     return ret;
 }
 
@@ -198,6 +265,7 @@ int LoRaMacCrypto::encrypt_payload(const uint8_t *buffer, uint16_t size,
     uint8_t a_block[16] = {0};
     uint8_t s_block[16] = {0};
     const uint8_t *key;
+    mbedtls_aes_context *ctx;
     if (is_fopts) {
         key = _keys.nwk_senckey;
     } else {
@@ -206,11 +274,9 @@ int LoRaMacCrypto::encrypt_payload(const uint8_t *buffer, uint16_t size,
         //_dev_addr
     }
 
-    mbedtls_aes_init(&aes_ctx);
-
-    ret = mbedtls_aes_setkey_enc(&aes_ctx, key, APPKEY_KEY_LENGTH);
+    ret = get_session_aes(key, &ctx);
     if (0 != ret) {
-        goto exit;
+        return ret;
     }
 
     a_block[0] = 0x01;
@@ -241,10 +307,10 @@ int LoRaMacCrypto::encrypt_payload(const uint8_t *buffer, uint16_t size,
         a_block[15] = ((ctr) & 0xFF);
         ctr++;
 
-        ret = mbedtls_aes_crypt_ecb(&aes_ctx, MBEDTLS_AES_ENCRYPT, a_block,
+        ret = mbedtls_aes_crypt_ecb(ctx, MBEDTLS_AES_ENCRYPT, a_block,
                                     s_block);
         if (0 != ret) {
-            goto exit;
+            return ret;
         }
 
         for (i = 0; i < 16; i++) {
@@ -256,10 +322,10 @@ int LoRaMacCrypto::encrypt_payload(const uint8_t *buffer, uint16_t size,
 
     if (size > 0) {
         a_block[15] = ((ctr) & 0xFF);
-        ret = mbedtls_aes_crypt_ecb(&aes_ctx, MBEDTLS_AES_ENCRYPT, a_block,
+        ret = mbedtls_aes_crypt_ecb(ctx, MBEDTLS_AES_ENCRYPT, a_block,
                                     s_block);
         if (0 != ret) {
-            goto exit;
+            return ret;
         }
 
         for (i = 0; i < size; i++) {
@@ -267,8 +333,6 @@ int LoRaMacCrypto::encrypt_payload(const uint8_t *buffer, uint16_t size,
         }
     }
 
-exit:
-    mbedtls_aes_free(&aes_ctx);
     return ret;
 }
 
@@ -377,6 +441,22 @@ void LoRaMacCrypto::unset_js_keys()
     memcpy(_keys.js_enckey, _keys.nwk_key, sizeof(_keys.nwk_skey));
 }
 
+void LoRaMacCrypto::get_session_keys(loramac_session_t &session) const
+{
+    memcpy(session.nwk_skey, _keys.nwk_skey, sizeof(session.nwk_skey));
+    memcpy(session.app_skey, _keys.app_skey, sizeof(session.app_skey));
+    memcpy(session.snwk_sintkey, _keys.snwk_sintkey, sizeof(session.snwk_sintkey));
+    memcpy(session.nwk_senckey, _keys.nwk_senckey, sizeof(session.nwk_senckey));
+}
+
+void LoRaMacCrypto::set_session_keys(const loramac_session_t &session)
+{
+    memcpy(_keys.nwk_skey, session.nwk_skey, sizeof(_keys.nwk_skey));
+    memcpy(_keys.app_skey, session.app_skey, sizeof(_keys.app_skey));
+    memcpy(_keys.snwk_sintkey, session.snwk_sintkey, sizeof(_keys.snwk_sintkey));
+    memcpy(_keys.nwk_senckey, session.nwk_senckey, sizeof(_keys.nwk_senckey));
+}
+
 int LoRaMacCrypto::compute_skeys_for_join_frame(const uint8_t *args, uint8_t args_size,
                                                 server_type_t stype)
 {
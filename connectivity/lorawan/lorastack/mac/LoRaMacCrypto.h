@@ -153,6 +153,18 @@ public:
      */
     void unset_js_keys();
 
+    /**
+     * @brief get_session_keys Copy the session keys out, to persist a session
+     * @param [out] session         - Session to fill in
+     */
+    void get_session_keys(loramac_session_t &session) const;
+
+    /**
+     * @brief set_session_keys Set the session keys of a restored session
+     * @param [in]  session         - Session holding the keys
+     */
+    void set_session_keys(const loramac_session_t &session);
+
     /**
      * Computes the LoRaMAC join frame decryption
      *
@@ -190,6 +202,56 @@ public:
     int compute_ping_slot_random_offset(uint32_t beacon_time, uint32_t dev_addr, uint16_t *rand);
 
 private:
+    /**
+     * Number of session keys whose contexts are kept
+     */
+    static const uint8_t SESSION_KEY_SLOTS = 2;
+
+    /**
+     * AES context keeping the key schedule of a session key
+     */
+    struct aes_slot_t {
+        uint8_t key[16];
+        bool ready;
+        mbedtls_aes_context ctx;
+    };
+
+    /**
+     * CMAC context keeping the key schedule and subkeys of a session key
+     */
+    struct cmac_slot_t {
+        uint8_t key[16];
+        bool ready;
+        mbedtls_cipher_context_t ctx;
+    };
+
+    /**
+     * Get an AES context set up with a session key, reusing it while the
+     * key does not change
+     *
+     * @param [in]  key             - 128-bit key
+     * @param [out] ctx             - AES context
+     *
+     * @return                        0 if successful, or a cipher specific error code
+     */
+    int get_session_aes(const uint8_t *key, mbedtls_aes_context **ctx);
+
+    /**
+     * Get a CMAC context set up with a session key and ready to take a new
+     * message, reusing it while the key does not change
+     *
+     * @param [in]  key             - 128-bit key
+     * @param [out] ctx             - CMAC context
+     *
+     * @return                        0 if successful, or a cipher specific error code
+     */
+    int get_session_cmac(const uint8_t *key, mbedtls_cipher_context_t **ctx);
+
+    aes_slot_t _aes_slots[SESSION_KEY_SLOTS];
+    cmac_slot_t _cmac_slots[SESSION_KEY_SLOTS];
+    uint8_t _aes_next_slot;
+    uint8_t _cmac_next_slot;
+
     /**
      * AES computation context variable
      */
@@ -69,6 +69,20 @@ void LoRaPHY::initialize(LoRaWANTimeHandler *lora_time)
     _lora_time = lora_time;
 }
 
+// Index of the lowest set bit, bits must not be 0
+static uint8_t lowest_bit(uint16_t bits)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctz(bits);
+#else
+    uint8_t i = 0;
+    for (; !(bits & 1); bits >>= 1) {
+        i++;
+    }
+    return i;
+#endif
+}
+
 bool LoRaPHY::mask_bit_test(const uint16_t *mask, unsigned bit)
 {
     return mask[bit / 16] & (1U << (bit % 16));
@@ -230,11 +244,11 @@ bool LoRaPHY::disable_channel(uint16_t *channel_mask, uint8_t id,
 uint8_t LoRaPHY::count_bits(uint16_t mask, uint8_t nbBits)
 {
     uint8_t nbActiveBits = 0;
+    uint32_t bits = mask & ((1UL << nbBits) - 1);
 
-    for (uint8_t j = 0; j < nbBits; j++) {
-        if (mask_bit_test(&mask, j)) {
-            nbActiveBits++;
-        }
+    // clear the lowest set bit until none are left
+    for (; bits; bits &= bits - 1) {
+        nbActiveBits++;
     }
 
     return nbActiveBits;
@@ -507,9 +521,15 @@ uint8_t LoRaPHY::enabled_channel_count(uint8_t datarate,
 {
     uint8_t count = 0;
     uint8_t delay_transmission = 0;
+    band_t *band_table = (band_t *) phy_params.bands.table;
 
-    for (uint8_t i = 0; i < phy_params.max_channel_cnt; i++) {
-        if (mask_bit_test(channel_mask, i)) {
+    // Scan the mask a word at a time, and only visit the channels which are enabled
+    for (uint8_t word = 0; word * 16 < phy_params.max_channel_cnt; word++) {
+        for (uint16_t bits = channel_mask[word]; bits; bits &= bits - 1) {
+            uint8_t i = word * 16 + lowest_bit(bits);
+            if (i >= phy_params.max_channel_cnt) {
+                break;
+            }
 
             if (val_in_range(datarate, phy_params.channels.channel_list[i].dr_range.fields.min,
                              phy_params.channels.channel_list[i].dr_range.fields.max) == 0) {
@@ -517,7 +537,6 @@ uint8_t LoRaPHY::enabled_channel_count(uint8_t datarate,
                 continue;
             }
 
-            band_t *band_table = (band_t *) phy_params.bands.table;
             if (band_table[phy_params.channels.channel_list[i].band].off_time > 0) {
                 // Check if the band is available for transmission
                 delay_transmission++;
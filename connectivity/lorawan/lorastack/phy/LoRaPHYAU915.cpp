@@ -261,6 +261,29 @@ static const uint8_t max_payload_with_repeater_AU915[] = { 51, 51, 51, 115,
                                                            222, 222, 222, 0, 33, 109, 222, 222, 222, 222, 0, 0
                                                          };
 
+/*!
+ * Upstream channels. The AU915 channel plan is fixed, so they live in flash.
+ * Channel = { Frequency [Hz], RX1 Frequency [Hz], { ( ( DrMax << 4 ) | DrMin ) }, Band }
+ */
+#define AU915_125KHZ_CHANNEL(n)     { 915200000 + (n) * 200000, 0, { ((DR_5 << 4) | DR_0) }, 0 }
+#define AU915_500KHZ_CHANNEL(n)     { 915900000 + (n) * 1600000, 0, { ((DR_6 << 4) | DR_6) }, 0 }
+#define AU915_125KHZ_CHANNELS_8(n) \
+    AU915_125KHZ_CHANNEL((n)), AU915_125KHZ_CHANNEL((n) + 1), AU915_125KHZ_CHANNEL((n) + 2), AU915_125KHZ_CHANNEL((n) + 3), \
+    AU915_125KHZ_CHANNEL((n) + 4), AU915_125KHZ_CHANNEL((n) + 5), AU915_125KHZ_CHANNEL((n) + 6), AU915_125KHZ_CHANNEL((n) + 7)
+#define AU915_500KHZ_CHANNELS_8(n) \
+    AU915_500KHZ_CHANNEL((n)), AU915_500KHZ_CHANNEL((n) + 1), AU915_500KHZ_CHANNEL((n) + 2), AU915_500KHZ_CHANNEL((n) + 3), \
+    AU915_500KHZ_CHANNEL((n) + 4), AU915_500KHZ_CHANNEL((n) + 5), AU915_500KHZ_CHANNEL((n) + 6), AU915_500KHZ_CHANNEL((n) + 7)
+
+static const channel_params_t channels_AU915[AU915_MAX_NB_CHANNELS] = {
+    // 125 kHz channels
+    AU915_125KHZ_CHANNELS_8(0), AU915_125KHZ_CHANNELS_8(8),
+    AU915_125KHZ_CHANNELS_8(16), AU915_125KHZ_CHANNELS_8(24),
+    AU915_125KHZ_CHANNELS_8(32), AU915_125KHZ_CHANNELS_8(40),
+    AU915_125KHZ_CHANNELS_8(48), AU915_125KHZ_CHANNELS_8(56),
+    // 500 kHz channels
+    AU915_500KHZ_CHANNELS_8(0)
+};
+
 static const uint16_t fsb_mask[] = MBED_CONF_LORA_FSB_MASK;
 
 static const uint16_t full_channel_mask [] = {0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0x00FF};
@@ -269,21 +292,6 @@ LoRaPHYAU915::LoRaPHYAU915()
 {
     bands[0] = AU915_BAND0;
 
-    // Activate Channels
-    // 125 kHz channels Upstream only
-    for (uint8_t i = 0; i < AU915_MAX_NB_CHANNELS - 8; i++) {
-        channels[i].frequency = 915200000 + i * 200000;
-        channels[i].dr_range.value = (DR_5 << 4) | DR_0;
-        channels[i].band = 0;
-    }
-    // 500 kHz channels
-    // Upstream and downstream both
-    for (uint8_t i = AU915_MAX_NB_CHANNELS - 8; i < AU915_MAX_NB_CHANNELS; i++) {
-        channels[i].frequency = 915900000 + (i - (AU915_MAX_NB_CHANNELS - 8)) * 1600000;
-        channels[i].dr_range.value = (DR_6 << 4) | DR_6;
-        channels[i].band = 0;
-    }
-
     // Initialize channels default mask
     // All channels are default channels here
     // Join request needs to alternate between 125 KHz and 500 KHz channels
@@ -304,8 +312,8 @@ LoRaPHYAU915::LoRaPHYAU915()
     // transmission on the same channel
     copy_channel_mask(current_channel_mask, channel_mask, AU915_CHANNEL_MASK_SIZE);
 
-    // set default channels
-    phy_params.channels.channel_list = channels;
+    // set default channels, never modified as there are no custom channel plans
+    phy_params.channels.channel_list = (channel_params_t *) channels_AU915;
     phy_params.channels.channel_list_size = AU915_MAX_NB_CHANNELS;
     phy_params.channels.mask = channel_mask;
     phy_params.channels.default_mask = default_channel_mask;
@@ -388,8 +396,8 @@ bool LoRaPHYAU915::tx_config(tx_config_params_t *params, int8_t *tx_power,
 {
     int8_t phy_dr = datarates_AU915[params->datarate];
 
-    if (params->tx_power > bands[channels[params->channel].band].max_tx_pwr) {
-        params->tx_power = bands[channels[params->channel].band].max_tx_pwr;
+    if (params->tx_power > bands[channels_AU915[params->channel].band].max_tx_pwr) {
+        params->tx_power = bands[channels_AU915[params->channel].band].max_tx_pwr;
     }
 
     uint32_t bandwidth = get_bandwidth(params->datarate);
@@ -403,7 +411,7 @@ bool LoRaPHYAU915::tx_config(tx_config_params_t *params, int8_t *tx_power,
 
     _radio->lock();
 
-    _radio->set_channel(channels[params->channel].frequency);
+    _radio->set_channel(channels_AU915[params->channel].frequency);
 
     _radio->set_tx_config(MODEM_LORA, phy_tx_power, 0, bandwidth, phy_dr, 1, 8,
                           false, true, 0, 0, false, 3000);
@@ -105,11 +105,6 @@ private:
 
 private:
 
-    /*!
-     * LoRaMAC channels
-     */
-    channel_params_t channels[AU915_MAX_NB_CHANNELS];
-
     /*!
      * LoRaMac bands
      */
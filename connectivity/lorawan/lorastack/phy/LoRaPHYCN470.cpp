@@ -238,20 +238,27 @@ static const uint8_t max_payloads_CN470[] = {51, 51, 51, 115, 222, 222};
 static const uint8_t max_payloads_with_repeater_CN470[] = {51, 51, 51, 115, 222, 222};
 
 
+/*!
+ * Upstream channels. The CN470 channel plan is fixed, so they live in flash.
+ * Channel = { Frequency [Hz], RX1 Frequency [Hz], { ( ( DrMax << 4 ) | DrMin ) }, Band }
+ */
+#define CN470_CHANNEL(n)        { 470300000 + (n) * 200000, 0, { ((DR_5 << 4) | DR_0) }, 0 }
+#define CN470_CHANNELS_8(n) \
+    CN470_CHANNEL((n)), CN470_CHANNEL((n) + 1), CN470_CHANNEL((n) + 2), CN470_CHANNEL((n) + 3), \
+    CN470_CHANNEL((n) + 4), CN470_CHANNEL((n) + 5), CN470_CHANNEL((n) + 6), CN470_CHANNEL((n) + 7)
+
+static const channel_params_t channels_CN470[CN470_MAX_NB_CHANNELS] = {
+    CN470_CHANNELS_8(0), CN470_CHANNELS_8(8), CN470_CHANNELS_8(16), CN470_CHANNELS_8(24),
+    CN470_CHANNELS_8(32), CN470_CHANNELS_8(40), CN470_CHANNELS_8(48), CN470_CHANNELS_8(56),
+    CN470_CHANNELS_8(64), CN470_CHANNELS_8(72), CN470_CHANNELS_8(80), CN470_CHANNELS_8(88)
+};
+
 LoRaPHYCN470::LoRaPHYCN470()
 {
     static const uint16_t fsb_mask[] = MBED_CONF_LORA_FSB_MASK_CHINA;
 
     bands[0] = CN470_BAND0;
 
-    // Channels
-    // 125 kHz channels
-    for (uint8_t i = 0; i < CN470_MAX_NB_CHANNELS; i++) {
-        channels[i].frequency = 470300000 + i * 200000;
-        channels[i].dr_range.value = (DR_5 << 4) | DR_0;
-        channels[i].band = 0;
-    }
-
     // Initialize the channels default mask
     for (uint8_t i = 0; i < CN470_CHANNEL_MASK_SIZE; i++) {
         default_channel_mask[i] = 0xFFFF & fsb_mask[i];
@@ -260,8 +267,8 @@ LoRaPHYCN470::LoRaPHYCN470()
     // Update the channels mask
     copy_channel_mask(channel_mask, default_channel_mask, CN470_CHANNEL_MASK_SIZE);
 
-    // set default channels
-    phy_params.channels.channel_list = channels;
+    // set default channels, never modified as there are no custom channel plans
+    phy_params.channels.channel_list = (channel_params_t *) channels_CN470;
     phy_params.channels.channel_list_size = CN470_MAX_NB_CHANNELS;
     phy_params.channels.mask = channel_mask;
     phy_params.channels.default_mask = default_channel_mask;
@@ -404,8 +411,8 @@ bool LoRaPHYCN470::tx_config(tx_config_params_t *config, int8_t *tx_power,
 {
     int8_t phy_dr = datarates_CN470[config->datarate];
 
-    if (config->tx_power > bands[channels[config->channel].band].max_tx_pwr) {
-        config->tx_power = bands[channels[config->channel].band].max_tx_pwr;
+    if (config->tx_power > bands[channels_CN470[config->channel].band].max_tx_pwr) {
+        config->tx_power = bands[channels_CN470[config->channel].band].max_tx_pwr;
     }
 
     int8_t phy_tx_power = 0;
@@ -417,7 +424,7 @@ bool LoRaPHYCN470::tx_config(tx_config_params_t *config, int8_t *tx_power,
     // acquire lock to radio
     _radio->lock();
 
-    _radio->set_channel(channels[config->channel].frequency);
+    _radio->set_channel(channels_CN470[config->channel].frequency);
 
     _radio->set_tx_config(MODEM_LORA, phy_tx_power, 0, 0, phy_dr, 1,
                           MBED_CONF_LORA_UPLINK_PREAMBLE_LENGTH, false, true,
@@ -488,7 +495,7 @@ uint8_t LoRaPHYCN470::link_ADR_request(adr_req_params_t *params,
             for (uint8_t i = 0; i < 16; i++) {
 
                 if (((adr_settings.channel_mask & (1 << i)) != 0) &&
-                        (channels[adr_settings.ch_mask_ctrl * 16 + i].frequency == 0)) {
+                        (channels_CN470[adr_settings.ch_mask_ctrl * 16 + i].frequency == 0)) {
                     // Trying to enable an undefined channel
                     status &= 0xFE; // Channel mask KO
                 }
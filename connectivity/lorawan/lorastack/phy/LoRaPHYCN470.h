@@ -79,11 +79,6 @@ public:
 
 private:
 
-    /*!
-     * LoRaMAC channels
-     */
-    channel_params_t channels[CN470_MAX_NB_CHANNELS];
-
     /*!
      * LoRaMac bands
      */
@@ -255,6 +255,29 @@ static const uint8_t max_payloads_US915[] = {11, 53, 125, 242, 242, 0, 0, 0, 53,
  */
 static const uint8_t max_payloads_with_repeater_US915[] = {11, 53, 125, 242, 242, 0, 0, 0, 33, 109, 222, 222, 222, 222, 0, 0};
 
+/*!
+ * Upstream channels. The US915 channel plan is fixed, so they live in flash.
+ * Channel = { Frequency [Hz], RX1 Frequency [Hz], { ( ( DrMax << 4 ) | DrMin ) }, Band }
+ */
+#define US915_125KHZ_CHANNEL(n)     { 902300000 + (n) * 200000, 0, { ((DR_3 << 4) | DR_0) }, 0 }
+#define US915_500KHZ_CHANNEL(n)     { 903000000 + (n) * 1600000, 0, { ((DR_4 << 4) | DR_4) }, 0 }
+#define US915_125KHZ_CHANNELS_8(n) \
+    US915_125KHZ_CHANNEL((n)), US915_125KHZ_CHANNEL((n) + 1), US915_125KHZ_CHANNEL((n) + 2), US915_125KHZ_CHANNEL((n) + 3), \
+    US915_125KHZ_CHANNEL((n) + 4), US915_125KHZ_CHANNEL((n) + 5), US915_125KHZ_CHANNEL((n) + 6), US915_125KHZ_CHANNEL((n) + 7)
+#define US915_500KHZ_CHANNELS_8(n) \
+    US915_500KHZ_CHANNEL((n)), US915_500KHZ_CHANNEL((n) + 1), US915_500KHZ_CHANNEL((n) + 2), US915_500KHZ_CHANNEL((n) + 3), \
+    US915_500KHZ_CHANNEL((n) + 4), US915_500KHZ_CHANNEL((n) + 5), US915_500KHZ_CHANNEL((n) + 6), US915_500KHZ_CHANNEL((n) + 7)
+
+static const channel_params_t channels_US915[US915_MAX_NB_CHANNELS] = {
+    // 125 kHz channels
+    US915_125KHZ_CHANNELS_8(0), US915_125KHZ_CHANNELS_8(8),
+    US915_125KHZ_CHANNELS_8(16), US915_125KHZ_CHANNELS_8(24),
+    US915_125KHZ_CHANNELS_8(32), US915_125KHZ_CHANNELS_8(40),
+    US915_125KHZ_CHANNELS_8(48), US915_125KHZ_CHANNELS_8(56),
+    // 500 kHz channels
+    US915_500KHZ_CHANNELS_8(0)
+};
+
 static const uint16_t fsb_mask[] = MBED_CONF_LORA_FSB_MASK;
 static const uint16_t full_channel_mask [] = {0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0x00FF};
 
@@ -262,20 +285,6 @@ LoRaPHYUS915::LoRaPHYUS915()
 {
     bands[0] = US915_BAND0;
 
-    // Channels
-    // 125 kHz channels - Upstream
-    for (uint8_t i = 0; i < US915_MAX_NB_CHANNELS - 8; i++) {
-        channels[i].frequency = 902300000 + i * 200000;
-        channels[i].dr_range.value = (DR_3 << 4) | DR_0;
-        channels[i].band = 0;
-    }
-    // 500 kHz channels - Upstream
-    for (uint8_t i = US915_MAX_NB_CHANNELS - 8; i < US915_MAX_NB_CHANNELS; i++) {
-        channels[i].frequency = 903000000 + (i - (US915_MAX_NB_CHANNELS - 8)) * 1600000;
-        channels[i].dr_range.value = (DR_4 << 4) | DR_4;
-        channels[i].band = 0;
-    }
-
     // Fill-up default channel mask and apply FSB mask too
     fill_channel_mask_with_fsb(full_channel_mask, fsb_mask,
                                default_channel_mask, US915_CHANNEL_MASK_SIZE);
@@ -291,8 +300,8 @@ LoRaPHYUS915::LoRaPHYUS915()
     // next transmission
     copy_channel_mask(current_channel_mask, channel_mask, US915_CHANNEL_MASK_SIZE);
 
-    // set default channels
-    phy_params.channels.channel_list = channels;
+    // set default channels, never modified as there are no custom channel plans
+    phy_params.channels.channel_list = (channel_params_t *) channels_US915;
     phy_params.channels.channel_list_size = US915_MAX_NB_CHANNELS;
     phy_params.channels.mask = channel_mask;
     phy_params.channels.default_mask = default_channel_mask;
@@ -404,7 +413,7 @@ bool LoRaPHYUS915::tx_config(tx_config_params_t *config, int8_t *tx_power,
 {
     int8_t phy_dr = datarates_US915[config->datarate];
     int8_t tx_power_limited = limit_tx_power(config->tx_power,
-                                             bands[channels[config->channel].band].max_tx_pwr,
+                                             bands[channels_US915[config->channel].band].max_tx_pwr,
                                              config->datarate);
 
     uint32_t bandwidth = get_bandwidth(config->datarate);
@@ -415,7 +424,7 @@ bool LoRaPHYUS915::tx_config(tx_config_params_t *config, int8_t *tx_power,
 
     _radio->lock();
 
-    _radio->set_channel(channels[config->channel].frequency);
+    _radio->set_channel(channels_US915[config->channel].frequency);
 
     _radio->set_tx_config(MODEM_LORA, phy_tx_power, 0, bandwidth, phy_dr, 1,
                           MBED_CONF_LORA_UPLINK_PREAMBLE_LENGTH,
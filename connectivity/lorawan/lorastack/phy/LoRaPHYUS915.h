@@ -106,11 +106,6 @@ private:
     int8_t limit_tx_power(int8_t tx_power, int8_t max_band_tx_power,
                           int8_t datarate);
 
-    /*!
-     * LoRaMAC channels
-     */
-    channel_params_t channels[US915_MAX_NB_CHANNELS];
-
     /*!
      * LoRaMac bands
      */
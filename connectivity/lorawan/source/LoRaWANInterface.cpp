@@ -72,6 +72,18 @@ lorawan_status_t LoRaWANInterface::disconnect()
     return _lw_stack.shutdown();
 }
 
+lorawan_status_t LoRaWANInterface::set_session_store(mbed::KVStore *store)
+{
+    Lock lock(*this);
+    return _lw_stack.set_session_store(store);
+}
+
+lorawan_status_t LoRaWANInterface::remove_stored_session()
+{
+    Lock lock(*this);
+    return _lw_stack.remove_stored_session();
+}
+
 lorawan_status_t LoRaWANInterface::add_link_check_request()
 {
     Lock lock(*this);
@@ -150,6 +162,13 @@ int16_t LoRaWANInterface::send(uint8_t port, const uint8_t *data, uint16_t lengt
     return _lw_stack.handle_tx(port, data, length, flags);
 }
 
+int16_t LoRaWANInterface::queue_send(uint8_t port, const uint8_t *data, uint16_t length, int flags,
+                                     uint8_t priority, bool aggregate)
+{
+    Lock lock(*this);
+    return _lw_stack.handle_queued_tx(port, data, length, flags, priority, aggregate);
+}
+
 lorawan_status_t LoRaWANInterface::cancel_sending(void)
 {
     Lock lock(*this);
@@ -27,6 +27,7 @@ SPDX-License-Identifier: BSD-3-Clause
 #include <stdlib.h>
 #include "platform/Callback.h"
 #include "events/EventQueue.h"
+#include "kvstore/KVStore.h"
 
 #include "LoRaWANStack.h"
 
@@ -48,6 +49,17 @@ SPDX-License-Identifier: BSD-3-Clause
 #define TX_DONE_FLAG                0x00000010
 #define CONN_IN_PROGRESS_FLAG       0x00000020
 #define REJOIN_IN_PROGRESS          0x00000040
+#define SESSION_RESTORED_FLAG       0x00000080
+
+/**
+ * Version of the session record in the KVStore
+ */
+#define SESSION_STORE_VERSION       1
+
+typedef struct {
+    uint32_t version;
+    loramac_session_t session;
+} stored_session_t;
 
 using namespace mbed;
 using namespace events;
@@ -92,7 +104,10 @@ LoRaWANStack::LoRaWANStack()
       _forced_counter(0),
       _ping_slot_info_requested(false),
       _device_time_requested(false),
-      _last_beacon_rx_time(0)
+      _last_beacon_rx_time(0),
+      _uplink_queue_count(0),
+      _session_store(NULL),
+      _session_ul_limit(0)
 {
     _tx_metadata.stale = true;
     _rx_metadata.stale = true;
@@ -215,6 +230,35 @@ lorawan_status_t LoRaWANStack::connect(const lorawan_connect_t &connect)
     return handle_connect(is_otaa);
 }
 
+lorawan_status_t LoRaWANStack::set_session_store(KVStore *store)
+{
+    if (_ctrl_flags & (CONN_IN_PROGRESS_FLAG | CONNECTED_FLAG)) {
+        return LORAWAN_STATUS_BUSY;
+    }
+
+    _session_store = store;
+    return LORAWAN_STATUS_OK;
+}
+
+lorawan_status_t LoRaWANStack::remove_stored_session()
+{
+    if (!_session_store) {
+        return LORAWAN_STATUS_NO_OP;
+    }
+
+    if (_ctrl_flags & (CONN_IN_PROGRESS_FLAG | CONNECTED_FLAG)) {
+        return LORAWAN_STATUS_BUSY;
+    }
+
+    int ret = _session_store->remove(MBED_CONF_LORA_SESSION_STORE_KEY);
+    if (ret != MBED_SUCCESS && ret != MBED_ERROR_ITEM_NOT_FOUND) {
+        tr_error("Failed to remove stored session: %d", ret);
+        return LORAWAN_STATUS_NO_OP;
+    }
+
+    return LORAWAN_STATUS_OK;
+}
+
 lorawan_status_t LoRaWANStack::add_channels(const lorawan_channelplan_t &channel_plan)
 {
     if (_device_current_state == DEVICE_STATE_NOT_INITIALIZED) {
@@ -294,6 +338,8 @@ lorawan_status_t LoRaWANStack::stop_sending(void)
 
     lorawan_status_t status = _loramac.clear_tx_pipe();
 
+    _uplink_queue_count = 0;
+
     if (status == LORAWAN_STATUS_OK) {
         _ctrl_flags &= ~TX_DONE_FLAG;
         _loramac.set_tx_ongoing(false);
@@ -403,6 +449,155 @@ int16_t LoRaWANStack::handle_tx(const uint8_t port, const uint8_t *data,
     return (status == LORAWAN_STATUS_OK) ? len : (int16_t) status;
 }
 
+int16_t LoRaWANStack::handle_queued_tx(const uint8_t port, const uint8_t *data,
+                                       uint16_t length, uint8_t flags,
+                                       uint8_t priority, bool aggregate)
+{
+    if (_device_current_state == DEVICE_STATE_NOT_INITIALIZED) {
+        return LORAWAN_STATUS_NOT_INITIALIZED;
+    }
+
+    if (!data && length) {
+        return LORAWAN_STATUS_PARAMETER_INVALID;
+    }
+
+    // Check what handle_tx() would reject before the message is queued, the
+    // application would not hear about it later on
+    if (!is_port_valid(port)) {
+        return LORAWAN_STATUS_PORT_INVALID;
+    }
+
+    switch (flags & MSG_FLAG_MASK) {
+        case MSG_UNCONFIRMED_FLAG:
+        case MSG_CONFIRMED_FLAG:
+        case MSG_PROPRIETARY_FLAG:
+            break;
+
+        default:
+            tr_error("Invalid send flags");
+            return LORAWAN_STATUS_PARAMETER_INVALID;
+    }
+
+    if (length > MBED_CONF_LORA_UPLINK_QUEUE_ENTRY_SIZE) {
+        return LORAWAN_STATUS_LENGTH_ERROR;
+    }
+
+    if (!_lw_session.active) {
+        return LORAWAN_STATUS_NO_ACTIVE_SESSIONS;
+    }
+
+    if (_uplink_queue_count == 0 && !_loramac.tx_ongoing()) {
+        int16_t ret = handle_tx(port, data, length, flags);
+        if (ret < 0 && ret != LORAWAN_STATUS_WOULD_BLOCK) {
+            return ret;
+        }
+        if (ret >= length) {
+            return ret;
+        }
+        // queue what did not fit into the frame, or the whole message if
+        // the stack could not take it now
+        if (ret > 0) {
+            data += ret;
+            length -= ret;
+        }
+    }
+
+    if (aggregate) {
+        const uint16_t max_size = MIN((uint16_t) MBED_CONF_LORA_UPLINK_QUEUE_ENTRY_SIZE,
+                                      (uint16_t) _loramac.get_max_tx_payload_size());
+        for (uint8_t i = 0; i < _uplink_queue_count; i++) {
+            uplink_queue_entry_t &entry = _uplink_queue[i];
+            if (entry.aggregate && entry.port == port && entry.flags == flags &&
+                    entry.priority == priority && entry.length + length <= max_size) {
+                memcpy(entry.data + entry.length, data, length);
+                entry.length += length;
+                return length;
+            }
+        }
+    }
+
+    if (_uplink_queue_count == MBED_CONF_LORA_UPLINK_QUEUE_SIZE) {
+        return LORAWAN_STATUS_WOULD_BLOCK;
+    }
+
+    // after the messages of the same or a higher priority
+    uint8_t index = _uplink_queue_count;
+    while (index > 0 && _uplink_queue[index - 1].priority < priority) {
+        _uplink_queue[index] = _uplink_queue[index - 1];
+        index--;
+    }
+
+    uplink_queue_entry_t &entry = _uplink_queue[index];
+    entry.port = port;
+    entry.flags = flags;
+    entry.priority = priority;
+    entry.aggregate = aggregate;
+    entry.length = length;
+    if (length) {
+        memcpy(entry.data, data, length);
+    }
+    _uplink_queue_count++;
+
+    if (!_loramac.tx_ongoing()) {
+        schedule_queued_uplink();
+    }
+
+    return length;
+}
+
+void LoRaWANStack::schedule_queued_uplink()
+{
+    if (_uplink_queue_count == 0) {
+        return;
+    }
+
+    // Not from within the state machine, the completed transmission has to
+    // be wound up first
+    const int ret = _queue->call(this, &LoRaWANStack::send_queued_uplink);
+    MBED_ASSERT(ret != 0);
+    (void)ret;
+}
+
+void LoRaWANStack::send_queued_uplink()
+{
+    if (_uplink_queue_count == 0 || _loramac.tx_ongoing()) {
+        return;
+    }
+
+    uplink_queue_entry_t &entry = _uplink_queue[0];
+    const int16_t ret = handle_tx(entry.port, entry.data, entry.length, entry.flags);
+
+    if (ret == LORAWAN_STATUS_WOULD_BLOCK || ret == LORAWAN_STATUS_BUSY) {
+        // retried once the ongoing operation completes
+        return;
+    }
+
+    if (ret < 0) {
+        tr_error("Queued uplink dropped, error code = %d", ret);
+        drop_queued_uplink(0);
+        send_event_to_application(TX_SCHEDULING_ERROR);
+        schedule_queued_uplink();
+        return;
+    }
+
+    if (ret < entry.length) {
+        // the data rate went down since the message was queued
+        memmove(entry.data, entry.data + ret, entry.length - ret);
+        entry.length -= ret;
+        return;
+    }
+
+    drop_queued_uplink(0);
+}
+
+void LoRaWANStack::drop_queued_uplink(uint8_t index)
+{
+    for (uint8_t i = index + 1; i < _uplink_queue_count; i++) {
+        _uplink_queue[i - 1] = _uplink_queue[i];
+    }
+    _uplink_queue_count--;
+}
+
 int16_t LoRaWANStack::handle_rx(uint8_t *data, uint16_t length, uint8_t &port, int &flags, bool validate_params)
 {
     if (_device_current_state == DEVICE_STATE_NOT_INITIALIZED) {
@@ -1087,7 +1282,12 @@ lorawan_status_t LoRaWANStack::handle_connect(bool is_otaa)
 {
     _ctrl_flags |= CONN_IN_PROGRESS_FLAG;
 
-    if (is_otaa) {
+    bool restored = restore_session(is_otaa);
+
+    if (is_otaa && restored) {
+        tr_debug("Resuming stored session, UpCnt=%lu", _session_ul_limit);
+        _ctrl_flags |= USING_OTAA_FLAG | SESSION_RESTORED_FLAG;
+    } else if (is_otaa) {
         tr_debug("Initiating OTAA");
 
         // In 1.0.2 spec, counters are always set to zero for new connection.
@@ -1102,10 +1302,8 @@ lorawan_status_t LoRaWANStack::handle_connect(bool is_otaa)
         // communication. In case of ABP specification is meddled about frame counters.
         // It says to reset counters to zero but there is no mechanism to tell the
         // network server that the device was disconnected or restarted.
-        // At the moment, this implementation does not support a non-volatile
-        // memory storage.
-        //_lw_session.downlink_counter; //Get from NVM
-        //_lw_session.uplink_counter; //Get from NVM
+        // The counters are kept in RAM, and restored above if a session
+        // store is attached.
 
         if (MBED_CONF_LORA_VERSION == LORAWAN_VERSION_1_1) {
             _reset_ind_requested = true;
@@ -1121,6 +1319,51 @@ lorawan_status_t LoRaWANStack::handle_connect(bool is_otaa)
     return state_controller(DEVICE_STATE_CONNECTING);
 }
 
+bool LoRaWANStack::restore_session(bool is_otaa)
+{
+    if (!_session_store) {
+        return false;
+    }
+
+    stored_session_t stored;
+    size_t size = 0;
+    int ret = _session_store->get(MBED_CONF_LORA_SESSION_STORE_KEY, &stored, sizeof(stored), &size);
+    if (ret != MBED_SUCCESS || size != sizeof(stored) || stored.version != SESSION_STORE_VERSION) {
+        return false;
+    }
+
+    if (_loramac.restore_session(stored.session, is_otaa) != LORAWAN_STATUS_OK) {
+        tr_debug("Stored session does not match the credentials");
+        return false;
+    }
+
+    _lw_session.uplink_counter = stored.session.ul_frame_counter;
+    _lw_session.downlink_counter = stored.session.dl_frame_counter;
+    _session_ul_limit = stored.session.ul_frame_counter;
+    return true;
+}
+
+void LoRaWANStack::store_session(uint32_t ul_frame_counter)
+{
+    if (!_session_store) {
+        return;
+    }
+
+    stored_session_t stored;
+    stored.version = SESSION_STORE_VERSION;
+    _loramac.get_session(stored.session, _ctrl_flags & USING_OTAA_FLAG);
+    stored.session.ul_frame_counter = ul_frame_counter;
+
+    int ret = _session_store->set(MBED_CONF_LORA_SESSION_STORE_KEY, &stored, sizeof(stored), 0);
+    if (ret != MBED_SUCCESS) {
+        // Tried again before the next uplink
+        tr_error("Failed to store session: %d", ret);
+        return;
+    }
+
+    _session_ul_limit = ul_frame_counter;
+}
+
 void LoRaWANStack::mlme_indication_handler()
 {
     if (_loramac.get_mlme_indication()->indication_type == MLME_SCHEDULE_UPLINK) {
@@ -1254,6 +1497,8 @@ void LoRaWANStack::mcps_confirm_handler()
             // if no ack was received after enough retries, send TX_ERROR
             send_event_to_application(TX_ERROR);
     }
+
+    schedule_queued_uplink();
 }
 
 void LoRaWANStack::mcps_indication_handler()
@@ -1368,8 +1613,13 @@ void LoRaWANStack::process_shutdown_state(lorawan_status_t &op_status)
      * Radio will be put to sleep by the APIs underneath
      */
     drop_channel_list();
+    if (_ctrl_flags & CONNECTED_FLAG) {
+        // Resume without a gap in the frame counter
+        store_session(_loramac.get_ul_frame_counter());
+    }
     _loramac.disconnect();
     _lw_session.active = false;
+    _uplink_queue_count = 0;
     _device_current_state = DEVICE_STATE_SHUTDOWN;
     op_status = LORAWAN_STATUS_DEVICE_OFF;
     _ctrl_flags = 0;
@@ -1403,6 +1653,7 @@ void LoRaWANStack::process_status_check_state()
             // event to application
             if (_automatic_uplink_ongoing) {
                 _automatic_uplink_ongoing = false;
+                schedule_queued_uplink();
             } else {
                 mcps_confirm_handler();
             }
@@ -1426,6 +1677,10 @@ void LoRaWANStack::process_scheduling_state(lorawan_status_t &op_status)
         }
     }
 
+    if (_session_store && _loramac.get_ul_frame_counter() >= _session_ul_limit) {
+        store_session(_loramac.get_ul_frame_counter() + MBED_CONF_LORA_SESSION_COUNTER_RESERVE);
+    }
+
     op_status = _loramac.send_ongoing_tx();
     if (op_status == LORAWAN_STATUS_OK) {
         _ctrl_flags &= ~TX_DONE_FLAG;
@@ -1467,6 +1722,9 @@ void LoRaWANStack::process_connected_state()
         tr_debug("OTAA Connection OK!");
     }
 
+    _ctrl_flags &= ~SESSION_RESTORED_FLAG;
+    store_session(_loramac.get_ul_frame_counter() + MBED_CONF_LORA_SESSION_COUNTER_RESERVE);
+
     _lw_session.active = true;
     send_event_to_application(CONNECTED);
 
@@ -1480,7 +1738,7 @@ void LoRaWANStack::process_connecting_state(lorawan_status_t &op_status)
 
     _device_current_state = DEVICE_STATE_CONNECTING;
 
-    if (_ctrl_flags & USING_OTAA_FLAG) {
+    if ((_ctrl_flags & USING_OTAA_FLAG) && !(_ctrl_flags & SESSION_RESTORED_FLAG)) {
         process_joining_state(op_status);
         return;
     }
@@ -1316,6 +1316,56 @@ typedef struct {
 
 } loramac_keys;
 
+/*!
+ * The state of an active session, kept across resets by LoRaWANStack when
+ * a session store is attached
+ */
+typedef struct {
+    /*!
+     * DevEUI for OTAA, zero for ABP
+     */
+    uint8_t dev_eui[8];
+
+    /*!
+     * Network ID and device address
+     */
+    uint32_t net_id;
+    uint32_t dev_addr;
+
+    /*!
+     * Frame counters, the uplink one with a margin ahead of the last
+     * counter actually used
+     */
+    uint32_t ul_frame_counter;
+    uint32_t dl_frame_counter;
+    uint32_t app_dl_frame_counter;
+
+    /*!
+     * Session keys
+     */
+    uint8_t nwk_skey[16];
+    uint8_t app_skey[16];
+    uint8_t snwk_sintkey[16];
+    uint8_t nwk_senckey[16];
+
+    /*!
+     * Parameters received in the JoinAccept
+     */
+    uint32_t recv_delay1;
+    uint8_t rx1_dr_offset;
+    uint8_t rx2_datarate;
+
+    /*!
+     * LW1_0_2 or LW1_1
+     */
+    uint8_t server_type;
+
+    /*!
+     * True if the session was established with OTAA
+     */
+    uint8_t is_otaa;
+} loramac_session_t;
+
 /*!
  * A composite structure containing all the timers used in the LoRaWAN operation
  */
@@ -223,6 +223,11 @@ TEST_F(Test_LoRaWANInterface, send)
     EXPECT_TRUE(0 == object->send(1, NULL, 0, 0));
 }
 
+TEST_F(Test_LoRaWANInterface, queue_send)
+{
+    EXPECT_TRUE(0 == object->queue_send(1, NULL, 0, 0));
+}
+
 TEST_F(Test_LoRaWANInterface, receive)
 {
     EXPECT_TRUE(0 == object->receive(1, NULL, 0, 0));
@@ -18,6 +18,7 @@
 #include "gtest/gtest.h"
 #include "LoRaWANStack.h"
 #include "events/EventQueue.h"
+#include "kvstore/KVStore.h"
 
 #include "LoRaPHY_stub.h"
 #include "LoRaMac_stub.h"
@@ -150,6 +151,93 @@ public:
 };
 
 
+class my_kvstore : public mbed::KVStore {
+public:
+    my_kvstore() : size(0), sets(0), removes(0)
+    {
+    }
+
+    virtual int init()
+    {
+        return MBED_SUCCESS;
+    }
+
+    virtual int deinit()
+    {
+        return MBED_SUCCESS;
+    }
+
+    virtual int reset()
+    {
+        return MBED_SUCCESS;
+    }
+
+    virtual int set(const char *key, const void *buffer, size_t size, uint32_t create_flags)
+    {
+        memcpy(data, buffer, size);
+        this->size = size;
+        sets++;
+        return MBED_SUCCESS;
+    }
+
+    virtual int get(const char *key, void *buffer, size_t buffer_size, size_t *actual_size = NULL, size_t offset = 0)
+    {
+        if (!size) {
+            return MBED_ERROR_ITEM_NOT_FOUND;
+        }
+        memcpy(buffer, data, size < buffer_size ? size : buffer_size);
+        *actual_size = size;
+        return MBED_SUCCESS;
+    }
+
+    virtual int get_info(const char *key, info_t *info = NULL)
+    {
+        return MBED_ERROR_UNSUPPORTED;
+    }
+
+    virtual int remove(const char *key)
+    {
+        size = 0;
+        removes++;
+        return MBED_SUCCESS;
+    }
+
+    virtual int set_start(set_handle_t *handle, const char *key, size_t final_data_size, uint32_t create_flags)
+    {
+        return MBED_ERROR_UNSUPPORTED;
+    }
+
+    virtual int set_add_data(set_handle_t handle, const void *value_data, size_t data_size)
+    {
+        return MBED_ERROR_UNSUPPORTED;
+    }
+
+    virtual int set_finalize(set_handle_t handle)
+    {
+        return MBED_ERROR_UNSUPPORTED;
+    }
+
+    virtual int iterator_open(iterator_t *it, const char *prefix = NULL)
+    {
+        return MBED_ERROR_UNSUPPORTED;
+    }
+
+    virtual int iterator_next(iterator_t it, char *key, size_t key_size)
+    {
+        return MBED_ERROR_UNSUPPORTED;
+    }
+
+    virtual int iterator_close(iterator_t it)
+    {
+        return MBED_ERROR_UNSUPPORTED;
+    }
+
+    uint8_t data[256];
+    size_t size;
+    int sets;
+    int removes;
+};
+
 
 class Test_LoRaWANStack : public testing::Test {
 protected:
@@ -301,6 +389,39 @@ TEST_F(Test_LoRaWANStack, connect_args)
     EXPECT_TRUE(LORAWAN_STATUS_ALREADY_CONNECTED == object->connect(conn));
 }
 
+TEST_F(Test_LoRaWANStack, session_store)
+{
+    my_kvstore store;
+    EXPECT_TRUE(LORAWAN_STATUS_NO_OP == object->remove_stored_session());
+    EXPECT_TRUE(LORAWAN_STATUS_OK == object->set_session_store(&store));
+
+    EventQueue queue;
+    EXPECT_TRUE(LORAWAN_STATUS_OK == object->initialize_mac_layer(&queue));
+
+    // Stored once connected
+    lorawan_connect_t conn;
+    conn.connect_type = LORAWAN_CONNECTION_ABP;
+    EXPECT_TRUE(LORAWAN_STATUS_OK == object->connect(conn));
+    EXPECT_EQ(1, store.sets);
+    EXPECT_TRUE(LORAWAN_STATUS_BUSY == object->set_session_store(NULL));
+    EXPECT_TRUE(LORAWAN_STATUS_BUSY == object->remove_stored_session());
+
+    // and with the exact counter on shutdown
+    EXPECT_TRUE(LORAWAN_STATUS_DEVICE_OFF == object->shutdown());
+    EXPECT_EQ(2, store.sets);
+
+    // A stored OTAA session is resumed without a join
+    conn.connect_type = LORAWAN_CONNECTION_OTAA;
+    EXPECT_TRUE(LORAWAN_STATUS_OK == object->connect(conn));
+    EXPECT_TRUE(LORAWAN_STATUS_ALREADY_CONNECTED == object->connect(conn));
+    EXPECT_EQ(3, store.sets);
+    EXPECT_TRUE(LORAWAN_STATUS_DEVICE_OFF == object->shutdown());
+
+    EXPECT_TRUE(LORAWAN_STATUS_OK == object->remove_stored_session());
+    EXPECT_EQ(1, store.removes);
+    EXPECT_EQ(0u, store.size);
+}
+
 TEST_F(Test_LoRaWANStack, add_channels)
 {
     lorawan_channelplan_t plan;
@@ -27,6 +27,7 @@ set(unittest-sources
 set(unittest-includes ${unittest-includes}
   target_h
   ../connectivity/lorawan
+  ../storage/kvstore/include
 )
 
 # Test & stub files
@@ -168,6 +168,13 @@ public:
         static err_t emac_low_level_output(struct netif *netif, struct pbuf *p);
         void emac_input(net_stack_mem_buf_t *buf);
         void emac_state_change(bool up);
+#if EMAC_RX_BATCH
+        struct EmacRxBatch;
+        static void emac_rx_batch_new(Interface *interface);
+        static void emac_rx_batch_delete(Interface *interface);
+        static void emac_rx_batch_post(EmacRxBatch *batch);
+        static void emac_input_batch(void *ctx);
+#endif
 #if LWIP_IGMP
         static err_t emac_igmp_mac_filter(struct netif *netif, const ip4_addr_t *group, enum netif_mac_filter_action action);
 #endif
@@ -253,6 +260,9 @@ public:
         static Interface *list;
         Interface *next;
         LWIPMemoryManager *memory_manager;
+#if LWIP_ETHERNET && EMAC_RX_BATCH
+        EmacRxBatch *emac_rx_batch = nullptr; /**< Frames queued for the tcpip thread, NULL to post them one by one */
+#endif
     };
 
     /** Register a network interface with the IP stack
@@ -467,6 +477,41 @@ protected:
     nsapi_size_or_error_t socket_recv(nsapi_socket_t handle,
                                       void *data, nsapi_size_t size) override;
 
+    /** Get the memory manager of the stack's buffers
+     *
+     *  @return         Memory manager allocating pbufs
+     */
+    NetStackMemoryManager *get_memory_manager() override;
+
+    /** Send a pbuf chain over a TCP socket without copying
+     *
+     *  The payloads are referenced by the TCP segments and the chain is
+     *  freed once the remote host acknowledges the last byte. The chain is
+     *  only accepted if it fits in the send buffer.
+     *
+     *  This call is non-blocking. If send would block,
+     *  NSAPI_ERROR_WOULD_BLOCK is returned immediately.
+     *
+     *  @param handle   Socket handle
+     *  @param buf      pbuf chain to send, owned by the stack unless an
+     *                  error is returned
+     *  @return         Number of bytes queued on success, negative error
+     *                  code on failure
+     */
+    nsapi_size_or_error_t socket_send_buf(nsapi_socket_t handle, net_stack_mem_buf_t *buf) override;
+
+    /** Receive data over a TCP socket as the pbuf chain it arrived in
+     *
+     *  This call is non-blocking. If recv would block,
+     *  NSAPI_ERROR_WOULD_BLOCK is returned immediately.
+     *
+     *  @param handle   Socket handle
+     *  @param buf      Destination for the received pbuf chain
+     *  @return         Number of received bytes on success, negative error
+     *                  code on failure
+     */
+    nsapi_size_or_error_t socket_recv_buf(nsapi_socket_t handle, net_stack_mem_buf_t **buf) override;
+
     /** Send a packet over a UDP socket
      *
      *  Sends data to the specified address. Returns the number of bytes
@@ -503,6 +548,37 @@ protected:
     nsapi_size_or_error_t socket_recvfrom(nsapi_socket_t handle, SocketAddress *address,
                                           void *buffer, nsapi_size_t size) override;
 
+    /** Send data gathered from several buffers over a socket
+     *
+     *  TCP sends the buffers with a single netconn vector write. UDP chains
+     *  a reference pbuf per buffer into one datagram, without copying.
+     *
+     *  This call is non-blocking. If sendmsg would block,
+     *  NSAPI_ERROR_WOULD_BLOCK is returned immediately.
+     *
+     *  @param handle   Socket handle
+     *  @param address  The SocketAddress of the remote host, or NULL for TCP
+     *  @param iov      Buffers of data to send to the host
+     *  @return         Number of sent bytes on success, negative error
+     *                  code on failure
+     */
+    nsapi_size_or_error_t socket_sendmsg(nsapi_socket_t handle, const SocketAddress *address,
+                                         mbed::Span<const nsapi_iovec_t> iov) override;
+
+    /** Receive data over a socket, scattered into several buffers
+     *
+     *  This call is non-blocking. If recvmsg would block,
+     *  NSAPI_ERROR_WOULD_BLOCK is returned immediately.
+     *
+     *  @param handle   Socket handle
+     *  @param address  Destination for the source address, or NULL for TCP
+     *  @param iov      Destination buffers for data received from the host
+     *  @return         Number of received bytes on success, negative error
+     *                  code on failure
+     */
+    nsapi_size_or_error_t socket_recvmsg(nsapi_socket_t handle, SocketAddress *address,
+                                         mbed::Span<const nsapi_iovec_t> iov) override;
+
     /** Register a callback on state change of the socket
      *
      *  The specified callback will be called on state changes such as when
@@ -582,16 +658,35 @@ private:
      */
     nsapi_error_t call_in(int delay, mbed::Callback<void()> func) override;
 
+    // Zero-copy chains sent and not yet acknowledged, per socket
+    static const int TCP_TX_REF_COUNT = 4;
+
     struct mbed_lwip_socket {
         bool in_use;
+        struct mbed_lwip_socket *next_free;
 
         struct netconn *conn;
         struct pbuf *buf;
         u16_t offset;
 
+        struct {
+            struct pbuf *p;
+            u32_t end;      // Sequence number after the last byte of the chain
+        } tx_ref[TCP_TX_REF_COUNT];
+
         void (*cb)(void *);
         void *data;
 
+        // Receive window of a TCP socket, and its send buffer or 0 for TCP_SND_BUF
+        u32_t rcv_wnd;
+        u32_t snd_buf;
+        bool rcv_wnd_set;       // Set by NSAPI_RCVBUF, which stops the autotuning
+        u32_t rcv_wnd_withheld; // Window not given back to the peer to keep to rcv_wnd
+#if TCP_WND_AUTOTUNE
+        u32_t tune_bytes;       // Bytes received since tune_start
+        u32_t tune_start;
+#endif
+
         // Track multicast addresses subscribed to by this socket
         nsapi_ip_mreq_t *multicast_memberships;
         uint32_t         multicast_memberships_count;
@@ -612,8 +707,9 @@ private:
 
     static void add_dns_addr(struct netif *lwip_netif, const char *interface_name);
 
-    /* Static arena of sockets */
+    /* Static arena of sockets, the free ones linked from arena_free */
     struct mbed_lwip_socket arena[MEMP_NUM_NETCONN];
+    struct mbed_lwip_socket *arena_free;
     void arena_init(void);
     struct mbed_lwip_socket *arena_alloc();
     void arena_dealloc(struct mbed_lwip_socket *s);
@@ -646,6 +742,12 @@ private:
     static int32_t find_multicast_member(const struct mbed_lwip_socket *s, const nsapi_ip_mreq_t *imr);
 
     static void socket_callback(struct netconn *nc, enum netconn_evt eh, u16_t len);
+    static bool socket_release_tx_refs(struct mbed_lwip_socket *s, bool all);
+    static void socket_set_rcv_wnd(struct mbed_lwip_socket *s, u32_t wnd);
+    static void socket_tcp_recvd(struct mbed_lwip_socket *s, u32_t len);
+    static err_t socket_recv_tcp_pbuf(struct mbed_lwip_socket *s);
+    static u32_t socket_tcp_send_space(const struct mbed_lwip_socket *s);
+    nsapi_error_t socket_sendto_netbuf(struct mbed_lwip_socket *s, const SocketAddress &address, struct netbuf *buf);
 
     static void tcpip_init_irq(void *handle);
     static void tcpip_thread_callback(void *ptr);
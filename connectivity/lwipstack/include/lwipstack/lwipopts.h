@@ -85,6 +85,26 @@
 
 #define MEMP_NUM_TCPIP_MSG_INPKT    MBED_CONF_LWIP_MEMP_NUM_TCPIP_MSG_INPKT
 
+// Run netconn API calls in the calling thread under the tcpip core lock rather than
+// posting each one to the tcpip thread and waiting for it
+#ifdef MBED_CONF_LWIP_TCPIP_CORE_LOCKING
+#define LWIP_TCPIP_CORE_LOCKING     MBED_CONF_LWIP_TCPIP_CORE_LOCKING
+#else
+#define LWIP_TCPIP_CORE_LOCKING     1
+#endif
+
+#ifdef LWIP_DEBUG
+// Trap core functions called without the core lock (or outside the tcpip thread)
+#define LWIP_ASSERT_CORE_LOCKED()   sys_check_core_locking()
+#endif
+
+// Received Ethernet frames queued per tcpip thread message, 0 to post each frame on its own
+#ifdef MBED_CONF_LWIP_EMAC_RX_BATCH
+#define EMAC_RX_BATCH               MBED_CONF_LWIP_EMAC_RX_BATCH
+#else
+#define EMAC_RX_BATCH               8
+#endif
+
 // Thread stacks use 8-byte alignment
 #define LWIP_ALIGN_UP(pos, align) ((pos) % (align) ? (pos) +  ((align) - (pos) % (align)) : (pos))
 
@@ -130,6 +150,19 @@
 // TCP sender buffer space (bytes).
 #define TCP_WND                     MBED_CONF_LWIP_TCP_WND
 
+// Grow the receive window of TCP sockets, from TCP_WND_AUTOTUNE_MIN up to TCP_WND,
+// while they receive nearly a whole window per round trip
+#ifdef MBED_CONF_LWIP_TCP_WND_AUTOTUNE
+#define TCP_WND_AUTOTUNE            MBED_CONF_LWIP_TCP_WND_AUTOTUNE
+#else
+#define TCP_WND_AUTOTUNE            0
+#endif
+
+#define TCP_WND_AUTOTUNE_MIN        LWIP_MIN(4 * TCP_MSS, TCP_WND)
+
+// Round trip time assumed until one is measured
+#define TCP_WND_AUTOTUNE_RTT_MS     200
+
 #define TCP_MAXRTX                  MBED_CONF_LWIP_TCP_MAXRTX
 
 #define TCP_SYNMAXRTX               MBED_CONF_LWIP_TCP_SYNMAXRTX
@@ -153,6 +186,21 @@
 
 #define MEM_SIZE                    MBED_CONF_LWIP_MEM_SIZE
 
+// Keep the heap and pools out of the .bss zeroed at boot, the pools are then
+// zeroed when the stack is initialized.
+#if defined(MBED_CONF_LWIP_MEMORY_NOINIT) && MBED_CONF_LWIP_MEMORY_NOINIT
+#include "mbed_toolchain.h"
+#define LWIP_DECLARE_MEMORY_ALIGNED(variable_name, size) MBED_NOINIT u8_t variable_name[LWIP_MEM_ALIGN_BUFFER(size)]
+#define MEMP_MEM_INIT               1
+#endif
+
+// Allocate the pools below from the heap of MEM_SIZE bytes rather than
+// reserving each one statically. The MEMP_NUM_ counts are then no longer
+// limits, the heap is, so that the RAM of idle socket pcbs is not reserved.
+#if defined(MBED_CONF_LWIP_MEMP_MEM_MALLOC) && MBED_CONF_LWIP_MEMP_MEM_MALLOC
+#define MEMP_MEM_MALLOC             1
+#endif
+
 // One tcp_pcb_listen is needed for each TCP server.
 // Each requires 72 bytes of RAM.
 #define MEMP_NUM_TCP_PCB_LISTEN     MBED_CONF_LWIP_TCP_SERVER_MAX
@@ -183,6 +231,12 @@
 
 #define TCP_CLOSE_TIMEOUT            MBED_CONF_LWIP_TCP_CLOSE_TIMEOUT
 
+// Closed connections keep their tcp_pcb, but not their socket, in TIME_WAIT
+// for twice this. When no tcp_pcb is free, the oldest in TIME_WAIT is reused.
+#ifdef MBED_CONF_LWIP_TCP_MSL
+#define TCP_MSL                      MBED_CONF_LWIP_TCP_MSL
+#endif
+
 #else
 #define LWIP_TCP                    0
 #endif
@@ -320,6 +374,9 @@
 // Checksum-on-copy disabled due to https://savannah.nongnu.org/bugs/?50914
 #define LWIP_CHECKSUM_ON_COPY       0
 
+// Lets EMAC drivers take over checksums they offload to hardware
+#define LWIP_CHECKSUM_CTRL_PER_NETIF 1
+
 #define LWIP_NETIF_HOSTNAME         1
 #define LWIP_NETIF_STATUS_CALLBACK  1
 #define LWIP_NETIF_LINK_CALLBACK    1
@@ -14,11 +14,14 @@
 */
 #if defined(TOOLCHAIN_GCC) && defined(__thumb2__)
 
+#include "mbed_toolchain.h"
+
 
 /* This is a hand written Thumb-2 assembly language version of the
    algorithm 3 version of lwip_standard_chksum in lwIP's inet_chksum.c.  It
-   performs the checksumming 32-bits at a time and even unrolls the loop to
-   perform two of these 32-bit adds per loop iteration.
+   performs the checksumming 32-bits at a time, 32 bytes per loop iteration
+   loaded with two load multiples and summed in a single chain of add with
+   carry, then two 32-bit adds per loop iteration for what is left.
    
    Returns:
         16-bit 1's complement summation (not inversed).
@@ -27,15 +30,15 @@
          but is marked as void so that GCC doesn't issue warning because it
          doesn't know about this low level return.
 */
-__attribute__((naked)) void /*uint16_t*/ thumb2_checksum(const void* pData, int length)
+MBED_HOT __attribute__((naked)) void /*uint16_t*/ thumb2_checksum(const void* pData, int length)
 {
     __asm (
         ".syntax unified\n"
         ".thumb\n"
 
-        // Push non-volatile registers we use on stack.  Push link register too to
-        // keep stack 8-byte aligned and allow single pop to restore and return.
-        "    push        {r4, lr}\n"
+        // Push non-volatile registers we use on stack, 4 of them to keep the
+        // stack 8-byte aligned.
+        "    push    {r4-r7}\n"
         // Initialize sum, r2, to 0.
         "    movs    r2, #0\n"
         // Remember whether pData was at odd address in r3.  This is used later to
@@ -69,9 +72,32 @@ __attribute__((naked)) void /*uint16_t*/ thumb2_checksum(const void* pData, int
         "    adds    r2, r2, r4\n"
         "    subs    r1, r1, #2\n"
 
+        // Burst summing loop which sums up data 8 words at a time.  The carry of
+        // each add goes in the next one, the last carry is applied twice as
+        // adding it can carry again.
+        // Make sure that we have more than 31 bytes left to sum.
+        "2$:\n"
+        "    cmp     r1, #32\n"
+        "    blt     5$\n"
+        "4$: ldmia   r0!, {r4-r7}\n"
+        "    adds    r2, r2, r4\n"
+        "    adcs    r2, r2, r5\n"
+        "    adcs    r2, r2, r6\n"
+        "    adcs    r2, r2, r7\n"
+        "    ldmia   r0!, {r4-r7}\n"
+        "    adcs    r2, r2, r4\n"
+        "    adcs    r2, r2, r5\n"
+        "    adcs    r2, r2, r6\n"
+        "    adcs    r2, r2, r7\n"
+        "    adcs    r2, r2, #0\n"
+        "    adc     r2, r2, #0\n"
+        "    subs    r1, r1, #32\n"
+        "    cmp     r1, #32\n"
+        "    bge     4$\n"
+
         // Main summing loop which sums up data 2 words at a time.
         // Make sure that we have more than 7 bytes left to sum.
-        "2$:\n"
+        "5$:\n"
         "    cmp     r1, #8\n"
         "    blt     3$\n"
         // Sum next two words.  Applying previous upper 16-bit carry to
@@ -83,7 +109,7 @@ __attribute__((naked)) void /*uint16_t*/ thumb2_checksum(const void* pData, int
         "    adds    r2, r4\n"
         "    adc     r2, r2, #0\n"
         "    subs    r1, r1, #8\n"
-        "    b       2$\n"
+        "    b       5$\n"
 
         // Sum up any remaining half-words.
         "3$:\n"
@@ -119,7 +145,8 @@ __attribute__((naked)) void /*uint16_t*/ thumb2_checksum(const void* pData, int
 
         // Return final sum.
         "9$: mov     r0, r2\n"
-        "    pop     {r4, pc}\n"
+        "    pop     {r4-r7}\n"
+        "    bx      lr\n"
     );
 }
 
@@ -15,21 +15,43 @@
 #if defined(TOOLCHAIN_GCC) && defined(__thumb2__)
 
 #include <stdio.h>
+#include "mbed_toolchain.h"
 
 
 /* This is a hand written Thumb-2 assembly language version of the
    standard C memcpy() function that can be used by the lwIP networking
-   stack to improve its performance.  It copies 4 bytes at a time and
-   unrolls the loop to perform 4 of these copies per loop iteration.
+   stack to improve its performance.  When the source and the destination
+   are both word aligned, it copies 32 bytes per loop iteration with load and
+   store multiples.  Otherwise and for what is left, it copies 4 bytes at a
+   time and unrolls the loop to perform 4 of these copies per loop iteration.
 */
-__attribute__((naked)) void thumb2_memcpy(void* pDest, const void* pSource, size_t length)
+MBED_HOT __attribute__((naked)) void thumb2_memcpy(void* pDest, const void* pSource, size_t length)
 {
     __asm (
         ".syntax unified\n"
         ".thumb\n"
 
-        // Copy 16 bytes at a time first.
-        "    lsrs    r3, r2, #4\n"
+        // Copy 32 bytes at a time first if there are that many and both
+        // pointers are word aligned, the load and store multiples would fault
+        // otherwise.
+        "    cmp     r2, #32\n"
+        "    blo.n   5$\n"
+        "    orr     r3, r0, r1\n"
+        "    tst     r3, #3\n"
+        "    bne.n   5$\n"
+        "    push    {r4-r7}\n"
+        "    lsrs    r3, r2, #5\n"
+        "6$: ldmia   r1!, {r4-r7}\n"
+        "    stmia   r0!, {r4-r7}\n"
+        "    ldmia   r1!, {r4-r7}\n"
+        "    stmia   r0!, {r4-r7}\n"
+        "    subs    r3, #1\n"
+        "    bne     6$\n"
+        "    pop     {r4-r7}\n"
+        "    and     r2, r2, #0x1f\n"
+
+        // Copy 16 bytes at a time.
+        "5$: lsrs    r3, r2, #4\n"
         "    beq.n   2$\n"
         "1$: ldr     r12, [r1], #4\n"
         "    str     r12, [r0], #4\n"
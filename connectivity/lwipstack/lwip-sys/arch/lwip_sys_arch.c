@@ -27,6 +27,7 @@
 #include "lwip/debug.h"
 #include "lwip/def.h"
 #include "lwip/sys.h"
+#include "lwip/tcpip.h"
 #include "lwip/mem.h"
 
 /* Define the heap ourselves to give us section placement control */
@@ -387,6 +388,8 @@ void sys_sem_free(sys_sem_t *sem) {}
 err_t sys_mutex_new(sys_mutex_t *mutex) {
     memset(mutex, 0, sizeof(*mutex));
     mutex->attr.name = "lwip_mutex";
+    // The tcpip core lock is taken by application threads of any priority
+    mutex->attr.attr_bits = osMutexPrioInherit;
     mutex->attr.cb_mem = &mutex->data;
     mutex->attr.cb_size = sizeof(mutex->data);
     mutex->id = osMutexNew(&mutex->attr);
@@ -497,6 +500,26 @@ bool sys_tcpip_thread_check(void)
     return osThreadGetId() == lwip_tcpip_thread_id;
 }
 
+#if LWIP_TCPIP_CORE_LOCKING
+void sys_check_core_locking(void)
+{
+    // The core lock only exists once tcpip_init() has run
+    if (lock_tcpip_core.id == NULL) {
+        return;
+    }
+    if (osMutexGetOwner(lock_tcpip_core.id) != osThreadGetId()) {
+        MBED_ERROR(MBED_MAKE_ERROR(MBED_MODULE_NETWORK_STACK, MBED_ERROR_CODE_MUTEX_LOCK_FAILED), "lwIP core used without the tcpip core lock\n");
+    }
+}
+#else
+void sys_check_core_locking(void)
+{
+    if (lwip_tcpip_thread_id && !sys_tcpip_thread_check()) {
+        MBED_ERROR(MBED_MAKE_ERROR(MBED_MODULE_NETWORK_STACK, MBED_ERROR_CODE_INVALID_OPERATION), "lwIP core used outside the tcpip thread\n");
+    }
+}
+#endif
+
 // Keep a pool of thread structures
 static int thread_pool_index = 0;
 static sys_thread_data_t thread_pool[SYS_THREAD_POOL_N];
@@ -89,6 +89,7 @@ typedef int sys_prot_t;
 
 void sys_tcpip_thread_set(void);
 bool sys_tcpip_thread_check(void);
+void sys_check_core_locking(void);
 
 #else
 #ifdef  __cplusplus
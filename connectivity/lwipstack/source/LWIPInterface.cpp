@@ -475,6 +475,9 @@ void LWIP::Interface::delete_interface(OnboardNetworkStack::Interface **interfac
             if (lwip->list == lwip) {
 
                 lwip->list = lwip->list->next;
+#if EMAC_RX_BATCH
+                emac_rx_batch_delete(node);
+#endif
                 netif_remove(&node->netif);
                 *interface_out = NULL;
                 delete node;
@@ -485,6 +488,9 @@ void LWIP::Interface::delete_interface(OnboardNetworkStack::Interface **interfac
                 if (node->next != NULL && node->next == lwip) {
                     Interface *remove = node->next;
                     node->next = node->next->next;
+#if EMAC_RX_BATCH
+                    emac_rx_batch_delete(remove);
+#endif
                     netif_remove(&remove->netif);
                     *interface_out = NULL;
                     delete remove;
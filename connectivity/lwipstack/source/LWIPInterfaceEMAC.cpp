@@ -15,16 +15,34 @@
  * limitations under the License.
  */
 
+#include <new>
 #include "lwip/tcpip.h"
+#include "lwip/sys.h"
 #include "lwip/tcp.h"
 #include "lwip/ip.h"
 #include "netif/etharp.h"
+#include "netif/ethernet.h"
 #include "lwip/ethip6.h"
 #include "netsocket/nsapi_types.h"
 #include "netsocket/EMAC.h"
 
 #include "LWIPStack.h"
 
+#if LWIP_CHECKSUM_CTRL_PER_NETIF
+// EMAC checksum offload flags map one-to-one onto the lwIP ones
+static_assert(EMAC::CHECKSUM_OFFLOAD_TX_IP == NETIF_CHECKSUM_GEN_IP &&
+              EMAC::CHECKSUM_OFFLOAD_TX_UDP == NETIF_CHECKSUM_GEN_UDP &&
+              EMAC::CHECKSUM_OFFLOAD_TX_TCP == NETIF_CHECKSUM_GEN_TCP &&
+              EMAC::CHECKSUM_OFFLOAD_TX_ICMP == NETIF_CHECKSUM_GEN_ICMP &&
+              EMAC::CHECKSUM_OFFLOAD_TX_ICMP6 == NETIF_CHECKSUM_GEN_ICMP6 &&
+              EMAC::CHECKSUM_OFFLOAD_RX_IP == NETIF_CHECKSUM_CHECK_IP &&
+              EMAC::CHECKSUM_OFFLOAD_RX_UDP == NETIF_CHECKSUM_CHECK_UDP &&
+              EMAC::CHECKSUM_OFFLOAD_RX_TCP == NETIF_CHECKSUM_CHECK_TCP &&
+              EMAC::CHECKSUM_OFFLOAD_RX_ICMP == NETIF_CHECKSUM_CHECK_ICMP &&
+              EMAC::CHECKSUM_OFFLOAD_RX_ICMP6 == NETIF_CHECKSUM_CHECK_ICMP6,
+              "EMAC checksum offload flags out of sync with lwIP");
+#endif
+
 #if LWIP_ETHERNET
 
 err_t LWIP::Interface::emac_low_level_output(struct netif *netif, struct pbuf *p)
@@ -38,10 +56,150 @@ err_t LWIP::Interface::emac_low_level_output(struct netif *netif, struct pbuf *p
     return ret ? ERR_OK : ERR_IF;
 }
 
+#if EMAC_RX_BATCH
+
+/* Frames queued by the EMAC driver thread and drained in the tcpip thread,
+ * so a burst costs one mailbox post instead of one per frame.
+ */
+struct LWIP::Interface::EmacRxBatch {
+    struct tcpip_callback_msg *msg; /**< Preallocated, so posting never allocates */
+    Interface *owner;               /**< NULL once the interface has been removed */
+    struct pbuf *frames[EMAC_RX_BATCH];
+    unsigned head;
+    unsigned count;
+    bool posted;                    /**< A drain call is waiting in the tcpip mailbox */
+};
+
+void LWIP::Interface::emac_rx_batch_new(Interface *interface)
+{
+    EmacRxBatch *batch = new (std::nothrow) EmacRxBatch();
+    if (!batch) {
+        return;
+    }
+
+    batch->msg = tcpip_callbackmsg_new(&LWIP::Interface::emac_input_batch, batch);
+    if (!batch->msg) {
+        delete batch;
+        return;
+    }
+
+    batch->owner = interface;
+    interface->emac_rx_batch = batch;
+}
+
+void LWIP::Interface::emac_rx_batch_delete(Interface *interface)
+{
+    EmacRxBatch *batch = interface->emac_rx_batch;
+    if (!batch) {
+        return;
+    }
+    interface->emac_rx_batch = NULL;
+
+    SYS_ARCH_DECL_PROTECT(lev);
+    SYS_ARCH_PROTECT(lev);
+    batch->owner = NULL;
+    while (batch->count) {
+        pbuf_free(batch->frames[batch->head]);
+        batch->head = (batch->head + 1) % EMAC_RX_BATCH;
+        batch->count--;
+    }
+    bool posted = batch->posted;
+    SYS_ARCH_UNPROTECT(lev);
+
+    /* A pending drain call still refers to the batch, it frees it instead */
+    if (!posted) {
+        tcpip_callbackmsg_delete(batch->msg);
+        delete batch;
+    }
+}
+
+void LWIP::Interface::emac_rx_batch_post(EmacRxBatch *batch)
+{
+    if (tcpip_callbackmsg_trycallback(batch->msg) == ERR_OK) {
+        return;
+    }
+
+    /* Mailbox full: wait for room rather than strand the queued frames */
+    if (tcpip_callback(&LWIP::Interface::emac_input_batch, batch) != ERR_OK) {
+        LWIP_DEBUGF(NETIF_DEBUG, ("Emac LWIP: input batch post error\n"));
+
+        SYS_ARCH_DECL_PROTECT(lev);
+        SYS_ARCH_PROTECT(lev);
+        batch->posted = false;
+        SYS_ARCH_UNPROTECT(lev);
+    }
+}
+
+void LWIP::Interface::emac_input_batch(void *ctx)
+{
+    EmacRxBatch *batch = static_cast<EmacRxBatch *>(ctx);
+
+    if (!batch->owner) {
+        tcpip_callbackmsg_delete(batch->msg);
+        delete batch;
+        return;
+    }
+
+    /* Bounded, so timers and API calls queued behind us get their turn under load */
+    for (unsigned budget = EMAC_RX_BATCH; budget > 0; budget--) {
+        struct pbuf *p;
+
+        SYS_ARCH_DECL_PROTECT(lev);
+        SYS_ARCH_PROTECT(lev);
+        if (batch->count == 0) {
+            batch->posted = false;
+            SYS_ARCH_UNPROTECT(lev);
+            return;
+        }
+        p = batch->frames[batch->head];
+        batch->head = (batch->head + 1) % EMAC_RX_BATCH;
+        batch->count--;
+        SYS_ARCH_UNPROTECT(lev);
+
+        /* Already in the tcpip thread, so skip tcpip_input */
+        if (ethernet_input(p, &batch->owner->netif) != ERR_OK) {
+            LWIP_DEBUGF(NETIF_DEBUG, ("Emac LWIP: IP input error\n"));
+
+            pbuf_free(p);
+        }
+    }
+
+    emac_rx_batch_post(batch);
+}
+
+#endif // EMAC_RX_BATCH
+
 void LWIP::Interface::emac_input(emac_mem_buf_t *buf)
 {
     struct pbuf *p = static_cast<struct pbuf *>(buf);
 
+#if EMAC_RX_BATCH
+    if (emac_rx_batch) {
+        EmacRxBatch *batch = emac_rx_batch;
+        bool post = false;
+
+        SYS_ARCH_DECL_PROTECT(lev);
+        SYS_ARCH_PROTECT(lev);
+        if (batch->count < EMAC_RX_BATCH) {
+            batch->frames[(batch->head + batch->count) % EMAC_RX_BATCH] = p;
+            batch->count++;
+            post = !batch->posted;
+            batch->posted = true;
+            p = NULL;
+        }
+        SYS_ARCH_UNPROTECT(lev);
+
+        if (p) {
+            LWIP_DEBUGF(NETIF_DEBUG, ("Emac LWIP: input batch full\n"));
+
+            pbuf_free(p);
+        } else if (post) {
+            emac_rx_batch_post(batch);
+        }
+        return;
+    }
+#endif
+
     /* pass all packets to ethernet_input, which decides what packets it supports */
     if (netif.input(p, &netif) != ERR_OK) {
         LWIP_DEBUGF(NETIF_DEBUG, ("Emac LWIP: IP input error\n"));
@@ -159,6 +317,11 @@ err_t LWIP::Interface::emac_if_init(struct netif *netif)
 
     mbed_if->emac->get_ifname(netif->name, NSAPI_INTERFACE_PREFIX_SIZE);
 
+#if LWIP_CHECKSUM_CTRL_PER_NETIF
+    /* Only compute and check in software what the EMAC doesn't do in hardware */
+    NETIF_SET_CHECKSUM_CTRL(netif, NETIF_CHECKSUM_ENABLE_ALL & ~mbed_if->emac->get_checksum_offload());
+#endif
+
 #if LWIP_IPV4
     netif->output = etharp_output;
 #if LWIP_IGMP
@@ -179,6 +342,12 @@ err_t LWIP::Interface::emac_if_init(struct netif *netif)
 
     netif->linkoutput = &LWIP::Interface::emac_low_level_output;
 
+#if EMAC_RX_BATCH
+    if (!mbed_if->emac_rx_batch) {
+        emac_rx_batch_new(mbed_if);
+    }
+#endif
+
     return err;
 }
 
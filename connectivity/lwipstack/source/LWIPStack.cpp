@@ -20,6 +20,7 @@
 #include "Semaphore.h"
 #include <stdio.h>
 #include <stdbool.h>
+#include <stddef.h>
 #include <string.h>
 
 #include "lwip/opt.h"
@@ -29,6 +30,7 @@
 #include "lwip/dhcp.h"
 #include "lwip/tcpip.h"
 #include "lwip/tcp.h"
+#include "lwip/memp.h"
 #include "lwip/ip.h"
 #include "lwip/mld6.h"
 #include "lwip/igmp.h"
@@ -46,6 +48,13 @@
 #define LWIP_SOCKET_MAX_MEMBERSHIPS 4
 #endif
 
+// Period of tcp_slowtmr(), the unit of the pcb round trip time estimate.
+// TCP_TMR_INTERVAL is private to the lwIP core, which defaults it to 250
+#ifndef TCP_TMR_INTERVAL
+#define TCP_TMR_INTERVAL 250
+#endif
+#define LWIP_TCP_SLOW_INTERVAL_MS (2 * TCP_TMR_INTERVAL)
+
 void LWIP::socket_callback(struct netconn *nc, enum netconn_evt eh, u16_t len)
 {
     // Filter send minus events
@@ -60,17 +69,198 @@ void LWIP::socket_callback(struct netconn *nc, enum netconn_evt eh, u16_t len)
         lwip._event_flag.set(TCP_CLOSED_FLAG);
     }
 
+    // A netconn belongs to a single socket
     for (int i = 0; i < MEMP_NUM_NETCONN; i++) {
-        if (lwip.arena[i].in_use
-                && lwip.arena[i].conn == nc
-                && lwip.arena[i].cb) {
-            lwip.arena[i].cb(lwip.arena[i].data);
+        struct mbed_lwip_socket *s = &lwip.arena[i];
+        if (!s->in_use || s->conn != nc) {
+            continue;
+        }
+#if LWIP_TCP
+        // Called with the core locked, as are all TCP callbacks
+        if (eh == NETCONN_EVT_SENDPLUS && NETCONNTYPE_GROUP(nc->type) == NETCONN_TCP) {
+            socket_release_tx_refs(s, false);
         }
+#endif
+        if (s->cb) {
+            s->cb(s->data);
+        }
+        break;
     }
 
     lwip.adaptation.unlock();
 }
 
+#if LWIP_TCP
+// Free the zero-copy chains the remote host has acknowledged, or all of them.
+// Must be called with the core locked. Returns true if some chains remain.
+bool LWIP::socket_release_tx_refs(struct mbed_lwip_socket *s, bool all)
+{
+    // Without a pcb the segments referencing the chains are gone
+    struct tcp_pcb *pcb = s->conn->pcb.tcp;
+    bool remaining = false;
+
+    for (int i = 0; i < TCP_TX_REF_COUNT; i++) {
+        if (!s->tx_ref[i].p) {
+            continue;
+        }
+        if (all || !pcb || (int32_t)(s->tx_ref[i].end - pcb->lastack) <= 0) {
+            pbuf_free(s->tx_ref[i].p);
+            s->tx_ref[i].p = NULL;
+        } else {
+            remaining = true;
+        }
+    }
+    return remaining;
+}
+
+// Number of segments tcp_write() splits the buffer of a chain into
+static u32_t tcp_send_buf_segments(struct tcp_pcb *pcb, const struct pbuf *q)
+{
+    u32_t mss_local = LWIP_MIN(pcb->mss, pcb->snd_wnd_max / 2);
+    if (mss_local == 0) {
+        mss_local = pcb->mss ? pcb->mss : 1;
+    }
+    return q->len / mss_local + 1;
+}
+
+// Send queue entries taken by the chain, each segment holds a header pbuf and
+// a reference to the data
+static u32_t tcp_send_buf_queuelen(struct tcp_pcb *pcb, const struct pbuf *p)
+{
+    u32_t queuelen = 0;
+    for (const struct pbuf *q = p; q; q = q->next) {
+        queuelen += 2 * tcp_send_buf_segments(pcb, q);
+    }
+    return queuelen;
+}
+
+// Check that tcp_write() will accept every buffer of the chain without copying
+static bool tcp_send_buf_fits(struct tcp_pcb *pcb, const struct pbuf *p)
+{
+    return p->tot_len <= tcp_sndbuf(pcb) &&
+           tcp_sndqueuelen(pcb) + tcp_send_buf_queuelen(pcb, p) <= TCP_SND_QUEUELEN;
+}
+
+// Check that the memory tcp_write() allocates for the chain is available, so
+// that it does not fail part way and leave a hole in the byte stream. The
+// segments and data references are only allocated under the core lock, the
+// headers come from the heap, which other threads may take meanwhile.
+static bool tcp_send_buf_alloc_check(struct tcp_pcb *pcb, const struct pbuf *p)
+{
+    // Largest TCP options, as the header pbufs hold them
+    const u16_t max_option_bytes = 40;
+    void *segs = NULL;
+    struct pbuf *pbufs = NULL;
+    bool ok = true;
+
+    for (const struct pbuf *q = p; q && ok; q = q->next) {
+        // One more data reference in case the buffer extends the last segment
+        for (u32_t i = tcp_send_buf_segments(pcb, q); i > 0 && ok; i--) {
+            void *seg = memp_malloc(MEMP_TCP_SEG);
+            struct pbuf *ref = pbuf_alloc(PBUF_RAW, 0, PBUF_ROM);
+            struct pbuf *hdr = pbuf_alloc(PBUF_TRANSPORT, max_option_bytes, PBUF_RAM);
+            struct pbuf *ext = i == 1 ? pbuf_alloc(PBUF_RAW, 0, PBUF_ROM) : NULL;
+            ok = seg && ref && hdr && (i != 1 || ext);
+            if (seg) {
+                *(void **)seg = segs;
+                segs = seg;
+            }
+            struct pbuf *allocated[] = { ref, hdr, ext };
+            for (struct pbuf *a : allocated) {
+                if (a) {
+                    a->next = pbufs;
+                    pbufs = a;
+                }
+            }
+        }
+    }
+
+    while (segs) {
+        void *next = *(void **)segs;
+        memp_free(MEMP_TCP_SEG, segs);
+        segs = next;
+    }
+    while (pbufs) {
+        struct pbuf *next = pbufs->next;
+        pbufs->next = NULL;
+        pbuf_free(pbufs);
+        pbufs = next;
+    }
+    return ok;
+}
+#endif
+
+#if LWIP_TCP
+void LWIP::socket_set_rcv_wnd(struct mbed_lwip_socket *s, u32_t wnd)
+{
+    s->rcv_wnd = wnd;
+
+    struct tcp_pcb *pcb = s->conn->pcb.tcp;
+    if (pcb && pcb->state == CLOSED) {
+        // Not known to the stack yet, the window can be set before it is announced
+        pcb->rcv_wnd = pcb->rcv_ann_wnd = (tcpwnd_size_t)wnd;
+        s->rcv_wnd_withheld = TCP_WND - wnd;
+    } else {
+        socket_tcp_recvd(s, 0);
+    }
+}
+
+// Give the window of the data taken from the socket back to the peer, but for
+// what the socket window withholds
+void LWIP::socket_tcp_recvd(struct mbed_lwip_socket *s, u32_t len)
+{
+#if TCP_WND_AUTOTUNE
+    struct tcp_pcb *pcb = s->conn->pcb.tcp;
+    if (!s->rcv_wnd_set && len && pcb) {
+        u32_t now = sys_now();
+        u32_t rtt_ms = pcb->sa > 0 ? (pcb->sa >> 3) * LWIP_TCP_SLOW_INTERVAL_MS : TCP_WND_AUTOTUNE_RTT_MS;
+
+        s->tune_bytes += len;
+        if (now - s->tune_start >= rtt_ms) {
+            // Nearly a whole window in a round trip, the window limits the transfer
+            if (4 * s->tune_bytes >= 3 * s->rcv_wnd) {
+                s->rcv_wnd = LWIP_MIN(2 * s->rcv_wnd, TCP_WND);
+            }
+            s->tune_bytes = 0;
+            s->tune_start = now;
+        }
+    }
+#endif
+
+    u32_t withheld = TCP_WND - s->rcv_wnd;
+    u32_t total = len + s->rcv_wnd_withheld;
+    if (total > withheld) {
+        s->rcv_wnd_withheld = withheld;
+        netconn_tcp_recvd(s->conn, total - withheld);
+    } else {
+        s->rcv_wnd_withheld = total;
+    }
+}
+
+err_t LWIP::socket_recv_tcp_pbuf(struct mbed_lwip_socket *s)
+{
+    err_t err = netconn_recv_tcp_pbuf_flags(s->conn, &s->buf, NETCONN_NOAUTORCVD);
+    s->offset = 0;
+
+    if (err == ERR_OK) {
+        socket_tcp_recvd(s, s->buf->tot_len);
+    }
+    return err;
+}
+
+// Bytes that can be queued on the socket without going over its send buffer
+u32_t LWIP::socket_tcp_send_space(const struct mbed_lwip_socket *s)
+{
+    struct tcp_pcb *pcb = s->conn->pcb.tcp;
+    if (!s->snd_buf || !pcb) {
+        return TCP_SND_BUF;
+    }
+
+    u32_t queued = TCP_SND_BUF - tcp_sndbuf(pcb);
+    return queued < s->snd_buf ? s->snd_buf - queued : 0;
+}
+#endif
+
 void LWIP::tcpip_init_irq(void *eh)
 {
     static_cast<rtos::Semaphore *>(eh)->release();
@@ -272,6 +462,12 @@ nsapi_error_t LWIP::socket_open(nsapi_socket_t *handle, nsapi_protocol_t proto)
         return NSAPI_ERROR_NO_SOCKET;
     }
 
+#if LWIP_TCP
+    if (proto == NSAPI_TCP) {
+        socket_set_rcv_wnd(s, TCP_WND_AUTOTUNE ? TCP_WND_AUTOTUNE_MIN : TCP_WND);
+    }
+#endif
+
     netconn_set_nonblocking(s->conn, true);
     *(struct mbed_lwip_socket **)handle = s;
     return 0;
@@ -290,6 +486,19 @@ nsapi_error_t LWIP::socket_close(nsapi_socket_t handle)
         netconn_shutdown(s->conn, false, true);
         _event_flag.wait_any(TCP_CLOSED_FLAG, TCP_CLOSE_TIMEOUT);
     }
+
+#if LWIP_TCPIP_CORE_LOCKING
+    if (NETCONNTYPE_GROUP(s->conn->type) == NETCONN_TCP) {
+        // Segments still referencing zero-copy chains are dropped with
+        // the connection before the chains are freed
+        LOCK_TCPIP_CORE();
+        if (socket_release_tx_refs(s, false) && s->conn->pcb.tcp) {
+            tcp_abort(s->conn->pcb.tcp);
+        }
+        socket_release_tx_refs(s, true);
+        UNLOCK_TCPIP_CORE();
+    }
+#endif
 #endif
     if (s->buf) {
         pbuf_free(s->buf);
@@ -377,6 +586,11 @@ nsapi_error_t LWIP::socket_accept(nsapi_socket_t server, nsapi_socket_t *handle,
         return err_remap(err);
     }
 
+    // The window was announced in full, it shrinks to the listener's as data is taken
+    ns->rcv_wnd_set = s->rcv_wnd_set;
+    ns->snd_buf = s->snd_buf;
+    socket_set_rcv_wnd(ns, s->rcv_wnd);
+
     netconn_set_nonblocking(ns->conn, true);
     *(struct mbed_lwip_socket **)handle = ns;
 
@@ -402,6 +616,14 @@ nsapi_size_or_error_t LWIP::socket_send(nsapi_socket_t handle, const void *data,
     struct mbed_lwip_socket *s = (struct mbed_lwip_socket *)handle;
     size_t bytes_written = 0;
 
+#if LWIP_TCP
+    u32_t space = socket_tcp_send_space(s);
+    if (space == 0) {
+        return NSAPI_ERROR_WOULD_BLOCK;
+    }
+    size = LWIP_MIN(size, space);
+#endif
+
     err_t err = netconn_write_partly(s->conn, data, size, NETCONN_COPY, &bytes_written);
     if (err != ERR_OK) {
         return err_remap(err);
@@ -416,9 +638,7 @@ nsapi_size_or_error_t LWIP::socket_recv(nsapi_socket_t handle, void *data, nsapi
     struct mbed_lwip_socket *s = (struct mbed_lwip_socket *)handle;
 
     if (!s->buf) {
-        err_t err = netconn_recv_tcp_pbuf(s->conn, &s->buf);
-        s->offset = 0;
-
+        err_t err = socket_recv_tcp_pbuf(s);
         if (err != ERR_OK) {
             return err_remap(err);
         }
@@ -438,13 +658,120 @@ nsapi_size_or_error_t LWIP::socket_recv(nsapi_socket_t handle, void *data, nsapi
 #endif
 }
 
-nsapi_size_or_error_t LWIP::socket_sendto(nsapi_socket_t handle, const SocketAddress &address, const void *data, nsapi_size_t size)
+NetStackMemoryManager *LWIP::get_memory_manager()
 {
+    return &memory_manager;
+}
+
+nsapi_size_or_error_t LWIP::socket_send_buf(nsapi_socket_t handle, net_stack_mem_buf_t *buf)
+{
+    // Needs the core lock to queue bare pcb writes from the caller's thread
+#if LWIP_TCP && LWIP_TCPIP_CORE_LOCKING
     struct mbed_lwip_socket *s = (struct mbed_lwip_socket *)handle;
+    struct pbuf *p = static_cast<struct pbuf *>(buf);
+    nsapi_size_or_error_t ret;
+
+    if (NETCONNTYPE_GROUP(s->conn->type) != NETCONN_TCP) {
+        return NSAPI_ERROR_UNSUPPORTED;
+    }
+    if (!p || p->tot_len == 0) {
+        return NSAPI_ERROR_PARAMETER;
+    }
+
+    LOCK_TCPIP_CORE();
+    struct tcp_pcb *pcb = s->conn->pcb.tcp;
+    int slot = -1;
+    socket_release_tx_refs(s, false);
+    for (int i = 0; i < TCP_TX_REF_COUNT; i++) {
+        if (!s->tx_ref[i].p) {
+            slot = i;
+            break;
+        }
+    }
+
+    if (!pcb || (pcb->state != ESTABLISHED && pcb->state != CLOSE_WAIT)) {
+        ret = NSAPI_ERROR_NO_CONNECTION;
+    } else if (p->tot_len > TCP_SND_BUF || tcp_send_buf_queuelen(pcb, p) > TCP_SND_QUEUELEN) {
+        // Would not fit even in an empty send queue
+        ret = NSAPI_ERROR_PARAMETER;
+    } else if (slot < 0 || s->conn->current_msg || !tcp_send_buf_fits(pcb, p) || !socket_tcp_send_space(s) ||
+               !tcp_send_buf_alloc_check(pcb, p)) {
+        ret = NSAPI_ERROR_WOULD_BLOCK;
+    } else {
+        u16_t sent = 0;
+        ret = NSAPI_ERROR_OK;
+        for (struct pbuf *q = p; q; q = q->next) {
+            if (q->len == 0) {
+                continue;
+            }
+            if (tcp_write(pcb, q->payload, q->len, q->next ? TCP_WRITE_FLAG_MORE : 0) != ERR_OK) {
+                ret = NSAPI_ERROR_NO_MEMORY;
+                break;
+            }
+            sent += q->len;
+        }
+
+        if (ret == NSAPI_ERROR_OK) {
+            s->tx_ref[slot].p = p;
+            s->tx_ref[slot].end = pcb->snd_lbb;
+            tcp_output(pcb);
+            ret = sent;
+        } else if (sent) {
+            // The heap ran out after the check. Queued segments can't be taken
+            // back, so reset the connection rather than send a stream with a
+            // hole in it. Aborting frees the segments, the caller keeps the chain.
+            tcp_abort(pcb);
+        } else {
+            ret = NSAPI_ERROR_WOULD_BLOCK;
+        }
+    }
+    UNLOCK_TCPIP_CORE();
+
+    return ret;
+#else
+    return NSAPI_ERROR_UNSUPPORTED;
+#endif
+}
+
+nsapi_size_or_error_t LWIP::socket_recv_buf(nsapi_socket_t handle, net_stack_mem_buf_t **buf)
+{
+#if LWIP_TCP
+    struct mbed_lwip_socket *s = (struct mbed_lwip_socket *)handle;
+
+    if (NETCONNTYPE_GROUP(s->conn->type) != NETCONN_TCP) {
+        return NSAPI_ERROR_UNSUPPORTED;
+    }
+
+    if (!s->buf) {
+        err_t err = socket_recv_tcp_pbuf(s);
+        if (err != ERR_OK) {
+            return err_remap(err);
+        }
+    }
+
+    // Hand over what a previous socket_recv() left of the chain
+    struct pbuf *p = s->buf;
+    if (s->offset) {
+        p = pbuf_free_header(p, s->offset);
+    }
+    s->buf = 0;
+    s->offset = 0;
+
+    *buf = p;
+    return p->tot_len;
+#else
+    return NSAPI_ERROR_UNSUPPORTED;
+#endif
+}
+
+nsapi_error_t LWIP::socket_sendto_netbuf(struct mbed_lwip_socket *s, const SocketAddress &address, struct netbuf *buf)
+{
     ip_addr_t ip_addr;
+    err_t err;
 
     nsapi_addr_t addr = address.get_addr();
     if (!convert_mbed_addr_to_lwip(&ip_addr, &addr)) {
+        netbuf_delete(buf);
         return NSAPI_ERROR_PARAMETER;
     }
     struct netif *netif_ = netif_get_by_index(s->conn->pcb.ip->netif_idx);
@@ -454,9 +781,19 @@ nsapi_size_or_error_t LWIP::socket_sendto(nsapi_socket_t handle, const SocketAdd
     if (netif_) {
         if ((addr.version == NSAPI_IPv4 && !get_ipv4_addr(netif_)) ||
                 (addr.version == NSAPI_IPv6 && !get_ipv6_addr(netif_) && !get_ipv6_link_local_addr(netif_))) {
+            netbuf_delete(buf);
             return NSAPI_ERROR_PARAMETER;
         }
     }
+
+    err = netconn_sendto(s->conn, buf, &ip_addr, address.get_port());
+    netbuf_delete(buf);
+    return err_remap(err);
+}
+
+nsapi_size_or_error_t LWIP::socket_sendto(nsapi_socket_t handle, const SocketAddress &address, const void *data, nsapi_size_t size)
+{
+    struct mbed_lwip_socket *s = (struct mbed_lwip_socket *)handle;
     struct netbuf *buf = netbuf_new();
 
     err_t err = netbuf_ref(buf, data, (u16_t)size);
@@ -465,10 +802,9 @@ nsapi_size_or_error_t LWIP::socket_sendto(nsapi_socket_t handle, const SocketAdd
         return err_remap(err);
     }
 
-    err = netconn_sendto(s->conn, buf, &ip_addr, address.get_port());
-    netbuf_delete(buf);
-    if (err != ERR_OK) {
-        return err_remap(err);
+    nsapi_error_t ret = socket_sendto_netbuf(s, address, buf);
+    if (ret != NSAPI_ERROR_OK) {
+        return ret;
     }
 
     return size;
@@ -497,6 +833,135 @@ nsapi_size_or_error_t LWIP::socket_recvfrom(nsapi_socket_t handle, SocketAddress
     return recv;
 }
 
+nsapi_size_or_error_t LWIP::socket_sendmsg(nsapi_socket_t handle, const SocketAddress *address,
+                                           mbed::Span<const nsapi_iovec_t> iov)
+{
+    struct mbed_lwip_socket *s = (struct mbed_lwip_socket *)handle;
+
+#if LWIP_TCP
+    if (NETCONNTYPE_GROUP(s->conn->type) == NETCONN_TCP) {
+        // netconn takes vectors laid out like struct iovec, as nsapi_iovec_t is
+        static_assert(sizeof(struct netvector) == sizeof(nsapi_iovec_t)
+                      && offsetof(struct netvector, ptr) == offsetof(nsapi_iovec_t, iov_base)
+                      && offsetof(struct netvector, len) == offsetof(nsapi_iovec_t, iov_len),
+                      "nsapi_iovec_t does not match struct netvector");
+        struct netvector *vectors = reinterpret_cast<struct netvector *>(const_cast<nsapi_iovec_t *>(iov.data()));
+        u16_t count = (u16_t)LWIP_MIN(iov.size(), 0xFFFF);
+
+        if (!socket_tcp_send_space(s)) {
+            return NSAPI_ERROR_WOULD_BLOCK;
+        }
+
+        size_t bytes_written = 0;
+        err_t err = netconn_write_vectors_partly(s->conn, vectors, count, NETCONN_COPY, &bytes_written);
+        if (err != ERR_OK) {
+            return err_remap(err);
+        }
+        return (nsapi_size_or_error_t)bytes_written;
+    }
+#endif
+
+    if (!address) {
+        return NSAPI_ERROR_NO_ADDRESS;
+    }
+
+    size_t size = 0;
+    for (const nsapi_iovec_t &v : iov) {
+        size += v.iov_len;
+    }
+    if (size > 0xFFFF) {
+        return NSAPI_ERROR_PARAMETER;
+    }
+
+    // Chain a reference to each buffer, the datagram is only copied by the driver
+    struct netbuf *buf = netbuf_new();
+    err_t err = netbuf_ref(buf, iov.empty() ? NULL : iov[0].iov_base, iov.empty() ? 0 : (u16_t)iov[0].iov_len);
+    if (err != ERR_OK) {
+        netbuf_delete(buf);
+        return err_remap(err);
+    }
+    for (const nsapi_iovec_t &v : iov.subspan(iov.empty() ? 0 : 1)) {
+        if (v.iov_len == 0) {
+            continue;
+        }
+        struct pbuf *p = pbuf_alloc_reference(v.iov_base, (u16_t)v.iov_len, PBUF_REF);
+        if (!p) {
+            netbuf_delete(buf);
+            return NSAPI_ERROR_NO_MEMORY;
+        }
+        pbuf_cat(buf->p, p);
+    }
+
+    nsapi_error_t ret = socket_sendto_netbuf(s, *address, buf);
+    if (ret != NSAPI_ERROR_OK) {
+        return ret;
+    }
+
+    return size;
+}
+
+nsapi_size_or_error_t LWIP::socket_recvmsg(nsapi_socket_t handle, SocketAddress *address,
+                                           mbed::Span<const nsapi_iovec_t> iov)
+{
+    struct mbed_lwip_socket *s = (struct mbed_lwip_socket *)handle;
+    nsapi_size_t recv = 0;
+
+#if LWIP_TCP
+    if (NETCONNTYPE_GROUP(s->conn->type) == NETCONN_TCP) {
+        if (!s->buf) {
+            err_t err = socket_recv_tcp_pbuf(s);
+            if (err != ERR_OK) {
+                return err_remap(err);
+            }
+        }
+
+        // Fill the buffers from what is left of the current pbuf chain
+        for (const nsapi_iovec_t &v : iov) {
+            if (!s->buf) {
+                break;
+            }
+            u16_t len = (u16_t)LWIP_MIN(v.iov_len, 0xFFFF);
+            u16_t copied = pbuf_copy_partial(s->buf, v.iov_base, len, s->offset);
+            s->offset += copied;
+            recv += copied;
+            if (s->offset >= s->buf->tot_len) {
+                pbuf_free(s->buf);
+                s->buf = 0;
+            }
+            if (copied < len) {
+                break;
+            }
+        }
+        return recv;
+    }
+#endif
+
+    struct netbuf *buf;
+    err_t err = netconn_recv(s->conn, &buf);
+    if (err != ERR_OK) {
+        return err_remap(err);
+    }
+
+    if (address) {
+        nsapi_addr_t addr;
+        convert_lwip_addr_to_mbed(&addr, netbuf_fromaddr(buf));
+        address->set_addr(addr);
+        address->set_port(netbuf_fromport(buf));
+    }
+
+    // Whatever does not fit in the buffers is dropped, as with recvfrom
+    for (const nsapi_iovec_t &v : iov) {
+        u16_t len = (u16_t)LWIP_MIN(v.iov_len, 0xFFFF);
+        recv += pbuf_copy_partial(buf->p, v.iov_base, len, (u16_t)recv);
+        if (recv >= buf->p->tot_len) {
+            break;
+        }
+    }
+    netbuf_delete(buf);
+
+    return recv;
+}
+
 int32_t LWIP::find_multicast_member(const struct mbed_lwip_socket *s, const nsapi_ip_mreq_t *imr)
 {
     uint32_t count = 0;
@@ -553,6 +1018,30 @@ nsapi_error_t LWIP::setsockopt(nsapi_socket_t handle, int level, int optname, co
 
             s->conn->pcb.tcp->keep_intvl = *(int *)optval;
             return 0;
+
+        case NSAPI_RCVBUF:
+            if (optlen != sizeof(int) || NETCONNTYPE_GROUP(s->conn->type) != NETCONN_TCP) {
+                return NSAPI_ERROR_UNSUPPORTED;
+            }
+            if (*(const int *)optval <= 0) {
+                return NSAPI_ERROR_PARAMETER;
+            }
+
+            // The window can not go over TCP_WND, nor below a segment
+            s->rcv_wnd_set = true;
+            socket_set_rcv_wnd(s, LWIP_MIN(LWIP_MAX((u32_t) * (const int *)optval, (u32_t)TCP_MSS), (u32_t)TCP_WND));
+            return 0;
+
+        case NSAPI_SNDBUF:
+            if (optlen != sizeof(int) || NETCONNTYPE_GROUP(s->conn->type) != NETCONN_TCP) {
+                return NSAPI_ERROR_UNSUPPORTED;
+            }
+            if (*(const int *)optval <= 0) {
+                return NSAPI_ERROR_PARAMETER;
+            }
+
+            s->snd_buf = LWIP_MIN(LWIP_MAX((u32_t) * (const int *)optval, (u32_t)TCP_MSS), (u32_t)TCP_SND_BUF);
+            return 0;
 #endif
 
         case NSAPI_REUSEADDR:
@@ -678,7 +1167,41 @@ nsapi_error_t LWIP::setsockopt(nsapi_socket_t handle, int level, int optname, co
 
 nsapi_error_t LWIP::getsockopt(nsapi_socket_t handle, int level, int optname, void *optval, unsigned *optlen)
 {
-    return NSAPI_ERROR_UNSUPPORTED;
+    struct mbed_lwip_socket *s = (struct mbed_lwip_socket *)handle;
+
+    switch (optname) {
+#if LWIP_TCP
+        case NSAPI_TCP_INFO: {
+            if (*optlen < sizeof(nsapi_tcp_info_t) || NETCONNTYPE_GROUP(s->conn->type) != NETCONN_TCP) {
+                return NSAPI_ERROR_UNSUPPORTED;
+            }
+
+            struct tcp_pcb *pcb = s->conn->pcb.tcp;
+            if (!pcb || pcb->state == LISTEN) {
+                return NSAPI_ERROR_NO_CONNECTION;
+            }
+
+            // lwIP keeps the smoothed round trip time scaled by 8, in slow timer ticks
+            nsapi_tcp_info_t *info = (nsapi_tcp_info_t *)optval;
+            info->rtt_ms = pcb->sa > 0 ? (pcb->sa >> 3) * LWIP_TCP_SLOW_INTERVAL_MS : 0;
+            info->send_queue = TCP_SND_BUF - tcp_sndbuf(pcb);
+            *optlen = sizeof(nsapi_tcp_info_t);
+            return 0;
+        }
+
+        case NSAPI_RCVBUF:
+        case NSAPI_SNDBUF:
+            if (*optlen < sizeof(int) || NETCONNTYPE_GROUP(s->conn->type) != NETCONN_TCP) {
+                return NSAPI_ERROR_UNSUPPORTED;
+            }
+
+            *(int *)optval = optname == NSAPI_RCVBUF ? s->rcv_wnd : (s->snd_buf ? s->snd_buf : TCP_SND_BUF);
+            *optlen = sizeof(int);
+            return 0;
+#endif
+        default:
+            return NSAPI_ERROR_UNSUPPORTED;
+    }
 }
 
 
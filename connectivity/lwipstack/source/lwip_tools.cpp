@@ -182,6 +182,12 @@ const ip_addr_t *LWIP::get_ip_addr(bool any_addr, const struct netif *netif)
 void LWIP::arena_init(void)
 {
     memset(arena, 0, sizeof(arena));
+
+    arena_free = NULL;
+    for (int i = MEMP_NUM_NETCONN - 1; i >= 0; i--) {
+        arena[i].next_free = arena_free;
+        arena_free = &arena[i];
+    }
 }
 
 struct LWIP::mbed_lwip_socket *LWIP::arena_alloc()
@@ -190,23 +196,22 @@ struct LWIP::mbed_lwip_socket *LWIP::arena_alloc()
 
     lwip.adaptation.lock();
 
-    for (int i = 0; i < MEMP_NUM_NETCONN; i++) {
-        if (!arena[i].in_use) {
-            struct mbed_lwip_socket *s = &arena[i];
-            memset(s, 0, sizeof(*s));
-            s->in_use = true;
-            lwip.adaptation.unlock();
-            return s;
-        }
+    struct mbed_lwip_socket *s = arena_free;
+    if (s) {
+        arena_free = s->next_free;
+        memset(s, 0, sizeof(*s));
+        s->in_use = true;
     }
 
     lwip.adaptation.unlock();
 
-    return 0;
+    return s;
 }
 
 void LWIP::arena_dealloc(struct mbed_lwip_socket *s)
 {
+    LWIP &lwip = LWIP::get_instance();
+
     s->in_use = false;
 
     while (s->multicast_memberships_count > 0) {
@@ -220,6 +225,11 @@ void LWIP::arena_dealloc(struct mbed_lwip_socket *s)
 
     free(s->multicast_memberships);
     s->multicast_memberships = NULL;
+
+    lwip.adaptation.lock();
+    s->next_free = arena_free;
+    arena_free = s;
+    lwip.adaptation.unlock();
 }
 
 bool convert_lwip_addr_to_mbed(nsapi_addr_t *out, const ip_addr_t *in)
@@ -676,10 +676,32 @@
             "umaal  r1, %2, %3, r0      \n\t"   \
             "str    r1, [%1], #4        \n\t"
 
+/*
+ * Two limbs at a time, with loads and stores bunched: on Cortex-M4 and M7
+ * an access to the word after the previous one takes a single cycle.
+ * Post-increment on back-to-back loads of the same base register stalls
+ * some cores, so only the first load of each pair writes the base back.
+ */
+#define MULADDC_PAIR                            \
+            "ldr    r0, [%0], #8        \n\t"   \
+            "ldr    r2, [%1], #8        \n\t"   \
+            "ldr    r1, [%0, #-4]       \n\t"   \
+            "ldr    r3, [%1, #-4]       \n\t"   \
+            "umaal  r2, %2, %3, r0      \n\t"   \
+            "umaal  r3, %2, %3, r1      \n\t"   \
+            "str    r2, [%1, #-8]       \n\t"   \
+            "str    r3, [%1, #-4]       \n\t"
+
+#define MULADDC_HUIT                            \
+            MULADDC_PAIR                        \
+            MULADDC_PAIR                        \
+            MULADDC_PAIR                        \
+            MULADDC_PAIR
+
 #define MULADDC_STOP                            \
          : "=r" (s),  "=r" (d), "=r" (c)        \
          : "r" (b), "0" (s), "1" (d), "2" (c)   \
-         : "r0", "r1", "memory"                 \
+         : "r0", "r1", "r2", "r3", "memory"     \
          );
 
 #else
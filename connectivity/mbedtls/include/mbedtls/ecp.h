@@ -288,6 +288,11 @@ mbedtls_ecp_group;
  *
  * The cost is increasing EC peak memory usage by a factor roughly 2.
  *
+ * For secp256r1 and secp384r1 with MBEDTLS_ECP_WINDOW_SIZE of 4 or more,
+ * the table is a constant in ecp_curves.c instead, costing flash but no
+ * RAM or first-use time. It holds the same number of points as the table
+ * that would otherwise be computed at runtime.
+ *
  * Change this value to 0 to reduce peak memory usage.
  */
 #define MBEDTLS_ECP_FIXED_POINT_OPTIM  1   /**< Enable fixed-point speed-up. */
@@ -0,0 +1,167 @@
+/*
+ *  crypto_engine.h
+ *
+ *  Copyright (C) 2021, Arm Limited, All Rights Reserved
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ */
+
+#ifndef CRYPTO_ENGINE_H
+#define CRYPTO_ENGINE_H
+
+/*
+ * Queue in front of a DMA-capable crypto accelerator, for the
+ * MBEDTLS_*_ALT drivers in connectivity/drivers/mbedtls.
+ *
+ * An engine is one hardware block (an AES or a HASH unit). Jobs use it one
+ * at a time, in submission order:
+ *
+ * - a submitted job has a start function, run once the engine is free.
+ *   It programs the hardware and starts the DMA, and the backend calls
+ *   crypto_engine_complete() from the DMA interrupt when it is done, which
+ *   starts the next job straight from the interrupt.
+ * - an acquired job belongs to a thread, which drives the hardware itself
+ *   until crypto_engine_release(). This suits the multi-step mbed TLS
+ *   stream APIs. The owner may still start DMA transfers, and sleep until
+ *   the backend calls crypto_engine_complete().
+ *
+ * Waiting threads block on a semaphore, so the CPU runs other threads while
+ * the accelerator works. Without an RTOS waiting is a busy loop.
+ */
+
+#include <stddef.h>
+
+#if defined(MBED_CONF_RTOS_PRESENT)
+#include "cmsis_os2.h"
+#include "mbed_rtos_storage.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CRYPTO_ENGINE_PENDING 1  /**< job status until it is done */
+
+typedef struct crypto_engine_job crypto_engine_job_t;
+
+/**
+ * \brief       Start a submitted job on the hardware
+ *
+ * \note        May be called from the interrupt completing the previous job.
+ *
+ * \return      0 if the transfer started, or an mbed TLS error code, which
+ *              completes the job at once.
+ */
+typedef int (*crypto_engine_start_t)(crypto_engine_job_t *job);
+
+/**
+ * \brief       Called when a job completes, before the next job starts.
+ *              Typically saves the hardware context of the job.
+ */
+typedef void (*crypto_engine_finish_t)(crypto_engine_job_t *job);
+
+struct crypto_engine_job {
+    crypto_engine_job_t *next;
+    crypto_engine_start_t start;    /*!< NULL for an acquired job */
+    crypto_engine_finish_t finish;  /*!< optional */
+    void *ctx;                      /*!< for the start and finish functions */
+    volatile int status;            /*!< CRYPTO_ENGINE_PENDING, 0 or an error */
+#if defined(MBED_CONF_RTOS_PRESENT)
+    osSemaphoreId_t sem;
+    mbed_rtos_storage_semaphore_t sem_obj;
+#endif
+};
+
+typedef struct crypto_engine {
+    crypto_engine_job_t *head;      /*!< job owning the hardware */
+    crypto_engine_job_t *tail;
+} crypto_engine_t;
+
+/**
+ * \brief       Initialize a job
+ *
+ * \param job   Job, usually on the stack of the caller
+ * \param start Start function, or NULL for crypto_engine_acquire()
+ * \param finish Finish function, or NULL
+ * \param ctx   Context of the start and finish functions
+ */
+void crypto_engine_job_init(crypto_engine_job_t *job,
+                            crypto_engine_start_t start,
+                            crypto_engine_finish_t finish,
+                            void *ctx);
+
+/**
+ * \brief       Free a job which is no longer queued
+ */
+void crypto_engine_job_free(crypto_engine_job_t *job);
+
+/**
+ * \brief       Queue a job and return without waiting for it
+ *
+ * \note        The job is started at once if the engine is free.
+ */
+void crypto_engine_submit(crypto_engine_t *engine, crypto_engine_job_t *job);
+
+/**
+ * \brief       Wait until a submitted job, or a transfer started by the
+ *              owner of an acquired job, completes
+ *
+ * \return      0 or the mbed TLS error code of the job
+ */
+int crypto_engine_wait(crypto_engine_job_t *job);
+
+/**
+ * \brief       Submit a job and wait for it
+ *
+ * \return      0 or the mbed TLS error code of the job
+ */
+int crypto_engine_run(crypto_engine_t *engine, crypto_engine_job_t *job);
+
+/**
+ * \brief       Wait for the engine and keep it until crypto_engine_release()
+ *
+ * \param job   Job initialized without a start function
+ */
+void crypto_engine_acquire(crypto_engine_t *engine, crypto_engine_job_t *job);
+
+/**
+ * \brief       Give the engine back to the next queued job
+ */
+void crypto_engine_release(crypto_engine_t *engine);
+
+/**
+ * \brief       Mark the start of a transfer by the owner of an acquired job,
+ *              before the hardware can complete it
+ */
+void crypto_engine_transfer(crypto_engine_job_t *job);
+
+/**
+ * \brief       Report that the hardware finished the current job or
+ *              transfer. Called by the backend, usually from an interrupt.
+ *
+ * \param status 0 or an mbed TLS error code
+ */
+void crypto_engine_complete(crypto_engine_t *engine, int status);
+
+/**
+ * \brief       Job owning the engine, or NULL when it is free
+ */
+crypto_engine_job_t *crypto_engine_current(crypto_engine_t *engine);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CRYPTO_ENGINE_H
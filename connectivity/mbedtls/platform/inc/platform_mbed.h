@@ -39,6 +39,12 @@
 
 #endif  // (defined(FEATURE_PSA) && defined(MBEDTLS_ENTROPY_NV_SEED))
 
+#if defined(MBED_CONF_NSAPI_TLS_VARIABLE_BUFFER_LENGTH) && MBED_CONF_NSAPI_TLS_VARIABLE_BUFFER_LENGTH
+/* Shrink the SSL I/O buffers to the negotiated maximum fragment length once
+ * the handshake is done, see TLSSocketWrapper::set_max_fragment_length() */
+#define MBEDTLS_SSL_VARIABLE_BUFFER_LENGTH
+#endif
+
 #if DEVICE_TRNG
 #define MBEDTLS_ENTROPY_HARDWARE_ALT
 #endif
@@ -31,6 +31,22 @@
 
 #define MBED_SHARED_RNG_NOT_INITIALIZED -1  /**< init_global_rng not called before global_rng */
 
+/* Bytes of entropy collected ahead by a low priority thread, so that seeding
+ * and reseeding the DRBG normally only copies them. Seeding takes 48 bytes
+ * and each reseed 32. 0 to poll the entropy sources on demand. Needs the RTOS */
+#ifndef MBED_CONF_MBEDTLS_ENTROPY_POOL_SIZE
+#define MBED_CONF_MBEDTLS_ENTROPY_POOL_SIZE 0
+#endif
+
+/* Stack size of the entropy collector thread */
+#ifndef MBED_CONF_MBEDTLS_ENTROPY_COLLECTOR_STACK_SIZE
+#define MBED_CONF_MBEDTLS_ENTROPY_COLLECTOR_STACK_SIZE 2048
+#endif
+
+#if (MBED_CONF_MBEDTLS_ENTROPY_POOL_SIZE > 0) && MBED_CONF_RTOS_PRESENT
+#define SHARED_RNG_POOL_ENABLED
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -38,6 +54,36 @@ extern "C" {
 #include "mbedtls/hmac_drbg.h"
 #include "mbedtls/entropy.h"
 
+/**
+ * \brief       Statistics of the entropy pool
+ */
+typedef struct {
+    size_t size;        /**< Size of the pool, 0 if it is disabled */
+    size_t level;       /**< Bytes currently in the pool */
+    uint32_t hits;      /**< Requests served from the pool */
+    uint32_t misses;    /**< Requests which had to poll the entropy sources */
+    uint32_t collected; /**< Bytes collected in the background */
+    uint32_t errors;    /**< Failed collections */
+} global_entropy_pool_stats_t;
+
+/**
+ * \brief       Start collecting entropy in the background
+ *
+ * \note        Called by init_global_rng. Calling it earlier, at boot,
+ *              lets the pool fill before the DRBG is first seeded.
+ *
+ * \return      0 if successful, or
+ *              MBEDTLS_ERR_ENTROPY_SOURCE_FAILED if the collector could not be started.
+ */
+int start_global_entropy_pool();
+
+/**
+ * \brief       Get the statistics of the entropy pool
+ *
+ * \param stats Statistics to fill
+ */
+void get_global_entropy_pool_stats(global_entropy_pool_stats_t *stats);
+
 /**
  * \brief       Initializes hmac ready for rng
  *
@@ -81,6 +127,9 @@ mbedtls_hmac_drbg_context *get_global_hmac_drbg();
 /**
  * \brief       Getter function for global entropy context
  *
+ * \note        With the entropy pool enabled, its collector thread polls
+ *              the context concurrently.
+ *
  * \return      global entropy context
  */
 mbedtls_entropy_context *get_global_entropy();
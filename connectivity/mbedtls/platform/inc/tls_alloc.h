@@ -0,0 +1,135 @@
+/*
+ *  tls_alloc.h
+ *
+ *  Copyright (C) 2021, Arm Limited, All Rights Reserved
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ */
+
+#ifndef TLS_ALLOC_H
+#define TLS_ALLOC_H
+
+#if !defined(MBEDTLS_CONFIG_FILE)
+#include "config.h"
+#else
+#include MBEDTLS_CONFIG_FILE
+#endif
+
+#include "mbedtls/platform.h"
+
+/*
+ * Allocator for mbedtls_calloc() and mbedtls_free(), in front of the heap.
+ *
+ * - size-class pools serve small allocations in O(1), so long-lived small
+ *   objects (contexts, certificates, sessions) do not scatter over the heap.
+ * - a handshake arena is a single heap region, bump-allocated while a
+ *   thread runs a handshake step. mbedtls frees most of it by the end of the
+ *   handshake; the region goes back to the heap in one piece once its last
+ *   block is freed, instead of leaving holes.
+ *
+ * Allocations that fit neither go to the heap. Needs MBEDTLS_PLATFORM_MEMORY,
+ * and is only used once tls_alloc_init() has been called.
+ */
+#if defined(MBEDTLS_PLATFORM_MEMORY) && \
+    !(defined(MBEDTLS_PLATFORM_FREE_MACRO) && defined(MBEDTLS_PLATFORM_CALLOC_MACRO))
+#define TLS_ALLOC_ENABLED
+
+#include <stddef.h>
+
+/* Number of blocks of each pool. The pools are allocated by tls_alloc_init() */
+#ifndef MBED_CONF_MBEDTLS_POOL_BLOCKS_32
+#define MBED_CONF_MBEDTLS_POOL_BLOCKS_32    32
+#endif
+#ifndef MBED_CONF_MBEDTLS_POOL_BLOCKS_64
+#define MBED_CONF_MBEDTLS_POOL_BLOCKS_64    24
+#endif
+#ifndef MBED_CONF_MBEDTLS_POOL_BLOCKS_128
+#define MBED_CONF_MBEDTLS_POOL_BLOCKS_128   16
+#endif
+#ifndef MBED_CONF_MBEDTLS_POOL_BLOCKS_256
+#define MBED_CONF_MBEDTLS_POOL_BLOCKS_256   8
+#endif
+
+/* Size of a handshake arena, 0 for no arenas */
+#ifndef MBED_CONF_MBEDTLS_HANDSHAKE_ARENA_SIZE
+#define MBED_CONF_MBEDTLS_HANDSHAKE_ARENA_SIZE  8192
+#endif
+
+/* Number of arenas alive at the same time */
+#ifndef MBED_CONF_MBEDTLS_HANDSHAKE_ARENA_COUNT
+#define MBED_CONF_MBEDTLS_HANDSHAKE_ARENA_COUNT 2
+#endif
+
+#define TLS_ALLOC_ERR_NO_MEMORY -1  /**< the pools could not be allocated */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct tls_arena tls_arena_t;
+
+typedef struct {
+    size_t pool_allocs;     /*!< allocations served by the pools */
+    size_t arena_allocs;    /*!< allocations served by arenas */
+    size_t heap_allocs;     /*!< allocations which went to the heap */
+    size_t pool_in_use;     /*!< pool blocks currently allocated */
+} tls_alloc_stats_t;
+
+/**
+ * \brief       Allocate the pools and make mbedtls_calloc() and mbedtls_free()
+ *              use them. Call it before any other mbed TLS function.
+ *
+ * \return      0 if successful, or TLS_ALLOC_ERR_NO_MEMORY.
+ */
+int tls_alloc_init(void);
+
+/**
+ * \brief       Reserve a handshake arena
+ *
+ * \return      The arena, or NULL if tls_alloc_init() was not called, no
+ *              arena is free or the heap is exhausted. Callers go on without
+ *              an arena then.
+ */
+tls_arena_t *tls_arena_new(void);
+
+/**
+ * \brief       Serve the allocations of the calling thread from the arena,
+ *              until tls_arena_leave()
+ */
+void tls_arena_enter(tls_arena_t *arena);
+
+/**
+ * \brief       Stop serving the calling thread from the arena
+ */
+void tls_arena_leave(tls_arena_t *arena);
+
+/**
+ * \brief       Give up an arena. Its region goes back to the heap once the
+ *              blocks still allocated in it are freed.
+ */
+void tls_arena_release(tls_arena_t *arena);
+
+/**
+ * \brief       Get allocation statistics
+ */
+void tls_alloc_stats_get(tls_alloc_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MBEDTLS_PLATFORM_MEMORY */
+
+#endif // TLS_ALLOC_H
@@ -0,0 +1,181 @@
+/*
+ *  crypto_engine.c
+ *
+ *  Copyright (C) 2021, Arm Limited, All Rights Reserved
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ */
+
+#include "crypto_engine.h"
+#include "platform/mbed_assert.h"
+#include "platform/mbed_critical.h"
+
+static void job_signal(crypto_engine_job_t *job, int status)
+{
+    /* The waiter may free the job once signalled, do not touch it after */
+    job->status = status;
+#if defined(MBED_CONF_RTOS_PRESENT)
+    osSemaphoreRelease(job->sem);
+#endif
+}
+
+/* Remove the head job, returning the next one */
+static crypto_engine_job_t *engine_pop(crypto_engine_t *engine)
+{
+    crypto_engine_job_t *job = engine->head;
+    crypto_engine_job_t *next;
+
+    if (job->finish) {
+        job->finish(job);
+    }
+
+    core_util_critical_section_enter();
+    next = job->next;
+    engine->head = next;
+    if (!next) {
+        engine->tail = NULL;
+    }
+    core_util_critical_section_exit();
+
+    return next;
+}
+
+/* Start jobs from the head of the queue until one is running */
+static void engine_start(crypto_engine_t *engine, crypto_engine_job_t *job)
+{
+    while (job) {
+        if (!job->start) {
+            /* The owner of an acquired job drives the hardware itself */
+            job_signal(job, 0);
+            return;
+        }
+
+        int ret = job->start(job);
+        if (ret == 0) {
+            return;
+        }
+
+        crypto_engine_job_t *next = engine_pop(engine);
+        job_signal(job, ret);
+        job = next;
+    }
+}
+
+void crypto_engine_job_init(crypto_engine_job_t *job,
+                            crypto_engine_start_t start,
+                            crypto_engine_finish_t finish,
+                            void *ctx)
+{
+    job->next = NULL;
+    job->start = start;
+    job->finish = finish;
+    job->ctx = ctx;
+    job->status = 0;
+#if defined(MBED_CONF_RTOS_PRESENT)
+    osSemaphoreAttr_t attr = { 0 };
+    attr.cb_mem = &job->sem_obj;
+    attr.cb_size = sizeof(job->sem_obj);
+    job->sem = osSemaphoreNew(1, 0, &attr);
+    MBED_ASSERT(job->sem != NULL);
+#endif
+}
+
+void crypto_engine_job_free(crypto_engine_job_t *job)
+{
+#if defined(MBED_CONF_RTOS_PRESENT)
+    osSemaphoreDelete(job->sem);
+#endif
+}
+
+void crypto_engine_submit(crypto_engine_t *engine, crypto_engine_job_t *job)
+{
+    int idle;
+
+    job->next = NULL;
+    job->status = CRYPTO_ENGINE_PENDING;
+
+    core_util_critical_section_enter();
+    idle = engine->head == NULL;
+    if (idle) {
+        engine->head = job;
+    } else {
+        engine->tail->next = job;
+    }
+    engine->tail = job;
+    core_util_critical_section_exit();
+
+    if (idle) {
+        engine_start(engine, job);
+    }
+}
+
+int crypto_engine_wait(crypto_engine_job_t *job)
+{
+#if defined(MBED_CONF_RTOS_PRESENT)
+    osSemaphoreAcquire(job->sem, osWaitForever);
+#else
+    while (job->status == CRYPTO_ENGINE_PENDING) {
+    }
+#endif
+    return job->status;
+}
+
+int crypto_engine_run(crypto_engine_t *engine, crypto_engine_job_t *job)
+{
+    crypto_engine_submit(engine, job);
+    return crypto_engine_wait(job);
+}
+
+void crypto_engine_acquire(crypto_engine_t *engine, crypto_engine_job_t *job)
+{
+    MBED_ASSERT(job->start == NULL);
+    crypto_engine_submit(engine, job);
+    crypto_engine_wait(job);
+}
+
+void crypto_engine_release(crypto_engine_t *engine)
+{
+    MBED_ASSERT(engine->head && engine->head->start == NULL);
+    engine_start(engine, engine_pop(engine));
+}
+
+void crypto_engine_transfer(crypto_engine_job_t *job)
+{
+    job->status = CRYPTO_ENGINE_PENDING;
+}
+
+void crypto_engine_complete(crypto_engine_t *engine, int status)
+{
+    crypto_engine_job_t *job = engine->head;
+
+    if (!job) {
+        return;
+    }
+
+    if (!job->start) {
+        /* A transfer of the owner ended, the owner keeps the engine */
+        job_signal(job, status);
+        return;
+    }
+
+    crypto_engine_job_t *next = engine_pop(engine);
+    job_signal(job, status);
+    engine_start(engine, next);
+}
+
+crypto_engine_job_t *crypto_engine_current(crypto_engine_t *engine)
+{
+    return engine->head;
+}
@@ -23,21 +23,159 @@
 #if defined(MBEDTLS_SSL_CONF_RNG)
 
 #include "mbed_trace.h"
+#include <string.h>
+
+#if defined(SHARED_RNG_POOL_ENABLED)
+#include "mbedtls/platform_util.h"
+#include "platform/PlatformMutex.h"
+#include "platform/SingletonPtr.h"
+#include "rtos/ThisThread.h"
+#include "rtos/Thread.h"
+#include <new>
+#endif
 
 #define TRACE_GROUP "SRNG"
 
 mbedtls_hmac_drbg_context global_hmac_drbg;
 mbedtls_entropy_context global_entropy;
 static bool is_initialized = false;
+static bool entropy_initialized = false;
+
+#if defined(SHARED_RNG_POOL_ENABLED)
+
+#define POOL_FLAG_REFILL 1
+#define POOL_FLAG_STOP   2
+
+/* The pool is taken from its end, the collector appends to it */
+static unsigned char entropy_pool[MBED_CONF_MBEDTLS_ENTROPY_POOL_SIZE];
+static global_entropy_pool_stats_t pool_stats;
+static rtos::Thread *collector;
+/* Guards the pool and its statistics */
+static SingletonPtr<PlatformMutex> pool_mutex;
+/* Guards global_entropy, which polls the sources */
+static SingletonPtr<PlatformMutex> entropy_mutex;
+
+static int poll_entropy(unsigned char *output, size_t len)
+{
+    entropy_mutex->lock();
+    int ret = mbedtls_entropy_func(&global_entropy, output, len);
+    entropy_mutex->unlock();
+    return ret;
+}
+
+static void collect_entropy()
+{
+    unsigned char block[MBEDTLS_ENTROPY_BLOCK_SIZE];
+
+    while (!(rtos::ThisThread::flags_wait_any(POOL_FLAG_REFILL | POOL_FLAG_STOP) & POOL_FLAG_STOP)) {
+        while (true) {
+            pool_mutex->lock();
+            size_t room = sizeof(entropy_pool) - pool_stats.level;
+            pool_mutex->unlock();
+            if (!room) {
+                break;
+            }
+            if (room > sizeof(block)) {
+                room = sizeof(block);
+            }
+
+            int ret = poll_entropy(block, room);
+
+            pool_mutex->lock();
+            if (ret != 0) {
+                pool_stats.errors++;
+            } else if (pool_stats.level + room <= sizeof(entropy_pool)) {
+                memcpy(entropy_pool + pool_stats.level, block, room);
+                pool_stats.level += room;
+                pool_stats.collected += room;
+            }
+            pool_mutex->unlock();
+            mbedtls_platform_zeroize(block, sizeof(block));
+
+            if (ret != 0) {
+                tr_warning("entropy collection failed: -0x%x", -ret);
+                break;
+            }
+        }
+    }
+}
+
+/* Entropy callback of the DRBG: a copy from the pool when it holds enough */
+static int pool_entropy(void *, unsigned char *output, size_t len)
+{
+    pool_mutex->lock();
+    if (pool_stats.level >= len) {
+        pool_stats.level -= len;
+        memcpy(output, entropy_pool + pool_stats.level, len);
+        mbedtls_platform_zeroize(entropy_pool + pool_stats.level, len);
+        pool_stats.hits++;
+        pool_mutex->unlock();
+        collector->flags_set(POOL_FLAG_REFILL);
+        return 0;
+    }
+    pool_stats.misses++;
+    pool_mutex->unlock();
+
+    return poll_entropy(output, len);
+}
+
+#endif // SHARED_RNG_POOL_ENABLED
+
+int start_global_entropy_pool()
+{
+    if (!entropy_initialized) {
+        mbedtls_entropy_init(&global_entropy);
+        entropy_initialized = true;
+    }
+
+#if defined(SHARED_RNG_POOL_ENABLED)
+    if (collector) {
+        return 0;
+    }
+
+    collector = new (std::nothrow) rtos::Thread(osPriorityLow, MBED_CONF_MBEDTLS_ENTROPY_COLLECTOR_STACK_SIZE,
+                                                nullptr, "entropy_pool");
+    if (!collector || collector->start(collect_entropy) != osOK) {
+        tr_error("entropy collector could not be started");
+        delete collector;
+        collector = nullptr;
+        return MBEDTLS_ERR_ENTROPY_SOURCE_FAILED;
+    }
+    pool_stats.size = sizeof(entropy_pool);
+    collector->flags_set(POOL_FLAG_REFILL);
+#endif
+    return 0;
+}
+
+void get_global_entropy_pool_stats(global_entropy_pool_stats_t *stats)
+{
+#if defined(SHARED_RNG_POOL_ENABLED)
+    pool_mutex->lock();
+    *stats = pool_stats;
+    pool_mutex->unlock();
+#else
+    memset(stats, 0, sizeof(*stats));
+#endif
+}
 
 int init_global_rng()
 {
-    mbedtls_entropy_init(&global_entropy);
+    int ret = start_global_entropy_pool();
+    if (ret != 0) {
+        free_global_rng();
+        return ret;
+    }
     mbedtls_hmac_drbg_init(&global_hmac_drbg);
 
-    int ret = mbedtls_hmac_drbg_seed(&global_hmac_drbg,
-                                     mbedtls_md_info_from_type(MBEDTLS_MD_SHA256),
-                                     mbedtls_entropy_func, &global_entropy, NULL, 0);
+#if defined(SHARED_RNG_POOL_ENABLED)
+    ret = mbedtls_hmac_drbg_seed(&global_hmac_drbg,
+                                 mbedtls_md_info_from_type(MBEDTLS_MD_SHA256),
+                                 pool_entropy, NULL, NULL, 0);
+#else
+    ret = mbedtls_hmac_drbg_seed(&global_hmac_drbg,
+                                 mbedtls_md_info_from_type(MBEDTLS_MD_SHA256),
+                                 mbedtls_entropy_func, &global_entropy, NULL, 0);
+#endif
 
     if (ret != 0) {
         tr_error(" init_global_rng failed! mbedtls_hmac_drbg_seed returned -0x%x", -ret);
@@ -51,7 +189,22 @@ int init_global_rng()
 
 void free_global_rng()
 {
-    mbedtls_entropy_free(&global_entropy);
+#if defined(SHARED_RNG_POOL_ENABLED)
+    if (collector) {
+        collector->flags_set(POOL_FLAG_STOP);
+        collector->join();
+        delete collector;
+        collector = nullptr;
+    }
+    pool_mutex->lock();
+    mbedtls_platform_zeroize(entropy_pool, sizeof(entropy_pool));
+    memset(&pool_stats, 0, sizeof(pool_stats));
+    pool_mutex->unlock();
+#endif
+    if (entropy_initialized) {
+        mbedtls_entropy_free(&global_entropy);
+        entropy_initialized = false;
+    }
     mbedtls_hmac_drbg_free(&global_hmac_drbg);
     is_initialized = false;
 }
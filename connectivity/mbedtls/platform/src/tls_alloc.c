@@ -0,0 +1,339 @@
+/*
+ *  tls_alloc.c
+ *
+ *  Copyright (C) 2021, Arm Limited, All Rights Reserved
+ *  SPDX-License-Identifier: Apache-2.0
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License"); you may
+ *  not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ *  WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ */
+
+#include "tls_alloc.h"
+
+#if defined(TLS_ALLOC_ENABLED)
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "platform/mbed_critical.h"
+#if defined(MBED_CONF_RTOS_PRESENT)
+#include "cmsis_os2.h"
+#endif
+
+#define TLS_ALLOC_ALIGN         8
+#define TLS_ALLOC_ROUND(len)    (((len) + TLS_ALLOC_ALIGN - 1) & ~(size_t)(TLS_ALLOC_ALIGN - 1))
+
+/* Arena blocks start with their size, so the last one can be given back */
+#define TLS_ARENA_HEADER        TLS_ALLOC_ROUND(sizeof(size_t))
+#define TLS_ARENA_DATA(arena)   ((unsigned char *)(arena) + TLS_ALLOC_ROUND(sizeof(tls_arena_t)))
+
+#define TLS_POOL_COUNT          4
+
+typedef struct tls_pool_block {
+    struct tls_pool_block *next;
+} tls_pool_block_t;
+
+typedef struct {
+    size_t block_size;
+    size_t count;
+    unsigned char *base;
+    tls_pool_block_t *free_list;
+} tls_pool_t;
+
+struct tls_arena {
+    unsigned char *top;     /* first free byte */
+    unsigned char *end;
+    size_t live;            /* blocks allocated in the arena */
+    void *owner;            /* thread served, NULL when none */
+    int released;
+};
+
+static tls_pool_t pools[TLS_POOL_COUNT] = {
+    { 32, MBED_CONF_MBEDTLS_POOL_BLOCKS_32, NULL, NULL },
+    { 64, MBED_CONF_MBEDTLS_POOL_BLOCKS_64, NULL, NULL },
+    { 128, MBED_CONF_MBEDTLS_POOL_BLOCKS_128, NULL, NULL },
+    { 256, MBED_CONF_MBEDTLS_POOL_BLOCKS_256, NULL, NULL },
+};
+
+static unsigned char *pool_start;
+static unsigned char *pool_end;
+static int initialized;
+
+static tls_arena_t *arenas[MBED_CONF_MBEDTLS_HANDSHAKE_ARENA_COUNT];
+
+static tls_alloc_stats_t stats;
+
+static void *current_thread(void)
+{
+#if defined(MBED_CONF_RTOS_PRESENT)
+    return osThreadGetId();
+#else
+    return &arenas;
+#endif
+}
+
+static void *arena_alloc(size_t len)
+{
+    void *owner = current_thread();
+    void *ptr = NULL;
+    size_t total;
+    int i;
+
+    if (len > MBED_CONF_MBEDTLS_HANDSHAKE_ARENA_SIZE) {
+        return NULL;
+    }
+    total = TLS_ARENA_HEADER + TLS_ALLOC_ROUND(len);
+
+    core_util_critical_section_enter();
+    for (i = 0; i < MBED_CONF_MBEDTLS_HANDSHAKE_ARENA_COUNT; i++) {
+        tls_arena_t *arena = arenas[i];
+        if (arena && arena->owner == owner) {
+            if ((size_t)(arena->end - arena->top) >= total) {
+                *(size_t *) arena->top = total;
+                ptr = arena->top + TLS_ARENA_HEADER;
+                arena->top += total;
+                arena->live++;
+                stats.arena_allocs++;
+            }
+            break;
+        }
+    }
+    core_util_critical_section_exit();
+
+    return ptr;
+}
+
+/* Returns 0 if ptr is not an arena block */
+static int arena_free(void *ptr)
+{
+    unsigned char *block = (unsigned char *) ptr - TLS_ARENA_HEADER;
+    tls_arena_t *dead = NULL;
+    int found = 0;
+    int i;
+
+    core_util_critical_section_enter();
+    for (i = 0; i < MBED_CONF_MBEDTLS_HANDSHAKE_ARENA_COUNT; i++) {
+        tls_arena_t *arena = arenas[i];
+        if (arena && (unsigned char *) ptr > TLS_ARENA_DATA(arena) &&
+                (unsigned char *) ptr < arena->end) {
+            found = 1;
+            if (block + *(size_t *) block == arena->top) {
+                arena->top = block;
+            }
+            if (--arena->live == 0) {
+                arena->top = TLS_ARENA_DATA(arena);
+                if (arena->released) {
+                    arenas[i] = NULL;
+                    dead = arena;
+                }
+            }
+            break;
+        }
+    }
+    core_util_critical_section_exit();
+
+    free(dead);
+    return found;
+}
+
+static void *pool_alloc(size_t len)
+{
+    tls_pool_block_t *block = NULL;
+    int i;
+
+    core_util_critical_section_enter();
+    for (i = 0; i < TLS_POOL_COUNT; i++) {
+        /* An exhausted class borrows from the next one */
+        if (pools[i].block_size >= len && pools[i].free_list) {
+            block = pools[i].free_list;
+            pools[i].free_list = block->next;
+            stats.pool_allocs++;
+            stats.pool_in_use++;
+            break;
+        }
+    }
+    core_util_critical_section_exit();
+
+    return block;
+}
+
+static void pool_free(void *ptr)
+{
+    tls_pool_block_t *block = (tls_pool_block_t *) ptr;
+    int i;
+
+    for (i = TLS_POOL_COUNT - 1; i > 0; i--) {
+        if ((unsigned char *) ptr >= pools[i].base) {
+            break;
+        }
+    }
+
+    core_util_critical_section_enter();
+    block->next = pools[i].free_list;
+    pools[i].free_list = block;
+    stats.pool_in_use--;
+    core_util_critical_section_exit();
+}
+
+static void *tls_calloc(size_t n, size_t size)
+{
+    void *ptr;
+    size_t len;
+
+    if (n != 0 && size > SIZE_MAX / n) {
+        return NULL;
+    }
+    len = n * size;
+
+    if (len != 0) {
+        ptr = arena_alloc(len);
+        if (!ptr) {
+            ptr = pool_alloc(len);
+        }
+        if (ptr) {
+            memset(ptr, 0, len);
+            return ptr;
+        }
+    }
+
+    core_util_critical_section_enter();
+    stats.heap_allocs++;
+    core_util_critical_section_exit();
+    return calloc(n, size);
+}
+
+static void tls_free(void *ptr)
+{
+    if (!ptr) {
+        return;
+    }
+
+    if ((unsigned char *) ptr >= pool_start && (unsigned char *) ptr < pool_end) {
+        pool_free(ptr);
+    } else if (!arena_free(ptr)) {
+        free(ptr);
+    }
+}
+
+int tls_alloc_init(void)
+{
+    size_t total = 0;
+    unsigned char *p;
+    int i;
+
+    if (initialized) {
+        return 0;
+    }
+
+    for (i = 0; i < TLS_POOL_COUNT; i++) {
+        total += pools[i].block_size * pools[i].count;
+    }
+
+    if (total != 0) {
+        pool_start = malloc(total);
+        if (!pool_start) {
+            return TLS_ALLOC_ERR_NO_MEMORY;
+        }
+    }
+
+    p = pool_start;
+    for (i = 0; i < TLS_POOL_COUNT; i++) {
+        size_t j;
+        pools[i].base = p;
+        for (j = 0; j < pools[i].count; j++) {
+            tls_pool_block_t *block = (tls_pool_block_t *) p;
+            block->next = pools[i].free_list;
+            pools[i].free_list = block;
+            p += pools[i].block_size;
+        }
+    }
+    pool_end = p;
+
+    initialized = 1;
+    return mbedtls_platform_set_calloc_free(tls_calloc, tls_free);
+}
+
+tls_arena_t *tls_arena_new(void)
+{
+    tls_arena_t *arena;
+    int i;
+
+    if (!initialized || MBED_CONF_MBEDTLS_HANDSHAKE_ARENA_SIZE == 0) {
+        return NULL;
+    }
+
+    arena = malloc(TLS_ALLOC_ROUND(sizeof(tls_arena_t)) + MBED_CONF_MBEDTLS_HANDSHAKE_ARENA_SIZE);
+    if (!arena) {
+        return NULL;
+    }
+    arena->top = TLS_ARENA_DATA(arena);
+    arena->end = arena->top + MBED_CONF_MBEDTLS_HANDSHAKE_ARENA_SIZE;
+    arena->live = 0;
+    arena->owner = NULL;
+    arena->released = 0;
+
+    core_util_critical_section_enter();
+    for (i = 0; i < MBED_CONF_MBEDTLS_HANDSHAKE_ARENA_COUNT; i++) {
+        if (!arenas[i]) {
+            arenas[i] = arena;
+            break;
+        }
+    }
+    core_util_critical_section_exit();
+
+    if (i == MBED_CONF_MBEDTLS_HANDSHAKE_ARENA_COUNT) {
+        free(arena);
+        return NULL;
+    }
+    return arena;
+}
+
+void tls_arena_enter(tls_arena_t *arena)
+{
+    arena->owner = current_thread();
+}
+
+void tls_arena_leave(tls_arena_t *arena)
+{
+    arena->owner = NULL;
+}
+
+void tls_arena_release(tls_arena_t *arena)
+{
+    tls_arena_t *dead = NULL;
+    int i;
+
+    core_util_critical_section_enter();
+    arena->owner = NULL;
+    arena->released = 1;
+    if (arena->live == 0) {
+        for (i = 0; i < MBED_CONF_MBEDTLS_HANDSHAKE_ARENA_COUNT; i++) {
+            if (arenas[i] == arena) {
+                arenas[i] = NULL;
+            }
+        }
+        dead = arena;
+    }
+    core_util_critical_section_exit();
+
+    free(dead);
+}
+
+void tls_alloc_stats_get(tls_alloc_stats_t *s)
+{
+    core_util_critical_section_enter();
+    *s = stats;
+    core_util_critical_section_exit();
+}
+
+#endif /* TLS_ALLOC_ENABLED */
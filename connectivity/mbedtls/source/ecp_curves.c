@@ -84,6 +84,43 @@
  * to be directly usable in MPIs
  */
 
+/*
+ * Precomputed comb tables for the base point, generated by
+ * tools/ecp_comb_table.py, so ecp_mul_comb() need not build them at runtime.
+ * A table only fits the window ecp_pick_window_size() picks for the base
+ * point, which depends on MBEDTLS_ECP_WINDOW_SIZE. Tables are stored for
+ * windows 4 and up; smaller windows still build the table at runtime.
+ */
+#if MBEDTLS_ECP_FIXED_POINT_OPTIM == 1
+
+#if( MBEDTLS_ECP_WINDOW_SIZE < 5 )
+#define ECP_SECP256R1_COMB_W    MBEDTLS_ECP_WINDOW_SIZE
+#else
+#define ECP_SECP256R1_COMB_W    5
+#endif
+
+#if( MBEDTLS_ECP_WINDOW_SIZE < 6 )
+#define ECP_SECP384R1_COMB_W    MBEDTLS_ECP_WINDOW_SIZE
+#else
+#define ECP_SECP384R1_COMB_W    6
+#endif
+
+#if ( defined(MBEDTLS_ECP_DP_SECP256R1_ENABLED) && ECP_SECP256R1_COMB_W >= 4 ) || \
+    ( defined(MBEDTLS_ECP_DP_SECP384R1_ENABLED) && ECP_SECP384R1_COMB_W >= 4 )
+#define ECP_COMB_TABLES
+
+/* Table points are affine (Z = 1) and never written, so they stay in flash */
+static const mbedtls_mpi_uint ecp_comb_one[] = { 1 };
+
+#define ECP_MPI_INIT( limbs ) \
+    { 1, sizeof( limbs ) / sizeof( mbedtls_mpi_uint ), (mbedtls_mpi_uint *) limbs }
+
+#define ECP_POINT_INIT_XY_Z1( x, y ) \
+    { ECP_MPI_INIT( x ), ECP_MPI_INIT( y ), ECP_MPI_INIT( ecp_comb_one ) }
+#endif
+
+#endif /* MBEDTLS_ECP_FIXED_POINT_OPTIM == 1 */
+
 /*
  * Domain parameters for secp192r1
  */
@@ -185,6 +222,329 @@ static const mbedtls_mpi_uint secp256r1_n[] = {
     BYTES_TO_T_UINT_8( 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF ),
     BYTES_TO_T_UINT_8( 0x00, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF ),
 };
+
+#if defined(ECP_COMB_TABLES) && ECP_SECP256R1_COMB_W >= 4
+#define ECP_SECP256R1_COMB_TABLE
+#if ECP_SECP256R1_COMB_W == 5
+static const mbedtls_mpi_uint secp256r1_T_0_X[] = {
+    BYTES_TO_T_UINT_8( 0x96, 0xC2, 0x98, 0xD8, 0x45, 0x39, 0xA1, 0xF4 ),
+    BYTES_TO_T_UINT_8( 0xA0, 0x33, 0xEB, 0x2D, 0x81, 0x7D, 0x03, 0x77 ),
+    BYTES_TO_T_UINT_8( 0xF2, 0x40, 0xA4, 0x63, 0xE5, 0xE6, 0xBC, 0xF8 ),
+    BYTES_TO_T_UINT_8( 0x47, 0x42, 0x2C, 0xE1, 0xF2, 0xD1, 0x17, 0x6B ),
+};
+static const mbedtls_mpi_uint secp256r1_T_0_Y[] = {
+    BYTES_TO_T_UINT_8( 0xF5, 0x51, 0xBF, 0x37, 0x68, 0x40, 0xB6, 0xCB ),
+    BYTES_TO_T_UINT_8( 0xCE, 0x5E, 0x31, 0x6B, 0x57, 0x33, 0xCE, 0x2B ),
+    BYTES_TO_T_UINT_8( 0x16, 0x9E, 0x0F, 0x7C, 0x4A, 0xEB, 0xE7, 0x8E ),
+    BYTES_TO_T_UINT_8( 0x9B, 0x7F, 0x1A, 0xFE, 0xE2, 0x42, 0xE3, 0x4F ),
+};
+static const mbedtls_mpi_uint secp256r1_T_1_X[] = {
+    BYTES_TO_T_UINT_8( 0x70, 0xC8, 0xBA, 0x04, 0xB7, 0x4B, 0xD2, 0xF7 ),
+    BYTES_TO_T_UINT_8( 0xAB, 0xC6, 0x23, 0x3A, 0xA0, 0x09, 0x3A, 0x59 ),
+    BYTES_TO_T_UINT_8( 0x1D, 0x9D, 0x4C, 0xF9, 0x58, 0x23, 0xCC, 0xDF ),
+    BYTES_TO_T_UINT_8( 0x02, 0xED, 0x7B, 0x29, 0x87, 0x0F, 0xFA, 0x3C ),
+};
+static const mbedtls_mpi_uint secp256r1_T_1_Y[] = {
+    BYTES_TO_T_UINT_8( 0x40, 0x69, 0xF2, 0x40, 0x0B, 0xA3, 0x98, 0xCE ),
+    BYTES_TO_T_UINT_8( 0xAF, 0xA8, 0x48, 0x02, 0x0D, 0x1C, 0x12, 0x62 ),
+    BYTES_TO_T_UINT_8( 0x9B, 0xAF, 0x09, 0x83, 0x80, 0xAA, 0x58, 0xA7 ),
+    BYTES_TO_T_UINT_8( 0xC6, 0x12, 0xBE, 0x70, 0x94, 0x76, 0xE3, 0xE4 ),
+};
+static const mbedtls_mpi_uint secp256r1_T_2_X[] = {
+    BYTES_TO_T_UINT_8( 0x7D, 0x7D, 0xEF, 0x86, 0xFF, 0xE3, 0x37, 0xDD ),
+    BYTES_TO_T_UINT_8( 0xDB, 0x86, 0x8B, 0x08, 0x27, 0x7C, 0xD7, 0xF6 ),
+    BYTES_TO_T_UINT_8( 0x91, 0x54, 0x4C, 0x25, 0x4F, 0x9A, 0xFE, 0x28 ),
+    BYTES_TO_T_UINT_8( 0x5E, 0xFD, 0xF0, 0x6D, 0x37, 0x03, 0x69, 0xD6 ),
+};
+static const mbedtls_mpi_uint secp256r1_T_2_Y[] = {
+    BYTES_TO_T_UINT_8( 0x96, 0xD5, 0xDA, 0xAD, 0x92, 0x49, 0xF0, 0x9F ),
+    BYTES_TO_T_UINT_8( 0xF9, 0x73, 0x43, 0x9E, 0xAF, 0xA7, 0xD1, 0xF3 ),
+    BYTES_TO_T_UINT_8( 0x67, 0x41, 0x07, 0xDF, 0x78, 0x95, 0x3E, 0xA1 ),
+    BYTES_TO_T_UINT_8( 0x22, 0x3D, 0xD1, 0xE6, 0x3C, 0xA5, 0xE2, 0x20 ),
+};
+static const mbedtls_mpi_uint secp256r1_T_3_X[] = {
+    BYTES_TO_T_UINT_8( 0xBF, 0x6A, 0x5D, 0x52, 0x35, 0xD7, 0xBF, 0xAE ),
+    BYTES_TO_T_UINT_8( 0x5A, 0xA2, 0xBE, 0x96, 0xF4, 0xF8, 0x02, 0xC3 ),
+    BYTES_TO_T_UINT_8( 0xA4, 0x20, 0x49, 0x54, 0xEA, 0xB3, 0x82, 0xDB ),
+    BYTES_TO_T_UINT_8( 0x2E, 0xDB, 0xEA, 0x02, 0xD1, 0x75, 0x1C, 0x62 ),
+};
+static const mbedtls_mpi_uint secp256r1_T_3_Y[] = {
+    BYTES_TO_T_UINT_8( 0xF0, 0x85, 0xF4, 0x9E, 0x4C, 0xDC, 0x39, 0x89 ),
+    BYTES_TO_T_UINT_8( 0x63, 0x6D, 0xC4, 0x57, 0xD8, 0x03, 0x5D, 0x22 ),
+    BYTES_TO_T_UINT_8( 0x70, 0x7F, 0x2D, 0x52, 0x6F, 0xC9, 0xDA, 0x4F ),
+    BYTES_TO_T_UINT_8( 0x9D, 0x64, 0xFA, 0xB4, 0xFE, 0xA4, 0xC4, 0xD7 ),
+};
+static const mbedtls_mpi_uint secp256r1_T_4_X[] = {
+    BYTES_TO_T_UINT_8( 0x2A, 0x37, 0xB9, 0xC0, 0xAA, 0x59, 0xC6, 0x8B ),
+    BYTES_TO_T_UINT_8( 0x3F, 0x58, 0xD9, 0xED, 0x58, 0x99, 0x65, 0xF7 ),
+    BYTES_TO_T_UINT_8( 0x88, 0x7D, 0x26, 0x8C, 0x4A, 0xF9, 0x05, 0x9F ),
+    BYTES_TO_T_UINT_8( 0x9D, 0x73, 0x9A, 0xC9, 0xE7, 0x46, 0xDC, 0x00 ),
+};
+static const mbedtls_mpi_uint secp256r1_T_4_Y[] = {
+    BYTES_TO_T_UINT_8( 0xF2, 0xD0, 0x55, 0xDF, 0x00, 0x0A, 0xF5, 0x4A ),
+    BYTES_TO_T_UINT_8( 0x6A, 0xBF, 0x56, 0x81, 0x2D, 0x20, 0xEB, 0xB5 ),
+    BYTES_TO_T_UINT_8( 0x11, 0xC1, 0x28, 0x52, 0xAB, 0xE3, 0xD1, 0x40 ),
+    BYTES_TO_T_UINT_8( 0x24, 0x34, 0x79, 0x45, 0x57, 0xA5, 0x12, 0x03 ),
+};
+static const mbedtls_mpi_uint secp256r1_T_5_X[] = {
+    BYTES_TO_T_UINT_8( 0xEE, 0xCF, 0xB8, 0x7E, 0xF7, 0x92, 0x96, 0x8D ),
+    BYTES_TO_T_UINT_8( 0x3D, 0x01, 0x8C, 0x0D, 0x23, 0xF2, 0xE3, 0x05 ),
+    BYTES_TO_T_UINT_8( 0x59, 0x2E, 0xE3, 0x84, 0x52, 0x7A, 0x34, 0x76 ),
+    BYTES_TO_T_UINT_8( 0xE5, 0xA1, 0xB0, 0x15, 0x90, 0xE2, 0x53, 0x3C ),
+};
+static const mbedtls_mpi_uint secp256r1_T_5_Y[] = {
+    BYTES_TO_T_UINT_8( 0xD4, 0x98, 0xE7, 0xFA, 0xA5, 0x7D, 0x8B, 0x53 ),
+    BYTES_TO_T_UINT_8( 0x91, 0x35, 0xD2, 0x00, 0xD1, 0x1B, 0x9F, 0x1B ),
+    BYTES_TO_T_UINT_8( 0x3F, 0x69, 0x08, 0x9A, 0x72, 0xF0, 0xA9, 0x11 ),
+    BYTES_TO_T_UINT_8( 0xB3, 0xFE, 0x0E, 0x14, 0xDA, 0x7C, 0x0E, 0xD3 ),
+};
+static const mbedtls_mpi_uint secp256r1_T_6_X[] = {
+    BYTES_TO_T_UINT_8( 0x83, 0xF6, 0xE8, 0xF8, 0x87, 0xF7, 0xFC, 0x6D ),
+    BYTES_TO_T_UINT_8( 0x90, 0xBE, 0x7F, 0x3F, 0x7A, 0x2B, 0xD7, 0x13 ),
+    BYTES_TO_T_UINT_8( 0xCF, 0x32, 0xF2, 0x2D, 0x94, 0x6D, 0x42, 0xFD ),
+    BYTES_TO_T_UINT_8( 0xAD, 0x9A, 0xE3, 0x5F, 0x42, 0xBB, 0x84, 0xED ),
+};
+static const mbedtls_mpi_uint secp256r1_T_6_Y[] = {
+    BYTES_TO_T_UINT_8( 0xFC, 0x95, 0x29, 0x73, 0xA1, 0x67, 0x3E, 0x02 ),
+    BYTES_TO_T_UINT_8( 0xE3, 0x30, 0x54, 0x35, 0x8E, 0x0A, 0xDD, 0x67 ),
+    BYTES_TO_T_UINT_8( 0x03, 0xD7, 0xA1, 0x97, 0x61, 0x3B, 0xF8, 0x0C ),
+    BYTES_TO_T_UINT_8( 0xF2, 0x33, 0x3C, 0x58, 0x55, 0x34, 0x23, 0xA3 ),
+};
+static const mbedtls_mpi_uint secp256r1_T_7_X[] = {
+    BYTES_TO_T_UINT_8( 0x99, 0x5D, 0x16, 0x5F, 0x7B, 0xBC, 0xBB, 0xCE ),
+    BYTES_TO_T_UINT_8( 0x61, 0xEE, 0x4E, 0x8A, 0xC1, 0x51, 0xCC, 0x50 ),
+    BYTES_TO_T_UINT_8( 0x1F, 0x0D, 0x4D, 0x1B, 0x53, 0x23, 0x1D, 0xB3 ),
+    BYTES_TO_T_UINT_8( 0xDA, 0x2A, 0x38, 0x66, 0x52, 0x84, 0xE1, 0x95 ),
+};
+static const mbedtls_mpi_uint secp256r1_T_7_Y[] = {
+    BYTES_TO_T_UINT_8( 0x5B, 0x9B, 0x83, 0x0A, 0x81, 0x4F, 0xAD, 0xAC ),
+    BYTES_TO_T_UINT_8( 0x0F, 0xFF, 0x42, 0x41, 0x6E, 0xA9, 0xA2, 0xA0 ),
+    BYTES_TO_T_UINT_8( 0x2F, 0xA1, 0x4F, 0x1F, 0x89, 0x82, 0xAA, 0x3E ),
+    BYTES_TO_T_UINT_8( 0xF3, 0xB8, 0x0F, 0x6B, 0x8F, 0x8C, 0xD6, 0x68 ),
+};
+static const mbedtls_mpi_uint secp256r1_T_8_X[] = {
+    BYTES_TO_T_UINT_8( 0xF1, 0xB3, 0xBB, 0x51, 0x69, 0xA2, 0x11, 0x93 ),
+    BYTES_TO_T_UINT_8( 0x65, 0x4F, 0x0F, 0x8D, 0xBD, 0x26, 0x0F, 0xE8 ),
+    BYTES_TO_T_UINT_8( 0xB9, 0xCB, 0xEC, 0x6B, 0x34, 0xC3, 0x3D, 0x9D ),
+    BYTES_TO_T_UINT_8( 0xE4, 0x5D, 0x1E, 0x10, 0xD5, 0x44, 0xE2, 0x54 ),
+};
+static const mbedtls_mpi_uint secp256r1_T_8_Y[] = {
+    BYTES_TO_T_UINT_8( 0x28, 0x9E, 0xB1, 0xF1, 0x6E, 0x4C, 0xAD, 0xB3 ),
+    BYTES_TO_T_UINT_8( 0xB7, 0xE3, 0xC2, 0x58, 0xC0, 0xFB, 0x34, 0x43 ),
+    BYTES_TO_T_UINT_8( 0x25, 0x9C, 0xDF, 0x35, 0x07, 0x41, 0xBD, 0x19 ),
+    BYTES_TO_T_UINT_8( 0xB6, 0x6E, 0x10, 0xEC, 0x0E, 0xEC, 0xBB, 0xD6 ),
+};
+static const mbedtls_mpi_uint secp256r1_T_9_X[] = {
+    BYTES_TO_T_UINT_8( 0xC8, 0xCF, 0xEF, 0x3F, 0x83, 0x1A, 0x88, 0xE8 ),
+    BYTES_TO_T_UINT_8( 0x0B, 0x29, 0xB5, 0xB9, 0xE0, 0xC9, 0xA3, 0xAE ),
+    BYTES_TO_T_UINT_8( 0x88, 0x46, 0x1E, 0x77, 0xCD, 0x7E, 0xB3, 0x10 ),
+    BYTES_TO_T_UINT_8( 0xB6, 0x21, 0xD0, 0xD4, 0xA3, 0x16, 0x08, 0xEE ),
+};
+static const mbedtls_mpi_uint secp256r1_T_9_Y[] = {
+    BYTES_TO_T_UINT_8( 0xA1, 0xCA, 0xA8, 0xB3, 0xBF, 0x29, 0x99, 0x8E ),
+    BYTES_TO_T_UINT_8( 0xD1, 0xF2, 0x05, 0xC1, 0xCF, 0x5D, 0x91, 0x48 ),
+    BYTES_TO_T_UINT_8( 0x9F, 0x01, 0x49, 0xDB, 0x82, 0xDF, 0x5F, 0x3A ),
+    BYTES_TO_T_UINT_8( 0xE1, 0x06, 0x90, 0xAD, 0xE3, 0x38, 0xA4, 0xC4 ),
+};
+static const mbedtls_mpi_uint secp256r1_T_10_X[] = {
+    BYTES_TO_T_UINT_8( 0xC9, 0xD2, 0x3A, 0xE8, 0x03, 0xC5, 0x6D, 0x5D ),
+    BYTES_TO_T_UINT_8( 0xBE, 0x35, 0xD0, 0xAE, 0x1D, 0x7A, 0x9F, 0xCA ),
+    BYTES_TO_T_UINT_8( 0x33, 0x1E, 0xD2, 0xCB, 0xAC, 0x88, 0x27, 0x55 ),
+    BYTES_TO_T_UINT_8( 0xF0, 0xB9, 0x9C, 0xE0, 0x31, 0xDD, 0x99, 0x86 ),
+};
+static const mbedtls_mpi_uint secp256r1_T_10_Y[] = {
+    BYTES_TO_T_UINT_8( 0x61, 0xF9, 0x9B, 0x32, 0x96, 0x41, 0x58, 0x38 ),
+    BYTES_TO_T_UINT_8( 0xF9, 0x5A, 0x2A, 0xB8, 0x96, 0x0E, 0xB2, 0x4C ),
+    BYTES_TO_T_UINT_8( 0xC1, 0x78, 0x2C, 0xC7, 0x08, 0x99, 0x19, 0x24 ),
+    BYTES_TO_T_UINT_8( 0xB7, 0x59, 0x28, 0xE9, 0x84, 0x54, 0xE6, 0x16 ),
+};
+static const mbedtls_mpi_uint secp256r1_T_11_X[] = {
+    BYTES_TO_T_UINT_8( 0xDD, 0x38, 0x30, 0xDB, 0x70, 0x2C, 0x0A, 0xA2 ),
+    BYTES_TO_T_UINT_8( 0x7C, 0x5C, 0x9D, 0xE9, 0xD5, 0x46, 0x0B, 0x5F ),
+    BYTES_TO_T_UINT_8( 0x83, 0x0B, 0x60, 0x4B, 0x37, 0x7D, 0xB9, 0xC9 ),
+    BYTES_TO_T_UINT_8( 0x5E, 0x24, 0xF3, 0x3D, 0x79, 0x7F, 0x6C, 0x18 ),
+};
+static const mbedtls_mpi_uint secp256r1_T_11_Y[] = {
+    BYTES_TO_T_UINT_8( 0x7F, 0xE5, 0x1C, 0x4F, 0x60, 0x24, 0xF7, 0x2A ),
+    BYTES_TO_T_UINT_8( 0xED, 0xD8, 0xE2, 0x91, 0x7F, 0x89, 0x49, 0x92 ),
+    BYTES_TO_T_UINT_8( 0x97, 0xA7, 0x2E, 0x8D, 0x6A, 0xB3, 0x39, 0x81 ),
+    BYTES_TO_T_UINT_8( 0x13, 0x89, 0xB5, 0x9A, 0xB8, 0x8D, 0x42, 0x9C ),
+};
+static const mbedtls_mpi_uint secp256r1_T_12_X[] = {
+    BYTES_TO_T_UINT_8( 0x8D, 0x45, 0xE6, 0x4B, 0x3F, 0x4F, 0x1E, 0x1F ),
+    BYTES_TO_T_UINT_8( 0x47, 0x65, 0x5E, 0x59, 0x22, 0xCC, 0x72, 0x5F ),
+    BYTES_TO_T_UINT_8( 0xF1, 0x93, 0x1A, 0x27, 0x1E, 0x34, 0xC5, 0x5B ),
+    BYTES_TO_T_UINT_8( 0x63, 0xF2, 0xA5, 0x58, 0x5C, 0x15, 0x2E, 0xC6 ),
+};
+static const mbedtls_mpi_uint secp256r1_T_12_Y[] = {
+    BYTES_TO_T_UINT_8( 0xF4, 0x7F, 0xBA, 0x58, 0x5A, 0x84, 0x6F, 0x5F ),
+    BYTES_TO_T_UINT_8( 0xAD, 0xA6, 0x36, 0x7E, 0xDC, 0xF7, 0xE1, 0x67 ),
+    BYTES_TO_T_UINT_8( 0x04, 0x4D, 0xAA, 0xEE, 0x57, 0x76, 0x3A, 0xD3 ),
+    BYTES_TO_T_UINT_8( 0x4E, 0x7E, 0x26, 0x18, 0x22, 0x23, 0x9F, 0xFF ),
+};
+static const mbedtls_mpi_uint secp256r1_T_13_X[] = {
+    BYTES_TO_T_UINT_8( 0x1D, 0x4C, 0x64, 0xC7, 0x55, 0x02, 0x3F, 0xE3 ),
+    BYTES_TO_T_UINT_8( 0xD8, 0x02, 0x90, 0xBB, 0xC3, 0xEC, 0x30, 0x40 ),
+    BYTES_TO_T_UINT_8( 0x9F, 0x6F, 0x64, 0xF4, 0x16, 0x69, 0x48, 0xA4 ),
+    BYTES_TO_T_UINT_8( 0xFA, 0x44, 0x9C, 0x95, 0x0C, 0x7D, 0x67, 0x5E ),
+};
+static const mbedtls_mpi_uint secp256r1_T_13_Y[] = {
+    BYTES_TO_T_UINT_8( 0x44, 0x91, 0x8B, 0xD8, 0xD0, 0xD7, 0xE7, 0xE2 ),
+    BYTES_TO_T_UINT_8( 0x1F, 0xF9, 0x48, 0x62, 0x6F, 0xA8, 0x93, 0x5D ),
+    BYTES_TO_T_UINT_8( 0xEA, 0x3A, 0x99, 0x02, 0xD5, 0x0B, 0x3D, 0xE3 ),
+    BYTES_TO_T_UINT_8( 0x1E, 0xD3, 0x00, 0x31, 0xE6, 0x0C, 0x9F, 0x44 ),
+};
+static const mbedtls_mpi_uint secp256r1_T_14_X[] = {
+    BYTES_TO_T_UINT_8( 0x56, 0xB2, 0xAA, 0xFD, 0x88, 0x15, 0xDF, 0x52 ),
+    BYTES_TO_T_UINT_8( 0x4C, 0x35, 0x27, 0x31, 0x44, 0xCD, 0xC0, 0x68 ),
+    BYTES_TO_T_UINT_8( 0x53, 0xF8, 0x91, 0xA5, 0x71, 0x94, 0x84, 0x2A ),
+    BYTES_TO_T_UINT_8( 0x92, 0xCB, 0xD0, 0x93, 0xE9, 0x88, 0xDA, 0xE4 ),
+};
+static const mbedtls_mpi_uint secp256r1_T_14_Y[] = {
+    BYTES_TO_T_UINT_8( 0x24, 0xC6, 0x39, 0x16, 0x5D, 0xA3, 0x1E, 0x6D ),
+    BYTES_TO_T_UINT_8( 0xBA, 0x07, 0x37, 0x26, 0x36, 0x2A, 0xFE, 0x60 ),
+    BYTES_TO_T_UINT_8( 0x51, 0xBC, 0xF3, 0xD0, 0xDE, 0x50, 0xFC, 0x97 ),
+    BYTES_TO_T_UINT_8( 0x80, 0x2E, 0x06, 0x10, 0x15, 0x4D, 0xFA, 0xF7 ),
+};
+static const mbedtls_mpi_uint secp256r1_T_15_X[] = {
+    BYTES_TO_T_UINT_8( 0x27, 0x65, 0x69, 0x5B, 0x66, 0xA2, 0x75, 0x2E ),
+    BYTES_TO_T_UINT_8( 0x9C, 0x16, 0x00, 0x5A, 0xB0, 0x30, 0x25, 0x1A ),
+    BYTES_TO_T_UINT_8( 0x42, 0xFB, 0x86, 0x42, 0x80, 0xC1, 0xC4, 0x76 ),
+    BYTES_TO_T_UINT_8( 0x5B, 0x1D, 0x83, 0x8E, 0x94, 0x01, 0x5F, 0x82 ),
+};
+static const mbedtls_mpi_uint secp256r1_T_15_Y[] = {
+    BYTES_TO_T_UINT_8( 0x39, 0x37, 0x70, 0xEF, 0x1F, 0xA1, 0xF0, 0xDB ),
+    BYTES_TO_T_UINT_8( 0x6A, 0x10, 0x5B, 0xCE, 0xC4, 0x9B, 0x6F, 0x10 ),
+    BYTES_TO_T_UINT_8( 0x50, 0x11, 0x11, 0x24, 0x4F, 0x4C, 0x79, 0x61 ),
+    BYTES_TO_T_UINT_8( 0x17, 0x3A, 0x72, 0xBC, 0xFE, 0x72, 0x58, 0x43 ),
+};
+static const mbedtls_ecp_point secp256r1_T[16] = {
+    ECP_POINT_INIT_XY_Z1( secp256r1_T_0_X, secp256r1_T_0_Y ),
+    ECP_POINT_INIT_XY_Z1( secp256r1_T_1_X, secp256r1_T_1_Y ),
+    ECP_POINT_INIT_XY_Z1( secp256r1_T_2_X, secp256r1_T_2_Y ),
+    ECP_POINT_INIT_XY_Z1( secp256r1_T_3_X, secp256r1_T_3_Y ),
+    ECP_POINT_INIT_XY_Z1( secp256r1_T_4_X, secp256r1_T_4_Y ),
+    ECP_POINT_INIT_XY_Z1( secp256r1_T_5_X, secp256r1_T_5_Y ),
+    ECP_POINT_INIT_XY_Z1( secp256r1_T_6_X, secp256r1_T_6_Y ),
+    ECP_POINT_INIT_XY_Z1( secp256r1_T_7_X, secp256r1_T_7_Y ),
+    ECP_POINT_INIT_XY_Z1( secp256r1_T_8_X, secp256r1_T_8_Y ),
+    ECP_POINT_INIT_XY_Z1( secp256r1_T_9_X, secp256r1_T_9_Y ),
+    ECP_POINT_INIT_XY_Z1( secp256r1_T_10_X, secp256r1_T_10_Y ),
+    ECP_POINT_INIT_XY_Z1( secp256r1_T_11_X, secp256r1_T_11_Y ),
+    ECP_POINT_INIT_XY_Z1( secp256r1_T_12_X, secp256r1_T_12_Y ),
+    ECP_POINT_INIT_XY_Z1( secp256r1_T_13_X, secp256r1_T_13_Y ),
+    ECP_POINT_INIT_XY_Z1( secp256r1_T_14_X, secp256r1_T_14_Y ),
+    ECP_POINT_INIT_XY_Z1( secp256r1_T_15_X, secp256r1_T_15_Y ),
+};
+#else /* ECP_SECP256R1_COMB_W == 4 */
+static const mbedtls_mpi_uint secp256r1_T_0_X[] = {
+    BYTES_TO_T_UINT_8( 0x96, 0xC2, 0x98, 0xD8, 0x45, 0x39, 0xA1, 0xF4 ),
+    BYTES_TO_T_UINT_8( 0xA0, 0x33, 0xEB, 0x2D, 0x81, 0x7D, 0x03, 0x77 ),
+    BYTES_TO_T_UINT_8( 0xF2, 0x40, 0xA4, 0x63, 0xE5, 0xE6, 0xBC, 0xF8 ),
+    BYTES_TO_T_UINT_8( 0x47, 0x42, 0x2C, 0xE1, 0xF2, 0xD1, 0x17, 0x6B ),
+};
+static const mbedtls_mpi_uint secp256r1_T_0_Y[] = {
+    BYTES_TO_T_UINT_8( 0xF5, 0x51, 0xBF, 0x37, 0x68, 0x40, 0xB6, 0xCB ),
+    BYTES_TO_T_UINT_8( 0xCE, 0x5E, 0x31, 0x6B, 0x57, 0x33, 0xCE, 0x2B ),
+    BYTES_TO_T_UINT_8( 0x16, 0x9E, 0x0F, 0x7C, 0x4A, 0xEB, 0xE7, 0x8E ),
+    BYTES_TO_T_UINT_8( 0x9B, 0x7F, 0x1A, 0xFE, 0xE2, 0x42, 0xE3, 0x4F ),
+};
+static const mbedtls_mpi_uint secp256r1_T_1_X[] = {
+    BYTES_TO_T_UINT_8( 0xAF, 0x92, 0x79, 0x09, 0xE2, 0x1C, 0x39, 0x93 ),
+    BYTES_TO_T_UINT_8( 0xFA, 0xF1, 0x35, 0x0D, 0xFD, 0x98, 0x6C, 0xE9 ),
+    BYTES_TO_T_UINT_8( 0x89, 0x27, 0xE0, 0x95, 0xDE, 0xC0, 0x57, 0xB2 ),
+    BYTES_TO_T_UINT_8( 0x6F, 0x72, 0xD6, 0x89, 0xBC, 0x4B, 0x0A, 0x30 ),
+};
+static const mbedtls_mpi_uint secp256r1_T_1_Y[] = {
+    BYTES_TO_T_UINT_8( 0xA0, 0x27, 0x81, 0xC0, 0x91, 0xA2, 0x54, 0xAA ),
+    BYTES_TO_T_UINT_8( 0xA5, 0x06, 0xD8, 0xA9, 0xAD, 0xEE, 0xB1, 0x5B ),
+    BYTES_TO_T_UINT_8( 0x6F, 0x3C, 0x1E, 0xFF, 0x25, 0xDB, 0x1D, 0x7F ),
+    BYTES_TO_T_UINT_8( 0x44, 0x46, 0x9B, 0xD0, 0xE0, 0xC7, 0xAA, 0x72 ),
+};
+static const mbedtls_mpi_uint secp256r1_T_2_X[] = {
+    BYTES_TO_T_UINT_8( 0x7F, 0x36, 0x1D, 0x2A, 0x93, 0x9C, 0x94, 0x13 ),
+    BYTES_TO_T_UINT_8( 0xB7, 0x11, 0x0A, 0x1A, 0x2B, 0xBD, 0x7F, 0xEF ),
+    BYTES_TO_T_UINT_8( 0x60, 0xFC, 0x1D, 0xB9, 0x8B, 0x06, 0xC6, 0xDD ),
+    BYTES_TO_T_UINT_8( 0xFF, 0x72, 0x9C, 0x8A, 0x32, 0x19, 0x95, 0xEF ),
+};
+static const mbedtls_mpi_uint secp256r1_T_2_Y[] = {
+    BYTES_TO_T_UINT_8( 0xA8, 0xD8, 0x76, 0x73, 0xA7, 0x35, 0x60, 0x19 ),
+    BYTES_TO_T_UINT_8( 0x40, 0x17, 0xCA, 0x95, 0x08, 0x3B, 0x18, 0x23 ),
+    BYTES_TO_T_UINT_8( 0x9C, 0x21, 0x2C, 0x02, 0x07, 0x98, 0xEE, 0xC1 ),
+    BYTES_TO_T_UINT_8( 0x9B, 0x2C, 0xBB, 0x7D, 0xC3, 0x9F, 0x1E, 0x61 ),
+};
+static const mbedtls_mpi_uint secp256r1_T_3_X[] = {
+    BYTES_TO_T_UINT_8( 0x01, 0xDE, 0x5C, 0xFC, 0xFF, 0xCA, 0x8E, 0xE4 ),
+    BYTES_TO_T_UINT_8( 0x26, 0x5F, 0x71, 0x0D, 0xE7, 0x84, 0xCD, 0x7C ),
+    BYTES_TO_T_UINT_8( 0x91, 0x43, 0x3E, 0xF4, 0x83, 0xF4, 0xE8, 0xA2 ),
+    BYTES_TO_T_UINT_8( 0xEA, 0x41, 0x11, 0xB2, 0x45, 0x77, 0x5D, 0xEB ),
+};
+static const mbedtls_mpi_uint secp256r1_T_3_Y[] = {
+    BYTES_TO_T_UINT_8( 0x79, 0x34, 0x1A, 0x73, 0xE2, 0x17, 0xC9, 0xCA ),
+    BYTES_TO_T_UINT_8( 0x45, 0xB6, 0x44, 0x28, 0xFE, 0x2C, 0xF2, 0x85 ),
+    BYTES_TO_T_UINT_8( 0xEE, 0x6C, 0x00, 0x58, 0xA1, 0xE6, 0x90, 0x09 ),
+    BYTES_TO_T_UINT_8( 0x7B, 0xC1, 0xEC, 0xDB, 0xEB, 0x72, 0xFD, 0xEA ),
+};
+static const mbedtls_mpi_uint secp256r1_T_4_X[] = {
+    BYTES_TO_T_UINT_8( 0x3E, 0x8A, 0x7C, 0x67, 0x04, 0x8C, 0xF4, 0x2D ),
+    BYTES_TO_T_UINT_8( 0x6B, 0xA5, 0x03, 0x02, 0x08, 0x2F, 0xE0, 0x74 ),
+    BYTES_TO_T_UINT_8( 0xDB, 0xFE, 0xC7, 0xB8, 0x7D, 0x5F, 0x85, 0x31 ),
+    BYTES_TO_T_UINT_8( 0xAD, 0xDD, 0xC9, 0x72, 0x76, 0x9E, 0x76, 0x4E ),
+};
+static const mbedtls_mpi_uint secp256r1_T_4_Y[] = {
+    BYTES_TO_T_UINT_8( 0xB0, 0xBB, 0x24, 0xB8, 0x65, 0x61, 0xC3, 0xA4 ),
+    BYTES_TO_T_UINT_8( 0xA5, 0x22, 0x91, 0x3B, 0x6F, 0xE1, 0x9A, 0xFB ),
+    BYTES_TO_T_UINT_8( 0x81, 0x72, 0x94, 0x06, 0x72, 0x05, 0xC0, 0x1E ),
+    BYTES_TO_T_UINT_8( 0x63, 0x06, 0x83, 0xDE, 0x82, 0x90, 0xB9, 0x42 ),
+};
+static const mbedtls_mpi_uint secp256r1_T_5_X[] = {
+    BYTES_TO_T_UINT_8( 0x73, 0x35, 0x1A, 0xC3, 0xD2, 0x1E, 0x99, 0x7F ),
+    BYTES_TO_T_UINT_8( 0x96, 0xB4, 0x4F, 0xD5, 0x5B, 0xDD, 0x82, 0x5B ),
+    BYTES_TO_T_UINT_8( 0xAE, 0xFC, 0x2F, 0x81, 0x20, 0x52, 0x5C, 0x59 ),
+    BYTES_TO_T_UINT_8( 0x87, 0x12, 0x6B, 0x71, 0x4D, 0xBC, 0x88, 0x0C ),
+};
+static const mbedtls_mpi_uint secp256r1_T_5_Y[] = {
+    BYTES_TO_T_UINT_8( 0xA8, 0xAC, 0x48, 0x5F, 0x63, 0xBF, 0x57, 0x3A ),
+    BYTES_TO_T_UINT_8( 0xF3, 0x64, 0x25, 0xDF, 0xF4, 0x81, 0x81, 0x7C ),
+    BYTES_TO_T_UINT_8( 0xAA, 0xE6, 0x04, 0x9C, 0xB3, 0xB5, 0xD1, 0x18 ),
+    BYTES_TO_T_UINT_8( 0xC6, 0x1D, 0x90, 0xF3, 0xA3, 0xDE, 0x5D, 0xDD ),
+};
+static const mbedtls_mpi_uint secp256r1_T_6_X[] = {
+    BYTES_TO_T_UINT_8( 0x7F, 0x2E, 0x58, 0xA2, 0x89, 0x47, 0x6B, 0xD3 ),
+    BYTES_TO_T_UINT_8( 0x28, 0x9C, 0xC3, 0x4E, 0x14, 0x10, 0x1A, 0x0D ),
+    BYTES_TO_T_UINT_8( 0xA0, 0xD7, 0xBA, 0xED, 0xC3, 0x62, 0x3C, 0x66 ),
+    BYTES_TO_T_UINT_8( 0xB9, 0x1D, 0x46, 0x6F, 0x4B, 0xBF, 0x52, 0x40 ),
+};
+static const mbedtls_mpi_uint secp256r1_T_6_Y[] = {
+    BYTES_TO_T_UINT_8( 0xEB, 0x25, 0x8D, 0x18, 0xC3, 0x27, 0x5A, 0x23 ),
+    BYTES_TO_T_UINT_8( 0x5B, 0xCC, 0xBF, 0x99, 0x39, 0xF3, 0x24, 0xE7 ),
+    BYTES_TO_T_UINT_8( 0xC8, 0x0C, 0xD7, 0x71, 0xBD, 0xE6, 0x2B, 0x86 ),
+    BYTES_TO_T_UINT_8( 0x61, 0xFC, 0xB0, 0x90, 0x51, 0x4D, 0xCF, 0xFE ),
+};
+static const mbedtls_mpi_uint secp256r1_T_7_X[] = {
+    BYTES_TO_T_UINT_8( 0xE5, 0x78, 0x1D, 0x0D, 0x11, 0xB5, 0x15, 0x96 ),
+    BYTES_TO_T_UINT_8( 0x4B, 0x74, 0xC4, 0x25, 0x32, 0xDE, 0xB0, 0x66 ),
+    BYTES_TO_T_UINT_8( 0x3A, 0x36, 0xAF, 0x6A, 0xFB, 0x46, 0x4A, 0x0A ),
+    BYTES_TO_T_UINT_8( 0x1C, 0xA2, 0xF7, 0x84, 0xB4, 0x26, 0x8E, 0xB4 ),
+};
+static const mbedtls_mpi_uint secp256r1_T_7_Y[] = {
+    BYTES_TO_T_UINT_8( 0x2D, 0x1B, 0xA0, 0x21, 0xF6, 0xB0, 0xEB, 0x06 ),
+    BYTES_TO_T_UINT_8( 0x98, 0x0F, 0x7B, 0x8B, 0x04, 0xE4, 0x04, 0xC0 ),
+    BYTES_TO_T_UINT_8( 0x68, 0xF6, 0xD6, 0xFE, 0xCD, 0x1B, 0x13, 0x64 ),
+    BYTES_TO_T_UINT_8( 0xAB, 0x3D, 0x4D, 0x4D, 0x40, 0x15, 0xC0, 0xFA ),
+};
+static const mbedtls_ecp_point secp256r1_T[8] = {
+    ECP_POINT_INIT_XY_Z1( secp256r1_T_0_X, secp256r1_T_0_Y ),
+    ECP_POINT_INIT_XY_Z1( secp256r1_T_1_X, secp256r1_T_1_Y ),
+    ECP_POINT_INIT_XY_Z1( secp256r1_T_2_X, secp256r1_T_2_Y ),
+    ECP_POINT_INIT_XY_Z1( secp256r1_T_3_X, secp256r1_T_3_Y ),
+    ECP_POINT_INIT_XY_Z1( secp256r1_T_4_X, secp256r1_T_4_Y ),
+    ECP_POINT_INIT_XY_Z1( secp256r1_T_5_X, secp256r1_T_5_Y ),
+    ECP_POINT_INIT_XY_Z1( secp256r1_T_6_X, secp256r1_T_6_Y ),
+    ECP_POINT_INIT_XY_Z1( secp256r1_T_7_X, secp256r1_T_7_Y ),
+};
+#endif
+#endif /* ECP_SECP256R1_COMB_TABLE */
 #endif /* MBEDTLS_ECP_DP_SECP256R1_ENABLED */
 
 /*
@@ -231,6 +591,972 @@ static const mbedtls_mpi_uint secp384r1_n[] = {
     BYTES_TO_T_UINT_8( 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF ),
     BYTES_TO_T_UINT_8( 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF ),
 };
+
+#if defined(ECP_COMB_TABLES) && ECP_SECP384R1_COMB_W >= 4
+#define ECP_SECP384R1_COMB_TABLE
+#if ECP_SECP384R1_COMB_W == 6
+static const mbedtls_mpi_uint secp384r1_T_0_X[] = {
+    BYTES_TO_T_UINT_8( 0xB7, 0x0A, 0x76, 0x72, 0x38, 0x5E, 0x54, 0x3A ),
+    BYTES_TO_T_UINT_8( 0x6C, 0x29, 0x55, 0xBF, 0x5D, 0xF2, 0x02, 0x55 ),
+    BYTES_TO_T_UINT_8( 0x38, 0x2A, 0x54, 0x82, 0xE0, 0x41, 0xF7, 0x59 ),
+    BYTES_TO_T_UINT_8( 0x98, 0x9B, 0xA7, 0x8B, 0x62, 0x3B, 0x1D, 0x6E ),
+    BYTES_TO_T_UINT_8( 0x74, 0xAD, 0x20, 0xF3, 0x1E, 0xC7, 0xB1, 0x8E ),
+    BYTES_TO_T_UINT_8( 0x37, 0x05, 0x8B, 0xBE, 0x22, 0xCA, 0x87, 0xAA ),
+};
+static const mbedtls_mpi_uint secp384r1_T_0_Y[] = {
+    BYTES_TO_T_UINT_8( 0x5F, 0x0E, 0xEA, 0x90, 0x7C, 0x1D, 0x43, 0x7A ),
+    BYTES_TO_T_UINT_8( 0x9D, 0x81, 0x7E, 0x1D, 0xCE, 0xB1, 0x60, 0x0A ),
+    BYTES_TO_T_UINT_8( 0xC0, 0xB8, 0xF0, 0xB5, 0x13, 0x31, 0xDA, 0xE9 ),
+    BYTES_TO_T_UINT_8( 0x7C, 0x14, 0x9A, 0x28, 0xBD, 0x1D, 0xF4, 0xF8 ),
+    BYTES_TO_T_UINT_8( 0x29, 0xDC, 0x92, 0x92, 0xBF, 0x98, 0x9E, 0x5D ),
+    BYTES_TO_T_UINT_8( 0x6F, 0x2C, 0x26, 0x96, 0x4A, 0xDE, 0x17, 0x36 ),
+};
+static const mbedtls_mpi_uint secp384r1_T_1_X[] = {
+    BYTES_TO_T_UINT_8( 0x46, 0x92, 0x00, 0x2C, 0x78, 0xDB, 0x1F, 0x37 ),
+    BYTES_TO_T_UINT_8( 0x17, 0xF3, 0xEB, 0xB7, 0x06, 0xF7, 0xB6, 0xBC ),
+    BYTES_TO_T_UINT_8( 0x3D, 0xBC, 0x2C, 0xCF, 0xD8, 0xED, 0x53, 0xE7 ),
+    BYTES_TO_T_UINT_8( 0x52, 0x75, 0x7B, 0xA3, 0xAB, 0xC3, 0x2C, 0x85 ),
+    BYTES_TO_T_UINT_8( 0xE5, 0x9D, 0x78, 0x41, 0xF6, 0x76, 0x84, 0xAC ),
+    BYTES_TO_T_UINT_8( 0x54, 0x56, 0xE8, 0x52, 0xB3, 0xCB, 0xA8, 0xBD ),
+};
+static const mbedtls_mpi_uint secp384r1_T_1_Y[] = {
+    BYTES_TO_T_UINT_8( 0x6D, 0xF2, 0xAE, 0xA4, 0xB6, 0x89, 0x1B, 0xDA ),
+    BYTES_TO_T_UINT_8( 0x01, 0x0F, 0xCE, 0x1C, 0x7C, 0xF6, 0x50, 0x4C ),
+    BYTES_TO_T_UINT_8( 0x4C, 0xEB, 0x90, 0xE6, 0x4D, 0xC7, 0xD4, 0x7A ),
+    BYTES_TO_T_UINT_8( 0xD1, 0x49, 0x2D, 0x8A, 0x01, 0x99, 0x60, 0x94 ),
+    BYTES_TO_T_UINT_8( 0x5F, 0x80, 0x9B, 0x9B, 0x6A, 0xB0, 0x07, 0xD9 ),
+    BYTES_TO_T_UINT_8( 0xC2, 0xA2, 0xEE, 0x59, 0xBE, 0x95, 0xBC, 0x23 ),
+};
+static const mbedtls_mpi_uint secp384r1_T_2_X[] = {
+    BYTES_TO_T_UINT_8( 0xE6, 0x9D, 0x56, 0xAE, 0x59, 0xFB, 0x1F, 0x98 ),
+    BYTES_TO_T_UINT_8( 0xCF, 0xAC, 0x91, 0x80, 0x87, 0xA8, 0x6E, 0x58 ),
+    BYTES_TO_T_UINT_8( 0x30, 0x08, 0xA7, 0x08, 0x94, 0x32, 0xFC, 0x67 ),
+    BYTES_TO_T_UINT_8( 0x9F, 0x29, 0x9E, 0x84, 0xF4, 0xE5, 0x6E, 0x7E ),
+    BYTES_TO_T_UINT_8( 0x55, 0x21, 0xB9, 0x50, 0x24, 0xF8, 0x9C, 0xC7 ),
+    BYTES_TO_T_UINT_8( 0x34, 0x04, 0x01, 0xC2, 0xFB, 0x77, 0x3E, 0xDE ),
+};
+static const mbedtls_mpi_uint secp384r1_T_2_Y[] = {
+    BYTES_TO_T_UINT_8( 0x00, 0x38, 0xEE, 0xE3, 0xC7, 0x9D, 0xEC, 0xA6 ),
+    BYTES_TO_T_UINT_8( 0xB6, 0x88, 0xCF, 0x43, 0xFA, 0x92, 0x5E, 0x8E ),
+    BYTES_TO_T_UINT_8( 0xE9, 0xCA, 0x43, 0xF8, 0x3B, 0x49, 0x7E, 0x75 ),
+    BYTES_TO_T_UINT_8( 0x1C, 0xE7, 0xEB, 0x17, 0x45, 0x86, 0xC2, 0xE1 ),
+    BYTES_TO_T_UINT_8( 0x92, 0x69, 0x57, 0x32, 0xE0, 0x9C, 0xD1, 0x00 ),
+    BYTES_TO_T_UINT_8( 0xD9, 0x10, 0xB8, 0x4D, 0xB8, 0xF4, 0x0D, 0xE3 ),
+};
+static const mbedtls_mpi_uint secp384r1_T_3_X[] = {
+    BYTES_TO_T_UINT_8( 0x60, 0xDC, 0x9A, 0xB2, 0x79, 0x39, 0x27, 0x16 ),
+    BYTES_TO_T_UINT_8( 0x4F, 0x71, 0xE4, 0x3B, 0x4D, 0x60, 0x0C, 0xA3 ),
+    BYTES_TO_T_UINT_8( 0x55, 0xBD, 0x19, 0x40, 0xFA, 0x19, 0x2A, 0x5A ),
+    BYTES_TO_T_UINT_8( 0x4D, 0xF8, 0x1E, 0x43, 0xA1, 0x50, 0x8D, 0xEF ),
+    BYTES_TO_T_UINT_8( 0xA3, 0x18, 0x7C, 0x41, 0xFA, 0x7C, 0x1B, 0x58 ),
+    BYTES_TO_T_UINT_8( 0x00, 0x59, 0x24, 0xC4, 0xE9, 0xB7, 0xD3, 0xAD ),
+};
+static const mbedtls_mpi_uint secp384r1_T_3_Y[] = {
+    BYTES_TO_T_UINT_8( 0xBB, 0x01, 0x3D, 0x63, 0x54, 0x45, 0x6F, 0xB7 ),
+    BYTES_TO_T_UINT_8( 0x7B, 0xB2, 0x19, 0xA3, 0x86, 0x1D, 0x42, 0x34 ),
+    BYTES_TO_T_UINT_8( 0x84, 0x02, 0x87, 0x18, 0x92, 0x52, 0x1A, 0x71 ),
+    BYTES_TO_T_UINT_8( 0x6C, 0x18, 0xB1, 0x5D, 0x18, 0x1B, 0x37, 0xFE ),
+    BYTES_TO_T_UINT_8( 0xF4, 0x74, 0x61, 0xBA, 0x18, 0xAF, 0x40, 0x30 ),
+    BYTES_TO_T_UINT_8( 0xDA, 0x7D, 0x3C, 0x52, 0x0F, 0x07, 0xB0, 0x6F ),
+};
+static const mbedtls_mpi_uint secp384r1_T_4_X[] = {
+    BYTES_TO_T_UINT_8( 0x09, 0x39, 0x13, 0xAA, 0x60, 0x15, 0x99, 0x30 ),
+    BYTES_TO_T_UINT_8( 0x17, 0x00, 0xCB, 0xC6, 0xB1, 0xDB, 0x97, 0x90 ),
+    BYTES_TO_T_UINT_8( 0xE6, 0xFA, 0x60, 0xB8, 0x24, 0xE4, 0x7D, 0xD3 ),
+    BYTES_TO_T_UINT_8( 0xDD, 0x75, 0xB3, 0x70, 0xB2, 0x83, 0xB1, 0x9B ),
+    BYTES_TO_T_UINT_8( 0xA3, 0xE3, 0x6C, 0xCD, 0x33, 0x62, 0x7A, 0x56 ),
+    BYTES_TO_T_UINT_8( 0x88, 0x30, 0xDC, 0x0F, 0x9F, 0xBB, 0xB8, 0xAA ),
+};
+static const mbedtls_mpi_uint secp384r1_T_4_Y[] = {
+    BYTES_TO_T_UINT_8( 0xA6, 0xD5, 0x0A, 0x60, 0x81, 0xB9, 0xC5, 0x16 ),
+    BYTES_TO_T_UINT_8( 0x44, 0xAA, 0x2F, 0xD6, 0xF2, 0x73, 0xDF, 0xEB ),
+    BYTES_TO_T_UINT_8( 0xF3, 0x7B, 0x74, 0xC9, 0xB3, 0x5B, 0x95, 0x6D ),
+    BYTES_TO_T_UINT_8( 0xAC, 0x04, 0xEB, 0x15, 0xC8, 0x5F, 0x00, 0xF6 ),
+    BYTES_TO_T_UINT_8( 0xB5, 0x50, 0x20, 0x28, 0xD1, 0x01, 0xAF, 0xF0 ),
+    BYTES_TO_T_UINT_8( 0x28, 0x6D, 0x4F, 0x31, 0x81, 0x2F, 0x94, 0x48 ),
+};
+static const mbedtls_mpi_uint secp384r1_T_5_X[] = {
+    BYTES_TO_T_UINT_8( 0x46, 0x2F, 0xD8, 0xB6, 0x63, 0x7C, 0xE9, 0x50 ),
+    BYTES_TO_T_UINT_8( 0xD9, 0x8C, 0xB9, 0x14, 0xD9, 0x37, 0x63, 0xDE ),
+    BYTES_TO_T_UINT_8( 0x10, 0x02, 0xB8, 0x46, 0xAD, 0xCE, 0x7B, 0x38 ),
+    BYTES_TO_T_UINT_8( 0x82, 0x47, 0x2D, 0x66, 0xA7, 0xE9, 0x33, 0x23 ),
+    BYTES_TO_T_UINT_8( 0x92, 0xF9, 0x93, 0x94, 0xA8, 0x48, 0xB3, 0x4F ),
+    BYTES_TO_T_UINT_8( 0xE9, 0x4A, 0xAC, 0x51, 0x08, 0x72, 0x2F, 0x1A ),
+};
+static const mbedtls_mpi_uint secp384r1_T_5_Y[] = {
+    BYTES_TO_T_UINT_8( 0xDA, 0xAD, 0xA0, 0xF9, 0x81, 0xE1, 0x78, 0x97 ),
+    BYTES_TO_T_UINT_8( 0x3A, 0x9A, 0x63, 0xD8, 0xBA, 0x79, 0x1A, 0x17 ),
+    BYTES_TO_T_UINT_8( 0x34, 0x31, 0x7B, 0x7A, 0x5A, 0x5D, 0x7D, 0x2D ),
+    BYTES_TO_T_UINT_8( 0x83, 0x96, 0x12, 0x4B, 0x19, 0x09, 0xE0, 0xB7 ),
+    BYTES_TO_T_UINT_8( 0x55, 0x8A, 0x57, 0xEE, 0x4E, 0x6E, 0x7E, 0xEC ),
+    BYTES_TO_T_UINT_8( 0x11, 0x9D, 0x69, 0xDC, 0xB3, 0xDA, 0xD8, 0x08 ),
+};
+static const mbedtls_mpi_uint secp384r1_T_6_X[] = {
+    BYTES_TO_T_UINT_8( 0x68, 0x49, 0x03, 0x03, 0x33, 0x6F, 0x28, 0x4A ),
+    BYTES_TO_T_UINT_8( 0x5D, 0xDB, 0xA7, 0x05, 0x8C, 0xF3, 0x4D, 0xFB ),
+    BYTES_TO_T_UINT_8( 0x8E, 0x92, 0xB1, 0xA8, 0xEC, 0x0D, 0x64, 0x3B ),
+    BYTES_TO_T_UINT_8( 0x4E, 0xFC, 0xFD, 0xD0, 0x4B, 0x88, 0x1B, 0x5D ),
+    BYTES_TO_T_UINT_8( 0x83, 0x9C, 0x51, 0x69, 0xCE, 0x71, 0x73, 0xF5 ),
+    BYTES_TO_T_UINT_8( 0xB8, 0x5A, 0x14, 0x23, 0x1A, 0x46, 0x63, 0x5F ),
+};
+static const mbedtls_mpi_uint secp384r1_T_6_Y[] = {
+    BYTES_TO_T_UINT_8( 0xBC, 0x4C, 0x70, 0x44, 0x18, 0xCD, 0xEF, 0xED ),
+    BYTES_TO_T_UINT_8( 0xC2, 0x49, 0xDD, 0x64, 0x7E, 0x7E, 0x4D, 0x92 ),
+    BYTES_TO_T_UINT_8( 0xA2, 0x32, 0x7C, 0x09, 0xD0, 0x3F, 0xD6, 0x2C ),
+    BYTES_TO_T_UINT_8( 0x6D, 0xE0, 0x4F, 0x65, 0x0C, 0x7A, 0x54, 0x3E ),
+    BYTES_TO_T_UINT_8( 0x16, 0xFA, 0xFB, 0x4A, 0xB4, 0x79, 0x5A, 0x8C ),
+    BYTES_TO_T_UINT_8( 0x04, 0x5D, 0x1B, 0x2B, 0xDA, 0xBC, 0x9A, 0x74 ),
+};
+static const mbedtls_mpi_uint secp384r1_T_7_X[] = {
+    BYTES_TO_T_UINT_8( 0x51, 0xAC, 0x56, 0xF7, 0x5F, 0x51, 0x68, 0x0B ),
+    BYTES_TO_T_UINT_8( 0xC6, 0xE0, 0x1D, 0xBC, 0x13, 0x4E, 0xAC, 0x03 ),
+    BYTES_TO_T_UINT_8( 0xB7, 0xF5, 0xC5, 0xE6, 0xD2, 0x88, 0xBA, 0xCB ),
+    BYTES_TO_T_UINT_8( 0xFA, 0x0E, 0x28, 0x23, 0x58, 0x67, 0xFA, 0xEE ),
+    BYTES_TO_T_UINT_8( 0x9E, 0x80, 0x4B, 0xD8, 0xC4, 0xDF, 0x15, 0xE4 ),
+    BYTES_TO_T_UINT_8( 0xF1, 0x0E, 0x58, 0xE6, 0x2C, 0x59, 0xC2, 0x03 ),
+};
+static const mbedtls_mpi_uint secp384r1_T_7_Y[] = {
+    BYTES_TO_T_UINT_8( 0x9B, 0x26, 0x27, 0x99, 0x16, 0x2B, 0x22, 0x0B ),
+    BYTES_TO_T_UINT_8( 0xBA, 0xF3, 0x8F, 0xC3, 0x2A, 0x9B, 0xFC, 0x38 ),
+    BYTES_TO_T_UINT_8( 0xFC, 0x2E, 0x83, 0x3D, 0xFE, 0x9E, 0x3C, 0x1B ),
+    BYTES_TO_T_UINT_8( 0x08, 0x57, 0xCD, 0x2D, 0xC1, 0x49, 0x38, 0xB5 ),
+    BYTES_TO_T_UINT_8( 0x95, 0x42, 0x8B, 0x33, 0x89, 0x1F, 0xEA, 0x01 ),
+    BYTES_TO_T_UINT_8( 0xAA, 0x1D, 0x13, 0xD7, 0x50, 0xBB, 0x3E, 0xEB ),
+};
+static const mbedtls_mpi_uint secp384r1_T_8_X[] = {
+    BYTES_TO_T_UINT_8( 0xD2, 0x9A, 0x52, 0xD2, 0x54, 0x7C, 0x97, 0xF2 ),
+    BYTES_TO_T_UINT_8( 0xE0, 0x33, 0x6E, 0xED, 0xD9, 0x87, 0x50, 0xC5 ),
+    BYTES_TO_T_UINT_8( 0x5A, 0x35, 0x7E, 0x16, 0x40, 0x15, 0x83, 0xB8 ),
+    BYTES_TO_T_UINT_8( 0x33, 0x2B, 0xA4, 0xAB, 0x03, 0x91, 0xEA, 0xFE ),
+    BYTES_TO_T_UINT_8( 0xC1, 0x47, 0x39, 0xEF, 0x05, 0x59, 0xD0, 0x90 ),
+    BYTES_TO_T_UINT_8( 0xBF, 0x24, 0x0D, 0x76, 0x11, 0x53, 0x08, 0xAF ),
+};
+static const mbedtls_mpi_uint secp384r1_T_8_Y[] = {
+    BYTES_TO_T_UINT_8( 0x1F, 0x2F, 0xDD, 0xBD, 0x50, 0x48, 0xB1, 0xE5 ),
+    BYTES_TO_T_UINT_8( 0x80, 0x1C, 0x84, 0x55, 0x78, 0x14, 0xEB, 0xF6 ),
+    BYTES_TO_T_UINT_8( 0xD9, 0x5E, 0x3E, 0xA6, 0xAF, 0xF6, 0xC7, 0x04 ),
+    BYTES_TO_T_UINT_8( 0xE7, 0x11, 0xE2, 0x65, 0xCA, 0x41, 0x95, 0x3B ),
+    BYTES_TO_T_UINT_8( 0xAE, 0x83, 0xD8, 0xE6, 0x4D, 0x22, 0x06, 0x2D ),
+    BYTES_TO_T_UINT_8( 0xFA, 0x7F, 0x25, 0x2A, 0xAA, 0x28, 0x46, 0x97 ),
+};
+static const mbedtls_mpi_uint secp384r1_T_9_X[] = {
+    BYTES_TO_T_UINT_8( 0x79, 0xDB, 0x15, 0x56, 0x84, 0xCB, 0xC0, 0x56 ),
+    BYTES_TO_T_UINT_8( 0x56, 0xDB, 0x0E, 0x08, 0xC9, 0xF5, 0xD4, 0x9E ),
+    BYTES_TO_T_UINT_8( 0xE6, 0x62, 0xD0, 0x1A, 0x7C, 0x13, 0xD5, 0x07 ),
+    BYTES_TO_T_UINT_8( 0x7D, 0xAD, 0x53, 0xE0, 0x32, 0x21, 0xA0, 0xC0 ),
+    BYTES_TO_T_UINT_8( 0xC5, 0x38, 0x81, 0x21, 0x23, 0x0E, 0xD2, 0xBB ),
+    BYTES_TO_T_UINT_8( 0x1C, 0x51, 0x05, 0xD0, 0x1E, 0x82, 0xA9, 0x71 ),
+};
+static const mbedtls_mpi_uint secp384r1_T_9_Y[] = {
+    BYTES_TO_T_UINT_8( 0xA7, 0xC3, 0x27, 0xBF, 0xC6, 0xAA, 0xB7, 0xB9 ),
+    BYTES_TO_T_UINT_8( 0xCB, 0x65, 0x45, 0xDF, 0xB9, 0x46, 0x17, 0x46 ),
+    BYTES_TO_T_UINT_8( 0xF5, 0x38, 0x3F, 0xB2, 0xB1, 0x5D, 0xCA, 0x1C ),
+    BYTES_TO_T_UINT_8( 0x88, 0x29, 0x6C, 0x63, 0xE9, 0xD7, 0x48, 0xB8 ),
+    BYTES_TO_T_UINT_8( 0xBC, 0xF1, 0xD7, 0x99, 0x8C, 0xC2, 0x05, 0x99 ),
+    BYTES_TO_T_UINT_8( 0x6D, 0xE6, 0x5E, 0x82, 0x6D, 0xE5, 0x7E, 0xD5 ),
+};
+static const mbedtls_mpi_uint secp384r1_T_10_X[] = {
+    BYTES_TO_T_UINT_8( 0x7B, 0x61, 0xFA, 0x7D, 0x01, 0xDB, 0xB6, 0x63 ),
+    BYTES_TO_T_UINT_8( 0x11, 0xC6, 0x58, 0x39, 0xF4, 0xC6, 0x82, 0x23 ),
+    BYTES_TO_T_UINT_8( 0x47, 0x5A, 0x7A, 0x80, 0x08, 0xCD, 0xAA, 0xD8 ),
+    BYTES_TO_T_UINT_8( 0xDA, 0x8C, 0xC6, 0x3F, 0x3C, 0xA5, 0x68, 0xF4 ),
+    BYTES_TO_T_UINT_8( 0xBB, 0xF5, 0xD5, 0x17, 0xAE, 0x36, 0xD8, 0x8A ),
+    BYTES_TO_T_UINT_8( 0xC7, 0xAD, 0x92, 0xC5, 0x57, 0x6C, 0xDA, 0x91 ),
+};
+static const mbedtls_mpi_uint secp384r1_T_10_Y[] = {
+    BYTES_TO_T_UINT_8( 0xE8, 0x67, 0x17, 0xC0, 0x40, 0x78, 0x8C, 0x84 ),
+    BYTES_TO_T_UINT_8( 0x7E, 0x9F, 0xF4, 0xAA, 0xDA, 0x5C, 0x7E, 0xB2 ),
+    BYTES_TO_T_UINT_8( 0x96, 0xDB, 0x42, 0x3E, 0x72, 0x64, 0xA0, 0x67 ),
+    BYTES_TO_T_UINT_8( 0x27, 0xF9, 0x41, 0x17, 0x43, 0xE3, 0xE8, 0xA8 ),
+    BYTES_TO_T_UINT_8( 0x66, 0xDD, 0xCC, 0x43, 0x7E, 0x16, 0x05, 0x03 ),
+    BYTES_TO_T_UINT_8( 0x36, 0x4B, 0xCF, 0x48, 0x8F, 0x41, 0x90, 0xE5 ),
+};
+static const mbedtls_mpi_uint secp384r1_T_11_X[] = {
+    BYTES_TO_T_UINT_8( 0x98, 0x0C, 0x6B, 0x9D, 0x22, 0x04, 0xBC, 0x5C ),
+    BYTES_TO_T_UINT_8( 0x86, 0x63, 0x79, 0x2F, 0x6A, 0x0E, 0x8A, 0xDE ),
+    BYTES_TO_T_UINT_8( 0x29, 0x67, 0x3F, 0x02, 0xB8, 0x91, 0x7F, 0x74 ),
+    BYTES_TO_T_UINT_8( 0xFC, 0x14, 0x64, 0xA0, 0x33, 0xF4, 0x6B, 0x50 ),
+    BYTES_TO_T_UINT_8( 0x1C, 0x44, 0x71, 0x87, 0xB8, 0x88, 0x3F, 0x45 ),
+    BYTES_TO_T_UINT_8( 0x1B, 0x2B, 0x85, 0x05, 0xC5, 0x44, 0x53, 0x15 ),
+};
+static const mbedtls_mpi_uint secp384r1_T_11_Y[] = {
+    BYTES_TO_T_UINT_8( 0x3E, 0x2B, 0xFE, 0xD1, 0x1C, 0x73, 0xE3, 0x2E ),
+    BYTES_TO_T_UINT_8( 0x66, 0x33, 0xA1, 0xD3, 0x69, 0x1C, 0x9D, 0xD2 ),
+    BYTES_TO_T_UINT_8( 0xE0, 0x5A, 0xBA, 0xB6, 0xAE, 0x1B, 0x94, 0x04 ),
+    BYTES_TO_T_UINT_8( 0xAF, 0x74, 0x90, 0x5C, 0x57, 0xB0, 0x3A, 0x45 ),
+    BYTES_TO_T_UINT_8( 0xDD, 0x2F, 0x93, 0x20, 0x24, 0x54, 0x1D, 0x8D ),
+    BYTES_TO_T_UINT_8( 0xFA, 0x78, 0x9D, 0x71, 0x67, 0x5D, 0x49, 0x98 ),
+};
+static const mbedtls_mpi_uint secp384r1_T_12_X[] = {
+    BYTES_TO_T_UINT_8( 0x12, 0xC8, 0x0E, 0x11, 0x8D, 0xE0, 0x8F, 0x69 ),
+    BYTES_TO_T_UINT_8( 0x59, 0x7F, 0x79, 0x6C, 0x5F, 0xB7, 0xBC, 0xB1 ),
+    BYTES_TO_T_UINT_8( 0x88, 0xE1, 0x83, 0x3C, 0x12, 0xBB, 0xEE, 0x96 ),
+    BYTES_TO_T_UINT_8( 0x2A, 0xC2, 0xC4, 0x1B, 0x41, 0x71, 0xB9, 0x17 ),
+    BYTES_TO_T_UINT_8( 0xB0, 0xEE, 0xBB, 0x1D, 0x89, 0x50, 0x88, 0xF2 ),
+    BYTES_TO_T_UINT_8( 0xFC, 0x1C, 0x55, 0x74, 0xEB, 0xDE, 0x92, 0x3F ),
+};
+static const mbedtls_mpi_uint secp384r1_T_12_Y[] = {
+    BYTES_TO_T_UINT_8( 0x9C, 0x38, 0x92, 0x06, 0x19, 0xD0, 0xB3, 0xB2 ),
+    BYTES_TO_T_UINT_8( 0x2A, 0x99, 0x26, 0xA3, 0x5F, 0xE2, 0xC1, 0x81 ),
+    BYTES_TO_T_UINT_8( 0x75, 0xFC, 0xFD, 0xC3, 0xB6, 0x26, 0x24, 0x8F ),
+    BYTES_TO_T_UINT_8( 0xAF, 0xAD, 0xE7, 0x49, 0xB7, 0x64, 0x4B, 0x96 ),
+    BYTES_TO_T_UINT_8( 0x6C, 0x4E, 0x95, 0xAD, 0x07, 0xFE, 0xB6, 0x30 ),
+    BYTES_TO_T_UINT_8( 0x4F, 0x15, 0xE7, 0x2D, 0x19, 0xA9, 0x08, 0x10 ),
+};
+static const mbedtls_mpi_uint secp384r1_T_13_X[] = {
+    BYTES_TO_T_UINT_8( 0xBE, 0xBD, 0xAC, 0x0A, 0x3F, 0x6B, 0xFF, 0xFA ),
+    BYTES_TO_T_UINT_8( 0xE0, 0xE4, 0x74, 0x14, 0xD9, 0x70, 0x1D, 0x71 ),
+    BYTES_TO_T_UINT_8( 0xF2, 0xB0, 0x71, 0xBB, 0xD8, 0x18, 0x96, 0x2B ),
+    BYTES_TO_T_UINT_8( 0xDA, 0xB8, 0x19, 0x90, 0x80, 0xB5, 0xEE, 0x01 ),
+    BYTES_TO_T_UINT_8( 0x91, 0x21, 0x20, 0xA6, 0x17, 0x48, 0x03, 0x6F ),
+    BYTES_TO_T_UINT_8( 0xE3, 0x1D, 0xBB, 0x6D, 0x94, 0x20, 0x34, 0xF1 ),
+};
+static const mbedtls_mpi_uint secp384r1_T_13_Y[] = {
+    BYTES_TO_T_UINT_8( 0x59, 0x82, 0x67, 0x4B, 0x8E, 0x4E, 0xBE, 0xE2 ),
+    BYTES_TO_T_UINT_8( 0xBE, 0xDA, 0x77, 0xF8, 0x23, 0x55, 0x2B, 0x2D ),
+    BYTES_TO_T_UINT_8( 0x5C, 0x02, 0xDE, 0x25, 0x35, 0x2D, 0x74, 0x51 ),
+    BYTES_TO_T_UINT_8( 0xD0, 0x0C, 0xB8, 0x0B, 0x39, 0xBA, 0xAD, 0x04 ),
+    BYTES_TO_T_UINT_8( 0xA6, 0x0E, 0x28, 0x4D, 0xE1, 0x3D, 0xE4, 0x1B ),
+    BYTES_TO_T_UINT_8( 0x5D, 0xEC, 0x0A, 0xD4, 0xB8, 0xC4, 0x8D, 0xB0 ),
+};
+static const mbedtls_mpi_uint secp384r1_T_14_X[] = {
+    BYTES_TO_T_UINT_8( 0x3E, 0x68, 0xCE, 0xC2, 0x55, 0x4D, 0x0C, 0x6D ),
+    BYTES_TO_T_UINT_8( 0x9B, 0x20, 0x93, 0x32, 0x90, 0xD6, 0xAE, 0x47 ),
+    BYTES_TO_T_UINT_8( 0xDD, 0x78, 0xAB, 0x43, 0x9E, 0xEB, 0x73, 0xAE ),
+    BYTES_TO_T_UINT_8( 0xED, 0x97, 0xC3, 0x83, 0xA6, 0x3C, 0xF1, 0xBF ),
+    BYTES_TO_T_UINT_8( 0x0F, 0x25, 0x25, 0x66, 0x08, 0x26, 0xFA, 0x4B ),
+    BYTES_TO_T_UINT_8( 0x41, 0xFB, 0x44, 0x5D, 0x82, 0xEC, 0x3B, 0xAC ),
+};
+static const mbedtls_mpi_uint secp384r1_T_14_Y[] = {
+    BYTES_TO_T_UINT_8( 0x58, 0x90, 0xEA, 0xB5, 0x04, 0x99, 0xD0, 0x69 ),
+    BYTES_TO_T_UINT_8( 0x4A, 0xF2, 0x22, 0xA0, 0xEB, 0xFD, 0x45, 0x87 ),
+    BYTES_TO_T_UINT_8( 0x5D, 0xA4, 0x81, 0x32, 0xFC, 0xFA, 0xEE, 0x5B ),
+    BYTES_TO_T_UINT_8( 0x27, 0xBB, 0xA4, 0x6A, 0x77, 0x41, 0x5C, 0x1D ),
+    BYTES_TO_T_UINT_8( 0xA1, 0x1E, 0xAA, 0x4F, 0xF0, 0x10, 0xB3, 0x50 ),
+    BYTES_TO_T_UINT_8( 0x09, 0x74, 0x13, 0x14, 0x9E, 0x90, 0xD7, 0xE6 ),
+};
+static const mbedtls_mpi_uint secp384r1_T_15_X[] = {
+    BYTES_TO_T_UINT_8( 0xDB, 0xBD, 0x70, 0x4F, 0xA8, 0xD1, 0x06, 0x2C ),
+    BYTES_TO_T_UINT_8( 0x19, 0x4E, 0x2E, 0x68, 0xFC, 0x35, 0xFA, 0x50 ),
+    BYTES_TO_T_UINT_8( 0x60, 0x53, 0x75, 0xED, 0xF2, 0x5F, 0xC2, 0xEB ),
+    BYTES_TO_T_UINT_8( 0x39, 0x87, 0x6B, 0x9F, 0x05, 0xE2, 0x22, 0x93 ),
+    BYTES_TO_T_UINT_8( 0x4F, 0x1A, 0xA8, 0xB7, 0x03, 0x9E, 0x6D, 0x7C ),
+    BYTES_TO_T_UINT_8( 0xCB, 0xD0, 0x69, 0x88, 0xA8, 0x39, 0x9E, 0x3A ),
+};
+static const mbedtls_mpi_uint secp384r1_T_15_Y[] = {
+    BYTES_TO_T_UINT_8( 0xF8, 0xEF, 0x68, 0xFE, 0xEC, 0x24, 0x08, 0x15 ),
+    BYTES_TO_T_UINT_8( 0xA1, 0x06, 0x4B, 0x92, 0x0D, 0xB7, 0x34, 0x74 ),
+    BYTES_TO_T_UINT_8( 0x3E, 0xF4, 0xDD, 0x1A, 0xA0, 0x4A, 0xE4, 0x45 ),
+    BYTES_TO_T_UINT_8( 0xC3, 0x63, 0x4F, 0x4F, 0xCE, 0xBB, 0xD6, 0xD3 ),
+    BYTES_TO_T_UINT_8( 0xCD, 0xEE, 0x8D, 0xDF, 0x3F, 0x73, 0xB7, 0xAC ),
+    BYTES_TO_T_UINT_8( 0xDF, 0x06, 0xB6, 0x80, 0x4D, 0x81, 0xD9, 0x53 ),
+};
+static const mbedtls_mpi_uint secp384r1_T_16_X[] = {
+    BYTES_TO_T_UINT_8( 0x15, 0xF5, 0x13, 0xDF, 0x13, 0x19, 0x97, 0x94 ),
+    BYTES_TO_T_UINT_8( 0x08, 0xF9, 0xB3, 0x33, 0x66, 0x82, 0x21, 0xFE ),
+    BYTES_TO_T_UINT_8( 0xF5, 0xFC, 0x39, 0x16, 0x23, 0x43, 0x76, 0x0E ),
+    BYTES_TO_T_UINT_8( 0x09, 0x48, 0x25, 0xA1, 0x64, 0x95, 0x1C, 0x2F ),
+    BYTES_TO_T_UINT_8( 0x43, 0xAC, 0x15, 0x57, 0xD9, 0xDE, 0xA0, 0x28 ),
+    BYTES_TO_T_UINT_8( 0x16, 0x5F, 0xB8, 0x3D, 0x48, 0x91, 0x24, 0xCC ),
+};
+static const mbedtls_mpi_uint secp384r1_T_16_Y[] = {
+    BYTES_TO_T_UINT_8( 0x2D, 0xF2, 0xC8, 0x54, 0xD1, 0x32, 0xBD, 0xC4 ),
+    BYTES_TO_T_UINT_8( 0x8A, 0x3B, 0xF0, 0xAA, 0x9D, 0xD8, 0xF4, 0x20 ),
+    BYTES_TO_T_UINT_8( 0x4F, 0xC3, 0xBB, 0x6C, 0x66, 0xAC, 0x25, 0x2D ),
+    BYTES_TO_T_UINT_8( 0x6F, 0x25, 0x10, 0xB2, 0xE1, 0x41, 0xDE, 0x1D ),
+    BYTES_TO_T_UINT_8( 0x3C, 0xE8, 0x30, 0xB8, 0x37, 0xBC, 0x2A, 0x98 ),
+    BYTES_TO_T_UINT_8( 0xBA, 0x57, 0x01, 0x4A, 0x1E, 0x78, 0x9F, 0x85 ),
+};
+static const mbedtls_mpi_uint secp384r1_T_17_X[] = {
+    BYTES_TO_T_UINT_8( 0xBD, 0x19, 0xCD, 0x12, 0x0B, 0x51, 0x4F, 0x56 ),
+    BYTES_TO_T_UINT_8( 0x30, 0x4B, 0x3D, 0x24, 0xA4, 0x16, 0x59, 0x05 ),
+    BYTES_TO_T_UINT_8( 0xAC, 0xEB, 0xD3, 0x59, 0x2E, 0x75, 0x7C, 0x01 ),
+    BYTES_TO_T_UINT_8( 0x8C, 0xB9, 0xB4, 0xA5, 0xD9, 0x2E, 0x29, 0x4C ),
+    BYTES_TO_T_UINT_8( 0x86, 0x16, 0x05, 0x75, 0x02, 0xB3, 0x06, 0xEE ),
+    BYTES_TO_T_UINT_8( 0xAB, 0x7C, 0x9F, 0x79, 0x91, 0xF1, 0x4F, 0x23 ),
+};
+static const mbedtls_mpi_uint secp384r1_T_17_Y[] = {
+    BYTES_TO_T_UINT_8( 0x65, 0x98, 0x7C, 0x84, 0xE1, 0xFF, 0x30, 0x77 ),
+    BYTES_TO_T_UINT_8( 0x71, 0xE2, 0xC2, 0x5F, 0x55, 0x40, 0xBD, 0xCD ),
+    BYTES_TO_T_UINT_8( 0x69, 0x65, 0x87, 0x3F, 0xC4, 0xC2, 0x24, 0x57 ),
+    BYTES_TO_T_UINT_8( 0x0E, 0x30, 0x0A, 0x60, 0x15, 0xD1, 0x24, 0x48 ),
+    BYTES_TO_T_UINT_8( 0x57, 0x99, 0xD9, 0xB6, 0xAE, 0xB1, 0xAF, 0x1D ),
+    BYTES_TO_T_UINT_8( 0x9B, 0x80, 0xEE, 0xA2, 0x0F, 0x74, 0xB9, 0xF3 ),
+};
+static const mbedtls_mpi_uint secp384r1_T_18_X[] = {
+    BYTES_TO_T_UINT_8( 0x03, 0xE6, 0x0F, 0x37, 0xC1, 0x10, 0x99, 0x1E ),
+    BYTES_TO_T_UINT_8( 0x61, 0xAD, 0x9D, 0x5D, 0x80, 0x01, 0xA6, 0xFE ),
+    BYTES_TO_T_UINT_8( 0xB0, 0x0F, 0x10, 0x2A, 0x9D, 0x20, 0x38, 0xEB ),
+    BYTES_TO_T_UINT_8( 0x6C, 0x60, 0xCB, 0xCE, 0x5A, 0xA0, 0xA7, 0x32 ),
+    BYTES_TO_T_UINT_8( 0xBA, 0xCF, 0x14, 0xDF, 0xBF, 0xE5, 0x74, 0x2D ),
+    BYTES_TO_T_UINT_8( 0xB5, 0x12, 0x1A, 0xDD, 0x59, 0x02, 0x5D, 0xC6 ),
+};
+static const mbedtls_mpi_uint secp384r1_T_18_Y[] = {
+    BYTES_TO_T_UINT_8( 0xC8, 0xC9, 0xF8, 0xF5, 0xB6, 0x13, 0x4D, 0x7B ),
+    BYTES_TO_T_UINT_8( 0xED, 0x45, 0xB1, 0x93, 0xB3, 0xA2, 0x79, 0xDC ),
+    BYTES_TO_T_UINT_8( 0x74, 0xF6, 0xCF, 0xF7, 0xE6, 0x29, 0x9C, 0xCC ),
+    BYTES_TO_T_UINT_8( 0x87, 0x50, 0x65, 0x80, 0xBC, 0x59, 0x0A, 0x59 ),
+    BYTES_TO_T_UINT_8( 0x0E, 0xF0, 0x24, 0x35, 0xA2, 0x46, 0xF0, 0x0C ),
+    BYTES_TO_T_UINT_8( 0xBD, 0x26, 0xC0, 0x9D, 0x61, 0x56, 0x62, 0x67 ),
+};
+static const mbedtls_mpi_uint secp384r1_T_19_X[] = {
+    BYTES_TO_T_UINT_8( 0x10, 0xBB, 0xC2, 0x24, 0x43, 0x2E, 0x37, 0x54 ),
+    BYTES_TO_T_UINT_8( 0x8A, 0xF7, 0xCE, 0x35, 0xFC, 0x77, 0xF3, 0x3F ),
+    BYTES_TO_T_UINT_8( 0x75, 0x34, 0x96, 0xD5, 0x4A, 0x76, 0x9D, 0x6B ),
+    BYTES_TO_T_UINT_8( 0xB8, 0x3B, 0x0F, 0xEA, 0xA8, 0x12, 0x0B, 0x22 ),
+    BYTES_TO_T_UINT_8( 0x66, 0x3F, 0x5D, 0x2D, 0x1C, 0xD4, 0x9E, 0xFB ),
+    BYTES_TO_T_UINT_8( 0x7D, 0x2E, 0xDD, 0xC7, 0x6E, 0xAB, 0xAF, 0xDC ),
+};
+static const mbedtls_mpi_uint secp384r1_T_19_Y[] = {
+    BYTES_TO_T_UINT_8( 0x8C, 0xB2, 0x7B, 0x0C, 0x9A, 0x83, 0x8E, 0x59 ),
+    BYTES_TO_T_UINT_8( 0x30, 0x51, 0x90, 0x92, 0x79, 0x32, 0x19, 0xC3 ),
+    BYTES_TO_T_UINT_8( 0xEE, 0x89, 0xF9, 0xD0, 0xCF, 0x2C, 0xA5, 0x8F ),
+    BYTES_TO_T_UINT_8( 0x7B, 0x50, 0x21, 0xDE, 0x50, 0x41, 0x9D, 0x81 ),
+    BYTES_TO_T_UINT_8( 0xE0, 0x7D, 0x2B, 0x9E, 0x9D, 0x95, 0xA8, 0xE3 ),
+    BYTES_TO_T_UINT_8( 0xD8, 0xA5, 0x20, 0x87, 0x88, 0x97, 0x5F, 0xAA ),
+};
+static const mbedtls_mpi_uint secp384r1_T_20_X[] = {
+    BYTES_TO_T_UINT_8( 0x64, 0x59, 0xB4, 0x66, 0x7E, 0xE8, 0x5A, 0x60 ),
+    BYTES_TO_T_UINT_8( 0xA5, 0x5C, 0x7E, 0xB2, 0xAD, 0xD9, 0xC9, 0xDA ),
+    BYTES_TO_T_UINT_8( 0x82, 0x97, 0x49, 0xA3, 0x13, 0x83, 0x07, 0x2E ),
+    BYTES_TO_T_UINT_8( 0x5A, 0x26, 0xC7, 0x13, 0x35, 0x0D, 0xB0, 0x6B ),
+    BYTES_TO_T_UINT_8( 0x1E, 0x60, 0xAB, 0xFA, 0x4B, 0x93, 0x18, 0x2C ),
+    BYTES_TO_T_UINT_8( 0x54, 0x2D, 0x1C, 0x31, 0x4C, 0xE4, 0x61, 0xAE ),
+};
+static const mbedtls_mpi_uint secp384r1_T_20_Y[] = {
+    BYTES_TO_T_UINT_8( 0xDE, 0x4D, 0x1E, 0x51, 0x59, 0x6E, 0x91, 0xC5 ),
+    BYTES_TO_T_UINT_8( 0x38, 0x54, 0x4D, 0x51, 0xED, 0x36, 0xCC, 0x60 ),
+    BYTES_TO_T_UINT_8( 0x18, 0xA8, 0x56, 0xC7, 0x78, 0x27, 0x33, 0xC5 ),
+    BYTES_TO_T_UINT_8( 0x42, 0xB7, 0x95, 0xC9, 0x8B, 0xC8, 0x6A, 0xBC ),
+    BYTES_TO_T_UINT_8( 0x5E, 0xE9, 0x13, 0x96, 0xB3, 0xE1, 0xF9, 0xEE ),
+    BYTES_TO_T_UINT_8( 0xF5, 0x46, 0xB0, 0x5E, 0xC3, 0x94, 0x03, 0x05 ),
+};
+static const mbedtls_mpi_uint secp384r1_T_21_X[] = {
+    BYTES_TO_T_UINT_8( 0x6D, 0x5B, 0x29, 0x30, 0x41, 0x1A, 0x9E, 0xB6 ),
+    BYTES_TO_T_UINT_8( 0x76, 0xCA, 0x83, 0x31, 0x5B, 0xA7, 0xCB, 0x42 ),
+    BYTES_TO_T_UINT_8( 0x21, 0x41, 0x50, 0x44, 0x4D, 0x64, 0x31, 0x89 ),
+    BYTES_TO_T_UINT_8( 0xCF, 0x84, 0xC2, 0x5D, 0x97, 0xA5, 0x3C, 0x18 ),
+    BYTES_TO_T_UINT_8( 0xF0, 0x0F, 0xA5, 0xFD, 0x8E, 0x5A, 0x47, 0x2C ),
+    BYTES_TO_T_UINT_8( 0x7C, 0x58, 0x02, 0x2D, 0x40, 0xB1, 0x0B, 0xBA ),
+};
+static const mbedtls_mpi_uint secp384r1_T_21_Y[] = {
+    BYTES_TO_T_UINT_8( 0xDA, 0x33, 0x8C, 0x67, 0xCE, 0x23, 0x43, 0x99 ),
+    BYTES_TO_T_UINT_8( 0x84, 0x53, 0x47, 0x72, 0x44, 0x1F, 0x5B, 0x2A ),
+    BYTES_TO_T_UINT_8( 0xAE, 0xC1, 0xD9, 0xA4, 0x50, 0x88, 0x63, 0x18 ),
+    BYTES_TO_T_UINT_8( 0x7C, 0xF2, 0x75, 0x69, 0x73, 0x00, 0xC4, 0x31 ),
+    BYTES_TO_T_UINT_8( 0x4B, 0x90, 0x1D, 0xDF, 0x1A, 0x00, 0xD8, 0x69 ),
+    BYTES_TO_T_UINT_8( 0x05, 0xB1, 0x89, 0x48, 0xA8, 0x70, 0x62, 0xEF ),
+};
+static const mbedtls_mpi_uint secp384r1_T_22_X[] = {
+    BYTES_TO_T_UINT_8( 0x7E, 0x8A, 0x55, 0x50, 0x7B, 0xEF, 0x8A, 0x3C ),
+    BYTES_TO_T_UINT_8( 0xFE, 0x1B, 0x23, 0x48, 0x23, 0x63, 0x91, 0xB6 ),
+    BYTES_TO_T_UINT_8( 0x0D, 0x04, 0x54, 0x3C, 0x24, 0x9B, 0xC7, 0x9A ),
+    BYTES_TO_T_UINT_8( 0x25, 0x38, 0xC3, 0x84, 0xFB, 0xFF, 0x9F, 0x49 ),
+    BYTES_TO_T_UINT_8( 0x66, 0x2A, 0xE0, 0x6D, 0x68, 0x8A, 0x5C, 0xCB ),
+    BYTES_TO_T_UINT_8( 0xC4, 0x93, 0x53, 0x85, 0xA1, 0x0D, 0xAF, 0x63 ),
+};
+static const mbedtls_mpi_uint secp384r1_T_22_Y[] = {
+    BYTES_TO_T_UINT_8( 0x1B, 0x88, 0x95, 0x4C, 0x0B, 0xD0, 0x06, 0x51 ),
+    BYTES_TO_T_UINT_8( 0x92, 0xAF, 0x8D, 0x49, 0xA2, 0xC8, 0xB4, 0xE0 ),
+    BYTES_TO_T_UINT_8( 0x75, 0x76, 0x53, 0x09, 0x88, 0x43, 0x87, 0xCA ),
+    BYTES_TO_T_UINT_8( 0x90, 0xA4, 0x77, 0x3F, 0x5E, 0x21, 0xB4, 0x0A ),
+    BYTES_TO_T_UINT_8( 0x35, 0x9E, 0x86, 0x64, 0xCC, 0x91, 0xC1, 0x77 ),
+    BYTES_TO_T_UINT_8( 0xC1, 0x17, 0x56, 0xCB, 0xC3, 0x7D, 0x5B, 0xB1 ),
+};
+static const mbedtls_mpi_uint secp384r1_T_23_X[] = {
+    BYTES_TO_T_UINT_8( 0x64, 0x74, 0x9F, 0xB5, 0x91, 0x21, 0xB1, 0x1C ),
+    BYTES_TO_T_UINT_8( 0x1E, 0xED, 0xE1, 0x11, 0xEF, 0x45, 0xAF, 0xC1 ),
+    BYTES_TO_T_UINT_8( 0xE0, 0x31, 0xBE, 0xB2, 0xBC, 0x72, 0x65, 0x1F ),
+    BYTES_TO_T_UINT_8( 0xB1, 0x4B, 0x8C, 0x77, 0xCE, 0x1E, 0x42, 0xB5 ),
+    BYTES_TO_T_UINT_8( 0xFF, 0xC9, 0xAA, 0xB9, 0xD9, 0x86, 0x99, 0x55 ),
+    BYTES_TO_T_UINT_8( 0x65, 0x23, 0x80, 0xC6, 0x4E, 0x35, 0x0B, 0x6D ),
+};
+static const mbedtls_mpi_uint secp384r1_T_23_Y[] = {
+    BYTES_TO_T_UINT_8( 0x47, 0xD8, 0xA2, 0x0A, 0x39, 0x32, 0x1D, 0x23 ),
+    BYTES_TO_T_UINT_8( 0x61, 0xC8, 0x86, 0xF1, 0x12, 0x9A, 0x4A, 0x05 ),
+    BYTES_TO_T_UINT_8( 0x8D, 0xF1, 0x7C, 0xAA, 0x70, 0x8E, 0xBC, 0x01 ),
+    BYTES_TO_T_UINT_8( 0x62, 0x01, 0x47, 0x8F, 0xDD, 0x8B, 0xA5, 0xC8 ),
+    BYTES_TO_T_UINT_8( 0xDB, 0x08, 0x21, 0xF4, 0xAB, 0xC7, 0xF5, 0x96 ),
+    BYTES_TO_T_UINT_8( 0x0A, 0x76, 0xA5, 0x95, 0xC4, 0x0F, 0x88, 0x1D ),
+};
+static const mbedtls_mpi_uint secp384r1_T_24_X[] = {
+    BYTES_TO_T_UINT_8( 0x3F, 0x42, 0x2A, 0x52, 0xCD, 0x75, 0x51, 0x49 ),
+    BYTES_TO_T_UINT_8( 0x90, 0x36, 0xE5, 0x04, 0x2B, 0x44, 0xC6, 0xEF ),
+    BYTES_TO_T_UINT_8( 0x5C, 0xEE, 0x16, 0x13, 0x07, 0x83, 0xB5, 0x30 ),
+    BYTES_TO_T_UINT_8( 0x76, 0x59, 0xC6, 0xA2, 0x19, 0x05, 0xD3, 0xC6 ),
+    BYTES_TO_T_UINT_8( 0xB6, 0x8B, 0xA8, 0x16, 0x09, 0xB7, 0xEA, 0xD6 ),
+    BYTES_TO_T_UINT_8( 0x70, 0xEE, 0x14, 0xAF, 0xB5, 0xFD, 0xD0, 0xEF ),
+};
+static const mbedtls_mpi_uint secp384r1_T_24_Y[] = {
+    BYTES_TO_T_UINT_8( 0x18, 0x7C, 0xCA, 0x71, 0x3E, 0x6E, 0x66, 0x75 ),
+    BYTES_TO_T_UINT_8( 0xBE, 0x31, 0x0E, 0x3F, 0xE5, 0x91, 0xC4, 0x7F ),
+    BYTES_TO_T_UINT_8( 0x8E, 0x3D, 0xC2, 0x3E, 0x95, 0x37, 0x58, 0x2B ),
+    BYTES_TO_T_UINT_8( 0x01, 0x1F, 0x02, 0x03, 0xF3, 0xEF, 0xEE, 0x66 ),
+    BYTES_TO_T_UINT_8( 0x28, 0x5B, 0x1A, 0xFC, 0x38, 0xCD, 0xE8, 0x24 ),
+    BYTES_TO_T_UINT_8( 0x12, 0x57, 0x42, 0x85, 0xC6, 0x21, 0x68, 0x71 ),
+};
+static const mbedtls_mpi_uint secp384r1_T_25_X[] = {
+    BYTES_TO_T_UINT_8( 0x8D, 0xA2, 0x4A, 0x66, 0xB1, 0x0A, 0xE6, 0xC0 ),
+    BYTES_TO_T_UINT_8( 0x86, 0x0C, 0x94, 0x9D, 0x5E, 0x99, 0xB2, 0xCE ),
+    BYTES_TO_T_UINT_8( 0xAD, 0x03, 0x40, 0xCA, 0xB2, 0xB3, 0x30, 0x55 ),
+    BYTES_TO_T_UINT_8( 0x74, 0x78, 0x48, 0x27, 0x34, 0x1E, 0xE2, 0x42 ),
+    BYTES_TO_T_UINT_8( 0xAE, 0x72, 0x5B, 0xAC, 0xC1, 0x6D, 0xE3, 0x82 ),
+    BYTES_TO_T_UINT_8( 0x57, 0xAB, 0x46, 0xCB, 0xEA, 0x5E, 0x4B, 0x0B ),
+};
+static const mbedtls_mpi_uint secp384r1_T_25_Y[] = {
+    BYTES_TO_T_UINT_8( 0xFC, 0x08, 0xAD, 0x4E, 0x51, 0x9F, 0x2A, 0x52 ),
+    BYTES_TO_T_UINT_8( 0x68, 0x5C, 0x7D, 0x4C, 0xD6, 0xCF, 0xDD, 0x02 ),
+    BYTES_TO_T_UINT_8( 0xD8, 0x76, 0x26, 0xE0, 0x8B, 0x10, 0xD9, 0x7C ),
+    BYTES_TO_T_UINT_8( 0x30, 0xA7, 0x23, 0x4E, 0x5F, 0xD2, 0x42, 0x17 ),
+    BYTES_TO_T_UINT_8( 0xD1, 0xE5, 0xA4, 0xEC, 0x77, 0x21, 0x34, 0x28 ),
+    BYTES_TO_T_UINT_8( 0x5C, 0x14, 0x65, 0xEA, 0x4A, 0x85, 0xC3, 0x2F ),
+};
+static const mbedtls_mpi_uint secp384r1_T_26_X[] = {
+    BYTES_TO_T_UINT_8( 0x19, 0xD8, 0x40, 0x27, 0x73, 0x15, 0x7E, 0x65 ),
+    BYTES_TO_T_UINT_8( 0xF6, 0xBB, 0x53, 0x7E, 0x0F, 0x40, 0xC8, 0xD4 ),
+    BYTES_TO_T_UINT_8( 0xEA, 0x37, 0x19, 0x73, 0xEF, 0x5A, 0x5E, 0x04 ),
+    BYTES_TO_T_UINT_8( 0x9C, 0x73, 0x2B, 0x49, 0x7E, 0xAC, 0x97, 0x5C ),
+    BYTES_TO_T_UINT_8( 0x15, 0xB2, 0xC3, 0x1E, 0x0E, 0xE7, 0xD2, 0x21 ),
+    BYTES_TO_T_UINT_8( 0x8A, 0x08, 0xD6, 0xDD, 0xAC, 0x21, 0xD6, 0x3E ),
+};
+static const mbedtls_mpi_uint secp384r1_T_26_Y[] = {
+    BYTES_TO_T_UINT_8( 0xA9, 0x26, 0xBE, 0x6D, 0x6D, 0xF2, 0x38, 0x3F ),
+    BYTES_TO_T_UINT_8( 0x08, 0x6C, 0x31, 0xA7, 0x49, 0x50, 0x3A, 0x89 ),
+    BYTES_TO_T_UINT_8( 0xC3, 0x99, 0xC6, 0xF5, 0xD2, 0xC2, 0x30, 0x5A ),
+    BYTES_TO_T_UINT_8( 0x2A, 0xE4, 0xF6, 0x8B, 0x8B, 0x97, 0xE9, 0xB2 ),
+    BYTES_TO_T_UINT_8( 0xDD, 0x21, 0xB7, 0x0D, 0xFC, 0x15, 0x54, 0x0B ),
+    BYTES_TO_T_UINT_8( 0x65, 0x83, 0x1C, 0xA4, 0xCD, 0x6B, 0x9D, 0xF2 ),
+};
+static const mbedtls_mpi_uint secp384r1_T_27_X[] = {
+    BYTES_TO_T_UINT_8( 0xD6, 0xE8, 0x4C, 0x48, 0xE4, 0xAA, 0x69, 0x93 ),
+    BYTES_TO_T_UINT_8( 0x27, 0x7A, 0x27, 0xFC, 0x37, 0x96, 0x1A, 0x7B ),
+    BYTES_TO_T_UINT_8( 0x6F, 0xE7, 0x30, 0xA5, 0xCF, 0x13, 0x46, 0x5C ),
+    BYTES_TO_T_UINT_8( 0x8C, 0xD8, 0xAF, 0x74, 0x23, 0x4D, 0x56, 0x84 ),
+    BYTES_TO_T_UINT_8( 0x32, 0x3D, 0x44, 0x14, 0x1B, 0x97, 0x83, 0xF0 ),
+    BYTES_TO_T_UINT_8( 0xFA, 0x47, 0xD7, 0x5F, 0xFD, 0x98, 0x38, 0xF7 ),
+};
+static const mbedtls_mpi_uint secp384r1_T_27_Y[] = {
+    BYTES_TO_T_UINT_8( 0xA3, 0x73, 0x64, 0x36, 0xFD, 0x7B, 0xC1, 0x15 ),
+    BYTES_TO_T_UINT_8( 0xEA, 0x5D, 0x32, 0xD2, 0x47, 0x94, 0x89, 0x2D ),
+    BYTES_TO_T_UINT_8( 0x51, 0xE9, 0x30, 0xAC, 0x06, 0xC8, 0x65, 0x04 ),
+    BYTES_TO_T_UINT_8( 0xFA, 0x6C, 0xB9, 0x1B, 0xF7, 0x61, 0x49, 0x53 ),
+    BYTES_TO_T_UINT_8( 0xD7, 0xFF, 0x32, 0x43, 0x80, 0xDA, 0xA6, 0xB1 ),
+    BYTES_TO_T_UINT_8( 0xAC, 0xF8, 0x04, 0x01, 0x95, 0x35, 0xCE, 0x21 ),
+};
+static const mbedtls_mpi_uint secp384r1_T_28_X[] = {
+    BYTES_TO_T_UINT_8( 0x6D, 0x06, 0x46, 0x0D, 0x51, 0xE2, 0xD8, 0xAC ),
+    BYTES_TO_T_UINT_8( 0x14, 0x57, 0x1D, 0x6F, 0x79, 0xA0, 0xCD, 0xA6 ),
+    BYTES_TO_T_UINT_8( 0xDF, 0xFB, 0x36, 0xCA, 0xAD, 0xF5, 0x9E, 0x41 ),
+    BYTES_TO_T_UINT_8( 0x6F, 0x7A, 0x1D, 0x9E, 0x1D, 0x95, 0x48, 0xDC ),
+    BYTES_TO_T_UINT_8( 0x81, 0x26, 0xA5, 0xB7, 0x15, 0x2C, 0xC2, 0xC6 ),
+    BYTES_TO_T_UINT_8( 0x86, 0x42, 0x72, 0xAA, 0x11, 0xDC, 0xC9, 0xB6 ),
+};
+static const mbedtls_mpi_uint secp384r1_T_28_Y[] = {
+    BYTES_TO_T_UINT_8( 0x3F, 0x6C, 0x64, 0xA7, 0x62, 0x3C, 0xAB, 0xD4 ),
+    BYTES_TO_T_UINT_8( 0x48, 0x6A, 0x44, 0xD8, 0x60, 0xC0, 0xA8, 0x80 ),
+    BYTES_TO_T_UINT_8( 0x82, 0x76, 0x58, 0x12, 0x57, 0x3C, 0x89, 0x46 ),
+    BYTES_TO_T_UINT_8( 0x82, 0x4F, 0x83, 0xCE, 0xCB, 0xB8, 0xD0, 0x2C ),
+    BYTES_TO_T_UINT_8( 0x9A, 0x84, 0x04, 0xB0, 0xAD, 0xEB, 0xFA, 0xDF ),
+    BYTES_TO_T_UINT_8( 0x34, 0xA4, 0xC3, 0x41, 0x44, 0x4E, 0x65, 0x3E ),
+};
+static const mbedtls_mpi_uint secp384r1_T_29_X[] = {
+    BYTES_TO_T_UINT_8( 0xB6, 0x16, 0xA9, 0x1C, 0xE7, 0x65, 0x20, 0xC1 ),
+    BYTES_TO_T_UINT_8( 0x58, 0x53, 0x32, 0xF8, 0xC0, 0xA6, 0xBD, 0x2C ),
+    BYTES_TO_T_UINT_8( 0xB7, 0xF0, 0xE6, 0x57, 0x31, 0xCC, 0x26, 0x6F ),
+    BYTES_TO_T_UINT_8( 0x27, 0xE3, 0x54, 0x1C, 0x34, 0xD3, 0x17, 0xBC ),
+    BYTES_TO_T_UINT_8( 0xF5, 0xAE, 0xED, 0xFB, 0xCD, 0xE7, 0x1E, 0x9F ),
+    BYTES_TO_T_UINT_8( 0x5A, 0x16, 0x1C, 0x34, 0x40, 0x00, 0x1F, 0xB6 ),
+};
+static const mbedtls_mpi_uint secp384r1_T_29_Y[] = {
+    BYTES_TO_T_UINT_8( 0x6A, 0x32, 0x00, 0xC2, 0xD4, 0x3B, 0x1A, 0x09 ),
+    BYTES_TO_T_UINT_8( 0x34, 0xE0, 0x99, 0x8F, 0x0C, 0x4A, 0x16, 0x44 ),
+    BYTES_TO_T_UINT_8( 0x83, 0x73, 0x18, 0x1B, 0xD4, 0x94, 0x29, 0x62 ),
+    BYTES_TO_T_UINT_8( 0x29, 0xA4, 0x2D, 0xB1, 0x9D, 0x74, 0x32, 0x67 ),
+    BYTES_TO_T_UINT_8( 0xBF, 0xF4, 0xB1, 0x0C, 0x37, 0x62, 0x8B, 0x66 ),
+    BYTES_TO_T_UINT_8( 0xC9, 0xFF, 0xDA, 0xE2, 0x35, 0xA3, 0xB6, 0x42 ),
+};
+static const mbedtls_mpi_uint secp384r1_T_30_X[] = {
+    BYTES_TO_T_UINT_8( 0x91, 0x49, 0x99, 0x65, 0xC5, 0xED, 0x16, 0xEF ),
+    BYTES_TO_T_UINT_8( 0x79, 0x42, 0x9A, 0xF3, 0xA7, 0x4E, 0x6F, 0x2B ),
+    BYTES_TO_T_UINT_8( 0x7B, 0x0A, 0x7E, 0xC0, 0xD7, 0x4E, 0x07, 0x55 ),
+    BYTES_TO_T_UINT_8( 0xD6, 0x7A, 0x31, 0x69, 0xA6, 0xB9, 0x15, 0x34 ),
+    BYTES_TO_T_UINT_8( 0xA8, 0xE0, 0x72, 0xA4, 0x3F, 0xB9, 0xF8, 0x0C ),
+    BYTES_TO_T_UINT_8( 0x2B, 0x75, 0x32, 0x85, 0xA2, 0xDE, 0x37, 0x12 ),
+};
+static const mbedtls_mpi_uint secp384r1_T_30_Y[] = {
+    BYTES_TO_T_UINT_8( 0xBC, 0xC0, 0x0D, 0xCF, 0x25, 0x41, 0xA4, 0xF4 ),
+    BYTES_TO_T_UINT_8( 0x9B, 0xFC, 0xB2, 0x48, 0xC3, 0x85, 0x83, 0x4B ),
+    BYTES_TO_T_UINT_8( 0x2B, 0xBE, 0x0B, 0x58, 0x2D, 0x7A, 0x9A, 0x62 ),
+    BYTES_TO_T_UINT_8( 0xC5, 0xF3, 0x81, 0x18, 0x1B, 0x74, 0x4F, 0x2C ),
+    BYTES_TO_T_UINT_8( 0xE2, 0x43, 0xA3, 0x0A, 0x16, 0x8B, 0xA3, 0x1E ),
+    BYTES_TO_T_UINT_8( 0x4A, 0x18, 0x81, 0x7B, 0x8D, 0xA2, 0x35, 0x77 ),
+};
+static const mbedtls_mpi_uint secp384r1_T_31_X[] = {
+    BYTES_TO_T_UINT_8( 0x86, 0xC4, 0x3F, 0x2C, 0xE7, 0x5F, 0x99, 0x03 ),
+    BYTES_TO_T_UINT_8( 0xF0, 0x2B, 0xB7, 0xB6, 0xAD, 0x5A, 0x56, 0xFF ),
+    BYTES_TO_T_UINT_8( 0x04, 0x00, 0xA4, 0x48, 0xC8, 0xE8, 0xBA, 0xBF ),
+    BYTES_TO_T_UINT_8( 0xE8, 0xA1, 0xB5, 0x13, 0x5A, 0xCD, 0x99, 0x9C ),
+    BYTES_TO_T_UINT_8( 0xB0, 0x95, 0xAD, 0xFC, 0xE2, 0x7E, 0xE7, 0xFE ),
+    BYTES_TO_T_UINT_8( 0x96, 0x6B, 0xD1, 0x34, 0x99, 0x53, 0x63, 0x0B ),
+};
+static const mbedtls_mpi_uint secp384r1_T_31_Y[] = {
+    BYTES_TO_T_UINT_8( 0x19, 0x8A, 0x77, 0x5D, 0x2B, 0xAB, 0x01, 0x28 ),
+    BYTES_TO_T_UINT_8( 0x4E, 0x85, 0xD0, 0xD5, 0x49, 0x83, 0x4D, 0x60 ),
+    BYTES_TO_T_UINT_8( 0x81, 0xC6, 0x91, 0x30, 0x3B, 0x00, 0xAF, 0x7A ),
+    BYTES_TO_T_UINT_8( 0x3A, 0xAE, 0x61, 0x07, 0xE1, 0xB6, 0xE2, 0xC9 ),
+    BYTES_TO_T_UINT_8( 0x95, 0x43, 0x41, 0xFE, 0x9B, 0xB6, 0xF0, 0xA5 ),
+    BYTES_TO_T_UINT_8( 0xB4, 0x97, 0xAE, 0xAD, 0x89, 0x88, 0x9E, 0x41 ),
+};
+static const mbedtls_ecp_point secp384r1_T[32] = {
+    ECP_POINT_INIT_XY_Z1( secp384r1_T_0_X, secp384r1_T_0_Y ),
+    ECP_POINT_INIT_XY_Z1( secp384r1_T_1_X, secp384r1_T_1_Y ),
+    ECP_POINT_INIT_XY_Z1( secp384r1_T_2_X, secp384r1_T_2_Y ),
+    ECP_POINT_INIT_XY_Z1( secp384r1_T_3_X, secp384r1_T_3_Y ),
+    ECP_POINT_INIT_XY_Z1( secp384r1_T_4_X, secp384r1_T_4_Y ),
+    ECP_POINT_INIT_XY_Z1( secp384r1_T_5_X, secp384r1_T_5_Y ),
+    ECP_POINT_INIT_XY_Z1( secp384r1_T_6_X, secp384r1_T_6_Y ),
+    ECP_POINT_INIT_XY_Z1( secp384r1_T_7_X, secp384r1_T_7_Y ),
+    ECP_POINT_INIT_XY_Z1( secp384r1_T_8_X, secp384r1_T_8_Y ),
+    ECP_POINT_INIT_XY_Z1( secp384r1_T_9_X, secp384r1_T_9_Y ),
+    ECP_POINT_INIT_XY_Z1( secp384r1_T_10_X, secp384r1_T_10_Y ),
+    ECP_POINT_INIT_XY_Z1( secp384r1_T_11_X, secp384r1_T_11_Y ),
+    ECP_POINT_INIT_XY_Z1( secp384r1_T_12_X, secp384r1_T_12_Y ),
+    ECP_POINT_INIT_XY_Z1( secp384r1_T_13_X, secp384r1_T_13_Y ),
+    ECP_POINT_INIT_XY_Z1( secp384r1_T_14_X, secp384r1_T_14_Y ),
+    ECP_POINT_INIT_XY_Z1( secp384r1_T_15_X, secp384r1_T_15_Y ),
+    ECP_POINT_INIT_XY_Z1( secp384r1_T_16_X, secp384r1_T_16_Y ),
+    ECP_POINT_INIT_XY_Z1( secp384r1_T_17_X, secp384r1_T_17_Y ),
+    ECP_POINT_INIT_XY_Z1( secp384r1_T_18_X, secp384r1_T_18_Y ),
+    ECP_POINT_INIT_XY_Z1( secp384r1_T_19_X, secp384r1_T_19_Y ),
+    ECP_POINT_INIT_XY_Z1( secp384r1_T_20_X, secp384r1_T_20_Y ),
+    ECP_POINT_INIT_XY_Z1( secp384r1_T_21_X, secp384r1_T_21_Y ),
+    ECP_POINT_INIT_XY_Z1( secp384r1_T_22_X, secp384r1_T_22_Y ),
+    ECP_POINT_INIT_XY_Z1( secp384r1_T_23_X, secp384r1_T_23_Y ),
+    ECP_POINT_INIT_XY_Z1( secp384r1_T_24_X, secp384r1_T_24_Y ),
+    ECP_POINT_INIT_XY_Z1( secp384r1_T_25_X, secp384r1_T_25_Y ),
+    ECP_POINT_INIT_XY_Z1( secp384r1_T_26_X, secp384r1_T_26_Y ),
+    ECP_POINT_INIT_XY_Z1( secp384r1_T_27_X, secp384r1_T_27_Y ),
+    ECP_POINT_INIT_XY_Z1( secp384r1_T_28_X, secp384r1_T_28_Y ),
+    ECP_POINT_INIT_XY_Z1( secp384r1_T_29_X, secp384r1_T_29_Y ),
+    ECP_POINT_INIT_XY_Z1( secp384r1_T_30_X, secp384r1_T_30_Y ),
+    ECP_POINT_INIT_XY_Z1( secp384r1_T_31_X, secp384r1_T_31_Y ),
+};
+#elif ECP_SECP384R1_COMB_W == 5
+static const mbedtls_mpi_uint secp384r1_T_0_X[] = {
+    BYTES_TO_T_UINT_8( 0xB7, 0x0A, 0x76, 0x72, 0x38, 0x5E, 0x54, 0x3A ),
+    BYTES_TO_T_UINT_8( 0x6C, 0x29, 0x55, 0xBF, 0x5D, 0xF2, 0x02, 0x55 ),
+    BYTES_TO_T_UINT_8( 0x38, 0x2A, 0x54, 0x82, 0xE0, 0x41, 0xF7, 0x59 ),
+    BYTES_TO_T_UINT_8( 0x98, 0x9B, 0xA7, 0x8B, 0x62, 0x3B, 0x1D, 0x6E ),
+    BYTES_TO_T_UINT_8( 0x74, 0xAD, 0x20, 0xF3, 0x1E, 0xC7, 0xB1, 0x8E ),
+    BYTES_TO_T_UINT_8( 0x37, 0x05, 0x8B, 0xBE, 0x22, 0xCA, 0x87, 0xAA ),
+};
+static const mbedtls_mpi_uint secp384r1_T_0_Y[] = {
+    BYTES_TO_T_UINT_8( 0x5F, 0x0E, 0xEA, 0x90, 0x7C, 0x1D, 0x43, 0x7A ),
+    BYTES_TO_T_UINT_8( 0x9D, 0x81, 0x7E, 0x1D, 0xCE, 0xB1, 0x60, 0x0A ),
+    BYTES_TO_T_UINT_8( 0xC0, 0xB8, 0xF0, 0xB5, 0x13, 0x31, 0xDA, 0xE9 ),
+    BYTES_TO_T_UINT_8( 0x7C, 0x14, 0x9A, 0x28, 0xBD, 0x1D, 0xF4, 0xF8 ),
+    BYTES_TO_T_UINT_8( 0x29, 0xDC, 0x92, 0x92, 0xBF, 0x98, 0x9E, 0x5D ),
+    BYTES_TO_T_UINT_8( 0x6F, 0x2C, 0x26, 0x96, 0x4A, 0xDE, 0x17, 0x36 ),
+};
+static const mbedtls_mpi_uint secp384r1_T_1_X[] = {
+    BYTES_TO_T_UINT_8( 0xBD, 0xF6, 0x8C, 0x8E, 0xDB, 0x24, 0xF6, 0x4D ),
+    BYTES_TO_T_UINT_8( 0xB6, 0xE6, 0x47, 0x85, 0x2B, 0x13, 0x44, 0x82 ),
+    BYTES_TO_T_UINT_8( 0x20, 0x94, 0xAC, 0xEA, 0x99, 0xE3, 0xD5, 0xA9 ),
+    BYTES_TO_T_UINT_8( 0x66, 0x80, 0xAD, 0x21, 0xBD, 0x91, 0x9B, 0x0A ),
+    BYTES_TO_T_UINT_8( 0x5B, 0x91, 0xEE, 0x3E, 0xBD, 0xCE, 0x2E, 0x49 ),
+    BYTES_TO_T_UINT_8( 0x4E, 0x80, 0xDD, 0x0F, 0x53, 0xD9, 0x54, 0x5E ),
+};
+static const mbedtls_mpi_uint secp384r1_T_1_Y[] = {
+    BYTES_TO_T_UINT_8( 0xB2, 0x43, 0x5A, 0xCC, 0x00, 0x8C, 0x28, 0x44 ),
+    BYTES_TO_T_UINT_8( 0xD7, 0x7F, 0x72, 0x42, 0x25, 0x71, 0x6D, 0xF6 ),
+    BYTES_TO_T_UINT_8( 0x33, 0x6C, 0xA6, 0x89, 0x52, 0xB3, 0x98, 0x6F ),
+    BYTES_TO_T_UINT_8( 0x09, 0x1B, 0x82, 0x95, 0xB4, 0xA4, 0x09, 0x50 ),
+    BYTES_TO_T_UINT_8( 0xD0, 0x31, 0x81, 0x0E, 0xAC, 0x34, 0xE5, 0xB5 ),
+    BYTES_TO_T_UINT_8( 0xC0, 0x4B, 0xA2, 0x4B, 0x63, 0x77, 0x3D, 0x4A ),
+};
+static const mbedtls_mpi_uint secp384r1_T_2_X[] = {
+    BYTES_TO_T_UINT_8( 0xD6, 0x94, 0x16, 0x93, 0x54, 0xEC, 0x11, 0x33 ),
+    BYTES_TO_T_UINT_8( 0xB2, 0x55, 0x6C, 0xD2, 0xC3, 0x4E, 0x00, 0x66 ),
+    BYTES_TO_T_UINT_8( 0x66, 0xCD, 0x2C, 0x1F, 0xC4, 0x0A, 0x0A, 0xD5 ),
+    BYTES_TO_T_UINT_8( 0x85, 0x73, 0x04, 0x4B, 0x60, 0x62, 0x4E, 0x27 ),
+    BYTES_TO_T_UINT_8( 0x64, 0x66, 0xFD, 0xB7, 0xE4, 0x04, 0x62, 0xD9 ),
+    BYTES_TO_T_UINT_8( 0x94, 0x12, 0xA7, 0x6A, 0x6B, 0x74, 0x3B, 0xD2 ),
+};
+static const mbedtls_mpi_uint secp384r1_T_2_Y[] = {
+    BYTES_TO_T_UINT_8( 0xDD, 0x4A, 0xB6, 0x46, 0xA7, 0x31, 0x72, 0x9A ),
+    BYTES_TO_T_UINT_8( 0x47, 0x08, 0x78, 0xBE, 0x8E, 0x9B, 0x70, 0x47 ),
+    BYTES_TO_T_UINT_8( 0x73, 0xEC, 0x3A, 0xAA, 0x1D, 0x10, 0xBE, 0xC5 ),
+    BYTES_TO_T_UINT_8( 0x90, 0x30, 0x9D, 0xB8, 0x19, 0xBD, 0x86, 0x27 ),
+    BYTES_TO_T_UINT_8( 0xA8, 0x1B, 0xA7, 0x09, 0x1D, 0x8F, 0x34, 0x5F ),
+    BYTES_TO_T_UINT_8( 0x6A, 0x07, 0x69, 0x01, 0xA7, 0xCD, 0xF2, 0xE2 ),
+};
+static const mbedtls_mpi_uint secp384r1_T_3_X[] = {
+    BYTES_TO_T_UINT_8( 0xE0, 0x5E, 0x46, 0x1A, 0x4C, 0x8A, 0xCB, 0x70 ),
+    BYTES_TO_T_UINT_8( 0x37, 0x3F, 0xEE, 0xF8, 0x46, 0xA2, 0x4B, 0xF0 ),
+    BYTES_TO_T_UINT_8( 0x26, 0xE1, 0x1E, 0xC8, 0xB6, 0xAE, 0xBE, 0xD6 ),
+    BYTES_TO_T_UINT_8( 0x3C, 0x39, 0x50, 0xDC, 0xE8, 0x13, 0xC1, 0x5F ),
+    BYTES_TO_T_UINT_8( 0xA7, 0xB6, 0x94, 0xD0, 0xD3, 0x2D, 0x47, 0xD0 ),
+    BYTES_TO_T_UINT_8( 0x69, 0x16, 0x1C, 0xDA, 0xBE, 0xB0, 0x69, 0xB7 ),
+};
+static const mbedtls_mpi_uint secp384r1_T_3_Y[] = {
+    BYTES_TO_T_UINT_8( 0xA1, 0xBC, 0x57, 0x41, 0xFA, 0x81, 0x24, 0x77 ),
+    BYTES_TO_T_UINT_8( 0xC6, 0xEE, 0xBE, 0x96, 0x5E, 0xED, 0x0A, 0xDE ),
+    BYTES_TO_T_UINT_8( 0xC0, 0x69, 0x45, 0x28, 0x16, 0x4F, 0xC0, 0xB9 ),
+    BYTES_TO_T_UINT_8( 0x01, 0xD6, 0x36, 0x8B, 0x11, 0x59, 0x41, 0xA2 ),
+    BYTES_TO_T_UINT_8( 0xCA, 0xE1, 0x15, 0xD4, 0x7F, 0x1B, 0xD5, 0x81 ),
+    BYTES_TO_T_UINT_8( 0xA2, 0xD0, 0xAA, 0xEB, 0xB9, 0x42, 0xE5, 0x4F ),
+};
+static const mbedtls_mpi_uint secp384r1_T_4_X[] = {
+    BYTES_TO_T_UINT_8( 0x96, 0xC9, 0xF8, 0xED, 0x18, 0xF7, 0xFA, 0x7F ),
+    BYTES_TO_T_UINT_8( 0x9A, 0x99, 0x8B, 0xC5, 0x86, 0x99, 0xE4, 0x4E ),
+    BYTES_TO_T_UINT_8( 0xE9, 0x28, 0x53, 0xBA, 0x0F, 0x0C, 0xDC, 0x5F ),
+    BYTES_TO_T_UINT_8( 0xB3, 0xB0, 0xE7, 0x4D, 0x3B, 0x9F, 0xBB, 0x22 ),
+    BYTES_TO_T_UINT_8( 0xAB, 0xB5, 0xA8, 0x79, 0x61, 0xB6, 0xBD, 0x59 ),
+    BYTES_TO_T_UINT_8( 0x0B, 0x96, 0x46, 0x5B, 0x96, 0xEB, 0x1C, 0xA4 ),
+};
+static const mbedtls_mpi_uint secp384r1_T_4_Y[] = {
+    BYTES_TO_T_UINT_8( 0x5B, 0x56, 0x3F, 0x67, 0x96, 0xD8, 0x5F, 0xF9 ),
+    BYTES_TO_T_UINT_8( 0x5D, 0x57, 0x46, 0x55, 0x77, 0xF9, 0x82, 0x16 ),
+    BYTES_TO_T_UINT_8( 0x1D, 0x98, 0x5E, 0x72, 0xD4, 0x59, 0x51, 0x98 ),
+    BYTES_TO_T_UINT_8( 0x44, 0xFF, 0xED, 0x82, 0x4D, 0x48, 0xFE, 0x2C ),
+    BYTES_TO_T_UINT_8( 0xD0, 0xAA, 0xEF, 0xE5, 0x25, 0xB6, 0x5C, 0x78 ),
+    BYTES_TO_T_UINT_8( 0x46, 0x83, 0xE2, 0x10, 0xF8, 0x4C, 0xE9, 0xC6 ),
+};
+static const mbedtls_mpi_uint secp384r1_T_5_X[] = {
+    BYTES_TO_T_UINT_8( 0xE7, 0x39, 0x31, 0xB3, 0x9F, 0x60, 0xBF, 0x49 ),
+    BYTES_TO_T_UINT_8( 0x90, 0x0A, 0x82, 0xAC, 0xEB, 0x2C, 0xFD, 0x60 ),
+    BYTES_TO_T_UINT_8( 0xF6, 0x20, 0x4A, 0x16, 0xD0, 0x4A, 0x34, 0xA1 ),
+    BYTES_TO_T_UINT_8( 0xB2, 0x2A, 0xD4, 0xCE, 0x64, 0x65, 0xA1, 0xC8 ),
+    BYTES_TO_T_UINT_8( 0xB5, 0x1D, 0xF8, 0x87, 0x62, 0xEF, 0x78, 0xC7 ),
+    BYTES_TO_T_UINT_8( 0x0C, 0xDE, 0x05, 0xDA, 0x3E, 0x2C, 0xC0, 0x81 ),
+};
+static const mbedtls_mpi_uint secp384r1_T_5_Y[] = {
+    BYTES_TO_T_UINT_8( 0xB9, 0x28, 0x7D, 0xC1, 0x64, 0x0E, 0x4D, 0x92 ),
+    BYTES_TO_T_UINT_8( 0x40, 0x13, 0xE3, 0x90, 0xB1, 0x10, 0xF3, 0x8B ),
+    BYTES_TO_T_UINT_8( 0x2C, 0x29, 0xCE, 0xA9, 0x13, 0xD4, 0xDA, 0x9D ),
+    BYTES_TO_T_UINT_8( 0x8E, 0x9A, 0x2F, 0xC4, 0x2D, 0xA1, 0xA2, 0x46 ),
+    BYTES_TO_T_UINT_8( 0x1D, 0x4B, 0xCB, 0x69, 0x97, 0x52, 0x34, 0x0C ),
+    BYTES_TO_T_UINT_8( 0xD3, 0xF2, 0x3E, 0x4C, 0x8A, 0x02, 0xE0, 0x1C ),
+};
+static const mbedtls_mpi_uint secp384r1_T_6_X[] = {
+    BYTES_TO_T_UINT_8( 0x68, 0x91, 0x31, 0xB2, 0xF2, 0xE7, 0xA6, 0xF9 ),
+    BYTES_TO_T_UINT_8( 0xA0, 0x44, 0xD1, 0x51, 0x53, 0xF9, 0xD5, 0xED ),
+    BYTES_TO_T_UINT_8( 0x61, 0xD1, 0x2A, 0xAD, 0x38, 0xC0, 0x71, 0x71 ),
+    BYTES_TO_T_UINT_8( 0x66, 0x59, 0x21, 0xF7, 0xBE, 0xA2, 0x01, 0x5C ),
+    BYTES_TO_T_UINT_8( 0x06, 0xFA, 0x78, 0xB9, 0x56, 0xC7, 0x96, 0xF6 ),
+    BYTES_TO_T_UINT_8( 0x48, 0xD2, 0x79, 0x65, 0xBB, 0x98, 0x43, 0x71 ),
+};
+static const mbedtls_mpi_uint secp384r1_T_6_Y[] = {
+    BYTES_TO_T_UINT_8( 0x25, 0xB3, 0x1F, 0xAB, 0x06, 0x57, 0xDE, 0x4A ),
+    BYTES_TO_T_UINT_8( 0x46, 0x18, 0x0C, 0xFF, 0xB4, 0x42, 0x8B, 0x81 ),
+    BYTES_TO_T_UINT_8( 0x7E, 0x93, 0xEE, 0xD6, 0x34, 0x9F, 0x0C, 0x7F ),
+    BYTES_TO_T_UINT_8( 0x84, 0x77, 0xCD, 0x90, 0xC5, 0x28, 0xAC, 0x54 ),
+    BYTES_TO_T_UINT_8( 0x76, 0x04, 0x7F, 0xE1, 0x45, 0xF6, 0x01, 0x87 ),
+    BYTES_TO_T_UINT_8( 0xB8, 0xD7, 0xB5, 0xA4, 0x51, 0xAA, 0x45, 0x65 ),
+};
+static const mbedtls_mpi_uint secp384r1_T_7_X[] = {
+    BYTES_TO_T_UINT_8( 0x6D, 0xE8, 0x38, 0xCB, 0xFC, 0xF4, 0xA2, 0xE2 ),
+    BYTES_TO_T_UINT_8( 0x59, 0xED, 0x82, 0x53, 0xBA, 0x57, 0x53, 0xCB ),
+    BYTES_TO_T_UINT_8( 0xC2, 0x76, 0x50, 0x1B, 0x5D, 0x8D, 0xE0, 0x6B ),
+    BYTES_TO_T_UINT_8( 0x1C, 0xE1, 0x83, 0x4D, 0x37, 0xF6, 0x2D, 0xC6 ),
+    BYTES_TO_T_UINT_8( 0x97, 0x9A, 0x96, 0x60, 0x1E, 0x8C, 0x95, 0xD6 ),
+    BYTES_TO_T_UINT_8( 0x48, 0xFC, 0xDB, 0x54, 0x2C, 0x60, 0x9B, 0xA4 ),
+};
+static const mbedtls_mpi_uint secp384r1_T_7_Y[] = {
+    BYTES_TO_T_UINT_8( 0xCA, 0x4B, 0x91, 0x51, 0xEE, 0xD2, 0x97, 0xFB ),
+    BYTES_TO_T_UINT_8( 0x19, 0x17, 0x21, 0xAA, 0xC9, 0x64, 0xBC, 0xB4 ),
+    BYTES_TO_T_UINT_8( 0x20, 0x4D, 0x64, 0x00, 0x52, 0xD9, 0xDC, 0x0A ),
+    BYTES_TO_T_UINT_8( 0x46, 0x00, 0x5F, 0xA7, 0x59, 0xCA, 0xE8, 0xB8 ),
+    BYTES_TO_T_UINT_8( 0xF2, 0x18, 0xA8, 0x17, 0xE2, 0x1F, 0x5E, 0x9F ),
+    BYTES_TO_T_UINT_8( 0xD1, 0x54, 0xCF, 0xB5, 0x2E, 0x2F, 0x1D, 0x7E ),
+};
+static const mbedtls_mpi_uint secp384r1_T_8_X[] = {
+    BYTES_TO_T_UINT_8( 0x65, 0x01, 0x06, 0x1E, 0x65, 0x24, 0xFE, 0x79 ),
+    BYTES_TO_T_UINT_8( 0x17, 0x0F, 0xB9, 0xB6, 0xE7, 0xBD, 0x30, 0x51 ),
+    BYTES_TO_T_UINT_8( 0x59, 0xB4, 0x3C, 0x85, 0xFD, 0x4C, 0x25, 0xCE ),
+    BYTES_TO_T_UINT_8( 0x54, 0x07, 0x44, 0xBA, 0x8E, 0x2B, 0x78, 0xA8 ),
+    BYTES_TO_T_UINT_8( 0x6C, 0xAA, 0xF8, 0xDA, 0x8F, 0xF6, 0x81, 0x7D ),
+    BYTES_TO_T_UINT_8( 0x68, 0xBF, 0xB8, 0x44, 0xAA, 0x19, 0x0E, 0xAA ),
+};
+static const mbedtls_mpi_uint secp384r1_T_8_Y[] = {
+    BYTES_TO_T_UINT_8( 0x87, 0xA4, 0x64, 0x26, 0x6F, 0xE9, 0x3E, 0x6E ),
+    BYTES_TO_T_UINT_8( 0x80, 0xEA, 0x9F, 0x4E, 0x25, 0x7D, 0x1B, 0x8F ),
+    BYTES_TO_T_UINT_8( 0x0D, 0x05, 0x1C, 0x13, 0x2A, 0x2A, 0x28, 0x7A ),
+    BYTES_TO_T_UINT_8( 0x8E, 0x49, 0x81, 0xCA, 0x57, 0xB3, 0x86, 0xD9 ),
+    BYTES_TO_T_UINT_8( 0x95, 0xC8, 0x4E, 0x15, 0x53, 0x07, 0x75, 0xC4 ),
+    BYTES_TO_T_UINT_8( 0xA3, 0x35, 0x3C, 0xCB, 0x8A, 0x0B, 0xDB, 0x65 ),
+};
+static const mbedtls_mpi_uint secp384r1_T_9_X[] = {
+    BYTES_TO_T_UINT_8( 0x04, 0x0F, 0x57, 0x6A, 0x8B, 0x12, 0x21, 0x1D ),
+    BYTES_TO_T_UINT_8( 0x27, 0xE4, 0x4F, 0x39, 0x1C, 0xB3, 0x17, 0xE9 ),
+    BYTES_TO_T_UINT_8( 0x3C, 0xD1, 0xA2, 0x6B, 0xDE, 0x28, 0xFE, 0xC0 ),
+    BYTES_TO_T_UINT_8( 0xA2, 0xEB, 0x08, 0x7F, 0x5F, 0x79, 0x31, 0x2D ),
+    BYTES_TO_T_UINT_8( 0xB7, 0x2C, 0x49, 0x88, 0x57, 0x89, 0xBB, 0xDA ),
+    BYTES_TO_T_UINT_8( 0xC1, 0x64, 0x2A, 0xC8, 0xB4, 0x78, 0x64, 0x5B ),
+};
+static const mbedtls_mpi_uint secp384r1_T_9_Y[] = {
+    BYTES_TO_T_UINT_8( 0x4C, 0x0E, 0x43, 0xCD, 0x18, 0xF5, 0x14, 0x5D ),
+    BYTES_TO_T_UINT_8( 0xF8, 0x14, 0x7D, 0x21, 0xD1, 0x92, 0x29, 0x55 ),
+    BYTES_TO_T_UINT_8( 0x67, 0x33, 0x03, 0x95, 0x11, 0x3C, 0x8D, 0xB3 ),
+    BYTES_TO_T_UINT_8( 0xE5, 0xE0, 0x07, 0xAE, 0xDC, 0x2D, 0xBB, 0xAC ),
+    BYTES_TO_T_UINT_8( 0x18, 0xF8, 0x50, 0x7B, 0x4C, 0x12, 0x93, 0x70 ),
+    BYTES_TO_T_UINT_8( 0x5B, 0xC1, 0x9C, 0x7E, 0x7F, 0x33, 0xE3, 0x0A ),
+};
+static const mbedtls_mpi_uint secp384r1_T_10_X[] = {
+    BYTES_TO_T_UINT_8( 0xED, 0x72, 0x3F, 0xEB, 0x46, 0x67, 0x56, 0xB8 ),
+    BYTES_TO_T_UINT_8( 0xAE, 0x14, 0xE1, 0x08, 0xD1, 0x6E, 0x31, 0x53 ),
+    BYTES_TO_T_UINT_8( 0xC6, 0xA8, 0xAE, 0x91, 0x81, 0xB4, 0xE5, 0x45 ),
+    BYTES_TO_T_UINT_8( 0xD5, 0xA9, 0x57, 0x28, 0xF5, 0x0B, 0xC3, 0x73 ),
+    BYTES_TO_T_UINT_8( 0x82, 0x7C, 0x1F, 0xFD, 0xAF, 0x96, 0xDB, 0x26 ),
+    BYTES_TO_T_UINT_8( 0xB5, 0x22, 0x18, 0xDF, 0xD0, 0x10, 0x90, 0x8C ),
+};
+static const mbedtls_mpi_uint secp384r1_T_10_Y[] = {
+    BYTES_TO_T_UINT_8( 0x3D, 0x8D, 0x42, 0x20, 0xAB, 0x24, 0x66, 0x24 ),
+    BYTES_TO_T_UINT_8( 0xCD, 0xC7, 0x02, 0x6A, 0x9F, 0x8C, 0xA4, 0xA3 ),
+    BYTES_TO_T_UINT_8( 0xDD, 0x1B, 0xCD, 0x34, 0x38, 0xB7, 0x98, 0x12 ),
+    BYTES_TO_T_UINT_8( 0xBD, 0xB3, 0x71, 0x1B, 0xBC, 0x33, 0x48, 0x66 ),
+    BYTES_TO_T_UINT_8( 0x08, 0x6E, 0x0A, 0x07, 0xD7, 0x5C, 0x36, 0xD9 ),
+    BYTES_TO_T_UINT_8( 0x6B, 0xB6, 0x10, 0xD6, 0x79, 0xD9, 0x4A, 0xA4 ),
+};
+static const mbedtls_mpi_uint secp384r1_T_11_X[] = {
+    BYTES_TO_T_UINT_8( 0x23, 0x4A, 0x82, 0x6F, 0x49, 0xA2, 0x51, 0xA6 ),
+    BYTES_TO_T_UINT_8( 0x86, 0x08, 0x1B, 0xBC, 0x2B, 0x0A, 0xA6, 0xAB ),
+    BYTES_TO_T_UINT_8( 0xA8, 0x31, 0xE3, 0x67, 0x51, 0xEF, 0x32, 0xC6 ),
+    BYTES_TO_T_UINT_8( 0x43, 0x27, 0x43, 0xD3, 0x94, 0xAB, 0x6C, 0x38 ),
+    BYTES_TO_T_UINT_8( 0xCC, 0xDA, 0xDB, 0x24, 0xCD, 0x57, 0x46, 0x64 ),
+    BYTES_TO_T_UINT_8( 0xEB, 0x8E, 0x9D, 0xEA, 0xE3, 0xEF, 0xBA, 0x79 ),
+};
+static const mbedtls_mpi_uint secp384r1_T_11_Y[] = {
+    BYTES_TO_T_UINT_8( 0xA9, 0x22, 0x00, 0x7C, 0x59, 0x0B, 0x10, 0xCE ),
+    BYTES_TO_T_UINT_8( 0x50, 0x25, 0x55, 0xB5, 0xD5, 0x67, 0x2C, 0xC7 ),
+    BYTES_TO_T_UINT_8( 0x7F, 0xD4, 0x25, 0xC6, 0x8D, 0x46, 0x7C, 0xCC ),
+    BYTES_TO_T_UINT_8( 0x72, 0x48, 0xB9, 0x43, 0xE2, 0x6A, 0x37, 0x54 ),
+    BYTES_TO_T_UINT_8( 0x33, 0xB7, 0x91, 0xFD, 0x31, 0x6D, 0x11, 0x86 ),
+    BYTES_TO_T_UINT_8( 0x81, 0xB9, 0x7A, 0xC0, 0x2E, 0x94, 0x3E, 0xC3 ),
+};
+static const mbedtls_mpi_uint secp384r1_T_12_X[] = {
+    BYTES_TO_T_UINT_8( 0x65, 0xB5, 0x9B, 0xDC, 0xE0, 0xD3, 0x26, 0x50 ),
+    BYTES_TO_T_UINT_8( 0x8D, 0xAC, 0x1D, 0xA4, 0x64, 0x55, 0x34, 0x3A ),
+    BYTES_TO_T_UINT_8( 0x0B, 0x44, 0x05, 0xCF, 0x73, 0x80, 0x2B, 0x09 ),
+    BYTES_TO_T_UINT_8( 0x9A, 0x5F, 0xE9, 0xE7, 0x1D, 0x97, 0x1F, 0xDE ),
+    BYTES_TO_T_UINT_8( 0x38, 0x48, 0xB0, 0xBC, 0xC6, 0x47, 0x7D, 0x17 ),
+    BYTES_TO_T_UINT_8( 0x29, 0x3D, 0x39, 0x37, 0x49, 0xC4, 0xA0, 0xB2 ),
+};
+static const mbedtls_mpi_uint secp384r1_T_12_Y[] = {
+    BYTES_TO_T_UINT_8( 0xCD, 0x40, 0x73, 0xE7, 0x3D, 0x4C, 0x22, 0x00 ),
+    BYTES_TO_T_UINT_8( 0x6E, 0x52, 0x4E, 0x6A, 0x98, 0x7B, 0xE3, 0x31 ),
+    BYTES_TO_T_UINT_8( 0x1B, 0xA5, 0x55, 0xBC, 0x85, 0xB7, 0x98, 0xEE ),
+    BYTES_TO_T_UINT_8( 0x64, 0xC6, 0x1B, 0x09, 0x26, 0x21, 0xD2, 0x4E ),
+    BYTES_TO_T_UINT_8( 0x0F, 0x09, 0xC7, 0x98, 0xBA, 0x78, 0xC1, 0x59 ),
+    BYTES_TO_T_UINT_8( 0xD5, 0xE4, 0x4C, 0xA1, 0xF4, 0xC7, 0x7F, 0x59 ),
+};
+static const mbedtls_mpi_uint secp384r1_T_13_X[] = {
+    BYTES_TO_T_UINT_8( 0x1D, 0x31, 0xDF, 0xFE, 0xD9, 0x05, 0xF3, 0x00 ),
+    BYTES_TO_T_UINT_8( 0xF9, 0xA9, 0x82, 0x60, 0x2A, 0x59, 0x22, 0x23 ),
+    BYTES_TO_T_UINT_8( 0x75, 0x6F, 0xC7, 0xDF, 0x28, 0x1C, 0x84, 0xF1 ),
+    BYTES_TO_T_UINT_8( 0x4E, 0x67, 0xAF, 0x10, 0x17, 0x4D, 0x71, 0xF0 ),
+    BYTES_TO_T_UINT_8( 0x73, 0x51, 0x89, 0xAF, 0x03, 0x18, 0x87, 0xCD ),
+    BYTES_TO_T_UINT_8( 0x1C, 0x57, 0xF5, 0x94, 0xA9, 0xB6, 0x0A, 0x11 ),
+};
+static const mbedtls_mpi_uint secp384r1_T_13_Y[] = {
+    BYTES_TO_T_UINT_8( 0x24, 0xD1, 0xD4, 0x22, 0x21, 0xB4, 0xA3, 0x5A ),
+    BYTES_TO_T_UINT_8( 0x5F, 0x7A, 0xFE, 0xA2, 0x94, 0xB5, 0x6E, 0xCB ),
+    BYTES_TO_T_UINT_8( 0x39, 0xAC, 0xB4, 0xB6, 0xBA, 0x18, 0xE9, 0xBB ),
+    BYTES_TO_T_UINT_8( 0x61, 0xC9, 0x31, 0x3A, 0x1E, 0x16, 0xE5, 0x19 ),
+    BYTES_TO_T_UINT_8( 0xCD, 0xC9, 0xFF, 0x3F, 0xCB, 0xA2, 0xA7, 0xC2 ),
+    BYTES_TO_T_UINT_8( 0xA3, 0xBA, 0x7B, 0xC6, 0xB1, 0x25, 0x08, 0x1A ),
+};
+static const mbedtls_mpi_uint secp384r1_T_14_X[] = {
+    BYTES_TO_T_UINT_8( 0xE1, 0x30, 0xE9, 0x77, 0xE8, 0x00, 0x41, 0x3D ),
+    BYTES_TO_T_UINT_8( 0x38, 0xC8, 0xC4, 0xAD, 0xAD, 0xBA, 0x99, 0x08 ),
+    BYTES_TO_T_UINT_8( 0x7E, 0x09, 0xB3, 0xF6, 0x9F, 0x89, 0x64, 0x5B ),
+    BYTES_TO_T_UINT_8( 0x9D, 0x43, 0x90, 0x27, 0x89, 0x0A, 0x06, 0x7C ),
+    BYTES_TO_T_UINT_8( 0xC6, 0x97, 0x34, 0x51, 0xD0, 0x25, 0xAB, 0x40 ),
+    BYTES_TO_T_UINT_8( 0x33, 0x88, 0x2D, 0x20, 0xE2, 0x4F, 0xA7, 0xDF ),
+};
+static const mbedtls_mpi_uint secp384r1_T_14_Y[] = {
+    BYTES_TO_T_UINT_8( 0x5B, 0xF9, 0x66, 0x24, 0xC5, 0xCE, 0x9C, 0x68 ),
+    BYTES_TO_T_UINT_8( 0x8E, 0xE8, 0xB8, 0xE0, 0x7A, 0x10, 0x57, 0xE7 ),
+    BYTES_TO_T_UINT_8( 0x16, 0x8F, 0xA7, 0x56, 0x13, 0xD5, 0xD0, 0x38 ),
+    BYTES_TO_T_UINT_8( 0xC2, 0xF7, 0xA9, 0x5D, 0x1C, 0x30, 0xC8, 0x47 ),
+    BYTES_TO_T_UINT_8( 0x2B, 0x6F, 0x95, 0x31, 0xC6, 0x5C, 0xC5, 0xE8 ),
+    BYTES_TO_T_UINT_8( 0x31, 0x49, 0x8D, 0x0C, 0xD6, 0x90, 0xA5, 0x6D ),
+};
+static const mbedtls_mpi_uint secp384r1_T_15_X[] = {
+    BYTES_TO_T_UINT_8( 0xBA, 0x2A, 0x9A, 0x67, 0x0F, 0xF5, 0xED, 0x96 ),
+    BYTES_TO_T_UINT_8( 0x80, 0x18, 0xA0, 0x7F, 0x91, 0x2B, 0xB9, 0x31 ),
+    BYTES_TO_T_UINT_8( 0x66, 0x57, 0x49, 0x72, 0xEB, 0x47, 0xA0, 0xFD ),
+    BYTES_TO_T_UINT_8( 0xC9, 0x99, 0x12, 0xCB, 0xC5, 0x63, 0xC6, 0xE8 ),
+    BYTES_TO_T_UINT_8( 0x68, 0xE6, 0xDB, 0x91, 0x46, 0x81, 0x79, 0x15 ),
+    BYTES_TO_T_UINT_8( 0x1C, 0x12, 0xA9, 0x9D, 0xC5, 0x09, 0xE2, 0x25 ),
+};
+static const mbedtls_mpi_uint secp384r1_T_15_Y[] = {
+    BYTES_TO_T_UINT_8( 0xDA, 0x64, 0x9B, 0xF6, 0xA2, 0x33, 0xD0, 0x9A ),
+    BYTES_TO_T_UINT_8( 0x97, 0xDB, 0x2A, 0xD8, 0xF3, 0xE8, 0x66, 0x63 ),
+    BYTES_TO_T_UINT_8( 0x89, 0x31, 0x10, 0xE9, 0x28, 0x2F, 0x05, 0x96 ),
+    BYTES_TO_T_UINT_8( 0x44, 0xE7, 0x6C, 0x6E, 0x54, 0x90, 0x27, 0x6C ),
+    BYTES_TO_T_UINT_8( 0x97, 0x66, 0x5D, 0xFE, 0x69, 0xB0, 0x53, 0xDA ),
+    BYTES_TO_T_UINT_8( 0x6A, 0xFB, 0x09, 0xDA, 0xB9, 0x00, 0x32, 0x55 ),
+};
+static const mbedtls_ecp_point secp384r1_T[16] = {
+    ECP_POINT_INIT_XY_Z1( secp384r1_T_0_X, secp384r1_T_0_Y ),
+    ECP_POINT_INIT_XY_Z1( secp384r1_T_1_X, secp384r1_T_1_Y ),
+    ECP_POINT_INIT_XY_Z1( secp384r1_T_2_X, secp384r1_T_2_Y ),
+    ECP_POINT_INIT_XY_Z1( secp384r1_T_3_X, secp384r1_T_3_Y ),
+    ECP_POINT_INIT_XY_Z1( secp384r1_T_4_X, secp384r1_T_4_Y ),
+    ECP_POINT_INIT_XY_Z1( secp384r1_T_5_X, secp384r1_T_5_Y ),
+    ECP_POINT_INIT_XY_Z1( secp384r1_T_6_X, secp384r1_T_6_Y ),
+    ECP_POINT_INIT_XY_Z1( secp384r1_T_7_X, secp384r1_T_7_Y ),
+    ECP_POINT_INIT_XY_Z1( secp384r1_T_8_X, secp384r1_T_8_Y ),
+    ECP_POINT_INIT_XY_Z1( secp384r1_T_9_X, secp384r1_T_9_Y ),
+    ECP_POINT_INIT_XY_Z1( secp384r1_T_10_X, secp384r1_T_10_Y ),
+    ECP_POINT_INIT_XY_Z1( secp384r1_T_11_X, secp384r1_T_11_Y ),
+    ECP_POINT_INIT_XY_Z1( secp384r1_T_12_X, secp384r1_T_12_Y ),
+    ECP_POINT_INIT_XY_Z1( secp384r1_T_13_X, secp384r1_T_13_Y ),
+    ECP_POINT_INIT_XY_Z1( secp384r1_T_14_X, secp384r1_T_14_Y ),
+    ECP_POINT_INIT_XY_Z1( secp384r1_T_15_X, secp384r1_T_15_Y ),
+};
+#else /* ECP_SECP384R1_COMB_W == 4 */
+static const mbedtls_mpi_uint secp384r1_T_0_X[] = {
+    BYTES_TO_T_UINT_8( 0xB7, 0x0A, 0x76, 0x72, 0x38, 0x5E, 0x54, 0x3A ),
+    BYTES_TO_T_UINT_8( 0x6C, 0x29, 0x55, 0xBF, 0x5D, 0xF2, 0x02, 0x55 ),
+    BYTES_TO_T_UINT_8( 0x38, 0x2A, 0x54, 0x82, 0xE0, 0x41, 0xF7, 0x59 ),
+    BYTES_TO_T_UINT_8( 0x98, 0x9B, 0xA7, 0x8B, 0x62, 0x3B, 0x1D, 0x6E ),
+    BYTES_TO_T_UINT_8( 0x74, 0xAD, 0x20, 0xF3, 0x1E, 0xC7, 0xB1, 0x8E ),
+    BYTES_TO_T_UINT_8( 0x37, 0x05, 0x8B, 0xBE, 0x22, 0xCA, 0x87, 0xAA ),
+};
+static const mbedtls_mpi_uint secp384r1_T_0_Y[] = {
+    BYTES_TO_T_UINT_8( 0x5F, 0x0E, 0xEA, 0x90, 0x7C, 0x1D, 0x43, 0x7A ),
+    BYTES_TO_T_UINT_8( 0x9D, 0x81, 0x7E, 0x1D, 0xCE, 0xB1, 0x60, 0x0A ),
+    BYTES_TO_T_UINT_8( 0xC0, 0xB8, 0xF0, 0xB5, 0x13, 0x31, 0xDA, 0xE9 ),
+    BYTES_TO_T_UINT_8( 0x7C, 0x14, 0x9A, 0x28, 0xBD, 0x1D, 0xF4, 0xF8 ),
+    BYTES_TO_T_UINT_8( 0x29, 0xDC, 0x92, 0x92, 0xBF, 0x98, 0x9E, 0x5D ),
+    BYTES_TO_T_UINT_8( 0x6F, 0x2C, 0x26, 0x96, 0x4A, 0xDE, 0x17, 0x36 ),
+};
+static const mbedtls_mpi_uint secp384r1_T_1_X[] = {
+    BYTES_TO_T_UINT_8( 0xE5, 0xA0, 0x09, 0xEB, 0x46, 0x52, 0x4E, 0x26 ),
+    BYTES_TO_T_UINT_8( 0x3C, 0xF0, 0xCD, 0x32, 0x11, 0xBE, 0xF4, 0xF8 ),
+    BYTES_TO_T_UINT_8( 0x4F, 0xFA, 0xAE, 0x5F, 0x83, 0x54, 0x9D, 0xDA ),
+    BYTES_TO_T_UINT_8( 0x22, 0x1B, 0xA3, 0x17, 0xD0, 0x4F, 0xBC, 0xBB ),
+    BYTES_TO_T_UINT_8( 0x45, 0x61, 0xF0, 0x86, 0x0C, 0xCD, 0xDE, 0xC3 ),
+    BYTES_TO_T_UINT_8( 0xAB, 0x2C, 0x5F, 0x0A, 0x67, 0xF1, 0x8E, 0x52 ),
+};
+static const mbedtls_mpi_uint secp384r1_T_1_Y[] = {
+    BYTES_TO_T_UINT_8( 0xD6, 0x0D, 0x4F, 0xC1, 0x58, 0x98, 0x1E, 0x8A ),
+    BYTES_TO_T_UINT_8( 0x24, 0x75, 0xCB, 0x09, 0xA8, 0x38, 0x05, 0x55 ),
+    BYTES_TO_T_UINT_8( 0x22, 0xED, 0x7F, 0xC8, 0xB4, 0xCA, 0x60, 0xBD ),
+    BYTES_TO_T_UINT_8( 0x8D, 0x05, 0x1D, 0x63, 0xDD, 0x6F, 0xB7, 0xF8 ),
+    BYTES_TO_T_UINT_8( 0x14, 0xCF, 0x1D, 0x1A, 0xA1, 0xEA, 0x03, 0x58 ),
+    BYTES_TO_T_UINT_8( 0x6C, 0xF5, 0xCC, 0x7B, 0xBE, 0x1F, 0x9B, 0x7B ),
+};
+static const mbedtls_mpi_uint secp384r1_T_2_X[] = {
+    BYTES_TO_T_UINT_8( 0x09, 0x39, 0x13, 0xAA, 0x60, 0x15, 0x99, 0x30 ),
+    BYTES_TO_T_UINT_8( 0x17, 0x00, 0xCB, 0xC6, 0xB1, 0xDB, 0x97, 0x90 ),
+    BYTES_TO_T_UINT_8( 0xE6, 0xFA, 0x60, 0xB8, 0x24, 0xE4, 0x7D, 0xD3 ),
+    BYTES_TO_T_UINT_8( 0xDD, 0x75, 0xB3, 0x70, 0xB2, 0x83, 0xB1, 0x9B ),
+    BYTES_TO_T_UINT_8( 0xA3, 0xE3, 0x6C, 0xCD, 0x33, 0x62, 0x7A, 0x56 ),
+    BYTES_TO_T_UINT_8( 0x88, 0x30, 0xDC, 0x0F, 0x9F, 0xBB, 0xB8, 0xAA ),
+};
+static const mbedtls_mpi_uint secp384r1_T_2_Y[] = {
+    BYTES_TO_T_UINT_8( 0xA6, 0xD5, 0x0A, 0x60, 0x81, 0xB9, 0xC5, 0x16 ),
+    BYTES_TO_T_UINT_8( 0x44, 0xAA, 0x2F, 0xD6, 0xF2, 0x73, 0xDF, 0xEB ),
+    BYTES_TO_T_UINT_8( 0xF3, 0x7B, 0x74, 0xC9, 0xB3, 0x5B, 0x95, 0x6D ),
+    BYTES_TO_T_UINT_8( 0xAC, 0x04, 0xEB, 0x15, 0xC8, 0x5F, 0x00, 0xF6 ),
+    BYTES_TO_T_UINT_8( 0xB5, 0x50, 0x20, 0x28, 0xD1, 0x01, 0xAF, 0xF0 ),
+    BYTES_TO_T_UINT_8( 0x28, 0x6D, 0x4F, 0x31, 0x81, 0x2F, 0x94, 0x48 ),
+};
+static const mbedtls_mpi_uint secp384r1_T_3_X[] = {
+    BYTES_TO_T_UINT_8( 0x44, 0x83, 0x75, 0x0E, 0xE6, 0xE2, 0x0A, 0x30 ),
+    BYTES_TO_T_UINT_8( 0xA5, 0x2C, 0x1A, 0x37, 0x7A, 0x70, 0x1C, 0x45 ),
+    BYTES_TO_T_UINT_8( 0x32, 0xDD, 0x52, 0x50, 0x10, 0x1D, 0x65, 0x25 ),
+    BYTES_TO_T_UINT_8( 0x54, 0xB9, 0x62, 0x48, 0x7F, 0xDE, 0x88, 0xBF ),
+    BYTES_TO_T_UINT_8( 0x13, 0xEF, 0x81, 0x03, 0x6E, 0xE2, 0xFC, 0xFA ),
+    BYTES_TO_T_UINT_8( 0x0E, 0x09, 0x0E, 0x96, 0x17, 0x6C, 0x91, 0xDC ),
+};
+static const mbedtls_mpi_uint secp384r1_T_3_Y[] = {
+    BYTES_TO_T_UINT_8( 0x89, 0x08, 0x6B, 0x02, 0x44, 0xCC, 0x17, 0xED ),
+    BYTES_TO_T_UINT_8( 0x1B, 0x44, 0x42, 0x9B, 0xF1, 0x1F, 0xC0, 0x95 ),
+    BYTES_TO_T_UINT_8( 0x97, 0x06, 0x16, 0xCC, 0x78, 0x64, 0x89, 0x40 ),
+    BYTES_TO_T_UINT_8( 0x35, 0x4A, 0xA0, 0x0B, 0xB8, 0x54, 0xD1, 0x52 ),
+    BYTES_TO_T_UINT_8( 0x52, 0x29, 0x1C, 0x70, 0xA4, 0x2E, 0xD9, 0xB3 ),
+    BYTES_TO_T_UINT_8( 0x0A, 0xCA, 0x9E, 0xD6, 0x40, 0x8A, 0x6E, 0x26 ),
+};
+static const mbedtls_mpi_uint secp384r1_T_4_X[] = {
+    BYTES_TO_T_UINT_8( 0xEE, 0x4C, 0x8D, 0x70, 0x24, 0x4D, 0x10, 0x8D ),
+    BYTES_TO_T_UINT_8( 0x43, 0xF0, 0x9C, 0x81, 0x58, 0x69, 0x7D, 0x19 ),
+    BYTES_TO_T_UINT_8( 0x10, 0x22, 0x71, 0xF0, 0xFA, 0x87, 0xFC, 0x47 ),
+    BYTES_TO_T_UINT_8( 0x58, 0x15, 0x20, 0x5C, 0x85, 0xF7, 0x3D, 0x10 ),
+    BYTES_TO_T_UINT_8( 0x38, 0xF6, 0x1E, 0x61, 0xE8, 0xA9, 0xB0, 0x30 ),
+    BYTES_TO_T_UINT_8( 0xEC, 0xBF, 0xFE, 0xFD, 0xC8, 0x9A, 0xB1, 0x00 ),
+};
+static const mbedtls_mpi_uint secp384r1_T_4_Y[] = {
+    BYTES_TO_T_UINT_8( 0x3E, 0xE0, 0x01, 0xD2, 0x6F, 0x8D, 0x0E, 0xD4 ),
+    BYTES_TO_T_UINT_8( 0x5F, 0xFF, 0x28, 0x22, 0x9C, 0x96, 0x7C, 0xBB ),
+    BYTES_TO_T_UINT_8( 0xC5, 0x64, 0x61, 0x63, 0x82, 0x02, 0x81, 0x68 ),
+    BYTES_TO_T_UINT_8( 0x0D, 0x22, 0x54, 0xE7, 0xD2, 0x3C, 0xBB, 0xCD ),
+    BYTES_TO_T_UINT_8( 0xC4, 0xED, 0xF6, 0xE9, 0x25, 0xFE, 0x18, 0x14 ),
+    BYTES_TO_T_UINT_8( 0x31, 0x60, 0xE3, 0x9E, 0x05, 0x91, 0x2F, 0xA7 ),
+};
+static const mbedtls_mpi_uint secp384r1_T_5_X[] = {
+    BYTES_TO_T_UINT_8( 0x82, 0x1F, 0x65, 0x85, 0xD2, 0x0D, 0x4C, 0x04 ),
+    BYTES_TO_T_UINT_8( 0xF7, 0x3E, 0x5D, 0x78, 0xE7, 0x51, 0x5C, 0x32 ),
+    BYTES_TO_T_UINT_8( 0x32, 0x55, 0xE9, 0x88, 0x61, 0x18, 0x3A, 0xB8 ),
+    BYTES_TO_T_UINT_8( 0x31, 0x29, 0x2C, 0x52, 0xAD, 0x94, 0x9F, 0x53 ),
+    BYTES_TO_T_UINT_8( 0x37, 0xF1, 0x80, 0x89, 0x5B, 0x4E, 0x27, 0x15 ),
+    BYTES_TO_T_UINT_8( 0xD7, 0x66, 0x0F, 0xDF, 0x10, 0xB0, 0xD7, 0x9F ),
+};
+static const mbedtls_mpi_uint secp384r1_T_5_Y[] = {
+    BYTES_TO_T_UINT_8( 0xC0, 0xE4, 0x64, 0x40, 0x4A, 0xB9, 0xA7, 0xE4 ),
+    BYTES_TO_T_UINT_8( 0x11, 0xD2, 0xD7, 0x25, 0x45, 0xBA, 0x4E, 0xD4 ),
+    BYTES_TO_T_UINT_8( 0xE3, 0x04, 0x8A, 0xBE, 0x54, 0x6B, 0x80, 0x0A ),
+    BYTES_TO_T_UINT_8( 0xDE, 0x33, 0x90, 0x14, 0xBD, 0x26, 0x92, 0x92 ),
+    BYTES_TO_T_UINT_8( 0x46, 0x92, 0x73, 0xC9, 0xA3, 0x6F, 0x5F, 0x79 ),
+    BYTES_TO_T_UINT_8( 0x25, 0x02, 0x26, 0xB9, 0xA3, 0xA9, 0x1A, 0x32 ),
+};
+static const mbedtls_mpi_uint secp384r1_T_6_X[] = {
+    BYTES_TO_T_UINT_8( 0xBD, 0x3B, 0x86, 0x5F, 0x58, 0x56, 0xB0, 0x10 ),
+    BYTES_TO_T_UINT_8( 0x3D, 0x28, 0x83, 0xB4, 0x5A, 0xDC, 0x2C, 0xE9 ),
+    BYTES_TO_T_UINT_8( 0x1D, 0x42, 0x7C, 0xDC, 0x09, 0x12, 0xB3, 0xEB ),
+    BYTES_TO_T_UINT_8( 0xA8, 0xA5, 0x01, 0x6D, 0x79, 0xBD, 0xFC, 0x3A ),
+    BYTES_TO_T_UINT_8( 0x51, 0x6A, 0x8B, 0xA0, 0xCA, 0x67, 0xB0, 0xE2 ),
+    BYTES_TO_T_UINT_8( 0xEB, 0x7A, 0xCB, 0xE8, 0xC2, 0x0D, 0x6E, 0x02 ),
+};
+static const mbedtls_mpi_uint secp384r1_T_6_Y[] = {
+    BYTES_TO_T_UINT_8( 0x8A, 0xE1, 0xDD, 0x02, 0x29, 0x50, 0xC3, 0xD8 ),
+    BYTES_TO_T_UINT_8( 0x36, 0xCF, 0xC6, 0xD8, 0xAC, 0x5F, 0xC1, 0x64 ),
+    BYTES_TO_T_UINT_8( 0x45, 0x1E, 0x78, 0x10, 0x01, 0x27, 0xEA, 0x17 ),
+    BYTES_TO_T_UINT_8( 0xD8, 0x43, 0x34, 0x1F, 0xFC, 0x1F, 0x8D, 0xD6 ),
+    BYTES_TO_T_UINT_8( 0xA5, 0x61, 0x74, 0x8C, 0x37, 0x56, 0xE2, 0x4B ),
+    BYTES_TO_T_UINT_8( 0xE1, 0x24, 0xEF, 0xD8, 0xBA, 0x66, 0x88, 0xAE ),
+};
+static const mbedtls_mpi_uint secp384r1_T_7_X[] = {
+    BYTES_TO_T_UINT_8( 0xDE, 0x66, 0x26, 0xC6, 0x0E, 0x9A, 0x10, 0x89 ),
+    BYTES_TO_T_UINT_8( 0x1E, 0xD0, 0xFC, 0x7F, 0x75, 0x2E, 0xC1, 0xC8 ),
+    BYTES_TO_T_UINT_8( 0xB0, 0x5A, 0x8B, 0xC4, 0x69, 0x61, 0x20, 0xA8 ),
+    BYTES_TO_T_UINT_8( 0x6C, 0xAC, 0x83, 0xF9, 0xCF, 0xFD, 0xC2, 0x4B ),
+    BYTES_TO_T_UINT_8( 0x23, 0x7D, 0x97, 0x55, 0x71, 0xCA, 0xCF, 0x59 ),
+    BYTES_TO_T_UINT_8( 0x6A, 0xC9, 0x66, 0x57, 0x33, 0xCB, 0x64, 0x12 ),
+};
+static const mbedtls_mpi_uint secp384r1_T_7_Y[] = {
+    BYTES_TO_T_UINT_8( 0x4B, 0x4B, 0x01, 0x2E, 0x81, 0x13, 0x69, 0x6B ),
+    BYTES_TO_T_UINT_8( 0xC5, 0x3E, 0x48, 0xE4, 0x07, 0x87, 0xD2, 0x31 ),
+    BYTES_TO_T_UINT_8( 0x58, 0x97, 0xB1, 0xFF, 0x0C, 0x19, 0xF7, 0xCB ),
+    BYTES_TO_T_UINT_8( 0x48, 0xF2, 0xA5, 0x65, 0xA0, 0x17, 0x67, 0xB6 ),
+    BYTES_TO_T_UINT_8( 0x69, 0x4F, 0x3B, 0xC5, 0xFA, 0xD8, 0x4A, 0xD9 ),
+    BYTES_TO_T_UINT_8( 0x76, 0xA3, 0xA1, 0xA1, 0xEE, 0xBE, 0x9E, 0x11 ),
+};
+static const mbedtls_ecp_point secp384r1_T[8] = {
+    ECP_POINT_INIT_XY_Z1( secp384r1_T_0_X, secp384r1_T_0_Y ),
+    ECP_POINT_INIT_XY_Z1( secp384r1_T_1_X, secp384r1_T_1_Y ),
+    ECP_POINT_INIT_XY_Z1( secp384r1_T_2_X, secp384r1_T_2_Y ),
+    ECP_POINT_INIT_XY_Z1( secp384r1_T_3_X, secp384r1_T_3_Y ),
+    ECP_POINT_INIT_XY_Z1( secp384r1_T_4_X, secp384r1_T_4_Y ),
+    ECP_POINT_INIT_XY_Z1( secp384r1_T_5_X, secp384r1_T_5_Y ),
+    ECP_POINT_INIT_XY_Z1( secp384r1_T_6_X, secp384r1_T_6_Y ),
+    ECP_POINT_INIT_XY_Z1( secp384r1_T_7_X, secp384r1_T_7_Y ),
+};
+#endif
+#endif /* ECP_SECP384R1_COMB_TABLE */
 #endif /* MBEDTLS_ECP_DP_SECP384R1_ENABLED */
 
 /*
@@ -677,6 +2003,15 @@ static int ecp_mod_p256k1( mbedtls_mpi * );
                             G ## _n,  sizeof( G ## _n  ) )
 #endif /* ECP_LOAD_GROUP */
 
+#if defined(ECP_COMB_TABLES)
+/* T_size 0 marks a static table, which mbedtls_ecp_group_free() leaves alone */
+#define LOAD_COMB_TABLE( G )                                    \
+    do {                                                        \
+        grp->T = (mbedtls_ecp_point *) G ## _T;                 \
+        grp->T_size = 0;                                        \
+    } while( 0 )
+#endif /* ECP_COMB_TABLES */
+
 #if defined(MBEDTLS_ECP_DP_CURVE25519_ENABLED)
 /*
  * Specialized function for creating the Curve25519 group
@@ -789,12 +2124,18 @@ int mbedtls_ecp_group_load( mbedtls_ecp_group *grp, mbedtls_ecp_group_id id )
 #if defined(MBEDTLS_ECP_DP_SECP256R1_ENABLED)
         case MBEDTLS_ECP_DP_SECP256R1:
             NIST_MODP( p256 );
+#if defined(ECP_SECP256R1_COMB_TABLE)
+            LOAD_COMB_TABLE( secp256r1 );
+#endif
             return( LOAD_GROUP( secp256r1 ) );
 #endif /* MBEDTLS_ECP_DP_SECP256R1_ENABLED */
 
 #if defined(MBEDTLS_ECP_DP_SECP384R1_ENABLED)
         case MBEDTLS_ECP_DP_SECP384R1:
             NIST_MODP( p384 );
+#if defined(ECP_SECP384R1_COMB_TABLE)
+            LOAD_COMB_TABLE( secp384r1 );
+#endif
             return( LOAD_GROUP( secp384r1 ) );
 #endif /* MBEDTLS_ECP_DP_SECP384R1_ENABLED */
 
@@ -0,0 +1,388 @@
+/*
+ * Copyright (c) 2021, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Cost of the primitives of the TLS cipher suites: bulk encryption and
+ * hashing on TLS record sized buffers, in cycles per byte, and the public
+ * key operations of a handshake, in cycles per operation. With
+ * accelerators fed by DMA, the idle time shows how much of the CPU other
+ * threads get meanwhile.
+ *
+ * The bulk results can be turned into nsapi.tls-cipher-order with
+ * connectivity/netsocket/tools/tls_cipher_order.py.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "mbed.h"
+#include "greentea-client/test_env.h"
+#include "unity/unity.h"
+#include "utest/utest.h"
+
+#if !defined(MBEDTLS_CONFIG_FILE)
+#include "mbedtls/config.h"
+#else
+#include MBEDTLS_CONFIG_FILE
+#endif
+
+#include "mbedtls/gcm.h"
+#include "mbedtls/ccm.h"
+#include "mbedtls/chachapoly.h"
+#include "mbedtls/sha256.h"
+#include "mbedtls/sha512.h"
+#include "mbedtls/ecdh.h"
+#include "mbedtls/ecdsa.h"
+#include "mbedtls/pk.h"
+#include "mbedtls/certs.h"
+
+#if defined(MBEDTLS_PLATFORM_C)
+#include "mbedtls/platform.h"
+#else
+#include <stdio.h>
+#define mbedtls_printf     printf
+#endif
+
+using namespace utest::v1;
+
+#define RECORD_SIZE     16384
+#define RECORD_COUNT    16
+
+/* Word aligned, as accelerators transfer words */
+MBED_ALIGN(32) static unsigned char input[RECORD_SIZE];
+MBED_ALIGN(32) static unsigned char output[RECORD_SIZE];
+
+static const unsigned char key[32] = { 0 };
+static const unsigned char iv[12] = { 0 };
+static unsigned char tag[16];
+
+/* Cycles are derived from the time at the core clock, so that accelerators
+ * and waits for them count as well */
+class Measure {
+public:
+    /** Report per byte if ops is 0, per operation otherwise */
+    Measure(const char *name, uint32_t ops = 0) : _name(name), _ops(ops)
+    {
+#if defined(MBED_CPU_STATS_ENABLED)
+        mbed_stats_cpu_get(&_start);
+#endif
+        _timer.start();
+    }
+
+    ~Measure()
+    {
+        _timer.stop();
+        uint64_t us = _timer.elapsed_time().count();
+        if (us == 0) {
+            us = 1;
+        }
+        uint64_t cycles = us * (SystemCoreClock / 1000000);
+        if (_ops) {
+            mbedtls_printf("%s: %u us/op, %u cycles/op\n", _name,
+                           (unsigned)(us / _ops), (unsigned)(cycles / _ops));
+        } else {
+            uint64_t bytes = (uint64_t) RECORD_SIZE * RECORD_COUNT;
+            uint32_t cpb100 = (uint32_t)(cycles * 100 / bytes);
+            mbedtls_printf("%s: %u KiB/s, %u.%02u cycles/byte\n", _name,
+                           (unsigned)((bytes * 1000000 / 1024) / us),
+                           (unsigned)(cpb100 / 100), (unsigned)(cpb100 % 100));
+        }
+#if defined(MBED_CPU_STATS_ENABLED)
+        mbed_stats_cpu_t end;
+        mbed_stats_cpu_get(&end);
+        mbedtls_printf("%s: CPU idle %u%%\n", _name,
+                       (unsigned)((end.idle_time - _start.idle_time) * 100 / (end.uptime - _start.uptime + 1)));
+#endif
+    }
+
+private:
+    const char *_name;
+    uint32_t _ops;
+    Timer _timer;
+#if defined(MBED_CPU_STATS_ENABLED)
+    mbed_stats_cpu_t _start;
+#endif
+};
+
+/* Deterministic, costless randomness, the entropy source is not measured */
+static int bench_rng(void *, unsigned char *output, size_t len)
+{
+    static uint32_t state = 0x12345678;
+    for (size_t i = 0; i < len; i++) {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        output[i] = (unsigned char) state;
+    }
+    return 0;
+}
+
+#if defined(MBEDTLS_GCM_C)
+static void gcm_record(unsigned int keybits, const char *name)
+{
+    mbedtls_gcm_context ctx;
+
+    mbedtls_gcm_init(&ctx);
+    TEST_ASSERT_EQUAL(0, mbedtls_gcm_setkey(&ctx, MBEDTLS_CIPHER_ID_AES, key, keybits));
+    {
+        Measure measure(name);
+        for (int i = 0; i < RECORD_COUNT; i++) {
+            TEST_ASSERT_EQUAL(0, mbedtls_gcm_crypt_and_tag(&ctx, MBEDTLS_GCM_ENCRYPT, RECORD_SIZE,
+                                                           iv, sizeof(iv), NULL, 0,
+                                                           input, output, sizeof(tag), tag));
+        }
+    }
+    mbedtls_gcm_free(&ctx);
+}
+
+void test_case_gcm_record()
+{
+    gcm_record(128, "AES-128-GCM");
+    gcm_record(256, "AES-256-GCM");
+}
+#endif /* MBEDTLS_GCM_C */
+
+#if defined(MBEDTLS_CCM_C)
+static void ccm_record(unsigned int keybits, const char *name)
+{
+    mbedtls_ccm_context ctx;
+
+    mbedtls_ccm_init(&ctx);
+    TEST_ASSERT_EQUAL(0, mbedtls_ccm_setkey(&ctx, MBEDTLS_CIPHER_ID_AES, key, keybits));
+    {
+        Measure measure(name);
+        for (int i = 0; i < RECORD_COUNT; i++) {
+            TEST_ASSERT_EQUAL(0, mbedtls_ccm_encrypt_and_tag(&ctx, RECORD_SIZE, iv, sizeof(iv), NULL, 0,
+                                                             input, output, tag, sizeof(tag)));
+        }
+    }
+    mbedtls_ccm_free(&ctx);
+}
+
+void test_case_ccm_record()
+{
+    ccm_record(128, "AES-128-CCM");
+    ccm_record(256, "AES-256-CCM");
+}
+#endif /* MBEDTLS_CCM_C */
+
+#if defined(MBEDTLS_CHACHAPOLY_C)
+void test_case_chachapoly_record()
+{
+    mbedtls_chachapoly_context ctx;
+
+    mbedtls_chachapoly_init(&ctx);
+    TEST_ASSERT_EQUAL(0, mbedtls_chachapoly_setkey(&ctx, key));
+    {
+        Measure measure("CHACHA20-POLY1305");
+        for (int i = 0; i < RECORD_COUNT; i++) {
+            TEST_ASSERT_EQUAL(0, mbedtls_chachapoly_encrypt_and_tag(&ctx, RECORD_SIZE, iv, NULL, 0,
+                                                                    input, output, tag));
+        }
+    }
+    mbedtls_chachapoly_free(&ctx);
+}
+#endif /* MBEDTLS_CHACHAPOLY_C */
+
+#if defined(MBEDTLS_SHA256_C)
+void test_case_sha256_record()
+{
+    mbedtls_sha256_context ctx;
+    unsigned char sum[32];
+
+    mbedtls_sha256_init(&ctx);
+    {
+        Measure measure("SHA-256");
+        TEST_ASSERT_EQUAL(0, mbedtls_sha256_starts_ret(&ctx, 0));
+        for (int i = 0; i < RECORD_COUNT; i++) {
+            TEST_ASSERT_EQUAL(0, mbedtls_sha256_update_ret(&ctx, input, RECORD_SIZE));
+        }
+        TEST_ASSERT_EQUAL(0, mbedtls_sha256_finish_ret(&ctx, sum));
+    }
+    mbedtls_sha256_free(&ctx);
+}
+#endif /* MBEDTLS_SHA256_C */
+
+#if defined(MBEDTLS_SHA512_C)
+void test_case_sha512_record()
+{
+    mbedtls_sha512_context ctx;
+    unsigned char sum[64];
+
+    mbedtls_sha512_init(&ctx);
+    {
+        Measure measure("SHA-384");
+        TEST_ASSERT_EQUAL(0, mbedtls_sha512_starts_ret(&ctx, 1));
+        for (int i = 0; i < RECORD_COUNT; i++) {
+            TEST_ASSERT_EQUAL(0, mbedtls_sha512_update_ret(&ctx, input, RECORD_SIZE));
+        }
+        TEST_ASSERT_EQUAL(0, mbedtls_sha512_finish_ret(&ctx, sum));
+    }
+    mbedtls_sha512_free(&ctx);
+}
+#endif /* MBEDTLS_SHA512_C */
+
+#define ECC_OPS     4
+#define RSA_OPS     4
+
+#if defined(MBEDTLS_ECDH_C) && defined(MBEDTLS_ECP_DP_SECP256R1_ENABLED)
+void test_case_ecdhe_p256()
+{
+    mbedtls_ecp_group grp;
+    mbedtls_ecp_point q, peer;
+    mbedtls_mpi d, peer_d, z;
+
+    mbedtls_ecp_group_init(&grp);
+    mbedtls_ecp_point_init(&q);
+    mbedtls_ecp_point_init(&peer);
+    mbedtls_mpi_init(&d);
+    mbedtls_mpi_init(&peer_d);
+    mbedtls_mpi_init(&z);
+    TEST_ASSERT_EQUAL(0, mbedtls_ecp_group_load(&grp, MBEDTLS_ECP_DP_SECP256R1));
+    TEST_ASSERT_EQUAL(0, mbedtls_ecdh_gen_public(&grp, &peer_d, &peer, bench_rng, NULL));
+    {
+        // The client side of an ECDHE key exchange
+        Measure measure("ECDHE P-256", ECC_OPS);
+        for (int i = 0; i < ECC_OPS; i++) {
+            TEST_ASSERT_EQUAL(0, mbedtls_ecdh_gen_public(&grp, &d, &q, bench_rng, NULL));
+            TEST_ASSERT_EQUAL(0, mbedtls_ecdh_compute_shared(&grp, &z, &peer, &d, bench_rng, NULL));
+        }
+    }
+    mbedtls_mpi_free(&z);
+    mbedtls_mpi_free(&peer_d);
+    mbedtls_mpi_free(&d);
+    mbedtls_ecp_point_free(&peer);
+    mbedtls_ecp_point_free(&q);
+    mbedtls_ecp_group_free(&grp);
+}
+#endif /* MBEDTLS_ECDH_C */
+
+#if defined(MBEDTLS_ECDSA_C) && defined(MBEDTLS_ECP_DP_SECP256R1_ENABLED)
+void test_case_ecdsa_p256()
+{
+    mbedtls_ecdsa_context ctx;
+    unsigned char hash[32];
+    unsigned char sig[MBEDTLS_ECDSA_MAX_LEN];
+    size_t sig_len;
+
+    // Not zero, for which verification takes a shortcut
+    memset(hash, 0x5a, sizeof(hash));
+    mbedtls_ecdsa_init(&ctx);
+    TEST_ASSERT_EQUAL(0, mbedtls_ecdsa_genkey(&ctx, MBEDTLS_ECP_DP_SECP256R1, bench_rng, NULL));
+    {
+        Measure measure("ECDSA P-256 sign", ECC_OPS);
+        for (int i = 0; i < ECC_OPS; i++) {
+            TEST_ASSERT_EQUAL(0, mbedtls_ecdsa_write_signature(&ctx, MBEDTLS_MD_SHA256, hash, sizeof(hash),
+                                                               sig, &sig_len, bench_rng, NULL));
+        }
+    }
+    {
+        Measure measure("ECDSA P-256 verify", ECC_OPS);
+        for (int i = 0; i < ECC_OPS; i++) {
+            TEST_ASSERT_EQUAL(0, mbedtls_ecdsa_read_signature(&ctx, hash, sizeof(hash), sig, sig_len));
+        }
+    }
+    mbedtls_ecdsa_free(&ctx);
+}
+#endif /* MBEDTLS_ECDSA_C */
+
+#if defined(MBEDTLS_RSA_C) && defined(MBEDTLS_PK_PARSE_C) && defined(MBEDTLS_CERTS_C) && defined(MBEDTLS_PEM_PARSE_C)
+void test_case_rsa_2048()
+{
+    mbedtls_pk_context pk;
+    unsigned char in[256] = { 0 };
+    unsigned char out[256];
+
+    mbedtls_pk_init(&pk);
+    TEST_ASSERT_EQUAL(0, mbedtls_pk_parse_key(&pk, (const unsigned char *) mbedtls_test_srv_key_rsa,
+                                              mbedtls_test_srv_key_rsa_len, NULL, 0));
+    mbedtls_rsa_context *rsa = mbedtls_pk_rsa(pk);
+    TEST_ASSERT_EQUAL(sizeof(in), mbedtls_rsa_get_len(rsa));
+    in[sizeof(in) - 1] = 2;
+    {
+        // Verifying the server's signature
+        Measure measure("RSA-2048 public", RSA_OPS);
+        for (int i = 0; i < RSA_OPS; i++) {
+            TEST_ASSERT_EQUAL(0, mbedtls_rsa_public(rsa, in, out));
+        }
+    }
+    {
+        // Signing with a client certificate
+        Measure measure("RSA-2048 private", RSA_OPS);
+        for (int i = 0; i < RSA_OPS; i++) {
+            TEST_ASSERT_EQUAL(0, mbedtls_rsa_private(rsa, bench_rng, NULL, in, out));
+        }
+    }
+    mbedtls_pk_free(&pk);
+}
+#endif /* MBEDTLS_RSA_C */
+
+utest::v1::status_t greentea_failure_handler(const Case *const source, const failure_t reason)
+{
+    greentea_case_failure_abort_handler(source, reason);
+    return STATUS_CONTINUE;
+}
+
+Case cases[] = {
+#if defined(MBEDTLS_GCM_C)
+    Case("Crypto: gcm_record", test_case_gcm_record, greentea_failure_handler),
+#endif
+#if defined(MBEDTLS_CCM_C)
+    Case("Crypto: ccm_record", test_case_ccm_record, greentea_failure_handler),
+#endif
+#if defined(MBEDTLS_CHACHAPOLY_C)
+    Case("Crypto: chachapoly_record", test_case_chachapoly_record, greentea_failure_handler),
+#endif
+#if defined(MBEDTLS_SHA256_C)
+    Case("Crypto: sha256_record", test_case_sha256_record, greentea_failure_handler),
+#endif
+#if defined(MBEDTLS_SHA512_C)
+    Case("Crypto: sha512_record", test_case_sha512_record, greentea_failure_handler),
+#endif
+#if defined(MBEDTLS_ECDH_C) && defined(MBEDTLS_ECP_DP_SECP256R1_ENABLED)
+    Case("Crypto: ecdhe_p256", test_case_ecdhe_p256, greentea_failure_handler),
+#endif
+#if defined(MBEDTLS_ECDSA_C) && defined(MBEDTLS_ECP_DP_SECP256R1_ENABLED)
+    Case("Crypto: ecdsa_p256", test_case_ecdsa_p256, greentea_failure_handler),
+#endif
+#if defined(MBEDTLS_RSA_C) && defined(MBEDTLS_PK_PARSE_C) && defined(MBEDTLS_CERTS_C) && defined(MBEDTLS_PEM_PARSE_C)
+    Case("Crypto: rsa_2048", test_case_rsa_2048, greentea_failure_handler),
+#endif
+};
+
+utest::v1::status_t greentea_test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(300, "default_auto");
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+Specification specification(greentea_test_setup, cases, greentea_test_teardown_handler);
+
+int main()
+{
+    int ret = 0;
+#if defined(MBEDTLS_PLATFORM_C)
+    if ((ret = mbedtls_platform_setup(NULL)) != 0) {
+        mbedtls_printf("Mbed TLS benchmark failed! mbedtls_platform_setup returned %d\n", ret);
+        return 1;
+    }
+#endif
+    ret = (Harness::run(specification) ? 0 : 1);
+#if defined(MBEDTLS_PLATFORM_C)
+    mbedtls_platform_teardown(NULL);
+#endif
+    return ret;
+}
@@ -0,0 +1,104 @@
+#!/usr/bin/env python3
+"""
+Generate the precomputed comb tables for ecp_curves.c.
+
+ecp_mul_comb() multiplies the base point with a table of 2^(w-1) points
+computed by ecp_precompute_comb(). This script computes the same points
+offline, in affine coordinates, and prints them as constant arrays:
+
+    python3 ecp_comb_table.py secp256r1 5
+
+The output goes after the domain parameters of the curve in ecp_curves.c.
+The window w must be the one ecp_pick_window_size() picks for the base
+point, which depends on MBEDTLS_ECP_WINDOW_SIZE.
+
+Copyright (c) 2021, Arm Limited, All Rights Reserved
+SPDX-License-Identifier: Apache-2.0
+"""
+
+import sys
+
+CURVES = {
+    'secp256r1': {
+        'p': 0xffffffff00000001000000000000000000000000ffffffffffffffffffffffff,
+        'a': -3,
+        'gx': 0x6b17d1f2e12c4247f8bce6e563a440f277037d812deb33a0f4a13945d898c296,
+        'gy': 0x4fe342e2fe1a7f9b8ee7eb4a7c0f9e162bce33576b315ececbb6406837bf51f5,
+        'nbits': 256,
+    },
+    'secp384r1': {
+        'p': 0xfffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffeffffffff0000000000000000ffffffff,
+        'a': -3,
+        'gx': 0xaa87ca22be8b05378eb1c71ef320ad746e1d3b628ba79b9859f741e082542a385502f25dbf55296c3a545e3872760ab7,
+        'gy': 0x3617de4a96262c6f5d9e98bf9292dc29f8f41dbd289a147ce9da3113b5f0b8c00a60b1ce1d7e819d7a431d7c90ea0e5f,
+        'nbits': 384,
+    },
+}
+
+
+def add(curve, P, Q):
+    p = curve['p']
+    if P is None:
+        return Q
+    if Q is None:
+        return P
+    if P[0] == Q[0]:
+        if (P[1] + Q[1]) % p == 0:
+            return None
+        l = (3 * P[0] * P[0] + curve['a']) * pow(2 * P[1], -1, p) % p
+    else:
+        l = (Q[1] - P[1]) * pow(Q[0] - P[0], -1, p) % p
+    x = (l * l - P[0] - Q[0]) % p
+    return (x, (l * (P[0] - x) - P[1]) % p)
+
+
+def comb_table(curve, w):
+    """Same steps as ecp_precompute_comb()"""
+    d = (curve['nbits'] + w - 1) // w
+    T_size = 1 << (w - 1)
+    T = [None] * T_size
+    T[0] = (curve['gx'], curve['gy'])
+
+    for j in range(d * (w - 1)):
+        i = 1 << (j // d)
+        if j % d == 0:
+            T[i] = T[i >> 1]
+        T[i] = add(curve, T[i], T[i])
+
+    i = 1
+    while i < T_size:
+        for j in reversed(range(i)):
+            T[i + j] = add(curve, T[j], T[i])
+        i <<= 1
+
+    return T
+
+
+def limbs(value, nbytes):
+    data = value.to_bytes(nbytes, 'little')
+    lines = []
+    for i in range(0, nbytes, 8):
+        lines.append('    BYTES_TO_T_UINT_8( %s ),' %
+                     ', '.join('0x%02X' % b for b in data[i:i + 8]))
+    return '\n'.join(lines)
+
+
+def main():
+    name, w = sys.argv[1], int(sys.argv[2])
+    curve = CURVES[name]
+    nbytes = curve['nbits'] // 8
+    T = comb_table(curve, w)
+
+    for i, (x, y) in enumerate(T):
+        for coord, value in (('X', x), ('Y', y)):
+            print('static const mbedtls_mpi_uint %s_T_%d_%s[] = {' % (name, i, coord))
+            print(limbs(value, nbytes))
+            print('};')
+    print('static const mbedtls_ecp_point %s_T[%d] = {' % (name, len(T)))
+    for i in range(len(T)):
+        print('    ECP_POINT_INIT_XY_Z1( %s_T_%d_X, %s_T_%d_Y ),' % (name, i, name, i))
+    print('};')
+
+
+if __name__ == '__main__':
+    main()
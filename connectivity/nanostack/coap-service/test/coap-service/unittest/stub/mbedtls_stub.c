@@ -94,6 +94,14 @@ void mbedtls_ssl_conf_authmode(mbedtls_ssl_config *a, int c)
 
 }
 
+int mbedtls_ssl_conf_max_frag_len(mbedtls_ssl_config *conf, unsigned char mfl_code)
+{
+    if (mbedtls_stub.useCounter) {
+        return mbedtls_stub.retArray[mbedtls_stub.counter++];
+    }
+    return mbedtls_stub.expected_int;
+}
+
 void mbedtls_ssl_conf_ca_chain(mbedtls_ssl_config *a,
                                mbedtls_x509_crt *b,
                                mbedtls_x509_crl *c)
@@ -203,6 +211,11 @@ int mbedtls_ssl_write(mbedtls_ssl_context *a, const unsigned char *b, size_t c)
     return mbedtls_stub.expected_int;
 }
 
+int mbedtls_ssl_get_max_out_record_payload(const mbedtls_ssl_context *ssl)
+{
+    return 16384;
+}
+
 int mbedtls_ssl_set_hostname(mbedtls_ssl_context *ssl, const char *hostname)
 {
     return 0;
@@ -291,6 +304,18 @@ void mbedtls_x509_crt_free(mbedtls_x509_crt *a)
 
 }
 
+int mbedtls_x509_crt_parse_der_nocopy(mbedtls_x509_crt *a, const unsigned char *b, size_t c)
+{
+    return mbedtls_stub.crt_expected_int;
+}
+
+int mbedtls_asn1_get_tag(unsigned char **p, const unsigned char *end, size_t *len, int tag)
+{
+    // A single element spanning the rest of the buffer
+    *len = end - *p;
+    return 0;
+}
+
 int mbedtls_x509_crt_parse(mbedtls_x509_crt *a, const unsigned char *b, size_t c)
 {
     if (mbedtls_stub.useCounter) {
@@ -416,6 +441,32 @@ int mbedtls_ssl_session_reset(mbedtls_ssl_context *ssl)
     return mbedtls_stub.expected_int;
 }
 
+int mbedtls_ssl_get_session(const mbedtls_ssl_context *ssl, mbedtls_ssl_session *session)
+{
+    if (mbedtls_stub.useCounter) {
+        return mbedtls_stub.retArray[mbedtls_stub.counter++];
+    }
+    return mbedtls_stub.expected_int;
+}
+
+int mbedtls_ssl_set_session(mbedtls_ssl_context *ssl, const mbedtls_ssl_session *session)
+{
+    if (mbedtls_stub.useCounter) {
+        return mbedtls_stub.retArray[mbedtls_stub.counter++];
+    }
+    return mbedtls_stub.expected_int;
+}
+
+void mbedtls_ssl_session_init(mbedtls_ssl_session *session)
+{
+
+}
+
+void mbedtls_ssl_session_free(mbedtls_ssl_session *session)
+{
+
+}
+
 void mbedtls_strerror(int ret, char *buf, size_t buflen)
 {
 }
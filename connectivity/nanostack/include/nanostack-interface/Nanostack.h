@@ -257,6 +257,20 @@ protected:
      */
     nsapi_size_or_error_t socket_recvfrom(void *handle, SocketAddress *address, void *buffer, nsapi_size_t size) override;
 
+    /** Receive the datagrams queued on a UDP socket
+     *
+     *  Takes the stack lock once for the whole batch.
+     *
+     *  This call is non-blocking. If no datagram is queued,
+     *  NSAPI_ERROR_WOULD_BLOCK is returned immediately.
+     *
+     *  @param handle     Socket handle
+     *  @param datagrams  Datagrams to fill
+     *  @return           Number of datagrams received on success, negative
+     *                    error code on failure
+     */
+    nsapi_size_or_error_t socket_recvfrom_batch(void *handle, mbed::Span<nsapi_datagram_t> datagrams) override;
+
     /** Register a callback on state change of the socket
      *
      *  The specified callback will be called on state changes such as when
@@ -21,6 +21,7 @@
 #include "arm_hal_phy.h"
 #include "EMAC.h"
 #include "enet_tasklet.h"
+#include "ethernet_mac_api.h"
 #include "mbed_interface.h"
 
 class EMACPhy : public NanostackEthernetPhy {
@@ -84,28 +85,34 @@ extern "C"
 
     void EMACPhy::emac_phy_rx(emac_mem_buf_t *mem)
     {
-        const uint8_t *ptr = NULL;
-        uint8_t *tmpbuf = NULL;
+        uint8_t *ptr;
+        void *storage;
         uint32_t total_len;
 
+        if (!phy.phy_rx_cb) {
+            memory_manager.free(mem);
+            return;
+        }
+
         if (memory_manager.get_next(mem) == NULL) {
-            // Easy contiguous case
-            ptr = static_cast<const uint8_t *>(memory_manager.get_ptr(mem));
+            // Easy contiguous case - the buffer is a nanostack heap block, hand it over as it is
+            ptr = static_cast<uint8_t *>(memory_manager.get_ptr(mem));
             total_len = memory_manager.get_len(mem);
+            storage = mem;
         } else {
-            // Nanostack can't accept chunked data - make temporary contiguous copy
+            // Nanostack can't accept chunked data - make contiguous copy
             total_len = memory_manager.get_total_len(mem);
-            ptr = tmpbuf = static_cast<uint8_t *>(ns_dyn_mem_temporary_alloc(total_len));
-            if (tmpbuf) {
-                memory_manager.copy_from_buf(tmpbuf, total_len, mem);
+            ptr = static_cast<uint8_t *>(ns_dyn_mem_temporary_alloc(total_len));
+            if (ptr) {
+                memory_manager.copy_from_buf(ptr, total_len, mem);
             }
+            memory_manager.free(mem);
+            storage = ptr;
         }
 
-        if (ptr && phy.phy_rx_cb) {
-            phy.phy_rx_cb(ptr, total_len, 0xff, 0, device_id);
+        if (storage) {
+            ethernet_mac_rx_buffer(device_id, ptr, total_len, 0xff, 0, storage);
         }
-        ns_dyn_mem_free(tmpbuf);
-        memory_manager.free(mem);
     }
 
 } // extern "C"
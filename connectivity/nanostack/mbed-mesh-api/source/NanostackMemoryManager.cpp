@@ -65,7 +65,13 @@ uint32_t NanostackMemoryManager::get_pool_alloc_unit(uint32_t align) const
 
 void NanostackMemoryManager::free(emac_mem_buf_t *mem)
 {
-    ns_dyn_mem_free(mem);
+    ns_stack_mem_t *buf = static_cast<ns_stack_mem_t *>(mem);
+
+    while (buf) {
+        ns_stack_mem_t *next = buf->next;
+        ns_dyn_mem_free(buf);
+        buf = next;
+    }
 }
 
 uint32_t NanostackMemoryManager::get_total_len(const emac_mem_buf_t *buf) const
@@ -222,6 +222,25 @@ extern int8_t eventOS_event_timer_cancel(uint8_t event_id, int8_t tasklet_id);
  * */
 extern uint32_t eventOS_event_timer_shortest_active_timer(void);
 
+/** System timer statistics */
+typedef struct eventOS_event_timer_stats_t {
+    uint16_t active;        /**< Timers waiting for their launch time */
+    uint16_t active_max;    /**< Most timers waiting at once */
+    uint16_t allocated;     /**< Timers in use, waiting or with their event queued */
+    uint32_t launched;      /**< Timer events sent since start up */
+} eventOS_event_timer_stats_t;
+
+/**
+ * Read system timer statistics
+ *
+ * Timers are kept in a heap on their launch time, so requesting, cancelling
+ * and launching a timer costs O(log n) in the number of active timers.
+ *
+ * \param stats structure to fill in
+ *
+ * */
+extern void eventOS_event_timer_stats_get(eventOS_event_timer_stats_t *stats);
+
 
 /** Timeout structure. Not to be modified by user */
 typedef struct timeout_entry_t timeout_t;
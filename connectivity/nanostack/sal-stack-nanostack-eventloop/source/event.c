@@ -33,6 +33,8 @@ typedef struct arm_core_tasklet {
 
 static NS_LIST_DEFINE(arm_core_tasklet_list, arm_core_tasklet_t, link);
 static NS_LIST_DEFINE(event_queue_active, arm_event_storage_t, link);
+// Last queued event of each priority, so events are queued without a scan
+static arm_event_storage_t *event_queue_tail[ARM_LIB_LOW_PRIORITY_EVENT + 1];
 static NS_LIST_DEFINE(free_event_entry, arm_event_storage_t, link);
 
 // Statically allocate initial pool of events.
@@ -47,6 +49,7 @@ static arm_core_tasklet_t *tasklet_dynamically_allocate(void);
 static arm_event_storage_t *event_dynamically_allocate(void);
 static arm_event_storage_t *event_core_get(void);
 static void event_core_write(arm_event_storage_t *event);
+static void event_core_unlink(arm_event_storage_t *event);
 
 static arm_core_tasklet_t *event_tasklet_handler_get(uint8_t tasklet_id)
 {
@@ -143,7 +146,7 @@ void eventOS_event_send_timer_allocated(arm_event_storage_t *event)
 
 void eventOS_event_cancel_critical(arm_event_storage_t *event)
 {
-    ns_list_remove(&event_queue_active, event);
+    event_core_unlink(event);
 }
 
 static arm_event_storage_t *event_dynamically_allocate(void)
@@ -213,27 +216,44 @@ static arm_event_storage_t *event_core_read(void)
     arm_event_storage_t *event = ns_list_get_first(&event_queue_active);
     if (event) {
         event->state = ARM_LIB_EVENT_RUNNING;
-        ns_list_remove(&event_queue_active, event);
+        event_core_unlink(event);
     }
     platform_exit_critical();
     return event;
 }
 
+static unsigned event_core_priority(const arm_event_storage_t *event)
+{
+    // Anything below low priority queues with it
+    return event->data.priority > ARM_LIB_LOW_PRIORITY_EVENT ? ARM_LIB_LOW_PRIORITY_EVENT : event->data.priority;
+}
+
+// Requires lock to be held
+static void event_core_unlink(arm_event_storage_t *event)
+{
+    unsigned priority = event_core_priority(event);
+    if (event_queue_tail[priority] == event) {
+        arm_event_storage_t *prev = ns_list_get_previous(&event_queue_active, event);
+        event_queue_tail[priority] = prev && event_core_priority(prev) == priority ? prev : NULL;
+    }
+    ns_list_remove(&event_queue_active, event);
+}
+
 void event_core_write(arm_event_storage_t *event)
 {
     platform_enter_critical();
-    bool added = false;
-    ns_list_foreach(arm_event_storage_t, event_tmp, &event_queue_active) {
-        // note enum ordering means we're checking if event_tmp is LOWER priority than event
-        if (event_tmp->data.priority > event->data.priority) {
-            ns_list_add_before(&event_queue_active, event_tmp, event);
-            added = true;
-            break;
-        }
+    unsigned priority = event_core_priority(event);
+    // note enum ordering means we go after the last event of the same or a HIGHER priority
+    arm_event_storage_t *after = NULL;
+    for (unsigned i = priority + 1; i-- > 0 && !after;) {
+        after = event_queue_tail[i];
     }
-    if (!added) {
-        ns_list_add_to_end(&event_queue_active, event);
+    if (after) {
+        ns_list_add_after(&event_queue_active, after, event);
+    } else {
+        ns_list_add_to_start(&event_queue_active, event);
     }
+    event_queue_tail[priority] = event;
     event->state = ARM_LIB_EVENT_QUEUED;
 
     /* Wake From Idle */
@@ -265,6 +285,7 @@ void eventOS_scheduler_init(void)
     /* Reset Event List variables */
     ns_list_init(&free_event_entry);
     ns_list_init(&event_queue_active);
+    memset(event_queue_tail, 0, sizeof(event_queue_tail));
     ns_list_init(&arm_core_tasklet_list);
 
     //Add first 10 entries to "free" list
@@ -13,6 +13,7 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <string.h>
 #include "ns_types.h"
 #include "ns_list.h"
 #include "timer_sys.h"
@@ -41,12 +42,22 @@ NS_STATIC_ASSERT(1000 % EVENTOS_EVENT_TIMER_HZ == 0, "Need whole number of ms pe
 static volatile uint32_t timer_sys_ticks;
 
 static NS_LIST_DEFINE(system_timer_free, sys_timer_struct_s, event.link);
-static NS_LIST_DEFINE(system_timer_list, sys_timer_struct_s, event.link);
+
+// Binary min-heap of the timers waiting for their launch time, on launch
+// time then request order. Its capacity is kept at the number of timers in
+// use, so that periodic timers can always go back in.
+static sys_timer_struct_s **system_timer_heap;
+static uint16_t system_timer_heap_capacity;
+static uint16_t system_timer_count;
+static uint32_t system_timer_order;
+
+static eventOS_event_timer_stats_t system_timer_stats;
 
 
 static sys_timer_struct_s *sys_timer_dynamically_allocate(void);
 static void timer_sys_interrupt(void);
 static void timer_sys_add(sys_timer_struct_s *timer);
+static void timer_sys_launch(sys_timer_struct_s *timer);
 
 #ifndef NS_EVENTLOOP_USE_TICK_TIMER
 static int8_t platform_tick_timer_start(uint32_t period_ms);
@@ -129,16 +140,103 @@ static sys_timer_struct_s *sys_timer_dynamically_allocate(void)
     return ns_dyn_mem_alloc(sizeof(sys_timer_struct_s));
 }
 
+/* Called internally with lock held */
+static bool timer_heap_reserve(uint32_t count)
+{
+    if (count <= system_timer_heap_capacity) {
+        return true;
+    }
+    if (count > UINT16_MAX) {
+        return false;
+    }
+
+    uint16_t capacity = system_timer_heap_capacity ? system_timer_heap_capacity : ST_MAX;
+    while (capacity < count) {
+        capacity = capacity > UINT16_MAX / 2 ? UINT16_MAX : capacity * 2;
+    }
+
+    sys_timer_struct_s **heap = ns_dyn_mem_alloc(capacity * sizeof(sys_timer_struct_s *));
+    if (!heap) {
+        return false;
+    }
+    if (system_timer_heap) {
+        memcpy(heap, system_timer_heap, system_timer_stats.active * sizeof(sys_timer_struct_s *));
+        ns_dyn_mem_free(system_timer_heap);
+    }
+    system_timer_heap = heap;
+    system_timer_heap_capacity = capacity;
+    return true;
+}
+
+static bool timer_before(const sys_timer_struct_s *a, const sys_timer_struct_s *b)
+{
+    if (a->launch_time != b->launch_time) {
+        return TICKS_BEFORE(a->launch_time, b->launch_time);
+    }
+    return (int32_t)(a->order - b->order) < 0;
+}
+
+static void timer_heap_set(uint16_t index, sys_timer_struct_s *timer)
+{
+    system_timer_heap[index] = timer;
+    timer->heap_index = index;
+}
+
+/* Move the timer up or down from index to its place */
+static void timer_heap_place(uint16_t index, sys_timer_struct_s *timer)
+{
+    while (index > 0) {
+        uint16_t parent = (index - 1) / 2;
+        if (!timer_before(timer, system_timer_heap[parent])) {
+            break;
+        }
+        timer_heap_set(index, system_timer_heap[parent]);
+        index = parent;
+    }
+
+    for (;;) {
+        uint32_t child = 2 * (uint32_t)index + 1;
+        if (child >= system_timer_stats.active) {
+            break;
+        }
+        if (child + 1 < system_timer_stats.active && timer_before(system_timer_heap[child + 1], system_timer_heap[child])) {
+            child++;
+        }
+        if (!timer_before(system_timer_heap[child], timer)) {
+            break;
+        }
+        timer_heap_set(index, system_timer_heap[child]);
+        index = child;
+    }
+
+    timer_heap_set(index, timer);
+}
+
+static void timer_heap_remove(sys_timer_struct_s *timer)
+{
+    sys_timer_struct_s *last = system_timer_heap[--system_timer_stats.active];
+    if (last != timer) {
+        timer_heap_place(timer->heap_index, last);
+    }
+}
+
 static sys_timer_struct_s *timer_struct_get(void)
 {
     sys_timer_struct_s *timer;
     platform_enter_critical();
+    if (!timer_heap_reserve(system_timer_count + 1)) {
+        platform_exit_critical();
+        return NULL;
+    }
     timer = ns_list_get_first(&system_timer_free);
     if (timer) {
         ns_list_remove(&system_timer_free, timer);
     } else {
         timer = sys_timer_dynamically_allocate();
     }
+    if (timer) {
+        system_timer_count++;
+    }
     platform_exit_critical();
     return timer;
 }
@@ -150,12 +248,13 @@ void timer_sys_event_free(arm_event_storage_t *event)
     if (timer->period == 0) {
         // Non-periodic - return to free list
         ns_list_add_to_start(&system_timer_free, timer);
+        system_timer_count--;
     } else {
         // Periodic - check due time of next launch
         timer->launch_time += timer->period;
         if (TICKS_BEFORE_OR_AT(timer->launch_time, timer_sys_ticks)) {
             // next event is overdue - queue event now
-            eventOS_event_send_timer_allocated(&timer->event);
+            timer_sys_launch(timer);
         } else {
             // add back to timer queue for the future
             timer_sys_add(timer);
@@ -168,9 +267,9 @@ void timer_sys_event_cancel_critical(struct arm_event_storage *event)
 {
     sys_timer_struct_s *timer = NS_CONTAINER_OF(event, sys_timer_struct_s, event);
     timer->period = 0;
-    // If its unqueued it is on my timer list, otherwise it is in event-loop.
+    // If its unqueued it is on my timer heap, otherwise it is in event-loop.
     if (event->state == ARM_LIB_EVENT_UNQUEUED) {
-        ns_list_remove(&system_timer_list, timer);
+        timer_heap_remove(timer);
     }
 }
 
@@ -186,21 +285,22 @@ uint32_t eventOS_event_timer_ticks(void)
 }
 
 /* Called internally with lock held */
+static void timer_sys_launch(sys_timer_struct_s *timer)
+{
+    eventOS_event_send_timer_allocated(&timer->event);
+    system_timer_stats.launched++;
+}
+
+/* Called internally with lock held, can't fail as the heap holds every timer in use */
 static void timer_sys_add(sys_timer_struct_s *timer)
 {
-    uint32_t at = timer->launch_time;
-
-    // Find first timer scheduled to run after us, and insert before it.
-    // (This means timers scheduled for same time run in order of request)
-    ns_list_foreach(sys_timer_struct_s, t, &system_timer_list) {
-        if (TICKS_BEFORE(at, t->launch_time)) {
-            ns_list_add_before(&system_timer_list, t, timer);
-            return;
-        }
-    }
+    // Timers scheduled for same time run in order of request
+    timer->order = system_timer_order++;
+    timer_heap_place(system_timer_stats.active++, timer);
 
-    // Didn't insert before another timer, so must be last.
-    ns_list_add_to_end(&system_timer_list, timer);
+    if (system_timer_stats.active > system_timer_stats.active_max) {
+        system_timer_stats.active_max = system_timer_stats.active;
+    }
 }
 
 /* Called internally with lock held */
@@ -225,7 +325,7 @@ static arm_event_storage_t *eventOS_event_timer_request_at_(const arm_event_t *e
     timer->period = period;
 
     if (TICKS_BEFORE_OR_AT(at, timer_sys_ticks)) {
-        eventOS_event_send_timer_allocated(&timer->event);
+        timer_sys_launch(timer);
     } else {
         timer_sys_add(timer);
     }
@@ -306,13 +406,19 @@ int8_t eventOS_event_timer_cancel(uint8_t event_id, int8_t tasklet_id)
 {
     platform_enter_critical();
 
-    /* First check pending timers */
-    ns_list_foreach(sys_timer_struct_s, cur, &system_timer_list) {
-        if (cur->event.data.receiver == tasklet_id && cur->event.data.event_id == event_id) {
-            eventOS_cancel(&cur->event);
-            goto done;
+    /* First check pending timers, the first to run of those matching */
+    sys_timer_struct_s *match = NULL;
+    for (uint16_t i = 0; i < system_timer_stats.active; i++) {
+        sys_timer_struct_s *cur = system_timer_heap[i];
+        if (cur->event.data.receiver == tasklet_id && cur->event.data.event_id == event_id &&
+                (!match || timer_before(cur, match))) {
+            match = cur;
         }
     }
+    if (match) {
+        eventOS_cancel(&match->event);
+        goto done;
+    }
 
     /* No pending timer, so check for already-pending event */
     arm_event_storage_t *event = eventOS_event_find_by_id_critical(tasklet_id, event_id);
@@ -335,7 +441,7 @@ uint32_t eventOS_event_timer_shortest_active_timer(void)
     uint32_t ret_val = 0;
 
     platform_enter_critical();
-    sys_timer_struct_s *first = ns_list_get_first(&system_timer_list);
+    sys_timer_struct_s *first = system_timer_stats.active ? system_timer_heap[0] : NULL;
     if (first == NULL) {
         // Weird API has 0 for "no events"
         ret_val = 0;
@@ -355,19 +461,23 @@ void system_timer_tick_update(uint32_t ticks)
     platform_enter_critical();
     //Keep runtime time
     timer_sys_ticks += ticks;
-    ns_list_foreach_safe(sys_timer_struct_s, cur, &system_timer_list) {
-        if (TICKS_BEFORE_OR_AT(cur->launch_time, timer_sys_ticks)) {
-            // Unthread from our list
-            ns_list_remove(&system_timer_list, cur);
-            // Make it an event (can't fail - no allocation)
-            // event system will call our timer_sys_event_free on event delivery.
-            eventOS_event_send_timer_allocated(&cur->event);
-        } else {
-            // List is ordered, so as soon as we see a later event, we're done.
-            break;
-        }
+    while (system_timer_stats.active && TICKS_BEFORE_OR_AT(system_timer_heap[0]->launch_time, timer_sys_ticks)) {
+        sys_timer_struct_s *cur = system_timer_heap[0];
+        // Take off our heap
+        timer_heap_remove(cur);
+        // Make it an event (can't fail - no allocation)
+        // event system will call our timer_sys_event_free on event delivery.
+        timer_sys_launch(cur);
     }
 
     platform_exit_critical();
 }
 
+void eventOS_event_timer_stats_get(eventOS_event_timer_stats_t *stats)
+{
+    platform_enter_critical();
+    *stats = system_timer_stats;
+    stats->allocated = system_timer_count;
+    platform_exit_critical();
+}
+
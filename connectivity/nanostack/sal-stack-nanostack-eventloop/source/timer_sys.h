@@ -27,6 +27,8 @@ typedef struct sys_timer_struct_s {
     arm_event_storage_t event;
     uint32_t launch_time; // tick value
     uint32_t period;
+    uint32_t order;       // request order, for timers with the same launch time
+    uint16_t heap_index;  // position in the timer heap while waiting
 } sys_timer_struct_s;
 
 
@@ -0,0 +1,26 @@
+
+####################
+# BENCHMARKS
+####################
+
+set(benchmark-includes ${benchmark-includes}
+  ../connectivity/nanostack/sal-stack-nanostack-eventloop/nanostack-event-loop
+  ../connectivity/nanostack/sal-stack-nanostack-eventloop/nanostack-event-loop/platform
+  ../connectivity/nanostack/sal-stack-nanostack-eventloop/source
+  ../connectivity/libraries/nanostack-libservice
+  ../connectivity/libraries/nanostack-libservice/mbed-client-libservice
+)
+
+set(benchmark-sources
+  ../connectivity/nanostack/sal-stack-nanostack-eventloop/source/event.c
+  ../connectivity/nanostack/sal-stack-nanostack-eventloop/source/system_timer.c
+  ../connectivity/libraries/nanostack-libservice/source/nsdynmemLIB/nsdynmemLIB.c
+  ../connectivity/libraries/nanostack-libservice/source/libList/ns_list.c
+  ../connectivity/nanostack/sal-stack-nanostack-eventloop/tests/BENCHMARKS/eventOS/benchmark_eventOS.cpp
+)
+
+# Ticked by the benchmark itself, without the high resolution timer
+set(benchmark-flags
+  -DMBED_CONF_NANOSTACK_EVENTLOOP_USE_PLATFORM_TICK_TIMER
+  -DMBED_CONF_NANOSTACK_EVENTLOOP_EXCLUDE_HIGHRES_TIMER
+)
@@ -0,0 +1,155 @@
+/* Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "benchmark/benchmark.h"
+#include "ns_types.h"
+#include "eventOS_event.h"
+#include "eventOS_event_timer.h"
+#include "eventOS_scheduler.h"
+#include "nsdynmemLIB.h"
+#include "timer_sys.h"
+
+#define HEAP_SIZE   (256 * 1024)
+
+// Platform of the event loop, ticked by hand
+extern "C" {
+void platform_enter_critical(void) {}
+void platform_exit_critical(void) {}
+void eventOS_scheduler_signal(void) {}
+void eventOS_scheduler_idle(void) {}
+int8_t platform_tick_timer_register(void (*)(void))
+{
+    return 0;
+}
+int8_t platform_tick_timer_start(uint32_t)
+{
+    return 0;
+}
+int8_t platform_tick_timer_stop(void)
+{
+    return 0;
+}
+int ns_timer_sleep(void)
+{
+    return 0;
+}
+}
+
+namespace {
+
+uint8_t heap[HEAP_SIZE];
+int8_t tasklet_id = -1;
+int handled;
+
+void tasklet(arm_event_s *event)
+{
+    if (event->event_type) {
+        handled++;
+    }
+}
+
+// The event loop can only be started once, the tasklet lives on
+int8_t event_loop()
+{
+    if (tasklet_id < 0) {
+        ns_dyn_mem_init(heap, sizeof(heap), NULL, NULL);
+        eventOS_scheduler_init();
+        tasklet_id = eventOS_event_handler_create(tasklet, 0);
+        eventOS_scheduler_run_until_idle();
+    }
+    return tasklet_id;
+}
+
+arm_event_t timer_event(int i)
+{
+    arm_event_t event = {};
+    event.receiver = event_loop();
+    event.event_type = 1;
+    event.event_id = i;
+    event.priority = ARM_LIB_MED_PRIORITY_EVENT;
+    return event;
+}
+
+// Spread out delays, their order unrelated to the order of request
+int32_t delay(int i)
+{
+    return 1 + (i * 7919) % 1000;
+}
+
+} // anonymous namespace
+
+// Request a timer and cancel it, among the given number of pending timers
+static void BM_eventOS_timer_request_cancel(benchmark::State &state)
+{
+    int pending = state.range(0);
+    for (int i = 0; i < pending; i++) {
+        arm_event_t event = timer_event(i % 200);
+        eventOS_event_timer_request_in(&event, delay(i));
+    }
+    arm_event_t event = timer_event(255);
+    int i = 0;
+
+    for (auto _ : state) {
+        arm_event_storage_t *timer = eventOS_event_timer_request_in(&event, delay(i++));
+        eventOS_cancel(timer);
+    }
+
+    eventOS_event_timer_stats_t stats;
+    eventOS_event_timer_stats_get(&stats);
+    state.counters["active"] = stats.active;
+    for (int i = 0; i < pending; i++) {
+        eventOS_event_timer_cancel(i % 200, tasklet_id);
+    }
+}
+BENCHMARK(BM_eventOS_timer_request_cancel)->Arg(0)->Arg(16)->Arg(256)->Arg(1024);
+
+// Request the given number of timers, then tick until all have run
+static void BM_eventOS_timer_run(benchmark::State &state)
+{
+    int count = state.range(0);
+
+    for (auto _ : state) {
+        for (int i = 0; i < count; i++) {
+            arm_event_t event = timer_event(i);
+            eventOS_event_timer_request_in(&event, delay(i));
+        }
+        while (eventOS_event_timer_shortest_active_timer()) {
+            system_timer_tick_update(1);
+            eventOS_scheduler_run_until_idle();
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_eventOS_timer_run)->Arg(16)->Arg(256)->Arg(1024);
+
+// Queue events of mixed priorities, then dispatch them all
+static void BM_eventOS_event_send_dispatch(benchmark::State &state)
+{
+    int count = state.range(0);
+    arm_event_t event = timer_event(0);
+
+    for (auto _ : state) {
+        for (int i = 0; i < count; i++) {
+            event.priority = (arm_library_event_priority_e)(i % 3);
+            eventOS_event_send(&event);
+        }
+        eventOS_scheduler_run_until_idle();
+    }
+
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_eventOS_event_send_dispatch)->Arg(16)->Arg(256)->Arg(1024);
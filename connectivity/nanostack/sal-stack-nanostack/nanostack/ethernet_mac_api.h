@@ -86,6 +86,23 @@ extern eth_mac_api_t *ethernet_mac_create(int8_t driver_id);
  */
 extern int8_t ethernet_mac_destroy(eth_mac_api_t *mac_api);
 
+/**
+ * @brief Pass a received frame to the MAC without copying it
+ *
+ * Alternative to the copying PHY RX callback for drivers receiving into
+ * nanostack heap. The MAC takes ownership of storage and frees it with
+ * ns_dyn_mem_free() once the frame is handled, also on failure.
+ *
+ * @param driver_id Ethernet driver id
+ * @param data_ptr Start of the frame, within storage
+ * @param data_len Length of the frame
+ * @param link_quality Link quality
+ * @param dbm Measured dBm
+ * @param storage Nanostack heap block holding the frame
+ * @return 0 if successful, -1 otherwise
+ */
+extern int8_t ethernet_mac_rx_buffer(int8_t driver_id, uint8_t *data_ptr, uint16_t data_len, uint8_t link_quality, int8_t dbm, void *storage);
+
 /**
  * @brief data_request data request call
  * @param api API to handle the request
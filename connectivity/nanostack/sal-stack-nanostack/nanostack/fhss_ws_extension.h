@@ -64,6 +64,22 @@ typedef struct broadcast_timing_info {
     uint32_t bt_rx_timestamp;                   /**< BT-IE reception timestamp */
 } broadcast_timing_info_t;
 
+#ifndef FHSS_WS_HOP_CACHE_SIZE
+/** Number of upcoming unicast slots whose channel is kept per neighbour, at least 1 */
+#define FHSS_WS_HOP_CACHE_SIZE  8
+#endif
+
+/**
+ * @brief fhss_ws_hop_cache Neighbor unicast hopping sequence from a slot on, maintained by FHSS.
+ */
+typedef struct fhss_ws_hop_cache {
+    uint16_t start_slot;                            /**< Slot of the first cached channel */
+    uint16_t number_of_channels;                    /**< Number of channels the sequence was computed for */
+    unsigned channel_function: 3;                   /**< Channel function the sequence was computed with */
+    uint8_t count;                                  /**< Number of cached channels, 0 when empty */
+    uint8_t channel_index[FHSS_WS_HOP_CACHE_SIZE];  /**< Channel function outputs, before applying the channel mask */
+} fhss_ws_hop_cache_t;
+
 /**
  * @brief fhss_ws_neighbor_timing_info Neighbor timing/hopping schedule information structure.
  */
@@ -74,6 +90,7 @@ typedef struct fhss_ws_neighbor_timing_info {
     broadcast_timing_info_t bc_timing_info;     /**< Neighbor broadcast timing info */
     ws_channel_mask_t uc_channel_list;          /**< Neighbor Unicast channel list */
     uint32_t *excluded_channels;                /**< Neighbor excluded channels (bit mask) */
+    fhss_ws_hop_cache_t uc_hop_cache;           /**< Neighbor unicast hopping sequence, must be zeroed with the rest of the structure */
 } fhss_ws_neighbor_timing_info_t;
 
 /**
@@ -67,6 +67,8 @@ typedef struct nwk_stats_t {
     uint32_t buf_headroom_realloc;  /**< Buffer headroom realloc count. */
     uint32_t buf_headroom_shuffle;  /**< Buffer headroom shuffle count. */
     uint32_t buf_headroom_fail;     /**< Buffer headroom failure count. */
+    uint32_t buf_pool_alloc;        /**< Buffer allocations served from a fixed size pool. */
+    uint32_t buf_pool_fallback;     /**< Buffer allocations that fell back to the heap with their pool empty. */
     /* ETX */
     uint16_t etx_1st_parent;        /**< Primary parent ETX. */
     uint16_t etx_2nd_parent;        /**< Secondary parent ETX. */
@@ -40,6 +40,111 @@
 
 volatile unsigned int buffer_count = 0;
 
+#if BUFFER_POOL_SMALL_COUNT > 0 || BUFFER_POOL_LARGE_COUNT > 0
+#define BUFFER_POOL
+#endif
+
+#ifdef BUFFER_POOL
+typedef struct buffer_pool_slab {
+    struct buffer_pool_slab *next;
+} buffer_pool_slab_t;
+
+typedef struct buffer_pool {
+    uint8_t *slabs;                 /* NULL if the pool is disabled */
+    buffer_pool_slab_t *free_list;
+    uint16_t data_size;             /* Largest buffer total size a slab holds */
+    uint16_t slab_size;
+    uint16_t count;
+} buffer_pool_t;
+
+/* Sorted by size, so the smallest fitting pool is tried first */
+static buffer_pool_t buffer_pools[] = {
+    { NULL, NULL, BUFFER_POOL_SMALL_SIZE, 0, BUFFER_POOL_SMALL_COUNT },
+    { NULL, NULL, BUFFER_POOL_LARGE_SIZE, 0, BUFFER_POOL_LARGE_COUNT },
+};
+
+#define BUFFER_POOL_COUNT (sizeof(buffer_pools) / sizeof(buffer_pools[0]))
+
+void buffer_pool_init(void)
+{
+    for (unsigned i = 0; i < BUFFER_POOL_COUNT; i++) {
+        buffer_pool_t *pool = &buffer_pools[i];
+        if (pool->slabs || !pool->count) {
+            continue;
+        }
+
+        // Keep every slab aligned for the buffer_t at its start
+        pool->slab_size = (sizeof(buffer_t) + pool->data_size + 7) & ~7;
+        pool->slabs = ns_dyn_mem_alloc((uint32_t)pool->slab_size * pool->count);
+        if (!pool->slabs) {
+            tr_error("buffer pool %u alloc failed", i);
+            continue;
+        }
+
+        for (uint16_t n = 0; n < pool->count; n++) {
+            buffer_pool_slab_t *slab = (buffer_pool_slab_t *)(pool->slabs + (uint32_t)n * pool->slab_size);
+            slab->next = pool->free_list;
+            pool->free_list = slab;
+        }
+    }
+}
+
+static buffer_t *buffer_alloc(uint32_t total_size)
+{
+    bool fallback = false;
+
+    for (unsigned i = 0; i < BUFFER_POOL_COUNT; i++) {
+        buffer_pool_t *pool = &buffer_pools[i];
+        if (!pool->slabs || total_size > pool->data_size) {
+            continue;
+        }
+
+        platform_enter_critical();
+        buffer_pool_slab_t *slab = pool->free_list;
+        if (slab) {
+            pool->free_list = slab->next;
+        }
+        platform_exit_critical();
+
+        if (slab) {
+            protocol_stats_update(STATS_BUFFER_POOL_ALLOC, 1);
+            return (buffer_t *)slab;
+        }
+        fallback = true;
+    }
+
+    if (fallback) {
+        protocol_stats_update(STATS_BUFFER_POOL_FALLBACK, 1);
+    }
+    return ns_dyn_mem_temporary_alloc(sizeof(buffer_t) + total_size);
+}
+
+static void buffer_release(buffer_t *buf)
+{
+    for (unsigned i = 0; i < BUFFER_POOL_COUNT; i++) {
+        buffer_pool_t *pool = &buffer_pools[i];
+        uint8_t *ptr = (uint8_t *)buf;
+        if (pool->slabs && ptr >= pool->slabs && ptr < pool->slabs + (uint32_t)pool->slab_size * pool->count) {
+            buffer_pool_slab_t *slab = (buffer_pool_slab_t *)buf;
+            platform_enter_critical();
+            slab->next = pool->free_list;
+            pool->free_list = slab;
+            platform_exit_critical();
+            return;
+        }
+    }
+
+    ns_dyn_mem_free(buf);
+}
+#else
+void buffer_pool_init(void)
+{
+}
+
+#define buffer_alloc(total_size) ns_dyn_mem_temporary_alloc(sizeof(buffer_t) + (total_size))
+#define buffer_release(buf) ns_dyn_mem_free(buf)
+#endif
+
 uint8_t *(buffer_corrupt_check)(buffer_t *buf)
 {
     if (buf == NULL) {
@@ -66,7 +171,8 @@ buffer_t *buffer_get_minimal(uint16_t size)
 }
 
 /**
- * Get pointer to a buffer_t structure and reserve memory for it from the dynamic heap.
+ * Get pointer to a buffer_t structure and reserve memory for it from a buffer pool
+ * or the dynamic heap.
  *
  * \param headroom required headroom in addition to basic size
  * \param size basic size of data allocate memory for
@@ -91,7 +197,7 @@ buffer_t *buffer_get_specific(uint16_t headroom, uint16_t size, uint16_t minspac
     if (total_size <= BUFFER_MAX_SIZE) {
         // Note - as well as this alloc+init, buffers can also be "realloced"
         // in buffer_headroom()
-        buf = ns_dyn_mem_temporary_alloc(sizeof(buffer_t) + total_size);
+        buf = buffer_alloc(total_size);
     }
 
     if (buf) {
@@ -142,7 +248,7 @@ buffer_t *buffer_headroom(buffer_t *buf, uint16_t size)
         // TODO - should we be giving them extra? probably
         uint32_t new_total = (curr_len + size + 3) & ~ 3;
         if (new_total <= BUFFER_MAX_SIZE) {
-            new_buf = ns_dyn_mem_temporary_alloc(sizeof(buffer_t) + new_total);
+            new_buf = buffer_alloc(new_total);
         }
 
         if (new_buf) {
@@ -155,7 +261,7 @@ buffer_t *buffer_headroom(buffer_t *buf, uint16_t size)
             // Copy the current data
             memcpy(buffer_data_pointer(new_buf), buffer_data_pointer(buf), curr_len);
             protocol_stats_update(STATS_BUFFER_HEADROOM_REALLOC, 1);
-            ns_dyn_mem_free(buf);
+            buffer_release(buf);
             buf = new_buf;
         } else {
             tr_error("HeadRoom Fail");
@@ -211,7 +317,7 @@ buffer_t *buffer_free(buffer_t *buf)
         socket_dereference(buf->socket);
         ns_dyn_mem_free(buf->predecessor);
         ns_dyn_mem_free(buf->rpl_option);
-        ns_dyn_mem_free(buf);
+        buffer_release(buf);
 
     } else {
         tr_error("nullp F");
@@ -49,6 +49,28 @@
 #define ACK_BUFFER_SIZE 5
 #endif
 
+/*
+ * Fixed size pools buffer_get() serves before falling back to the heap.
+ * Small slabs fit a default buffer carrying an 802.15.4 frame, large slabs
+ * an IPv6 minimum MTU packet with default headroom. Pools are allocated from
+ * the heap once by buffer_pool_init(); a count of 0 disables the pool.
+ */
+#ifndef BUFFER_POOL_SMALL_SIZE
+#define BUFFER_POOL_SMALL_SIZE 128
+#endif
+
+#ifndef BUFFER_POOL_SMALL_COUNT
+#define BUFFER_POOL_SMALL_COUNT 0
+#endif
+
+#ifndef BUFFER_POOL_LARGE_SIZE
+#define BUFFER_POOL_LARGE_SIZE 1320
+#endif
+
+#ifndef BUFFER_POOL_LARGE_COUNT
+#define BUFFER_POOL_LARGE_COUNT 0
+#endif
+
 /*
  * headroom given to buffers by default.
  * if buffer value is below 107 bytes then remaining value is allocated as headroom.
@@ -252,6 +274,9 @@ NS_STATIC_ASSERT(offsetof(buffer_t, link) == 0, "Some use NS_LIST_HEAD_INCOMPLET
 
 
 
+/** Allocate the buffer pools, if configured */
+extern void buffer_pool_init(void);
+
 /** Allocate memory for a buffer_t from the heap */
 extern buffer_t *buffer_get(uint16_t size);
 
@@ -258,6 +258,7 @@ typedef struct protocol_interface_rf_mac_setup {
     uint32_t enhanced_ack_handler_timestamp;
     arm_event_t mac_mcps_timer_event;
     arm_event_storage_t mac_ack_event;
+    arm_event_storage_t mac_confirm_event;
     uint16_t indirect_pending_bytes;
     arm_nwk_mlme_event_type_e mac_mlme_event;
     mac_event_t timer_mac_event;
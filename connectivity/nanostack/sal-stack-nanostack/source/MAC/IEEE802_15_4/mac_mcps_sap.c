@@ -2472,16 +2472,26 @@ int8_t mcps_sap_pd_confirm(void *mac_ptr)
     if (mac_tasklet_event_handler < 0  || !mac_ptr) {
         return -2;
     }
-    arm_event_s event = {
-        .receiver = mac_tasklet_event_handler,
-        .sender = 0,
-        .event_id = 0,
-        .data_ptr = mac_ptr,
-        .event_type = MCPS_SAP_DATA_CNF_EVENT,
-        .priority = ARM_LIB_HIGH_PRIORITY_EVENT,
-    };
+    protocol_interface_rf_mac_setup_s *rf_ptr = mac_ptr;
+    arm_event_storage_t *event = &rf_ptr->mac_confirm_event;
 
-    return eventOS_event_send(&event);
+    /* Confirmation of every frame, so send it without allocating. The tasklet
+     * reads the TX result from the MAC, a queued confirmation covers a new one.
+     */
+    platform_enter_critical();
+    if (event->state != ARM_LIB_EVENT_QUEUED) {
+        event->data.data_ptr = mac_ptr;
+        event->data.event_data = 0;
+        event->data.event_id = 0;
+        event->data.event_type = MCPS_SAP_DATA_CNF_EVENT;
+        event->data.priority = ARM_LIB_HIGH_PRIORITY_EVENT;
+        event->data.sender = 0;
+        event->data.receiver = mac_tasklet_event_handler;
+        eventOS_event_send_user_allocated(event);
+    }
+    platform_exit_critical();
+
+    return 0;
 }
 
 int8_t mcps_sap_pd_confirm_failure(void *mac_ptr)
@@ -2602,6 +2612,9 @@ void mac_mcps_buffer_queue_free(protocol_interface_rf_mac_setup_s *rf_mac_setup)
         mcps_sap_prebuild_frame_buffer_free(rf_mac_setup->active_pd_data_request);
         rf_mac_setup->active_pd_data_request = NULL;
     }
+    if (rf_mac_setup->mac_confirm_event.state == ARM_LIB_EVENT_QUEUED) {
+        eventOS_cancel(&rf_mac_setup->mac_confirm_event);
+    }
 
     while (rf_mac_setup->pd_data_request_queue_to_go) {
         mac_pre_build_frame_t *buffer = mcps_sap_pd_req_queue_read(rf_mac_setup, false, true);
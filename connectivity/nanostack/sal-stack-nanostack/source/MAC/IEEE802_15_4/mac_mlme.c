@@ -1075,6 +1075,9 @@ void mac_mlme_data_base_deallocate(struct protocol_interface_rf_mac_setup *rf_ma
         eventOS_callback_timer_unregister(rf_mac->mlme_timer_id);
         eventOS_callback_timer_unregister(rf_mac->mac_timer_id);
         eventOS_callback_timer_unregister(rf_mac->mac_mcps_timer);
+        if (rf_mac->mac_confirm_event.state == ARM_LIB_EVENT_QUEUED) {
+            eventOS_cancel(&rf_mac->mac_confirm_event);
+        }
 
         ns_dyn_mem_free(rf_mac->dev_driver_tx_buffer.buf);
         ns_dyn_mem_free(rf_mac->dev_driver_tx_buffer.enhanced_ack_buf);
@@ -35,6 +35,14 @@ typedef struct eth_mac_internal_s {
     //linked list link
 } eth_mac_internal_t;
 
+/* Received frame waiting for the tasklet. Either the payload follows the
+ * entry in the same allocation, or it is in storage handed over by the driver.
+ */
+typedef struct eth_data_ind_entry_s {
+    eth_data_ind_t data_ind;
+    void *storage;
+} eth_data_ind_entry_t;
+
 static eth_mac_internal_t mac_store = { //Hack only at this point, later put into linked list
     .tasklet_id = -1
 };
@@ -174,10 +182,10 @@ static void ethernet_mac_tasklet(arm_event_s *event)
 
     switch (event_type) {
         case ETH_DATA_IND_EVENT: {
-            eth_data_ind_t *data_ind = event->data_ptr;
-            mac_store.mac_api->data_ind_cb(mac_store.mac_api, data_ind);
-            ns_dyn_mem_free(((eth_data_ind_t *)event->data_ptr)->msdu);
-            ns_dyn_mem_free(event->data_ptr);
+            eth_data_ind_entry_t *entry = event->data_ptr;
+            mac_store.mac_api->data_ind_cb(mac_store.mac_api, &entry->data_ind);
+            ns_dyn_mem_free(entry->storage);
+            ns_dyn_mem_free(entry);
             break;
         }
         case ETH_DATA_CNF_EVENT: {
@@ -259,7 +267,7 @@ static void data_req(const eth_mac_api_t *api, const eth_data_req_t *data)
     mac_store.dev_driver->phy_driver->tx(data_ptr, data_length, 0, PHY_LAYER_PAYLOAD);
 }
 
-static int8_t eth_mac_net_phy_rx(const uint8_t *data_ptr, uint16_t data_len, uint8_t link_quality, int8_t dbm, int8_t driver_id)
+static int8_t eth_mac_rx(const uint8_t *data_ptr, uint16_t data_len, uint8_t link_quality, int8_t dbm, int8_t driver_id, void *storage)
 {
     arm_device_driver_list_s *driver = arm_net_phy_driver_pointer(driver_id);
     if (!data_ptr || !driver || driver != mac_store.dev_driver) {
@@ -275,65 +283,90 @@ static int8_t eth_mac_net_phy_rx(const uint8_t *data_ptr, uint16_t data_len, uin
         return -1;
     }
 
-    eth_data_ind_t *data_ind = ns_dyn_mem_temporary_alloc(sizeof(eth_data_ind_t));
-    if (!data_ind) {
-        return -1;
-    }
-    memset(data_ind, 0, sizeof(eth_data_ind_t));
+    eth_data_ind_t data_ind;
+    memset(&data_ind, 0, sizeof(eth_data_ind_t));
 
     if (driver->phy_driver->link_type == PHY_LINK_ETHERNET_TYPE) {
         if (data_len < ETHERNET_HDRLEN + 1) {
-            ns_dyn_mem_free(data_ind);
             return -1;
         }
 
-        memcpy(data_ind->dstAddress, data_ptr +  ETHERNET_HDROFF_DST_ADDR, 6);
-        memcpy(data_ind->srcAddress, data_ptr +  ETHERNET_HDROFF_SRC_ADDR, 6);
+        memcpy(data_ind.dstAddress, data_ptr +  ETHERNET_HDROFF_DST_ADDR, 6);
+        memcpy(data_ind.srcAddress, data_ptr +  ETHERNET_HDROFF_SRC_ADDR, 6);
 
-        data_ind->etehernet_type = common_read_16_bit(data_ptr + ETHERNET_HDROFF_TYPE);
+        data_ind.etehernet_type = common_read_16_bit(data_ptr + ETHERNET_HDROFF_TYPE);
 
         data_ptr += ETHERNET_HDRLEN;
         data_len -= ETHERNET_HDRLEN;
 
     } else if (driver->phy_driver->link_type == PHY_LINK_TUN) {
         if (data_len < 5) {
-            ns_dyn_mem_free(data_ind);
             return -1;
         }
         /* TUN header
          * [ TUN FLAGS 2B | PROTOCOL 2B | PAYLOAD ]
          * Protocol is ether-type id.
          */
-        data_ind->etehernet_type = common_read_16_bit(data_ptr + 2);
+        data_ind.etehernet_type = common_read_16_bit(data_ptr + 2);
 
         data_len -= 4;
         data_ptr += 4;
     } else if (driver->phy_driver->link_type == PHY_LINK_SLIP || driver->phy_driver->link_type == PHY_LINK_PPP) {
-        data_ind->etehernet_type = ETHERTYPE_IPV6;
+        data_ind.etehernet_type = ETHERTYPE_IPV6;
     }
 
-    data_ind->msdu = ns_dyn_mem_temporary_alloc(data_len);
-    if (!data_ind->msdu) {
-        ns_dyn_mem_free(data_ind);
-        return -1;
+    eth_data_ind_entry_t *entry;
+    if (storage) {
+        // Payload stays where the driver received it
+        entry = ns_dyn_mem_temporary_alloc(sizeof(eth_data_ind_entry_t));
+        if (!entry) {
+            return -1;
+        }
+        data_ind.msdu = (uint8_t *) data_ptr;
+    } else {
+        entry = ns_dyn_mem_temporary_alloc(sizeof(eth_data_ind_entry_t) + data_len);
+        if (!entry) {
+            return -1;
+        }
+        data_ind.msdu = (uint8_t *)(entry + 1);
+        memcpy(data_ind.msdu, data_ptr, data_len);
     }
-    memcpy(data_ind->msdu, data_ptr, data_len);
-    data_ind->msduLength = data_len;
-    data_ind->dbm = dbm;
-    data_ind->link_quality = link_quality;
+    data_ind.msduLength = data_len;
+    data_ind.dbm = dbm;
+    data_ind.link_quality = link_quality;
+    entry->data_ind = data_ind;
+    entry->storage = storage;
 
     arm_event_s event = {
         .receiver = mac_store.tasklet_id,
         .sender = 0,
         .event_id = 0,
-        .data_ptr = data_ind,
+        .data_ptr = entry,
         .event_type = ETH_DATA_IND_EVENT,
         .priority = ARM_LIB_HIGH_PRIORITY_EVENT,
     };
 
     if (eventOS_event_send(&event)) {
-        ns_dyn_mem_free(data_ind->msdu);
-        ns_dyn_mem_free(data_ind);
+        ns_dyn_mem_free(entry);
+        return -1;
+    }
+
+    return 0;
+}
+
+static int8_t eth_mac_net_phy_rx(const uint8_t *data_ptr, uint16_t data_len, uint8_t link_quality, int8_t dbm, int8_t driver_id)
+{
+    return eth_mac_rx(data_ptr, data_len, link_quality, dbm, driver_id, NULL);
+}
+
+int8_t ethernet_mac_rx_buffer(int8_t driver_id, uint8_t *data_ptr, uint16_t data_len, uint8_t link_quality, int8_t dbm, void *storage)
+{
+    if (!storage) {
+        return -1;
+    }
+
+    if (eth_mac_rx(data_ptr, data_len, link_quality, dbm, driver_id, storage)) {
+        ns_dyn_mem_free(storage);
         return -1;
     }
 
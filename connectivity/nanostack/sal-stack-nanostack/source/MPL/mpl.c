@@ -51,6 +51,10 @@
 #define MAX_BUFFERED_MESSAGES_SIZE 8192
 #define MAX_BUFFERED_MESSAGE_LIFETIME 600 // 1/10 s ticks
 
+#ifndef MPL_SEED_HASH_SIZE
+#define MPL_SEED_HASH_SIZE 8 // Buckets of the seed index of each domain, a power of 2
+#endif
+
 static bool mpl_timer_running;
 static uint16_t mpl_total_buffered;
 
@@ -83,10 +87,12 @@ typedef struct mpl_data_message {
 
 typedef struct mpl_seed {
     ns_list_link_t link;
+    struct mpl_seed *hash_next;             /* next seed in the same bucket of the domain seed index */
     bool colour;
     uint16_t lifetime;
     uint8_t min_sequence;
     uint8_t id_len;
+    uint8_t buffered[32];                   /* bitmap of the sequence numbers in messages */
     NS_LIST_HEAD(mpl_buffered_message_t, link) messages; /* sequence number order */
     uint8_t id[];
 } mpl_seed_t;
@@ -100,6 +106,7 @@ struct mpl_domain {
     bool proactive_forwarding;
     uint16_t seed_set_entry_lifetime;
     NS_LIST_HEAD(mpl_seed_t, link) seeds;
+    mpl_seed_t *seed_hash[MPL_SEED_HASH_SIZE]; // Index of seeds, by hash of seed id
     trickle_t trickle;                      // Control timer
     trickle_params_t data_trickle_params;
     trickle_params_t control_trickle_params;
@@ -235,6 +242,7 @@ mpl_domain_t *mpl_domain_create(protocol_interface_info_entry_t *cur, const uint
     domain->sequence = randLIB_get_8bit();
     domain->colour = false;
     ns_list_init(&domain->seeds);
+    memset(domain->seed_hash, 0, sizeof domain->seed_hash);
     domain->proactive_forwarding = proactive_forwarding >= 0 ? proactive_forwarding
                                    : cur->mpl_proactive_forwarding;
     domain->seed_set_entry_lifetime = seed_set_entry_lifetime ? seed_set_entry_lifetime
@@ -313,9 +321,19 @@ static void mpl_domain_inconsistent(mpl_domain_t *domain)
     mpl_schedule_timer();
 }
 
+/* FNV-1a, folded to a bucket of the domain seed index */
+static uint_fast8_t mpl_seed_hash(uint8_t id_len, const uint8_t *seed_id)
+{
+    uint32_t hash = 2166136261u ^ id_len;
+    for (uint_fast8_t i = 0; i < id_len; i++) {
+        hash = (hash ^ seed_id[i]) * 16777619u;
+    }
+    return (hash ^ (hash >> 16)) & (MPL_SEED_HASH_SIZE - 1);
+}
+
 static mpl_seed_t *mpl_seed_lookup(const mpl_domain_t *domain, uint8_t id_len, const uint8_t *seed_id)
 {
-    ns_list_foreach(mpl_seed_t, seed, &domain->seeds) {
+    for (mpl_seed_t *seed = domain->seed_hash[mpl_seed_hash(id_len, seed_id)]; seed; seed = seed->hash_next) {
         if (seed->id_len == id_len && memcmp(seed->id, seed_id, id_len) == 0) {
             return seed;
         }
@@ -335,9 +353,14 @@ static mpl_seed_t *mpl_seed_create(mpl_domain_t *domain, uint8_t id_len, const u
     seed->lifetime = domain->seed_set_entry_lifetime;
     seed->id_len = id_len;
     seed->colour = domain->colour;
+    memset(seed->buffered, 0, sizeof seed->buffered);
     ns_list_init(&seed->messages);
     memcpy(seed->id, seed_id, id_len);
     ns_list_add_to_end(&domain->seeds, seed);
+
+    mpl_seed_t **bucket = &domain->seed_hash[mpl_seed_hash(id_len, seed_id)];
+    seed->hash_next = *bucket;
+    *bucket = seed;
     return seed;
 }
 
@@ -346,6 +369,12 @@ static void mpl_seed_delete(mpl_domain_t *domain, mpl_seed_t *seed)
     ns_list_foreach_safe(mpl_buffered_message_t, message, &seed->messages) {
         mpl_buffer_delete(seed, message);
     }
+    for (mpl_seed_t **p = &domain->seed_hash[mpl_seed_hash(seed->id_len, seed->id)]; *p; p = &(*p)->hash_next) {
+        if (*p == seed) {
+            *p = seed->hash_next;
+            break;
+        }
+    }
     ns_list_remove(&domain->seeds, seed);
     ns_dyn_mem_free(seed);
 }
@@ -362,6 +391,10 @@ static void mpl_seed_advance_min_sequence(mpl_seed_t *seed, uint8_t min_sequence
 
 static mpl_buffered_message_t *mpl_buffer_lookup(mpl_seed_t *seed, uint8_t sequence)
 {
+    /* Most lookups are of new messages, answered by the bitmap */
+    if (!bit_test(seed->buffered, sequence)) {
+        return NULL;
+    }
     ns_list_foreach(mpl_buffered_message_t, message, &seed->messages) {
         if (mpl_buffer_sequence(message) == sequence) {
             return message;
@@ -457,6 +490,7 @@ static mpl_buffered_message_t *mpl_buffer_create(buffer_t *buf, mpl_domain_t *do
     if (!inserted) {
         ns_list_add_to_start(&seed->messages, message);
     }
+    bit_set(seed->buffered, sequence);
     mpl_total_buffered += ip_len;
 
     /* Does MPL spec intend this distinction between start and reset? */
@@ -468,6 +502,7 @@ static mpl_buffered_message_t *mpl_buffer_create(buffer_t *buf, mpl_domain_t *do
 static void mpl_buffer_delete(mpl_seed_t *seed, mpl_buffered_message_t *message)
 {
     mpl_total_buffered -= mpl_buffer_size(message);
+    bit_clear(seed->buffered, mpl_buffer_sequence(message));
     ns_list_remove(&seed->messages, message);
     ns_dyn_mem_free(message);
 }
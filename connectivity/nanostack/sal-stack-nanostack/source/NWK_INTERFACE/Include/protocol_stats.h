@@ -42,6 +42,8 @@ typedef enum {
     STATS_BUFFER_HEADROOM_REALLOC,
     STATS_BUFFER_HEADROOM_SHUFFLE,
     STATS_BUFFER_HEADROOM_FAIL,
+    STATS_BUFFER_POOL_ALLOC,
+    STATS_BUFFER_POOL_FALLBACK,
     STATS_ETX_1ST_PARENT,
     STATS_ETX_2ND_PARENT,
     STATS_AL_TX_QUEUE_SIZE,
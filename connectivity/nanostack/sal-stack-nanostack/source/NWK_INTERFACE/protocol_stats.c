@@ -139,6 +139,14 @@ void protocol_stats_update(nwk_stats_type_t type, uint16_t update_val)
                 nwk_stats_ptr->buf_headroom_fail++;
                 break;
 
+            case STATS_BUFFER_POOL_ALLOC:
+                nwk_stats_ptr->buf_pool_alloc++;
+                break;
+
+            case STATS_BUFFER_POOL_FALLBACK:
+                nwk_stats_ptr->buf_pool_fallback++;
+                break;
+
             case STATS_ETX_1ST_PARENT:
                 nwk_stats_ptr->etx_1st_parent = update_val;
                 break;
@@ -30,16 +30,6 @@
     c ^= b; c -= rot(b, 24); \
 }
 
-#define mix(a,b,c) \
-{ \
-    a -= c; a ^= rot(c, 4); c += b; \
-    b -= a; b ^= rot(a, 6); a += c; \
-    c -= b; c ^= rot(b, 8); b += a; \
-    a -= c; a ^= rot(c, 16); c += b; \
-    b -= a; b ^= rot(a, 19); a += c; \
-    c -= b; c ^= rot(b, 4); b += a; \
-}
-
 static uint32_t global_seed = 1;
 
 
@@ -48,17 +38,20 @@ uint16_t tr51_calc_nearest_prime_number(uint16_t start_value)
     if (start_value < 2) {
         return 0;
     }
-    uint16_t divider = start_value - 1;
-    while (start_value) {
-        if (start_value % divider--) {
-            if (divider == 1) {
-                break;
-            }
-        } else {
-            divider = ++start_value - 1;
+    // 2 gives 3, as the channel tables of existing networks depend on it
+    if (start_value == 2) {
+        return 3;
+    }
+    for (uint32_t candidate = start_value; candidate <= UINT16_MAX; candidate++) {
+        uint32_t divider = 2;
+        while (divider * divider <= candidate && candidate % divider) {
+            divider++;
+        }
+        if (divider * divider > candidate) {
+            return candidate;
         }
     }
-    return start_value;
+    return 0;
 }
 
 static void tr51_seed_rand(uint32_t seed)
@@ -150,55 +143,41 @@ static uint16_t tr51_calculate_hopping_sequence(int16_t *channel_table, uint16_t
     return slot;
 }
 
-static uint32_t dh1cf_hashword(const uint32_t *key, size_t key_length, uint32_t init_value)
+/**
+ * @brief Jenkins lookup3 hashword() of a 3 word key with 0 init value, the only key DH1CF hashes.
+ * @param key0 First word of the key, the slot number.
+ * @param key1 Second word of the key.
+ * @param key2 Third word of the key.
+ * @return Hash value.
+ */
+static inline uint32_t dh1cf_hash3(uint32_t key0, uint32_t key1, uint32_t key2)
 {
     uint32_t a, b, c;
-    a = b = c = 0xdeadbeef + (((uint32_t)key_length) << 2) + init_value;
-    while (key_length > 3) {
-        a += key[0];
-        b += key[1];
-        c += key[2];
-        mix(a, b, c);
-        key_length -= 3;
-        key += 3;
-    }
-    switch (key_length) {
-        case 3:
-            c += key[2];
-        /* fall through */
-        case 2:
-            b += key[1];
-        /* fall through */
-        case 1:
-            a += key[0];
-            final(a, b, c);
-        /* fall through */
-        case 0:
-            break;
-    }
+    a = b = c = 0xdeadbeef + (3 << 2);
+    a += key0;
+    b += key1;
+    c += key2;
+    final(a, b, c);
     return c;
 }
 
 int32_t dh1cf_get_uc_channel_index(uint16_t slot_number, uint8_t *mac, int16_t number_of_channels)
 {
-    int32_t channel_number;
-    uint32_t key[3];
-    key[0] = (uint32_t) slot_number;
-    key[1] = common_read_32_bit(&mac[4]);
-    key[2] = common_read_32_bit(&mac[0]);
-    channel_number = dh1cf_hashword(key, 3, 0) % number_of_channels;
-    return channel_number;
+    return dh1cf_hash3(slot_number, common_read_32_bit(&mac[4]), common_read_32_bit(&mac[0])) % number_of_channels;
+}
+
+void dh1cf_get_uc_channel_indexes(uint16_t slot_number, uint8_t *mac, int16_t number_of_channels, uint8_t *channels, uint8_t count)
+{
+    uint32_t key1 = common_read_32_bit(&mac[4]);
+    uint32_t key2 = common_read_32_bit(&mac[0]);
+    for (uint8_t i = 0; i < count; i++) {
+        channels[i] = dh1cf_hash3((uint16_t)(slot_number + i), key1, key2) % number_of_channels;
+    }
 }
 
 int32_t dh1cf_get_bc_channel_index(uint16_t slot_number, uint16_t bsi, int16_t number_of_channels)
 {
-    int32_t channel_number;
-    uint32_t key[3];
-    key[0] = (uint32_t) slot_number;
-    key[1] = (uint32_t) bsi << 16;
-    key[2] = 0;
-    channel_number = dh1cf_hashword(key, 3, 0) % number_of_channels;
-    return channel_number;
+    return dh1cf_hash3(slot_number, (uint32_t) bsi << 16, 0) % number_of_channels;
 }
 
 int tr51_init_channel_table(int16_t *channel_table, int16_t number_of_channels)
@@ -218,6 +197,23 @@ int32_t tr51_get_uc_channel_index(int16_t *channel_table, uint8_t *output_table,
     return output_table[slot_number];
 }
 
+uint8_t tr51_get_uc_channel_indexes(int16_t *channel_table, uint8_t *output_table, uint16_t slot_number, uint8_t *mac, int16_t number_of_channels, uint32_t *excluded_channels, uint8_t *channels, uint8_t count)
+{
+    if (number_of_channels <= 0) {
+        return 0;
+    }
+    uint16_t nearest_prime = tr51_calc_nearest_prime_number(number_of_channels);
+    uint8_t first_element;
+    uint8_t step_size;
+    tr51_compute_cfd(mac, &first_element, &step_size, nearest_prime);
+    tr51_calculate_hopping_sequence(channel_table, nearest_prime, first_element, step_size, output_table, excluded_channels);
+    // Indexed as tr51_get_uc_channel_index does, slot by slot
+    for (uint8_t i = 0; i < count; i++) {
+        channels[i] = output_table[(slot_number + i) % number_of_channels];
+    }
+    return count;
+}
+
 int32_t tr51_get_bc_channel_index(int16_t *channel_table, uint8_t *output_table, uint16_t slot_number, uint16_t bsi, int16_t number_of_channels, uint32_t *excluded_channels)
 {
     uint16_t nearest_prime = tr51_calc_nearest_prime_number(number_of_channels);
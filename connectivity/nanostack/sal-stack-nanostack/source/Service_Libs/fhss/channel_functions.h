@@ -44,6 +44,20 @@ int tr51_init_channel_table(int16_t *channel_table, int16_t number_of_channels);
  */
 int32_t tr51_get_uc_channel_index(int16_t *channel_table, uint8_t *output_table, uint16_t slot_number, uint8_t *mac, int16_t number_of_channels, uint32_t *excluded_channels);
 
+/**
+ * @brief Compute the unicast schedule channel indexes of consecutive slots using tr51 channel function.
+ * @param channel_table Channel table.
+ * @param output_table Table used to generate output channel.
+ * @param slot_number First slot number.
+ * @param mac MAC address of the node for which the indexes are calculated.
+ * @param number_of_channels Number of channels.
+ * @param excluded_channels Excluded channels.
+ * @param channels Output, channel indexes of slot_number and the following slots, wrapping after number_of_channels slots.
+ * @param count Number of channel indexes to compute.
+ * @return Number of channel indexes computed, 0 if there are no channels.
+ */
+uint8_t tr51_get_uc_channel_indexes(int16_t *channel_table, uint8_t *output_table, uint16_t slot_number, uint8_t *mac, int16_t number_of_channels, uint32_t *excluded_channels, uint8_t *channels, uint8_t count);
+
 /**
  * @brief Compute the broadcast schedule channel index using tr51 channel function.
  * @param channel_table Channel table.
@@ -65,6 +79,16 @@ int32_t tr51_get_bc_channel_index(int16_t *channel_table, uint8_t *output_table,
  */
 int32_t dh1cf_get_uc_channel_index(uint16_t slot_number, uint8_t *mac, int16_t number_of_channels);
 
+/**
+ * @brief Compute the unicast schedule channel indexes of consecutive slots using direct hash channel function.
+ * @param slot_number First slot number.
+ * @param mac MAC address of the node for which the indexes are calculated.
+ * @param number_of_channels Number of channels, at most 256.
+ * @param channels Output, channel indexes of slot_number and the following slots.
+ * @param count Number of channel indexes to compute.
+ */
+void dh1cf_get_uc_channel_indexes(uint16_t slot_number, uint8_t *mac, int16_t number_of_channels, uint8_t *channels, uint8_t count);
+
 /**
  * @brief Compute the broadcast schedule channel index using direct hash channel function.
  * @param slot_number Current slot number.
@@ -278,17 +278,31 @@ static uint8_t calc_own_tx_trig_slot(uint8_t own_hop)
     return (own_hop & 1);
 }
 
+static uint8_t fhss_count_bits(uint32_t bits)
+{
+    bits = bits - ((bits >> 1) & 0x55555555);
+    bits = (bits & 0x33333333) + ((bits >> 2) & 0x33333333);
+    return (((bits + (bits >> 4)) & 0x0f0f0f0f) * 0x01010101) >> 24;
+}
+
 static int32_t fhss_channel_index_from_mask(const uint32_t *channel_mask, int32_t channel_index, uint16_t number_of_channels)
 {
     //Function will return real active channel index at list
-    int32_t active_channels = 0;
-    // Set channel maks outside excluded channels
-    for (int32_t i = 0; i < number_of_channels; i++) {
-        if (channel_mask[0 + (i / 32)] & (1 << (i % 32))) {
-            if (channel_index == active_channels) {
+    // Skip the mask words before the one holding the channel
+    for (int32_t word = 0; word * 32 < number_of_channels; word++) {
+        uint32_t bits = channel_mask[word];
+        if (number_of_channels - word * 32 < 32) {
+            bits &= ((uint32_t)1 << (number_of_channels - word * 32)) - 1;
+        }
+        uint8_t active_channels = fhss_count_bits(bits);
+        if (channel_index >= active_channels) {
+            channel_index -= active_channels;
+            continue;
+        }
+        for (int32_t i = word * 32; bits; i++, bits >>= 1) {
+            if ((bits & 1) && channel_index-- == 0) {
                 return i;
             }
-            active_channels++;
         }
     }
     return 0;
@@ -514,6 +528,46 @@ static uint16_t fhss_ws_calculate_destination_slot(fhss_ws_neighbor_timing_info_
     return (own_floor(((float)(US_TO_MS(tx_time - ufsi_timestamp) + dest_ms_since_seq_start) / dwell_time)) % seq_length);
 }
 
+// Channel function output of a neighbour unicast slot. Computed with the following slots into
+// the neighbour hop cache, unless the cache already holds the slot for the current schedule
+static int32_t fhss_ws_get_neighbor_uc_channel_index(fhss_structure_t *fhss_structure, fhss_ws_neighbor_timing_info_t *neighbor_timing_info, uint16_t destination_slot, uint8_t *destination_address)
+{
+    fhss_ws_hop_cache_t *hop_cache = &neighbor_timing_info->uc_hop_cache;
+    uint8_t channel_function = neighbor_timing_info->uc_timing_info.unicast_channel_function;
+    uint16_t number_of_channels = neighbor_timing_info->uc_channel_list.channel_count;
+    uint32_t seq_length = 0x10000;
+    if (channel_function == WS_TR51CF) {
+        number_of_channels = neighbor_timing_info->uc_timing_info.unicast_number_of_channels;
+        seq_length = number_of_channels;
+    }
+
+    uint32_t offset = (destination_slot + seq_length - hop_cache->start_slot) % seq_length;
+    if (hop_cache->count && offset < hop_cache->count &&
+            hop_cache->channel_function == channel_function && hop_cache->number_of_channels == number_of_channels) {
+        return hop_cache->channel_index[offset];
+    }
+
+    // Channel function outputs of more than 256 channels don't fit the cache
+    if (number_of_channels > 256) {
+        hop_cache->count = 0;
+        if (channel_function == WS_TR51CF) {
+            return tr51_get_uc_channel_index(fhss_structure->ws->tr51_channel_table, fhss_structure->ws->tr51_output_table, destination_slot, destination_address, number_of_channels, NULL);
+        }
+        return dh1cf_get_uc_channel_index(destination_slot, destination_address, number_of_channels);
+    }
+
+    if (channel_function == WS_TR51CF) {
+        hop_cache->count = tr51_get_uc_channel_indexes(fhss_structure->ws->tr51_channel_table, fhss_structure->ws->tr51_output_table, destination_slot, destination_address, number_of_channels, NULL, hop_cache->channel_index, FHSS_WS_HOP_CACHE_SIZE);
+    } else {
+        dh1cf_get_uc_channel_indexes(destination_slot, destination_address, number_of_channels, hop_cache->channel_index, FHSS_WS_HOP_CACHE_SIZE);
+        hop_cache->count = FHSS_WS_HOP_CACHE_SIZE;
+    }
+    hop_cache->start_slot = destination_slot;
+    hop_cache->channel_function = channel_function;
+    hop_cache->number_of_channels = number_of_channels;
+    return hop_cache->count ? hop_cache->channel_index[0] : 0;
+}
+
 static uint32_t fhss_ws_get_sf_timeout_callback(fhss_structure_t *fhss_structure)
 {
     return MS_TO_US(fhss_structure->ws->fhss_configuration.fhss_uc_dwell_interval);
@@ -634,11 +688,9 @@ static int fhss_ws_tx_handle_callback(const fhss_api_t *api, bool is_broadcast_a
 
         uint16_t destination_slot = fhss_ws_calculate_destination_slot(neighbor_timing_info, tx_time);
         int32_t tx_channel = neighbor_timing_info->uc_timing_info.fixed_channel;
-        if (neighbor_timing_info->uc_timing_info.unicast_channel_function == WS_TR51CF) {
-            tx_channel = tr51_get_uc_channel_index(fhss_structure->ws->tr51_channel_table, fhss_structure->ws->tr51_output_table, destination_slot, destination_address, neighbor_timing_info->uc_timing_info.unicast_number_of_channels, NULL);
-            tx_channel = fhss_channel_index_from_mask(neighbor_timing_info->uc_channel_list.channel_mask, tx_channel, fhss_structure->number_of_channels);
-        } else if (neighbor_timing_info->uc_timing_info.unicast_channel_function == WS_DH1CF) {
-            tx_channel = dh1cf_get_uc_channel_index(destination_slot, destination_address, neighbor_timing_info->uc_channel_list.channel_count);
+        if (neighbor_timing_info->uc_timing_info.unicast_channel_function == WS_TR51CF ||
+                neighbor_timing_info->uc_timing_info.unicast_channel_function == WS_DH1CF) {
+            tx_channel = fhss_ws_get_neighbor_uc_channel_index(fhss_structure, neighbor_timing_info, destination_slot, destination_address);
             tx_channel = fhss_channel_index_from_mask(neighbor_timing_info->uc_channel_list.channel_mask, tx_channel, fhss_structure->number_of_channels);
         } else if (neighbor_timing_info->uc_timing_info.unicast_channel_function == WS_VENDOR_DEF_CF) {
             if (fhss_structure->ws->fhss_configuration.vendor_defined_cf) {
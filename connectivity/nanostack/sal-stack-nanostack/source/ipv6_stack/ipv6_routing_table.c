@@ -93,6 +93,10 @@ static neighbour_cache_config_t neighbour_cache_config = {NCACHE_MAX_ABSOLUTE, N
 static NS_LIST_DEFINE(ipv6_destination_cache, ipv6_destination_t, link);
 static NS_LIST_DEFINE(ipv6_routing_table, ipv6_route_t, link);
 
+/* Destination Cache entries also chained by address, for lookup */
+static ipv6_destination_t *ipv6_destination_hash[IPV6_DESTINATION_HASH_SIZE];
+static uint_fast16_t ipv6_destination_cache_count;
+
 static ipv6_destination_t *ipv6_destination_lookup(const uint8_t *address, int8_t interface_id);
 static void ipv6_destination_cache_forget_router(ipv6_neighbour_cache_t *cache, const uint8_t neighbour_addr[16]);
 static void ipv6_destination_cache_forget_neighbour(const ipv6_neighbour_t *neighbour);
@@ -105,6 +109,32 @@ static uint8_t ipv6_route_table_get_max_entries(int8_t interface_id, ipv6_route_
 
 static uint16_t dcache_gc_timer;
 
+/* Interface identifiers differ most between neighbours and destinations on a mesh */
+static uint_fast8_t ipv6_address_hash(const uint8_t address[static 16])
+{
+    return address[11] ^ address[13] ^ address[14] ^ address[15];
+}
+
+static void ipv6_neighbour_hash_add(ipv6_neighbour_cache_t *cache, ipv6_neighbour_t *entry)
+{
+    ipv6_neighbour_t **bucket = &cache->hash[ipv6_address_hash(entry->ip_address) & (IPV6_NEIGHBOUR_HASH_SIZE - 1)];
+
+    entry->hash_next = *bucket;
+    *bucket = entry;
+}
+
+static void ipv6_neighbour_hash_remove(ipv6_neighbour_cache_t *cache, ipv6_neighbour_t *entry)
+{
+    ipv6_neighbour_t **prev = &cache->hash[ipv6_address_hash(entry->ip_address) & (IPV6_NEIGHBOUR_HASH_SIZE - 1)];
+
+    for (; *prev; prev = &(*prev)->hash_next) {
+        if (*prev == entry) {
+            *prev = entry->hash_next;
+            break;
+        }
+    }
+}
+
 static uint32_t next_probe_time(ipv6_neighbour_cache_t *cache, uint_fast8_t retrans_num)
 {
     uint32_t t = cache->retrans_timer;
@@ -247,7 +277,9 @@ void ipv6_neighbour_cache_flush(ipv6_neighbour_cache_t *cache)
 
 ipv6_neighbour_t *ipv6_neighbour_lookup(ipv6_neighbour_cache_t *cache, const uint8_t *address)
 {
-    ns_list_foreach(ipv6_neighbour_t, cur, &cache->list) {
+    ipv6_neighbour_t *cur = cache->hash[ipv6_address_hash(address) & (IPV6_NEIGHBOUR_HASH_SIZE - 1)];
+
+    for (; cur; cur = cur->hash_next) {
         if (addr_ipv6_equal(cur->ip_address, address)) {
             return cur;
         }
@@ -274,6 +306,7 @@ void ipv6_neighbour_entry_remove(ipv6_neighbour_cache_t *cache, ipv6_neighbour_t
      * the entry.
      */
     ns_list_remove(&cache->list, entry);
+    ipv6_neighbour_hash_remove(cache, entry);
     switch (entry->state) {
         case IP_NEIGHBOUR_NEW:
             break;
@@ -302,23 +335,22 @@ void ipv6_neighbour_entry_remove(ipv6_neighbour_cache_t *cache, ipv6_neighbour_t
 ipv6_neighbour_t *ipv6_neighbour_lookup_or_create(ipv6_neighbour_cache_t *cache, const uint8_t *address/*, bool tentative*/)
 {
     uint_fast16_t count = 0;
-    ipv6_neighbour_t *entry = NULL;
+    ipv6_neighbour_t *entry = ipv6_neighbour_lookup(cache, address);
     ipv6_neighbour_t *garbage_possible_entry = NULL;
 
-    ns_list_foreach(ipv6_neighbour_t, cur, &cache->list) {
+    if (entry) {
+        if (entry != ns_list_get_first(&cache->list)) {
+            ns_list_remove(&cache->list, entry);
+            ns_list_add_to_start(&cache->list, entry);
+        }
+        return entry;
+    }
 
+    ns_list_foreach(ipv6_neighbour_t, cur, &cache->list) {
         if (cur->type == IP_NEIGHBOUR_GARBAGE_COLLECTIBLE) {
             garbage_possible_entry = cur;
             count++;
         }
-
-        if (addr_ipv6_equal(cur->ip_address, address)) {
-            if (cur != ns_list_get_first(&cache->list)) {
-                ns_list_remove(&cache->list, cur);
-                ns_list_add_to_start(&cache->list, cur);
-            }
-            return cur;
-        }
     }
 
     if (count >= neighbour_cache_config.max_entries && garbage_possible_entry) {
@@ -354,6 +386,7 @@ ipv6_neighbour_t *ipv6_neighbour_lookup_or_create(ipv6_neighbour_cache_t *cache,
     }
 
     ns_list_add_to_start(&cache->list, entry);
+    ipv6_neighbour_hash_add(cache, entry);
 
     return entry;
 }
@@ -875,6 +908,31 @@ void ipv6_destination_cache_print(route_print_fn_t *print_fn)
     }
 }
 
+static void ipv6_destination_link(ipv6_destination_t *entry)
+{
+    ipv6_destination_t **bucket = &ipv6_destination_hash[ipv6_address_hash(entry->destination) & (IPV6_DESTINATION_HASH_SIZE - 1)];
+
+    ns_list_add_to_start(&ipv6_destination_cache, entry);
+    entry->hash_next = *bucket;
+    *bucket = entry;
+    ipv6_destination_cache_count++;
+}
+
+/* Take an entry out of the cache - caller then releases its reference */
+static void ipv6_destination_unlink(ipv6_destination_t *entry)
+{
+    ipv6_destination_t **prev = &ipv6_destination_hash[ipv6_address_hash(entry->destination) & (IPV6_DESTINATION_HASH_SIZE - 1)];
+
+    ns_list_remove(&ipv6_destination_cache, entry);
+    for (; *prev; prev = &(*prev)->hash_next) {
+        if (*prev == entry) {
+            *prev = entry->hash_next;
+            break;
+        }
+    }
+    ipv6_destination_cache_count--;
+}
+
 static ipv6_destination_t *ipv6_destination_lookup(const uint8_t *address, int8_t interface_id)
 {
     bool is_ll = addr_is_ipv6_link_local(address);
@@ -883,7 +941,7 @@ static ipv6_destination_t *ipv6_destination_lookup(const uint8_t *address, int8_
         return NULL;
     }
 
-    ns_list_foreach(ipv6_destination_t, cur, &ipv6_destination_cache) {
+    for (ipv6_destination_t *cur = ipv6_destination_hash[ipv6_address_hash(address) & (IPV6_DESTINATION_HASH_SIZE - 1)]; cur; cur = cur->hash_next) {
         if (!addr_ipv6_equal(cur->destination, address)) {
             continue;
         }
@@ -912,7 +970,6 @@ static ipv6_destination_t *ipv6_destination_lookup(const uint8_t *address, int8_
  */
 ipv6_destination_t *ipv6_destination_lookup_or_create(const uint8_t *address, int8_t interface_id)
 {
-    uint_fast16_t count = 0;
     ipv6_destination_t *entry = NULL;
     bool interface_specific = addr_ipv6_scope(address, NULL) <= IPV6_SCOPE_REALM_LOCAL;
 
@@ -921,8 +978,7 @@ ipv6_destination_t *ipv6_destination_lookup_or_create(const uint8_t *address, in
     }
 
     /* Find any existing entry */
-    ns_list_foreach(ipv6_destination_t, cur, &ipv6_destination_cache) {
-        count++;
+    for (ipv6_destination_t *cur = ipv6_destination_hash[ipv6_address_hash(address) & (IPV6_DESTINATION_HASH_SIZE - 1)]; cur; cur = cur->hash_next) {
         if (!addr_ipv6_equal(cur->destination, address)) {
             continue;
         }
@@ -937,9 +993,9 @@ ipv6_destination_t *ipv6_destination_lookup_or_create(const uint8_t *address, in
 
 
     if (!entry) {
-        if (count > destination_cache_config.max_entries) {
+        if (ipv6_destination_cache_count > destination_cache_config.max_entries) {
             entry = ns_list_get_last(&ipv6_destination_cache);
-            ns_list_remove(&ipv6_destination_cache, entry);
+            ipv6_destination_unlink(entry);
             ipv6_destination_release(entry);
         }
 
@@ -966,7 +1022,7 @@ ipv6_destination_t *ipv6_destination_lookup_or_create(const uint8_t *address, in
         } else {
             entry->interface_id = -1;
         }
-        ns_list_add_to_start(&ipv6_destination_cache, entry);
+        ipv6_destination_link(entry);
     } else if (entry != ns_list_get_first(&ipv6_destination_cache)) {
         /* If there was an entry, and it wasn't at the start, move it */
         ns_list_remove(&ipv6_destination_cache, entry);
@@ -1074,7 +1130,7 @@ void ipv6_destination_redirect(const uint8_t *dest_addr, const uint8_t *sender_a
 
 void ipv6_destination_cache_forced_gc(bool full_gc)
 {
-    int gc_count = ns_list_count(&ipv6_destination_cache);
+    int gc_count = ipv6_destination_cache_count;
 
     /* Minimize size of destination cache:
      * - keep absolutely minimum number of entries if not full gc
@@ -1082,7 +1138,7 @@ void ipv6_destination_cache_forced_gc(bool full_gc)
      **/
     ns_list_foreach_reverse_safe(ipv6_destination_t, entry, &ipv6_destination_cache) {
         if (entry->lifetime == 0 || gc_count > destination_cache_config.long_term_entries || full_gc) {
-            ns_list_remove(&ipv6_destination_cache, entry);
+            ipv6_destination_unlink(entry);
             ipv6_destination_release(entry);
             gc_count--;
         }
@@ -1137,7 +1193,7 @@ static void ipv6_destination_cache_gc_periodic(void)
      */
     ns_list_foreach_reverse_safe(ipv6_destination_t, entry, &ipv6_destination_cache) {
         if (entry->lifetime == 0 || gc_count > destination_cache_config.short_term_entries) {
-            ns_list_remove(&ipv6_destination_cache, entry);
+            ipv6_destination_unlink(entry);
             ipv6_destination_release(entry);
             if (--gc_count <= destination_cache_config.long_term_entries) {
                 break;
@@ -1376,6 +1432,11 @@ static ipv6_route_t *ipv6_route_find_best(const uint8_t *addr, int8_t interface_
             continue;
         }
 
+        /* Cannot beat a longer prefix match, so don't bother comparing it */
+        if (best && route->prefix_len < best->prefix_len) {
+            continue;
+        }
+
         /* Prefix must match */
         if (!bitsequal(addr, route->prefix, route->prefix_len)) {
             continue;
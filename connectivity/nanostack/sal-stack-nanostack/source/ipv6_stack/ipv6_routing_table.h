@@ -41,6 +41,17 @@
 
 #define IPV6_ROUTE_DEFAULT_METRIC           128
 
+/* Buckets of the per-interface Neighbour Cache and the Destination Cache
+ * lookup hashes - must be powers of 2.
+ */
+#ifndef IPV6_NEIGHBOUR_HASH_SIZE
+#define IPV6_NEIGHBOUR_HASH_SIZE            8
+#endif
+
+#ifndef IPV6_DESTINATION_HASH_SIZE
+#define IPV6_DESTINATION_HASH_SIZE          16
+#endif
+
 /* XXX in the process of renaming this - it's really specifically the
  * IP Neighbour Cache  but was initially called a routing table */
 
@@ -101,6 +112,7 @@ typedef struct ipv6_neighbour {
     uint32_t                        timer;                      /* 100ms ticks */
     uint32_t                        lifetime;                   /* seconds */
     ns_list_link_t                  link;                       /*!< List link */
+    struct ipv6_neighbour           *hash_next;                 /*!< Next entry in hash bucket */
     NS_LIST_HEAD_INCOMPLETE(struct buffer) queue;
     uint8_t                         ll_address[];
 } ipv6_neighbour_t;
@@ -135,6 +147,7 @@ typedef struct ipv6_neighbour_cache {
     ipv6_route_interface_info_t             route_if_info;
     //uint8_t                                   num_entries;
     NS_LIST_HEAD(ipv6_neighbour_t, link)    list;
+    ipv6_neighbour_t                        *hash[IPV6_NEIGHBOUR_HASH_SIZE];    // lookup by IP address, NULL-terminated chains
 } ipv6_neighbour_cache_t;
 
 /* Macros for formatting ipv6 addresses into strings for route printing. */
@@ -207,6 +220,7 @@ typedef struct ipv6_destination {
 #endif
     ipv6_neighbour_t                *last_neighbour;    // last neighbour used (only for reachability confirmation)
     ns_list_link_t                  link;
+    struct ipv6_destination         *hash_next;         // next entry in hash bucket
 } ipv6_destination_t;
 
 #ifndef NO_IPV6_PMTUD
@@ -1379,6 +1379,7 @@ int8_t net_init_core(void)
 {
     /* Reset Protocol_stats */
     protocol_stats_init();
+    buffer_pool_init();
     protocol_core_init();
 #ifdef HAVE_RPL
     rpl_data_init();
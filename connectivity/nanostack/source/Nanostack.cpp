@@ -871,6 +871,43 @@ out:
     return ret;
 }
 
+nsapi_size_or_error_t Nanostack::socket_recvfrom_batch(void *handle, mbed::Span<nsapi_datagram_t> datagrams)
+{
+    // Validate parameters
+    NanostackSocket *socket = static_cast<NanostackSocket *>(handle);
+    if (handle == NULL) {
+        MBED_ASSERT(false);
+        return NSAPI_ERROR_NO_SOCKET;
+    }
+
+    nsapi_size_or_error_t ret = 0;
+
+    NanostackLockGuard lock;
+
+    if (socket->closed()) {
+        return NSAPI_ERROR_NO_CONNECTION;
+    }
+
+    for (nsapi_datagram_t &d : datagrams) {
+        ns_address_t ns_address;
+        int retcode = ::socket_recvfrom(socket->socket_id, d.data, d.size, 0, &ns_address);
+
+        if (retcode < 0) {
+            if (ret == 0) {
+                ret = retcode == NS_EWOULDBLOCK ? NSAPI_ERROR_WOULD_BLOCK : NSAPI_ERROR_PARAMETER;
+            }
+            break;
+        }
+        d.len = retcode;
+        convert_ns_addr_to_mbed(&d.address, &ns_address);
+        ret++;
+    }
+
+    tr_debug("socket_recvfrom_batch(socket=%p) sock_id=%d, ret=%i", socket, socket->socket_id, ret);
+
+    return ret;
+}
+
 nsapi_error_t Nanostack::socket_bind(void *handle, const SocketAddress &address)
 {
     // Validate parameters
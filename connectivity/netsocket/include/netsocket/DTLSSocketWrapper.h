@@ -40,6 +40,65 @@ public:
      * @param control      Transport control mode. See @ref control_transport.
      */
     DTLSSocketWrapper(Socket *transport, const char *hostname = NULL, control_transport control = TRANSPORT_CONNECT_AND_CLOSE);
+
+#if defined(MBEDTLS_SSL_PROTO_DTLS) || defined(DOXYGEN_ONLY)
+    /** Set the largest datagram DTLS sends.
+     *
+     *  Handshake messages larger than this, such as certificate chains, are
+     *  fragmented by DTLS instead of by IP. This matters on links with a
+     *  small MTU, where a lost IP fragment loses the whole flight.
+     *
+     *  @param mtu  Maximum UDP payload in bytes, or 0 for no limit.
+     */
+    void set_mtu(uint16_t mtu);
+
+    /** Set the handshake retransmission timeouts.
+     *
+     *  A flight is first retransmitted after min, and the timeout doubles on
+     *  each retransmission until it exceeds max, when the handshake fails.
+     *  The Mbed TLS defaults of 1 and 60 seconds retransmit needlessly on
+     *  high latency links such as NB-IoT.
+     *
+     *  @param min  Initial retransmission timeout.
+     *  @param max  Maximum retransmission timeout.
+     */
+    void set_handshake_timeout(std::chrono::milliseconds min, std::chrono::milliseconds max);
+#endif
+
+#if defined(MBEDTLS_SSL_DTLS_CONNECTION_ID) || defined(DOXYGEN_ONLY)
+    /** Negotiate a connection ID in the next handshake.
+     *
+     *  With a connection ID the server identifies the connection by the ID
+     *  in each record instead of by the client address, so the connection
+     *  survives NAT rebinding without a new handshake. The client's own ID
+     *  is empty: only the server is asked for one.
+     *
+     *  @note Must be called before connect(). Mbed TLS implements the
+     *  connection ID draft which preceded RFC 9146, so the server must
+     *  support the draft extension.
+     *
+     *  @param enabled  True to offer connection IDs.
+     *  @retval         NSAPI_ERROR_OK on success.
+     *  @retval         NSAPI_ERROR_PARAMETER if the SSL configuration rejects connection IDs.
+     */
+    nsapi_error_t set_connection_id(bool enabled);
+
+    /** Check whether the established connection uses a connection ID.
+     *
+     *  @return True if the server agreed to use a connection ID.
+     */
+    bool is_connection_id_used();
+#endif
+
+    /* Session resumption is inherited from TLSSocketWrapper, see
+     * get_session() and set_session(). Resuming a DTLS session saves the
+     * certificate exchange when the connection ID cannot be used. */
+
+protected:
+#ifndef DOXYGEN_ONLY
+    int configure_ssl_context() override;
+#endif
+
 private:
     static void timing_set_delay(void *ctx, uint32_t int_ms, uint32_t fin_ms);
     static int timing_get_delay(void *ctx);
@@ -47,6 +106,7 @@ private:
     rtos::Kernel::Clock::time_point _int_time;
     int _timer_event_id = 0;
     bool _timer_expired = false;
+    bool _cid_enabled = false;
 };
 
 #endif
@@ -73,6 +73,38 @@ public:
      */
     virtual uint32_t get_align_preference() const = 0;
 
+    /** Checksum offload capabilities, see get_checksum_offload()
+     *
+     * TX flags mean the hardware fills in the checksum of outgoing packets.
+     * RX flags mean the hardware verifies incoming packets and drops those
+     * with a bad checksum.
+     */
+    enum checksum_offload_t {
+        CHECKSUM_OFFLOAD_TX_IP      = 0x0001,
+        CHECKSUM_OFFLOAD_TX_UDP     = 0x0002,
+        CHECKSUM_OFFLOAD_TX_TCP     = 0x0004,
+        CHECKSUM_OFFLOAD_TX_ICMP    = 0x0008,
+        CHECKSUM_OFFLOAD_TX_ICMP6   = 0x0010,
+        CHECKSUM_OFFLOAD_RX_IP      = 0x0100,
+        CHECKSUM_OFFLOAD_RX_UDP     = 0x0200,
+        CHECKSUM_OFFLOAD_RX_TCP     = 0x0400,
+        CHECKSUM_OFFLOAD_RX_ICMP    = 0x0800,
+        CHECKSUM_OFFLOAD_RX_ICMP6   = 0x1000,
+    };
+
+    /**
+     * Gets checksum offload capabilities
+     *
+     * The stack skips computing or verifying the checksums the EMAC device
+     * handles in hardware. Queried once, when the interface is brought up.
+     *
+     * @return         Bitmask of checksum_offload_t flags, 0 if none
+     */
+    virtual uint32_t get_checksum_offload() const
+    {
+        return 0;
+    }
+
     /**
      * Return interface name
      *
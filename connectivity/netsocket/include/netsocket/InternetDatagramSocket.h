@@ -74,6 +74,29 @@ public:
     nsapi_size_or_error_t recvfrom(SocketAddress *address,
                                    void *data, nsapi_size_t size) override;
 
+    /** Receive several datagrams at once.
+     *
+     *  Blocks like recvfrom() until at least one datagram is received, then
+     *  also takes the datagrams already queued, up to the number given,
+     *  under a single lock. Each datagram gets its length and source
+     *  address set.
+     *
+     *  @note If a datagram is larger than its buffer, the excess data is silently discarded.
+     *
+     *  @note If socket is connected, only packets coming from connected peer address
+     *  are accepted. Rejected entries are swapped behind the accepted ones, so the
+     *  datagrams returned may not use the buffers in the order given.
+     *
+     *  @param datagrams  Datagrams to fill, each with its buffer and size set.
+     *  @retval           int Number of datagrams received on success.
+     *  @retval           NSAPI_ERROR_NO_SOCKET in case socket was not created correctly.
+     *  @retval           NSAPI_ERROR_WOULD_BLOCK in case non-blocking mode is enabled
+     *                    and no datagram is queued.
+     *  @retval           int Other negative error codes for stack-related failures.
+     *                    See \ref NetworkStack::socket_recvfrom_batch.
+     */
+    nsapi_size_or_error_t recvfrom_batch(mbed::Span<nsapi_datagram_t> datagrams);
+
     /** Set the remote address for next send() call and filtering
      *  of incoming packets. To reset the address, zero initialized
      *  SocketAddress must be in the address parameter.
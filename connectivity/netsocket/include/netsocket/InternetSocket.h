@@ -154,6 +154,49 @@ public:
      */
     nsapi_error_t getpeername(SocketAddress *address) override;
 
+    /** Send a datagram gathered from several buffers.
+     *
+     *  The buffers are passed to the network stack, which sends them as
+     *  one datagram to address, or to the connected peer if address is NULL.
+     *
+     *  By default, sendmsg blocks until data is sent. If socket is set to
+     *  non-blocking or times out, NSAPI_ERROR_WOULD_BLOCK is returned
+     *  immediately.
+     *
+     *  @param address  Remote address, or NULL to send to the connected peer
+     *  @param iov      Buffers of data to send to the host
+     *  @retval         int Number of sent bytes on success.
+     *  @retval         NSAPI_ERROR_NO_SOCKET in case socket was not created correctly.
+     *  @retval         NSAPI_ERROR_NO_ADDRESS if address is NULL and no peer is connected.
+     *  @retval         NSAPI_ERROR_WOULD_BLOCK in case non-blocking mode is enabled
+     *                  and send cannot be performed immediately.
+     *  @retval         int Other negative error codes for stack-related failures.
+     *                  See @ref NetworkStack::socket_sendmsg.
+     */
+    nsapi_size_or_error_t sendmsg(const SocketAddress *address,
+                                  mbed::Span<const nsapi_iovec_t> iov) override;
+
+    /** Receive a datagram scattered into several buffers.
+     *
+     *  If the socket is connected, only datagrams coming from the connected
+     *  peer are accepted.
+     *
+     *  By default, recvmsg blocks until a datagram is received. If socket
+     *  is set to non-blocking or times out with no data,
+     *  NSAPI_ERROR_WOULD_BLOCK is returned.
+     *
+     *  @param address  Destination for the source address or NULL
+     *  @param iov      Destination buffers for the datagram
+     *  @retval         int Number of received bytes on success.
+     *  @retval         NSAPI_ERROR_NO_SOCKET in case socket was not created correctly.
+     *  @retval         NSAPI_ERROR_WOULD_BLOCK in case non-blocking mode is enabled
+     *                  and recv cannot be performed immediately.
+     *  @retval         int Other negative error codes for stack-related failures.
+     *                  See @ref NetworkStack::socket_recvmsg.
+     */
+    nsapi_size_or_error_t recvmsg(SocketAddress *address,
+                                  mbed::Span<const nsapi_iovec_t> iov) override;
+
 
 #if !defined(DOXYGEN_ONLY)
 
@@ -162,6 +205,10 @@ protected:
     virtual nsapi_protocol_t get_proto() = 0;
     void event();
     int modify_multicast_group(const SocketAddress &address, nsapi_socket_option_t socketopt);
+    /* Waits up to the socket timeout for READ_FLAG or WRITE_FLAG, counting the time
+     * blocked in the socket statistics. Called without _lock held.
+     */
+    uint32_t wait_for_event(uint32_t flag);
     char _interface_name[NSAPI_INTERFACE_NAME_MAX_SIZE];
     NetworkStack *_stack = nullptr;
     nsapi_socket_t _socket = nullptr;
@@ -24,9 +24,11 @@
 #ifndef NETWORK_INTERFACE_H
 #define NETWORK_INTERFACE_H
 
+#include <chrono>
 #include "netsocket/nsapi_types.h"
 #include "netsocket/SocketAddress.h"
 #include "Callback.h"
+#include "platform/Span.h"
 #include "DNS.h"
 
 
@@ -38,6 +40,7 @@ class MeshInterface;
 class CellularInterface;
 class EMACInterface;
 class PPPInterface;
+class TCPSocket;
 
 /** Common interface that is shared between network devices.
  *
@@ -362,6 +365,33 @@ public:
      */
     virtual nsapi_error_t get_dns_server(int index, SocketAddress *address, const char *interface_name = NULL);
 
+    /** Connect to a host over whichever of IPv6 and IPv4 answers first.
+     *
+     *  Implements "Happy Eyeballs" (RFC 8305). Both address families are
+     *  resolved, and connection attempts alternate between them starting
+     *  with IPv6. A new attempt starts every @p attempt_delay, or as soon as
+     *  one fails, while earlier ones carry on. Each attempt uses a free
+     *  socket from @p sockets, so their number bounds how many attempts run
+     *  at once. A broken path then costs one attempt delay instead of a full
+     *  connect timeout.
+     *
+     *  The sockets must not be open. On success the winner is left connected
+     *  and in blocking mode, and the other sockets are closed. A TLS session
+     *  can then be run over the winner with TLSSocketWrapper.
+     *
+     *  @param hostname      Hostname or IP address literal to connect to.
+     *  @param port          Port to connect to.
+     *  @param sockets       Sockets to attempt connections with.
+     *  @param timeout       Time limit for resolving and connecting.
+     *  @param attempt_delay Time to wait for an attempt before starting the next.
+     *  @return              Index in @p sockets of the connected socket,
+     *                       NSAPI_ERROR_TIMEOUT if none connected in time,
+     *                       or the error of the last failed attempt or lookup.
+     */
+    nsapi_value_or_error_t happy_eyeballs_connect(const char *hostname, uint16_t port, mbed::Span<TCPSocket> sockets,
+                                                  std::chrono::milliseconds timeout = std::chrono::seconds(30),
+                                                  std::chrono::milliseconds attempt_delay = std::chrono::milliseconds(250));
+
     /** Register callback for status reporting.
      *
      *  The specified status callback function will be called on status changes
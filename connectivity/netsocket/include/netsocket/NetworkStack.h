@@ -23,6 +23,7 @@
 #include "nsapi_types.h"
 #include "netsocket/SocketAddress.h"
 #include "netsocket/NetworkInterface.h"
+#include "platform/Span.h"
 #include "DNS.h"
 
 /** @file NetworkStack.h NetworkStack class */
@@ -31,6 +32,19 @@
 
 // Predeclared classes
 class OnboardNetworkStack;
+class NetStackMemoryManager;
+typedef void net_stack_mem_buf_t;
+
+/** Datagram of a batch receive
+ *
+ *  @see NetworkStack::socket_recvfrom_batch
+ */
+typedef struct nsapi_datagram {
+    void *data;             /**< Destination buffer, set by the caller */
+    nsapi_size_t size;      /**< Size of the buffer in bytes, set by the caller */
+    nsapi_size_t len;       /**< Number of bytes received into the buffer */
+    SocketAddress address;  /**< Source address of the datagram */
+} nsapi_datagram_t;
 
 /** NetworkStack class
  *
@@ -395,6 +409,109 @@ protected:
     virtual nsapi_size_or_error_t socket_recvfrom(nsapi_socket_t handle, SocketAddress *address,
                                                   void *buffer, nsapi_size_t size) = 0;
 
+    /** Send data gathered from several buffers over a socket
+     *
+     *  For a TCP socket the buffers are sent in order as part of the
+     *  stream and address must be NULL. For a UDP socket they form a single
+     *  datagram sent to address.
+     *
+     *  The default implementation sends buffer by buffer over TCP, and
+     *  copies them into a temporary buffer for UDP.
+     *
+     *  This call is non-blocking. If sendmsg would block,
+     *  NSAPI_ERROR_WOULD_BLOCK is returned immediately.
+     *
+     *  @param handle   Socket handle
+     *  @param address  The SocketAddress of the remote host, or NULL for TCP
+     *  @param iov      Buffers of data to send to the host
+     *  @return         Number of sent bytes on success, negative error
+     *                  code on failure
+     */
+    virtual nsapi_size_or_error_t socket_sendmsg(nsapi_socket_t handle, const SocketAddress *address,
+                                                 mbed::Span<const nsapi_iovec_t> iov);
+
+    /** Receive data over a socket, scattered into several buffers
+     *
+     *  For a TCP socket address must be NULL. For a UDP socket a single
+     *  datagram is received and its source address stored in address.
+     *
+     *  The default implementation receives buffer by buffer over TCP, and
+     *  through a temporary buffer for UDP.
+     *
+     *  This call is non-blocking. If recvmsg would block,
+     *  NSAPI_ERROR_WOULD_BLOCK is returned immediately.
+     *
+     *  @param handle   Socket handle
+     *  @param address  Destination for the source address, or NULL for TCP
+     *  @param iov      Destination buffers for data received from the host
+     *  @return         Number of received bytes on success, negative error
+     *                  code on failure
+     */
+    virtual nsapi_size_or_error_t socket_recvmsg(nsapi_socket_t handle, SocketAddress *address,
+                                                 mbed::Span<const nsapi_iovec_t> iov);
+
+    /** Receive the datagrams queued on a UDP socket
+     *
+     *  Fills the datagrams in order until all are used or no more are
+     *  queued, setting their length and source address. Data beyond the
+     *  size of a buffer is discarded, as with socket_recvfrom().
+     *
+     *  The default implementation calls socket_recvfrom() for each one.
+     *
+     *  This call is non-blocking. If no datagram is queued,
+     *  NSAPI_ERROR_WOULD_BLOCK is returned immediately.
+     *
+     *  @param handle     Socket handle
+     *  @param datagrams  Datagrams to fill
+     *  @return           Number of datagrams received on success, negative
+     *                    error code on failure
+     */
+    virtual nsapi_size_or_error_t socket_recvfrom_batch(nsapi_socket_t handle,
+                                                        mbed::Span<nsapi_datagram_t> datagrams);
+
+    /** Get the memory manager of the stack's buffers
+     *
+     *  Buffers for socket_send_buf() are allocated from, and buffers returned
+     *  by socket_recv_buf() are accessed and freed through, this manager.
+     *
+     *  @return         Memory manager, or NULL if the stack does not support
+     *                  zero-copy sockets
+     */
+    virtual NetStackMemoryManager *get_memory_manager();
+
+    /** Send a chain of stack buffers over a TCP socket without copying
+     *
+     *  The stack keeps the buffers until the data is acknowledged by the
+     *  remote host, then frees them. The whole chain is queued or none of
+     *  it, NSAPI_ERROR_PARAMETER is returned for a chain which can never
+     *  fit in the send buffer.
+     *
+     *  This call is non-blocking. If send would block,
+     *  NSAPI_ERROR_WOULD_BLOCK is returned immediately.
+     *
+     *  @param handle   Socket handle
+     *  @param buf      Buffer chain allocated from get_memory_manager(),
+     *                  owned by the stack unless an error is returned
+     *  @return         Number of bytes queued on success, negative error
+     *                  code on failure
+     */
+    virtual nsapi_size_or_error_t socket_send_buf(nsapi_socket_t handle, net_stack_mem_buf_t *buf);
+
+    /** Receive data over a TCP socket as a chain of stack buffers
+     *
+     *  The buffers are handed over without copying, the caller must free
+     *  them with get_memory_manager()->free().
+     *
+     *  This call is non-blocking. If recv would block,
+     *  NSAPI_ERROR_WOULD_BLOCK is returned immediately.
+     *
+     *  @param handle   Socket handle
+     *  @param buf      Destination for the received buffer chain
+     *  @return         Number of received bytes on success, negative error
+     *                  code on failure
+     */
+    virtual nsapi_size_or_error_t socket_recv_buf(nsapi_socket_t handle, net_stack_mem_buf_t **buf);
+
     /** Register a callback on state change of the socket
      *
      *  The specified callback will be called on state changes such as when
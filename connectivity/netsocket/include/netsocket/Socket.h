@@ -24,6 +24,7 @@
 #define SOCKET_H
 
 #include "netsocket/SocketAddress.h"
+#include "platform/Span.h"
 #include "Callback.h"
 
 /** Socket interface.
@@ -157,6 +158,40 @@ public:
     virtual nsapi_size_or_error_t recvfrom(SocketAddress *address,
                                            void *data, nsapi_size_t size) = 0;
 
+    /** Send data gathered from several buffers.
+     *
+     *  Equivalent to send() or sendto() of the buffers concatenated. For a
+     *  connectionless socket the buffers form a single message, so a
+     *  protocol header and payload can be sent without first copying them
+     *  together.
+     *
+     *  The default implementation copies the buffers into a temporary one.
+     *  Sockets of an IP network stack pass them down to the stack.
+     *
+     *  @param address  Remote address, or NULL to send to the connected peer
+     *  @param iov      Buffers of data to send to the host
+     *  @return         Number of sent bytes on success, negative subclass-dependent error
+     *                  code on failure
+     */
+    virtual nsapi_size_or_error_t sendmsg(const SocketAddress *address,
+                                          mbed::Span<const nsapi_iovec_t> iov);
+
+    /** Receive data scattered into several buffers.
+     *
+     *  Equivalent to recv() or recvfrom() into the buffers concatenated,
+     *  which are filled in order.
+     *
+     *  The default implementation receives into a temporary buffer.
+     *  Sockets of an IP network stack pass the buffers down to the stack.
+     *
+     *  @param address  Destination for the source address or NULL
+     *  @param iov      Destination buffers for data received from the host
+     *  @return         Number of received bytes on success, negative subclass-dependent
+     *                  error code on failure
+     */
+    virtual nsapi_size_or_error_t recvmsg(SocketAddress *address,
+                                          mbed::Span<const nsapi_iovec_t> iov);
+
     /** Bind a specific address to a socket.
      *
      *  Binding a socket specifies the address and port on which to receive
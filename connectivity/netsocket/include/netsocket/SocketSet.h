@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/** @file SocketSet.h Wait for events on several sockets */
+/** @addtogroup netsocket
+ * @{
+ */
+
+#ifndef SOCKET_SET_H
+#define SOCKET_SET_H
+
+#include "netsocket/Socket.h"
+#include "platform/NonCopyable.h"
+#include "platform/PlatformMutex.h"
+#include "platform/Span.h"
+#include "rtos/EventFlags.h"
+#include "rtos/Kernel.h"
+
+#ifndef MBED_CONF_NSAPI_SOCKET_SET_SIZE
+#define MBED_CONF_NSAPI_SOCKET_SET_SIZE 16
+#endif
+
+/** Set of sockets a single thread waits on.
+ *
+ *  Each socket added takes one flag of an event flags object, which its
+ *  sigio() callback sets, so a thread can block on all of them at once
+ *  without polling.
+ *
+ *  Socket events are edge triggered: a socket is reported once per event,
+ *  not for as long as data is pending. Sockets in a set should be
+ *  non-blocking, and the caller should service a reported socket until it
+ *  returns NSAPI_ERROR_WOULD_BLOCK before waiting again.
+ *
+ *  @note The set owns the sigio() callback of every socket in it. Calling
+ *  sigio() on such a socket stops the set from seeing its events.
+ *
+ *  Example:
+ *  @code
+ *  SocketSet set;
+ *  set.add(&sock1);
+ *  set.add(&sock2);
+ *
+ *  Socket *ready[2];
+ *  while (true) {
+ *      nsapi_size_or_error_t count = set.wait(ready);
+ *      for (int i = 0; i < count; i++) {
+ *          while (ready[i]->recv(buf, sizeof buf) > 0) {
+ *              ...
+ *          }
+ *      }
+ *  }
+ *  @endcode
+ */
+class SocketSet : private mbed::NonCopyable<SocketSet> {
+public:
+    /** Maximum number of sockets in a set */
+    static const int MAX_SOCKETS = MBED_CONF_NSAPI_SOCKET_SET_SIZE;
+
+    /** Create an empty socket set */
+    SocketSet();
+
+    /** Destroy the set, removing all its sockets */
+    ~SocketSet();
+
+    /** Add a socket to the set.
+     *
+     *  The socket is reported by the next wait() once, in case it had
+     *  events before it was added. The socket must be removed before
+     *  it is destroyed.
+     *
+     *  @param socket   Socket to add.
+     *  @retval         NSAPI_ERROR_OK on success.
+     *  @retval         NSAPI_ERROR_PARAMETER if socket is NULL or already in the set.
+     *  @retval         NSAPI_ERROR_NO_MEMORY if the set is full.
+     */
+    nsapi_error_t add(Socket *socket);
+
+    /** Remove a socket from the set and clear its sigio() callback.
+     *
+     *  @param socket   Socket to remove.
+     *  @retval         NSAPI_ERROR_OK on success.
+     *  @retval         NSAPI_ERROR_NO_SOCKET if the socket is not in the set.
+     */
+    nsapi_error_t remove(Socket *socket);
+
+    /** Number of sockets in the set */
+    int size() const;
+
+    /** Wait until at least one socket in the set has had an event.
+     *
+     *  Sockets reported are consumed. Sockets that had an event but did not
+     *  fit in ready are reported by the next call.
+     *
+     *  @param ready    Filled with the sockets that had an event.
+     *  @param timeout  Maximum time to wait, forever by default.
+     *  @return         Number of sockets stored in ready, or
+     *                  NSAPI_ERROR_WOULD_BLOCK if the timeout expired,
+     *                  NSAPI_ERROR_NO_SOCKET if the set is empty and
+     *                  NSAPI_ERROR_PARAMETER if ready is empty.
+     */
+    nsapi_size_or_error_t wait(mbed::Span<Socket *> ready,
+                               rtos::Kernel::Clock::duration_u32 timeout = rtos::Kernel::wait_for_u32_forever);
+
+private:
+    struct Entry {
+        SocketSet *set;
+        Socket *socket;
+        uint32_t flag;
+
+        void event();
+    };
+
+    Entry *find(Socket *socket);
+
+    Entry _entries[MAX_SOCKETS];
+    mutable PlatformMutex _mutex;
+    rtos::EventFlags _flags;
+    uint32_t _mask;     /*!< flags of the sockets in the set */
+};
+
+#endif
+
+/** @}*/
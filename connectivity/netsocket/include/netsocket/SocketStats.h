@@ -28,6 +28,17 @@
 #define MBED_CONF_NSAPI_SOCKET_STATS_MAX_COUNT      10
 #endif
 
+// Window over which sent_bps and recv_bps are averaged
+#ifndef MBED_CONF_NSAPI_SOCKET_STATS_RATE_WINDOW_MS
+#define MBED_CONF_NSAPI_SOCKET_STATS_RATE_WINDOW_MS 5000
+#endif
+
+/** Number of buckets in mbed_stats_socket_t::rtt_histogram */
+#define MBED_STATS_SOCKET_RTT_BUCKETS               8
+
+/** Upper bound of the first round trip time bucket, each next bucket doubles it */
+#define MBED_STATS_SOCKET_RTT_BUCKET_MS             16
+
 /** Enum of socket states
   *
   * Can be used to specify current state of socket - open, closed, connected or listen.
@@ -51,6 +62,15 @@ typedef struct {
     size_t sent_bytes;              /**< Data sent through this socket */
     size_t recv_bytes;              /**< Data received through this socket */
     us_timestamp_t last_change_tick;/**< osKernelGetTick() when state last changed */
+    uint32_t sent_bps;              /**< Bytes per second sent over the last nsapi.socket-stats-rate-window-ms */
+    uint32_t recv_bps;              /**< Bytes per second received over the last nsapi.socket-stats-rate-window-ms */
+    uint32_t send_blocked_ms;       /**< Time spent blocked in send calls */
+    uint32_t recv_blocked_ms;       /**< Time spent blocked in receive calls */
+    uint32_t rtt_ms;                /**< Last round trip time reported by the stack, 0 if unknown (TCP only) */
+    uint32_t send_queue;            /**< Bytes in the stack send queue after the last send (TCP only) */
+    uint32_t rtt_histogram[MBED_STATS_SOCKET_RTT_BUCKETS]; /**< Round trip time samples, one per send. Bucket n counts
+                                                                 samples below MBED_STATS_SOCKET_RTT_BUCKET_MS << n,
+                                                                 the last bucket all longer ones */
 } mbed_stats_socket_t;
 
 /**  SocketStats class
@@ -141,12 +161,51 @@ public:
      */
     void stats_update_recv_bytes(const Socket *reference_id, size_t recv_bytes);
 
+    /** Update time spent blocked in send, which is cumulative count per socket.
+     *  API used by socket (TCP or UDP) layers only, not to be used by application.
+     *
+     *  @param reference_id   ID to identify socket in data array.
+     *  @param blocked_ms Parameter to append time blocked waiting to send.
+     *
+     */
+    void stats_update_send_blocked_time(const Socket *reference_id, uint32_t blocked_ms);
+
+    /** Update time spent blocked in receive, which is cumulative count per socket.
+     *  API used by socket (TCP or UDP) layers only, not to be used by application.
+     *
+     *  @param reference_id   ID to identify socket in data array.
+     *  @param blocked_ms Parameter to append time blocked waiting for data.
+     *
+     */
+    void stats_update_recv_blocked_time(const Socket *reference_id, uint32_t blocked_ms);
+
+    /** Record the round trip time and send queue of a TCP socket.
+     *  API used by socket (TCP) layers only, not to be used by application.
+     *
+     *  @param reference_id   ID to identify socket in data array.
+     *  @param info Parameter with the connection state read from the stack.
+     *
+     */
+    void stats_update_tcp_info(const Socket *reference_id, const nsapi_tcp_info_t &info);
+
 #if MBED_CONF_NSAPI_SOCKET_STATS_ENABLED
 private:
+    /** Bytes counted in fixed windows, from which a sliding window rate is estimated */
+    struct rate_window {
+        uint32_t start;                 /**< Start of the current window in ms */
+        uint32_t current;               /**< Bytes in the current window */
+        uint32_t previous;              /**< Bytes in the previous window */
+    };
+
     static mbed_stats_socket_t _stats[MBED_CONF_NSAPI_SOCKET_STATS_MAX_COUNT];
+    static rate_window _sent_rate[MBED_CONF_NSAPI_SOCKET_STATS_MAX_COUNT];
+    static rate_window _recv_rate[MBED_CONF_NSAPI_SOCKET_STATS_MAX_COUNT];
     static SingletonPtr<PlatformMutex> _mutex;
     static uint32_t _size;
 
+    static void rate_add(rate_window &rate, uint32_t now, size_t bytes);
+    static uint32_t rate_get(rate_window rate, uint32_t now);
+
     /** Internal function to scan the array and get the position of the element in the list.
      *
      *  @param reference_id   ID to identify the socket in the data array.
@@ -186,6 +245,18 @@ inline void SocketStats::stats_update_sent_bytes(const Socket *, size_t)
 inline void SocketStats::stats_update_recv_bytes(const Socket *, size_t)
 {
 }
+
+inline void SocketStats::stats_update_send_blocked_time(const Socket *, uint32_t)
+{
+}
+
+inline void SocketStats::stats_update_recv_blocked_time(const Socket *, uint32_t)
+{
+}
+
+inline void SocketStats::stats_update_tcp_info(const Socket *, const nsapi_tcp_info_t &)
+{
+}
 #endif // !MBED_CONF_NSAPI_SOCKET_STATS_ENABLED
 
 #endif
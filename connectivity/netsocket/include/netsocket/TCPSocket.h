@@ -102,6 +102,64 @@ public:
      */
     nsapi_size_or_error_t recv(void *data, nsapi_size_t size) override;
 
+    /** Get the memory manager of the network stack's buffers
+     *
+     *  Used to allocate buffers for send_buf() and to access and free
+     *  buffers from recv_buf().
+     *
+     *  @return         Memory manager, or NULL if the socket is not open or
+     *                  the stack does not support zero-copy sockets
+     */
+    NetStackMemoryManager *get_memory_manager();
+
+    /** Send a chain of network stack buffers over a TCP socket without copying
+     *
+     *  The buffers are allocated from get_memory_manager() and filled in
+     *  place. On success the stack owns the chain and frees it once the data
+     *  is acknowledged, on failure the caller keeps it. The whole chain is
+     *  queued, or none of it: a chain larger than the stack's send buffer
+     *  is rejected with NSAPI_ERROR_PARAMETER. If the stack runs out of
+     *  memory part way, it resets the connection and returns
+     *  NSAPI_ERROR_NO_MEMORY. Closing the socket while such data is still
+     *  unacknowledged resets the connection.
+     *
+     *  By default, send_buf blocks until the chain fits in the send buffer.
+     *  If socket is set to non-blocking or times out, NSAPI_ERROR_WOULD_BLOCK
+     *  can be returned.
+     *
+     *  @param buf      Buffer chain to send
+     *  @retval         int Number of sent bytes on success
+     *  @retval         NSAPI_ERROR_NO_SOCKET in case socket was not created correctly
+     *  @retval         NSAPI_ERROR_WOULD_BLOCK in case non-blocking mode is enabled
+     *                  and send cannot be performed immediately
+     *  @retval         NSAPI_ERROR_UNSUPPORTED if the stack does not support zero-copy sockets
+     *  @retval         NSAPI_ERROR_PARAMETER if the chain can never fit in the send buffer
+     *  @retval         int Other negative error codes for stack-related failures.
+     *                  See @ref NetworkStack::socket_send_buf.
+     */
+    nsapi_size_or_error_t send_buf(net_stack_mem_buf_t *buf);
+
+    /** Receive data over a TCP socket as a chain of network stack buffers
+     *
+     *  The data is handed over in the buffers the stack received it in. Walk
+     *  the chain with get_memory_manager()->get_next(), get_ptr() and
+     *  get_len(), then free it with get_memory_manager()->free().
+     *
+     *  By default, recv_buf blocks until some data is received. If socket is set to
+     *  non-blocking or times out, NSAPI_ERROR_WOULD_BLOCK can be returned to
+     *  indicate no data.
+     *
+     *  @param buf      Destination for the received buffer chain
+     *  @retval         int Number of received bytes on success
+     *  @retval         NSAPI_ERROR_NO_SOCKET in case socket was not created correctly
+     *  @retval         NSAPI_ERROR_WOULD_BLOCK in case non-blocking mode is enabled
+     *                  and recv cannot be performed immediately
+     *  @retval         NSAPI_ERROR_UNSUPPORTED if the stack does not support zero-copy sockets
+     *  @retval         int Other negative error codes for stack-related failures.
+     *                  See @ref NetworkStack::socket_recv_buf.
+     */
+    nsapi_size_or_error_t recv_buf(net_stack_mem_buf_t **buf);
+
     /** Send data on a socket.
      *
      * TCP socket is connection oriented protocol, so address is ignored.
@@ -145,6 +203,48 @@ public:
     nsapi_size_or_error_t recvfrom(SocketAddress *address,
                                    void *data, nsapi_size_t size) override;
 
+    /** Send data gathered from several buffers over a TCP socket
+     *
+     *  TCP socket is connection oriented protocol, so address is ignored.
+     *  The buffers are sent in order, as with send() of them concatenated.
+     *
+     *  By default, sendmsg blocks until all data is sent. If socket is set to
+     *  non-blocking or times out, a partial amount can be written.
+     *  NSAPI_ERROR_WOULD_BLOCK is returned if no data was written.
+     *
+     *  @param address  Remote address, ignored
+     *  @param iov      Buffers of data to send to the host
+     *  @retval         int Number of sent bytes on success
+     *  @retval         NSAPI_ERROR_NO_SOCKET in case socket was not created correctly
+     *  @retval         NSAPI_ERROR_WOULD_BLOCK in case non-blocking mode is enabled
+     *                  and send cannot be performed immediately
+     *  @retval         int Other negative error codes for stack-related failures.
+     *                  See @ref NetworkStack::socket_sendmsg.
+     */
+    nsapi_size_or_error_t sendmsg(const SocketAddress *address,
+                                  mbed::Span<const nsapi_iovec_t> iov) override;
+
+    /** Receive data over a TCP socket, scattered into several buffers
+     *
+     *  The buffers are filled in order. Stores the remote address in
+     *  address if address is not NULL.
+     *
+     *  By default, recvmsg blocks until some data is received. If socket is set to
+     *  non-blocking or times out, NSAPI_ERROR_WOULD_BLOCK can be returned to
+     *  indicate no data.
+     *
+     *  @param address  Destination for the remote address or NULL
+     *  @param iov      Destination buffers for data received from the host
+     *  @retval         int Number of received bytes on success
+     *  @retval         NSAPI_ERROR_NO_SOCKET in case socket was not created correctly
+     *  @retval         NSAPI_ERROR_WOULD_BLOCK in case non-blocking mode is enabled
+     *                  and recv cannot be performed immediately
+     *  @retval         int Other negative error codes for stack-related failures.
+     *                  See @ref NetworkStack::socket_recvmsg.
+     */
+    nsapi_size_or_error_t recvmsg(SocketAddress *address,
+                                  mbed::Span<const nsapi_iovec_t> iov) override;
+
     /** Accepts a connection on a socket.
      *
      *  The server socket must be bound and set to listen for connections.
@@ -186,6 +286,9 @@ private:
      *  To be used within accept() function. Close() will clean this up.
      */
     TCPSocket(TCPSocket *parent, nsapi_socket_t socket, SocketAddress address);
+
+    /* Samples round trip time and send queue into the socket statistics, with _lock held */
+    void update_tcp_info();
 };
 
 
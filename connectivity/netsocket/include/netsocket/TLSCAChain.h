@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/** @file TLSCAChain.h Parsed CA certificate chain shared by TLS sockets */
+/** \addtogroup netsocket
+ * @{*/
+
+#ifndef _MBED_TLS_CA_CHAIN_H_
+#define _MBED_TLS_CA_CHAIN_H_
+
+#include "netsocket/nsapi_types.h"
+#include "platform/NonCopyable.h"
+#include "platform/SharedPtr.h"
+#include "mbedtls/x509_crt.h"
+
+#if defined(MBEDTLS_X509_CRT_PARSE_C) || defined(DOXYGEN_ONLY)
+
+/**
+ * TLSCAChain holds a parsed chain of trusted CA certificates.
+ *
+ * TLSSocketWrapper::set_root_ca_cert() parses the certificates again for
+ * every socket. Parsing them once into a TLSCAChain and passing it to
+ * TLSSocketWrapper::set_ca_chain() of each socket saves both the parsing
+ * time and a copy of the chain per socket. The chain is held through
+ * mbed::SharedPtr and freed with the last socket or reference using it.
+ *
+ * @code
+ * mbed::SharedPtr<TLSCAChain> ca(new TLSCAChain);
+ * ca->parse(root_ca_pem);
+ * socket1.set_ca_chain(ca);
+ * socket2.set_ca_chain(ca);
+ * @endcode
+ *
+ * @note The chain must not be modified once a socket uses it.
+ */
+class TLSCAChain : private mbed::NonCopyable<TLSCAChain> {
+public:
+    TLSCAChain();
+    ~TLSCAChain();
+
+    /** Add certificates to the chain.
+     *
+     * @param ca   PEM (including the terminating null byte) or DER certificates.
+     * @param len  Length of the certificates.
+     * @return     NSAPI_ERROR_OK on success, NSAPI_ERROR_PARAMETER if the
+     *             certificates could not be parsed.
+     */
+    nsapi_error_t parse(const void *ca, size_t len);
+
+    /** Add PEM certificates to the chain.
+     *
+     * @param ca_pem  Null-terminated PEM certificates.
+     * @return        NSAPI_ERROR_OK on success, NSAPI_ERROR_PARAMETER if the
+     *                certificates could not be parsed.
+     */
+    nsapi_error_t parse(const char *ca_pem);
+
+    /** Add DER certificates to the chain without copying them.
+     *
+     * The parsed certificates point into the given memory, which saves a
+     * heap copy of each certificate, typically 1-2 KB. Use it for
+     * certificates in persistent memory, like a const array in flash.
+     *
+     * @note The certificates must stay valid until the chain is destroyed.
+     *
+     * @param ca_der  DER certificates, one after another.
+     * @param len     Length of the certificates.
+     * @return        NSAPI_ERROR_OK on success, NSAPI_ERROR_PARAMETER if the
+     *                certificates could not be parsed.
+     */
+    nsapi_error_t parse_der_nocopy(const void *ca_der, size_t len);
+
+    /** Get the Mbed TLS certificate chain.
+     *
+     * @return The chain, or nullptr if no certificate was parsed.
+     */
+    mbedtls_x509_crt *get_crt()
+    {
+        return _parsed ? &_crt : nullptr;
+    }
+
+private:
+    mbedtls_x509_crt _crt;
+    bool _parsed = false;
+};
+
+#endif /* MBEDTLS_X509_CRT_PARSE_C */
+
+#endif // _MBED_TLS_CA_CHAIN_H_
+
+/** @} */
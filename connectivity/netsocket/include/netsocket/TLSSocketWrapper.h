@@ -23,7 +23,9 @@
 #define _MBED_HTTPS_TLS_SOCKET_WRAPPER_H_
 
 #include "netsocket/Socket.h"
+#include "netsocket/TLSCAChain.h"
 #include "rtos/EventFlags.h"
+#include "rtos/Mutex.h"
 #include "platform/Callback.h"
 #include "mbedtls/platform.h"
 #include "mbedtls/ssl.h"
@@ -31,6 +33,9 @@
 #include "mbedtls/ctr_drbg.h"
 #include "mbedtls/hmac_drbg.h"
 #include "mbedtls/error.h"
+#if defined(MBEDTLS_PLATFORM_MEMORY)
+#include "tls_alloc.h"
+#endif
 
 // This class requires Mbed TLS SSL/TLS client code
 #if defined(MBEDTLS_SSL_CLI_C) || defined(DOXYGEN_ONLY)
@@ -49,6 +54,29 @@
 #error "CTR or HMAC must be defined for TLSSocketWrapper!"
 #endif
 
+// Number of sessions kept for resumption, see TLSSocketWrapper::set_session()
+#ifndef MBED_CONF_NSAPI_TLS_SESSION_CACHE_SIZE
+#define MBED_CONF_NSAPI_TLS_SESSION_CACHE_SIZE 0
+#endif
+
+// Maximum fragment length requested by sockets using their own SSL config,
+// 0 for none. See TLSSocketWrapper::set_max_fragment_length()
+#ifndef MBED_CONF_NSAPI_TLS_MAX_FRAGMENT_LENGTH
+#define MBED_CONF_NSAPI_TLS_MAX_FRAGMENT_LENGTH 0
+#endif
+
+// nsapi.tls-cipher-order: ciphers preferred by sockets using their own SSL
+// config, as a comma-separated list of mbedtls_cipher_type_t, the first
+// the most preferred. The suites of other ciphers follow in the Mbed TLS
+// order. connectivity/netsocket/tools/tls_cipher_order.py generates it
+// from the results of the mbedtls benchmark test. Undefined by default.
+
+// Size of the buffer coalescing the writes of a corked socket, see
+// TLSSocketWrapper::set_cork()
+#ifndef MBED_CONF_NSAPI_TLS_CORK_BUFFER_SIZE
+#define MBED_CONF_NSAPI_TLS_CORK_BUFFER_SIZE 1024
+#endif
+
 /**
  * TLSSocket is a wrapper around Socket for interacting with TLS servers.
  *
@@ -116,6 +144,26 @@ public:
      */
     nsapi_error_t set_root_ca_cert(const char *root_ca_pem);
 
+    /** Sets the certification of Root CA without copying it.
+     *
+     * Unlike set_root_ca_cert(), the certificates are not copied to the
+     * heap, the parsed chain points into them. Use it for DER certificates
+     * in persistent memory, like a const array in flash. PEM certificates
+     * can be converted to such an array at build time with
+     * connectivity/netsocket/tools/pem_to_der.py.
+     *
+     * @note Must be called before calling connect()
+     * @note The certificates must stay valid until the socket is destroyed
+     *       or another CA chain is set.
+     *
+     * @param root_ca_der Root CA Certificates in DER format, one after another.
+     * @param len         Length of the certificates.
+     * @retval NSAPI_ERROR_OK on success.
+     * @retval NSAPI_ERROR_NO_MEMORY in case there is not enough memory to allocate the chain.
+     * @retval NSAPI_ERROR_PARAMETER in case the provided root_ca_der parameter failed parsing.
+     */
+    nsapi_error_t set_root_ca_cert_nocopy(const void *root_ca_der, size_t len);
+
     /** Sets client certificate, and client private key.
      *
      * @param client_cert Client certification in PEM or DER format.
@@ -171,6 +219,43 @@ public:
      */
     nsapi_size_or_error_t recv(void *data, nsapi_size_t size) override;
 
+    /** Coalesce the data of send() calls into full TLS records.
+     *
+     * A protocol writing a header and then a body, like MQTT or HTTP,
+     * otherwise produces a record, a MAC and a TCP segment for each write.
+     * When corked, send() copies the data to a buffer of
+     * nsapi.tls-cork-buffer-size bytes, at most the negotiated record
+     * payload, and the buffer is sent as one record when it is full, on
+     * flush(), before recv() and on close().
+     *
+     * With a nonzero delay, the buffer is also sent that long after the
+     * data is written, like Nagle's algorithm, from the shared event queue.
+     *
+     * @param enabled   true to buffer the data, false to flush the buffer
+     *                  and send each write directly again.
+     * @param delay_ms  Milliseconds after the first buffered write at which
+     *                  the buffer is sent, 0 to wait for a full buffer or
+     *                  flush().
+     * @retval NSAPI_ERROR_OK on success.
+     * @retval NSAPI_ERROR_NO_SOCKET in case socket was not created correctly.
+     * @retval NSAPI_ERROR_NO_MEMORY in case there is not enough memory to allocate the buffer.
+     * @retval NSAPI_ERROR_WOULD_BLOCK or NSAPI_ERROR_DEVICE_ERROR in case
+     *         the buffer could not be flushed when disabling, see flush().
+     *         The socket stays corked.
+     */
+    nsapi_error_t set_cork(bool enabled, int delay_ms = 0);
+
+    /** Send the data buffered by a corked socket as a TLS record.
+     *
+     * @retval NSAPI_ERROR_OK on success, or if nothing is buffered.
+     * @retval NSAPI_ERROR_NO_SOCKET in case socket was not created correctly.
+     * @retval NSAPI_ERROR_WOULD_BLOCK in case non-blocking mode is enabled
+     *         and the data cannot be sent immediately. It stays buffered.
+     * @retval NSAPI_ERROR_DEVICE_ERROR in case of tls-related errors.
+     *         See @ref mbedtls_ssl_write.
+     */
+    nsapi_error_t flush();
+
     /* = Functions inherited from Socket = */
     nsapi_error_t close() override;
     /**
@@ -220,8 +305,75 @@ public:
      * @param crt Mbed TLS X509 certificate chain.
      */
     void set_ca_chain(mbedtls_x509_crt *crt);
+
+    /** Set a CA chain shared with other sockets.
+     *
+     * The socket keeps a reference to the chain until another chain is set
+     * or the socket is destroyed.
+     *
+     * @param chain Parsed CA chain, or nullptr to remove it.
+     */
+    void set_ca_chain(mbed::SharedPtr<TLSCAChain> chain);
 #endif
 
+    /** Get the session of the established TLS connection.
+     *
+     * The session can be passed to set_session() of a socket connecting to
+     * the same server later, to resume it with an abbreviated handshake. It
+     * holds the session ID and, if the server issued one, the RFC 5077
+     * session ticket.
+     *
+     * @param session  Session initialized with mbedtls_ssl_session_init().
+     *                 Free it with mbedtls_ssl_session_free().
+     * @return         NSAPI_ERROR_OK on success, NSAPI_ERROR_NO_CONNECTION if the
+     *                 handshake has not completed, NSAPI_ERROR_NO_MEMORY if the
+     *                 session could not be copied.
+     */
+    nsapi_error_t get_session(mbedtls_ssl_session *session);
+
+    /** Request resumption of a session in the next handshake.
+     *
+     * If the server no longer knows the session, a full handshake is done.
+     *
+     * When no session is set and nsapi.tls-session-cache-size is nonzero, the
+     * session last established with the same hostname by any socket is
+     * resumed. TLSSocket::connect() therefore resumes sessions automatically
+     * once the cache is enabled.
+     *
+     * @note Must be called before connect(). The session is copied when the
+     *       handshake starts, it must stay valid until then.
+     *
+     * @param session  Session from get_session().
+     * @return         NSAPI_ERROR_OK on success, NSAPI_ERROR_ALREADY if the
+     *                 handshake has already started.
+     */
+    nsapi_error_t set_session(const mbedtls_ssl_session *session);
+
+    /** Request a maximum fragment length (RFC 6066) in the next handshake.
+     *
+     * A server accepting it sends records of at most this length, and so
+     * does the client. With nsapi.tls-variable-buffer-length set, the
+     * 16 KB input and output buffers shrink to it once the handshake is
+     * done, which lets more connections share the heap. The handshake
+     * itself still uses full-size buffers.
+     *
+     * @note This is a setting of the SSL configuration, shared with the
+     *       sockets using the same set_ssl_config().
+     *
+     * @param length  512, 1024, 2048 or 4096, or 0 to request no limit.
+     * @return        NSAPI_ERROR_OK on success, NSAPI_ERROR_PARAMETER for
+     *                other lengths, NSAPI_ERROR_ALREADY if the handshake has
+     *                already started, NSAPI_ERROR_UNSUPPORTED if Mbed TLS is
+     *                built without MBEDTLS_SSL_MAX_FRAGMENT_LENGTH.
+     */
+    nsapi_error_t set_max_fragment_length(size_t length);
+
+    /** Remove sessions from the process-wide session cache.
+     *
+     * @param hostname  Only remove the session of this host, or NULL to remove all.
+     */
+    static void clear_session_cache(const char *hostname = NULL);
+
     /** Get internal Mbed TLS configuration structure.
      *
      * @return Mbed TLS SSL config.
@@ -265,6 +417,12 @@ protected:
 
     bool is_handshake_started() const;
 
+    /** Configure the SSL context once it is set up, before the handshake.
+     *
+     *  @return 0 on success, or an Mbed TLS error code, which fails the handshake.
+     */
+    virtual int configure_ssl_context();
+
     void event();
 #endif
 
@@ -273,6 +431,18 @@ protected:
 private:
     /** Continue already initialized handshake */
     nsapi_error_t continue_handshake();
+
+    /** Write data as TLS records, waiting up to timeout.
+     *
+     *  Drives the handshake if it is not done, like send().
+     */
+    nsapi_size_or_error_t write(const void *data, nsapi_size_t size, int timeout);
+
+    /** Write the cork buffer, with _cork_mutex held */
+    nsapi_error_t flush_cork(int timeout);
+
+    /** Send the cork buffer from the shared event queue */
+    void cork_timer_event();
     /**
      * Helper for pretty-printing Mbed TLS error codes
      */
@@ -321,8 +491,23 @@ private:
 #ifdef MBEDTLS_X509_CRT_PARSE_C
     mbedtls_x509_crt *_cacert = nullptr;
     mbedtls_x509_crt *_clicert = nullptr;
+    mbed::SharedPtr<TLSCAChain> _shared_cacert;
 #endif
     mbedtls_ssl_config *_ssl_conf = nullptr;
+    const mbedtls_ssl_session *_session = nullptr;
+
+    /* Write coalescing, see set_cork() */
+    rtos::Mutex _cork_mutex;
+    uint8_t *_cork_buf = nullptr;
+    size_t _cork_len = 0;
+    int _cork_delay = 0;
+    int _cork_event_id = 0;
+    /* A flush returned WOULD_BLOCK, Mbed TLS wants the same data again */
+    bool _cork_pending = false;
+#if defined(TLS_ALLOC_ENABLED)
+    /* Serves the handshake allocations, see tls_alloc.h */
+    tls_arena_t *_arena = nullptr;
+#endif
 
     bool _connect_transport: 1;
     bool _close_transport: 1;
@@ -46,6 +46,7 @@
 #include "netsocket/DTLSSocketWrapper.h"
 #include "netsocket/TLSSocket.h"
 #include "netsocket/DTLSSocket.h"
+#include "netsocket/SocketSet.h"
 
 #endif // __cplusplus
 
@@ -21,6 +21,7 @@
 #ifndef NSAPI_TYPES_H
 #define NSAPI_TYPES_H
 
+#include <stddef.h>
 #include <stdint.h>
 
 #ifdef __cplusplus
@@ -318,6 +319,7 @@ typedef enum nsapi_socket_option {
     NSAPI_LATENCY,           /*!< Read estimated latency to destination */
     NSAPI_STAGGER,           /*!< Read estimated stagger value to destination */
     NSAPI_IPTOS,             /*!< Set IP type of service to set specific precedence */
+    NSAPI_TCP_INFO,          /*!< Read round trip time and send queue of a TCP connection, see nsapi_tcp_info_t */
 } nsapi_socket_option_t;
 
 typedef enum nsapi_tlssocket_level {
@@ -381,6 +383,16 @@ typedef struct nsapi_stack {
     unsigned _stack_buffer[16];
 } nsapi_stack_t;
 
+/** nsapi_iovec structure
+ *
+ *  One buffer of a scatter-gather list, laid out like struct iovec so
+ *  stacks can pass it on unchanged.
+ */
+typedef struct nsapi_iovec {
+    void *iov_base; /* Start of the buffer */
+    size_t iov_len; /* Size of the buffer in bytes */
+} nsapi_iovec_t;
+
 /** nsapi_ip_mreq structure
  */
 typedef struct nsapi_ip_mreq {
@@ -395,6 +407,13 @@ typedef struct nsapi_latency_req {
     uint32_t latency;   /* [OUT] Latency value */
 } nsapi_latency_req_t;
 
+/** nsapi_tcp_info structure
+ */
+typedef struct nsapi_tcp_info {
+    uint32_t rtt_ms;        /* [OUT] Smoothed round trip time in milliseconds, 0 if not measured */
+    uint32_t send_queue;    /* [OUT] Bytes queued or sent and not yet acknowledged */
+} nsapi_tcp_info_t;
+
 /** nsapi_stagger_req structure
  */
 typedef struct nsapi_stagger_req {
@@ -36,6 +36,50 @@ DTLSSocketWrapper::DTLSSocketWrapper(Socket *transport, const char *hostname, co
 #endif /* !defined(MBEDTLS_SSL_CONF_SET_TIMER) && !defined(MBEDTLS_SSL_CONF_GET_TIMER) */
 }
 
+#if defined(MBEDTLS_SSL_PROTO_DTLS)
+void DTLSSocketWrapper::set_mtu(uint16_t mtu)
+{
+    mbedtls_ssl_set_mtu(get_ssl_context(), mtu);
+}
+
+void DTLSSocketWrapper::set_handshake_timeout(std::chrono::milliseconds min, std::chrono::milliseconds max)
+{
+    mbedtls_ssl_conf_handshake_timeout(get_ssl_config(), min.count(), max.count());
+}
+#endif
+
+#if defined(MBEDTLS_SSL_DTLS_CONNECTION_ID)
+nsapi_error_t DTLSSocketWrapper::set_connection_id(bool enabled)
+{
+    if (enabled && mbedtls_ssl_conf_cid(get_ssl_config(), 0, MBEDTLS_SSL_UNEXPECTED_CID_IGNORE) != 0) {
+        return NSAPI_ERROR_PARAMETER;
+    }
+    _cid_enabled = enabled;
+    return NSAPI_ERROR_OK;
+}
+
+bool DTLSSocketWrapper::is_connection_id_used()
+{
+    int enabled = MBEDTLS_SSL_CID_DISABLED;
+
+    if (!is_handshake_started() || mbedtls_ssl_get_peer_cid(get_ssl_context(), &enabled, nullptr, nullptr) != 0) {
+        return false;
+    }
+    return enabled == MBEDTLS_SSL_CID_ENABLED;
+}
+#endif
+
+int DTLSSocketWrapper::configure_ssl_context()
+{
+#if defined(MBEDTLS_SSL_DTLS_CONNECTION_ID)
+    // The context must be set up before the connection ID can be set
+    if (_cid_enabled) {
+        return mbedtls_ssl_set_cid(get_ssl_context(), MBEDTLS_SSL_CID_ENABLED, nullptr, 0);
+    }
+#endif
+    return 0;
+}
+
 void DTLSSocketWrapper::timing_set_delay(void *ctx, uint32_t int_ms, uint32_t fin_ms)
 {
     DTLSSocketWrapper *context = static_cast<DTLSSocketWrapper *>(ctx);
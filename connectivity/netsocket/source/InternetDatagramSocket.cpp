@@ -18,6 +18,7 @@
 #include "netsocket/InternetDatagramSocket.h"
 #include "Timer.h"
 #include "mbed_assert.h"
+#include <utility>
 
 nsapi_error_t InternetDatagramSocket::connect(const SocketAddress &address)
 {
@@ -55,7 +56,7 @@ nsapi_size_or_error_t InternetDatagramSocket::sendto(const SocketAddress &addres
             // Release lock before blocking so other threads
             // accessing this object aren't blocked
             _lock.unlock();
-            flag = _event_flag.wait_any(WRITE_FLAG, _timeout);
+            flag = wait_for_event(WRITE_FLAG);
             _lock.lock();
 
             if (flag & osFlagsError) {
@@ -123,7 +124,80 @@ nsapi_size_or_error_t InternetDatagramSocket::recvfrom(SocketAddress *address, v
             // Release lock before blocking so other threads
             // accessing this object aren't blocked
             _lock.unlock();
-            flag = _event_flag.wait_any(READ_FLAG, _timeout);
+            flag = wait_for_event(READ_FLAG);
+            _lock.lock();
+
+            if (flag & osFlagsError) {
+                // Timeout break
+                ret = NSAPI_ERROR_WOULD_BLOCK;
+                break;
+            }
+        }
+    }
+
+    _readers--;
+    if (!_socket || !_readers) {
+        _event_flag.set(FINISHED_FLAG);
+    }
+
+    _lock.unlock();
+    return ret;
+}
+
+nsapi_size_or_error_t InternetDatagramSocket::recvfrom_batch(mbed::Span<nsapi_datagram_t> datagrams)
+{
+    _lock.lock();
+    nsapi_size_or_error_t ret;
+
+    _readers++;
+
+    if (_socket) {
+        _socket_stats.stats_update_socket_state(this, SOCK_OPEN);
+    }
+    while (true) {
+        if (!_socket) {
+            ret = NSAPI_ERROR_NO_SOCKET;
+            break;
+        }
+
+        core_util_atomic_flag_clear(&_pending);
+        nsapi_size_or_error_t recv = _stack->socket_recvfrom_batch(_socket, datagrams);
+
+        // Filter incomming packets using connected peer address,
+        // keeping the accepted ones at the front
+        if (recv > 0 && _remote_peer) {
+            nsapi_size_or_error_t accepted = 0;
+            for (nsapi_size_or_error_t i = 0; i < recv; i++) {
+                if (datagrams[i].address == _remote_peer) {
+                    if (i != accepted) {
+                        std::swap(datagrams[accepted], datagrams[i]);
+                    }
+                    accepted++;
+                }
+            }
+            if (!accepted) {
+                continue;
+            }
+            recv = accepted;
+        }
+
+        _socket_stats.stats_update_peer(this, _remote_peer);
+        // Non-blocking sockets always return. Blocking only returns when success or errors other than WOULD_BLOCK
+        if ((0 == _timeout) || (NSAPI_ERROR_WOULD_BLOCK != recv)) {
+            size_t bytes = 0;
+            for (nsapi_size_or_error_t i = 0; i < recv; i++) {
+                bytes += datagrams[i].len;
+            }
+            ret = recv;
+            _socket_stats.stats_update_recv_bytes(this, bytes);
+            break;
+        } else {
+            uint32_t flag;
+
+            // Release lock before blocking so other threads
+            // accessing this object aren't blocked
+            _lock.unlock();
+            flag = wait_for_event(READ_FLAG);
             _lock.lock();
 
             if (flag & osFlagsError) {
@@ -18,6 +18,9 @@
 #include "netsocket/InternetSocket.h"
 #include "platform/mbed_critical.h"
 #include "platform/Callback.h"
+#if MBED_CONF_NSAPI_SOCKET_STATS_ENABLED && defined(MBED_CONF_RTOS_PRESENT)
+#include "rtos/Kernel.h"
+#endif
 
 using namespace mbed;
 
@@ -26,6 +29,24 @@ InternetSocket::InternetSocket()
     _socket_stats.stats_new_socket_entry(this);
 }
 
+uint32_t InternetSocket::wait_for_event(uint32_t flag)
+{
+#if MBED_CONF_NSAPI_SOCKET_STATS_ENABLED && defined(MBED_CONF_RTOS_PRESENT)
+    uint64_t start = rtos::Kernel::get_ms_count();
+    uint32_t ret = _event_flag.wait_any(flag, _timeout);
+    uint32_t blocked = rtos::Kernel::get_ms_count() - start;
+
+    if (flag == WRITE_FLAG) {
+        _socket_stats.stats_update_send_blocked_time(this, blocked);
+    } else {
+        _socket_stats.stats_update_recv_blocked_time(this, blocked);
+    }
+    return ret;
+#else
+    return _event_flag.wait_any(flag, _timeout);
+#endif
+}
+
 InternetSocket::~InternetSocket()
 {
     close();
@@ -265,3 +286,115 @@ nsapi_error_t InternetSocket::getpeername(SocketAddress *address)
     *address = _remote_peer;
     return NSAPI_ERROR_OK;
 }
+
+nsapi_size_or_error_t InternetSocket::sendmsg(const SocketAddress *address, mbed::Span<const nsapi_iovec_t> iov)
+{
+    _lock.lock();
+    nsapi_size_or_error_t ret;
+    SocketAddress peer = address ? *address : _remote_peer;
+
+    _writers++;
+    if (_socket) {
+        _socket_stats.stats_update_socket_state(this, SOCK_OPEN);
+        _socket_stats.stats_update_peer(this, peer);
+    }
+    while (true) {
+        if (!_socket) {
+            ret = NSAPI_ERROR_NO_SOCKET;
+            break;
+        }
+        if (!peer) {
+            ret = NSAPI_ERROR_NO_ADDRESS;
+            break;
+        }
+
+        core_util_atomic_flag_clear(&_pending);
+        nsapi_size_or_error_t sent = _stack->socket_sendmsg(_socket, &peer, iov);
+        if ((0 == _timeout) || (NSAPI_ERROR_WOULD_BLOCK != sent)) {
+            _socket_stats.stats_update_sent_bytes(this, sent);
+            ret = sent;
+            break;
+        } else {
+            uint32_t flag;
+
+            // Release lock before blocking so other threads
+            // accessing this object aren't blocked
+            _lock.unlock();
+            flag = wait_for_event(WRITE_FLAG);
+            _lock.lock();
+
+            if (flag & osFlagsError) {
+                // Timeout break
+                ret = NSAPI_ERROR_WOULD_BLOCK;
+                break;
+            }
+        }
+    }
+
+    _writers--;
+    if (!_socket || !_writers) {
+        _event_flag.set(FINISHED_FLAG);
+    }
+    _lock.unlock();
+    return ret;
+}
+
+nsapi_size_or_error_t InternetSocket::recvmsg(SocketAddress *address, mbed::Span<const nsapi_iovec_t> iov)
+{
+    _lock.lock();
+    nsapi_size_or_error_t ret;
+    SocketAddress ignored;
+
+    if (!address) {
+        address = &ignored;
+    }
+
+    _readers++;
+
+    if (_socket) {
+        _socket_stats.stats_update_socket_state(this, SOCK_OPEN);
+    }
+    while (true) {
+        if (!_socket) {
+            ret = NSAPI_ERROR_NO_SOCKET;
+            break;
+        }
+
+        core_util_atomic_flag_clear(&_pending);
+        nsapi_size_or_error_t recv = _stack->socket_recvmsg(_socket, address, iov);
+
+        // Filter incoming packets using connected peer address
+        if (recv >= 0 && _remote_peer && _remote_peer != *address) {
+            continue;
+        }
+
+        // Non-blocking sockets always return. Blocking only returns when success or errors other than WOULD_BLOCK
+        if ((0 == _timeout) || (NSAPI_ERROR_WOULD_BLOCK != recv)) {
+            ret = recv;
+            _socket_stats.stats_update_recv_bytes(this, recv);
+            break;
+        } else {
+            uint32_t flag;
+
+            // Release lock before blocking so other threads
+            // accessing this object aren't blocked
+            _lock.unlock();
+            flag = wait_for_event(READ_FLAG);
+            _lock.lock();
+
+            if (flag & osFlagsError) {
+                // Timeout break
+                ret = NSAPI_ERROR_WOULD_BLOCK;
+                break;
+            }
+        }
+    }
+
+    _readers--;
+    if (!_socket || !_readers) {
+        _event_flag.set(FINISHED_FLAG);
+    }
+
+    _lock.unlock();
+    return ret;
+}
@@ -0,0 +1,374 @@
+/* Network interface happy eyeballs connect
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "netsocket/NetworkInterface.h"
+#include "netsocket/TCPSocket.h"
+#include "rtos/EventFlags.h"
+#include "rtos/Kernel.h"
+#include "PlatformMutex.h"
+#include <new>
+
+using namespace std::chrono;
+using rtos::Kernel::Clock;
+
+namespace {
+
+/* Time to wait for a pending AAAA answer when the A answer comes first (RFC 8305 section 3) */
+constexpr milliseconds RESOLUTION_DELAY = milliseconds(50);
+
+enum {
+    FAMILY_IPV6,
+    FAMILY_IPV4,
+    FAMILY_COUNT
+};
+
+/* Address lookups for both families, and the flags the connect loop waits on.
+ * The DNS callbacks may still run after the connect has returned, so the
+ * object is reference counted and freed by whoever drops the last reference.
+ */
+class HappyEyeballsLookup {
+public:
+    static const uint32_t EVENT_FLAG = 1;
+
+    rtos::EventFlags flags;
+
+    HappyEyeballsLookup() : _refs(1), _last(FAMILY_IPV4), _started(false)
+    {
+        for (int f = 0; f < FAMILY_COUNT; f++) {
+            _family[f].addrs = NULL;
+            _family[f].count = 0;
+            _family[f].next = 0;
+            _family[f].id = 0;
+            _family[f].done = false;
+        }
+    }
+
+    void set_literal(const SocketAddress &address)
+    {
+        int f = address.get_ip_version() == NSAPI_IPv6 ? FAMILY_IPV6 : FAMILY_IPV4;
+        _family[f].addrs = new (std::nothrow) SocketAddress[1];
+        if (_family[f].addrs) {
+            _family[f].addrs[0] = address;
+            _family[f].count = 1;
+        } else {
+            _family[f].count = NSAPI_ERROR_NO_MEMORY;
+        }
+        _family[f].done = true;
+        _family[!f].count = NSAPI_ERROR_NO_ADDRESS;
+        _family[!f].done = true;
+    }
+
+    void start(NetworkInterface *iface, const char *hostname, int f)
+    {
+        SocketAddress hints{{f == FAMILY_IPV6 ? NSAPI_IPv6 : NSAPI_IPv4}, 0};
+
+        _mutex.lock();
+        _refs++;
+        _mutex.unlock();
+
+        nsapi_value_or_error_t ret = iface->getaddrinfo_async(hostname, &hints, f == FAMILY_IPV6 ?
+                                                              mbed::callback(this, &HappyEyeballsLookup::resolved_ipv6) :
+                                                              mbed::callback(this, &HappyEyeballsLookup::resolved_ipv4));
+
+        _mutex.lock();
+        // Already done if answered from the cache, in which case ret is not an id
+        if (!_family[f].done) {
+            if (ret < 0) {
+                _family[f].count = ret;
+                _family[f].done = true;
+                _refs--;
+            } else {
+                _family[f].id = ret;
+            }
+        }
+        _mutex.unlock();
+    }
+
+    /* Picks the next address to try, alternating families starting with IPv6 (RFC 8305 section 4).
+     * Returns 1 with the address, 0 if one may follow once a lookup completes or at retry_at,
+     * and -1 once every address has been handed out.
+     */
+    int next(SocketAddress *address, Clock::time_point now, Clock::time_point *retry_at)
+    {
+        int ret = -1;
+
+        _mutex.lock();
+        for (int n = 0; n < FAMILY_COUNT; n++) {
+            int f = n == 0 ? !_last : _last;
+            Family &family = _family[f];
+
+            if (!family.done) {
+                ret = 0;
+                continue;
+            }
+            if (family.next >= family.count) {
+                continue;
+            }
+            if (f == FAMILY_IPV4 && !_started && !_family[FAMILY_IPV6].done && now < family.resolved + RESOLUTION_DELAY) {
+                *retry_at = family.resolved + RESOLUTION_DELAY;
+                ret = 0;
+                continue;
+            }
+
+            *address = family.addrs[family.next++];
+            _last = f;
+            _started = true;
+            ret = 1;
+            break;
+        }
+        _mutex.unlock();
+
+        return ret;
+    }
+
+    /* Error to report if no address was found */
+    nsapi_error_t error()
+    {
+        _mutex.lock();
+        nsapi_error_t err = _family[FAMILY_IPV4].count < 0 ? _family[FAMILY_IPV4].count : _family[FAMILY_IPV6].count;
+        _mutex.unlock();
+
+        return err < 0 ? err : NSAPI_ERROR_DNS_FAILURE;
+    }
+
+    /* Cancels pending lookups and drops the connect loop's reference */
+    void finish(NetworkInterface *iface)
+    {
+        for (int f = 0; f < FAMILY_COUNT; f++) {
+            _mutex.lock();
+            nsapi_value_or_error_t id = _family[f].done ? 0 : _family[f].id;
+            _mutex.unlock();
+
+            // On success the callback will not be called, so its reference goes here
+            if (id > 0 && iface->gethostbyname_async_cancel(id) == NSAPI_ERROR_OK) {
+                release();
+            }
+        }
+        release();
+    }
+
+    void socket_event()
+    {
+        flags.set(EVENT_FLAG);
+    }
+
+private:
+    struct Family {
+        SocketAddress *addrs;
+        nsapi_value_or_error_t count;   /*!< number of addresses, or error once done */
+        int next;                       /*!< next address to try */
+        nsapi_value_or_error_t id;      /*!< pending lookup */
+        Clock::time_point resolved;
+        bool done;
+    };
+
+    ~HappyEyeballsLookup()
+    {
+        for (int f = 0; f < FAMILY_COUNT; f++) {
+            delete[] _family[f].addrs;
+        }
+    }
+
+    void resolved(int f, nsapi_value_or_error_t result, SocketAddress *address)
+    {
+        _mutex.lock();
+        Family &family = _family[f];
+        if (result > 0 && address) {
+            family.addrs = new (std::nothrow) SocketAddress[result];
+            if (family.addrs) {
+                for (int i = 0; i < result; i++) {
+                    family.addrs[i] = address[i];
+                }
+                family.count = result;
+            } else {
+                family.count = NSAPI_ERROR_NO_MEMORY;
+            }
+        } else {
+            family.count = result < 0 ? result : NSAPI_ERROR_DNS_FAILURE;
+        }
+        family.resolved = Clock::now();
+        family.done = true;
+        _mutex.unlock();
+
+        flags.set(EVENT_FLAG);
+        release();
+    }
+
+    void resolved_ipv6(nsapi_value_or_error_t result, SocketAddress *address)
+    {
+        resolved(FAMILY_IPV6, result, address);
+    }
+
+    void resolved_ipv4(nsapi_value_or_error_t result, SocketAddress *address)
+    {
+        resolved(FAMILY_IPV4, result, address);
+    }
+
+    void release()
+    {
+        _mutex.lock();
+        bool last = --_refs == 0;
+        _mutex.unlock();
+
+        if (last) {
+            delete this;
+        }
+    }
+
+    Family _family[FAMILY_COUNT];
+    PlatformMutex _mutex;
+    int _refs;
+    int _last;          /*!< family of the last address handed out */
+    bool _started;
+};
+
+bool connect_in_progress(nsapi_error_t err)
+{
+    return err == NSAPI_ERROR_IN_PROGRESS || err == NSAPI_ERROR_ALREADY || err == NSAPI_ERROR_WOULD_BLOCK;
+}
+
+} // namespace
+
+nsapi_value_or_error_t NetworkInterface::happy_eyeballs_connect(const char *hostname, uint16_t port, mbed::Span<TCPSocket> sockets,
+                                                                milliseconds timeout, milliseconds attempt_delay)
+{
+    if (!hostname || hostname[0] == '\0' || sockets.empty()) {
+        return NSAPI_ERROR_PARAMETER;
+    }
+
+    HappyEyeballsLookup *lookup = new (std::nothrow) HappyEyeballsLookup;
+    SocketAddress *targets = new (std::nothrow) SocketAddress[sockets.size()];
+    bool *active = new (std::nothrow) bool[sockets.size()]();
+    if (!lookup || !targets || !active) {
+        if (lookup) {
+            lookup->finish(this);
+        }
+        delete[] targets;
+        delete[] active;
+        return NSAPI_ERROR_NO_MEMORY;
+    }
+
+    SocketAddress literal;
+    if (literal.set_ip_address(hostname)) {
+        lookup->set_literal(literal);
+    } else {
+        // nsapi_dns runs one query at a time, and an AAAA query stuck on a broken
+        // IPv6 path would hold back the A query behind it, so A goes first
+        lookup->start(this, hostname, FAMILY_IPV4);
+        lookup->start(this, hostname, FAMILY_IPV6);
+    }
+
+    const Clock::time_point deadline = Clock::now() + timeout;
+    Clock::time_point next_attempt = Clock::now();
+    nsapi_value_or_error_t result = NSAPI_ERROR_NO_CONNECTION;
+    bool attempted = false;
+    int running = 0;
+    int winner = -1;
+
+    while (winner < 0) {
+        Clock::time_point now = Clock::now();
+        if (now >= deadline) {
+            result = NSAPI_ERROR_TIMEOUT;
+            break;
+        }
+
+        // Non-blocking connect reports progress when called again
+        for (size_t i = 0; i < sockets.size() && winner < 0; i++) {
+            if (!active[i]) {
+                continue;
+            }
+            nsapi_error_t err = sockets[i].connect(targets[i]);
+            if (err == NSAPI_ERROR_OK || err == NSAPI_ERROR_IS_CONNECTED) {
+                winner = i;
+            } else if (!connect_in_progress(err)) {
+                sockets[i].close();
+                active[i] = false;
+                running--;
+                result = err;
+                next_attempt = now;
+            }
+        }
+        if (winner >= 0) {
+            break;
+        }
+
+        Clock::time_point wake = deadline;
+        int free_slot = -1;
+        for (size_t i = 0; i < sockets.size(); i++) {
+            if (!active[i]) {
+                free_slot = i;
+                break;
+            }
+        }
+
+        if (free_slot >= 0 && (running == 0 || now >= next_attempt)) {
+            SocketAddress address;
+            int found = lookup->next(&address, now, &wake);
+            if (found > 0) {
+                TCPSocket &socket = sockets[free_slot];
+                address.set_port(port);
+                attempted = true;
+                next_attempt = now + attempt_delay;
+
+                nsapi_error_t err = socket.open(this);
+                if (err == NSAPI_ERROR_OK) {
+                    socket.set_blocking(false);
+                    socket.sigio(mbed::callback(lookup, &HappyEyeballsLookup::socket_event));
+                    err = socket.connect(address);
+                    if (err == NSAPI_ERROR_OK || err == NSAPI_ERROR_IS_CONNECTED) {
+                        winner = free_slot;
+                        break;
+                    } else if (connect_in_progress(err)) {
+                        targets[free_slot] = address;
+                        active[free_slot] = true;
+                        running++;
+                        continue;
+                    }
+                    socket.close();
+                }
+                result = err;
+                next_attempt = now;
+                continue;
+            } else if (found < 0 && running == 0) {
+                if (!attempted) {
+                    result = lookup->error();
+                }
+                break;
+            }
+        } else if (free_slot >= 0 && next_attempt < wake) {
+            wake = next_attempt;
+        }
+
+        lookup->flags.wait_any_until(HappyEyeballsLookup::EVENT_FLAG, wake);
+    }
+
+    for (size_t i = 0; i < sockets.size(); i++) {
+        // The lookup, which the callback points to, is about to go
+        sockets[i].sigio(nullptr);
+        if ((int) i == winner) {
+            sockets[i].set_blocking(true);
+        } else if (active[i]) {
+            sockets[i].close();
+        }
+    }
+
+    delete[] targets;
+    delete[] active;
+    lookup->finish(this);
+
+    return winner >= 0 ? winner : result;
+}
@@ -18,6 +18,7 @@
 #include "netsocket/NetworkStack.h"
 #include "netsocket/nsapi_dns.h"
 #include "stddef.h"
+#include <string.h>
 #include <new>
 #include "events/EventQueue.h"
 #include "events/mbed_shared_queues.h"
@@ -181,6 +182,132 @@ nsapi_error_t NetworkStack::getstackopt(int level, int optname, void *optval, un
     return NSAPI_ERROR_UNSUPPORTED;
 }
 
+nsapi_size_or_error_t NetworkStack::socket_sendmsg(nsapi_socket_t handle, const SocketAddress *address,
+                                                   mbed::Span<const nsapi_iovec_t> iov)
+{
+    nsapi_size_t size = 0;
+    nsapi_size_or_error_t ret;
+
+    if (!address) {
+        // A stream has no message boundaries, send the buffers in turn
+        for (const nsapi_iovec_t &v : iov) {
+            if (v.iov_len == 0) {
+                continue;
+            }
+            ret = socket_send(handle, v.iov_base, v.iov_len);
+            if (ret < 0) {
+                return size ? size : ret;
+            }
+            size += ret;
+            if ((size_t)ret < v.iov_len) {
+                break;
+            }
+        }
+        return size;
+    }
+
+    if (iov.size() == 1) {
+        return socket_sendto(handle, *address, iov[0].iov_base, iov[0].iov_len);
+    }
+
+    // A datagram must go in one piece
+    for (const nsapi_iovec_t &v : iov) {
+        size += v.iov_len;
+    }
+    uint8_t *data = new (std::nothrow) uint8_t[size ? size : 1];
+    if (!data) {
+        return NSAPI_ERROR_NO_MEMORY;
+    }
+    uint8_t *ptr = data;
+    for (const nsapi_iovec_t &v : iov) {
+        memcpy(ptr, v.iov_base, v.iov_len);
+        ptr += v.iov_len;
+    }
+
+    ret = socket_sendto(handle, *address, data, size);
+    delete[] data;
+    return ret;
+}
+
+nsapi_size_or_error_t NetworkStack::socket_recvmsg(nsapi_socket_t handle, SocketAddress *address,
+                                                   mbed::Span<const nsapi_iovec_t> iov)
+{
+    nsapi_size_t size = 0;
+    nsapi_size_or_error_t ret;
+
+    if (!address) {
+        for (const nsapi_iovec_t &v : iov) {
+            if (v.iov_len == 0) {
+                continue;
+            }
+            ret = socket_recv(handle, v.iov_base, v.iov_len);
+            if (ret < 0) {
+                return size ? size : ret;
+            }
+            size += ret;
+            if ((size_t)ret < v.iov_len) {
+                break;
+            }
+        }
+        return size;
+    }
+
+    if (iov.size() == 1) {
+        return socket_recvfrom(handle, address, iov[0].iov_base, iov[0].iov_len);
+    }
+
+    for (const nsapi_iovec_t &v : iov) {
+        size += v.iov_len;
+    }
+    uint8_t *data = new (std::nothrow) uint8_t[size ? size : 1];
+    if (!data) {
+        return NSAPI_ERROR_NO_MEMORY;
+    }
+
+    ret = socket_recvfrom(handle, address, data, size);
+    const uint8_t *ptr = data;
+    nsapi_size_t left = ret > 0 ? ret : 0;
+    for (const nsapi_iovec_t &v : iov) {
+        size_t len = v.iov_len < left ? v.iov_len : left;
+        memcpy(v.iov_base, ptr, len);
+        ptr += len;
+        left -= len;
+    }
+    delete[] data;
+    return ret;
+}
+
+nsapi_size_or_error_t NetworkStack::socket_recvfrom_batch(nsapi_socket_t handle,
+                                                          mbed::Span<nsapi_datagram_t> datagrams)
+{
+    nsapi_size_or_error_t count = 0;
+
+    for (nsapi_datagram_t &d : datagrams) {
+        nsapi_size_or_error_t ret = socket_recvfrom(handle, &d.address, d.data, d.size);
+        if (ret < 0) {
+            return count ? count : ret;
+        }
+        d.len = ret;
+        count++;
+    }
+    return count;
+}
+
+NetStackMemoryManager *NetworkStack::get_memory_manager()
+{
+    return NULL;
+}
+
+nsapi_size_or_error_t NetworkStack::socket_send_buf(nsapi_socket_t handle, net_stack_mem_buf_t *buf)
+{
+    return NSAPI_ERROR_UNSUPPORTED;
+}
+
+nsapi_size_or_error_t NetworkStack::socket_recv_buf(nsapi_socket_t handle, net_stack_mem_buf_t **buf)
+{
+    return NSAPI_ERROR_UNSUPPORTED;
+}
+
 nsapi_error_t NetworkStack::setsockopt(void *handle, int level, int optname, const void *optval, unsigned optlen)
 {
     return NSAPI_ERROR_UNSUPPORTED;
@@ -0,0 +1,81 @@
+/* Socket
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "netsocket/Socket.h"
+#include <string.h>
+#include <new>
+
+// Default Socket operations
+
+nsapi_size_or_error_t Socket::sendmsg(const SocketAddress *address, mbed::Span<const nsapi_iovec_t> iov)
+{
+    const void *data = NULL;
+    uint8_t *copy = NULL;
+    nsapi_size_t size = 0;
+
+    for (const nsapi_iovec_t &v : iov) {
+        size += v.iov_len;
+    }
+
+    if (iov.size() == 1) {
+        data = iov[0].iov_base;
+    } else if (size) {
+        copy = new (std::nothrow) uint8_t[size];
+        if (!copy) {
+            return NSAPI_ERROR_NO_MEMORY;
+        }
+        uint8_t *ptr = copy;
+        for (const nsapi_iovec_t &v : iov) {
+            memcpy(ptr, v.iov_base, v.iov_len);
+            ptr += v.iov_len;
+        }
+        data = copy;
+    }
+
+    nsapi_size_or_error_t ret = address ? sendto(*address, data, size) : send(data, size);
+    delete[] copy;
+    return ret;
+}
+
+nsapi_size_or_error_t Socket::recvmsg(SocketAddress *address, mbed::Span<const nsapi_iovec_t> iov)
+{
+    if (iov.size() == 1) {
+        return recvfrom(address, iov[0].iov_base, iov[0].iov_len);
+    }
+
+    nsapi_size_t size = 0;
+    for (const nsapi_iovec_t &v : iov) {
+        size += v.iov_len;
+    }
+
+    uint8_t *copy = new (std::nothrow) uint8_t[size ? size : 1];
+    if (!copy) {
+        return NSAPI_ERROR_NO_MEMORY;
+    }
+
+    nsapi_size_or_error_t ret = recvfrom(address, copy, size);
+    const uint8_t *ptr = copy;
+    nsapi_size_t left = ret > 0 ? ret : 0;
+    for (const nsapi_iovec_t &v : iov) {
+        size_t len = v.iov_len < left ? v.iov_len : left;
+        memcpy(v.iov_base, ptr, len);
+        ptr += len;
+        left -= len;
+    }
+    delete[] copy;
+    return ret;
+}
@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "netsocket/SocketSet.h"
+
+using namespace std::chrono;
+using rtos::Kernel::Clock;
+
+// The top bit of an event flags value marks an error
+static_assert(MBED_CONF_NSAPI_SOCKET_SET_SIZE > 0 && MBED_CONF_NSAPI_SOCKET_SET_SIZE <= 31,
+              "nsapi.socket-set-size must be between 1 and 31");
+
+const int SocketSet::MAX_SOCKETS;
+
+void SocketSet::Entry::event()
+{
+    set->_flags.set(flag);
+}
+
+SocketSet::SocketSet() : _mask(0)
+{
+    for (int i = 0; i < MAX_SOCKETS; i++) {
+        _entries[i].set = this;
+        _entries[i].socket = NULL;
+        _entries[i].flag = 1u << i;
+    }
+}
+
+SocketSet::~SocketSet()
+{
+    for (int i = 0; i < MAX_SOCKETS; i++) {
+        if (_entries[i].socket) {
+            _entries[i].socket->sigio(nullptr);
+        }
+    }
+}
+
+SocketSet::Entry *SocketSet::find(Socket *socket)
+{
+    for (int i = 0; i < MAX_SOCKETS; i++) {
+        if (_entries[i].socket == socket) {
+            return &_entries[i];
+        }
+    }
+    return NULL;
+}
+
+nsapi_error_t SocketSet::add(Socket *socket)
+{
+    if (!socket) {
+        return NSAPI_ERROR_PARAMETER;
+    }
+
+    _mutex.lock();
+    if (find(socket)) {
+        _mutex.unlock();
+        return NSAPI_ERROR_PARAMETER;
+    }
+    Entry *entry = find(NULL);
+    if (!entry) {
+        _mutex.unlock();
+        return NSAPI_ERROR_NO_MEMORY;
+    }
+    entry->socket = socket;
+    _mask |= entry->flag;
+    _mutex.unlock();
+
+    socket->sigio(mbed::callback(entry, &Entry::event));
+    // Events before the socket was added were not seen, so report it once
+    _flags.set(entry->flag);
+
+    return NSAPI_ERROR_OK;
+}
+
+nsapi_error_t SocketSet::remove(Socket *socket)
+{
+    if (!socket) {
+        return NSAPI_ERROR_NO_SOCKET;
+    }
+
+    _mutex.lock();
+    Entry *entry = find(socket);
+    if (!entry) {
+        _mutex.unlock();
+        return NSAPI_ERROR_NO_SOCKET;
+    }
+    socket->sigio(nullptr);
+    entry->socket = NULL;
+    _mask &= ~entry->flag;
+    _flags.clear(entry->flag);
+    _mutex.unlock();
+
+    return NSAPI_ERROR_OK;
+}
+
+int SocketSet::size() const
+{
+    int count = 0;
+
+    _mutex.lock();
+    for (int i = 0; i < MAX_SOCKETS; i++) {
+        if (_entries[i].socket) {
+            count++;
+        }
+    }
+    _mutex.unlock();
+
+    return count;
+}
+
+nsapi_size_or_error_t SocketSet::wait(mbed::Span<Socket *> ready, Clock::duration_u32 timeout)
+{
+    if (ready.empty()) {
+        return NSAPI_ERROR_PARAMETER;
+    }
+
+    const bool forever = timeout == rtos::Kernel::wait_for_u32_forever;
+    const Clock::time_point deadline = Clock::now() + timeout;
+
+    while (true) {
+        _mutex.lock();
+        uint32_t mask = _mask;
+        _mutex.unlock();
+
+        if (!mask) {
+            return NSAPI_ERROR_NO_SOCKET;
+        }
+
+        Clock::duration_u32 remaining = timeout;
+        if (!forever) {
+            Clock::time_point now = Clock::now();
+            remaining = now < deadline ? duration_cast<Clock::duration_u32>(deadline - now) : Clock::duration_u32(0);
+        }
+
+        uint32_t flags = _flags.wait_any_for(mask, remaining);
+        if (flags & osFlagsError) {
+            return NSAPI_ERROR_WOULD_BLOCK;
+        }
+
+        nsapi_size_or_error_t count = 0;
+        uint32_t unreported = 0;
+
+        _mutex.lock();
+        for (int i = 0; i < MAX_SOCKETS; i++) {
+            Entry &entry = _entries[i];
+            // The socket may have been removed since the wait returned
+            if (!(flags & entry.flag) || !entry.socket) {
+                continue;
+            }
+            if (count < (nsapi_size_or_error_t) ready.size()) {
+                ready[count++] = entry.socket;
+            } else {
+                unreported |= entry.flag;
+            }
+        }
+        _mutex.unlock();
+
+        if (unreported) {
+            _flags.set(unreported);
+        }
+        if (count) {
+            return count;
+        }
+    }
+}
@@ -27,8 +27,47 @@
 #if MBED_CONF_NSAPI_SOCKET_STATS_ENABLED
 SingletonPtr<PlatformMutex> SocketStats::_mutex;
 mbed_stats_socket_t SocketStats::_stats[MBED_CONF_NSAPI_SOCKET_STATS_MAX_COUNT];
+SocketStats::rate_window SocketStats::_sent_rate[MBED_CONF_NSAPI_SOCKET_STATS_MAX_COUNT];
+SocketStats::rate_window SocketStats::_recv_rate[MBED_CONF_NSAPI_SOCKET_STATS_MAX_COUNT];
 uint32_t SocketStats::_size = 0;
 
+static uint32_t stats_now()
+{
+#ifdef MBED_CONF_RTOS_PRESENT
+    return rtos::Kernel::get_ms_count();
+#else
+    return 0;
+#endif
+}
+
+void SocketStats::rate_add(rate_window &rate, uint32_t now, size_t bytes)
+{
+    const uint32_t window = MBED_CONF_NSAPI_SOCKET_STATS_RATE_WINDOW_MS;
+    uint32_t elapsed = now - rate.start;
+
+    if (elapsed >= 2 * window) {
+        rate.previous = 0;
+        rate.current = 0;
+        rate.start = now;
+    } else if (elapsed >= window) {
+        rate.previous = rate.current;
+        rate.current = 0;
+        rate.start += window;
+    }
+    rate.current += bytes;
+}
+
+uint32_t SocketStats::rate_get(rate_window rate, uint32_t now)
+{
+    const uint32_t window = MBED_CONF_NSAPI_SOCKET_STATS_RATE_WINDOW_MS;
+
+    rate_add(rate, now, 0);
+    // The sliding window still covers the end of the previous window
+    uint64_t bytes = (uint64_t)rate.previous * (window - (now - rate.start)) / window + rate.current;
+
+    return bytes * 1000 / window;
+}
+
 int SocketStats::get_entry_position(const Socket *const reference_id)
 {
     for (uint32_t j = 0; j < _size; j++) {
@@ -43,9 +82,12 @@ size_t SocketStats::mbed_stats_socket_get_each(mbed_stats_socket_t *stats, size_
 {
     MBED_ASSERT(stats != NULL);
     size_t j;
+    uint32_t now = stats_now();
     _mutex->lock();
     for (j = 0; j < count && j < _size; j++) {
         stats[j] = _stats[j];
+        stats[j].sent_bps = rate_get(_sent_rate[j], now);
+        stats[j].recv_bps = rate_get(_recv_rate[j], now);
     }
     _mutex->unlock();
     return j;
@@ -60,6 +102,8 @@ void SocketStats::stats_new_socket_entry(Socket *const reference_id)
     } else if (_size < MBED_CONF_NSAPI_SOCKET_STATS_MAX_COUNT) {
         // Add new entry
         _stats[_size].reference_id = reference_id;
+        _sent_rate[_size] = {};
+        _recv_rate[_size] = {};
         _size++;
     } else {
         int position = -1;
@@ -78,6 +122,8 @@ void SocketStats::stats_new_socket_entry(Socket *const reference_id)
         }
         _stats[position] = {};
         _stats[position].reference_id = reference_id;
+        _sent_rate[position] = {};
+        _recv_rate[position] = {};
     }
     _mutex->unlock();
 }
@@ -121,6 +167,7 @@ void SocketStats::stats_update_sent_bytes(const Socket *const reference_id, size
     int position = get_entry_position(reference_id);
     if ((position >= 0) && ((int32_t)sent_bytes > 0)) {
         _stats[position].sent_bytes += sent_bytes;
+        rate_add(_sent_rate[position], stats_now(), sent_bytes);
     }
     _mutex->unlock();
 }
@@ -131,6 +178,45 @@ void SocketStats::stats_update_recv_bytes(const Socket *const reference_id, size
     int position = get_entry_position(reference_id);
     if ((position >= 0) && ((int32_t)recv_bytes > 0)) {
         _stats[position].recv_bytes += recv_bytes;
+        rate_add(_recv_rate[position], stats_now(), recv_bytes);
+    }
+    _mutex->unlock();
+}
+
+void SocketStats::stats_update_send_blocked_time(const Socket *const reference_id, uint32_t blocked_ms)
+{
+    _mutex->lock();
+    int position = get_entry_position(reference_id);
+    if (position >= 0) {
+        _stats[position].send_blocked_ms += blocked_ms;
+    }
+    _mutex->unlock();
+}
+
+void SocketStats::stats_update_recv_blocked_time(const Socket *const reference_id, uint32_t blocked_ms)
+{
+    _mutex->lock();
+    int position = get_entry_position(reference_id);
+    if (position >= 0) {
+        _stats[position].recv_blocked_ms += blocked_ms;
+    }
+    _mutex->unlock();
+}
+
+void SocketStats::stats_update_tcp_info(const Socket *const reference_id, const nsapi_tcp_info_t &info)
+{
+    _mutex->lock();
+    int position = get_entry_position(reference_id);
+    if (position >= 0) {
+        _stats[position].send_queue = info.send_queue;
+        if (info.rtt_ms) {
+            int bucket = 0;
+            while (bucket < MBED_STATS_SOCKET_RTT_BUCKETS - 1 && info.rtt_ms >= (uint32_t)MBED_STATS_SOCKET_RTT_BUCKET_MS << bucket) {
+                bucket++;
+            }
+            _stats[position].rtt_ms = info.rtt_ms;
+            _stats[position].rtt_histogram[bucket]++;
+        }
     }
     _mutex->unlock();
 }
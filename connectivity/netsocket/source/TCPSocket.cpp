@@ -34,6 +34,18 @@ TCPSocket::TCPSocket(TCPSocket *parent, nsapi_socket_t socket, SocketAddress add
     _stack->socket_attach(socket, _event.thunk, &_event);
 }
 
+void TCPSocket::update_tcp_info()
+{
+#if MBED_CONF_NSAPI_SOCKET_STATS_ENABLED
+    nsapi_tcp_info_t info;
+    unsigned optlen = sizeof(info);
+
+    if (_socket && _stack->getsockopt(_socket, NSAPI_SOCKET, NSAPI_TCP_INFO, &info, &optlen) == NSAPI_ERROR_OK) {
+        _socket_stats.stats_update_tcp_info(this, info);
+    }
+#endif
+}
+
 nsapi_protocol_t TCPSocket::get_proto()
 {
     return NSAPI_TCP;
@@ -138,7 +150,7 @@ nsapi_size_or_error_t TCPSocket::send(const void *data, nsapi_size_t size)
             // Release lock before blocking so other threads
             // accessing this object aren't blocked
             _lock.unlock();
-            flag = _event_flag.wait_any(WRITE_FLAG, _timeout);
+            flag = wait_for_event(WRITE_FLAG);
             _lock.lock();
 
             if (flag & osFlagsError) {
@@ -150,6 +162,10 @@ nsapi_size_or_error_t TCPSocket::send(const void *data, nsapi_size_t size)
         }
     }
 
+    if (written > 0) {
+        update_tcp_info();
+    }
+
     _writers--;
     if (!_socket) {
         _event_flag.set(FINISHED_FLAG);
@@ -166,12 +182,208 @@ nsapi_size_or_error_t TCPSocket::send(const void *data, nsapi_size_t size)
     }
 }
 
+NetStackMemoryManager *TCPSocket::get_memory_manager()
+{
+    _lock.lock();
+    NetStackMemoryManager *manager = _stack ? _stack->get_memory_manager() : NULL;
+    _lock.unlock();
+    return manager;
+}
+
+nsapi_size_or_error_t TCPSocket::send_buf(net_stack_mem_buf_t *buf)
+{
+    _lock.lock();
+    nsapi_size_or_error_t ret;
+
+    // If this assert is hit then there are two threads
+    // performing a send at the same time which is undefined
+    // behavior
+    MBED_ASSERT(_writers == 0);
+    _writers++;
+
+    while (true) {
+        if (!_socket) {
+            ret = NSAPI_ERROR_NO_SOCKET;
+            break;
+        }
+
+        core_util_atomic_flag_clear(&_pending);
+        ret = _stack->socket_send_buf(_socket, buf);
+        if ((_timeout == 0) || (ret != NSAPI_ERROR_WOULD_BLOCK)) {
+            break;
+        } else {
+            uint32_t flag;
+
+            // Release lock before blocking so other threads
+            // accessing this object aren't blocked
+            _lock.unlock();
+            flag = wait_for_event(WRITE_FLAG);
+            _lock.lock();
+
+            if (flag & osFlagsError) {
+                // Timeout break
+                break;
+            }
+        }
+    }
+
+    if (ret > 0) {
+        update_tcp_info();
+    }
+
+    _writers--;
+    if (!_socket) {
+        _event_flag.set(FINISHED_FLAG);
+    }
+
+    _lock.unlock();
+    if (ret > 0) {
+        _socket_stats.stats_update_sent_bytes(this, ret);
+    }
+    return ret;
+}
+
+nsapi_size_or_error_t TCPSocket::recv_buf(net_stack_mem_buf_t **buf)
+{
+    _lock.lock();
+    nsapi_size_or_error_t ret;
+
+    // If this assert is hit then there are two threads
+    // performing a recv at the same time which is undefined
+    // behavior
+    MBED_ASSERT(_readers == 0);
+    _readers++;
+
+    while (true) {
+        if (!_socket) {
+            ret = NSAPI_ERROR_NO_SOCKET;
+            break;
+        }
+
+        core_util_atomic_flag_clear(&_pending);
+        ret = _stack->socket_recv_buf(_socket, buf);
+        if ((_timeout == 0) || (ret != NSAPI_ERROR_WOULD_BLOCK)) {
+            _socket_stats.stats_update_recv_bytes(this, ret);
+            break;
+        } else {
+            uint32_t flag;
+
+            // Release lock before blocking so other threads
+            // accessing this object aren't blocked
+            _lock.unlock();
+            flag = wait_for_event(READ_FLAG);
+            _lock.lock();
+
+            if (flag & osFlagsError) {
+                // Timeout break
+                ret = NSAPI_ERROR_WOULD_BLOCK;
+                break;
+            }
+        }
+    }
+
+    _readers--;
+    if (!_socket) {
+        _event_flag.set(FINISHED_FLAG);
+    }
+
+    _lock.unlock();
+    return ret;
+}
+
 nsapi_size_or_error_t TCPSocket::sendto(const SocketAddress &address, const void *data, nsapi_size_t size)
 {
     (void)address;
     return send(data, size);
 }
 
+nsapi_size_or_error_t TCPSocket::sendmsg(const SocketAddress *address, mbed::Span<const nsapi_iovec_t> iov)
+{
+    (void)address;
+    _lock.lock();
+    nsapi_size_or_error_t ret;
+    nsapi_size_t written = 0;
+    nsapi_size_t size = 0;
+    ptrdiff_t index = 0;    // First buffer not sent entirely
+    size_t offset = 0;      // Bytes of that buffer already sent
+
+    for (const nsapi_iovec_t &v : iov) {
+        size += v.iov_len;
+    }
+
+    // If this assert is hit then there are two threads
+    // performing a send at the same time which is undefined
+    // behavior
+    MBED_ASSERT(_writers == 0);
+    _writers++;
+
+    // Like send, write the whole thing if blocking
+    while (true) {
+        if (!_socket) {
+            ret = NSAPI_ERROR_NO_SOCKET;
+            break;
+        }
+
+        mbed::Span<const nsapi_iovec_t> pending = iov.subspan(index);
+        nsapi_iovec_t head;
+        if (offset) {
+            // Finish the buffer sent in part before moving on to the rest
+            head.iov_base = static_cast<uint8_t *>(iov[index].iov_base) + offset;
+            head.iov_len = iov[index].iov_len - offset;
+            pending = mbed::Span<const nsapi_iovec_t>(&head, 1);
+        }
+
+        core_util_atomic_flag_clear(&_pending);
+        ret = _stack->socket_sendmsg(_socket, NULL, pending);
+        if (ret >= 0) {
+            written += ret;
+            if (written >= size) {
+                break;
+            }
+            for (offset += ret; index < iov.size() && offset >= iov[index].iov_len; index++) {
+                offset -= iov[index].iov_len;
+            }
+        }
+        if (_timeout == 0) {
+            break;
+        } else if (ret == NSAPI_ERROR_WOULD_BLOCK) {
+            uint32_t flag;
+
+            // Release lock before blocking so other threads
+            // accessing this object aren't blocked
+            _lock.unlock();
+            flag = wait_for_event(WRITE_FLAG);
+            _lock.lock();
+
+            if (flag & osFlagsError) {
+                // Timeout break
+                break;
+            }
+        } else if (ret < 0) {
+            break;
+        }
+    }
+
+    if (written > 0) {
+        update_tcp_info();
+    }
+
+    _writers--;
+    if (!_socket) {
+        _event_flag.set(FINISHED_FLAG);
+    }
+
+    _lock.unlock();
+    if (ret <= 0 && ret != NSAPI_ERROR_WOULD_BLOCK) {
+        return ret;
+    } else if (written == 0) {
+        return NSAPI_ERROR_WOULD_BLOCK;
+    } else {
+        _socket_stats.stats_update_sent_bytes(this, written);
+        return written;
+    }
+}
+
 nsapi_size_or_error_t TCPSocket::recv(void *data, nsapi_size_t size)
 {
     _lock.lock();
@@ -200,7 +412,7 @@ nsapi_size_or_error_t TCPSocket::recv(void *data, nsapi_size_t size)
             // Release lock before blocking so other threads
             // accessing this object aren't blocked
             _lock.unlock();
-            flag = _event_flag.wait_any(READ_FLAG, _timeout);
+            flag = wait_for_event(READ_FLAG);
             _lock.lock();
 
             if (flag & osFlagsError) {
@@ -228,6 +440,58 @@ nsapi_size_or_error_t TCPSocket::recvfrom(SocketAddress *address, void *data, ns
     return recv(data, size);
 }
 
+nsapi_size_or_error_t TCPSocket::recvmsg(SocketAddress *address, mbed::Span<const nsapi_iovec_t> iov)
+{
+    _lock.lock();
+    nsapi_size_or_error_t ret;
+
+    if (address) {
+        *address = _remote_peer;
+    }
+
+    // If this assert is hit then there are two threads
+    // performing a recv at the same time which is undefined
+    // behavior
+    MBED_ASSERT(_readers == 0);
+    _readers++;
+
+    while (true) {
+        if (!_socket) {
+            ret = NSAPI_ERROR_NO_SOCKET;
+            break;
+        }
+
+        core_util_atomic_flag_clear(&_pending);
+        ret = _stack->socket_recvmsg(_socket, NULL, iov);
+        if ((_timeout == 0) || (ret != NSAPI_ERROR_WOULD_BLOCK)) {
+            _socket_stats.stats_update_recv_bytes(this, ret);
+            break;
+        } else {
+            uint32_t flag;
+
+            // Release lock before blocking so other threads
+            // accessing this object aren't blocked
+            _lock.unlock();
+            flag = wait_for_event(READ_FLAG);
+            _lock.lock();
+
+            if (flag & osFlagsError) {
+                // Timeout break
+                ret = NSAPI_ERROR_WOULD_BLOCK;
+                break;
+            }
+        }
+    }
+
+    _readers--;
+    if (!_socket) {
+        _event_flag.set(FINISHED_FLAG);
+    }
+
+    _lock.unlock();
+    return ret;
+}
+
 nsapi_error_t TCPSocket::listen(int backlog)
 {
     _lock.lock();
@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "netsocket/TLSCAChain.h"
+#include "mbedtls/asn1.h"
+
+#include <string.h>
+
+#if defined(MBEDTLS_X509_CRT_PARSE_C)
+
+TLSCAChain::TLSCAChain()
+{
+    mbedtls_x509_crt_init(&_crt);
+}
+
+TLSCAChain::~TLSCAChain()
+{
+    mbedtls_x509_crt_free(&_crt);
+}
+
+nsapi_error_t TLSCAChain::parse(const void *ca, size_t len)
+{
+    if (mbedtls_x509_crt_parse(&_crt, static_cast<const unsigned char *>(ca), len) != 0) {
+        return NSAPI_ERROR_PARAMETER;
+    }
+    _parsed = true;
+    return NSAPI_ERROR_OK;
+}
+
+nsapi_error_t TLSCAChain::parse(const char *ca_pem)
+{
+    return parse(ca_pem, strlen(ca_pem) + 1);
+}
+
+nsapi_error_t TLSCAChain::parse_der_nocopy(const void *ca_der, size_t len)
+{
+    unsigned char *p = static_cast<unsigned char *>(const_cast<void *>(ca_der));
+    const unsigned char *end = p + len;
+
+    if (!len) {
+        return NSAPI_ERROR_PARAMETER;
+    }
+
+    // Each certificate is a SEQUENCE, its header gives where the next starts
+    while (p < end) {
+        const unsigned char *crt = p;
+        size_t crt_len;
+        if (mbedtls_asn1_get_tag(&p, end, &crt_len, MBEDTLS_ASN1_CONSTRUCTED | MBEDTLS_ASN1_SEQUENCE) != 0) {
+            return NSAPI_ERROR_PARAMETER;
+        }
+        p += crt_len;
+        if (mbedtls_x509_crt_parse_der_nocopy(&_crt, crt, p - crt) != 0) {
+            return NSAPI_ERROR_PARAMETER;
+        }
+        _parsed = true;
+    }
+    return NSAPI_ERROR_OK;
+}
+
+#endif /* MBEDTLS_X509_CRT_PARSE_C */
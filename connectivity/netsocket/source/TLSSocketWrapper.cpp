@@ -30,6 +30,162 @@
 // This class requires Mbed TLS SSL/TLS client code
 #if defined(MBEDTLS_SSL_CLI_C)
 
+// The cache is keyed by the hostname used for certificate verification
+#if (MBED_CONF_NSAPI_TLS_SESSION_CACHE_SIZE > 0) && defined(MBEDTLS_X509_CRT_PARSE_C) && !defined(MBEDTLS_X509_REMOVE_HOSTNAME_VERIFICATION)
+#define TLS_SESSION_CACHE_ENABLED 1
+#include "platform/PlatformMutex.h"
+#include "platform/SingletonPtr.h"
+
+struct TLS_SESSION_CACHE {
+    char *host;
+    uint32_t last_used;
+    mbedtls_ssl_session session;
+};
+
+static TLS_SESSION_CACHE tls_session_cache[MBED_CONF_NSAPI_TLS_SESSION_CACHE_SIZE];
+static uint32_t tls_session_cache_clock;
+static SingletonPtr<PlatformMutex> tls_session_cache_mutex;
+
+static TLS_SESSION_CACHE *tls_session_cache_find(const char *host)
+{
+    for (int i = 0; i < MBED_CONF_NSAPI_TLS_SESSION_CACHE_SIZE; i++) {
+        if (tls_session_cache[i].host && strcmp(tls_session_cache[i].host, host) == 0) {
+            return &tls_session_cache[i];
+        }
+    }
+    return nullptr;
+}
+
+static void tls_session_cache_free(TLS_SESSION_CACHE *entry)
+{
+    mbedtls_ssl_session_free(&entry->session);
+    delete[] entry->host;
+    entry->host = nullptr;
+}
+
+// Request resumption of the session cached for host, if any
+static void tls_session_cache_resume(mbedtls_ssl_context *ssl, const char *host)
+{
+    tls_session_cache_mutex->lock();
+    TLS_SESSION_CACHE *entry = tls_session_cache_find(host);
+    if (entry) {
+        entry->last_used = ++tls_session_cache_clock;
+        int ret = mbedtls_ssl_set_session(ssl, &entry->session);
+        if (ret != 0) {
+            tr_warning("mbedtls_ssl_set_session() failed: -0x%04X", -ret);
+        } else {
+            tr_debug("Resuming cached session with %s", host);
+        }
+    }
+    tls_session_cache_mutex->unlock();
+}
+
+// Cache the session established with host, replacing the least recently used one
+static void tls_session_cache_store(const mbedtls_ssl_context *ssl, const char *host)
+{
+    tls_session_cache_mutex->lock();
+    TLS_SESSION_CACHE *entry = tls_session_cache_find(host);
+    if (entry) {
+        mbedtls_ssl_session_free(&entry->session);
+    } else {
+        entry = &tls_session_cache[0];
+        for (int i = 0; i < MBED_CONF_NSAPI_TLS_SESSION_CACHE_SIZE; i++) {
+            if (!tls_session_cache[i].host) {
+                entry = &tls_session_cache[i];
+                break;
+            }
+            if (tls_session_cache[i].last_used < entry->last_used) {
+                entry = &tls_session_cache[i];
+            }
+        }
+        if (entry->host) {
+            tls_session_cache_free(entry);
+        }
+        entry->host = new (std::nothrow) char[strlen(host) + 1];
+        if (!entry->host) {
+            tls_session_cache_mutex->unlock();
+            return;
+        }
+        strcpy(entry->host, host);
+    }
+
+    entry->last_used = ++tls_session_cache_clock;
+    if (mbedtls_ssl_get_session(ssl, &entry->session) != 0) {
+        tls_session_cache_free(entry);
+    }
+    tls_session_cache_mutex->unlock();
+}
+#endif
+
+#if defined(MBEDTLS_SSL_MAX_FRAGMENT_LENGTH)
+static int max_frag_len_code(size_t length)
+{
+    switch (length) {
+        case 0:
+            return MBEDTLS_SSL_MAX_FRAG_LEN_NONE;
+        case 512:
+            return MBEDTLS_SSL_MAX_FRAG_LEN_512;
+        case 1024:
+            return MBEDTLS_SSL_MAX_FRAG_LEN_1024;
+        case 2048:
+            return MBEDTLS_SSL_MAX_FRAG_LEN_2048;
+        case 4096:
+            return MBEDTLS_SSL_MAX_FRAG_LEN_4096;
+        default:
+            return -1;
+    }
+}
+#endif
+
+#if defined(MBED_CONF_NSAPI_TLS_CIPHER_ORDER)
+static size_t cipher_rank(int suite)
+{
+    static const mbedtls_cipher_type_t order[] = { MBED_CONF_NSAPI_TLS_CIPHER_ORDER };
+    const mbedtls_ssl_ciphersuite_t *info = mbedtls_ssl_ciphersuite_from_id(suite);
+
+    size_t rank = 0;
+    while (rank < sizeof(order) / sizeof(order[0]) && (!info || info->cipher != order[rank])) {
+        rank++;
+    }
+    return rank;
+}
+
+/* The enabled suites sorted by the rank of their cipher, keeping the
+ * Mbed TLS order within a rank. Built once and shared by all sockets */
+static int *build_ciphersuites()
+{
+    const int *list = mbedtls_ssl_list_ciphersuites();
+    size_t count = 0;
+    size_t max_rank = 0;
+    while (list[count]) {
+        size_t rank = cipher_rank(list[count++]);
+        if (rank > max_rank) {
+            max_rank = rank;
+        }
+    }
+
+    int *suites = new (std::nothrow) int[count + 1];
+    if (suites) {
+        size_t n = 0;
+        for (size_t rank = 0; rank <= max_rank; rank++) {
+            for (size_t i = 0; i < count; i++) {
+                if (cipher_rank(list[i]) == rank) {
+                    suites[n++] = list[i];
+                }
+            }
+        }
+        suites[n] = 0;
+    }
+    return suites;
+}
+
+static const int *ordered_ciphersuites()
+{
+    static const int *suites = build_ciphersuites();
+    return suites;
+}
+#endif
+
 TLSSocketWrapper::TLSSocketWrapper(Socket *transport, const char *hostname, control_transport control) :
     _transport(transport),
     _connect_transport(control == TRANSPORT_CONNECT || control == TRANSPORT_CONNECT_AND_CLOSE),
@@ -69,6 +225,11 @@ TLSSocketWrapper::~TLSSocketWrapper()
     DRBG_FREE(&_drbg);
 
     mbedtls_ssl_free(&_ssl);
+#if defined(TLS_ALLOC_ENABLED)
+    if (_arena) {
+        tls_arena_release(_arena);
+    }
+#endif
 #if defined(MBEDTLS_X509_CRT_PARSE_C)
     mbedtls_pk_free(&_pkctx);
     set_own_cert(nullptr);
@@ -121,6 +282,26 @@ nsapi_error_t TLSSocketWrapper::set_root_ca_cert(const char *root_ca_pem)
     return set_root_ca_cert(root_ca_pem, strlen(root_ca_pem) + 1);
 }
 
+nsapi_error_t TLSSocketWrapper::set_root_ca_cert_nocopy(const void *root_ca_der, size_t len)
+{
+#if !defined(MBEDTLS_X509_CRT_PARSE_C)
+    return NSAPI_ERROR_UNSUPPORTED;
+#else
+    TLSCAChain *chain = new (std::nothrow) TLSCAChain;
+    if (!chain) {
+        return NSAPI_ERROR_NO_MEMORY;
+    }
+
+    mbed::SharedPtr<TLSCAChain> ca(chain);
+    nsapi_error_t ret = chain->parse_der_nocopy(root_ca_der, len);
+    if (ret != NSAPI_ERROR_OK) {
+        return ret;
+    }
+    set_ca_chain(ca);
+    return NSAPI_ERROR_OK;
+#endif
+}
+
 nsapi_error_t TLSSocketWrapper::set_client_cert_key(const char *client_cert_pem, const char *client_private_key_pem)
 {
     return set_client_cert_key(client_cert_pem, strlen(client_cert_pem) + 1, client_private_key_pem, strlen(client_private_key_pem) + 1);
@@ -210,12 +391,44 @@ nsapi_error_t TLSSocketWrapper::start_handshake(bool first_call)
     mbedtls_debug_set_threshold(MBED_CONF_TLS_SOCKET_DEBUG_LEVEL);
 #endif
 
+#if defined(TLS_ALLOC_ENABLED)
+    /* mbedtls_ssl_setup() allocates the handshake state too */
+    _arena = tls_arena_new();
+    if (_arena) {
+        tls_arena_enter(_arena);
+    }
+#endif
+
     tr_debug("mbedtls_ssl_setup()");
-    if ((ret = mbedtls_ssl_setup(&_ssl, get_ssl_config())) != 0) {
+    ret = mbedtls_ssl_setup(&_ssl, get_ssl_config());
+#if defined(TLS_ALLOC_ENABLED)
+    if (_arena) {
+        tls_arena_leave(_arena);
+    }
+#endif
+    if (ret != 0) {
         print_mbedtls_error("mbedtls_ssl_setup", ret);
         return NSAPI_ERROR_AUTH_FAILURE;
     }
 
+    if ((ret = configure_ssl_context()) != 0) {
+        print_mbedtls_error("configure_ssl_context", ret);
+        return NSAPI_ERROR_AUTH_FAILURE;
+    }
+
+    if (_session) {
+        if ((ret = mbedtls_ssl_set_session(&_ssl, _session)) != 0) {
+            // Not fatal, a full handshake is done instead
+            print_mbedtls_error("mbedtls_ssl_set_session", ret);
+        }
+        _session = nullptr;
+    }
+#if TLS_SESSION_CACHE_ENABLED
+    else if (_ssl.hostname) {
+        tls_session_cache_resume(&_ssl, _ssl.hostname);
+    }
+#endif
+
     _transport->set_blocking(false);
     _transport->sigio(mbed::callback(this, &TLSSocketWrapper::event));
 
@@ -255,7 +468,21 @@ nsapi_error_t TLSSocketWrapper::continue_handshake()
     }
 
     while (true) {
+#if defined(TLS_ALLOC_ENABLED)
+        if (_arena) {
+            tls_arena_enter(_arena);
+        }
+#endif
         ret = mbedtls_ssl_handshake(&_ssl);
+#if defined(TLS_ALLOC_ENABLED)
+        if (_arena) {
+            tls_arena_leave(_arena);
+            if (ret != MBEDTLS_ERR_SSL_WANT_READ && ret != MBEDTLS_ERR_SSL_WANT_WRITE) {
+                tls_arena_release(_arena);
+                _arena = nullptr;
+            }
+        }
+#endif
         if (_timeout && (ret == MBEDTLS_ERR_SSL_WANT_READ || ret == MBEDTLS_ERR_SSL_WANT_WRITE)) {
             uint32_t flag;
             flag = _event_flag.wait_any(1, _timeout);
@@ -272,6 +499,11 @@ nsapi_error_t TLSSocketWrapper::continue_handshake()
         if (ret == MBEDTLS_ERR_SSL_WANT_READ || ret == MBEDTLS_ERR_SSL_WANT_WRITE) {
             return NSAPI_ERROR_ALREADY;
         } else {
+#if TLS_SESSION_CACHE_ENABLED
+            if (_ssl.hostname) {
+                clear_session_cache(_ssl.hostname);
+            }
+#endif
             return NSAPI_ERROR_AUTH_FAILURE;
         }
     }
@@ -303,19 +535,137 @@ nsapi_error_t TLSSocketWrapper::continue_handshake()
     delete[] buf;
 #endif
 
+#if TLS_SESSION_CACHE_ENABLED
+    if (_ssl.hostname) {
+        tls_session_cache_store(&_ssl, _ssl.hostname);
+    }
+#endif
+
     _handshake_completed = true;
     return NSAPI_ERROR_IS_CONNECTED;
 }
 
+nsapi_error_t TLSSocketWrapper::get_session(mbedtls_ssl_session *session)
+{
+    if (!_handshake_completed) {
+        return NSAPI_ERROR_NO_CONNECTION;
+    }
+
+    int ret = mbedtls_ssl_get_session(&_ssl, session);
+    if (ret != 0) {
+        print_mbedtls_error("mbedtls_ssl_get_session", ret);
+        return NSAPI_ERROR_NO_MEMORY;
+    }
+    return NSAPI_ERROR_OK;
+}
 
-nsapi_error_t TLSSocketWrapper::send(const void *data, nsapi_size_t size)
+nsapi_error_t TLSSocketWrapper::set_session(const mbedtls_ssl_session *session)
 {
-    int ret;
+    if (is_handshake_started()) {
+        return NSAPI_ERROR_ALREADY;
+    }
+
+    _session = session;
+    return NSAPI_ERROR_OK;
+}
+
+void TLSSocketWrapper::clear_session_cache(const char *hostname)
+{
+#if TLS_SESSION_CACHE_ENABLED
+    tls_session_cache_mutex->lock();
+    for (int i = 0; i < MBED_CONF_NSAPI_TLS_SESSION_CACHE_SIZE; i++) {
+        if (tls_session_cache[i].host && (!hostname || strcmp(tls_session_cache[i].host, hostname) == 0)) {
+            tls_session_cache_free(&tls_session_cache[i]);
+        }
+    }
+    tls_session_cache_mutex->unlock();
+#endif
+}
 
+nsapi_error_t TLSSocketWrapper::set_max_fragment_length(size_t length)
+{
+#if defined(MBEDTLS_SSL_MAX_FRAGMENT_LENGTH)
+    if (is_handshake_started()) {
+        return NSAPI_ERROR_ALREADY;
+    }
+
+    int code = max_frag_len_code(length);
+    if (code < 0) {
+        return NSAPI_ERROR_PARAMETER;
+    }
+
+    mbedtls_ssl_config *conf = get_ssl_config();
+    if (!conf || mbedtls_ssl_conf_max_frag_len(conf, code) != 0) {
+        return NSAPI_ERROR_PARAMETER;
+    }
+    return NSAPI_ERROR_OK;
+#else
+    (void) length;
+    return NSAPI_ERROR_UNSUPPORTED;
+#endif
+}
+
+nsapi_error_t TLSSocketWrapper::send(const void *data, nsapi_size_t size)
+{
     if (!_transport) {
         return NSAPI_ERROR_NO_SOCKET;
     }
 
+    if (!_cork_buf) {
+        return write(data, size, _timeout);
+    }
+
+    nsapi_error_t ret = continue_handshake();
+    if (ret != NSAPI_ERROR_IS_CONNECTED) {
+        if (ret == NSAPI_ERROR_ALREADY) {
+            ret = NSAPI_ERROR_WOULD_BLOCK;
+        }
+        return ret;
+    }
+
+    // A record carries at most the negotiated fragment length
+    size_t limit = MBED_CONF_NSAPI_TLS_CORK_BUFFER_SIZE;
+    int payload = mbedtls_ssl_get_max_out_record_payload(&_ssl);
+    if (payload > 0 && (size_t) payload < limit) {
+        limit = payload;
+    }
+
+    _cork_mutex.lock();
+    nsapi_size_t done = 0;
+    ret = NSAPI_ERROR_OK;
+    while (true) {
+        if (_cork_len >= limit || _cork_pending) {
+            ret = flush_cork(_timeout);
+            if (ret < 0) {
+                break;
+            }
+        }
+        if (done == size) {
+            break;
+        }
+        size_t n = size - done;
+        if (n > limit - _cork_len) {
+            n = limit - _cork_len;
+        }
+        memcpy(_cork_buf + _cork_len, (const uint8_t *) data + done, n);
+        _cork_len += n;
+        done += n;
+    }
+
+    if (_cork_len && _cork_delay && !_cork_event_id) {
+        _cork_event_id = mbed::mbed_event_queue()->call_in(std::chrono::milliseconds(_cork_delay),
+                                                           this, &TLSSocketWrapper::cork_timer_event);
+    }
+    tr_debug("cork %d, %d buffered", size, (int) _cork_len);
+    _cork_mutex.unlock();
+
+    return done ? done : ret;
+}
+
+nsapi_size_or_error_t TLSSocketWrapper::write(const void *data, nsapi_size_t size, int timeout)
+{
+    int ret;
+
     tr_debug("send %d", size);
     while (true) {
         if (!_handshake_completed) {
@@ -330,11 +680,11 @@ nsapi_error_t TLSSocketWrapper::send(const void *data, nsapi_size_t size)
 
         ret = mbedtls_ssl_write(&_ssl, (const unsigned char *) data, size);
 
-        if (_timeout == 0) {
+        if (timeout == 0) {
             break;
         } else if (ret == MBEDTLS_ERR_SSL_WANT_WRITE || ret == MBEDTLS_ERR_SSL_WANT_READ) {
             uint32_t flag;
-            flag = _event_flag.wait_any(1, _timeout);
+            flag = _event_flag.wait_any(1, timeout);
             if (flag & osFlagsError) {
                 // Timeout break
                 break;
@@ -357,6 +707,86 @@ nsapi_error_t TLSSocketWrapper::send(const void *data, nsapi_size_t size)
     return ret; // Assume "non negative errorcode" to be propagated from Socket layer
 }
 
+nsapi_error_t TLSSocketWrapper::flush_cork(int timeout)
+{
+    nsapi_size_or_error_t ret = NSAPI_ERROR_OK;
+    size_t sent = 0;
+
+    while (sent < _cork_len) {
+        ret = write(_cork_buf + sent, _cork_len - sent, timeout);
+        if (ret <= 0) {
+            break;
+        }
+        sent += ret;
+    }
+
+    if (sent) {
+        memmove(_cork_buf, _cork_buf + sent, _cork_len - sent);
+        _cork_len -= sent;
+    }
+    _cork_pending = (ret == NSAPI_ERROR_WOULD_BLOCK);
+
+    if (!_cork_len && _cork_event_id) {
+        mbed::mbed_event_queue()->cancel(_cork_event_id);
+        _cork_event_id = 0;
+    }
+    return ret < 0 ? ret : NSAPI_ERROR_OK;
+}
+
+void TLSSocketWrapper::cork_timer_event()
+{
+    // A send() in progress sends the buffer itself, or arms the timer again
+    if (!_cork_mutex.trylock()) {
+        return;
+    }
+    _cork_event_id = 0;
+    if (_transport && _cork_len && flush_cork(0) == NSAPI_ERROR_WOULD_BLOCK) {
+        _cork_event_id = mbed::mbed_event_queue()->call_in(std::chrono::milliseconds(_cork_delay),
+                                                           this, &TLSSocketWrapper::cork_timer_event);
+    }
+    _cork_mutex.unlock();
+}
+
+nsapi_error_t TLSSocketWrapper::set_cork(bool enabled, int delay_ms)
+{
+    if (!_transport) {
+        return NSAPI_ERROR_NO_SOCKET;
+    }
+
+    nsapi_error_t ret = NSAPI_ERROR_OK;
+    _cork_mutex.lock();
+    if (enabled) {
+        if (!_cork_buf) {
+            _cork_buf = new (std::nothrow) uint8_t[MBED_CONF_NSAPI_TLS_CORK_BUFFER_SIZE];
+        }
+        if (_cork_buf) {
+            _cork_delay = delay_ms;
+        } else {
+            ret = NSAPI_ERROR_NO_MEMORY;
+        }
+    } else if (_cork_buf) {
+        ret = flush_cork(_timeout);
+        if (ret == NSAPI_ERROR_OK) {
+            delete[] _cork_buf;
+            _cork_buf = nullptr;
+        }
+    }
+    _cork_mutex.unlock();
+    return ret;
+}
+
+nsapi_error_t TLSSocketWrapper::flush()
+{
+    if (!_transport) {
+        return NSAPI_ERROR_NO_SOCKET;
+    }
+
+    _cork_mutex.lock();
+    nsapi_error_t ret = _cork_buf ? flush_cork(_timeout) : NSAPI_ERROR_OK;
+    _cork_mutex.unlock();
+    return ret;
+}
+
 nsapi_size_or_error_t TLSSocketWrapper::sendto(const SocketAddress &, const void *data, nsapi_size_t size)
 {
     // Ignore the SocketAddress
@@ -371,6 +801,14 @@ nsapi_size_or_error_t TLSSocketWrapper::recv(void *data, nsapi_size_t size)
         return NSAPI_ERROR_NO_SOCKET;
     }
 
+    // The peer may wait for the buffered request before answering
+    if (_cork_buf && _cork_len) {
+        ret = flush();
+        if (ret < 0 && ret != NSAPI_ERROR_WOULD_BLOCK) {
+            return ret;
+        }
+    }
+
     while (true) {
         if (!_handshake_completed) {
             ret = continue_handshake();
@@ -558,11 +996,18 @@ void TLSSocketWrapper::set_ca_chain(mbedtls_x509_crt *crt)
         delete _cacert;
         _cacert_allocated = false;
     }
+    _shared_cacert = nullptr;
     _cacert = crt;
     tr_debug("mbedtls_ssl_conf_ca_chain()");
     mbedtls_ssl_conf_ca_chain(get_ssl_config(), _cacert, nullptr);
 }
 
+void TLSSocketWrapper::set_ca_chain(mbed::SharedPtr<TLSCAChain> chain)
+{
+    set_ca_chain(chain ? chain->get_crt() : nullptr);
+    _shared_cacert = chain;
+}
+
 #endif /* MBEDTLS_X509_CRT_PARSE_C */
 
 mbedtls_ssl_config *TLSSocketWrapper::get_ssl_config()
@@ -586,6 +1031,16 @@ mbedtls_ssl_config *TLSSocketWrapper::get_ssl_config()
          * MBEDTLS_SSL_VERIFY_NONE in the call to mbedtls_ssl_conf_authmode()
          */
         mbedtls_ssl_conf_authmode(get_ssl_config(), MBEDTLS_SSL_VERIFY_REQUIRED);
+#if defined(MBEDTLS_SSL_MAX_FRAGMENT_LENGTH)
+        if (max_frag_len_code(MBED_CONF_NSAPI_TLS_MAX_FRAGMENT_LENGTH) > 0) {
+            mbedtls_ssl_conf_max_frag_len(_ssl_conf, max_frag_len_code(MBED_CONF_NSAPI_TLS_MAX_FRAGMENT_LENGTH));
+        }
+#endif
+#if defined(MBED_CONF_NSAPI_TLS_CIPHER_ORDER)
+        if (ordered_ciphersuites()) {
+            mbedtls_ssl_conf_ciphersuites(_ssl_conf, ordered_ciphersuites());
+        }
+#endif
     }
     return _ssl_conf;
 }
@@ -616,6 +1071,13 @@ nsapi_error_t TLSSocketWrapper::close()
     int ret = 0;
     if (_handshake_completed) {
         _transport->set_blocking(true);
+        if (_cork_buf) {
+            _cork_mutex.lock();
+            if (_cork_len) {
+                flush_cork(-1);
+            }
+            _cork_mutex.unlock();
+        }
         ret = mbedtls_ssl_close_notify(&_ssl);
         if (ret) {
             print_mbedtls_error("mbedtls_ssl_close_notify", ret);
@@ -630,7 +1092,17 @@ nsapi_error_t TLSSocketWrapper::close()
         }
     }
 
+    _cork_mutex.lock();
+    if (_cork_event_id) {
+        mbed::mbed_event_queue()->cancel(_cork_event_id);
+        _cork_event_id = 0;
+    }
+    delete[] _cork_buf;
+    _cork_buf = nullptr;
+    _cork_len = 0;
+    _cork_pending = false;
     _transport = nullptr;
+    _cork_mutex.unlock();
 
     return ret;
 }
@@ -725,6 +1197,11 @@ bool TLSSocketWrapper::is_handshake_started() const
     return _tls_initialized;
 }
 
+int TLSSocketWrapper::configure_ssl_context()
+{
+    return 0;
+}
+
 
 nsapi_error_t TLSSocketWrapper::getpeername(SocketAddress *address)
 {
@@ -38,8 +38,11 @@ using rtos::Kernel::Clock;
 #define CLASS_IN 1
 
 #define RR_A 1
+#define RR_SOA 6
 #define RR_AAAA 28
 
+#define RCODE_NXDOMAIN 3
+
 // DNS options
 #define DNS_BUFFER_SIZE 512
 #define DNS_SERVERS_SIZE 5
@@ -52,12 +55,22 @@ using rtos::Kernel::Clock;
 #define MIN(a, b) ((a) < (b) ? (a) : (b))
 #endif
 
+#ifndef MBED_CONF_NSAPI_DNS_CACHE_NEGATIVE_TTL_MAX
+#define MBED_CONF_NSAPI_DNS_CACHE_NEGATIVE_TTL_MAX 300
+#endif
+
 struct DNS_CACHE {
-    nsapi_addr_t *address;
-    char *host;
+    nsapi_addr_t *address;          /*!< NULL for a cached negative answer */
+    char *host;                     /*!< NULL when the entry is free */
     Clock::time_point expires;      /*!< time to live in milliseconds */
-    Clock::time_point accessed;     /*!< last accessed */
+    Clock::time_point refresh;      /*!< refreshed in background when used after this */
+    uint32_t hash;                  /*!< hash of host */
+    nsapi_version_t version;        /*!< version of the cached answer */
     uint8_t count;                  /*!< number of IP addresses */
+    uint8_t bucket_next;            /*!< next entry in hash bucket, index + 1 */
+    uint8_t lru_prev;               /*!< more recently used entry, index + 1 */
+    uint8_t lru_next;               /*!< less recently used entry, index + 1 */
+    bool refreshing;                /*!< background query in progress */
 };
 
 struct SOCKET_CB_DATA {
@@ -96,9 +109,10 @@ struct DNS_QUERY {
     dns_state state;
 };
 
-static void nsapi_dns_cache_add(const char *host, nsapi_addr_t *address, duration<uint32_t> ttl, uint8_t count);
-static nsapi_size_or_error_t nsapi_dns_cache_find(const char *host, nsapi_version_t version, nsapi_addr_t *address);
+static void nsapi_dns_cache_add(const char *host, nsapi_version_t version, const nsapi_addr_t *address, duration<uint32_t> ttl, uint8_t count);
+static nsapi_size_or_error_t nsapi_dns_cache_find(const char *host, nsapi_version_t version, nsapi_addr_t *address, bool *refresh = NULL);
 static void nsapi_dns_cache_reset();
+static void nsapi_dns_cache_refresh(NetworkStack *stack, const char *host, call_in_callback_cb_t call_in_cb, const char *interface_name, nsapi_version_t version);
 
 static nsapi_error_t nsapi_dns_get_server_addr(NetworkStack *stack, uint8_t *index, uint8_t *total_attempts, uint8_t *send_success, SocketAddress *dns_addr, const char *interface_name);
 
@@ -111,6 +125,9 @@ static void nsapi_dns_query_async_socket_callback(void *ptr);
 static void nsapi_dns_query_async_socket_callback_handle(NetworkStack *stack);
 static void nsapi_dns_query_async_response(void *ptr);
 static void nsapi_dns_query_async_initiate_next(void);
+static nsapi_value_or_error_t nsapi_dns_query_async_queue(NetworkStack *stack, const char *host, NetworkStack::hostbyname_cb_t callback,
+                                                          nsapi_size_t addr_count, call_in_callback_cb_t call_in_cb,
+                                                          const char *interface_name, nsapi_version_t version);
 
 // *INDENT-OFF*
 static nsapi_addr_t dns_servers[DNS_SERVERS_SIZE] = {
@@ -125,7 +142,20 @@ static nsapi_addr_t dns_servers[DNS_SERVERS_SIZE] = {
 // *INDENT-ON*
 
 #if (MBED_CONF_NSAPI_DNS_CACHE_SIZE > 0)
-static DNS_CACHE *dns_cache[MBED_CONF_NSAPI_DNS_CACHE_SIZE];
+static_assert(MBED_CONF_NSAPI_DNS_CACHE_SIZE < 255, "DNS cache links are stored in uint8_t");
+
+// Smallest power of two holding the cache, so lookups mostly hit a single entry
+static constexpr unsigned dns_cache_buckets(unsigned n, unsigned b = 1)
+{
+    return b >= n ? b : dns_cache_buckets(n, b * 2);
+}
+#define DNS_CACHE_BUCKETS dns_cache_buckets(MBED_CONF_NSAPI_DNS_CACHE_SIZE)
+
+// Entries are linked by index + 1, so zero-initialised storage is an empty cache
+static DNS_CACHE dns_cache[MBED_CONF_NSAPI_DNS_CACHE_SIZE];
+static uint8_t dns_cache_bucket[DNS_CACHE_BUCKETS];
+static uint8_t dns_cache_lru_head;  // most recently used
+static uint8_t dns_cache_lru_tail;  // least recently used, evicted first
 // Protects cache shared between blocking and asynchronous calls
 static SingletonPtr<PlatformMutex> dns_cache_mutex;
 #endif
@@ -231,9 +261,28 @@ static int dns_append_question(uint8_t *ptr, uint16_t id, const char *host, nsap
     return *p - s_ptr;
 }
 
+static void dns_skip_name(const uint8_t **p)
+{
+    while (true) {
+        uint8_t len = dns_scan_byte(p);
+        if (len == 0) {
+            break;
+        } else if (len & 0xc0) { // this is link
+            dns_scan_byte(p);
+            break;
+        }
+
+        *p += len;
+    }
+}
+
+// Returns the number of addresses found, 0 for a failed or negative answer
+// and -1 if the packet is not the response. On a negative answer ttl is how
+// long it may be cached (RFC 2308), or zero if it must not be cached.
 static int dns_scan_response(const uint8_t *ptr, uint16_t exp_id, duration<uint32_t> *ttl, nsapi_addr_t *addr, unsigned addr_count)
 {
     const uint8_t **p = &ptr;
+    *ttl = ttl->zero();
 
     // scan header
     uint16_t id    = dns_scan_word(p);
@@ -244,7 +293,7 @@ static int dns_scan_response(const uint8_t *ptr, uint16_t exp_id, duration<uint3
 
     uint16_t qdcount = dns_scan_word(p); // qdcount
     uint16_t ancount = dns_scan_word(p); // ancount
-    dns_scan_word(p);                    // nscount
+    uint16_t nscount = dns_scan_word(p); // nscount
     dns_scan_word(p);                    // arcount
 
     // verify header is response to query
@@ -252,7 +301,7 @@ static int dns_scan_response(const uint8_t *ptr, uint16_t exp_id, duration<uint3
         return -1;
     }
 
-    if (rcode != 0) {
+    if (rcode != 0 && rcode != RCODE_NXDOMAIN) {
         return 0;
     }
 
@@ -275,17 +324,7 @@ static int dns_scan_response(const uint8_t *ptr, uint16_t exp_id, duration<uint3
     unsigned count = 0;
 
     for (int i = 0; i < ancount && count < addr_count; i++) {
-        while (true) {
-            uint8_t len = dns_scan_byte(p);
-            if (len == 0) {
-                break;
-            } else if (len & 0xc0) { // this is link
-                dns_scan_byte(p);
-                break;
-            }
-
-            *p += len;
-        }
+        dns_skip_name(p);
 
         uint16_t rtype    = dns_scan_word(p);    // rtype
         uint16_t rclass   = dns_scan_word(p);    // rclass
@@ -324,10 +363,130 @@ static int dns_scan_response(const uint8_t *ptr, uint16_t exp_id, duration<uint3
         }
     }
 
-    return count;
+    if (count > 0) {
+        return count;
+    }
+
+    // No address: the answer may be cached for the lesser of the SOA record's
+    // TTL and its MINIMUM field. Without a SOA record it is not cached at all.
+    *ttl = ttl->zero();
+    for (int i = 0; i < nscount; i++) {
+        dns_skip_name(p);
+
+        uint16_t rtype    = dns_scan_word(p);    // rtype
+        uint16_t rclass   = dns_scan_word(p);    // rclass
+        uint32_t ttl_val  = dns_scan_word32(p);  // ttl
+        uint16_t rdlength = dns_scan_word(p);    // rdlength
+
+        if (rtype == RR_SOA && rclass == CLASS_IN) {
+            dns_skip_name(p);                    // mname
+            dns_skip_name(p);                    // rname
+            *p += 4 * sizeof(uint32_t);          // serial, refresh, retry, expire
+            uint32_t minimum = dns_scan_word32(p);
+
+            ttl_val = MIN(ttl_val, minimum);
+            ttl_val = MIN(ttl_val, (uint32_t) MBED_CONF_NSAPI_DNS_CACHE_NEGATIVE_TTL_MAX);
+            *ttl = duration<uint32_t>(ttl_val);
+            break;
+        }
+
+        *p += rdlength;
+    }
+
+    return 0;
+}
+
+#if (MBED_CONF_NSAPI_DNS_CACHE_SIZE > 0)
+// FNV-1a
+static uint32_t nsapi_dns_cache_hash(const char *host)
+{
+    uint32_t hash = 2166136261u;
+    while (*host) {
+        hash ^= (uint8_t) *host++;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static void nsapi_dns_cache_lru_unlink(uint8_t index)
+{
+    DNS_CACHE *entry = &dns_cache[index - 1];
+
+    if (entry->lru_prev) {
+        dns_cache[entry->lru_prev - 1].lru_next = entry->lru_next;
+    } else {
+        dns_cache_lru_head = entry->lru_next;
+    }
+    if (entry->lru_next) {
+        dns_cache[entry->lru_next - 1].lru_prev = entry->lru_prev;
+    } else {
+        dns_cache_lru_tail = entry->lru_prev;
+    }
+    entry->lru_prev = 0;
+    entry->lru_next = 0;
+}
+
+static void nsapi_dns_cache_lru_push(uint8_t index)
+{
+    DNS_CACHE *entry = &dns_cache[index - 1];
+
+    entry->lru_prev = 0;
+    entry->lru_next = dns_cache_lru_head;
+    if (dns_cache_lru_head) {
+        dns_cache[dns_cache_lru_head - 1].lru_prev = index;
+    } else {
+        dns_cache_lru_tail = index;
+    }
+    dns_cache_lru_head = index;
+}
+
+static void nsapi_dns_cache_remove(uint8_t index)
+{
+    DNS_CACHE *entry = &dns_cache[index - 1];
+
+    uint8_t *link = &dns_cache_bucket[entry->hash & (DNS_CACHE_BUCKETS - 1)];
+    while (*link != index) {
+        link = &dns_cache[*link - 1].bucket_next;
+    }
+    *link = entry->bucket_next;
+    nsapi_dns_cache_lru_unlink(index);
+
+    delete[] entry->host;
+    delete[] entry->address;
+    *entry = DNS_CACHE();
+}
+
+// Finds the entry for host, preferring addresses over a negative answer when
+// any version is accepted. Expired entries met on the way are dropped.
+static uint8_t nsapi_dns_cache_lookup(const char *host, uint32_t hash, nsapi_version_t version, bool exact)
+{
+    auto now = Clock::now();
+    uint8_t found = 0;
+    uint8_t index = dns_cache_bucket[hash & (DNS_CACHE_BUCKETS - 1)];
+
+    while (index) {
+        DNS_CACHE *entry = &dns_cache[index - 1];
+        uint8_t next = entry->bucket_next;
+
+        if (now > entry->expires) {
+            nsapi_dns_cache_remove(index);
+        } else if (entry->hash == hash && strcmp(entry->host, host) == 0 &&
+                   (entry->version == version || (!exact && version == NSAPI_UNSPEC))) {
+            if (entry->address) {
+                return index;
+            }
+            if (!found) {
+                found = index;
+            }
+        }
+        index = next;
+    }
+
+    return found;
 }
+#endif
 
-static void nsapi_dns_cache_add(const char *host, nsapi_addr_t *address, duration<uint32_t> ttl, uint8_t count)
+static void nsapi_dns_cache_add(const char *host, nsapi_version_t version, const nsapi_addr_t *address, duration<uint32_t> ttl, uint8_t count)
 {
 #if (MBED_CONF_NSAPI_DNS_CACHE_SIZE > 0)
     // RFC 1034: if TTL is zero, entry is not added to cache
@@ -335,86 +494,105 @@ static void nsapi_dns_cache_add(const char *host, nsapi_addr_t *address, duratio
         return;
     }
 
-    // Checks if already cached
-    if (nsapi_dns_cache_find(host, address->version, NULL) == NSAPI_ERROR_OK) {
-        return;
+    if (address) {
+        version = address[0].version; //only first IP address version check, others have the same version
+        count = MIN(count, MBED_CONF_NSAPI_DNS_ADDRESSES_LIMIT);
+    } else {
+        count = 0;
     }
 
+    uint32_t hash = nsapi_dns_cache_hash(host);
+
     dns_cache_mutex->lock();
 
-    int index = -1;
-    Clock::time_point accessed = Clock::time_point::max();
+    // A new answer replaces the cached one, whether positive or negative
+    uint8_t index = nsapi_dns_cache_lookup(host, hash, version, true);
+    if (index) {
+        nsapi_dns_cache_remove(index);
+    }
 
-    // Finds free or last accessed entry
+    // Finds free or least recently used entry
+    index = 0;
     for (int i = 0; i < MBED_CONF_NSAPI_DNS_CACHE_SIZE; i++) {
-        if (!dns_cache[i]) {
-            index = i;
+        if (!dns_cache[i].host) {
+            index = i + 1;
             break;
-        } else if (dns_cache[i]->accessed <= accessed) {
-            accessed = dns_cache[i]->accessed;
-            index = i;
         }
     }
+    if (!index) {
+        index = dns_cache_lru_tail;
+        nsapi_dns_cache_remove(index);
+    }
 
-    if (index < 0) {
+    DNS_CACHE *entry = &dns_cache[index - 1];
+    entry->host = new (std::nothrow) char[strlen(host) + 1];
+    if (address) {
+        entry->address = new (std::nothrow) nsapi_addr_t[count];
+    }
+    if (!entry->host || (address && !entry->address)) {
+        delete[] entry->host;
+        delete[] entry->address;
+        *entry = DNS_CACHE();
         dns_cache_mutex->unlock();
         return;
     }
 
-    // Allocates in case entry is free, otherwise reuses
-    if (!dns_cache[index]) {
-        dns_cache[index] = new (std::nothrow) DNS_CACHE;
-    } else {
-        delete dns_cache[index]->host;
-        delete dns_cache[index]->address;
+    strcpy(entry->host, host);
+    for (int i = 0; i < count; i++) {
+        entry->address[i] = address[i];
     }
+    entry->count = count;
+    entry->version = version;
+    entry->hash = hash;
+    auto now = Clock::now();
+    entry->expires = now + ttl;
+    // Starts refreshing during the last eighth of the TTL
+    entry->refresh = entry->expires - ttl / 8;
+    entry->refreshing = false;
 
-    if (dns_cache[index]) {
-        dns_cache[index]->address = new (std::nothrow) nsapi_addr_t[count];
-        for (int i = 0; i < count; i++) {
-            dns_cache[index]->address[i] = address[i];
-        }
-        dns_cache[index]->count = count;
-        dns_cache[index]->host = new (std::nothrow) char[strlen(host) + 1];
-        strcpy(dns_cache[index]->host, host);
-        auto now = Clock::now();
-        dns_cache[index]->expires = now + ttl;
-        dns_cache[index]->accessed = now;
-    }
+    uint8_t *bucket = &dns_cache_bucket[hash & (DNS_CACHE_BUCKETS - 1)];
+    entry->bucket_next = *bucket;
+    *bucket = index;
+    nsapi_dns_cache_lru_push(index);
 
     dns_cache_mutex->unlock();
 #endif
 }
 
-static nsapi_size_or_error_t nsapi_dns_cache_find(const char *host, nsapi_version_t version, nsapi_addr_t *address)
+// Returns the number of cached addresses, NSAPI_ERROR_DNS_FAILURE for a cached
+// negative answer or NSAPI_ERROR_NO_ADDRESS. When refresh is given, it is set
+// if the caller should start a background query as the entry nears expiry.
+static nsapi_size_or_error_t nsapi_dns_cache_find(const char *host, nsapi_version_t version, nsapi_addr_t *address, bool *refresh)
 {
     nsapi_error_t ret_val = NSAPI_ERROR_NO_ADDRESS;
 
 #if (MBED_CONF_NSAPI_DNS_CACHE_SIZE > 0)
+    uint32_t hash = nsapi_dns_cache_hash(host);
+
     dns_cache_mutex->lock();
 
-    for (int i = 0; i < MBED_CONF_NSAPI_DNS_CACHE_SIZE; i++) {
-        if (dns_cache[i]) {
-            auto now = Clock::now();
-            // Checks all entries for expired entries
-            if (now > dns_cache[i]->expires) {
-                delete dns_cache[i]->host;
-                delete dns_cache[i]->address;
-                delete dns_cache[i];
-                dns_cache[i] = NULL;
-            } else if ((version == NSAPI_UNSPEC || version == dns_cache[i]->address[0].version) && //only first IP address version check, others have the same version
-                       strcmp(dns_cache[i]->host, host) == 0) {
-                if (address) {
-                    ret_val = 0;
-                    for (int count = 0; count < dns_cache[i]->count; count++) {
-                        address[count] = dns_cache[i]->address[count];
-                        ret_val++;
-                    }
+    uint8_t index = nsapi_dns_cache_lookup(host, hash, version, false);
+    if (index) {
+        DNS_CACHE *entry = &dns_cache[index - 1];
+
+        if (!entry->address) {
+            ret_val = NSAPI_ERROR_DNS_FAILURE;
+        } else {
+            if (address) {
+                for (int count = 0; count < entry->count; count++) {
+                    address[count] = entry->address[count];
                 }
-                dns_cache[i]->accessed = now;
+            }
+            ret_val = entry->count;
 
+            if (refresh && !entry->refreshing && Clock::now() >= entry->refresh) {
+                entry->refreshing = true;
+                *refresh = true;
             }
         }
+
+        nsapi_dns_cache_lru_unlink(index);
+        nsapi_dns_cache_lru_push(index);
     }
 
     dns_cache_mutex->unlock();
@@ -428,18 +606,40 @@ static void nsapi_dns_cache_reset()
 #if (MBED_CONF_NSAPI_DNS_CACHE_SIZE > 0)
     dns_cache_mutex->lock();
     for (int i = 0; i < MBED_CONF_NSAPI_DNS_CACHE_SIZE; i++) {
-        if (dns_cache[i]) {
-            delete[] dns_cache[i]->host;
-            dns_cache[i]->host = NULL;
-            delete[] dns_cache[i]->address;
-            delete dns_cache[i];
-            dns_cache[i] = NULL;
+        if (dns_cache[i].host) {
+            nsapi_dns_cache_remove(i + 1);
         }
     }
     dns_cache_mutex->unlock();
 #endif
 }
 
+static void nsapi_dns_cache_refreshed(nsapi_value_or_error_t result, SocketAddress *address)
+{
+    // Nothing to do, the response has already replaced the cache entry
+}
+
+// Queues a query that bypasses the cache, must be called with dns_mutex held
+static void nsapi_dns_cache_refresh(NetworkStack *stack, const char *host, call_in_callback_cb_t call_in_cb, const char *interface_name, nsapi_version_t version)
+{
+    nsapi_dns_query_async_queue(stack, host, nsapi_dns_cache_refreshed, MBED_CONF_NSAPI_DNS_ADDRESSES_LIMIT,
+                                call_in_cb, interface_name, version);
+}
+
+// Blocking queries have no call_in callback, so their refreshes run on the shared queue
+static nsapi_error_t nsapi_dns_shared_queue_call_in(int delay, mbed::Callback<void()> func)
+{
+    events::EventQueue *event_queue = mbed::mbed_event_queue();
+
+    if (!event_queue) {
+        return NSAPI_ERROR_NO_MEMORY;
+    }
+
+    int id = delay > 0 ? event_queue->call_in(milliseconds(delay), func) : event_queue->call(func);
+
+    return id ? NSAPI_ERROR_OK : NSAPI_ERROR_NO_MEMORY;
+}
+
 static nsapi_error_t nsapi_dns_get_server_addr(NetworkStack *stack, uint8_t *index, uint8_t *total_attempts, uint8_t *send_success, SocketAddress *dns_addr, const char *interface_name)
 {
     bool dns_addr_set = false;
@@ -488,7 +688,16 @@ static nsapi_size_or_error_t nsapi_dns_query_multiple(NetworkStack *stack, const
 
     // check cache
     nsapi_addr *tmp = new (std::nothrow) nsapi_addr_t [MBED_CONF_NSAPI_DNS_ADDRESSES_LIMIT];
-    int cached = nsapi_dns_cache_find(host, version, tmp);
+    if (!tmp) {
+        return NSAPI_ERROR_NO_MEMORY;
+    }
+    bool refresh = false;
+    int cached = nsapi_dns_cache_find(host, version, tmp, &refresh);
+    if (refresh) {
+        dns_mutex->lock();
+        nsapi_dns_cache_refresh(stack, host, nsapi_dns_shared_queue_call_in, interface_name, version);
+        dns_mutex->unlock();
+    }
     if (cached > 0) {
         unsigned int us_cached = cached;
         for (unsigned int i = 0;  i < MIN(us_cached, addr_count); i++) {
@@ -498,6 +707,9 @@ static nsapi_size_or_error_t nsapi_dns_query_multiple(NetworkStack *stack, const
         return MIN(us_cached, addr_count);
     }
     delete [] tmp;
+    if (cached == NSAPI_ERROR_DNS_FAILURE) {
+        return NSAPI_ERROR_DNS_FAILURE;
+    }
     // create a udp socket
     UDPSocket socket;
     int err = socket.open(stack);
@@ -575,10 +787,12 @@ static nsapi_size_or_error_t nsapi_dns_query_multiple(NetworkStack *stack, const
         duration<uint32_t> ttl;
         int resp = dns_scan_response(response, 1, &ttl, addr, addr_count);
         if (resp > 0) {
-            nsapi_dns_cache_add(host, addr, ttl, resp);
+            nsapi_dns_cache_add(host, version, addr, ttl, resp);
             result = resp;
         } else if (resp < 0) {
             continue;
+        } else {
+            nsapi_dns_cache_add(host, version, NULL, ttl, 0);
         }
 
         /* The DNS response is final, no need to check other servers */
@@ -693,8 +907,6 @@ nsapi_value_or_error_t nsapi_dns_query_multiple_async(NetworkStack *stack, const
                                                       NetworkStack::hostbyname_cb_t callback, nsapi_size_t addr_count,
                                                       call_in_callback_cb_t call_in_cb, const char *interface_name, nsapi_version_t version)
 {
-    dns_mutex->lock();
-
     if (!stack) {
         return NSAPI_ERROR_PARAMETER;
     }
@@ -702,12 +914,29 @@ nsapi_value_or_error_t nsapi_dns_query_multiple_async(NetworkStack *stack, const
     // check for valid host name
     int host_len = host ? strlen(host) : 0;
     if (host_len > DNS_HOST_NAME_MAX_LEN || host_len == 0) {
-        dns_mutex->unlock();
         return NSAPI_ERROR_PARAMETER;
     }
 
     nsapi_addr *address = new (std::nothrow) nsapi_addr_t [MBED_CONF_NSAPI_DNS_ADDRESSES_LIMIT];
-    int cached = nsapi_dns_cache_find(host, version, address);
+    if (!address) {
+        return NSAPI_ERROR_NO_MEMORY;
+    }
+
+    dns_mutex->lock();
+
+    bool refresh = false;
+    int cached = nsapi_dns_cache_find(host, version, address, &refresh);
+    if (refresh) {
+        nsapi_dns_cache_refresh(stack, host, call_in_cb, interface_name, version);
+    }
+
+    if (cached == NSAPI_ERROR_DNS_FAILURE) {
+        // Cached negative answer, fails immediately
+        dns_mutex->unlock();
+        delete[] address;
+        return NSAPI_ERROR_DNS_FAILURE;
+    }
+
     if (!addr_count) {
         if (cached > 0) {
             SocketAddress addr(*address);
@@ -732,6 +961,18 @@ nsapi_value_or_error_t nsapi_dns_query_multiple_async(NetworkStack *stack, const
         }
     }
     delete[] address;
+
+    nsapi_value_or_error_t ret = nsapi_dns_query_async_queue(stack, host, callback, addr_count, call_in_cb, interface_name, version);
+
+    dns_mutex->unlock();
+
+    return ret;
+}
+
+static nsapi_value_or_error_t nsapi_dns_query_async_queue(NetworkStack *stack, const char *host, NetworkStack::hostbyname_cb_t callback,
+                                                          nsapi_size_t addr_count, call_in_callback_cb_t call_in_cb,
+                                                          const char *interface_name, nsapi_version_t version)
+{
     int index = -1;
 
     for (int i = 0; i < DNS_QUERY_QUEUE_SIZE; i++) {
@@ -742,21 +983,18 @@ nsapi_value_or_error_t nsapi_dns_query_multiple_async(NetworkStack *stack, const
     }
 
     if (index < 0) {
-        dns_mutex->unlock();
         return NSAPI_ERROR_NO_MEMORY;
     }
 
     DNS_QUERY *query = new (std::nothrow) DNS_QUERY;
 
     if (!query) {
-        dns_mutex->unlock();
         return NSAPI_ERROR_NO_MEMORY;
     }
 
-    query->host = new (std::nothrow) char[host_len + 1];
+    query->host = new (std::nothrow) char[strlen(host) + 1];
     if (!query->host) {
         delete query;
-        dns_mutex->unlock();
         return NSAPI_ERROR_NO_MEMORY;
     }
     strcpy(query->host, host);
@@ -806,7 +1044,6 @@ nsapi_value_or_error_t nsapi_dns_query_multiple_async(NetworkStack *stack, const
             delete[] query->host;
             delete query;
             dns_query_queue[index] = NULL;
-            dns_mutex->unlock();
             return NSAPI_ERROR_NO_MEMORY;
         }
         dns_timer_running = true;
@@ -815,8 +1052,6 @@ nsapi_value_or_error_t nsapi_dns_query_multiple_async(NetworkStack *stack, const
     // Initiates query
     nsapi_dns_query_async_initiate_next();
 
-    dns_mutex->unlock();
-
     return query->unique_id;
 }
 
@@ -1246,8 +1481,11 @@ static void nsapi_dns_query_async_response(void *ptr)
             }
 
             // Adds address to cache
-            nsapi_dns_cache_add(query->host, &(query->addrs[0]), query->ttl, query->count);
+            nsapi_dns_cache_add(query->host, query->version, &(query->addrs[0]), query->ttl, query->count);
             status = query->count;
+        } else if (query->addrs) {
+            // Answered, but without addresses
+            nsapi_dns_cache_add(query->host, query->version, NULL, query->ttl, 0);
         }
 
         nsapi_dns_query_async_resp(query, status, addresses);
@@ -9,6 +9,7 @@ set(unittest-includes ${unittest-includes}
 
 set(unittest-sources
   ../connectivity/netsocket/source/CellularNonIPSocket.cpp
+  ../connectivity/netsocket/source/Socket.cpp
 )
 
 set(unittest-test-sources
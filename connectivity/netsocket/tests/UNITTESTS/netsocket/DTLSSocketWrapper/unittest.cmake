@@ -5,12 +5,14 @@
 
 set(unittest-sources
   ../connectivity/netsocket/source/SocketAddress.cpp
+  ../connectivity/netsocket/source/Socket.cpp
   ../connectivity/netsocket/source/NetworkStack.cpp
   ../connectivity/netsocket/source/InternetSocket.cpp
   ../connectivity/netsocket/source/InternetDatagramSocket.cpp
   ../connectivity/netsocket/source/UDPSocket.cpp
   ../connectivity/netsocket/source/DTLSSocketWrapper.cpp
   ../connectivity/netsocket/source/TLSSocketWrapper.cpp
+  ../connectivity/netsocket/source/TLSCAChain.cpp
   ../connectivity/libraries/nanostack-libservice/source/libip4string/ip4tos.c
   ../connectivity/libraries/nanostack-libservice/source/libip6string/ip6tos.c
   ../connectivity/libraries/nanostack-libservice/source/libip4string/stoip4.c
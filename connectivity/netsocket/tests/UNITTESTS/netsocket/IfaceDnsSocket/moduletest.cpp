@@ -113,6 +113,8 @@ protected:
     static const unsigned char packet_ip6[packet_ip6_size];
     static constexpr unsigned int packet_ip4_3addresses_size = 76;
     static const unsigned char packet_ip4_3addresses[packet_ip4_3addresses_size];
+    static constexpr unsigned int packet_nxdomain_size = 69;
+    static const unsigned char packet_nxdomain[packet_nxdomain_size];
 };
 
 std::list<std::future<void>> Test_IfaceDnsSocket::eventQueue;
@@ -215,6 +217,37 @@ const unsigned char Test_IfaceDnsSocket::packet_ip4_3addresses[Test_IfaceDnsSock
     0x01, 0x02, 0x03, 0x04       // Address bytes
 };
 
+// NXDOMAIN answer for the same question, with a SOA record in the authority section
+const unsigned char Test_IfaceDnsSocket::packet_nxdomain[Test_IfaceDnsSocket::packet_nxdomain_size] = {
+    0x00, 0x01, // ID
+    0x81, 0x83, // Flags, rcode = NXDOMAIN
+    0x00, 0x01, // qdcount
+    0x00, 0x00, // ancount
+    0x00, 0x01, // nscount
+    0x00, 0x00, // arcount
+
+    0x06,                               // question, qdcount = 1, first byte is len = 6
+    0x67, 0x6f, 0x6f, 0x67, 0x6c, 0x65, // body of the question
+    0x03,                               // len = 3
+    0x63, 0x6f, 0x6d,                   // body of the question qtype and qclass of the question
+    0x00,                               // len = 0
+    0x00, 0x01,                         // qtype
+    0x00, 0x01,                         // qclass
+
+    0xc0, 0x13,                  // authority name, link to "com"
+    0x00, 0x06,                  // rtype: RR_SOA = 6
+    0x00, 0x01,                  // rclass
+    0x00, 0x00, 0x03, 0x84,      // ttl
+    0x00, 0x1d,                  // rdlength
+    0x01, 0x61, 0xc0, 0x13,      // mname
+    0x02, 0x6e, 0x73, 0xc0, 0x13, // rname
+    0x00, 0x00, 0x00, 0x01,      // serial
+    0x00, 0x00, 0x07, 0x08,      // refresh
+    0x00, 0x00, 0x03, 0x84,      // retry
+    0x00, 0x09, 0x3a, 0x80,      // expire
+    0x00, 0x00, 0x00, 0x3c       // minimum, the negative caching TTL
+};
+
 // We cannot use SetArgArray, because this is void* type.
 // Use a manual for loop, to avoid depending on local implementation of strncpy (had some issues with it).
 ACTION_P2(SetArg2ToCharPtr, value, size)
@@ -349,6 +382,31 @@ TEST_F(Test_IfaceDnsSocket, single_query_errors)
     EXPECT_EQ(NSAPI_ERROR_DEVICE_ERROR, nsapi_dns_query(iface, "www.google.com", &addr));
 }
 
+TEST_F(Test_IfaceDnsSocket, single_query_nxdomain)
+{
+    SocketAddress addr;
+    EXPECT_CALL(stackMock(), socket_open(_, NSAPI_UDP))
+    .Times(1)
+    .WillOnce(DoAll(SetArgPointee<0>((void **)&stackMock()), Return(NSAPI_ERROR_OK)));
+
+    EXPECT_CALL(stackMock(), get_dns_server(_, _, _)).Times(1).WillOnce(Return(NSAPI_ERROR_UNSUPPORTED));
+
+    EXPECT_CALL(stackMock(), socket_sendto(_, _, _, _)).Times(1).WillOnce(Return(NSAPI_ERROR_OK));
+
+    EXPECT_CALL(stackMock(), socket_recvfrom(_, _, _, _))
+    .Times(1)
+    .WillOnce(DoAll(SetArg2ToCharPtr(Test_IfaceDnsSocket::packet_nxdomain, Test_IfaceDnsSocket::packet_nxdomain_size), Return(Test_IfaceDnsSocket::packet_nxdomain_size)));
+
+    EXPECT_CALL(stackMock(), socket_close(_)).Times(1).WillOnce(Return(NSAPI_ERROR_OK));
+
+    EXPECT_EQ(NSAPI_ERROR_DNS_FAILURE, nsapi_dns_query(iface, "www.google.com", &addr, NSAPI_IPv4));
+
+    // Negative answer is cached, no second query is sent.
+    EXPECT_EQ(NSAPI_ERROR_DNS_FAILURE, nsapi_dns_query(iface, "www.google.com", &addr, NSAPI_IPv4));
+    EXPECT_EQ(NSAPI_ERROR_DNS_FAILURE, nsapi_dns_query_async(&stackMock(), "www.google.com", &Test_IfaceDnsSocket::hostbyname_cb, Test_IfaceDnsSocket::call_in, NSAPI_IPv4));
+    EXPECT_TRUE(eventQueue.empty());
+}
+
 TEST_F(Test_IfaceDnsSocket, simultaneous_query_async)
 {
     // Make sure socket opens successfully
@@ -611,3 +669,40 @@ TEST_F(Test_IfaceDnsSocket, retries_attempts)
 
     EXPECT_EQ(NSAPI_ERROR_DNS_FAILURE, nsapi_dns_query(iface, "www.google.com", &addr));
 }
+
+TEST_F(Test_IfaceDnsSocket, happy_eyeballs_literal)
+{
+    TCPSocket sockets[2];
+
+    EXPECT_CALL(stackMock(), socket_open(_, NSAPI_TCP))
+    .Times(1)
+    .WillOnce(DoAll(SetArgPointee<0>((void **)&stackMock()), Return(NSAPI_ERROR_OK)));
+
+    // Connection completes on the second poll
+    EXPECT_CALL(stackMock(), socket_connect(_, _))
+    .Times(2)
+    .WillOnce(Return(NSAPI_ERROR_IN_PROGRESS))
+    .WillOnce(Return(NSAPI_ERROR_IS_CONNECTED));
+
+    EXPECT_EQ(0, iface->happy_eyeballs_connect("1.2.3.4", 80, sockets));
+
+    // Only the winner is open, closed when it goes out of scope
+    EXPECT_CALL(stackMock(), socket_close(_)).Times(1).WillOnce(Return(NSAPI_ERROR_OK));
+}
+
+TEST_F(Test_IfaceDnsSocket, happy_eyeballs_connect_fails)
+{
+    TCPSocket sockets[2];
+
+    EXPECT_CALL(stackMock(), socket_open(_, NSAPI_TCP))
+    .Times(1)
+    .WillOnce(DoAll(SetArgPointee<0>((void **)&stackMock()), Return(NSAPI_ERROR_OK)));
+
+    EXPECT_CALL(stackMock(), socket_connect(_, _)).Times(1).WillOnce(Return(NSAPI_ERROR_NO_CONNECTION));
+
+    EXPECT_CALL(stackMock(), socket_close(_)).Times(1).WillOnce(Return(NSAPI_ERROR_OK));
+
+    // No address of the other family to fall back to
+    EXPECT_EQ(NSAPI_ERROR_NO_CONNECTION, iface->happy_eyeballs_connect("2001:db8::1", 80, sockets));
+    EXPECT_EQ(NSAPI_ERROR_PARAMETER, iface->happy_eyeballs_connect("", 80, sockets));
+}
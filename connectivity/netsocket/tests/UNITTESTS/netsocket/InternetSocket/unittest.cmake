@@ -7,6 +7,7 @@ set(CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} -DMBED_CONF_NSAPI_DNS_ADDRESSES_LIMIT=10
 
 set(unittest-sources
   ../connectivity/netsocket/source/SocketAddress.cpp
+  ../connectivity/netsocket/source/Socket.cpp
   ../connectivity/netsocket/source/NetworkStack.cpp
   ../connectivity/netsocket/source/InternetSocket.cpp
   ../connectivity/libraries/nanostack-libservice/source/libip4string/ip4tos.c
@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2021, Arm Limited and affiliates
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+#include "netsocket/SocketSet.h"
+#include "netsocket/UDPSocket.h"
+#include <list>
+
+using namespace std::chrono;
+
+// Control the rtos EventFlags stub. See EventFlags_stub.cpp
+extern std::list<uint32_t> eventFlagsStubNextRetval;
+
+class TestSocketSet : public testing::Test {
+protected:
+    SocketSet *set;
+    UDPSocket sockets[3];
+
+    virtual void SetUp()
+    {
+        set = new SocketSet;
+        eventFlagsStubNextRetval.clear();
+    }
+
+    virtual void TearDown()
+    {
+        delete set;
+        eventFlagsStubNextRetval.clear();
+    }
+};
+
+TEST_F(TestSocketSet, constructor)
+{
+    EXPECT_TRUE(set);
+    EXPECT_EQ(set->size(), 0);
+}
+
+TEST_F(TestSocketSet, add_remove)
+{
+    EXPECT_EQ(set->add(NULL), NSAPI_ERROR_PARAMETER);
+    EXPECT_EQ(set->add(&sockets[0]), NSAPI_ERROR_OK);
+    EXPECT_EQ(set->add(&sockets[0]), NSAPI_ERROR_PARAMETER);
+    EXPECT_EQ(set->add(&sockets[1]), NSAPI_ERROR_OK);
+    EXPECT_EQ(set->size(), 2);
+
+    EXPECT_EQ(set->remove(&sockets[0]), NSAPI_ERROR_OK);
+    EXPECT_EQ(set->remove(&sockets[0]), NSAPI_ERROR_NO_SOCKET);
+    EXPECT_EQ(set->remove(&sockets[2]), NSAPI_ERROR_NO_SOCKET);
+    EXPECT_EQ(set->size(), 1);
+}
+
+TEST_F(TestSocketSet, add_full)
+{
+    UDPSocket extra[SocketSet::MAX_SOCKETS];
+
+    for (int i = 0; i < SocketSet::MAX_SOCKETS; i++) {
+        EXPECT_EQ(set->add(&extra[i]), NSAPI_ERROR_OK);
+    }
+    EXPECT_EQ(set->add(&sockets[0]), NSAPI_ERROR_NO_MEMORY);
+
+    EXPECT_EQ(set->remove(&extra[3]), NSAPI_ERROR_OK);
+    EXPECT_EQ(set->add(&sockets[0]), NSAPI_ERROR_OK);
+    EXPECT_EQ(set->size(), SocketSet::MAX_SOCKETS);
+
+    for (int i = 0; i < SocketSet::MAX_SOCKETS; i++) {
+        set->remove(&extra[i]);
+    }
+}
+
+TEST_F(TestSocketSet, wait_empty)
+{
+    Socket *ready[3];
+
+    EXPECT_EQ(set->wait(ready), NSAPI_ERROR_NO_SOCKET);
+    set->add(&sockets[0]);
+    EXPECT_EQ(set->wait(mbed::Span<Socket *>()), NSAPI_ERROR_PARAMETER);
+}
+
+TEST_F(TestSocketSet, wait_ready)
+{
+    Socket *ready[3];
+
+    set->add(&sockets[0]);
+    set->add(&sockets[1]);
+    set->add(&sockets[2]);
+
+    eventFlagsStubNextRetval.push_back(0x5);
+    EXPECT_EQ(set->wait(ready), 2);
+    EXPECT_EQ(ready[0], &sockets[0]);
+    EXPECT_EQ(ready[1], &sockets[2]);
+
+    eventFlagsStubNextRetval.push_back(0x2);
+    EXPECT_EQ(set->wait(ready, 100ms), 1);
+    EXPECT_EQ(ready[0], &sockets[1]);
+}
+
+TEST_F(TestSocketSet, wait_ready_small_span)
+{
+    Socket *ready[1];
+
+    set->add(&sockets[0]);
+    set->add(&sockets[1]);
+
+    eventFlagsStubNextRetval.push_back(0x3);
+    EXPECT_EQ(set->wait(ready), 1);
+    EXPECT_EQ(ready[0], &sockets[0]);
+}
+
+TEST_F(TestSocketSet, wait_removed_socket)
+{
+    Socket *ready[3];
+
+    set->add(&sockets[0]);
+    set->add(&sockets[1]);
+    set->remove(&sockets[0]);
+
+    // A wake-up for a removed socket alone is not reported
+    eventFlagsStubNextRetval.push_back(0x1);
+    eventFlagsStubNextRetval.push_back(0x3);
+    EXPECT_EQ(set->wait(ready), 1);
+    EXPECT_EQ(ready[0], &sockets[1]);
+}
+
+TEST_F(TestSocketSet, wait_timeout)
+{
+    Socket *ready[3];
+
+    set->add(&sockets[0]);
+
+    eventFlagsStubNextRetval.push_back(osFlagsErrorTimeout);
+    EXPECT_EQ(set->wait(ready, 10ms), NSAPI_ERROR_WOULD_BLOCK);
+    eventFlagsStubNextRetval.push_back(osFlagsErrorResource);
+    EXPECT_EQ(set->wait(ready, 0ms), NSAPI_ERROR_WOULD_BLOCK);
+}
@@ -264,6 +264,63 @@ TEST_F(TestTCPSocket, unsupported_api)
     EXPECT_EQ(socket->join_multicast_group(addr), NSAPI_ERROR_UNSUPPORTED);
 }
 
+/* scatter-gather */
+
+TEST_F(TestTCPSocket, sendmsg_no_open)
+{
+    const nsapi_iovec_t iov[] = {{dataBuf, 4}, {dataBuf + 4, dataSize - 4}};
+    EXPECT_EQ(socket->sendmsg(NULL, iov), NSAPI_ERROR_NO_SOCKET);
+}
+
+TEST_F(TestTCPSocket, sendmsg_resumes_partial_buffer)
+{
+    const nsapi_iovec_t iov[] = {{dataBuf, 4}, {dataBuf + 4, dataSize - 4}};
+    socket->open(&stack);
+    stack.return_values.push_back(2);
+    stack.return_values.push_back(2);
+    stack.return_values.push_back(dataSize - 4);
+    EXPECT_EQ(socket->sendmsg(NULL, iov), dataSize);
+    EXPECT_TRUE(stack.return_values.empty());
+}
+
+TEST_F(TestTCPSocket, sendmsg_error_would_block)
+{
+    const nsapi_iovec_t iov[] = {{dataBuf, 4}, {dataBuf + 4, dataSize - 4}};
+    socket->open(&stack);
+    stack.return_value = NSAPI_ERROR_WOULD_BLOCK;
+    socket->set_blocking(false);
+    EXPECT_EQ(socket->sendmsg(NULL, iov), NSAPI_ERROR_WOULD_BLOCK);
+}
+
+TEST_F(TestTCPSocket, recvmsg_fills_buffers_in_order)
+{
+    const nsapi_iovec_t iov[] = {{dataBuf, 4}, {dataBuf + 4, dataSize - 4}};
+    socket->open(&stack);
+    stack.return_values.push_back(4);
+    stack.return_values.push_back(3);
+    EXPECT_EQ(socket->recvmsg(NULL, iov), 7);
+}
+
+/* zero-copy buffers */
+
+TEST_F(TestTCPSocket, buf_no_open)
+{
+    net_stack_mem_buf_t *buf = NULL;
+    EXPECT_EQ(socket->get_memory_manager(), (NetStackMemoryManager *)NULL);
+    EXPECT_EQ(socket->send_buf(dataBuf), NSAPI_ERROR_NO_SOCKET);
+    EXPECT_EQ(socket->recv_buf(&buf), NSAPI_ERROR_NO_SOCKET);
+}
+
+TEST_F(TestTCPSocket, buf_unsupported_by_stack)
+{
+    net_stack_mem_buf_t *buf = NULL;
+    socket->open(&stack);
+    EXPECT_EQ(socket->get_memory_manager(), (NetStackMemoryManager *)NULL);
+    EXPECT_EQ(socket->send_buf(dataBuf), NSAPI_ERROR_UNSUPPORTED);
+    EXPECT_EQ(socket->recv_buf(&buf), NSAPI_ERROR_UNSUPPORTED);
+    EXPECT_EQ(buf, (net_stack_mem_buf_t *)NULL);
+}
+
 /* listen */
 
 TEST_F(TestTCPSocket, listen_no_open)
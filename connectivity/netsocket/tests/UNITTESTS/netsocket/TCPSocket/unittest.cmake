@@ -5,6 +5,7 @@
 
 set(unittest-sources
   ../connectivity/netsocket/source/SocketAddress.cpp
+  ../connectivity/netsocket/source/Socket.cpp
   ../connectivity/netsocket/source/NetworkStack.cpp
   ../connectivity/netsocket/source/InternetSocket.cpp
   ../connectivity/netsocket/source/TCPSocket.cpp
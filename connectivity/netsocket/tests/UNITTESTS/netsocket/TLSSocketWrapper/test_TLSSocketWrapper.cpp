@@ -228,6 +228,69 @@ TEST_F(TestTLSSocketWrapper, connect_handshake_fail_ssl_get_verify_result)
     EXPECT_EQ(wrapper->connect(a), NSAPI_ERROR_OK);
 }
 
+/* session resumption */
+
+TEST_F(TestTLSSocketWrapper, get_session_not_connected)
+{
+    mbedtls_ssl_session session;
+    EXPECT_EQ(wrapper->get_session(&session), NSAPI_ERROR_NO_CONNECTION);
+}
+
+TEST_F(TestTLSSocketWrapper, set_session_resumed_in_handshake)
+{
+    mbedtls_ssl_session session;
+    transport->open(&stack);
+    mbedtls_stub.useCounter = true;
+    EXPECT_EQ(wrapper->set_session(&session), NSAPI_ERROR_OK);
+    const SocketAddress a("127.0.0.1", 1024);
+    EXPECT_EQ(wrapper->connect(a), NSAPI_ERROR_OK);
+    // mbedtls_ssl_config_defaults, mbedtls_ssl_setup, mbedtls_ssl_set_session, mbedtls_ssl_handshake
+    EXPECT_EQ(mbedtls_stub.counter, 4);
+    EXPECT_EQ(wrapper->set_session(&session), NSAPI_ERROR_ALREADY);
+    EXPECT_EQ(wrapper->get_session(&session), NSAPI_ERROR_OK);
+}
+
+TEST_F(TestTLSSocketWrapper, set_session_fail_full_handshake)
+{
+    mbedtls_ssl_session session;
+    transport->open(&stack);
+    mbedtls_stub.useCounter = true;
+    mbedtls_stub.retArray[2] = MBEDTLS_ERR_SSL_BAD_INPUT_DATA; // mbedtls_ssl_set_session error
+    EXPECT_EQ(wrapper->set_session(&session), NSAPI_ERROR_OK);
+    const SocketAddress a("127.0.0.1", 1024);
+    EXPECT_EQ(wrapper->connect(a), NSAPI_ERROR_OK);
+}
+
+TEST_F(TestTLSSocketWrapper, set_max_fragment_length)
+{
+    transport->open(&stack);
+    EXPECT_EQ(wrapper->set_max_fragment_length(1000), NSAPI_ERROR_PARAMETER);
+    EXPECT_EQ(wrapper->set_max_fragment_length(4096), NSAPI_ERROR_OK);
+    EXPECT_EQ(wrapper->set_max_fragment_length(0), NSAPI_ERROR_OK);
+    const SocketAddress a("127.0.0.1", 1024);
+    EXPECT_EQ(wrapper->connect(a), NSAPI_ERROR_OK);
+    EXPECT_EQ(wrapper->set_max_fragment_length(512), NSAPI_ERROR_ALREADY);
+}
+
+TEST_F(TestTLSSocketWrapper, set_max_fragment_length_rejected)
+{
+    transport->open(&stack);
+    mbedtls_stub.useCounter = true;
+    mbedtls_stub.retArray[1] = MBEDTLS_ERR_SSL_BAD_INPUT_DATA; // mbedtls_ssl_conf_max_frag_len error
+    EXPECT_EQ(wrapper->set_max_fragment_length(2048), NSAPI_ERROR_PARAMETER);
+}
+
+TEST_F(TestTLSSocketWrapper, get_session_fail)
+{
+    mbedtls_ssl_session session;
+    transport->open(&stack);
+    mbedtls_stub.useCounter = true;
+    mbedtls_stub.retArray[3] = MBEDTLS_ERR_SSL_ALLOC_FAILED; // mbedtls_ssl_get_session error
+    const SocketAddress a("127.0.0.1", 1024);
+    EXPECT_EQ(wrapper->connect(a), NSAPI_ERROR_OK);
+    EXPECT_EQ(wrapper->get_session(&session), NSAPI_ERROR_NO_MEMORY);
+}
+
 /* send */
 
 TEST_F(TestTLSSocketWrapper, send_no_open)
@@ -278,6 +341,64 @@ TEST_F(TestTLSSocketWrapper, send_device_error)
     EXPECT_EQ(wrapper->send(dataBuf, dataSize), NSAPI_ERROR_DEVICE_ERROR);
 }
 
+/* cork */
+
+TEST_F(TestTLSSocketWrapper, cork_no_socket)
+{
+    wrapper->close();
+    EXPECT_EQ(wrapper->set_cork(true), NSAPI_ERROR_NO_SOCKET);
+    EXPECT_EQ(wrapper->flush(), NSAPI_ERROR_NO_SOCKET);
+}
+
+TEST_F(TestTLSSocketWrapper, cork_coalesces_sends)
+{
+    transport->open(&stack);
+    mbedtls_stub.useCounter = true;
+    mbedtls_stub.retArray[3] = 2 * dataSize; // mbedtls_ssl_write
+    const SocketAddress a("127.0.0.1", 1024);
+    EXPECT_EQ(wrapper->connect(a), NSAPI_ERROR_OK);
+    EXPECT_EQ(wrapper->set_cork(true), NSAPI_ERROR_OK);
+    EXPECT_EQ(wrapper->send(dataBuf, dataSize), dataSize);
+    EXPECT_EQ(wrapper->send(dataBuf, dataSize), dataSize);
+    EXPECT_EQ(mbedtls_stub.counter, 3); // Nothing written yet
+    EXPECT_EQ(wrapper->flush(), NSAPI_ERROR_OK);
+    EXPECT_EQ(mbedtls_stub.counter, 4); // One record
+    EXPECT_EQ(wrapper->flush(), NSAPI_ERROR_OK);
+    EXPECT_EQ(mbedtls_stub.counter, 4);
+}
+
+TEST_F(TestTLSSocketWrapper, cork_full_buffer_sent)
+{
+    static char big[MBED_CONF_NSAPI_TLS_CORK_BUFFER_SIZE + 10];
+    transport->open(&stack);
+    mbedtls_stub.useCounter = true;
+    mbedtls_stub.retArray[3] = MBED_CONF_NSAPI_TLS_CORK_BUFFER_SIZE; // mbedtls_ssl_write
+    const SocketAddress a("127.0.0.1", 1024);
+    EXPECT_EQ(wrapper->connect(a), NSAPI_ERROR_OK);
+    EXPECT_EQ(wrapper->set_cork(true), NSAPI_ERROR_OK);
+    EXPECT_EQ(wrapper->send(big, sizeof(big)), sizeof(big));
+    EXPECT_EQ(mbedtls_stub.counter, 4); // The first full record
+}
+
+TEST_F(TestTLSSocketWrapper, cork_flush_would_block)
+{
+    transport->open(&stack);
+    wrapper->set_blocking(false);
+    mbedtls_stub.useCounter = true;
+    mbedtls_stub.retArray[3] = MBEDTLS_ERR_SSL_WANT_WRITE; // mbedtls_ssl_write
+    mbedtls_stub.retArray[4] = MBEDTLS_ERR_SSL_WANT_WRITE; // mbedtls_ssl_write, again
+    mbedtls_stub.retArray[5] = dataSize;                   // mbedtls_ssl_write
+    const SocketAddress a("127.0.0.1", 1024);
+    wrapper->connect(a);
+    EXPECT_EQ(wrapper->set_cork(true), NSAPI_ERROR_OK);
+    EXPECT_EQ(wrapper->send(dataBuf, dataSize), dataSize);
+    EXPECT_EQ(wrapper->flush(), NSAPI_ERROR_WOULD_BLOCK);
+    // The pending record is written before more data is buffered
+    EXPECT_EQ(wrapper->send(dataBuf, dataSize), NSAPI_ERROR_WOULD_BLOCK);
+    EXPECT_EQ(wrapper->set_cork(false), NSAPI_ERROR_OK);
+    EXPECT_EQ(mbedtls_stub.counter, 6);
+}
+
 TEST_F(TestTLSSocketWrapper, send_to)
 {
     transport->open(&stack);
@@ -385,6 +506,53 @@ TEST_F(TestTLSSocketWrapper, set_root_ca_cert)
     EXPECT_NE(wrapper->get_ca_chain(), static_cast<mbedtls_x509_crt *>(NULL));
 }
 
+TEST_F(TestTLSSocketWrapper, set_shared_ca_chain)
+{
+    mbed::SharedPtr<TLSCAChain> ca(new TLSCAChain);
+    EXPECT_EQ(ca->get_crt(), static_cast<mbedtls_x509_crt *>(NULL));
+    EXPECT_EQ(ca->parse(cert), NSAPI_ERROR_OK);
+    EXPECT_NE(ca->get_crt(), static_cast<mbedtls_x509_crt *>(NULL));
+
+    wrapper->set_ca_chain(ca);
+    EXPECT_EQ(wrapper->get_ca_chain(), ca->get_crt());
+    EXPECT_EQ(ca.use_count(), 2);
+
+    // A chain set otherwise drops the reference
+    EXPECT_EQ(wrapper->set_root_ca_cert(cert, strlen(cert)), NSAPI_ERROR_OK);
+    EXPECT_NE(wrapper->get_ca_chain(), ca->get_crt());
+    EXPECT_EQ(ca.use_count(), 1);
+
+    wrapper->set_ca_chain(ca);
+    wrapper->set_ca_chain(mbed::SharedPtr<TLSCAChain>());
+    EXPECT_EQ(wrapper->get_ca_chain(), static_cast<mbedtls_x509_crt *>(NULL));
+    EXPECT_EQ(ca.use_count(), 1);
+}
+
+TEST_F(TestTLSSocketWrapper, set_shared_ca_chain_invalid)
+{
+    TLSCAChain ca;
+    mbedtls_stub.useCounter = true;
+    mbedtls_stub.retArray[0] = -1; // mbedtls_x509_crt_parse error
+    EXPECT_EQ(ca.parse(cert), NSAPI_ERROR_PARAMETER);
+    EXPECT_EQ(ca.get_crt(), static_cast<mbedtls_x509_crt *>(NULL));
+}
+
+TEST_F(TestTLSSocketWrapper, set_root_ca_cert_nocopy)
+{
+    static const unsigned char der[] = { 0x30, 0x03, 0x02, 0x01, 0x00 };
+    EXPECT_EQ(wrapper->set_root_ca_cert_nocopy(der, sizeof(der)), NSAPI_ERROR_OK);
+    EXPECT_NE(wrapper->get_ca_chain(), static_cast<mbedtls_x509_crt *>(NULL));
+}
+
+TEST_F(TestTLSSocketWrapper, set_root_ca_cert_nocopy_invalid)
+{
+    static const unsigned char der[] = { 0x30, 0x03, 0x02, 0x01, 0x00 };
+    EXPECT_EQ(wrapper->set_root_ca_cert_nocopy(der, 0), NSAPI_ERROR_PARAMETER);
+    mbedtls_stub.crt_expected_int = 1; // mbedtls_x509_crt_parse_der_nocopy error
+    EXPECT_EQ(wrapper->set_root_ca_cert_nocopy(der, sizeof(der)), NSAPI_ERROR_PARAMETER);
+    EXPECT_EQ(wrapper->get_ca_chain(), static_cast<mbedtls_x509_crt *>(NULL));
+}
+
 TEST_F(TestTLSSocketWrapper, set_root_ca_cert_nolen)
 {
     EXPECT_EQ(transport->open(&stack), NSAPI_ERROR_OK);
@@ -19,6 +19,7 @@
 #define UNITTESTS_FEATURES_NETSOCKET_TLSSOCKET_TLS_TEST_CONFIG_H_
 
 #define MBEDTLS_SSL_CLI_C
+#define MBEDTLS_SSL_MAX_FRAGMENT_LENGTH
 
 
 #endif /* UNITTESTS_FEATURES_NETSOCKET_TLSSOCKET_TLS_TEST_CONFIG_H_ */
@@ -145,6 +145,79 @@ TEST_F(TestUDPSocket, recv_address_filtering)
     EXPECT_EQ(socket->recvfrom(&a1, &dataBuf, dataSize), 100);
 }
 
+TEST_F(TestUDPSocket, sendmsg)
+{
+    const nsapi_addr_t addr = {NSAPI_IPv4, {127, 0, 0, 1} };
+    const SocketAddress a(addr, 1024);
+    const nsapi_iovec_t iov[] = {{dataBuf, 4}, {dataBuf + 4, dataSize - 4}};
+    EXPECT_EQ(socket->sendmsg(&a, iov), NSAPI_ERROR_NO_SOCKET);
+
+    socket->open(&stack);
+    EXPECT_EQ(socket->sendmsg(NULL, iov), NSAPI_ERROR_NO_ADDRESS);
+
+    stack.return_value = dataSize;
+    EXPECT_EQ(socket->sendmsg(&a, iov), dataSize);
+
+    EXPECT_EQ(socket->connect(a), NSAPI_ERROR_OK);
+    EXPECT_EQ(socket->sendmsg(NULL, iov), dataSize);
+}
+
+TEST_F(TestUDPSocket, recvmsg)
+{
+    const nsapi_iovec_t iov[] = {{dataBuf, 4}, {dataBuf + 4, dataSize - 4}};
+    EXPECT_EQ(socket->recvmsg(NULL, iov), NSAPI_ERROR_NO_SOCKET);
+
+    socket->open(&stack);
+    stack.return_values.push_back(7);
+    EXPECT_EQ(socket->recvmsg(NULL, iov), 7);
+}
+
+TEST_F(TestUDPSocket, recvfrom_batch)
+{
+    char buf[3][10];
+    nsapi_datagram_t datagrams[3] = {{buf[0], 10}, {buf[1], 10}, {buf[2], 10}};
+    EXPECT_EQ(socket->recvfrom_batch(datagrams), NSAPI_ERROR_NO_SOCKET);
+
+    socket->open(&stack);
+    stack.return_values.push_back(5);
+    stack.return_values.push_back(6);
+    stack.return_values.push_back(NSAPI_ERROR_WOULD_BLOCK);
+    EXPECT_EQ(socket->recvfrom_batch(datagrams), 2);
+    EXPECT_EQ(datagrams[0].len, 5);
+    EXPECT_EQ(datagrams[1].len, 6);
+
+    stack.return_values.push_back(7);
+    stack.return_values.push_back(7);
+    stack.return_values.push_back(7);
+    EXPECT_EQ(socket->recvfrom_batch(datagrams), 3);
+}
+
+TEST_F(TestUDPSocket, recvfrom_batch_address_filtering)
+{
+    char buf[2][10];
+    nsapi_datagram_t datagrams[2] = {{buf[0], 10}, {buf[1], 10}};
+    socket->open(&stack);
+    const nsapi_addr_t addr1 = {NSAPI_IPv4, {127, 0, 0, 1} };
+    const nsapi_addr_t addr2 = {NSAPI_IPv4, {127, 0, 0, 2} };
+    SocketAddress a1(addr1, 1024);
+    SocketAddress a2(addr2, 1024);
+
+    EXPECT_EQ(socket->connect(a1), NSAPI_ERROR_OK);
+
+    stack.return_socketAddress = a2;
+    stack.return_values.push_back(100); //This will not return, because wrong address is used.
+    stack.return_values.push_back(NSAPI_ERROR_WOULD_BLOCK);
+    stack.return_values.push_back(NSAPI_ERROR_NO_MEMORY); //Break the loop of waiting for data from a1.
+    EXPECT_EQ(socket->recvfrom_batch(datagrams), NSAPI_ERROR_NO_MEMORY);
+
+    stack.return_socketAddress = a1;
+    stack.return_values.push_back(100);
+    stack.return_values.push_back(NSAPI_ERROR_WOULD_BLOCK);
+    EXPECT_EQ(socket->recvfrom_batch(datagrams), 1);
+    EXPECT_EQ(datagrams[0].len, 100);
+    EXPECT_EQ(datagrams[0].address, a1);
+}
+
 TEST_F(TestUDPSocket, unsupported_api)
 {
     nsapi_error_t error;
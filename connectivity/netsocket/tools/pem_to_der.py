@@ -0,0 +1,70 @@
+#!/usr/bin/env python3
+"""
+Convert PEM certificates to a C array of DER certificates.
+
+    python3 pem_to_der.py [--name root_ca_der] ca1.pem [ca2.pem ...] root_ca.c
+
+The certificates of all inputs are concatenated. The array is const, so it
+stays in flash, and can be passed to TLSSocketWrapper::set_root_ca_cert_nocopy()
+or TLSCAChain::parse_der_nocopy() without a copy on the heap:
+
+    extern const unsigned char root_ca_der[];
+    extern const size_t root_ca_der_len;
+    socket.set_root_ca_cert_nocopy(root_ca_der, root_ca_der_len);
+
+Copyright (c) 2021, Arm Limited, All Rights Reserved
+SPDX-License-Identifier: Apache-2.0
+"""
+
+import argparse
+import base64
+import re
+import sys
+
+PEM_RE = re.compile(r'-----BEGIN CERTIFICATE-----(.*?)-----END CERTIFICATE-----', re.S)
+
+
+def read_certificates(path):
+    """Return the DER of every certificate of a PEM file."""
+    with open(path) as f:
+        text = f.read()
+    ders = [base64.b64decode(''.join(body.split())) for body in PEM_RE.findall(text)]
+    if not ders:
+        sys.exit('no certificate in %s' % path)
+    return ders
+
+
+def c_array(ders, name):
+    image = b''.join(ders)
+    lines = ['/* Generated by pem_to_der.py, %d certificate(s) */' % len(ders),
+             '#include <stddef.h>',
+             '',
+             'extern const unsigned char %s[];' % name,
+             'extern const size_t %s_len;' % name,
+             '',
+             'const unsigned char %s[%d] = {' % (name, len(image))]
+    for i in range(0, len(image), 12):
+        lines.append('    ' + ' '.join('0x%02x,' % b for b in image[i:i + 12]))
+    lines.append('};')
+    lines.append('')
+    lines.append('const size_t %s_len = sizeof(%s);' % (name, name))
+    return '\n'.join(lines) + '\n'
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Convert PEM certificates to a C array of DER certificates')
+    parser.add_argument('inputs', nargs='+', help='PEM files')
+    parser.add_argument('output', help='C file to write')
+    parser.add_argument('--name', default='root_ca_der',
+                        help='name of the array (default root_ca_der)')
+    args = parser.parse_args()
+
+    ders = []
+    for path in args.inputs:
+        ders += read_certificates(path)
+    with open(args.output, 'w') as f:
+        f.write(c_array(ders, args.name))
+
+
+if __name__ == '__main__':
+    main()
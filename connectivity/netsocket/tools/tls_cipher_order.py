@@ -0,0 +1,62 @@
+#!/usr/bin/env python3
+"""
+Order the TLS ciphers of a target by the speed measured on it.
+
+    python3 tls_cipher_order.py [--target NAME] benchmark.log
+
+The log is the output of the mbed-connectivity-mbedtls-benchmark test,
+which prints a line like "AES-128-GCM: 1234 KiB/s, 5.67 cycles/byte" for
+each bulk cipher. The mbed_app.json setting of nsapi.tls-cipher-order
+listing them fastest first is printed, for TLSSocketWrapper to offer the
+cipher suites in that order.
+
+Copyright (c) 2021, Arm Limited, All Rights Reserved
+SPDX-License-Identifier: Apache-2.0
+"""
+
+import argparse
+import json
+import re
+import sys
+
+CIPHERS = {
+    'AES-128-GCM': 'MBEDTLS_CIPHER_AES_128_GCM',
+    'AES-256-GCM': 'MBEDTLS_CIPHER_AES_256_GCM',
+    'AES-128-CCM': 'MBEDTLS_CIPHER_AES_128_CCM',
+    'AES-256-CCM': 'MBEDTLS_CIPHER_AES_256_CCM',
+    'CHACHA20-POLY1305': 'MBEDTLS_CIPHER_CHACHA20_POLY1305',
+}
+
+RESULT_RE = re.compile(r'([A-Z0-9-]+): (\d+) KiB/s')
+
+
+def measured_speeds(path):
+    """Return the KiB/s of each known cipher found in the log."""
+    speeds = {}
+    with open(path) as f:
+        for line in f:
+            match = RESULT_RE.search(line)
+            if match and match.group(1) in CIPHERS:
+                speeds[match.group(1)] = int(match.group(2))
+    return speeds
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Order the TLS ciphers by measured speed')
+    parser.add_argument('log', help='output of the mbedtls benchmark test')
+    parser.add_argument('--target', help='print it as an override of this target')
+    args = parser.parse_args()
+
+    speeds = measured_speeds(args.log)
+    if not speeds:
+        sys.exit('no cipher result in %s' % args.log)
+
+    order = sorted(speeds, key=lambda name: speeds[name], reverse=True)
+    setting = {'nsapi.tls-cipher-order': ','.join(CIPHERS[name] for name in order)}
+    if args.target:
+        setting = {'target_overrides': {args.target: setting}}
+    print(json.dumps(setting, indent=4))
+
+
+if __name__ == '__main__':
+    main()
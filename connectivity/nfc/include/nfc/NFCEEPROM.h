@@ -25,6 +25,11 @@
 #include "NFCTarget.h"
 #include "NFCEEPROMDriver.h"
 
+/** Number of EEPROM regions whose content is tracked when the cache is enabled, at most 32 */
+#ifndef MBED_CONF_NFC_EEPROM_CACHE_REGIONS
+#define MBED_CONF_NFC_EEPROM_CACHE_REGIONS 32
+#endif
+
 namespace mbed {
 namespace nfc {
 
@@ -99,6 +104,27 @@ public:
      */
     void set_delegate(Delegate *delegate);
 
+    /**
+     * Keep track of the NDEF message held by the EEPROM.
+     *
+     * Once enabled, a fingerprint of each region of the EEPROM is kept from the
+     * messages written and read. Writing a message then leaves out the regions
+     * (and the size) that the EEPROM already holds, and reading returns the last
+     * message without accessing the EEPROM.
+     *
+     * @note Only enable this if the NFC interface of the tag is read-only, or call
+     * invalidate_cache() when it may have been written: changes made over NFC
+     * are not seen.
+     *
+     * @param[in] enabled whether to keep track of the EEPROM content
+     */
+    void set_cache_enabled(bool enabled);
+
+    /**
+     * Forget the content of the EEPROM, so that the next operations access all of it.
+     */
+    void invalidate_cache();
+
     // Implementation of NFCTarget
     virtual void write_ndef_message();
     virtual void read_ndef_message();
@@ -118,6 +144,8 @@ private:
     void continue_write();
     void continue_read();
     void continue_erase();
+    static uint32_t fingerprint(const uint8_t *bytes, size_t count);
+    void cache_read_message();
 
     // NFCNDEFCapable implementation
     virtual NFCNDEFCapable::Delegate *ndef_capable_delegate();
@@ -152,6 +180,14 @@ private:
     size_t _ndef_buffer_read_sz;
     uint32_t _eeprom_address;
     nfc_err_t _operation_result;
+
+    bool _cache_enabled;
+    bool _message_cached;
+    bool _size_cached;
+    size_t _cached_size;
+    size_t _region_size;
+    uint32_t _cached_regions;
+    uint32_t _region_fingerprints[MBED_CONF_NFC_EEPROM_CACHE_REGIONS];
 };
 /** @}*/
 } // namespace nfc
@@ -130,6 +130,18 @@ public:
      */
     virtual size_t read_max_size() = 0;
 
+    /**
+     * Get the number of bytes the EEPROM writes in one go.
+     *
+     * Writes are aligned to and sized in multiples of this when possible.
+     *
+     * @return the write page size in bytes, or 0 if the EEPROM has no preference
+     */
+    virtual size_t write_page_size()
+    {
+        return 0;
+    }
+
     /**
      * Start a session of operations (reads, writes, erases, size gets/sets).
      * This method is called prior to any memory access to allow the underlying implementation
@@ -78,6 +78,51 @@ public:
             return 0;
         }
 
+        /**
+         * Stream the NDEF message rather than build it.
+         *
+         * If the message is streamed, it is read in parts through read_ndef_message()
+         * and written in parts through write_ndef_message() as the remote party
+         * exchanges it, so it does not need to fit in the buffer.
+         *
+         * @param[out] size the size of the message the remote party can read
+         * @param[out] max_size the size of the largest message the remote party can write
+         *
+         * @return whether the message is streamed
+         */
+        virtual bool stream_ndef_message(size_t &size, size_t &max_size)
+        {
+            return false;
+        }
+
+        /**
+         * Read part of a streamed NDEF message.
+         *
+         * @param[in] offset the offset within the message of the first byte to read
+         * @param[in] buffer a mutable buffer in which the bytes should be stored
+         *
+         * @return the number of bytes actually read
+         */
+        virtual size_t read_ndef_message(size_t offset, const Span<uint8_t> &buffer)
+        {
+            return 0;
+        }
+
+        /**
+         * Write part of a streamed NDEF message.
+         *
+         * @param[in] offset the offset within the message of the first byte written
+         * @param[in] buffer a buffer containing the bytes written
+         */
+        virtual void write_ndef_message(size_t offset, const Span<const uint8_t> &buffer) { }
+
+        /**
+         * Called once the remote party has written a streamed NDEF message.
+         *
+         * @param[in] size the size of the message written
+         */
+        virtual void ndef_message_written(size_t size) { }
+
     protected:
         ~Delegate() {}
     };
@@ -115,8 +160,12 @@ private:
     // Callbacks from NDEF stack
     static nfc_err_t s_ndef_encode(ndef_msg_t *pTag, ac_buffer_builder_t *pBufferBldr, void *pUserData);
     static nfc_err_t s_ndef_decode(ndef_msg_t *pTag, ac_buffer_t *pBuffer, void *pUserData);
+    static nfc_err_t s_ndef_stream_read(ndef_msg_t *pTag, size_t offset, ac_buffer_builder_t *pBufferBldr, void *pUserData);
+    static nfc_err_t s_ndef_stream_write(ndef_msg_t *pTag, size_t offset, ac_buffer_t *pBuffer, void *pUserData);
     nfc_err_t ndef_encode(ac_buffer_builder_t *pBufferBldr);
     nfc_err_t ndef_decode(ac_buffer_t *pBuffer);
+    nfc_err_t ndef_stream_read(size_t offset, ac_buffer_builder_t *pBufferBldr);
+    nfc_err_t ndef_stream_write(size_t offset, ac_buffer_t *pBuffer);
 
     ndef_msg_t _ndef_message;
 };
@@ -42,10 +42,51 @@ void ndef_msg_init(ndef_msg_t *pNdef, ndef_encode_fn_t encode, ndef_decode_fn_t
 {
     pNdef->encode = encode;
     pNdef->decode = decode;
+    pNdef->streamRead = NULL;
+    pNdef->streamWrite = NULL;
     ac_buffer_builder_init(&pNdef->bufferBldr, data, size);
+    pNdef->streamed = false;
+    pNdef->length = 0;
+    pNdef->maxLength = 0;
     pNdef->pUserData = pUserData;
 }
 
+/** Set the functions used to exchange a streamed NDEF message
+ * \param pNdef pointer to ndef_msg_t structure
+ * \param read function that will be called to generate part of the message when the other party reads it
+ * \param write function that will be called with part of the message when the other party writes it
+ */
+void ndef_msg_set_stream_callbacks(ndef_msg_t *pNdef, ndef_stream_read_fn_t read, ndef_stream_write_fn_t write)
+{
+    pNdef->streamRead = read;
+    pNdef->streamWrite = write;
+}
+
+/** Stream the NDEF message rather than build it in the underlying buffer
+ * To be called from the encode function. The message is then read and written in parts through the stream
+ * functions, with the underlying buffer only holding one part at a time. Once the other party has written
+ * a message, the decode function is called with an empty buffer and ndef_msg_length() returns its length.
+ * \param pNdef pointer to ndef_msg_t structure
+ * \param length length of the message to read
+ * \param maxLength length of the longest message that can be written
+ */
+void ndef_msg_stream(ndef_msg_t *pNdef, size_t length, size_t maxLength)
+{
+    pNdef->streamed = true;
+    pNdef->length = length;
+    pNdef->maxLength = maxLength;
+}
+
+/** Go back to building the NDEF message in the underlying buffer
+ * \param pNdef pointer to ndef_msg_t structure
+ */
+void ndef_msg_unstream(ndef_msg_t *pNdef)
+{
+    pNdef->streamed = false;
+    pNdef->length = 0;
+    pNdef->maxLength = 0;
+}
+
 /** Get NDEF tag implementation
  * \param pNdefTag pointer to ndef_tag_t structure
  * \return implementation
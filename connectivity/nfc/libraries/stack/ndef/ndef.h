@@ -50,14 +50,36 @@ typedef nfc_err_t (*ndef_encode_fn_t)(ndef_msg_t *pTag, ac_buffer_builder_t *pBu
  */
 typedef nfc_err_t (*ndef_decode_fn_t)(ndef_msg_t *pTag, ac_buffer_t *pBuffer, void *pUserData);
 
+/** Function called to read part of a streamed message (target mode)
+ * \param pTag pointer to ndef_tag_t instance
+ * \param offset offset within the message of the first byte to read
+ * \param pBufferBldr buffer builder in which to store the bytes following offset, as many as it can hold
+ */
+typedef nfc_err_t (*ndef_stream_read_fn_t)(ndef_msg_t *pTag, size_t offset, ac_buffer_builder_t *pBufferBldr, void *pUserData);
+
+/** Function called with part of a streamed message written by the other party (target mode)
+ * \param pTag pointer to ndef_tag_t instance
+ * \param offset offset within the message of the first byte written
+ * \param pBuffer buffer containing the bytes written, it can be a chain of buffers
+ */
+typedef nfc_err_t (*ndef_stream_write_fn_t)(ndef_msg_t *pTag, size_t offset, ac_buffer_t *pBuffer, void *pUserData);
+
 struct __ndef_msg {
     ndef_encode_fn_t encode;
     ndef_decode_fn_t decode;
+    ndef_stream_read_fn_t streamRead;
+    ndef_stream_write_fn_t streamWrite;
     ac_buffer_builder_t bufferBldr;
+    bool streamed;
+    size_t length;
+    size_t maxLength;
     void *pUserData;
 };
 
 void ndef_msg_init(ndef_msg_t *pNdef, ndef_encode_fn_t encode, ndef_decode_fn_t decode, uint8_t *data, size_t size, void *pUserData);
+void ndef_msg_set_stream_callbacks(ndef_msg_t *pNdef, ndef_stream_read_fn_t read, ndef_stream_write_fn_t write);
+void ndef_msg_stream(ndef_msg_t *pNdef, size_t length, size_t maxLength);
+void ndef_msg_unstream(ndef_msg_t *pNdef);
 
 static inline nfc_err_t ndef_msg_encode(ndef_msg_t *pNdef)
 {
@@ -80,6 +102,42 @@ static inline ac_buffer_builder_t *ndef_msg_buffer_builder(ndef_msg_t *pNdef)
     return &pNdef->bufferBldr;
 }
 
+static inline bool ndef_msg_is_streamed(ndef_msg_t *pNdef)
+{
+    return pNdef->streamed;
+}
+
+static inline size_t ndef_msg_length(ndef_msg_t *pNdef)
+{
+    return pNdef->length;
+}
+
+static inline size_t ndef_msg_max_length(ndef_msg_t *pNdef)
+{
+    return pNdef->maxLength;
+}
+
+static inline void ndef_msg_set_length(ndef_msg_t *pNdef, size_t length)
+{
+    pNdef->length = length;
+}
+
+static inline nfc_err_t ndef_msg_stream_read(ndef_msg_t *pNdef, size_t offset, ac_buffer_builder_t *pBufferBldr)
+{
+    if (pNdef->streamRead == NULL) {
+        return NFC_OK;
+    }
+    return pNdef->streamRead(pNdef, offset, pBufferBldr, pNdef->pUserData);
+}
+
+static inline nfc_err_t ndef_msg_stream_write(ndef_msg_t *pNdef, size_t offset, ac_buffer_t *pBuffer)
+{
+    if (pNdef->streamWrite == NULL) {
+        return NFC_OK;
+    }
+    return pNdef->streamWrite(pNdef, offset, pBuffer, pNdef->pUserData);
+}
+
 //void* ndef_tag_impl(ndef_tag_t* pNdefTag);
 
 #ifdef __cplusplus
@@ -40,6 +40,7 @@ static const uint8_t aid[] = { 0xD2, 0x76, 0x00, 0x00, 0x85, 0x01, 0x00 };
 #define CC_FILE 0xE103 //Must not be changed
 #define NDEF_FILE 0xA443
 #define DEFAULT_FILE 0x0000
+#define TYPE4_MAX_NDEF_SIZE (0xFFFF - 2) //Limited by the 16-bit size of the NDEF file, including its length header
 
 static void app_selected(nfc_tech_iso7816_app_t *pIso7816App, void *pUserData);
 static void app_deselected(nfc_tech_iso7816_app_t *pIso7816App, void *pUserData);
@@ -47,6 +48,8 @@ static void app_apdu(nfc_tech_iso7816_app_t *pIso7816App, void *pUserData);
 
 static nfc_err_t data_read(nfc_tech_type4_target_t *pType4Target, ac_buffer_t *pBuf, uint16_t file, size_t off, size_t len);
 static nfc_err_t data_write(nfc_tech_type4_target_t *pType4Target, ac_buffer_t *pBuf, uint16_t file, size_t off);
+static nfc_err_t ndef_stream_read(nfc_tech_type4_target_t *pType4Target, ac_buffer_t *pBuf, size_t off, size_t len);
+static nfc_err_t ndef_stream_write(nfc_tech_type4_target_t *pType4Target, ac_buffer_t *pBuf, size_t off);
 
 void nfc_tech_type4_target_init(nfc_tech_type4_target_t *pType4Target, nfc_tech_iso7816_t *pIso7816, ndef_msg_t *pNdef)
 {
@@ -72,6 +75,17 @@ void app_selected(nfc_tech_iso7816_app_t *pIso7816App, void *pUserData)
 
     ac_buffer_builder_reset(ndef_msg_buffer_builder(pType4Target->pNdef));
 
+    //Encode NDEF file, this is where the message can switch to streaming
+    ndef_msg_unstream(pType4Target->pNdef);
+    ndef_msg_encode(pType4Target->pNdef);
+
+    size_t maxNdefSize;
+    if (ndef_msg_is_streamed(pType4Target->pNdef)) {
+        maxNdefSize = MIN(MAX(ndef_msg_max_length(pType4Target->pNdef), ndef_msg_length(pType4Target->pNdef)), TYPE4_MAX_NDEF_SIZE);
+    } else {
+        maxNdefSize = ac_buffer_builder_writable(ndef_msg_buffer_builder(pType4Target->pNdef)) + ac_buffer_reader_readable(ac_buffer_builder_buffer(ndef_msg_buffer_builder(pType4Target->pNdef)));
+    }
+
     //Populate CC file
     ac_buffer_builder_reset(&pType4Target->ccFileBldr);
     ac_buffer_builder_write_nu16(&pType4Target->ccFileBldr, 15);   //CC file is 15 bytes long
@@ -85,21 +99,23 @@ void app_selected(nfc_tech_iso7816_app_t *pIso7816App, void *pUserData)
     ac_buffer_builder_write_nu8(&pType4Target->ccFileBldr, 0x04);   //NDEF File Control TLV - Type
     ac_buffer_builder_write_nu8(&pType4Target->ccFileBldr, 6);   //NDEF File Control TLV - Length
     ac_buffer_builder_write_nu16(&pType4Target->ccFileBldr, NDEF_FILE);   //NDEF file id
-    ac_buffer_builder_write_nu16(&pType4Target->ccFileBldr, 2 /* length header */ + ac_buffer_builder_writable(ndef_msg_buffer_builder(pType4Target->pNdef)));     //Max size of NDEF data
+    ac_buffer_builder_write_nu16(&pType4Target->ccFileBldr, 2 /* length header */ + maxNdefSize);     //Max size of NDEF data
     ac_buffer_builder_write_nu8(&pType4Target->ccFileBldr, 0x00);   //Open read access
     ac_buffer_builder_write_nu8(&pType4Target->ccFileBldr, 0x00);   //Open write access
 
-    //Encode NDEF file
-    ndef_msg_encode(pType4Target->pNdef);
-
     //Populate NDEF file
     ac_buffer_builder_init(&pType4Target->ndefFileBldr, pType4Target->ndefFileBuf, /*sizeof(pType4Target->ndefFileBuf)*/2);
 
-    ac_buffer_builder_write_nu16(&pType4Target->ndefFileBldr, ac_buffer_reader_readable(ac_buffer_builder_buffer(ndef_msg_buffer_builder(pType4Target->pNdef))));
+    if (ndef_msg_is_streamed(pType4Target->pNdef)) {
+        //The message is generated as it is read, the buffer only holds one response at a time
+        ac_buffer_builder_write_nu16(&pType4Target->ndefFileBldr, MIN(ndef_msg_length(pType4Target->pNdef), TYPE4_MAX_NDEF_SIZE));
+    } else {
+        ac_buffer_builder_write_nu16(&pType4Target->ndefFileBldr, ac_buffer_reader_readable(ac_buffer_builder_buffer(ndef_msg_buffer_builder(pType4Target->pNdef))));
 
-    //Pad NDEF file with 0s
-    while (ac_buffer_builder_writable(ndef_msg_buffer_builder(pType4Target->pNdef)) > 0) {
-        ac_buffer_builder_write_nu8(ndef_msg_buffer_builder(pType4Target->pNdef), 0);
+        //Pad NDEF file with 0s
+        size_t padding = ac_buffer_builder_writable(ndef_msg_buffer_builder(pType4Target->pNdef));
+        memset(ac_buffer_builder_write_position(ndef_msg_buffer_builder(pType4Target->pNdef)), 0, padding);
+        ac_buffer_builder_write_n_skip(ndef_msg_buffer_builder(pType4Target->pNdef), padding);
     }
 
     //No file selected
@@ -127,7 +143,15 @@ void app_deselected(nfc_tech_iso7816_app_t *pIso7816App, void *pUserData)
         //Set buffer length based on file header
         size_t length = ac_buffer_read_nu16(ac_buffer_builder_buffer(&pType4Target->ndefFileBldr));
         NFC_DBG("Length is %lu", length);
-        if (length < ac_buffer_builder_writable(ndef_msg_buffer_builder(pType4Target->pNdef))) {
+        if (ndef_msg_is_streamed(pType4Target->pNdef)) {
+            //The message has already been passed on as it was written
+            if (length <= ndef_msg_max_length(pType4Target->pNdef)) {
+                ndef_msg_set_length(pType4Target->pNdef, length);
+                ndef_msg_decode(pType4Target->pNdef);
+            } else {
+                NFC_ERR("Invalid length");
+            }
+        } else if (length < ac_buffer_builder_writable(ndef_msg_buffer_builder(pType4Target->pNdef))) {
             ac_buffer_builder_set_write_offset(ndef_msg_buffer_builder(pType4Target->pNdef), length);
             ndef_msg_decode(pType4Target->pNdef);
         } else {
@@ -145,7 +169,12 @@ void app_apdu(nfc_tech_iso7816_app_t *pIso7816App, void *pUserData)
     ac_buffer_builder_set_full(&pType4Target->ndefFileBldr);
     ac_buffer_builder_set_full(ndef_msg_buffer_builder(pType4Target->pNdef));   //Set offset to 0, size to max
 
-    ac_buffer_set_next(ac_buffer_builder_buffer(&pType4Target->ndefFileBldr), ac_buffer_builder_buffer(ndef_msg_buffer_builder(pType4Target->pNdef)));
+    if (ndef_msg_is_streamed(pType4Target->pNdef)) {
+        //Only the length header is held in RAM
+        ac_buffer_set_next(ac_buffer_builder_buffer(&pType4Target->ndefFileBldr), NULL);
+    } else {
+        ac_buffer_set_next(ac_buffer_builder_buffer(&pType4Target->ndefFileBldr), ac_buffer_builder_buffer(ndef_msg_buffer_builder(pType4Target->pNdef)));
+    }
 
     //Recover PDU
     nfc_tech_iso7816_c_apdu_t *pCApdu = nfc_tech_iso7816_app_c_apdu(pIso7816App);
@@ -223,6 +252,9 @@ nfc_err_t data_read(nfc_tech_type4_target_t *pType4Target, ac_buffer_t *pBuf, ui
             pFile = ac_buffer_builder_buffer(&pType4Target->ccFileBldr);
             break;
         case NDEF_FILE:
+            if (ndef_msg_is_streamed(pType4Target->pNdef)) {
+                return ndef_stream_read(pType4Target, pBuf, off, len);
+            }
             pFile = ac_buffer_builder_buffer(&pType4Target->ndefFileBldr);
             break;
         default:
@@ -249,6 +281,9 @@ nfc_err_t data_write(nfc_tech_type4_target_t *pType4Target, ac_buffer_t *pBuf, u
     ac_buffer_t *pFile;
     switch (file) {
         case NDEF_FILE:
+            if (ndef_msg_is_streamed(pType4Target->pNdef)) {
+                return ndef_stream_write(pType4Target, pBuf, off);
+            }
             pFile = ac_buffer_builder_buffer(&pType4Target->ndefFileBldr);
             break;
         case CC_FILE: //Cannot write to CC file!
@@ -283,4 +318,79 @@ nfc_err_t data_write(nfc_tech_type4_target_t *pType4Target, ac_buffer_t *pBuf, u
     return NFC_OK;
 }
 
+nfc_err_t ndef_stream_read(nfc_tech_type4_target_t *pType4Target, ac_buffer_t *pBuf, size_t off, size_t len)
+{
+    ac_buffer_t *pHeader = ac_buffer_builder_buffer(&pType4Target->ndefFileBldr);
+    ac_buffer_builder_t *pBldr = ndef_msg_buffer_builder(pType4Target->pNdef);
+    size_t headerLen = ac_buffer_reader_readable(pHeader);
+    size_t length = MIN(ndef_msg_length(pType4Target->pNdef), TYPE4_MAX_NDEF_SIZE);
+
+    if (off > headerLen + length) {
+        return NFC_ERR_LENGTH;
+    }
+
+    //Length header first, if requested
+    if (off < headerLen) {
+        ac_buffer_read_n_skip(pHeader, off);
+        ac_buffer_split(pBuf, pHeader, pHeader, MIN(len, headerLen - off));
+        len -= ac_buffer_reader_readable(pBuf);
+        off = 0;
+    } else {
+        ac_buffer_init(pBuf, NULL, 0);
+        off -= headerLen;
+    }
+
+    len = MIN(len, length - off);
+    if (len == 0) {
+        return NFC_OK;
+    }
+
+    //Then generate the requested part of the message straight into the response
+    ac_buffer_builder_t partBldr;
+    ac_buffer_builder_reset(pBldr);
+    ac_buffer_builder_init(&partBldr, ac_buffer_builder_write_position(pBldr), MIN(len, ac_buffer_builder_writable(pBldr)));
 
+    nfc_err_t ret = ndef_msg_stream_read(pType4Target->pNdef, off, &partBldr);
+    if (ret != NFC_OK) {
+        return ret;
+    }
+
+    ac_buffer_builder_write_n_skip(pBldr, ac_buffer_reader_readable(ac_buffer_builder_buffer(&partBldr)));
+    ac_buffer_append(pBuf, ac_buffer_builder_buffer(pBldr));
+
+    return NFC_OK;
+}
+
+nfc_err_t ndef_stream_write(nfc_tech_type4_target_t *pType4Target, ac_buffer_t *pBuf, size_t off)
+{
+    ac_buffer_t *pHeader = ac_buffer_builder_buffer(&pType4Target->ndefFileBldr);
+    size_t headerLen = ac_buffer_reader_readable(pHeader);
+    size_t len = ac_buffer_reader_readable(pBuf);
+
+    if (off > headerLen + ndef_msg_max_length(pType4Target->pNdef)) {
+        return NFC_ERR_LENGTH;
+    }
+
+    //Length header is kept here
+    if (off < headerLen) {
+        while ((off < headerLen) && (len > 0)) {
+            ac_buffer_builder_write_nu8_at(&pType4Target->ndefFileBldr, off, ac_buffer_read_nu8(pBuf));
+            off++;
+            len--;
+        }
+        off = 0;
+    } else {
+        off -= headerLen;
+    }
+
+    len = MIN(len, ndef_msg_max_length(pType4Target->pNdef) - off);
+    if (len == 0) {
+        return NFC_OK;
+    }
+
+    //The message itself is passed on without being copied
+    ac_buffer_t part;
+    ac_buffer_split(&part, pBuf, pBuf, len);
+
+    return ndef_msg_stream_write(pType4Target->pNdef, off, &part);
+}
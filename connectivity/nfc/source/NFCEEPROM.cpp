@@ -25,8 +25,12 @@ NFCEEPROM::NFCEEPROM(NFCEEPROMDriver *driver, events::EventQueue *queue, const S
     :
     NFCTarget(ndef_buffer), _delegate(NULL), _driver(driver), _event_queue(queue), _initialized(false),
     _current_op(nfc_eeprom_idle), _ndef_buffer_reader { nullptr, 0, nullptr }, _ndef_buffer_read_sz(0),
-    _eeprom_address(0), _operation_result(NFC_ERR_UNKNOWN)
+    _eeprom_address(0), _operation_result(NFC_ERR_UNKNOWN),
+    _cache_enabled(false), _message_cached(false), _size_cached(false), _cached_size(0), _region_size(0),
+    _cached_regions(0)
 {
+    MBED_STATIC_ASSERT(MBED_CONF_NFC_EEPROM_CACHE_REGIONS > 0 && MBED_CONF_NFC_EEPROM_CACHE_REGIONS <= 32,
+                       "NFC EEPROM cache regions must be between 1 and 32");
     _driver->set_delegate(this);
     _driver->set_event_queue(queue);
 }
@@ -37,6 +41,17 @@ nfc_err_t NFCEEPROM::initialize()
 
     // Initialize driver
     _driver->reset();
+
+    // Split the EEPROM in cache regions made of whole write pages
+    size_t page_size = _driver->write_page_size();
+    _region_size = (_driver->read_max_size() + MBED_CONF_NFC_EEPROM_CACHE_REGIONS - 1) / MBED_CONF_NFC_EEPROM_CACHE_REGIONS;
+    if (page_size > 0) {
+        _region_size = ((_region_size + page_size - 1) / page_size) * page_size;
+    }
+    if (_region_size == 0) {
+        _region_size = 1;
+    }
+
     _initialized = true;
     return NFC_OK;
 }
@@ -46,6 +61,19 @@ void NFCEEPROM::set_delegate(NFCEEPROM::Delegate *delegate)
     _delegate = delegate;
 }
 
+void NFCEEPROM::set_cache_enabled(bool enabled)
+{
+    _cache_enabled = enabled;
+    invalidate_cache();
+}
+
+void NFCEEPROM::invalidate_cache()
+{
+    _message_cached = false;
+    _size_cached = false;
+    _cached_regions = 0;
+}
+
 void NFCEEPROM::write_ndef_message()
 {
     MBED_ASSERT(_initialized == true);
@@ -72,6 +100,7 @@ void NFCEEPROM::write_ndef_message()
 
     // Reset EEPROM address
     _eeprom_address = 0;
+    _message_cached = false;
     // Go through the steps!
     _driver->start_session();
 
@@ -90,6 +119,14 @@ void NFCEEPROM::read_ndef_message()
         }
         return;
     }
+    // The buffer still holds the message the EEPROM was last known to hold
+    if (_message_cached) {
+        _current_op = nfc_eeprom_read_end_session;
+        _operation_result = NFC_OK;
+        _event_queue->call(this, &NFCEEPROM::on_session_ended, true);
+        return;
+    }
+
     _current_op = nfc_eeprom_read_start_session;
 
     // Reset EEPROM address
@@ -120,6 +157,7 @@ void NFCEEPROM::erase_ndef_message()
 
     // Reset EEPROM address
     _eeprom_address = 0;
+    invalidate_cache();
 
     // Go through the steps!
     _driver->start_session();
@@ -139,6 +177,12 @@ void NFCEEPROM::on_session_started(bool success)
                 handle_error(NFC_ERR_CONTROLLER); // An EEPROM is not really a controller but close enough
                 return;
             }
+            if (_size_cached && (_cached_size == ac_buffer_reader_readable(&_ndef_buffer_reader))) {
+                // Size is unchanged, go straight to the bytes
+                _current_op = nfc_eeprom_write_write_bytes;
+                continue_write();
+                break;
+            }
             _current_op = nfc_eeprom_write_write_size;
             _driver->write_size(ac_buffer_reader_readable(&_ndef_buffer_reader));
             break;
@@ -178,6 +222,9 @@ void NFCEEPROM::on_session_ended(bool success)
                 return;
             }
             _current_op = nfc_eeprom_idle;
+            if (_cache_enabled) {
+                _message_cached = true;
+            }
             if (_delegate != NULL) {
                 _delegate->on_ndef_message_written(_operation_result);
             }
@@ -189,6 +236,9 @@ void NFCEEPROM::on_session_ended(bool success)
                 return;
             }
             _current_op = nfc_eeprom_idle;
+            if (_cache_enabled && (_operation_result == NFC_OK)) {
+                cache_read_message();
+            }
 
             // Try to parse the NDEF message
             ndef_msg_decode(ndef_message());
@@ -273,6 +323,11 @@ void NFCEEPROM::on_size_written(bool success)
                 return;
             }
 
+            if (_cache_enabled) {
+                _size_cached = true;
+                _cached_size = ac_buffer_reader_readable(&_ndef_buffer_reader);
+            }
+
             _current_op = nfc_eeprom_write_write_bytes;
             continue_write();
             break;
@@ -367,9 +422,33 @@ void NFCEEPROM::on_bytes_erased(size_t count)
 
 void NFCEEPROM::continue_write()
 {
+    // At the start of each region, leave it out if the EEPROM already holds it
+    while (_cache_enabled && (ac_buffer_reader_readable(&_ndef_buffer_reader) > 0) && ((_eeprom_address % _region_size) == 0)) {
+        size_t region = _eeprom_address / _region_size;
+        if (region >= MBED_CONF_NFC_EEPROM_CACHE_REGIONS) {
+            break;
+        }
+
+        size_t count = MIN(_region_size, ac_buffer_reader_current_buffer_length(&_ndef_buffer_reader));
+        uint32_t region_fingerprint = fingerprint(ac_buffer_reader_current_buffer_pointer(&_ndef_buffer_reader), count);
+        if (!(_cached_regions & (1UL << region)) || (_region_fingerprints[region] != region_fingerprint)) {
+            // Any failure from here on invalidates the whole cache
+            _region_fingerprints[region] = region_fingerprint;
+            _cached_regions |= 1UL << region;
+            break;
+        }
+
+        _eeprom_address += count;
+        ac_buffer_read_n_skip(&_ndef_buffer_reader, count);
+    }
+
     if (ac_buffer_reader_readable(&_ndef_buffer_reader) > 0) {
-        // Continue writing
-        _driver->write_bytes(_eeprom_address, ac_buffer_reader_current_buffer_pointer(&_ndef_buffer_reader), ac_buffer_reader_current_buffer_length(&_ndef_buffer_reader));
+        // Continue writing, up to the end of the region when caching so that it's written in whole pages
+        size_t count = ac_buffer_reader_current_buffer_length(&_ndef_buffer_reader);
+        if (_cache_enabled) {
+            count = MIN(count, _region_size - (_eeprom_address % _region_size));
+        }
+        _driver->write_bytes(_eeprom_address, ac_buffer_reader_current_buffer_pointer(&_ndef_buffer_reader), count);
     } else {
         // we are done
         _current_op = nfc_eeprom_write_end_session;
@@ -404,12 +483,43 @@ void NFCEEPROM::continue_read()
     }
 }
 
+uint32_t NFCEEPROM::fingerprint(const uint8_t *bytes, size_t count)
+{
+    // FNV-1a
+    uint32_t hash = 2166136261UL;
+    for (size_t i = 0; i < count; i++) {
+        hash = (hash ^ bytes[i]) * 16777619UL;
+    }
+    return hash;
+}
+
+void NFCEEPROM::cache_read_message()
+{
+    ac_buffer_t reader;
+    ac_buffer_dup(&reader, ac_buffer_builder_buffer(ndef_msg_buffer_builder(ndef_message())));
+
+    _cached_size = ac_buffer_reader_readable(&reader);
+    _size_cached = true;
+
+    for (size_t region = 0; (region < MBED_CONF_NFC_EEPROM_CACHE_REGIONS) && (ac_buffer_reader_readable(&reader) > 0); region++) {
+        size_t count = MIN(_region_size, ac_buffer_reader_current_buffer_length(&reader));
+        _region_fingerprints[region] = fingerprint(ac_buffer_reader_current_buffer_pointer(&reader), count);
+        _cached_regions |= 1UL << region;
+        ac_buffer_read_n_skip(&reader, count);
+    }
+
+    _message_cached = true;
+}
+
 void NFCEEPROM::handle_error(nfc_err_t ret)
 {
     // Save & reset current op
     nfc_eeprom_operation_t last_op = _current_op;
     _current_op = nfc_eeprom_idle;
 
+    // The EEPROM may have been left anywhere between the old and new content
+    invalidate_cache();
+
     if (_delegate != NULL) {
         if (last_op <= nfc_eeprom_write_end_session) {
             _delegate->on_ndef_message_written(ret);
@@ -29,6 +29,7 @@ using namespace mbed::nfc;
 NFCNDEFCapable::NFCNDEFCapable(const Span<uint8_t> &buffer)
 {
     ndef_msg_init(&_ndef_message, s_ndef_encode, s_ndef_decode, buffer.data(), buffer.size(), this);
+    ndef_msg_set_stream_callbacks(&_ndef_message, s_ndef_stream_read, s_ndef_stream_write);
 }
 
 void NFCNDEFCapable::parse_ndef_message(const ac_buffer_t &buffer)
@@ -63,18 +64,73 @@ nfc_err_t NFCNDEFCapable::s_ndef_decode(ndef_msg_t *pTag, ac_buffer_t *pBuffer,
     return self->ndef_decode(pBuffer);
 }
 
+nfc_err_t NFCNDEFCapable::s_ndef_stream_read(ndef_msg_t *pTag, size_t offset, ac_buffer_builder_t *pBufferBldr, void *pUserData)
+{
+    NFCNDEFCapable *self = (NFCNDEFCapable *)pUserData;
+    return self->ndef_stream_read(offset, pBufferBldr);
+}
+
+nfc_err_t NFCNDEFCapable::s_ndef_stream_write(ndef_msg_t *pTag, size_t offset, ac_buffer_t *pBuffer, void *pUserData)
+{
+    NFCNDEFCapable *self = (NFCNDEFCapable *)pUserData;
+    return self->ndef_stream_write(offset, pBuffer);
+}
+
 nfc_err_t NFCNDEFCapable::ndef_encode(ac_buffer_builder_t *pBufferBldr)
 {
+    Delegate *delegate = ndef_capable_delegate();
+    size_t size = 0;
+    size_t max_size = 0;
+    if ((delegate != NULL) && delegate->stream_ndef_message(size, max_size)) {
+        ndef_msg_stream(&_ndef_message, size, max_size);
+        return NFC_OK;
+    }
+
     build_ndef_message(*pBufferBldr);
     return NFC_OK;
 }
 
 nfc_err_t NFCNDEFCapable::ndef_decode(ac_buffer_t *pBuffer)
 {
+    if (ndef_msg_is_streamed(&_ndef_message)) {
+        Delegate *delegate = ndef_capable_delegate();
+        if (delegate != NULL) {
+            delegate->ndef_message_written(ndef_msg_length(&_ndef_message));
+        }
+        return NFC_OK;
+    }
+
     parse_ndef_message(*pBuffer);
     return NFC_OK;
 }
 
+nfc_err_t NFCNDEFCapable::ndef_stream_read(size_t offset, ac_buffer_builder_t *pBufferBldr)
+{
+    Delegate *delegate = ndef_capable_delegate();
+    if (delegate != NULL) {
+        size_t count = delegate->read_ndef_message(offset, make_Span(ac_buffer_builder_write_position(pBufferBldr), ac_buffer_builder_writable(pBufferBldr)));
+        ac_buffer_builder_write_n_skip(pBufferBldr, MIN(count, ac_buffer_builder_writable(pBufferBldr)));
+    }
+    return NFC_OK;
+}
+
+nfc_err_t NFCNDEFCapable::ndef_stream_write(size_t offset, ac_buffer_t *pBuffer)
+{
+    Delegate *delegate = ndef_capable_delegate();
+    if (delegate == NULL) {
+        return NFC_OK;
+    }
+
+    // Hand over each buffer of the chain in place
+    while (ac_buffer_reader_readable(pBuffer) > 0) {
+        size_t length = ac_buffer_reader_current_buffer_length(pBuffer);
+        delegate->write_ndef_message(offset, make_const_Span(ac_buffer_reader_current_buffer_pointer(pBuffer), length));
+        ac_buffer_read_n_skip(pBuffer, length);
+        offset += length;
+    }
+    return NFC_OK;
+}
+
 ndef_msg_t *NFCNDEFCapable::ndef_message()
 {
     return &_ndef_message;
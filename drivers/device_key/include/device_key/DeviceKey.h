@@ -20,6 +20,7 @@
 #include "stddef.h"
 #include "stdint.h"
 #include "platform/NonCopyable.h"
+#include "platform/PlatformMutex.h"
 
 #define DEVICEKEY_ENABLED 1
 
@@ -32,6 +33,20 @@
 
 #if (DEVICEKEY_ENABLED) || defined(DOXYGEN_ONLY)
 
+/** Number of derived keys kept in RAM for callers asking for them to be cached.
+ *
+ *  A cached key is returned without reading the root of trust from flash and
+ *  running the KDF again. Set to 0 to disable the cache.
+ */
+#ifndef MBED_CONF_DEVICEKEY_DERIVED_KEY_CACHE_SIZE
+#define MBED_CONF_DEVICEKEY_DERIVED_KEY_CACHE_SIZE 4
+#endif
+
+/** Longest salt, in bytes, whose derived key can be cached */
+#ifndef MBED_CONF_DEVICEKEY_DERIVED_KEY_CACHE_SALT_SIZE
+#define MBED_CONF_DEVICEKEY_DERIVED_KEY_CACHE_SALT_SIZE 32
+#endif
+
 namespace mbed {
 /** \addtogroup device-security Device Key
  * \ingroup mbed-os-public
@@ -96,9 +111,17 @@ public:
      * @param output Buffer to receive the derived key. Size must be 16 bytes or 32 bytes
      *               according to the ikey_type parameter
      * @param ikey_type Type of the required key. Must be 16 bytes or 32 bytes.
+     * @param cache Keep the derived key in RAM, and return it from there next time it is asked to be cached.
+     *              Only for salts of up to MBED_CONF_DEVICEKEY_DERIVED_KEY_CACHE_SALT_SIZE bytes.
      * @return 0 on success, negative error code on failure
      */
-    int generate_derived_key(const unsigned char *isalt, size_t isalt_size, unsigned char *output, uint16_t ikey_type);
+    int generate_derived_key(const unsigned char *isalt, size_t isalt_size, unsigned char *output, uint16_t ikey_type,
+                             bool cache = false);
+
+    /** Wipe the derived keys cached in RAM.
+     *  Call before entering deep sleep, or once the cached keys are no longer needed.
+     */
+    void clear_derived_key_cache();
 
     /** Set a device key into the KVStore. If entropy support is missing, call this method
      *  before calling device_key_derived_key. This method should be called only once!
@@ -153,6 +176,29 @@ private:
     int get_derived_key(uint32_t *ikey_buff, size_t ikey_size, const unsigned char *isalt, size_t isalt_size,
                         unsigned char *output, uint32_t ikey_type);
 
+    /** Copy a derived key from the cache
+     * @return true if the key was cached
+     */
+    bool cache_get(const unsigned char *isalt, size_t isalt_size, unsigned char *output, uint16_t ikey_type);
+
+    /** Add a derived key to the cache, replacing the least recently used one if it is full
+     */
+    void cache_put(const unsigned char *isalt, size_t isalt_size, const unsigned char *key, uint16_t ikey_type);
+
+#if MBED_CONF_DEVICEKEY_DERIVED_KEY_CACHE_SIZE
+    struct cached_key_t {
+        unsigned char salt[MBED_CONF_DEVICEKEY_DERIVED_KEY_CACHE_SALT_SIZE];
+        uint16_t salt_size;
+        uint16_t key_type;      // 0 for an empty entry
+        uint32_t last_used;
+        unsigned char key[DEVICE_KEY_32BYTE];
+    };
+
+    PlatformMutex _cache_mutex;
+    cached_key_t _cache[MBED_CONF_DEVICEKEY_DERIVED_KEY_CACHE_SIZE];
+    uint32_t _cache_tick;
+#endif
+
 };
 
 /** @}*/
@@ -20,6 +20,7 @@
 #if DEVICEKEY_ENABLED
 #include "mbedtls/cmac.h"
 #include "mbedtls/platform.h"
+#include "mbedtls/platform_util.h"
 #include "kvstore/KVStore.h"
 #include "tdbstore/TDBStore.h"
 #include "kvstore_global_api/KVMap.h"
@@ -58,6 +59,10 @@ namespace mbed {
 
 DeviceKey::DeviceKey()
 {
+#if MBED_CONF_DEVICEKEY_DERIVED_KEY_CACHE_SIZE
+    memset(_cache, 0, sizeof(_cache));
+    _cache_tick = 0;
+#endif
 
     int ret = kv_init_storage_config();
     if (ret != MBED_SUCCESS) {
@@ -74,6 +79,7 @@ DeviceKey::DeviceKey()
 
 DeviceKey::~DeviceKey()
 {
+    clear_derived_key_cache();
 #if defined(MBEDTLS_PLATFORM_C)
     mbedtls_platform_teardown(NULL);
 #endif /* MBEDTLS_PLATFORM_C */
@@ -81,7 +87,7 @@ DeviceKey::~DeviceKey()
 }
 
 int DeviceKey::generate_derived_key(const unsigned char *salt, size_t isalt_size, unsigned char *output,
-                                    uint16_t ikey_type)
+                                    uint16_t ikey_type, bool cache)
 {
     uint32_t key_buff[DEVICE_KEY_32BYTE / sizeof(uint32_t)];
     size_t actual_size = DEVICE_KEY_32BYTE;
@@ -90,6 +96,10 @@ int DeviceKey::generate_derived_key(const unsigned char *salt, size_t isalt_size
         return DEVICEKEY_INVALID_KEY_TYPE;
     }
 
+    if (cache && cache_get(salt, isalt_size, output, ikey_type)) {
+        return DEVICEKEY_SUCCESS;
+    }
+
     actual_size = DEVICE_KEY_16BYTE != ikey_type ? DEVICE_KEY_32BYTE : DEVICE_KEY_16BYTE;
 
     //First try to read the key from KVStore
@@ -99,9 +109,76 @@ int DeviceKey::generate_derived_key(const unsigned char *salt, size_t isalt_size
     }
 
     ret = get_derived_key(key_buff, actual_size, salt, isalt_size, output, ikey_type);
+    mbedtls_platform_zeroize(key_buff, sizeof(key_buff));
+    if (DEVICEKEY_SUCCESS == ret && cache) {
+        cache_put(salt, isalt_size, output, ikey_type);
+    }
     return ret;
 }
 
+void DeviceKey::clear_derived_key_cache()
+{
+#if MBED_CONF_DEVICEKEY_DERIVED_KEY_CACHE_SIZE
+    _cache_mutex.lock();
+    mbedtls_platform_zeroize(_cache, sizeof(_cache));
+    _cache_mutex.unlock();
+#endif
+}
+
+bool DeviceKey::cache_get(const unsigned char *isalt, size_t isalt_size, unsigned char *output, uint16_t ikey_type)
+{
+#if MBED_CONF_DEVICEKEY_DERIVED_KEY_CACHE_SIZE
+    bool found = false;
+
+    if (isalt_size > MBED_CONF_DEVICEKEY_DERIVED_KEY_CACHE_SALT_SIZE) {
+        return false;
+    }
+
+    _cache_mutex.lock();
+    for (int i = 0; i < MBED_CONF_DEVICEKEY_DERIVED_KEY_CACHE_SIZE; i++) {
+        cached_key_t *entry = &_cache[i];
+        if (entry->key_type == ikey_type && entry->salt_size == isalt_size &&
+                !memcmp(entry->salt, isalt, isalt_size)) {
+            memcpy(output, entry->key, ikey_type);
+            entry->last_used = ++_cache_tick;
+            found = true;
+            break;
+        }
+    }
+    _cache_mutex.unlock();
+
+    return found;
+#else
+    return false;
+#endif
+}
+
+void DeviceKey::cache_put(const unsigned char *isalt, size_t isalt_size, const unsigned char *key, uint16_t ikey_type)
+{
+#if MBED_CONF_DEVICEKEY_DERIVED_KEY_CACHE_SIZE
+    if (isalt_size > MBED_CONF_DEVICEKEY_DERIVED_KEY_CACHE_SALT_SIZE) {
+        return;
+    }
+
+    _cache_mutex.lock();
+    // Pick an empty entry, or else the least recently used one
+    cached_key_t *entry = &_cache[0];
+    for (int i = 1; i < MBED_CONF_DEVICEKEY_DERIVED_KEY_CACHE_SIZE && entry->key_type; i++) {
+        if (!_cache[i].key_type || _cache[i].last_used < entry->last_used) {
+            entry = &_cache[i];
+        }
+    }
+
+    mbedtls_platform_zeroize(entry, sizeof(*entry));
+    memcpy(entry->salt, isalt, isalt_size);
+    entry->salt_size = isalt_size;
+    memcpy(entry->key, key, ikey_type);
+    entry->key_type = ikey_type;
+    entry->last_used = ++_cache_tick;
+    _cache_mutex.unlock();
+#endif
+}
+
 int DeviceKey::device_inject_root_of_trust(uint32_t *value, size_t isize)
 {
     return write_key_to_kvstore(value, isize);
@@ -139,6 +216,9 @@ int DeviceKey::write_key_to_kvstore(uint32_t *input, size_t isize)
         return DEVICEKEY_KVSTORE_UNPREDICTED_ERROR;
     }
 
+    // Keys derived from a previous root of trust are no longer valid
+    clear_derived_key_cache();
+
     return DEVICEKEY_SUCCESS;
 }
 
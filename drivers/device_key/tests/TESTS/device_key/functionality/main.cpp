@@ -489,6 +489,60 @@ void generate_derived_key_wrong_key_type_test()
 
 }
 
+/*
+ * Test cached derived keys match the derived ones, and don't outlive their root of trust
+ */
+void generate_derived_key_cache_test()
+{
+    unsigned char output1[DEVICE_KEY_16BYTE];
+    unsigned char output2[DEVICE_KEY_16BYTE];
+    unsigned char salt[] = "SecureStore key";
+    size_t salt_size = sizeof(salt);
+    int key_type = DEVICE_KEY_16BYTE;
+    DeviceKey &devkey = DeviceKey::get_instance();
+    KVMap &kv_map = KVMap::get_instance();
+    KVStore *inner_store = kv_map.get_internal_kv_instance(NULL);
+    TEST_ASSERT_NOT_EQUAL(NULL, inner_store);
+
+    int ret = inner_store->reset();
+    TEST_ASSERT_EQUAL_INT(DEVICEKEY_SUCCESS, ret);
+
+    ret = DeviceKey::get_instance().generate_root_of_trust();
+    if (ret != DEVICEKEY_SUCCESS) {
+        ret = inject_dummy_rot_key();
+    }
+    TEST_ASSERT_EQUAL_INT(DEVICEKEY_SUCCESS, ret);
+
+    ret = devkey.generate_derived_key(salt, salt_size, output1, key_type);
+    TEST_ASSERT_EQUAL_INT32(0, ret);
+
+    for (int i = 0; i < 2; i++) {
+        memset(output2, 0, sizeof(output2));
+        ret = devkey.generate_derived_key(salt, salt_size, output2, key_type, true);
+        TEST_ASSERT_EQUAL_INT32(0, ret);
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(output1, output2, DEVICE_KEY_16BYTE);
+    }
+
+    devkey.clear_derived_key_cache();
+    memset(output2, 0, sizeof(output2));
+    ret = devkey.generate_derived_key(salt, salt_size, output2, key_type, true);
+    TEST_ASSERT_EQUAL_INT32(0, ret);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(output1, output2, DEVICE_KEY_16BYTE);
+
+    // A new root of trust gives new derived keys, even for cached salts
+    ret = inner_store->reset();
+    TEST_ASSERT_EQUAL_INT(DEVICEKEY_SUCCESS, ret);
+
+    uint32_t key[DEVICE_KEY_16BYTE / sizeof(uint32_t)];
+    memcpy(key, "8765432187654321", DEVICE_KEY_16BYTE);
+    ret = devkey.device_inject_root_of_trust(key, DEVICE_KEY_16BYTE);
+    TEST_ASSERT_EQUAL_INT(DEVICEKEY_SUCCESS, ret);
+
+    ret = devkey.generate_derived_key(salt, salt_size, output2, key_type, true);
+    TEST_ASSERT_EQUAL_INT32(0, ret);
+    TEST_ASSERT(memcmp(output1, output2, DEVICE_KEY_16BYTE) != 0);
+}
+
 utest::v1::status_t greentea_failure_handler(const Case *const source, const failure_t reason)
 {
     greentea_case_failure_abort_handler(source, reason);
@@ -510,7 +564,8 @@ Case cases[] = {
 #ifndef MBEDTLS_AES_ONLY_128_BIT_KEY_LENGTH
     Case("Device Key - derived key key type 32",             generate_derived_key_key_type_32_test,             greentea_failure_handler),
 #endif
-    Case("Device Key - derived key wrong key type",          generate_derived_key_wrong_key_type_test,          greentea_failure_handler)
+    Case("Device Key - derived key wrong key type",          generate_derived_key_wrong_key_type_test,          greentea_failure_handler),
+    Case("Device Key - derived key cache",                   generate_derived_key_cache_test,                   greentea_failure_handler)
 };
 
 utest::v1::status_t greentea_test_setup(const size_t number_of_cases)
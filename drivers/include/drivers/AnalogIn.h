@@ -25,6 +25,11 @@
 #include "platform/SingletonPtr.h"
 #include "platform/PlatformMutex.h"
 
+#if DEVICE_ANALOGIN_STREAM
+#include "platform/Callback.h"
+#include "platform/Span.h"
+#endif
+
 #include <cmath>
 
 namespace mbed {
@@ -149,8 +154,42 @@ public:
         return read();
     }
 
+#if DEVICE_ANALOGIN_STREAM || defined(DOXYGEN_ONLY)
+    /** Sample continuously into a double buffer
+     *
+     * A timer triggers the conversions and DMA writes them to the buffer.
+     * Each time half of the buffer is full, the callback gets that half,
+     * from interrupt context, while the other half is being filled. It must
+     * be done with the samples before that half is filled again.
+     *
+     * This function locks the deep sleep until stop_stream() is called.
+     *
+     * @param buffer      The double buffer, which must stay valid until stop_stream().
+     *                    Its size must be a multiple of twice the number of inputs.
+     * @param sample_rate The sampling rate of each input, in Hz
+     * @param callback    The callback given the samples, represented like read_u16() values
+     *                    and interleaved by input, this input first
+     * @param channels    (optional) Up to 7 other inputs on the same ADC to sample with this one
+     *
+     * @returns 0 if the sampling started, -1 if this input is already sampling or if
+     *          the target can not sample these inputs at this rate
+     *
+     * @note Calling read() or read_u16() on the sampled inputs is undefined until
+     *       stop_stream() is called
+     */
+    int start_stream(Span<uint16_t> buffer, uint32_t sample_rate, const Callback<void(Span<uint16_t>)> &callback,
+                     Span<AnalogIn *const> channels = {});
+
+    /** Stop the sampling started by start_stream()
+     */
+    void stop_stream();
+#endif
+
     virtual ~AnalogIn()
     {
+#if DEVICE_ANALOGIN_STREAM
+        stop_stream();
+#endif
         lock();
         analogin_free(&_adc);
         unlock();
@@ -173,6 +212,13 @@ protected:
 
     float _vref;
 
+#if DEVICE_ANALOGIN_STREAM
+    static void _stream_irq(uint32_t id, uint16_t *samples, size_t count);
+
+    Callback<void(Span<uint16_t>)> _stream_callback;
+    bool _streaming = false;
+#endif
+
 #endif //!defined(DOXYGEN_ONLY)
 
 };
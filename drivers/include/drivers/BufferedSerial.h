@@ -37,6 +37,14 @@
 #define MBED_CONF_DRIVERS_UART_SERIAL_TXBUF_SIZE  256
 #endif
 
+#ifndef MBED_CONF_DRIVERS_UART_SERIAL_RX_DMA_SIZE
+#define MBED_CONF_DRIVERS_UART_SERIAL_RX_DMA_SIZE  64
+#endif
+
+#ifndef MBED_CONF_DRIVERS_UART_SERIAL_TX_DMA_SIZE
+#define MBED_CONF_DRIVERS_UART_SERIAL_TX_DMA_SIZE  64
+#endif
+
 namespace mbed {
 /**
  * \defgroup drivers_BufferedSerial BufferedSerial class
@@ -47,6 +55,11 @@ namespace mbed {
 /** Class providing buffered UART communication functionality using separate
  *  circular buffer for send and receive channels
  *
+ *  On targets with DEVICE_SERIAL_DMA, reception runs as circular DMA into a
+ *  ring of MBED_CONF_DRIVERS_UART_SERIAL_RX_DMA_SIZE bytes, drained into the
+ *  receive buffer when the line goes idle, and transmission sends chunks of
+ *  up to MBED_CONF_DRIVERS_UART_SERIAL_TX_DMA_SIZE bytes by DMA. Either
+ *  direction falls back to per byte interrupts if its DMA cannot be started.
  */
 
 class BufferedSerial:
@@ -109,6 +122,17 @@ public:
      */
     ssize_t write(const void *buffer, size_t length) override;
 
+    /** Write the contents of several buffers to a file
+     *
+     *  Same semantics as write, but the buffers are queued under a single
+     *  lock and the transmitter is started once they are all queued.
+     *
+     *  @param iov      The buffers to write from
+     *  @param iovcnt   The number of buffers
+     *  @return         The number of bytes written, negative error on failure
+     */
+    ssize_t writev(const struct iovec *iov, int iovcnt) override;
+
     /** Read the contents of a file into a buffer
      *
      *  Follows POSIX semantics:
@@ -301,6 +325,11 @@ private:
      */
     ssize_t write_unbuffered(const char *buf_ptr, size_t length);
 
+    /** Start transmitting what was queued in the transmit buffer, if the
+     * transmitter is idle.
+     */
+    void start_tx();
+
     /** Enable processing of byte reception IRQs and register a callback to
      * process them.
      */
@@ -321,12 +350,36 @@ private:
      */
     void disable_tx_irq();
 
+#if DEVICE_SERIAL_DMA
+    /** Start or stop circular DMA reception, falling back to byte
+     * reception IRQs if it cannot be started.
+     */
+    void start_rx();
+    void stop_rx_dma();
+
+    /** Send the next chunk of the transmit buffer by DMA, if any.
+     * Called from critical section.
+     */
+    void tx_dma_next();
+
+    /** DMA handlers for serial
+     *  rx_dma_irq copies what DMA received since the last call into the
+     *  receive buffer; tx_dma_irq starts the next chunk.
+     */
+    void rx_dma_irq(void);
+    void tx_dma_irq(void);
+    static void _rx_dma_irq(uint32_t id);
+    static void _tx_dma_irq(uint32_t id);
+#endif
+
     /** Software serial buffers
      *  By default buffer size is 256 for TX and 256 for RX. Configurable
      *  through mbed_app.json
+     *  Each buffer has one producer and one consumer, one of them being the
+     *  serial interrupt, so they need no critical section.
      */
-    CircularBuffer<char, MBED_CONF_DRIVERS_UART_SERIAL_RXBUF_SIZE> _rxbuf;
-    CircularBuffer<char, MBED_CONF_DRIVERS_UART_SERIAL_TXBUF_SIZE> _txbuf;
+    CircularBuffer<char, MBED_CONF_DRIVERS_UART_SERIAL_RXBUF_SIZE, uint32_t, CircularBufferMode::spsc> _rxbuf;
+    CircularBuffer<char, MBED_CONF_DRIVERS_UART_SERIAL_TXBUF_SIZE, uint32_t, CircularBufferMode::spsc> _txbuf;
 
     PlatformMutex _mutex;
 
@@ -339,6 +392,15 @@ private:
     bool _rx_enabled = true;
     InterruptIn *_dcd_irq = nullptr;
 
+#if DEVICE_SERIAL_DMA
+    uint8_t _rx_dma_buf[MBED_CONF_DRIVERS_UART_SERIAL_RX_DMA_SIZE];
+    uint8_t _tx_dma_buf[MBED_CONF_DRIVERS_UART_SERIAL_TX_DMA_SIZE];
+    size_t _rx_dma_tail = 0;
+    bool _rx_dma = false;
+    bool _tx_dma = true;
+    bool _tx_dma_busy = false;
+#endif
+
     /** Device Hanged up
      *  Determines if the device hanged up on us.
      *
@@ -25,6 +25,7 @@
 #include "platform/Callback.h"
 #include "platform/PlatformMutex.h"
 #include "platform/NonCopyable.h"
+#include "platform/Span.h"
 
 namespace mbed {
 /** \defgroup drivers-public-api-can CAN
@@ -218,9 +219,49 @@ public:
      *  @returns
      *    0 if no message arrived,
      *    1 if message arrived
+     *
+     *  @note With an RX buffer set, messages are read from it when @a handle
+     *  is 0. Other handles only get the messages the RX interrupt did not
+     *  take yet.
      */
     int read(CANMessage &msg, int handle = 0);
 
+    /** Read the messages received into the RX buffer.
+     *
+     *  @param msgs The messages to read to.
+     *
+     *  @returns the number of messages read, 0 if none arrived or no RX
+     *  buffer is set
+     *
+     *  @see set_rx_buffer
+     */
+    size_t read(Span<CANMessage> msgs);
+
+    /** Receive messages into a buffer from the RX interrupt.
+     *
+     *  The RX interrupt then reads every message pending in the controller
+     *  into the buffer, before calling the function attached to CAN::RxIrq
+     *  once for all of them. Bursts are no longer lost when the thread
+     *  reading them is late, up to the size of the buffer. Messages arriving
+     *  while it is full are dropped and counted by rx_overruns().
+     *
+     *  This function locks the deep sleep while a buffer is set.
+     *
+     *  @param buffer the storage for received messages, which must remain
+     *  valid while set, or an empty span to read from the controller again.
+     *  It holds up to its size minus one messages.
+     */
+    void set_rx_buffer(Span<CANMessage> buffer);
+
+    /** Get the number of messages dropped because the RX buffer was full.
+     *
+     *  @returns the number of messages dropped since the RX buffer was set
+     */
+    uint32_t rx_overruns() const
+    {
+        return _rx_overruns;
+    }
+
     /** Reset CAN interface.
      *
      * To use after error overflow.
@@ -265,6 +306,27 @@ public:
      */
     int filter(unsigned int id, unsigned int mask, CANFormat format = CANAny, int handle = 0);
 
+    /** A message filter
+     */
+    struct Filter {
+        unsigned int id;                /**< The id to filter on */
+        unsigned int mask;              /**< The mask applied to the id */
+        CANFormat format = CANAny;      /**< The format to filter on */
+    };
+
+    /** Configure several hardware filters at once
+     *
+     *  Filter i is set with handle i, which maps to the filter bank with the
+     *  same index on controllers such as bxCAN and FDCAN. Messages matching
+     *  any of the filters are received.
+     *
+     *  @param filters the filters to set
+     *
+     *  @returns the number of filters set, fewer than requested if the
+     *  controller ran out of filter banks or does not support filtering
+     */
+    size_t filter(Span<const Filter> filters);
+
     /**  Detects read errors - Used to detect read overflow errors.
      *
      *  @returns number of read errors
@@ -311,6 +373,17 @@ protected:
     can_t               _can;
     Callback<void()>    _irq[IrqCnt];
     PlatformMutex       _mutex;
+
+private:
+    void rx_buffer_irq();
+
+    // Ring of messages received by the RX interrupt, one slot is kept free
+    // to tell full from empty. Only the interrupt moves _rx_head.
+    CANMessage         *_rx_buffer = nullptr;
+    size_t              _rx_buffer_size = 0;
+    volatile uint32_t   _rx_head = 0;
+    volatile uint32_t   _rx_tail = 0;
+    volatile uint32_t   _rx_overruns = 0;
 #endif
 };
 
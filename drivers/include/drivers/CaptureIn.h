@@ -0,0 +1,148 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_CAPTUREIN_H
+#define MBED_CAPTUREIN_H
+
+#include "platform/platform.h"
+
+#if DEVICE_CAPTURE || defined(DOXYGEN_ONLY)
+
+#include "hal/capture_api.h"
+#include "platform/Callback.h"
+#include "platform/NonCopyable.h"
+#include "platform/Span.h"
+
+namespace mbed {
+/**
+ * \defgroup drivers_CaptureIn CaptureIn class
+ * \ingroup drivers-public-api-gpio
+ * @{
+ */
+
+/** A timestamped edge input, using timer input capture
+ *
+ * The timer hardware latches the time of each edge and DMA stores it, so
+ * the timestamps do not depend on interrupt latency and edges keep being
+ * recorded at rates an InterruptIn could not follow.
+ *
+ * @note Synchronization level: Interrupt safe
+ *
+ * Example:
+ * @code
+ * // Print the frequency of a pulse train
+ *
+ * #include "mbed.h"
+ *
+ * CaptureIn pulses(D2);
+ * uint32_t timestamps[256];
+ *
+ * int main() {
+ *     pulses.start(timestamps);
+ *     while(1) {
+ *         ThisThread::sleep_for(10ms);
+ *         printf("%lu Hz\n", pulses.read_frequency());
+ *     }
+ * }
+ * @endcode
+ */
+class CaptureIn : private NonCopyable<CaptureIn> {
+
+public:
+    enum Edge {
+        Rising = CAPTURE_EDGE_RISING,
+        Falling = CAPTURE_EDGE_FALLING,
+        Both = CAPTURE_EDGE_BOTH
+    };
+
+    /** Create a CaptureIn connected to the specified pin
+     *
+     *  @param pin  CaptureIn pin to connect to
+     *  @param edge Edges captured
+     */
+    CaptureIn(PinName pin, Edge edge = Rising);
+
+    ~CaptureIn();
+
+    /** Get the frequency of the timestamps
+     *
+     *  @returns
+     *    The frequency the timestamps count at, in hertz
+     */
+    uint32_t get_frequency();
+
+    /** Start capturing edges
+     *
+     *  Timestamps are written to the buffer as a ring. They are overwritten
+     *  if they are not read within the time it takes to capture the buffer
+     *  size in edges. Deep sleep is locked until stop() is called.
+     *
+     *  @param buffer   The ring buffer, which must stay valid until stop() is called
+     *  @param callback Called from interrupt context when the ring is half full and full
+     *  @returns
+     *    0 on success, -1 if a capture is running or no DMA channel is available
+     */
+    int start(Span<uint32_t> buffer, Callback<void()> callback = nullptr);
+
+    /** Stop capturing edges
+     */
+    void stop();
+
+    /** Get the number of timestamps captured and not read yet
+     *
+     *  @returns
+     *    The number of timestamps read() would return
+     */
+    size_t readable();
+
+    /** Read the timestamps captured since the previous read
+     *
+     *  @param timestamps Buffer the timestamps are copied to, oldest first
+     *  @returns
+     *    The number of timestamps read
+     */
+    size_t read(Span<uint32_t> timestamps);
+
+    /** Measure the frequency of the signal
+     *
+     *  The frequency is averaged over the timestamps not read yet, which are
+     *  consumed.
+     *
+     *  @returns
+     *    The frequency in hertz, or 0 if fewer than two edges were captured
+     */
+    uint32_t read_frequency();
+
+#if !(DOXYGEN_ONLY)
+protected:
+    static void _capture_irq(uint32_t id);
+
+    capture_t _capture;
+    Edge _edge;
+    uint32_t *_buffer;
+    size_t _length;
+    size_t _tail;
+    Callback<void()> _callback;
+#endif
+};
+
+/** @}*/
+
+} // namespace mbed
+
+#endif
+
+#endif
@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2021 Arm Limited and affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_CLOCK_MANAGER_H
+#define MBED_CLOCK_MANAGER_H
+
+#include "platform/platform.h"
+
+#if DEVICE_CLOCK_SCALING || defined(DOXYGEN_ONLY)
+
+#include "hal/clock_scaling_api.h"
+#include "platform/Callback.h"
+#include "platform/NonCopyable.h"
+
+namespace mbed {
+/** \addtogroup drivers-public-api */
+/** @{*/
+
+/**
+ * \defgroup drivers_ClockManager ClockManager class
+ * @{
+ */
+
+/** Switch the system clock between performance levels at runtime.
+ *
+ * Level 0 is the clock set at boot, the fastest, and each following level
+ * is slower. The application can drop to a low clock between bursts of
+ * work and go back to level 0 for heavy computation, such as a TLS
+ * handshake.
+ *
+ * Drivers whose baud rate or frequency is derived from the clock,
+ * SerialBase, SPI, I2C and PwmOut, register a Listener and recompute
+ * their dividers when the level changes. The us ticker, and so timers and
+ * the RTOS tick, keep their frequency.
+ *
+ * Example:
+ * @code
+ * ClockManager::set_level(ClockManager::level_count() - 1);
+ * // ... wait for events at the lowest clock ...
+ * ClockManager::set_level(0);
+ * @endcode
+ *
+ * @note Synchronization level: Thread safe, not callable from interrupt context.
+ * The listeners are called from the thread which changes the level, which
+ * must not hold the lock of any driver.
+ */
+class ClockManager {
+public:
+    /** Point of a level change a listener is called at */
+    enum event_t {
+        CLOCK_WILL_CHANGE,  /**< Before the change, at the old clock */
+        CLOCK_CHANGED       /**< After the change, at the new clock */
+    };
+
+    /** Registration of a callback for the level changes, for as long as
+     *  the object exists.
+     */
+    class Listener : private NonCopyable<Listener> {
+    public:
+        /** Register a callback
+         *
+         *  @param callback     Function called before and after each level change
+         */
+        Listener(Callback<void(event_t)> callback);
+
+        /** Unregister the callback
+         */
+        ~Listener();
+
+#if !defined(DOXYGEN_ONLY)
+    private:
+        friend class ClockManager;
+
+        Callback<void(event_t)> _callback;
+        Listener *_next;
+#endif
+    };
+
+    /** Get the number of performance levels
+     *
+     *  @return     Number of levels, at least 1
+     */
+    static int level_count();
+
+    /** Get the core clock frequency of a level
+     *
+     *  @param level    Level, below level_count()
+     *  @return         Frequency in Hz, or 0 if the level does not exist
+     */
+    static uint32_t frequency(int level);
+
+    /** Get the current level
+     *
+     *  @return     Current level
+     */
+    static int get_level();
+
+    /** Switch to a level, notifying the listeners
+     *
+     *  @param level    Level, below level_count()
+     *  @return         0 on success, -1 if the level does not exist or
+     *                  the clock could not be switched
+     */
+    static int set_level(int level);
+
+#if !defined(DOXYGEN_ONLY)
+private:
+    static void notify(event_t event);
+
+    static Listener *_listeners;
+#endif
+};
+
+/** @}*/
+/** @}*/
+
+} // namespace mbed
+
+#endif // DEVICE_CLOCK_SCALING
+#endif // MBED_CLOCK_MANAGER_H
@@ -0,0 +1,73 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_CYCLECLOCK_H
+#define MBED_CYCLECLOCK_H
+
+#include <chrono>
+#include "platform/mbed_profiler.h"
+
+namespace mbed {
+/**
+ * \defgroup drivers_CycleClock CycleClock class
+ * \ingroup drivers-public-api-ticker
+ * @{
+ */
+
+/**
+ * A C++11 Clock representing the CPU cycle counter.
+ *
+ * Reading it is a single register read, without critical section, which
+ * suits timestamping hot paths such as every packet or log line. The
+ * counter is the DWT cycle counter, started on first use, so the clock reads
+ * 0 on cores without one, such as Cortex-M0/M0+.
+ *
+ * The period is given by the core clock frequency, in Hz, known to the
+ * application:
+ * @code
+ * using Clock = CycleClock<216000000>;
+ *
+ * auto start = Clock::now();
+ * process(packet);
+ * auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start);
+ * @endcode
+ *
+ * The 32-bit count wraps, after about 20 seconds at 200 MHz: the difference
+ * between two time points is right as long as they are less than a wrap apart.
+ * The count keeps going in sleep, but stops in deep sleep, and its period
+ * changes with the core clock, see ClockManager.
+ */
+template<uint32_t Frequency>
+class CycleClock {
+public:
+    /* unsigned so that the differences wrap with the counter */
+    using rep = uint32_t;
+    using period = std::ratio<1, Frequency>;
+    using duration = std::chrono::duration<rep, period>;
+    using time_point = std::chrono::time_point<CycleClock>;
+    static const bool is_steady = false;
+
+    /** Read the current time */
+    static time_point now()
+    {
+        return time_point{duration{mbed_profile_cycles()}};
+    }
+};
+
+/** @}*/
+
+}
+#endif /* MBED_CYCLECLOCK_H */
@@ -0,0 +1,121 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_FASTDIGITALIN_H
+#define MBED_FASTDIGITALIN_H
+
+#include "platform/platform.h"
+#include "platform/mbed_critical.h"
+#include "hal/gpio_api.h"
+
+namespace mbed {
+/**
+ * \defgroup drivers_FastDigitalIn FastDigitalIn class
+ * \ingroup drivers-public-api-gpio
+ * @{
+ */
+
+/** A digital input on a pin known at compile time
+ *
+ * It behaves as DigitalIn, but on the targets defining GPIO_FAST_READY the
+ * port register and the mask of the pin are resolved at compile time, and
+ * read() inlines to a single register read. On the other targets it falls
+ * back to the gpio HAL calls.
+ *
+ * @note Synchronization level: Interrupt safe
+ *
+ * Example:
+ * @code
+ * #include "mbed.h"
+ *
+ * FastDigitalIn<BUTTON1> button(PullUp);
+ * FastDigitalOut<LED1> led;
+ *
+ * int main() {
+ *     while(1) {
+ *         led = button;
+ *     }
+ * }
+ * @endcode
+ */
+template<PinName Pin>
+class FastDigitalIn {
+    static_assert(Pin != NC, "FastDigitalIn needs a connected pin");
+
+public:
+    /** Create a FastDigitalIn, with the default pin mode
+     */
+    FastDigitalIn() : gpio()
+    {
+        // No lock needed in the constructor
+        gpio_init_in(&gpio, Pin);
+    }
+
+    /** Create a FastDigitalIn
+     *
+     *  @param mode the initial mode of the pin
+     */
+    FastDigitalIn(PinMode mode) : gpio()
+    {
+        // No lock needed in the constructor
+        gpio_init_in_ex(&gpio, Pin, mode);
+    }
+
+    /** Read the input, represented as 0 or 1 (int)
+     *
+     *  @returns
+     *    An integer representing the state of the input pin,
+     *    0 for logical 0, 1 for logical 1
+     */
+    MBED_FORCEINLINE int read()
+    {
+#if GPIO_FAST_READY
+        return gpio_fast_read(Pin);
+#else
+        return gpio_read(&gpio);
+#endif
+    }
+
+    /** Set the input pin mode
+     *
+     *  @param pull PullUp, PullDown, PullNone, OpenDrain
+     */
+    void mode(PinMode pull)
+    {
+        core_util_critical_section_enter();
+        gpio_mode(&gpio, pull);
+        core_util_critical_section_exit();
+    }
+
+    /** An operator shorthand for read()
+     * \sa FastDigitalIn::read()
+     */
+    operator int()
+    {
+        return read();
+    }
+
+protected:
+#if !defined(DOXYGEN_ONLY)
+    gpio_t gpio;
+#endif //!defined(DOXYGEN_ONLY)
+};
+
+/** @}*/
+
+} // namespace mbed
+
+#endif
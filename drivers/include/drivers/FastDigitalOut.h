@@ -0,0 +1,133 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_FASTDIGITALOUT_H
+#define MBED_FASTDIGITALOUT_H
+
+#include "platform/platform.h"
+#include "hal/gpio_api.h"
+
+namespace mbed {
+/**
+ * \defgroup drivers_FastDigitalOut FastDigitalOut class
+ * \ingroup drivers-public-api-gpio
+ * @{
+ */
+
+/** A digital output on a pin known at compile time
+ *
+ * It behaves as DigitalOut, but on the targets defining GPIO_FAST_READY the
+ * port register and the mask of the pin are resolved at compile time, and
+ * write() and read() inline to a single register access. This suits
+ * bit-banged protocols and chip select toggling. On the other targets it
+ * falls back to the gpio HAL calls.
+ *
+ * @note Synchronization level: Interrupt safe
+ *
+ * Example:
+ * @code
+ * #include "mbed.h"
+ *
+ * FastDigitalOut<LED1> led;
+ *
+ * int main() {
+ *     while(1) {
+ *         led = !led;
+ *         ThisThread::sleep_for(200);
+ *     }
+ * }
+ * @endcode
+ */
+template<PinName Pin>
+class FastDigitalOut {
+    static_assert(Pin != NC, "FastDigitalOut needs a connected pin");
+
+public:
+    /** Create a FastDigitalOut, with the output value 0
+     */
+    FastDigitalOut() : gpio()
+    {
+        // No lock needed in the constructor
+        gpio_init_out(&gpio, Pin);
+    }
+
+    /** Create a FastDigitalOut
+     *
+     *  @param value the initial pin value
+     */
+    FastDigitalOut(int value) : gpio()
+    {
+        // No lock needed in the constructor
+        gpio_init_out_ex(&gpio, Pin, value);
+    }
+
+    /** Set the output, specified as 0 or 1 (int)
+     *
+     *  @param value An integer specifying the pin output value,
+     *      0 for logical 0, 1 (or any other non-zero value) for logical 1
+     */
+    MBED_FORCEINLINE void write(int value)
+    {
+#if GPIO_FAST_READY
+        gpio_fast_write(Pin, value);
+#else
+        gpio_write(&gpio, value);
+#endif
+    }
+
+    /** Return the output setting, represented as 0 or 1 (int)
+     *
+     *  @returns
+     *    an integer representing the output setting of the pin,
+     *    0 for logical 0, 1 for logical 1
+     */
+    MBED_FORCEINLINE int read()
+    {
+#if GPIO_FAST_READY
+        return gpio_fast_read(Pin);
+#else
+        return gpio_read(&gpio);
+#endif
+    }
+
+    /** A shorthand for write()
+     * \sa FastDigitalOut::write()
+     */
+    FastDigitalOut &operator= (int value)
+    {
+        write(value);
+        return *this;
+    }
+
+    /** A shorthand for read()
+     * \sa FastDigitalOut::read()
+     */
+    operator int()
+    {
+        return read();
+    }
+
+protected:
+#if !defined(DOXYGEN_ONLY)
+    gpio_t gpio;
+#endif //!defined(DOXYGEN_ONLY)
+};
+
+/** @}*/
+
+} // namespace mbed
+
+#endif
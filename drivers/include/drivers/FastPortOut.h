@@ -0,0 +1,124 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_FASTPORTOUT_H
+#define MBED_FASTPORTOUT_H
+
+#include "platform/platform.h"
+
+#if DEVICE_PORTOUT || defined(DOXYGEN_ONLY)
+
+#include "platform/mbed_critical.h"
+#include "hal/port_api.h"
+#include "hal/gpio_api.h"
+
+namespace mbed {
+/**
+ * \defgroup drivers_FastPortOut FastPortOut class
+ * \ingroup drivers-public-api-gpio
+ * @{
+ */
+
+/** A multiple pin digital output on a port and mask known at compile time
+ *
+ * It behaves as PortOut, but on the targets defining GPIO_FAST_READY the
+ * port register is resolved at compile time, and write() inlines to the
+ * set and clear register writes of the masked pins. On the other targets
+ * it falls back to the port HAL calls.
+ *
+ * @note Synchronization level: Interrupt safe
+ *
+ * Example:
+ * @code
+ * #include "mbed.h"
+ *
+ * // Data bus on the 8 low pins of port B
+ * FastPortOut<PortB, 0xFF> bus;
+ *
+ * int main() {
+ *     for (int i = 0; ; i++) {
+ *         bus = i;
+ *     }
+ * }
+ * @endcode
+ */
+template<PortName Port, uint32_t Mask = 0xFFFFFFFF>
+class FastPortOut {
+public:
+    /** Create a FastPortOut, the pins in the mask are set up as outputs
+     */
+    FastPortOut()
+    {
+        core_util_critical_section_enter();
+        port_init(&_port, Port, Mask, PIN_OUTPUT);
+        core_util_critical_section_exit();
+    }
+
+    /** Write the value to the output port
+     *
+     *  @param value An integer specifying a bit to write for every corresponding pin in the mask
+     */
+    MBED_FORCEINLINE void write(int value)
+    {
+#if GPIO_FAST_READY
+        gpio_fast_port_write(Port, Mask, value);
+#else
+        port_write(&_port, value);
+#endif
+    }
+
+    /** Read the value currently output on the port
+     *
+     *  @returns
+     *    An integer with each bit corresponding to associated pin value
+     */
+    MBED_FORCEINLINE int read()
+    {
+#if GPIO_FAST_READY
+        return gpio_fast_port_read(Port, Mask);
+#else
+        return port_read(&_port);
+#endif
+    }
+
+    /** A shorthand for write()
+     * \sa FastPortOut::write()
+     */
+    FastPortOut &operator= (int value)
+    {
+        write(value);
+        return *this;
+    }
+
+    /** A shorthand for read()
+     * \sa FastPortOut::read()
+     */
+    operator int()
+    {
+        return read();
+    }
+
+private:
+    port_t _port;
+};
+
+/** @}*/
+
+} // namespace mbed
+
+#endif
+
+#endif
@@ -65,7 +65,7 @@ namespace mbed {
  */
 class FlashIAP : private NonCopyable<FlashIAP> {
 public:
-    constexpr FlashIAP() : _flash(), _page_buf(nullptr)
+    constexpr FlashIAP() : _flash(), _page_buf(nullptr), _stream_buf(nullptr), _stream_addr(0), _stream_fill(0)
     {
 
     }
@@ -105,6 +105,35 @@ public:
      */
     int program(const void *buffer, uint32_t addr, uint32_t size);
 
+    /** Start programming a stream of data
+     *
+     *  Data passed to program_stream() is programmed from the address
+     *  onwards. Whole pages are programmed straight from the caller's buffer
+     *  and only the data that does not fill a page is kept, so the stream
+     *  can be fed with buffers of any size as they are received.
+     *  The sectors must have been erased prior to being programmed.
+     *
+     *  @param addr   Address of a page to begin writing to
+     *  @return       0 on success, negative error code on failure
+     */
+    int program_stream_start(uint32_t addr);
+
+    /** Program the next data of the stream
+     *
+     *  @param buffer Buffer of data to be written
+     *  @param size   Size to write in bytes
+     *  @return       0 on success, negative error code on failure
+     */
+    int program_stream(const void *buffer, uint32_t size);
+
+    /** Program the data left in the stream and end it
+     *
+     *  The last page is padded with the erase value.
+     *
+     *  @return       0 on success, negative error code on failure
+     */
+    int program_stream_end();
+
     /** Erase sectors
      *
      *  The state of an erased sector is undefined until it has been programmed
@@ -144,6 +173,22 @@ public:
      */
     uint32_t get_page_size() const;
 
+    /** Get the flash bank size
+     *
+     *  A bank can be erased and programmed while the application runs from
+     *  another bank. Single bank targets return the flash size.
+     *  @return Size of a bank in bytes
+     */
+    uint32_t get_bank_size() const;
+
+    /** Check if a region can be erased and programmed while the application runs
+     *
+     *  @param addr Address of the region
+     *  @param size Size of the region in bytes
+     *  @return true if the region is in banks not holding the application code
+     */
+    bool is_read_while_write(uint32_t addr, uint32_t size) const;
+
     /** Get the flash erase value
      *
      *  Get the value we read after erase operation
@@ -164,6 +209,9 @@ private:
 
     flash_t _flash;
     uint8_t *_page_buf;
+    uint8_t *_stream_buf;
+    uint32_t _stream_addr;
+    uint32_t _stream_fill;
     static SingletonPtr<PlatformMutex> _mutex;
 #endif
 };
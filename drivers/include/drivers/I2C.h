@@ -26,11 +26,14 @@
 #include "platform/SingletonPtr.h"
 #include "platform/PlatformMutex.h"
 #include "platform/NonCopyable.h"
+#include "drivers/ClockManager.h"
 
 #if DEVICE_I2C_ASYNCH
 #include "platform/CThunk.h"
 #include "hal/dma_api.h"
 #include "platform/Callback.h"
+#include "platform/CircularBuffer.h"
+#include "platform/Transaction.h"
 #endif
 
 namespace mbed {
@@ -205,14 +208,58 @@ public:
      * @param repeated Repeated start, true - do not send stop at end
      *        default value is false.
      *
-     * @returns Zero if the transfer has started, or -1 if I2C peripheral is busy
+     * @returns Zero if the transfer has started or was added to the queue,
+     *          or -1 if I2C peripheral is busy and the queue is full
      */
     int transfer(int address, const char *tx_buffer, int tx_length, char *rx_buffer, int rx_length, const event_callback_t &callback, int event = I2C_EVENT_TRANSFER_COMPLETE, bool repeated = false);
 
-    /** Abort the ongoing I2C transfer
+    /** Put a nonblocking I2C transfer on the transfer queue.
+     *
+     * Queued transfers are started from the interrupt handler as soon as the
+     * previous one ends, after its callback. A transfer queued with repeated
+     * set is followed by the next one with a repeated start, so a sequence of
+     * writes then reads to several slaves runs without the thread in between.
+     * The queue holds TRANSACTION_QUEUE_SIZE_I2C transfers, none if the target
+     * does not define it.
+     *
+     * This function can be called from the transfer callbacks.
+     *
+     * @param address   8/10 bit I2C slave address
+     * @param tx_buffer The TX buffer with data to be transferred
+     * @param tx_length The length of TX buffer in bytes
+     * @param rx_buffer The RX buffer, which is used for received data
+     * @param rx_length The length of RX buffer in bytes
+     * @param event     The logical OR of events to modify
+     * @param callback  The event callback function
+     * @param repeated Repeated start, true - do not send stop at end
+     *        default value is false.
+     *
+     * @returns Zero if the transfer was added to the queue, or -1 if the queue is full
+     */
+    int queue_transfer(int address, const char *tx_buffer, int tx_length, char *rx_buffer, int rx_length, const event_callback_t &callback, int event = I2C_EVENT_TRANSFER_COMPLETE, bool repeated = false);
+
+    /** Abort the ongoing I2C transfer, and continue with transfers in the queue, if any.
      */
     void abort_transfer();
 
+    /** Clear the queue of transfers.
+     */
+    void clear_transfer_buffer();
+
+    /** Clear the queue of transfers and abort the on-going transfer.
+     */
+    void abort_all_transfers();
+
+    /** Configure DMA usage suggestion for non-blocking transfers.
+     *
+     *  @param usage The usage DMA hint for peripheral.
+     *
+     *  @return Result of the operation.
+     *  @retval 0 The usage was set.
+     *  @retval -1 Usage cannot be set as there is an ongoing transaction.
+     */
+    int set_dma_usage(DMAUsage usage);
+
 #if !defined(DOXYGEN_ONLY)
 protected:
     /** Lock deep sleep only if it is not yet locked */
@@ -222,10 +269,30 @@ protected:
     void unlock_deep_sleep();
 
     void irq_handler_asynch(void);
+
+    /** Configure the callback and the peripheral, and start a transfer.
+     *  Also called from the interrupt handler for queued transfers.
+     */
+    void start_transfer(int address, const char *tx_buffer, int tx_length, char *rx_buffer, int rx_length, const event_callback_t &callback, int event, bool repeated);
+
     event_callback_t _callback;
     CThunk<I2C> _irq;
     DMAUsage _usage;
     bool _deep_sleep_locked;
+
+#if TRANSACTION_QUEUE_SIZE_I2C
+    /** Start the next transfer in the queue, if any and the peripheral is free. */
+    void dequeue_transaction();
+
+    struct i2c_transaction_s {
+        transaction_t transaction;
+        int address;
+        bool repeated;
+    };
+
+    /* Queue of pending transfers */
+    CircularBuffer<i2c_transaction_s, TRANSACTION_QUEUE_SIZE_I2C> _transaction_buffer;
+#endif
 #endif
 #endif
 
@@ -240,6 +307,12 @@ protected:
     PinName _sda;
     PinName _scl;
 
+#if DEVICE_CLOCK_SCALING
+    /* Sets the frequency again for a new clock */
+    void _clock_changed(ClockManager::event_t event);
+    ClockManager::Listener _clock_listener {callback(this, &I2C::_clock_changed)};
+#endif
+
 private:
     /** Recover I2C bus, when stuck with SDA low
      *  @note : Initialization of I2C bus is required after this API.
@@ -36,6 +36,20 @@
 #include <mstd_type_traits>
 #endif
 
+/* Number of bytes the 32-bit ANSI CRC table mode processes per step, 1, 4 or 8.
+ * Slice-by-4 and slice-by-8 need a 256-entry table, and add 3 or 7 more
+ * 1KiB tables in flash.
+ */
+#ifndef MBED_CONF_DRIVERS_CRC_SLICE_BY
+#define MBED_CONF_DRIVERS_CRC_SLICE_BY 1
+#endif
+
+#if MBED_CRC_TABLE_SIZE == 256 && MBED_CONF_DRIVERS_CRC_SLICE_BY > 1
+#define MBED_CRC_SLICE_TABLES 1
+#else
+#define MBED_CRC_SLICE_TABLES 0
+#endif
+
 namespace mbed {
 /** \addtogroup drivers-public-api */
 /** @{*/
@@ -59,6 +73,13 @@ namespace impl {
 template<uint32_t polynomial, uint8_t width, CrcMode mode>
 class MbedCRC;
 
+#if MBED_CRC_SLICE_TABLES
+/* Entry i of table k is the CRC of byte i followed by k + 1 zero bytes */
+struct crc_slice_table_t {
+    uint32_t table[MBED_CONF_DRIVERS_CRC_SLICE_BY - 1][256];
+};
+#endif
+
 constexpr bool have_crc_table(uint32_t polynomial, uint8_t width)
 {
 #if MBED_CRC_TABLE_SIZE > 0
@@ -564,6 +585,11 @@ private:
     static const crc_table_t _crc_table[MBED_CRC_TABLE_SIZE];
 #endif
 
+#if MBED_CRC_SLICE_TABLES
+    /* Only defined for mode == TABLE and POLY_32BIT_ANSI - see below */
+    static const crc_slice_table_t _crc_slice_table;
+#endif
+
     static constexpr uint32_t adjust_initial_value(uint32_t initial_xor, bool reflect_data)
     {
         if (mode == CrcMode::BITWISE) {
@@ -806,6 +832,12 @@ private:
         // Note the inversion because table and CRC are reflected - data must be
         bool reflect = !_reflect_data;
 
+#if MBED_CRC_SLICE_TABLES
+        if (!reflect) {
+            p_crc = do_slices(data, size, p_crc);
+        }
+#endif
+
         for (crc_data_size_t byte = 0; byte < size; byte++) {
             uint_fast32_t data_byte = data[byte];
             if (reflect) {
@@ -824,6 +856,42 @@ private:
     }
 #endif
 
+#if MBED_CRC_SLICE_TABLES
+    /** Slice-by-N CRC computation, for whole slices of reflected data.
+     *
+     * @param  data  data buffer, advanced past the bytes processed
+     * @param  size  size of the data, reduced by the bytes processed
+     * @param  p_crc  CRC register value
+     * @return  updated register value
+     */
+    template<uint32_t poly = polynomial>
+    static std::enable_if_t<poly == POLY_32BIT_ANSI && width == 32, uint_fast32_t>
+    do_slices(const uint8_t *&data, crc_data_size_t &size, uint_fast32_t p_crc)
+    {
+        const auto &t = _crc_slice_table.table;
+
+        for (; size >= MBED_CONF_DRIVERS_CRC_SLICE_BY; size -= MBED_CONF_DRIVERS_CRC_SLICE_BY) {
+            uint_fast32_t one = p_crc ^ (data[0] | (data[1] << 8) | (data[2] << 16) | ((uint_fast32_t) data[3] << 24));
+#if MBED_CONF_DRIVERS_CRC_SLICE_BY == 8
+            uint_fast32_t two = data[4] | (data[5] << 8) | (data[6] << 16) | ((uint_fast32_t) data[7] << 24);
+            p_crc = t[6][one & 0xFF] ^ t[5][(one >> 8) & 0xFF] ^ t[4][(one >> 16) & 0xFF] ^ t[3][one >> 24] ^
+                    t[2][two & 0xFF] ^ t[1][(two >> 8) & 0xFF] ^ t[0][(two >> 16) & 0xFF] ^ _crc_table[two >> 24];
+#else
+            p_crc = t[2][one & 0xFF] ^ t[1][(one >> 8) & 0xFF] ^ t[0][(one >> 16) & 0xFF] ^ _crc_table[one >> 24];
+#endif
+            data += MBED_CONF_DRIVERS_CRC_SLICE_BY;
+        }
+        return p_crc;
+    }
+
+    template<uint32_t poly = polynomial>
+    static std::enable_if_t < !(poly == POLY_32BIT_ANSI && width == 32), uint_fast32_t >
+    do_slices(const uint8_t *&, crc_data_size_t &, uint_fast32_t p_crc)
+    {
+        return p_crc;
+    }
+#endif
+
 #ifdef DEVICE_CRC
     /** Hardware CRC computation.
      *
@@ -862,6 +930,11 @@ const uint16_t MbedCRC<POLY_16BIT_IBM, 16, CrcMode::TABLE>::_crc_table[MBED_CRC_
 template<>
 const uint32_t MbedCRC<POLY_32BIT_ANSI, 32, CrcMode::TABLE>::_crc_table[MBED_CRC_TABLE_SIZE];
 
+#if MBED_CRC_SLICE_TABLES
+template<>
+const crc_slice_table_t MbedCRC<POLY_32BIT_ANSI, 32, CrcMode::TABLE>::_crc_slice_table;
+#endif
+
 #endif // MBED_CRC_TABLE_SIZE > 0
 
 } // namespace impl
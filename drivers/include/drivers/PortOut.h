@@ -22,6 +22,8 @@
 #if DEVICE_PORTOUT || defined(DOXYGEN_ONLY)
 
 #include "hal/port_api.h"
+#include "platform/Callback.h"
+#include "platform/Span.h"
 
 namespace mbed {
 /**
@@ -65,6 +67,10 @@ public:
      */
     PortOut(PortName port, int mask = 0xFFFFFFFF);
 
+#if DEVICE_PORT_DMA || defined(DOXYGEN_ONLY)
+    ~PortOut();
+#endif
+
     /** Write the value to the output port
      *
      *  @param value An integer specifying a bit to write for every corresponding PortOut pin
@@ -84,6 +90,42 @@ public:
         return port_read(&_port);
     }
 
+#if DEVICE_PORT_DMA || defined(DOXYGEN_ONLY)
+    /** Get the frequency write_burst() writes values at
+     *
+     *  @param frequency The frequency requested, in hertz
+     *  @returns
+     *    The closest frequency the target generates, in hertz, or 0 if none
+     */
+    uint32_t burst_frequency(uint32_t frequency);
+
+    /** Write a burst of values to the port with DMA
+     *
+     *  The values are written at a fixed rate without the CPU, which suits
+     *  bit-banged buses and patterns with tight timing.
+     *  Deep sleep is locked until the burst is written.
+     *
+     *  @param values    Values to write, as for write(). The buffer must stay valid
+     *                   until the callback is called
+     *  @param frequency The frequency the values are written at, in hertz
+     *  @param callback  Called from interrupt context once the last value is written
+     *  @returns
+     *    0 on success, -1 if a burst is being written or no DMA channel is available
+     */
+    int write_burst(Span<const uint32_t> values, uint32_t frequency, Callback<void()> callback = nullptr);
+
+    /** Check whether a burst is being written
+     *
+     *  @returns
+     *    true until the last value of the burst is written
+     */
+    bool burst_active();
+
+    /** Stop the burst being written, without calling its callback
+     */
+    void abort_burst();
+#endif
+
     /** A shorthand for write()
      * \sa PortOut::write()
      */
@@ -112,6 +154,13 @@ public:
 
 private:
     port_t _port;
+#if DEVICE_PORT_DMA
+    static void burst_irq(uint32_t id);
+    void burst_done();
+
+    Callback<void()> _burst_callback;
+    bool _burst_sleep_locked = false;
+#endif
 };
 
 /** @}*/
@@ -21,6 +21,9 @@
 
 #if DEVICE_PWMOUT || defined(DOXYGEN_ONLY)
 #include "hal/pwmout_api.h"
+#include "platform/Callback.h"
+#include "platform/Span.h"
+#include "drivers/ClockManager.h"
 
 namespace mbed {
 /**
@@ -155,6 +158,43 @@ public:
      */
     void resume();
 
+#if DEVICE_PWMOUT_DMA || defined(DOXYGEN_ONLY)
+    /** Get the resolution of the pulse widths of write_sequence()
+     *
+     *  @returns
+     *    The number of timer ticks in a period, the pulse width of a 100% duty-cycle
+     */
+    uint32_t sequence_period_ticks();
+
+    /** Output a sequence of pulse widths with DMA, one per period
+     *
+     *  The CPU is not involved once the sequence started, which suits pulse
+     *  trains with tight timing such as WS2812 LEDs or stepper motor ramps.
+     *  The period must be set before the sequence is started.
+     *
+     *  @param pulses   Pulse widths in timer ticks, in range 0 to sequence_period_ticks().
+     *                  The buffer must stay valid until the callback is called
+     *  @param callback Called from interrupt context once the last pulse width is loaded
+     *  @returns
+     *    0 on success, -1 if a sequence is being output or no DMA channel is available
+     *
+     *  @note The output keeps the last pulse width of the sequence. End it with 0
+     *        to leave the output low.
+     */
+    int write_sequence(Span<const uint16_t> pulses, Callback<void()> callback = nullptr);
+
+    /** Check whether a sequence is being output
+     *
+     *  @returns
+     *    true until the last pulse width of the sequence is loaded
+     */
+    bool sequence_active();
+
+    /** Stop the sequence being output, without calling its callback
+     */
+    void abort_sequence();
+#endif
+
     /** A operator shorthand for write()
      *  \sa PwmOut::write()
      */
@@ -198,12 +238,26 @@ protected:
     /** Power down this instance */
     void deinit();
 
+#if DEVICE_PWMOUT_DMA
+    /** Sequence done handler */
+    static void sequence_irq(uint32_t id);
+
+    Callback<void()> _sequence_callback;
+#endif
+
     pwmout_t _pwm;
     PinName _pin;
     bool _deep_sleep_locked;
     bool _initialized;
     float _duty_cycle;
     int _period_us;
+
+#if DEVICE_CLOCK_SCALING
+    /** Keep the period and duty cycle across a clock change */
+    void clock_changed(ClockManager::event_t event);
+
+    ClockManager::Listener _clock_listener {callback(this, &PwmOut::clock_changed)};
+#endif
 #endif
 };
 
@@ -211,6 +211,28 @@ public:
      */
     qspi_status_t command_transfer(qspi_inst_t instruction, int address, const char *tx_buffer, size_t tx_length, const char *rx_buffer, size_t rx_length);
 
+#if DEVICE_QSPI_MEMORY_MAPPED || defined(DOXYGEN_ONLY)
+    /** Enter memory-mapped mode, where the peripheral reads the external memory on accesses to its mapped window
+     *
+     *  The current format and dummy cycles are used for the reads. No other transfer may be done until the mode is exited.
+     *
+     *  @param instruction Read instruction to be used for reads of the mapped window
+     *  @param alt Alt value to be used in Alternate-byte phase. Use -1 for ignoring Alternate-byte phase
+     *  @param address Pointer to a variable which is set to the start of the mapped window
+     *
+     *  @returns
+     *    Returns QSPI_STATUS_SUCCESS on success and QSPI_STATUS_ERROR on failure.
+     */
+    qspi_status_t memory_mapped_enter(qspi_inst_t instruction, int alt, const void **address);
+
+    /** Exit memory-mapped mode, returning to command mode
+     *
+     *  @returns
+     *    Returns QSPI_STATUS_SUCCESS on success and QSPI_STATUS_ERROR on failure.
+     */
+    qspi_status_t memory_mapped_exit();
+#endif
+
 #if !defined(DOXYGEN_ONLY)
 protected:
     /** Acquire exclusive access to this SPI bus
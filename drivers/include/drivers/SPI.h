@@ -26,6 +26,7 @@
 #include "drivers/DigitalOut.h"
 #include "platform/SingletonPtr.h"
 #include "platform/NonCopyable.h"
+#include "drivers/ClockManager.h"
 
 #if defined MBED_CONF_DRIVERS_SPI_COUNT_MAX && DEVICE_SPI_COUNT > MBED_CONF_DRIVERS_SPI_COUNT_MAX
 #define SPI_PERIPHERALS_USED MBED_CONF_DRIVERS_SPI_COUNT_MAX
@@ -238,6 +239,15 @@ public:
 
 #if DEVICE_SPI_ASYNCH
 
+    /** One segment of a multi-segment transfer, @see transfer_segments()
+     */
+    struct Segment {
+        const void *tx_buffer;  /**< TX buffer, NULL to send the default SPI value */
+        int tx_length;          /**< Length of the TX buffer in words */
+        void *rx_buffer;        /**< RX buffer, NULL to ignore the received data */
+        int rx_length;          /**< Length of the RX buffer in words */
+    };
+
     /** Start non-blocking SPI transfer using 8bit buffers.
      *
      * This function locks the deep sleep until any event has occurred.
@@ -265,6 +275,32 @@ public:
         return 0;
     }
 
+    /** Start a non-blocking SPI transfer made of several segments, for
+     * instance a command, an address and the data.
+     *
+     * The segments are sent in order with chip select asserted from the
+     * first one to the last one. Each segment is started from the interrupt
+     * handler of the previous one, and the callback is only called once the
+     * last segment completes, or when a segment fails. The remaining
+     * segments are then dropped.
+     *
+     * This function locks the deep sleep until any event has occurred.
+     *
+     * @param segments  The segments. The array and the buffers must stay valid
+     *                  until the callback is called.
+     * @param count     The number of segments.
+     * @param bit_width The buffers element width in bits.
+     * @param callback  The event callback function.
+     * @param event     The event mask of events to modify. @see spi_api.h for SPI events.
+     *
+     * @return Operation result.
+     * @retval 0 If the transfer has started or was added to the queue.
+     * @retval -1 If the queue is full, or if the hardware chip select can
+     *            not be kept asserted between segments,
+     *            @see spi_capabilities_t::hw_cs_hold
+     */
+    int transfer_segments(const Segment *segments, int count, unsigned char bit_width, const event_callback_t &callback, int event = SPI_EVENT_COMPLETE);
+
     /** Abort the on-going SPI transfer, and continue with transfers in the queue, if any.
      */
     void abort_transfer();
@@ -344,7 +380,23 @@ protected:
      */
     void start_transfer(const void *tx_buffer, int tx_length, void *rx_buffer, int rx_length, unsigned char bit_width, const event_callback_t &callback, int event);
 
+    /** Configure a callback, SPI peripheral, and initiate a multi-segment transfer.
+     *
+     * @param segments  The segments.
+     * @param count     The number of segments, at least 1.
+     * @param bit_width The buffers element width.
+     * @param callback  The event callback function.
+     * @param event     The event mask of events to modify.
+     */
+    void start_segments(const Segment *segments, int count, unsigned char bit_width, const event_callback_t &callback, int event);
+
 private:
+    /** Start the next segment of a multi-segment transfer, from the interrupt handler */
+    void start_next_segment();
+
+    /** Release the hardware chip select if it is held */
+    void release_cs_hold();
+
     /** Lock deep sleep only if it is not yet locked */
     void lock_deep_sleep();
 
@@ -353,11 +405,24 @@ private:
 
 
 #if TRANSACTION_QUEUE_SIZE_SPI
+    /** Put a transfer or a multi-segment transfer on the transfer queue.
+     *
+     *  @param data Transaction data, the buffers are unused for a multi-segment transfer.
+     *  @param segments The segments, or NULL for a single transfer.
+     *  @param count The number of segments.
+     *
+     *  @retval 0 A transfer was added to the queue.
+     *  @retval -1 Transfer can't be added because queue is full.
+     */
+    int queue_transaction(const transaction_t &data, const Segment *segments, int count);
+
     /** Start a new transaction.
      *
      *  @param data Transaction data.
+     *  @param segments The segments, or NULL for a single transfer.
+     *  @param count The number of segments.
      */
-    void start_transaction(transaction_t *data);
+    void start_transaction(transaction_t *data, const Segment *segments, int count);
 
     /** Dequeue a transaction and start the transfer if there was one pending.
      */
@@ -383,6 +448,15 @@ protected:
     // worked through C++ zero-initialization). And all the constants should be zero
     // to ensure it stays in the actual zero-init part of the image if used, avoiding
     // an initialized-data cost.
+#if DEVICE_SPI_ASYNCH && TRANSACTION_QUEUE_SIZE_SPI
+    // Pending transfer, segments is NULL unless it is a multi-segment transfer
+    struct spi_transaction_s {
+        Transaction<SPI> transaction;
+        const Segment *segments;
+        int segment_count;
+    };
+#endif
+
     struct spi_peripheral_s {
         /* Internal SPI name identifying the resources. */
         SPIName name = SPIName(0);
@@ -394,7 +468,7 @@ protected:
         SPI *owner = nullptr;
 #if DEVICE_SPI_ASYNCH && TRANSACTION_QUEUE_SIZE_SPI
         /* Queue of pending transfers */
-        SingletonPtr<CircularBuffer<Transaction<SPI>, TRANSACTION_QUEUE_SIZE_SPI> > transaction_buffer;
+        SingletonPtr<CircularBuffer<spi_transaction_s, TRANSACTION_QUEUE_SIZE_SPI> > transaction_buffer;
 #endif
     };
 
@@ -416,6 +490,13 @@ protected:
     DMAUsage _usage;
     /* Current sate of the sleep manager */
     bool _deep_sleep_locked;
+    /* Segments left in the on-going multi-segment transfer */
+    const Segment *_segments;
+    int _segments_left;
+    unsigned char _segment_width;
+    int _segment_event;
+    /* The hardware chip select is held between segments */
+    bool _cs_held;
 #endif // DEVICE_SPI_ASYNCH
 
     // Configuration.
@@ -443,6 +524,10 @@ protected:
     SPIName _peripheral_name;
     /* Pointer to spi init function */
     void (*_init_func)(SPI *);
+#if DEVICE_CLOCK_SCALING
+    /* Sets the frequency again for a new clock */
+    ClockManager::Listener _clock_listener {callback(this, &SPI::_clock_changed)};
+#endif
 
 private:
     void _do_construct();
@@ -452,6 +537,9 @@ private:
      */
     void _acquire(void);
     void _set_ssel(int);
+#if DEVICE_CLOCK_SCALING
+    void _clock_changed(ClockManager::event_t event);
+#endif
 
     /** Private lookup in the static _peripherals table.
      */
@@ -24,6 +24,12 @@
 
 #include "hal/spi_api.h"
 
+#if DEVICE_SPI_ASYNCH
+#include "platform/CThunk.h"
+#include "hal/dma_api.h"
+#include "platform/Callback.h"
+#endif
+
 namespace mbed {
 /**
  * \defgroup drivers_SPISlave SPISlave class
@@ -123,9 +129,100 @@ public:
      */
     void reply(int value);
 
+#if DEVICE_SPI_ASYNCH
+
+    /** Start a non-blocking SPI slave transfer using 8bit buffers.
+     *
+     * The transfer is armed straight away and runs as the master clocks the
+     * frames, with DMA where the target supports it. One more transfer can
+     * be given while a transfer is on-going: it is started from the
+     * interrupt handler as soon as the current one completes, before the
+     * callback is called, so that the master can clock the frames back to
+     * back while the application processes the completed buffers.
+     *
+     * This function locks the deep sleep until the transfers complete.
+     *
+     * @param tx_buffer The TX buffer with data to be transferred. If NULL is passed,
+     *                  the fill character is sent.
+     * @param tx_length The length of TX buffer in bytes.
+     * @param rx_buffer The RX buffer which is used for received data. If NULL is passed,
+     *                  received data are ignored.
+     * @param rx_length The length of RX buffer in bytes. If both buffers are
+     *                  given, the shorter length is transferred.
+     * @param callback  The event callback function, called from interrupt context.
+     * @param event     The event mask of events to modify. @see spi_api.h for SPI events.
+     *
+     * @return Operation result.
+     * @retval 0 If the transfer has started or is next.
+     * @retval -1 If a transfer is already next, or the target can not run
+     *            the transfer, @see spi_slave_transfer
+     */
+    template<typename Type>
+    int transfer(const Type *tx_buffer, int tx_length, Type *rx_buffer, int rx_length, const event_callback_t &callback, int event = SPI_EVENT_COMPLETE)
+    {
+        return transfer(tx_buffer, tx_length, rx_buffer, rx_length, sizeof(Type) * 8, callback, event);
+    }
+
+    /** Abort the on-going SPI transfer, and drop the next one.
+     */
+    void abort_transfer();
+
+    /** Configure DMA usage suggestion for non-blocking transfers.
+     *
+     *  @param usage The usage DMA hint for peripheral.
+     *
+     *  @return Result of the operation.
+     *  @retval 0 The usage was set.
+     *  @retval -1 Usage cannot be set as there is an ongoing transaction.
+     */
+    int set_dma_usage(DMAUsage usage);
+
+#endif // DEVICE_SPI_ASYNCH
+
 #if !defined(DOXYGEN_ONLY)
 
 protected:
+#if DEVICE_SPI_ASYNCH
+    /** Buffers and events of a transfer */
+    struct transfer_t {
+        const void *tx_buffer;
+        int tx_length;
+        void *rx_buffer;
+        int rx_length;
+        unsigned char width;
+        event_callback_t callback;
+        int event;
+    };
+
+    /** Start the transfer or make it the next one.
+     *
+     * @return 0 on success, -1 if it can not be started or a transfer is already next
+     */
+    int transfer(const void *tx_buffer, int tx_length, void *rx_buffer, int rx_length, unsigned char bit_width, const event_callback_t &callback, int event);
+
+    /** Arm the peripheral with a transfer, and make it the current one.
+     *
+     * @return true if the transfer was armed
+     */
+    bool start_transfer(const transfer_t &t);
+
+    /** SPI interrupt handler.
+     */
+    void irq_handler_asynch(void);
+
+    /* Interrupt */
+    CThunk<SPISlave> _irq;
+    /* The transfer armed in the peripheral */
+    transfer_t _current;
+    /* The transfer started once the current one completes */
+    transfer_t _next;
+    bool _active;
+    bool _next_pending;
+    /* Current preferred DMA mode @see dma_api.h */
+    DMAUsage _usage;
+#endif // DEVICE_SPI_ASYNCH
+
+
     /* Internal SPI object identifying the resources */
     spi_t _spi;
 
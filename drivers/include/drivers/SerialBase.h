@@ -25,6 +25,7 @@
 #include "hal/serial_api.h"
 #include "platform/mbed_toolchain.h"
 #include "platform/NonCopyable.h"
+#include "drivers/ClockManager.h"
 
 #if DEVICE_SERIAL_ASYNCH
 #include "platform/CThunk.h"
@@ -302,6 +303,12 @@ protected:
      */
     void _deinit();
 
+#if DEVICE_CLOCK_SCALING
+    /** Set the baud rate again for the new clock
+     */
+    void _clock_changed(ClockManager::event_t event);
+#endif
+
 #if DEVICE_SERIAL_ASYNCH
     CThunk<SerialBase> _thunk_irq;
     DMAUsage _tx_usage = DMA_USAGE_NEVER;
@@ -330,6 +337,10 @@ protected:
     void (SerialBase::*_set_flow_control_sp_func)(Flow, const serial_fc_pinmap_t &) = NULL;
 #endif
 
+#if DEVICE_CLOCK_SCALING
+    ClockManager::Listener _clock_listener {callback(this, &SerialBase::_clock_changed)};
+#endif
+
 #endif
 };
 
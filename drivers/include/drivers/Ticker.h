@@ -125,6 +125,16 @@ public:
      */
     void detach();
 
+    /** Allow the function to be called late, so that it shares an interrupt
+     *  with other timer events and the system wakes up less often
+     *
+     *  @param slack the time the call may be delayed by, 0 (the default) to call on time
+     *
+     *  @note The slack applies from the next attach, or the next period of a
+     *  Ticker. Late calls do not shift the following periods.
+     */
+    void set_slack(std::chrono::microseconds slack);
+
 #if !defined(DOXYGEN_ONLY)
 protected:
     TickerBase(const ticker_data_t *data);
@@ -98,6 +98,20 @@ public:
         ticker_insert_event_us(_ticker, obj, timestamp.time_since_epoch().count(), id);
     }
 
+    /** Insert an event to the queue, allowing it to run late
+     *
+     * @see ticker_insert_event_us_slack
+     *
+     * @param obj       The event object to be inserted to the queue
+     * @param timestamp The event's timestamp
+     * @param id        The event object
+     * @param slack     Time the event may be delayed by, to share an interrupt with other events
+     */
+    void insert_event(ticker_event_t *obj, time_point timestamp, uint32_t id, duration slack)
+    {
+        ticker_insert_event_us_slack(_ticker, obj, timestamp.time_since_epoch().count(), id, slack.count());
+    }
+
     /** Read the current (absolute) ticker's timestamp
      *
      * @warning Return an absolute timestamp counting from the initialization of the
@@ -19,6 +19,12 @@
 
 #if DEVICE_ANALOGIN
 
+#if DEVICE_ANALOGIN_STREAM
+#include "platform/mbed_power_mgmt.h"
+
+#define ANALOGIN_STREAM_CHANNELS_MAX 8
+#endif
+
 namespace mbed {
 
 SingletonPtr<PlatformMutex> AnalogIn::_mutex;
@@ -69,6 +75,61 @@ float AnalogIn::get_reference_voltage(void) const
     return _vref;
 }
 
+#if DEVICE_ANALOGIN_STREAM
+
+int AnalogIn::start_stream(Span<uint16_t> buffer, uint32_t sample_rate, const Callback<void(Span<uint16_t>)> &callback,
+                           Span<AnalogIn *const> channels)
+{
+    analogin_t *adcs[ANALOGIN_STREAM_CHANNELS_MAX];
+    size_t count = channels.size() + 1;
+
+    if (count > ANALOGIN_STREAM_CHANNELS_MAX || buffer.size() % (2 * count) != 0) {
+        return -1;
+    }
+    adcs[0] = &_adc;
+    for (size_t i = 1; i < count; i++) {
+        adcs[i] = &channels[i - 1]->_adc;
+    }
+
+    lock();
+    if (_streaming) {
+        unlock();
+        return -1;
+    }
+
+    _stream_callback = callback;
+    sleep_manager_lock_deep_sleep();
+    if (!analogin_stream_start(adcs, count, sample_rate, buffer.data(), buffer.size(), &AnalogIn::_stream_irq, (uint32_t)this)) {
+        sleep_manager_unlock_deep_sleep();
+        unlock();
+        return -1;
+    }
+    _streaming = true;
+    unlock();
+    return 0;
+}
+
+void AnalogIn::stop_stream()
+{
+    lock();
+    if (_streaming) {
+        analogin_stream_stop(&_adc);
+        _streaming = false;
+        sleep_manager_unlock_deep_sleep();
+    }
+    unlock();
+}
+
+void AnalogIn::_stream_irq(uint32_t id, uint16_t *samples, size_t count)
+{
+    AnalogIn *handler = (AnalogIn *)id;
+    if (handler->_stream_callback) {
+        handler->_stream_callback(Span<uint16_t>(samples, count));
+    }
+}
+
+#endif
+
 } // namespace mbed
 
 #endif
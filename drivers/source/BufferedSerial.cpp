@@ -20,23 +20,42 @@
 
 #include "platform/mbed_poll.h"
 #include "platform/mbed_thread.h"
+#if DEVICE_SERIAL_DMA
+#include "platform/mbed_power_mgmt.h"
+#endif
 
 namespace mbed {
 
 BufferedSerial::BufferedSerial(PinName tx, PinName rx, int baud):
     SerialBase(tx, rx, baud)
 {
+#if DEVICE_SERIAL_DMA
+    start_rx();
+#else
     enable_rx_irq();
+#endif
 }
 
 BufferedSerial::BufferedSerial(const serial_pinmap_t &static_pinmap, int baud):
     SerialBase(static_pinmap, baud)
 {
+#if DEVICE_SERIAL_DMA
+    start_rx();
+#else
     enable_rx_irq();
+#endif
 }
 
 BufferedSerial::~BufferedSerial()
 {
+#if DEVICE_SERIAL_DMA
+    core_util_critical_section_enter();
+    stop_rx_dma();
+    core_util_critical_section_exit();
+    while (_tx_dma_busy) {
+        thread_sleep_for(1);
+    }
+#endif
     delete _dcd_irq;
 }
 
@@ -113,6 +132,14 @@ int BufferedSerial::sync()
         api_lock();
     }
 
+#if DEVICE_SERIAL_DMA
+    while (_tx_dma_busy) {
+        api_unlock();
+        thread_sleep_for(1);
+        api_lock();
+    }
+#endif
+
     api_unlock();
 
     return 0;
@@ -136,6 +163,16 @@ void BufferedSerial::sigio(Callback<void()> func)
  */
 ssize_t BufferedSerial::write_unbuffered(const char *buf_ptr, size_t length)
 {
+#if DEVICE_SERIAL_DMA
+    // The DMA interrupt cannot run here, finish the chunk by polling
+    if (_tx_dma_busy) {
+        while (serial_tx_dma_active(&_serial)) {
+        }
+        _tx_dma_busy = false;
+        sleep_manager_unlock_deep_sleep();
+    }
+#endif
+
     while (!_txbuf.empty()) {
         tx_irq();
     }
@@ -179,25 +216,85 @@ ssize_t BufferedSerial::write(const void *buffer, size_t length)
             } while (_txbuf.full());
         }
 
-        while (data_written < length && !_txbuf.full()) {
-            _txbuf.push(*buf_ptr++);
-            data_written++;
+        data_written += _txbuf.push(buf_ptr + data_written, length - data_written);
+
+        start_tx();
+    }
+
+    api_unlock();
+
+    return data_written != 0 ? (ssize_t) data_written : (ssize_t) - EAGAIN;
+}
+
+ssize_t BufferedSerial::writev(const struct iovec *iov, int iovcnt)
+{
+    size_t data_written = 0;
+    size_t length = 0;
+
+    if (core_util_in_critical_section()) {
+        for (int i = 0; i < iovcnt; i++) {
+            data_written += write_unbuffered(static_cast<const char *>(iov[i].iov_base), iov[i].iov_len);
         }
+        return data_written;
+    }
 
-        core_util_critical_section_enter();
-        if (_tx_enabled && !_tx_irq_enabled) {
-            // only write to hardware in one place
-            BufferedSerial::tx_irq();
-            if (!_txbuf.empty()) {
-                enable_tx_irq();
+    api_lock();
+
+    // Queue all the buffers under one lock, and only start the hardware
+    // when the buffer fills up or everything is queued
+    for (int i = 0; i < iovcnt; i++) {
+        const char *buf_ptr = static_cast<const char *>(iov[i].iov_base);
+        size_t done = 0;
+        length += iov[i].iov_len;
+
+        while (done < iov[i].iov_len) {
+            if (_txbuf.full()) {
+                start_tx();
+                if (!_blocking) {
+                    break;
+                }
+                do {
+                    api_unlock();
+                    thread_sleep_for(1);
+                    api_lock();
+                } while (_txbuf.full());
             }
+
+            done += _txbuf.push(buf_ptr + done, iov[i].iov_len - done);
+        }
+
+        data_written += done;
+        if (done < iov[i].iov_len) {
+            break;
         }
-        core_util_critical_section_exit();
     }
 
+    start_tx();
+
     api_unlock();
 
-    return data_written != 0 ? (ssize_t) data_written : (ssize_t) - EAGAIN;
+    return data_written != 0 || length == 0 ? (ssize_t) data_written : (ssize_t) - EAGAIN;
+}
+
+void BufferedSerial::start_tx()
+{
+    core_util_critical_section_enter();
+#if DEVICE_SERIAL_DMA
+    if (_tx_enabled && _tx_dma && !_tx_dma_busy) {
+        tx_dma_next();
+    }
+    const bool tx_by_irq = !_tx_dma;
+#else
+    const bool tx_by_irq = true;
+#endif
+    if (tx_by_irq && _tx_enabled && !_tx_irq_enabled) {
+        // only write to hardware in one place
+        BufferedSerial::tx_irq();
+        if (!_txbuf.empty()) {
+            enable_tx_irq();
+        }
+    }
+    core_util_critical_section_exit();
 }
 
 ssize_t BufferedSerial::read(void *buffer, size_t length)
@@ -223,12 +320,15 @@ ssize_t BufferedSerial::read(void *buffer, size_t length)
         api_lock();
     }
 
-    while (data_read < length && !_rxbuf.empty()) {
-        _rxbuf.pop(*ptr++);
-        data_read++;
-    }
+    data_read = _rxbuf.pop(ptr, length);
 
     core_util_critical_section_enter();
+#if DEVICE_SERIAL_DMA
+    if (_rx_dma) {
+        // pick up what DMA left in its ring while the buffer was full
+        BufferedSerial::rx_dma_irq();
+    } else
+#endif
     if (_rx_enabled && !_rx_irq_enabled) {
         // only read from hardware in one place
         BufferedSerial::rx_irq();
@@ -329,6 +429,101 @@ void BufferedSerial::tx_irq(void)
     }
 }
 
+#if DEVICE_SERIAL_DMA
+void BufferedSerial::start_rx()
+{
+    _rx_dma_tail = 0;
+    _rx_dma = serial_rx_dma_start(&_serial, _rx_dma_buf, sizeof(_rx_dma_buf),
+                                  &BufferedSerial::_rx_dma_irq, reinterpret_cast<uint32_t>(this));
+    if (_rx_dma) {
+        // SerialBase only holds the deep sleep lock for attached IRQs
+        sleep_manager_lock_deep_sleep();
+    } else {
+        enable_rx_irq();
+    }
+}
+
+void BufferedSerial::stop_rx_dma()
+{
+    if (_rx_dma) {
+        rx_dma_irq();
+        serial_rx_dma_stop(&_serial);
+        sleep_manager_unlock_deep_sleep();
+        _rx_dma = false;
+    }
+}
+
+void BufferedSerial::rx_dma_irq(void)
+{
+    bool was_empty = _rxbuf.empty();
+    size_t head = serial_rx_dma_position(&_serial);
+
+    // Copy at most two contiguous runs of the ring. What does not fit in the
+    // receive buffer stays in the ring until read() makes room.
+    while (_rx_dma_tail != head) {
+        size_t end = head > _rx_dma_tail ? head : sizeof(_rx_dma_buf);
+        size_t pushed = _rxbuf.push(reinterpret_cast<char *>(&_rx_dma_buf[_rx_dma_tail]), end - _rx_dma_tail);
+        if (pushed == 0) {
+            break;
+        }
+        _rx_dma_tail = (_rx_dma_tail + pushed) % sizeof(_rx_dma_buf);
+    }
+
+    if (was_empty && !_rxbuf.empty()) {
+        wake();
+    }
+}
+
+// Also called from write to start transfer
+void BufferedSerial::tx_dma_next()
+{
+    bool was_full = _txbuf.full();
+    size_t length = _txbuf.pop(reinterpret_cast<char *>(_tx_dma_buf), sizeof(_tx_dma_buf));
+
+    if (length != 0) {
+        if (serial_tx_dma_start(&_serial, _tx_dma_buf, length,
+                                &BufferedSerial::_tx_dma_irq, reinterpret_cast<uint32_t>(this))) {
+            _tx_dma_busy = true;
+            sleep_manager_lock_deep_sleep();
+        } else {
+            // No DMA for this port: send the chunk and use IRQs from now on
+            _tx_dma = false;
+            for (size_t i = 0; i < length; i++) {
+                SerialBase::_base_putc(_tx_dma_buf[i]);
+            }
+            if (!_txbuf.empty()) {
+                enable_tx_irq();
+            }
+        }
+    }
+
+    if (was_full && !_txbuf.full() && !hup()) {
+        wake();
+    }
+}
+
+void BufferedSerial::tx_dma_irq(void)
+{
+    // write_unbuffered may have completed the chunk already
+    if (!_tx_dma_busy) {
+        return;
+    }
+    _tx_dma_busy = false;
+    sleep_manager_unlock_deep_sleep();
+    tx_dma_next();
+}
+
+void BufferedSerial::_rx_dma_irq(uint32_t id)
+{
+    reinterpret_cast<BufferedSerial *>(id)->rx_dma_irq();
+}
+
+void BufferedSerial::_tx_dma_irq(uint32_t id)
+{
+    reinterpret_cast<BufferedSerial *>(id)->tx_dma_irq();
+}
+#endif
+
 /* These are all called from critical section
  * Attatch IRQ routines to the serial device.
  */
@@ -359,7 +554,25 @@ void BufferedSerial::disable_tx_irq()
 int BufferedSerial::enable_input(bool enabled)
 {
     api_lock();
+#if DEVICE_SERIAL_DMA
+    core_util_critical_section_enter();
+    if (!enabled) {
+        stop_rx_dma();
+    }
+    core_util_critical_section_exit();
+#endif
     SerialBase::enable_input(enabled);
+#if DEVICE_SERIAL_DMA
+    core_util_critical_section_enter();
+    if (enabled && !_rx_dma) {
+        // the peripheral may have been initialized again, restart DMA
+        if (_rx_irq_enabled) {
+            disable_rx_irq();
+        }
+        start_rx();
+    }
+    core_util_critical_section_exit();
+#endif
     api_unlock();
 
     return 0;
@@ -368,6 +581,13 @@ int BufferedSerial::enable_input(bool enabled)
 int BufferedSerial::enable_output(bool enabled)
 {
     api_lock();
+#if DEVICE_SERIAL_DMA
+    while (!enabled && _tx_dma_busy) {
+        api_unlock();
+        thread_sleep_for(1);
+        api_lock();
+    }
+#endif
     SerialBase::enable_output(enabled);
     api_unlock();
 
@@ -18,6 +18,7 @@
 
 #if DEVICE_CAN
 
+#include "platform/mbed_critical.h"
 #include "platform/mbed_power_mgmt.h"
 
 namespace mbed {
@@ -55,6 +56,7 @@ CAN::~CAN()
     // No lock needed in destructor
 
     // Detaching interrupts releases the sleep lock if it was locked
+    set_rx_buffer(Span<CANMessage>());
     for (int irq = 0; irq < IrqCnt; irq++) {
         attach(nullptr, (IrqType)irq);
     }
@@ -80,12 +82,54 @@ int CAN::write(CANMessage msg)
 
 int CAN::read(CANMessage &msg, int handle)
 {
+    if (_rx_buffer_size != 0 && handle == 0) {
+        return read(Span<CANMessage>(&msg, 1));
+    }
+
     lock();
     int ret = can_read(&_can, &msg, handle);
     unlock();
     return ret;
 }
 
+size_t CAN::read(Span<CANMessage> msgs)
+{
+    size_t count = 0;
+
+    lock();
+    while (_rx_buffer_size != 0 && count < (size_t) msgs.size() && _rx_tail != _rx_head) {
+        msgs[count++] = _rx_buffer[_rx_tail];
+        // the interrupt may only reuse the slot once the message is copied
+        _rx_tail = (_rx_tail + 1) % _rx_buffer_size;
+    }
+    unlock();
+    return count;
+}
+
+void CAN::set_rx_buffer(Span<CANMessage> buffer)
+{
+    lock();
+    core_util_critical_section_enter();
+    bool was_buffered = _rx_buffer_size != 0;
+    _rx_buffer = buffer.data();
+    _rx_buffer_size = buffer.size();
+    _rx_head = 0;
+    _rx_tail = 0;
+    _rx_overruns = 0;
+    core_util_critical_section_exit();
+
+    if (_rx_buffer_size != 0 && !was_buffered) {
+        sleep_manager_lock_deep_sleep();
+        can_irq_set(&_can, IRQ_RX, 1);
+    } else if (_rx_buffer_size == 0 && was_buffered) {
+        if (!_irq[IRQ_RX]) {
+            can_irq_set(&_can, IRQ_RX, 0);
+        }
+        sleep_manager_unlock_deep_sleep();
+    }
+    unlock();
+}
+
 void CAN::reset()
 {
     lock();
@@ -132,6 +176,22 @@ int CAN::filter(unsigned int id, unsigned int mask, CANFormat format, int handle
     return ret;
 }
 
+size_t CAN::filter(Span<const Filter> filters)
+{
+    size_t count = 0;
+
+    lock();
+    while (count < (size_t) filters.size()) {
+        const Filter &f = filters[count];
+        if (!can_filter(&_can, f.id, f.mask, f.format, count)) {
+            break;
+        }
+        count++;
+    }
+    unlock();
+    return count;
+}
+
 void CAN::attach(Callback<void()> func, IrqType type)
 {
     lock();
@@ -148,14 +208,36 @@ void CAN::attach(Callback<void()> func, IrqType type)
             sleep_manager_unlock_deep_sleep();
         }
         _irq[(CanIrqType)type] = nullptr;
-        can_irq_set(&_can, (CanIrqType)type, 0);
+        // the RX buffer still needs the RX interrupt
+        if (type != RxIrq || _rx_buffer_size == 0) {
+            can_irq_set(&_can, (CanIrqType)type, 0);
+        }
     }
     unlock();
 }
 
+void CAN::rx_buffer_irq()
+{
+    CANMessage msg;
+
+    // read everything pending, so a burst costs one interrupt
+    while (can_read(&_can, &msg, 0)) {
+        uint32_t next = (_rx_head + 1) % _rx_buffer_size;
+        if (next != _rx_tail) {
+            _rx_buffer[_rx_head] = msg;
+            _rx_head = next;
+        } else {
+            _rx_overruns = _rx_overruns + 1;
+        }
+    }
+}
+
 void CAN::_irq_handler(uint32_t id, CanIrqType type)
 {
     CAN *handler = (CAN *)id;
+    if (type == IRQ_RX && handler->_rx_buffer_size != 0) {
+        handler->rx_buffer_irq();
+    }
     if (handler->_irq[type]) {
         handler->_irq[type].call();
     }
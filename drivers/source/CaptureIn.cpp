@@ -0,0 +1,149 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "drivers/CaptureIn.h"
+
+#if DEVICE_CAPTURE
+
+#include "platform/mbed_critical.h"
+#include "platform/mbed_power_mgmt.h"
+
+namespace mbed {
+
+CaptureIn::CaptureIn(PinName pin, Edge edge) :
+    _edge(edge),
+    _buffer(nullptr),
+    _length(0),
+    _tail(0)
+{
+    core_util_critical_section_enter();
+    capture_init(&_capture, pin, (capture_edge_t) edge);
+    core_util_critical_section_exit();
+}
+
+CaptureIn::~CaptureIn()
+{
+    stop();
+    core_util_critical_section_enter();
+    capture_free(&_capture);
+    core_util_critical_section_exit();
+}
+
+uint32_t CaptureIn::get_frequency()
+{
+    return capture_get_info(&_capture)->frequency;
+}
+
+int CaptureIn::start(Span<uint32_t> buffer, Callback<void()> callback)
+{
+    int ret = -1;
+    core_util_critical_section_enter();
+    if (!_buffer && !buffer.empty()) {
+        _callback = callback;
+        _length = buffer.size();
+        _tail = 0;
+        if (capture_start(&_capture, buffer.data(), _length, &CaptureIn::_capture_irq, reinterpret_cast<uint32_t>(this))) {
+            _buffer = buffer.data();
+            sleep_manager_lock_deep_sleep();
+            ret = 0;
+        }
+    }
+    core_util_critical_section_exit();
+    return ret;
+}
+
+void CaptureIn::stop()
+{
+    core_util_critical_section_enter();
+    if (_buffer) {
+        capture_stop(&_capture);
+        _buffer = nullptr;
+        sleep_manager_unlock_deep_sleep();
+    }
+    core_util_critical_section_exit();
+}
+
+size_t CaptureIn::readable()
+{
+    size_t count = 0;
+    core_util_critical_section_enter();
+    if (_buffer) {
+        count = (capture_position(&_capture) + _length - _tail) % _length;
+    }
+    core_util_critical_section_exit();
+    return count;
+}
+
+size_t CaptureIn::read(Span<uint32_t> timestamps)
+{
+    size_t count = 0;
+    core_util_critical_section_enter();
+    if (_buffer) {
+        size_t head = capture_position(&_capture);
+        while ((_tail != head) && (count < timestamps.size())) {
+            timestamps[count++] = _buffer[_tail];
+            _tail = (_tail + 1) % _length;
+        }
+    }
+    core_util_critical_section_exit();
+    return count;
+}
+
+uint32_t CaptureIn::read_frequency()
+{
+    const capture_info_t *info = capture_get_info(&_capture);
+    uint32_t mask = (info->bits >= 32) ? 0xFFFFFFFF : ((1UL << info->bits) - 1);
+    uint64_t ticks = 0;
+    uint32_t edges = 0;
+
+    core_util_critical_section_enter();
+    if (_buffer) {
+        size_t head = capture_position(&_capture);
+        if (_tail != head) {
+            uint32_t previous = _buffer[_tail];
+            _tail = (_tail + 1) % _length;
+            // Sum the intervals one by one, as the counter may wrap more than once
+            while (_tail != head) {
+                ticks += (_buffer[_tail] - previous) & mask;
+                previous = _buffer[_tail];
+                _tail = (_tail + 1) % _length;
+                edges++;
+            }
+        }
+    }
+    core_util_critical_section_exit();
+
+    if (_edge == Both) {
+        ticks *= 2;
+    }
+    if (!ticks) {
+        return 0;
+    }
+    return (uint32_t)(((uint64_t) edges * info->frequency + ticks / 2) / ticks);
+}
+
+void CaptureIn::_capture_irq(uint32_t id)
+{
+    CaptureIn *handler = reinterpret_cast<CaptureIn *>(id);
+    if (handler->_callback) {
+        handler->_callback();
+    }
+}
+
+} // namespace mbed
+
+#endif // #if DEVICE_CAPTURE
@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2021 Arm Limited and affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "drivers/ClockManager.h"
+
+#if DEVICE_CLOCK_SCALING
+
+#include "platform/PlatformMutex.h"
+#include "platform/SingletonPtr.h"
+
+namespace mbed {
+
+// Guards the listener list, and keeps a change and its notifications together
+static SingletonPtr<PlatformMutex> _mutex;
+
+ClockManager::Listener *ClockManager::_listeners = nullptr;
+
+ClockManager::Listener::Listener(Callback<void(event_t)> callback) :
+    _callback(callback), _next(nullptr)
+{
+    _mutex->lock();
+    _next = _listeners;
+    _listeners = this;
+    _mutex->unlock();
+}
+
+ClockManager::Listener::~Listener()
+{
+    _mutex->lock();
+    for (Listener **p = &_listeners; *p; p = &(*p)->_next) {
+        if (*p == this) {
+            *p = _next;
+            break;
+        }
+    }
+    _mutex->unlock();
+}
+
+int ClockManager::level_count()
+{
+    return clock_scaling_level_count();
+}
+
+uint32_t ClockManager::frequency(int level)
+{
+    if (level < 0) {
+        return 0;
+    }
+    return clock_scaling_frequency(level);
+}
+
+int ClockManager::get_level()
+{
+    return clock_scaling_get_level();
+}
+
+int ClockManager::set_level(int level)
+{
+    if (level < 0 || level >= level_count()) {
+        return -1;
+    }
+
+    _mutex->lock();
+    if (level == get_level()) {
+        _mutex->unlock();
+        return 0;
+    }
+
+    notify(CLOCK_WILL_CHANGE);
+    int ret = clock_scaling_set_level(level);
+    // Also after a failure, so that the listeners resume
+    notify(CLOCK_CHANGED);
+    _mutex->unlock();
+
+    return ret;
+}
+
+void ClockManager::notify(event_t event)
+{
+    for (Listener *listener = _listeners; listener; listener = listener->_next) {
+        listener->_callback(event);
+    }
+}
+
+} // namespace mbed
+
+#endif // DEVICE_CLOCK_SCALING
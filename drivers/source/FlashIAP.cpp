@@ -82,6 +82,8 @@ int FlashIAP::deinit()
         }
     }
     delete[] _page_buf;
+    delete[] _stream_buf;
+    _stream_buf = nullptr;
     _mutex->unlock();
     return ret;
 }
@@ -162,6 +164,73 @@ int FlashIAP::program(const void *buffer, uint32_t addr, uint32_t size)
     return ret;
 }
 
+int FlashIAP::program_stream_start(uint32_t addr)
+{
+    uint32_t page_size = get_page_size();
+    if (_stream_buf || !is_aligned(addr, page_size)) {
+        return -1;
+    }
+    _stream_buf = new uint8_t[page_size];
+    _stream_addr = addr;
+    _stream_fill = 0;
+    return 0;
+}
+
+int FlashIAP::program_stream(const void *buffer, uint32_t size)
+{
+    uint32_t page_size = get_page_size();
+    const uint8_t *buf = (const uint8_t *) buffer;
+    uint32_t chunk;
+    int ret = 0;
+
+    if (!_stream_buf || (!buffer && size)) {
+        return -1;
+    }
+
+    // Complete the page started by the previous call
+    if (_stream_fill) {
+        chunk = std::min(page_size - _stream_fill, size);
+        memcpy(_stream_buf + _stream_fill, buf, chunk);
+        _stream_fill += chunk;
+        buf += chunk;
+        size -= chunk;
+        if (_stream_fill == page_size) {
+            ret = program(_stream_buf, _stream_addr, page_size);
+            _stream_addr += page_size;
+            _stream_fill = 0;
+        }
+    }
+
+    chunk = size / page_size * page_size;
+    if (!ret && chunk) {
+        ret = program(buf, _stream_addr, chunk);
+        _stream_addr += chunk;
+        buf += chunk;
+        size -= chunk;
+    }
+
+    if (!ret && size) {
+        memcpy(_stream_buf, buf, size);
+        _stream_fill = size;
+    }
+    return ret;
+}
+
+int FlashIAP::program_stream_end()
+{
+    int ret = 0;
+    if (!_stream_buf) {
+        return -1;
+    }
+    if (_stream_fill) {
+        ret = program(_stream_buf, _stream_addr, _stream_fill);
+    }
+    delete[] _stream_buf;
+    _stream_buf = nullptr;
+    _stream_fill = 0;
+    return ret;
+}
+
 bool FlashIAP::is_aligned_to_sector(uint32_t addr, uint32_t size)
 {
     uint32_t current_sector_size = flash_get_sector_size(&_flash, addr);
@@ -233,6 +302,30 @@ uint32_t FlashIAP::get_flash_size() const
     return flash_get_size(&_flash);
 }
 
+uint32_t FlashIAP::get_bank_size() const
+{
+    return flash_get_bank_size(&_flash);
+}
+
+bool FlashIAP::is_read_while_write(uint32_t addr, uint32_t size) const
+{
+#if defined(FLASHIAP_APP_ROM_END_ADDR)
+    uint32_t flash_start_addr = flash_get_start_address(&_flash);
+    uint32_t bank_size = flash_get_bank_size(&_flash);
+    uint32_t app_end_addr = FLASHIAP_APP_ROM_END_ADDR;
+
+    if (!size || (addr < flash_start_addr) || (app_end_addr <= flash_start_addr)) {
+        return false;
+    }
+    // Bank of the last byte of the application, which starts in the first bank
+    uint32_t app_last_bank = (app_end_addr - 1 - flash_start_addr) / bank_size;
+    uint32_t first_bank = (addr - flash_start_addr) / bank_size;
+    return first_bank > app_last_bank;
+#else
+    return false;
+#endif
+}
+
 uint8_t FlashIAP::get_erase_value() const
 {
     return flash_get_erase_value(&_flash);
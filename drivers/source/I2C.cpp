@@ -23,6 +23,7 @@
 
 #if DEVICE_I2C_ASYNCH
 #include "platform/mbed_power_mgmt.h"
+#include "platform/mbed_critical.h"
 #endif
 
 namespace mbed {
@@ -87,6 +88,15 @@ void I2C::aquire()
     unlock();
 }
 
+#if DEVICE_CLOCK_SCALING
+void I2C::_clock_changed(ClockManager::event_t event)
+{
+    if (event == ClockManager::CLOCK_CHANGED) {
+        frequency(_hz);
+    }
+}
+#endif
+
 // write - Master Transmitter Mode
 int I2C::write(int address, const char *data, int length, bool repeated)
 {
@@ -211,17 +221,58 @@ int I2C::transfer(int address, const char *tx_buffer, int tx_length, char *rx_bu
     lock();
     if (i2c_active(&_i2c)) {
         unlock();
-        return -1; // transaction ongoing
+        // transaction ongoing
+        return queue_transfer(address, tx_buffer, tx_length, rx_buffer, rx_length, callback, event, repeated);
     }
+    start_transfer(address, tx_buffer, tx_length, rx_buffer, rx_length, callback, event, repeated);
+    unlock();
+    return 0;
+}
+
+int I2C::queue_transfer(int address, const char *tx_buffer, int tx_length, char *rx_buffer, int rx_length, const event_callback_t &callback, int event, bool repeated)
+{
+#if TRANSACTION_QUEUE_SIZE_I2C
+    i2c_transaction_s t;
+
+    t.transaction.tx_buffer = const_cast<char *>(tx_buffer);
+    t.transaction.tx_length = tx_length;
+    t.transaction.rx_buffer = rx_buffer;
+    t.transaction.rx_length = rx_length;
+    t.transaction.event = event;
+    t.transaction.callback = callback;
+    t.transaction.width = 8;
+    t.address = address;
+    t.repeated = repeated;
+
+    core_util_critical_section_enter();
+    if (_transaction_buffer.full()) {
+        core_util_critical_section_exit();
+        return -1; // the buffer is full
+    }
+    _transaction_buffer.push(t);
+    dequeue_transaction();
+    core_util_critical_section_exit();
+    return 0;
+#else
+    return -1;
+#endif
+}
+
+void I2C::start_transfer(int address, const char *tx_buffer, int tx_length, char *rx_buffer, int rx_length, const event_callback_t &callback, int event, bool repeated)
+{
     lock_deep_sleep();
-    aquire();
+
+    // Queued transfers start from the interrupt handler, so the frequency
+    // is set without taking the mutex
+    if (_owner != this) {
+        i2c_frequency(&_i2c, _hz);
+        _owner = this;
+    }
 
     _callback = callback;
     int stop = (repeated) ? 0 : 1;
     _irq.callback(&I2C::irq_handler_asynch);
     i2c_transfer_asynch(&_i2c, (void *)tx_buffer, tx_length, (void *)rx_buffer, rx_length, address, stop, _irq.entry(), event, _usage);
-    unlock();
-    return 0;
 }
 
 void I2C::abort_transfer(void)
@@ -229,9 +280,58 @@ void I2C::abort_transfer(void)
     lock();
     i2c_abort_asynch(&_i2c);
     unlock_deep_sleep();
+#if TRANSACTION_QUEUE_SIZE_I2C
+    core_util_critical_section_enter();
+    dequeue_transaction();
+    core_util_critical_section_exit();
+#endif
+    unlock();
+}
+
+void I2C::clear_transfer_buffer(void)
+{
+#if TRANSACTION_QUEUE_SIZE_I2C
+    _transaction_buffer.reset();
+#endif
+}
+
+void I2C::abort_all_transfers(void)
+{
+    clear_transfer_buffer();
+    abort_transfer();
+}
+
+int I2C::set_dma_usage(DMAUsage usage)
+{
+    lock();
+    if (i2c_active(&_i2c)) {
+        unlock();
+        return -1;
+    }
+    _usage = usage;
     unlock();
+    return 0;
 }
 
+#if TRANSACTION_QUEUE_SIZE_I2C
+
+void I2C::dequeue_transaction()
+{
+    // The callback may already have started a transfer
+    if (i2c_active(&_i2c)) {
+        return;
+    }
+
+    i2c_transaction_s t;
+    if (_transaction_buffer.pop(t)) {
+        transaction_t *data = &t.transaction;
+        start_transfer(t.address, static_cast<const char *>(data->tx_buffer), data->tx_length,
+                       static_cast<char *>(data->rx_buffer), data->rx_length, data->callback, data->event, t.repeated);
+    }
+}
+
+#endif
+
 void I2C::irq_handler_asynch(void)
 {
     int event = i2c_irq_handler_asynch(&_i2c);
@@ -241,6 +341,11 @@ void I2C::irq_handler_asynch(void)
 
     if (event) {
         unlock_deep_sleep();
+#if TRANSACTION_QUEUE_SIZE_I2C
+        // The peripheral is free, go on with the next transfer. It starts with
+        // a repeated start if the previous one was queued with repeated set.
+        dequeue_transaction();
+#endif
     }
 }
 
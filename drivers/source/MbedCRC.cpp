@@ -26,6 +26,10 @@ SingletonPtr<PlatformMutex> mbed_crc_mutex;
 static_assert(MBED_CRC_TABLE_SIZE == 0 || MBED_CRC_TABLE_SIZE == 16 || MBED_CRC_TABLE_SIZE == 256,
               "Configuration setting drivers.crc-table-size must be set to 0, 16 or 256");
 
+static_assert(MBED_CONF_DRIVERS_CRC_SLICE_BY == 1 ||
+              (MBED_CRC_TABLE_SIZE == 256 && (MBED_CONF_DRIVERS_CRC_SLICE_BY == 4 || MBED_CONF_DRIVERS_CRC_SLICE_BY == 8)),
+              "Configuration setting drivers.crc-slice-by must be set to 1, or to 4 or 8 with drivers.crc-table-size 256");
+
 #if MBED_CRC_TABLE_SIZE > 0
 
 /* Tables are arranged for LSB first input. This means they're optimised
@@ -141,6 +145,35 @@ const uint32_t MbedCRC<POLY_32BIT_ANSI, 32, CrcMode::TABLE>::_crc_table[MBED_CRC
     CRCS(0xbdbdf21c, 0xcabac28a, 0x53b39330, 0x24b4a3a6, 0xbad03605, 0xcdd70693, 0x54de5729, 0x23d967bf, 0xb3667a2e, 0xc4614ab8, 0x5d681b02, 0x2a6f2b94, 0xb40bbe37, 0xc30c8ea1, 0x5a05df1b, 0x2d02ef8d)
 };
 
+#if MBED_CRC_SLICE_TABLES
+
+/* Computed at compile time, so the tables end up in flash like the one above */
+static constexpr crc_slice_table_t make_crc32_slice_table()
+{
+    uint32_t base[256] = {};
+    crc_slice_table_t t = {};
+
+    for (uint32_t i = 0; i < 256; i++) {
+        uint32_t crc = i;
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320 : crc >> 1;
+        }
+        base[i] = crc;
+    }
+    for (int k = 0; k < MBED_CONF_DRIVERS_CRC_SLICE_BY - 1; k++) {
+        for (uint32_t i = 0; i < 256; i++) {
+            uint32_t prev = k == 0 ? base[i] : t.table[k - 1][i];
+            t.table[k][i] = (prev >> 8) ^ base[prev & 0xFF];
+        }
+    }
+    return t;
+}
+
+template<>
+const crc_slice_table_t MbedCRC<POLY_32BIT_ANSI, 32, CrcMode::TABLE>::_crc_slice_table = make_crc32_slice_table();
+
+#endif // MBED_CRC_SLICE_TABLES
+
 } // namespace impl
 
 #endif // MBED_CRC_TABLE_SIZE > 0
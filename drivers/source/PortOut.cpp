@@ -21,6 +21,7 @@
 #if DEVICE_PORTOUT
 
 #include "platform/mbed_critical.h"
+#include "platform/mbed_power_mgmt.h"
 
 namespace mbed {
 
@@ -31,6 +32,73 @@ PortOut::PortOut(PortName port, int mask)
     core_util_critical_section_exit();
 }
 
+#if DEVICE_PORT_DMA
+PortOut::~PortOut()
+{
+    abort_burst();
+}
+
+uint32_t PortOut::burst_frequency(uint32_t frequency)
+{
+    return port_dma_frequency(&_port, frequency);
+}
+
+int PortOut::write_burst(Span<const uint32_t> values, uint32_t frequency, Callback<void()> callback)
+{
+    int ret = -1;
+    core_util_critical_section_enter();
+    if (!_burst_sleep_locked) {
+        _burst_callback = callback;
+        // Timers driving the DMA stop in deep sleep
+        sleep_manager_lock_deep_sleep();
+        _burst_sleep_locked = true;
+        if (port_dma_write(&_port, values.data(), values.size(), frequency, &PortOut::burst_irq, reinterpret_cast<uint32_t>(this))) {
+            ret = 0;
+        } else {
+            sleep_manager_unlock_deep_sleep();
+            _burst_sleep_locked = false;
+        }
+    }
+    core_util_critical_section_exit();
+    return ret;
+}
+
+bool PortOut::burst_active()
+{
+    core_util_critical_section_enter();
+    bool active = port_dma_active(&_port);
+    core_util_critical_section_exit();
+    return active;
+}
+
+void PortOut::abort_burst()
+{
+    core_util_critical_section_enter();
+    port_dma_stop(&_port);
+    if (_burst_sleep_locked) {
+        sleep_manager_unlock_deep_sleep();
+        _burst_sleep_locked = false;
+    }
+    core_util_critical_section_exit();
+}
+
+void PortOut::burst_irq(uint32_t id)
+{
+    reinterpret_cast<PortOut *>(id)->burst_done();
+}
+
+void PortOut::burst_done()
+{
+    if (_burst_sleep_locked) {
+        sleep_manager_unlock_deep_sleep();
+        _burst_sleep_locked = false;
+    }
+    if (_burst_callback) {
+        _burst_callback();
+    }
+}
+#endif
+
 } // namespace mbed
 
 #endif // #if DEVICE_PORTOUT
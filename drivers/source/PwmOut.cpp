@@ -143,6 +143,71 @@ void PwmOut::resume()
     core_util_critical_section_exit();
 }
 
+#if DEVICE_CLOCK_SCALING
+void PwmOut::clock_changed(ClockManager::event_t event)
+{
+    core_util_critical_section_enter();
+    if (_initialized) {
+        if (event == ClockManager::CLOCK_WILL_CHANGE) {
+            // Read while the registers still match the old clock
+            _duty_cycle = PwmOut::read();
+            _period_us = PwmOut::read_period_us();
+        } else {
+            PwmOut::period_us(_period_us);
+            PwmOut::write(_duty_cycle);
+        }
+    }
+    core_util_critical_section_exit();
+}
+#endif
+
+#if DEVICE_PWMOUT_DMA
+uint32_t PwmOut::sequence_period_ticks()
+{
+    core_util_critical_section_enter();
+    uint32_t ticks = pwmout_dma_period_ticks(&_pwm);
+    core_util_critical_section_exit();
+    return ticks;
+}
+
+int PwmOut::write_sequence(Span<const uint16_t> pulses, Callback<void()> callback)
+{
+    int ret = -1;
+    core_util_critical_section_enter();
+    if (!pwmout_dma_active(&_pwm)) {
+        _sequence_callback = callback;
+        if (pwmout_dma_start(&_pwm, pulses.data(), pulses.size(), &PwmOut::sequence_irq, reinterpret_cast<uint32_t>(this))) {
+            ret = 0;
+        }
+    }
+    core_util_critical_section_exit();
+    return ret;
+}
+
+bool PwmOut::sequence_active()
+{
+    core_util_critical_section_enter();
+    bool active = pwmout_dma_active(&_pwm);
+    core_util_critical_section_exit();
+    return active;
+}
+
+void PwmOut::abort_sequence()
+{
+    core_util_critical_section_enter();
+    pwmout_dma_stop(&_pwm);
+    core_util_critical_section_exit();
+}
+
+void PwmOut::sequence_irq(uint32_t id)
+{
+    PwmOut *handler = reinterpret_cast<PwmOut *>(id);
+    if (handler->_sequence_callback) {
+        handler->_sequence_callback();
+    }
+}
+#endif
+
 void PwmOut::lock_deep_sleep()
 {
     if (_deep_sleep_locked == false) {
@@ -177,6 +242,9 @@ void PwmOut::deinit()
     core_util_critical_section_enter();
 
     if (_initialized) {
+#if DEVICE_PWMOUT_DMA
+        pwmout_dma_stop(&_pwm);
+#endif
         pwmout_free(&_pwm);
         unlock_deep_sleep();
         _initialized = false;
@@ -255,6 +255,47 @@ qspi_status_t QSPI::command_transfer(qspi_inst_t instruction, int address, const
     return ret_status;
 }
 
+#if DEVICE_QSPI_MEMORY_MAPPED
+qspi_status_t QSPI::memory_mapped_enter(qspi_inst_t instruction, int alt, const void **address)
+{
+    qspi_status_t ret_status = QSPI_STATUS_ERROR;
+
+    if (_initialized) {
+        if (address != NULL) {
+            lock();
+            if (true == _acquire()) {
+                _build_qspi_command(instruction, 0, alt);
+                if (QSPI_STATUS_OK == qspi_memory_mapped_enter(&_qspi, &_qspi_command, address)) {
+                    ret_status = QSPI_STATUS_OK;
+                }
+            }
+            unlock();
+        } else {
+            ret_status = QSPI_STATUS_INVALID_PARAMETER;
+        }
+    }
+
+    return ret_status;
+}
+
+qspi_status_t QSPI::memory_mapped_exit()
+{
+    qspi_status_t ret_status = QSPI_STATUS_ERROR;
+
+    if (_initialized) {
+        lock();
+        if (true == _acquire()) {
+            if (QSPI_STATUS_OK == qspi_memory_mapped_exit(&_qspi)) {
+                ret_status = QSPI_STATUS_OK;
+            }
+        }
+        unlock();
+    }
+
+    return ret_status;
+}
+#endif
+
 void QSPI::lock()
 {
     _mutex->lock();
@@ -120,6 +120,11 @@ void SPI::_do_construct()
 #if DEVICE_SPI_ASYNCH
     _usage = DMA_USAGE_NEVER;
     _deep_sleep_locked = false;
+    _segments = NULL;
+    _segments_left = 0;
+    _segment_width = 8;
+    _segment_event = 0;
+    _cs_held = false;
 #endif
     _select_count = 0;
     _bits = 8;
@@ -218,6 +223,20 @@ void SPI::_acquire()
     }
 }
 
+#if DEVICE_CLOCK_SCALING
+void SPI::_clock_changed(ClockManager::event_t event)
+{
+    if (event == ClockManager::CLOCK_CHANGED) {
+        lock();
+        // Other users of the peripheral set their frequency when acquiring it
+        if (_peripheral->owner == this) {
+            spi_frequency(&_peripheral->spi, _hz);
+        }
+        unlock();
+    }
+}
+#endif
+
 int SPI::write(int value)
 {
     select();
@@ -287,8 +306,38 @@ int SPI::transfer(const void *tx_buffer, int tx_length, void *rx_buffer, int rx_
     return 0;
 }
 
+int SPI::transfer_segments(const Segment *segments, int count, unsigned char bit_width, const event_callback_t &callback, int event)
+{
+    if (count <= 0) {
+        return -1;
+    }
+    if (count > 1 && _hw_ssel != NC) {
+        spi_capabilities_t cap = {};
+        spi_get_capabilities(_hw_ssel, false, &cap);
+        if (cap.hw_cs_handle && !cap.hw_cs_hold) {
+            // The hardware would release chip select between the segments
+            return -1;
+        }
+    }
+    if (spi_active(&_peripheral->spi)) {
+#if TRANSACTION_QUEUE_SIZE_SPI
+        transaction_t t = {};
+        t.event = event;
+        t.callback = callback;
+        t.width = bit_width;
+        return queue_transaction(t, segments, count);
+#else
+        return -1;
+#endif
+    }
+    start_segments(segments, count, bit_width, callback, event);
+    return 0;
+}
+
 void SPI::abort_transfer()
 {
+    _segments_left = 0;
+    release_cs_hold();
     spi_abort_asynch(&_peripheral->spi);
     unlock_deep_sleep();
 #if TRANSACTION_QUEUE_SIZE_SPI
@@ -330,18 +379,7 @@ int SPI::queue_transfer(const void *tx_buffer, int tx_length, void *rx_buffer, i
     t.event = event;
     t.callback = callback;
     t.width = bit_width;
-    Transaction<SPI> transaction(this, t);
-    if (_peripheral->transaction_buffer->full()) {
-        return -1; // the buffer is full
-    } else {
-        core_util_critical_section_enter();
-        _peripheral->transaction_buffer->push(transaction);
-        if (!spi_active(&_peripheral->spi)) {
-            dequeue_transaction();
-        }
-        core_util_critical_section_exit();
-        return 0;
-    }
+    return queue_transaction(t, NULL, 0);
 #else
     return -1;
 #endif
@@ -357,6 +395,49 @@ void SPI::start_transfer(const void *tx_buffer, int tx_length, void *rx_buffer,
     spi_master_transfer(&_peripheral->spi, tx_buffer, tx_length, rx_buffer, rx_length, bit_width, _irq.entry(), event, _usage);
 }
 
+void SPI::start_segments(const Segment *segments, int count, unsigned char bit_width, const event_callback_t &callback, int event)
+{
+    _segments = segments + 1;
+    _segments_left = count - 1;
+    _segment_width = bit_width;
+    _segment_event = event;
+
+    // Every segment but the last one reports all the events, so that an
+    // error stops the transfer
+    int first_event = event;
+    if (_segments_left) {
+        first_event = SPI_EVENT_ALL;
+        if (_hw_ssel != NC) {
+            _acquire();
+            spi_master_cs_hold(&_peripheral->spi, true);
+            _cs_held = true;
+        }
+    }
+    start_transfer(segments->tx_buffer, segments->tx_length, segments->rx_buffer, segments->rx_length, bit_width, callback, first_event);
+}
+
+void SPI::start_next_segment()
+{
+    const Segment *segment = _segments++;
+    _segments_left--;
+
+    int event = SPI_EVENT_ALL;
+    if (_segments_left == 0) {
+        // chip select is released at the end of the last segment
+        release_cs_hold();
+        event = _segment_event;
+    }
+    spi_master_transfer(&_peripheral->spi, segment->tx_buffer, segment->tx_length, segment->rx_buffer, segment->rx_length, _segment_width, _irq.entry(), event, _usage);
+}
+
+void SPI::release_cs_hold()
+{
+    if (_cs_held) {
+        spi_master_cs_hold(&_peripheral->spi, false);
+        _cs_held = false;
+    }
+}
+
 void SPI::lock_deep_sleep()
 {
     if (_deep_sleep_locked == false) {
@@ -375,18 +456,41 @@ void SPI::unlock_deep_sleep()
 
 #if TRANSACTION_QUEUE_SIZE_SPI
 
-void SPI::start_transaction(transaction_t *data)
+int SPI::queue_transaction(const transaction_t &data, const Segment *segments, int count)
+{
+    spi_transaction_s t;
+    t.transaction = Transaction<SPI>(this, data);
+    t.segments = segments;
+    t.segment_count = count;
+    if (_peripheral->transaction_buffer->full()) {
+        return -1; // the buffer is full
+    } else {
+        core_util_critical_section_enter();
+        _peripheral->transaction_buffer->push(t);
+        if (!spi_active(&_peripheral->spi)) {
+            dequeue_transaction();
+        }
+        core_util_critical_section_exit();
+        return 0;
+    }
+}
+
+void SPI::start_transaction(transaction_t *data, const Segment *segments, int count)
 {
-    start_transfer(data->tx_buffer, data->tx_length, data->rx_buffer, data->rx_length, data->width, data->callback, data->event);
+    if (segments) {
+        start_segments(segments, count, data->width, data->callback, data->event);
+    } else {
+        start_transfer(data->tx_buffer, data->tx_length, data->rx_buffer, data->rx_length, data->width, data->callback, data->event);
+    }
 }
 
 void SPI::dequeue_transaction()
 {
-    Transaction<SPI> t;
+    spi_transaction_s t;
     if (_peripheral->transaction_buffer->pop(t)) {
-        SPI *obj = t.get_object();
-        transaction_t *data = t.get_transaction();
-        obj->start_transaction(data);
+        SPI *obj = t.transaction.get_object();
+        transaction_t *data = t.transaction.get_transaction();
+        obj->start_transaction(data, t.segments, t.segment_count);
     }
 }
 
@@ -395,8 +499,25 @@ void SPI::dequeue_transaction()
 void SPI::irq_handler_asynch(void)
 {
     int event = spi_irq_handler_asynch(&_peripheral->spi);
+    if (_segments_left && (event & SPI_EVENT_INTERNAL_TRANSFER_COMPLETE)) {
+        if (!(event & (SPI_EVENT_ERROR | SPI_EVENT_RX_OVERFLOW))) {
+            // Go on with the next segment straight away, chip select stays asserted
+            start_next_segment();
+            return;
+        }
+        // A failed segment ends the transfer
+        _segments_left = 0;
+        if (_cs_held) {
+            release_cs_hold();
+            spi_abort_asynch(&_peripheral->spi);
+        }
+        event &= _segment_event | SPI_EVENT_INTERNAL_TRANSFER_COMPLETE;
+    }
     if (_callback && (event & SPI_EVENT_ALL)) {
-        _set_ssel(1);
+        // Keep chip select asserted if the transfer is part of a select()/deselect() transaction
+        if (_select_count == 0) {
+            _set_ssel(1);
+        }
         unlock_deep_sleep();
         _callback.call(event & SPI_EVENT_ALL);
     }
@@ -17,11 +17,24 @@
 #include "drivers/SPISlave.h"
 #include "mbed_assert.h"
 
+#if DEVICE_SPI_ASYNCH
+#include "platform/mbed_critical.h"
+#include "platform/mbed_power_mgmt.h"
+#endif
+
 #if DEVICE_SPISLAVE
 
 namespace mbed {
 
 SPISlave::SPISlave(PinName mosi, PinName miso, PinName sclk, PinName ssel) :
+#if DEVICE_SPI_ASYNCH
+    _irq(this),
+    _current(),
+    _next(),
+    _active(false),
+    _next_pending(false),
+    _usage(DMA_USAGE_OPPORTUNISTIC),
+#endif
     _spi(),
     _bits(8),
     _mode(0),
@@ -33,6 +46,14 @@ SPISlave::SPISlave(PinName mosi, PinName miso, PinName sclk, PinName ssel) :
 }
 
 SPISlave::SPISlave(const spi_pinmap_t &pinmap) :
+#if DEVICE_SPI_ASYNCH
+    _irq(this),
+    _current(),
+    _next(),
+    _active(false),
+    _next_pending(false),
+    _usage(DMA_USAGE_OPPORTUNISTIC),
+#endif
     _spi(),
     _bits(8),
     _mode(0),
@@ -71,6 +92,94 @@ void SPISlave::reply(int value)
     spi_slave_write(&_spi, value);
 }
 
+#if DEVICE_SPI_ASYNCH
+
+int SPISlave::transfer(const void *tx_buffer, int tx_length, void *rx_buffer, int rx_length, unsigned char bit_width, const event_callback_t &callback, int event)
+{
+    transfer_t t = { tx_buffer, tx_length, rx_buffer, rx_length, bit_width, callback, event };
+    int ret = 0;
+
+    core_util_critical_section_enter();
+    if (!_active) {
+        sleep_manager_lock_deep_sleep();
+        if (!start_transfer(t)) {
+            sleep_manager_unlock_deep_sleep();
+            ret = -1;
+        }
+    } else if (!_next_pending) {
+        _next = t;
+        _next_pending = true;
+    } else {
+        ret = -1;
+    }
+    core_util_critical_section_exit();
+
+    return ret;
+}
+
+void SPISlave::abort_transfer()
+{
+    core_util_critical_section_enter();
+    if (_active) {
+        spi_abort_asynch(&_spi);
+        _active = false;
+        _next_pending = false;
+        sleep_manager_unlock_deep_sleep();
+    }
+    core_util_critical_section_exit();
+}
+
+int SPISlave::set_dma_usage(DMAUsage usage)
+{
+    if (_active) {
+        return -1;
+    }
+    _usage = usage;
+    return 0;
+}
+
+bool SPISlave::start_transfer(const transfer_t &t)
+{
+    _current = t;
+    _irq.callback(&SPISlave::irq_handler_asynch);
+    _active = spi_slave_transfer(&_spi, t.tx_buffer, t.tx_length, t.rx_buffer, t.rx_length, t.width, _irq.entry(), t.event, _usage);
+    return _active;
+}
+
+void SPISlave::irq_handler_asynch(void)
+{
+    int event = spi_irq_handler_asynch(&_spi);
+    if (!(event & (SPI_EVENT_ALL | SPI_EVENT_INTERNAL_TRANSFER_COMPLETE))) {
+        return;
+    }
+
+    // Arm the next buffers before the callback, the master may already be
+    // clocking the next frame
+    event_callback_t callback = _current.callback;
+    event_callback_t failed;
+    if (_next_pending) {
+        _next_pending = false;
+        if (!start_transfer(_next) && (_next.event & SPI_EVENT_ERROR)) {
+            failed = _next.callback;
+        }
+    } else {
+        _active = false;
+    }
+    if (!_active) {
+        sleep_manager_unlock_deep_sleep();
+    }
+
+    if (callback && (event & SPI_EVENT_ALL)) {
+        callback.call(event & SPI_EVENT_ALL);
+    }
+    // The next transfer could not be armed, it ends with an error
+    if (failed) {
+        failed.call(SPI_EVENT_ERROR);
+    }
+}
+
+#endif // DEVICE_SPI_ASYNCH
+
 } // namespace mbed
 
 #endif
@@ -164,6 +164,20 @@ void SerialBase::_deinit()
     serial_free(&_serial);
 }
 
+#if DEVICE_CLOCK_SCALING
+void SerialBase::_clock_changed(ClockManager::event_t event)
+{
+    if (event == ClockManager::CLOCK_CHANGED) {
+        lock();
+        // A disabled port gets the baud rate when enabled again
+        if (_rx_enabled || _tx_enabled) {
+            serial_baud(&_serial, _baud);
+        }
+        unlock();
+    }
+}
+#endif
+
 void SerialBase::enable_input(bool enable)
 {
     lock();
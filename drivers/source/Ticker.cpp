@@ -68,6 +68,16 @@ void TickerBase::handler()
     }
 }
 
+void TickerBase::set_slack(microseconds slack)
+{
+    if (slack.count() < 0) {
+        slack = microseconds::zero();
+    } else if (slack.count() > UINT32_MAX) {
+        slack = microseconds(UINT32_MAX);
+    }
+    event.slack = slack.count();
+}
+
 void TickerBase::attach(Callback<void()> func, microseconds t)
 {
     CriticalSectionLock lock;
@@ -52,12 +52,13 @@ void TimerEvent::insert(microseconds rel_time)
 
 void TimerEvent::insert_absolute(us_timestamp_t timestamp)
 {
-    ticker_insert_event_us(_ticker_data, &event, timestamp, (uint32_t)this);
+    ticker_insert_event_us_slack(_ticker_data, &event, timestamp, (uint32_t)this, event.slack);
 }
 
 void TimerEvent::insert_absolute(TickerDataClock::time_point timestamp)
 {
-    _ticker_data.insert_event(&event, timestamp, (uint32_t)this);
+    // keep the slack set by TickerBase::set_slack()
+    _ticker_data.insert_event(&event, timestamp, (uint32_t)this, TickerDataClock::duration(event.slack));
 }
 
 void TimerEvent::remove()
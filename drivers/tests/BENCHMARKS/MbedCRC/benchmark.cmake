@@ -0,0 +1,17 @@
+
+####################
+# BENCHMARKS
+####################
+
+set(benchmark-sources
+  ../drivers/source/MbedCRC.cpp
+  stubs/mbed_critical_stub.c
+  stubs/mbed_assert_stub.cpp
+  ../drivers/tests/BENCHMARKS/MbedCRC/benchmark_MbedCRC.cpp
+)
+
+# Table size and slicing as set by drivers.crc-table-size and drivers.crc-slice-by
+set(benchmark-flags
+  -DMBED_CRC_TABLE_SIZE=256
+  -DMBED_CONF_DRIVERS_CRC_SLICE_BY=1
+)
@@ -0,0 +1,62 @@
+/* Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "benchmark/benchmark.h"
+#include "drivers/MbedCRC.h"
+#include <string.h>
+
+using namespace mbed;
+
+// Compute the CRC of a buffer, in the mode selected by the configuration (table by default)
+template <uint32_t polynomial, int width>
+static void BM_MbedCRC_compute(benchmark::State &state)
+{
+    MbedCRC<polynomial, width> crc;
+    uint8_t data[4096];
+    memset(data, 0x5A, sizeof(data));
+    uint32_t result;
+
+    for (auto _ : state) {
+        crc.compute(data, state.range(0), &result);
+        benchmark::DoNotOptimize(result);
+    }
+
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_MbedCRC_compute, POLY_32BIT_ANSI, 32)->Arg(16)->Arg(256)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_MbedCRC_compute, POLY_16BIT_CCITT, 16)->Arg(16)->Arg(256)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_MbedCRC_compute, POLY_8BIT_CCITT, 8)->Arg(16)->Arg(256)->Arg(4096);
+
+// Compute a CRC in chunks, with compute_partial
+static void BM_MbedCRC_partial(benchmark::State &state)
+{
+    MbedCRC<POLY_32BIT_ANSI, 32> crc;
+    uint8_t data[4096];
+    memset(data, 0x5A, sizeof(data));
+    uint32_t result;
+
+    for (auto _ : state) {
+        crc.compute_partial_start(&result);
+        for (size_t offset = 0; offset < sizeof(data); offset += state.range(0)) {
+            crc.compute_partial(data + offset, state.range(0), &result);
+        }
+        crc.compute_partial_stop(&result);
+        benchmark::DoNotOptimize(result);
+    }
+
+    state.SetBytesProcessed(state.iterations() * sizeof(data));
+}
+BENCHMARK(BM_MbedCRC_partial)->Arg(16)->Arg(256);
@@ -221,6 +221,39 @@ void test_any_polynomial()
     }
 }
 
+template<CrcMode mode>
+static uint32_t crc32_timed(const uint8_t *data, size_t size, uint32_t *crc)
+{
+    MbedCRC<POLY_32BIT_ANSI, 32, mode> ct(0xFFFFFFFF, 0, true, false);
+    Timer timer;
+
+    timer.start();
+    TEST_ASSERT_EQUAL(0, ct.compute(data, size, crc));
+    timer.stop();
+    return std::chrono::duration_cast<std::chrono::microseconds>(timer.elapsed_time()).count();
+}
+
+void test_crc32_benchmark()
+{
+    static uint8_t data[4096];
+    uint32_t crc_bitwise, crc_table, crc_default;
+
+    for (size_t i = 0; i < sizeof(data); i++) {
+        data[i] = i * 7 + (i >> 8);
+    }
+
+    uint32_t bitwise_us = crc32_timed<CrcMode::BITWISE>(data, sizeof(data), &crc_bitwise);
+    uint32_t table_us = crc32_timed<CrcMode::TABLE>(data, sizeof(data), &crc_table);
+    uint32_t default_us = crc32_timed<CrcMode::HARDWARE>(data, sizeof(data), &crc_default);
+
+    utest_printf("CRC32 of %u bytes: bitwise %lu us, table %lu us (%d entries, slice-by-%d), default mode %lu us\n",
+                 (unsigned) sizeof(data), (unsigned long) bitwise_us, (unsigned long) table_us,
+                 MBED_CRC_TABLE_SIZE, MBED_CONF_DRIVERS_CRC_SLICE_BY, (unsigned long) default_us);
+
+    TEST_ASSERT_EQUAL_HEX32(crc_bitwise, crc_table);
+    TEST_ASSERT_EQUAL_HEX32(crc_bitwise, crc_default);
+}
+
 void test_thread(void)
 {
     char  test[] = "123456789";
@@ -260,7 +293,8 @@ Case cases[] = {
 #if defined(MBED_CONF_RTOS_PRESENT)
     Case("Test thread safety", test_thread_safety),
 #endif
-    Case("Test not supported polynomials", test_any_polynomial)
+    Case("Test not supported polynomials", test_any_polynomial),
+    Case("Test CRC32 benchmark", test_crc32_benchmark)
 };
 
 utest::v1::status_t greentea_test_setup(const size_t number_of_cases)
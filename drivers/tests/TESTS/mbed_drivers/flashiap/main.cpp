@@ -190,6 +190,62 @@ void flashiap_cross_sector_program_test()
     TEST_ASSERT_EQUAL_INT32(0, ret);
 }
 
+void flashiap_stream_program_test()
+{
+    FlashIAP flash_device;
+    uint32_t ret = flash_device.init();
+    TEST_ASSERT_EQUAL_INT32(0, ret);
+
+    uint32_t sector_size = flash_device.get_sector_size(flash_device.get_flash_start() + flash_device.get_flash_size() - 1UL);
+    uint32_t page_size = flash_device.get_page_size();
+    uint8_t erase_value = flash_device.get_erase_value();
+    TEST_ASSERT_NOT_EQUAL(0, sector_size);
+    TEST_ASSERT_NOT_EQUAL(0, page_size);
+
+    uint32_t address = (flash_device.get_flash_start() + flash_device.get_flash_size()) - (sector_size);
+    utest_printf("ROM ends at 0x%lx, test starts at 0x%lx, bank size %lu, read while write %d\n",
+                 FLASHIAP_APP_ROM_END_ADDR, address, flash_device.get_bank_size(),
+                 flash_device.is_read_while_write(address, sector_size));
+    TEST_SKIP_UNLESS_MESSAGE(address >= FLASHIAP_APP_ROM_END_ADDR, "Test skipped. Test region overlaps code.");
+    TEST_ASSERT_FALSE(flash_device.is_read_while_write(flash_device.get_flash_start(), 1));
+
+    ret = flash_device.erase(address, sector_size);
+    TEST_ASSERT_EQUAL_INT32(0, ret);
+
+    // Feed the stream with chunks which do not line up with pages
+    uint32_t prog_size = std::min(sector_size, 4 * page_size) - 1;
+    uint8_t *data = new uint8_t[prog_size + 1];
+    for (uint32_t i = 0; i < prog_size; i++) {
+        data[i] = rand() % 256;
+    }
+    data[prog_size] = erase_value;
+
+    ret = flash_device.program_stream_start(address);
+    TEST_ASSERT_EQUAL_INT32(0, ret);
+    uint32_t offset = 0;
+    uint32_t chunk = 1;
+    while (offset < prog_size) {
+        chunk = std::min(chunk, prog_size - offset);
+        ret = flash_device.program_stream(data + offset, chunk);
+        TEST_ASSERT_EQUAL_INT32(0, ret);
+        offset += chunk;
+        chunk = chunk * 3 + 1;
+    }
+    ret = flash_device.program_stream_end();
+    TEST_ASSERT_EQUAL_INT32(0, ret);
+
+    uint8_t *data_flashed = new uint8_t[prog_size + 1];
+    ret = flash_device.read(data_flashed, address, prog_size + 1);
+    TEST_ASSERT_EQUAL_INT32(0, ret);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(data, data_flashed, prog_size + 1);
+
+    delete[] data;
+    delete[] data_flashed;
+
+    ret = flash_device.deinit();
+    TEST_ASSERT_EQUAL_INT32(0, ret);
+}
+
 void flashiap_program_error_test()
 {
     FlashIAP flash_device;
@@ -314,6 +370,7 @@ Case cases[] = {
     Case("FlashIAP - init", flashiap_init_test),
     Case("FlashIAP - program", flashiap_program_test),
     Case("FlashIAP - program across sectors", flashiap_cross_sector_program_test),
+    Case("FlashIAP - program stream", flashiap_stream_program_test),
     Case("FlashIAP - program errors", flashiap_program_error_test),
     Case("FlashIAP - timing", flashiap_timing_test),
 };
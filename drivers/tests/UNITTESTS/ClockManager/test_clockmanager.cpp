@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2021 Arm Limited and affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "gtest/gtest.h"
+#include "drivers/ClockManager.h"
+
+#include <vector>
+
+using namespace mbed;
+
+class Recorder {
+public:
+    Recorder() : listener(callback(this, &Recorder::on_event))
+    {
+    }
+
+    void on_event(ClockManager::event_t event)
+    {
+        events.push_back(event);
+        levels.push_back(ClockManager::get_level());
+    }
+
+    std::vector<ClockManager::event_t> events;
+    std::vector<int> levels;
+    ClockManager::Listener listener;
+};
+
+// AStyle ignored as the definition is not clear due to preprocessor usage
+// *INDENT-OFF*
+class TestClockManager : public testing::Test {
+protected:
+
+    void SetUp()
+    {
+        ClockManager::set_level(0);
+    }
+
+    void TearDown()
+    {
+        ClockManager::set_level(0);
+    }
+};
+// *INDENT-ON*
+
+TEST_F(TestClockManager, test_clockmanager_levels)
+{
+    EXPECT_EQ(3, ClockManager::level_count());
+    EXPECT_EQ(80000000U, ClockManager::frequency(0));
+    EXPECT_EQ(20000000U, ClockManager::frequency(2));
+    EXPECT_EQ(0U, ClockManager::frequency(3));
+    EXPECT_EQ(0U, ClockManager::frequency(-1));
+}
+
+TEST_F(TestClockManager, test_clockmanager_set_level)
+{
+    EXPECT_EQ(0, ClockManager::set_level(2));
+    EXPECT_EQ(2, ClockManager::get_level());
+    EXPECT_EQ(-1, ClockManager::set_level(3));
+    EXPECT_EQ(-1, ClockManager::set_level(-1));
+    EXPECT_EQ(2, ClockManager::get_level());
+}
+
+TEST_F(TestClockManager, test_clockmanager_notify)
+{
+    Recorder recorder;
+
+    EXPECT_EQ(0, ClockManager::set_level(1));
+    ASSERT_EQ(2U, recorder.events.size());
+    EXPECT_EQ(ClockManager::CLOCK_WILL_CHANGE, recorder.events[0]);
+    EXPECT_EQ(0, recorder.levels[0]);
+    EXPECT_EQ(ClockManager::CLOCK_CHANGED, recorder.events[1]);
+    EXPECT_EQ(1, recorder.levels[1]);
+
+    // Neither the current level nor an invalid one notifies
+    EXPECT_EQ(0, ClockManager::set_level(1));
+    EXPECT_EQ(-1, ClockManager::set_level(5));
+    EXPECT_EQ(2U, recorder.events.size());
+}
+
+TEST_F(TestClockManager, test_clockmanager_unregister)
+{
+    Recorder first;
+    Recorder *second = new Recorder;
+    Recorder third;
+
+    ClockManager::set_level(1);
+    EXPECT_EQ(2U, first.events.size());
+    EXPECT_EQ(2U, second->events.size());
+    EXPECT_EQ(2U, third.events.size());
+
+    delete second;
+    ClockManager::set_level(2);
+    EXPECT_EQ(4U, first.events.size());
+    EXPECT_EQ(4U, third.events.size());
+}
@@ -0,0 +1,28 @@
+
+####################
+# UNIT TESTS
+####################
+set(TEST_SUITE_NAME "ClockManager")
+
+# Add test specific include paths
+set(unittest-includes ${unittest-includes}
+  .
+  ../hal
+)
+
+# Source files
+set(unittest-sources
+  ../drivers/source/ClockManager.cpp
+)
+
+# Test files
+set(unittest-test-sources
+  ../drivers/tests/UNITTESTS/ClockManager/test_clockmanager.cpp
+  stubs/mbed_critical_stub.c
+  stubs/mbed_assert_stub.cpp
+  stubs/clock_scaling_api_stub.c
+)
+
+set(unittest-test-flags
+  -DDEVICE_CLOCK_SCALING
+)
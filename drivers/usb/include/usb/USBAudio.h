@@ -28,6 +28,17 @@
 #include "ByteBuffer.h"
 #include "rtos/EventFlags.h"
 
+/**
+ * Use an asynchronous isochronous OUT endpoint with an explicit feedback
+ * endpoint. The device then sets the rate at which the host sends samples,
+ * from the fill level of the read buffer, so a drift between the host and
+ * the device clocks does not end in overflows or underflows. It needs one
+ * more isochronous IN endpoint.
+ */
+#ifndef MBED_CONF_USB_AUDIO_FEEDBACK
+#define MBED_CONF_USB_AUDIO_FEEDBACK 0
+#endif
+
 /** \defgroup drivers-public-api-usb USB
  * \ingroup drivers-public-api
  */
@@ -84,15 +95,17 @@ public:
     *
     * @param connect Call connect on initialization
     * @param frequency_rx frequency in Hz (default: 48000)
-    * @param channel_count_rx channel number (1 or 2) (default: 1)
+    * @param channel_count_rx channel number (1 to 8) (default: 1)
     * @param frequency_tx frequency in Hz (default: 8000)
-    * @param channel_count_tx channel number (1 or 2) (default: 1)
+    * @param channel_count_tx channel number (1 to 8) (default: 1)
     * @param buffer_ms time audio can be buffered without overflowing in milliseconds
     * @param vendor_id Your vendor_id
     * @param product_id Your product_id
     * @param product_release Your product_release
+    * @param sample_size bytes per sample, 2 for 16-bit or 3 for 24-bit
+    * little endian PCM, in both directions (default: 2)
     */
-    USBAudio(bool connect = true, uint32_t frequency_rx = 48000, uint8_t channel_count_rx = 1, uint32_t frequency_tx = 8000, uint8_t channel_count_tx = 1, uint32_t buffer_ms = 10, uint16_t vendor_id = 0x7bb8, uint16_t product_id = 0x1111, uint16_t product_release = 0x0100);
+    USBAudio(bool connect = true, uint32_t frequency_rx = 48000, uint8_t channel_count_rx = 1, uint32_t frequency_tx = 8000, uint8_t channel_count_tx = 1, uint32_t buffer_ms = 10, uint16_t vendor_id = 0x7bb8, uint16_t product_id = 0x1111, uint16_t product_release = 0x0100, uint8_t sample_size = 2);
 
     /**
     * Fully featured constructor
@@ -107,15 +120,17 @@ public:
     *
     * @param phy USB phy to use
     * @param frequency_rx frequency in Hz (default: 48000)
-    * @param channel_count_rx channel number (1 or 2) (default: 1)
+    * @param channel_count_rx channel number (1 to 8) (default: 1)
     * @param frequency_tx frequency in Hz (default: 8000)
-    * @param channel_count_tx channel number (1 or 2) (default: 1)
+    * @param channel_count_tx channel number (1 to 8) (default: 1)
     * @param buffer_ms time audio can be buffered without overflowing in milliseconds
     * @param vendor_id Your vendor_id
     * @param product_id Your product_id
     * @param product_release Your product_release
+    * @param sample_size bytes per sample, 2 for 16-bit or 3 for 24-bit
+    * little endian PCM, in both directions (default: 2)
     */
-    USBAudio(USBPhy *phy, uint32_t frequency_rx, uint8_t channel_count_rx, uint32_t frequency_tx, uint8_t channel_count_tx, uint32_t buffer_ms, uint16_t vendor_id, uint16_t product_id, uint16_t product_release);
+    USBAudio(USBPhy *phy, uint32_t frequency_rx, uint8_t channel_count_rx, uint32_t frequency_tx, uint8_t channel_count_tx, uint32_t buffer_ms, uint16_t vendor_id, uint16_t product_id, uint16_t product_release, uint8_t sample_size = 2);
 
     /**
      * Destroy this object
@@ -156,6 +171,8 @@ public:
     * @param size size to read
     * @param actual size actually read
     * @note This function is safe to call from USBAudio callbacks.
+    * @note The read buffer is shared with the interrupt handler without
+    * locking, so only one thread may read at a time.
     */
     void read_nb(uint8_t *buf, uint32_t size, uint32_t *actual);
 
@@ -198,6 +215,8 @@ public:
     * @param size size to write
     * @param actual actual size written
     * @note This function is safe to call from USBAudio callbacks.
+    * @note The write buffer is shared with the interrupt handler without
+    * locking, so only one thread may write at a time.
     */
     void write_nb(uint8_t *buf, uint32_t size, uint32_t *actual);
 
@@ -273,7 +292,7 @@ private:
         Opened
     };
 
-    void _init(uint32_t frequency_rx, uint8_t channel_count_rx, uint32_t frequency_tx, uint8_t channel_count_tx, uint32_t buffer_ms);
+    void _init(uint32_t frequency_rx, uint8_t channel_count_rx, uint32_t frequency_tx, uint8_t channel_count_tx, uint32_t buffer_ms, uint8_t sample_size);
 
     /*
     * Call to rebuild the configuration descriptor
@@ -292,6 +311,10 @@ private:
     void _send_isr_start();
     void _send_isr_next_sync();
     void _send_isr();
+#if MBED_CONF_USB_AUDIO_FEEDBACK
+    void _feedback_isr_next();
+    void _feedback_isr();
+#endif
 
     // has connect been called
     bool _connected;
@@ -337,6 +360,9 @@ private:
     uint8_t _rx_channel_count;
     uint8_t _tx_channel_count;
 
+    // bytes per sample
+    uint8_t _sample_size;
+
     bool _tx_idle;
     uint16_t _tx_frame_fract;
     uint16_t _tx_whole_frames_per_xfer;
@@ -371,13 +397,22 @@ private:
     // endpoint numbers
     usb_ep_t _episo_out;    // rx endpoint
     usb_ep_t _episo_in;     // tx endpoint
+#if MBED_CONF_USB_AUDIO_FEEDBACK
+    usb_ep_t _episo_fb;     // rx feedback endpoint
+
+    // rx rate sent to the host, in 10.14 fixed point frames per millisecond
+    bool _fb_idle;
+    uint32_t _fb_nominal;
+    uint32_t _fb_target;    // rx buffer fill aimed at, in bytes
+    uint8_t _fb_buf[3];
+#endif
 
     // channel config in the configuration descriptor: master, left, right
     uint16_t _channel_config_rx;
     uint16_t _channel_config_tx;
 
     // configuration descriptor
-    uint8_t _config_descriptor[183];
+    uint8_t _config_descriptor[183 + (MBED_CONF_USB_AUDIO_FEEDBACK ? 9 : 0)];
 
     // buffer for control requests
     uint8_t _control_receive[2];
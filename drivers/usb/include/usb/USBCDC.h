@@ -104,6 +104,9 @@ public:
     /**
      * Send what there is room for
      *
+     * Data can be added while the previous packet is being sent, it goes out
+     * in the next packet as soon as the previous one is done.
+     *
      * @param buffer data to send
      * @param size maximum number of bytes to send
      * @param actual a pointer to where to store the number of bytes sent
@@ -219,17 +222,25 @@ protected:
     OperationList<AsyncWait> _connected_list;
     bool _terminal_connected;
 
+    /*
+     * Both directions are double buffered, so the next packet is ready in
+     * one buffer while the other is on the bus
+     */
+
     OperationList<AsyncWrite> _tx_list;
     bool _tx_in_progress;
-    uint8_t _tx_buffer[CDC_MAX_PACKET_SIZE];
-    uint8_t *_tx_buf;
-    uint32_t _tx_size;
+    uint8_t _tx_buffer[2][CDC_MAX_PACKET_SIZE];
+    uint8_t _tx_fill;           // buffer being filled, the other one is in flight
+    uint32_t _tx_size;          // bytes in the buffer being filled
 
     OperationList<AsyncRead> _rx_list;
     bool _rx_in_progress;
-    uint8_t _rx_buffer[CDC_MAX_PACKET_SIZE];
+    uint8_t _rx_buffer[2][CDC_MAX_PACKET_SIZE];
+    uint32_t _rx_sizes[2];
+    uint8_t _rx_head;           // buffer being read from
+    uint8_t _rx_count;          // buffers holding received data
     uint8_t *_rx_buf;
-    uint32_t _rx_size;
+    uint32_t _rx_size;          // bytes left in the buffer being read from
 };
 
 /** @}*/
@@ -254,6 +254,12 @@ private:
     uint8_t _string_imac_addr[26];
 
     uint8_t _bulk_buf[MAX_PACKET_SIZE_BULK];
+
+    // frame being sent, the packets are started from the bulk IN callback
+    uint8_t *_tx_buf;
+    uint32_t _tx_remaining;
+    bool _tx_zlp;
+
     uint16_t _packet_filter;
     ByteBuffer _rx_queue;
 
@@ -271,7 +277,7 @@ private:
     void _bulk_out_callback();
     bool _notify_network_connection(uint8_t value);
     bool _notify_connection_speed_change(uint32_t up, uint32_t down);
-    bool _write_bulk(uint8_t *buffer, uint32_t size);
+    bool _write_next_packet();
     void _notify_connect();
 };
 
@@ -25,6 +25,23 @@
 #include "USBHID_Types.h"
 #include "OperationList.h"
 
+/**
+ * Number of input reports queued for the interrupt IN endpoint, including
+ * the one being transferred.
+ */
+#ifndef MBED_CONF_USB_HID_REPORT_QUEUE_SIZE
+#define MBED_CONF_USB_HID_REPORT_QUEUE_SIZE 4
+#endif
+
+/**
+ * bInterval of the USBHID interrupt endpoints. On a full speed PHY it is the
+ * polling period in frames of 1 ms. On a high speed PHY the period is
+ * 2^(bInterval-1) microframes of 125 us, so 1 polls 8 times per ms.
+ */
+#ifndef MBED_CONF_USB_HID_INTERVAL
+#define MBED_CONF_USB_HID_INTERVAL 1
+#endif
+
 /**
  * \defgroup drivers_USBHID USBHID class
  * \ingroup drivers-public-api-usb
@@ -112,6 +129,8 @@ public:
     /**
     * Send a Report. warning: blocking
     *
+    * Blocks until the report fits in the queue, not until it is sent.
+    *
     * @param report Report which will be sent (a report is defined by all data and the length)
     * @returns true if successful
     */
@@ -121,8 +140,14 @@ public:
     /**
     * Send a Report. warning: non blocking
     *
+    * The report is copied in a queue of MBED_CONF_USB_HID_REPORT_QUEUE_SIZE
+    * reports. The endpoint ISR starts the next one as soon as the previous
+    * one completes, so a report goes out in each polling interval while the
+    * queue is not empty.
+    *
     * @param report Report which will be sent (a report is defined by all data and the length)
-    * @returns true if successful
+    * @returns true if successful, false if the queue is full or the device
+    * is not configured
     */
     bool send_nb(const HID_REPORT *report);
 
@@ -240,7 +265,7 @@ protected:
     virtual void report_rx() {}
 
     /*
-     * Called when there is space to send a hid report
+     * Called when there is space in the queue to send a hid report
      */
     virtual void report_tx() {}
 
@@ -259,12 +284,14 @@ private:
 
     OperationList<AsyncWait> _connect_list;
     OperationList<AsyncSend> _send_list;
-    bool _send_idle;
+    // the first report of the queue is being transferred
+    HID_REPORT _send_queue[MBED_CONF_USB_HID_REPORT_QUEUE_SIZE];
+    uint8_t _send_head;
+    uint8_t _send_count;
     OperationList<AsyncRead> _read_list;
     bool _read_idle;
 
     uint8_t _configuration_descriptor[41];
-    HID_REPORT _input_report;
     HID_REPORT _output_report;
     uint8_t _output_length;
     uint8_t _input_length;
@@ -29,6 +29,14 @@
 
 #include "USBDevice.h"
 
+/**
+ * Number of blocks read or written to the BlockDevice at once. The page is
+ * allocated with fewer blocks if the heap can't hold that many.
+ */
+#ifndef MBED_CONF_USB_MSD_PAGE_BLOCKS
+#define MBED_CONF_USB_MSD_PAGE_BLOCKS   4
+#endif
+
 /**
  * \defgroup drivers_USBMSD USBMSD class
  * \ingroup drivers-public-api-usb
@@ -242,6 +250,11 @@ private:
     // cache in RAM before writing in memory. Useful also to read a block.
     uint8_t *_page;
 
+    // blocks the page holds, and the run of the current transfer it holds
+    uint32_t _page_blocks;
+    uint32_t _page_addr;
+    uint32_t _page_length;
+
     int _block_size;
     uint64_t _memory_size;
     uint64_t _block_count;
@@ -301,6 +314,7 @@ private:
     bool readCapacity(void);
     bool infoTransfer(void);
     void memoryRead(void);
+    void memoryReadPage(void);
     bool modeSense6(void);
     bool modeSense10(void);
     void testUnitReady(void);
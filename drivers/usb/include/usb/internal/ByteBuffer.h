@@ -25,6 +25,14 @@
  * \ingroup drivers-internal-api-usb
  * @{
  */
+
+/**
+ * Circular buffer of bytes
+ *
+ * One writer (push, write) and one reader (pop, read) can use the buffer
+ * at the same time without a lock, for instance a thread and an interrupt
+ * handler. resize must not run concurrently with anything else.
+ */
 class ByteBuffer {
 public:
 
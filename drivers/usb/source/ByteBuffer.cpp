@@ -17,11 +17,16 @@
 
 #include "ByteBuffer.h"
 #include "mbed_assert.h"
+#include "platform/mbed_atomic.h"
 #include <string.h>
 
+// The reader only updates _head and the writer only updates _tail. Each side
+// publishes its index with a barrier once the data is copied, and loads the
+// index of the other side with a barrier before touching the data.
+
 ByteBuffer::ByteBuffer(uint32_t size): _head(0), _tail(0), _size(0), _buf(NULL)
 {
-    resize(_size);
+    resize(size);
 }
 
 ByteBuffer::~ByteBuffer()
@@ -41,13 +46,15 @@ void ByteBuffer::resize(uint32_t size)
 
 void ByteBuffer::push(uint8_t data)
 {
-    _buf[_tail] = data;
-    _tail++;
-    if (_tail >= _size) {
-        _tail -= _size;
+    uint32_t tail = _tail;
+    _buf[tail] = data;
+    tail++;
+    if (tail >= _size) {
+        tail -= _size;
     }
     // Overflow not allowed
-    MBED_ASSERT(_head != _tail);
+    MBED_ASSERT(core_util_atomic_load_u32(&_head) != tail);
+    core_util_atomic_store_u32(&_tail, tail);
 }
 
 void ByteBuffer::write(uint8_t *data, uint32_t size)
@@ -58,15 +65,16 @@ void ByteBuffer::write(uint8_t *data, uint32_t size)
         return;
     }
 
-    uint32_t new_tail = _tail + size;
+    uint32_t tail = _tail;
+    uint32_t new_tail = tail + size;
     if (new_tail >= _size) {
         new_tail -= _size;
     }
 
     // Perform first memcpy
-    uint32_t until_end = _size - _tail;
+    uint32_t until_end = _size - tail;
     uint32_t copy_size = until_end < size ? until_end : size;
-    memcpy(_buf + _tail, data, copy_size);
+    memcpy(_buf + tail, data, copy_size);
     data += copy_size;
     size -= copy_size;
 
@@ -76,18 +84,20 @@ void ByteBuffer::write(uint8_t *data, uint32_t size)
     }
 
     // Update tail
-    _tail = new_tail;
+    core_util_atomic_store_u32(&_tail, new_tail);
 }
 
 uint8_t ByteBuffer::pop()
 {
+    uint32_t head = _head;
     // Underflow not allowed
-    MBED_ASSERT(_head != _tail);
-    uint8_t val = _buf[_head];
-    _head++;
-    if (_head >= _size) {
-        _head -= _size;
+    MBED_ASSERT(head != core_util_atomic_load_u32(&_tail));
+    uint8_t val = _buf[head];
+    head++;
+    if (head >= _size) {
+        head -= _size;
     }
+    core_util_atomic_store_u32(&_head, head);
     return val;
 }
 
@@ -99,15 +109,16 @@ void ByteBuffer::read(uint8_t *data, uint32_t size)
         return;
     }
 
-    uint32_t new_head = _head + size;
+    uint32_t head = _head;
+    uint32_t new_head = head + size;
     if (new_head >= _size) {
         new_head -= _size;
     }
 
     // Perform first memcpy
-    uint32_t until_end = _size - _head;
+    uint32_t until_end = _size - head;
     uint32_t copy_size = until_end < size ? until_end : size;
-    memcpy(data, _buf + _head, copy_size);
+    memcpy(data, _buf + head, copy_size);
     data += copy_size;
     size -= copy_size;
 
@@ -117,16 +128,18 @@ void ByteBuffer::read(uint8_t *data, uint32_t size)
     }
 
     // Update head
-    _head = new_head;
+    core_util_atomic_store_u32(&_head, new_head);
 }
 
 uint32_t ByteBuffer::size()
 {
+    uint32_t head = core_util_atomic_load_u32(&_head);
+    uint32_t tail = core_util_atomic_load_u32(&_tail);
     uint32_t size;
-    if (_tail < _head) {
-        size = _size + _tail - _head;
+    if (tail < head) {
+        size = _size + tail - head;
     } else {
-        size = _tail - _head;
+        size = tail - head;
     }
     return size;
 }
@@ -138,14 +151,14 @@ uint32_t ByteBuffer::free()
 
 bool ByteBuffer::full()
 {
-    uint32_t next = _tail + 1;
+    uint32_t next = core_util_atomic_load_u32(&_tail) + 1;
     if (next >= _size) {
         next -= _size;
     }
-    return next == _head;
+    return next == core_util_atomic_load_u32(&_head);
 }
 
 bool ByteBuffer::empty()
 {
-    return _head == _tail;
+    return core_util_atomic_load_u32(&_head) == core_util_atomic_load_u32(&_tail);
 }
@@ -22,8 +22,9 @@
 #include "EndpointResolver.h"
 #include "usb_phy_api.h"
 
-#define SAMPLE_SIZE                 2
 #define XFER_FREQUENCY_HZ           1000
+#define FEEDBACK_SIZE               3
+#define FEEDBACK_REFRESH            3       // 2^3 ms between updates
 #define WRITE_READY_UNBLOCK         (1 << 0)
 #define READ_READY_UNBLOCK          (1 << 1)
 
@@ -117,10 +118,17 @@ static void stub_handler(USBAudio::AudioEvent event)
     (void)event;
 }
 
-USBAudio::USBAudio(bool connect, uint32_t frequency_rx, uint8_t channel_count_rx, uint32_t frequency_tx, uint8_t channel_count_tx, uint32_t buffer_ms, uint16_t vendor_id, uint16_t product_id, uint16_t product_release):
+static uint16_t channel_config(uint8_t channel_count)
+{
+    // Mono has no spatial location, other layouts take them in order:
+    // left, right, center, LFE, left surround, right surround...
+    return (channel_count == 1) ? CHANNEL_M : (uint16_t)((1 << channel_count) - 1);
+}
+
+USBAudio::USBAudio(bool connect, uint32_t frequency_rx, uint8_t channel_count_rx, uint32_t frequency_tx, uint8_t channel_count_tx, uint32_t buffer_ms, uint16_t vendor_id, uint16_t product_id, uint16_t product_release, uint8_t sample_size):
     USBDevice(get_usb_phy(), vendor_id, product_id, product_release)
 {
-    _init(frequency_rx, channel_count_rx, frequency_tx, channel_count_tx, buffer_ms);
+    _init(frequency_rx, channel_count_rx, frequency_tx, channel_count_tx, buffer_ms, sample_size);
 
     // connect or init device
     if (connect) {
@@ -130,14 +138,18 @@ USBAudio::USBAudio(bool connect, uint32_t frequency_rx, uint8_t channel_count_rx
     }
 }
 
-USBAudio::USBAudio(USBPhy *phy, uint32_t frequency_rx, uint8_t channel_count_rx, uint32_t frequency_tx, uint8_t channel_count_tx, uint32_t buffer_ms, uint16_t vendor_id, uint16_t product_id, uint16_t product_release):
+USBAudio::USBAudio(USBPhy *phy, uint32_t frequency_rx, uint8_t channel_count_rx, uint32_t frequency_tx, uint8_t channel_count_tx, uint32_t buffer_ms, uint16_t vendor_id, uint16_t product_id, uint16_t product_release, uint8_t sample_size):
     USBDevice(phy, vendor_id, product_id, product_release)
 {
-    _init(frequency_rx, channel_count_rx, frequency_tx, channel_count_tx, buffer_ms);
+    _init(frequency_rx, channel_count_rx, frequency_tx, channel_count_tx, buffer_ms, sample_size);
 }
 
-void USBAudio::_init(uint32_t frequency_rx, uint8_t channel_count_rx, uint32_t frequency_tx, uint8_t channel_count_tx, uint32_t buffer_ms)
+void USBAudio::_init(uint32_t frequency_rx, uint8_t channel_count_rx, uint32_t frequency_tx, uint8_t channel_count_tx, uint32_t buffer_ms, uint8_t sample_size)
 {
+    MBED_ASSERT((sample_size == 2) || (sample_size == 3));
+    MBED_ASSERT((channel_count_rx >= 1) && (channel_count_rx <= 8));
+    MBED_ASSERT((channel_count_tx >= 1) && (channel_count_tx <= 8));
+
     _connected = false;
 
     _volume = 0;
@@ -160,32 +172,48 @@ void USBAudio::_init(uint32_t frequency_rx, uint8_t channel_count_rx, uint32_t f
     _tx_channel_count = channel_count_tx;
     _rx_channel_count = channel_count_rx;
 
+    _sample_size = sample_size;
+
     _tx_idle = true;
     _tx_frame_fract = 0;
     _tx_whole_frames_per_xfer = _tx_freq / XFER_FREQUENCY_HZ;
     _tx_fract_frames_per_xfer = _tx_freq % XFER_FREQUENCY_HZ;
 
     uint32_t max_frames = _tx_whole_frames_per_xfer + (_tx_fract_frames_per_xfer ? 1 : 0);
-    _tx_packet_size_max = max_frames * SAMPLE_SIZE * _tx_channel_count;
-    _rx_packet_size_max = (_rx_freq + 1000 - 1) / 1000 * _rx_channel_count * 2;
+    _tx_packet_size_max = max_frames * _sample_size * _tx_channel_count;
+    uint32_t rx_frames = (_rx_freq + XFER_FREQUENCY_HZ - 1) / XFER_FREQUENCY_HZ;
+#if MBED_CONF_USB_AUDIO_FEEDBACK
+    // room for the extra frame the host sends when asked to speed up
+    rx_frames += 1;
+#endif
+    _rx_packet_size_max = rx_frames * _sample_size * _rx_channel_count;
 
     _tx_packet_buf = new uint8_t[_tx_packet_size_max]();
     _rx_packet_buf = new uint8_t[_rx_packet_size_max]();
 
-    _tx_queue.resize(buffer_ms * _tx_channel_count * SAMPLE_SIZE * _tx_freq / XFER_FREQUENCY_HZ);
-    _rx_queue.resize(buffer_ms * _rx_channel_count * SAMPLE_SIZE * _rx_freq / XFER_FREQUENCY_HZ);
+    _tx_queue.resize(buffer_ms * _tx_channel_count * _sample_size * _tx_freq / XFER_FREQUENCY_HZ);
+    _rx_queue.resize(buffer_ms * _rx_channel_count * _sample_size * _rx_freq / XFER_FREQUENCY_HZ);
+
+#if MBED_CONF_USB_AUDIO_FEEDBACK
+    _fb_idle = true;
+    _fb_nominal = (_rx_freq << 14) / XFER_FREQUENCY_HZ;
+    _fb_target = _rx_queue.free() / 2;
+#endif
 
     _tx_state = Closed;
     _rx_state = Closed;
 
     EndpointResolver resolver(endpoint_table());
     resolver.endpoint_ctrl(64);
-    _episo_out = resolver.endpoint_out(USB_EP_TYPE_ISO, _tx_packet_size_max);
-    _episo_in = resolver.endpoint_in(USB_EP_TYPE_ISO, _rx_packet_size_max);
+    _episo_out = resolver.endpoint_out(USB_EP_TYPE_ISO, _rx_packet_size_max);
+    _episo_in = resolver.endpoint_in(USB_EP_TYPE_ISO, _tx_packet_size_max);
+#if MBED_CONF_USB_AUDIO_FEEDBACK
+    _episo_fb = resolver.endpoint_in(USB_EP_TYPE_ISO, FEEDBACK_SIZE);
+#endif
     MBED_ASSERT(resolver.valid());
 
-    _channel_config_rx = (_rx_channel_count == 1) ? CHANNEL_M : CHANNEL_L + CHANNEL_R;
-    _channel_config_tx = (_tx_channel_count == 1) ? CHANNEL_M : CHANNEL_L + CHANNEL_R;
+    _channel_config_rx = channel_config(_rx_channel_count);
+    _channel_config_tx = channel_config(_tx_channel_count);
 
     _build_configuration_desc();
 }
@@ -243,15 +271,13 @@ bool USBAudio::read(uint8_t *buf, uint32_t size)
 
 void USBAudio::read_nb(uint8_t *buf, uint32_t size, uint32_t *actual)
 {
-
-    lock();
+    // _rx_queue has a single reader and the ISR as single writer, so it
+    // is read without locking
 
     uint32_t available = _rx_queue.size();
     uint32_t copy_size = available > size ? size : available;
     _rx_queue.read(buf, copy_size);
     *actual = copy_size;
-
-    unlock();
 }
 
 uint32_t USBAudio::read_overflows(bool clear)
@@ -299,15 +325,20 @@ bool USBAudio::write(uint8_t *buf, uint32_t size)
 
 void USBAudio::write_nb(uint8_t *buf, uint32_t size, uint32_t *actual)
 {
-    lock();
+    // _tx_queue has a single writer and the ISR as single reader, so it
+    // is written without locking
 
     uint32_t available = _tx_queue.free();
     uint32_t copy_size = available > size ? size : available;
     _tx_queue.write(buf, copy_size);
     *actual = copy_size;
-    _send_isr_start();
 
-    unlock();
+    // Only an idle stream has to be restarted
+    if (_tx_idle) {
+        lock();
+        _send_isr_start();
+        unlock();
+    }
 }
 
 uint32_t USBAudio::write_underflows(bool clear)
@@ -545,6 +576,10 @@ void USBAudio::callback_set_configuration(uint8_t configuration)
         // Configure isochronous endpoint
         endpoint_add(_episo_out, _rx_packet_size_max, USB_EP_TYPE_ISO,  static_cast<ep_cb_t>(&USBAudio::_receive_isr));
         endpoint_add(_episo_in, _tx_packet_size_max, USB_EP_TYPE_ISO,  static_cast<ep_cb_t>(&USBAudio::_send_isr));
+#if MBED_CONF_USB_AUDIO_FEEDBACK
+        endpoint_add(_episo_fb, FEEDBACK_SIZE, USB_EP_TYPE_ISO,  static_cast<ep_cb_t>(&USBAudio::_feedback_isr));
+        _fb_idle = true;
+#endif
 
         // activate readings on this endpoint
         read_start(_episo_out, _rx_packet_buf, _rx_packet_size_max);
@@ -609,7 +644,8 @@ const uint8_t *USBAudio::string_iproduct_desc()
                                + (2 * STREAMING_INTERFACE_DESCRIPTOR_LENGTH) \
                                + (2 * FORMAT_TYPE_I_DESCRIPTOR_LENGTH) \
                                + (2 * (ENDPOINT_DESCRIPTOR_LENGTH + 2)) \
-                               + (2 * STREAMING_ENDPOINT_DESCRIPTOR_LENGTH) )
+                               + (2 * STREAMING_ENDPOINT_DESCRIPTOR_LENGTH) \
+                               + (MBED_CONF_USB_AUDIO_FEEDBACK * (ENDPOINT_DESCRIPTOR_LENGTH + 2)) )
 
 #define TOTAL_CONTROL_INTF_LENGTH    (CONTROL_INTERFACE_DESCRIPTOR_LENGTH + 1 + \
                                       2*INPUT_TERMINAL_DESCRIPTOR_LENGTH     + \
@@ -738,7 +774,7 @@ void USBAudio::_build_configuration_desc()
         INTERFACE_DESCRIPTOR,                   // bDescriptorType
         0x01,                                   // bInterfaceNumber
         0x01,                                   // bAlternateSetting
-        0x01,                                   // bNumEndpoints
+        0x01 + MBED_CONF_USB_AUDIO_FEEDBACK,    // bNumEndpoints
         AUDIO_CLASS,                            // bInterfaceClass
         SUBCLASS_AUDIOSTREAMING,                // bInterfaceSubClass
         0x00,                                   // bInterfaceProtocol
@@ -759,8 +795,8 @@ void USBAudio::_build_configuration_desc()
         STREAMING_FORMAT_TYPE,                  // bDescriptorSubtype
         FORMAT_TYPE_I,                          // bFormatType
         _rx_channel_count,                      // bNrChannels
-        0x02,                                   // bSubFrameSize
-        16,                                     // bBitResolution
+        _sample_size,                           // bSubFrameSize
+        (uint8_t)(_sample_size * 8),            // bBitResolution
         0x01,                                   // bSamFreqType
         (uint8_t)(LSB(_rx_freq)),               // tSamFreq
         (uint8_t)((_rx_freq >> 8) & 0xff),      // tSamFreq
@@ -770,12 +806,20 @@ void USBAudio::_build_configuration_desc()
         ENDPOINT_DESCRIPTOR_LENGTH + 2,         // bLength
         ENDPOINT_DESCRIPTOR,                    // bDescriptorType
         _episo_out,                             // bEndpointAddress
+#if MBED_CONF_USB_AUDIO_FEEDBACK
+        E_ISOCHRONOUS | E_ASYNCHRONOUS,         // bmAttributes
+#else
         E_ISOCHRONOUS,                          // bmAttributes
+#endif
         (uint8_t)(LSB(_rx_packet_size_max)),    // wMaxPacketSize
         (uint8_t)(MSB(_rx_packet_size_max)),    // wMaxPacketSize
         0x01,                                   // bInterval
         0x00,                                   // bRefresh
+#if MBED_CONF_USB_AUDIO_FEEDBACK
+        _episo_fb,                              // bSynchAddress
+#else
         0x00,                                   // bSynchAddress
+#endif
 
         // Endpoint - Audio Streaming
         STREAMING_ENDPOINT_DESCRIPTOR_LENGTH,   // bLength
@@ -786,6 +830,18 @@ void USBAudio::_build_configuration_desc()
         LSB(0x0000),                            // wLockDelay
         MSB(0x0000),                            // wLockDelay
 
+#if MBED_CONF_USB_AUDIO_FEEDBACK
+        // Endpoint - Feedback
+        ENDPOINT_DESCRIPTOR_LENGTH + 2,         // bLength
+        ENDPOINT_DESCRIPTOR,                    // bDescriptorType
+        _episo_fb,                              // bEndpointAddress
+        E_ISOCHRONOUS | E_FEEDBACK,             // bmAttributes
+        LSB(FEEDBACK_SIZE),                     // wMaxPacketSize
+        MSB(FEEDBACK_SIZE),                     // wMaxPacketSize
+        0x01,                                   // bInterval
+        FEEDBACK_REFRESH,                       // bRefresh
+        0x00,                                   // bSynchAddress
+#endif
 
         // Interface 1, Alternate Setting 0, Audio Streaming - Zero Bandwith
         INTERFACE_DESCRIPTOR_LENGTH,            // bLength
@@ -824,8 +880,8 @@ void USBAudio::_build_configuration_desc()
         SUBCLASS_AUDIOSTREAMING,                // bDescriptorSubtype
         FORMAT_TYPE_I,                          // bFormatType
         _tx_channel_count,                      // bNrChannels
-        0x02,                                   // bSubFrameSize
-        0x10,                                   // bBitResolution
+        _sample_size,                           // bSubFrameSize
+        (uint8_t)(_sample_size * 8),            // bBitResolution
         0x01,                                   // bSamFreqType
         (uint8_t)(LSB(_tx_freq)),               // tSamFreq
         (uint8_t)((_tx_freq >> 8) & 0xff),      // tSamFreq
@@ -876,6 +932,11 @@ void USBAudio::_receive_change(ChannelState new_state)
         // Entering the opened state
         _read_list.process();
         _rx_done.call(Start);
+#if MBED_CONF_USB_AUDIO_FEEDBACK
+        if (_fb_idle) {
+            _feedback_isr_next();
+        }
+#endif
     }
     if (new_state == Closed) {
         // Only block if the channel is closed
@@ -955,7 +1016,7 @@ void USBAudio::_send_isr_next_sync()
         _tx_frame_fract -= XFER_FREQUENCY_HZ;
         fames += 1;
     }
-    uint32_t send_size = fames * _tx_channel_count * 2;
+    uint32_t send_size = fames * _tx_channel_count * _sample_size;
 
     // Check if this is the initial TX packet
     if (_tx_idle && !_tx_queue.full()) {
@@ -999,3 +1060,43 @@ void USBAudio::_send_isr()
         _tx_done.call(Transfer);
     }
 }
+
+#if MBED_CONF_USB_AUDIO_FEEDBACK
+void USBAudio::_feedback_isr_next()
+{
+    assert_locked();
+
+    if (_rx_state != Opened) {
+        _fb_idle = true;
+        return;
+    }
+
+    // Ask for more frames while the read buffer is below the target and for
+    // fewer while it is above, by at most 1/64 of the rate or one frame
+    int32_t max_correction = _fb_nominal >> 6;
+    if (max_correction > (1 << 14)) {
+        max_correction = 1 << 14;
+    }
+    int32_t correction = 0;
+    if (_fb_target) {
+        int32_t error = (int32_t)_fb_target - (int32_t)_rx_queue.size();
+        correction = (int32_t)(((int64_t)error * max_correction) / (int32_t)_fb_target);
+    }
+    uint32_t feedback = _fb_nominal + correction;
+
+    _fb_buf[0] = (feedback >> 0) & 0xff;
+    _fb_buf[1] = (feedback >> 8) & 0xff;
+    _fb_buf[2] = (feedback >> 16) & 0xff;
+    write_start(_episo_fb, _fb_buf, FEEDBACK_SIZE);
+    _fb_idle = false;
+}
+
+void USBAudio::_feedback_isr()
+{
+    assert_locked();
+
+    write_finish(_episo_fb);
+
+    _feedback_isr_next();
+}
+#endif
@@ -180,11 +180,13 @@ void USBCDC::_init()
     _terminal_connected = false;
 
     _tx_in_progress = false;
-    _tx_buf = _tx_buffer;
+    _tx_fill = 0;
     _tx_size = 0;
 
     _rx_in_progress = false;
-    _rx_buf = _rx_buffer;
+    _rx_head = 0;
+    _rx_count = 0;
+    _rx_buf = _rx_buffer[0];
     _rx_size = 0;
 }
 
@@ -294,8 +296,7 @@ void USBCDC::callback_set_configuration(uint8_t configuration)
         endpoint_add(_bulk_in, CDC_MAX_PACKET_SIZE, USB_EP_TYPE_BULK, &USBCDC::_send_isr);
         endpoint_add(_bulk_out, CDC_MAX_PACKET_SIZE, USB_EP_TYPE_BULK, &USBCDC::_receive_isr);
 
-        read_start(_bulk_out, _rx_buf, sizeof(_rx_buffer));
-        _rx_in_progress = true;
+        _receive_isr_start();
 
         ret = true;
     }
@@ -320,17 +321,19 @@ void USBCDC::_change_terminal_connected(bool connected)
             endpoint_abort(_bulk_in);
             _tx_in_progress = false;
         }
-        _tx_buf = _tx_buffer;
+        _tx_fill = 0;
         _tx_size = 0;
         _tx_list.process();
         MBED_ASSERT(_tx_list.empty());
 
         // Abort RX
         if (_rx_in_progress) {
-            endpoint_abort(_bulk_in);
+            endpoint_abort(_bulk_out);
             _rx_in_progress = false;
         }
-        _rx_buf = _rx_buffer;
+        _rx_head = 0;
+        _rx_count = 0;
+        _rx_buf = _rx_buffer[0];
         _rx_size = 0;
         _rx_list.process();
         MBED_ASSERT(_rx_list.empty());
@@ -379,11 +382,11 @@ void USBCDC::send_nb(uint8_t *buffer, uint32_t size, uint32_t *actual, bool now)
     lock();
 
     *actual = 0;
-    if (_terminal_connected && !_tx_in_progress) {
-        uint32_t free = sizeof(_tx_buffer) - _tx_size;
+    if (_terminal_connected) {
+        uint32_t free = sizeof(_tx_buffer[0]) - _tx_size;
         uint32_t write_size = free > size ? size : free;
-        if (size > 0) {
-            memcpy(_tx_buf, buffer, write_size);
+        if (write_size > 0) {
+            memcpy(&_tx_buffer[_tx_fill][_tx_size], buffer, write_size);
         }
         _tx_size += write_size;
         *actual = write_size;
@@ -400,8 +403,11 @@ void USBCDC::_send_isr_start()
     assert_locked();
 
     if (!_tx_in_progress && _tx_size) {
-        if (USBDevice::write_start(_bulk_in, _tx_buffer, _tx_size)) {
+        if (USBDevice::write_start(_bulk_in, _tx_buffer[_tx_fill], _tx_size)) {
             _tx_in_progress = true;
+            // fill the other buffer while this one is sent
+            _tx_fill ^= 1;
+            _tx_size = 0;
         }
     }
 }
@@ -415,12 +421,13 @@ void USBCDC::_send_isr()
     assert_locked();
 
     write_finish(_bulk_in);
-    _tx_buf = _tx_buffer;
-    _tx_size = 0;
     _tx_in_progress = false;
 
+    // send what was queued during the transfer right away
+    _send_isr_start();
+
     _tx_list.process();
-    if (!_tx_in_progress) {
+    if (_tx_size < sizeof(_tx_buffer[0])) {
         data_tx();
     }
 }
@@ -444,27 +451,37 @@ bool USBCDC::receive(uint8_t *buffer, uint32_t size,  uint32_t *size_read)
 
 void USBCDC::receive_nb(uint8_t *buffer, uint32_t size,  uint32_t *size_read)
 {
+    lock();
 
     *size_read = 0;
-    if (_terminal_connected && !_rx_in_progress) {
+    while (_terminal_connected && _rx_size && size) {
         // Copy data over
         uint32_t copy_size = _rx_size > size ? size : _rx_size;
         memcpy(buffer, _rx_buf, copy_size);
-        *size_read = copy_size;
+        *size_read += copy_size;
+        buffer += copy_size;
+        size -= copy_size;
         _rx_buf += copy_size;
         _rx_size -= copy_size;
         if (_rx_size == 0) {
+            // Move on to the next packet, if it was received already
+            _rx_head ^= 1;
+            _rx_count--;
+            _rx_buf = _rx_buffer[_rx_head];
+            _rx_size = _rx_count ? _rx_sizes[_rx_head] : 0;
             _receive_isr_start();
         }
     }
+
+    unlock();
 }
 
 void USBCDC::_receive_isr_start()
 {
-    if ((_rx_size == 0) && !_rx_in_progress) {
-        // Refill the buffer
+    if ((_rx_count < 2) && !_rx_in_progress) {
+        // Refill the free buffer
         _rx_in_progress = true;
-        read_start(_bulk_out, _rx_buffer, sizeof(_rx_buffer));
+        read_start(_bulk_out, _rx_buffer[(_rx_head + _rx_count) % 2], sizeof(_rx_buffer[0]));
     }
 }
 
@@ -476,12 +493,22 @@ void USBCDC::_receive_isr()
 {
     assert_locked();
 
-    MBED_ASSERT(_rx_size == 0);
-    _rx_buf = _rx_buffer;
-    _rx_size = read_finish(_bulk_out);
+    const uint8_t index = (_rx_head + _rx_count) % 2;
+    const uint32_t size = read_finish(_bulk_out);
     _rx_in_progress = false;
+    if (size) {
+        _rx_sizes[index] = size;
+        if (_rx_count++ == 0) {
+            _rx_buf = _rx_buffer[index];
+            _rx_size = size;
+        }
+    }
+
+    // Receive the next packet while this one is read
+    _receive_isr_start();
+
     _rx_list.process();
-    if (!_rx_in_progress) {
+    if (_rx_size) {
         data_rx();
     }
 
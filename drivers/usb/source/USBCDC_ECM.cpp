@@ -43,7 +43,8 @@
 #define LINK_SPEED                  (10000000)
 
 USBCDC_ECM::USBCDC_ECM(bool connect_blocking, uint16_t vendor_id, uint16_t product_id, uint16_t product_release)
-    : USBDevice(get_usb_phy(), vendor_id, product_id, product_release), _packet_filter(0), _queue(4 * EVENTS_EVENT_SIZE)
+    : USBDevice(get_usb_phy(), vendor_id, product_id, product_release), _tx_buf(NULL), _tx_remaining(0), _tx_zlp(false),
+      _packet_filter(0), _queue(4 * EVENTS_EVENT_SIZE)
 {
     _init();
 
@@ -57,7 +58,8 @@ USBCDC_ECM::USBCDC_ECM(bool connect_blocking, uint16_t vendor_id, uint16_t produ
 }
 
 USBCDC_ECM::USBCDC_ECM(USBPhy *phy, uint16_t vendor_id, uint16_t product_id, uint16_t product_release)
-    : USBDevice(phy, vendor_id, product_id, product_release), _packet_filter(0), _queue(4 * EVENTS_EVENT_SIZE)
+    : USBDevice(phy, vendor_id, product_id, product_release), _tx_buf(NULL), _tx_remaining(0), _tx_zlp(false),
+      _packet_filter(0), _queue(4 * EVENTS_EVENT_SIZE)
 {
 
     _init();
@@ -183,27 +185,35 @@ void USBCDC_ECM::_notify_connect()
     _notify_connection_speed_change(LINK_SPEED, LINK_SPEED);
 }
 
-bool USBCDC_ECM::_write_bulk(uint8_t *buffer, uint32_t size)
+bool USBCDC_ECM::_write_next_packet()
 {
-    bool ret = true;
+    assert_locked();
 
-    _flags.clear(FLAG_WRITE_DONE);
-    USBDevice::write_start(_bulk_in, buffer, size);
-    uint32_t flags = _flags.wait_any(FLAG_WRITE_DONE | FLAG_DISCONNECT, osWaitForever, false);
-    if (flags & FLAG_DISCONNECT) {
-        ret = false;
+    uint32_t max_packet = USBDevice::endpoint_max_packet_size(_bulk_in);
+    uint32_t data_size = (_tx_remaining > max_packet) ? max_packet : _tx_remaining;
+
+    if (data_size == 0) {
+        if (!_tx_zlp) {
+            return false;
+        }
+        /* Send zero length packet */
+        _tx_zlp = false;
     }
 
-    USBDevice::write_finish(_bulk_in);
-    return ret;
+    if (!USBDevice::write_start(_bulk_in, _tx_buf, data_size)) {
+        _tx_remaining = 0;
+        _tx_zlp = false;
+        return false;
+    }
+    _tx_buf += data_size;
+    _tx_remaining -= data_size;
+    return true;
 }
 
 bool USBCDC_ECM::send(uint8_t *buffer, uint32_t size)
 {
     _write_mutex.lock();
     bool ret = true;
-    uint32_t sent = 0;
-    uint32_t data_size = 0;
 
     if (size > MAX_SEGMENT_SIZE) {
         _write_mutex.unlock();
@@ -211,23 +221,32 @@ bool USBCDC_ECM::send(uint8_t *buffer, uint32_t size)
         return false;
     }
 
-    uint32_t max_packet = USBDevice::endpoint_max_packet_size(_bulk_in);
+    _flags.clear(FLAG_WRITE_DONE);
 
-    while (size - sent > 0) {
-        data_size = (size - sent > max_packet) ? max_packet : size - sent;
-        if (_write_bulk(buffer + sent, data_size)) {
-            sent += data_size;
-        } else {
-            _write_mutex.unlock();
-            return false;
+    // The packets of the frame are sent straight from the buffer. Each one is
+    // started from the bulk IN callback when the previous one is done, so the
+    // thread only wakes up once the whole frame is out.
+    lock();
+    _tx_buf = buffer;
+    _tx_remaining = size;
+    _tx_zlp = (size % USBDevice::endpoint_max_packet_size(_bulk_in)) == 0;
+    bool started = _write_next_packet();
+    unlock();
+
+    if (started) {
+        uint32_t flags = _flags.wait_any(FLAG_WRITE_DONE | FLAG_DISCONNECT, osWaitForever, false);
+        if (flags & FLAG_DISCONNECT) {
+            ret = false;
         }
+    } else {
+        ret = false;
     }
 
-    /* Send zero length packet */
-    if (size % max_packet == 0) {
-        uint8_t buf = 0;
-        ret = _write_bulk(&buf, 0);
-    }
+    lock();
+    _tx_buf = NULL;
+    _tx_remaining = 0;
+    _tx_zlp = false;
+    unlock();
 
     _write_mutex.unlock();
     return ret;
@@ -339,6 +358,8 @@ void USBCDC_ECM::callback_state_change(DeviceState new_state)
         _flags.set(FLAG_CONNECT);
         _flags.clear(FLAG_DISCONNECT);
     } else {
+        _tx_remaining = 0;
+        _tx_zlp = false;
         _flags.set(FLAG_DISCONNECT);
         _flags.clear(FLAG_CONNECT | FLAG_WRITE_DONE | FLAG_INT_DONE);
     }
@@ -535,7 +556,10 @@ void USBCDC_ECM::_bulk_in_callback()
 {
     assert_locked();
 
-    _flags.set(FLAG_WRITE_DONE);
+    USBDevice::write_finish(_bulk_in);
+    if (!_write_next_packet()) {
+        _flags.set(FLAG_WRITE_DONE);
+    }
 }
 
 void USBCDC_ECM::_bulk_out_callback()
@@ -142,12 +142,12 @@ void USBHID::_init(uint8_t output_report_length, uint8_t input_report_length)
     _int_out = resolver.endpoint_out(USB_EP_TYPE_INT, MAX_HID_REPORT_SIZE);
     MBED_ASSERT(resolver.valid());
 
-    _send_idle = true;
+    _send_head = 0;
+    _send_count = 0;
     _read_idle = true;
     _output_length = output_report_length;
     _input_length = input_report_length;
     reportLength = 0;
-    _input_report.length = 0;
     _output_report.length = 0;
 }
 
@@ -192,10 +192,15 @@ bool USBHID::send_nb(const HID_REPORT *report)
     }
 
     bool success = false;
-    if (_send_idle) {
-        memcpy(&_input_report, report, sizeof(_input_report));
-        write_start(_int_in, _input_report.data, _input_report.length);
-        _send_idle = false;
+    if (_send_count < MBED_CONF_USB_HID_REPORT_QUEUE_SIZE && report->length <= MAX_HID_REPORT_SIZE) {
+        HID_REPORT &entry = _send_queue[(_send_head + _send_count) % MBED_CONF_USB_HID_REPORT_QUEUE_SIZE];
+        entry.length = report->length;
+        memcpy(entry.data, report->data, report->length);
+        _send_count++;
+        // otherwise the ISR starts it when the reports before are sent
+        if (_send_count == 1) {
+            write_start(_int_in, entry.data, entry.length);
+        }
         success = true;
     }
 
@@ -243,10 +248,17 @@ void USBHID::_send_isr()
     assert_locked();
 
     write_finish(_int_in);
-    _send_idle = true;
+    _send_head = (_send_head + 1) % MBED_CONF_USB_HID_REPORT_QUEUE_SIZE;
+    _send_count--;
+
+    // keep the endpoint fed for the next polling interval
+    if (_send_count) {
+        HID_REPORT &entry = _send_queue[_send_head];
+        write_start(_int_in, entry.data, entry.length);
+    }
 
     _send_list.process();
-    if (_send_idle) {
+    if (_send_count < MBED_CONF_USB_HID_REPORT_QUEUE_SIZE) {
         report_tx();
     }
 
@@ -275,9 +287,10 @@ uint16_t USBHID::report_desc_length()
 void USBHID::callback_state_change(DeviceState new_state)
 {
     if (new_state != Configured) {
-        if (!_send_idle) {
+        if (_send_count) {
             endpoint_abort(_int_in);
-            _send_idle = true;
+            _send_head = 0;
+            _send_count = 0;
         }
         if (!_read_idle) {
             endpoint_abort(_int_out);
@@ -496,7 +509,7 @@ const uint8_t *USBHID::configuration_desc(uint8_t index)
         E_INTERRUPT,                        // bmAttributes
         LSB(MAX_HID_REPORT_SIZE),           // wMaxPacketSize (LSB)
         MSB(MAX_HID_REPORT_SIZE),           // wMaxPacketSize (MSB)
-        1,                                  // bInterval (milliseconds)
+        MBED_CONF_USB_HID_INTERVAL,         // bInterval
 
         ENDPOINT_DESCRIPTOR_LENGTH,         // bLength
         ENDPOINT_DESCRIPTOR,                // bDescriptorType
@@ -504,7 +517,7 @@ const uint8_t *USBHID::configuration_desc(uint8_t index)
         E_INTERRUPT,                        // bmAttributes
         LSB(MAX_HID_REPORT_SIZE),           // wMaxPacketSize (LSB)
         MSB(MAX_HID_REPORT_SIZE),           // wMaxPacketSize (MSB)
-        1,                                  // bInterval (milliseconds)
+        MBED_CONF_USB_HID_INTERVAL,         // bInterval
     };
     MBED_ASSERT(sizeof(configurationDescriptorTemp) == sizeof(_configuration_descriptor));
     memcpy(_configuration_descriptor, configurationDescriptorTemp, sizeof(_configuration_descriptor));
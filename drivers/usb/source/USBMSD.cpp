@@ -68,7 +68,8 @@ enum Status {
 USBMSD::USBMSD(mbed::BlockDevice *bd, bool connect_blocking, uint16_t vendor_id, uint16_t product_id, uint16_t product_release)
     : USBDevice(get_usb_phy(), vendor_id, product_id, product_release),
       _initialized(false), _media_removed(false),
-      _addr(0), _length(0), _mem_ok(false), _block_size(0), _memory_size(0), _block_count(0),
+      _addr(0), _length(0), _mem_ok(false), _page_blocks(0), _page_addr(0), _page_length(0),
+      _block_size(0), _memory_size(0), _block_count(0),
       _out_ready(false), _in_ready(false), _bulk_out_size(0),
       _in_task(&_queue), _out_task(&_queue), _reset_task(&_queue), _control_task(&_queue),
       _configure_task(&_queue), _bd(bd)
@@ -84,7 +85,8 @@ USBMSD::USBMSD(mbed::BlockDevice *bd, bool connect_blocking, uint16_t vendor_id,
 USBMSD::USBMSD(USBPhy *phy, mbed::BlockDevice *bd, uint16_t vendor_id, uint16_t product_id, uint16_t product_release)
     : USBDevice(phy, vendor_id, product_id, product_release),
       _initialized(false), _media_removed(false),
-      _addr(0), _length(0), _mem_ok(false), _block_size(0), _memory_size(0), _block_count(0),
+      _addr(0), _length(0), _mem_ok(false), _page_blocks(0), _page_addr(0), _page_length(0),
+      _block_size(0), _memory_size(0), _block_count(0),
       _out_ready(false), _in_ready(false), _bulk_out_size(0),
       _in_task(&_queue), _out_task(&_queue), _reset_task(&_queue), _control_task(&_queue),
       _configure_task(&_queue), _bd(bd)
@@ -154,7 +156,12 @@ bool USBMSD::connect()
         _block_size = _memory_size / _block_count;
         if (_block_size != 0) {
             free(_page);
-            _page = (uint8_t *)malloc(_block_size * sizeof(uint8_t));
+            _page_blocks = MBED_CONF_USB_MSD_PAGE_BLOCKS;
+            _page = (uint8_t *)malloc(_page_blocks * _block_size * sizeof(uint8_t));
+            while ((_page == NULL) && (_page_blocks > 1)) {
+                _page_blocks /= 2;
+                _page = (uint8_t *)malloc(_page_blocks * _block_size * sizeof(uint8_t));
+            }
             if (_page == NULL) {
                 _mutex.unlock();
                 _mutex_init.unlock();
@@ -507,7 +514,9 @@ void USBMSD::_process()
                         break;
                     }
                     memoryWrite(_bulk_out_buf, _bulk_out_size);
-                    _read_next();
+                    if (_out_ready) {
+                        _read_next();
+                    }
                     break;
                 case VERIFY10:
                     if (!_out_ready) {
@@ -586,22 +595,30 @@ void USBMSD::memoryWrite(uint8_t *buf, uint16_t size)
         endpoint_stall(_bulk_out);
     }
 
-    // we fill an array in RAM of 1 block before writing it in memory
-    for (int i = 0; i < size; i++) {
-        _page[_addr % _block_size + i] = buf[i];
-    }
-
-    // if the array is filled, write it in memory
-    if (!((_addr + size) % _block_size)) {
-        if (!(disk_status() & WRITE_PROTECT)) {
-            disk_write(_page, _addr / _block_size, 1);
-        }
+    // we fill an array in RAM of up to _page_blocks blocks before writing it in memory
+    if (_page_length == 0) {
+        _page_addr = _addr;
     }
+    memcpy(&_page[_page_length], buf, size);
+    _page_length += size;
 
     _addr += size;
     _length -= size;
     _csw.DataResidue -= size;
 
+    // if the array is filled, or the transfer ends, write the complete blocks in memory
+    if ((_page_length == _page_blocks * _block_size) || (!_length) || (_stage != PROCESS_CBW)) {
+        uint32_t blocks = _page_length / _block_size;
+
+        // let the next packet come in while the blocks are programmed
+        _read_next();
+
+        if (blocks && !(disk_status() & WRITE_PROTECT)) {
+            disk_write(_page, _page_addr / _block_size, blocks);
+        }
+        _page_length = 0;
+    }
+
     if ((!_length) || (_stage != PROCESS_CBW)) {
         _csw.Status = (_stage == ERROR) ? CSW_FAILED : CSW_PASSED;
         sendCSW();
@@ -890,18 +907,24 @@ void USBMSD::memoryRead(void)
     }
 
     if (n > 0) {
-        // we read an entire block
-        if (!(_addr % _block_size)) {
-            disk_read(_page, _addr / _block_size, 1);
+        // we read up to _page_blocks entire blocks
+        if ((_addr < _page_addr) || (_addr >= _page_addr + _page_length)) {
+            memoryReadPage();
         }
 
         // write data which are in RAM
-        _write_next(&_page[_addr % _block_size], MAX_PACKET);
+        _write_next(&_page[_addr - _page_addr], MAX_PACKET);
 
         _addr += n;
         _length -= n;
 
         _csw.DataResidue -= n;
+
+        // The last packet of the page was copied for sending: read the next
+        // blocks while it is on the bus
+        if (_length && (_addr == _page_addr + _page_length)) {
+            memoryReadPage();
+        }
     }
 
     if (!_length || (_stage != PROCESS_CBW)) {
@@ -911,6 +934,18 @@ void USBMSD::memoryRead(void)
 }
 
 
+void USBMSD::memoryReadPage(void)
+{
+    uint32_t blocks = (_length + _block_size - 1) / _block_size;
+    if (blocks > _page_blocks) {
+        blocks = _page_blocks;
+    }
+
+    _page_addr = _addr;
+    _page_length = blocks * _block_size;
+    disk_read(_page, _page_addr / _block_size, blocks);
+}
+
 bool USBMSD::infoTransfer(void)
 {
     uint32_t addr_block;
@@ -920,6 +955,10 @@ bool USBMSD::infoTransfer(void)
 
     _addr = addr_block * _block_size;
 
+    // nothing of the previous transfer is kept in the page
+    _page_addr = 0;
+    _page_length = 0;
+
     if ((addr_block >= _block_count) || (_addr >= _memory_size)) {
         _csw.Status = CSW_FAILED;
         sendCSW();
@@ -71,6 +71,10 @@ public:
             _event->id = 0;
             _event->delay = duration(0);
             _event->period = non_periodic;
+            _event->priority = 0;
+#if EQUEUE_DISPATCH_POOL
+            _event->affinity = 0;
+#endif
 
             _event->post = &Event::event_post<F>;
             _event->dtor = &Event::event_dtor<F>;
@@ -174,6 +178,36 @@ public:
         period(duration(p));
     }
 
+    /** Configure the priority of an event
+     *
+     *  When several events are ready, events with a higher priority
+     *  are dispatched first.
+     *
+     *  @param p   Priority from 0 (default) to EQUEUE_PRIORITY_LEVELS-1
+     */
+    void priority(int p)
+    {
+        if (_event) {
+            _event->priority = p;
+        }
+    }
+
+#if EQUEUE_DISPATCH_POOL
+    /** Configure the affinity key of an event
+     *
+     *  Events with the same non-zero key never run concurrently when the
+     *  queue is dispatched by several threads.
+     *
+     *  @param key Affinity key, 0 for none
+     */
+    void affinity(unsigned key)
+    {
+        if (_event) {
+            _event->affinity = key;
+        }
+    }
+#endif
+
     /** Posts an event onto the underlying event queue
      *
      *  The event is posted to the underlying queue and is executed in the
@@ -252,6 +286,10 @@ private:
 
         duration delay;
         duration period;
+        int priority;
+#if EQUEUE_DISPATCH_POOL
+        unsigned affinity;
+#endif
 
         int (*post)(struct event *, ArgTs... args);
         void (*dtor)(struct event *);
@@ -272,6 +310,10 @@ private:
         new (p) C(*(F *)(e + 1), args...);
         equeue_event_delay(p, e->delay.count());
         equeue_event_period(p, e->period.count());
+        equeue_event_priority(p, e->priority);
+#if EQUEUE_DISPATCH_POOL
+        equeue_event_affinity(p, e->affinity);
+#endif
         equeue_event_dtor(p, &EventQueue::function_dtor<C>);
         return equeue_post(e->equeue, &EventQueue::function_call<C>, p);
     }
@@ -0,0 +1,219 @@
+/*
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef EVENT_FLOW_H
+#define EVENT_FLOW_H
+
+#include "events/EventQueue.h"
+#include "events/EventSignal.h"
+#include "platform/Callback.h"
+#include "platform/NonCopyable.h"
+#include "platform/mbed_assert.h"
+#include "platform/mbed_toolchain.h"
+
+namespace events {
+/** \addtogroup events-public-api
+ * @{
+ */
+
+/** EventFlow
+ *
+ *  Multi-step flow run on an event queue without a thread of its own.
+ *
+ *  The flow is written as a single run() function using the EVENT_FLOW_*
+ *  macros. Each wait returns to the dispatch loop and the flow continues
+ *  after the wait once the queue calls run() again, in the style of
+ *  protothreads. Local variables do not survive a wait, state that must
+ *  be kept across steps belongs in members of the derived class.
+ *
+ *  For C++20 builds, EventTask offers the same with coroutines.
+ *
+ * @code
+ *  class Exchange : public EventFlow {
+ *  public:
+ *      Exchange(EventQueue *queue, TCPSocket *socket)
+ *          : EventFlow(queue), _socket(socket), _readable(queue)
+ *      {
+ *          _socket->set_blocking(false);
+ *          _socket->sigio(mbed::callback(&_readable, &EventSignal::notify));
+ *      }
+ *
+ *  protected:
+ *      void run() override
+ *      {
+ *          EVENT_FLOW_BEGIN();
+ *          _socket->send("ping", 4);
+ *          while ((_res = _socket->recv(_reply, sizeof _reply)) == NSAPI_ERROR_WOULD_BLOCK) {
+ *              EVENT_FLOW_WAIT(_readable);
+ *          }
+ *          EVENT_FLOW_SLEEP(1s);
+ *          EVENT_FLOW_END();
+ *      }
+ *
+ *  private:
+ *      TCPSocket *_socket;
+ *      EventSignal _readable;
+ *      nsapi_size_or_error_t _res;
+ *      char _reply[16];
+ *  };
+ * @endcode
+ */
+class EventFlow : private mbed::NonCopyable<EventFlow> {
+public:
+    using duration = EventQueue::duration;
+
+    /** Create a flow
+     *
+     *  @param queue    Event queue the flow runs on
+     */
+    explicit EventFlow(EventQueue *queue) : _flow_state(0), _queue(queue), _running(false)
+    {
+    }
+
+    virtual ~EventFlow()
+    {
+    }
+
+    /** Start the flow from the beginning
+     *
+     *  The start function is IRQ safe.
+     *
+     *  @return         False if the flow is already running or the queue
+     *                  is out of memory
+     */
+    bool start()
+    {
+        if (_running) {
+            return false;
+        }
+
+        _flow_state = 0;
+        _running = true;
+        if (!_queue->call(mbed::callback(this, &EventFlow::run))) {
+            _running = false;
+            return false;
+        }
+        return true;
+    }
+
+    /** Check whether the flow has started and not yet finished
+     *
+     *  @return         True while the flow is running
+     */
+    bool running() const
+    {
+        return _running;
+    }
+
+protected:
+    /** Body of the flow, written with the EVENT_FLOW_* macros
+     */
+    virtual void run() = 0;
+
+    /** Called once the flow reaches EVENT_FLOW_END or EVENT_FLOW_EXIT
+     */
+    virtual void finished()
+    {
+    }
+
+    /** Event queue the flow runs on
+     *
+     *  @return         Event queue passed to the constructor
+     */
+    EventQueue *queue() const
+    {
+        return _queue;
+    }
+
+    /** Continue the flow after a delay, used by EVENT_FLOW_SLEEP */
+    void flow_sleep(duration d)
+    {
+        MBED_UNUSED int id = _queue->call_in(d, mbed::callback(this, &EventFlow::run));
+        MBED_ASSERT(id);
+    }
+
+    /** Continue the flow once notified, used by EVENT_FLOW_WAIT */
+    void flow_wait(EventSignal &signal)
+    {
+        MBED_ASSERT(signal.queue() == _queue);
+        signal.wait(mbed::callback(this, &EventFlow::run));
+    }
+
+    /** Finish the flow, used by EVENT_FLOW_END and EVENT_FLOW_EXIT */
+    void flow_finish()
+    {
+        _flow_state = 0;
+        _running = false;
+        finished();
+    }
+
+    /** Resume point of the flow, managed by the EVENT_FLOW_* macros */
+    int _flow_state;
+
+private:
+    EventQueue *_queue;
+    volatile bool _running;
+};
+
+/** @}*/
+}
+
+/** Start the body of EventFlow::run */
+#define EVENT_FLOW_BEGIN() switch (this->_flow_state) { case 0:
+
+/** End the body of EventFlow::run */
+#define EVENT_FLOW_END() } this->flow_finish()
+
+/** Finish the flow early */
+#define EVENT_FLOW_EXIT() do { this->flow_finish(); return; } while (0)
+
+/** Let other events on the queue run before continuing */
+#define EVENT_FLOW_YIELD() EVENT_FLOW_SLEEP(EventFlow::duration(0))
+
+/** Continue the flow after a delay, expressed as a Chrono duration */
+#define EVENT_FLOW_SLEEP(d)                                     \
+    do {                                                        \
+        this->_flow_state = __LINE__;                           \
+        this->flow_sleep(d);                                    \
+        return;                                                 \
+        case __LINE__:;                                         \
+    } while (0)
+
+/** Continue the flow once the EventSignal is notified */
+#define EVENT_FLOW_WAIT(signal)                                 \
+    do {                                                        \
+        this->_flow_state = __LINE__;                           \
+        this->flow_wait(signal);                                \
+        return;                                                 \
+        case __LINE__:;                                         \
+    } while (0)
+
+/** Continue the flow once cond holds, checking it every interval
+ *
+ *  Suited to state without a notification, for example
+ *  EVENT_FLOW_WAIT_UNTIL(flags.get() & READY, 10ms) on an rtos::EventFlags.
+ */
+#define EVENT_FLOW_WAIT_UNTIL(cond, interval)                   \
+    do {                                                        \
+        this->_flow_state = __LINE__;                           \
+        case __LINE__:                                          \
+        if (!(cond)) {                                          \
+            this->flow_sleep(interval);                         \
+            return;                                             \
+        }                                                       \
+    } while (0)
+
+#endif
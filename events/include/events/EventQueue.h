@@ -134,6 +134,31 @@ public:
      */
     void dispatch_once();
 
+#if EQUEUE_DISPATCH_POOL || defined(DOXYGEN_ONLY)
+    /** Dispatch events from one of several threads
+     *
+     *  Behaves like dispatch_for(), but may run in any number of threads at
+     *  the same time, each of them executing one ready event at a time.
+     *  Events posted with the same affinity key never run concurrently.
+     *
+     *  Requires the events.dispatch-pool option. A queue must not be
+     *  dispatched with dispatch_for() and dispatch_shared_for() at the
+     *  same time.
+     *
+     *  @param ms       Time to wait for events in milliseconds, expressed as a
+     *                  Chrono duration.
+     */
+    void dispatch_shared_for(duration ms);
+
+    /** Dispatch events from one of several threads without a timeout
+     *
+     *  Executes events indefinitely unless the dispatch loop is forcibly
+     *  broken. break_dispatch() stops every thread dispatching the queue.
+     *  @see dispatch_shared_for()
+     */
+    void dispatch_shared_forever();
+#endif
+
     /** Break out of a running event loop
      *
      *  Forces the specified event queue's dispatch loop to terminate. Pending
@@ -284,6 +309,24 @@ public:
      */
     int chain(EventQueue *target);
 
+#if EQUEUE_STATS || defined(DOXYGEN_ONLY)
+    /** Fill the passed in structure with the dispatch statistics of the queue
+     *
+     *  Reports how many events were dispatched, histograms of how long they
+     *  waited past their due time and how long they ran, and the callback of
+     *  the longest running event. Times are in milliseconds.
+     *
+     *  Requires MBED_EVENTS_STATS_ENABLED or MBED_ALL_STATS_ENABLED.
+     *
+     *  @param stats    A pointer to the equeue_stats_t structure to fill
+     */
+    void get_stats(equeue_stats_t *stats);
+
+    /** Clear the dispatch statistics of the queue
+     */
+    void reset_stats();
+#endif
+
 
 
 #if defined(DOXYGEN_ONLY)
@@ -373,6 +416,70 @@ public:
     int call(T *obj, R (T::*method)(Args ...args), Args ...args);
     // *INDENT-ON*
 
+    /** Calls an event on the queue with a dispatch priority
+     *
+     *  The specified callback is executed in the context of the event
+     *  queue's dispatch loop. When several events are ready, events with a
+     *  higher priority are dispatched first, events of the same priority
+     *  in the order they were posted.
+     *
+     *  The call_with_priority function is IRQ safe and can act as a mechanism
+     *  for moving events out of IRQ contexts.
+     *
+     *  @param priority Priority from 0 (default) to EQUEUE_PRIORITY_LEVELS-1
+     *  @param f        Function to execute in the context of the dispatch loop
+     *  @param args     Arguments to pass to the callback
+     *  @return         A unique ID that represents the posted event and can
+     *                  be passed to cancel, or an ID of 0 if there is not
+     *                  enough memory to allocate the event.
+     *
+     * @code
+     *     #include "mbed.h"
+     *
+     *     int main() {
+     *         // creates a queue with the default size
+     *         EventQueue queue;
+     *
+     *         // the second event is dispatched first
+     *         queue.call(printf, "logging\n");
+     *         queue.call_with_priority(3, printf, "network rx\n");
+     *
+     *         queue.dispatch_once();
+     *     }
+     * @endcode
+     */
+    template <typename F, typename ...Args>
+    int call_with_priority(int priority, F f, Args ...args);
+
+    /** Calls an event on the queue with a dispatch priority
+     *  @see EventQueue::call_with_priority
+     */
+    // AStyle ignore, not handling correctly below
+    // *INDENT-OFF*
+    template <typename T, typename R, typename ...Args>
+    int call_with_priority(int priority, T *obj, R (T::*method)(Args ...args), Args ...args);
+    // *INDENT-ON*
+
+    /** Calls an event on the queue with an affinity key
+     *
+     *  The specified callback is executed in the context of one of the
+     *  threads running dispatch_shared_for(). Events with the same
+     *  non-zero key never run concurrently and run in the order they
+     *  became due, so related events need no extra locking.
+     *
+     *  The call_with_affinity function is IRQ safe and can act as a mechanism
+     *  for moving events out of IRQ contexts.
+     *
+     *  @param key      Affinity key, 0 for none
+     *  @param f        Function to execute in the context of the dispatch loop
+     *  @param args     Arguments to pass to the callback
+     *  @return         A unique ID that represents the posted event and can
+     *                  be passed to cancel, or an ID of 0 if there is not
+     *                  enough memory to allocate the event.
+     */
+    template <typename F, typename ...Args>
+    int call_with_affinity(unsigned key, F f, Args ...args);
+
     /** Calls an event on the queue after a specified delay
      *
      *  The specified callback is executed in the context of the event
@@ -831,6 +938,113 @@ public:
         return call(mbed::callback(obj, method), args...);
     }
 
+    /** Calls an event on the queue with a dispatch priority
+     *
+     *  The specified callback is executed in the context of the event
+     *  queue's dispatch loop. When several events are ready, events with a
+     *  higher priority are dispatched first.
+     *
+     *  The call_with_priority function is IRQ safe and can act as a mechanism
+     *  for moving events out of IRQ contexts.
+     *
+     *  @param priority Priority from 0 (default) to EQUEUE_PRIORITY_LEVELS-1
+     *  @param f        Function to execute in the context of the dispatch loop
+     *  @return         A unique ID that represents the posted event and can
+     *                  be passed to cancel, or an ID of 0 if there is not
+     *                  enough memory to allocate the event.
+     */
+    template <typename F>
+    int call_with_priority(int priority, F f)
+    {
+        void *p = equeue_alloc(&_equeue, sizeof(F));
+        if (!p) {
+            return 0;
+        }
+
+        F *e = new (p) F(std::move(f));
+        equeue_event_priority(e, priority);
+        equeue_event_dtor(e, &EventQueue::function_dtor<F>);
+        return equeue_post(&_equeue, &EventQueue::function_call<F>, e);
+    }
+
+    /** Calls an event on the queue with a dispatch priority
+     *  @see                    EventQueue::call_with_priority
+     *  @param priority         Priority from 0 (default) to EQUEUE_PRIORITY_LEVELS-1
+     *  @param f                Function to execute in the context of the dispatch loop
+     *  @param args             Arguments to pass to the callback
+     */
+    template <typename F, typename... ArgTs>
+    int call_with_priority(int priority, F f, ArgTs... args)
+    {
+        return call_with_priority(priority, context<F, ArgTs...>(std::move(f), args...));
+    }
+
+    /** Calls an event on the queue with a dispatch priority
+     *  @see EventQueue::call_with_priority
+     */
+    template <typename T, typename R, typename... ArgTs>
+    int call_with_priority(int priority, T *obj, R(T::*method)(ArgTs...), ArgTs... args)
+    {
+        return call_with_priority(priority, mbed::callback(obj, method), args...);
+    }
+
+    /** Calls an event on the queue with a dispatch priority
+     *  @see EventQueue::call_with_priority
+     */
+    template <typename T, typename R, typename... ArgTs>
+    int call_with_priority(int priority, const T *obj, R(T::*method)(ArgTs...) const, ArgTs... args)
+    {
+        return call_with_priority(priority, mbed::callback(obj, method), args...);
+    }
+
+#if EQUEUE_DISPATCH_POOL
+    /** Calls an event on the queue with an affinity key
+     *
+     *  Events with the same non-zero key never run concurrently when the
+     *  queue is dispatched by several threads with dispatch_shared_for().
+     *
+     *  @param key      Affinity key, 0 for none
+     *  @param f        Function to execute in the context of the dispatch loop
+     *  @return         A unique ID that represents the posted event and can
+     *                  be passed to cancel, or an ID of 0 if there is not
+     *                  enough memory to allocate the event.
+     */
+    template <typename F>
+    int call_with_affinity(unsigned key, F f)
+    {
+        void *p = equeue_alloc(&_equeue, sizeof(F));
+        if (!p) {
+            return 0;
+        }
+
+        F *e = new (p) F(std::move(f));
+        equeue_event_affinity(e, key);
+        equeue_event_dtor(e, &EventQueue::function_dtor<F>);
+        return equeue_post(&_equeue, &EventQueue::function_call<F>, e);
+    }
+
+    /** Calls an event on the queue with an affinity key
+     *  @see                    EventQueue::call_with_affinity
+     *  @param key              Affinity key, 0 for none
+     *  @param f                Function to execute in the context of the dispatch loop
+     *  @param args             Arguments to pass to the callback
+     */
+    template <typename F, typename... ArgTs>
+    int call_with_affinity(unsigned key, F f, ArgTs... args)
+    {
+        return call_with_affinity(key, context<F, ArgTs...>(std::move(f), args...));
+    }
+
+    /** Calls an event on the queue with an affinity key
+     *  @see EventQueue::call_with_affinity
+     */
+    template <typename T, typename R, typename... ArgTs>
+    int call_with_affinity(unsigned key, T *obj, R(T::*method)(ArgTs...), ArgTs... args)
+    {
+        return call_with_affinity(key, mbed::callback(obj, method), args...);
+    }
+#endif
+
     /** Calls an event on the queue after a specified delay
      *
      *  The specified callback will be executed in the context of the event
@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef EVENT_SIGNAL_H
+#define EVENT_SIGNAL_H
+
+#include "events/EventQueue.h"
+#include "platform/Callback.h"
+#include "platform/NonCopyable.h"
+#include "platform/mbed_assert.h"
+#include "platform/mbed_critical.h"
+#include "platform/mbed_toolchain.h"
+
+namespace events {
+/** \addtogroup events-public-api
+ * @{
+ */
+
+/** EventSignal
+ *
+ *  One-shot notification that resumes a waiting flow or task on an event
+ *  queue. notify() is IRQ safe, so it can be attached directly to sources
+ *  such as Socket::sigio or an InterruptIn.
+ *
+ *  Notifications that arrive with nobody waiting are latched, and several
+ *  of them are merged into one, so a waiter must check the state it waits
+ *  for after being resumed.
+ *
+ * @code
+ *  EventSignal readable(mbed_event_queue());
+ *  socket.sigio(mbed::callback(&readable, &EventSignal::notify));
+ * @endcode
+ */
+class EventSignal : private mbed::NonCopyable<EventSignal> {
+public:
+    /** Create a signal
+     *
+     *  @param queue    Event queue the waiter is resumed on
+     */
+    explicit EventSignal(EventQueue *queue) : _queue(queue), _pending(false)
+    {
+    }
+
+    /** Notify the signal
+     *
+     *  Posts the waiter onto the queue, or latches the notification if
+     *  there is no waiter yet.
+     *
+     *  The notify function is IRQ safe.
+     */
+    void notify()
+    {
+        core_util_critical_section_enter();
+        mbed::Callback<void()> waiter = _waiter;
+        _waiter = nullptr;
+        if (!waiter) {
+            _pending = true;
+        }
+        core_util_critical_section_exit();
+
+        if (waiter) {
+            post(waiter);
+        }
+    }
+
+    /** Wait for the signal
+     *
+     *  The callback is posted onto the queue once the signal is notified,
+     *  right away if a notification is already latched. Only one waiter is
+     *  supported at a time, a new one replaces the previous one.
+     *
+     *  @param waiter   Function to run on the queue once notified
+     */
+    void wait(mbed::Callback<void()> waiter)
+    {
+        core_util_critical_section_enter();
+        bool pending = _pending;
+        _pending = false;
+        if (!pending) {
+            _waiter = waiter;
+        }
+        core_util_critical_section_exit();
+
+        if (pending) {
+            post(waiter);
+        }
+    }
+
+    /** Drop any latched notification and waiter
+     */
+    void reset()
+    {
+        core_util_critical_section_enter();
+        _pending = false;
+        _waiter = nullptr;
+        core_util_critical_section_exit();
+    }
+
+    /** Check for a latched notification
+     *
+     *  @return         True if notified with nobody waiting
+     */
+    bool pending() const
+    {
+        return _pending;
+    }
+
+    /** Event queue the waiter is resumed on
+     *
+     *  @return         Event queue passed to the constructor
+     */
+    EventQueue *queue() const
+    {
+        return _queue;
+    }
+
+private:
+    void post(mbed::Callback<void()> waiter)
+    {
+        MBED_UNUSED int id = _queue->call(waiter);
+        MBED_ASSERT(id);
+    }
+
+    EventQueue *_queue;
+    mbed::Callback<void()> _waiter;
+    volatile bool _pending;
+};
+
+/** @}*/
+}
+
+#endif
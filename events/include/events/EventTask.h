@@ -0,0 +1,295 @@
+/*
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef EVENT_TASK_H
+#define EVENT_TASK_H
+
+#include "events/EventQueue.h"
+#include "events/EventSignal.h"
+#include "platform/mbed_assert.h"
+#include "platform/mbed_toolchain.h"
+
+#if defined(__cpp_impl_coroutine) && defined(__has_include)
+#if __has_include(<coroutine>)
+#define EVENTS_COROUTINES_PRESENT 1
+#endif
+#endif
+
+#if EVENTS_COROUTINES_PRESENT || defined(DOXYGEN_ONLY)
+
+#include <coroutine>
+#include <exception>
+#include <new>
+#include <utility>
+
+namespace events {
+/** \addtogroup events-public-api
+ * @{
+ */
+
+/** EventTask
+ *
+ *  Coroutine running on an event queue, for C++20 builds. Builds without
+ *  coroutine support can use EventFlow instead.
+ *
+ *  A function returning EventTask is suspended until started on a queue,
+ *  then every co_await returns to the dispatch loop and the coroutine is
+ *  resumed by the queue. Its frame is allocated from the heap and freed
+ *  when the coroutine finishes.
+ *
+ * @code
+ *  EventTask exchange(EventQueue *queue, TCPSocket *socket, EventSignal *readable)
+ *  {
+ *      char reply[16];
+ *      socket->send("ping", 4);
+ *      while (socket->recv(reply, sizeof reply) == NSAPI_ERROR_WOULD_BLOCK) {
+ *          co_await *readable;
+ *      }
+ *      co_await sleep_for(queue, 1s);
+ *  }
+ *
+ *  exchange(queue, &socket, &readable).start(queue);
+ * @endcode
+ */
+class EventTask {
+public:
+    struct promise_type {
+        EventTask get_return_object()
+        {
+            return EventTask(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+
+        static EventTask get_return_object_on_allocation_failure()
+        {
+            return EventTask();
+        }
+
+        void *operator new(std::size_t size) noexcept
+        {
+            return ::operator new(size, std::nothrow);
+        }
+
+        void operator delete(void *p)
+        {
+            ::operator delete(p);
+        }
+
+        std::suspend_always initial_suspend() noexcept
+        {
+            return {};
+        }
+
+        std::suspend_never final_suspend() noexcept
+        {
+            return {};
+        }
+
+        void return_void()
+        {
+        }
+
+        void unhandled_exception()
+        {
+            std::terminate();
+        }
+    };
+
+    EventTask(EventTask &&other) : _handle(std::exchange(other._handle, nullptr))
+    {
+    }
+
+    EventTask &operator=(EventTask &&other)
+    {
+        if (this != &other) {
+            this->~EventTask();
+            _handle = std::exchange(other._handle, nullptr);
+        }
+        return *this;
+    }
+
+    /** Destroy a task that never started
+     */
+    ~EventTask()
+    {
+        if (_handle) {
+            _handle.destroy();
+        }
+    }
+
+    /** Start the coroutine on the queue
+     *
+     *  The coroutine then owns itself and is freed when it finishes.
+     *
+     *  @param queue    Event queue to start the coroutine on
+     *  @return         False if the coroutine frame could not be allocated,
+     *                  the task was already started, or the queue is out of
+     *                  memory
+     */
+    bool start(EventQueue *queue)
+    {
+        if (!_handle) {
+            return false;
+        }
+
+        std::coroutine_handle<> handle = _handle;
+        if (!queue->call([handle] { handle.resume(); })) {
+            return false;
+        }
+        _handle = nullptr;
+        return true;
+    }
+
+private:
+    EventTask() : _handle(nullptr)
+    {
+    }
+
+    explicit EventTask(std::coroutine_handle<promise_type> handle) : _handle(handle)
+    {
+    }
+
+    std::coroutine_handle<promise_type> _handle;
+};
+
+/** Awaitable resuming the coroutine on a queue after a delay
+ *
+ *  @param queue    Event queue to resume on
+ *  @param d        Delay before resuming, expressed as a Chrono duration
+ *  @return         Awaitable for co_await
+ */
+inline auto sleep_for(EventQueue *queue, EventQueue::duration d)
+{
+    struct awaiter {
+        EventQueue *queue;
+        EventQueue::duration d;
+
+        bool await_ready() const noexcept
+        {
+            return false;
+        }
+
+        void await_suspend(std::coroutine_handle<> handle)
+        {
+            MBED_UNUSED int id = queue->call_in(d, [handle] { handle.resume(); });
+            MBED_ASSERT(id);
+        }
+
+        void await_resume() const noexcept
+        {
+        }
+    };
+
+    return awaiter{queue, d};
+}
+
+/** Awaitable moving the coroutine onto a queue
+ *
+ *  Also lets other events on the queue run before continuing.
+ *
+ *  @param queue    Event queue to resume on
+ *  @return         Awaitable for co_await
+ */
+inline auto resume_on(EventQueue *queue)
+{
+    return sleep_for(queue, EventQueue::duration(0));
+}
+
+/** Awaitable resuming the coroutine on a queue once a condition holds
+ *
+ *  Suited to state without a notification, for example
+ *  co_await wait_until(queue, [&] { return flags.get() & READY; }, 10ms)
+ *  on an rtos::EventFlags.
+ *
+ *  @param queue    Event queue to check the condition and resume on
+ *  @param cond     Condition, checked every interval
+ *  @param interval Time between checks, expressed as a Chrono duration
+ *  @return         Awaitable for co_await
+ */
+template <typename F>
+auto wait_until(EventQueue *queue, F cond, EventQueue::duration interval)
+{
+    struct awaiter {
+        EventQueue *queue;
+        F cond;
+        EventQueue::duration interval;
+
+        bool await_ready()
+        {
+            return cond();
+        }
+
+        void await_suspend(std::coroutine_handle<> handle)
+        {
+            poll(queue, cond, interval, handle);
+        }
+
+        void await_resume() const noexcept
+        {
+        }
+
+        static void poll(EventQueue *queue, F cond, EventQueue::duration interval,
+                         std::coroutine_handle<> handle)
+        {
+            MBED_UNUSED int id = queue->call_in(interval, [queue, cond, interval, handle] {
+                if (cond()) {
+                    handle.resume();
+                } else {
+                    poll(queue, cond, interval, handle);
+                }
+            });
+            MBED_ASSERT(id);
+        }
+    };
+
+    return awaiter{queue, std::move(cond), interval};
+}
+
+/** Awaitable resuming the coroutine once the signal is notified
+ *
+ *  The coroutine resumes on the signal's queue.
+ *
+ *  @param signal   Signal to wait for
+ *  @return         Awaitable for co_await
+ */
+inline auto operator co_await(EventSignal &signal)
+{
+    struct awaiter {
+        EventSignal &signal;
+
+        bool await_ready() const noexcept
+        {
+            return false;
+        }
+
+        void await_suspend(std::coroutine_handle<> handle)
+        {
+            signal.wait([handle] { handle.resume(); });
+        }
+
+        void await_resume() const noexcept
+        {
+        }
+    };
+
+    return awaiter{signal};
+}
+
+/** @}*/
+}
+
+#endif // EVENTS_COROUTINES_PRESENT || defined(DOXYGEN_ONLY)
+
+#endif
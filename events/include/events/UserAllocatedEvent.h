@@ -228,6 +228,34 @@ public:
         _period = period;
     }
 
+    /** Configure the priority of an event
+     *
+     *  When several events are ready, events with a higher priority
+     *  are dispatched first.
+     *
+     *  @param priority Priority from 0 (default) to EQUEUE_PRIORITY_LEVELS-1
+     */
+    void priority(int priority)
+    {
+        MBED_ASSERT(!_post_ref);
+        equeue_event_priority(&_e + 1, priority);
+    }
+
+#if EQUEUE_DISPATCH_POOL
+    /** Configure the affinity key of an event
+     *
+     *  Events with the same non-zero key never run concurrently when the
+     *  queue is dispatched by several threads.
+     *
+     *  @param key      Affinity key, 0 for none
+     */
+    void affinity(unsigned key)
+    {
+        MBED_ASSERT(!_post_ref);
+        equeue_event_affinity(&_e + 1, key);
+    }
+#endif
+
     /** Cancels posted event
      *
      *  Attempts to cancel posted event. It is safe to call
@@ -291,7 +319,7 @@ private:
 
     constexpr static equeue_event get_default_equeue_event()
     {
-        return equeue_event{ 0, 0, 0, NULL, NULL, NULL, 0, -1, &UserAllocatedEvent::event_dtor, NULL };
+        return equeue_event{ 0, 0, 0, 0, NULL, NULL, NULL, 0, -1, &UserAllocatedEvent::event_dtor, NULL };
     }
 
 public:
@@ -35,6 +35,102 @@ extern "C" {
  * @{
  */
 
+// Timer wheel backend
+//
+// By default scheduled events are kept in a list sorted by deadline, so
+// posting an event is linear in the number of distinct deadlines. Defining
+// EQUEUE_TIMER_WHEEL to 1 keeps them in a hierarchical timer wheel instead,
+// making posting and cancelling constant time at the cost of a fixed table
+// of EQUEUE_WHEEL_LEVELS * 2^EQUEUE_WHEEL_BITS pointers in each queue.
+//
+// Each level covers EQUEUE_WHEEL_BITS more bits of the tick. Events beyond
+// the range of the wheel are kept in its last slot and placed again as the
+// wheel turns.
+#if !defined(EQUEUE_TIMER_WHEEL) && defined(MBED_CONF_EVENTS_USE_TIMER_WHEEL)
+#define EQUEUE_TIMER_WHEEL MBED_CONF_EVENTS_USE_TIMER_WHEEL
+#endif
+
+#if EQUEUE_TIMER_WHEEL
+#ifndef EQUEUE_WHEEL_BITS
+#define EQUEUE_WHEEL_BITS 5
+#endif
+
+#ifndef EQUEUE_WHEEL_LEVELS
+#define EQUEUE_WHEEL_LEVELS 4
+#endif
+
+#if EQUEUE_WHEEL_BITS > 5 || EQUEUE_WHEEL_BITS * EQUEUE_WHEEL_LEVELS > 30
+#error "EQUEUE_WHEEL_BITS must be at most 5 and cover at most 30 bits of the tick"
+#endif
+
+#define EQUEUE_WHEEL_SLOTS (1 << EQUEUE_WHEEL_BITS)
+#endif
+
+// Event priorities
+//
+// When several events are due in the same dispatch pass, events with a higher
+// priority are dispatched first. Events of the same priority keep their
+// deadline and posting order. Priorities range from 0, the default, up to
+// EQUEUE_PRIORITY_LEVELS-1.
+//
+// A long running event is not preempted, so priorities only reduce the
+// latency of events that are already waiting to be dispatched.
+#if !defined(EQUEUE_PRIORITY_LEVELS) && defined(MBED_CONF_EVENTS_PRIORITY_LEVELS)
+#define EQUEUE_PRIORITY_LEVELS MBED_CONF_EVENTS_PRIORITY_LEVELS
+#endif
+
+#ifndef EQUEUE_PRIORITY_LEVELS
+#define EQUEUE_PRIORITY_LEVELS 4
+#endif
+
+#if EQUEUE_PRIORITY_LEVELS < 1 || EQUEUE_PRIORITY_LEVELS > 256
+#error "EQUEUE_PRIORITY_LEVELS must be between 1 and 256"
+#endif
+
+// Shared dispatch
+//
+// Defining EQUEUE_DISPATCH_POOL to 1 lets several threads dispatch the same
+// queue with equeue_dispatch_shared. Each dispatcher takes one event at a
+// time, so independent events run concurrently in every dispatching thread.
+//
+// Events given the same affinity key never run concurrently and run in the
+// order they became due. Key 0, the default, means no affinity. Keys are
+// hashed into EQUEUE_AFFINITY_KEYS buckets, so unrelated keys may
+// occasionally be serialized with each other.
+#if !defined(EQUEUE_DISPATCH_POOL) && defined(MBED_CONF_EVENTS_DISPATCH_POOL)
+#define EQUEUE_DISPATCH_POOL MBED_CONF_EVENTS_DISPATCH_POOL
+#endif
+
+#if EQUEUE_DISPATCH_POOL
+#ifndef EQUEUE_AFFINITY_KEYS
+#define EQUEUE_AFFINITY_KEYS 32
+#endif
+
+#if EQUEUE_AFFINITY_KEYS < 1 || EQUEUE_AFFINITY_KEYS > 255
+#error "EQUEUE_AFFINITY_KEYS must be between 1 and 255"
+#endif
+#endif
+
+// Dispatch statistics
+//
+// Defining EQUEUE_STATS to 1, or enabling MBED_EVENTS_STATS_ENABLED or
+// MBED_ALL_STATS_ENABLED, makes each queue record how long events wait
+// between being due and being dispatched, and how long they run, in
+// histograms of EQUEUE_STATS_BUCKETS power of two buckets of milliseconds.
+#if !defined(EQUEUE_STATS) && (defined(MBED_EVENTS_STATS_ENABLED) || defined(MBED_ALL_STATS_ENABLED))
+#define EQUEUE_STATS 1
+#endif
+
+#if EQUEUE_STATS
+#ifndef EQUEUE_STATS_BUCKETS
+#define EQUEUE_STATS_BUCKETS 8
+#endif
+
+#if EQUEUE_STATS_BUCKETS < 2 || EQUEUE_STATS_BUCKETS > 32
+#error "EQUEUE_STATS_BUCKETS must be between 2 and 32"
+#endif
+#endif
+
 // The minimum size of an event
 // This size is guaranteed to fit events created by event_call
 #define EQUEUE_EVENT_SIZE (sizeof(struct equeue_event) + 2*sizeof(void*))
@@ -44,6 +140,7 @@ struct equeue_event {
     unsigned size;
     uint16_t generation;
     uint8_t id;
+    uint8_t priority;
 
     struct equeue_event *next;
     struct equeue_event *sibling;
@@ -54,12 +151,36 @@ struct equeue_event {
     void (*dtor)(void *);
 
     void (*cb)(void *);
+#if EQUEUE_DISPATCH_POOL
+    uint8_t affinity;
+#endif
     // data follows
 };
 
+#if EQUEUE_STATS
+// Dispatch statistics of a queue
+//
+// Bucket 0 of each histogram counts events taking 0ms, bucket i counts
+// [2^(i-1), 2^i) ms and the last bucket counts everything longer.
+//
+// The slowest callback is the function run by the queue. For events posted
+// from C++ this is a per callable type trampoline, slowest_data then points
+// to the stored callable and its arguments.
+typedef struct equeue_stats {
+    unsigned dispatched;                    // Number of events dispatched since reset
+    unsigned lag_max;                       // Longest wait from due to dispatched, in ms
+    unsigned runtime_max;                   // Longest run time, in ms
+    void (*slowest_cb)(void *);             // Callback of the longest running event
+    void *slowest_data;                     // Data of the longest running event
+    unsigned lag[EQUEUE_STATS_BUCKETS];     // Histogram of waits from due to dispatched
+    unsigned runtime[EQUEUE_STATS_BUCKETS]; // Histogram of run times
+} equeue_stats_t;
+#endif
+
 // Event queue structure
 typedef struct equeue {
     struct equeue_event *queue;
+    struct equeue_event *pending;
     unsigned tick;
 
     uint16_t generation;
@@ -81,6 +202,27 @@ typedef struct equeue {
         void *timer;
     } background;
 
+#if EQUEUE_TIMER_WHEEL
+    struct equeue_wheel {
+        unsigned tick;
+        struct equeue_event *due;
+        uint32_t occupied[EQUEUE_WHEEL_LEVELS];
+        struct equeue_event *slots[EQUEUE_WHEEL_LEVELS][EQUEUE_WHEEL_SLOTS];
+    } wheel;
+#endif
+
+#if EQUEUE_DISPATCH_POOL
+    struct equeue_pool {
+        struct equeue_event *ready;
+        unsigned dispatchers;
+        uint32_t busy[(EQUEUE_AFFINITY_KEYS + 31) / 32];
+    } pool;
+#endif
+
+#if EQUEUE_STATS
+    equeue_stats_t stats;
+#endif
+
     equeue_sema_t eventsema;
     equeue_mutex_t queuelock;
     equeue_mutex_t memlock;
@@ -113,12 +255,34 @@ void equeue_destroy(equeue_t *queue);
 // equeue_dispatch does not wait and is irq safe.
 void equeue_dispatch(equeue_t *queue, int ms);
 
+#if EQUEUE_DISPATCH_POOL
+// Dispatch events from one of several threads
+//
+// Behaves like equeue_dispatch, but may be called concurrently from any
+// number of threads, each of which takes one ready event at a time. An event
+// canceled before a dispatcher has taken it does not run and equeue_cancel
+// returns true. equeue_break stops every thread dispatching the queue.
+//
+// A queue must not be dispatched by equeue_dispatch and
+// equeue_dispatch_shared at the same time.
+void equeue_dispatch_shared(equeue_t *queue, int ms);
+#endif
+
 // Break out of a running event loop
 //
 // Forces the specified event queue's dispatch loop to terminate. Pending
 // events may finish executing, but no new events will be executed.
 void equeue_break(equeue_t *queue);
 
+#if EQUEUE_STATS
+// Dispatch statistics
+//
+// equeue_stats_get copies the statistics recorded since the queue was created
+// or since the last equeue_stats_reset. Both functions are irq safe.
+void equeue_stats_get(equeue_t *queue, equeue_stats_t *stats);
+void equeue_stats_reset(equeue_t *queue);
+#endif
+
 // Simple event calls
 //
 // The specified callback will be executed in the context of the event queue's
@@ -163,9 +327,19 @@ void equeue_dealloc(equeue_t *queue, void *event);
 // equeue_event_delay  - Millisecond delay before dispatching an event
 // equeue_event_period - Millisecond period for repeating dispatching an event
 // equeue_event_dtor   - Destructor to run when the event is deallocated
+// equeue_event_priority - Dispatch priority, clamped to EQUEUE_PRIORITY_LEVELS
 void equeue_event_delay(void *event, int ms);
 void equeue_event_period(void *event, int ms);
 void equeue_event_dtor(void *event, void (*dtor)(void *));
+void equeue_event_priority(void *event, int priority);
+
+#if EQUEUE_DISPATCH_POOL
+// Serialize an allocated event with other events of the same key
+//
+// Events sharing a non-zero affinity key are never dispatched concurrently
+// by equeue_dispatch_shared and run in the order they became due.
+void equeue_event_affinity(void *event, unsigned key);
+#endif
 
 // Post an event onto the event queue
 //
@@ -175,7 +349,10 @@ void equeue_event_dtor(void *event, void (*dtor)(void *));
 // as its argument.
 //
 // The equeue_post function is irq safe and can act as a mechanism for
-// moving events out of irq contexts.
+// moving events out of irq contexts. Unless the queue is chained or has a
+// background timer, posting doesn't take the queue lock; the event is pushed
+// onto a pending list with an atomic operation and the dispatch loop sorts
+// it into the queue.
 //
 // The return value is a unique id that represents the posted event and can
 // be passed to equeue_cancel.
@@ -189,7 +366,8 @@ int equeue_post(equeue_t *queue, void (*cb)(void *), void *event);
 // event as its argument.
 //
 // The equeue_post_user_allocated function is irq safe and can act as
-// a mechanism for moving events out of irq contexts.
+// a mechanism for moving events out of irq contexts. As no allocation is
+// needed, it doesn't lock at all under the same conditions as equeue_post.
 void equeue_post_user_allocated(equeue_t *queue, void (*cb)(void *), void *event);
 
 // Cancel an in-flight event
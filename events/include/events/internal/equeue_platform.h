@@ -97,6 +97,21 @@ void equeue_mutex_lock(equeue_mutex_t *mutex);
 void equeue_mutex_unlock(equeue_mutex_t *mutex);
 
 
+// Platform atomic operations
+//
+// Used to post events without taking the queue lock, so both must be safe
+// in interrupt contexts and act as full memory barriers.
+//
+// The equeue_atomic_cas_ptr stores desired in ptr if it still contains
+// *expected and returns true. Otherwise it updates *expected with the
+// current value and returns false.
+//
+// The equeue_atomic_exchange_ptr stores desired in ptr and returns the
+// previous value.
+bool equeue_atomic_cas_ptr(void *volatile *ptr, void **expected, void *desired);
+void *equeue_atomic_exchange_ptr(void *volatile *ptr, void *desired);
+
+
 // Platform semaphore type
 //
 // The equeue library requires a binary semaphore type that can be safely
@@ -21,6 +21,9 @@
 #include "events/EventQueue.h"
 #include "events/Event.h"
 #include "events/UserAllocatedEvent.h"
+#include "events/EventSignal.h"
+#include "events/EventFlow.h"
+#include "events/EventTask.h"
 
 #include "events/mbed_shared_queues.h"
 
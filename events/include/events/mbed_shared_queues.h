@@ -19,6 +19,17 @@
 
 #include "events/EventQueue.h"
 
+/** Number of threads dispatching the normal shared event queue. More than
+ *  one requires the events.dispatch-pool option, the threads then share the
+ *  queue with EventQueue::dispatch_shared_forever. */
+#ifndef MBED_CONF_EVENTS_SHARED_DISPATCH_THREADS
+#define MBED_CONF_EVENTS_SHARED_DISPATCH_THREADS 1
+#endif
+
+#if MBED_CONF_EVENTS_SHARED_DISPATCH_THREADS > 1 && !EQUEUE_DISPATCH_POOL
+#error "events.shared-dispatch-threads above 1 requires events.dispatch-pool"
+#endif
+
 namespace mbed {
 /** \addtogroup events-public-api */
 /** @{*/
@@ -38,6 +49,11 @@ namespace mbed {
  * such, users can expect that event latency will typically be 10ms or less,
  * but could occasionally be significantly higher if many events are queued.
  *
+ * If `events.shared-dispatch-threads` is above 1, that many threads dispatch
+ * the queue, each with its own stack of `events.shared-stacksize`, so a long
+ * event only holds up one of them. Use EventQueue::call_with_affinity for
+ * events that must not run concurrently with each other.
+ *
  * If an RTOS is not present or the configuration option
  * `events.shared-dispatch-from-application` is set to true, then this
  * does not create a dedicated dispatch thread - instead the application is
@@ -61,6 +61,18 @@ void EventQueue::dispatch_once()
     return equeue_dispatch(&_equeue, 0);
 }
 
+#if EQUEUE_DISPATCH_POOL
+void EventQueue::dispatch_shared_for(duration ms)
+{
+    return equeue_dispatch_shared(&_equeue, ms.count());
+}
+
+void EventQueue::dispatch_shared_forever()
+{
+    return equeue_dispatch_shared(&_equeue, -1);
+}
+#endif
+
 void EventQueue::break_dispatch()
 {
     return equeue_break(&_equeue);
@@ -100,4 +112,16 @@ int EventQueue::chain(EventQueue *target)
         return equeue_chain(&_equeue, 0);
     }
 }
+
+#if EQUEUE_STATS
+void EventQueue::get_stats(equeue_stats_t *stats)
+{
+    equeue_stats_get(&_equeue, stats);
+}
+
+void EventQueue::reset_stats()
+{
+    equeue_stats_reset(&_equeue);
+}
+#endif
 }
@@ -56,6 +56,9 @@ static inline void equeue_incid(equeue_t *q, struct equeue_event *e)
 }
 
 
+static void equeue_drain(equeue_t *q);
+
+
 // equeue lifetime management
 int equeue_create(equeue_t *q, size_t size)
 {
@@ -96,6 +99,7 @@ int equeue_create_inplace(equeue_t *q, size_t size, void *buffer)
     q->slab.data = q->buffer;
 
     q->queue = 0;
+    q->pending = 0;
     equeue_tick_init();
     q->tick = equeue_tick();
     q->generation = 0;
@@ -105,6 +109,19 @@ int equeue_create_inplace(equeue_t *q, size_t size, void *buffer)
     q->background.update = 0;
     q->background.timer = 0;
 
+#if EQUEUE_TIMER_WHEEL
+    memset(&q->wheel, 0, sizeof(q->wheel));
+    q->wheel.tick = q->tick;
+#endif
+
+#if EQUEUE_DISPATCH_POOL
+    memset(&q->pool, 0, sizeof(q->pool));
+#endif
+
+#if EQUEUE_STATS
+    memset(&q->stats, 0, sizeof(q->stats));
+#endif
+
     // initialize platform resources
     int err;
     err = equeue_sema_create(&q->eventsema);
@@ -127,7 +144,27 @@ int equeue_create_inplace(equeue_t *q, size_t size, void *buffer)
 
 void equeue_destroy(equeue_t *q)
 {
+    equeue_mutex_lock(&q->queuelock);
+    equeue_drain(q);
+    equeue_mutex_unlock(&q->queuelock);
+
     // call destructors on pending events
+#if EQUEUE_TIMER_WHEEL
+    for (struct equeue_event *e = q->wheel.due; e; e = e->next) {
+        if (e->dtor) {
+            e->dtor(e + 1);
+        }
+    }
+    for (unsigned k = 0; k < EQUEUE_WHEEL_LEVELS; k++) {
+        for (unsigned i = 0; i < EQUEUE_WHEEL_SLOTS; i++) {
+            for (struct equeue_event *e = q->wheel.slots[k][i]; e; e = e->next) {
+                if (e->dtor) {
+                    e->dtor(e + 1);
+                }
+            }
+        }
+    }
+#else
     for (struct equeue_event *es = q->queue; es; es = es->next) {
         for (struct equeue_event *e = es->sibling; e; e = e->sibling) {
             if (e->dtor) {
@@ -138,6 +175,14 @@ void equeue_destroy(equeue_t *q)
             es->dtor(es + 1);
         }
     }
+#endif
+#if EQUEUE_DISPATCH_POOL
+    for (struct equeue_event *e = q->pool.ready; e; e = e->next) {
+        if (e->dtor) {
+            e->dtor(e + 1);
+        }
+    }
+#endif
     // notify background timer
     if (q->background.update) {
         q->background.update(q->background.timer, -1);
@@ -224,6 +269,10 @@ void *equeue_alloc(equeue_t *q, size_t size)
     e->target = 0;
     e->period = -1;
     e->dtor = 0;
+    e->priority = 0;
+#if EQUEUE_DISPATCH_POOL
+    e->affinity = 0;
+#endif
 
     return e + 1;
 }
@@ -243,13 +292,203 @@ void equeue_dealloc(equeue_t *q, void *p)
     }
 }
 
-void equeue_enqueue(equeue_t *q, struct equeue_event *e, unsigned tick)
+#if EQUEUE_TIMER_WHEEL
+#define EQUEUE_WHEEL_MASK (EQUEUE_WHEEL_SLOTS - 1)
+#define EQUEUE_WHEEL_RANGE (1u << (EQUEUE_WHEEL_BITS * EQUEUE_WHEEL_LEVELS))
+
+// timer wheel, each level splits the tick into blocks of 2^(bits*level)
+// ticks, and an event sits in the slot of the block its target falls in,
+// at the lowest level that can still tell it apart from the current block
+static void equeue_wheel_insert(equeue_t *q, struct equeue_event *e)
 {
-    e->target = tick + equeue_clampdiff(e->target, tick);
-    e->generation = q->generation;
+    struct equeue_event **p;
+    int delta = equeue_tickdiff(e->target, q->wheel.tick);
 
-    equeue_mutex_lock(&q->queuelock);
+    if (delta < 0) {
+        // the wheel already turned past the target
+        p = &q->wheel.due;
+    } else {
+        if ((unsigned)delta >= EQUEUE_WHEEL_RANGE) {
+            // out of range, park in the furthest slot until it cascades
+            delta = EQUEUE_WHEEL_RANGE - 1;
+        }
+
+        unsigned level = 0;
+        while ((unsigned)delta >> (EQUEUE_WHEEL_BITS * (level + 1))) {
+            level += 1;
+        }
+
+        unsigned index = ((q->wheel.tick + delta) >> (EQUEUE_WHEEL_BITS * level)) & EQUEUE_WHEEL_MASK;
+        p = &q->wheel.slots[level][index];
+        q->wheel.occupied[level] |= 1u << index;
+    }
+
+    e->next = *p;
+    if (e->next) {
+        e->next->ref = &e->next;
+    }
+    e->sibling = 0;
+
+    *p = e;
+    e->ref = p;
+}
+
+static void equeue_wheel_remove(equeue_t *q, struct equeue_event *e)
+{
+    *e->ref = e->next;
+    if (e->next) {
+        e->next->ref = e->ref;
+    }
+
+    // mark the slot empty if this was its last event
+    uintptr_t slot = (uintptr_t)e->ref - (uintptr_t)q->wheel.slots;
+    if (!*e->ref && slot < sizeof(q->wheel.slots)) {
+        unsigned i = slot / sizeof(struct equeue_event *);
+        q->wheel.occupied[i / EQUEUE_WHEEL_SLOTS] &= ~(1u << (i % EQUEUE_WHEEL_SLOTS));
+    }
+}
+
+// find the next tick where a slot either expires or cascades down a level
+static bool equeue_wheel_next(equeue_t *q, unsigned *next)
+{
+    unsigned tick = q->wheel.tick;
+    unsigned best = EQUEUE_WHEEL_RANGE;
+    bool found = false;
+    for (unsigned level = 0; level < EQUEUE_WHEEL_LEVELS; level++) {
+        uint32_t occupied = q->wheel.occupied[level];
+        if (!occupied) {
+            continue;
+        }
+
+        // the current block has already cascaded unless we're at its start
+        unsigned shift = EQUEUE_WHEEL_BITS * level;
+        unsigned block = tick >> shift;
+        unsigned first = (tick & ((1u << shift) - 1)) ? 1 : 0;
+
+        for (unsigned d = first; d < first + EQUEUE_WHEEL_SLOTS; d++) {
+            if (occupied & (1u << ((block + d) & EQUEUE_WHEEL_MASK))) {
+                unsigned dist = ((block + d) << shift) - tick;
+                if (dist < best) {
+                    best = dist;
+                }
+                found = true;
+                break;
+            }
+        }
+    }
+
+    *next = tick + best;
+    return found;
+}
+
+// take all the events out of a list, oldest first
+static struct equeue_event *equeue_wheel_take(struct equeue_event **p)
+{
+    struct equeue_event *es = *p;
+    *p = 0;
+
+    // slots are filled at the head
+    struct equeue_event *prev = 0;
+    while (es) {
+        struct equeue_event *e = es;
+        es = e->next;
+        e->next = prev;
+        prev = e;
+    }
+
+    return prev;
+}
+
+static struct equeue_event *equeue_wheel_take_slot(equeue_t *q, unsigned level, unsigned index)
+{
+    q->wheel.occupied[level] &= ~(1u << index);
+    return equeue_wheel_take(&q->wheel.slots[level][index]);
+}
+
+static struct equeue_event *equeue_wheel_expire(equeue_t *q, unsigned target)
+{
+    struct equeue_event *head = equeue_wheel_take(&q->wheel.due);
+    struct equeue_event **tail = &head;
+    while (*tail) {
+        tail = &(*tail)->next;
+    }
+
+    unsigned tick;
+    while (equeue_wheel_next(q, &tick) && equeue_tickdiff(tick, target) <= 0) {
+        q->wheel.tick = tick;
+
+        // move blocks starting at this tick down, from the top so events
+        // can fall through several levels
+        for (unsigned level = EQUEUE_WHEEL_LEVELS - 1; level > 0; level--) {
+            unsigned shift = EQUEUE_WHEEL_BITS * level;
+            if (tick & ((1u << shift) - 1)) {
+                continue;
+            }
+
+            struct equeue_event *es = equeue_wheel_take_slot(q, level, (tick >> shift) & EQUEUE_WHEEL_MASK);
+            while (es) {
+                struct equeue_event *e = es;
+                es = e->next;
+                equeue_wheel_insert(q, e);
+            }
+        }
+
+        *tail = equeue_wheel_take_slot(q, 0, tick & EQUEUE_WHEEL_MASK);
+        while (*tail) {
+            tail = &(*tail)->next;
+        }
+
+        q->wheel.tick = tick + 1;
+    }
+
+    // nothing else happens before the target
+    if (equeue_tickdiff(q->wheel.tick, target) <= 0) {
+        q->wheel.tick = target + 1;
+    }
+
+    return head;
+}
+#endif
+
+// find the tick the dispatch loop needs to wake up at, must be called with
+// the queuelock held
+static bool equeue_queue_next(equeue_t *q, unsigned *target)
+{
+#if EQUEUE_TIMER_WHEEL
+    if (q->wheel.due) {
+        *target = q->wheel.due->target;
+        return true;
+    }
+
+    return equeue_wheel_next(q, target);
+#else
+    if (!q->queue) {
+        return false;
+    }
+
+    *target = q->queue->target;
+    return true;
+#endif
+}
 
+// insert an event into the scheduled events, returns true if it changed
+// the next deadline, must be called with the queuelock held
+static bool equeue_queue_insert(equeue_t *q, struct equeue_event *e)
+{
+#if EQUEUE_TIMER_WHEEL
+    // finding the next deadline isn't free, and only the background timer
+    // cares if it moved
+    if (!(q->background.update && q->background.active)) {
+        equeue_wheel_insert(q, e);
+        return false;
+    }
+
+    unsigned before, after;
+    bool had_next = equeue_queue_next(q, &before);
+    equeue_wheel_insert(q, e);
+    equeue_queue_next(q, &after);
+    return !had_next || before != after;
+#else
     // find the event slot
     struct equeue_event **p = &q->queue;
     while (*p && equeue_tickdiff((*p)->target, e->target) < 0) {
@@ -276,15 +515,104 @@ void equeue_enqueue(equeue_t *q, struct equeue_event *e, unsigned tick)
     *p = e;
     e->ref = p;
 
+    return q->queue == e && !e->sibling;
+#endif
+}
+
+// remove a scheduled event, must be called with the queuelock held
+static void equeue_queue_remove(equeue_t *q, struct equeue_event *e)
+{
+#if EQUEUE_TIMER_WHEEL
+    equeue_wheel_remove(q, e);
+#else
+    if (e->sibling) {
+        e->sibling->next = e->next;
+        if (e->sibling->next) {
+            e->sibling->next->ref = &e->sibling->next;
+        }
+
+        *e->ref = e->sibling;
+        e->sibling->ref = e->ref;
+    } else {
+        *e->ref = e->next;
+        if (e->next) {
+            e->next->ref = e->ref;
+        }
+    }
+#endif
+}
+
+void equeue_enqueue(equeue_t *q, struct equeue_event *e, unsigned tick)
+{
+    e->target = tick + equeue_clampdiff(e->target, tick);
+    e->generation = q->generation;
+
+    equeue_mutex_lock(&q->queuelock);
+
+    bool changed = equeue_queue_insert(q, e);
+
     // notify background timer
+    unsigned next;
     if ((q->background.update && q->background.active) &&
-            (q->queue == e && !e->sibling)) {
+            changed && equeue_queue_next(q, &next)) {
         q->background.update(q->background.timer,
-                             equeue_clampdiff(e->target, tick));
+                             equeue_clampdiff(next, tick));
     }
     equeue_mutex_unlock(&q->queuelock);
 }
 
+// move events posted without the lock into the queue, must be called
+// with the queuelock held
+static void equeue_drain(equeue_t *q)
+{
+    struct equeue_event *es = (struct equeue_event *)
+                              equeue_atomic_exchange_ptr((void *volatile *)&q->pending, 0);
+    if (!es) {
+        return;
+    }
+
+    // the pending list is in reverse post order
+    struct equeue_event *prev = 0;
+    while (es) {
+        struct equeue_event *next = es->next;
+        es->next = prev;
+        prev = es;
+        es = next;
+    }
+
+    unsigned tick = equeue_tick();
+    while (prev) {
+        struct equeue_event *e = prev;
+        prev = e->next;
+        equeue_enqueue(q, e, tick);
+    }
+}
+
+// enqueue a newly posted event
+static void equeue_post_event(equeue_t *q, struct equeue_event *e, unsigned tick)
+{
+    // a background timer has to be updated under the lock, otherwise only
+    // the dispatch loop looks at the queue and can sort the event in later.
+    // equeue_enqueue checks the timer again under the lock
+    if (q->background.update) {
+        equeue_enqueue(q, e, tick);
+        return;
+    }
+
+    void *head = q->pending;
+    do {
+        e->next = (struct equeue_event *)head;
+    } while (!equeue_atomic_cas_ptr((void *volatile *)&q->pending, &head, e));
+
+    // equeue_background sets the timer before it drains the list, so if the
+    // timer was set meanwhile, either it drained this event or it is seen here
+    if (q->background.update) {
+        equeue_mutex_lock(&q->queuelock);
+        equeue_drain(q);
+        equeue_mutex_unlock(&q->queuelock);
+    }
+}
+
 // equeue scheduling functions
 static int equeue_event_id(equeue_t *q, struct equeue_event *e)
 {
@@ -295,31 +623,31 @@ static int equeue_event_id(equeue_t *q, struct equeue_event *e)
 static struct equeue_event *equeue_unqueue_by_address(equeue_t *q, struct equeue_event *e)
 {
     equeue_mutex_lock(&q->queuelock);
+    // the event may still be on the pending list
+    equeue_drain(q);
+
     // clear the event and check if already in-flight
     e->cb = 0;
     e->period = -1;
 
     int diff = equeue_tickdiff(e->target, q->tick);
     if (diff < 0 || (diff == 0 && e->generation != q->generation)) {
+#if EQUEUE_DISPATCH_POOL
+        // events waiting for a shared dispatcher have not started yet
+        for (struct equeue_event **p = &q->pool.ready; *p; p = &(*p)->next) {
+            if (*p == e) {
+                *p = e->next;
+                equeue_mutex_unlock(&q->queuelock);
+                return e;
+            }
+        }
+#endif
         equeue_mutex_unlock(&q->queuelock);
         return 0;
     }
 
     // disentangle from queue
-    if (e->sibling) {
-        e->sibling->next = e->next;
-        if (e->sibling->next) {
-            e->sibling->next->ref = &e->sibling->next;
-        }
-
-        *e->ref = e->sibling;
-        e->sibling->ref = e->ref;
-    } else {
-        *e->ref = e->next;
-        if (e->next) {
-            e->next->ref = e->ref;
-        }
-    }
+    equeue_queue_remove(q, e);
     equeue_mutex_unlock(&q->queuelock);
     return e;
 }
@@ -347,9 +675,46 @@ static struct equeue_event *equeue_unqueue_by_id(equeue_t *q, int id)
     return e;
 }
 
+#if EQUEUE_PRIORITY_LEVELS > 1
+// stable partition of the expired events by priority, highest first
+static struct equeue_event *equeue_prioritize(struct equeue_event *head)
+{
+    struct equeue_event *heads[EQUEUE_PRIORITY_LEVELS];
+    struct equeue_event **tails[EQUEUE_PRIORITY_LEVELS];
+    unsigned used = 0;
+    for (unsigned i = 0; i < EQUEUE_PRIORITY_LEVELS; i++) {
+        heads[i] = 0;
+        tails[i] = &heads[i];
+    }
+
+    for (struct equeue_event *e = head; e; e = e->next) {
+        *tails[e->priority] = e;
+        tails[e->priority] = &e->next;
+        used |= (e->priority != 0);
+    }
+
+    // nothing to reorder in the common case
+    if (!used) {
+        return head;
+    }
+
+    struct equeue_event **tail = &head;
+    for (int i = EQUEUE_PRIORITY_LEVELS - 1; i >= 0; i--) {
+        *tail = heads[i];
+        if (heads[i]) {
+            tail = tails[i];
+        }
+    }
+    *tail = 0;
+
+    return head;
+}
+#endif
+
 static struct equeue_event *equeue_dequeue(equeue_t *q, unsigned target)
 {
     equeue_mutex_lock(&q->queuelock);
+    equeue_drain(q);
 
     // find all expired events
 
@@ -357,6 +722,17 @@ static struct equeue_event *equeue_dequeue(equeue_t *q, unsigned target)
         q->tick = target;
     }
 
+#if EQUEUE_TIMER_WHEEL
+    struct equeue_event *head = equeue_wheel_expire(q, target);
+
+    /* we only increment the generation if events have been taken off the queue
+     * as this is the only time cancellation may conflict with dequeueing */
+    if (head) {
+        q->generation += 1;
+    }
+
+    equeue_mutex_unlock(&q->queuelock);
+#else
     struct equeue_event *head = q->queue;
     struct equeue_event **p = &head;
     while (*p && equeue_tickdiff((*p)->target, target) <= 0) {
@@ -394,6 +770,11 @@ static struct equeue_event *equeue_dequeue(equeue_t *q, unsigned target)
         *tail = prev;
         tail = &es->next;
     }
+#endif
+
+#if EQUEUE_PRIORITY_LEVELS > 1
+    head = equeue_prioritize(head);
+#endif
 
     return head;
 }
@@ -405,8 +786,9 @@ int equeue_post(equeue_t *q, void (*cb)(void *), void *p)
     e->cb = cb;
     e->target = tick + e->target;
 
-    equeue_enqueue(q, e, tick);
+    // the id must be taken before the event becomes visible to the dispatcher
     int id = equeue_event_id(q, e);
+    equeue_post_event(q, e, tick);
     equeue_sema_signal(&q->eventsema);
     return id;
 }
@@ -419,7 +801,7 @@ void equeue_post_user_allocated(equeue_t *q, void (*cb)(void *), void *p)
     e->target = tick + e->target;
     e->id = EQUEUE_USER_ALLOCATED_EVENT_STATE_INPROGRESS;
 
-    equeue_enqueue(q, e, tick);
+    equeue_post_event(q, e, tick);
     equeue_sema_signal(&q->eventsema);
 }
 
@@ -496,6 +878,71 @@ void equeue_break(equeue_t *q)
     equeue_sema_signal(&q->eventsema);
 }
 
+#if EQUEUE_STATS
+static void ecallback_unwrap(void (**cb)(void *), void **data);
+
+static unsigned equeue_stats_bucket(unsigned ms)
+{
+    unsigned i = 0;
+    while (ms && i < EQUEUE_STATS_BUCKETS - 1) {
+        ms >>= 1;
+        i++;
+    }
+    return i;
+}
+
+static void equeue_stats_record(equeue_t *q, struct equeue_event *e,
+                                void (*cb)(void *), unsigned start, unsigned end)
+{
+    unsigned lag = equeue_clampdiff(start, e->target);
+    unsigned runtime = equeue_clampdiff(end, start);
+
+    equeue_mutex_lock(&q->queuelock);
+    q->stats.dispatched += 1;
+    q->stats.lag[equeue_stats_bucket(lag)] += 1;
+    q->stats.runtime[equeue_stats_bucket(runtime)] += 1;
+    if (lag > q->stats.lag_max) {
+        q->stats.lag_max = lag;
+    }
+    if (runtime > q->stats.runtime_max || !q->stats.slowest_cb) {
+        void *data = e + 1;
+        ecallback_unwrap(&cb, &data);
+        q->stats.runtime_max = runtime;
+        q->stats.slowest_cb = cb;
+        q->stats.slowest_data = data;
+    }
+    equeue_mutex_unlock(&q->queuelock);
+}
+
+void equeue_stats_get(equeue_t *q, equeue_stats_t *stats)
+{
+    equeue_mutex_lock(&q->queuelock);
+    *stats = q->stats;
+    equeue_mutex_unlock(&q->queuelock);
+}
+
+void equeue_stats_reset(equeue_t *q)
+{
+    equeue_mutex_lock(&q->queuelock);
+    memset(&q->stats, 0, sizeof(q->stats));
+    equeue_mutex_unlock(&q->queuelock);
+}
+#endif
+
+// reenqueue periodic events or deallocate
+static void equeue_complete(equeue_t *q, struct equeue_event *e)
+{
+    if (e->period >= 0) {
+        e->target += e->period;
+        equeue_enqueue(q, e, equeue_tick());
+    } else {
+        if (!EQUEUE_IS_USER_ALLOCATED_EVENT(e)) {
+            equeue_incid(q, e);
+        }
+        equeue_dealloc(q, e + 1);
+    }
+}
+
 void equeue_dispatch(equeue_t *q, int ms)
 {
     unsigned tick = equeue_tick();
@@ -514,19 +961,16 @@ void equeue_dispatch(equeue_t *q, int ms)
             // actually dispatch the callbacks
             void (*cb)(void *) = e->cb;
             if (cb) {
+#if EQUEUE_STATS
+                unsigned start = equeue_tick();
+                cb(e + 1);
+                equeue_stats_record(q, e, cb, start, equeue_tick());
+#else
                 cb(e + 1);
+#endif
             }
 
-            // reenqueue periodic events or deallocate
-            if (e->period >= 0) {
-                e->target += e->period;
-                equeue_enqueue(q, e, equeue_tick());
-            } else {
-                if (!EQUEUE_IS_USER_ALLOCATED_EVENT(e)) {
-                    equeue_incid(q, e);
-                }
-                equeue_dealloc(q, e + 1);
-            }
+            equeue_complete(q, e);
         }
 
         int deadline = -1;
@@ -539,9 +983,10 @@ void equeue_dispatch(equeue_t *q, int ms)
                 // update background timer if necessary
                 if (q->background.update) {
                     equeue_mutex_lock(&q->queuelock);
-                    if (q->background.update && q->queue) {
+                    unsigned next;
+                    if (q->background.update && equeue_queue_next(q, &next)) {
                         q->background.update(q->background.timer,
-                                             equeue_clampdiff(q->queue->target, tick));
+                                             equeue_clampdiff(next, tick));
                     }
                     q->background.active = true;
                     equeue_mutex_unlock(&q->queuelock);
@@ -553,8 +998,9 @@ void equeue_dispatch(equeue_t *q, int ms)
 
         // find closest deadline
         equeue_mutex_lock(&q->queuelock);
-        if (q->queue) {
-            int diff = equeue_clampdiff(q->queue->target, tick);
+        unsigned next;
+        if (equeue_queue_next(q, &next)) {
+            int diff = equeue_clampdiff(next, tick);
             if ((unsigned)diff < (unsigned)deadline) {
                 deadline = diff;
             }
@@ -580,6 +1026,170 @@ void equeue_dispatch(equeue_t *q, int ms)
     }
 }
 
+#if EQUEUE_DISPATCH_POOL
+// affinity bookkeeping, must be called with the queuelock held
+static bool equeue_affinity_busy(equeue_t *q, uint8_t affinity)
+{
+    unsigned k = affinity - 1u;
+    return affinity && (q->pool.busy[k / 32] & (1u << (k % 32)));
+}
+
+static void equeue_affinity_mark(equeue_t *q, uint8_t affinity, bool busy)
+{
+    unsigned k = affinity - 1u;
+    if (busy) {
+        q->pool.busy[k / 32] |= 1u << (k % 32);
+    } else {
+        q->pool.busy[k / 32] &= ~(1u << (k % 32));
+    }
+}
+
+static bool equeue_ready_runnable(equeue_t *q, struct equeue_event *e)
+{
+    // canceled events can be reclaimed regardless of their affinity
+    return !e->cb || !equeue_affinity_busy(q, e->affinity);
+}
+
+// move expired events into the ready list and take the first one that is
+// allowed to run, setting more if another dispatcher could take one too
+static struct equeue_event *equeue_dequeue_shared(equeue_t *q, unsigned target,
+                                                  bool *owner, bool *more)
+{
+    struct equeue_event *es = equeue_dequeue(q, target);
+
+    equeue_mutex_lock(&q->queuelock);
+
+    // the batch is in priority order, so each event goes after the
+    // previous one and after any ready event of the same or higher priority
+    struct equeue_event **p = &q->pool.ready;
+    while (es) {
+        struct equeue_event *e = es;
+        es = e->next;
+
+        while (*p && (*p)->priority >= e->priority) {
+            p = &(*p)->next;
+        }
+        e->next = *p;
+        *p = e;
+        p = &e->next;
+    }
+
+    struct equeue_event *e = 0;
+    *owner = false;
+    *more = false;
+    for (p = &q->pool.ready; *p; p = &(*p)->next) {
+        if (equeue_ready_runnable(q, *p)) {
+            e = *p;
+            *p = e->next;
+            break;
+        }
+    }
+
+    if (e && e->cb && e->affinity) {
+        equeue_affinity_mark(q, e->affinity, true);
+        *owner = true;
+    }
+
+    for (; *p; p = &(*p)->next) {
+        if (equeue_ready_runnable(q, *p)) {
+            *more = true;
+            break;
+        }
+    }
+
+    equeue_mutex_unlock(&q->queuelock);
+    return e;
+}
+
+void equeue_dispatch_shared(equeue_t *q, int ms)
+{
+    unsigned tick = equeue_tick();
+    unsigned timeout = tick + ms;
+
+    equeue_mutex_lock(&q->queuelock);
+    q->background.active = false;
+    q->pool.dispatchers += 1;
+    equeue_mutex_unlock(&q->queuelock);
+
+    while (1) {
+        bool owner, more;
+        struct equeue_event *e = equeue_dequeue_shared(q, tick, &owner, &more);
+
+        // let another dispatcher pick up the rest
+        if (more) {
+            equeue_sema_signal(&q->eventsema);
+        }
+
+        if (e) {
+            void (*cb)(void *) = e->cb;
+            if (cb) {
+#if EQUEUE_STATS
+                unsigned start = equeue_tick();
+                cb(e + 1);
+                equeue_stats_record(q, e, cb, start, equeue_tick());
+#else
+                cb(e + 1);
+#endif
+            }
+
+            // events that waited on this key can run now, this
+            // dispatcher comes back for them without waiting
+            if (owner) {
+                equeue_mutex_lock(&q->queuelock);
+                equeue_affinity_mark(q, e->affinity, false);
+                equeue_mutex_unlock(&q->queuelock);
+            }
+
+            equeue_complete(q, e);
+        }
+
+        int deadline = -1;
+        tick = equeue_tick();
+
+        // check if we should stop dispatching soon
+        if (ms >= 0) {
+            deadline = equeue_tickdiff(timeout, tick);
+            if (deadline <= 0) {
+                break;
+            }
+        }
+
+        if (!e) {
+            // find closest deadline
+            equeue_mutex_lock(&q->queuelock);
+            unsigned next;
+            if (equeue_queue_next(q, &next)) {
+                int diff = equeue_clampdiff(next, tick);
+                if ((unsigned)diff < (unsigned)deadline) {
+                    deadline = diff;
+                }
+            }
+            equeue_mutex_unlock(&q->queuelock);
+
+            // wait for events
+            equeue_sema_wait(&q->eventsema, deadline);
+            tick = equeue_tick();
+        }
+
+        // a break stays requested until every dispatcher has seen it
+        if (q->break_requested) {
+            break;
+        }
+    }
+
+    equeue_mutex_lock(&q->queuelock);
+    q->pool.dispatchers -= 1;
+    if (q->break_requested) {
+        if (q->pool.dispatchers) {
+            equeue_sema_signal(&q->eventsema);
+        } else {
+            q->break_requested = false;
+        }
+    }
+    equeue_mutex_unlock(&q->queuelock);
+}
+#endif
+
 
 // event functions
 void equeue_event_delay(void *p, int ms)
@@ -600,6 +1210,25 @@ void equeue_event_dtor(void *p, void (*dtor)(void *))
     e->dtor = dtor;
 }
 
+void equeue_event_priority(void *p, int priority)
+{
+    struct equeue_event *e = (struct equeue_event *)p - 1;
+    if (priority < 0) {
+        priority = 0;
+    } else if (priority > EQUEUE_PRIORITY_LEVELS - 1) {
+        priority = EQUEUE_PRIORITY_LEVELS - 1;
+    }
+    e->priority = priority;
+}
+
+#if EQUEUE_DISPATCH_POOL
+void equeue_event_affinity(void *p, unsigned key)
+{
+    struct equeue_event *e = (struct equeue_event *)p - 1;
+    e->affinity = key ? (key - 1) % EQUEUE_AFFINITY_KEYS + 1 : 0;
+}
+#endif
+
 
 // simple callbacks
 struct ecallback {
@@ -613,6 +1242,18 @@ static void ecallback_dispatch(void *p)
     e->cb(e->data);
 }
 
+#if EQUEUE_STATS
+// report the user callback of events posted by equeue_call and friends
+static void ecallback_unwrap(void (**cb)(void *), void **data)
+{
+    if (*cb == ecallback_dispatch) {
+        struct ecallback *e = (struct ecallback *)*data;
+        *cb = e->cb;
+        *data = e->data;
+    }
+}
+#endif
+
 int equeue_call(equeue_t *q, void (*cb)(void *), void *data)
 {
     struct ecallback *e = equeue_alloc(q, sizeof(struct ecallback));
@@ -665,9 +1306,14 @@ void equeue_background(equeue_t *q,
     q->background.update = update;
     q->background.timer = timer;
 
-    if (q->background.update && q->queue) {
+    // events posted before the timer was set must be seen by it, see
+    // equeue_post_event for the ones posted while it is set
+    equeue_drain(q);
+
+    unsigned next;
+    if (q->background.update && equeue_queue_next(q, &next)) {
         q->background.update(q->background.timer,
-                             equeue_clampdiff(q->queue->target, equeue_tick()));
+                             equeue_clampdiff(next, equeue_tick()));
     }
     q->background.active = true;
     equeue_mutex_unlock(&q->queuelock);
@@ -19,6 +19,7 @@
 
 #ifdef MBED_CONF_RTOS_PRESENT
 #include "rtos/Thread.h"
+#include <new>
 using rtos::Thread;
 #endif
 
@@ -52,6 +53,43 @@ EventQueue *do_shared_event_queue_with_thread(const char *name)
 
     return &queue;
 }
+
+#if MBED_CONF_EVENTS_SHARED_DISPATCH_THREADS > 1
+/* As above, with Threads threads sharing the dispatch of the queue.
+ */
+template
+<osPriority Priority, size_t QueueSize, size_t StackSize, size_t Threads>
+EventQueue *do_shared_event_queue_with_threads(const char *name)
+{
+    static uint64_t queue_buffer[QueueSize / sizeof(uint64_t)];
+    static EventQueue queue(sizeof queue_buffer, (unsigned char *) queue_buffer);
+
+    static uint64_t stacks[Threads][StackSize / sizeof(uint64_t)];
+    alignas(Thread) static unsigned char threads[Threads][sizeof(Thread)];
+    static bool created = false;
+
+    if (!created) {
+        for (size_t i = 0; i < Threads; i++) {
+            new (threads[i]) Thread(Priority, StackSize, (unsigned char *) stacks[i], name);
+        }
+        created = true;
+    }
+
+    for (size_t i = 0; i < Threads; i++) {
+        Thread *thread = reinterpret_cast<Thread *>(threads[i]);
+        Thread::State state = thread->get_state();
+        if (state == Thread::Inactive || state == Thread::Deleted) {
+            osStatus status = thread->start(callback(&queue, &EventQueue::dispatch_shared_forever));
+            MBED_ASSERT(status == osOK);
+            if (status != osOK) {
+                return NULL;
+            }
+        }
+    }
+
+    return &queue;
+}
+#endif
 #endif
 
 EventQueue *mbed_event_queue()
@@ -62,6 +100,8 @@ EventQueue *mbed_event_queue()
     static EventQueue queue(sizeof queue_buffer, queue_buffer);
 
     return &queue;
+#elif MBED_CONF_EVENTS_SHARED_DISPATCH_THREADS > 1
+    return do_shared_event_queue_with_threads<osPriorityNormal, MBED_CONF_EVENTS_SHARED_EVENTSIZE, MBED_CONF_EVENTS_SHARED_STACKSIZE, MBED_CONF_EVENTS_SHARED_DISPATCH_THREADS>("shared_event_queue");
 #else
     return do_shared_event_queue_with_thread<osPriorityNormal, MBED_CONF_EVENTS_SHARED_EVENTSIZE, MBED_CONF_EVENTS_SHARED_STACKSIZE>("shared_event_queue");
 #endif
@@ -0,0 +1,23 @@
+
+####################
+# BENCHMARKS
+####################
+
+list(REMOVE_ITEM benchmark-includes ${PROJECT_SOURCE_DIR}/../events/tests/UNITTESTS/target_h ${PROJECT_SOURCE_DIR}/../events/tests/UNITTESTS/target_h/equeue)
+
+set(benchmark-includes ${benchmark-includes}
+  ../events/source
+  ../events/include/events
+  ../events/include/events/internal
+)
+
+set(benchmark-sources
+  ../events/source/equeue.c
+  ../events/source/equeue_posix.c
+  ../events/tests/BENCHMARKS/equeue/benchmark_equeue.cpp
+)
+
+set(benchmark-flags
+  -pthread
+  -DEQUEUE_PLATFORM_POSIX
+)
@@ -0,0 +1,83 @@
+/* Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "benchmark/benchmark.h"
+#include "equeue.h"
+
+#define QUEUE_SIZE  (64 * 1024)
+
+static void count_func(void *p)
+{
+    (*(int *)p)++;
+}
+
+// Allocate and free an event
+static void BM_equeue_alloc(benchmark::State &state)
+{
+    equeue_t q;
+    equeue_create(&q, QUEUE_SIZE);
+
+    for (auto _ : state) {
+        void *e = equeue_alloc(&q, state.range(0));
+        benchmark::DoNotOptimize(e);
+        equeue_dealloc(&q, e);
+    }
+
+    equeue_destroy(&q);
+}
+BENCHMARK(BM_equeue_alloc)->Arg(4)->Arg(64)->Arg(512);
+
+// Post a batch of immediate events, then dispatch them all
+static void BM_equeue_post_dispatch(benchmark::State &state)
+{
+    equeue_t q;
+    equeue_create(&q, QUEUE_SIZE);
+    int count = 0;
+
+    for (auto _ : state) {
+        for (int i = 0; i < state.range(0); i++) {
+            equeue_call(&q, count_func, &count);
+        }
+        equeue_dispatch(&q, 0);
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    equeue_destroy(&q);
+}
+BENCHMARK(BM_equeue_post_dispatch)->Arg(1)->Arg(16)->Arg(256);
+
+// Post events with spread out delays, which have to be sorted in the queue,
+// and cancel them
+static void BM_equeue_post_cancel_delayed(benchmark::State &state)
+{
+    equeue_t q;
+    equeue_create(&q, QUEUE_SIZE);
+    int count = 0;
+    int ids[256];
+
+    for (auto _ : state) {
+        for (int i = 0; i < state.range(0); i++) {
+            ids[i] = equeue_call_in(&q, 1000 + (i * 7919) % 10000, count_func, &count);
+        }
+        for (int i = 0; i < state.range(0); i++) {
+            equeue_cancel(&q, ids[i]);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    equeue_destroy(&q);
+}
+BENCHMARK(BM_equeue_post_cancel_delayed)->Arg(16)->Arg(256);
@@ -1002,11 +1002,11 @@ static void test_equeue_user_allocated_event_post()
     TEST_ASSERT_EQUAL_INT(0, err);
 
     uint8_t touched = 0;
-    user_allocated_event e1 = { { 0, 0, 0, NULL, NULL, NULL, 0, -1, NULL, NULL }, 0 };
-    user_allocated_event e2 = { { 0, 0, 0, NULL, NULL, NULL, 10,  10, NULL, NULL }, 0 };
-    user_allocated_event e3 = { { 0, 0, 0, NULL, NULL, NULL, 10,  10, NULL, NULL }, 0 };
-    user_allocated_event e4 = { { 0, 0, 0, NULL, NULL, NULL, 10,  10, NULL, NULL }, 0 };
-    user_allocated_event e5 = { { 0, 0, 0, NULL, NULL, NULL, 0, -1, NULL, NULL }, 0 };
+    user_allocated_event e1 = { { 0, 0, 0, 0, NULL, NULL, NULL, 0, -1, NULL, NULL }, 0 };
+    user_allocated_event e2 = { { 0, 0, 0, 0, NULL, NULL, NULL, 10,  10, NULL, NULL }, 0 };
+    user_allocated_event e3 = { { 0, 0, 0, 0, NULL, NULL, NULL, 10,  10, NULL, NULL }, 0 };
+    user_allocated_event e4 = { { 0, 0, 0, 0, NULL, NULL, NULL, 10,  10, NULL, NULL }, 0 };
+    user_allocated_event e5 = { { 0, 0, 0, 0, NULL, NULL, NULL, 0, -1, NULL, NULL }, 0 };
 
     TEST_ASSERT_NOT_EQUAL(0, equeue_call_every(&q, 10, simple_func, &touched));
     TEST_ASSERT_EQUAL_INT(0, equeue_call_every(&q, 10, simple_func, &touched));
@@ -591,6 +591,37 @@ void event_period_tests()
 
 }
 
+static int priority_log[6];
+static int priority_count = 0;
+
+void priority_handler(int value)
+{
+    priority_log[priority_count++] = value;
+}
+
+void event_priority_test()
+{
+    EventQueue queue(TEST_EQUEUE_SIZE);
+    auto ue = queue.make_user_allocated_event(priority_handler, 4);
+    Event<void(int)> e = queue.event(priority_handler);
+
+    queue.call(priority_handler, 0);
+    queue.call_with_priority(1, priority_handler, 1);
+    ue.priority(2);
+    ue.call();
+    e.priority(3);
+    e.post(3);
+    queue.call_with_priority(3, priority_handler, 5);
+    queue.call(priority_handler, 2);
+
+    queue.dispatch_once();
+
+    // higher priorities first, posting order within a priority
+    const int expected[] = { 3, 5, 4, 1, 0, 2 };
+    TEST_ASSERT_EQUAL(6, priority_count);
+    TEST_ASSERT_EQUAL_INT_ARRAY(expected, priority_log, 6);
+}
+
 // Test setup
 utest::v1::status_t test_setup(const size_t number_of_cases)
 {
@@ -619,7 +650,8 @@ const Case cases[] = {
     Case("Testing time_left", time_left_test),
     Case("Testing mixed dynamic & static events queue", mixed_dynamic_static_events_queue_test),
     Case("Testing static events queue", static_events_queue_test),
-    Case("Testing event period values", event_period_tests)
+    Case("Testing event period values", event_period_tests),
+    Case("Testing event priorities", event_priority_test)
 };
 
 Specification specification(test_setup, cases);
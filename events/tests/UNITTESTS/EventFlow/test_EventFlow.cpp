@@ -0,0 +1,241 @@
+/*
+ * Copyright (c) 2021, Arm Limited and affiliates.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "gtest/gtest.h"
+#include "events/EventQueue.h"
+#include "events/EventSignal.h"
+#include "events/EventFlow.h"
+#include "events/EventTask.h"
+
+using namespace events;
+using namespace std::chrono_literals;
+
+extern unsigned int equeue_global_time;
+
+class TestEventFlow : public testing::Test {
+protected:
+    EventQueue queue;
+};
+
+class SteppingFlow : public EventFlow {
+public:
+    SteppingFlow(EventQueue *queue) : EventFlow(queue), signal(queue), steps(0), done(false), ready(false)
+    {
+    }
+
+    EventSignal signal;
+    int steps;
+    unsigned stamps[4];
+    bool done;
+    bool ready;
+
+protected:
+    void run() override
+    {
+        EVENT_FLOW_BEGIN();
+        stamps[steps++] = equeue_global_time;
+        EVENT_FLOW_SLEEP(10ms);
+        stamps[steps++] = equeue_global_time;
+        EVENT_FLOW_WAIT(signal);
+        stamps[steps++] = equeue_global_time;
+        EVENT_FLOW_WAIT_UNTIL(ready, 5ms);
+        stamps[steps++] = equeue_global_time;
+        EVENT_FLOW_END();
+    }
+
+    void finished() override
+    {
+        done = true;
+    }
+};
+
+/** Test that a flow runs its steps on the queue.
+ *
+ *  Given a flow that sleeps, waits for a signal and polls a condition.
+ *  When the queue is dispatched and the signal and condition become true.
+ *  Then each step runs once, in order, and the flow finishes.
+ */
+TEST_F(TestEventFlow, test_flow_steps)
+{
+    SteppingFlow flow(&queue);
+    EXPECT_TRUE(flow.start());
+    EXPECT_TRUE(flow.running());
+    EXPECT_FALSE(flow.start());
+
+    queue.dispatch_for(50ms);
+    EXPECT_EQ(2, flow.steps);
+    EXPECT_EQ(10u, flow.stamps[1] - flow.stamps[0]);
+
+    flow.signal.notify();
+    queue.dispatch_for(20ms);
+    EXPECT_EQ(3, flow.steps);
+
+    flow.ready = true;
+    queue.dispatch_for(20ms);
+    EXPECT_EQ(4, flow.steps);
+    EXPECT_TRUE(flow.done);
+    EXPECT_FALSE(flow.running());
+
+    // a finished flow starts again from the beginning
+    flow.steps = 0;
+    flow.done = false;
+    flow.signal.notify();
+    EXPECT_TRUE(flow.start());
+    queue.dispatch_for(50ms);
+    EXPECT_EQ(4, flow.steps);
+    EXPECT_TRUE(flow.done);
+}
+
+/** Test that signal notifications are latched.
+ *
+ *  Given a signal notified several times with nobody waiting.
+ *  When a waiter is added.
+ *  Then it runs once, and later waiters wait for a new notification.
+ */
+TEST_F(TestEventFlow, test_signal_latch)
+{
+    EventSignal signal(&queue);
+    int count = 0;
+
+    signal.notify();
+    signal.notify();
+    EXPECT_TRUE(signal.pending());
+
+    signal.wait([&count] { count++; });
+    EXPECT_FALSE(signal.pending());
+    queue.dispatch_once();
+    EXPECT_EQ(1, count);
+
+    signal.wait([&count] { count++; });
+    queue.dispatch_once();
+    EXPECT_EQ(1, count);
+
+    signal.notify();
+    queue.dispatch_once();
+    EXPECT_EQ(2, count);
+
+    signal.wait([&count] { count++; });
+    signal.reset();
+    signal.notify();
+    EXPECT_TRUE(signal.pending());
+    queue.dispatch_once();
+    EXPECT_EQ(2, count);
+}
+
+class LoopFlow : public EventFlow {
+public:
+    LoopFlow(EventQueue *queue) : EventFlow(queue), i(0)
+    {
+    }
+
+    int i;
+
+protected:
+    void run() override
+    {
+        EVENT_FLOW_BEGIN();
+        for (i = 0; i < 5; i++) {
+            if (i == 3) {
+                EVENT_FLOW_EXIT();
+            }
+            EVENT_FLOW_YIELD();
+        }
+        i = 100;
+        EVENT_FLOW_END();
+    }
+};
+
+/** Test that a flow can wait inside loops and finish early.
+ *
+ *  Given a flow yielding inside a loop and exiting from it.
+ *  When the queue is dispatched.
+ *  Then the loop state is kept across yields and the flow ends at the exit.
+ */
+TEST_F(TestEventFlow, test_flow_loop_exit)
+{
+    LoopFlow flow(&queue);
+    EXPECT_TRUE(flow.start());
+    queue.dispatch_for(10ms);
+    EXPECT_EQ(3, flow.i);
+    EXPECT_FALSE(flow.running());
+}
+
+#if EVENTS_COROUTINES_PRESENT
+static EventTask stepping_task(EventQueue *queue, EventSignal *signal, bool *ready,
+                               int *steps, unsigned *stamps)
+{
+    stamps[(*steps)++] = equeue_global_time;
+    co_await sleep_for(queue, 10ms);
+    stamps[(*steps)++] = equeue_global_time;
+    co_await *signal;
+    stamps[(*steps)++] = equeue_global_time;
+    co_await wait_until(queue, [ready] { return *ready; }, 5ms);
+    stamps[(*steps)++] = equeue_global_time;
+    co_await resume_on(queue);
+    (*steps)++;
+}
+
+/** Test that a coroutine task runs its steps on the queue.
+ *
+ *  Given a task that sleeps, waits for a signal and polls a condition.
+ *  When the queue is dispatched and the signal and condition become true.
+ *  Then each step runs once, in order, and the task completes.
+ */
+TEST_F(TestEventFlow, test_task_steps)
+{
+    EventSignal signal(&queue);
+    bool ready = false;
+    int steps = 0;
+    unsigned stamps[4];
+
+    EventTask task = stepping_task(&queue, &signal, &ready, &steps, stamps);
+    EXPECT_EQ(0, steps);
+    EXPECT_TRUE(task.start(&queue));
+    EXPECT_FALSE(task.start(&queue));
+
+    queue.dispatch_for(50ms);
+    EXPECT_EQ(2, steps);
+    EXPECT_EQ(10u, stamps[1] - stamps[0]);
+
+    signal.notify();
+    queue.dispatch_for(20ms);
+    EXPECT_EQ(3, steps);
+
+    ready = true;
+    queue.dispatch_for(20ms);
+    EXPECT_EQ(5, steps);
+}
+
+/** Test that a task that is never started is destroyed with its handle.
+ *
+ *  Given a task that was created but not started.
+ *  When it goes out of scope.
+ *  Then its body never runs.
+ */
+TEST_F(TestEventFlow, test_task_not_started)
+{
+    EventSignal signal(&queue);
+    bool ready = true;
+    int steps = 0;
+    unsigned stamps[4];
+
+    {
+        EventTask task = stepping_task(&queue, &signal, &ready, &steps, stamps);
+    }
+    queue.dispatch_for(20ms);
+    EXPECT_EQ(0, steps);
+}
+#endif
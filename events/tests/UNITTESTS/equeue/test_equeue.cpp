@@ -1071,11 +1071,11 @@ TEST_F(TestEqueue, test_equeue_user_allocated_event_post)
     ASSERT_EQ(0, err);
 
     uint8_t touched = 0;
-    user_allocated_event e1 = { { 0, 0, 0, NULL, NULL, NULL, 0, -1, NULL, NULL }, 0 };
-    user_allocated_event e2 = { { 0, 0, 0, NULL, NULL, NULL, 10,  10, NULL, NULL }, 0 };
-    user_allocated_event e3 = { { 0, 0, 0, NULL, NULL, NULL, 10,  10, NULL, NULL }, 0 };
-    user_allocated_event e4 = { { 0, 0, 0, NULL, NULL, NULL, 10,  10, NULL, NULL }, 0 };
-    user_allocated_event e5 = { { 0, 0, 0, NULL, NULL, NULL, 0, -1, NULL, NULL }, 0 };
+    user_allocated_event e1 = { { 0, 0, 0, 0, NULL, NULL, NULL, 0, -1, NULL, NULL }, 0 };
+    user_allocated_event e2 = { { 0, 0, 0, 0, NULL, NULL, NULL, 10,  10, NULL, NULL }, 0 };
+    user_allocated_event e3 = { { 0, 0, 0, 0, NULL, NULL, NULL, 10,  10, NULL, NULL }, 0 };
+    user_allocated_event e4 = { { 0, 0, 0, 0, NULL, NULL, NULL, 10,  10, NULL, NULL }, 0 };
+    user_allocated_event e5 = { { 0, 0, 0, 0, NULL, NULL, NULL, 0, -1, NULL, NULL }, 0 };
 
     EXPECT_NE(0, equeue_call_every(&q, 10, simple_func, &touched));
     EXPECT_EQ(0, equeue_call_every(&q, 10, simple_func, &touched));
@@ -1112,3 +1112,494 @@ TEST_F(TestEqueue, test_equeue_user_allocated_event_post)
 
     equeue_destroy(&q);
 }
+
+struct producer {
+    pthread_t thread;
+    equeue_t *q;
+    unsigned id;
+    unsigned next;
+};
+
+#define PRODUCER_COUNT 4
+#define PRODUCER_EVENTS 50
+
+static void producer_func(void *p)
+{
+    struct producer *prod = reinterpret_cast<struct producer *>(p);
+    prod->next++;
+}
+
+static void *producer_thread(void *p)
+{
+    struct producer *prod = reinterpret_cast<struct producer *>(p);
+    for (int i = 0; i < PRODUCER_EVENTS; i++) {
+        EXPECT_NE(0, equeue_call(prod->q, producer_func, prod));
+    }
+    return 0;
+}
+
+/** Test that events posted concurrently from several threads are all dispatched.
+ *
+ *  Given queue is initialized.
+ *  When several threads post events at the same time without a dispatcher running.
+ *  Then a later dispatch runs every posted event exactly once.
+ */
+TEST_F(TestEqueue, test_equeue_concurrent_post)
+{
+    equeue_t q;
+    int err = equeue_create(&q, PRODUCER_COUNT * PRODUCER_EVENTS * (EQUEUE_EVENT_SIZE + 2 * sizeof(void *)));
+    ASSERT_EQ(0, err);
+
+    struct producer prods[PRODUCER_COUNT];
+    for (int i = 0; i < PRODUCER_COUNT; i++) {
+        prods[i].q = &q;
+        prods[i].id = i;
+        prods[i].next = 0;
+        err = pthread_create(&prods[i].thread, 0, producer_thread, &prods[i]);
+        ASSERT_EQ(0, err);
+    }
+
+    for (int i = 0; i < PRODUCER_COUNT; i++) {
+        err = pthread_join(prods[i].thread, 0);
+        ASSERT_EQ(0, err);
+    }
+
+    equeue_dispatch(&q, 0);
+
+    for (int i = 0; i < PRODUCER_COUNT; i++) {
+        EXPECT_EQ(PRODUCER_EVENTS, prods[i].next);
+    }
+
+    equeue_destroy(&q);
+}
+
+struct order_entry {
+    int value;
+    int *log;
+    int *count;
+};
+
+static void order_func(void *p)
+{
+    struct order_entry *entry = reinterpret_cast<struct order_entry *>(p);
+    entry->log[(*entry->count)++] = entry->value;
+}
+
+/** Test that events posted without a dispatcher running keep their post order
+ *  and can still be canceled.
+ *
+ *  Given queue is initialized.
+ *  When events are posted and one of them is canceled before dispatching.
+ *  Then the remaining events run in the order they were posted.
+ */
+TEST_F(TestEqueue, test_equeue_pending_order_and_cancel)
+{
+    equeue_t q;
+    int err = equeue_create(&q, TEST_EQUEUE_SIZE);
+    ASSERT_EQ(0, err);
+
+    int log[5] = { 0 };
+    int count = 0;
+    int ids[5];
+    for (int i = 0; i < 5; i++) {
+        struct order_entry *entry = reinterpret_cast<struct order_entry *>(equeue_alloc(&q, sizeof(struct order_entry)));
+        ASSERT_TRUE(entry != NULL);
+        entry->value = i;
+        entry->log = log;
+        entry->count = &count;
+        ids[i] = equeue_post(&q, order_func, entry);
+        ASSERT_NE(0, ids[i]);
+    }
+
+    EXPECT_TRUE(equeue_cancel(&q, ids[2]));
+    EXPECT_FALSE(equeue_cancel(&q, ids[2]));
+    EXPECT_EQ(0, equeue_timeleft(&q, ids[3]));
+
+    equeue_dispatch(&q, 0);
+    ASSERT_EQ(4, count);
+    EXPECT_EQ(0, log[0]);
+    EXPECT_EQ(1, log[1]);
+    EXPECT_EQ(3, log[2]);
+    EXPECT_EQ(4, log[3]);
+
+    equeue_destroy(&q);
+}
+
+struct deadline {
+    unsigned expected;
+    unsigned fired;
+    int count;
+};
+
+static void deadline_func(void *p)
+{
+    struct deadline *d = reinterpret_cast<struct deadline *>(p);
+    d->fired = equeue_tick();
+    d->count++;
+}
+
+/** Test that events far apart in time fire at their deadline.
+ *
+ *  Given queue is initialized.
+ *  When events are posted with delays spanning short and very long times, and one of them is canceled.
+ *  Then every other event is dispatched exactly once at its deadline.
+ */
+TEST_F(TestEqueue, test_equeue_spread_deadlines)
+{
+    equeue_t q;
+    int err = equeue_create(&q, TEST_EQUEUE_SIZE);
+    ASSERT_EQ(0, err);
+
+    const int delays[] = { 0, 1, 31, 32, 33, 1000, 1024, 40000, 1048575, 1048576, 3000000 };
+    const int count = sizeof(delays) / sizeof(delays[0]);
+    struct deadline deadlines[count];
+    int ids[count];
+
+    unsigned start = equeue_tick();
+    for (int i = 0; i < count; i++) {
+        deadlines[i].expected = start + delays[i];
+        deadlines[i].fired = 0;
+        deadlines[i].count = 0;
+        ids[i] = equeue_call_in(&q, delays[i], deadline_func, &deadlines[i]);
+        ASSERT_NE(0, ids[i]);
+    }
+
+    EXPECT_TRUE(equeue_cancel(&q, ids[7]));
+
+    equeue_dispatch(&q, 3000010);
+
+    for (int i = 0; i < count; i++) {
+        if (i == 7) {
+            EXPECT_EQ(0, deadlines[i].count);
+        } else {
+            EXPECT_EQ(1, deadlines[i].count);
+            EXPECT_EQ(deadlines[i].expected, deadlines[i].fired);
+        }
+    }
+
+    equeue_destroy(&q);
+}
+
+/** Test that ready events are dispatched by priority.
+ *
+ *  Given queue is initialized.
+ *  When events with different priorities are ready in the same dispatch.
+ *  Then higher priorities run first and equal priorities keep their post order.
+ */
+TEST_F(TestEqueue, test_equeue_priority)
+{
+    equeue_t q;
+    int err = equeue_create(&q, TEST_EQUEUE_SIZE);
+    ASSERT_EQ(0, err);
+
+    // out of range priorities are clamped
+    const int priorities[] = { 0, 2, 1, 2, -1, EQUEUE_PRIORITY_LEVELS + 5, 1 };
+    const int expected[] = { 5, 1, 3, 2, 6, 0, 4 };
+    const int n = sizeof(priorities) / sizeof(priorities[0]);
+    int log[n] = { 0 };
+    int count = 0;
+    for (int i = 0; i < n; i++) {
+        struct order_entry *entry = reinterpret_cast<struct order_entry *>(equeue_alloc(&q, sizeof(struct order_entry)));
+        ASSERT_TRUE(entry != NULL);
+        entry->value = i;
+        entry->log = log;
+        entry->count = &count;
+        equeue_event_priority(entry, priorities[i]);
+        ASSERT_NE(0, equeue_post(&q, order_func, entry));
+    }
+
+    equeue_dispatch(&q, 0);
+    ASSERT_EQ(n, count);
+    for (int i = 0; i < n; i++) {
+        EXPECT_EQ(expected[i], log[i]);
+    }
+
+    equeue_destroy(&q);
+}
+
+#if EQUEUE_DISPATCH_POOL
+struct gate {
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    bool open;
+    bool waited;
+};
+
+static void gate_wait_func(void *p)
+{
+    struct gate *g = *reinterpret_cast<struct gate **>(p);
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    ts.tv_sec += 5;
+
+    pthread_mutex_lock(&g->mutex);
+    while (!g->open) {
+        if (pthread_cond_timedwait(&g->cond, &g->mutex, &ts)) {
+            break;
+        }
+    }
+    g->waited = g->open;
+    pthread_mutex_unlock(&g->mutex);
+}
+
+static void gate_open_func(void *p)
+{
+    struct gate *g = *reinterpret_cast<struct gate **>(p);
+    pthread_mutex_lock(&g->mutex);
+    g->open = true;
+    pthread_cond_broadcast(&g->cond);
+    pthread_mutex_unlock(&g->mutex);
+}
+
+static void *shared_dispatch_thread(void *p)
+{
+    equeue_dispatch_shared(reinterpret_cast<equeue_t *>(p), DISPATCH_INFINITE);
+    return 0;
+}
+
+/** Test that shared dispatchers run events concurrently.
+ *
+ *  Given queue is dispatched by two threads with equeue_dispatch_shared.
+ *  When an event blocks until a later event runs.
+ *  Then the later event runs in the other thread and equeue_break stops both.
+ */
+TEST_F(TestEqueue, test_equeue_dispatch_shared_concurrent)
+{
+    equeue_t q;
+    int err = equeue_create(&q, TEST_EQUEUE_SIZE);
+    ASSERT_EQ(0, err);
+
+    pthread_t threads[2];
+    for (int i = 0; i < 2; i++) {
+        err = pthread_create(&threads[i], 0, shared_dispatch_thread, &q);
+        ASSERT_EQ(0, err);
+    }
+
+    struct gate g = { PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER, false, false };
+    struct gate *gp = &g;
+    ecount t;
+    ASSERT_NE(0, equeue_call(&q, gate_wait_func, &gp));
+    ASSERT_NE(0, equeue_call(&q, gate_open_func, &gp));
+    ASSERT_NE(0, equeue_call(&q, multithread_func, &t));
+    t.wait_for_touches(1);
+
+    equeue_break(&q);
+    for (int i = 0; i < 2; i++) {
+        err = pthread_join(threads[i], 0);
+        ASSERT_EQ(0, err);
+    }
+
+    pthread_mutex_lock(&g.mutex);
+    while (!g.waited && g.open) {
+        pthread_mutex_unlock(&g.mutex);
+        usleep(1000);
+        pthread_mutex_lock(&g.mutex);
+    }
+    EXPECT_TRUE(g.waited);
+    pthread_mutex_unlock(&g.mutex);
+
+    equeue_destroy(&q);
+}
+
+struct affinity_entry {
+    int value;
+    int *log;
+    int *count;
+    int *running;
+    bool *overlap;
+    ecount *done;
+};
+
+static void affinity_func(void *p)
+{
+    struct affinity_entry *entry = reinterpret_cast<struct affinity_entry *>(p);
+    if (__atomic_add_fetch(entry->running, 1, __ATOMIC_SEQ_CST) > 1) {
+        *entry->overlap = true;
+    }
+    usleep(100);
+    entry->log[__atomic_fetch_add(entry->count, 1, __ATOMIC_SEQ_CST)] = entry->value;
+    __atomic_sub_fetch(entry->running, 1, __ATOMIC_SEQ_CST);
+    entry->done->touch();
+}
+
+/** Test that events with the same affinity key are serialized.
+ *
+ *  Given queue is dispatched by four threads with equeue_dispatch_shared.
+ *  When events with the same affinity key are posted alongside other events.
+ *  Then they never run concurrently and run in posting order.
+ */
+TEST_F(TestEqueue, test_equeue_dispatch_shared_affinity)
+{
+    equeue_t q;
+    int err = equeue_create(&q, TEST_EQUEUE_SIZE);
+    ASSERT_EQ(0, err);
+
+    pthread_t threads[4];
+    for (int i = 0; i < 4; i++) {
+        err = pthread_create(&threads[i], 0, shared_dispatch_thread, &q);
+        ASSERT_EQ(0, err);
+    }
+
+    const int n = 8;
+    int log[n] = { 0 };
+    int count = 0;
+    int running = 0;
+    bool overlap = false;
+    int other_count = 0;
+    int other_log[n] = { 0 };
+    int other_running = 0;
+    bool other_overlap = false;
+    ecount done;
+    for (int i = 0; i < n; i++) {
+        struct affinity_entry *entry = reinterpret_cast<struct affinity_entry *>(equeue_alloc(&q, sizeof(struct affinity_entry)));
+        ASSERT_TRUE(entry != NULL);
+        *entry = { i, log, &count, &running, &overlap, &done };
+        equeue_event_affinity(entry, 7);
+        ASSERT_NE(0, equeue_post(&q, affinity_func, entry));
+
+        // unrelated events are free to run alongside
+        entry = reinterpret_cast<struct affinity_entry *>(equeue_alloc(&q, sizeof(struct affinity_entry)));
+        ASSERT_TRUE(entry != NULL);
+        *entry = { i, other_log, &other_count, &other_running, &other_overlap, &done };
+        ASSERT_NE(0, equeue_post(&q, affinity_func, entry));
+    }
+
+    done.wait_for_touches(2 * n);
+    equeue_break(&q);
+    for (int i = 0; i < 4; i++) {
+        err = pthread_join(threads[i], 0);
+        ASSERT_EQ(0, err);
+    }
+
+    EXPECT_FALSE(overlap);
+    ASSERT_EQ(n, count);
+    for (int i = 0; i < n; i++) {
+        EXPECT_EQ(i, log[i]);
+    }
+    EXPECT_EQ(n, other_count);
+
+    equeue_destroy(&q);
+}
+
+static void touch_func(void *p)
+{
+    (*reinterpret_cast<ecount **>(p))->touch();
+}
+
+static void flag_func(void *p)
+{
+    **reinterpret_cast<bool **>(p) = true;
+}
+
+/** Test that an event held back by its affinity key can be canceled.
+ *
+ *  Given queue is dispatched by two threads with equeue_dispatch_shared.
+ *  When an event waits for an earlier event of the same key and is canceled.
+ *  Then equeue_cancel succeeds and the event never runs.
+ */
+TEST_F(TestEqueue, test_equeue_dispatch_shared_cancel)
+{
+    equeue_t q;
+    int err = equeue_create(&q, TEST_EQUEUE_SIZE);
+    ASSERT_EQ(0, err);
+
+    pthread_t threads[2];
+    for (int i = 0; i < 2; i++) {
+        err = pthread_create(&threads[i], 0, shared_dispatch_thread, &q);
+        ASSERT_EQ(0, err);
+    }
+
+    struct gate g = { PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER, false, false };
+    struct gate **ge = reinterpret_cast<struct gate **>(equeue_alloc(&q, sizeof(struct gate *)));
+    ASSERT_TRUE(ge != NULL);
+    *ge = &g;
+    equeue_event_affinity(ge, 1);
+    ASSERT_NE(0, equeue_post(&q, gate_wait_func, ge));
+
+    bool ran = false;
+    bool **re = reinterpret_cast<bool **>(equeue_alloc(&q, sizeof(bool *)));
+    ASSERT_TRUE(re != NULL);
+    *re = &ran;
+    equeue_event_affinity(re, 1);
+    int id = equeue_post(&q, flag_func, re);
+    ASSERT_NE(0, id);
+
+    // give the other dispatcher time to find the event held back
+    usleep(20000);
+    EXPECT_TRUE(equeue_cancel(&q, id));
+
+    struct gate *gp = &g;
+    ASSERT_NE(0, equeue_call(&q, gate_open_func, &gp));
+
+    ecount t;
+    ecount **te = reinterpret_cast<ecount **>(equeue_alloc(&q, sizeof(ecount *)));
+    ASSERT_TRUE(te != NULL);
+    *te = &t;
+    equeue_event_affinity(te, 1);
+    ASSERT_NE(0, equeue_post(&q, touch_func, te));
+    t.wait_for_touches(1);
+
+    equeue_break(&q);
+    for (int i = 0; i < 2; i++) {
+        err = pthread_join(threads[i], 0);
+        ASSERT_EQ(0, err);
+    }
+
+    EXPECT_TRUE(g.waited);
+    EXPECT_FALSE(ran);
+
+    equeue_destroy(&q);
+}
+#endif
+
+#if EQUEUE_STATS
+/** Test that dispatch statistics record waits and run times.
+ *
+ *  Given queue is initialized.
+ *  When a slow event delays the events due after it.
+ *  Then the histograms and maxima reflect that and the slow callback is reported.
+ */
+TEST_F(TestEqueue, test_equeue_stats)
+{
+    equeue_t q;
+    int err = equeue_create(&q, TEST_EQUEUE_SIZE);
+    ASSERT_EQ(0, err);
+
+    equeue_stats_t stats;
+    equeue_stats_get(&q, &stats);
+    EXPECT_EQ(0u, stats.dispatched);
+
+    // sloth_func advances time by 10ms while it runs
+    uint8_t touched = 0;
+    ASSERT_NE(0, equeue_call(&q, sloth_func, &touched));
+    ASSERT_NE(0, equeue_call(&q, simple_func, &touched));
+    ASSERT_NE(0, equeue_call(&q, simple_func, &touched));
+    equeue_dispatch(&q, 0);
+
+    equeue_stats_get(&q, &stats);
+    EXPECT_EQ(3u, stats.dispatched);
+    EXPECT_EQ(10u, stats.runtime_max);
+    EXPECT_EQ((void *)sloth_func, (void *)stats.slowest_cb);
+    EXPECT_EQ(10u, stats.lag_max);
+
+    // 0ms in bucket 0, 10ms in [8, 16)
+    EXPECT_EQ(2u, stats.runtime[0]);
+    EXPECT_EQ(1u, stats.runtime[4]);
+    EXPECT_EQ(1u, stats.lag[0]);
+    EXPECT_EQ(2u, stats.lag[4]);
+
+    unsigned total = 0;
+    for (int i = 0; i < EQUEUE_STATS_BUCKETS; i++) {
+        total += stats.lag[i];
+    }
+    EXPECT_EQ(3u, total);
+
+    equeue_stats_reset(&q);
+    equeue_stats_get(&q, &stats);
+    EXPECT_EQ(0u, stats.dispatched);
+    EXPECT_EQ(0u, stats.runtime_max);
+    EXPECT_TRUE(stats.slowest_cb == NULL);
+
+    equeue_destroy(&q);
+}
+#endif
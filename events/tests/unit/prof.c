@@ -89,9 +89,12 @@ static const char *prof_units;
     res -= prof_baseline_cycle;                                             \
     printf("\r%s: %"PRIu64" %s", #func, res, prof_units);                   \
                                                                             \
+    prof_cycle_t prev = 0;                                                  \
     if (!isatty(0)) {                                                       \
-        prof_cycle_t prev;                                                  \
         while (scanf("%*[^0-9]%"PRIu64, &prev) == 0);                       \
+    }                                                                       \
+                                                                            \
+    if (prev) {                                                             \
         int64_t perc = 100*((int64_t)prev - (int64_t)res) / (int64_t)prev;  \
                                                                             \
         if (perc > 10) {                                                    \
@@ -263,6 +266,31 @@ void equeue_post_future_many_prof(int count)
     equeue_destroy(&q);
 }
 
+void equeue_post_many_deadlines_prof(int count)
+{
+    struct equeue q;
+    equeue_create(&q, (count + 1) * EQUEUE_EVENT_SIZE);
+
+    // every event gets its own deadline, as with many independent timeouts
+    for (int i = 0; i < count; i++) {
+        equeue_call_in(&q, 1000 + 10 * i, no_func, 0);
+    }
+
+    prof_loop() {
+        void *e = equeue_alloc(&q, 0);
+        equeue_event_delay(e, 1000 + 5 * count);
+
+        // posting only defers the event to the dispatch loop, cancelling
+        // makes it take its place among the other deadlines
+        prof_start();
+        int id = equeue_post(&q, no_func, e);
+        equeue_cancel(&q, id);
+        prof_stop();
+    }
+
+    equeue_destroy(&q);
+}
+
 void equeue_dispatch_prof(void)
 {
     struct equeue q;
@@ -414,6 +442,7 @@ int main()
     prof_measure(equeue_alloc_many_prof, 1000);
     prof_measure(equeue_post_many_prof, 1000);
     prof_measure(equeue_post_future_many_prof, 1000);
+    prof_measure(equeue_post_many_deadlines_prof, 1000);
     prof_measure(equeue_dispatch_many_prof, 100);
     prof_measure(equeue_cancel_many_prof, 100);
 
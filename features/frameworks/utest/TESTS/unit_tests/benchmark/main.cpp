@@ -0,0 +1,88 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "mbed.h"
+#include "greentea-client/test_env.h"
+#include "utest/utest.h"
+#include "unity/unity.h"
+
+using namespace utest::v1;
+
+static volatile uint32_t spin_counter;
+
+static void spin(uint32_t loops)
+{
+    for (uint32_t i = 0; i < loops; i++) {
+        spin_counter++;
+    }
+}
+
+void test_statistics_ordered()
+{
+    uint32_t calls = 0;
+    benchmark_t stats = benchmark("spin 100", [&] { calls++; spin(100); }, 50, 5);
+
+    TEST_ASSERT_EQUAL_UINT32(55, calls);
+    TEST_ASSERT_EQUAL_UINT32(50, stats.iterations);
+    TEST_ASSERT(stats.min <= stats.median);
+    TEST_ASSERT(stats.median <= stats.p99);
+    TEST_ASSERT(stats.p99 <= stats.max);
+    TEST_ASSERT(stats.min <= stats.mean && stats.mean <= stats.max);
+}
+
+void test_longer_body_slower()
+{
+    benchmark_t small = benchmark("spin 1000", [] { spin(1000); }, 20);
+    benchmark_t large = benchmark("spin 10000", [] { spin(10000); }, 20);
+
+    TEST_ASSERT(small.median < large.median);
+}
+
+void test_report_percentiles()
+{
+    uint32_t samples[100];
+    for (uint32_t i = 0; i < 100; i++) {
+        // Reversed, to check they are sorted
+        samples[i] = 100000 + (99 - i) * 1000;
+    }
+    benchmark_t stats = benchmark_report("synthetic", samples, 100);
+
+    // The time taken to read the clock is taken off every sample
+    uint32_t overhead = 100000 - stats.min;
+    TEST_ASSERT_EQUAL_UINT32(100, stats.iterations);
+    TEST_ASSERT_EQUAL_UINT32(149000 - overhead, stats.median);
+    TEST_ASSERT_EQUAL_UINT32(198000 - overhead, stats.p99);
+    TEST_ASSERT_EQUAL_UINT32(199000 - overhead, stats.max);
+}
+
+Case cases[] = {
+    Case("Benchmark: statistics ordered", test_statistics_ordered),
+    Case("Benchmark: longer body slower", test_longer_body_slower),
+    Case("Benchmark: report percentiles", test_report_percentiles)
+};
+
+utest::v1::status_t greentea_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(20, "default_auto");
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+Specification specification(greentea_setup, cases);
+
+int main()
+{
+    Harness::run(specification);
+}
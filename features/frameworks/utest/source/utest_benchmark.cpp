@@ -0,0 +1,109 @@
+/****************************************************************************
+ * Copyright (c) 2021, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ****************************************************************************
+ */
+
+#include <stdio.h>
+#include <algorithm>
+
+#include "utest/utest_benchmark.h"
+#include "utest/utest_print.h"
+#include "greentea-client/test_env.h"
+#include "device.h"
+#include "platform/mbed_profiler.h"
+#include "hal/us_ticker_api.h"
+
+using namespace utest::v1;
+
+// Clock reads averaged to estimate the time of one
+#define BENCHMARK_OVERHEAD_READS    16
+
+static bool benchmark_has_cycles()
+{
+#ifdef TARGET_CORTEX_M
+    // The cycle counter always reads 0 on cores without one
+    static const bool has_cycles = mbed_profile_cycles() != mbed_profile_cycles();
+    return has_cycles;
+#else
+    return false;
+#endif
+}
+
+uint32_t utest::v1::benchmark_clock()
+{
+#ifdef TARGET_CORTEX_M
+    if (benchmark_has_cycles()) {
+        return mbed_profile_cycles();
+    }
+#endif
+#if DEVICE_USTICKER
+    return us_ticker_read();
+#else
+    return 0;
+#endif
+}
+
+const char *utest::v1::benchmark_unit()
+{
+    return benchmark_has_cycles() ? "cycles" : "us";
+}
+
+static uint32_t benchmark_overhead()
+{
+    uint32_t overhead = UINT32_MAX;
+    for (int i = 0; i < BENCHMARK_OVERHEAD_READS; i++) {
+        uint32_t start = benchmark_clock();
+        overhead = std::min(overhead, benchmark_clock() - start);
+    }
+    return overhead;
+}
+
+benchmark_t utest::v1::benchmark_report(const char *name, uint32_t *samples, uint32_t count)
+{
+    benchmark_t stats = {};
+    if (samples == NULL || count == 0) {
+        utest_printf("benchmark %s: no samples\n", name);
+        return stats;
+    }
+
+    uint32_t overhead = benchmark_overhead();
+    uint64_t total = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        samples[i] = samples[i] > overhead ? samples[i] - overhead : 0;
+        total += samples[i];
+    }
+    std::sort(samples, samples + count);
+
+    stats.iterations = count;
+    stats.min = samples[0];
+    stats.median = samples[(count - 1) / 2];
+    // Nearest rank: the smallest sample with 99% of the samples at or below it
+    stats.p99 = samples[(count * 99 + 99) / 100 - 1];
+    stats.max = samples[count - 1];
+    stats.mean = (uint32_t)(total / count);
+
+    const char *unit = benchmark_unit();
+    utest_printf("benchmark %s: %lu iterations, min %lu, median %lu, p99 %lu, max %lu, mean %lu %s\n",
+                 name, (unsigned long) stats.iterations, (unsigned long) stats.min, (unsigned long) stats.median,
+                 (unsigned long) stats.p99, (unsigned long) stats.max, (unsigned long) stats.mean, unit);
+
+    char value[128];
+    snprintf(value, sizeof(value), "%s;%s;%lu;%lu;%lu;%lu;%lu;%lu", name, unit,
+             (unsigned long) stats.iterations, (unsigned long) stats.min, (unsigned long) stats.median,
+             (unsigned long) stats.p99, (unsigned long) stats.max, (unsigned long) stats.mean);
+    greentea_send_kv("benchmark", value);
+    return stats;
+}
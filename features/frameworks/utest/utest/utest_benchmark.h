@@ -0,0 +1,114 @@
+/** \addtogroup frameworks */
+/** @{*/
+/****************************************************************************
+ * Copyright (c) 2021, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ****************************************************************************
+ */
+
+#ifndef UTEST_BENCHMARK_H
+#define UTEST_BENCHMARK_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <new>
+
+namespace utest {
+/** \addtogroup frameworks */
+/** @{*/
+namespace v1 {
+
+    enum {
+        BENCHMARK_WARMUP_DEFAULT = 10   ///< Iterations run before measuring, to fill caches and finish lazy initialization
+    };
+
+    /// Statistics of a benchmark, in the unit of benchmark_unit()
+    struct benchmark_t {
+        uint32_t iterations;    ///< Iterations measured, 0 if the samples could not be allocated
+        uint32_t min;           ///< Fastest iteration
+        uint32_t median;        ///< Median iteration
+        uint32_t p99;           ///< 99th percentile iteration
+        uint32_t max;           ///< Slowest iteration
+        uint32_t mean;          ///< Average iteration
+    };
+
+    /** Read the clock timing the benchmarks: the DWT cycle counter, or the
+     *  microsecond ticker on cores without one, such as Cortex-M0/M0+.
+     */
+    uint32_t benchmark_clock();
+
+    /// @returns the unit of benchmark_clock(), "cycles" or "us".
+    const char *benchmark_unit();
+
+    /** Compute the statistics of the samples of a benchmark, corrected for the
+     *  time taken to read the clock, and report them.
+     *
+     *  They are printed, and sent to greentea as the key-value pair
+     *  {{benchmark;<name>;<unit>;<iterations>;<min>;<median>;<p99>;<max>;<mean>}}
+     *  for the host to collect and compare across runs and targets.
+     *
+     *  @param name     Name of the benchmark, without ';'
+     *  @param samples  Time taken by each iteration, sorted in place
+     *  @param count    Number of samples
+     *  @returns the statistics.
+     */
+    benchmark_t benchmark_report(const char *name, uint32_t *samples, uint32_t count);
+
+    /** Time a piece of code and report the statistics with benchmark_report().
+     *
+     *  @code
+     *  void test_crc32()
+     *  {
+     *      MbedCRC<POLY_32BIT_ANSI, 32> crc;
+     *      uint32_t result;
+     *      benchmark_t stats = benchmark("crc32 1k", [&] { crc.compute(buffer, sizeof(buffer), &result); }, 100);
+     *      TEST_ASSERT_NOT_EQUAL(0, stats.iterations);
+     *  }
+     *  @endcode
+     *
+     *  @param name         Name of the benchmark, without ';'
+     *  @param body         Callable run once per iteration
+     *  @param iterations   Iterations measured, a sample of each is allocated on the heap
+     *  @param warmup       Iterations run before measuring
+     *  @returns the statistics.
+     */
+    template <typename F>
+    benchmark_t benchmark(const char *name, F &&body, uint32_t iterations, uint32_t warmup = BENCHMARK_WARMUP_DEFAULT)
+    {
+        for (uint32_t i = 0; i < warmup; i++) {
+            body();
+        }
+
+        uint32_t *samples = new (std::nothrow) uint32_t[iterations];
+        if (samples == NULL) {
+            return benchmark_report(name, NULL, 0);
+        }
+        for (uint32_t i = 0; i < iterations; i++) {
+            uint32_t start = benchmark_clock();
+            body();
+            samples[i] = benchmark_clock() - start;
+        }
+
+        benchmark_t stats = benchmark_report(name, samples, iterations);
+        delete[] samples;
+        return stats;
+    }
+
+}   // namespace v1
+}   // namespace utest
+
+#endif // UTEST_BENCHMARK_H
+
+/** @}*/
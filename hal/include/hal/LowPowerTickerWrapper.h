@@ -29,10 +29,27 @@
 #include "platform/mbed_chrono.h"
 #include "platform/mbed_critical.h"
 
+#ifndef MBED_CONF_TARGET_LPTICKER_QUEUED_MATCH
+#define MBED_CONF_TARGET_LPTICKER_QUEUED_MATCH 0
+#endif
 
 class LowPowerTickerWrapper {
 public:
 
+    /**
+     * Counters of the work done by the wrapper
+     */
+    struct stats_t {
+        /** Matches written to the low power ticker */
+        uint32_t writes;
+        /** Matches not written because an earlier match was pending,
+         * with MBED_CONF_TARGET_LPTICKER_QUEUED_MATCH */
+        uint32_t queued;
+        /** Matches scheduled with the microsecond Timeout */
+        uint32_t deferred;
+        /** Longest delay between set_interrupt and the low power ticker write, in ticks */
+        uint32_t max_write_delay;
+    };
 
     /**
      * Create a new wrapped low power ticker object
@@ -96,6 +113,13 @@ public:
      */
     bool timeout_pending();
 
+    /**
+     * Get the counters of the work done by the wrapper
+     *
+     * @return The counters since the wrapper was created
+     */
+    stats_t get_stats();
+
     /*
      * Implementation of ticker_init
      */
@@ -205,6 +229,7 @@ private:
      */
     uint32_t _us_per_tick;
 
+    stats_t _stats;
 
     void _reset();
 
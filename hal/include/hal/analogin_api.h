@@ -23,6 +23,9 @@
 #include "device.h"
 #include "pinmap.h"
 
+#include <stdbool.h>
+#include <stddef.h>
+
 #if DEVICE_ANALOGIN
 
 #ifdef __cplusplus
@@ -109,6 +112,64 @@ const PinMap *analogin_pinmap(void);
 
 /**@}*/
 
+#if DEVICE_ANALOGIN_STREAM
+
+/**
+ * \defgroup hal_analogin_stream Analogin streaming hal functions
+ *
+ * Continuous sampling of one or more inputs, triggered by a timer and
+ * written by DMA into a double buffer.
+ *
+ * # Defined behaviour
+ * * ::analogin_stream_start samples the given inputs, in order, at `sample_rate` Hz each
+ * * Samples are written to `buffer`, interleaved by input. The first half of the buffer
+ *   is filled, then the second half, then the first one again and so on
+ * * The handler is called from interrupt context each time a half is full, with that
+ *   half, while the other half is being filled
+ * * The samples given to the handler are represented like ::analogin_read_u16 values
+ * * ::analogin_stream_start returns false and samples nothing if the inputs are not on
+ *   the same ADC, or if the rate can not be reached
+ * * ::analogin_stream_stop stops the sampling, the handler is not called any more
+ *
+ * # Undefined behaviour
+ * * `length` not a multiple of twice the number of inputs
+ * * Calling ::analogin_read, ::analogin_read_u16 on an input being sampled
+ * * Calling ::analogin_stream_start on an input already being sampled
+ * @{
+ */
+
+/** Handler called with each half of the buffer
+ *
+ * @param id      The id given to ::analogin_stream_start
+ * @param samples The samples, interleaved by input
+ * @param count   The number of samples
+ */
+typedef void (*analogin_stream_handler)(uint32_t id, uint16_t *samples, size_t count);
+
+/** Start sampling continuously
+ *
+ * @param channels      The analogin objects to sample, on the same ADC
+ * @param channel_count The number of analogin objects
+ * @param sample_rate   The sampling rate of each input, in Hz
+ * @param buffer        The double buffer, which must stay valid until ::analogin_stream_stop
+ * @param length        The length of the buffer, in samples
+ * @param handler       The handler called with each half of the buffer
+ * @param id            The id given to the handler
+ * @return true if the sampling started
+ */
+bool analogin_stream_start(analogin_t *const *channels, size_t channel_count, uint32_t sample_rate,
+                           uint16_t *buffer, size_t length, analogin_stream_handler handler, uint32_t id);
+
+/** Stop sampling
+ *
+ * @param obj The first analogin object given to ::analogin_stream_start
+ */
+void analogin_stream_stop(analogin_t *obj);
+
+/**@}*/
+
+#endif
+
 #ifdef __cplusplus
 }
 #endif
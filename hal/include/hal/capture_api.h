@@ -0,0 +1,143 @@
+/** \addtogroup hal */
+/** @{*/
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_CAPTURE_API_H
+#define MBED_CAPTURE_API_H
+
+#include "device.h"
+#include "pinmap.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#if DEVICE_CAPTURE
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Capture hal structure. capture_s is declared in the target's hal
+ */
+typedef struct capture_s capture_t;
+
+/** Edges captured
+ */
+typedef enum {
+    CAPTURE_EDGE_RISING,
+    CAPTURE_EDGE_FALLING,
+    CAPTURE_EDGE_BOTH
+} capture_edge_t;
+
+/** Information about the capture timer
+ */
+typedef struct {
+    uint32_t frequency; /**< Frequency of the timestamps in hertz */
+    uint32_t bits;      /**< Number of bits of the timestamps, from 16 to 32 */
+} capture_info_t;
+
+typedef void (*capture_handler)(uint32_t id);
+
+/**
+ * \defgroup hal_capture Capture hal functions
+ *
+ * Timer input capture recording edge timestamps with DMA.
+ *
+ * # Defined behavior
+ * * ::capture_init configures the pin as a timer input capture channel for the edges given
+ * * ::capture_start writes the timestamp of each edge to the buffer, as a ring wrapping to
+ *   its start when it is full
+ * * Timestamps are the value of a free running counter, latched by the hardware on the edge,
+ *   counting at the frequency and with the number of bits returned by ::capture_get_info
+ * * The handler is called from interrupt context, with the id given to ::capture_start, when
+ *   the ring is half full and full
+ * * ::capture_position returns the ring index the next timestamp is written to
+ * * ::capture_start returns false when no DMA channel is available
+ *
+ * # Undefined behavior
+ * * Calling other function before ::capture_init
+ * * Calling ::capture_start while a capture is running
+ * * Timestamps overwritten in the ring before they are read
+ *
+ * @{
+ */
+
+/** Initialize the capture peripheral and configure the pin
+ *
+ * @param obj  The capture object to initialize
+ * @param pin  The capture pin
+ * @param edge The edges captured
+ */
+void capture_init(capture_t *obj, PinName pin, capture_edge_t edge);
+
+/** Deinitialize the capture peripheral
+ *
+ * @param obj The capture object
+ */
+void capture_free(capture_t *obj);
+
+/** Get the frequency and width of the timestamps
+ *
+ * @param obj The capture object
+ * @return The capture timer information
+ */
+const capture_info_t *capture_get_info(capture_t *obj);
+
+/** Start capturing edge timestamps into a circular DMA buffer
+ *
+ * @param obj     The capture object
+ * @param buffer  The ring buffer
+ * @param length  The number of timestamps of the ring buffer
+ * @param handler The handler called when the ring is half full and full
+ * @param id      The id passed to the handler
+ * @return true if the capture started, false if DMA is not available
+ */
+bool capture_start(capture_t *obj, uint32_t *buffer, size_t length, capture_handler handler, uint32_t id);
+
+/** Get the position DMA writes the next timestamp to
+ *
+ * @param obj The capture object
+ * @return Index in the ring buffer, in range 0 to length - 1
+ */
+size_t capture_position(capture_t *obj);
+
+/** Stop capturing
+ *
+ * @param obj The capture object
+ */
+void capture_stop(capture_t *obj);
+
+/** Get the pins that support input capture
+ *
+ * Return a PinMap array of pins that support input capture.
+ * The array is terminated with {NC, NC, 0}.
+ *
+ * @return PinMap array
+ */
+const PinMap *capture_pinmap(void);
+
+/**@}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+#endif
+
+/** @}*/
@@ -0,0 +1,87 @@
+/** \addtogroup hal */
+/** @{*/
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_CLOCK_SCALING_API_H
+#define MBED_CLOCK_SCALING_API_H
+
+#include <stdint.h>
+#include "device.h"
+
+#if DEVICE_CLOCK_SCALING
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \defgroup hal_clock_scaling Clock scaling hal functions
+ *
+ * Switch the core and bus clocks between performance levels at runtime.
+ *
+ * # Defined behavior
+ * * Level 0 is the clock configured at boot, the fastest. Each following
+ *   level is slower
+ * * ::clock_scaling_set_level keeps the us ticker counting at its frequency,
+ *   without losing its pending interrupt
+ * * The level is kept across deep sleep
+ *
+ * # Undefined behavior
+ * * Peripherals other than the us ticker keep their dividers, their
+ *   drivers recompute them, see mbed::ClockManager
+ * * Calling ::clock_scaling_set_level from interrupt context
+ *
+ * @{
+ */
+
+/** Get the number of performance levels
+ *
+ * @return The number of levels, at least 1
+ */
+uint8_t clock_scaling_level_count(void);
+
+/** Get the core clock frequency of a level
+ *
+ * @param level The level, below ::clock_scaling_level_count
+ * @return The frequency in Hz, or 0 if the level does not exist
+ */
+uint32_t clock_scaling_frequency(uint8_t level);
+
+/** Get the current level
+ *
+ * @return The current level
+ */
+uint8_t clock_scaling_get_level(void);
+
+/** Switch to a level
+ *
+ * @param level The level, below ::clock_scaling_level_count
+ * @return 0 on success, -1 if the level does not exist or the clock could not be switched
+ */
+int clock_scaling_set_level(uint8_t level);
+
+/**@}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+#endif
+
+/** @}*/
@@ -125,6 +125,21 @@ uint32_t flash_get_size(const flash_t *obj);
  */
 uint8_t flash_get_erase_value(const flash_t *obj);
 
+/** Get the flash bank size
+ *
+ * Banks are of equal size and start at the start of the flash region. A bank
+ * can be erased and programmed while code executes from, and data is read
+ * from, another bank. flash_erase_sector() and flash_program_page() should not
+ * mask interrupts for the duration of the operation when the address is in a
+ * bank other than the one executing.
+ *
+ * This function has a WEAK implementation returning the flash region size,
+ * for targets with a single bank.
+ * @param obj The flash object
+ * @return The size of a bank
+ */
+uint32_t flash_get_bank_size(const flash_t *obj);
+
 /**@}*/
 
 #ifdef __cplusplus
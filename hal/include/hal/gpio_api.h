@@ -48,6 +48,9 @@ extern "C" {
  * * The GPIO operations ::gpio_write, ::gpio_read take less than 20us to complete
  * * The function ::gpio_get_capabilities fills the given
  * `gpio_capabilities_t` instance according to pin capabilities.
+ * * A target defining GPIO_FAST_READY provides in gpio_object.h the static inline gpio_fast_write, gpio_fast_read,
+ *   gpio_fast_port_write and gpio_fast_port_read, which take the pin or port instead of a gpio_t, so that a constant
+ *   pin inlines to a single register access, see mbed::FastDigitalOut
  *
  * # Undefined behavior
  * * Calling any ::gpio_mode, ::gpio_dir, ::gpio_write or ::gpio_read on a gpio_t object that was initialized
@@ -33,6 +33,15 @@ extern "C" {
 
 typedef void (*ticker_irq_handler_type)(const ticker_data_t *const);
 
+/** Counters of the work done by the lp ticker wrapper
+ */
+typedef struct {
+    uint32_t writes;          /**< Matches written to the low power ticker */
+    uint32_t queued;          /**< Matches not written because an earlier match was pending */
+    uint32_t deferred;        /**< Matches scheduled with a microsecond Timeout */
+    uint32_t max_write_delay; /**< Longest delay before a match was written, in low power ticks */
+} lp_ticker_wrapper_stats_t;
+
 /**
  * Interrupt handler for the wrapped lp ticker
  *
@@ -69,6 +78,18 @@ void lp_ticker_wrapper_suspend(void);
  */
 void lp_ticker_wrapper_resume(void);
 
+/**
+ * Get the counters of the work done by the wrapper layer
+ *
+ * Matches are queued, instead of written, when a later match is set while
+ * an earlier one is pending and MBED_CONF_TARGET_LPTICKER_QUEUED_MATCH is
+ * enabled. The earlier match then fires first and the ticker sets the later
+ * one from its interrupt.
+ *
+ * @param stats The counters since the wrapper was created
+ */
+void lp_ticker_wrapper_get_stats(lp_ticker_wrapper_stats_t *stats);
+
 /**@}*/
 
 #ifdef __cplusplus
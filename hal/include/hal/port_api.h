@@ -21,6 +21,9 @@
 #define MBED_PORTMAP_H
 
 #include "device.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
 
 #if DEVICE_PORTIN || DEVICE_PORTOUT
 
@@ -84,6 +87,66 @@ int port_read(port_t *obj);
 
 /**@}*/
 
+#if DEVICE_PORT_DMA
+
+/**
+ * \defgroup hal_port_dma Port DMA HAL functions
+ *
+ * # Defined behaviour
+ * * ::port_dma_write writes the values to the port, as ::port_write does, one per period of
+ *   the frequency
+ * * The frequency used is the closest the target can generate, returned by ::port_dma_frequency
+ * * The port keeps the last value once the burst is done
+ * * The handler is called from interrupt context, with the id given to ::port_dma_write,
+ *   once the last value is written
+ * * ::port_dma_write returns false when no DMA channel or timer is available
+ *
+ * # Undefined behaviour
+ * * Calling ::port_dma_write while ::port_dma_active returns true
+ * * Calling ::port_write or ::port_dir while a burst is written
+ * * Modifying the values before the handler is called
+ * @{
+ */
+
+typedef void (*port_dma_handler)(uint32_t id);
+
+/** Get the write frequency a burst is written at
+ *
+ * @param obj       The port object
+ * @param frequency The frequency requested, in hertz
+ * @return The frequency used, in hertz, or 0 if it cannot be generated
+ */
+uint32_t port_dma_frequency(port_t *obj, uint32_t frequency);
+
+/** Start writing a burst of values to the port with DMA
+ *
+ * @param obj       The port object
+ * @param values    The values to write
+ * @param length    The number of values
+ * @param frequency The frequency values are written at, in hertz
+ * @param handler   The handler called once the burst is written
+ * @param id        The id passed to the handler
+ * @return true if the burst started, false if DMA is not available
+ */
+bool port_dma_write(port_t *obj, const uint32_t *values, size_t length, uint32_t frequency, port_dma_handler handler, uint32_t id);
+
+/** Check whether a burst is being written
+ *
+ * @param obj The port object
+ * @return true until the last value is written
+ */
+bool port_dma_active(port_t *obj);
+
+/** Stop writing a burst
+ *
+ * @param obj The port object
+ */
+void port_dma_stop(port_t *obj);
+
+/**@}*/
+
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -22,6 +22,9 @@
 
 #include "device.h"
 #include "pinmap.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
 
 #if DEVICE_PWMOUT
 
@@ -173,6 +176,65 @@ const PinMap *pwmout_pinmap(void);
 
 /**@}*/
 
+#if DEVICE_PWMOUT_DMA
+
+/**
+ * \defgroup hal_pwmout_dma Pwmout DMA hal functions
+ *
+ * # Defined behavior
+ * * ::pwmout_dma_start outputs one pulse width of the sequence per PWM period, from the next period
+ * * Pulse widths are in timer ticks, in range <0, ::pwmout_dma_period_ticks>
+ * * The output keeps the last pulse width of the sequence once it is done
+ * * The handler is called from interrupt context, with the id given to ::pwmout_dma_start,
+ *   once the last pulse width is loaded
+ * * ::pwmout_dma_start returns false when no DMA channel is available
+ * * ::pwmout_dma_stop stops the sequence, keeping the pulse width being output
+ *
+ * # Undefined behavior
+ * * Calling ::pwmout_dma_start while ::pwmout_dma_active returns true
+ * * Changing the period or the pulse width while a sequence is output
+ * * Modifying the sequence before the handler is called
+ *
+ * @{
+ */
+
+typedef void (*pwmout_dma_handler)(uint32_t id);
+
+/** Get the number of timer ticks in a PWM period
+ *
+ * @param obj The pwmout object
+ * @return The pulse width of a 100% duty-cycle, in range <1, 65535>
+ */
+uint32_t pwmout_dma_period_ticks(pwmout_t *obj);
+
+/** Start outputting a sequence of pulse widths with DMA
+ *
+ * @param obj     The pwmout object
+ * @param pulses  The pulse widths in timer ticks, one per period
+ * @param length  The number of pulse widths
+ * @param handler The handler called once the sequence is output
+ * @param id      The id passed to the handler
+ * @return true if the sequence started, false if DMA is not available
+ */
+bool pwmout_dma_start(pwmout_t *obj, const uint16_t *pulses, size_t length, pwmout_dma_handler handler, uint32_t id);
+
+/** Check whether a sequence is being output
+ *
+ * @param obj The pwmout object
+ * @return true until the last pulse width is loaded
+ */
+bool pwmout_dma_active(pwmout_t *obj);
+
+/** Stop outputting a sequence
+ *
+ * @param obj The pwmout object
+ */
+void pwmout_dma_stop(pwmout_t *obj);
+
+/**@}*/
+
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -215,6 +215,32 @@ qspi_status_t qspi_command_transfer(qspi_t *obj, const qspi_command_t *command,
  */
 qspi_status_t qspi_read(qspi_t *obj, const qspi_command_t *command, void *data, size_t *length);
 
+#if DEVICE_QSPI_MEMORY_MAPPED
+
+/** Enter memory-mapped mode
+ *
+ * In memory-mapped mode the peripheral issues the given read command for every
+ * access to its mapped window. No other transfer is allowed until the mode is exited.
+ *
+ * @param obj QSPI object
+ * @param command QSPI read command (the address is ignored)
+ * @param[out] address Start of the mapped window (address 0 of the external memory)
+ * @return QSPI_STATUS_OK if memory-mapped mode was entered
+           QSPI_STATUS_INVALID_PARAMETER if invalid parameter found
+           QSPI_STATUS_ERROR otherwise
+ */
+qspi_status_t qspi_memory_mapped_enter(qspi_t *obj, const qspi_command_t *command, const void **address);
+
+/** Exit memory-mapped mode, returning to command mode
+ *
+ * @param obj QSPI object
+ * @return QSPI_STATUS_OK if memory-mapped mode was exited
+           QSPI_STATUS_ERROR otherwise
+ */
+qspi_status_t qspi_memory_mapped_exit(qspi_t *obj);
+
+#endif
+
 /** Get the pins that support QSPI SCLK
  *
  * Return a PinMap array of pins that support QSPI SCLK in
@@ -455,6 +455,76 @@ void serial_rx_abort_asynch(serial_t *obj);
 
 #endif
 
+#if DEVICE_SERIAL_DMA
+
+/**
+ * \defgroup hal_DmaSerial Serial DMA Hardware Abstraction Layer
+ *
+ * # Defined behaviour
+ * * ::serial_rx_dma_start receives into the buffer as a ring, wrapping to its start when it is full
+ * * The RX handler is called when the line goes idle after a character, and when the ring
+ *   is half full and full
+ * * ::serial_rx_dma_position returns the ring index the next character is written to
+ * * ::serial_tx_dma_start calls the TX handler once the last byte is sent
+ * * ::serial_rx_dma_start and ::serial_tx_dma_start return false when no DMA channel is available
+ * * Handlers are called from interrupt context with the id given when the transfer started
+ *
+ * # Undefined behaviour
+ * * Calling ::serial_rx_dma_start while RX DMA is running
+ * * Calling ::serial_tx_dma_start while ::serial_tx_dma_active returns true
+ * * Using ::serial_getc, ::serial_putc or ::serial_irq_set on a direction while DMA runs on it
+ * * Characters overwritten in the ring before they are read
+ * @{
+ */
+
+typedef void (*serial_dma_handler)(uint32_t id);
+
+/** Start receiving into a circular DMA buffer
+ *
+ * @param obj     The serial object
+ * @param buffer  The ring buffer
+ * @param length  The size of the ring buffer
+ * @param handler The handler called on idle line, half full and full
+ * @param id      The id passed to the handler
+ * @return true if reception started, false if DMA is not available
+ */
+bool serial_rx_dma_start(serial_t *obj, uint8_t *buffer, size_t length, serial_dma_handler handler, uint32_t id);
+
+/** Get the position DMA writes the next received character to
+ *
+ * @param obj The serial object
+ * @return Index in the ring buffer, in range 0 to length - 1
+ */
+size_t serial_rx_dma_position(serial_t *obj);
+
+/** Stop receiving with DMA
+ *
+ * @param obj The serial object
+ */
+void serial_rx_dma_stop(serial_t *obj);
+
+/** Start transmitting a buffer with DMA
+ *
+ * @param obj     The serial object
+ * @param buffer  The data to send, which must stay valid until the handler is called
+ * @param length  The number of bytes to send
+ * @param handler The handler called once the data is sent
+ * @param id      The id passed to the handler
+ * @return true if transmission started, false if DMA is not available
+ */
+bool serial_tx_dma_start(serial_t *obj, const uint8_t *buffer, size_t length, serial_dma_handler handler, uint32_t id);
+
+/** Check whether a DMA transmission is ongoing
+ *
+ * @param obj The serial object
+ * @return true until the last byte of the transmission is sent
+ */
+bool serial_tx_dma_active(serial_t *obj);
+
+/**@}*/
+
+#endif
+
 #ifdef __cplusplus
 }
 #endif
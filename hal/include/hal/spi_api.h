@@ -83,6 +83,7 @@ typedef struct {
     uint8_t     clk_modes; /**< specifies supported modes from spi_mode_t. Each bit represents the corresponding mode. */
     bool        support_slave_mode; /**< If true, the device can handle SPI slave mode using hardware management on the specified ssel pin. */
     bool        hw_cs_handle; /**< If true, in SPI master mode Chip Select can be handled by hardware. */
+    bool        hw_cs_hold; /**< If true, ::spi_master_cs_hold can keep the hardware Chip Select asserted between asynchronous transfers. */
     bool        async_mode; /**< If true, in async mode is supported. */
     bool        tx_rx_buffers_equal_length; /**< If true, rx and tx buffers must have the same length. */
 } spi_capabilities_t;
@@ -411,6 +412,41 @@ uint8_t spi_active(spi_t *obj);
  */
 void spi_abort_asynch(spi_t *obj);
 
+/** Keep the hardware chip select asserted between asynchronous transfers
+ *
+ * With hold set, the chip select driven by the hardware stays asserted at the end of the transfers started by
+ * ::spi_master_transfer. Once hold is cleared, the next transfer releases it at its end, and ::spi_abort_asynch
+ * releases it right away. Only supported if ::spi_get_capabilities reports hw_cs_hold, otherwise it does nothing.
+ *
+ * @param obj  The SPI peripheral
+ * @param hold true to keep the chip select asserted
+ */
+void spi_master_cs_hold(spi_t *obj, bool hold);
+
+/** Begin an asynchronous SPI slave transfer
+ *
+ * The transfer is armed right away and runs as the master clocks the frames, the handler is called with the same
+ * conventions as for ::spi_master_transfer, and ::spi_irq_handler_asynch, ::spi_active and ::spi_abort_asynch apply
+ * to it. If both buffers are given, the shorter length is transferred. A new transfer can be started from the
+ * handler, so that the next buffers are armed before the master clocks the next frame.
+ *
+ * The DMA hint is a suggestion only. Targets without SPI DMA support, such as STM32, move the frames from the SPI
+ * interrupt whatever the hint is, so the interrupt has to be serviced once per frame.
+ *
+ * @param[in] obj       The SPI object, formatted as slave
+ * @param[in] tx        The transmit buffer, or NULL to send the fill character
+ * @param[in] tx_length The number of bytes to transmit
+ * @param[in] rx        The receive buffer, or NULL to drop the received data
+ * @param[in] rx_length The number of bytes to receive
+ * @param[in] bit_width The bit width of buffer words
+ * @param[in] handler   SPI interrupt handler
+ * @param[in] event     The logical OR of events to be registered
+ * @param[in] hint      A suggestion for how to use DMA with this transfer
+ * @return true if the transfer was started, false if the peripheral is busy, the buffers can not be transferred at
+ *         once or the target has no asynchronous slave support
+ */
+bool spi_slave_transfer(spi_t *obj, const void *tx, size_t tx_length, void *rx, size_t rx_length, uint8_t bit_width, uint32_t handler, uint32_t event, DMAUsage hint);
+
 
 #endif
 
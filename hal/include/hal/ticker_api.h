@@ -38,12 +38,26 @@ typedef uint32_t timestamp_t;
  */
 typedef uint64_t us_timestamp_t;
 
+/* Keep the events of a ticker in a pairing heap instead of a sorted list.
+ * Inserting an event is then O(1) and removing one O(log n) amortized,
+ * instead of O(n), at the cost of two pointers per event. Events with the
+ * same timestamp are no longer guaranteed to run in insertion order.
+ */
+#ifndef MBED_CONF_TARGET_TICKER_EVENT_HEAP
+#define MBED_CONF_TARGET_TICKER_EVENT_HEAP 0
+#endif
+
 /** Ticker's event structure
  */
 typedef struct ticker_event_s {
     us_timestamp_t         timestamp; /**< Event's timestamp */
     uint32_t               id;        /**< TimerEvent object */
-    struct ticker_event_s *next;      /**< Next event in the queue */
+    struct ticker_event_s *next;      /**< Next event in the queue, or next sibling in the heap */
+    uint32_t               slack;     /**< Time in us the event may run late by, to share an interrupt */
+#if MBED_CONF_TARGET_TICKER_EVENT_HEAP
+    struct ticker_event_s *child;     /**< First child in the heap */
+    struct ticker_event_s *prev;      /**< Parent of a first child, or previous sibling in the heap */
+#endif
 } ticker_event_t;
 
 typedef void (*ticker_event_handler)(uint32_t id);
@@ -109,7 +123,7 @@ typedef struct {
  */
 typedef struct {
     ticker_event_handler event_handler; /**< Event handler */
-    ticker_event_t *head;               /**< A pointer to head */
+    ticker_event_t *head;               /**< A pointer to head, the earliest event */
 #ifndef MBED_TICKER_CONSTANT_PERIOD_NUM
     uint32_t period_num;                /**< Ratio of period to 1us, numerator */
 #endif
@@ -128,6 +142,7 @@ typedef struct {
     uint32_t tick_remainder;            /**< Ticks that have not been added to base_time */
 #endif
     us_timestamp_t present_time;        /**< Store the timestamp used for present time */
+    uint32_t update_count;              /**< Incremented before and after the present time is updated, see ticker_read_us */
     bool initialized;                   /**< Indicate if the instance is initialized */
     bool dispatching;                   /**< The function ticker_irq_handler is dispatching */
     bool suspended;                     /**< Indicate if the instance is suspended */
@@ -210,6 +225,21 @@ void ticker_insert_event(const ticker_data_t *const ticker, ticker_event_t *obj,
  */
 void ticker_insert_event_us(const ticker_data_t *const ticker, ticker_event_t *obj, us_timestamp_t timestamp, uint32_t id);
 
+/** Insert an event to the queue, allowing it to run late
+ *
+ * Behaves like ticker_insert_event_us, except that the event may run up to
+ * slack us after its timestamp. The ticker interrupt is then set to the
+ * earliest timestamp plus slack of the pending events, and every event due
+ * by that time runs from the same interrupt, saving wake-ups.
+ *
+ * @param ticker    The ticker object.
+ * @param obj       The event object to be inserted to the queue
+ * @param timestamp The event's timestamp
+ * @param id        The event object
+ * @param slack     Time in us the event may be delayed by
+ */
+void ticker_insert_event_us_slack(const ticker_data_t *const ticker, ticker_event_t *obj, us_timestamp_t timestamp, uint32_t id, uint32_t slack);
+
 /** Read the current (relative) ticker's timestamp
  *
  * @warning Return a relative timestamp because the counter wrap every 4294
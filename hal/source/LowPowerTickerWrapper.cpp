@@ -20,7 +20,7 @@
 using namespace mbed::chrono;
 
 LowPowerTickerWrapper::LowPowerTickerWrapper(const ticker_data_t *data, const ticker_interface_t *interface, uint32_t min_cycles_between_writes, uint32_t min_cycles_until_match)
-    : _intf(data->interface), _min_count_between_writes(min_cycles_between_writes + 1), _min_count_until_match(min_cycles_until_match + 1), _suspended(false)
+    : _intf(data->interface), _min_count_between_writes(min_cycles_between_writes + 1), _min_count_until_match(min_cycles_until_match + 1), _suspended(false), _stats()
 {
     core_util_critical_section_enter();
 
@@ -101,6 +101,16 @@ bool LowPowerTickerWrapper::timeout_pending()
     return pending;
 }
 
+LowPowerTickerWrapper::stats_t LowPowerTickerWrapper::get_stats()
+{
+    core_util_critical_section_enter();
+
+    stats_t stats = _stats;
+
+    core_util_critical_section_exit();
+    return stats;
+}
+
 void LowPowerTickerWrapper::init()
 {
     core_util_critical_section_enter();
@@ -138,7 +148,19 @@ void LowPowerTickerWrapper::set_interrupt(timestamp_t timestamp)
 {
     core_util_critical_section_enter();
 
-    _last_set_interrupt = _intf->read();
+    timestamp_t current = _intf->read();
+#if MBED_CONF_TARGET_LPTICKER_QUEUED_MATCH
+    // The pending match is written or has a Timeout, so it fires first and
+    // the ticker queue sets the later match from its interrupt. This trades
+    // a write, possibly delayed by a Timeout, for an early interrupt.
+    if (!_suspended && _pending_match && !_match_check(current) &&
+            (((timestamp - current) & _mask) > ((_cur_match_time - current) & _mask))) {
+        _stats.queued++;
+        core_util_critical_section_exit();
+        return;
+    }
+#endif
+    _last_set_interrupt = current;
     _cur_match_time = timestamp;
     _pending_match = true;
     if (!_suspended) {
@@ -281,6 +303,7 @@ void LowPowerTickerWrapper::_schedule_match(timestamp_t current)
             uint32_t ticks = cycles_until_match < _min_count_until_match ? cycles_until_match : _min_count_until_match;
             _timeout.attach(mbed::callback(this, &LowPowerTickerWrapper::_timeout_handler), _lp_ticks_to_us(ticks));
             _pending_timeout = true;
+            _stats.deferred++;
         }
         return;
     }
@@ -288,6 +311,11 @@ void LowPowerTickerWrapper::_schedule_match(timestamp_t current)
     if (!too_close) {
 
         // Schedule LP ticker
+        uint32_t write_delay = (current - _last_set_interrupt) & _mask;
+        if (write_delay > _stats.max_write_delay) {
+            _stats.max_write_delay = write_delay;
+        }
+        _stats.writes++;
         _intf->set_interrupt(_cur_match_time);
         current = _intf->read();
         _last_actual_set_interrupt = current;
@@ -313,6 +341,7 @@ void LowPowerTickerWrapper::_schedule_match(timestamp_t current)
         uint32_t ticks = cycles_until_match < _min_count_until_match ? cycles_until_match : _min_count_until_match;
         _timeout.attach(mbed::callback(this, &LowPowerTickerWrapper::_timeout_handler), _lp_ticks_to_us(ticks));
         _pending_timeout = true;
+        _stats.deferred++;
         return;
     }
 }
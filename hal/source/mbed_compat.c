@@ -54,6 +54,7 @@ MBED_WEAK void spi_get_capabilities(PinName ssel, bool slave, spi_capabilities_t
         cap->word_length = 0x00008080;              // 8 and 16 bit symbols
         cap->support_slave_mode = false;            // to be determined later based on ssel
         cap->hw_cs_handle = false;                  // irrelevant in slave mode
+        cap->hw_cs_hold = false;                    // no chip select hold between transfers
         cap->slave_delay_between_symbols_ns = 2500; // 2.5 us
         cap->clk_modes = 0x0f;                      // all clock modes
         cap->tx_rx_buffers_equal_length = true;     // rx buffer size must be equal tx buffer size
@@ -68,6 +69,7 @@ MBED_WEAK void spi_get_capabilities(PinName ssel, bool slave, spi_capabilities_t
         cap->word_length = 0x00008080;            // 8 and 16 bit symbols
         cap->support_slave_mode = false;          // to be determined later based on ssel
         cap->hw_cs_handle = false;                // to be determined later based on ssel
+        cap->hw_cs_hold = false;                  // no chip select hold between transfers
         cap->slave_delay_between_symbols_ns = 0;  // irrelevant in master mode
         cap->clk_modes = 0x0f;                    // all clock modes
         cap->tx_rx_buffers_equal_length = true;   // rx buffer size must be equal tx buffer size
@@ -92,6 +94,30 @@ MBED_WEAK void spi_get_capabilities(PinName ssel, bool slave, spi_capabilities_t
     }
 }
 
+#if DEVICE_SPI_ASYNCH
+// Default capabilities report no chip select hold
+MBED_WEAK void spi_master_cs_hold(spi_t *obj, bool hold)
+{
+    (void)obj;
+    (void)hold;
+}
+
+// Targets without asynchronous slave support can not start a transfer
+MBED_WEAK bool spi_slave_transfer(spi_t *obj, const void *tx, size_t tx_length, void *rx, size_t rx_length, uint8_t bit_width, uint32_t handler, uint32_t event, DMAUsage hint)
+{
+    (void)obj;
+    (void)tx;
+    (void)tx_length;
+    (void)rx;
+    (void)rx_length;
+    (void)bit_width;
+    (void)handler;
+    (void)event;
+    (void)hint;
+    return false;
+}
+#endif
+
 #endif
 
 #if DEVICE_RESET_REASON
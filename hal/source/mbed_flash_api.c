@@ -28,4 +28,9 @@ MBED_WEAK int32_t flash_read(flash_t *obj, uint32_t address, uint8_t *data, uint
     return 0;
 }
 
+MBED_WEAK uint32_t flash_get_bank_size(const flash_t *obj)
+{
+    return flash_get_size(obj);
+}
+
 #endif
@@ -126,4 +126,18 @@ void lp_ticker_wrapper_resume()
     ticker_wrapper->resume();
 }
 
+void lp_ticker_wrapper_get_stats(lp_ticker_wrapper_stats_t *stats)
+{
+    if (!init) {
+        // Force ticker to initialize
+        get_lp_ticker_data();
+    }
+
+    LowPowerTickerWrapper::stats_t wrapper_stats = ticker_wrapper->get_stats();
+    stats->writes = wrapper_stats.writes;
+    stats->queued = wrapper_stats.queued;
+    stats->deferred = wrapper_stats.deferred;
+    stats->max_write_delay = wrapper_stats.max_write_delay;
+}
+
 #endif
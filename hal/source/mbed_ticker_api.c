@@ -18,6 +18,7 @@
 #include <stddef.h>
 #include "hal/ticker_api.h"
 #include "platform/mbed_critical.h"
+#include "platform/mbed_atomic.h"
 #include "platform/mbed_assert.h"
 #include "platform/mbed_error.h"
 
@@ -230,6 +231,7 @@ static void initialize(const ticker_data_t *ticker)
     ticker->queue->tick_last_read = ticker->interface->read();
     TICKER_SET_TICK_REMAINDER(ticker->queue, 0);
     ticker->queue->present_time = 0;
+    ticker->queue->update_count = 0;
     ticker->queue->dispatching = false;
     ticker->queue->suspended = false;
     ticker->queue->initialized = true;
@@ -278,23 +280,12 @@ static us_timestamp_t convert_timestamp(us_timestamp_t ref, timestamp_t timestam
 }
 
 /**
- * Update the present timestamp value of a ticker.
+ * Convert ticks elapsed since the last update of the present time to us,
+ * adding in the remainder from the last conversion. The ticks left over
+ * are stored in remainder.
  */
-static void update_present_time(const ticker_data_t *const ticker)
+static uint64_t convert_elapsed_ticks(const ticker_event_queue_t *queue, uint32_t elapsed_ticks, uint32_t *remainder)
 {
-    ticker_event_queue_t *queue = ticker->queue;
-    if (queue->suspended) {
-        return;
-    }
-    uint32_t ticker_time = ticker->interface->read();
-    if (ticker_time == queue->tick_last_read) {
-        // No work to do
-        return;
-    }
-
-    uint32_t elapsed_ticks = (ticker_time - queue->tick_last_read) & TICKER_BITMASK(queue);
-    queue->tick_last_read = ticker_time;
-
     // Convert elapsed_ticks to elapsed_us as (elapsed_ticks * period_num / period_den)
     // adding in any remainder from the last division
     uint64_t scaled_ticks;
@@ -304,24 +295,66 @@ static void update_present_time(const ticker_data_t *const ticker)
         scaled_ticks = (uint64_t) elapsed_ticks * TICKER_PERIOD_NUM(queue);
     }
     uint64_t elapsed_us;
+    *remainder = TICKER_TICK_REMAINDER(queue);
     if (TICKER_PERIOD_DEN_SHIFTS(queue) == 0) {
         // Optimized for cases that don't need division
         elapsed_us = scaled_ticks;
     } else {
-        scaled_ticks += TICKER_TICK_REMAINDER(queue);
+        scaled_ticks += *remainder;
         if (TICKER_PERIOD_DEN_SHIFTS(queue) >= 0) {
             // Speed-optimised for shifts
             elapsed_us = scaled_ticks >> TICKER_PERIOD_DEN_SHIFTS(queue);
-            TICKER_SET_TICK_REMAINDER(queue, scaled_ticks - (elapsed_us << TICKER_PERIOD_DEN_SHIFTS(queue)));
+            *remainder = (uint32_t)(scaled_ticks - (elapsed_us << TICKER_PERIOD_DEN_SHIFTS(queue)));
         } else {
             // General case division
             elapsed_us = scaled_ticks / TICKER_PERIOD_DEN(queue);
-            TICKER_SET_TICK_REMAINDER(queue, scaled_ticks - elapsed_us * TICKER_PERIOD_DEN(queue));
+            *remainder = (uint32_t)(scaled_ticks - elapsed_us * TICKER_PERIOD_DEN(queue));
         }
     }
+    return elapsed_us;
+}
+
+/**
+ * Mark the start and the end of a change of the present time. The changes
+ * are made in critical sections, the count lets ticker_read_us read the
+ * present time without one: it is odd during a change, and differs once
+ * a change happened.
+ */
+static inline void begin_present_time_update(ticker_event_queue_t *queue)
+{
+    core_util_atomic_store_u32(&queue->update_count, queue->update_count + 1);
+}
+
+static inline void end_present_time_update(ticker_event_queue_t *queue)
+{
+    core_util_atomic_store_u32(&queue->update_count, queue->update_count + 1);
+}
+
+/**
+ * Update the present timestamp value of a ticker.
+ */
+static void update_present_time(const ticker_data_t *const ticker)
+{
+    ticker_event_queue_t *queue = ticker->queue;
+    if (queue->suspended) {
+        return;
+    }
+    uint32_t ticker_time = ticker->interface->read();
+    if (ticker_time == queue->tick_last_read) {
+        // No work to do
+        return;
+    }
+
+    uint32_t elapsed_ticks = (ticker_time - queue->tick_last_read) & TICKER_BITMASK(queue);
+    uint32_t remainder;
+    uint64_t elapsed_us = convert_elapsed_ticks(queue, elapsed_ticks, &remainder);
 
     // Update current time
+    begin_present_time_update(queue);
+    queue->tick_last_read = ticker_time;
+    TICKER_SET_TICK_REMAINDER(queue, remainder);
     queue->present_time += elapsed_us;
+    end_present_time_update(queue);
 }
 
 /**
@@ -365,15 +398,127 @@ static timestamp_t compute_tick_round_up(const ticker_data_t *const ticker, us_t
     return (queue->tick_last_read + delta) & TICKER_BITMASK(queue);
 }
 
+#if MBED_CONF_TARGET_TICKER_EVENT_HEAP
+/* Pairing heap of events. queue->head is the root, the earliest event.
+ * Children of a node are linked through next, the first child's prev points
+ * to its parent and every other child's prev to its previous sibling. Events
+ * not in the heap, other than the root, have a NULL prev.
+ */
+
+/* Merge two heaps; on equal timestamps a stays first */
+static ticker_event_t *heap_meld(ticker_event_t *a, ticker_event_t *b)
+{
+    if (a == NULL) {
+        return b;
+    }
+    if (b == NULL) {
+        return a;
+    }
+    if (b->timestamp < a->timestamp) {
+        ticker_event_t *tmp = a;
+        a = b;
+        b = tmp;
+    }
+    b->prev = a;
+    b->next = a->child;
+    if (a->child != NULL) {
+        a->child->prev = b;
+    }
+    a->child = b;
+    return a;
+}
+
+/* Merge the siblings starting at first into one heap, in two passes */
+static ticker_event_t *heap_merge_pairs(ticker_event_t *first)
+{
+    ticker_event_t *pairs = NULL;
+    ticker_event_t *root = NULL;
+
+    // left to right, meld siblings two by two and stack the results
+    while (first != NULL) {
+        ticker_event_t *a = first;
+        ticker_event_t *b = a->next;
+        first = b != NULL ? b->next : NULL;
+        a->prev = NULL;
+        if (b != NULL) {
+            b->prev = NULL;
+            a = heap_meld(a, b);
+        }
+        a->next = pairs;
+        pairs = a;
+    }
+
+    // right to left, meld the stacked pairs into the root
+    while (pairs != NULL) {
+        ticker_event_t *a = pairs;
+        pairs = a->next;
+        a->next = NULL;
+        root = heap_meld(root, a);
+    }
+
+    if (root != NULL) {
+        root->prev = NULL;
+    }
+    return root;
+}
+
+static void heap_pop(ticker_event_queue_t *queue)
+{
+    ticker_event_t *obj = queue->head;
+
+    queue->head = heap_merge_pairs(obj->child);
+    obj->child = NULL;
+}
+
+/* Return false if obj is not in the heap */
+static bool heap_remove(ticker_event_queue_t *queue, ticker_event_t *obj)
+{
+    if (obj == queue->head) {
+        heap_pop(queue);
+        return true;
+    }
+    if (obj->prev == NULL) {
+        return false;
+    }
+
+    // unlink from the parent or previous sibling, then meld the children back
+    if (obj->prev->child == obj) {
+        obj->prev->child = obj->next;
+    } else {
+        obj->prev->next = obj->next;
+    }
+    if (obj->next != NULL) {
+        obj->next->prev = obj->prev;
+    }
+    obj->next = NULL;
+    obj->prev = NULL;
+
+    queue->head = heap_meld(queue->head, heap_merge_pairs(obj->child));
+    obj->child = NULL;
+    return true;
+}
+#endif
+
 //NOTE: Must be called from critical section!
-static void insert_event(const ticker_data_t *const ticker, ticker_event_t *obj, us_timestamp_t timestamp, uint32_t id)
+static void insert_event(const ticker_data_t *const ticker, ticker_event_t *obj, us_timestamp_t timestamp, uint32_t id, uint32_t slack)
 {
     ticker_event_queue_t *queue = ticker->queue;
 
     // initialise our data
     obj->timestamp = timestamp;
     obj->id = id;
+    obj->slack = slack;
+
+#if MBED_CONF_TARGET_TICKER_EVENT_HEAP
+    obj->next = NULL;
+    obj->child = NULL;
+    obj->prev = NULL;
+    queue->head = heap_meld(queue->head, obj);
 
+    if (queue->head == obj || timestamp <= queue->present_time || queue->head->slack != 0) {
+        schedule_interrupt(ticker);
+    }
+#else
     /* Go through the list until we either reach the end, or find
        an element this should come before (which is possibly the
        head). */
@@ -398,9 +543,10 @@ static void insert_event(const ticker_data_t *const ticker, ticker_event_t *obj,
         prev->next = obj;
     }
 
-    if (prev == NULL || timestamp <= queue->present_time) {
+    if (prev == NULL || timestamp <= queue->present_time || queue->head->slack != 0) {
         schedule_interrupt(ticker);
     }
+#endif
 }
 
 /**
@@ -428,6 +574,58 @@ int _ticker_match_interval_passed(timestamp_t prev_tick, timestamp_t cur_tick, t
  * in ticker.queue.max_delta. This is necessary to keep track
  * of the timer overflow.
  */
+/* Latest time the next interrupt can be set to so that no event runs later
+ * than its timestamp plus slack. Only events due before it can bring it
+ * forward, and all events due by then run from that interrupt.
+ */
+static us_timestamp_t queue_deadline(const ticker_event_queue_t *queue)
+{
+    const ticker_event_t *head = queue->head;
+    us_timestamp_t deadline = head->timestamp + head->slack;
+
+    if (head->slack == 0) {
+        // nothing is due before the head
+        return deadline;
+    }
+
+#if MBED_CONF_TARGET_TICKER_EVENT_HEAP
+    // Walk the heap in depth first order, skipping the children of events
+    // due after the deadline as they are due even later.
+    const ticker_event_t *p = head->child;
+    while (p != NULL) {
+        if (p->timestamp < deadline) {
+            if (p->timestamp + p->slack < deadline) {
+                deadline = p->timestamp + p->slack;
+            }
+            if (p->child != NULL) {
+                p = p->child;
+                continue;
+            }
+        }
+        // go to the next sibling, climbing back to the parents whose
+        // siblings were not visited yet
+        while (p->next == NULL) {
+            while (p->prev->child != p) {
+                p = p->prev;
+            }
+            p = p->prev;
+            if (p == head) {
+                return deadline;
+            }
+        }
+        p = p->next;
+    }
+#else
+    for (const ticker_event_t *p = head->next; p != NULL && p->timestamp < deadline; p = p->next) {
+        if (p->timestamp + p->slack < deadline) {
+            deadline = p->timestamp + p->slack;
+        }
+    }
+#endif
+
+    return deadline;
+}
+
 static void schedule_interrupt(const ticker_data_t *const ticker)
 {
     ticker_event_queue_t *queue = ticker->queue;
@@ -450,6 +648,9 @@ static void schedule_interrupt(const ticker_data_t *const ticker)
             return;
         }
 
+        // let events with slack wait for the ones due after them
+        match_time = queue_deadline(queue);
+
         timestamp_t match_tick = compute_tick_round_up(ticker, match_time);
 
         // The same tick should never occur since match_tick is rounded up.
@@ -503,7 +704,11 @@ void ticker_irq_handler(const ticker_data_t *const ticker)
             // This event was in the past:
             //      point to the following one and execute its handler
             ticker_event_t *p = ticker->queue->head;
+#if MBED_CONF_TARGET_TICKER_EVENT_HEAP
+            heap_pop(queue);
+#else
             queue->head = queue->head->next;
+#endif
             if (queue->event_handler != NULL) {
                 (*queue->event_handler)(p->id); // NOTE: the handler can set new events
             }
@@ -532,7 +737,7 @@ void ticker_insert_event(const ticker_data_t *const ticker, ticker_event_t *obj,
                                             timestamp
                                         );
 
-    insert_event(ticker, obj, absolute_timestamp, id);
+    insert_event(ticker, obj, absolute_timestamp, id, 0);
 
     core_util_critical_section_exit();
 }
@@ -544,7 +749,19 @@ void ticker_insert_event_us(const ticker_data_t *const ticker, ticker_event_t *o
     // update the current timestamp
     update_present_time(ticker);
 
-    insert_event(ticker, obj, timestamp, id);
+    insert_event(ticker, obj, timestamp, id, 0);
+
+    core_util_critical_section_exit();
+}
+
+void ticker_insert_event_us_slack(const ticker_data_t *const ticker, ticker_event_t *obj, us_timestamp_t timestamp, uint32_t id, uint32_t slack)
+{
+    core_util_critical_section_enter();
+
+    // update the current timestamp
+    update_present_time(ticker);
+
+    insert_event(ticker, obj, timestamp, id, slack);
 
     core_util_critical_section_exit();
 }
@@ -554,6 +771,12 @@ void ticker_remove_event(const ticker_data_t *const ticker, ticker_event_t *obj)
     core_util_critical_section_enter();
     ticker_event_queue_t *queue = ticker->queue;
 
+#if MBED_CONF_TARGET_TICKER_EVENT_HEAP
+    bool was_head = queue->head == obj;
+    if (heap_remove(queue, obj) && was_head) {
+        schedule_interrupt(ticker);
+    }
+#else
     // remove this object from the list
     if (queue->head == obj) {
         // first in the list, so just drop me
@@ -570,6 +793,7 @@ void ticker_remove_event(const ticker_data_t *const ticker, ticker_event_t *obj)
             p = p->next;
         }
     }
+#endif
 
     core_util_critical_section_exit();
 }
@@ -581,14 +805,34 @@ timestamp_t ticker_read(const ticker_data_t *const ticker)
 
 us_timestamp_t ticker_read_us(const ticker_data_t *const ticker)
 {
+    ticker_event_queue_t *queue = ticker->queue;
     us_timestamp_t ret;
+    uint32_t count;
 
     initialize(ticker);
 
-    core_util_critical_section_enter();
-    update_present_time(ticker);
-    ret = ticker->queue->present_time;
-    core_util_critical_section_exit();
+    // Add the time elapsed since the last update of the present time,
+    // without storing it, and read again if the present time was updated
+    // meanwhile. Interrupts are not disabled.
+    do {
+        count = core_util_atomic_load_u32(&queue->update_count);
+        ret = queue->present_time;
+        if (!queue->suspended) {
+            uint32_t elapsed_ticks = (ticker->interface->read() - queue->tick_last_read) & TICKER_BITMASK(queue);
+            if (elapsed_ticks > TICKER_MAX_DELTA(queue)) {
+                // The interrupt which keeps the present time from wrapping
+                // is late, interrupts may be disabled: update it here
+                core_util_critical_section_enter();
+                update_present_time(ticker);
+                ret = queue->present_time;
+                core_util_critical_section_exit();
+                return ret;
+            }
+            uint32_t remainder;
+            ret += convert_elapsed_ticks(queue, elapsed_ticks, &remainder);
+        }
+        MBED_BARRIER();
+    } while ((count & 1) || count != core_util_atomic_load_u32(&queue->update_count));
 
     return ret;
 }
@@ -627,7 +871,9 @@ void ticker_suspend(const ticker_data_t *const ticker)
 {
     core_util_critical_section_enter();
 
+    begin_present_time_update(ticker->queue);
     ticker->queue->suspended = true;
+    end_present_time_update(ticker->queue);
 
     core_util_critical_section_exit();
 }
@@ -638,7 +884,9 @@ void ticker_resume(const ticker_data_t *const ticker)
 
     ticker->queue->suspended = false;
     if (ticker->queue->initialized) {
+        begin_present_time_update(ticker->queue);
         ticker->queue->tick_last_read = ticker->interface->read();
+        end_present_time_update(ticker->queue);
 
         update_present_time(ticker);
         schedule_interrupt(ticker);
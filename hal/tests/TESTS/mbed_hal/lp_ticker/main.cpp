@@ -166,6 +166,46 @@ void lp_ticker_glitch_test()
     }
 }
 
+#if DEVICE_LPTICKER && (LPTICKER_DELAY_TICKS > 0)
+static volatile bool wrapper_event_fired;
+
+static void wrapper_event_handler()
+{
+    wrapper_event_fired = true;
+}
+
+static void wrapper_event_stub()
+{
+}
+
+/* Test that a later match set while an earlier one is pending does fire,
+ * whether the wrapper writes it or queues it. */
+void lp_ticker_wrapper_later_match_test()
+{
+    lp_ticker_wrapper_stats_t before, after;
+    LowPowerTimeout early, late;
+    Timer timer;
+
+    wrapper_event_fired = false;
+    lp_ticker_wrapper_get_stats(&before);
+
+    late.attach(wrapper_event_handler, 50ms);
+    early.attach(wrapper_event_stub, 20ms);
+    // The match moves from the early to the late timeout
+    early.detach();
+
+    timer.start();
+    while (!wrapper_event_fired && (timer.elapsed_time() < 500ms));
+    TEST_ASSERT_TRUE(wrapper_event_fired);
+
+    lp_ticker_wrapper_get_stats(&after);
+    utest_printf("writes %lu, queued %lu, deferred %lu, max write delay %lu ticks\n",
+                 after.writes - before.writes, after.queued - before.queued,
+                 after.deferred - before.deferred, after.max_write_delay);
+    TEST_ASSERT(after.max_write_delay >= before.max_write_delay);
+}
+#endif
+
 #if DEVICE_LPTICKER
 utest::v1::status_t lp_ticker_deepsleep_test_setup_handler(const Case *const source, const size_t index_of_case)
 {
@@ -207,7 +247,10 @@ Case cases[] = {
 #if DEVICE_SLEEP
     Case("lp ticker sleep test", lp_ticker_deepsleep_test_setup_handler, lp_ticker_deepsleep_test, lp_ticker_deepsleep_test_teardown_handler),
 #endif
-    Case("lp ticker glitch test", lp_ticker_glitch_test)
+    Case("lp ticker glitch test", lp_ticker_glitch_test),
+#if DEVICE_LPTICKER && (LPTICKER_DELAY_TICKS > 0)
+    Case("lp ticker wrapper later match test", lp_ticker_wrapper_later_match_test),
+#endif
 };
 
 Specification specification(test_setup, cases);
@@ -1886,6 +1886,62 @@ static void test_irq_handler_multiple_event_single_dequeue()
     TEST_ASSERT_EQUAL(0, interface_stub.disable_interrupt_call);
 }
 
+/**
+ * Given an initialized ticker with an event inserted with slack and two
+ * events due later, the first without slack and within the slack of the
+ * first event, the other after it.
+ * When ticker_irq_handler is called at the time the interrupt is set to.
+ * Then:
+ *   - The interrupt should be set to the timestamp of the second event.
+ *   - The IRQ handler should have been called for the first two events.
+ *   - The interrupt timestamp in the ticker interface should be equal to the
+ *     timestamp plus slack of the last event.
+ */
+static void test_irq_handler_slack_coalescing()
+{
+    const us_timestamp_t timestamps [] = {
+        10,
+        50,
+        500
+    };
+    const uint32_t slacks [] = {
+        100,
+        0,
+        20
+    };
+
+    size_t handler_called = 0;
+    struct irq_handler_stub_t {
+        static void event_handler(uint32_t id)
+        {
+            ++ (*((size_t *) id));
+        }
+    };
+
+    ticker_set_handler(&ticker_stub, irq_handler_stub_t::event_handler);
+
+    ticker_event_t events[MBED_ARRAY_SIZE(timestamps)] = { 0 };
+
+    for (size_t i = 0; i < MBED_ARRAY_SIZE(events); ++i) {
+        ticker_insert_event_us_slack(
+            &ticker_stub,
+            &events[i], timestamps[i], (uint32_t) &handler_called, slacks[i]
+        );
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(timestamps[1], interface_stub.interrupt_timestamp);
+
+    interface_stub.timestamp = interface_stub.interrupt_timestamp;
+    ticker_irq_handler(&ticker_stub);
+
+    TEST_ASSERT_EQUAL_UINT32(2, handler_called);
+    TEST_ASSERT_EQUAL_PTR(&events[2], queue_stub.head);
+    TEST_ASSERT_EQUAL_UINT32(
+        timestamps[2] + slacks[2],
+        interface_stub.interrupt_timestamp
+    );
+}
+
 /**
  * Given an initialized ticker with multiple ticker event inserted and the
  * interface timestamp is equal to the timestamp of the first event. The first
@@ -2413,6 +2469,10 @@ static const case_t cases[] = {
         "test_irq_handler_multiple_event_single_dequeue",
         test_irq_handler_multiple_event_single_dequeue
     ),
+    MAKE_TEST_CASE(
+        "test_irq_handler_slack_coalescing",
+        test_irq_handler_slack_coalescing
+    ),
     MAKE_TEST_CASE(
         "test_irq_handler_insert_immediate_in_irq",
         test_irq_handler_insert_immediate_in_irq
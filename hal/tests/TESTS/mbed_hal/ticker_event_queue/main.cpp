@@ -0,0 +1,151 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* Benchmark of the ticker event queue, on a stub ticker so that no event
+ * fires while it is measured. Build with and without
+ * MBED_CONF_TARGET_TICKER_EVENT_HEAP to compare the list and the heap.
+ */
+
+#include "mbed.h"
+#include "greentea-client/test_env.h"
+#include "unity.h"
+#include "utest.h"
+#include "hal/ticker_api.h"
+#include "hal/us_ticker_api.h"
+
+#if !DEVICE_USTICKER
+#error [NOT_SUPPORTED] test not supported
+#else
+
+using namespace utest::v1;
+
+#define MAX_EVENTS  200
+
+static timestamp_t stub_time;
+static uint32_t dispatched;
+static us_timestamp_t last_dispatched;
+static bool out_of_order;
+
+static void stub_nop()
+{
+}
+
+static uint32_t stub_read()
+{
+    return stub_time;
+}
+
+static void stub_set_interrupt(timestamp_t timestamp)
+{
+}
+
+static const ticker_info_t stub_info = { 1000000, 32 };
+
+static const ticker_info_t *stub_get_info()
+{
+    return &stub_info;
+}
+
+static const ticker_interface_t stub_interface = {
+    stub_nop,
+    stub_read,
+    stub_nop,
+    stub_nop,
+    stub_set_interrupt,
+    stub_nop,
+    stub_nop,
+    stub_get_info,
+    false
+};
+
+static ticker_event_queue_t stub_queue;
+static const ticker_data_t stub_ticker = { &stub_interface, &stub_queue };
+
+static ticker_event_t events[MAX_EVENTS];
+
+static void stub_handler(uint32_t id)
+{
+    if (events[id].timestamp < last_dispatched) {
+        out_of_order = true;
+    }
+    last_dispatched = events[id].timestamp;
+    dispatched++;
+}
+
+/* Timestamps spread over the queue, so the list has to be walked */
+static timestamp_t event_timestamp(uint32_t i)
+{
+    return 1000 + ((i * 7919) % MAX_EVENTS) * 100;
+}
+
+template<uint32_t N>
+void test_event_queue()
+{
+    stub_queue = ticker_event_queue_t{};
+    stub_time = 0;
+    dispatched = 0;
+    last_dispatched = 0;
+    out_of_order = false;
+    ticker_set_handler(&stub_ticker, stub_handler);
+
+    uint32_t start = us_ticker_read();
+    for (uint32_t i = 0; i < N; i++) {
+        ticker_insert_event(&stub_ticker, &events[i], event_timestamp(i), i);
+    }
+    uint32_t insert_time = us_ticker_read() - start;
+
+    // remove every other event, from the middle of the queue
+    start = us_ticker_read();
+    for (uint32_t i = 0; i < N; i += 2) {
+        ticker_remove_event(&stub_ticker, &events[i]);
+    }
+    uint32_t remove_time = us_ticker_read() - start;
+
+    stub_time = event_timestamp(MAX_EVENTS);
+    start = us_ticker_read();
+    ticker_irq_handler(&stub_ticker);
+    uint32_t dispatch_time = us_ticker_read() - start;
+
+    utest_printf("%u events (%s): insert %u us, remove %u us, dispatch %u us\n",
+                 (unsigned) N, MBED_CONF_TARGET_TICKER_EVENT_HEAP ? "heap" : "list",
+                 (unsigned) insert_time, (unsigned) remove_time, (unsigned) dispatch_time);
+
+    TEST_ASSERT_EQUAL_UINT32(N / 2, dispatched);
+    TEST_ASSERT_FALSE(out_of_order);
+    TEST_ASSERT_NULL(stub_queue.head);
+}
+
+Case cases[] = {
+    Case("Event queue - 10 events", test_event_queue<10>),
+    Case("Event queue - 50 events", test_event_queue<50>),
+    Case("Event queue - 200 events", test_event_queue<MAX_EVENTS>),
+};
+
+utest::v1::status_t greentea_test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(20, "default_auto");
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+Specification specification(greentea_test_setup, cases, greentea_test_teardown_handler);
+
+int main()
+{
+    return !Harness::run(specification);
+}
+
+#endif // !DEVICE_USTICKER
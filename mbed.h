@@ -54,12 +54,15 @@
 #include "drivers/DigitalIn.h"
 #include "drivers/DigitalOut.h"
 #include "drivers/DigitalInOut.h"
+#include "drivers/FastDigitalIn.h"
+#include "drivers/FastDigitalOut.h"
 #include "drivers/BusIn.h"
 #include "drivers/BusOut.h"
 #include "drivers/BusInOut.h"
 #include "drivers/PortIn.h"
 #include "drivers/PortInOut.h"
 #include "drivers/PortOut.h"
+#include "drivers/FastPortOut.h"
 #include "drivers/AnalogIn.h"
 #include "drivers/AnalogOut.h"
 #include "drivers/PwmOut.h"
@@ -74,10 +77,12 @@
 #include "drivers/MbedCRC.h"
 #include "drivers/QSPI.h"
 #include "drivers/Watchdog.h"
+#include "drivers/ClockManager.h"
 
 // mbed Internal components
 #include "drivers/ResetReason.h"
 #include "drivers/HighResClock.h"
+#include "drivers/CycleClock.h"
 #include "drivers/Timer.h"
 #include "drivers/Ticker.h"
 #include "drivers/Timeout.h"
@@ -88,6 +93,7 @@
 #include "drivers/RealTimeClock.h"
 #include "platform/LocalFileSystem.h"
 #include "drivers/InterruptIn.h"
+#include "drivers/CaptureIn.h"
 #include "platform/mbed_wait_api.h"
 #include "platform/mbed_thread.h"
 #include "hal/sleep_api.h"
@@ -104,10 +110,13 @@
 #include "platform/ScopedRomWriteLock.h"
 #include "platform/ScopedRamExecutionLock.h"
 #include "platform/mbed_stats.h"
+#include "platform/mbed_profiler.h"
+#include "platform/mbed_crash_snapshot.h"
 #include "platform/Stream.h"
 
 // mbed Non-hardware components
 #include "platform/Callback.h"
+#include "platform/InplaceCallback.h"
 #include "platform/ScopedLock.h"
 
 #ifndef MBED_NO_GLOBAL_USING_DIRECTIVE
@@ -199,6 +199,35 @@ void pits_ps_write_once_test()
     TEST_ASSERT_EQUAL(PSA_STORAGE_FLAG_WRITE_ONCE, info.flags);
 }
 
+template <storage_type_t stype>
+void pits_ps_info_update_test()
+{
+    psa_status_t status = PSA_SUCCESS;
+    uint8_t write_buff[TEST_BUFF_SIZE] = {0};
+    struct psa_storage_info_t info = {0, 0};
+
+    status = set_func(stype, 5, TEST_BUFF_SIZE, write_buff, 0);
+    TEST_ASSERT_EQUAL(PSA_SUCCESS, status);
+
+    status = get_info_func(stype, 5, &info);
+    TEST_ASSERT_EQUAL(PSA_SUCCESS, status);
+    TEST_ASSERT_EQUAL(TEST_BUFF_SIZE, info.size);
+
+    // Entry info read before an update must not be returned after it
+    status = set_func(stype, 5, TEST_BUFF_SIZE / 2, write_buff, 0);
+    TEST_ASSERT_EQUAL(PSA_SUCCESS, status);
+
+    status = get_info_func(stype, 5, &info);
+    TEST_ASSERT_EQUAL(PSA_SUCCESS, status);
+    TEST_ASSERT_EQUAL(TEST_BUFF_SIZE / 2, info.size);
+
+    status = remove_func(stype, 5);
+    TEST_ASSERT_EQUAL(PSA_SUCCESS, status);
+
+    status = get_info_func(stype, 5, &info);
+    TEST_ASSERT_EQUAL(PSA_ERROR_DOES_NOT_EXIST, status);
+}
+
 utest::v1::status_t case_its_teardown_handler(const Case *const source, const size_t passed, const size_t failed, const failure_t reason)
 {
     psa_status_t status;
@@ -224,9 +253,11 @@ utest::v1::status_t case_its_setup_handler(const Case *const source, const size_
 Case cases[] = {
     Case("PSA prot internal storage - Basic", case_its_setup_handler<its>, pits_ps_test<its>, case_its_teardown_handler),
     Case("PSA prot internal storage - Write-once", case_its_setup_handler<its>, pits_ps_write_once_test<its>, case_its_teardown_handler),
+    Case("PSA prot internal storage - Info update", case_its_setup_handler<its>, pits_ps_info_update_test<its>, case_its_teardown_handler),
 #if COMPONENT_FLASHIAP
     Case("PSA protected storage - Basic", case_its_setup_handler<ps>, pits_ps_test<ps>),
-    Case("PSA protected storage - Write-once", case_its_setup_handler<ps>, pits_ps_write_once_test<ps>)
+    Case("PSA protected storage - Write-once", case_its_setup_handler<ps>, pits_ps_write_once_test<ps>),
+    Case("PSA protected storage - Info update", case_its_setup_handler<ps>, pits_ps_info_update_test<ps>)
 #endif
 };
 
@@ -1289,10 +1289,12 @@ psa_status_t psa_destroy_key( psa_key_handle_t handle )
         if( overall_status == PSA_SUCCESS )
             overall_status = status;
 
-        /* TODO: other slots may have a copy of the same key. We should
-         * invalidate them.
+        /* A copy cached after being closed must not outlive the key.
+         * TODO: other open slots may have a copy of the same key. We
+         * should invalidate them.
          * https://github.com/ARMmbed/mbed-crypto/issues/214
          */
+        psa_purge_key_slot_cache( slot->attr.id );
     }
 #endif /* defined(MBEDTLS_PSA_CRYPTO_STORAGE_C) */
 
@@ -1888,6 +1890,10 @@ static psa_status_t psa_finish_key_creation(
 #if defined(MBEDTLS_PSA_CRYPTO_STORAGE_C)
     if( ! PSA_KEY_LIFETIME_IS_VOLATILE( slot->attr.lifetime ) )
     {
+        /* Storage may have been wiped behind the back of a cached copy
+         * of an older key with this identifier */
+        psa_purge_key_slot_cache( slot->attr.id );
+
 #if defined(MBEDTLS_PSA_CRYPTO_SE_C)
         if( driver != NULL )
         {
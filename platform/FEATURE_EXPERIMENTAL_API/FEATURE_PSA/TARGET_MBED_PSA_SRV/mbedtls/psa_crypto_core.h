@@ -53,6 +53,10 @@ typedef struct
         } se;
 #endif /* MBEDTLS_PSA_CRYPTO_SE_C */
     } data;
+    /* Nonzero if the key was closed but is kept loaded, so that opening
+     * it again doesn't read it back from storage. The slot has no valid
+     * handle while cached. */
+    unsigned cached : 1;
 } psa_key_slot_t;
 
 /* A mask of key attribute flags used only internally.
@@ -69,8 +69,9 @@ psa_status_t psa_get_key_slot( psa_key_handle_t handle,
         return( PSA_ERROR_INVALID_HANDLE );
     slot = &global_data.key_slots[handle - 1];
 
-    /* If the slot isn't occupied, the handle is invalid. */
-    if( ! psa_is_key_slot_occupied( slot ) )
+    /* If the slot isn't occupied, the handle is invalid. Neither is
+     * the handle of a key that was closed and is only cached. */
+    if( ! psa_is_key_slot_occupied( slot ) || slot->cached )
         return( PSA_ERROR_INVALID_HANDLE );
 
     *p_slot = slot;
@@ -109,10 +110,90 @@ psa_status_t psa_get_empty_key_slot( psa_key_handle_t *handle,
         if( ! psa_is_key_slot_occupied( *p_slot ) )
             return( PSA_SUCCESS );
     }
+
+    /* No free slot: reclaim the slot of a cached key */
+    for( *handle = PSA_KEY_SLOT_COUNT; *handle != 0; --( *handle ) )
+    {
+        *p_slot = &global_data.key_slots[*handle - 1];
+        if( ( *p_slot )->cached )
+        {
+            (void) psa_wipe_key_slot( *p_slot );
+            return( PSA_SUCCESS );
+        }
+    }
     *p_slot = NULL;
     return( PSA_ERROR_INSUFFICIENT_MEMORY );
 }
 
+#if MBEDTLS_PSA_KEY_SLOT_CACHE_COUNT > 0
+static int psa_key_file_id_equal( psa_key_file_id_t a, psa_key_file_id_t b )
+{
+#if defined(MBEDTLS_PSA_CRYPTO_KEY_FILE_ID_ENCODES_OWNER)
+    return( a.key_id == b.key_id && a.owner == b.owner );
+#else
+    return( a == b );
+#endif
+}
+
+/* Find the cached copy of a persistent key, or NULL. */
+static psa_key_slot_t *psa_find_cached_key_slot( psa_key_file_id_t id,
+                                                 psa_key_handle_t *handle )
+{
+    psa_key_handle_t key;
+    for( key = 1; key <= PSA_KEY_SLOT_COUNT; key++ )
+    {
+        psa_key_slot_t *slot = &global_data.key_slots[key - 1];
+        if( slot->cached && psa_key_file_id_equal( slot->attr.id, id ) )
+        {
+            if( handle != NULL )
+                *handle = key;
+            return( slot );
+        }
+    }
+    return( NULL );
+}
+
+/* Keep a closed key loaded if it is a persistent key in local storage
+ * and the cache isn't full. Return 1 if the key was cached. */
+static int psa_cache_key_slot( psa_key_slot_t *slot )
+{
+    psa_key_handle_t key;
+    unsigned cached = 0;
+
+    if( PSA_KEY_LIFETIME_IS_VOLATILE( slot->attr.lifetime ) ||
+        psa_key_lifetime_is_external( slot->attr.lifetime ) )
+        return( 0 );
+
+    for( key = 1; key <= PSA_KEY_SLOT_COUNT; key++ )
+    {
+        const psa_key_slot_t *other = &global_data.key_slots[key - 1];
+        if( other->cached )
+        {
+            /* One cached copy of each key is enough */
+            if( psa_key_file_id_equal( other->attr.id, slot->attr.id ) )
+                return( 0 );
+            ++cached;
+        }
+    }
+    if( cached >= MBEDTLS_PSA_KEY_SLOT_CACHE_COUNT )
+        return( 0 );
+
+    slot->cached = 1;
+    return( 1 );
+}
+#endif /* MBEDTLS_PSA_KEY_SLOT_CACHE_COUNT > 0 */
+
+void psa_purge_key_slot_cache( psa_key_file_id_t id )
+{
+#if MBEDTLS_PSA_KEY_SLOT_CACHE_COUNT > 0
+    psa_key_slot_t *slot = psa_find_cached_key_slot( id, NULL );
+    if( slot != NULL )
+        (void) psa_wipe_key_slot( slot );
+#else
+    (void) id;
+#endif
+}
+
 #if defined(MBEDTLS_PSA_CRYPTO_STORAGE_C)
 static psa_status_t psa_load_persistent_key_into_slot( psa_key_slot_t *slot )
 {
@@ -238,6 +319,16 @@ psa_status_t psa_open_key( psa_key_file_id_t id, psa_key_handle_t *handle )
     if( ! psa_is_key_id_valid( id, 1 ) )
         return( PSA_ERROR_INVALID_ARGUMENT );
 
+#if MBEDTLS_PSA_KEY_SLOT_CACHE_COUNT > 0
+    /* Reopen a cached copy without going to storage */
+    slot = psa_find_cached_key_slot( id, handle );
+    if( slot != NULL )
+    {
+        slot->cached = 0;
+        return( PSA_SUCCESS );
+    }
+#endif
+
     status = psa_get_empty_key_slot( handle, &slot );
     if( status != PSA_SUCCESS )
         return( status );
@@ -272,6 +363,11 @@ psa_status_t psa_close_key( psa_key_handle_t handle )
     if( status != PSA_SUCCESS )
         return( status );
 
+#if MBEDTLS_PSA_KEY_SLOT_CACHE_COUNT > 0
+    if( psa_cache_key_slot( slot ) )
+        return( PSA_SUCCESS );
+#endif
+
     return( psa_wipe_key_slot( slot ) );
 }
 
@@ -282,7 +378,8 @@ void mbedtls_psa_get_stats( mbedtls_psa_stats_t *stats )
     for( key = 1; key <= PSA_KEY_SLOT_COUNT; key++ )
     {
         const psa_key_slot_t *slot = &global_data.key_slots[key - 1];
-        if( ! psa_is_key_slot_occupied( slot ) )
+        /* Cached keys are closed and their slots can be reclaimed */
+        if( ! psa_is_key_slot_occupied( slot ) || slot->cached )
         {
             ++stats->empty_slots;
             continue;
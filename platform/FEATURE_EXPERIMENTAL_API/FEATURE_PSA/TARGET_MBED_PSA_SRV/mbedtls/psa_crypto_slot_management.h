@@ -28,6 +28,14 @@
  * The value is a compile-time constant for now, for simplicity. */
 #define PSA_KEY_SLOT_COUNT 32
 
+/* Number of closed persistent keys kept loaded in their key slots, with
+ * their attributes and key material already parsed, so that opening them
+ * again doesn't read and import them from storage. Cached keys give up
+ * their slot when no other slot is free. Define as 0 to wipe keys on close. */
+#if !defined(MBEDTLS_PSA_KEY_SLOT_CACHE_COUNT)
+#define MBEDTLS_PSA_KEY_SLOT_CACHE_COUNT 4
+#endif
+
 /** Access a key slot at the given handle.
  *
  * \param handle        Key handle to query.
@@ -73,6 +81,15 @@ void psa_wipe_all_key_slots( void );
 psa_status_t psa_get_empty_key_slot( psa_key_handle_t *handle,
                                      psa_key_slot_t **p_slot );
 
+/** Drop the cached copies of a persistent key.
+ *
+ * Call this when the key is removed from storage, so that opening it
+ * again can't find a stale copy.
+ *
+ * \param id           The persistent identifier of the key.
+ */
+void psa_purge_key_slot_cache( psa_key_file_id_t id );
+
 /** Test whether a lifetime designates a key in an external cryptoprocessor.
  *
  * \param lifetime      The lifetime to test.
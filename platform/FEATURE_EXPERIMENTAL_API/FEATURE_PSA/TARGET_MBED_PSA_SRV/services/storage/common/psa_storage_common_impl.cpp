@@ -21,9 +21,92 @@
 #include "mbed_error.h"
 #include "mbed_assert.h"
 #include "mbed_toolchain.h"
+#include "platform/PlatformMutex.h"
+#include "platform/SingletonPtr.h"
 
 using namespace mbed;
 
+#if MBED_CONF_PSA_STORAGE_INFO_CACHE_SIZE
+typedef struct {
+    KVStore *kvstore;           // NULL for an empty entry
+    int32_t pid;
+    psa_storage_uid_t uid;
+    KVStore::info_t info;
+    uint32_t last_used;
+} info_cache_entry_t;
+
+static info_cache_entry_t info_cache[MBED_CONF_PSA_STORAGE_INFO_CACHE_SIZE];
+static uint32_t info_cache_tick = 0;
+// Bumped by every invalidation, so info read from the KVStore during one isn't cached
+static uint32_t info_cache_generation = 0;
+static SingletonPtr<PlatformMutex> info_cache_mutex;
+#endif
+
+/*
+ * \brief Get the KVStore info of a PSA storage entry, from the info cache if possible
+ */
+static int get_info_cached(KVStore *kvstore, int32_t pid, psa_storage_uid_t uid, const char *kv_key,
+                           KVStore::info_t *info)
+{
+#if MBED_CONF_PSA_STORAGE_INFO_CACHE_SIZE
+    info_cache_mutex->lock();
+    for (int i = 0; i < MBED_CONF_PSA_STORAGE_INFO_CACHE_SIZE; i++) {
+        info_cache_entry_t *entry = &info_cache[i];
+        if (entry->kvstore == kvstore && entry->pid == pid && entry->uid == uid) {
+            *info = entry->info;
+            entry->last_used = ++info_cache_tick;
+            info_cache_mutex->unlock();
+            return MBED_SUCCESS;
+        }
+    }
+    uint32_t generation = info_cache_generation;
+    info_cache_mutex->unlock();
+#endif
+
+    int status = kvstore->get_info(kv_key, info);
+
+#if MBED_CONF_PSA_STORAGE_INFO_CACHE_SIZE
+    if (status == MBED_SUCCESS) {
+        info_cache_mutex->lock();
+        if (generation == info_cache_generation) {
+            // Pick an empty entry, or else the least recently used one
+            info_cache_entry_t *entry = &info_cache[0];
+            for (int i = 1; i < MBED_CONF_PSA_STORAGE_INFO_CACHE_SIZE && entry->kvstore; i++) {
+                if (!info_cache[i].kvstore || info_cache[i].last_used < entry->last_used) {
+                    entry = &info_cache[i];
+                }
+            }
+            entry->kvstore = kvstore;
+            entry->pid = pid;
+            entry->uid = uid;
+            entry->info = *info;
+            entry->last_used = ++info_cache_tick;
+        }
+        info_cache_mutex->unlock();
+    }
+#endif
+
+    return status;
+}
+
+/*
+ * \brief Drop the cached info of a PSA storage entry, or of all entries of a KVStore if all is set
+ */
+static void invalidate_info(KVStore *kvstore, int32_t pid, psa_storage_uid_t uid, bool all)
+{
+#if MBED_CONF_PSA_STORAGE_INFO_CACHE_SIZE
+    info_cache_mutex->lock();
+    for (int i = 0; i < MBED_CONF_PSA_STORAGE_INFO_CACHE_SIZE; i++) {
+        info_cache_entry_t *entry = &info_cache[i];
+        if (entry->kvstore == kvstore && (all || (entry->pid == pid && entry->uid == uid))) {
+            entry->kvstore = NULL;
+        }
+    }
+    info_cache_generation++;
+    info_cache_mutex->unlock();
+#endif
+}
+
 #ifdef   __cplusplus
 extern "C"
 {
@@ -73,6 +156,7 @@ void psa_storage_handle_version(KVStore *kvstore, const char *version_key, const
     if ((read_version.major < curr_version->major) ||
             ((read_version.major == curr_version->major) && (read_version.minor < curr_version->minor))) {
         psa_status_t migration_status = migrate_func(kvstore, &read_version, curr_version);
+        invalidate_info(kvstore, 0, 0, true);
         if (migration_status != PSA_SUCCESS) {
             error("PSA storage migration failed");
         }
@@ -195,6 +279,7 @@ psa_status_t psa_storage_set_impl(KVStore *kvstore, int32_t pid, psa_storage_uid
     generate_fn(kv_key, PSA_STORAGE_FILE_NAME_MAX, uid, pid);
 
     int status = kvstore->set(kv_key, p_data, data_length, kv_create_flags);
+    invalidate_info(kvstore, pid, uid, false);
 
     return convert_status(status);
 }
@@ -211,7 +296,7 @@ psa_status_t psa_storage_get_impl(KVStore *kvstore, int32_t pid, psa_storage_uid
     generate_fn(kv_key, PSA_STORAGE_FILE_NAME_MAX, uid, pid);
 
     KVStore::info_t kv_info;
-    int status = kvstore->get_info(kv_key, &kv_info);
+    int status = get_info_cached(kvstore, pid, uid, kv_key, &kv_info);
 
     if (status == MBED_SUCCESS) {
         if (data_offset > kv_info.size) {
@@ -228,6 +313,9 @@ psa_status_t psa_storage_get_impl(KVStore *kvstore, int32_t pid, psa_storage_uid
         }
 
         status = kvstore->get(kv_key, p_data, data_length, p_data_length, data_offset);
+        if (status != MBED_SUCCESS) {
+            invalidate_info(kvstore, pid, uid, false);
+        }
     }
 
     return convert_status(status);
@@ -246,7 +334,7 @@ psa_status_t psa_storage_get_info_impl(KVStore *kvstore, int32_t pid, psa_storag
     generate_fn(kv_key, PSA_STORAGE_FILE_NAME_MAX, uid, pid);
 
     KVStore::info_t kv_info;
-    int status = kvstore->get_info(kv_key, &kv_info);
+    int status = get_info_cached(kvstore, pid, uid, kv_key, &kv_info);
 
     if (status == MBED_SUCCESS) {
         p_info->flags = 0;
@@ -272,6 +360,7 @@ psa_status_t psa_storage_remove_impl(KVStore *kvstore, int32_t pid, psa_storage_
     generate_fn(kv_key, PSA_STORAGE_FILE_NAME_MAX, uid, pid);
 
     int status = kvstore->remove(kv_key);
+    invalidate_info(kvstore, pid, uid, false);
 
     return convert_status(status);
 }
@@ -279,6 +368,7 @@ psa_status_t psa_storage_remove_impl(KVStore *kvstore, int32_t pid, psa_storage_
 psa_status_t psa_storage_reset_impl(KVStore *kvstore)
 {
     int status = kvstore->reset();
+    invalidate_info(kvstore, 0, 0, true);
     return convert_status(status);
 }
 
@@ -22,6 +22,15 @@
 #include "psa/storage_common.h"
 #include "KVStore.h"
 
+/** Number of PSA storage entries whose KVStore info (size and flags) is kept in RAM.
+ *
+ *  Gets and get_infos of a cached UID skip the KVStore get_info lookup. The info is
+ *  dropped on set, remove and reset through this API. Set to 0 to disable.
+ */
+#ifndef MBED_CONF_PSA_STORAGE_INFO_CACHE_SIZE
+#define MBED_CONF_PSA_STORAGE_INFO_CACHE_SIZE 8
+#endif
+
 #ifdef   __cplusplus
 extern "C"
 {
@@ -291,6 +291,18 @@ bool tfm_ns_mailbox_is_msg_replied(mailbox_msg_handle_t handle)
         return false;
     }
 
+    /*
+     * The caller polls in a loop, and the critical section also locks the
+     * peer core out of the queue. Peek at the aligned status word first, and
+     * only enter the critical section once the reply flag is seen, so that
+     * the reply is read after all the status updates of the peer.
+     */
+    status = *(volatile const mailbox_queue_status_t *)
+                                            &mailbox_queue_ptr->replied_slots;
+    if (!(status & (1 << idx))) {
+        return false;
+    }
+
     tfm_ns_mailbox_hal_enter_critical();
     status = mailbox_queue_ptr->replied_slots;
     tfm_ns_mailbox_hal_exit_critical();
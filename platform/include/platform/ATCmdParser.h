@@ -26,6 +26,13 @@
 #include "platform/NonCopyable.h"
 #include "platform/FileHandle.h"
 
+/** Size of the receive buffer which ATCmdParser reads from the
+ *  FileHandle in bulk, 0 to read one byte at a time.
+ */
+#ifndef MBED_CONF_PLATFORM_ATCMDPARSER_RX_BUFFER_SIZE
+#define MBED_CONF_PLATFORM_ATCMDPARSER_RX_BUFFER_SIZE 64
+#endif
+
 namespace mbed {
 /** \addtogroup platform-public-api Platform */
 /** @{*/
@@ -63,6 +70,11 @@ private:
     char *_buffer;
     int _timeout;
 
+    // Bytes read from the file handle but not parsed yet
+    char *_rx_buffer;
+    int _rx_pos;
+    int _rx_len;
+
     // Parsing information
     const char *_output_delimiter;
     int _output_delim_size;
@@ -110,9 +122,13 @@ public:
      */
     ATCmdParser(FileHandle *fh, const char *output_delimiter = "\r",
                 int buffer_size = 256, int timeout = 8000, bool debug = false)
-        : _fh(fh), _buffer_size(buffer_size), _oob_cb_count(0), _in_prev(0), _aborted(false), _oobs(NULL)
+        : _fh(fh), _buffer_size(buffer_size), _rx_buffer(NULL), _rx_pos(0), _rx_len(0),
+          _oob_cb_count(0), _in_prev(0), _aborted(false), _oobs(NULL)
     {
         _buffer = new char[buffer_size];
+#if MBED_CONF_PLATFORM_ATCMDPARSER_RX_BUFFER_SIZE
+        _rx_buffer = new char[MBED_CONF_PLATFORM_ATCMDPARSER_RX_BUFFER_SIZE];
+#endif
         set_timeout(timeout);
         set_delimiter(output_delimiter);
         debug_on(debug);
@@ -129,6 +145,7 @@ public:
             delete oob;
         }
         delete[] _buffer;
+        delete[] _rx_buffer;
     }
 
     /**
@@ -207,10 +224,22 @@ public:
     /**
      * Get a single byte from the underlying stream
      *
+     * @note Bytes are read from the stream in blocks of up to
+     * MBED_CONF_PLATFORM_ATCMDPARSER_RX_BUFFER_SIZE, so once the parser is
+     * used, data must be read through it rather than from the FileHandle.
+     *
      * @return The byte that was read or -1 during a timeout
      */
     int getc();
 
+    /**
+     * Check if data can be read, either from the parser's buffer or the
+     * underlying stream
+     *
+     * @return true if data is available
+     */
+    bool readable();
+
     /**
      * Write an array of bytes to the underlying stream
      *
@@ -0,0 +1,174 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_ATOMICBITSET_H
+#define MBED_ATOMICBITSET_H
+
+#include <stdint.h>
+#include "platform/mbed_atomic.h"
+#include "platform/NonCopyable.h"
+
+namespace mbed {
+
+/** \addtogroup platform-public-api */
+/** @{*/
+/**
+ * \defgroup platform_AtomicBitset AtomicBitset class
+ * @{
+ */
+
+/** Fixed-size set of flags updated without locks or critical sections
+ *
+ *  Bits are set and cleared through mbed_atomic.h, so flags shared between
+ *  interrupt handlers and threads no longer need a critical section around
+ *  a plain word. claim() finds a clear bit and sets it in one step, which
+ *  makes the set an allocator of N slots:
+ *
+ *  @code
+ *  static AtomicBitset<16> used;
+ *  static Buffer buffers[16];
+ *
+ *  Buffer *alloc()
+ *  {
+ *      int i = used.claim();
+ *      return i < 0 ? nullptr : &buffers[i];
+ *  }
+ *
+ *  void free(Buffer *buffer)
+ *  {
+ *      used.reset(buffer - buffers);
+ *  }
+ *  @endcode
+ *
+ *  @note Synchronization level: Interrupt safe
+ *
+ *  @tparam N   Number of bits
+ */
+template <uint32_t N>
+class AtomicBitset : private NonCopyable<AtomicBitset<N> > {
+public:
+    static_assert(N > 0, "N must not be 0");
+
+    AtomicBitset() : _words()
+    {
+    }
+
+    /** Set a bit
+     *
+     *  @param pos      Index of the bit, lower than N
+     *  @return         Previous value of the bit
+     */
+    bool set(uint32_t pos)
+    {
+        uint32_t mask = 1UL << (pos % 32);
+        return core_util_atomic_fetch_or_u32(&_words[pos / 32], mask) & mask;
+    }
+
+    /** Clear a bit
+     *
+     *  @param pos      Index of the bit, lower than N
+     *  @return         Previous value of the bit
+     */
+    bool reset(uint32_t pos)
+    {
+        uint32_t mask = 1UL << (pos % 32);
+        return core_util_atomic_fetch_and_u32(&_words[pos / 32], ~mask) & mask;
+    }
+
+    /** Read a bit
+     *
+     *  @param pos      Index of the bit, lower than N
+     *  @return         Value of the bit
+     */
+    bool test(uint32_t pos) const
+    {
+        return core_util_atomic_load_u32(&_words[pos / 32]) & (1UL << (pos % 32));
+    }
+
+    /** Set the lowest clear bit
+     *
+     *  @return         Index of the bit set, or -1 if all bits were set
+     */
+    int claim()
+    {
+        for (uint32_t i = 0; i < WORDS; i++) {
+            uint32_t full = word_mask(i);
+            uint32_t word = core_util_atomic_load_u32(&_words[i]);
+            while ((word & full) != full) {
+                uint32_t bit = lowest_clear(word);
+                // On failure word is updated, and the search restarts from it
+                if (core_util_atomic_cas_u32(&_words[i], &word, word | (1UL << bit))) {
+                    return i * 32 + bit;
+                }
+            }
+        }
+        return -1;
+    }
+
+    /** Count the bits set
+     *
+     *  @return         Snapshot of the number of bits set
+     */
+    uint32_t count() const
+    {
+        uint32_t count = 0;
+        for (uint32_t i = 0; i < WORDS; i++) {
+            uint32_t word = core_util_atomic_load_u32(&_words[i]);
+            for (; word; word &= word - 1) {
+                count++;
+            }
+        }
+        return count;
+    }
+
+    /** Number of bits of the set
+     *
+     *  @return         N
+     */
+    static constexpr uint32_t size()
+    {
+        return N;
+    }
+
+private:
+    static constexpr uint32_t WORDS = (N + 31) / 32;
+
+    // Bits of the word which belong to the set, the top ones of the last
+    // word are past N
+    static constexpr uint32_t word_mask(uint32_t i)
+    {
+        return (i < WORDS - 1 || N % 32 == 0) ? 0xFFFFFFFFUL : (1UL << (N % 32)) - 1;
+    }
+
+    static uint32_t lowest_clear(uint32_t word)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_ctz(~word);
+#else
+        return __CLZ(__RBIT(~word));
+#endif
+    }
+
+    volatile uint32_t _words[WORDS];
+};
+
+/** @}*/
+
+/** @}*/
+
+} // namespace mbed
+
+#endif
@@ -60,12 +60,27 @@ struct is_unsigned<unsigned long long> {
  * @{
  */
 
+/** Synchronization used by a CircularBuffer */
+enum class CircularBufferMode {
+    critical_section,   ///< Every operation runs in a critical section, a push onto a full buffer overwrites
+    spsc                ///< Lock-free for one producer and one consumer, a push onto a full buffer fails
+};
+
 /** Templated Circular buffer class
  *
- *  @note Synchronization level: Interrupt safe.
- *  @note CounterType must be unsigned and consistent with BufferSize.
+ *  In spsc mode the buffer takes no critical section at all. One context
+ *  may push while another pops, for example an interrupt handler filling
+ *  the buffer and a thread draining it. Pushing items that do not fit
+ *  fails instead of overwriting the oldest ones, so push reports how much
+ *  was stored.
+ *
+ *  @note Synchronization level: Interrupt safe, or single producer and single
+ *        consumer in spsc mode.
+ *  @note CounterType must be unsigned and consistent with BufferSize, in spsc
+ *        mode it must hold twice BufferSize.
  */
-template<typename T, uint32_t BufferSize, typename CounterType = uint32_t>
+template<typename T, uint32_t BufferSize, typename CounterType = uint32_t,
+         CircularBufferMode Mode = CircularBufferMode::critical_section>
 class CircularBuffer {
 public:
     CircularBuffer() : _head(0), _tail(0), _full(false)
@@ -315,6 +330,46 @@ public:
         return data_updated;
     }
 
+    /** Peek at the oldest items without copying them.
+     *
+     * Returns the longest run of items that is contiguous in memory, the
+     * remaining ones follow once the run has been dropped.
+     *
+     * @note A push onto a full buffer overwrites the oldest items, including
+     *       the ones in the span. Use spsc mode where that is a concern.
+     *
+     * @return Span of the oldest items, empty if the buffer is empty.
+     */
+    mbed::Span<const T> peek_span() const
+    {
+        core_util_critical_section_enter();
+        CounterType tail = _tail;
+        CounterType len = 0;
+        if (!non_critical_empty()) {
+            len = (_head > _tail) ? _head - _tail : BufferSize - _tail;
+        }
+        core_util_critical_section_exit();
+        return mbed::make_Span(_buffer + tail, len);
+    }
+
+    /** Drop the oldest items, for example once read through peek_span().
+     *
+     * @param len The number of elements to drop, limited to the number stored.
+     */
+    void drop(CounterType len)
+    {
+        core_util_critical_section_enter();
+        if (len > non_critical_size()) {
+            len = non_critical_size();
+        }
+        if (len) {
+            CounterType to_end = BufferSize - _tail;
+            _tail = (len >= to_end) ? len - to_end : _tail + len;
+            _full = false;
+        }
+        core_util_critical_section_exit();
+    }
+
 private:
     bool non_critical_empty() const
     {
@@ -363,6 +418,254 @@ private:
     bool _full;
 };
 
+/** Lock-free single producer, single consumer CircularBuffer
+ *
+ * The indices run over twice BufferSize so a full buffer can be told apart
+ * from an empty one without a flag shared by both sides. The producer only
+ * writes _head and the consumer only writes _tail.
+ */
+template<typename T, uint32_t BufferSize, typename CounterType>
+class CircularBuffer<T, BufferSize, CounterType, CircularBufferMode::spsc> {
+public:
+    CircularBuffer() : _head(0), _tail(0)
+    {
+        static_assert(
+            internal::is_unsigned<CounterType>::value,
+            "CounterType must be unsigned"
+        );
+
+        static_assert(
+            BufferSize > 0 && BufferSize <= 0x7FFFFFFF &&
+            ((sizeof(CounterType) >= sizeof(uint32_t)) ||
+             (2 * BufferSize <= (((uint32_t) 1) << (sizeof(CounterType) * 8)))),
+            "Invalid BufferSize for the CounterType"
+        );
+    }
+
+    /** Push the transaction to the buffer, called by the producer.
+     *
+     * @param data Data to be pushed to the buffer.
+     * @return True if pushed, false if the buffer is full.
+     */
+    bool push(const T &data)
+    {
+        CounterType head = core_util_atomic_load_explicit(&_head, mbed_memory_order_relaxed);
+        CounterType tail = core_util_atomic_load_explicit(&_tail, mbed_memory_order_acquire);
+        if (distance(tail, head) == BufferSize) {
+            return false;
+        }
+
+        _buffer[index(head)] = data;
+        core_util_atomic_store_explicit(&_head, advance(head, 1), mbed_memory_order_release);
+        return true;
+    }
+
+    /** Push the transaction to the buffer, called by the producer.
+     *
+     * @param src Data to be pushed to the buffer.
+     * @param len Number of items to be pushed to the buffer.
+     * @return The number of elements pushed, less than len if the buffer fills up.
+     */
+    CounterType push(const T *src, CounterType len)
+    {
+        CounterType head = core_util_atomic_load_explicit(&_head, mbed_memory_order_relaxed);
+        CounterType tail = core_util_atomic_load_explicit(&_tail, mbed_memory_order_acquire);
+        CounterType space = BufferSize - distance(tail, head);
+        if (len > space) {
+            len = space;
+        }
+
+        /* copy up to the end of the storage, then wrap to its start */
+        CounterType start = index(head);
+        CounterType first = (len > BufferSize - start) ? BufferSize - start : len;
+        std::copy(src, src + first, _buffer + start);
+        std::copy(src + first, src + len, _buffer);
+
+        core_util_atomic_store_explicit(&_head, advance(head, len), mbed_memory_order_release);
+        return len;
+    }
+
+    /** Push the transaction to the buffer, called by the producer.
+     *
+     * @param src Data to be pushed to the buffer.
+     * @return The number of elements pushed, less than the size of src if the buffer fills up.
+     */
+    CounterType push(mbed::Span<const T> src)
+    {
+        return push(src.data(), src.size());
+    }
+
+    /** Pop from the buffer, called by the consumer.
+     *
+     * @param data Container to store the data to be popped from the buffer.
+     * @return True if data popped.
+     */
+    bool pop(T &data)
+    {
+        CounterType tail = core_util_atomic_load_explicit(&_tail, mbed_memory_order_relaxed);
+        CounterType head = core_util_atomic_load_explicit(&_head, mbed_memory_order_acquire);
+        if (head == tail) {
+            return false;
+        }
+
+        data = _buffer[index(tail)];
+        core_util_atomic_store_explicit(&_tail, advance(tail, 1), mbed_memory_order_release);
+        return true;
+    }
+
+    /**
+     * Pop multiple elements from the buffer, called by the consumer.
+     *
+     * @param dest The array which will receive the elements.
+     * @param len The number of elements to pop.
+     *
+     * @return The number of elements popped.
+     */
+    CounterType pop(T *dest, CounterType len)
+    {
+        CounterType tail = core_util_atomic_load_explicit(&_tail, mbed_memory_order_relaxed);
+        CounterType head = core_util_atomic_load_explicit(&_head, mbed_memory_order_acquire);
+        CounterType stored = distance(tail, head);
+        if (len > stored) {
+            len = stored;
+        }
+
+        /* copy up to the end of the storage, then wrap to its start */
+        CounterType start = index(tail);
+        CounterType first = (len > BufferSize - start) ? BufferSize - start : len;
+        std::copy(_buffer + start, _buffer + start + first, dest);
+        std::copy(_buffer, _buffer + len - first, dest + first);
+
+        core_util_atomic_store_explicit(&_tail, advance(tail, len), mbed_memory_order_release);
+        return len;
+    }
+
+    /**
+     * Pop multiple elements from the buffer, called by the consumer.
+     *
+     * @param dest The span that contains the buffer that will be used to store the elements.
+     *
+     * @return The span with the size set to number of elements popped using the buffer passed in as the parameter.
+     */
+    mbed::Span<T> pop(mbed::Span<T> dest)
+    {
+        CounterType popped = pop(dest.data(), dest.size());
+        return mbed::make_Span(dest.data(), popped);
+    }
+
+    /** Peek at the oldest items without copying them, called by the consumer.
+     *
+     * Returns the longest run of items that is contiguous in memory, the
+     * remaining ones follow once the run has been dropped. The items stay
+     * valid until dropped.
+     *
+     * @return Span of the oldest items, empty if the buffer is empty.
+     */
+    mbed::Span<const T> peek_span() const
+    {
+        CounterType tail = core_util_atomic_load_explicit(&_tail, mbed_memory_order_relaxed);
+        CounterType head = core_util_atomic_load_explicit(&_head, mbed_memory_order_acquire);
+        CounterType len = distance(tail, head);
+        CounterType start = index(tail);
+        if (len > BufferSize - start) {
+            len = BufferSize - start;
+        }
+        return mbed::make_Span(_buffer + start, len);
+    }
+
+    /** Drop the oldest items, called by the consumer.
+     *
+     * @param len The number of elements to drop, limited to the number stored.
+     */
+    void drop(CounterType len)
+    {
+        CounterType tail = core_util_atomic_load_explicit(&_tail, mbed_memory_order_relaxed);
+        CounterType head = core_util_atomic_load_explicit(&_head, mbed_memory_order_acquire);
+        CounterType stored = distance(tail, head);
+        if (len > stored) {
+            len = stored;
+        }
+        core_util_atomic_store_explicit(&_tail, advance(tail, len), mbed_memory_order_release);
+    }
+
+    /** Peek into circular buffer without popping, called by the consumer.
+     *
+     * @param data Data to be peeked from the buffer.
+     * @return True if the buffer is not empty and data contains a transaction, false otherwise.
+     */
+    bool peek(T &data) const
+    {
+        CounterType tail = core_util_atomic_load_explicit(&_tail, mbed_memory_order_relaxed);
+        CounterType head = core_util_atomic_load_explicit(&_head, mbed_memory_order_acquire);
+        if (head == tail) {
+            return false;
+        }
+
+        data = _buffer[index(tail)];
+        return true;
+    }
+
+    /** Check if the buffer is empty.
+     *
+     * @return True if the buffer is empty, false if not.
+     */
+    bool empty() const
+    {
+        return size() == 0;
+    }
+
+    /** Check if the buffer is full.
+     *
+     * @return True if the buffer is full, false if not
+     */
+    bool full() const
+    {
+        return size() == BufferSize;
+    }
+
+    /**
+     * Reset the buffer.
+     *
+     * @note Must not run concurrently with a push or pop.
+     */
+    void reset()
+    {
+        core_util_atomic_store(&_head, CounterType(0));
+        core_util_atomic_store(&_tail, CounterType(0));
+    }
+
+    /**
+     * Get the number of elements currently stored in the circular_buffer.
+     */
+    CounterType size() const
+    {
+        CounterType tail = core_util_atomic_load_explicit(&_tail, mbed_memory_order_acquire);
+        CounterType head = core_util_atomic_load_explicit(&_head, mbed_memory_order_acquire);
+        return distance(tail, head);
+    }
+
+private:
+    static CounterType index(CounterType pos)
+    {
+        return (pos >= BufferSize) ? pos - BufferSize : pos;
+    }
+
+    static CounterType advance(CounterType pos, CounterType increment)
+    {
+        uint32_t to_end = 2 * BufferSize - pos;
+        return (increment >= to_end) ? increment - to_end : pos + increment;
+    }
+
+    static CounterType distance(CounterType from, CounterType to)
+    {
+        return (to >= from) ? to - from : 2 * BufferSize - from + to;
+    }
+
+    T _buffer[BufferSize];
+    volatile CounterType _head;
+    volatile CounterType _tail;
+};
+
 /**@}*/
 
 /**@}*/
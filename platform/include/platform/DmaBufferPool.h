@@ -0,0 +1,133 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_DMABUFFERPOOL_H
+#define MBED_DMABUFFERPOOL_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "platform/mbed_dcache.h"
+#include "platform/mbed_assert.h"
+#include "platform/AtomicBitset.h"
+#include "platform/NonCopyable.h"
+
+namespace mbed {
+
+/** \addtogroup platform-public-api */
+/** @{*/
+/**
+ * \defgroup platform_DmaBufferPool DmaBufferPool class
+ * @{
+ */
+
+/** Fixed pool of buffers safe to hand to a DMA controller
+ *
+ *  Each buffer starts on a cache line and is rounded up to whole lines, so
+ *  cache maintenance on a buffer never touches data of its neighbours or
+ *  of the CPU. The memory holding the buffers is the memory of the pool,
+ *  which MBED_DMA_SECTION places in the section configured for DMA:
+ *
+ *  @code
+ *  MBED_DMA_SECTION static DmaBufferPool<1536, 4> tx_pool;
+ *
+ *  void send(const void *data, size_t size)
+ *  {
+ *      void *buffer = tx_pool.alloc();
+ *      memcpy(buffer, data, size);
+ *      mbed_dcache_clean(buffer, size);
+ *      start_dma(buffer, size);
+ *  }
+ *
+ *  void send_done(void *buffer)
+ *  {
+ *      tx_pool.free(buffer);
+ *  }
+ *  @endcode
+ *
+ *  @note Synchronization level: Interrupt safe
+ *
+ *  @tparam Size    Size of a buffer in bytes
+ *  @tparam Count   Number of buffers
+ */
+template <size_t Size, uint32_t Count>
+class DmaBufferPool : private NonCopyable<DmaBufferPool<Size, Count> > {
+public:
+    static_assert(Size > 0, "Size must not be 0");
+
+    /** Size of a buffer, rounded up to whole cache lines */
+    static constexpr size_t buffer_size = MBED_DMA_SIZE(Size);
+
+    DmaBufferPool()
+    {
+    }
+
+    /** Allocate a buffer
+     *
+     *  @return         Buffer of buffer_size bytes, or nullptr if all are in use
+     */
+    void *alloc()
+    {
+        int i = _used.claim();
+        return i < 0 ? nullptr : _buffers[i];
+    }
+
+    /** Free a buffer
+     *
+     *  @param buffer   Buffer returned by alloc() of this pool
+     */
+    void free(void *buffer)
+    {
+        MBED_ASSERT(owns(buffer));
+        uint32_t i = (static_cast<uint8_t *>(buffer) - &_buffers[0][0]) / buffer_size;
+        MBED_ASSERT(_buffers[i] == buffer);
+        _used.reset(i);
+    }
+
+    /** Check if a buffer belongs to the pool
+     *
+     *  @param buffer   Buffer to check
+     *  @return         true if buffer is in the memory of the pool
+     */
+    bool owns(const void *buffer) const
+    {
+        const uint8_t *p = static_cast<const uint8_t *>(buffer);
+        return p >= &_buffers[0][0] && p < &_buffers[0][0] + sizeof(_buffers);
+    }
+
+    /** Count the buffers free
+     *
+     *  @return         Snapshot of the number of buffers not allocated
+     */
+    uint32_t count_free() const
+    {
+        return Count - _used.count();
+    }
+
+private:
+    MBED_ALIGN(MBED_DCACHE_LINE_SIZE) uint8_t _buffers[Count][buffer_size];
+    AtomicBitset<Count> _used;
+};
+
+template <size_t Size, uint32_t Count>
+constexpr size_t DmaBufferPool<Size, Count>::buffer_size;
+
+/** @}*/
+
+/** @}*/
+
+} // namespace mbed
+
+#endif
@@ -75,6 +75,30 @@ public:
      */
     virtual ssize_t write(const void *buffer, size_t size) = 0;
 
+    /** Read from a file into several buffers
+     *
+     *  Behaves as a single read into the buffers one after the other. The
+     *  default implementation reads into each buffer in turn, and stops at
+     *  the first read that doesn't fill its buffer.
+     *
+     *  @param iov      The buffers to read in to
+     *  @param iovcnt   The number of buffers
+     *  @return         The number of bytes read, 0 at end of file, negative error on failure
+     */
+    virtual ssize_t readv(const struct iovec *iov, int iovcnt);
+
+    /** Write the contents of several buffers to a file
+     *
+     *  Behaves as a single write of the buffers one after the other. The
+     *  default implementation writes each buffer in turn, and stops at the
+     *  first write that is partial.
+     *
+     *  @param iov      The buffers to write from
+     *  @param iovcnt   The number of buffers
+     *  @return         The number of bytes written, negative error on failure
+     */
+    virtual ssize_t writev(const struct iovec *iov, int iovcnt);
+
     /** Move the file position to a given offset from from a given location
      *
      *  @param offset   The offset from whence to move to
@@ -0,0 +1,275 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_INPLACECALLBACK_H
+#define MBED_INPLACECALLBACK_H
+
+#include <cstddef>
+#include <stdint.h>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "platform/Callback.h"
+#include "platform/mbed_assert.h"
+#include "platform/NonCopyable.h"
+
+// Controlling switches from config:
+// MBED_CONF_PLATFORM_INPLACE_CALLBACK_SIZE - default inline storage of InplaceCallback, in bytes
+
+#ifndef MBED_CONF_PLATFORM_INPLACE_CALLBACK_SIZE
+#define MBED_CONF_PLATFORM_INPLACE_CALLBACK_SIZE 32
+#endif
+
+namespace mbed {
+/** \addtogroup platform-public-api */
+/** @{*/
+/**
+ * \defgroup platform_InplaceCallback InplaceCallback class
+ * @{
+ */
+
+/** Move-only callback with a configurable inline buffer
+ *
+ *  Unlike Callback, whose storage is limited to a couple of pointers, an
+ *  InplaceCallback holds any function object of up to N bytes, such as a
+ *  lambda capturing a few values, without the user having to allocate a
+ *  context on the heap. Function objects only need to be move constructible.
+ *
+ *  An InplaceCallback can be posted with EventQueue::call, which moves it into
+ *  the event. APIs taking a Callback, such as Ticker::attach or Socket::sigio,
+ *  can call an InplaceCallback kept alive by the caller:
+ *
+ * @code
+ *  InplaceCallback<void()> on_tick([this, channel, gain] { sample(channel, gain); });
+ *  ticker.attach(callback(&on_tick, &InplaceCallback<void()>::call), 10ms);
+ * @endcode
+ *
+ *  @note Synchronization level: Not protected
+ *
+ *  @tparam Signature   Function type, for example void(int)
+ *  @tparam N           Inline storage in bytes, defaults to platform.inplace-callback-size
+ */
+template <typename Signature, size_t N = MBED_CONF_PLATFORM_INPLACE_CALLBACK_SIZE>
+class InplaceCallback;
+
+/** @}*/
+
+template <typename R, typename... ArgTs, size_t N>
+class InplaceCallback<R(ArgTs...), N> : private NonCopyable<InplaceCallback<R(ArgTs...), N> > {
+public:
+    using result_type = R;
+
+    /** Create an empty InplaceCallback
+     */
+    InplaceCallback() noexcept : _ops(nullptr) { }
+
+    /** Create an empty InplaceCallback
+     */
+    InplaceCallback(std::nullptr_t) noexcept : InplaceCallback() { }
+
+    /** Move an InplaceCallback
+     *  @param other     The InplaceCallback to move, left empty
+     */
+    InplaceCallback(InplaceCallback &&other) : _ops(nullptr)
+    {
+        move(other);
+    }
+
+    // *INDENT-OFF*
+    /** Create an InplaceCallback with a function object or function pointer
+     *  @param f Function object to attach, must fit in N bytes
+     */
+    template <typename F,
+              typename std::enable_if_t<
+                  !std::is_same<std::decay_t<F>, InplaceCallback>::value &&
+                  mstd::is_invocable_r<R, std::decay_t<F> &, ArgTs...>::value, int> = 0>
+    InplaceCallback(F &&f) : _ops(nullptr)
+    {
+        generate(std::forward<F>(f));
+    }
+    // *INDENT-ON*
+
+    /** Destroy an InplaceCallback
+     */
+    ~InplaceCallback()
+    {
+        destroy();
+    }
+
+    /** Move assign an InplaceCallback
+     *  @param that      The InplaceCallback to move, left empty
+     */
+    InplaceCallback &operator=(InplaceCallback &&that)
+    {
+        if (this != &that) {
+            destroy();
+            move(that);
+        }
+        return *this;
+    }
+
+    // *INDENT-OFF*
+    /** Assign a function object or function pointer
+     *  @param f Function object to attach, must fit in N bytes
+     */
+    template <typename F,
+              typename std::enable_if_t<
+                  !std::is_same<std::decay_t<F>, InplaceCallback>::value &&
+                  mstd::is_invocable_r<R, std::decay_t<F> &, ArgTs...>::value, int> = 0>
+    InplaceCallback &operator=(F &&f)
+    {
+        destroy();
+        generate(std::forward<F>(f));
+        return *this;
+    }
+    // *INDENT-ON*
+
+    /** Empty an InplaceCallback
+     */
+    InplaceCallback &operator=(std::nullptr_t) noexcept
+    {
+        destroy();
+        return *this;
+    }
+
+    /** Call the attached function
+     */
+    R call(ArgTs... args)
+    {
+        MBED_ASSERT(_ops);
+        return _ops->call(&_storage, std::forward<ArgTs>(args)...);
+    }
+
+    /** Call the attached function
+     */
+    R operator()(ArgTs... args)
+    {
+        return call(std::forward<ArgTs>(args)...);
+    }
+
+    /** Test if function has been assigned
+     */
+    explicit operator bool() const noexcept
+    {
+        return _ops;
+    }
+
+    /** Inline storage available to function objects
+     *
+     *  @return         N
+     */
+    static constexpr size_t capacity()
+    {
+        return N;
+    }
+
+private:
+    struct ops {
+        R(*call)(void *, ArgTs &&...);
+        void (*move)(void *, void *);
+        void (*dtor)(void *);
+    };
+
+    template <typename F>
+    void generate(F &&f)
+    {
+        using T = std::decay_t<F>;
+        static_assert(sizeof(T) <= N, "InplaceCallback F does not fit, increase N");
+        static_assert(alignof(T) <= alignof(std::max_align_t), "InplaceCallback F is over-aligned");
+        static_assert(std::is_move_constructible<T>::value, "InplaceCallback F must be MoveConstructible");
+
+        if (is_null(f)) {
+            _ops = nullptr;
+            return;
+        }
+
+        static const ops target_ops = {
+            &target_call<T>,
+            &target_move<T>,
+            &target_dtor<T>
+        };
+
+        new (&_storage) T(std::forward<F>(f));
+        _ops = &target_ops;
+    }
+
+    void move(InplaceCallback &other)
+    {
+        if (other._ops) {
+            other._ops->move(&_storage, &other._storage);
+            other._ops->dtor(&other._storage);
+        }
+        _ops = other._ops;
+        other._ops = nullptr;
+    }
+
+    void destroy()
+    {
+        if (_ops) {
+            _ops->dtor(&_storage);
+            _ops = nullptr;
+        }
+    }
+
+    // Function pointers and pointers to members can be empty
+    template <typename T>
+    static bool is_null(const T &f)
+    {
+        return is_null_impl(f, std::integral_constant<bool, std::is_pointer<T>::value || std::is_member_pointer<T>::value>());
+    }
+
+    template <typename T>
+    static bool is_null_impl(const T &f, std::true_type)
+    {
+        return f == nullptr;
+    }
+
+    template <typename T>
+    static bool is_null_impl(const T &, std::false_type)
+    {
+        return false;
+    }
+
+    // Call F in storage
+    template <typename F>
+    static R target_call(void *p, ArgTs &&... args)
+    {
+        return detail::invoke_r<R>(*static_cast<F *>(p), std::forward<ArgTs>(args)...);
+    }
+
+    // Move construct F into storage
+    template <typename F>
+    static void target_move(void *d, void *p)
+    {
+        new (d) F(std::move(*static_cast<F *>(p)));
+    }
+
+    // Destroy F in storage
+    template <typename F>
+    static void target_dtor(void *p)
+    {
+        static_cast<F *>(p)->~F();
+    }
+
+    const ops *_ops;
+    alignas(std::max_align_t) unsigned char _storage[N];
+};
+
+/** @}*/
+
+} // namespace mbed
+
+#endif
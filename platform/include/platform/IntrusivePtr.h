@@ -0,0 +1,339 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MBED_INTRUSIVEPTR_H
+#define MBED_INTRUSIVEPTR_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <utility>
+
+#include "platform/mbed_atomic.h"
+
+namespace mbed {
+
+/** \addtogroup platform-public-api */
+/** @{*/
+/**
+ * \defgroup platform_IntrusivePtr IntrusivePtr class
+ * @{
+ */
+
+/** Concurrency supported by the reference count of a RefCounted object */
+enum class RefCountMode {
+    atomic,         ///< References may be taken and dropped from any thread or interrupt
+    single_thread   ///< References are only taken and dropped from one thread
+};
+
+/** Base of the classes managed by IntrusivePtr, holding their reference count
+ *
+ *  Copying an object does not copy its count, the copy starts unreferenced.
+ *
+ *  @tparam Mode    Concurrency supported, see RefCountMode. single_thread
+ *                  saves the atomic operations.
+ */
+template <RefCountMode Mode = RefCountMode::atomic>
+class RefCounted {
+public:
+    /** Take a reference, called by IntrusivePtr */
+    void ref() const
+    {
+        if (Mode == RefCountMode::atomic) {
+            core_util_atomic_incr_u32(&_ref_count, 1);
+        } else {
+            _ref_count++;
+        }
+    }
+
+    /** Drop a reference, called by IntrusivePtr
+     *
+     *  @return True if it was the last reference
+     */
+    bool unref() const
+    {
+        if (Mode == RefCountMode::atomic) {
+            return core_util_atomic_decr_u32(&_ref_count, 1) == 0;
+        } else {
+            return --_ref_count == 0;
+        }
+    }
+
+    /** Reference count accessor
+     *
+     *  @return Number of IntrusivePtr referencing the object
+     */
+    uint32_t use_count() const
+    {
+        if (Mode == RefCountMode::atomic) {
+            return core_util_atomic_load_u32(&_ref_count);
+        } else {
+            return _ref_count;
+        }
+    }
+
+protected:
+    RefCounted() : _ref_count(0)
+    {
+    }
+
+    RefCounted(const RefCounted &) : _ref_count(0)
+    {
+    }
+
+    RefCounted &operator=(const RefCounted &)
+    {
+        return *this;
+    }
+
+    ~RefCounted() = default;
+
+private:
+    mutable uint32_t _ref_count;
+};
+
+/** Intrusive shared pointer class.
+  *
+  * Like SharedPtr, IntrusivePtr deletes the object it points to when the last
+  * pointer to it is destroyed. The reference count lives in the object, which
+  * derives from RefCounted, so no counter is allocated and an IntrusivePtr
+  * is the size of a raw pointer. An IntrusivePtr can also be created again
+  * from a raw pointer to an object still referenced.
+  *
+  * @code
+  * #include "platform/IntrusivePtr.h"
+  *
+  * struct Buffer : mbed::RefCounted<> {
+  *     uint8_t data[64];
+  * };
+  *
+  * void test() {
+  *     IntrusivePtr<Buffer> ptr = make_intrusive<Buffer>();
+  *     IntrusivePtr<Buffer> ptr2(ptr);
+  *
+  *     ptr = nullptr; // The buffer is still referenced by ptr2
+  *     ptr2 = nullptr; // The buffer is deleted
+  * }
+  * @endcode
+  *
+  * @tparam T    Class of the object, deriving from RefCounted
+  */
+template <class T>
+class IntrusivePtr {
+public:
+    /**
+     * @brief Create empty IntrusivePtr not pointing to anything.
+     */
+    constexpr IntrusivePtr(): _ptr()
+    {
+    }
+
+    /**
+     * @brief Create empty IntrusivePtr not pointing to anything.
+     */
+    constexpr IntrusivePtr(std::nullptr_t) : IntrusivePtr()
+    {
+    }
+
+    /**
+     * @brief Create new IntrusivePtr
+     * @param ptr Pointer to take a reference to
+     */
+    IntrusivePtr(T *ptr): _ptr(ptr)
+    {
+        if (_ptr != nullptr) {
+            _ptr->ref();
+        }
+    }
+
+    /**
+     * @brief Destructor.
+     * @details Drop the reference, and delete object if no longer pointed to.
+     */
+    ~IntrusivePtr()
+    {
+        release();
+    }
+
+    /**
+     * @brief Copy constructor.
+     * @param source Object being copied from.
+     */
+    IntrusivePtr(const IntrusivePtr &source): IntrusivePtr(source._ptr)
+    {
+    }
+
+    /**
+     * @brief Move constructor.
+     * @param source Object being moved from.
+     */
+    IntrusivePtr(IntrusivePtr &&source): _ptr(source._ptr)
+    {
+        source._ptr = nullptr;
+    }
+
+    /**
+     * @brief Copy assignment operator.
+     * @param source Object being assigned from.
+     * @return Object being assigned.
+     */
+    IntrusivePtr &operator=(const IntrusivePtr &source)
+    {
+        reset(source._ptr);
+        return *this;
+    }
+
+    /**
+     * @brief Move assignment operator.
+     * @param source Object being assigned from.
+     * @return Object being assigned.
+     */
+    IntrusivePtr &operator=(IntrusivePtr &&source)
+    {
+        if (this != &source) {
+            release();
+            _ptr = source._ptr;
+            source._ptr = nullptr;
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Replaces the managed pointer.
+     * @param[in] ptr the new raw pointer to take a reference to.
+     */
+    void reset(T *ptr)
+    {
+        // Take the new reference first, for ptr to survive if it is the object already held
+        if (ptr != nullptr) {
+            ptr->ref();
+        }
+        release();
+        _ptr = ptr;
+    }
+
+    /**
+     * @brief Replace the managed pointer with a null pointer.
+     */
+    void reset()
+    {
+        release();
+        _ptr = nullptr;
+    }
+
+    /**
+     * @brief Raw pointer accessor.
+     * @return Pointer.
+     */
+    T *get() const
+    {
+        return _ptr;
+    }
+
+    /**
+     * @brief Reference count accessor.
+     * @return Reference count.
+     */
+    uint32_t use_count() const
+    {
+        return _ptr != nullptr ? _ptr->use_count() : 0;
+    }
+
+    /**
+     * @brief Dereference object operator.
+     */
+    T &operator*() const
+    {
+        return *_ptr;
+    }
+
+    /**
+     * @brief Dereference object member operator.
+     */
+    T *operator->() const
+    {
+        return _ptr;
+    }
+
+    /**
+     * @brief Boolean conversion operator.
+     * @return Whether or not the pointer is null.
+     */
+    operator bool() const
+    {
+        return _ptr != nullptr;
+    }
+
+private:
+    void release()
+    {
+        if (_ptr != nullptr && _ptr->unref()) {
+            delete _ptr;
+        }
+    }
+
+    T *_ptr;
+};
+
+/** Create an IntrusivePtr to a new object.
+  *
+  * @param args Arguments of the constructor of T
+  * @return IntrusivePtr managing the new object
+  */
+template <class T, class... Args>
+IntrusivePtr<T> make_intrusive(Args &&... args)
+{
+    return IntrusivePtr<T>(new T(std::forward<Args>(args)...));
+}
+
+/** Non-member relational operators.
+  */
+template <class T, class U>
+bool operator== (const IntrusivePtr<T> &lhs, const IntrusivePtr<U> &rhs)
+{
+    return (lhs.get() == rhs.get());
+}
+
+template <class T>
+bool operator== (const IntrusivePtr<T> &lhs, std::nullptr_t)
+{
+    return lhs.get() == nullptr;
+}
+
+template <class T, class U>
+bool operator!= (const IntrusivePtr<T> &lhs, const IntrusivePtr<U> &rhs)
+{
+    return (lhs.get() != rhs.get());
+}
+
+template <class T>
+bool operator!= (const IntrusivePtr<T> &lhs, std::nullptr_t)
+{
+    return lhs.get() != nullptr;
+}
+
+/** @}*/
+
+/** @}*/
+
+} /* namespace mbed */
+
+#ifndef MBED_NO_GLOBAL_USING_DIRECTIVE
+using mbed::IntrusivePtr;
+using mbed::make_intrusive;
+#endif
+
+#endif // MBED_INTRUSIVEPTR_H
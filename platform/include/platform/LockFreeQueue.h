@@ -0,0 +1,291 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_LOCKFREEQUEUE_H
+#define MBED_LOCKFREEQUEUE_H
+
+#include <stdint.h>
+#include <type_traits>
+#include "platform/mbed_atomic.h"
+#include "platform/NonCopyable.h"
+
+namespace mbed {
+
+/** \addtogroup platform-public-api */
+/** @{*/
+/**
+ * \defgroup platform_LockFreeQueue LockFreeQueue class
+ * @{
+ */
+
+/** Concurrency supported by a LockFreeQueue */
+enum class LockFreeQueueMode {
+    spsc,   ///< One producer and one consumer
+    mpmc    ///< Any number of producers and consumers
+};
+
+/** Fixed-size queue without locks or critical sections
+ *
+ *  Items are copied in and out of a static ring, with the indices updated
+ *  through mbed_atomic.h. Nothing goes through the kernel, so push and pop
+ *  are cheap enough to carry sensor samples from an interrupt handler to a
+ *  thread at high rates. rtos::BlockingLockFreeQueue adds a blocking pop.
+ *
+ *  The default spsc mode permits one producer and one consumer at a time,
+ *  for example an ISR pushing and a thread popping. The mpmc mode permits
+ *  any number of both, at the cost of a compare-and-swap per operation.
+ *  In mpmc mode an item becomes visible once the push that claimed its slot
+ *  has completed, so a pop may report the queue empty while an interrupted
+ *  push is in progress.
+ *
+ *  @note Synchronization level: Interrupt safe within the limits of the mode.
+ *
+ *  @tparam T       Type of the items, must be trivially copyable
+ *  @tparam N       Capacity, must be a power of two
+ *  @tparam Mode    Concurrency supported, see LockFreeQueueMode
+ */
+template <typename T, uint32_t N, LockFreeQueueMode Mode = LockFreeQueueMode::spsc>
+class LockFreeQueue;
+
+/** @}*/
+
+template <typename T, uint32_t N>
+class LockFreeQueue<T, N, LockFreeQueueMode::spsc> : private NonCopyable<LockFreeQueue<T, N, LockFreeQueueMode::spsc> > {
+public:
+    static_assert(N > 0 && (N & (N - 1)) == 0, "N must be a power of two");
+    static_assert(std::is_trivially_copyable<T>::value, "T must be trivially copyable");
+
+    LockFreeQueue() : _head(0), _tail(0)
+    {
+    }
+
+    /** Push an item, called by the producer
+     *
+     *  @param item     Item to copy into the queue
+     *  @return         False if the queue is full
+     */
+    bool push(const T &item)
+    {
+        uint32_t head = core_util_atomic_load_explicit_u32(&_head, mbed_memory_order_relaxed);
+        uint32_t tail = core_util_atomic_load_explicit_u32(&_tail, mbed_memory_order_acquire);
+        if (head - tail == N) {
+            return false;
+        }
+
+        _buffer[head % N] = item;
+        core_util_atomic_store_explicit_u32(&_head, head + 1, mbed_memory_order_release);
+        return true;
+    }
+
+    /** Pop an item, called by the consumer
+     *
+     *  @param item     Item to copy out of the queue
+     *  @return         False if the queue is empty
+     */
+    bool pop(T &item)
+    {
+        uint32_t tail = core_util_atomic_load_explicit_u32(&_tail, mbed_memory_order_relaxed);
+        uint32_t head = core_util_atomic_load_explicit_u32(&_head, mbed_memory_order_acquire);
+        if (head == tail) {
+            return false;
+        }
+
+        item = _buffer[tail % N];
+        core_util_atomic_store_explicit_u32(&_tail, tail + 1, mbed_memory_order_release);
+        return true;
+    }
+
+    /** Number of items in the queue
+     *
+     *  Exact when called by the producer or the consumer, a snapshot
+     *  otherwise.
+     *
+     *  @return         Number of items
+     */
+    uint32_t size() const
+    {
+        uint32_t tail = core_util_atomic_load_explicit_u32(&_tail, mbed_memory_order_acquire);
+        uint32_t head = core_util_atomic_load_explicit_u32(&_head, mbed_memory_order_acquire);
+        return head - tail;
+    }
+
+    /** Check whether the queue is empty
+     *
+     *  @return         True if the queue holds no items
+     */
+    bool empty() const
+    {
+        return size() == 0;
+    }
+
+    /** Check whether the queue is full
+     *
+     *  @return         True if the queue holds N items
+     */
+    bool full() const
+    {
+        return size() == N;
+    }
+
+    /** Capacity of the queue
+     *
+     *  @return         N
+     */
+    static constexpr uint32_t capacity()
+    {
+        return N;
+    }
+
+private:
+    // Free-running indices, _head only written by the producer and _tail
+    // only by the consumer
+    volatile uint32_t _head;
+    volatile uint32_t _tail;
+    T _buffer[N];
+};
+
+template <typename T, uint32_t N>
+class LockFreeQueue<T, N, LockFreeQueueMode::mpmc> : private NonCopyable<LockFreeQueue<T, N, LockFreeQueueMode::mpmc> > {
+public:
+    static_assert(N > 0 && (N & (N - 1)) == 0, "N must be a power of two");
+    static_assert(std::is_trivially_copyable<T>::value, "T must be trivially copyable");
+
+    LockFreeQueue() : _enqueue(0), _dequeue(0)
+    {
+        for (uint32_t i = 0; i < N; i++) {
+            _cells[i].sequence = i;
+        }
+    }
+
+    /** Push an item
+     *
+     *  @param item     Item to copy into the queue
+     *  @return         False if the queue is full
+     */
+    bool push(const T &item)
+    {
+        Cell *cell;
+        uint32_t pos = core_util_atomic_load_explicit_u32(&_enqueue, mbed_memory_order_relaxed);
+        while (true) {
+            cell = &_cells[pos % N];
+            uint32_t seq = core_util_atomic_load_explicit_u32(&cell->sequence, mbed_memory_order_acquire);
+            int32_t diff = (int32_t)(seq - pos);
+            if (diff == 0) {
+                if (core_util_atomic_compare_exchange_weak_explicit_u32(&_enqueue, &pos, pos + 1,
+                                                                        mbed_memory_order_relaxed, mbed_memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = core_util_atomic_load_explicit_u32(&_enqueue, mbed_memory_order_relaxed);
+            }
+        }
+
+        cell->data = item;
+        core_util_atomic_store_explicit_u32(&cell->sequence, pos + 1, mbed_memory_order_release);
+        return true;
+    }
+
+    /** Pop an item
+     *
+     *  @param item     Item to copy out of the queue
+     *  @return         False if the queue is empty
+     */
+    bool pop(T &item)
+    {
+        Cell *cell;
+        uint32_t pos = core_util_atomic_load_explicit_u32(&_dequeue, mbed_memory_order_relaxed);
+        while (true) {
+            cell = &_cells[pos % N];
+            uint32_t seq = core_util_atomic_load_explicit_u32(&cell->sequence, mbed_memory_order_acquire);
+            int32_t diff = (int32_t)(seq - (pos + 1));
+            if (diff == 0) {
+                if (core_util_atomic_compare_exchange_weak_explicit_u32(&_dequeue, &pos, pos + 1,
+                                                                        mbed_memory_order_relaxed, mbed_memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = core_util_atomic_load_explicit_u32(&_dequeue, mbed_memory_order_relaxed);
+            }
+        }
+
+        item = cell->data;
+        core_util_atomic_store_explicit_u32(&cell->sequence, pos + N, mbed_memory_order_release);
+        return true;
+    }
+
+    /** Number of items in the queue
+     *
+     *  @return         Snapshot of the number of claimed slots
+     */
+    uint32_t size() const
+    {
+        uint32_t dequeue = core_util_atomic_load_explicit_u32(&_dequeue, mbed_memory_order_acquire);
+        uint32_t enqueue = core_util_atomic_load_explicit_u32(&_enqueue, mbed_memory_order_acquire);
+        uint32_t size = enqueue - dequeue;
+        // the indices are read separately, so clamp a stale dequeue index
+        return size > N ? N : size;
+    }
+
+    /** Check whether the queue is empty
+     *
+     *  @return         True if the queue holds no items
+     */
+    bool empty() const
+    {
+        return size() == 0;
+    }
+
+    /** Check whether the queue is full
+     *
+     *  @return         True if the queue holds N items
+     */
+    bool full() const
+    {
+        return size() == N;
+    }
+
+    /** Capacity of the queue
+     *
+     *  @return         N
+     */
+    static constexpr uint32_t capacity()
+    {
+        return N;
+    }
+
+private:
+    // Each cell's sequence tells which lap of the ring it is ready for:
+    // equal to the position when free for a push, position + 1 once
+    // filled, and position + N once popped
+    struct Cell {
+        volatile uint32_t sequence;
+        T data;
+    };
+
+    volatile uint32_t _enqueue;
+    volatile uint32_t _dequeue;
+    Cell _cells[N];
+};
+
+/** @}*/
+
+} // namespace mbed
+
+#endif
@@ -0,0 +1,144 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_LOCKFREESTACK_H
+#define MBED_LOCKFREESTACK_H
+
+#include <stdint.h>
+#include "platform/mbed_atomic.h"
+#include "platform/mbed_critical.h"
+#include "platform/NonCopyable.h"
+
+namespace mbed {
+
+/** \addtogroup platform-public-api */
+/** @{*/
+/**
+ * \defgroup platform_LockFreeStack LockFreeStack class
+ * @{
+ */
+
+/** Intrusive last-in first-out list without locks (Treiber stack)
+ *
+ *  Nodes are linked through their own `next` member, so pushing and
+ *  popping allocates nothing, which suits free lists of memory pools and
+ *  buffers shared between interrupt handlers and threads.
+ *
+ *  A compare-and-swap pop can be fooled when the head node is popped and
+ *  pushed back while it runs (the ABA problem). On cores with exclusive
+ *  access (Armv7-M, Armv8-M and Armv7-A), pop uses LDREX/STREX directly:
+ *  any exception between the two clears the exclusive monitor, so the
+ *  store fails and pop retries. Other cores pop in a short critical
+ *  section.
+ *
+ *  A pop may read the `next` member of a node popped concurrently, so
+ *  nodes must stay readable while the stack is used, as pool blocks do.
+ *
+ *  @code
+ *  struct Block {
+ *      Block *next;
+ *      uint8_t data[60];
+ *  };
+ *
+ *  static Block blocks[8];
+ *  static LockFreeStack<Block> free_blocks;
+ *
+ *  void init()
+ *  {
+ *      for (Block &block : blocks) {
+ *          free_blocks.push(&block);
+ *      }
+ *  }
+ *  @endcode
+ *
+ *  @note Synchronization level: Interrupt safe
+ *
+ *  @tparam T   Type of the nodes, with a public `T *next` member
+ */
+template <typename T>
+class LockFreeStack : private NonCopyable<LockFreeStack<T> > {
+public:
+    LockFreeStack() : _head(nullptr)
+    {
+    }
+
+    /** Push a node
+     *
+     *  @param node     Node to push, not already in the stack
+     */
+    void push(T *node)
+    {
+        // The head is only replaced if unchanged, and a node pushed back
+        // meanwhile is as good a next node as any, so pushing is ABA safe
+        T *head = load_head();
+        do {
+            node->next = head;
+        } while (!core_util_atomic_compare_exchange_weak_ptr((void *volatile *) &_head, (void **) &head, node));
+    }
+
+    /** Pop the last node pushed
+     *
+     *  @return         The node, or nullptr if the stack is empty
+     */
+    T *pop()
+    {
+#if MBED_EXCLUSIVE_ACCESS
+        T *head;
+        do {
+            head = (T *) __LDREXW((volatile uint32_t *) &_head);
+            if (head == nullptr) {
+                __CLREX();
+                return nullptr;
+            }
+        } while (__STREXW((uint32_t) head->next, (volatile uint32_t *) &_head));
+        MBED_BARRIER();
+        return head;
+#else
+        core_util_critical_section_enter();
+        T *head = _head;
+        if (head != nullptr) {
+            _head = head->next;
+        }
+        core_util_critical_section_exit();
+        return head;
+#endif
+    }
+
+    /** Check whether the stack is empty
+     *
+     *  @return         Snapshot of whether the stack holds no nodes
+     */
+    bool empty() const
+    {
+        return load_head() == nullptr;
+    }
+
+private:
+    T *load_head() const
+    {
+        return (T *) core_util_atomic_load_ptr((void *const volatile *) &_head);
+    }
+
+    T *volatile _head;
+};
+
+/** @}*/
+
+/** @}*/
+
+} // namespace mbed
+
+#endif
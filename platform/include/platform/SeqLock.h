@@ -0,0 +1,113 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_SEQLOCK_H
+#define MBED_SEQLOCK_H
+
+#include <stdint.h>
+#include <string.h>
+#include <type_traits>
+#include "platform/mbed_atomic.h"
+#include "platform/NonCopyable.h"
+
+namespace mbed {
+
+/** \addtogroup platform-public-api */
+/** @{*/
+/**
+ * \defgroup platform_SeqLock SeqLock class
+ * @{
+ */
+
+/** Value of several words written by one writer and read without locks
+ *
+ *  The writer never waits, and readers retry if a write happened while
+ *  they copied the value, detected by a sequence count that is odd during
+ *  writes. It suits a multi-word timestamp or a set of readings updated by
+ *  an interrupt handler and read by threads: the readers never mask the
+ *  interrupt.
+ *
+ *  A reader spinning in read() cannot let a writer it interrupted finish,
+ *  so code which may interrupt the writer must use try_read() instead.
+ *
+ *  @note Synchronization level: Interrupt safe, with one writer at a time
+ *
+ *  @tparam T   Type of the value, must be trivially copyable
+ */
+template <typename T>
+class SeqLock : private NonCopyable<SeqLock<T> > {
+public:
+    static_assert(std::is_trivially_copyable<T>::value, "T must be trivially copyable");
+
+    SeqLock() : _sequence(0), _value()
+    {
+    }
+
+    /** Replace the value, called by the writer
+     *
+     *  @param value    New value
+     */
+    void write(const T &value)
+    {
+        uint32_t sequence = core_util_atomic_load_explicit_u32(&_sequence, mbed_memory_order_relaxed);
+        core_util_atomic_store_explicit_u32(&_sequence, sequence + 1, mbed_memory_order_relaxed);
+        // The odd count must be visible before any word of the value changes
+        MBED_BARRIER();
+        memcpy((void *) &_value, &value, sizeof(T));
+        core_util_atomic_store_explicit_u32(&_sequence, sequence + 2, mbed_memory_order_release);
+    }
+
+    /** Read the value, retrying while a write is in progress
+     *
+     *  @return         Value of the last complete write
+     */
+    T read() const
+    {
+        T value;
+        while (!try_read(value)) {
+        }
+        return value;
+    }
+
+    /** Read the value once
+     *
+     *  @param value    Set to the value of the last complete write, on success
+     *  @return         False if a write was in progress or happened during the read
+     */
+    bool try_read(T &value) const
+    {
+        uint32_t sequence = core_util_atomic_load_explicit_u32(&_sequence, mbed_memory_order_acquire);
+        if (sequence & 1) {
+            return false;
+        }
+        memcpy(&value, (const void *) &_value, sizeof(T));
+        // The copy must be complete before the count is checked again
+        MBED_BARRIER();
+        return core_util_atomic_load_explicit_u32(&_sequence, mbed_memory_order_relaxed) == sequence;
+    }
+
+private:
+    volatile uint32_t _sequence;
+    volatile T _value;
+};
+
+/** @}*/
+
+/** @}*/
+
+} // namespace mbed
+
+#endif
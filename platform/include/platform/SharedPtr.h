@@ -22,6 +22,7 @@
 
 #include <stdint.h>
 #include <stddef.h>
+#include <utility>
 
 #include "platform/mbed_atomic.h"
 
@@ -52,9 +53,13 @@ namespace mbed {
   *
   *
   * It is similar to the std::shared_ptr class introduced in C++11;
-  * however, this is not a compatible implementation (no weak pointer, no make_shared, no custom deleters and so on.)
+  * however, this is not a compatible implementation (no weak pointer, no custom deleters and so on.)
   *
-  * Usage: SharedPtr<Class> ptr(new Class())
+  * Usage: SharedPtr<Class> ptr(new Class()), or mbed::make_shared<Class>() to
+  * allocate the object and its reference counter together.
+  *
+  * For classes which can hold their own reference count, IntrusivePtr
+  * needs no counter allocation at all.
   *
   * When ptr is passed around by value, the copy constructor and
   * destructor manages the reference count of the raw pointer.
@@ -90,7 +95,7 @@ public:
     {
         // Allocate counter on the heap, so it can be shared
         if (_ptr != nullptr) {
-            _counter = new uint32_t(1);
+            _counter = new Counter{1};
         }
     }
 
@@ -113,7 +118,7 @@ public:
     {
         // Increment reference counter
         if (_ptr != nullptr) {
-            core_util_atomic_incr_u32(_counter, 1);
+            core_util_atomic_incr_u32(&_counter->count, 1);
         }
     }
 
@@ -147,7 +152,7 @@ public:
 
             // Increment new counter
             if (_ptr != nullptr) {
-                core_util_atomic_incr_u32(_counter, 1);
+                core_util_atomic_incr_u32(&_counter->count, 1);
             }
         }
 
@@ -189,7 +194,7 @@ public:
         _ptr = ptr;
         if (ptr != nullptr) {
             // Allocate counter on the heap, so it can be shared
-            _counter = new uint32_t(1);
+            _counter = new Counter{1};
         } else {
             _counter = nullptr;
         }
@@ -224,7 +229,7 @@ public:
     uint32_t use_count() const
     {
         if (_ptr != nullptr) {
-            return core_util_atomic_load_u32(_counter);
+            return core_util_atomic_load_u32(&_counter->count) & ~BLOCK_FLAG;
         } else {
             return 0;
         }
@@ -258,11 +263,37 @@ public:
     }
 
 private:
+    template <class U, class... Args>
+    friend SharedPtr<U> make_shared(Args &&... args);
+
+    // Set in the counter of an object allocated by make_shared
+    static constexpr uint32_t BLOCK_FLAG = 0x80000000;
+
+    // Shared reference counter
+    struct Counter {
+        uint32_t count;
+    };
+
+    // Object allocated with its counter, the counter is the base so that the
+    // block is found from it whatever the layout of T
+    struct Block : Counter {
+        template <class... Args>
+        Block(Args &&... args) : Counter{1 | BLOCK_FLAG}, object(std::forward<Args>(args)...)
+        {
+        }
+
+        T object;
+    };
+
+    SharedPtr(Block *block): _ptr(&block->object), _counter(block)
+    {
+    }
+
     /**
      * @brief Get pointer to reference counter.
      * @return Pointer to reference counter.
      */
-    uint32_t *get_counter() const
+    Counter *get_counter() const
     {
         return _counter;
     }
@@ -276,7 +307,10 @@ private:
     void decrement_counter()
     {
         if (_ptr != nullptr) {
-            if (core_util_atomic_decr_u32(_counter, 1) == 0) {
+            uint32_t count = core_util_atomic_decr_u32(&_counter->count, 1);
+            if (count == BLOCK_FLAG) {
+                delete static_cast<Block *>(_counter);
+            } else if (count == 0) {
                 delete _counter;
                 delete _ptr;
             }
@@ -288,9 +322,24 @@ private:
     T *_ptr;
 
     // Pointer to shared reference counter
-    uint32_t *_counter;
+    Counter *_counter;
 };
 
+/** Create a SharedPtr, allocating the object and its reference counter at once.
+  *
+  * @code
+  * SharedPtr<MyStruct> ptr = make_shared<MyStruct>(1, 2);
+  * @endcode
+  *
+  * @param args Arguments of the constructor of T
+  * @return SharedPtr managing the new object
+  */
+template <class T, class... Args>
+SharedPtr<T> make_shared(Args &&... args)
+{
+    return SharedPtr<T>(new typename SharedPtr<T>::Block(std::forward<Args>(args)...));
+}
+
 /** Non-member relational operators.
   */
 template <class T, class U>
@@ -0,0 +1,64 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_BOOT_MEMORY_H
+#define MBED_BOOT_MEMORY_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** \ingroup mbed-os-internal */
+/** \addtogroup platform-internal-api */
+/** @{*/
+
+/*
+ * Memory initialization for the reset handlers
+ *
+ * Reset handlers may call these to copy .data and zero .bss, instead of
+ * loops storing a word at a time. They only use the stack and the memory
+ * they're given, so may run before memory is initialized.
+ *
+ * Both are weak, so that a target with a DMA controller usable from reset
+ * may replace them.
+ */
+
+/*
+ * Copies words, 32 bytes at a time
+ *
+ * @param  dest                 Word aligned destination
+ * @param  src                  Word aligned source
+ * @param  size                 Bytes to copy, a multiple of 4
+ */
+void mbed_boot_copy_memory(uint32_t *dest, const uint32_t *src, uint32_t size);
+
+/*
+ * Zeroes words, 32 bytes at a time
+ *
+ * @param  dest                 Word aligned memory to zero
+ * @param  size                 Bytes to zero, a multiple of 4
+ */
+void mbed_boot_zero_memory(uint32_t *dest, uint32_t size);
+
+/**@}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,100 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_HEAP_POOL_H
+#define MBED_HEAP_POOL_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/* Bytes reserved for the size-class pools, 0 sends every allocation to the
+ * toolchain's malloc */
+#ifndef MBED_CONF_PLATFORM_HEAP_POOL_SIZE
+#define MBED_CONF_PLATFORM_HEAP_POOL_SIZE       0
+#endif
+
+/* The pools are handed out to the size classes in slabs of this size */
+#ifndef MBED_CONF_PLATFORM_HEAP_POOL_SLAB_SIZE
+#define MBED_CONF_PLATFORM_HEAP_POOL_SLAB_SIZE  512
+#endif
+
+/** Smallest block size of the size-class pools */
+#define MBED_HEAP_POOL_MIN_BLOCK    16
+
+/** Largest allocation served by the size-class pools */
+#define MBED_HEAP_POOL_MAX_BLOCK    256
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** \ingroup mbed-os-internal */
+/** \addtogroup platform-internal-api */
+/** @{*/
+
+#if MBED_CONF_PLATFORM_HEAP_POOL_SIZE
+
+/*
+ * Segregated size-class pools for the small allocations, used by the
+ * allocation wrappers in front of the toolchain's malloc
+ *
+ * Blocks of 16 to 256 bytes come from fixed-size pools in a static area,
+ * so allocating and freeing them is constant time and they cannot fragment
+ * the heap. A slab given to a size class stays with it.
+ */
+
+/*
+ * Allocates a block from the pool of the smallest fitting size class
+ *
+ * @param  size                 Requested size in bytes
+ * @return                      Block of at least size bytes, or NULL if size
+ *                              is above MBED_HEAP_POOL_MAX_BLOCK or the pools
+ *                              are exhausted
+ */
+void *mbed_heap_pool_alloc(size_t size);
+
+/*
+ * Returns a block to its pool
+ *
+ * @param  ptr                  Block returned by mbed_heap_pool_alloc
+ */
+void mbed_heap_pool_free(void *ptr);
+
+/*
+ * Checks whether a pointer was allocated from the pools
+ *
+ * @param  ptr                  Pointer to check, may be NULL
+ * @return                      true if ptr lies in the pools
+ */
+bool mbed_heap_pool_owns(const void *ptr);
+
+/*
+ * Gets the size of a pool block
+ *
+ * @param  ptr                  Block returned by mbed_heap_pool_alloc
+ * @return                      Size of the block's class
+ */
+size_t mbed_heap_pool_block_size(const void *ptr);
+
+#endif
+
+/** @}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,164 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_CRASH_SNAPSHOT_H
+#define MBED_CRASH_SNAPSHOT_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include "platform/mbed_error.h"
+
+/** Crash snapshots are captured when the application reserves a RAM region
+ *  kept across resets (not initialized by the startup code) and sets its
+ *  start address and size, in bytes and a multiple of 4. */
+#if defined(MBED_CONF_PLATFORM_CRASH_SNAPSHOT_RAM_START) && defined(MBED_CONF_PLATFORM_CRASH_SNAPSHOT_RAM_SIZE)
+#define MBED_CRASH_SNAPSHOT_ENABLED 1
+#else
+#define MBED_CRASH_SNAPSHOT_ENABLED 0
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** \addtogroup platform-public-api */
+/** @{*/
+
+/**
+ * \defgroup platform_crash_snapshot crash snapshot functions
+ *
+ * On a fatal error, the state needed to debug it is written compressed to
+ * a RAM region kept across the reset: the error and fault contexts, the
+ * used part of the stack of every thread, the allocation profile of
+ * mbed_mem_trace_profile_callback() and the last traces. After the reboot,
+ * the application stores it with mbed_crash_snapshot_store() and uploads
+ * it when convenient.
+ *
+ * The snapshot is made of little endian 32-bit words: the header is the
+ * magic "MCS1", the length of the snapshot in bytes, the CRC32 of the
+ * records, the number of records and flags (bit 0 set if records were
+ * left out for lack of room). Each record starts with a word holding its
+ * type in the top 8 bits and its length in bytes, excluding this word, in
+ * the others, and is padded to a multiple of 4 bytes:
+ *  - MBED_CRASH_SNAPSHOT_ERROR: the mbed_error_ctx of the fatal error.
+ *  - MBED_CRASH_SNAPSHOT_FAULT: the mbed_fault_context_t, for hardware faults.
+ *  - MBED_CRASH_SNAPSHOT_STACK: the thread id (0 for the main stack in handler
+ *    mode), the start and the size of the stack, the stack pointer, then the
+ *    words from the stack pointer to the end of the stack, compressed: a word
+ *    with bit 31 set repeats the next word (word & 0x7FFFFFFF) times, others
+ *    are followed by that many words copied as they are.
+ *  - MBED_CRASH_SNAPSHOT_HEAP: the snapshot of mbed_mem_trace_profile_snapshot().
+ *  - MBED_CRASH_SNAPSHOT_TRACE: the unread records of mbed_trace_deferred_read().
+ *  - MBED_CRASH_SNAPSHOT_TRACE_LINE: the last line traced, as a string.
+ * @{
+ */
+
+/** Types of the records of a crash snapshot */
+typedef enum {
+    MBED_CRASH_SNAPSHOT_ERROR = 1,
+    MBED_CRASH_SNAPSHOT_FAULT,
+    MBED_CRASH_SNAPSHOT_STACK,
+    MBED_CRASH_SNAPSHOT_HEAP,
+    MBED_CRASH_SNAPSHOT_TRACE,
+    MBED_CRASH_SNAPSHOT_TRACE_LINE
+} mbed_crash_snapshot_record_t;
+
+/**
+ *  Capture a snapshot of the fatal error. Called by mbed_error(), and only
+ *  useful from other fatal error handlers.
+ *
+ *  @param error_ctx    Context of the fatal error
+ */
+void mbed_crash_snapshot_capture(const mbed_error_ctx *error_ctx);
+
+/**
+ *  Get the snapshot captured before the last reset.
+ *
+ *  @param size     Set to the length of the snapshot in bytes
+ *  @return The snapshot, or NULL if there is no valid one
+ */
+const void *mbed_crash_snapshot_get(size_t *size);
+
+/**
+ *  Discard the snapshot captured before the last reset.
+ */
+void mbed_crash_snapshot_clear(void);
+
+/** @}*/
+
+/** @}*/
+
+#ifdef __cplusplus
+}
+
+/** Store the snapshot captured before the last reset in a BlockDevice region,
+ *  and discard it from RAM. The region is erased first, and the snapshot is
+ *  programmed padded to the program size of the device.
+ *
+ *  @code
+ *  FlashIAPBlockDevice crash_region(CRASH_REGION_START, CRASH_REGION_SIZE);
+ *
+ *  int main()
+ *  {
+ *      crash_region.init();
+ *      if (mbed_crash_snapshot_store(crash_region, 0, crash_region.size()) == 0) {
+ *          // Tell the application a snapshot is waiting to be uploaded
+ *      }
+ *  }
+ *  @endcode
+ *
+ *  @param bd       Block device, already initialized
+ *  @param addr     Start of the region, aligned to the erase size
+ *  @param size     Size of the region, a multiple of the erase size
+ *  @return 0 if a snapshot was stored, 1 if there was none, a negative
+ *          error of the block device, or -1 if the region is too small
+ */
+template <typename BlockDevice>
+int mbed_crash_snapshot_store(BlockDevice &bd, uint64_t addr, uint64_t size)
+{
+    size_t length;
+    const uint8_t *snapshot = static_cast<const uint8_t *>(mbed_crash_snapshot_get(&length));
+    if (snapshot == NULL) {
+        return 1;
+    }
+
+    // The RAM region may end before the last program unit, which is padded in a copy
+    uint8_t tail[64];
+    uint64_t program_size = bd.get_program_size();
+    uint64_t whole = (length / program_size) * program_size;
+    if (whole + (whole < length ? program_size : 0) > size ||
+            (whole < length && program_size > sizeof(tail))) {
+        return -1;
+    }
+    int err = bd.erase(addr, size);
+    if (err == 0 && whole > 0) {
+        err = bd.program(snapshot, addr, whole);
+    }
+    if (err == 0 && whole < length) {
+        memset(tail, 0xFF, program_size);
+        memcpy(tail, snapshot + whole, length - whole);
+        err = bd.program(tail, addr + whole, program_size);
+    }
+    if (err == 0) {
+        mbed_crash_snapshot_clear();
+    }
+    return err;
+}
+
+#endif // __cplusplus
+
+#endif // MBED_CRASH_SNAPSHOT_H
@@ -0,0 +1,154 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_DCACHE_H
+#define MBED_DCACHE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "cmsis.h"
+#include "platform/mbed_toolchain.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** \addtogroup platform-public-api */
+/** @{*/
+
+/**
+ * \defgroup platform_dcache data cache maintenance for DMA
+ *
+ * Buffers shared with a DMA controller on cores with a data cache, such as
+ * Cortex-M7, must not share a cache line with data used by the CPU, and
+ * need maintenance around each transfer:
+ *  - mbed_dcache_clean() before the DMA reads memory written by the CPU.
+ *  - mbed_dcache_invalidate() after the DMA wrote memory read by the CPU.
+ *
+ * The functions do nothing on cores without a data cache, so drivers call
+ * them unconditionally.
+ *
+ * @code
+ * MBED_DMA_BUFFER static uint8_t rx_buffer[MBED_DMA_SIZE(100)];
+ *
+ * void start_rx()
+ * {
+ *     // no dirty line may be written back over the data received
+ *     mbed_dcache_clean_invalidate(rx_buffer, sizeof(rx_buffer));
+ *     start_dma(rx_buffer, 100);
+ * }
+ *
+ * void rx_done()
+ * {
+ *     // drop lines speculatively loaded during the transfer
+ *     mbed_dcache_invalidate(rx_buffer, sizeof(rx_buffer));
+ * }
+ * @endcode
+ * @{
+ */
+
+#if defined(__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+#define MBED_DCACHE_PRESENT     1
+/** Size of a data cache line, the alignment of DMA buffers */
+#define MBED_DCACHE_LINE_SIZE   32
+#else
+#define MBED_DCACHE_PRESENT     0
+#define MBED_DCACHE_LINE_SIZE   4
+#endif
+
+/** Round the size of a DMA buffer up to whole cache lines
+ *
+ *  @param size     Size of the data in bytes
+ */
+#define MBED_DMA_SIZE(size) \
+    (((size) + MBED_DCACHE_LINE_SIZE - 1) & ~(MBED_DCACHE_LINE_SIZE - 1))
+
+/** Place a variable in the section holding DMA buffers
+ *
+ *  The section is set with MBED_CONF_PLATFORM_DMA_BUFFER_SECTION, for
+ *  example to use DTCM or non-cacheable SRAM, and the linker script of
+ *  the target must define it. The default memory is used if it's not set.
+ */
+#ifdef MBED_CONF_PLATFORM_DMA_BUFFER_SECTION
+#define MBED_DMA_SECTION        MBED_SECTION(MBED_CONF_PLATFORM_DMA_BUFFER_SECTION)
+#else
+#define MBED_DMA_SECTION
+#endif
+
+/** Declare a DMA buffer: cache line aligned and in the DMA buffer section
+ *
+ *  The size of the buffer should be rounded with MBED_DMA_SIZE(), so that
+ *  it ends on a cache line boundary too.
+ */
+#define MBED_DMA_BUFFER         MBED_DMA_SECTION MBED_ALIGN(MBED_DCACHE_LINE_SIZE)
+
+/** Write back the cache lines of a buffer the DMA is going to read
+ *
+ *  @param addr     Start of the buffer
+ *  @param size     Size of the buffer in bytes
+ */
+static inline void mbed_dcache_clean(const void *addr, size_t size)
+{
+#if MBED_DCACHE_PRESENT
+    SCB_CleanDCache_by_Addr((uint32_t *)addr, (int32_t)size);
+#else
+    (void)addr;
+    (void)size;
+#endif
+}
+
+/** Discard the cache lines of a buffer the DMA has written
+ *
+ *  Data written by the CPU to the lines and not yet written back is lost,
+ *  so the buffer must own its first and last lines.
+ *
+ *  @param addr     Start of the buffer
+ *  @param size     Size of the buffer in bytes
+ */
+static inline void mbed_dcache_invalidate(void *addr, size_t size)
+{
+#if MBED_DCACHE_PRESENT
+    SCB_InvalidateDCache_by_Addr((uint32_t *)addr, (int32_t)size);
+#else
+    (void)addr;
+    (void)size;
+#endif
+}
+
+/** Write back and discard the cache lines of a buffer handed to the DMA
+ *
+ *  @param addr     Start of the buffer
+ *  @param size     Size of the buffer in bytes
+ */
+static inline void mbed_dcache_clean_invalidate(void *addr, size_t size)
+{
+#if MBED_DCACHE_PRESENT
+    SCB_CleanInvalidateDCache_by_Addr((uint32_t *)addr, (int32_t)size);
+#else
+    (void)addr;
+    (void)size;
+#endif
+}
+
+/** @}*/
+
+/** @}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -162,6 +162,77 @@ void mbed_mem_trace_free(void *ptr, void *caller);
  */
 void mbed_mem_trace_default_callback(uint8_t op, void *res, void *caller, ...);
 
+/** Maximum call sites aggregated by the profiling callback */
+#ifndef MBED_MEM_TRACE_PROFILE_SITES
+#define MBED_MEM_TRACE_PROFILE_SITES        32
+#endif
+
+/** Maximum live allocations the profiling callback follows to their free */
+#ifndef MBED_MEM_TRACE_PROFILE_LIVE
+#define MBED_MEM_TRACE_PROFILE_LIVE         128
+#endif
+
+/** Number of size classes of the profiling callback, class i counts sizes up to 16 << i bytes and the last one the larger ones */
+#define MBED_MEM_TRACE_PROFILE_SIZE_CLASSES 8
+
+/**
+ * Allocation statistics of one call site, aggregated by the profiling callback
+ */
+typedef struct {
+    void *caller;               /**< Caller of the allocations, as passed to the tracer */
+    uint32_t alloc_cnt;         /**< Number of allocations */
+    uint32_t free_cnt;          /**< Number of those allocations freed since */
+    uint32_t current_size;      /**< Bytes allocated and not freed yet */
+    uint32_t max_size;          /**< Maximum of current_size */
+    uint32_t total_size;        /**< Bytes allocated in total */
+    uint32_t lifetime_avg_us;   /**< Average time between allocation and free of the freed allocations */
+    uint32_t lifetime_max_us;   /**< Longest time between allocation and free */
+    uint32_t size_cnt[MBED_MEM_TRACE_PROFILE_SIZE_CLASSES]; /**< Allocations per size class, see MBED_MEM_TRACE_PROFILE_SIZE_CLASSES */
+} mbed_mem_trace_site_t;
+
+/**
+ * Profiling memory trace callback. DO NOT CALL DIRECTLY. It is meant to be used
+ * as the argument of 'mbed_mem_trace_set_callback'.
+ * Instead of printing, the callback aggregates the allocations in RAM by caller and by
+ * size, cheap enough to be left on. Frees are charged to the call site of the allocation.
+ * Allocations from more than MBED_MEM_TRACE_PROFILE_SITES callers, and frees of
+ * allocations not followed because more than MBED_MEM_TRACE_PROFILE_LIVE were live, are
+ * only counted in the totals of the snapshot.
+ * Lifetimes are measured with the microsecond ticker, and wrap for allocations
+ * living longer than about 71 minutes.
+ */
+void mbed_mem_trace_profile_callback(uint8_t op, void *res, void *caller, ...);
+
+/**
+ * Get the call sites aggregated by the profiling callback
+ * @param sites array of structures to fill.
+ * @param count number of structures in the array.
+ * @return the number of structures filled, at most the number of call sites seen.
+ */
+size_t mbed_mem_trace_profile_get(mbed_mem_trace_site_t *sites, size_t count);
+
+/**
+ * Write a compact binary snapshot of the profile, for transfer to a host tool.
+ * All fields are little endian 32-bit words: the magic "MTP1", the number of sites,
+ * the number of size classes, the count of untracked allocations and the count of
+ * untracked frees, followed for each site by the fields of mbed_mem_trace_site_t in order.
+ * @param buf buffer to write to, or NULL to get the size needed.
+ * @param size size of buf in bytes.
+ * @return the number of bytes written or needed, 0 if buf is too small.
+ */
+size_t mbed_mem_trace_profile_snapshot(uint8_t *buf, size_t size);
+
+/**
+ * Same as mbed_mem_trace_profile_snapshot(), without taking the trace lock.
+ * Only for fatal error handlers, which cannot wait for the lock.
+ */
+size_t mbed_mem_trace_profile_snapshot_unlocked(uint8_t *buf, size_t size);
+
+/**
+ * Clear the data aggregated by the profiling callback
+ */
+void mbed_mem_trace_profile_reset(void);
+
 /** @}*/
 
 #ifdef __cplusplus
@@ -19,6 +19,7 @@
 
 
 #include "platform/mbed_toolchain.h"
+#include "platform/mbed_stats.h"
 #include "hal/ticker_api.h"
 #include <stdbool.h>
 
@@ -90,7 +91,7 @@ extern "C" {
  *
  */
 
-#ifdef MBED_SLEEP_TRACING_ENABLED
+#if defined(MBED_SLEEP_TRACING_ENABLED) || defined(MBED_SLEEP_STATS_ENABLED)
 
 void sleep_tracker_lock(const char *const filename, int line);
 void sleep_tracker_unlock(const char *const filename, int line);
@@ -117,7 +118,7 @@ void sleep_tracker_unlock(const char *const filename, int line);
 #define sleep_manager_unlock_deep_sleep() \
     sleep_manager_unlock_deep_sleep_internal()
 
-#endif // MBED_SLEEP_TRACING_ENABLED
+#endif // defined(MBED_SLEEP_TRACING_ENABLED) || defined(MBED_SLEEP_STATS_ENABLED)
 
 /** Lock the deep sleep mode
  *
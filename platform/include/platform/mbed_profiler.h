@@ -0,0 +1,175 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_PROFILER_H
+#define MBED_PROFILER_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "platform/mbed_preprocessor.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** \addtogroup platform-public-api */
+/** @{*/
+
+/**
+ * \defgroup platform_profiler profiler functions
+ *
+ * Lightweight profiling without a debugger, on Cortex-M cores:
+ *  - a sampling profiler, which records the PC interrupted by a periodic
+ *    interrupt in a histogram of the code region.
+ *  - scoped timers counting the CPU cycles spent in a block, with
+ *    MBED_PROFILE_SCOPE(). The timers are compiled in when
+ *    MBED_PROFILER_ENABLED is defined.
+ *
+ * Cycles are counted with the DWT cycle counter, so the timers read 0 on
+ * cores without one, such as Cortex-M0/M0+.
+ * @{
+ */
+
+/**
+ * Cycles spent in a scope timed with MBED_PROFILE_SCOPE()
+ */
+typedef struct mbed_profile_scope {
+    const char *name;                   /**< Name of the scope */
+    uint32_t count;                     /**< Number of times the scope was left */
+    uint32_t max_cycles;                /**< Most cycles spent in the scope at once */
+    uint64_t total_cycles;              /**< Cycles spent in the scope in total */
+    struct mbed_profile_scope *next;    /**< Next scope timed, see mbed_profile_scope_first() */
+    uint8_t registered;                 /**< Set once added to the list of scopes */
+} mbed_profile_scope_t;
+
+/**
+ *  Read the CPU cycle counter, starting it on first use.
+ *
+ *  @return Cycles counted, or 0 if the core has no cycle counter
+ */
+uint32_t mbed_profile_cycles(void);
+
+/**
+ *  Account cycles spent in a scope. MBED_PROFILE_SCOPE() calls it when the
+ *  scope is left.
+ *
+ *  @param scope    The scope
+ *  @param cycles   Cycles spent in the scope
+ */
+void mbed_profile_scope_add(mbed_profile_scope_t *scope, uint32_t cycles);
+
+/**
+ *  Get the first scope timed, the others follow through mbed_profile_scope_t::next.
+ *
+ *  @return The most recently registered scope, or NULL if none was timed yet
+ */
+const mbed_profile_scope_t *mbed_profile_scope_first(void);
+
+/**
+ *  Start sampling the PC.
+ *
+ *  The vector of the interrupt is replaced by one which records the PC of
+ *  the interrupted context and then calls the original handler, so the
+ *  interrupt must already be set up and firing periodically. SysTick_IRQn
+ *  samples at the RTOS tick rate, and a spare timer interrupt can sample
+ *  faster. The vector table must be in RAM.
+ *
+ *  The histogram covers MBED_ROM_START to MBED_ROM_START + MBED_ROM_SIZE,
+ *  split into buckets of the smallest power of 2 size which fits.
+ *
+ *  @param irqn         The interrupt sampled, as a IRQn_Type
+ *  @param histogram    Sample counts, one word per bucket
+ *  @param buckets      Number of buckets of the histogram
+ *  @return 0 on success, -1 if sampling is already running or the ROM region is not known
+ */
+int mbed_profiler_sampling_start(int irqn, uint32_t *histogram, size_t buckets);
+
+/**
+ *  Stop sampling the PC, and restore the original vector.
+ */
+void mbed_profiler_sampling_stop(void);
+
+/**
+ * Write a compact binary snapshot of the histogram, for transfer to a host tool.
+ * All fields are little endian 32-bit words: the magic "MPS1", the start address
+ * of the histogram, log2 of the bucket size, the number of buckets, the number of
+ * samples and the number of those outside of the histogram (in RAM functions for
+ * instance), followed by the count of each bucket.
+ * @param buf buffer to write to, or NULL to get the size needed.
+ * @param size size of buf in bytes.
+ * @return the number of bytes written or needed, 0 if buf is too small or sampling
+ *         was never started.
+ */
+size_t mbed_profiler_sampling_snapshot(uint8_t *buf, size_t size);
+
+/**
+ * Send the snapshot of mbed_profiler_sampling_snapshot() on an ITM stimulus
+ * port, on targets with DEVICE_ITM.
+ * @param port ITM stimulus port.
+ */
+void mbed_profiler_sampling_itm_send(uint32_t port);
+
+/** @}*/
+
+/** @}*/
+
+#ifdef __cplusplus
+}
+
+namespace mbed {
+namespace internal {
+/** Timer of MBED_PROFILE_SCOPE(), accounting the cycles when destroyed */
+class ProfileScopeTimer {
+public:
+    ProfileScopeTimer(mbed_profile_scope_t *scope) : _scope(scope), _start(mbed_profile_cycles())
+    {
+    }
+
+    ~ProfileScopeTimer()
+    {
+        mbed_profile_scope_add(_scope, mbed_profile_cycles() - _start);
+    }
+
+private:
+    mbed_profile_scope_t *_scope;
+    uint32_t _start;
+};
+} // namespace internal
+} // namespace mbed
+
+#ifdef MBED_PROFILER_ENABLED
+/** Count the cycles spent from this point to the end of the enclosing scope
+ *
+ * @code
+ * void process()
+ * {
+ *     MBED_PROFILE_SCOPE("process");
+ *     ...
+ * }
+ * @endcode
+ *
+ * @param scope_name Name of the scope, a string literal
+ */
+#define MBED_PROFILE_SCOPE(scope_name) \
+    static mbed_profile_scope_t MBED_CONCAT(mbed_profile_scope_, __LINE__) = { scope_name }; \
+    mbed::internal::ProfileScopeTimer MBED_CONCAT(mbed_profile_timer_, __LINE__)(&MBED_CONCAT(mbed_profile_scope_, __LINE__))
+#else
+#define MBED_PROFILE_SCOPE(scope_name)
+#endif
+
+#endif // __cplusplus
+
+#endif // MBED_PROFILER_H
@@ -183,6 +183,21 @@ FileHandle *mbed_override_console(int fd);
  *           possible if it's not open with current implementation).
  */
 FileHandle *mbed_file_handle(int fd);
+
+/** Get the number of console characters dropped because the transmit
+ * buffer was full
+ *
+ * With the raw HAL serial console and the configuration option
+ * "platform.stdio-tx-buffer-size" set, writes to the console copy the
+ * characters to a ring buffer and return at once. The buffer is drained by
+ * the serial TX interrupt, and characters which do not fit are dropped.
+ * Writes from a critical section, such as error reports, flush the buffer
+ * and are not buffered.
+ *
+ * @return number of characters dropped since reset, always 0 without
+ *         the transmit buffer
+ */
+uint32_t mbed_console_tx_dropped();
 }
 #endif
 typedef struct DIR_impl DIR;
@@ -561,6 +576,12 @@ struct pollfd {
     short revents;
 };
 
+/* sys/uio.h defines */
+struct iovec {
+    void *iov_base;     ///< Start of the buffer
+    size_t iov_len;     ///< Size of the buffer in bytes
+};
+
 /* POSIX-compatible I/O functions */
 #if __cplusplus
 extern "C" {
@@ -577,6 +598,8 @@ extern "C" {
 #endif // !MBED_CONF_PLATFORM_STDIO_MINIMAL_CONSOLE_ONLY
     ssize_t write(int fildes, const void *buf, size_t nbyte);
     ssize_t read(int fildes, void *buf, size_t nbyte);
+    ssize_t writev(int fildes, const struct iovec *iov, int iovcnt);
+    ssize_t readv(int fildes, const struct iovec *iov, int iovcnt);
     int fsync(int fildes);
     int isatty(int fildes);
 #if !MBED_CONF_PLATFORM_STDIO_MINIMAL_CONSOLE_ONLY
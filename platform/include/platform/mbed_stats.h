@@ -49,6 +49,15 @@ extern "C" {
 #ifndef MBED_THREAD_STATS_ENABLED
 #define MBED_THREAD_STATS_ENABLED   1
 #endif
+#ifndef MBED_MUTEX_STATS_ENABLED
+#define MBED_MUTEX_STATS_ENABLED    1
+#endif
+#ifndef MBED_SLEEP_STATS_ENABLED
+#define MBED_SLEEP_STATS_ENABLED    1
+#endif
+#ifndef MBED_BOOT_STATS_ENABLED
+#define MBED_BOOT_STATS_ENABLED     1
+#endif
 
 #endif // MBED_ALL_STATS_ENABLED
 
@@ -75,6 +84,15 @@ typedef struct {
  */
 void mbed_stats_heap_get(mbed_stats_heap_t *stats);
 
+/**
+ *  Fill the passed in heap stat structure with the statistics of the static
+ *  pool thread stacks are allocated from when MBED_CONF_RTOS_THREAD_STACK_POOL_SIZE
+ *  is set. max_size is the peak use, the pool size the threads run so far need.
+ *
+ *  @param stats    A pointer to the mbed_stats_heap_t structure to fill
+ */
+void mbed_stats_stack_pool_get(mbed_stats_heap_t *stats);
+
 /**
  * struct mbed_stats_stack_t definition
  */
@@ -121,6 +139,19 @@ typedef struct {
  */
 void mbed_stats_cpu_get(mbed_stats_cpu_t *stats);
 
+/** Maximum threads whose run time is tracked by thread statistics, or whose
+ *  stack use is tracked when MBED_STACK_STATS_SAMPLED is set
+ *
+ *  Sampled stack statistics record the stack pointer of each thread when it
+ *  is switched out, instead of filling the stacks with a pattern at thread
+ *  creation and scanning them when queried. They are cheap enough to query
+ *  often, but miss stack used between context switches, by interrupt
+ *  handlers for instance, so they are a lower bound of the real use.
+ */
+#ifndef MBED_MAX_THREAD_RUN_TIMES
+#define MBED_MAX_THREAD_RUN_TIMES       16
+#endif
+
 /**
  * struct mbed_stats_thread_t definition
  */
@@ -131,6 +162,7 @@ typedef struct {
     uint32_t stack_size;        /**< Current number of bytes reserved for the stack */
     uint32_t stack_space;       /**< Current number of free bytes remaining on the stack */
     const char   *name;         /**< Name of the thread */
+    us_timestamp_t run_time;    /**< Time the thread has spent running since it was created */
 } mbed_stats_thread_t;
 
 /**
@@ -144,6 +176,158 @@ typedef struct {
  */
 size_t mbed_stats_thread_get_each(mbed_stats_thread_t *stats, size_t count);
 
+/**
+ * struct mbed_stats_thread_usage_t definition
+ */
+typedef struct {
+    uint32_t id;                /**< ID of the thread */
+    const char   *name;         /**< Name of the thread */
+    us_timestamp_t run_time;    /**< Time the thread has spent running since the previous sample */
+    uint32_t usage;             /**< Share of the sample taken by the thread, in hundredths of a percent */
+} mbed_stats_thread_usage_t;
+
+/**
+ *  Sample the CPU usage of each available thread, in the style of top.
+ *
+ *  Each call covers the time since the previous call, or since the threads were
+ *  created for the first one. Shares are relative to the run time of all threads
+ *  in the sample, so the idle thread's share is the time the CPU was not used.
+ *  All threads start a new sample, including those that do not fit in the array.
+ *
+ *  @param usage    A pointer to an array of mbed_stats_thread_usage_t structures to fill
+ *  @param count    The number of mbed_stats_thread_usage_t structures in the provided array
+ *  @return         The number of mbed_stats_thread_usage_t structures that have been filled,
+ *                  as for mbed_stats_thread_get_each.
+ *
+ *  @note Run time is only tracked for the first MBED_MAX_THREAD_RUN_TIMES threads alive at a time.
+ */
+size_t mbed_stats_thread_usage_sample(mbed_stats_thread_usage_t *usage, size_t count);
+
+/**
+ * struct mbed_stats_mutex_t definition, filled in by rtos::Mutex::get_stats
+ */
+typedef struct {
+    uint32_t acquisitions;      /**< Number of times the mutex was acquired since reset, recursive locks included */
+    uint32_t contended;         /**< Number of those acquisitions that found the mutex owned by another thread */
+    uint32_t max_hold_us;       /**< Longest time the mutex was held by one owner since reset, in microseconds */
+} mbed_stats_mutex_t;
+
+/** Maximum deep sleep locks reported by sleep statistics */
+#define MBED_MAX_SLEEP_LOCKS            10
+
+/** Length of the file name prefix identifying a deep sleep lock, including the terminator */
+#define MBED_SLEEP_LOCK_ID_WIDTH        15
+
+/** Maximum wakeup sources reported by sleep statistics */
+#define MBED_MAX_WAKEUP_SOURCES         8
+
+/** Number of sleep duration buckets, bucket i counts sleeps shorter than 10^i ms and the last one the longer ones */
+#define MBED_SLEEP_HISTOGRAM_BUCKETS    6
+
+/**
+ * struct mbed_stats_sleep_lock_t definition
+ */
+typedef struct {
+    char identifier[MBED_SLEEP_LOCK_ID_WIDTH]; /**< Start of the name of the file that took the lock, empty for unused entries */
+    uint32_t held;                  /**< Number of times the lock is currently held */
+    uint32_t blocked_count;         /**< Number of sleeps that could not enter deep sleep while the lock was held */
+    us_timestamp_t blocked_time;    /**< Time spent in sleep instead of deep sleep while the lock was held */
+} mbed_stats_sleep_lock_t;
+
+/**
+ * struct mbed_stats_wakeup_t definition
+ */
+typedef struct {
+    int32_t irq;                /**< Interrupt pending on wakeup, numbered as IRQn_Type */
+    uint32_t count;             /**< Number of wakeups by this interrupt */
+} mbed_stats_wakeup_t;
+
+/**
+ * struct mbed_stats_sleep_t definition
+ */
+typedef struct {
+    uint32_t sleep_cnt;         /**< Number of times the system entered sleep */
+    uint32_t deep_sleep_cnt;    /**< Number of times the system entered deep sleep */
+    uint32_t blocked_cnt;       /**< Number of those sleeps that could not enter deep sleep because of a lock */
+    uint32_t sleep_histogram[MBED_SLEEP_HISTOGRAM_BUCKETS];         /**< Sleep durations, see MBED_SLEEP_HISTOGRAM_BUCKETS */
+    uint32_t deep_sleep_histogram[MBED_SLEEP_HISTOGRAM_BUCKETS];    /**< Deep sleep durations, see MBED_SLEEP_HISTOGRAM_BUCKETS */
+    mbed_stats_sleep_lock_t locks[MBED_MAX_SLEEP_LOCKS];            /**< Deep sleep locks taken through sleep_manager_lock_deep_sleep */
+    mbed_stats_wakeup_t wakeups[MBED_MAX_WAKEUP_SOURCES];           /**< Interrupts that woke the system up, unused entries have a zero count */
+    uint32_t wakeup_unknown_cnt;    /**< Wakeups with no interrupt pending, or by interrupts not fitting in wakeups */
+} mbed_stats_sleep_t;
+
+/**
+ *  Fill the passed in structure with sleep statistics since reset.
+ *
+ *  Durations are only measured on targets with a low power ticker.
+ *  Wakeup sources are only recorded on Cortex-M targets.
+ *
+ *  @param stats    A pointer to the mbed_stats_sleep_t structure to fill
+ */
+void mbed_stats_sleep_get(mbed_stats_sleep_t *stats);
+
+/**
+ *  Reset the sleep statistics, apart from the locks currently held.
+ */
+void mbed_stats_sleep_reset(void);
+
+/**
+ * enum mbed_boot_phase_t definition
+ */
+typedef enum {
+    MBED_BOOT_PHASE_INIT,           /**< mbed_init() was entered, after the C library startup initialized memory */
+    MBED_BOOT_PHASE_SDK_INIT,       /**< mbed_sdk_init() returned, the target is initialized */
+    MBED_BOOT_PHASE_RTOS_INIT,      /**< The RTOS kernel is initialized */
+    MBED_BOOT_PHASE_RTOS_START,     /**< The main thread started running */
+    MBED_BOOT_PHASE_STATIC_INIT,    /**< C++ static constructors ran */
+    MBED_BOOT_PHASE_MAIN,           /**< main() is about to be called */
+    MBED_BOOT_PHASE_APPLICATION,    /**< Reserved for the application, for instance once its first packet is sent */
+    MBED_BOOT_PHASE_COUNT
+} mbed_boot_phase_t;
+
+/**
+ * struct mbed_stats_boot_t definition
+ */
+typedef struct {
+    uint32_t cycles[MBED_BOOT_PHASE_COUNT];     /**< CPU cycles from the start of the count to each phase, 0 for the phases not (yet) reached */
+    uint32_t core_clock;                        /**< SystemCoreClock when MBED_BOOT_PHASE_MAIN was reached, to convert the cycles to time */
+} mbed_stats_boot_t;
+
+/**
+ *  Start counting boot cycles before memory is initialized.
+ *
+ *  Cycles are otherwise counted from MBED_BOOT_PHASE_INIT. When
+ *  MBED_BOOT_STATS_FROM_RESET is defined, the reset handler calls this
+ *  before it copies .data and zeroes .bss, or before the C library does,
+ *  and the time they take is recorded as MBED_BOOT_PHASE_INIT.
+ *
+ *  This only writes the DWT registers, so may be called before RAM is
+ *  initialized.
+ */
+void mbed_stats_boot_start(void);
+
+/**
+ *  Record that the boot reached a phase.
+ *
+ *  The boot code records all the phases but MBED_BOOT_PHASE_APPLICATION.
+ *  Only the first mark of each phase is kept.
+ *
+ *  @param phase    The phase reached
+ */
+void mbed_stats_boot_mark(mbed_boot_phase_t phase);
+
+/**
+ *  Fill the passed in structure with the boot phase timestamps.
+ *
+ *  Cycles are counted with the DWT cycle counter, so are only recorded on
+ *  Cortex-M cores which have one. The reset handler, SystemInit() and the C
+ *  library startup run before MBED_BOOT_PHASE_INIT, and are only measured if
+ *  the reset handler calls mbed_stats_boot_start().
+ *
+ *  @param stats    A pointer to the mbed_stats_boot_t structure to fill
+ */
+void mbed_stats_boot_get(mbed_stats_boot_t *stats);
+
 /**
  * enum mbed_compiler_id_t definition
  */
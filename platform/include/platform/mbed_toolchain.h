@@ -455,6 +455,72 @@
 #endif
 #endif
 
+/** MBED_NOINIT
+ *  Declare a variable which the startup code does not zero.
+ *
+ *  Large buffers which are always written before being read, such as
+ *  network pools and DMA buffers, then take no boot time. Their content is
+ *  undefined after power up, and may be kept over a reset.
+ *
+ *  GCC and ARM Compiler place them in .bss.noinit, which is zeroed with the
+ *  rest of .bss unless the target's linker script places it first in a
+ *  NOLOAD output section, or scatter file in an UNINIT region. IAR uses
+ *  __no_init.
+ *
+ *  @code
+ *  #include "mbed_toolchain.h"
+ *
+ *  MBED_NOINIT static uint8_t rx_buffer[16384];
+ *  @endcode
+ */
+#ifndef MBED_NOINIT
+#if defined(__ICCARM__)
+#define MBED_NOINIT __no_init
+#else
+#define MBED_NOINIT MBED_SECTION(".bss.noinit")
+#endif
+#endif
+
+/** MBED_HOT
+ *  Declare a function that runs from RAM, so that it's not slowed down by
+ *  flash wait states.
+ *
+ *  Functions are only moved when MBED_CONF_PLATFORM_HOT_CODE_IN_RAM is
+ *  set. They are then placed in MBED_CONF_PLATFORM_HOT_CODE_SECTION if
+ *  the target's linker script provides one, such as a section in ITCM.
+ *  Otherwise GCC places them with the initialized data, which the startup
+ *  code copies to RAM, and IAR uses __ramfunc. ARM Compiler needs the
+ *  section, as its scatter files place code by type and not by name.
+ *
+ *  GCC ignores the section of template functions, so they stay in flash.
+ *
+ *  @code
+ *  #include "mbed_toolchain.h"
+ *
+ *  MBED_HOT uint32_t checksum(const uint8_t *data, size_t size) {
+ *
+ *  }
+ *  @endcode
+ */
+#ifndef MBED_CONF_PLATFORM_HOT_CODE_IN_RAM
+#define MBED_CONF_PLATFORM_HOT_CODE_IN_RAM 0
+#endif
+
+#ifndef MBED_HOT
+#if !MBED_CONF_PLATFORM_HOT_CODE_IN_RAM
+#define MBED_HOT
+#elif defined(MBED_CONF_PLATFORM_HOT_CODE_SECTION)
+#define MBED_HOT MBED_NOINLINE MBED_SECTION(MBED_CONF_PLATFORM_HOT_CODE_SECTION)
+#elif defined(__ICCARM__)
+#define MBED_HOT __ramfunc
+#elif defined(__GNUC__) && !defined(__clang__)
+// Not a .data. name, which the assembler expects to hold data
+#define MBED_HOT __attribute__((noinline, noclone, section(".data_mbed_hot")))
+#else
+#define MBED_HOT
+#endif
+#endif
+
 /**
  * Macro expanding to a string literal of the enclosing function name.
  *
@@ -282,6 +282,41 @@ void mbed_trace_include_filters_set(char *filters);
 /** get trace include filters
  */
 const char *mbed_trace_include_filters_get(void);
+/**
+ * Set deferred trace mode.
+ * Instead of being formatted and printed, traces are stored as binary records
+ * in the given ring buffer, to be read with mbed_trace_deferred_read() and
+ * formatted later, typically by a host tool holding the application's ELF file.
+ * Command line traces are still printed.
+ *
+ * Each record is made of little-endian words:
+ *  - uint16_t record length in bytes, including this header, always a multiple of 4,
+ *    uint8_t trace level, uint8_t reserved.
+ *  - uint32_t address of the group string.
+ *  - uint32_t address of the format string.
+ *  - the arguments taken by the format, in order, each one padded to a multiple of 4 bytes:
+ *    integers and pointers as in memory, double as 8 bytes, and strings as a
+ *    uint32_t length followed by up to MBED_TRACE_DEFERRED_STRING_LENGTH bytes (default 32).
+ *
+ * Traces which do not fit in the buffer are dropped and counted.
+ * The "%n" conversion is not supported.
+ * @param buffer ring buffer which stores the records, NULL to print traces again.
+ * @param size size of the buffer in bytes.
+ */
+void mbed_trace_deferred_set(void *buffer, size_t size);
+/**
+ * Read deferred trace records.
+ * Only whole records are read, oldest first.
+ * @param buffer buffer to copy the records to.
+ * @param size size of the buffer in bytes.
+ * @return number of bytes read.
+ */
+size_t mbed_trace_deferred_read(void *buffer, size_t size);
+/**
+ * Get the number of traces dropped since deferred mode was set
+ * because the ring buffer was full.
+ */
+uint32_t mbed_trace_deferred_dropped(void);
 /**
  * General trace function
  * This should be used every time when user want to print out something important thing
@@ -394,6 +429,9 @@ char *mbed_trace_array(const uint8_t *buf, uint16_t len);
 #undef mbed_trace_exclude_filters_get
 #undef mbed_trace_include_filters_set
 #undef mbed_trace_include_filters_get
+#undef mbed_trace_deferred_set
+#undef mbed_trace_deferred_read
+#undef mbed_trace_deferred_dropped
 #undef mbed_tracef
 #undef mbed_vtracef
 #undef mbed_trace_last
@@ -419,6 +457,9 @@ char *mbed_trace_array(const uint8_t *buf, uint16_t len);
 #define mbed_trace_exclude_filters_get(...)         ((const char *) 0)
 #define mbed_trace_include_filters_set(...)         ((void) 0)
 #define mbed_trace_include_filters_get(...)         ((const char *) 0)
+#define mbed_trace_deferred_set(...)                ((void) 0)
+#define mbed_trace_deferred_read(...)               ((size_t) 0)
+#define mbed_trace_deferred_dropped(...)            ((uint32_t) 0)
 #define mbed_trace_last(...)                        ((const char *) 0)
 #define mbed_tracef(...)                            ((void) 0)
 #define mbed_vtracef(...)                           ((void) 0)
@@ -16,6 +16,8 @@
 #include <stdio.h>
 #include <string.h>
 #include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
 
 #ifdef MBED_CONF_MBED_TRACE_ENABLE
 #undef MBED_CONF_MBED_TRACE_ENABLE
@@ -85,6 +87,13 @@
 #define DEFAULT_TRACE_FILTER_LENGTH       24
 #endif
 
+/** default max length of a string argument recorded in deferred mode */
+#ifdef MBED_TRACE_DEFERRED_STRING_LENGTH
+#define DEFAULT_TRACE_DEFERRED_STRING_LENGTH MBED_TRACE_DEFERRED_STRING_LENGTH
+#else
+#define DEFAULT_TRACE_DEFERRED_STRING_LENGTH 32
+#endif
+
 /** default trace configuration bitmask */
 #ifdef MBED_TRACE_CONFIG
 #define DEFAULT_TRACE_CONFIG              MBED_TRACE_CONFIG
@@ -96,6 +105,7 @@
 static void mbed_trace_realloc(char **buffer, int *length_ptr, int new_length);
 static void mbed_trace_default_print(const char *str);
 static void mbed_trace_reset_tmp(void);
+static void mbed_trace_deferred_write(uint8_t dlevel, const char *grp, const char *fmt, va_list ap);
 
 typedef struct trace_s {
     /** trace configuration bits */
@@ -131,6 +141,16 @@ typedef struct trace_s {
     void (*mutex_release_f)(void);
     /** number of times the mutex has been locked */
     int mutex_lock_count;
+    /** deferred mode ring buffer, traces are formatted when NULL */
+    uint8_t *deferred_buf;
+    /** deferred mode ring buffer size */
+    size_t deferred_size;
+    /** deferred mode ring buffer write index */
+    size_t deferred_head;
+    /** deferred mode ring buffer read index */
+    size_t deferred_tail;
+    /** number of traces dropped because the ring buffer was full */
+    uint32_t deferred_dropped;
 } trace_t;
 
 static trace_t m_trace = {
@@ -149,7 +169,12 @@ static trace_t m_trace = {
     .cmd_printf = 0,
     .mutex_wait_f = 0,
     .mutex_release_f = 0,
-    .mutex_lock_count = 0
+    .mutex_lock_count = 0,
+    .deferred_buf = 0,
+    .deferred_size = 0,
+    .deferred_head = 0,
+    .deferred_tail = 0,
+    .deferred_dropped = 0
 };
 
 int mbed_trace_init(void)
@@ -209,6 +234,11 @@ void mbed_trace_free(void)
     m_trace.mutex_wait_f = 0;
     m_trace.mutex_release_f = 0;
     m_trace.mutex_lock_count = 0;
+    m_trace.deferred_buf = 0;
+    m_trace.deferred_size = 0;
+    m_trace.deferred_head = 0;
+    m_trace.deferred_tail = 0;
+    m_trace.deferred_dropped = 0;
 }
 static void mbed_trace_realloc(char **buffer, int *length_ptr, int new_length)
 {
@@ -331,6 +361,11 @@ void mbed_vtracef(uint8_t dlevel, const char *grp, const char *fmt, va_list ap)
         goto end;
     }
     if ((m_trace.trace_config & TRACE_MASK_LEVEL) &  dlevel) {
+        if (m_trace.deferred_buf && dlevel != TRACE_LEVEL_CMD) {
+            mbed_trace_deferred_write(dlevel, grp, fmt, ap);
+            mbed_trace_reset_tmp();
+            goto end;
+        }
         bool color = (m_trace.trace_config & TRACE_MODE_COLOR) != 0;
         bool plain = (m_trace.trace_config & TRACE_MODE_PLAIN) != 0;
         bool cr    = (m_trace.trace_config & TRACE_CARRIAGE_RETURN) != 0;
@@ -494,6 +529,319 @@ end:
         } while (--count > 0);
     }
 }
+/* Deferred mode */
+typedef enum {
+    DEFERRED_ARG_NONE,
+    DEFERRED_ARG_INT,
+    DEFERRED_ARG_LONG,
+    DEFERRED_ARG_LONG_LONG,
+    DEFERRED_ARG_SIZE,
+    DEFERRED_ARG_INTMAX,
+    DEFERRED_ARG_PTRDIFF,
+    DEFERRED_ARG_POINTER,
+    DEFERRED_ARG_DOUBLE,
+    DEFERRED_ARG_STRING
+} deferred_arg_t;
+
+/* Return the type of the next argument consumed by the format and advance it.
+ * A '*' width or precision takes an int argument of its own, returned with
+ * star set; the caller skips the '*' and the next call resumes in the same
+ * conversion.
+ */
+static deferred_arg_t mbed_trace_deferred_next_arg(const char **fmt_ptr, bool *star)
+{
+    const char *fmt = *fmt_ptr;
+    deferred_arg_t type = DEFERRED_ARG_INT;
+
+    if (!*star) {
+        while (*fmt && *fmt != '%') {
+            fmt++;
+        }
+        if (!*fmt) {
+            *fmt_ptr = fmt;
+            return DEFERRED_ARG_NONE;
+        }
+        fmt++;
+        while (*fmt && strchr("-+ #0", *fmt)) {
+            fmt++;
+        }
+    }
+    *star = false;
+    if (*fmt == '*') {
+        *fmt_ptr = fmt;
+        *star = true;
+        return DEFERRED_ARG_INT;
+    }
+    while (*fmt >= '0' && *fmt <= '9') {
+        fmt++;
+    }
+    if (*fmt == '.') {
+        fmt++;
+        if (*fmt == '*') {
+            *fmt_ptr = fmt;
+            *star = true;
+            return DEFERRED_ARG_INT;
+        }
+        while (*fmt >= '0' && *fmt <= '9') {
+            fmt++;
+        }
+    }
+    switch (*fmt) {
+        case 'h':
+            fmt += (fmt[1] == 'h') ? 2 : 1;
+            break;
+        case 'l':
+            if (fmt[1] == 'l') {
+                type = DEFERRED_ARG_LONG_LONG;
+                fmt += 2;
+            } else {
+                type = DEFERRED_ARG_LONG;
+                fmt++;
+            }
+            break;
+        case 'z':
+            type = DEFERRED_ARG_SIZE;
+            fmt++;
+            break;
+        case 'j':
+            type = DEFERRED_ARG_INTMAX;
+            fmt++;
+            break;
+        case 't':
+            type = DEFERRED_ARG_PTRDIFF;
+            fmt++;
+            break;
+        case 'L':
+            fmt++;
+            break;
+        default:
+            break;
+    }
+    switch (*fmt) {
+        case '\0':
+            type = DEFERRED_ARG_NONE;
+            break;
+        case '%':
+            type = DEFERRED_ARG_NONE;
+            fmt++;
+            break;
+        case 's':
+            type = DEFERRED_ARG_STRING;
+            fmt++;
+            break;
+        case 'p':
+        case 'n':
+            type = DEFERRED_ARG_POINTER;
+            fmt++;
+            break;
+        case 'f':
+        case 'F':
+        case 'e':
+        case 'E':
+        case 'g':
+        case 'G':
+        case 'a':
+        case 'A':
+            type = DEFERRED_ARG_DOUBLE;
+            fmt++;
+            break;
+        default:
+            fmt++;
+            break;
+    }
+    *fmt_ptr = fmt;
+    return type;
+}
+
+/* Fetch the next argument into a buffer of 8 bytes, and return its size */
+static size_t mbed_trace_deferred_fetch(deferred_arg_t type, va_list *ap, uint8_t *value, const char **str)
+{
+    *str = NULL;
+    switch (type) {
+        case DEFERRED_ARG_INT: {
+            int v = va_arg(*ap, int);
+            memcpy(value, &v, sizeof(v));
+            return sizeof(v);
+        }
+        case DEFERRED_ARG_LONG: {
+            long v = va_arg(*ap, long);
+            memcpy(value, &v, sizeof(v));
+            return sizeof(v);
+        }
+        case DEFERRED_ARG_LONG_LONG: {
+            long long v = va_arg(*ap, long long);
+            memcpy(value, &v, sizeof(v));
+            return sizeof(v);
+        }
+        case DEFERRED_ARG_SIZE: {
+            size_t v = va_arg(*ap, size_t);
+            memcpy(value, &v, sizeof(v));
+            return sizeof(v);
+        }
+        case DEFERRED_ARG_INTMAX: {
+            intmax_t v = va_arg(*ap, intmax_t);
+            memcpy(value, &v, sizeof(v));
+            return sizeof(v);
+        }
+        case DEFERRED_ARG_PTRDIFF: {
+            ptrdiff_t v = va_arg(*ap, ptrdiff_t);
+            memcpy(value, &v, sizeof(v));
+            return sizeof(v);
+        }
+        case DEFERRED_ARG_POINTER: {
+            uint32_t v = (uint32_t)(uintptr_t) va_arg(*ap, void *);
+            memcpy(value, &v, sizeof(v));
+            return sizeof(v);
+        }
+        case DEFERRED_ARG_DOUBLE: {
+            double v = va_arg(*ap, double);
+            memcpy(value, &v, sizeof(v));
+            return sizeof(v);
+        }
+        case DEFERRED_ARG_STRING: {
+            *str = va_arg(*ap, const char *);
+            if (*str == NULL) {
+                *str = "<null>";
+            }
+            uint32_t len = strlen(*str);
+            if (len > DEFAULT_TRACE_DEFERRED_STRING_LENGTH) {
+                len = DEFAULT_TRACE_DEFERRED_STRING_LENGTH;
+            }
+            memcpy(value, &len, sizeof(len));
+            return sizeof(len);
+        }
+        default:
+            return 0;
+    }
+}
+
+/* Length of a value once padded to whole words */
+#define deferred_padded(len) (((len) + 3) & ~3)
+
+static void mbed_trace_deferred_put(const void *data, size_t len)
+{
+    const uint8_t *src = data;
+    while (len--) {
+        m_trace.deferred_buf[m_trace.deferred_head] = *src++;
+        m_trace.deferred_head = (m_trace.deferred_head + 1) % m_trace.deferred_size;
+    }
+}
+
+static void mbed_trace_deferred_pad(size_t len)
+{
+    static const uint8_t zero[3] = {0};
+    mbed_trace_deferred_put(zero, deferred_padded(len) - len);
+}
+
+static void mbed_trace_deferred_write(uint8_t dlevel, const char *grp, const char *fmt, va_list ap)
+{
+    uint8_t value[8];
+    const char *str;
+    const char *f;
+    bool star = false;
+    deferred_arg_t type;
+    va_list ap2;
+
+    // First pass to find out the record length
+    size_t len = 12;
+    va_copy(ap2, ap);
+    f = fmt;
+    while ((type = mbed_trace_deferred_next_arg(&f, &star)) != DEFERRED_ARG_NONE) {
+        size_t size = mbed_trace_deferred_fetch(type, &ap2, value, &str);
+        len += deferred_padded(size);
+        if (str) {
+            uint32_t str_len;
+            memcpy(&str_len, value, sizeof(str_len));
+            len += deferred_padded(str_len);
+        }
+        if (star) {
+            f++;
+        }
+    }
+    va_end(ap2);
+
+    size_t used = (m_trace.deferred_head + m_trace.deferred_size - m_trace.deferred_tail) % m_trace.deferred_size;
+    if (len > 0xFFFF || len >= m_trace.deferred_size - used) {
+        m_trace.deferred_dropped++;
+        return;
+    }
+
+    uint16_t record_len = len;
+    uint8_t header[4] = {0};
+    uint32_t grp_addr = (uint32_t)(uintptr_t) grp;
+    uint32_t fmt_addr = (uint32_t)(uintptr_t) fmt;
+    memcpy(header, &record_len, sizeof(record_len));
+    header[2] = dlevel;
+    mbed_trace_deferred_put(header, sizeof(header));
+    mbed_trace_deferred_put(&grp_addr, sizeof(grp_addr));
+    mbed_trace_deferred_put(&fmt_addr, sizeof(fmt_addr));
+
+    va_copy(ap2, ap);
+    f = fmt;
+    star = false;
+    while ((type = mbed_trace_deferred_next_arg(&f, &star)) != DEFERRED_ARG_NONE) {
+        size_t size = mbed_trace_deferred_fetch(type, &ap2, value, &str);
+        mbed_trace_deferred_put(value, size);
+        mbed_trace_deferred_pad(size);
+        if (str) {
+            uint32_t str_len;
+            memcpy(&str_len, value, sizeof(str_len));
+            mbed_trace_deferred_put(str, str_len);
+            mbed_trace_deferred_pad(str_len);
+        }
+        if (star) {
+            f++;
+        }
+    }
+    va_end(ap2);
+}
+
+void mbed_trace_deferred_set(void *buffer, size_t size)
+{
+    if (m_trace.mutex_wait_f) {
+        m_trace.mutex_wait_f();
+    }
+    m_trace.deferred_buf = size ? buffer : NULL;
+    m_trace.deferred_size = size;
+    m_trace.deferred_head = 0;
+    m_trace.deferred_tail = 0;
+    m_trace.deferred_dropped = 0;
+    if (m_trace.mutex_release_f) {
+        m_trace.mutex_release_f();
+    }
+}
+
+size_t mbed_trace_deferred_read(void *buffer, size_t size)
+{
+    uint8_t *dst = buffer;
+    size_t read = 0;
+
+    if (m_trace.mutex_wait_f) {
+        m_trace.mutex_wait_f();
+    }
+    while (m_trace.deferred_buf && m_trace.deferred_tail != m_trace.deferred_head) {
+        uint16_t record_len = m_trace.deferred_buf[m_trace.deferred_tail] |
+                              (m_trace.deferred_buf[(m_trace.deferred_tail + 1) % m_trace.deferred_size] << 8);
+        if (record_len > size - read) {
+            break;
+        }
+        // Only whole records are read
+        while (record_len--) {
+            dst[read++] = m_trace.deferred_buf[m_trace.deferred_tail];
+            m_trace.deferred_tail = (m_trace.deferred_tail + 1) % m_trace.deferred_size;
+        }
+    }
+    if (m_trace.mutex_release_f) {
+        m_trace.mutex_release_f();
+    }
+    return read;
+}
+
+uint32_t mbed_trace_deferred_dropped(void)
+{
+    return m_trace.deferred_dropped;
+}
+
 static void mbed_trace_reset_tmp(void)
 {
     m_trace.tmp_data_ptr = m_trace.tmp_data;
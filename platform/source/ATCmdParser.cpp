@@ -25,6 +25,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <ctype.h>
 
 #ifdef LF
 #undef LF
@@ -59,12 +60,27 @@ int ATCmdParser::putc(char c)
 
 int ATCmdParser::getc()
 {
+    if (_rx_pos < _rx_len) {
+        return static_cast<unsigned char>(_rx_buffer[_rx_pos++]);
+    }
+
     pollfh fhs;
     fhs.fh = _fh;
     fhs.events = POLLIN;
 
     int count = poll(&fhs, 1, _timeout);
     if (count > 0 && (fhs.revents & POLLIN)) {
+        if (_rx_buffer) {
+            // Take everything available in one read, the next bytes are
+            // then returned without going through the file handle
+            ssize_t len = _fh->read(_rx_buffer, MBED_CONF_PLATFORM_ATCMDPARSER_RX_BUFFER_SIZE);
+            if (len <= 0) {
+                return -1;
+            }
+            _rx_pos = 1;
+            _rx_len = len;
+            return static_cast<unsigned char>(_rx_buffer[0]);
+        }
         unsigned char ch;
         return _fh->read(&ch, 1) == 1 ? ch : -1;
     } else {
@@ -72,8 +88,15 @@ int ATCmdParser::getc()
     }
 }
 
+bool ATCmdParser::readable()
+{
+    return _rx_pos < _rx_len || _fh->readable();
+}
+
 void ATCmdParser::flush()
 {
+    _rx_pos = 0;
+    _rx_len = 0;
     while (_fh->readable()) {
         unsigned char ch;
         _fh->read(&ch, 1);
@@ -96,12 +119,27 @@ int ATCmdParser::write(const char *data, int size)
 int ATCmdParser::read(char *data, int size)
 {
     int i = 0;
-    for (; i < size; i++) {
-        int c = getc();
-        if (c < 0) {
+    if (_rx_pos < _rx_len) {
+        i = _rx_len - _rx_pos < size ? _rx_len - _rx_pos : size;
+        memcpy(data, _rx_buffer + _rx_pos, i);
+        _rx_pos += i;
+    }
+
+    // Read the rest directly, so that nothing past the data is buffered
+    while (i < size) {
+        pollfh fhs;
+        fhs.fh = _fh;
+        fhs.events = POLLIN;
+
+        int count = poll(&fhs, 1, _timeout);
+        if (count <= 0 || !(fhs.revents & POLLIN)) {
+            return -1;
+        }
+        ssize_t len = _fh->read(data + i, size - i);
+        if (len <= 0) {
             return -1;
         }
-        data[i] = c;
+        i += len;
     }
     return i;
 }
@@ -195,6 +233,13 @@ restart:
         _buffer[offset++] = 'n';
         _buffer[offset++] = 0;
 
+        // Literal characters at the start of the response, a line can only
+        // match once it starts with them
+        int literal = 0;
+        while (literal < offset && _buffer[literal] != '%' && !isspace(static_cast<unsigned char>(_buffer[literal]))) {
+            literal++;
+        }
+
         debug_if(_dbg_on, "AT? %s\n", _buffer);
         // To workaround scanf's lack of error reporting, we actually
         // make two passes. One checks the validity with the modified
@@ -213,7 +258,7 @@ restart:
 
             // If just peeking for OOBs, and at start of line, check
             // readability
-            if (!response && j == 0 && !_fh->readable()) {
+            if (!response && j == 0 && !readable()) {
                 return -1;
             }
 
@@ -269,7 +314,9 @@ restart:
             if (whole_line_wanted && c != '\n') {
                 // Don't attempt scanning until we get delimiter if they included it in format
                 // This allows recv("Foo: %s\n") to work, and not match with just the first character of a string
-            } else if (response) {
+            } else if (!response || j < literal || memcmp(_buffer + offset, _buffer, literal) != 0) {
+                // Skip scanf until the line starts with the literal characters
+            } else {
                 sscanf(_buffer + offset, _buffer, &count);
             }
 
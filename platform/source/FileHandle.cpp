@@ -18,6 +18,39 @@
 
 namespace mbed {
 
+ssize_t FileHandle::readv(const struct iovec *iov, int iovcnt)
+{
+    ssize_t total = 0;
+    for (int i = 0; i < iovcnt; i++) {
+        ssize_t ret = read(iov[i].iov_base, iov[i].iov_len);
+        if (ret < 0) {
+            // Report what was already read, the error will come again
+            return total != 0 ? total : ret;
+        }
+        total += ret;
+        if ((size_t)ret < iov[i].iov_len) {
+            break;
+        }
+    }
+    return total;
+}
+
+ssize_t FileHandle::writev(const struct iovec *iov, int iovcnt)
+{
+    ssize_t total = 0;
+    for (int i = 0; i < iovcnt; i++) {
+        ssize_t ret = write(iov[i].iov_base, iov[i].iov_len);
+        if (ret < 0) {
+            return total != 0 ? total : ret;
+        }
+        total += ret;
+        if ((size_t)ret < iov[i].iov_len) {
+            break;
+        }
+    }
+    return total;
+}
+
 off_t FileHandle::size()
 {
     /* remember our current position */
@@ -0,0 +1,227 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <stdbool.h>
+#include <string.h>
+#include "platform/mbed_profiler.h"
+#include "platform/mbed_critical.h"
+#include "platform/mbed_toolchain.h"
+#include "device.h"
+#include "cmsis.h"
+#if DEVICE_ITM
+#include "hal/itm_api.h"
+#endif
+
+#define SAMPLING_MAGIC          0x3153504D  // "MPS1" in little endian
+#define SAMPLING_HEADER_WORDS   6
+
+static mbed_profile_scope_t *profile_scopes;
+
+static uint32_t *sampling_histogram;
+static size_t sampling_buckets;
+static uint32_t sampling_start;
+static uint32_t sampling_size;
+static uint32_t sampling_shift;
+static uint32_t sampling_samples;
+static uint32_t sampling_outside;
+static int sampling_irqn;
+static uint32_t sampling_vector;
+static bool sampling_running;
+
+uint32_t mbed_profile_cycles(void)
+{
+#if defined(DWT_CTRL_CYCCNTENA_Msk) && defined(CoreDebug_DEMCR_TRCENA_Msk)
+    if (!(DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk)) {
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    }
+    return DWT->CYCCNT;
+#else
+    return 0;
+#endif
+}
+
+void mbed_profile_scope_add(mbed_profile_scope_t *scope, uint32_t cycles)
+{
+    core_util_critical_section_enter();
+    if (!scope->registered) {
+        scope->registered = 1;
+        scope->next = profile_scopes;
+        profile_scopes = scope;
+    }
+    scope->count++;
+    scope->total_cycles += cycles;
+    if (cycles > scope->max_cycles) {
+        scope->max_cycles = cycles;
+    }
+    core_util_critical_section_exit();
+}
+
+const mbed_profile_scope_t *mbed_profile_scope_first(void)
+{
+    return profile_scopes;
+}
+
+/* Called by mbed_profiler_sample_irq with the EXC_RETURN value and the main
+ * stack pointer at exception entry. */
+MBED_USED void mbed_profiler_sample(uint32_t exc_return, uint32_t *msp)
+{
+    // Bit 2 of EXC_RETURN tells which stack holds the exception frame, whose
+    // 7th word is the interrupted PC
+    const uint32_t *frame = (exc_return & 4) ? (const uint32_t *)__get_PSP() : msp;
+    uint32_t offset = (frame[6] & ~1UL) - sampling_start;
+    uint32_t bucket = offset >> sampling_shift;
+
+    sampling_samples++;
+    if (offset < sampling_size && bucket < sampling_buckets) {
+        sampling_histogram[bucket]++;
+    } else {
+        sampling_outside++;
+    }
+
+    ((void (*)(void)) sampling_vector)();
+}
+
+#if defined(__GNUC__)
+/* Pass LR and SP as they were on exception entry, and tail call so that
+ * returning from mbed_profiler_sample() returns from the exception. */
+__attribute__((naked)) void mbed_profiler_sample_irq(void)
+{
+    __asm volatile(
+        "mov r0, lr         \n"
+        "mov r1, sp         \n"
+        "ldr r2, =mbed_profiler_sample \n"
+        "bx r2              \n"
+        ".ltorg             \n"
+    );
+}
+#else
+/* Without naked functions, the frame can only be found on the process
+ * stack, which RTOS threads run on. */
+void mbed_profiler_sample_irq(void)
+{
+#ifdef MBED_CONF_RTOS_PRESENT
+    if (SCB->ICSR & SCB_ICSR_RETTOBASE_Msk) {
+        mbed_profiler_sample(4, NULL);
+        return;
+    }
+#endif
+    sampling_samples++;
+    sampling_outside++;
+    ((void (*)(void)) sampling_vector)();
+}
+#endif
+
+int mbed_profiler_sampling_start(int irqn, uint32_t *histogram, size_t buckets)
+{
+#if defined(MBED_ROM_START) && defined(MBED_ROM_SIZE)
+    if (sampling_running || buckets == 0) {
+        return -1;
+    }
+
+    uint32_t shift = 0;
+    while (((MBED_ROM_SIZE - 1) >> shift) >= buckets) {
+        shift++;
+    }
+    memset(histogram, 0, buckets * sizeof(uint32_t));
+
+    core_util_critical_section_enter();
+    sampling_histogram = histogram;
+    sampling_buckets = buckets;
+    sampling_start = MBED_ROM_START;
+    sampling_size = MBED_ROM_SIZE;
+    sampling_shift = shift;
+    sampling_samples = 0;
+    sampling_outside = 0;
+    sampling_irqn = irqn;
+    sampling_vector = NVIC_GetVector((IRQn_Type) irqn);
+    NVIC_SetVector((IRQn_Type) irqn, (uint32_t) &mbed_profiler_sample_irq);
+    sampling_running = true;
+    core_util_critical_section_exit();
+    return 0;
+#else
+    return -1;
+#endif
+}
+
+void mbed_profiler_sampling_stop(void)
+{
+    core_util_critical_section_enter();
+    if (sampling_running) {
+        NVIC_SetVector((IRQn_Type) sampling_irqn, sampling_vector);
+        sampling_running = false;
+    }
+    core_util_critical_section_exit();
+}
+
+static uint8_t *sampling_put_word(uint8_t *buf, uint32_t value)
+{
+    buf[0] = (uint8_t)value;
+    buf[1] = (uint8_t)(value >> 8);
+    buf[2] = (uint8_t)(value >> 16);
+    buf[3] = (uint8_t)(value >> 24);
+    return buf + 4;
+}
+
+size_t mbed_profiler_sampling_snapshot(uint8_t *buf, size_t size)
+{
+    if (sampling_histogram == NULL) {
+        return 0;
+    }
+    size_t needed = 4 * (SAMPLING_HEADER_WORDS + sampling_buckets);
+    if (buf == NULL || size < needed) {
+        return buf == NULL ? needed : 0;
+    }
+
+    core_util_critical_section_enter();
+    buf = sampling_put_word(buf, SAMPLING_MAGIC);
+    buf = sampling_put_word(buf, sampling_start);
+    buf = sampling_put_word(buf, sampling_shift);
+    buf = sampling_put_word(buf, sampling_buckets);
+    buf = sampling_put_word(buf, sampling_samples);
+    buf = sampling_put_word(buf, sampling_outside);
+    core_util_critical_section_exit();
+    // Buckets are only incremented, a sample racing with the copy is harmless
+    for (size_t i = 0; i < sampling_buckets; i++) {
+        buf = sampling_put_word(buf, sampling_histogram[i]);
+    }
+
+    return needed;
+}
+
+void mbed_profiler_sampling_itm_send(uint32_t port)
+{
+#if DEVICE_ITM
+    if (sampling_histogram == NULL) {
+        return;
+    }
+    mbed_itm_init();
+
+    uint8_t header[4 * SAMPLING_HEADER_WORDS];
+    uint8_t *buf = header;
+    buf = sampling_put_word(buf, SAMPLING_MAGIC);
+    buf = sampling_put_word(buf, sampling_start);
+    buf = sampling_put_word(buf, sampling_shift);
+    buf = sampling_put_word(buf, sampling_buckets);
+    buf = sampling_put_word(buf, sampling_samples);
+    buf = sampling_put_word(buf, sampling_outside);
+    mbed_itm_send_block(port, header, sizeof(header));
+    // Cortex-M are little endian, so the counts go out as they are
+    mbed_itm_send_block(port, sampling_histogram, sampling_buckets * sizeof(uint32_t));
+#else
+    (void) port;
+#endif
+}
@@ -16,6 +16,7 @@
  */
 
 #include "platform/mbed_mem_trace.h"
+#include "platform/internal/mbed_heap_pool.h"
 #include "platform/mbed_stats.h"
 #include "platform/mbed_toolchain.h"
 #include "platform/SingletonPtr.h"
@@ -35,7 +36,12 @@
 
 Both tracers can be activated and deactivated in any combination. If both tracers
 are active, the second one (MBED_MEM_TRACING_ENABLED) will trace the first one's
-(MBED_HEAP_STATS_ENABLED) memory calls.*/
+(MBED_HEAP_STATS_ENABLED) memory calls.
+
+Setting MBED_CONF_PLATFORM_HEAP_POOL_SIZE to a non-zero size serves allocations
+of up to MBED_HEAP_POOL_MAX_BLOCK bytes from the size-class pools of
+mbed_heap_pool.h before falling back to the toolchain's malloc. Both tracers see
+the pool allocations like any other.*/
 
 /******************************************************************************/
 /* Implementation of the runtime max heap usage checker                       */
@@ -59,6 +65,11 @@ typedef struct mbed_heap_overhead  {
 
 static int get_malloc_block_total_size(void *ptr)
 {
+#if MBED_CONF_PLATFORM_HEAP_POOL_SIZE
+    if (mbed_heap_pool_owns(ptr)) {
+        return mbed_heap_pool_block_size(ptr);
+    }
+#endif
     mbed_heap_overhead_t *c = (mbed_heap_overhead_t *)((char *)ptr - offsetof(mbed_heap_overhead, next));
 
     // Skip the padding area
@@ -100,6 +111,65 @@ extern "C" {
     void free_wrapper(struct _reent *r, void *ptr, void *caller);
 }
 
+static void *backend_malloc(struct _reent *r, size_t size)
+{
+#if MBED_CONF_PLATFORM_HEAP_POOL_SIZE
+    void *ptr = mbed_heap_pool_alloc(size);
+    if (ptr != NULL) {
+        return ptr;
+    }
+#endif
+    return __real__malloc_r(r, size);
+}
+
+static void backend_free(struct _reent *r, void *ptr)
+{
+#if MBED_CONF_PLATFORM_HEAP_POOL_SIZE
+    if (mbed_heap_pool_owns(ptr)) {
+        mbed_heap_pool_free(ptr);
+        return;
+    }
+#endif
+    __real__free_r(r, ptr);
+}
+
+#if MBED_CONF_PLATFORM_HEAP_POOL_SIZE && !MBED_HEAP_STATS_ENABLED
+static void *backend_realloc(struct _reent *r, void *ptr, size_t size)
+{
+    if (!mbed_heap_pool_owns(ptr)) {
+        return ptr == NULL ? backend_malloc(r, size) : __real__realloc_r(r, ptr, size);
+    }
+    if (size == 0) {
+        mbed_heap_pool_free(ptr);
+        return NULL;
+    }
+
+    // A pool block only moves when the new size does not fit its class
+    size_t block_size = mbed_heap_pool_block_size(ptr);
+    if (size <= block_size) {
+        return ptr;
+    }
+    void *new_ptr = __real__malloc_r(r, size);
+    if (new_ptr != NULL) {
+        memcpy(new_ptr, ptr, block_size);
+        mbed_heap_pool_free(ptr);
+    }
+    return new_ptr;
+}
+
+static void *backend_calloc(struct _reent *r, size_t nmemb, size_t size)
+{
+    if (size != 0 && nmemb > SIZE_MAX / size) {
+        return NULL;
+    }
+    void *ptr = backend_malloc(r, nmemb * size);
+    if (ptr != NULL) {
+        memset(ptr, 0, nmemb * size);
+    }
+    return ptr;
+}
+#endif
+
 
 extern "C" void *__wrap__malloc_r(struct _reent *r, size_t size)
 {
@@ -116,7 +186,7 @@ extern "C" void *malloc_wrapper(struct _reent *r, size_t size, void *caller)
     malloc_stats_mutex->lock();
     alloc_info_t *alloc_info = NULL;
     if (size <= SIZE_MAX - sizeof(alloc_info_t)) {
-        alloc_info = (alloc_info_t *)__real__malloc_r(r, size + sizeof(alloc_info_t));
+        alloc_info = (alloc_info_t *)backend_malloc(r, size + sizeof(alloc_info_t));
     }
     if (alloc_info != NULL) {
         alloc_info->size = size;
@@ -134,7 +204,7 @@ extern "C" void *malloc_wrapper(struct _reent *r, size_t size, void *caller)
     }
     malloc_stats_mutex->unlock();
 #else // #if MBED_HEAP_STATS_ENABLED
-    ptr = __real__malloc_r(r, size);
+    ptr = backend_malloc(r, size);
 #endif // #if MBED_HEAP_STATS_ENABLED
 #if MBED_MEM_TRACING_ENABLED
     mbed_mem_trace_malloc(ptr, size, caller);
@@ -176,6 +246,8 @@ extern "C" void *__wrap__realloc_r(struct _reent *r, void *ptr, size_t size)
         memcpy(new_ptr, (void *)ptr, copy_size);
         free(ptr);
     }
+#elif MBED_CONF_PLATFORM_HEAP_POOL_SIZE
+    new_ptr = backend_realloc(r, ptr, size);
 #else // #if MBED_HEAP_STATS_ENABLED
     new_ptr = __real__realloc_r(r, ptr, size);
 #endif // #if MBED_HEAP_STATS_ENABLED
@@ -208,15 +280,15 @@ extern "C" void free_wrapper(struct _reent *r, void *ptr, void *caller)
             heap_stats.current_size -= user_size;
             heap_stats.alloc_cnt -= 1;
             heap_stats.overhead_size -= (alloc_size - user_size);
-            __real__free_r(r, (void *)alloc_info);
+            backend_free(r, (void *)alloc_info);
         } else {
-            __real__free_r(r, ptr);
+            backend_free(r, ptr);
         }
     }
 
     malloc_stats_mutex->unlock();
 #else // #if MBED_HEAP_STATS_ENABLED
-    __real__free_r(r, ptr);
+    backend_free(r, ptr);
 #endif // #if MBED_HEAP_STATS_ENABLED
 #if MBED_MEM_TRACING_ENABLED
     mbed_mem_trace_free(ptr, caller);
@@ -237,6 +309,8 @@ extern "C" void *__wrap__calloc_r(struct _reent *r, size_t nmemb, size_t size)
     if (ptr != NULL) {
         memset(ptr, 0, nmemb * size);
     }
+#elif MBED_CONF_PLATFORM_HEAP_POOL_SIZE
+    ptr = backend_calloc(r, nmemb, size);
 #else // #if MBED_HEAP_STATS_ENABLED
     ptr = __real__calloc_r(r, nmemb, size);
 #endif // #if MBED_HEAP_STATS_ENABLED
@@ -279,8 +353,8 @@ extern "C" void *__wrap__memalign_r(struct _reent *r, size_t alignment, size_t b
 #define SUB_FREE        $Sub$$__iar_dlfree
 #endif
 
-/* Enable hooking of memory function only if tracing is also enabled */
-#if defined(MBED_MEM_TRACING_ENABLED) || defined(MBED_HEAP_STATS_ENABLED)
+/* Enable hooking of memory function only if tracing, statistics or the pools are enabled */
+#if defined(MBED_MEM_TRACING_ENABLED) || defined(MBED_HEAP_STATS_ENABLED) || MBED_CONF_PLATFORM_HEAP_POOL_SIZE
 
 extern "C" {
     void *SUPER_MALLOC(size_t size);
@@ -291,6 +365,65 @@ extern "C" {
     void free_wrapper(void *ptr, void *caller);
 }
 
+static void *backend_malloc(size_t size)
+{
+#if MBED_CONF_PLATFORM_HEAP_POOL_SIZE
+    void *ptr = mbed_heap_pool_alloc(size);
+    if (ptr != NULL) {
+        return ptr;
+    }
+#endif
+    return SUPER_MALLOC(size);
+}
+
+static void backend_free(void *ptr)
+{
+#if MBED_CONF_PLATFORM_HEAP_POOL_SIZE
+    if (mbed_heap_pool_owns(ptr)) {
+        mbed_heap_pool_free(ptr);
+        return;
+    }
+#endif
+    SUPER_FREE(ptr);
+}
+
+#if MBED_CONF_PLATFORM_HEAP_POOL_SIZE && !MBED_HEAP_STATS_ENABLED
+static void *backend_realloc(void *ptr, size_t size)
+{
+    if (!mbed_heap_pool_owns(ptr)) {
+        return ptr == NULL ? backend_malloc(size) : SUPER_REALLOC(ptr, size);
+    }
+    if (size == 0) {
+        mbed_heap_pool_free(ptr);
+        return NULL;
+    }
+
+    // A pool block only moves when the new size does not fit its class
+    size_t block_size = mbed_heap_pool_block_size(ptr);
+    if (size <= block_size) {
+        return ptr;
+    }
+    void *new_ptr = SUPER_MALLOC(size);
+    if (new_ptr != NULL) {
+        memcpy(new_ptr, ptr, block_size);
+        mbed_heap_pool_free(ptr);
+    }
+    return new_ptr;
+}
+
+static void *backend_calloc(size_t nmemb, size_t size)
+{
+    if (size != 0 && nmemb > SIZE_MAX / size) {
+        return NULL;
+    }
+    void *ptr = backend_malloc(nmemb * size);
+    if (ptr != NULL) {
+        memset(ptr, 0, nmemb * size);
+    }
+    return ptr;
+}
+#endif
+
 extern "C" void *SUB_MALLOC(size_t size)
 {
     return malloc_wrapper(size, MBED_CALLER_ADDR());
@@ -306,7 +439,7 @@ extern "C" void *malloc_wrapper(size_t size, void *caller)
     malloc_stats_mutex->lock();
     alloc_info_t *alloc_info = NULL;
     if (size <= SIZE_MAX - sizeof(alloc_info_t)) {
-        alloc_info = (alloc_info_t *)SUPER_MALLOC(size + sizeof(alloc_info_t));
+        alloc_info = (alloc_info_t *)backend_malloc(size + sizeof(alloc_info_t));
     }
     if (alloc_info != NULL) {
         alloc_info->size = size;
@@ -324,7 +457,7 @@ extern "C" void *malloc_wrapper(size_t size, void *caller)
     }
     malloc_stats_mutex->unlock();
 #else // #if MBED_HEAP_STATS_ENABLED
-    ptr = SUPER_MALLOC(size);
+    ptr = backend_malloc(size);
 #endif // #if MBED_HEAP_STATS_ENABLED
 #if MBED_MEM_TRACING_ENABLED
     mbed_mem_trace_malloc(ptr, size, caller);
@@ -372,6 +505,8 @@ extern "C" void *SUB_REALLOC(void *ptr, size_t size)
             SUPER_REALLOC(NULL, 0);
         }
     }
+#elif MBED_CONF_PLATFORM_HEAP_POOL_SIZE
+    new_ptr = backend_realloc(ptr, size);
 #else // #if MBED_HEAP_STATS_ENABLED
     new_ptr = SUPER_REALLOC(ptr, size);
 #endif // #if MBED_HEAP_STATS_ENABLED
@@ -404,6 +539,8 @@ extern "C" void *SUB_CALLOC(size_t nmemb, size_t size)
             SUPER_CALLOC(NULL, 0);
         }
     }
+#elif MBED_CONF_PLATFORM_HEAP_POOL_SIZE
+    ptr = backend_calloc(nmemb, size);
 #else // #if MBED_HEAP_STATS_ENABLED
     ptr = SUPER_CALLOC(nmemb, size);
 #endif // #if MBED_HEAP_STATS_ENABLED
@@ -436,15 +573,15 @@ extern "C" void free_wrapper(void *ptr, void *caller)
             heap_stats.current_size -= user_size;
             heap_stats.alloc_cnt -= 1;
             heap_stats.overhead_size -= (alloc_size - user_size);
-            SUPER_FREE((void *)alloc_info);
+            backend_free((void *)alloc_info);
         } else {
-            SUPER_FREE(ptr);
+            backend_free(ptr);
         }
     }
 
     malloc_stats_mutex->unlock();
 #else // #if MBED_HEAP_STATS_ENABLED
-    SUPER_FREE(ptr);
+    backend_free(ptr);
 #endif // #if MBED_HEAP_STATS_ENABLED
 #if MBED_MEM_TRACING_ENABLED
     mbed_mem_trace_free(ptr, caller);
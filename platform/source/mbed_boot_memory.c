@@ -0,0 +1,101 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "platform/mbed_toolchain.h"
+#include "platform/internal/mbed_boot_memory.h"
+
+/* Store multiples of 4 registers are bursts on the AHB, where single stores
+ * each take a bus transaction. The loops are in assembly so the compiler
+ * cannot turn them back into memcpy() or memset(), which are byte loops in
+ * the size optimized C libraries.
+ */
+MBED_WEAK void mbed_boot_copy_memory(uint32_t *dest, const uint32_t *src, uint32_t size)
+{
+    uint32_t blocks = size / 32;
+
+#if defined(__GNUC__) && defined(__arm__)
+    if (blocks) {
+        __asm volatile(
+            "1:\n\t"
+            "ldmia  %1!, {r3-r6}\n\t"
+            "stmia  %0!, {r3-r6}\n\t"
+            "ldmia  %1!, {r3-r6}\n\t"
+            "stmia  %0!, {r3-r6}\n\t"
+            "subs   %2, %2, #1\n\t"
+            "bne    1b"
+            : "+l"(dest), "+l"(src), "+l"(blocks)
+            :
+            : "r3", "r4", "r5", "r6", "cc", "memory");
+    }
+#else
+    for (; blocks; blocks--) {
+        dest[0] = src[0];
+        dest[1] = src[1];
+        dest[2] = src[2];
+        dest[3] = src[3];
+        dest[4] = src[4];
+        dest[5] = src[5];
+        dest[6] = src[6];
+        dest[7] = src[7];
+        dest += 8;
+        src += 8;
+    }
+#endif
+
+    for (size = (size % 32) / 4; size; size--) {
+        *dest++ = *src++;
+    }
+}
+
+MBED_WEAK void mbed_boot_zero_memory(uint32_t *dest, uint32_t size)
+{
+    uint32_t blocks = size / 32;
+
+#if defined(__GNUC__) && defined(__arm__)
+    if (blocks) {
+        __asm volatile(
+            "movs   r3, #0\n\t"
+            "movs   r4, #0\n\t"
+            "movs   r5, #0\n\t"
+            "movs   r6, #0\n\t"
+            "1:\n\t"
+            "stmia  %0!, {r3-r6}\n\t"
+            "stmia  %0!, {r3-r6}\n\t"
+            "subs   %1, %1, #1\n\t"
+            "bne    1b"
+            : "+l"(dest), "+l"(blocks)
+            :
+            : "r3", "r4", "r5", "r6", "cc", "memory");
+    }
+#else
+    for (; blocks; blocks--) {
+        dest[0] = 0;
+        dest[1] = 0;
+        dest[2] = 0;
+        dest[3] = 0;
+        dest[4] = 0;
+        dest[5] = 0;
+        dest[6] = 0;
+        dest[7] = 0;
+        dest += 8;
+    }
+#endif
+
+    for (size = (size % 32) / 4; size; size--) {
+        *dest++ = 0;
+    }
+}
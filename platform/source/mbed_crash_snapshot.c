@@ -0,0 +1,288 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <stdbool.h>
+#include <string.h>
+#include "device.h"
+#include "platform/mbed_crash_snapshot.h"
+#include "platform/mbed_mem_trace.h"
+#include "platform/internal/mbed_fault_handler.h"
+#include "drivers/MbedCRC.h"
+#include "mbed_rtx.h"
+#ifdef MBED_CONF_RTOS_PRESENT
+#include "rtx_os.h"
+#endif
+#if MBED_CONF_MBED_TRACE_ENABLE
+#include "mbed-trace/mbed_trace.h"
+#endif
+
+#if MBED_CRASH_SNAPSHOT_ENABLED
+
+#define SNAPSHOT_MAGIC          0x3153434D  // "MCS1" in little endian
+#define SNAPSHOT_HEADER_WORDS   5
+#define SNAPSHOT_FLAG_TRUNCATED 1
+#define SNAPSHOT_WORDS          (MBED_CONF_PLATFORM_CRASH_SNAPSHOT_RAM_SIZE / 4)
+#define SNAPSHOT_RUN            0x80000000UL
+#define SNAPSHOT_MIN_RUN        3
+
+static uint32_t *const snapshot = (uint32_t *) MBED_CONF_PLATFORM_CRASH_SNAPSHOT_RAM_START;
+
+/* Position in words of the end of the snapshot, which may run past the RAM
+ * region while a record is written: the record is then dropped. */
+static uint32_t snapshot_pos;
+static uint32_t snapshot_records;
+static uint32_t snapshot_flags;
+static uint32_t record_start;
+
+static void record_begin(void)
+{
+    record_start = snapshot_pos++;
+}
+
+static void record_put(uint32_t word)
+{
+    if (snapshot_pos < SNAPSHOT_WORDS) {
+        snapshot[snapshot_pos] = word;
+    }
+    snapshot_pos++;
+}
+
+static void record_put_bytes(const void *data, size_t size)
+{
+    const uint8_t *bytes = (const uint8_t *) data;
+    for (size_t i = 0; i < size; i += 4) {
+        uint32_t word = 0;
+        memcpy(&word, bytes + i, size - i < 4 ? size - i : 4);
+        record_put(word);
+    }
+}
+
+static void record_cancel(void)
+{
+    snapshot_pos = record_start;
+}
+
+static void record_end(mbed_crash_snapshot_record_t type, uint32_t length)
+{
+    if (snapshot_pos > SNAPSHOT_WORDS) {
+        record_cancel();
+        snapshot_flags |= SNAPSHOT_FLAG_TRUNCATED;
+        return;
+    }
+    snapshot[record_start] = ((uint32_t) type << 24) | length;
+    snapshot_records++;
+}
+
+static uint32_t record_length(void)
+{
+    return 4 * (snapshot_pos - record_start - 1);
+}
+
+/* Stacks hold long runs of zeros and of the same pointers, so each run of
+ * SNAPSHOT_MIN_RUN words or more is stored as a count and the word. */
+static void record_stack(uint32_t thread_id, uint32_t stack_start, uint32_t stack_size, uint32_t sp)
+{
+    uint32_t stack_end = (stack_start + stack_size) & ~3UL;
+    record_begin();
+    record_put(thread_id);
+    record_put(stack_start);
+    record_put(stack_size);
+    record_put(sp);
+
+    // A stack pointer out of the stack is recorded, and the stack dumped whole or not at all
+    sp = sp < stack_start ? stack_start : sp > stack_end ? stack_end : sp;
+    const uint32_t *p = (const uint32_t *)((sp + 3) & ~3UL);
+    const uint32_t *end = (const uint32_t *) stack_end;
+    while (p < end && snapshot_pos <= SNAPSHOT_WORDS) {
+        const uint32_t *run = p + 1;
+        while (run < end && *run == *p) {
+            run++;
+        }
+        if (run - p >= SNAPSHOT_MIN_RUN) {
+            record_put(SNAPSHOT_RUN | (uint32_t)(run - p));
+            record_put(*p);
+            p = run;
+            continue;
+        }
+        const uint32_t *literal = p;
+        while (p < end && !(end - p >= SNAPSHOT_MIN_RUN && p[0] == p[1] && p[1] == p[2])) {
+            p++;
+        }
+        record_put((uint32_t)(p - literal));
+        while (literal < p) {
+            record_put(*literal++);
+        }
+    }
+    record_end(MBED_CRASH_SNAPSHOT_STACK, record_length());
+}
+
+static void record_error(const mbed_error_ctx *error_ctx, const mbed_fault_context_t *mfc)
+{
+    record_begin();
+    record_put_bytes(error_ctx, sizeof(*error_ctx));
+    record_end(MBED_CRASH_SNAPSHOT_ERROR, sizeof(*error_ctx));
+
+    if (mfc) {
+        record_begin();
+        record_put_bytes(mfc, sizeof(*mfc));
+        record_end(MBED_CRASH_SNAPSHOT_FAULT, sizeof(*mfc));
+    }
+}
+
+static void record_heap(void)
+{
+    // The trace lock cannot be taken from a fatal error, which may be in an interrupt
+    record_begin();
+    if (snapshot_pos < SNAPSHOT_WORDS) {
+        size_t length = mbed_mem_trace_profile_snapshot_unlocked((uint8_t *) &snapshot[snapshot_pos],
+                                                                 4 * (SNAPSHOT_WORDS - snapshot_pos));
+        snapshot_pos += length / 4;
+        if (length == 0) {
+            snapshot_pos = SNAPSHOT_WORDS + 1;
+        }
+    }
+    record_end(MBED_CRASH_SNAPSHOT_HEAP, record_length());
+}
+
+static void record_traces(void)
+{
+#if MBED_CONF_MBED_TRACE_ENABLE
+    // Nothing runs after a fatal error, so the trace mutex is dropped rather than waited on
+    mbed_trace_mutex_wait_function_set(NULL);
+    mbed_trace_mutex_release_function_set(NULL);
+
+    const char *line = mbed_trace_last();
+    if (line && line[0] != '\0') {
+        size_t length = strlen(line);
+        record_begin();
+        record_put_bytes(line, length);
+        record_end(MBED_CRASH_SNAPSHOT_TRACE_LINE, length);
+    }
+
+    record_begin();
+    if (snapshot_pos < SNAPSHOT_WORDS) {
+        snapshot_pos += mbed_trace_deferred_read(&snapshot[snapshot_pos], 4 * (SNAPSHOT_WORDS - snapshot_pos)) / 4;
+    }
+    if (record_length() == 0) {
+        record_cancel();
+    } else {
+        record_end(MBED_CRASH_SNAPSHOT_TRACE, record_length());
+    }
+#endif
+}
+
+#ifdef MBED_CONF_RTOS_PRESENT
+static void record_threads(const osRtxThread_t *thread, const osRtxThread_t *current, bool delay_list)
+{
+    while (thread != NULL) {
+        if (thread != current) {
+            record_stack((uint32_t) thread, (uint32_t) thread->stack_mem, thread->stack_size, thread->sp);
+        }
+        // Ready threads are linked through thread_next, waiting and delayed ones through delay_next
+        thread = delay_list ? thread->delay_next : thread->thread_next;
+    }
+}
+#endif
+
+void mbed_crash_snapshot_capture(const mbed_error_ctx *error_ctx)
+{
+    const mbed_fault_context_t *mfc = NULL;
+    uint32_t thread_sp = error_ctx->thread_current_sp;
+    uint32_t handler_sp = 0;
+
+    if (error_ctx->error_status == MBED_ERROR_MEMMANAGE_EXCEPTION ||
+            error_ctx->error_status == MBED_ERROR_BUSFAULT_EXCEPTION ||
+            error_ctx->error_status == MBED_ERROR_USAGEFAULT_EXCEPTION ||
+            error_ctx->error_status == MBED_ERROR_HARDFAULT_EXCEPTION) {
+        mfc = (const mbed_fault_context_t *) error_ctx->error_value;
+#ifdef TARGET_CORTEX_M
+        // A fault in handler mode runs on the main stack, and the thread stack is as it was interrupted
+        if (!(mfc->EXC_RETURN & 0x8)) {
+            handler_sp = mfc->SP_reg;
+            thread_sp = mfc->PSP;
+        }
+#endif
+    }
+
+    snapshot_pos = SNAPSHOT_HEADER_WORDS;
+    snapshot_records = 0;
+    snapshot_flags = 0;
+
+    // Most useful first, in case the region is too small for everything
+    record_error(error_ctx, mfc);
+#ifdef MBED_CONF_RTOS_PRESENT
+    record_stack(error_ctx->thread_id, error_ctx->thread_stack_mem, error_ctx->thread_stack_size, thread_sp);
+#ifdef INITIAL_SP
+    if (handler_sp != 0) {
+        record_stack(0, handler_sp, (uint32_t) INITIAL_SP - handler_sp, handler_sp);
+    }
+#endif
+#elif defined(INITIAL_SP)
+    // Without RTOS, everything runs on the main stack
+    (void) handler_sp;
+    record_stack(0, thread_sp, (uint32_t) INITIAL_SP - thread_sp, thread_sp);
+#endif
+    record_heap();
+    record_traces();
+#ifdef MBED_CONF_RTOS_PRESENT
+    const osRtxThread_t *current = (const osRtxThread_t *) error_ctx->thread_id;
+    record_threads(osRtxInfo.thread.ready.thread_list, current, false);
+    record_threads(osRtxInfo.thread.delay_list, current, true);
+    record_threads(osRtxInfo.thread.wait_list, current, true);
+#endif
+
+    snapshot[0] = SNAPSHOT_MAGIC;
+    snapshot[1] = 4 * snapshot_pos;
+    snapshot[2] = mbed_tiny_compute_crc32(&snapshot[SNAPSHOT_HEADER_WORDS], 4 * (snapshot_pos - SNAPSHOT_HEADER_WORDS));
+    snapshot[3] = snapshot_records;
+    snapshot[4] = snapshot_flags;
+}
+
+const void *mbed_crash_snapshot_get(size_t *size)
+{
+    uint32_t length = snapshot[1];
+    if (snapshot[0] != SNAPSHOT_MAGIC || length < 4 * SNAPSHOT_HEADER_WORDS ||
+            length > 4 * SNAPSHOT_WORDS || (length & 3) ||
+            snapshot[2] != mbed_tiny_compute_crc32(&snapshot[SNAPSHOT_HEADER_WORDS], length - 4 * SNAPSHOT_HEADER_WORDS)) {
+        return NULL;
+    }
+    *size = length;
+    return snapshot;
+}
+
+void mbed_crash_snapshot_clear(void)
+{
+    snapshot[0] = 0;
+}
+
+#else
+
+void mbed_crash_snapshot_capture(const mbed_error_ctx *error_ctx)
+{
+    (void) error_ctx;
+}
+
+const void *mbed_crash_snapshot_get(size_t *size)
+{
+    (void) size;
+    return NULL;
+}
+
+void mbed_crash_snapshot_clear(void)
+{
+}
+
+#endif // MBED_CRASH_SNAPSHOT_ENABLED
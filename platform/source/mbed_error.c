@@ -21,6 +21,7 @@
 #include "platform/source/mbed_crash_data_offsets.h"
 #include "platform/mbed_atomic.h"
 #include "platform/mbed_critical.h"
+#include "platform/mbed_crash_snapshot.h"
 #include "platform/mbed_error.h"
 #include "platform/mbed_interface.h"
 #include "platform/mbed_power_mgmt.h"
@@ -298,6 +299,11 @@ WEAK MBED_NORETURN mbed_error_status_t mbed_error(mbed_error_status_t error_stat
         //set the error reported
         (void) handle_error(error_status, error_value, filename, line_number, MBED_CALLER_ADDR());
 
+#if MBED_CRASH_SNAPSHOT_ENABLED
+        //Capture the snapshot before printing, which may fault again
+        mbed_crash_snapshot_capture(&last_error_ctx);
+#endif
+
         //On fatal errors print the error context/report
         ERROR_REPORT(&last_error_ctx, error_msg, filename, line_number);
     }
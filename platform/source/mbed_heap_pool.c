@@ -0,0 +1,116 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <stdint.h>
+#include "platform/internal/mbed_heap_pool.h"
+#include "platform/mbed_assert.h"
+#include "platform/mbed_critical.h"
+#include "platform/mbed_toolchain.h"
+
+#if MBED_CONF_PLATFORM_HEAP_POOL_SIZE
+
+#define SLAB_SIZE       MBED_CONF_PLATFORM_HEAP_POOL_SLAB_SIZE
+#define SLAB_COUNT      (MBED_CONF_PLATFORM_HEAP_POOL_SIZE / SLAB_SIZE)
+#define CLASS_COUNT     5   // 16, 32, 64, 128 and 256 bytes
+
+MBED_STATIC_ASSERT(MBED_HEAP_POOL_MIN_BLOCK << (CLASS_COUNT - 1) == MBED_HEAP_POOL_MAX_BLOCK,
+                   "Size classes must end at MBED_HEAP_POOL_MAX_BLOCK");
+MBED_STATIC_ASSERT(SLAB_SIZE % MBED_HEAP_POOL_MAX_BLOCK == 0,
+                   "Heap pool slab size must be a multiple of MBED_HEAP_POOL_MAX_BLOCK");
+MBED_STATIC_ASSERT(SLAB_COUNT > 0 && SLAB_COUNT <= UINT16_MAX,
+                   "Heap pool size must hold between one and 65535 slabs");
+
+typedef struct free_block {
+    struct free_block *next;
+} free_block_t;
+
+typedef struct {
+    free_block_t *free_list;    // Blocks returned by mbed_heap_pool_free
+    uint8_t *carve;             // Next block never handed out in the current slab
+    uint8_t *carve_end;         // End of the current slab
+} size_class_t;
+
+MBED_ALIGN(8) static uint8_t pool[SLAB_COUNT * SLAB_SIZE];
+static uint8_t slab_class[SLAB_COUNT];
+static size_class_t classes[CLASS_COUNT];
+static uint16_t slabs_used;
+
+static unsigned size_to_class(size_t size)
+{
+    unsigned c = 0;
+    while ((size_t)(MBED_HEAP_POOL_MIN_BLOCK << c) < size) {
+        c++;
+    }
+    return c;
+}
+
+void *mbed_heap_pool_alloc(size_t size)
+{
+    if (size > MBED_HEAP_POOL_MAX_BLOCK) {
+        return NULL;
+    }
+
+    unsigned c = size_to_class(size);
+    size_class_t *sc = &classes[c];
+    size_t block_size = MBED_HEAP_POOL_MIN_BLOCK << c;
+    void *ptr = NULL;
+
+    core_util_critical_section_enter();
+    if (sc->free_list != NULL) {
+        ptr = sc->free_list;
+        sc->free_list = sc->free_list->next;
+    } else {
+        if (sc->carve == sc->carve_end && slabs_used < SLAB_COUNT) {
+            // Blocks are carved from a fresh slab as they are needed
+            slab_class[slabs_used] = c;
+            sc->carve = &pool[slabs_used * SLAB_SIZE];
+            sc->carve_end = sc->carve + SLAB_SIZE;
+            slabs_used++;
+        }
+        if (sc->carve != sc->carve_end) {
+            ptr = sc->carve;
+            sc->carve += block_size;
+        }
+    }
+    core_util_critical_section_exit();
+
+    return ptr;
+}
+
+void mbed_heap_pool_free(void *ptr)
+{
+    MBED_ASSERT(mbed_heap_pool_owns(ptr));
+    size_class_t *sc = &classes[slab_class[((uint8_t *)ptr - pool) / SLAB_SIZE]];
+    free_block_t *block = (free_block_t *)ptr;
+
+    core_util_critical_section_enter();
+    block->next = sc->free_list;
+    sc->free_list = block;
+    core_util_critical_section_exit();
+}
+
+bool mbed_heap_pool_owns(const void *ptr)
+{
+    return (const uint8_t *)ptr >= pool && (const uint8_t *)ptr < pool + sizeof(pool);
+}
+
+size_t mbed_heap_pool_block_size(const void *ptr)
+{
+    MBED_ASSERT(mbed_heap_pool_owns(ptr));
+    return MBED_HEAP_POOL_MIN_BLOCK << slab_class[((const uint8_t *)ptr - pool) / SLAB_SIZE];
+}
+
+#endif
@@ -0,0 +1,300 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <stdarg.h>
+#include <string.h>
+#include "platform/mbed_mem_trace.h"
+#include "platform/mbed_assert.h"
+#include "device.h"
+#if DEVICE_USTICKER
+#include "hal/us_ticker_api.h"
+#endif
+
+/******************************************************************************
+ * Internal variables, functions and helpers
+ *****************************************************************************/
+
+#define PROFILE_MAGIC       0x3150544D  // "MTP1" in little endian
+#define PROFILE_TOMBSTONE   ((void *)1)
+#define PROFILE_HEADER_WORDS    5
+#define PROFILE_SITE_WORDS      (8 + MBED_MEM_TRACE_PROFILE_SIZE_CLASSES)
+
+typedef struct {
+    mbed_mem_trace_site_t site;
+    uint64_t lifetime_total_us;
+} profile_site_t;
+
+typedef struct {
+    void *ptr;                  // NULL for a free entry, PROFILE_TOMBSTONE for a freed one
+    uint32_t size;
+    uint32_t timestamp;
+    uint16_t site;
+} profile_live_t;
+
+/* Both tables are hash tables with linear probing. They are only accessed from
+ * the callback or with the trace lock held, so the trace mutex protects them. */
+static profile_site_t profile_sites[MBED_MEM_TRACE_PROFILE_SITES];
+static profile_live_t profile_live[MBED_MEM_TRACE_PROFILE_LIVE];
+static uint32_t profile_site_cnt;
+static uint32_t profile_untracked_alloc_cnt;
+static uint32_t profile_untracked_free_cnt;
+
+static uint32_t profile_now()
+{
+#if DEVICE_USTICKER
+    return us_ticker_read();
+#else
+    return 0;
+#endif
+}
+
+static uint32_t profile_hash(void *ptr, uint32_t size)
+{
+    uintptr_t value = (uintptr_t)ptr;
+    return (uint32_t)((value >> 3) ^ (value >> 11)) % size;
+}
+
+static profile_site_t *profile_site_get(void *caller)
+{
+    uint32_t index = profile_hash(caller, MBED_MEM_TRACE_PROFILE_SITES);
+    for (uint32_t i = 0; i < MBED_MEM_TRACE_PROFILE_SITES; i++) {
+        profile_site_t *entry = &profile_sites[index];
+        if (entry->site.alloc_cnt == 0) {
+            entry->site.caller = caller;
+            profile_site_cnt++;
+            return entry;
+        }
+        if (entry->site.caller == caller) {
+            return entry;
+        }
+        index = (index + 1) % MBED_MEM_TRACE_PROFILE_SITES;
+    }
+    return NULL;
+}
+
+static profile_live_t *profile_live_find(void *ptr)
+{
+    uint32_t index = profile_hash(ptr, MBED_MEM_TRACE_PROFILE_LIVE);
+    for (uint32_t i = 0; i < MBED_MEM_TRACE_PROFILE_LIVE; i++) {
+        profile_live_t *entry = &profile_live[index];
+        if (entry->ptr == ptr) {
+            return entry;
+        }
+        if (entry->ptr == NULL) {
+            break;
+        }
+        index = (index + 1) % MBED_MEM_TRACE_PROFILE_LIVE;
+    }
+    return NULL;
+}
+
+static profile_live_t *profile_live_insert(void *ptr)
+{
+    uint32_t index = profile_hash(ptr, MBED_MEM_TRACE_PROFILE_LIVE);
+    for (uint32_t i = 0; i < MBED_MEM_TRACE_PROFILE_LIVE; i++) {
+        profile_live_t *entry = &profile_live[index];
+        if (entry->ptr == NULL || entry->ptr == PROFILE_TOMBSTONE) {
+            return entry;
+        }
+        index = (index + 1) % MBED_MEM_TRACE_PROFILE_LIVE;
+    }
+    return NULL;
+}
+
+static void profile_alloc(void *res, size_t size, void *caller)
+{
+    if (res == NULL) {
+        return;
+    }
+
+    profile_live_t *live = profile_live_insert(res);
+    profile_site_t *entry = live ? profile_site_get(caller) : NULL;
+    if (entry == NULL) {
+        profile_untracked_alloc_cnt++;
+        return;
+    }
+
+    mbed_mem_trace_site_t *site = &entry->site;
+    uint32_t size_class = 0;
+    while (size_class < MBED_MEM_TRACE_PROFILE_SIZE_CLASSES - 1 && size > (16u << size_class)) {
+        size_class++;
+    }
+    site->alloc_cnt++;
+    site->size_cnt[size_class]++;
+    site->total_size += size;
+    site->current_size += size;
+    if (site->current_size > site->max_size) {
+        site->max_size = site->current_size;
+    }
+
+    live->ptr = res;
+    live->size = size;
+    live->timestamp = profile_now();
+    live->site = entry - profile_sites;
+}
+
+static void profile_free(void *ptr)
+{
+    if (ptr == NULL) {
+        return;
+    }
+
+    profile_live_t *live = profile_live_find(ptr);
+    if (live == NULL) {
+        profile_untracked_free_cnt++;
+        return;
+    }
+
+    profile_site_t *entry = &profile_sites[live->site];
+    uint32_t lifetime = profile_now() - live->timestamp;
+    entry->site.free_cnt++;
+    entry->site.current_size -= live->size;
+    entry->lifetime_total_us += lifetime;
+    if (lifetime > entry->site.lifetime_max_us) {
+        entry->site.lifetime_max_us = lifetime;
+    }
+    live->ptr = PROFILE_TOMBSTONE;
+}
+
+static void profile_copy_site(mbed_mem_trace_site_t *dst, const profile_site_t *src)
+{
+    *dst = src->site;
+    if (src->site.free_cnt) {
+        dst->lifetime_avg_us = (uint32_t)(src->lifetime_total_us / src->site.free_cnt);
+    }
+}
+
+static uint8_t *profile_put_word(uint8_t *buf, uint32_t value)
+{
+    buf[0] = (uint8_t)value;
+    buf[1] = (uint8_t)(value >> 8);
+    buf[2] = (uint8_t)(value >> 16);
+    buf[3] = (uint8_t)(value >> 24);
+    return buf + 4;
+}
+
+/******************************************************************************
+ * Public interface
+ *****************************************************************************/
+
+void mbed_mem_trace_profile_callback(uint8_t op, void *res, void *caller, ...)
+{
+    va_list va;
+    size_t temp_s1, temp_s2;
+    void *temp_ptr;
+
+    va_start(va, caller);
+    switch (op) {
+        case MBED_MEM_TRACE_MALLOC:
+            temp_s1 = va_arg(va, size_t);
+            profile_alloc(res, temp_s1, caller);
+            break;
+
+        case MBED_MEM_TRACE_REALLOC:
+            temp_ptr = va_arg(va, void *);
+            temp_s1 = va_arg(va, size_t);
+            // A failed realloc leaves the old allocation in place
+            if (res != NULL || temp_s1 == 0) {
+                profile_free(temp_ptr);
+                profile_alloc(res, temp_s1, caller);
+            }
+            break;
+
+        case MBED_MEM_TRACE_CALLOC:
+            temp_s1 = va_arg(va, size_t);
+            temp_s2 = va_arg(va, size_t);
+            profile_alloc(res, temp_s1 * temp_s2, caller);
+            break;
+
+        case MBED_MEM_TRACE_FREE:
+            temp_ptr = va_arg(va, void *);
+            profile_free(temp_ptr);
+            break;
+
+        default:
+            break;
+    }
+    va_end(va);
+}
+
+size_t mbed_mem_trace_profile_get(mbed_mem_trace_site_t *sites, size_t count)
+{
+    MBED_ASSERT(sites != NULL);
+    size_t filled = 0;
+
+    mbed_mem_trace_lock();
+    for (uint32_t i = 0; i < MBED_MEM_TRACE_PROFILE_SITES && filled < count; i++) {
+        if (profile_sites[i].site.alloc_cnt) {
+            profile_copy_site(&sites[filled++], &profile_sites[i]);
+        }
+    }
+    mbed_mem_trace_unlock();
+
+    return filled;
+}
+
+size_t mbed_mem_trace_profile_snapshot(uint8_t *buf, size_t size)
+{
+    mbed_mem_trace_lock();
+    size_t written = mbed_mem_trace_profile_snapshot_unlocked(buf, size);
+    mbed_mem_trace_unlock();
+    return written;
+}
+
+size_t mbed_mem_trace_profile_snapshot_unlocked(uint8_t *buf, size_t size)
+{
+    size_t needed = 4 * (PROFILE_HEADER_WORDS + PROFILE_SITE_WORDS * profile_site_cnt);
+    if (buf == NULL || size < needed) {
+        return buf == NULL ? needed : 0;
+    }
+
+    buf = profile_put_word(buf, PROFILE_MAGIC);
+    buf = profile_put_word(buf, profile_site_cnt);
+    buf = profile_put_word(buf, MBED_MEM_TRACE_PROFILE_SIZE_CLASSES);
+    buf = profile_put_word(buf, profile_untracked_alloc_cnt);
+    buf = profile_put_word(buf, profile_untracked_free_cnt);
+    for (uint32_t i = 0; i < MBED_MEM_TRACE_PROFILE_SITES; i++) {
+        if (profile_sites[i].site.alloc_cnt == 0) {
+            continue;
+        }
+        mbed_mem_trace_site_t site;
+        profile_copy_site(&site, &profile_sites[i]);
+        buf = profile_put_word(buf, (uint32_t)(uintptr_t)site.caller);
+        buf = profile_put_word(buf, site.alloc_cnt);
+        buf = profile_put_word(buf, site.free_cnt);
+        buf = profile_put_word(buf, site.current_size);
+        buf = profile_put_word(buf, site.max_size);
+        buf = profile_put_word(buf, site.total_size);
+        buf = profile_put_word(buf, site.lifetime_avg_us);
+        buf = profile_put_word(buf, site.lifetime_max_us);
+        for (uint32_t j = 0; j < MBED_MEM_TRACE_PROFILE_SIZE_CLASSES; j++) {
+            buf = profile_put_word(buf, site.size_cnt[j]);
+        }
+    }
+
+    return needed;
+}
+
+void mbed_mem_trace_profile_reset(void)
+{
+    mbed_mem_trace_lock();
+    memset(profile_sites, 0, sizeof(profile_sites));
+    memset(profile_live, 0, sizeof(profile_live));
+    profile_site_cnt = 0;
+    profile_untracked_alloc_cnt = 0;
+    profile_untracked_free_cnt = 0;
+    mbed_mem_trace_unlock();
+}
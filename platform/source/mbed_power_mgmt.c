@@ -17,6 +17,7 @@
 
 #include "platform/mbed_power_mgmt.h"
 #include "platform/mbed_interface.h"
+#include "platform/mbed_assert.h"
 #include "platform/mbed_atomic.h"
 #include "platform/mbed_critical.h"
 #include "platform/mbed_error.h"
@@ -28,21 +29,42 @@
 #include "platform/mbed_wait_api.h"
 
 #include <stdio.h>
+#include <string.h>
+
+#if defined(MBED_SLEEP_STATS_ENABLED) && DEVICE_SLEEP
+#include "cmsis.h"
+#endif
 
 #if DEVICE_SLEEP
 
+#if (defined(MBED_CPU_STATS_ENABLED) || defined(MBED_SLEEP_STATS_ENABLED)) && DEVICE_LPTICKER
+#define SLEEP_TIMING_ENABLED 1
+#endif
+
 // deep sleep locking counter. A target is allowed to deep sleep if counter == 0
 static uint16_t deep_sleep_lock = 0U;
 #if defined(MBED_CPU_STATS_ENABLED) && DEVICE_LPTICKER
 static us_timestamp_t sleep_time = 0;
 static us_timestamp_t deep_sleep_time = 0;
+#endif
 
+#if SLEEP_TIMING_ENABLED
 static const ticker_data_t *sleep_ticker = NULL;
 #endif
 
+#ifdef MBED_SLEEP_STATS_ENABLED
+static uint32_t sleep_cnt = 0;
+static uint32_t deep_sleep_cnt = 0;
+static uint32_t blocked_cnt = 0;
+static uint32_t sleep_histogram[MBED_SLEEP_HISTOGRAM_BUCKETS];
+static uint32_t deep_sleep_histogram[MBED_SLEEP_HISTOGRAM_BUCKETS];
+static mbed_stats_wakeup_t wakeups[MBED_MAX_WAKEUP_SOURCES];
+static uint32_t wakeup_unknown_cnt = 0;
+#endif
+
 static inline us_timestamp_t read_us(void)
 {
-#if defined(MBED_CPU_STATS_ENABLED) && DEVICE_LPTICKER
+#if SLEEP_TIMING_ENABLED
     if (NULL == sleep_ticker) {
         sleep_ticker = get_lp_ticker_data();
     }
@@ -84,17 +106,21 @@ us_timestamp_t mbed_time_deepsleep(void)
 #endif
 }
 
-#ifdef MBED_SLEEP_TRACING_ENABLED
+#if defined(MBED_SLEEP_TRACING_ENABLED) || defined(MBED_SLEEP_STATS_ENABLED)
 
 // Length of the identifier extracted from the driver name to store for logging.
-#define IDENTIFIER_WIDTH 15
+#define IDENTIFIER_WIDTH MBED_SLEEP_LOCK_ID_WIDTH
 
 // Number of drivers that can be stored in the structure
-#define STATISTIC_COUNT  10
+#define STATISTIC_COUNT  MBED_MAX_SLEEP_LOCKS
 
 typedef struct sleep_statistic {
     char identifier[IDENTIFIER_WIDTH];
     uint8_t count;
+#ifdef MBED_SLEEP_STATS_ENABLED
+    uint32_t blocked_count;
+    us_timestamp_t blocked_time;
+#endif
 } sleep_statistic_t;
 
 static sleep_statistic_t sleep_stats[STATISTIC_COUNT];
@@ -136,6 +162,7 @@ static sleep_statistic_t *sleep_tracker_add(const char *const filename)
     return NULL;
 }
 
+#ifdef MBED_SLEEP_TRACING_ENABLED
 static void sleep_tracker_print_stats(void)
 {
     mbed_error_printf("Sleep locks held:\r\n");
@@ -152,9 +179,12 @@ static void sleep_tracker_print_stats(void)
                           sleep_stats[i].count);
     }
 }
+#endif
 
 void sleep_tracker_lock(const char *const filename, int line)
 {
+    // Locks may be taken from interrupts, so find or add the entry in one go
+    core_util_critical_section_enter();
     sleep_statistic_t *stat = sleep_tracker_find(filename);
 
     // Entry for this driver does not exist, create one.
@@ -162,9 +192,14 @@ void sleep_tracker_lock(const char *const filename, int line)
         stat = sleep_tracker_add(filename);
     }
 
-    core_util_atomic_incr_u8(&stat->count, 1);
+    if (stat != NULL) {
+        core_util_atomic_incr_u8(&stat->count, 1);
+    }
+    core_util_critical_section_exit();
 
+#ifdef MBED_SLEEP_TRACING_ENABLED
     mbed_error_printf("LOCK: %s, ln: %i, lock count: %u\r\n", filename, line, deep_sleep_lock);
+#endif
 }
 
 void sleep_tracker_unlock(const char *const filename, int line)
@@ -179,10 +214,66 @@ void sleep_tracker_unlock(const char *const filename, int line)
 
     core_util_atomic_decr_u8(&stat->count, 1);
 
+#ifdef MBED_SLEEP_TRACING_ENABLED
     mbed_error_printf("UNLOCK: %s, ln: %i, lock count: %u\r\n", filename, line, deep_sleep_lock);
+#endif
+}
+
+#endif // defined(MBED_SLEEP_TRACING_ENABLED) || defined(MBED_SLEEP_STATS_ENABLED)
+
+#ifdef MBED_SLEEP_STATS_ENABLED
+static void sleep_stats_wakeup(void)
+{
+#if defined(__CORTEX_M)
+    // Interrupts are still masked, so the one that woke the core is pending
+    uint32_t vector = (SCB->ICSR & SCB_ICSR_VECTPENDING_Msk) >> SCB_ICSR_VECTPENDING_Pos;
+    if (vector != 0) {
+        int32_t irq = (int32_t)vector - 16;
+        for (int i = 0; i < MBED_MAX_WAKEUP_SOURCES; ++i) {
+            if (wakeups[i].count == 0) {
+                wakeups[i].irq = irq;
+            }
+            if (wakeups[i].irq == irq) {
+                wakeups[i].count++;
+                return;
+            }
+        }
+    }
+#endif
+    wakeup_unknown_cnt++;
 }
 
-#endif // MBED_SLEEP_TRACING_ENABLED
+// Called from the critical section of sleep_manager_sleep_auto
+static void sleep_stats_record(bool deep, bool blocked, us_timestamp_t duration)
+{
+    uint32_t *histogram = deep ? deep_sleep_histogram : sleep_histogram;
+    us_timestamp_t limit = 1000;
+    int bucket = 0;
+    while (bucket < MBED_SLEEP_HISTOGRAM_BUCKETS - 1 && duration >= limit) {
+        bucket++;
+        limit *= 10;
+    }
+    histogram[bucket]++;
+
+    if (deep) {
+        deep_sleep_cnt++;
+    } else {
+        sleep_cnt++;
+    }
+
+    if (blocked) {
+        blocked_cnt++;
+        for (int i = 0; i < STATISTIC_COUNT; ++i) {
+            if (sleep_stats[i].count != 0) {
+                sleep_stats[i].blocked_count++;
+                sleep_stats[i].blocked_time += duration;
+            }
+        }
+    }
+
+    sleep_stats_wakeup();
+}
+#endif // MBED_SLEEP_STATS_ENABLED
 
 void sleep_manager_lock_deep_sleep_internal(void)
 {
@@ -224,17 +315,22 @@ void sleep_manager_sleep_auto(void)
     sleep_tracker_print_stats();
 #endif
     core_util_critical_section_enter();
-#if defined(MBED_CPU_STATS_ENABLED) && DEVICE_LPTICKER
+#if SLEEP_TIMING_ENABLED
     us_timestamp_t start = read_us();
+#endif
+#if (defined(MBED_CPU_STATS_ENABLED) && DEVICE_LPTICKER) || defined(MBED_SLEEP_STATS_ENABLED)
     bool deep = false;
 #endif
+#ifdef MBED_SLEEP_STATS_ENABLED
+    bool blocked = !sleep_manager_can_deep_sleep();
+#endif
 
 // debug profile should keep debuggers attached, no deep sleep allowed
 #ifdef MBED_DEBUG
     hal_sleep();
 #else
     if (sleep_manager_can_deep_sleep()) {
-#if defined(MBED_CPU_STATS_ENABLED) && DEVICE_LPTICKER
+#if (defined(MBED_CPU_STATS_ENABLED) && DEVICE_LPTICKER) || defined(MBED_SLEEP_STATS_ENABLED)
         deep = true;
 #endif
         hal_deepsleep();
@@ -243,13 +339,22 @@ void sleep_manager_sleep_auto(void)
     }
 #endif
 
-#if defined(MBED_CPU_STATS_ENABLED) && DEVICE_LPTICKER
+#if SLEEP_TIMING_ENABLED
     us_timestamp_t end = read_us();
+#endif
+#if defined(MBED_CPU_STATS_ENABLED) && DEVICE_LPTICKER
     if (true == deep) {
         deep_sleep_time += end - start;
     } else {
         sleep_time += end - start;
     }
+#endif
+#ifdef MBED_SLEEP_STATS_ENABLED
+#if SLEEP_TIMING_ENABLED
+    sleep_stats_record(deep, blocked, end - start);
+#else
+    sleep_stats_record(deep, blocked, 0);
+#endif
 #endif
     core_util_critical_section_exit();
 }
@@ -276,3 +381,46 @@ bool sleep_manager_can_deep_sleep(void)
 }
 
 #endif
+
+void mbed_stats_sleep_get(mbed_stats_sleep_t *stats)
+{
+    MBED_ASSERT(stats != NULL);
+    memset(stats, 0, sizeof(mbed_stats_sleep_t));
+
+#if defined(MBED_SLEEP_STATS_ENABLED) && DEVICE_SLEEP
+    core_util_critical_section_enter();
+    stats->sleep_cnt = sleep_cnt;
+    stats->deep_sleep_cnt = deep_sleep_cnt;
+    stats->blocked_cnt = blocked_cnt;
+    memcpy(stats->sleep_histogram, sleep_histogram, sizeof(sleep_histogram));
+    memcpy(stats->deep_sleep_histogram, deep_sleep_histogram, sizeof(deep_sleep_histogram));
+    for (int i = 0; i < STATISTIC_COUNT; ++i) {
+        memcpy(stats->locks[i].identifier, sleep_stats[i].identifier, IDENTIFIER_WIDTH);
+        stats->locks[i].held = sleep_stats[i].count;
+        stats->locks[i].blocked_count = sleep_stats[i].blocked_count;
+        stats->locks[i].blocked_time = sleep_stats[i].blocked_time;
+    }
+    memcpy(stats->wakeups, wakeups, sizeof(wakeups));
+    stats->wakeup_unknown_cnt = wakeup_unknown_cnt;
+    core_util_critical_section_exit();
+#endif
+}
+
+void mbed_stats_sleep_reset(void)
+{
+#if defined(MBED_SLEEP_STATS_ENABLED) && DEVICE_SLEEP
+    core_util_critical_section_enter();
+    sleep_cnt = 0;
+    deep_sleep_cnt = 0;
+    blocked_cnt = 0;
+    memset(sleep_histogram, 0, sizeof(sleep_histogram));
+    memset(deep_sleep_histogram, 0, sizeof(deep_sleep_histogram));
+    for (int i = 0; i < STATISTIC_COUNT; ++i) {
+        sleep_stats[i].blocked_count = 0;
+        sleep_stats[i].blocked_time = 0;
+    }
+    memset(wakeups, 0, sizeof(wakeups));
+    wakeup_unknown_cnt = 0;
+    core_util_critical_section_exit();
+#endif
+}
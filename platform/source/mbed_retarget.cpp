@@ -30,6 +30,7 @@
 #include "platform/mbed_atomic.h"
 #include "platform/mbed_critical.h"
 #include "platform/mbed_poll.h"
+#include "platform/mbed_power_mgmt.h"
 #include "drivers/BufferedSerial.h"
 #include "hal/us_ticker_api.h"
 #include "hal/lp_ticker_api.h"
@@ -141,10 +142,51 @@ void remove_filehandle(FileHandle *file)
 }
 }
 
+/* Size of the ring buffer in front of the raw HAL serial console, 0 to
+ * write each character with serial_putc. Must be a power of 2.
+ */
+#ifndef MBED_CONF_PLATFORM_STDIO_TX_BUFFER_SIZE
+#define MBED_CONF_PLATFORM_STDIO_TX_BUFFER_SIZE 0
+#endif
+
 #if DEVICE_SERIAL
 extern int stdio_uart_inited;
 extern serial_t stdio_uart;
 
+#if MBED_CONF_PLATFORM_STDIO_TX_BUFFER_SIZE
+MBED_STATIC_ASSERT((MBED_CONF_PLATFORM_STDIO_TX_BUFFER_SIZE & (MBED_CONF_PLATFORM_STDIO_TX_BUFFER_SIZE - 1)) == 0,
+                   "platform.stdio-tx-buffer-size must be a power of 2");
+
+/* Written in critical sections, and drained by the TX interrupt. The
+ * indices run freely and are masked on access.
+ */
+static unsigned char console_tx_buffer[MBED_CONF_PLATFORM_STDIO_TX_BUFFER_SIZE];
+static uint32_t console_tx_head;
+static uint32_t console_tx_tail;
+static uint32_t console_tx_dropped;
+static bool console_tx_irq_attached;
+static bool console_tx_active;
+
+static void console_tx_drain()
+{
+    while (console_tx_tail != console_tx_head && serial_writable(&stdio_uart)) {
+        serial_putc(&stdio_uart, console_tx_buffer[console_tx_tail++ & (MBED_CONF_PLATFORM_STDIO_TX_BUFFER_SIZE - 1)]);
+    }
+    if (console_tx_active && console_tx_tail == console_tx_head) {
+        console_tx_active = false;
+        serial_irq_set(&stdio_uart, TxIrq, 0);
+        sleep_manager_unlock_deep_sleep();
+    }
+}
+
+static void console_tx_irq(uint32_t id, SerialIrq event)
+{
+    if (event == TxIrq) {
+        console_tx_drain();
+    }
+}
+#endif // MBED_CONF_PLATFORM_STDIO_TX_BUFFER_SIZE
+
 /* Private FileHandle to implement backwards-compatible functionality of
  * direct HAL serial access for default stdin/stdout/stderr.
  * This is not a particularly well-behaved FileHandle for a stream, which
@@ -172,6 +214,7 @@ public:
     {
         return 0;
     }
+    virtual int sync();
     virtual short poll(short events) const;
 };
 
@@ -219,12 +262,51 @@ DirectSerial::DirectSerial(const serial_pinmap_t &static_pinmap, int baud)
 ssize_t DirectSerial::write(const void *buffer, size_t size)
 {
     const unsigned char *buf = static_cast<const unsigned char *>(buffer);
+#if MBED_CONF_PLATFORM_STDIO_TX_BUFFER_SIZE
+    // Interrupts are masked when called in a critical section, as
+    // mbed_error_puts() does, so write through after what was buffered
+    if (core_util_in_critical_section()) {
+        sync();
+    } else {
+        core_util_critical_section_enter();
+        if (!console_tx_irq_attached) {
+            serial_irq_handler(&stdio_uart, console_tx_irq, 0);
+            console_tx_irq_attached = true;
+        }
+        size_t space = MBED_CONF_PLATFORM_STDIO_TX_BUFFER_SIZE - (console_tx_head - console_tx_tail);
+        size_t count = size < space ? size : space;
+        console_tx_dropped += size - count;
+        for (size_t i = 0; i < count; i++) {
+            console_tx_buffer[console_tx_head++ & (MBED_CONF_PLATFORM_STDIO_TX_BUFFER_SIZE - 1)] = buf[i];
+        }
+        if (count && !console_tx_active) {
+            console_tx_active = true;
+            sleep_manager_lock_deep_sleep();
+            serial_irq_set(&stdio_uart, TxIrq, 1);
+        }
+        core_util_critical_section_exit();
+        return size;
+    }
+#endif
     for (size_t i = 0; i < size; i++) {
         serial_putc(&stdio_uart, buf[i]);
     }
     return size;
 }
 
+int DirectSerial::sync()
+{
+#if MBED_CONF_PLATFORM_STDIO_TX_BUFFER_SIZE
+    // Poll, the TX interrupt may be masked
+    while (console_tx_tail != console_tx_head) {
+        core_util_critical_section_enter();
+        console_tx_drain();
+        core_util_critical_section_exit();
+    }
+#endif
+    return 0;
+}
+
 ssize_t DirectSerial::read(void *buffer, size_t size)
 {
     unsigned char *buf = static_cast<unsigned char *>(buffer);
@@ -388,6 +470,15 @@ FileHandle *mbed_file_handle(int fd)
     return nullptr;
 #endif // !MBED_CONF_PLATFORM_STDIO_MINIMAL_CONSOLE_ONLY
 }
+
+uint32_t mbed_console_tx_dropped()
+{
+#if DEVICE_SERIAL && MBED_CONF_PLATFORM_STDIO_TX_BUFFER_SIZE
+    return core_util_atomic_load_u32(&console_tx_dropped);
+#else
+    return 0;
+#endif
+}
 }
 
 
@@ -793,6 +884,40 @@ extern "C" ssize_t write(int fildes, const void *buf, size_t length)
     }
 }
 
+extern "C" ssize_t writev(int fildes, const struct iovec *iov, int iovcnt)
+{
+    if (iovcnt < 0) {
+        errno = EINVAL;
+        return -1;
+    }
+
+#if MBED_CONF_PLATFORM_STDIO_MINIMAL_CONSOLE_ONLY
+    ssize_t ret = 0;
+    for (int i = 0; i < iovcnt; i++) {
+        ssize_t r = write(fildes, iov[i].iov_base, iov[i].iov_len);
+        if (r < 0) {
+            return ret != 0 ? ret : -1;
+        }
+        ret += r;
+    }
+    return ret;
+#else
+    FileHandle *fhc = mbed_file_handle(fildes);
+    if (fhc == NULL) {
+        errno = EBADF;
+        return -1;
+    }
+
+    ssize_t ret = fhc->writev(iov, iovcnt);
+    if (ret < 0) {
+        errno = -ret;
+        return -1;
+    } else {
+        return ret;
+    }
+#endif // MBED_CONF_PLATFORM_STDIO_MINIMAL_CONSOLE_ONLY
+}
+
 #if MBED_CONF_PLATFORM_STDIO_MINIMAL_CONSOLE_ONLY
 /* Write one character to a serial interface */
 MBED_WEAK int mbed::minimal_console_putc(int c)
@@ -917,6 +1042,38 @@ extern "C" ssize_t read(int fildes, void *buf, size_t length)
     }
 }
 
+extern "C" ssize_t readv(int fildes, const struct iovec *iov, int iovcnt)
+{
+    if (iovcnt < 0) {
+        errno = EINVAL;
+        return -1;
+    }
+
+#if MBED_CONF_PLATFORM_STDIO_MINIMAL_CONSOLE_ONLY
+    // The minimal console reads one character at a time
+    for (int i = 0; i < iovcnt; i++) {
+        if (iov[i].iov_len != 0) {
+            return read(fildes, iov[i].iov_base, iov[i].iov_len);
+        }
+    }
+    return 0;
+#else
+    FileHandle *fhc = mbed_file_handle(fildes);
+    if (fhc == NULL) {
+        errno = EBADF;
+        return -1;
+    }
+
+    ssize_t ret = fhc->readv(iov, iovcnt);
+    if (ret < 0) {
+        errno = -ret;
+        return -1;
+    } else {
+        return ret;
+    }
+#endif // MBED_CONF_PLATFORM_STDIO_MINIMAL_CONSOLE_ONLY
+}
+
 #if MBED_CONF_PLATFORM_STDIO_MINIMAL_CONSOLE_ONLY
 /* Read a character from the serial interface */
 MBED_WEAK int mbed::minimal_console_getc()
@@ -22,12 +22,21 @@
 #include <stdlib.h>
 
 #include "device.h"
+#include "cmsis.h"
 #ifdef MBED_CONF_RTOS_PRESENT
 #include "cmsis_os2.h"
+#include "rtos/source/rtos_handlers.h"
+#include "rtos/source/rtos_stack_pool.h"
 #elif defined(MBED_STACK_STATS_ENABLED) || defined(MBED_THREAD_STATS_ENABLED)
 #warning Statistics are currently not supported without the rtos.
 #endif
 
+#if defined(MBED_STACK_STATS_SAMPLED) && defined(MBED_CONF_RTOS_PRESENT)
+#define THREAD_STACK_USED(id)   rtos_thread_stack_high_water(id)
+#else
+#define THREAD_STACK_USED(id)   (osThreadGetStackSize(id) - osThreadGetStackSpace(id))
+#endif
+
 #if defined(MBED_CPU_STATS_ENABLED) && (!DEVICE_SLEEP)
 #warning CPU statistics are not supported without sleep support.
 #endif
@@ -44,7 +53,54 @@ void mbed_stats_cpu_get(mbed_stats_cpu_t *stats)
 #endif
 }
 
+#if defined(MBED_BOOT_STATS_ENABLED) && defined(DWT_CTRL_CYCCNTENA_Msk) && defined(CoreDebug_DEMCR_TRCENA_Msk)
+static uint32_t boot_cycles[MBED_BOOT_PHASE_COUNT];
+static uint32_t boot_core_clock;
+#endif
+
+void mbed_stats_boot_start(void)
+{
+#if defined(MBED_BOOT_STATS_ENABLED) && defined(DWT_CTRL_CYCCNTENA_Msk) && defined(CoreDebug_DEMCR_TRCENA_Msk)
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+}
+
+void mbed_stats_boot_mark(mbed_boot_phase_t phase)
+{
+#if defined(MBED_BOOT_STATS_ENABLED) && defined(DWT_CTRL_CYCCNTENA_Msk) && defined(CoreDebug_DEMCR_TRCENA_Msk)
+#if !defined(MBED_BOOT_STATS_FROM_RESET)
+    if (phase == MBED_BOOT_PHASE_INIT) {
+        mbed_stats_boot_start();
+        return;
+    }
+#endif
+    if (phase < MBED_BOOT_PHASE_COUNT && boot_cycles[phase] == 0) {
+        // A counter which reads 0 marks the phase as not reached
+        uint32_t cycles = DWT->CYCCNT;
+        boot_cycles[phase] = cycles ? cycles : 1;
+        if (phase == MBED_BOOT_PHASE_MAIN) {
+            boot_core_clock = SystemCoreClock;
+        }
+    }
+#else
+    (void) phase;
+#endif
+}
+
+void mbed_stats_boot_get(mbed_stats_boot_t *stats)
+{
+    MBED_ASSERT(stats != NULL);
+    memset(stats, 0, sizeof(mbed_stats_boot_t));
+#if defined(MBED_BOOT_STATS_ENABLED) && defined(DWT_CTRL_CYCCNTENA_Msk) && defined(CoreDebug_DEMCR_TRCENA_Msk)
+    memcpy(stats->cycles, boot_cycles, sizeof(boot_cycles));
+    stats->core_clock = boot_core_clock;
+#endif
+}
+
 // note: mbed_stats_heap_get defined in mbed_alloc_wrappers.cpp
+// note: mbed_stats_sleep_get defined in mbed_power_mgmt.c
 void mbed_stats_stack_get(mbed_stats_stack_t *stats)
 {
     MBED_ASSERT(stats != NULL);
@@ -66,7 +122,7 @@ void mbed_stats_stack_get(mbed_stats_stack_t *stats)
 
     for (i = 0; i < thread_n; i++) {
         uint32_t stack_size = osThreadGetStackSize(threads[i]);
-        stats->max_size += stack_size - osThreadGetStackSpace(threads[i]);
+        stats->max_size += THREAD_STACK_USED(threads[i]);
         stats->reserved_size += stack_size;
         stats->stack_cnt++;
     }
@@ -76,6 +132,16 @@ void mbed_stats_stack_get(mbed_stats_stack_t *stats)
 #endif
 }
 
+void mbed_stats_stack_pool_get(mbed_stats_heap_t *stats)
+{
+    MBED_ASSERT(stats != NULL);
+    memset(stats, 0, sizeof(mbed_stats_heap_t));
+
+#if defined(MBED_CONF_RTOS_PRESENT) && defined(MBED_CONF_RTOS_THREAD_STACK_POOL_SIZE) && MBED_CONF_RTOS_THREAD_STACK_POOL_SIZE > 0
+    rtos_stack_pool_get_stats(stats);
+#endif
+}
+
 size_t mbed_stats_stack_get_each(mbed_stats_stack_t *stats, size_t count)
 {
     MBED_ASSERT(stats != NULL);
@@ -97,7 +163,7 @@ size_t mbed_stats_stack_get_each(mbed_stats_stack_t *stats, size_t count)
 
     for (i = 0; i < count; i++) {
         uint32_t stack_size = osThreadGetStackSize(threads[i]);
-        stats[i].max_size = stack_size - osThreadGetStackSpace(threads[i]);
+        stats[i].max_size = THREAD_STACK_USED(threads[i]);
         stats[i].reserved_size = stack_size;
         stats[i].thread_id = (uint32_t)threads[i];
         stats[i].stack_cnt = 1;
@@ -130,8 +196,9 @@ size_t mbed_stats_thread_get_each(mbed_stats_thread_t *stats, size_t count)
         stats[i].state = (uint32_t)osThreadGetState(threads[i]);
         stats[i].priority = (uint32_t)osThreadGetPriority(threads[i]);
         stats[i].stack_size = osThreadGetStackSize(threads[i]);
-        stats[i].stack_space = osThreadGetStackSpace(threads[i]);
+        stats[i].stack_space = stats[i].stack_size - THREAD_STACK_USED(threads[i]);
         stats[i].name = osThreadGetName(threads[i]);
+        stats[i].run_time = rtos_thread_run_time(threads[i], NULL);
     }
     osKernelUnlock();
     free(threads);
@@ -139,6 +206,47 @@ size_t mbed_stats_thread_get_each(mbed_stats_thread_t *stats, size_t count)
     return i;
 }
 
+size_t mbed_stats_thread_usage_sample(mbed_stats_thread_usage_t *usage, size_t count)
+{
+    MBED_ASSERT(usage != NULL);
+    memset(usage, 0, count * sizeof(mbed_stats_thread_usage_t));
+    size_t i = 0;
+
+#if defined(MBED_THREAD_STATS_ENABLED) && defined(MBED_CONF_RTOS_PRESENT)
+    osThreadId_t *threads;
+    us_timestamp_t total = 0;
+
+    // Every thread starts a new sample, so enumerate all of them
+    uint32_t thread_cnt = osThreadGetCount();
+    threads = malloc(sizeof(osThreadId_t) * thread_cnt);
+    MBED_ASSERT(threads != NULL);
+
+    osKernelLock();
+    thread_cnt = osThreadEnumerate(threads, thread_cnt);
+
+    for (uint32_t n = 0; n < thread_cnt; n++) {
+        us_timestamp_t run_time;
+        rtos_thread_run_time(threads[n], &run_time);
+        total += run_time;
+        if (i < count) {
+            usage[i].id = (uint32_t)threads[n];
+            usage[i].name = osThreadGetName(threads[n]);
+            usage[i].run_time = run_time;
+            i++;
+        }
+    }
+    osKernelUnlock();
+    free(threads);
+
+    if (total != 0) {
+        for (size_t n = 0; n < i; n++) {
+            usage[n].usage = (uint32_t)(usage[n].run_time * 10000 / total);
+        }
+    }
+#endif
+    return i;
+}
+
 void mbed_stats_sys_get(mbed_stats_sys_t *stats)
 {
     MBED_ASSERT(stats != NULL);
@@ -0,0 +1,10 @@
+
+####################
+# BENCHMARKS
+####################
+
+set(benchmark-sources
+  stubs/mbed_critical_stub.c
+  stubs/mbed_assert_stub.cpp
+  ../platform/tests/BENCHMARKS/CircularBuffer/benchmark_CircularBuffer.cpp
+)
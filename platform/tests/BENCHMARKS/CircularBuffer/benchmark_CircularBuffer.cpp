@@ -0,0 +1,61 @@
+/* Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "benchmark/benchmark.h"
+#include "platform/CircularBuffer.h"
+
+using namespace mbed;
+
+#define BUFFER_SIZE 256
+
+// Push and pop one element at a time
+template <CircularBufferMode Mode>
+static void BM_CircularBuffer_push_pop(benchmark::State &state)
+{
+    CircularBuffer<uint8_t, BUFFER_SIZE, uint32_t, Mode> buf;
+    uint8_t data = 0;
+
+    for (auto _ : state) {
+        for (int i = 0; i < state.range(0); i++) {
+            buf.push(data++);
+        }
+        for (int i = 0; i < state.range(0); i++) {
+            buf.pop(data);
+        }
+        benchmark::DoNotOptimize(data);
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_CircularBuffer_push_pop, CircularBufferMode::critical_section)->Arg(16)->Arg(BUFFER_SIZE);
+BENCHMARK_TEMPLATE(BM_CircularBuffer_push_pop, CircularBufferMode::spsc)->Arg(16)->Arg(BUFFER_SIZE);
+
+// Push and pop blocks of elements, which wrap around the end of the buffer
+template <CircularBufferMode Mode>
+static void BM_CircularBuffer_block(benchmark::State &state)
+{
+    CircularBuffer<uint8_t, BUFFER_SIZE, uint32_t, Mode> buf;
+    uint8_t block[BUFFER_SIZE] = {};
+
+    for (auto _ : state) {
+        buf.push(block, state.range(0));
+        benchmark::DoNotOptimize(buf.pop(block, state.range(0)));
+    }
+
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_CircularBuffer_block, CircularBufferMode::critical_section)->Arg(16)->Arg(100);
+BENCHMARK_TEMPLATE(BM_CircularBuffer_block, CircularBufferMode::spsc)->Arg(16)->Arg(100);
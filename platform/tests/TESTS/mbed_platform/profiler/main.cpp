@@ -0,0 +1,126 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define MBED_PROFILER_ENABLED
+
+#include "greentea-client/test_env.h"
+#include "unity/unity.h"
+#include "utest/utest.h"
+
+#include "mbed.h"
+
+#if !defined(__CORTEX_M) || !defined(DWT_CTRL_CYCCNTENA_Msk)
+#error [NOT_SUPPORTED] test not supported
+#else
+
+using namespace utest::v1;
+
+#define HISTOGRAM_BUCKETS   64
+
+static volatile uint32_t spin_counter;
+
+static void spin(uint32_t loops)
+{
+    MBED_PROFILE_SCOPE("spin");
+    for (uint32_t i = 0; i < loops; i++) {
+        spin_counter++;
+    }
+}
+
+static const mbed_profile_scope_t *find_scope(const char *name)
+{
+    for (const mbed_profile_scope_t *scope = mbed_profile_scope_first(); scope; scope = scope->next) {
+        if (strcmp(scope->name, name) == 0) {
+            return scope;
+        }
+    }
+    return NULL;
+}
+
+void test_profile_scope()
+{
+    spin(100);
+    const mbed_profile_scope_t *scope = find_scope("spin");
+    TEST_ASSERT_NOT_NULL(scope);
+    TEST_ASSERT_EQUAL_UINT32(1, scope->count);
+    uint32_t short_cycles = scope->max_cycles;
+    TEST_ASSERT_NOT_EQUAL(0, short_cycles);
+
+    spin(10000);
+    TEST_ASSERT_EQUAL_UINT32(2, scope->count);
+    TEST_ASSERT_TRUE(scope->max_cycles > short_cycles);
+    TEST_ASSERT_TRUE(scope->total_cycles >= (uint64_t) scope->max_cycles + short_cycles);
+}
+
+#if defined(MBED_CONF_RTOS_PRESENT) && defined(NVIC_RAM_VECTOR_ADDRESS) && defined(MBED_ROM_START) && defined(MBED_ROM_SIZE)
+static uint32_t histogram[HISTOGRAM_BUCKETS];
+
+void test_sampling()
+{
+    TEST_ASSERT_EQUAL(0, mbed_profiler_sampling_start(SysTick_IRQn, histogram, HISTOGRAM_BUCKETS));
+    TEST_ASSERT_EQUAL(-1, mbed_profiler_sampling_start(SysTick_IRQn, histogram, HISTOGRAM_BUCKETS));
+
+    // The RTOS tick keeps running while the thread spins
+    Timer timer;
+    timer.start();
+    while (timer.elapsed_time() < 200ms) {
+        spin_counter++;
+    }
+    mbed_profiler_sampling_stop();
+
+    uint8_t snapshot[4 * (6 + HISTOGRAM_BUCKETS)];
+    TEST_ASSERT_EQUAL(sizeof(snapshot), mbed_profiler_sampling_snapshot(NULL, 0));
+    TEST_ASSERT_EQUAL(sizeof(snapshot), mbed_profiler_sampling_snapshot(snapshot, sizeof(snapshot)));
+    uint32_t samples;
+    memcpy(&samples, snapshot + 16, sizeof(samples));
+    TEST_ASSERT_TRUE(samples > 0);
+
+    // This function runs from ROM, so its bucket got samples
+    uint32_t offset = (reinterpret_cast<uint32_t>(&test_sampling) & ~1) - MBED_ROM_START;
+    uint32_t shift;
+    memcpy(&shift, snapshot + 8, sizeof(shift));
+    uint32_t total = 0;
+    for (uint32_t i = 0; i < HISTOGRAM_BUCKETS; i++) {
+        total += histogram[i];
+    }
+    TEST_ASSERT_TRUE(total > 0);
+    TEST_ASSERT_TRUE((offset >> shift) < HISTOGRAM_BUCKETS);
+    utest_printf("%u samples, %u in the bucket of the test\n", (unsigned) samples, (unsigned) histogram[offset >> shift]);
+}
+#endif
+
+Case cases[] = {
+    Case("Test profile scope", test_profile_scope),
+#if defined(MBED_CONF_RTOS_PRESENT) && defined(NVIC_RAM_VECTOR_ADDRESS) && defined(MBED_ROM_START) && defined(MBED_ROM_SIZE)
+    Case("Test sampling", test_sampling),
+#endif
+};
+
+utest::v1::status_t greentea_test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(20, "default_auto");
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+Specification specification(greentea_test_setup, cases, greentea_test_teardown_handler);
+
+int main()
+{
+    Harness::run(specification);
+}
+
+#endif // !defined(__CORTEX_M) || !defined(DWT_CTRL_CYCCNTENA_Msk)
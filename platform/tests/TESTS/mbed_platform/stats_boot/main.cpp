@@ -0,0 +1,84 @@
+
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+
+#include "greentea-client/test_env.h"
+#include "unity/unity.h"
+#include "utest/utest.h"
+
+#include "mbed.h"
+
+#if !defined(MBED_BOOT_STATS_ENABLED) || !defined(DWT_CTRL_CYCCNTENA_Msk)
+#error [NOT_SUPPORTED] test not supported
+#else
+
+using namespace utest::v1;
+
+void test_boot_phases()
+{
+    mbed_stats_boot_t stats;
+    mbed_stats_boot_get(&stats);
+
+    // Phases are reached in order
+    uint32_t last = 0;
+    for (int i = MBED_BOOT_PHASE_SDK_INIT; i <= MBED_BOOT_PHASE_MAIN; i++) {
+        if (stats.cycles[i] == 0) {
+            continue;
+        }
+        TEST_ASSERT_TRUE(stats.cycles[i] >= last);
+        last = stats.cycles[i];
+    }
+    TEST_ASSERT_NOT_EQUAL(0, stats.cycles[MBED_BOOT_PHASE_MAIN]);
+    TEST_ASSERT_EQUAL_UINT32(SystemCoreClock, stats.core_clock);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.cycles[MBED_BOOT_PHASE_APPLICATION]);
+
+    utest_printf("main() reached after %u cycles\n", (unsigned) stats.cycles[MBED_BOOT_PHASE_MAIN]);
+}
+
+void test_boot_application_mark()
+{
+    mbed_stats_boot_t stats;
+
+    mbed_stats_boot_mark(MBED_BOOT_PHASE_APPLICATION);
+    mbed_stats_boot_get(&stats);
+    uint32_t first = stats.cycles[MBED_BOOT_PHASE_APPLICATION];
+    TEST_ASSERT_TRUE(first > stats.cycles[MBED_BOOT_PHASE_MAIN]);
+
+    // Only the first mark is kept
+    mbed_stats_boot_mark(MBED_BOOT_PHASE_APPLICATION);
+    mbed_stats_boot_get(&stats);
+    TEST_ASSERT_EQUAL_UINT32(first, stats.cycles[MBED_BOOT_PHASE_APPLICATION]);
+}
+
+Case cases[] = {
+    Case("Test boot phases", test_boot_phases),
+    Case("Test boot application mark", test_boot_application_mark)
+};
+
+utest::v1::status_t greentea_test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(20, "default_auto");
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+Specification specification(greentea_test_setup, cases, greentea_test_teardown_handler);
+
+int main()
+{
+    Harness::run(specification);
+}
+
+#endif // !defined(MBED_BOOT_STATS_ENABLED) || !defined(DWT_CTRL_CYCCNTENA_Msk)
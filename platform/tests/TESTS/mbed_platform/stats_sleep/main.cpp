@@ -0,0 +1,114 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "greentea-client/test_env.h"
+#include "unity/unity.h"
+#include "utest/utest.h"
+
+#include "mbed.h"
+#include <string.h>
+
+#if !defined(MBED_SLEEP_STATS_ENABLED) || !DEVICE_LPTICKER || !DEVICE_SLEEP
+#error [NOT_SUPPORTED] test not supported
+#else
+
+using namespace utest::v1;
+
+#define SLEEP_TIME              100ms
+
+static uint32_t sum(const uint32_t *values, int count)
+{
+    uint32_t total = 0;
+    for (int i = 0; i < count; i++) {
+        total += values[i];
+    }
+    return total;
+}
+
+static const mbed_stats_sleep_lock_t *find_lock(const mbed_stats_sleep_t *stats, const char *identifier)
+{
+    for (int i = 0; i < MBED_MAX_SLEEP_LOCKS; i++) {
+        if (strcmp(stats->locks[i].identifier, identifier) == 0) {
+            return &stats->locks[i];
+        }
+    }
+    return NULL;
+}
+
+void test_sleep_counts(void)
+{
+    mbed_stats_sleep_t stats;
+
+    mbed_stats_sleep_reset();
+    ThisThread::sleep_for(SLEEP_TIME);
+    mbed_stats_sleep_get(&stats);
+
+    uint32_t sleeps = stats.sleep_cnt + stats.deep_sleep_cnt;
+    TEST_ASSERT_NOT_EQUAL(0, sleeps);
+    TEST_ASSERT_EQUAL(stats.sleep_cnt, sum(stats.sleep_histogram, MBED_SLEEP_HISTOGRAM_BUCKETS));
+    TEST_ASSERT_EQUAL(stats.deep_sleep_cnt, sum(stats.deep_sleep_histogram, MBED_SLEEP_HISTOGRAM_BUCKETS));
+
+    uint32_t wakeups = stats.wakeup_unknown_cnt;
+    for (int i = 0; i < MBED_MAX_WAKEUP_SOURCES; i++) {
+        wakeups += stats.wakeups[i].count;
+    }
+    TEST_ASSERT_EQUAL(sleeps, wakeups);
+}
+
+void test_sleep_lock_attribution(void)
+{
+    mbed_stats_sleep_t stats;
+
+    mbed_stats_sleep_reset();
+    sleep_manager_lock_deep_sleep();
+    ThisThread::sleep_for(SLEEP_TIME);
+    mbed_stats_sleep_get(&stats);
+    sleep_manager_unlock_deep_sleep();
+
+    const mbed_stats_sleep_lock_t *lock = find_lock(&stats, "main.cpp");
+    TEST_ASSERT_NOT_NULL(lock);
+    TEST_ASSERT_EQUAL(1, lock->held);
+    TEST_ASSERT_NOT_EQUAL(0, lock->blocked_count);
+    TEST_ASSERT_NOT_EQUAL(0, lock->blocked_time);
+    TEST_ASSERT_EQUAL(0, stats.deep_sleep_cnt);
+    TEST_ASSERT_EQUAL(stats.sleep_cnt, stats.blocked_cnt);
+
+    mbed_stats_sleep_get(&stats);
+    lock = find_lock(&stats, "main.cpp");
+    TEST_ASSERT_NOT_NULL(lock);
+    TEST_ASSERT_EQUAL(0, lock->held);
+}
+
+Case cases[] = {
+    Case("Test sleep counts", test_sleep_counts),
+    Case("Test sleep lock attribution", test_sleep_lock_attribution)
+};
+
+utest::v1::status_t greentea_test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(20, "default_auto");
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+Specification specification(greentea_test_setup, cases, greentea_test_teardown_handler);
+
+int main()
+{
+    Harness::run(specification);
+}
+
+#endif // !defined(MBED_SLEEP_STATS_ENABLED) || !DEVICE_LPTICKER || !DEVICE_SLEEP
@@ -27,6 +27,7 @@
 #else
 
 using namespace utest::v1;
+using namespace std::chrono_literals;
 
 static EventFlags ef;
 static int32_t counter = 0;
@@ -51,6 +52,67 @@ void increment_with_delay()
     }
 }
 
+void busy_loop()
+{
+    Timer timer;
+    timer.start();
+    while (timer.elapsed_time() < 200ms) {
+    }
+    ef.wait_all(FLAG_SIGNAL_DEC);
+}
+
+void test_case_run_time()
+{
+    mbed_stats_thread_usage_t *usage = new mbed_stats_thread_usage_t[MAX_THREAD_STATS];
+    mbed_stats_thread_t *stats = new mbed_stats_thread_t[MAX_THREAD_STATS];
+    Thread t1(osPriorityNormal1, TEST_STACK_SIZE, NULL, "Th1");
+
+    // Start a new sample for the threads already running
+    mbed_stats_thread_usage_sample(usage, MAX_THREAD_STATS);
+    // Th1 preempts this thread until it blocks
+    t1.start(busy_loop);
+    ThisThread::sleep_for(100ms);
+
+    int count = mbed_stats_thread_get_each(stats, MAX_THREAD_STATS);
+    bool found = false;
+    for (int i = 0; i < count; i++) {
+        if (0 == strcmp(stats[i].name, "Th1")) {
+            TEST_ASSERT_UINT32_WITHIN(20000, 200000, (uint32_t)stats[i].run_time);
+            found = true;
+        }
+    }
+    TEST_ASSERT_TRUE(found);
+
+    // Th1 ran for about 200ms of the 300ms sampled, the rest was mostly idle
+    uint32_t total = 0;
+    count = mbed_stats_thread_usage_sample(usage, MAX_THREAD_STATS);
+    found = false;
+    for (int i = 0; i < count; i++) {
+        total += usage[i].usage;
+        if (0 == strcmp(usage[i].name, "Th1")) {
+            TEST_ASSERT_UINT32_WITHIN(20000, 200000, (uint32_t)usage[i].run_time);
+            TEST_ASSERT_UINT32_WITHIN(1000, 6667, usage[i].usage);
+            found = true;
+        }
+    }
+    TEST_ASSERT_TRUE(found);
+    TEST_ASSERT_UINT32_WITHIN(count, 10000, total);
+
+    // A blocked thread uses no CPU
+    ThisThread::sleep_for(100ms);
+    count = mbed_stats_thread_usage_sample(usage, MAX_THREAD_STATS);
+    for (int i = 0; i < count; i++) {
+        if (0 == strcmp(usage[i].name, "Th1")) {
+            TEST_ASSERT_EQUAL_UINT32(0, usage[i].usage);
+        }
+    }
+
+    ef.set(FLAG_SIGNAL_DEC);
+    t1.join();
+    delete[] stats;
+    delete[] usage;
+}
+
 void test_case_single_thread_stats()
 {
     mbed_stats_thread_t *stats = new mbed_stats_thread_t[MAX_THREAD_STATS];
@@ -161,6 +223,7 @@ Case cases[] = {
     Case("Less count value", test_case_less_count),
     Case("Multiple Threads blocked", test_case_multi_threads_blocked),
     Case("Multiple Threads terminate", test_case_multi_threads_terminate),
+    Case("Thread run time", test_case_run_time),
 };
 
 utest::v1::status_t greentea_test_setup(const size_t number_of_cases)
@@ -404,3 +404,27 @@ TEST_F(test_ATCmdParser, test_ATCmdParser_scanf)
 }
 
 
+
+TEST_F(test_ATCmdParser, test_ATCmdParser_recv_then_read)
+{
+    FileHandle_stub fh1;
+    ATCmdParser at(&fh1, "\r");
+
+    // Data buffered past the matched response is returned by read()
+    char table1[] = "noise\r\n+IPD,5:helloOK\r\n";
+    char buf[6] = {0};
+    int len = 0;
+    at.flush();
+    filehandle_stub_table = table1;
+    filehandle_stub_table_pos = 0;
+    mbed_poll_stub::revents_value = POLLIN;
+    mbed_poll_stub::int_value = 1;
+    EXPECT_TRUE(at.recv("+IPD,%d:", &len));
+    EXPECT_EQ(5, len);
+    EXPECT_EQ(5, at.read(buf, len));
+    EXPECT_EQ(0, memcmp(buf, "hello", 5));
+    EXPECT_TRUE(at.recv("OK"));
+
+    filehandle_stub_table = NULL;
+    filehandle_stub_table_pos = 0;
+}
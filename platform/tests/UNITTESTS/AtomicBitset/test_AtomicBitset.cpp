@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2021, Arm Limited and affiliates
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+#include "platform/AtomicBitset.h"
+
+using mbed::AtomicBitset;
+
+TEST(TestAtomicBitset, set_reset_test)
+{
+    AtomicBitset<40> bits;
+    EXPECT_FALSE(bits.test(35));
+    EXPECT_FALSE(bits.set(35));
+    EXPECT_TRUE(bits.test(35));
+    EXPECT_TRUE(bits.set(35));
+    EXPECT_EQ(1u, bits.count());
+    EXPECT_TRUE(bits.reset(35));
+    EXPECT_FALSE(bits.reset(35));
+    EXPECT_EQ(0u, bits.count());
+}
+
+TEST(TestAtomicBitset, claim_lowest_clear)
+{
+    AtomicBitset<40> bits;
+    EXPECT_EQ(0, bits.claim());
+    EXPECT_EQ(1, bits.claim());
+    bits.set(2);
+    EXPECT_EQ(3, bits.claim());
+    bits.reset(0);
+    EXPECT_EQ(0, bits.claim());
+}
+
+TEST(TestAtomicBitset, claim_until_full)
+{
+    AtomicBitset<40> bits;
+    for (int i = 0; i < 40; i++) {
+        EXPECT_EQ(i, bits.claim());
+    }
+    // Bits past N in the last word are never claimed
+    EXPECT_EQ(-1, bits.claim());
+    EXPECT_EQ(40u, bits.count());
+
+    bits.reset(37);
+    EXPECT_EQ(37, bits.claim());
+}
+
+TEST(TestAtomicBitset, claim_whole_words)
+{
+    AtomicBitset<64> bits;
+    for (int i = 0; i < 64; i++) {
+        EXPECT_EQ(i, bits.claim());
+    }
+    EXPECT_EQ(-1, bits.claim());
+}
@@ -129,3 +129,119 @@ TEST_F(TestCircularBuffer, writing_over_max_capacity)
         EXPECT_TRUE(0 == memcmp(test_numbers + 1, test_numbers_popped, TEST_BUFFER_SIZE));
     }
 }
+
+TEST_F(TestCircularBuffer, peek_span_drop)
+{
+    const int test_numbers[TEST_BUFFER_SIZE] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 };
+    int test_numbers_popped[TEST_BUFFER_SIZE];
+    int item;
+
+    EXPECT_EQ(buf->peek_span().size(), 0);
+
+    /* move the tail so the stored items wrap around the end */
+    buf->push(test_numbers, 6);
+    buf->pop(test_numbers_popped, 6);
+    buf->push(test_numbers, 8);
+
+    mbed::Span<const int> span = buf->peek_span();
+    EXPECT_EQ(span.size(), 4);
+    EXPECT_TRUE(0 == memcmp(test_numbers, span.data(), 4 * sizeof(int)));
+
+    buf->drop(span.size());
+    span = buf->peek_span();
+    EXPECT_EQ(span.size(), 4);
+    EXPECT_TRUE(0 == memcmp(test_numbers + 4, span.data(), 4 * sizeof(int)));
+
+    buf->drop(100);
+    EXPECT_TRUE(buf->empty());
+    EXPECT_FALSE(buf->pop(item));
+}
+
+class TestCircularBufferSPSC : public testing::Test {
+protected:
+    mbed::CircularBuffer<int, TEST_BUFFER_SIZE, uint8_t, mbed::CircularBufferMode::spsc> buf;
+};
+
+TEST_F(TestCircularBufferSPSC, push_pop)
+{
+    int item = 0;
+    EXPECT_TRUE(buf.empty());
+    EXPECT_TRUE(buf.push(1));
+    EXPECT_EQ(buf.size(), 1);
+    EXPECT_TRUE(buf.peek(item));
+    EXPECT_EQ(item, 1);
+    EXPECT_TRUE(buf.pop(item));
+    EXPECT_EQ(item, 1);
+    EXPECT_FALSE(buf.pop(item));
+}
+
+TEST_F(TestCircularBufferSPSC, push_full)
+{
+    int item;
+    for (int i = 0; i < TEST_BUFFER_SIZE; i++) {
+        EXPECT_TRUE(buf.push(i));
+    }
+    EXPECT_TRUE(buf.full());
+    EXPECT_FALSE(buf.push(100));
+
+    /* a full buffer keeps the oldest items */
+    EXPECT_TRUE(buf.pop(item));
+    EXPECT_EQ(item, 0);
+    EXPECT_TRUE(buf.push(100));
+    buf.reset();
+    EXPECT_TRUE(buf.empty());
+}
+
+TEST_F(TestCircularBufferSPSC, push_pop_multiple)
+{
+    const int test_numbers[TEST_BUFFER_SIZE] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 };
+
+    /* several laps, checking the copies across the buffer end */
+    for (int lap = 0; lap < 3 * TEST_BUFFER_SIZE; lap++) {
+        int test_numbers_popped[TEST_BUFFER_SIZE] = { 0 };
+        int count = lap % TEST_BUFFER_SIZE;
+        EXPECT_EQ(buf.push(test_numbers, count), count);
+        EXPECT_EQ(buf.size(), count);
+        mbed::Span<int> popped = buf.pop(mbed::make_Span(test_numbers_popped, TEST_BUFFER_SIZE));
+        EXPECT_EQ(popped.size(), count);
+        EXPECT_TRUE(0 == memcmp(test_numbers, test_numbers_popped, count * sizeof(int)));
+        EXPECT_TRUE(buf.empty());
+    }
+}
+
+TEST_F(TestCircularBufferSPSC, push_over_capacity)
+{
+    const int test_numbers[TEST_BUFFER_SIZE + 1] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11 };
+    int test_numbers_popped[TEST_BUFFER_SIZE] = { 0 };
+
+    buf.push(-1);
+    /* only what fits is stored, the rest is left to the caller */
+    EXPECT_EQ(buf.push(test_numbers, TEST_BUFFER_SIZE + 1), TEST_BUFFER_SIZE - 1);
+    EXPECT_EQ(buf.pop(test_numbers_popped, TEST_BUFFER_SIZE), TEST_BUFFER_SIZE);
+    EXPECT_EQ(test_numbers_popped[0], -1);
+    EXPECT_TRUE(0 == memcmp(test_numbers, test_numbers_popped + 1, (TEST_BUFFER_SIZE - 1) * sizeof(int)));
+}
+
+TEST_F(TestCircularBufferSPSC, peek_span_drop)
+{
+    const int test_numbers[TEST_BUFFER_SIZE] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 };
+    int test_numbers_popped[TEST_BUFFER_SIZE];
+
+    /* move the tail so the stored items wrap around the end */
+    buf.push(test_numbers, 6);
+    buf.pop(test_numbers_popped, 6);
+    buf.push(test_numbers, 8);
+
+    mbed::Span<const int> span = buf.peek_span();
+    EXPECT_EQ(span.size(), 4);
+    EXPECT_TRUE(0 == memcmp(test_numbers, span.data(), 4 * sizeof(int)));
+
+    buf.drop(span.size());
+    span = buf.peek_span();
+    EXPECT_EQ(span.size(), 4);
+    EXPECT_TRUE(0 == memcmp(test_numbers + 4, span.data(), 4 * sizeof(int)));
+
+    buf.drop(100);
+    EXPECT_TRUE(buf.empty());
+    EXPECT_EQ(buf.peek_span().size(), 0);
+}
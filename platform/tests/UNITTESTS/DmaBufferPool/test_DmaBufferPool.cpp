@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2021, Arm Limited and affiliates
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+#include "platform/DmaBufferPool.h"
+
+using mbed::DmaBufferPool;
+
+TEST(TestDmaBufferPool, buffer_size_whole_lines)
+{
+    typedef DmaBufferPool<1, 1> SmallPool;
+    typedef DmaBufferPool<100, 1> Pool;
+    typedef DmaBufferPool<MBED_DCACHE_LINE_SIZE, 1> LinePool;
+
+    EXPECT_EQ(0u, SmallPool::buffer_size % MBED_DCACHE_LINE_SIZE);
+    EXPECT_EQ(0u, Pool::buffer_size % MBED_DCACHE_LINE_SIZE);
+    EXPECT_LE(100u, Pool::buffer_size);
+    EXPECT_EQ((size_t)MBED_DCACHE_LINE_SIZE, LinePool::buffer_size);
+}
+
+TEST(TestDmaBufferPool, alloc_until_empty)
+{
+    DmaBufferPool<100, 3> pool;
+    void *buffers[3];
+
+    EXPECT_EQ(3u, pool.count_free());
+    for (int i = 0; i < 3; i++) {
+        buffers[i] = pool.alloc();
+        ASSERT_NE(nullptr, buffers[i]);
+        EXPECT_TRUE(pool.owns(buffers[i]));
+        EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(buffers[i]) % MBED_DCACHE_LINE_SIZE);
+    }
+    EXPECT_EQ(nullptr, pool.alloc());
+    EXPECT_EQ(0u, pool.count_free());
+
+    // buffers don't overlap
+    for (int i = 1; i < 3; i++) {
+        EXPECT_LE(pool.buffer_size, (size_t)((uint8_t *)buffers[i] - (uint8_t *)buffers[i - 1]));
+    }
+
+    pool.free(buffers[1]);
+    EXPECT_EQ(1u, pool.count_free());
+    EXPECT_EQ(buffers[1], pool.alloc());
+}
+
+TEST(TestDmaBufferPool, owns)
+{
+    DmaBufferPool<64, 2> pool;
+    uint8_t other[64];
+
+    EXPECT_FALSE(pool.owns(other));
+    uint8_t *buffer = static_cast<uint8_t *>(pool.alloc());
+    EXPECT_TRUE(pool.owns(buffer + pool.buffer_size - 1));
+    EXPECT_FALSE(pool.owns(buffer + 2 * pool.buffer_size));
+}
@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2021, Arm Limited and affiliates
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+#include "platform/InplaceCallback.h"
+#include <memory>
+
+using mbed::InplaceCallback;
+
+static int add_one(int x)
+{
+    return x + 1;
+}
+
+struct Counted {
+    Counted(int *live) : live(live)
+    {
+        (*live)++;
+    }
+
+    Counted(Counted &&other) : live(other.live)
+    {
+        (*live)++;
+    }
+
+    ~Counted()
+    {
+        (*live)--;
+    }
+
+    int operator()(int x)
+    {
+        return x * 2;
+    }
+
+    int *live;
+};
+
+TEST(TestInplaceCallback, test_lambda_capture)
+{
+    int a = 1, b = 2, c = 3, d = 4;
+    InplaceCallback<int(int), 32> cb([a, b, c, d](int x) {
+        return a + b + c + d + x;
+    });
+
+    EXPECT_TRUE(bool(cb));
+    EXPECT_EQ(15, cb(5));
+    EXPECT_EQ(32u, cb.capacity());
+}
+
+TEST(TestInplaceCallback, test_function_pointer)
+{
+    InplaceCallback<int(int)> cb(add_one);
+    EXPECT_EQ(3, cb(2));
+
+    int (*null_fn)(int) = nullptr;
+    InplaceCallback<int(int)> empty(null_fn);
+    EXPECT_FALSE(bool(empty));
+
+    cb = nullptr;
+    EXPECT_FALSE(bool(cb));
+}
+
+TEST(TestInplaceCallback, test_move_only)
+{
+    std::unique_ptr<int> value(new int(7));
+    InplaceCallback<int()> cb([value = std::move(value)] {
+        return *value;
+    });
+    EXPECT_EQ(7, cb());
+
+    InplaceCallback<int()> moved(std::move(cb));
+    EXPECT_FALSE(bool(cb));
+    EXPECT_EQ(7, moved());
+
+    cb = std::move(moved);
+    EXPECT_FALSE(bool(moved));
+    EXPECT_EQ(7, cb());
+}
+
+TEST(TestInplaceCallback, test_lifetime)
+{
+    int live = 0;
+    {
+        InplaceCallback<int(int)> cb{Counted(&live)};
+        EXPECT_EQ(1, live);
+        EXPECT_EQ(6, cb(3));
+
+        InplaceCallback<int(int)> moved(std::move(cb));
+        EXPECT_EQ(1, live);
+
+        moved = add_one;
+        EXPECT_EQ(0, live);
+
+        moved = Counted(&live);
+        EXPECT_EQ(1, live);
+    }
+    EXPECT_EQ(0, live);
+}
@@ -0,0 +1,12 @@
+
+####################
+# UNIT TESTS
+####################
+
+set(unittest-sources
+)
+
+set(unittest-test-sources
+  ../platform/tests/UNITTESTS/InplaceCallback/test_InplaceCallback.cpp
+  stubs/mbed_assert_stub.cpp
+)
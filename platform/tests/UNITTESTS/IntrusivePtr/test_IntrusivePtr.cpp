@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2021, Arm Limited and affiliates
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+#include "platform/IntrusivePtr.h"
+#include "platform/SharedPtr.h"
+
+using mbed::IntrusivePtr;
+using mbed::RefCounted;
+using mbed::RefCountMode;
+using mbed::SharedPtr;
+
+static int live_objects;
+
+template <RefCountMode Mode>
+struct TestObject : RefCounted<Mode> {
+    TestObject(int v = 0) : value(v)
+    {
+        live_objects++;
+    }
+
+    ~TestObject()
+    {
+        live_objects--;
+    }
+
+    int value;
+};
+
+template <typename T>
+class TestIntrusivePtr : public testing::Test {
+protected:
+    void SetUp()
+    {
+        live_objects = 0;
+    }
+};
+
+typedef testing::Types<TestObject<RefCountMode::atomic>, TestObject<RefCountMode::single_thread> > ObjectTypes;
+
+TYPED_TEST_CASE(TestIntrusivePtr, ObjectTypes);
+
+TYPED_TEST(TestIntrusivePtr, lifetime)
+{
+    {
+        IntrusivePtr<TypeParam> ptr = mbed::make_intrusive<TypeParam>(5);
+        EXPECT_EQ(1, live_objects);
+        EXPECT_EQ(1u, ptr.use_count());
+        EXPECT_EQ(5, ptr->value);
+    }
+    EXPECT_EQ(0, live_objects);
+}
+
+TYPED_TEST(TestIntrusivePtr, sharing)
+{
+    IntrusivePtr<TypeParam> ptr(new TypeParam);
+    IntrusivePtr<TypeParam> ptr2(ptr);
+    EXPECT_EQ(2u, ptr.use_count());
+    EXPECT_TRUE(ptr == ptr2);
+
+    // A pointer can be made again from the raw pointer
+    IntrusivePtr<TypeParam> ptr3(ptr.get());
+    EXPECT_EQ(3u, ptr.use_count());
+
+    ptr = nullptr;
+    ptr3.reset();
+    EXPECT_EQ(1, live_objects);
+    EXPECT_EQ(1u, ptr2.use_count());
+
+    ptr2 = nullptr;
+    EXPECT_EQ(0, live_objects);
+    EXPECT_TRUE(ptr2 == nullptr);
+}
+
+TYPED_TEST(TestIntrusivePtr, move_and_self_reset)
+{
+    IntrusivePtr<TypeParam> ptr = mbed::make_intrusive<TypeParam>();
+    IntrusivePtr<TypeParam> ptr2(std::move(ptr));
+    EXPECT_FALSE(ptr);
+    EXPECT_EQ(1u, ptr2.use_count());
+
+    ptr2.reset(ptr2.get());
+    EXPECT_EQ(1, live_objects);
+    ptr2 = ptr2;
+    EXPECT_EQ(1u, ptr2.use_count());
+}
+
+TEST(TestSharedPtr, make_shared)
+{
+    live_objects = 0;
+    {
+        SharedPtr<TestObject<RefCountMode::single_thread> > ptr = mbed::make_shared<TestObject<RefCountMode::single_thread> >(7);
+        EXPECT_EQ(1u, ptr.use_count());
+        EXPECT_EQ(7, ptr->value);
+
+        SharedPtr<TestObject<RefCountMode::single_thread> > ptr2 = ptr;
+        EXPECT_EQ(2u, ptr.use_count());
+        ptr = nullptr;
+        EXPECT_EQ(1, live_objects);
+    }
+    EXPECT_EQ(0, live_objects);
+}
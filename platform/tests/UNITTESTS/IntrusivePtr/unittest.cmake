@@ -0,0 +1,12 @@
+
+####################
+# UNIT TESTS
+####################
+
+set(unittest-sources
+)
+
+set(unittest-test-sources
+  ../platform/tests/UNITTESTS/IntrusivePtr/test_IntrusivePtr.cpp
+  stubs/mbed_atomic_stub.c
+)
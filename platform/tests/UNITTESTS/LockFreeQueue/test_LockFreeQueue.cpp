@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2021, Arm Limited and affiliates
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+#include "platform/LockFreeQueue.h"
+
+#define TEST_QUEUE_SIZE (8)
+
+using mbed::LockFreeQueue;
+using mbed::LockFreeQueueMode;
+
+template <typename Q>
+class TestLockFreeQueue : public testing::Test {
+protected:
+    Q queue;
+};
+
+typedef testing::Types<LockFreeQueue<int, TEST_QUEUE_SIZE, LockFreeQueueMode::spsc>,
+        LockFreeQueue<int, TEST_QUEUE_SIZE, LockFreeQueueMode::mpmc> > QueueTypes;
+
+TYPED_TEST_CASE(TestLockFreeQueue, QueueTypes);
+
+TYPED_TEST(TestLockFreeQueue, push_pop)
+{
+    int item = 0;
+    EXPECT_TRUE(this->queue.empty());
+    EXPECT_TRUE(this->queue.push(1));
+    EXPECT_EQ(1u, this->queue.size());
+    EXPECT_TRUE(this->queue.pop(item));
+    EXPECT_EQ(1, item);
+    EXPECT_TRUE(this->queue.empty());
+}
+
+TYPED_TEST(TestLockFreeQueue, pop_empty)
+{
+    int item = 5;
+    EXPECT_FALSE(this->queue.pop(item));
+    EXPECT_EQ(5, item);
+}
+
+TYPED_TEST(TestLockFreeQueue, push_full)
+{
+    for (int i = 0; i < TEST_QUEUE_SIZE; i++) {
+        EXPECT_TRUE(this->queue.push(i));
+    }
+    EXPECT_TRUE(this->queue.full());
+    EXPECT_FALSE(this->queue.push(100));
+    EXPECT_EQ(TEST_QUEUE_SIZE, this->queue.capacity());
+
+    int item;
+    EXPECT_TRUE(this->queue.pop(item));
+    EXPECT_EQ(0, item);
+    EXPECT_TRUE(this->queue.push(100));
+}
+
+TYPED_TEST(TestLockFreeQueue, wrap_around)
+{
+    // several laps of the ring, with the fill level varying each lap
+    int next_push = 0;
+    int next_pop = 0;
+    for (int lap = 0; lap < 10; lap++) {
+        int count = lap % TEST_QUEUE_SIZE + 1;
+        for (int i = 0; i < count; i++) {
+            EXPECT_TRUE(this->queue.push(next_push++));
+        }
+        EXPECT_EQ((uint32_t)count, this->queue.size());
+        int item;
+        for (int i = 0; i < count; i++) {
+            EXPECT_TRUE(this->queue.pop(item));
+            EXPECT_EQ(next_pop++, item);
+        }
+        EXPECT_TRUE(this->queue.empty());
+    }
+}
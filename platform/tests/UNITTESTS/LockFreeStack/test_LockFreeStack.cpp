@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2021, Arm Limited and affiliates
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+#include "platform/LockFreeStack.h"
+
+using mbed::LockFreeStack;
+
+struct Node {
+    Node *next;
+    int value;
+};
+
+TEST(TestLockFreeStack, pop_empty)
+{
+    LockFreeStack<Node> stack;
+    EXPECT_TRUE(stack.empty());
+    EXPECT_EQ(nullptr, stack.pop());
+}
+
+TEST(TestLockFreeStack, last_in_first_out)
+{
+    LockFreeStack<Node> stack;
+    Node nodes[3] = {{nullptr, 0}, {nullptr, 1}, {nullptr, 2}};
+    for (Node &node : nodes) {
+        stack.push(&node);
+    }
+    EXPECT_FALSE(stack.empty());
+
+    EXPECT_EQ(&nodes[2], stack.pop());
+    EXPECT_EQ(&nodes[1], stack.pop());
+    stack.push(&nodes[2]);
+    EXPECT_EQ(&nodes[2], stack.pop());
+    EXPECT_EQ(&nodes[0], stack.pop());
+    EXPECT_EQ(nullptr, stack.pop());
+    EXPECT_TRUE(stack.empty());
+}
@@ -0,0 +1,13 @@
+
+####################
+# UNIT TESTS
+####################
+
+set(unittest-sources
+)
+
+set(unittest-test-sources
+  ../platform/tests/UNITTESTS/LockFreeStack/test_LockFreeStack.cpp
+  stubs/mbed_atomic_stub.c
+  stubs/mbed_critical_stub.c
+)
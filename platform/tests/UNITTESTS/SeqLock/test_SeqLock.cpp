@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2021, Arm Limited and affiliates
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+#include "platform/SeqLock.h"
+
+using mbed::SeqLock;
+
+struct Timestamp {
+    uint32_t seconds;
+    uint32_t microseconds;
+    uint64_t ticks;
+};
+
+TEST(TestSeqLock, initial_value)
+{
+    SeqLock<Timestamp> lock;
+    Timestamp value = lock.read();
+    EXPECT_EQ(0u, value.seconds);
+    EXPECT_EQ(0u, value.microseconds);
+    EXPECT_EQ(0u, value.ticks);
+}
+
+TEST(TestSeqLock, write_read)
+{
+    SeqLock<Timestamp> lock;
+    lock.write({1, 2, 3});
+    lock.write({4, 5, 6});
+
+    Timestamp value;
+    EXPECT_TRUE(lock.try_read(value));
+    EXPECT_EQ(4u, value.seconds);
+    EXPECT_EQ(5u, value.microseconds);
+    EXPECT_EQ(6u, value.ticks);
+    EXPECT_EQ(4u, lock.read().seconds);
+}
@@ -0,0 +1,12 @@
+
+####################
+# UNIT TESTS
+####################
+
+set(unittest-sources
+)
+
+set(unittest-test-sources
+  ../platform/tests/UNITTESTS/SeqLock/test_SeqLock.cpp
+  stubs/mbed_atomic_stub.c
+)
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2021, Arm Limited and affiliates
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+#include <stdint.h>
+#include <string.h>
+#include "platform/internal/mbed_heap_pool.h"
+
+// The pools hold 4 slabs of 512 bytes, shared by the tests in order
+
+TEST(TestHeapPool, size_classes)
+{
+    void *small = mbed_heap_pool_alloc(1);
+    void *medium = mbed_heap_pool_alloc(100);
+    void *empty = mbed_heap_pool_alloc(0);
+    ASSERT_TRUE(small != NULL);
+    ASSERT_TRUE(medium != NULL);
+    ASSERT_TRUE(empty != NULL);
+
+    EXPECT_EQ(16u, mbed_heap_pool_block_size(small));
+    EXPECT_EQ(128u, mbed_heap_pool_block_size(medium));
+    EXPECT_EQ(16u, mbed_heap_pool_block_size(empty));
+    EXPECT_EQ(0u, (uintptr_t)small % 8);
+    EXPECT_EQ(0u, (uintptr_t)medium % 8);
+
+    EXPECT_TRUE(mbed_heap_pool_owns(small));
+    EXPECT_FALSE(mbed_heap_pool_owns(NULL));
+    EXPECT_FALSE(mbed_heap_pool_owns(&small));
+    EXPECT_TRUE(mbed_heap_pool_alloc(MBED_HEAP_POOL_MAX_BLOCK + 1) == NULL);
+
+    // Freed blocks are handed out again first
+    mbed_heap_pool_free(small);
+    EXPECT_EQ(small, mbed_heap_pool_alloc(16));
+
+    void *next = mbed_heap_pool_alloc(16);
+    EXPECT_NE(small, next);
+    EXPECT_NE(empty, next);
+
+    mbed_heap_pool_free(next);
+    mbed_heap_pool_free(small);
+    mbed_heap_pool_free(medium);
+    mbed_heap_pool_free(empty);
+}
+
+TEST(TestHeapPool, exhaustion)
+{
+    // Two slabs are left, holding 2 blocks of 256 bytes each
+    void *blocks[4];
+    for (int i = 0; i < 4; i++) {
+        blocks[i] = mbed_heap_pool_alloc(MBED_HEAP_POOL_MAX_BLOCK);
+        ASSERT_TRUE(blocks[i] != NULL);
+        memset(blocks[i], i, MBED_HEAP_POOL_MAX_BLOCK);
+    }
+    EXPECT_TRUE(mbed_heap_pool_alloc(MBED_HEAP_POOL_MAX_BLOCK) == NULL);
+    EXPECT_TRUE(mbed_heap_pool_alloc(64) == NULL);
+
+    // Classes holding a slab keep serving their own blocks
+    void *small = mbed_heap_pool_alloc(16);
+    EXPECT_TRUE(small != NULL);
+    mbed_heap_pool_free(small);
+
+    for (int i = 0; i < 4; i++) {
+        EXPECT_EQ(i, ((uint8_t *)blocks[i])[MBED_HEAP_POOL_MAX_BLOCK - 1]);
+    }
+    mbed_heap_pool_free(blocks[2]);
+    EXPECT_EQ(blocks[2], mbed_heap_pool_alloc(200));
+}
@@ -0,0 +1,19 @@
+
+####################
+# UNIT TESTS
+####################
+
+set(unittest-sources
+  ../platform/source/mbed_heap_pool.c
+)
+
+set(unittest-test-sources
+  ../platform/tests/UNITTESTS/mbed_heap_pool/test_mbed_heap_pool.cpp
+  stubs/mbed_assert_stub.cpp
+  stubs/mbed_critical_stub.c
+)
+
+set(unittest-test-flags
+  -DMBED_CONF_PLATFORM_HEAP_POOL_SIZE=2048
+  -DMBED_CONF_PLATFORM_HEAP_POOL_SLAB_SIZE=512
+)
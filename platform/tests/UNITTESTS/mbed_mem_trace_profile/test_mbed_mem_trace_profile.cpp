@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2021, Arm Limited and affiliates
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+#include "platform/mbed_mem_trace.h"
+
+static uint32_t ticker_now;
+
+extern "C" uint32_t us_ticker_read()
+{
+    return ticker_now;
+}
+
+#define CALLER_A    ((void *)0x1000)
+#define CALLER_B    ((void *)0x2000)
+#define CALLER_FREE ((void *)0x3000)
+
+static void *ptr(uintptr_t value)
+{
+    return (void *)value;
+}
+
+class TestMemTraceProfile : public testing::Test {
+protected:
+    void SetUp()
+    {
+        ticker_now = 0;
+        mbed_mem_trace_profile_reset();
+        mbed_mem_trace_set_callback(mbed_mem_trace_profile_callback);
+    }
+
+    void TearDown()
+    {
+        mbed_mem_trace_set_callback(NULL);
+    }
+
+    // Trace calls as the allocation wrappers make them
+    void malloc_op(void *res, size_t size, void *caller)
+    {
+        mbed_mem_trace_lock();
+        mbed_mem_trace_malloc(res, size, caller);
+        mbed_mem_trace_unlock();
+    }
+
+    void free_op(void *p)
+    {
+        mbed_mem_trace_lock();
+        mbed_mem_trace_free(p, CALLER_FREE);
+        mbed_mem_trace_unlock();
+    }
+
+    mbed_mem_trace_site_t *find(void *caller)
+    {
+        size_t count = mbed_mem_trace_profile_get(sites, MBED_MEM_TRACE_PROFILE_SITES);
+        for (size_t i = 0; i < count; i++) {
+            if (sites[i].caller == caller) {
+                return &sites[i];
+            }
+        }
+        return NULL;
+    }
+
+    mbed_mem_trace_site_t sites[MBED_MEM_TRACE_PROFILE_SITES];
+};
+
+TEST_F(TestMemTraceProfile, aggregate_by_site)
+{
+    malloc_op(ptr(0x100), 10, CALLER_A);
+    malloc_op(ptr(0x200), 100, CALLER_A);
+    malloc_op(ptr(0x300), 5000, CALLER_B);
+    ticker_now = 1000;
+    free_op(ptr(0x100));
+    ticker_now = 3000;
+    free_op(ptr(0x300));
+
+    mbed_mem_trace_site_t *a = find(CALLER_A);
+    ASSERT_TRUE(a != NULL);
+    EXPECT_EQ(2u, a->alloc_cnt);
+    EXPECT_EQ(1u, a->free_cnt);
+    EXPECT_EQ(100u, a->current_size);
+    EXPECT_EQ(110u, a->max_size);
+    EXPECT_EQ(110u, a->total_size);
+    EXPECT_EQ(1000u, a->lifetime_avg_us);
+    EXPECT_EQ(1u, a->size_cnt[0]);
+    EXPECT_EQ(1u, a->size_cnt[3]);
+
+    mbed_mem_trace_site_t *b = find(CALLER_B);
+    ASSERT_TRUE(b != NULL);
+    EXPECT_EQ(0u, b->current_size);
+    EXPECT_EQ(3000u, b->lifetime_max_us);
+    EXPECT_EQ(1u, b->size_cnt[MBED_MEM_TRACE_PROFILE_SIZE_CLASSES - 1]);
+}
+
+TEST_F(TestMemTraceProfile, realloc_calloc)
+{
+    mbed_mem_trace_lock();
+    mbed_mem_trace_calloc(ptr(0x100), 4, 8, CALLER_A);
+    mbed_mem_trace_realloc(ptr(0x200), ptr(0x100), 64, CALLER_B);
+    // A failed realloc keeps the old allocation
+    mbed_mem_trace_realloc(NULL, ptr(0x200), 1000, CALLER_B);
+    mbed_mem_trace_unlock();
+
+    mbed_mem_trace_site_t *a = find(CALLER_A);
+    ASSERT_TRUE(a != NULL);
+    EXPECT_EQ(1u, a->free_cnt);
+    EXPECT_EQ(32u, a->total_size);
+    EXPECT_EQ(0u, a->current_size);
+
+    mbed_mem_trace_site_t *b = find(CALLER_B);
+    ASSERT_TRUE(b != NULL);
+    EXPECT_EQ(1u, b->alloc_cnt);
+    EXPECT_EQ(64u, b->current_size);
+}
+
+TEST_F(TestMemTraceProfile, untracked)
+{
+    // Frees of allocations made before profiling are not charged to any site
+    free_op(ptr(0x900));
+
+    // One allocation more than the live table holds
+    for (uintptr_t i = 1; i <= MBED_MEM_TRACE_PROFILE_LIVE + 1; i++) {
+        malloc_op(ptr(i * 8), 16, CALLER_A);
+    }
+    // Two call sites more than the site table holds, with CALLER_A
+    for (uintptr_t i = 1; i <= MBED_MEM_TRACE_PROFILE_SITES + 1; i++) {
+        free_op(ptr(i * 8));
+        malloc_op(ptr(i * 8), 16, ptr(0x4000 + i));
+    }
+    free_op(ptr((MBED_MEM_TRACE_PROFILE_LIVE + 1) * 8));
+
+    EXPECT_EQ((size_t)MBED_MEM_TRACE_PROFILE_SITES, mbed_mem_trace_profile_get(sites, MBED_MEM_TRACE_PROFILE_SITES));
+
+    uint8_t buf[512];
+    size_t size = mbed_mem_trace_profile_snapshot(NULL, 0);
+    ASSERT_EQ(4u * (5 + MBED_MEM_TRACE_PROFILE_SITES * (8 + MBED_MEM_TRACE_PROFILE_SIZE_CLASSES)), size);
+    ASSERT_LE(size, sizeof(buf));
+    EXPECT_EQ(0u, mbed_mem_trace_profile_snapshot(buf, size - 1));
+    EXPECT_EQ(size, mbed_mem_trace_profile_snapshot(buf, sizeof(buf)));
+    EXPECT_EQ(0, memcmp(buf, "MTP1", 4));
+    EXPECT_EQ(MBED_MEM_TRACE_PROFILE_SITES, buf[4]);
+    EXPECT_EQ(MBED_MEM_TRACE_PROFILE_SIZE_CLASSES, buf[8]);
+    EXPECT_EQ(3, buf[12]);
+    EXPECT_EQ(2, buf[16]);
+}
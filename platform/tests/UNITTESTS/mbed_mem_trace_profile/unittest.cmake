@@ -0,0 +1,21 @@
+
+####################
+# UNIT TESTS
+####################
+
+set(unittest-sources
+  ../platform/source/mbed_mem_trace.cpp
+  ../platform/source/mbed_mem_trace_profile.cpp
+)
+
+set(unittest-test-sources
+  ../platform/tests/UNITTESTS/mbed_mem_trace_profile/test_mbed_mem_trace_profile.cpp
+  stubs/mbed_assert_stub.cpp
+  stubs/Mutex_stub.cpp
+)
+
+set(unittest-test-flags
+  -DDEVICE_USTICKER=1
+  -DMBED_MEM_TRACE_PROFILE_SITES=4
+  -DMBED_MEM_TRACE_PROFILE_LIVE=8
+)
@@ -0,0 +1,183 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef BLOCKING_LOCK_FREE_QUEUE_H
+#define BLOCKING_LOCK_FREE_QUEUE_H
+
+#include <stdint.h>
+#include "rtos/EventFlags.h"
+#include "rtos/Kernel.h"
+#include "platform/LockFreeQueue.h"
+#include "platform/NonCopyable.h"
+#include "platform/mbed_atomic.h"
+
+namespace rtos {
+/** \addtogroup rtos-public-api */
+/** @{*/
+
+/**
+ * \defgroup rtos_BlockingLockFreeQueue BlockingLockFreeQueue class
+ * @{
+ */
+
+/** LockFreeQueue whose consumers can wait for an item
+
+ Pushing stays lock-free and free of kernel calls while no consumer is
+ waiting. Only a push that finds a waiting consumer sets the event flag
+ to wake it up.
+
+ @note
+ Memory considerations: The queue and its EventFlags are created on the current thread's stack, static or dynamic
+ RTOS memory pools are not being used.
+
+ @tparam T       Type of the items, must be trivially copyable
+ @tparam N       Capacity, must be a power of two
+ @tparam Mode    Concurrency supported, see mbed::LockFreeQueueMode
+*/
+template <typename T, uint32_t N, mbed::LockFreeQueueMode Mode = mbed::LockFreeQueueMode::spsc>
+class BlockingLockFreeQueue : private mbed::NonCopyable<BlockingLockFreeQueue<T, N, Mode> > {
+public:
+    BlockingLockFreeQueue() : _waiters(0)
+    {
+    }
+
+    /** Push an item without waiting
+
+      @param   item  item to copy into the queue.
+      @return  false if the queue is full.
+
+      @note This function may be called from ISR context.
+     */
+    bool push(const T &item)
+    {
+        if (!_queue.push(item)) {
+            return false;
+        }
+
+        // Pairs with the increment in try_pop_for(), so either the waiter
+        // sees the item or the push sees the waiter
+        if (core_util_atomic_load_u32(&_waiters)) {
+            _flags.set(NOT_EMPTY);
+        }
+        return true;
+    }
+
+    /** Pop an item without waiting
+
+      @param   item  item to copy out of the queue.
+      @return  false if the queue is empty.
+
+      @note This function may be called from ISR context.
+     */
+    bool try_pop(T &item)
+    {
+        return _queue.pop(item);
+    }
+
+    /** Wait for an item for a specified time
+
+      @param   item      item to copy out of the queue.
+      @param   rel_time  timeout value.
+      @return  false if the queue stayed empty until the timeout.
+
+      @note You cannot call this function from ISR context.
+     */
+    bool try_pop_for(T &item, Kernel::Clock::duration_u32 rel_time)
+    {
+        if (_queue.pop(item)) {
+            return true;
+        }
+        if (rel_time == rel_time.zero()) {
+            return false;
+        }
+
+        Kernel::Clock::time_point abs_time = Kernel::Clock::now() + rel_time;
+        while (true) {
+            core_util_atomic_incr_u32(&_waiters, 1);
+            bool popped = _queue.pop(item);
+            uint32_t flags = popped ? 0 : _flags.wait_any_until(NOT_EMPTY, abs_time);
+            core_util_atomic_decr_u32(&_waiters, 1);
+
+            if (popped || _queue.pop(item)) {
+                return true;
+            }
+            if (flags & osFlagsError) {
+                return false;
+            }
+        }
+    }
+
+    /** Wait for an item
+
+      @param   item  item to copy out of the queue.
+
+      @note You cannot call this function from ISR context.
+     */
+    void pop(T &item)
+    {
+        while (!try_pop_for(item, Kernel::wait_for_u32_forever)) {
+        }
+    }
+
+    /** Number of items in the queue
+
+      @return  number of items, a snapshot if other threads use the queue.
+     */
+    uint32_t size() const
+    {
+        return _queue.size();
+    }
+
+    /** Check whether the queue is empty
+
+      @return  true if the queue holds no items.
+     */
+    bool empty() const
+    {
+        return _queue.empty();
+    }
+
+    /** Check whether the queue is full
+
+      @return  true if the queue holds N items.
+     */
+    bool full() const
+    {
+        return _queue.full();
+    }
+
+private:
+    enum {
+        NOT_EMPTY = 1
+    };
+
+    mbed::LockFreeQueue<T, N, Mode> _queue;
+    EventFlags _flags;
+    volatile uint32_t _waiters;
+};
+
+/** @}*/
+/** @}*/
+
+} // namespace rtos
+
+#endif
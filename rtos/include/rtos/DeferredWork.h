@@ -0,0 +1,126 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef DEFERRED_WORK_H
+#define DEFERRED_WORK_H
+
+#include <stdint.h>
+#include "rtos/mbed_rtos_types.h"
+#include "platform/Callback.h"
+#include "platform/NonCopyable.h"
+
+#if MBED_CONF_RTOS_PRESENT || defined(DOXYGEN_ONLY)
+
+namespace rtos {
+/** \addtogroup rtos-public-api */
+/** @{*/
+
+/**
+ * \defgroup rtos_DeferredWork DeferredWork class
+ * @{
+ */
+
+/** Work deferred from an interrupt handler to a thread
+ *
+ *  An interrupt handler posts the work item, which marks it pending with a
+ *  single atomic operation, and the work then runs in the deferred work
+ *  thread. Pending work runs highest priority first, each item once however
+ *  many times it was posted since it last ran.
+ *
+ *  Unlike posting to mbed_highprio_event_queue(), posting neither allocates
+ *  nor locks, and cannot fail. The thread runs above every other priority
+ *  but the timer thread, so the latency to the work is its own run time
+ *  plus that of the higher priority items pending.
+ *
+ *  Example:
+ *  @code
+ *  #include "mbed.h"
+ *
+ *  InterruptIn button(BUTTON1);
+ *
+ *  void read_sensor() {
+ *      // Runs in thread context, so may take locks and block
+ *  }
+ *
+ *  DeferredWork sensor_work(read_sensor, 4);
+ *
+ *  int main() {
+ *      button.fall(callback(&sensor_work, &DeferredWork::post));
+ *  }
+ *  @endcode
+ *
+ * @note
+ * Memory considerations: The thread and its stack of MBED_CONF_RTOS_DEFERRED_WORK_STACK_SIZE bytes
+ * are statically allocated, and started when the first item is created.
+ *
+ * @note
+ * Bare metal profile: This class is not supported.
+ */
+class DeferredWork : private mbed::NonCopyable<DeferredWork> {
+public:
+    /** Number of priorities, which is also the maximum number of items */
+    static const uint32_t priorities = 32;
+
+    /** Register a work item
+
+      @param   work       function to run in the deferred work thread.
+      @param   priority   0, which runs first, to priorities - 1. Each item needs its own priority.
+
+      @note You cannot call this function from ISR context.
+     */
+    DeferredWork(mbed::Callback<void()> work, uint32_t priority);
+
+    /** Unregister the work item, waiting for it to finish running if it is
+
+      @note You cannot call this function from ISR context, nor from the item itself.
+     */
+    ~DeferredWork();
+
+    /** Mark the work pending, to run in the deferred work thread
+
+      @note This function may be called from ISR context.
+     */
+    void post();
+
+    /** Check if the work is pending
+
+      @return  true if posted since it last started running.
+
+      @note This function may be called from ISR context.
+     */
+    bool pending() const;
+
+private:
+    static void thread_main();
+
+    mbed::Callback<void()> _work;
+    uint32_t _priority;
+};
+
+/** @}*/
+/** @}*/
+
+} // namespace rtos
+
+#endif
+
+#endif
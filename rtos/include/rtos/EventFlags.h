@@ -29,6 +29,7 @@
 #include "rtos/mbed_rtos_types.h"
 #include "rtos/internal/mbed_rtos1_types.h"
 #include "rtos/internal/mbed_rtos_storage.h"
+#include "rtos/internal/WaitSetHook.h"
 
 #include "platform/NonCopyable.h"
 
@@ -156,12 +157,15 @@ public:
     ~EventFlags();
 
 private:
+    friend class WaitSet;
+
     void constructor(const char *name = nullptr);
     uint32_t wait_for(uint32_t flags, uint32_t opt, Kernel::Clock::duration_u32 rel_time, bool clear);
     uint32_t wait_until(uint32_t flags, uint32_t opt, Kernel::Clock::time_point abs_time, bool clear);
 
 #if MBED_CONF_RTOS_PRESENT
     osEventFlagsId_t                _id;
+    WaitSet                        *_wait_set;
     mbed_rtos_storage_event_flags_t _obj_mem;
 #else
     uint32_t _flags;
@@ -371,6 +371,8 @@ public:
     }
 
 private:
+    friend class WaitSet;
+
     Queue<T, queue_sz> _queue;
     MemoryPool<T, queue_sz> _pool;
 };
@@ -31,6 +31,7 @@
 #include "rtos/internal/mbed_rtos_storage.h"
 #include "platform/NonCopyable.h"
 #include "platform/mbed_assert.h"
+#include "platform/mbed_critical.h"
 #include "rtos/Kernel.h"
 
 
@@ -276,11 +277,162 @@ public:
         return osMemoryPoolFree(_id, block);
     }
 
+    /** Allocate several memory blocks from a memory pool, without blocking.
+      @param   blocks  array receiving the addresses of the allocated memory blocks.
+      @param   count   number of blocks to allocate.
+      @return          number of blocks allocated, less than count if the pool ran out.
+
+      @note You may call this function from ISR context.
+      @note The blocks are taken in a single critical section, where the kernel is
+            called directly rather than through an SVC, so keep count small.
+    */
+    uint32_t alloc_batch(T **blocks, uint32_t count)
+    {
+        uint32_t i;
+        core_util_critical_section_enter();
+        for (i = 0; i < count; i++) {
+            blocks[i] = (T *)osMemoryPoolAlloc(_id, 0);
+            if (blocks[i] == nullptr) {
+                break;
+            }
+        }
+        core_util_critical_section_exit();
+        return i;
+    }
+
+    /** Free several memory blocks.
+      @param   blocks  array of addresses of the memory blocks to be freed.
+      @param   count   number of blocks to free.
+      @return          osOK if all blocks were freed, otherwise the error of the first
+                       block that could not be freed, see free().
+
+      @note You may call this function from ISR context.
+      @note Unlike alloc_batch(), the blocks are freed one kernel call at a time: a free
+            from a critical section queues a post-processing request each, and the
+            kernel's ISR queue only has room for a few of them.
+    */
+    osStatus free_batch(T *const *blocks, uint32_t count)
+    {
+        osStatus status = osOK;
+        for (uint32_t i = 0; i < count; i++) {
+            osStatus ret = osMemoryPoolFree(_id, blocks[i]);
+            if (status == osOK) {
+                status = ret;
+            }
+        }
+        return status;
+    }
+
 private:
     osMemoryPoolId_t             _id;
     char                         _pool_mem[MBED_RTOS_STORAGE_MEM_POOL_MEM_SIZE(pool_sz, sizeof(T))];
     mbed_rtos_storage_mem_pool_t _obj_mem;
 };
+
+/** Cache of memory blocks taken from a MemoryPool, owned by a single thread.
+
+ Blocks are allocated from and freed into a small magazine without entering the
+ kernel. The magazine is refilled with half its size through alloc_batch() when
+ it runs empty, and spills half its size through free_batch() when it overflows,
+ so heavy users of a shared pool pay for a pool access every few blocks only.
+
+ Each thread allocating at a high rate, for example a driver thread filling Mail
+ messages, creates its own cache. Blocks may be freed into another thread's pool
+ or cache.
+
+  @tparam  T         data type of a single object (element).
+  @tparam  pool_sz   maximum number of objects (elements) in the memory pool.
+  @tparam  cache_sz  number of blocks the cache can hold (default: 8).
+
+ @note
+ Synchronization level: Not protected. A cache must only be used by one thread.
+ Blocks held by caches are not available to other users of the pool.
+*/
+template<typename T, uint32_t pool_sz, uint32_t cache_sz = 8>
+class MemoryPoolCache : private mbed::NonCopyable<MemoryPoolCache<T, pool_sz, cache_sz> > {
+    static_assert(cache_sz > 1, "Invalid memory pool cache size. Must be greater than 1.");
+public:
+    /** Create an empty cache for a memory pool.
+      @param   pool  memory pool to take the blocks from.
+    */
+    MemoryPoolCache(MemoryPool<T, pool_sz> &pool) : _pool(pool), _count(0)
+    {
+    }
+
+    /** Return the cached blocks to the pool.
+    */
+    ~MemoryPoolCache()
+    {
+        flush();
+    }
+
+    /** Allocate a memory block from the cache, refilling it from the pool if needed.
+      @return  address of the allocated memory block or nullptr in case of no memory available.
+    */
+    T *try_alloc()
+    {
+        if (_count == 0) {
+            _count = _pool.alloc_batch(_blocks, cache_sz / 2);
+            if (_count == 0) {
+                return nullptr;
+            }
+        }
+        return _blocks[--_count];
+    }
+
+    /** Allocate a memory block from the cache and set memory block to zero.
+      @return  address of the allocated memory block or nullptr in case of no memory available.
+    */
+    T *try_calloc()
+    {
+        T *item = try_alloc();
+        if (item != nullptr) {
+            memset(item, 0, sizeof(T));
+        }
+        return item;
+    }
+
+    /** Free a memory block into the cache, returning half of the cache to the pool if it is full.
+      @param   block  address of the allocated memory block to be freed.
+      @return         osOK on success, or the error of returning blocks to the pool, see MemoryPool::free().
+    */
+    osStatus free(T *block)
+    {
+        osStatus status = osOK;
+        if (block == nullptr) {
+            return osErrorParameter;
+        }
+        if (_count == cache_sz) {
+            _count -= cache_sz / 2;
+            status = _pool.free_batch(&_blocks[_count], cache_sz / 2);
+        }
+        _blocks[_count++] = block;
+        return status;
+    }
+
+    /** Return all cached blocks to the pool.
+      @return  osOK on success, or the error of returning blocks to the pool, see MemoryPool::free().
+    */
+    osStatus flush()
+    {
+        osStatus status = _pool.free_batch(_blocks, _count);
+        _count = 0;
+        return status;
+    }
+
+    /** Number of blocks held by the cache.
+      @return  number of blocks that can be allocated without accessing the pool.
+    */
+    uint32_t size() const
+    {
+        return _count;
+    }
+
+private:
+    MemoryPool<T, pool_sz> &_pool;
+    uint32_t _count;
+    T *_blocks[cache_sz];
+};
 /** @}*/
 /** @}*/
 }
@@ -32,6 +32,7 @@
 #include "platform/NonCopyable.h"
 #include "platform/ScopedLock.h"
 #include "platform/mbed_toolchain.h"
+#include "platform/mbed_stats.h"
 
 namespace rtos {
 /** \addtogroup rtos-public-api */
@@ -164,6 +165,28 @@ public:
      */
     osThreadId_t get_owner();
 
+#if MBED_MUTEX_STATS_ENABLED || defined(DOXYGEN_ONLY)
+    /** Get the contention statistics of this mutex
+
+      Requires MBED_MUTEX_STATS_ENABLED, which also makes every contended
+      lock try the mutex once before blocking so the contention can be
+      counted. Hot mutexes show up as a high contended count relative to
+      acquisitions, or as a long maximum hold time.
+
+      @param   stats  pointer to the structure to fill
+      @note In bare-metal builds, all statistics are zero.
+
+      @note You cannot call this function from ISR context.
+     */
+    void get_stats(mbed_stats_mutex_t *stats);
+
+    /** Reset the contention statistics of this mutex
+
+      @note You cannot call this function from ISR context.
+     */
+    void reset_stats();
+#endif
+
     /** Mutex destructor
      *
      * @note You cannot call this function from ISR context.
@@ -178,6 +201,14 @@ private:
     osMutexId_t               _id;
     mbed_rtos_storage_mutex_t _obj_mem;
     uint32_t                  _count;
+#if MBED_MUTEX_STATS_ENABLED
+    void stats_acquired(bool contended);
+
+    uint32_t                  _acquisitions;
+    uint32_t                  _contended;
+    uint32_t                  _hold_start;
+    uint32_t                  _hold_max;
+#endif
 #endif
 };
 
@@ -226,6 +257,19 @@ inline bool Mutex::trylock_until(Kernel::Clock::time_point)
 inline void Mutex::unlock()
 {
 }
+
+#if MBED_MUTEX_STATS_ENABLED
+inline void Mutex::get_stats(mbed_stats_mutex_t *stats)
+{
+    stats->acquisitions = 0;
+    stats->contended = 0;
+    stats->max_hold_us = 0;
+}
+
+inline void Mutex::reset_stats()
+{
+}
+#endif
 #endif
 
 /** @}*/
@@ -26,6 +26,7 @@
 #include "rtos/mbed_rtos_types.h"
 #include "rtos/internal/mbed_rtos1_types.h"
 #include "rtos/internal/mbed_rtos_storage.h"
+#include "rtos/internal/WaitSetHook.h"
 #include "rtos/Kernel.h"
 #include "platform/mbed_error.h"
 #include "platform/NonCopyable.h"
@@ -79,6 +80,7 @@ public:
         attr.cb_size = sizeof(_obj_mem);
         _id = osMessageQueueNew(queue_sz, sizeof(T *), &attr);
         MBED_ASSERT(_id);
+        _wait_set = nullptr;
     }
 
     /** Queue destructor
@@ -175,7 +177,11 @@ public:
     bool try_put_for(Kernel::Clock::duration_u32 rel_time, T *data, uint8_t prio = 0)
     {
         osStatus status = osMessageQueuePut(_id, &data, prio, rel_time.count());
-        return status == osOK;
+        if (status != osOK) {
+            return false;
+        }
+        internal::wait_set_signal(_wait_set);
+        return true;
     }
 
     /** Inserts the given element to the end of the queue.
@@ -218,7 +224,11 @@ public:
     MBED_DEPRECATED_SINCE("mbed-os-6.0.0", "Replaced with try_put and try_put_for. In future put will be an untimed blocking call.")
     osStatus put(T *data, uint32_t millisec = 0, uint8_t prio = 0)
     {
-        return osMessageQueuePut(_id, &data, prio, millisec);
+        osStatus status = osMessageQueuePut(_id, &data, prio, millisec);
+        if (status == osOK) {
+            internal::wait_set_signal(_wait_set);
+        }
+        return status;
     }
 
     /** Get a message from the queue.
@@ -335,7 +345,10 @@ public:
         return event;
     }
 private:
+    friend class WaitSet;
+
     osMessageQueueId_t            _id;
+    WaitSet                      *_wait_set;
     char                          _queue_mem[queue_sz * (sizeof(T *) + sizeof(mbed_rtos_storage_message_t))];
     mbed_rtos_storage_msg_queue_t _obj_mem;
 };
@@ -28,6 +28,7 @@
 #include "rtos/mbed_rtos_types.h"
 #include "rtos/internal/mbed_rtos1_types.h"
 #include "rtos/internal/mbed_rtos_storage.h"
+#include "rtos/internal/WaitSetHook.h"
 #include "rtos/Kernel.h"
 #include "platform/mbed_toolchain.h"
 #include "platform/NonCopyable.h"
@@ -140,12 +141,15 @@ public:
     ~Semaphore();
 
 private:
+    friend class WaitSet;
+
     void constructor(int32_t count, uint16_t max_count);
 
 #if MBED_CONF_RTOS_PRESENT
     int32_t _wait(uint32_t millisec);
 
     osSemaphoreId_t               _id;
+    WaitSet                      *_wait_set;
     mbed_rtos_storage_semaphore_t _obj_mem;
 #else
     static bool semaphore_available(void *);
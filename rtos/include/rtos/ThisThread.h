@@ -24,6 +24,7 @@
 #define THIS_THREAD_H
 
 #include <stdint.h>
+#include <chrono>
 #include "platform/mbed_toolchain.h"
 #include "rtos/Kernel.h"
 #include "rtos/mbed_rtos_types.h"
@@ -222,6 +223,24 @@ void sleep_for(uint32_t millisec);
 */
 void sleep_for(Kernel::Clock::duration_u32 rel_time);
 
+#if !defined(DOXYGEN_ONLY)
+void high_res_sleep_for(std::chrono::microseconds rel_time);
+#endif
+
+/** Sleep for a specified time period, with microsecond resolution:
+  The delay is timed by a one-shot event on the us ticker rather than by the
+  RTOS tick, so it is not rounded to the tick period. Whole ticks of a
+  longer delay are still slept through the RTOS, and only the remainder
+  keeps deep sleep locked.
+  @param   rel_time  time delay value, for example `250us`
+  @note You cannot call this function from ISR context.
+*/
+template<typename Rep>
+void sleep_for(std::chrono::duration<Rep, std::micro> rel_time)
+{
+    high_res_sleep_for(std::chrono::microseconds(rel_time));
+}
+
 
 /** Sleep until a specified time in millisec
   The specified time is according to Kernel::get_ms_count().
@@ -229,6 +229,8 @@ public:
     /** Get the maximum stack memory usage to date for this Thread
       @return  the maximum stack memory usage to date in bytes
 
+      @note With MBED_STACK_STATS_SAMPLED this is the maximum seen at context
+            switches, which keeps it cheap but may miss the deepest use.
       @note You cannot call this function from ISR context.
     */
     uint32_t max_stack() const;
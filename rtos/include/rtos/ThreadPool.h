@@ -0,0 +1,177 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <stdint.h>
+#include "rtos/mbed_rtos_types.h"
+#include "rtos/EventFlags.h"
+#include "rtos/Semaphore.h"
+#include "rtos/Thread.h"
+#include "platform/Callback.h"
+#include "platform/NonCopyable.h"
+
+#if MBED_CONF_RTOS_PRESENT || defined(DOXYGEN_ONLY)
+
+namespace rtos {
+/** \addtogroup rtos-public-api */
+/** @{*/
+
+/**
+ * \defgroup rtos_ThreadPool ThreadPool class
+ * @{
+ */
+
+/** Fixed set of worker threads running submitted tasks
+ *
+ *  Subsystems that only need to run short jobs in thread context can share
+ *  a pool instead of each creating a Thread and EventQueue pair with its
+ *  own stack.
+ *
+ *  Each worker has its own deque of tasks. A task submitted by a worker is
+ *  queued on that worker and run last in, first out, other tasks are spread
+ *  over the workers in turn and run first in, first out. A worker with
+ *  nothing left to run steals the oldest task of another worker, so a long
+ *  task does not hold up the tasks queued behind it while another worker is
+ *  idle.
+ *
+ *  Example:
+ *  @code
+ *  #include "mbed.h"
+ *
+ *  ThreadPool pool(2);
+ *  EventFlags done;
+ *
+ *  void crunch(int *block) {
+ *      // ...
+ *  }
+ *
+ *  int main() {
+ *      static int blocks[4];
+ *      pool.start();
+ *      for (int i = 0; i < 4; i++) {
+ *          pool.submit(callback(crunch, &blocks[i]), &done, 1 << i);
+ *      }
+ *      done.wait_all(0xF);
+ *  }
+ *  @endcode
+ *
+ * @note
+ * Memory considerations: The worker threads, their stacks and deques are allocated on the heap
+ * when the pool is created.
+ *
+ * @note
+ * Bare metal profile: This class is not supported.
+ */
+class ThreadPool : private mbed::NonCopyable<ThreadPool> {
+public:
+    /** Create a pool without starting the workers
+
+      @param   workers     number of worker threads.
+      @param   depth       number of tasks each worker can queue (default: 8).
+      @param   priority    priority of the worker threads (default: osPriorityNormal).
+      @param   stack_size  stack size (in bytes) of each worker thread (default: OS_STACK_SIZE).
+      @param   name        name of the worker threads. It has to stay allocated for the lifetime of the pool (default: nullptr)
+
+      @note You cannot call this function from ISR context.
+     */
+    ThreadPool(uint32_t workers, uint32_t depth = 8, osPriority priority = osPriorityNormal,
+               uint32_t stack_size = OS_STACK_SIZE, const char *name = nullptr);
+
+    /** Run the queued tasks, then stop the workers and free the pool
+
+      @note You cannot call this function from ISR context.
+     */
+    ~ThreadPool();
+
+    /** Start the worker threads
+
+      @return  status code that indicates the execution status of the function.
+      @note A pool can only be started once. Tasks submitted before start run once started.
+      @note You cannot call this function from ISR context.
+     */
+    osStatus start();
+
+    /** Submit a task to the pool
+
+      @param   task   function to run on a worker thread.
+      @param   done   event flags to set once the task has run (default: nullptr).
+      @param   flags  flags to set in done (default: 0).
+      @return  false if the deques are full.
+
+      @note This function may be called from ISR context.
+     */
+    bool submit(mbed::Callback<void()> task, EventFlags *done = nullptr, uint32_t flags = 0);
+
+    /** Number of worker threads
+
+      @return  number of workers given to the constructor.
+     */
+    uint32_t workers() const
+    {
+        return _worker_count;
+    }
+
+private:
+    struct Task {
+        mbed::Callback<void()> fn;
+        EventFlags *done;
+        uint32_t flags;
+        bool local;     // Submitted by the worker it is queued on
+    };
+
+    struct Worker {
+        ThreadPool *pool;
+        Thread *thread;
+        Task *tasks;
+        uint32_t head;
+        uint32_t count;
+
+        void run()
+        {
+            pool->worker_main(this);
+        }
+    };
+
+    bool push(Worker *worker, const Task &task);
+    bool pop_own(Worker *worker, Task &task);
+    bool pop_front(Worker *worker, Task &task);
+    bool take(Worker *self, Task &task);
+    void worker_main(Worker *self);
+
+    Worker *_workers;
+    uint32_t _worker_count;
+    uint32_t _depth;
+    uint32_t _next;
+    uint32_t _started;
+    Semaphore _pending;
+};
+
+/** @}*/
+/** @}*/
+
+} // namespace rtos
+
+#endif
+
+#endif
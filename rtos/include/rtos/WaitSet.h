@@ -0,0 +1,252 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef WAIT_SET_H
+#define WAIT_SET_H
+
+#include <stdint.h>
+#include "rtos/mbed_rtos_types.h"
+#include "rtos/Kernel.h"
+#include "rtos/Queue.h"
+#include "rtos/Mail.h"
+#include "rtos/Semaphore.h"
+#include "rtos/EventFlags.h"
+#include "platform/Callback.h"
+#include "platform/NonCopyable.h"
+
+#if MBED_CONF_RTOS_PRESENT || defined(DOXYGEN_ONLY)
+
+#ifndef MBED_CONF_RTOS_WAIT_SET_MAX_MEMBERS
+#define MBED_CONF_RTOS_WAIT_SET_MAX_MEMBERS 8
+#endif
+
+namespace rtos {
+/** \addtogroup rtos-public-api */
+/** @{*/
+
+/**
+ * \defgroup rtos_WaitSet WaitSet class
+ * @{
+ */
+
+/** Wait on several RTOS objects at once
+ *
+ *  Queues, Mail boxes, Semaphores and EventFlags are added to the set, and
+ *  wait() blocks until one of them is ready: a Queue or Mail box which is
+ *  not empty, a Semaphore with a token, or EventFlags with one of the given
+ *  flags set. It returns the index of that member, and the caller then gets
+ *  from it without blocking. Other sources, such as a socket, are added as a
+ *  readiness function and call notify() when their state changes, from their
+ *  sigio callback for example.
+ *
+ *  The primitives wake the waiting thread when they are put to, released or
+ *  set, so the set is not polled. A primitive which is in no set pays one
+ *  load for that.
+ *
+ *  Example:
+ *  @code
+ *  #include "mbed.h"
+ *
+ *  Queue<message_t, 8> commands;
+ *  Mail<packet_t, 4> packets;
+ *
+ *  void service_thread() {
+ *      WaitSet set;
+ *      int command_index = set.add(commands);
+ *      int packet_index = set.add(packets);
+ *      while (true) {
+ *          int index = set.wait();
+ *          if (index == command_index) {
+ *              message_t *message;
+ *              if (commands.try_get(&message)) {
+ *                  // handle the command
+ *              }
+ *          } else if (index == packet_index) {
+ *              packet_t *packet = packets.try_get();
+ *              if (packet) {
+ *                  // handle the packet
+ *                  packets.free(packet);
+ *              }
+ *          }
+ *      }
+ *  }
+ *  @endcode
+ *
+ * @note
+ * A primitive can be in a single set at a time, and must be removed from
+ * it, or the set destroyed, before the primitive is. When several members
+ * are ready, wait() takes them in turn, so that none is starved.
+ *
+ * @note
+ * The set reserves thread flag WaitSet::thread_flag of the thread which
+ * waits on it.
+ *
+ * @note
+ * Synchronization level: add(), remove() and wait() are called from the
+ * thread owning the set, notify() is thread and interrupt safe. Returning
+ * ready does not take the object, so a member shared with other consumers
+ * may be empty again when it is read.
+ *
+ * @note
+ * Bare metal profile: This class is not supported.
+ */
+class WaitSet : private mbed::NonCopyable<WaitSet> {
+public:
+    /** Maximum number of members, set with MBED_CONF_RTOS_WAIT_SET_MAX_MEMBERS */
+    static constexpr int max_members = MBED_CONF_RTOS_WAIT_SET_MAX_MEMBERS;
+
+    /** Thread flag of the waiting thread used to wake it */
+    static constexpr uint32_t thread_flag = 0x40000000;
+
+    /** Create an empty set
+     */
+    WaitSet();
+
+    /** Remove every member and destroy the set
+     *
+     *  @note You cannot call this function while a thread waits on the set.
+     */
+    ~WaitSet();
+
+    /** Add a Queue, ready when it is not empty
+     *
+     *  @param queue    Queue, not in any set
+     *  @return         Index of the member, or -1 if the set is full or the
+     *                  queue is in a set already
+     */
+    template<typename T, uint32_t queue_sz>
+    int add(Queue<T, queue_sz> &queue)
+    {
+        return add(member_t{mbed::callback(queue_ready<T, queue_sz>, &queue), nullptr, 0, &queue._wait_set});
+    }
+
+    /** Add a Mail box, ready when it is not empty
+     *
+     *  @param mail     Mail box, not in any set
+     *  @return         Index of the member, or -1 if the set is full or the
+     *                  mail box is in a set already
+     */
+    template<typename T, uint32_t queue_sz>
+    int add(Mail<T, queue_sz> &mail)
+    {
+        return add(member_t{mbed::callback(queue_ready<T, queue_sz>, &mail._queue), nullptr, 0, &mail._queue._wait_set});
+    }
+
+    /** Add a Semaphore, ready when it has a token
+     *
+     *  @param semaphore    Semaphore, not in any set
+     *  @return             Index of the member, or -1 if the set is full or
+     *                      the semaphore is in a set already
+     */
+    int add(Semaphore &semaphore);
+
+    /** Add EventFlags, ready when any of the flags is set
+     *
+     *  @param event_flags  EventFlags, not in any set
+     *  @param flags        Flags to wait for
+     *  @return             Index of the member, or -1 if the set is full or
+     *                      the event flags are in a set already
+     */
+    int add(EventFlags &event_flags, uint32_t flags);
+
+    /** Add another source of events
+     *
+     *  The source calls notify() after it may have become ready.
+     *
+     *  @param ready    Function returning whether the source is ready,
+     *                  called from the waiting thread
+     *  @return         Index of the member, or -1 if the set is full
+     */
+    int add(mbed::Callback<bool()> ready);
+
+    /** Remove a member
+     *
+     *  The index may then be returned by a later add().
+     *
+     *  @param index    Index returned by add()
+     */
+    void remove(int index);
+
+    /** Wait until a member is ready
+     *
+     *  @return     Index of the ready member
+     */
+    int wait();
+
+    /** Wait until a member is ready, or for a timeout
+     *
+     *  @param rel_time     Timeout, or Kernel::wait_for_u32_forever
+     *  @return             Index of the ready member, or -1 on timeout
+     */
+    int wait_for(Kernel::Clock::duration_u32 rel_time);
+
+    /** Wait until a member is ready, or until a time
+     *
+     *  @param abs_time     Absolute timeout time, referenced to Kernel::Clock
+     *  @return             Index of the ready member, or -1 on timeout
+     */
+    int wait_until(Kernel::Clock::time_point abs_time);
+
+    /** Wake the waiting thread to check the members again
+     *
+     *  @note You may call this function from ISR context.
+     */
+    void notify();
+
+#if !defined(DOXYGEN_ONLY)
+private:
+    friend void internal::wait_set_notify(WaitSet *const *hook);
+
+    struct member_t {
+        mbed::Callback<bool()> ready;
+        EventFlags *event_flags;
+        uint32_t flags;
+        WaitSet **hook;
+    };
+
+    template<typename T, uint32_t queue_sz>
+    static bool queue_ready(Queue<T, queue_sz> *queue)
+    {
+        return !queue->empty();
+    }
+
+    static bool semaphore_ready(Semaphore *semaphore);
+
+    int add(member_t member);
+    bool is_ready(const member_t &member) const;
+    int ready_member();
+    int wait(Kernel::Clock::time_point abs_time, bool forever);
+
+    member_t _members[max_members];
+    osThreadId_t _waiter;
+    int _next;
+#endif
+};
+
+/** @}*/
+/** @}*/
+
+} // namespace rtos
+
+#endif // MBED_CONF_RTOS_PRESENT || defined(DOXYGEN_ONLY)
+
+#endif // WAIT_SET_H
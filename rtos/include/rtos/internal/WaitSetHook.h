@@ -0,0 +1,57 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef WAIT_SET_HOOK_H
+#define WAIT_SET_HOOK_H
+
+#if MBED_CONF_RTOS_PRESENT
+
+namespace rtos {
+
+class WaitSet;
+
+namespace internal {
+
+/** Wake the thread waiting on the WaitSet the hook points to, if any
+ *
+ *  The hook is read again under a critical section, so that the WaitSet
+ *  can be unregistered concurrently.
+ */
+void wait_set_notify(WaitSet *const *hook);
+
+/** Notify the hook of a primitive which may have become ready
+ *
+ *  Costs a single load when the primitive is in no WaitSet.
+ */
+inline void wait_set_signal(WaitSet *const &hook)
+{
+    if (hook != nullptr) {
+        wait_set_notify(&hook);
+    }
+}
+
+} // namespace internal
+} // namespace rtos
+
+#endif // MBED_CONF_RTOS_PRESENT
+
+#endif // WAIT_SET_HOOK_H
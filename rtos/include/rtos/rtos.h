@@ -27,6 +27,8 @@
 #include "rtos/internal/mbed_rtos_storage.h"
 #include "rtos/Kernel.h"
 #include "rtos/Thread.h"
+#include "rtos/ThreadPool.h"
+#include "rtos/DeferredWork.h"
 #include "rtos/ThisThread.h"
 #include "rtos/Mutex.h"
 #include "rtos/Semaphore.h"
@@ -34,7 +36,9 @@
 #include "rtos/MemoryPool.h"
 #include "rtos/Queue.h"
 #include "rtos/EventFlags.h"
+#include "rtos/BlockingLockFreeQueue.h"
 #include "rtos/ConditionVariable.h"
+#include "rtos/WaitSet.h"
 
 
 /** \defgroup rtos-public-api RTOS
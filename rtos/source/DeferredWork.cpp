@@ -0,0 +1,135 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "cmsis.h"
+#include "rtos/DeferredWork.h"
+#include "rtos/ThisThread.h"
+#include "rtos/Thread.h"
+#include "platform/mbed_assert.h"
+#include "platform/mbed_atomic.h"
+#include "platform/mbed_critical.h"
+#include "platform/mbed_error.h"
+
+#if MBED_CONF_RTOS_PRESENT
+
+#ifndef MBED_CONF_RTOS_DEFERRED_WORK_STACK_SIZE
+#define MBED_CONF_RTOS_DEFERRED_WORK_STACK_SIZE 1024
+#endif
+
+#ifndef MBED_CONF_RTOS_DEFERRED_WORK_PRIORITY
+#define MBED_CONF_RTOS_DEFERRED_WORK_PRIORITY   osPriorityRealtime
+#endif
+
+#define DEFERRED_WORK_FLAG  1
+
+using namespace std::chrono_literals;
+
+namespace rtos {
+
+// Bit n set when items[n] is pending
+static volatile uint32_t deferred_pending;
+static DeferredWork *deferred_items[DeferredWork::priorities];
+static DeferredWork *volatile deferred_running;
+static osThreadId_t deferred_thread_id;
+
+DeferredWork::DeferredWork(mbed::Callback<void()> work, uint32_t priority)
+    : _work(work), _priority(priority)
+{
+    static uint64_t stack[MBED_CONF_RTOS_DEFERRED_WORK_STACK_SIZE / sizeof(uint64_t)];
+    static Thread thread(MBED_CONF_RTOS_DEFERRED_WORK_PRIORITY, sizeof(stack), (unsigned char *)stack, "deferred_work");
+
+    Thread::State state = thread.get_state();
+    if (state == Thread::Inactive || state == Thread::Deleted) {
+        osStatus status = thread.start(thread_main);
+        if (status != osOK) {
+            MBED_ERROR1(MBED_MAKE_ERROR(MBED_MODULE_KERNEL, MBED_ERROR_CODE_THREAD_CREATE_FAILED), "Deferred work thread not created", status);
+        }
+        deferred_thread_id = thread.get_id();
+    }
+
+    core_util_critical_section_enter();
+    bool taken = priority >= priorities || deferred_items[priority] != nullptr;
+    if (!taken) {
+        deferred_items[priority] = this;
+    }
+    core_util_critical_section_exit();
+
+    if (taken) {
+        MBED_ERROR1(MBED_MAKE_ERROR(MBED_MODULE_KERNEL, MBED_ERROR_CODE_ALREADY_IN_USE), "Deferred work priority taken", priority);
+    }
+}
+
+DeferredWork::~DeferredWork()
+{
+    MBED_ASSERT(ThisThread::get_id() != deferred_thread_id);
+
+    core_util_critical_section_enter();
+    deferred_items[_priority] = nullptr;
+    core_util_atomic_fetch_and_u32(&deferred_pending, ~(1UL << _priority));
+    core_util_critical_section_exit();
+
+    // The item can only be running here if it blocked, so let it finish
+    while (deferred_running == this) {
+        ThisThread::sleep_for(1ms);
+    }
+}
+
+void DeferredWork::post()
+{
+    // Only the first item posted while the thread is idle wakes it up
+    if (core_util_atomic_fetch_or_u32(&deferred_pending, 1UL << _priority) == 0) {
+        osThreadFlagsSet(deferred_thread_id, DEFERRED_WORK_FLAG);
+    }
+}
+
+bool DeferredWork::pending() const
+{
+    return core_util_atomic_load_u32(&deferred_pending) & (1UL << _priority);
+}
+
+void DeferredWork::thread_main()
+{
+    while (true) {
+        ThisThread::flags_wait_any(DEFERRED_WORK_FLAG);
+
+        uint32_t pending;
+        while ((pending = core_util_atomic_load_u32(&deferred_pending)) != 0) {
+            // Lowest bit first, rereading the pending items after each one
+            uint32_t priority = 31 - __CLZ(pending & -pending);
+
+            core_util_critical_section_enter();
+            core_util_atomic_fetch_and_u32(&deferred_pending, ~(1UL << priority));
+            DeferredWork *item = deferred_items[priority];
+            deferred_running = item;
+            core_util_critical_section_exit();
+
+            if (item) {
+                item->_work();
+            }
+            deferred_running = nullptr;
+        }
+    }
+}
+
+} // namespace rtos
+
+#endif
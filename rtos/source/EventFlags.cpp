@@ -51,6 +51,7 @@ void EventFlags::constructor(const char *name)
     attr.cb_size = sizeof(_obj_mem);
     _id = osEventFlagsNew(&attr);
     MBED_ASSERT(_id);
+    _wait_set = nullptr;
 #else
     _flags = 0;
 #endif
@@ -59,7 +60,11 @@ void EventFlags::constructor(const char *name)
 uint32_t EventFlags::set(uint32_t flags)
 {
 #if MBED_CONF_RTOS_PRESENT
-    return osEventFlagsSet(_id, flags);
+    uint32_t result = osEventFlagsSet(_id, flags);
+    if (!(result & osFlagsError)) {
+        internal::wait_set_signal(_wait_set);
+    }
+    return result;
 #else
     return core_util_atomic_fetch_or_u32(&_flags, flags) | flags;
 #endif
@@ -25,6 +25,7 @@
 #include "rtos_idle.h"
 #include "rtos_handlers.h"
 #include "platform/mbed_critical.h"
+#include "platform/mbed_atomic.h"
 #include "platform/internal/mbed_os_timer.h"
 
 #if !MBED_CONF_RTOS_PRESENT
@@ -55,26 +56,27 @@ uint64_t Kernel::impl::get_tick_count()
     if (sizeof osKernelGetTickCount() == sizeof(uint64_t)) {
         return osKernelGetTickCount();
     } else { /* assume 32-bit */
-        // Based on suggestion in CMSIS-RTOS 2.1.1 docs, but with reentrancy
-        // protection for the tick memory. We use critical section rather than a
-        // mutex, as hopefully this method can be callable from interrupt later -
-        // only thing currently preventing it is that pre CMSIS RTOS 2.1.1, it's
-        // not defined as safe.
-        // We assume this is called multiple times per 32-bit wrap period (49 days).
-        static uint32_t tick_h, tick_l;
+        // Based on suggestion in CMSIS-RTOS 2.1.1 docs, without locking: the
+        // high word and the top bit of the last tick read share one word, which
+        // is only written when the top bit changes, twice per 32-bit wrap.
+        // The tick is read after the state, so a wrap between the two is
+        // counted, and a failed update means another caller already did it.
+        // We assume this is called at least once per half 32-bit wrap period
+        // (24 days).
+        static uint32_t tick_state;
 
-        core_util_critical_section_enter();
-        // The 2.1.1 API says this is legal from an ISR - we assume this means
-        // it's also legal with interrupts disabled. RTX implementation kind
-        // of conflates the two.
+        uint32_t state = core_util_atomic_load_u32(&tick_state);
+        // The 2.1.1 API says this is legal from an ISR
         uint32_t tick32 = osKernelGetTickCount();
-        if (tick32 < tick_l) {
-            tick_h++;
+        uint32_t tick_h = state >> 1;
+        uint32_t top = tick32 >> 31;
+        if (top != (state & 1)) {
+            if (top == 0) {
+                tick_h++;
+            }
+            core_util_atomic_cas_u32(&tick_state, &state, (tick_h << 1) | top);
         }
-        tick_l = tick32;
-        uint64_t ret = ((uint64_t) tick_h << 32) | tick_l;
-        core_util_critical_section_exit();
-        return ret;
+        return ((uint64_t) tick_h << 32) | tick32;
     }
 #else
     return ::get_ms_count();
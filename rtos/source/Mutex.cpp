@@ -48,6 +48,12 @@ Mutex::Mutex(const char *name)
 void Mutex::constructor(const char *name)
 {
     _count = 0;
+#if MBED_MUTEX_STATS_ENABLED
+    _acquisitions = 0;
+    _contended = 0;
+    _hold_start = 0;
+    _hold_max = 0;
+#endif
     osMutexAttr_t attr =
     { 0 };
     attr.name = name ? name : "application_unnamed_mutex";
@@ -63,10 +69,23 @@ void Mutex::constructor(const char *name)
 
 void Mutex::lock(void)
 {
+#if MBED_MUTEX_STATS_ENABLED
+    bool contended = false;
+    osStatus status = osMutexAcquire(_id, 0);
+    if (status == osErrorResource) {
+        contended = true;
+        status = osMutexAcquire(_id, osWaitForever);
+    }
+    if (osOK == status) {
+        _count++;
+        stats_acquired(contended);
+    }
+#else
     osStatus status = osMutexAcquire(_id, osWaitForever);
     if (osOK == status) {
         _count++;
     }
+#endif
 
     if (status != osOK && !mbed_get_error_in_progress()) {
         MBED_ERROR1(MBED_MAKE_ERROR(MBED_MODULE_KERNEL, MBED_ERROR_CODE_MUTEX_LOCK_FAILED), "Mutex lock failed", status);
@@ -85,11 +104,25 @@ bool Mutex::trylock_for(uint32_t millisec)
 
 bool Mutex::trylock_for(Kernel::Clock::duration_u32 rel_time)
 {
+#if MBED_MUTEX_STATS_ENABLED
+    bool contended = false;
+    osStatus status = osMutexAcquire(_id, 0);
+    if (status == osErrorResource && rel_time != rel_time.zero()) {
+        contended = true;
+        status = osMutexAcquire(_id, rel_time.count());
+    }
+    if (status == osOK) {
+        _count++;
+        stats_acquired(contended);
+        return true;
+    }
+#else
     osStatus status = osMutexAcquire(_id, rel_time.count());
     if (status == osOK) {
         _count++;
         return true;
     }
+#endif
 
     bool success = (status == osOK ||
                     (status == osErrorResource && rel_time == rel_time.zero()) ||
@@ -126,6 +159,16 @@ void Mutex::unlock()
     // Count must be adjusted inside the lock. This would leave it incorrect
     // on failure, but it only is used for an assert in ConditionVariable,
     // and a mutex release failure means MBED_ERROR anyway.
+#if MBED_MUTEX_STATS_ENABLED
+    // Same for the hold time, which must be taken before another thread
+    // can acquire the mutex and restart it.
+    if (_count == 1) {
+        uint32_t held = osKernelGetSysTimerCount() - _hold_start;
+        if (held > _hold_max) {
+            _hold_max = held;
+        }
+    }
+#endif
     _count--;
 
     osStatus status = osMutexRelease(_id);
@@ -140,6 +183,34 @@ osThreadId Mutex::get_owner()
     return osMutexGetOwner(_id);
 }
 
+#if MBED_MUTEX_STATS_ENABLED
+void Mutex::stats_acquired(bool contended)
+{
+    // Only called with the mutex held, which serializes the updates
+    _acquisitions++;
+    if (contended) {
+        _contended++;
+    }
+    if (_count == 1) {
+        _hold_start = osKernelGetSysTimerCount();
+    }
+}
+
+void Mutex::get_stats(mbed_stats_mutex_t *stats)
+{
+    stats->acquisitions = _acquisitions;
+    stats->contended = _contended;
+    stats->max_hold_us = (uint64_t)_hold_max * 1000000 / osKernelGetSysTimerFreq();
+}
+
+void Mutex::reset_stats()
+{
+    _acquisitions = 0;
+    _contended = 0;
+    _hold_max = 0;
+}
+#endif
+
 Mutex::~Mutex()
 {
     osMutexDelete(_id);
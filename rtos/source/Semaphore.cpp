@@ -53,6 +53,7 @@ void Semaphore::constructor(int32_t count, uint16_t max_count)
     attr.cb_size = sizeof(_obj_mem);
     _id = osSemaphoreNew(max_count, count, &attr);
     MBED_ASSERT(_id != nullptr);
+    _wait_set = nullptr;
 #else
     _count = count;
     _max_count = max_count;
@@ -162,7 +163,11 @@ bool Semaphore::try_acquire_until(Kernel::Clock::time_point abs_time)
 osStatus Semaphore::release(void)
 {
 #if MBED_CONF_RTOS_PRESENT
-    return osSemaphoreRelease(_id);
+    osStatus status = osSemaphoreRelease(_id);
+    if (status == osOK) {
+        internal::wait_set_signal(_wait_set);
+    }
+    return status;
 #else
     int32_t old_count = core_util_atomic_load_s32(&_count);
     do {
@@ -24,12 +24,19 @@
 #define __STDC_LIMIT_MACROS
 #include "rtos/ThisThread.h"
 
+#include <algorithm>
 #include "platform/mbed_toolchain.h"
 #include "rtos/Kernel.h"
 #include "platform/CriticalSectionLock.h"
 #include "platform/mbed_assert.h"
 #include "platform/mbed_critical.h"
+#include "platform/mbed_power_mgmt.h"
 #include "platform/internal/mbed_os_timer.h"
+#include "drivers/TimerEvent.h"
+#include "hal/us_ticker_api.h"
+#if MBED_CONF_RTOS_PRESENT
+#include "rtos/Semaphore.h"
+#endif
 
 using std::milli;
 using std::chrono::duration;
@@ -229,6 +236,77 @@ void ThisThread::sleep_for(Clock::duration_u32 rel_time)
 #endif
 }
 
+namespace {
+
+// One-shot us ticker event which wakes the thread sleeping on it
+class HighResWakeup : private mbed::TimerEvent {
+public:
+    HighResWakeup() : TimerEvent(get_us_ticker_data())
+#if MBED_CONF_RTOS_PRESENT
+        , _semaphore(0, 1)
+#else
+        , _fired(false)
+#endif
+    {
+    }
+
+    mbed::TickerDataClock::time_point now()
+    {
+        return _ticker_data.now();
+    }
+
+    void sleep_until(mbed::TickerDataClock::time_point abs_time)
+    {
+        // The us ticker may stop in deep sleep
+        sleep_manager_lock_deep_sleep();
+        insert_absolute(abs_time);
+#if MBED_CONF_RTOS_PRESENT
+        _semaphore.acquire();
+#else
+        while (!core_util_atomic_load_bool(&_fired)) {
+            sleep();
+        }
+#endif
+        sleep_manager_unlock_deep_sleep();
+    }
+
+private:
+    void handler() override
+    {
+#if MBED_CONF_RTOS_PRESENT
+        _semaphore.release();
+#else
+        core_util_atomic_store_bool(&_fired, true);
+#endif
+    }
+
+#if MBED_CONF_RTOS_PRESENT
+    rtos::Semaphore _semaphore;
+#else
+    bool _fired;
+#endif
+};
+
+}
+
+void ThisThread::high_res_sleep_for(std::chrono::microseconds rel_time)
+{
+    if (rel_time <= std::chrono::microseconds::zero()) {
+        return;
+    }
+
+    HighResWakeup wakeup;
+    mbed::TickerDataClock::time_point abs_time = wakeup.now() + rel_time;
+
+    // Sleep the whole ticks through the RTOS, with one to spare as the first
+    // may be partly over, and time the rest on the us ticker
+    Clock::duration ticks = std::chrono::duration_cast<Clock::duration>(rel_time) - Clock::duration(1);
+    if (ticks > Clock::duration::zero()) {
+        ThisThread::sleep_for(std::chrono::duration_cast<Clock::duration_u32>(std::min<Clock::duration>(ticks, wait_for_u32_max)));
+    }
+    wakeup.sleep_until(abs_time);
+}
+
 void ThisThread::sleep_until(uint64_t millisec)
 {
     ThisThread::sleep_until(Clock::time_point(duration<uint64_t, milli>(millisec)));
@@ -25,6 +25,7 @@
 #include "rtos/ThisThread.h"
 #include "rtos_idle.h"
 #include "rtos_handlers.h"
+#include "rtos_stack_pool.h"
 #include "platform/mbed_assert.h"
 #include "platform/mbed_error.h"
 
@@ -44,6 +45,28 @@ namespace rtos {
 #define MBED_TZ_DEFAULT_ACCESS   0
 #endif
 
+static uint32_t *allocate_stack(uint32_t size)
+{
+#if defined(MBED_CONF_RTOS_THREAD_STACK_POOL_SIZE) && MBED_CONF_RTOS_THREAD_STACK_POOL_SIZE > 0
+    return static_cast<uint32_t *>(rtos_stack_pool_alloc(size));
+#else
+    uint32_t *stack = new uint32_t[size / sizeof(uint32_t)];
+    MBED_ASSERT(stack != nullptr);
+    return stack;
+#endif
+}
+
+static void release_stack(void *stack, uint32_t size)
+{
+#if defined(MBED_CONF_RTOS_THREAD_STACK_POOL_SIZE) && MBED_CONF_RTOS_THREAD_STACK_POOL_SIZE > 0
+    rtos_stack_pool_free(stack, size);
+#else
+    (void)size;
+    // Cast before deallocation as delete[] does not accept void*
+    delete[] static_cast<uint32_t *>(stack);
+#endif
+}
+
 void Thread::constructor(uint32_t tz_module, osPriority priority,
                          uint32_t stack_size, unsigned char *stack_mem, const char *name)
 {
@@ -81,14 +104,20 @@ osStatus Thread::start(mbed::Callback<void()> task)
     }
 
     if (_attr.stack_mem == nullptr) {
-        _attr.stack_mem = new uint32_t[_attr.stack_size / sizeof(uint32_t)];
-        MBED_ASSERT(_attr.stack_mem != nullptr);
+        _attr.stack_mem = allocate_stack(_attr.stack_size);
+        if (_attr.stack_mem == nullptr) {
+            _mutex.unlock();
+            _join_sem.release();
+            return osErrorNoMemory;
+        }
     }
 
+#if !defined(MBED_STACK_STATS_SAMPLED)
     //Fill the stack with a magic word for maximum usage checking
     for (uint32_t i = 0; i < (_attr.stack_size / sizeof(uint32_t)); i++) {
         ((uint32_t *)_attr.stack_mem)[i] = osRtxStackMagicWord;
     }
+#endif
 
     _attr.cb_size = sizeof(_obj_mem);
     _attr.cb_mem = &_obj_mem;
@@ -96,8 +125,7 @@ osStatus Thread::start(mbed::Callback<void()> task)
     _tid = osThreadNew(Thread::_thunk, this, &_attr);
     if (_tid == nullptr) {
         if (_dynamic_stack) {
-            // Cast before deallocation as delete[] does not accept void*
-            delete[] static_cast<uint32_t *>(_attr.stack_mem);
+            release_stack(_attr.stack_mem, _attr.stack_size);
             _attr.stack_mem = nullptr;
         }
         _mutex.unlock();
@@ -294,7 +322,9 @@ uint32_t Thread::max_stack() const
     _mutex.lock();
 
     if (_tid != nullptr) {
-#if defined(MBED_OS_BACKEND_RTX5)
+#if defined(MBED_STACK_STATS_SAMPLED)
+        size = rtos_thread_stack_high_water(_tid);
+#elif defined(MBED_OS_BACKEND_RTX5)
         mbed_rtos_storage_thread_t *thread = (mbed_rtos_storage_thread_t *)_tid;
         uint32_t high_mark = 0;
         while ((((uint32_t *)(thread->stack_mem))[high_mark] == osRtxStackMagicWord) || (((uint32_t *)(thread->stack_mem))[high_mark] == osRtxStackFillPattern)) {
@@ -325,8 +355,7 @@ Thread::~Thread()
     // terminate is thread safe
     terminate();
     if (_dynamic_stack) {
-        // Cast before deallocation as delete[] does not accept void*
-        delete[] static_cast<uint32_t *>(_attr.stack_mem);
+        release_stack(_attr.stack_mem, _attr.stack_size);
         _attr.stack_mem = nullptr;
     }
 }
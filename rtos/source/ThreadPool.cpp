@@ -0,0 +1,194 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "rtos/ThreadPool.h"
+#include "rtos/ThisThread.h"
+#include "platform/mbed_assert.h"
+#include "platform/mbed_atomic.h"
+#include "platform/mbed_critical.h"
+
+#if MBED_CONF_RTOS_PRESENT
+
+namespace rtos {
+
+ThreadPool::ThreadPool(uint32_t workers, uint32_t depth, osPriority priority,
+                       uint32_t stack_size, const char *name)
+    : _worker_count(workers), _depth(depth), _next(0), _started(0)
+{
+    MBED_ASSERT(workers > 0 && depth > 0);
+
+    _workers = new Worker[workers];
+    for (uint32_t i = 0; i < workers; i++) {
+        _workers[i].pool = this;
+        _workers[i].thread = new Thread(priority, stack_size, nullptr, name);
+        _workers[i].tasks = new Task[depth];
+        _workers[i].head = 0;
+        _workers[i].count = 0;
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    // One extra token per worker, taken once the deques are empty
+    for (uint32_t i = 0; i < _started; i++) {
+        _pending.release();
+    }
+    for (uint32_t i = 0; i < _started; i++) {
+        _workers[i].thread->join();
+    }
+
+    for (uint32_t i = 0; i < _worker_count; i++) {
+        delete _workers[i].thread;
+        delete[] _workers[i].tasks;
+    }
+    delete[] _workers;
+}
+
+osStatus ThreadPool::start()
+{
+    if (_started) {
+        return osErrorResource;
+    }
+
+    for (uint32_t i = 0; i < _worker_count; i++) {
+        osStatus status = _workers[i].thread->start(mbed::callback(&_workers[i], &Worker::run));
+        if (status != osOK) {
+            return status;
+        }
+        _started++;
+    }
+    return osOK;
+}
+
+bool ThreadPool::submit(mbed::Callback<void()> task, EventFlags *done, uint32_t flags)
+{
+    // Tasks submitted by a worker stay on it, others are spread in turn
+    uint32_t first = _worker_count;
+    if (!core_util_is_isr_active()) {
+        osThreadId_t id = ThisThread::get_id();
+        for (uint32_t i = 0; i < _worker_count; i++) {
+            if (_workers[i].thread->get_id() == id) {
+                first = i;
+                break;
+            }
+        }
+    }
+    Task entry = { task, done, flags, first != _worker_count };
+    if (first == _worker_count) {
+        first = core_util_atomic_incr_u32(&_next, 1) % _worker_count;
+    }
+
+    for (uint32_t i = 0; i < _worker_count; i++) {
+        if (push(&_workers[(first + i) % _worker_count], entry)) {
+            _pending.release();
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ThreadPool::push(Worker *worker, const Task &task)
+{
+    bool pushed = false;
+    core_util_critical_section_enter();
+    if (worker->count < _depth) {
+        worker->tasks[(worker->head + worker->count) % _depth] = task;
+        worker->count++;
+        pushed = true;
+    }
+    core_util_critical_section_exit();
+    return pushed;
+}
+
+bool ThreadPool::pop_own(Worker *worker, Task &task)
+{
+    bool popped = false;
+    core_util_critical_section_enter();
+    if (worker->count > 0) {
+        uint32_t back = (worker->head + worker->count - 1) % _depth;
+        if (worker->tasks[back].local) {
+            // Last in, first out for the tasks the worker submitted itself
+            task = worker->tasks[back];
+            worker->count--;
+        } else {
+            // First in, first out for the others, so that none is left behind
+            task = worker->tasks[worker->head];
+            worker->head = (worker->head + 1) % _depth;
+            worker->count--;
+        }
+        popped = true;
+    }
+    core_util_critical_section_exit();
+    return popped;
+}
+
+bool ThreadPool::pop_front(Worker *worker, Task &task)
+{
+    bool popped = false;
+    core_util_critical_section_enter();
+    if (worker->count > 0) {
+        task = worker->tasks[worker->head];
+        worker->head = (worker->head + 1) % _depth;
+        worker->count--;
+        popped = true;
+    }
+    core_util_critical_section_exit();
+    return popped;
+}
+
+bool ThreadPool::take(Worker *self, Task &task)
+{
+    if (pop_own(self, task)) {
+        return true;
+    }
+
+    uint32_t index = self - _workers;
+    for (uint32_t i = 1; i < _worker_count; i++) {
+        if (pop_front(&_workers[(index + i) % _worker_count], task)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::worker_main(Worker *self)
+{
+    while (true) {
+        // Every token matches a queued task, apart from the ones released
+        // by the destructor to stop the workers
+        _pending.acquire();
+
+        Task task;
+        if (!take(self, task)) {
+            return;
+        }
+
+        task.fn();
+        if (task.done) {
+            task.done->set(task.flags);
+        }
+    }
+}
+
+} // namespace rtos
+
+#endif
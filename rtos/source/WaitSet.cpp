@@ -0,0 +1,192 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "rtos/WaitSet.h"
+#include "rtos/ThisThread.h"
+#include "platform/mbed_assert.h"
+#include "platform/mbed_atomic.h"
+#include "platform/mbed_critical.h"
+
+#if MBED_CONF_RTOS_PRESENT
+
+namespace rtos {
+
+namespace internal {
+
+void wait_set_notify(WaitSet *const *hook)
+{
+    core_util_critical_section_enter();
+    WaitSet *wait_set = *hook;
+    if (wait_set != nullptr) {
+        wait_set->notify();
+    }
+    core_util_critical_section_exit();
+}
+
+} // namespace internal
+
+WaitSet::WaitSet() : _members(), _waiter(nullptr), _next(0)
+{
+}
+
+WaitSet::~WaitSet()
+{
+    for (int i = 0; i < max_members; i++) {
+        remove(i);
+    }
+}
+
+int WaitSet::add(Semaphore &semaphore)
+{
+    return add(member_t{mbed::callback(semaphore_ready, &semaphore), nullptr, 0, &semaphore._wait_set});
+}
+
+int WaitSet::add(EventFlags &event_flags, uint32_t flags)
+{
+    return add(member_t{nullptr, &event_flags, flags, &event_flags._wait_set});
+}
+
+int WaitSet::add(mbed::Callback<bool()> ready)
+{
+    return add(member_t{ready, nullptr, 0, nullptr});
+}
+
+int WaitSet::add(member_t member)
+{
+    for (int i = 0; i < max_members; i++) {
+        if (_members[i].ready || _members[i].event_flags) {
+            continue;
+        }
+
+        if (member.hook) {
+            // Registered under the lock, as producers may already be signalling
+            core_util_critical_section_enter();
+            if (*member.hook != nullptr) {
+                core_util_critical_section_exit();
+                return -1;
+            }
+            *member.hook = this;
+            core_util_critical_section_exit();
+        }
+        _members[i] = member;
+        return i;
+    }
+    return -1;
+}
+
+void WaitSet::remove(int index)
+{
+    MBED_ASSERT(index >= 0 && index < max_members);
+    member_t &member = _members[index];
+    if (member.hook) {
+        core_util_critical_section_enter();
+        *member.hook = nullptr;
+        core_util_critical_section_exit();
+    }
+    member = member_t();
+}
+
+bool WaitSet::semaphore_ready(Semaphore *semaphore)
+{
+    return osSemaphoreGetCount(semaphore->_id) > 0;
+}
+
+bool WaitSet::is_ready(const member_t &member) const
+{
+    if (member.event_flags) {
+        return (member.event_flags->get() & member.flags) != 0;
+    }
+    return member.ready && member.ready();
+}
+
+int WaitSet::ready_member()
+{
+    // Start after the last member returned, so that a busy one does not starve the others
+    for (int n = 0; n < max_members; n++) {
+        int i = (_next + n) % max_members;
+        if (is_ready(_members[i])) {
+            _next = (i + 1) % max_members;
+            return i;
+        }
+    }
+    return -1;
+}
+
+int WaitSet::wait()
+{
+    return wait(Kernel::Clock::time_point(), true);
+}
+
+int WaitSet::wait_for(Kernel::Clock::duration_u32 rel_time)
+{
+    if (rel_time == Kernel::wait_for_u32_forever) {
+        return wait();
+    }
+    return wait(Kernel::Clock::now() + rel_time, false);
+}
+
+int WaitSet::wait_until(Kernel::Clock::time_point abs_time)
+{
+    return wait(abs_time, false);
+}
+
+int WaitSet::wait(Kernel::Clock::time_point abs_time, bool forever)
+{
+    core_util_atomic_store(&_waiter, ThisThread::get_id());
+
+    int index;
+    while (true) {
+        // A member which becomes ready from here on sets the flag, so checking
+        // them after clearing it cannot miss a wake up
+        osThreadFlagsClear(thread_flag);
+        index = ready_member();
+        if (index >= 0) {
+            break;
+        }
+
+        uint32_t timeout = osWaitForever;
+        if (!forever) {
+            Kernel::Clock::time_point now = Kernel::Clock::now();
+            if (now >= abs_time) {
+                break;
+            }
+            Kernel::Clock::duration remaining = abs_time - now;
+            timeout = remaining < Kernel::wait_for_u32_max ? uint32_t(remaining.count()) : Kernel::wait_for_u32_max.count();
+        }
+        osThreadFlagsWait(thread_flag, osFlagsWaitAny, timeout);
+    }
+
+    core_util_atomic_store(&_waiter, static_cast<osThreadId_t>(nullptr));
+    return index;
+}
+
+void WaitSet::notify()
+{
+    osThreadId_t waiter = core_util_atomic_load(&_waiter);
+    if (waiter != nullptr) {
+        osThreadFlagsSet(waiter, thread_flag);
+    }
+}
+
+} // namespace rtos
+
+#endif // MBED_CONF_RTOS_PRESENT
@@ -23,6 +23,7 @@
 #ifndef RTOS_HANDLERS_H
 #define RTOS_HANDLERS_H
 
+#include <stdint.h>
 #include "rtos/mbed_rtos_types.h"
 
 #ifdef __cplusplus
@@ -44,6 +45,28 @@ extern "C" {
  @param fptr Hook function pointer.
  */
 void rtos_attach_thread_terminate_hook(void (*fptr)(osThreadId_t id));
+
+/**
+ @note
+ Gets the time a thread has spent running, tracked at each context switch
+ when thread statistics are enabled. Must not be called from ISR context.
+ @param id      Thread ID.
+ @param sample  If not NULL, set to the run time since the previous call
+                with a sample for this thread, which starts a new sample.
+ @return Run time in microseconds since the thread was created, or 0 if the
+         thread is not tracked.
+ */
+uint64_t rtos_thread_run_time(osThreadId_t id, uint64_t *sample);
+
+/**
+ @note
+ Gets the deepest stack use of a thread seen at context switches when
+ MBED_STACK_STATS_SAMPLED is set. Use between switches, such as in an
+ interrupt handler, is not seen. Must not be called from ISR context.
+ @param id      Thread ID.
+ @return Stack use in bytes, or 0 if the thread is not tracked.
+ */
+uint32_t rtos_thread_stack_high_water(osThreadId_t id);
 /** @}*/
 
 #ifdef __cplusplus
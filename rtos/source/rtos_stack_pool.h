@@ -0,0 +1,68 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef RTOS_STACK_POOL_H
+#define RTOS_STACK_POOL_H
+
+#include <stdint.h>
+#include "platform/mbed_stats.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \defgroup rtos_stack_pool RTOS thread stack pool
+ * \ingroup rtos-internal-api
+ *
+ * When MBED_CONF_RTOS_THREAD_STACK_POOL_SIZE is set, threads created without
+ * stack memory take their stack from a static pool of that many bytes
+ * instead of the heap. The pool is placed in the section set with
+ * MBED_CONF_RTOS_THREAD_STACK_POOL_SECTION, if any.
+ * @{
+ */
+
+/**
+ @note
+ Allocates a thread stack from the pool.
+ @param size    Size of the stack in bytes.
+ @return 8-byte aligned stack, or NULL if the pool has no room for it.
+ */
+void *rtos_stack_pool_alloc(uint32_t size);
+
+/**
+ @note
+ Returns a stack allocated by rtos_stack_pool_alloc() to the pool.
+ @param stack   Stack to free.
+ @param size    Size the stack was allocated with.
+ */
+void rtos_stack_pool_free(void *stack, uint32_t size);
+
+/**
+ @note
+ Gets the usage of the pool, in the fields of the heap statistics. Sizes
+ include the header of each block, so max_size is the pool size needed by
+ the threads run so far.
+ @param stats   Statistics to fill.
+ */
+void rtos_stack_pool_get_stats(mbed_stats_heap_t *stats);
+/** @}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
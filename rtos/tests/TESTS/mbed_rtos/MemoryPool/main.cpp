@@ -586,6 +586,79 @@ void free_block_invalid_parameter()
     TEST_ASSERT_EQUAL(osErrorParameter, status);
 }
 
+/* Test batch allocation and deallocation.
+ *
+ * Given MemoryPool object of the specified size has been successfully created.
+ * When more blocks than available are requested in a batch and then freed in a batch.
+ * Then only the available blocks are allocated, are unique, and can all be allocated again.
+ *
+ */
+void test_mem_pool_batch()
+{
+    MemoryPool<int, 4> mem_pool;
+    int *blocks[6];
+
+    TEST_ASSERT_EQUAL(4, mem_pool.alloc_batch(blocks, 6));
+    for (int i = 0; i < 4; i++) {
+        TEST_ASSERT_NOT_NULL(blocks[i]);
+        for (int j = 0; j < i; j++) {
+            TEST_ASSERT_NOT_EQUAL(blocks[j], blocks[i]);
+        }
+    }
+    TEST_ASSERT_NULL(mem_pool.try_alloc());
+    TEST_ASSERT_EQUAL(0, mem_pool.alloc_batch(blocks + 4, 2));
+
+    TEST_ASSERT_EQUAL(osOK, mem_pool.free_batch(blocks, 4));
+    TEST_ASSERT_EQUAL(4, mem_pool.alloc_batch(blocks, 4));
+
+    /* An invalid block is reported, the valid ones are still freed. */
+    blocks[4] = NULL;
+    TEST_ASSERT_EQUAL(osErrorParameter, mem_pool.free_batch(blocks, 5));
+    TEST_ASSERT_EQUAL(4, mem_pool.alloc_batch(blocks, 4));
+}
+
+/* Test the per-thread cache in front of a memory pool.
+ *
+ * Given a MemoryPoolCache on a MemoryPool.
+ * When blocks are allocated and freed through the cache.
+ * Then the cache refills and spills in halves, hands out the whole pool,
+ * and returns its blocks to the pool on flush.
+ *
+ */
+void test_mem_pool_cache()
+{
+    MemoryPool<int, 8> mem_pool;
+    MemoryPoolCache<int, 8, 4> cache(mem_pool);
+    int *blocks[8];
+
+    blocks[0] = cache.try_alloc();
+    TEST_ASSERT_NOT_NULL(blocks[0]);
+    TEST_ASSERT_EQUAL(1, cache.size());
+
+    for (int i = 1; i < 8; i++) {
+        blocks[i] = cache.try_calloc();
+        TEST_ASSERT_NOT_NULL(blocks[i]);
+        TEST_ASSERT_EQUAL(0, *blocks[i]);
+    }
+    TEST_ASSERT_NULL(cache.try_alloc());
+    TEST_ASSERT_NULL(mem_pool.try_alloc());
+
+    for (int i = 0; i < 8; i++) {
+        TEST_ASSERT_EQUAL(osOK, cache.free(blocks[i]));
+        TEST_ASSERT_TRUE(cache.size() <= 4);
+    }
+    TEST_ASSERT_EQUAL(4, cache.size());
+    TEST_ASSERT_EQUAL(osErrorParameter, cache.free(NULL));
+
+    /* Blocks spilled to the pool are available to other users. */
+    TEST_ASSERT_EQUAL(4, mem_pool.alloc_batch(blocks, 8));
+    TEST_ASSERT_EQUAL(osOK, mem_pool.free_batch(blocks, 4));
+
+    TEST_ASSERT_EQUAL(osOK, cache.flush());
+    TEST_ASSERT_EQUAL(0, cache.size());
+    TEST_ASSERT_EQUAL(8, mem_pool.alloc_batch(blocks, 8));
+}
+
 /* Use wrapper functions to reduce memory usage. */
 
 template<typename T, const uint32_t numOfEntries>
@@ -669,7 +742,10 @@ Case cases[] = {
     Case("Test: wait forever", test_mem_pool_waitforever),
 
     Case("Test: free() - robust (free called with invalid param - NULL).", free_block_invalid_parameter_null),
-    Case("Test: free() - robust (free called with invalid param).", free_block_invalid_parameter)
+    Case("Test: free() - robust (free called with invalid param).", free_block_invalid_parameter),
+
+    Case("Test: alloc_batch()/free_batch().", test_mem_pool_batch),
+    Case("Test: MemoryPoolCache.", test_mem_pool_cache)
 };
 
 utest::v1::status_t greentea_test_setup(const size_t number_of_cases)
@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2021, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mbed.h"
+#include "greentea-client/test_env.h"
+#include "unity/unity.h"
+#include "utest/utest.h"
+
+using utest::v1::Case;
+using namespace std::chrono;
+
+#if !defined(MBED_CONF_RTOS_PRESENT)
+#error [NOT_SUPPORTED] DeferredWork test cases require RTOS with multithread to run
+#else
+
+#define ITEM_COUNT  4
+
+static EventFlags done;
+static EventFlags gate;
+static volatile uint32_t runs[ITEM_COUNT];
+static uint32_t order[ITEM_COUNT];
+static volatile uint32_t order_count;
+static osThreadId_t ran_on;
+
+static void work(int index)
+{
+    ran_on = ThisThread::get_id();
+    runs[index]++;
+    order[order_count++] = index;
+    done.set(1 << index);
+}
+
+static void blocking_work()
+{
+    gate.wait_all(1);
+    done.set(1 << ITEM_COUNT);
+}
+
+static void reset()
+{
+    for (int i = 0; i < ITEM_COUNT; i++) {
+        runs[i] = 0;
+    }
+    order_count = 0;
+    done.clear();
+    gate.clear();
+}
+
+/** Test that posted work runs in the deferred work thread
+
+    Given a work item
+    When it is posted from a thread
+    Then it runs once, in another thread
+ */
+void test_post()
+{
+    DeferredWork item(callback(work, 0), 8);
+    reset();
+
+    item.post();
+    TEST_ASSERT_EQUAL(1, done.wait_all_for(1, 1s));
+    TEST_ASSERT_EQUAL(1, runs[0]);
+    TEST_ASSERT_TRUE(ran_on != ThisThread::get_id());
+    TEST_ASSERT_FALSE(item.pending());
+}
+
+/** Test that pending work runs in priority order and once per run
+
+    Given work items posted, several times each, while a higher priority item blocks
+    When the blocking item returns
+    Then each item runs once, highest priority first
+ */
+void test_priority_order()
+{
+    DeferredWork blocker(blocking_work, 0);
+    DeferredWork item0(callback(work, 0), 3);
+    DeferredWork item1(callback(work, 1), 5);
+    DeferredWork item2(callback(work, 2), 7);
+    DeferredWork item3(callback(work, 3), 9);
+    reset();
+
+    blocker.post();
+    for (int i = 0; i < 2; i++) {
+        item3.post();
+        item1.post();
+        item2.post();
+        item0.post();
+    }
+    TEST_ASSERT_TRUE(item0.pending());
+    TEST_ASSERT_EQUAL(0, order_count);
+
+    gate.set(1);
+    const uint32_t all = (1 << (ITEM_COUNT + 1)) - 1;
+    TEST_ASSERT_EQUAL(all, done.wait_all_for(all, 1s));
+    TEST_ASSERT_EQUAL(ITEM_COUNT, order_count);
+    for (int i = 0; i < ITEM_COUNT; i++) {
+        TEST_ASSERT_EQUAL(1, runs[i]);
+        TEST_ASSERT_EQUAL(i, order[i]);
+    }
+}
+
+static DeferredWork *isr_item;
+
+static void post_from_isr()
+{
+    isr_item->post();
+}
+
+/** Test that work can be posted from an interrupt
+
+    Given a work item
+    When it is posted from a timeout
+    Then it runs
+ */
+void test_post_from_isr()
+{
+    DeferredWork item(callback(work, 0), 8);
+    Timeout timeout;
+    isr_item = &item;
+    reset();
+
+    timeout.attach(post_from_isr, 10ms);
+    TEST_ASSERT_EQUAL(1, done.wait_all_for(1, 1s));
+    TEST_ASSERT_EQUAL(1, runs[0]);
+}
+
+utest::v1::status_t test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(10, "default_auto");
+    return utest::v1::verbose_test_setup_handler(number_of_cases);
+}
+
+Case cases[] = {
+    Case("Test post", test_post),
+    Case("Test priority order", test_priority_order),
+    Case("Test post from ISR", test_post_from_isr),
+};
+
+utest::v1::Specification specification(test_setup, cases);
+
+int main()
+{
+    return !utest::v1::Harness::run(specification);
+}
+
+#endif // !defined(MBED_CONF_RTOS_PRESENT)
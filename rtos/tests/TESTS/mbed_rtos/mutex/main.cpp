@@ -294,6 +294,45 @@ void test_single_thread_lock(void)
     mutex.unlock();
 }
 
+#if MBED_MUTEX_STATS_ENABLED
+void test_stats_contended_thread(Mutex *mutex)
+{
+    mutex->lock();
+    mutex->unlock();
+}
+
+/** Test mutex contention statistics
+
+    Given a mutex and two threads A & B
+    When thread A holds the lock while thread B calls @a lock
+    Then the statistics count both acquisitions, one of them contended,
+        and the hold time of thread A
+*/
+void test_stats(void)
+{
+    Mutex mutex;
+    mbed_stats_mutex_t stats;
+    Thread thread(osPriorityNormal, TEST_STACK_SIZE);
+
+    mutex.lock();
+    mutex.lock();
+    mutex.unlock();
+    mutex.unlock();
+    mutex.reset_stats();
+
+    mutex.lock();
+    thread.start(callback(test_stats_contended_thread, &mutex));
+    ThisThread::sleep_for(TEST_DELAY);
+    mutex.unlock();
+    thread.join();
+
+    mutex.get_stats(&stats);
+    TEST_ASSERT_EQUAL(2, stats.acquisitions);
+    TEST_ASSERT_EQUAL(1, stats.contended);
+    TEST_ASSERT_UINT32_WITHIN(5000, duration_cast<microseconds>(TEST_DELAY).count(), stats.max_hold_us);
+}
+#endif
+
 utest::v1::status_t test_setup(const size_t number_of_cases)
 {
     GREENTEA_SETUP(10, "default_auto");
@@ -310,6 +349,9 @@ Case cases[] = {
     Case("Test dual thread second thread lock", test_dual_thread_nolock<test_dual_thread_nolock_lock_thread>),
     Case("Test dual thread second thread trylock", test_dual_thread_nolock<test_dual_thread_nolock_trylock_thread>),
     Case("Test multiple thread", test_multiple_threads),
+#if MBED_MUTEX_STATS_ENABLED
+    Case("Test mutex stats", test_stats),
+#endif
 };
 
 Specification specification(test_setup, cases);
@@ -0,0 +1,186 @@
+/*
+ * Copyright (c) 2021, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mbed.h"
+#include "greentea-client/test_env.h"
+#include "unity/unity.h"
+#include "utest/utest.h"
+
+using utest::v1::Case;
+using namespace std::chrono;
+
+#if !defined(MBED_CONF_RTOS_PRESENT)
+#error [NOT_SUPPORTED] ThreadPool test cases require RTOS with multithread to run
+#else
+
+#if defined(__CORTEX_M23) || defined(__CORTEX_M33)
+#define THREAD_STACK_SIZE   768
+#else
+#define THREAD_STACK_SIZE   512
+#endif
+
+#define TASK_COUNT  8
+#define ALL_TASKS   ((1 << TASK_COUNT) - 1)
+
+static volatile uint32_t counter;
+static osThreadId_t ran_on[TASK_COUNT];
+
+static void count_task(int index)
+{
+    ran_on[index] = ThisThread::get_id();
+    core_util_atomic_incr_u32(&counter, 1);
+}
+
+/** Test that every submitted task runs
+
+    Given a started pool of two workers
+    When tasks are submitted with a completion flag each
+    Then all tasks run and all flags get set
+ */
+void test_submit()
+{
+    ThreadPool pool(2, 4, osPriorityNormal, THREAD_STACK_SIZE);
+    EventFlags done;
+    counter = 0;
+
+    TEST_ASSERT_EQUAL(osOK, pool.start());
+    TEST_ASSERT_EQUAL(osErrorResource, pool.start());
+    for (int i = 0; i < TASK_COUNT; i++) {
+        TEST_ASSERT_TRUE(pool.submit(callback(count_task, i), &done, 1 << i));
+    }
+
+    uint32_t flags = done.wait_all_for(ALL_TASKS, 1s);
+    TEST_ASSERT_EQUAL(ALL_TASKS, flags);
+    TEST_ASSERT_EQUAL(TASK_COUNT, counter);
+}
+
+/** Test that tasks queued before start run and the destructor drains the deques
+
+    Given a pool that is not started
+    When tasks are submitted until the deques are full, then the pool is started and destroyed
+    Then submitting fails once full and all queued tasks have run after the destructor
+ */
+void test_queue_before_start()
+{
+    counter = 0;
+    {
+        ThreadPool pool(2, 2, osPriorityNormal, THREAD_STACK_SIZE);
+        for (int i = 0; i < 4; i++) {
+            TEST_ASSERT_TRUE(pool.submit(callback(count_task, i)));
+        }
+        TEST_ASSERT_FALSE(pool.submit(callback(count_task, 4)));
+        TEST_ASSERT_EQUAL(0, counter);
+        TEST_ASSERT_EQUAL(osOK, pool.start());
+    }
+    TEST_ASSERT_EQUAL(4, counter);
+}
+
+static int run_order[TASK_COUNT];
+
+static void order_task(int index)
+{
+    run_order[counter] = index;
+    core_util_atomic_incr_u32(&counter, 1);
+}
+
+/** Test that tasks submitted from outside the pool run in submission order
+
+    Given a pool of one worker that is not started
+    When tasks are submitted and the pool is started
+    Then the tasks run first in, first out
+ */
+void test_external_order()
+{
+    ThreadPool pool(1, TASK_COUNT, osPriorityNormal, THREAD_STACK_SIZE);
+    EventFlags done;
+    counter = 0;
+
+    for (int i = 0; i < TASK_COUNT; i++) {
+        TEST_ASSERT_TRUE(pool.submit(callback(order_task, i), &done, 1 << i));
+    }
+    TEST_ASSERT_EQUAL(osOK, pool.start());
+
+    uint32_t flags = done.wait_all_for(ALL_TASKS, 1s);
+    TEST_ASSERT_EQUAL(ALL_TASKS, flags);
+    for (int i = 0; i < TASK_COUNT; i++) {
+        TEST_ASSERT_EQUAL(i, run_order[i]);
+    }
+}
+
+static EventFlags gate;
+static osThreadId_t blocked_on;
+
+struct Spawner {
+    ThreadPool *pool;
+    EventFlags *done;
+
+    void spawn()
+    {
+        // Queued on this worker, which stays blocked, so the other steals them
+        blocked_on = ThisThread::get_id();
+        for (int i = 0; i < TASK_COUNT; i++) {
+            pool->submit(callback(count_task, i), done, 1 << i);
+        }
+        gate.wait_all(1);
+    }
+};
+
+/** Test that an idle worker steals the tasks queued on a busy one
+
+    Given a task on a worker that submits more tasks and then blocks
+    When the tasks are run
+    Then all of them run on the other worker
+ */
+void test_steal()
+{
+    ThreadPool pool(2, TASK_COUNT, osPriorityNormal, THREAD_STACK_SIZE);
+    EventFlags done;
+    Spawner spawner = { &pool, &done };
+    counter = 0;
+
+    TEST_ASSERT_EQUAL(osOK, pool.start());
+    TEST_ASSERT_TRUE(pool.submit(callback(&spawner, &Spawner::spawn)));
+
+    uint32_t flags = done.wait_all_for(ALL_TASKS, 1s);
+    TEST_ASSERT_EQUAL(ALL_TASKS, flags);
+    for (int i = 0; i < TASK_COUNT; i++) {
+        TEST_ASSERT_TRUE(ran_on[i] != blocked_on);
+    }
+    gate.set(1);
+}
+
+utest::v1::status_t test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(10, "default_auto");
+    return utest::v1::verbose_test_setup_handler(number_of_cases);
+}
+
+Case cases[] = {
+    Case("Test submit", test_submit),
+    Case("Test queue before start", test_queue_before_start),
+    Case("Test external tasks order", test_external_order),
+    Case("Test work stealing", test_steal),
+};
+
+utest::v1::Specification specification(test_setup, cases);
+
+int main()
+{
+    return !utest::v1::Harness::run(specification);
+}
+
+#endif // !defined(MBED_CONF_RTOS_PRESENT)
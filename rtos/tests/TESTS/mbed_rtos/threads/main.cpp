@@ -486,6 +486,25 @@ void test_thread_wait()
     TEST_ASSERT_DURATION_WITHIN(50ms, 150ms, timer.elapsed_time());
 }
 
+/** Testing thread wait with microsecond resolution
+
+    Given the thread is running
+    when the @a wait function is called with a duration below the RTOS tick
+    then the thread sleeps for that amount of time, not rounded to the tick
+ */
+void test_thread_wait_us()
+{
+    Timer timer;
+    timer.start();
+
+    ThisThread::sleep_for(300us);
+    TEST_ASSERT_DURATION_WITHIN(200us, 300us, timer.elapsed_time());
+
+    timer.reset();
+    ThisThread::sleep_for(2500us);
+    TEST_ASSERT_DURATION_WITHIN(200us, 2500us, timer.elapsed_time());
+}
+
 /** Testing thread name
 
     Given a thread is started with a specified name
@@ -836,6 +855,7 @@ static const case_t cases[] = {
 
     {"Testing thread stack info", test_thread_stack_info, DEFAULT_HANDLERS},
     {"Testing thread wait", test_thread_wait, DEFAULT_HANDLERS},
+    {"Testing thread wait with us resolution", test_thread_wait_us, DEFAULT_HANDLERS},
     {"Testing thread name", test_thread_name, DEFAULT_HANDLERS},
 
     {"Testing thread states: deleted", test_deleted, DEFAULT_HANDLERS},
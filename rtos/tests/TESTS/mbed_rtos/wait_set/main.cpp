@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2021, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mbed.h"
+#include "greentea-client/test_env.h"
+#include "unity/unity.h"
+#include "utest/utest.h"
+
+using utest::v1::Case;
+using namespace std::chrono;
+
+#if !defined(MBED_CONF_RTOS_PRESENT)
+#error [NOT_SUPPORTED] WaitSet test cases require RTOS with multithread to run
+#else
+
+#define THREAD_STACK_SIZE 512
+
+static uint32_t message = 0x1234;
+static Queue<uint32_t, 4> queue;
+static Mail<uint32_t, 4> mail;
+static Semaphore semaphore(0);
+static EventFlags event_flags;
+
+static void put_queue()
+{
+    ThisThread::sleep_for(10ms);
+    queue.try_put(&message);
+}
+
+static void put_mail()
+{
+    ThisThread::sleep_for(10ms);
+    uint32_t *mptr = mail.try_alloc();
+    *mptr = message;
+    mail.put(mptr);
+}
+
+static void release_from_isr()
+{
+    semaphore.release();
+}
+
+/** Test that wait returns the member which becomes ready
+
+    Given a set of a Queue and a Mail box
+    When another thread puts to one of them
+    Then wait returns its index, and the message can be taken
+ */
+void test_queue_and_mail()
+{
+    WaitSet set;
+    int queue_index = set.add(queue);
+    int mail_index = set.add(mail);
+    TEST_ASSERT_NOT_EQUAL(-1, queue_index);
+    TEST_ASSERT_NOT_EQUAL(-1, mail_index);
+
+    Thread thread(osPriorityNormal, THREAD_STACK_SIZE);
+    thread.start(put_mail);
+    TEST_ASSERT_EQUAL(mail_index, set.wait_for(1s));
+    uint32_t *mptr = mail.try_get();
+    TEST_ASSERT_NOT_NULL(mptr);
+    TEST_ASSERT_EQUAL(message, *mptr);
+    mail.free(mptr);
+    thread.join();
+
+    Thread thread2(osPriorityNormal, THREAD_STACK_SIZE);
+    thread2.start(put_queue);
+    TEST_ASSERT_EQUAL(queue_index, set.wait_for(1s));
+    uint32_t *data;
+    TEST_ASSERT_TRUE(queue.try_get(&data));
+    TEST_ASSERT_EQUAL_PTR(&message, data);
+    thread2.join();
+}
+
+/** Test that a member ready from an interrupt wakes the waiting thread
+
+    Given a set of a Semaphore and EventFlags
+    When the semaphore is released from a timeout
+    Then wait returns the semaphore's index
+ */
+void test_semaphore_from_isr()
+{
+    WaitSet set;
+    int flags_index = set.add(event_flags, 0x2);
+    int semaphore_index = set.add(semaphore);
+    Timeout timeout;
+
+    timeout.attach(release_from_isr, 10ms);
+    TEST_ASSERT_EQUAL(semaphore_index, set.wait_for(1s));
+    TEST_ASSERT_TRUE(semaphore.try_acquire());
+
+    event_flags.set(0x1);
+    TEST_ASSERT_EQUAL(-1, set.wait_for(10ms));
+    event_flags.set(0x2);
+    TEST_ASSERT_EQUAL(flags_index, set.wait_for(1s));
+    event_flags.clear();
+}
+
+/** Test that wait times out, and that ready members take turns
+
+    Given a set of two ready members
+    When waiting repeatedly
+    Then each is returned in turn, and after both are taken wait times out
+ */
+void test_fairness_and_timeout()
+{
+    WaitSet set;
+    int queue_index = set.add(queue);
+    int semaphore_index = set.add(semaphore);
+    TEST_ASSERT_EQUAL(-1, set.wait_for(10ms));
+
+    queue.try_put(&message);
+    queue.try_put(&message);
+    semaphore.release();
+    semaphore.release();
+    TEST_ASSERT_EQUAL(queue_index, set.wait_for(0ms));
+    TEST_ASSERT_EQUAL(semaphore_index, set.wait_for(0ms));
+    TEST_ASSERT_EQUAL(queue_index, set.wait_for(0ms));
+
+    uint32_t *data;
+    while (queue.try_get(&data)) {
+    }
+    while (semaphore.try_acquire()) {
+    }
+    TEST_ASSERT_EQUAL(-1, set.wait_for(10ms));
+}
+
+/** Test that an object can only be in one set, until removed
+
+    Given a queue in a set
+    When it is added to another set
+    Then it fails until it is removed from the first one
+ */
+void test_single_set()
+{
+    WaitSet set1;
+    WaitSet set2;
+    int index = set1.add(queue);
+    TEST_ASSERT_EQUAL(-1, set2.add(queue));
+    set1.remove(index);
+    TEST_ASSERT_NOT_EQUAL(-1, set2.add(queue));
+}
+
+utest::v1::status_t test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(10, "default_auto");
+    return utest::v1::verbose_test_setup_handler(number_of_cases);
+}
+
+Case cases[] = {
+    Case("Test queue and mail", test_queue_and_mail),
+    Case("Test semaphore from ISR", test_semaphore_from_isr),
+    Case("Test fairness and timeout", test_fairness_and_timeout),
+    Case("Test single set", test_single_set),
+};
+
+utest::v1::Specification specification(test_setup, cases);
+
+int main()
+{
+    return !utest::v1::Harness::run(specification);
+}
+
+#endif // !defined(MBED_CONF_RTOS_PRESENT)
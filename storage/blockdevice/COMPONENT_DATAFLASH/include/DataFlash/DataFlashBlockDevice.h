@@ -190,13 +190,17 @@ private:
     uint16_t _block_size;
     bool _is_initialized;
     uint32_t _init_ref_count;
+    uint8_t _read_dummy_bytes;
 
     // Internal functions
     uint16_t _get_register(uint8_t opcode);
     void _write_command(uint32_t command, const uint8_t *buffer, uint32_t size);
     void _write_enable(bool enable);
-    int _sync(void);
+    int _sync(uint32_t poll_interval);
     int _write_page(const uint8_t *buffer, uint32_t addr, uint32_t offset, uint32_t size);
+    void _write_buffer(uint8_t sram, const uint8_t *buffer);
+    void _program_buffer(uint8_t sram, uint32_t page);
+    uint32_t _page_address(uint32_t page, uint32_t offset);
     uint32_t _translate_address(mbed::bd_addr_t addr);
 
     // Mutex for thread safety
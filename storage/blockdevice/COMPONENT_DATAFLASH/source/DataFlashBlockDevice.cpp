@@ -38,6 +38,7 @@ using namespace mbed;
 #define DATAFLASH_BLOCK_SIZE_4K1   0x1080
 #define DATAFLASH_PAGE_BIT_264     9
 #define DATAFLASH_PAGE_BIT_528     10
+#define DATAFLASH_SRAM_COUNT       2
 
 /* enable debug */
 #ifndef DATAFLASH_DEBUG
@@ -59,8 +60,13 @@ enum opcode {
     DATAFLASH_OP_ID                        = 0x9F,
     DATAFLASH_OP_READ_LOW_POWER            = 0x01,
     DATAFLASH_OP_READ_LOW_FREQUENCY        = 0x03,
+    DATAFLASH_OP_READ_HIGH_FREQUENCY       = 0x0B,
     DATAFLASH_OP_PROGRAM_DIRECT            = 0x02, // Program through Buffer 1 without Built-In Erase
     DATAFLASH_OP_PROGRAM_DIRECT_WITH_ERASE = 0x82,
+    DATAFLASH_OP_BUFFER_1_WRITE            = 0x84,
+    DATAFLASH_OP_BUFFER_2_WRITE            = 0x87,
+    DATAFLASH_OP_BUFFER_1_PROGRAM          = 0x88, // Buffer 1 to Main Memory Page Program without Built-In Erase
+    DATAFLASH_OP_BUFFER_2_PROGRAM          = 0x89,
     DATAFLASH_OP_ERASE_BLOCK               = 0x50,
     DATAFLASH_OP_ERASE_PAGE                = 0x81,
 };
@@ -112,6 +118,7 @@ enum id_density {
 enum timing {
     DATAFLASH_TIMING_ERASE_PROGRAM_PAGE   =    17,
     DATAFLASH_TIMING_PROGRAM_PAGE         =     3,
+    DATAFLASH_TIMING_POLL_PROGRAM_PAGE    =     1,
     DATAFLASH_TIMING_ERASE_PAGE           =    12,
     DATAFLASH_TIMING_ERASE_BLOCK          =    45,
     DATAFLASH_TIMING_ERASE_SECTOR         =   700,
@@ -146,19 +153,23 @@ DataFlashBlockDevice::DataFlashBlockDevice(PinName mosi,
         _page_size(0),
         _block_size(0),
         _is_initialized(0),
-        _init_ref_count(0)
+        _init_ref_count(0),
+        _read_dummy_bytes(DATAFLASH_LOW_FREQUENCY_BYTES)
 {
     /* check that frequency is within range */
-    if (freq > DATAFLASH_LOW_FREQUENCY) {
+    if (freq > DATAFLASH_HIGH_FREQUENCY) {
 
         /* cap frequency at the highest supported one */
-        _spi.frequency(DATAFLASH_LOW_FREQUENCY);
+        freq = DATAFLASH_HIGH_FREQUENCY;
+    }
 
-    } else {
-        /* freqency is valid, use as-is */
-        _spi.frequency(freq);
+    /* above the low frequency domain, reads need the high frequency opcode */
+    if (freq > DATAFLASH_LOW_FREQUENCY) {
+        _read_dummy_bytes = DATAFLASH_HIGH_FREQUENCY_BYTES;
     }
 
+    _spi.frequency(freq);
+
     /* write protect chip if pin is connected */
     if (nwp != NC) {
         _nwp = 0;
@@ -208,7 +219,7 @@ int DataFlashBlockDevice::init()
             _write_command(DATAFLASH_COMMAND_DATAFLASH_PAGE_SIZE, NULL, 0);
 
             /* wait for device to be ready and update return code */
-            result = _sync();
+            result = _sync(DATAFLASH_TIMING_ERASE_PROGRAM_PAGE);
 
             /* set binary flag */
             binary_page_size = false;
@@ -224,7 +235,7 @@ int DataFlashBlockDevice::init()
             _write_command(DATAFLASH_COMMAND_BINARY_PAGE_SIZE, NULL, 0);
 
             /* wait for device to be ready and update return code */
-            result = _sync();
+            result = _sync(DATAFLASH_TIMING_ERASE_PROGRAM_PAGE);
 
             /* set binary flag */
             binary_page_size = true;
@@ -333,7 +344,11 @@ int DataFlashBlockDevice::read(void *buffer, bd_addr_t addr, bd_size_t size)
         _spi.select();
 
         /* send read opcode */
-        _spi.write(DATAFLASH_OP_READ_LOW_FREQUENCY);
+        if (_read_dummy_bytes == DATAFLASH_HIGH_FREQUENCY_BYTES) {
+            _spi.write(DATAFLASH_OP_READ_HIGH_FREQUENCY);
+        } else {
+            _spi.write(DATAFLASH_OP_READ_LOW_FREQUENCY);
+        }
 
         /* translate address */
         uint32_t address = _translate_address(addr);
@@ -345,11 +360,13 @@ int DataFlashBlockDevice::read(void *buffer, bd_addr_t addr, bd_size_t size)
         _spi.write((address >>  8) & 0xFF);
         _spi.write(address & 0xFF);
 
-        /* clock out one byte at a time and store in external buffer */
-        for (uint32_t index = 0; index < size; index++) {
-            external_buffer[index] = _spi.write(DATAFLASH_OP_NOP);
+        for (uint32_t index = 0; index < _read_dummy_bytes; index++) {
+            _spi.write(DATAFLASH_OP_NOP);
         }
 
+        /* clock out the data in one transfer and store in external buffer */
+        _spi.write(NULL, 0, reinterpret_cast<char *>(external_buffer), size);
+
         _spi.deselect();
 
         result = BD_ERROR_OK;
@@ -385,6 +402,12 @@ int DataFlashBlockDevice::program(const void *buffer, bd_addr_t addr, bd_size_t
         /* disable write protection */
         _write_enable(true);
 
+        /* Whole pages go through the two SRAM buffers in turn, so that one
+           is loaded while the other is programmed into main memory.
+         */
+        uint8_t sram = 0;
+        bool programming = false;
+
         /* continue until all bytes have been written */
         uint32_t bytes_written = 0;
         while (bytes_written < size) {
@@ -397,14 +420,38 @@ int DataFlashBlockDevice::program(const void *buffer, bd_addr_t addr, bd_size_t
                 bytes_remaining = _page_size - page_offset;
             }
 
-            /* Write one page, bytes_written keeps track of the progress,
-               page_number is the page address, and page_offset is non-zero for
-               unaligned writes.
-             */
-            result = _write_page(&external_buffer[bytes_written],
-                                 page_number,
-                                 page_offset,
-                                 bytes_remaining);
+            if (bytes_remaining == _page_size) {
+                /* load the page while the previous one is programmed */
+                _write_buffer(sram, &external_buffer[bytes_written]);
+
+                result = BD_ERROR_OK;
+                if (programming) {
+                    result = _sync(DATAFLASH_TIMING_POLL_PROGRAM_PAGE);
+                }
+                if (result == BD_ERROR_OK) {
+                    _program_buffer(sram, page_number);
+                    programming = true;
+                    sram = (sram + 1) % DATAFLASH_SRAM_COUNT;
+                }
+            } else {
+                /* a partial page is programmed on its own, which uses buffer 1 */
+                result = BD_ERROR_OK;
+                if (programming) {
+                    result = _sync(DATAFLASH_TIMING_POLL_PROGRAM_PAGE);
+                    programming = false;
+                }
+
+                /* Write one page, bytes_written keeps track of the progress,
+                   page_number is the page address, and page_offset is non-zero for
+                   unaligned writes.
+                 */
+                if (result == BD_ERROR_OK) {
+                    result = _write_page(&external_buffer[bytes_written],
+                                         page_number,
+                                         page_offset,
+                                         bytes_remaining);
+                }
+            }
 
             /* update loop variables upon success otherwise break loop */
             if (result == BD_ERROR_OK) {
@@ -420,6 +467,14 @@ int DataFlashBlockDevice::program(const void *buffer, bd_addr_t addr, bd_size_t
             }
         }
 
+        /* wait for the last page to be programmed */
+        if (programming) {
+            int sync_result = _sync(DATAFLASH_TIMING_POLL_PROGRAM_PAGE);
+            if (result == BD_ERROR_OK) {
+                result = sync_result;
+            }
+        }
+
         /* enable write protection */
         _write_enable(false);
     }
@@ -465,7 +520,7 @@ int DataFlashBlockDevice::erase(bd_addr_t addr, bd_size_t size)
             _write_command(command, NULL, 0);
 
             /* wait until device is ready and update return value */
-            result = _sync();
+            result = _sync(DATAFLASH_TIMING_ERASE_PROGRAM_PAGE);
 
             /* if erase failed, break loop */
             if (result != BD_ERROR_OK) {
@@ -584,9 +639,7 @@ void DataFlashBlockDevice::_write_command(uint32_t command, const uint8_t *buffe
 
     /* send optional data */
     if (buffer && size) {
-        for (uint32_t index = 0; index < size; index++) {
-            _spi.write(buffer[index]);
-        }
+        _spi.write(reinterpret_cast<const char *>(buffer), size, NULL, 0);
     }
 
     _spi.deselect();
@@ -625,9 +678,10 @@ void DataFlashBlockDevice::_write_enable(bool enable)
 /**
  * @brief Sleep and poll status register until device is ready for next command.
  *
+ * @param poll_interval Milliseconds between polls.
  * @return BlockDevice compatible error code.
  */
-int DataFlashBlockDevice::_sync(void)
+int DataFlashBlockDevice::_sync(uint32_t poll_interval)
 {
     DEBUG_PRINTF("_sync\r\n");
 
@@ -635,11 +689,11 @@ int DataFlashBlockDevice::_sync(void)
     int result = BD_ERROR_DEVICE_ERROR;
 
     /* Poll device until a hard coded timeout is reached.
-       The polling interval is based on the typical page program time.
+       The polling interval is based on the typical time of the operation.
      */
     for (uint32_t timeout = 0;
             timeout < DATAFLASH_TIMEOUT;
-            timeout += DATAFLASH_TIMING_ERASE_PROGRAM_PAGE) {
+            timeout += poll_interval) {
 
         /* get status register */
         uint16_t status = _get_register(DATAFLASH_OP_STATUS);
@@ -655,8 +709,8 @@ int DataFlashBlockDevice::_sync(void)
             break;
             /* wait the typical write period before trying again */
         } else {
-            DEBUG_PRINTF("sleep_for: %d\r\n", DATAFLASH_TIMING_ERASE_PROGRAM_PAGE);
-            rtos::ThisThread::sleep_for(DATAFLASH_TIMING_ERASE_PROGRAM_PAGE);
+            DEBUG_PRINTF("sleep_for: %" PRIu32 "\r\n", poll_interval);
+            rtos::ThisThread::sleep_for(poll_interval);
         }
     }
 
@@ -686,16 +740,7 @@ int DataFlashBlockDevice::_write_page(const uint8_t *buffer,
      */
     command = DATAFLASH_OP_PROGRAM_DIRECT;
 
-    uint32_t address = 0;
-
-    /* convert page number and offset into device address based on address format */
-    if (_page_size == DATAFLASH_PAGE_SIZE_264) {
-        address = (page << DATAFLASH_PAGE_BIT_264) | offset;
-    } else if (_page_size == DATAFLASH_PAGE_SIZE_528) {
-        address = (page << DATAFLASH_PAGE_BIT_528) | offset;
-    } else {
-        address = (page * _page_size) | offset;
-    }
+    uint32_t address = _page_address(page, offset);
 
     /* set write address */
     command = (command << 8) | ((address >> 16) & 0xFF);
@@ -706,11 +751,73 @@ int DataFlashBlockDevice::_write_page(const uint8_t *buffer,
     _write_command(command, buffer, size);
 
     /* wait until device is ready before continuing */
-    int result = _sync();
+    int result = _sync(DATAFLASH_TIMING_ERASE_PROGRAM_PAGE);
 
     return result;
 }
 
+/**
+ * @brief Load a whole page into one of the SRAM buffers.
+ * @details The device may be busy programming from the other buffer.
+ *
+ * @param sram Buffer to load, 0 or 1.
+ * @param buffer Data of the page.
+ */
+void DataFlashBlockDevice::_write_buffer(uint8_t sram, const uint8_t *buffer)
+{
+    DEBUG_PRINTF("_write_buffer: %d %p\r\n", sram, buffer);
+
+    /* buffer address 0, the page is loaded in full */
+    uint32_t command = (sram == 0) ? DATAFLASH_OP_BUFFER_1_WRITE : DATAFLASH_OP_BUFFER_2_WRITE;
+
+    _write_command(command << 24, buffer, _page_size);
+}
+
+/**
+ * @brief Start programming a page from one of the SRAM buffers.
+ * @details The whole buffer is programmed, so it must hold the whole page.
+ *          Returns without waiting for the programming to finish.
+ *
+ * @param sram Buffer to program from, 0 or 1.
+ * @param page Page to program.
+ */
+void DataFlashBlockDevice::_program_buffer(uint8_t sram, uint32_t page)
+{
+    DEBUG_PRINTF("_program_buffer: %d %" PRIX32 "\r\n", sram, page);
+
+    uint32_t command = (sram == 0) ? DATAFLASH_OP_BUFFER_1_PROGRAM : DATAFLASH_OP_BUFFER_2_PROGRAM;
+    uint32_t address = _page_address(page, 0);
+
+    command = (command << 8) | ((address >> 16) & 0xFF);
+    command = (command << 8) | ((address >>  8) & 0xFF);
+    command = (command << 8) | (address & 0xFF);
+
+    _write_command(command, NULL, 0);
+}
+
+/**
+ * @brief Convert page number and offset into device address.
+ *
+ * @param page Page number.
+ * @param offset Offset in page.
+ * @return Address in format expected by device.
+ */
+uint32_t DataFlashBlockDevice::_page_address(uint32_t page, uint32_t offset)
+{
+    uint32_t address = 0;
+
+    /* convert page number and offset into device address based on address format */
+    if (_page_size == DATAFLASH_PAGE_SIZE_264) {
+        address = (page << DATAFLASH_PAGE_BIT_264) | offset;
+    } else if (_page_size == DATAFLASH_PAGE_SIZE_528) {
+        address = (page << DATAFLASH_PAGE_BIT_528) | offset;
+    } else {
+        address = (page * _page_size) | offset;
+    }
+
+    return address;
+}
+
 /**
  * @brief Translate address.
  * @details If the device is configured for non-binary page sizes,
@@ -24,6 +24,18 @@
 #include "blockdevice/BlockDevice.h"
 #include "platform/mbed_toolchain.h"
 
+/** Remember which sectors this block device erased and hasn't programmed
+ *  since, so erasing them again is skipped
+ *
+ *  Disabled by default. Only enable it if nothing but this block device
+ *  writes to its flash region while it is initialized: no bootloader or
+ *  FOTA agent programming the region from the application, and no other
+ *  FlashIAP or FlashIAPBlockDevice instance covering it.
+ */
+#ifndef MBED_CONF_FLASHIAP_BLOCK_DEVICE_ERASE_TRACKING
+#define MBED_CONF_FLASHIAP_BLOCK_DEVICE_ERASE_TRACKING 0
+#endif
+
 /** BlockDevice using the FlashIAP API
  *
  */
@@ -76,6 +88,9 @@ public:
      *
      *  The state of an erased block is undefined until it has been programmed
      *
+     *  With erase tracking enabled, sectors erased by this block device and
+     *  not programmed since are not erased again.
+     *
      *  @param addr     Address of block to begin erasing
      *  @param size     Size to erase in bytes, must be a multiple of erase block size
      *  @return         0 on success, negative error code on failure
@@ -116,6 +131,28 @@ public:
      */
     virtual int get_erase_value() const;
 
+    /** Get a pointer to the region in the internal flash memory map
+     *
+     *  @param addr     Address of block to begin reading from
+     *  @param size     Size of the region in bytes
+     *  @return         Pointer to the region, or NULL if the read is not valid
+     */
+    virtual const void *get_mapped_address(mbed::bd_addr_t addr, mbed::bd_size_t size) const;
+
+    /** Check whether a region was erased by this block device and not programmed since
+     *
+     *  @param addr     Address of block to begin checking
+     *  @param size     Size of the region in bytes
+     *  @return         True if the whole region is known to be erased
+     */
+    virtual bool is_erased(mbed::bd_addr_t addr, mbed::bd_size_t size) const;
+
+    /** Get the optional capabilities of the block device
+     *
+     *  @return         BD_CAPABILITY_MAPPED, and BD_CAPABILITY_ERASE_STATE when erase tracking is enabled
+     */
+    virtual uint32_t get_capabilities() const;
+
     /** Get the total size of the underlying device
      *
      *  @return         Size of the underlying device in bytes
@@ -138,12 +175,21 @@ public:
 
 
 private:
+    // Erase tracking, one bit per smallest sector in the region
+    void erase_state_init();
+    void erase_state_range(mbed::bd_addr_t addr, mbed::bd_size_t size, uint32_t &first, uint32_t &end) const;
+    bool erase_state_get(mbed::bd_addr_t addr, mbed::bd_size_t size) const;
+    void erase_state_set(mbed::bd_addr_t addr, mbed::bd_size_t size, bool erased);
+
     // Device configuration
     mbed::FlashIAP _flash;
     mbed::bd_addr_t _base;
     mbed::bd_size_t _size;
     bool _is_initialized;
     uint32_t _init_ref_count;
+
+    uint8_t *_erased;
+    uint32_t _erase_unit;
 };
 
 #endif /* DEVICE_FLASH */
@@ -23,6 +23,7 @@
 
 using namespace mbed;
 #include <inttypes.h>
+#include <new>
 
 #define FLASHIAP_READ_SIZE 1
 
@@ -38,7 +39,8 @@ using namespace mbed;
 #endif
 
 FlashIAPBlockDevice::FlashIAPBlockDevice(uint32_t address, uint32_t size)
-    : _flash(), _base(address), _size(size), _is_initialized(false), _init_ref_count(0)
+    : _flash(), _base(address), _size(size), _is_initialized(false), _init_ref_count(0),
+      _erased(NULL), _erase_unit(0)
 {
     if ((address == 0xFFFFFFFF) || (size == 0)) {
         MBED_ERROR(MBED_ERROR_INVALID_ARGUMENT,
@@ -90,6 +92,8 @@ int FlashIAPBlockDevice::init()
         _size = _flash.get_flash_size() - (_base - _flash.get_flash_start());
     }
 
+    erase_state_init();
+
     _is_initialized = true;
     return ret;
 }
@@ -111,6 +115,9 @@ int FlashIAPBlockDevice::deinit()
 
     _is_initialized = false;
 
+    delete[] _erased;
+    _erased = NULL;
+
     return _flash.deinit();
 }
 
@@ -153,6 +160,9 @@ int FlashIAPBlockDevice::program(const void *buffer,
         /* Convert virtual address to the physical address for the device. */
         bd_addr_t physical_address = _base + virtual_address;
 
+        /* Touched sectors need erasing again, even if programming fails. */
+        erase_state_set(virtual_address, size, false);
+
         /* Write data using the internal flash driver. */
         result = _flash.program(buffer, physical_address, size);
 
@@ -178,8 +188,28 @@ int FlashIAPBlockDevice::erase(bd_addr_t virtual_address,
         /* Convert virtual address to the physical address for the device. */
         bd_addr_t physical_address = _base + virtual_address;
 
-        /* Erase sector */
-        result = _flash.erase(physical_address, size);
+        if (!_erased) {
+            /* Erase sector */
+            result = _flash.erase(physical_address, size);
+        } else {
+            /* Erase sector by sector, skipping the ones still erased. */
+            result = BD_ERROR_OK;
+            while (size && !result) {
+                bd_size_t sector_size = get_erase_size(virtual_address);
+
+                if (!erase_state_get(virtual_address, sector_size)) {
+                    result = _flash.erase(_base + virtual_address, sector_size);
+                    if (!result) {
+                        erase_state_set(virtual_address, sector_size, true);
+                    }
+                } else {
+                    DEBUG_PRINTF("erase skipped: %" PRIX64 "\r\n", virtual_address);
+                }
+
+                virtual_address += sector_size;
+                size -= sector_size;
+            }
+        }
     }
 
     return result;
@@ -244,6 +274,34 @@ int FlashIAPBlockDevice::get_erase_value() const
     return erase_val;
 }
 
+const void *FlashIAPBlockDevice::get_mapped_address(bd_addr_t virtual_address, bd_size_t size) const
+{
+    if (!_is_initialized || !is_valid_read(virtual_address, size)) {
+        return NULL;
+    }
+
+    /* Internal flash is memory mapped at its physical address. */
+    return reinterpret_cast<const void *>(static_cast<uintptr_t>(_base + virtual_address));
+}
+
+bool FlashIAPBlockDevice::is_erased(bd_addr_t virtual_address, bd_size_t size) const
+{
+    if (!_is_initialized || !size || virtual_address + size > _size) {
+        return false;
+    }
+
+    return erase_state_get(virtual_address, size);
+}
+
+uint32_t FlashIAPBlockDevice::get_capabilities() const
+{
+    uint32_t capabilities = BD_CAPABILITY_MAPPED;
+    if (_erased) {
+        capabilities |= BD_CAPABILITY_ERASE_STATE;
+    }
+    return capabilities;
+}
+
 
 bd_size_t FlashIAPBlockDevice::size() const
 {
@@ -267,4 +325,80 @@ bool FlashIAPBlockDevice::is_valid_erase(bd_addr_t addr, bd_size_t size) const
                base_addr % get_erase_size(addr) == 0 &&
                (base_addr + size) % get_erase_size(addr + size - 1) == 0);
 }
+
+void FlashIAPBlockDevice::erase_state_init()
+{
+#if MBED_CONF_FLASHIAP_BLOCK_DEVICE_ERASE_TRACKING
+    /* Track at the granularity of the smallest sector in the region. */
+    uint32_t unit = 0;
+    for (bd_addr_t addr = 0; addr < _size;) {
+        uint32_t sector_size = _flash.get_sector_size(_base + addr);
+        if (!sector_size) {
+            return;
+        }
+
+        if (!unit || sector_size < unit) {
+            unit = sector_size;
+        }
+        addr += sector_size;
+    }
+
+    if (!unit) {
+        return;
+    }
+
+    _erase_unit = unit;
+
+    uint32_t first, end;
+    erase_state_range(0, _size, first, end);
+
+    /* Nothing is known to be erased yet. Tracking stays off without memory. */
+    _erased = new (std::nothrow) uint8_t[(end + 7) / 8]();
+#endif
+}
+
+void FlashIAPBlockDevice::erase_state_range(bd_addr_t addr, bd_size_t size, uint32_t &first, uint32_t &end) const
+{
+    /* Sectors are aligned to the start of the flash, not to our base. */
+    bd_addr_t offset = _base - _flash.get_flash_start();
+
+    first = (offset + addr) / _erase_unit - offset / _erase_unit;
+    end = (offset + addr + size + _erase_unit - 1) / _erase_unit - offset / _erase_unit;
+}
+
+bool FlashIAPBlockDevice::erase_state_get(bd_addr_t addr, bd_size_t size) const
+{
+    if (!_erased) {
+        return false;
+    }
+
+    uint32_t first, end;
+    erase_state_range(addr, size, first, end);
+
+    for (uint32_t i = first; i < end; i++) {
+        if (!(_erased[i / 8] & (1 << (i % 8)))) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void FlashIAPBlockDevice::erase_state_set(bd_addr_t addr, bd_size_t size, bool erased)
+{
+    if (!_erased) {
+        return;
+    }
+
+    uint32_t first, end;
+    erase_state_range(addr, size, first, end);
+
+    for (uint32_t i = first; i < end; i++) {
+        if (erased) {
+            _erased[i / 8] |= (1 << (i % 8));
+        } else {
+            _erased[i / 8] &= ~(1 << (i % 8));
+        }
+    }
+}
 #endif /* DEVICE_FLASH */
@@ -152,6 +152,16 @@ public:
      */
     virtual mbed::bd_size_t get_program_size() const;
 
+    /** Get the page size of the device
+     *
+     *  Any size can be programmed, but each page touched by a program costs
+     *  a write cycle of the EEPROM, so callers that can pick their alignment
+     *  should program whole, aligned pages.
+     *
+     *  @return         Size of a page in bytes
+     */
+    mbed::bd_size_t get_page_size() const;
+
     /** Get the size of a eraseable block
      *
      *  @return         Size of a eraseable block in bytes
@@ -178,9 +188,16 @@ private:
     bool _address_is_eight_bit;
     uint32_t _size;
     uint32_t _block;
+    char *_page_buffer;
 
     int _sync();
 
+    /** Fill the page buffer with the address and data of one page write
+     *
+     *  @return Number of bytes of the buffer to send
+     */
+    int _prepare_page(mbed::bd_addr_t addr, const char *data, mbed::bd_size_t size);
+
     /**
      * Gets the device's I2C address with respect to the requested page.
      * When eight-bit mode is disabled, this function is a noop.
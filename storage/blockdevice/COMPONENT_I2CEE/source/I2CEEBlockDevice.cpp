@@ -14,11 +14,25 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <string.h>
 #include "I2CEEBlockDevice.h"
+#include "drivers/Timer.h"
+#include "platform/mbed_wait_api.h"
 #include "rtos/ThisThread.h"
 using namespace mbed;
+using namespace std::chrono;
 
-#define I2CEE_TIMEOUT 10000
+#define I2CEE_TIMEOUT 10s
+
+// Most EEPROMs finish a page within a few ms, so poll for that long with
+// a fine interval before falling back to sleeping a tick between polls
+#ifndef MBED_CONF_I2CEE_BUSY_POLL_US
+#define MBED_CONF_I2CEE_BUSY_POLL_US        5000
+#endif
+
+#ifndef MBED_CONF_I2CEE_POLL_INTERVAL_US
+#define MBED_CONF_I2CEE_POLL_INTERVAL_US    50
+#endif
 
 
 I2CEEBlockDevice::I2CEEBlockDevice(
@@ -29,6 +43,7 @@ I2CEEBlockDevice::I2CEEBlockDevice(
     , _address_is_eight_bit(address_is_eight_bit)
     , _size(size)
     , _block(block)
+    , _page_buffer(new char[block + 2])
 {
     _i2c = new (_i2c_buffer) I2C(sda, scl);
     _i2c->frequency(freq);
@@ -42,6 +57,7 @@ I2CEEBlockDevice::I2CEEBlockDevice(
     , _address_is_eight_bit(address_is_eight_bit)
     , _size(size)
     , _block(block)
+    , _page_buffer(new char[block + 2])
 {
     _i2c = i2c_obj;
 }
@@ -50,6 +66,7 @@ I2CEEBlockDevice::~I2CEEBlockDevice()
     if (_i2c == (I2C *)_i2c_buffer) {
         _i2c->~I2C();
     }
+    delete[] _page_buffer;
 }
 
 int I2CEEBlockDevice::init()
@@ -99,47 +116,55 @@ int I2CEEBlockDevice::program(const void *buffer, bd_addr_t addr, bd_size_t size
 
     const auto *pBuffer = static_cast<const char *>(buffer);
 
-    // While we have some more data to write.
-    while (size > 0) {
-        uint32_t off = addr % _block;
-        uint32_t chunk = (off + size < _block) ? size : (_block - off);
-
-        _i2c->start();
+    if (size == 0) {
+        return BD_ERROR_OK;
+    }
 
-        if (1 != _i2c->write(get_paged_device_address(addr))) {
-            return BD_ERROR_DEVICE_ERROR;
-        }
+    uint32_t chunk = _block - (addr % _block);
+    if (chunk > size) {
+        chunk = size;
+    }
+    int length = _prepare_page(addr, pBuffer, chunk);
 
-        if (!_address_is_eight_bit && 1 != _i2c->write((char)(addr >> 8u))) {
+    // While we have some more data to write.
+    while (size > 0) {
+        if (0 != _i2c->write(get_paged_device_address(addr), _page_buffer, length)) {
             return BD_ERROR_DEVICE_ERROR;
         }
 
-        if (1 != _i2c->write((char)(addr & 0xffu))) {
-            return BD_ERROR_DEVICE_ERROR;
-        }
+        addr += chunk;
+        size -= chunk;
+        pBuffer += chunk;
 
-        for (unsigned i = 0; i < chunk; i++) {
-            if (1 != _i2c->write(pBuffer[i])) {
-                return BD_ERROR_DEVICE_ERROR;
-            }
+        // Prepare the next page while the EEPROM writes this one
+        if (size > 0) {
+            chunk = (size < _block) ? size : _block;
+            length = _prepare_page(addr, pBuffer, chunk);
         }
 
-        _i2c->stop();
-
         int err = _sync();
 
         if (err) {
             return err;
         }
-
-        addr += chunk;
-        size -= chunk;
-        pBuffer += chunk;
     }
 
     return BD_ERROR_OK;
 }
 
+int I2CEEBlockDevice::_prepare_page(bd_addr_t addr, const char *data, bd_size_t size)
+{
+    int length = 0;
+
+    if (!_address_is_eight_bit) {
+        _page_buffer[length++] = (char)(addr >> 8u);
+    }
+    _page_buffer[length++] = (char)(addr & 0xffu);
+
+    memcpy(&_page_buffer[length], data, size);
+    return length + (int)size;
+}
+
 int I2CEEBlockDevice::erase(bd_addr_t addr, bd_size_t size)
 {
     // No erase needed
@@ -151,15 +176,25 @@ int I2CEEBlockDevice::_sync()
     // The chip doesn't ACK while writing to the actual EEPROM
     // so loop trying to do a zero byte write until it is ACKed
     // by the chip.
-    for (int i = 0; i < I2CEE_TIMEOUT; i++) {
+    Timer timer;
+    timer.start();
+
+    while (true) {
         if (_i2c->write(_i2c_addr | 0, 0, 0) < 1) {
             return 0;
         }
 
-        rtos::ThisThread::sleep_for(1);
-    }
+        microseconds elapsed = timer.elapsed_time();
+        if (elapsed >= I2CEE_TIMEOUT) {
+            return BD_ERROR_DEVICE_ERROR;
+        }
 
-    return BD_ERROR_DEVICE_ERROR;
+        if (elapsed < microseconds(MBED_CONF_I2CEE_BUSY_POLL_US)) {
+            wait_us(MBED_CONF_I2CEE_POLL_INTERVAL_US);
+        } else {
+            rtos::ThisThread::sleep_for(1ms);
+        }
+    }
 }
 
 bd_size_t I2CEEBlockDevice::get_read_size() const
@@ -172,6 +207,11 @@ bd_size_t I2CEEBlockDevice::get_program_size() const
     return 1;
 }
 
+bd_size_t I2CEEBlockDevice::get_page_size() const
+{
+    return _block;
+}
+
 bd_size_t I2CEEBlockDevice::get_erase_size() const
 {
     return 1;
@@ -92,6 +92,18 @@ enum ospif_polarity_mode {
     OSPIF_POLARITY_MODE_1      /* CPOL=1, CPHA=1 */
 };
 
+/** Transfer mode of the OSPIF reads
+ *
+ *  @see OSPIFBlockDevice::get_transfer_mode()
+ */
+struct ospif_transfer_mode {
+    ospi_bus_width_t inst_width;    /* Bus width of the instruction phase */
+    ospi_bus_width_t address_width; /* Bus width of the address phase */
+    ospi_bus_width_t data_width;    /* Bus width of the data phase */
+    uint8_t dummy_cycles;           /* Dummy cycles before the data phase */
+    mbed::ospi_inst_t instruction;  /* Read instruction */
+};
+
 #define OSPIF_MAX_ACTIVE_FLASH_DEVICES 10
 
 /** BlockDevice for SFDP based flash devices over OSPI bus
@@ -290,6 +302,16 @@ public:
      */
     virtual int change_mode(int mode);
 
+    /** Get the transfer mode of the reads
+     *
+     *  The fastest mode the SFDP tables advertise is selected by init(). The
+     *  octal modes are only kept if data reads back as in SPI mode, DOPI
+     *  falling back to SOPI and then to SPI.
+     *
+     *  @return         Bus widths, dummy cycles and instruction of the reads
+     */
+    ospif_transfer_mode get_transfer_mode() const;
+
 private:
     /********************************/
     /*   Different Device Csel Mgmt */
@@ -348,8 +370,8 @@ private:
     // Enable Fast Mode - for flash chips with low power default
     int _enable_fast_mode();
 
-    // Enable OPI Mode
-    int _enable_opi_mdoe();
+    // Enable the fastest OPI Mode reading back the same data as SPI mode
+    int _enable_opi_mode();
 
     // Query vendor ID and handle special behavior that isn't covered by SFDP data
     int _handle_vendor_quirks();
@@ -168,6 +168,9 @@ using namespace mbed;
 // Length of data returned from RDID instruction
 #define OSPI_RDID_DATA_LENGTH 3
 
+// Length of data read back to verify an OPI mode, even for DOPI mode
+#define OSPIF_OPI_VERIFY_DATA_LENGTH 16
+
 
 /* Init function to initialize Different Devices CS static list */
 static PinName *generate_initialized_active_ospif_csel_arr();
@@ -769,6 +772,43 @@ int OSPIFBlockDevice::change_mode(int mode)
     return status;
 }
 
+ospif_transfer_mode OSPIFBlockDevice::get_transfer_mode() const
+{
+    ospif_transfer_mode mode;
+    mode.inst_width = _inst_width;
+    mode.address_width = _address_width;
+    mode.data_width = _data_width;
+    mode.dummy_cycles = _dummy_cycles;
+    mode.instruction = _read_instruction;
+    return mode;
+}
+
+int OSPIFBlockDevice::_enable_opi_mode()
+{
+    static const int opi_modes[] = { DOPI, SOPI };
+    uint8_t expected[OSPIF_OPI_VERIFY_DATA_LENGTH];
+    uint8_t data[OSPIF_OPI_VERIFY_DATA_LENGTH];
+
+    // Reference data, read in SPI mode
+    if ((OSPIF_BD_ERROR_OK != change_mode(SPI)) ||
+            (OSPI_STATUS_OK != _ospi_send_read_command(_read_instruction, expected, 0, sizeof(expected)))) {
+        tr_error("OPI mode - Reading reference data failed");
+        return -1;
+    }
+
+    for (int mode : opi_modes) {
+        if ((OSPIF_BD_ERROR_OK == change_mode(mode)) &&
+                (OSPI_STATUS_OK == _ospi_send_read_command(_read_instruction, data, 0, sizeof(data))) &&
+                (0 == memcmp(expected, data, sizeof(data)))) {
+            tr_debug("Init - Setting %s mode", (mode == DOPI) ? "DOPI" : "SOPI");
+            return 0;
+        }
+        tr_warning("Init - %s mode read back failed", (mode == DOPI) ? "DOPI" : "SOPI");
+    }
+
+    change_mode(SPI);
+    return -1;
+}
 
 /********************************/
 /*   Different Device Csel Mgmt */
@@ -878,8 +918,9 @@ int OSPIFBlockDevice::_sfdp_parse_basic_param_table(Callback<int(bd_addr_t, void
     // Detect and Set fastest Bus mode (default 1-1-1)
     _sfdp_detect_best_bus_read_mode(param_table, sfdp_info.bptbl.size, shouldSetQuadEnable, is_qpi_mode, is_opi_mode);
     if (true == is_opi_mode) {
-        change_mode(DOPI);
-        tr_debug("Init - Setting DOPI mode");
+        if (0 != _enable_opi_mode()) {
+            tr_warning("Device supports OPI bus, but OPI mode read back failed, using SPI mode");
+        }
     }
     if (true == shouldSetQuadEnable) {
         if (_needs_fast_mode) {
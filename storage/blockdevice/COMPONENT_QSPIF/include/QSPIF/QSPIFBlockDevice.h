@@ -248,6 +248,50 @@ public:
      */
     virtual const char *get_type() const;
 
+#if DEVICE_QSPI_MEMORY_MAPPED || defined(DOXYGEN_ONLY)
+    /** Switch reads to memory-mapped (XIP) mode
+     *
+     *  The QSPI peripheral maps the whole flash into the address space using the
+     *  fastest read mode found in SFDP, and read() becomes a plain copy from that window.
+     *  Program and erase temporarily drop back to command mode; mapped mode is
+     *  restored once they complete.
+     *
+     *  @return         QSPIF_BD_ERROR_OK(0) - success
+     *                  QSPIF_BD_ERROR_DEVICE_ERROR - device is not initialized, cannot be mapped
+     *                                                as a whole or the HAL failed to enter mapped mode
+     */
+    int memory_mapped_enable();
+
+    /** Switch reads back to command mode
+     *
+     *  @return         QSPIF_BD_ERROR_OK(0) - success
+     *                  QSPIF_BD_ERROR_DEVICE_ERROR - device driver transaction failed
+     */
+    int memory_mapped_disable();
+
+    /** Get the start of the memory-mapped window
+     *
+     *  The pointer is only valid while no program or erase is in progress.
+     *
+     *  @return         Address of flash offset 0, or NULL if the device is not currently mapped
+     */
+    const void *get_memory_mapped_address() const;
+
+    /** Get a pointer through which a region can be read directly
+     *
+     *  @param addr     Address of the region
+     *  @param size     Size of the region in bytes
+     *  @return         Pointer to the region inside the mapped window, or NULL if not mapped
+     */
+    virtual const void *get_mapped_address(mbed::bd_addr_t addr, mbed::bd_size_t size) const;
+
+    /** Get the optional capabilities of the block device
+     *
+     *  @return         BD_CAPABILITY_MAPPED while the device is memory mapped
+     */
+    virtual uint32_t get_capabilities() const;
+#endif
+
 private:
     /********************************/
     /*   Different Device Csel Mgmt */
@@ -332,6 +376,17 @@ private:
     // Detect 4-byte addressing mode and enable it if supported
     int _sfdp_detect_and_enable_4byte_addressing(uint8_t *basic_param_table_ptr, int basic_param_table_size);
 
+#if DEVICE_QSPI_MEMORY_MAPPED
+    /****************************************/
+    /* Memory-Mapped Mode Functions         */
+    /****************************************/
+    // Enter memory-mapped mode using the current read instruction and bus format, if requested and not already mapped
+    qspi_status_t _memory_mapped_enter();
+
+    // Leave memory-mapped mode, if mapped, and restore the default 1-1-1 bus format
+    qspi_status_t _memory_mapped_exit();
+#endif
+
 private:
     enum qspif_clear_protection_method_t {
         QSPIF_BP_ULBPR,    // Issue global protection unlock instruction
@@ -394,6 +449,11 @@ private:
 
     uint32_t _init_ref_count;
     bool _is_initialized;
+
+#if DEVICE_QSPI_MEMORY_MAPPED
+    bool _memory_mapped; // Whether memory-mapped reads were requested
+    const void *_mapped_base; // Start of the mapped window, NULL while in command mode
+#endif
 };
 
 #endif
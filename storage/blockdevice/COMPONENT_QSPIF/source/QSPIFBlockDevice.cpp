@@ -176,6 +176,11 @@ QSPIFBlockDevice::QSPIFBlockDevice(PinName io0, PinName io1, PinName io2, PinNam
     // Set default 4-byte addressing extension register write instruction
     _attempt_4_byte_addressing = true;
     _4byte_msb_reg_write_inst = QSPIF_INST_4BYTE_REG_WRITE_DEFAULT;
+
+#if DEVICE_QSPI_MEMORY_MAPPED
+    _memory_mapped = false;
+    _mapped_base = NULL;
+#endif
 }
 
 int QSPIFBlockDevice::init()
@@ -293,6 +298,13 @@ int QSPIFBlockDevice::deinit()
         return result;
     }
 
+#if DEVICE_QSPI_MEMORY_MAPPED
+    if (QSPI_STATUS_OK != _memory_mapped_exit()) {
+        result = QSPIF_BD_ERROR_DEVICE_ERROR;
+    }
+    _memory_mapped = false;
+#endif
+
     // Disable Device for Writing
     qspi_status_t status = _qspi_send_general_command(QSPIF_INST_WRDI, QSPI_NO_ADDRESS_COMMAND, NULL, 0, NULL, 0);
     if (status != QSPI_STATUS_OK)  {
@@ -318,6 +330,14 @@ int QSPIFBlockDevice::read(void *buffer, bd_addr_t addr, bd_size_t size)
 
     _mutex.lock();
 
+#if DEVICE_QSPI_MEMORY_MAPPED
+    if (_memory_mapped && QSPI_STATUS_OK == _memory_mapped_enter()) {
+        memcpy(buffer, static_cast<const uint8_t *>(_mapped_base) + addr, size);
+        _mutex.unlock();
+        return status;
+    }
+#endif
+
     if (QSPI_STATUS_OK != _qspi_send_read_command(_read_instruction, buffer, addr, size)) {
         tr_error("Read Command failed");
         status = QSPIF_BD_ERROR_DEVICE_ERROR;
@@ -348,6 +368,14 @@ int QSPIFBlockDevice::program(const void *buffer, bd_addr_t addr, bd_size_t size
 
         _mutex.lock();
 
+#if DEVICE_QSPI_MEMORY_MAPPED
+        if (QSPI_STATUS_OK != _memory_mapped_exit()) {
+            program_failed = true;
+            status = QSPIF_BD_ERROR_DEVICE_ERROR;
+            goto exit_point;
+        }
+#endif
+
         //Send WREN
         if (_set_write_enable() != 0) {
             tr_error("Write Enabe failed");
@@ -382,6 +410,12 @@ exit_point:
         _mutex.unlock();
     }
 
+#if DEVICE_QSPI_MEMORY_MAPPED
+    _mutex.lock();
+    _memory_mapped_enter();
+    _mutex.unlock();
+#endif
+
     return status;
 }
 
@@ -439,6 +473,14 @@ int QSPIFBlockDevice::erase(bd_addr_t addr, bd_size_t size)
 
         _mutex.lock();
 
+#if DEVICE_QSPI_MEMORY_MAPPED
+        if (QSPI_STATUS_OK != _memory_mapped_exit()) {
+            erase_failed = true;
+            status = QSPIF_BD_ERROR_DEVICE_ERROR;
+            goto exit_point;
+        }
+#endif
+
         if (_set_write_enable() != 0) {
             tr_error("QSPI Erase Device not ready - failed");
             erase_failed = true;
@@ -477,6 +519,12 @@ exit_point:
         _mutex.unlock();
     }
 
+#if DEVICE_QSPI_MEMORY_MAPPED
+    _mutex.lock();
+    _memory_mapped_enter();
+    _mutex.unlock();
+#endif
+
     return status;
 }
 
@@ -549,6 +597,68 @@ int QSPIFBlockDevice::get_erase_value() const
     return 0xFF;
 }
 
+#if DEVICE_QSPI_MEMORY_MAPPED
+int QSPIFBlockDevice::memory_mapped_enable()
+{
+    int status = QSPIF_BD_ERROR_OK;
+
+    _mutex.lock();
+
+    if (!_is_initialized) {
+        status = QSPIF_BD_ERROR_DEVICE_ERROR;
+    } else if ((_sfdp_info.bptbl.device_size_bytes > (1 << 24)) && (_address_size != QSPI_CFG_ADDR_SIZE_32)) {
+        // The upper part of the device is only reachable through the extended address register
+        tr_error("Memory-mapped mode requires 4-byte addressing on devices larger than 16MB");
+        status = QSPIF_BD_ERROR_DEVICE_ERROR;
+    } else {
+        _memory_mapped = true;
+        if (QSPI_STATUS_OK != _memory_mapped_enter()) {
+            _memory_mapped = false;
+            status = QSPIF_BD_ERROR_DEVICE_ERROR;
+        }
+    }
+
+    _mutex.unlock();
+
+    return status;
+}
+
+int QSPIFBlockDevice::memory_mapped_disable()
+{
+    int status = QSPIF_BD_ERROR_OK;
+
+    _mutex.lock();
+
+    _memory_mapped = false;
+    if (QSPI_STATUS_OK != _memory_mapped_exit()) {
+        status = QSPIF_BD_ERROR_DEVICE_ERROR;
+    }
+
+    _mutex.unlock();
+
+    return status;
+}
+
+const void *QSPIFBlockDevice::get_memory_mapped_address() const
+{
+    return _mapped_base;
+}
+
+const void *QSPIFBlockDevice::get_mapped_address(bd_addr_t addr, bd_size_t size) const
+{
+    if (!_mapped_base || (addr + size) > _sfdp_info.bptbl.device_size_bytes) {
+        return NULL;
+    }
+
+    return static_cast<const uint8_t *>(_mapped_base) + addr;
+}
+
+uint32_t QSPIFBlockDevice::get_capabilities() const
+{
+    return _mapped_base ? BD_CAPABILITY_MAPPED : 0;
+}
+#endif
+
 /********************************/
 /*   Different Device Csel Mgmt */
 /********************************/
@@ -1273,6 +1383,60 @@ bool QSPIFBlockDevice::_is_mem_ready()
 /***************************************************/
 /*********** QSPI Driver API Functions *************/
 /***************************************************/
+#if DEVICE_QSPI_MEMORY_MAPPED
+qspi_status_t QSPIFBlockDevice::_memory_mapped_enter()
+{
+    if (!_memory_mapped) {
+        return QSPI_STATUS_ERROR;
+    }
+
+    if (_mapped_base) {
+        return QSPI_STATUS_OK;
+    }
+
+    // Mapped reads use the best bus mode supported by the part, just like command mode reads
+    qspi_status_t status = _qspi.configure_format(_inst_width, _address_width, _address_size, _address_width, // Alt width should be the same as address width
+                                                  _alt_size, _data_width, _dummy_cycles);
+    if (QSPI_STATUS_OK != status) {
+        tr_error("_qspi_configure_format failed");
+        return status;
+    }
+
+    status = _qspi.memory_mapped_enter(_read_instruction, (_alt_size == 0) ? -1 : QSPI_ALT_DEFAULT_VALUE, &_mapped_base);
+    if (QSPI_STATUS_OK != status) {
+        tr_error("QSPI entering memory-mapped mode failed");
+        _mapped_base = NULL;
+        _qspi.configure_format(QSPI_CFG_BUS_SINGLE, QSPI_CFG_BUS_SINGLE, _address_size, QSPI_CFG_BUS_SINGLE, 0, QSPI_CFG_BUS_SINGLE, 0);
+        return status;
+    }
+
+    return QSPI_STATUS_OK;
+}
+
+qspi_status_t QSPIFBlockDevice::_memory_mapped_exit()
+{
+    if (!_mapped_base) {
+        return QSPI_STATUS_OK;
+    }
+
+    qspi_status_t status = _qspi.memory_mapped_exit();
+    if (QSPI_STATUS_OK != status) {
+        tr_error("QSPI leaving memory-mapped mode failed");
+        return status;
+    }
+    _mapped_base = NULL;
+
+    // All commands other than Read and RSFDP use default 1-1-1 bus mode
+    status = _qspi.configure_format(QSPI_CFG_BUS_SINGLE, QSPI_CFG_BUS_SINGLE, _address_size, QSPI_CFG_BUS_SINGLE, 0, QSPI_CFG_BUS_SINGLE, 0);
+    if (QSPI_STATUS_OK != status) {
+        tr_error("_qspi_configure_format failed");
+        return status;
+    }
+
+    return QSPI_STATUS_OK;
+}
+#endif
+
 qspi_status_t QSPIFBlockDevice::_qspi_set_frequency(int freq)
 {
     return _qspi.set_frequency(freq);
@@ -51,6 +51,10 @@
 #ifndef MBED_CONF_SD_CRC_ENABLED
 #define MBED_CONF_SD_CRC_ENABLED 0
 #endif
+/** Move data blocks with asynchronous (DMA capable) SPI transfers, on targets supporting SPI_ASYNCH */
+#ifndef MBED_CONF_SD_DMA_ENABLED
+#define MBED_CONF_SD_DMA_ENABLED 0
+#endif
 
 /** SDBlockDevice class
  *
@@ -103,6 +107,17 @@ public:
      */
     virtual int deinit();
 
+    /** Ensure that data on a block device is in sync with the underlying storage
+     *
+     *  Ends a multiple block transfer left open for contiguous requests.
+     *
+     *  @return         BD_ERROR_OK(0) - success
+     *                  SD_BLOCK_DEVICE_ERROR_NO_DEVICE - device (SD card) is missing or not connected
+     *                  SD_BLOCK_DEVICE_ERROR_NO_INIT - device is not initialized
+     *                  SD_BLOCK_DEVICE_ERROR_WRITE - SPI write error
+     */
+    virtual int sync();
+
     /** Read blocks from a block device
      *
      *  @param buffer   Buffer to write blocks to
@@ -154,6 +169,12 @@ public:
      */
     virtual int trim(mbed::bd_addr_t addr, mbed::bd_size_t size);
 
+    /** Get the optional capabilities of the block device
+     *
+     *  @return         BD_CAPABILITY_TRIM, trims are sent to the card as erases
+     */
+    virtual uint32_t get_capabilities() const;
+
     /** Get the size of a readable block
      *
      *  @return         Size of a readable block in bytes
@@ -271,6 +292,17 @@ private:
     int _read(uint8_t *buffer, uint32_t length);
     int _read_bytes(uint8_t *buffer, uint32_t length);
     uint8_t _write(const uint8_t *buffer, uint8_t token, uint32_t length);
+    void _spi_block(const uint8_t *tx_buffer, uint8_t *rx_buffer, uint32_t length);   /**< Move a data block */
+    int _stop_stream();                     /**< End an open multiple block read/write */
+
+    /* Multiple block read/write (CMD18/CMD25) left open, continued by contiguous requests */
+    cmdSupported _stream_cmd;
+    mbed::bd_addr_t _stream_next_addr;
+
+#if DEVICE_SPI_ASYNCH && MBED_CONF_SD_DMA_ENABLED
+    volatile bool _transfer_done;
+    void _transfer_complete(int event);
+#endif
     int _freq(void);
     void _preclock_then_select();
     void _postclock_then_deselect();
@@ -262,6 +262,8 @@ SDBlockDevice::SDBlockDevice(PinName mosi, PinName miso, PinName sclk, PinName c
 #endif
 {
     _card_type = SDCARD_NONE;
+    _stream_cmd = CMD_NOT_SUPPORTED;
+    _stream_next_addr = 0;
 
     // Set default to 100kHz for initialisation and 1MHz for data transfer
     static_assert(((MBED_CONF_SD_INIT_FREQUENCY >= 100000) && (MBED_CONF_SD_INIT_FREQUENCY <= 400000)),
@@ -283,6 +285,8 @@ SDBlockDevice::SDBlockDevice(const spi_pinmap_t &spi_pinmap, PinName cs, uint64_
 #endif
 {
     _card_type = SDCARD_NONE;
+    _stream_cmd = CMD_NOT_SUPPORTED;
+    _stream_next_addr = 0;
 
     // Set default to 100kHz for initialisation and 1MHz for data transfer
     static_assert(((MBED_CONF_SD_INIT_FREQUENCY >= 100000) && (MBED_CONF_SD_INIT_FREQUENCY <= 400000)),
@@ -460,6 +464,7 @@ int SDBlockDevice::deinit()
         goto end;
     }
 
+    _stop_stream();
     _is_initialized = false;
     _sectors = 0;
 
@@ -469,6 +474,19 @@ end:
 }
 
 
+int SDBlockDevice::sync()
+{
+    lock();
+    if (!_is_initialized) {
+        unlock();
+        return SD_BLOCK_DEVICE_ERROR_NO_INIT;
+    }
+
+    int status = _stop_stream();
+    unlock();
+    return status;
+}
+
 int SDBlockDevice::program(const void *b, bd_addr_t addr, bd_size_t size)
 {
     if (!is_valid_program(addr, size)) {
@@ -488,56 +506,72 @@ int SDBlockDevice::program(const void *b, bd_addr_t addr, bd_size_t size)
     // Get block count
     size_t blockCnt = size / _block_size;
 
-    // SDSC Card (CCS=0) uses byte unit address
-    // SDHC and SDXC Cards (CCS=1) use block unit address (512 Bytes unit)
-    if (SDCARD_V2HC == _card_type) {
-        addr = addr / _block_size;
-    }
-
-    // Send command to perform write operation
-    if (blockCnt == 1) {
-        // Single block write command
-        if (BD_ERROR_OK != (status = _cmd(CMD24_WRITE_BLOCK, addr))) {
+    if ((CMD25_WRITE_MULTIPLE_BLOCK == _stream_cmd) && (addr == _stream_next_addr)) {
+        // Continue the multiple block write left open by the previous program
+        _preclock_then_select();
+    } else {
+        if (BD_ERROR_OK != (status = _stop_stream())) {
             unlock();
             return status;
         }
 
-        // Write data
-        response = _write(buffer, SPI_START_BLOCK, _block_size);
+        // SDSC Card (CCS=0) uses byte unit address
+        // SDHC and SDXC Cards (CCS=1) use block unit address (512 Bytes unit)
+        bd_addr_t card_addr = (SDCARD_V2HC == _card_type) ? addr / _block_size : addr;
 
-        // Only CRC and general write error are communicated via response token
-        if (response != SPI_DATA_ACCEPTED) {
-            debug_if(SD_DBG, "Single Block Write failed: 0x%x \n", response);
-            status = SD_BLOCK_DEVICE_ERROR_WRITE;
+        // Send command to perform write operation
+        if (blockCnt == 1) {
+            // Single block write command
+            if (BD_ERROR_OK != (status = _cmd(CMD24_WRITE_BLOCK, card_addr))) {
+                unlock();
+                return status;
+            }
+
+            // Write data
+            response = _write(buffer, SPI_START_BLOCK, _block_size);
+
+            // Only CRC and general write error are communicated via response token
+            if (response != SPI_DATA_ACCEPTED) {
+                debug_if(SD_DBG, "Single Block Write failed: 0x%x \n", response);
+                status = SD_BLOCK_DEVICE_ERROR_WRITE;
+            }
+
+            _postclock_then_deselect();
+            unlock();
+            return status;
         }
-    } else {
+
         // Pre-erase setting prior to multiple block write operation
         _cmd(ACMD23_SET_WR_BLK_ERASE_COUNT, blockCnt, 1);
 
         // Multiple block write command
-        if (BD_ERROR_OK != (status = _cmd(CMD25_WRITE_MULTIPLE_BLOCK, addr))) {
+        if (BD_ERROR_OK != (status = _cmd(CMD25_WRITE_MULTIPLE_BLOCK, card_addr))) {
             unlock();
             return status;
         }
+        _stream_cmd = CMD25_WRITE_MULTIPLE_BLOCK;
+    }
 
-        // Write the data: one block at a time
-        do {
-            response = _write(buffer, SPI_START_BLK_MUL_WRITE, _block_size);
-            if (response != SPI_DATA_ACCEPTED) {
-                debug_if(SD_DBG, "Multiple Block Write failed: 0x%x \n", response);
-                break;
-            }
-            buffer += _block_size;
-        } while (--blockCnt);     // Receive all blocks of data
+    // Write the data: one block at a time
+    do {
+        response = _write(buffer, SPI_START_BLK_MUL_WRITE, _block_size);
+        if (response != SPI_DATA_ACCEPTED) {
+            debug_if(SD_DBG, "Multiple Block Write failed: 0x%x \n", response);
+            status = SD_BLOCK_DEVICE_ERROR_WRITE;
+            break;
+        }
+        buffer += _block_size;
+    } while (--blockCnt);     // Receive all blocks of data
 
-        /* In a Multiple Block write operation, the stop transmission will be done by
-         * sending 'Stop Tran' token instead of 'Start Block' token at the beginning
-         * of the next block
-         */
-        _spi.write(SPI_STOP_TRAN);
+    _postclock_then_deselect();
+
+    // Leave the stream open, so a contiguous program doesn't need a new command.
+    // It's stopped by the next non contiguous access or sync.
+    _stream_next_addr = addr + size;
+    if (BD_ERROR_OK != status) {
+        _stop_stream();
     }
 
-    _postclock_then_deselect();
     unlock();
     return status;
 }
@@ -558,21 +592,32 @@ int SDBlockDevice::read(void *b, bd_addr_t addr, bd_size_t size)
     int status = BD_ERROR_OK;
     size_t blockCnt =  size / _block_size;
 
-    // SDSC Card (CCS=0) uses byte unit address
-    // SDHC and SDXC Cards (CCS=1) use block unit address (512 Bytes unit)
-    if (SDCARD_V2HC == _card_type) {
-        addr = addr / _block_size;
-    }
-
-    // Write command ro receive data
-    if (blockCnt > 1) {
-        status = _cmd(CMD18_READ_MULTIPLE_BLOCK, addr);
+    if ((CMD18_READ_MULTIPLE_BLOCK == _stream_cmd) && (addr == _stream_next_addr)) {
+        // Continue the multiple block read left open by the previous read
+        _preclock_then_select();
     } else {
-        status = _cmd(CMD17_READ_SINGLE_BLOCK, addr);
-    }
-    if (BD_ERROR_OK != status) {
-        unlock();
-        return status;
+        if (BD_ERROR_OK != (status = _stop_stream())) {
+            unlock();
+            return status;
+        }
+
+        // SDSC Card (CCS=0) uses byte unit address
+        // SDHC and SDXC Cards (CCS=1) use block unit address (512 Bytes unit)
+        bd_addr_t card_addr = (SDCARD_V2HC == _card_type) ? addr / _block_size : addr;
+
+        // Write command ro receive data
+        if (blockCnt > 1) {
+            status = _cmd(CMD18_READ_MULTIPLE_BLOCK, card_addr);
+        } else {
+            status = _cmd(CMD17_READ_SINGLE_BLOCK, card_addr);
+        }
+        if (BD_ERROR_OK != status) {
+            unlock();
+            return status;
+        }
+        if (blockCnt > 1) {
+            _stream_cmd = CMD18_READ_MULTIPLE_BLOCK;
+        }
     }
 
     // receive the data : one block at a time
@@ -586,14 +631,46 @@ int SDBlockDevice::read(void *b, bd_addr_t addr, bd_size_t size)
     }
     _postclock_then_deselect();
 
-    // Send CMD12(0x00000000) to stop the transmission for multi-block transfer
-    if (size > _block_size) {
-        status = _cmd(CMD12_STOP_TRANSMISSION, 0x0);
+    // Leave a multi-block read open for a contiguous read, unless it reached the end of the card
+    _stream_next_addr = addr + size;
+    if ((CMD18_READ_MULTIPLE_BLOCK == _stream_cmd) &&
+            ((BD_ERROR_OK != status) || (_stream_next_addr >= this->size()))) {
+        int stop_status = _stop_stream();
+        if (BD_ERROR_OK == status) {
+            status = stop_status;
+        }
     }
     unlock();
     return status;
 }
 
+int SDBlockDevice::_stop_stream()
+{
+    int status = BD_ERROR_OK;
+
+    if (CMD25_WRITE_MULTIPLE_BLOCK == _stream_cmd) {
+        /* In a Multiple Block write operation, the stop transmission will be done by
+         * sending 'Stop Tran' token instead of 'Start Block' token at the beginning
+         * of the next block
+         */
+        _preclock_then_select();
+        _spi.write(SPI_STOP_TRAN);
+        _spi.write(SPI_FILL_CHAR);
+        // Wait for the card to finish programming
+        if (false == _wait_ready(SD_COMMAND_TIMEOUT)) {
+            debug_if(SD_DBG, "Card not ready yet \n");
+            status = SD_BLOCK_DEVICE_ERROR_WRITE;
+        }
+        _postclock_then_deselect();
+    } else if (CMD18_READ_MULTIPLE_BLOCK == _stream_cmd) {
+        // Send CMD12(0x00000000) to stop the transmission for multi-block transfer
+        status = _cmd(CMD12_STOP_TRANSMISSION, 0x0);
+    }
+
+    _stream_cmd = CMD_NOT_SUPPORTED;
+    return status;
+}
+
 bool SDBlockDevice::_is_valid_trim(bd_addr_t addr, bd_size_t size)
 {
     return (
@@ -613,7 +690,11 @@ int SDBlockDevice::trim(bd_addr_t addr, bd_size_t size)
         unlock();
         return SD_BLOCK_DEVICE_ERROR_NO_INIT;
     }
-    int status = BD_ERROR_OK;
+    int status = _stop_stream();
+    if (BD_ERROR_OK != status) {
+        unlock();
+        return status;
+    }
 
     size -= _block_size;
     // SDSC Card (CCS=0) uses byte unit address
@@ -639,6 +720,11 @@ int SDBlockDevice::trim(bd_addr_t addr, bd_size_t size)
     return status;
 }
 
+uint32_t SDBlockDevice::get_capabilities() const
+{
+    return BD_CAPABILITY_TRIM;
+}
+
 bd_size_t SDBlockDevice::get_read_size() const
 {
     return _block_size;
@@ -667,6 +753,7 @@ void SDBlockDevice::debug(bool dbg)
 int SDBlockDevice::frequency(uint64_t freq)
 {
     lock();
+    _stop_stream();
     _transfer_sck = freq;
     int err = _freq();
     unlock();
@@ -950,7 +1037,7 @@ int SDBlockDevice::_read(uint8_t *buffer, uint32_t length)
     }
 
     // read data
-    _spi.write(NULL, 0, (char *)buffer, length);
+    _spi_block(NULL, buffer, length);
 
     // Read the CRC16 checksum for the data block
     crc = (_spi.write(SPI_FILL_CHAR) << 8);
@@ -983,7 +1070,7 @@ uint8_t SDBlockDevice::_write(const uint8_t *buffer, uint8_t token, uint32_t len
     _spi.write(token);
 
     // write the data
-    _spi.write((char *)buffer, length, NULL, 0);
+    _spi_block(buffer, NULL, length);
 
 #if MBED_CONF_SD_CRC_ENABLED
     if (_crc_on) {
@@ -1118,6 +1205,28 @@ bool SDBlockDevice::_wait_ready(std::chrono::duration<uint32_t, std::milli> time
     return false;
 }
 
+void SDBlockDevice::_spi_block(const uint8_t *tx_buffer, uint8_t *rx_buffer, uint32_t length)
+{
+#if DEVICE_SPI_ASYNCH && MBED_CONF_SD_DMA_ENABLED
+    // Card stays selected across the transfer, as it's done within select()/deselect()
+    _transfer_done = false;
+    if (0 == _spi.transfer(tx_buffer, tx_buffer ? length : 0, rx_buffer, rx_buffer ? length : 0,
+                           mbed::callback(this, &SDBlockDevice::_transfer_complete), SPI_EVENT_COMPLETE)) {
+        while (!_transfer_done);
+        return;
+    }
+    // SPI is busy with another asynchronous transfer, so fall back to a blocking one
+#endif
+    _spi.write((const char *)tx_buffer, tx_buffer ? length : 0, (char *)rx_buffer, rx_buffer ? length : 0);
+}
+
+#if DEVICE_SPI_ASYNCH && MBED_CONF_SD_DMA_ENABLED
+void SDBlockDevice::_transfer_complete(int event)
+{
+    _transfer_done = true;
+}
+#endif
+
 // SPI function to wait for count
 void SDBlockDevice::_spi_wait(uint8_t count)
 {
@@ -1133,6 +1242,9 @@ void SDBlockDevice::_spi_init()
     _spi.frequency(_init_sck);
     _spi.format(8, 0);
     _spi.set_default_write_value(SPI_FILL_CHAR);
+#if DEVICE_SPI_ASYNCH && MBED_CONF_SD_DMA_ENABLED
+    _spi.set_dma_usage(DMA_USAGE_OPPORTUNISTIC);
+#endif
     // Initial 74 cycles required for few cards, before selecting SPI mode
     _spi_wait(10);
     _spi.unlock();
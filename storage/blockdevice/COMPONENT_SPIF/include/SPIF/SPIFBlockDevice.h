@@ -17,11 +17,13 @@
 #ifndef MBED_SPIF_BLOCK_DEVICE_H
 #define MBED_SPIF_BLOCK_DEVICE_H
 
+#include <chrono>
 #include "platform/SingletonPtr.h"
 #include "drivers/SPI.h"
 #include "drivers/DigitalOut.h"
 #include "blockdevice/internal/SFDP.h"
 #include "blockdevice/BlockDevice.h"
+#include "rtos/Semaphore.h"
 
 #ifndef MBED_CONF_SPIF_DRIVER_SPI_MOSI
 #define MBED_CONF_SPIF_DRIVER_SPI_MOSI NC
@@ -38,6 +40,10 @@
 #ifndef MBED_CONF_SPIF_DRIVER_SPI_FREQ
 #define MBED_CONF_SPIF_DRIVER_SPI_FREQ 40000000
 #endif
+/** Move read and program data with asynchronous (DMA capable) SPI transfers, on targets supporting SPI_ASYNCH */
+#ifndef MBED_CONF_SPIF_DRIVER_DMA_ENABLED
+#define MBED_CONF_SPIF_DRIVER_DMA_ENABLED 0
+#endif
 
 /** Enum spif standard error codes
  *
@@ -249,6 +255,9 @@ private:
 
     // Send set_frequency command to Driver
     spif_bd_error _spi_set_frequency(int freq);
+
+    // Clock read or program data, with an asynchronous transfer when enabled
+    void _spi_block(const uint8_t *tx_buffer, uint8_t *rx_buffer, mbed::bd_size_t length);
     /********************************/
 
     // Soft Reset Flash Memory
@@ -257,8 +266,9 @@ private:
     // Configure Write Enable in Status Register
     int _set_write_enable();
 
-    // Wait on status register until write not-in-progress
-    bool _is_mem_ready();
+    // Wait on status register until write not-in-progress, first sleeping for the
+    // typical time of the operation (0 if unknown) then polling at a fraction of it
+    bool _is_mem_ready(std::chrono::microseconds typical_time = std::chrono::microseconds::zero());
 
     // Query vendor ID and handle special behavior that isn't covered by SFDP data
     int _handle_vendor_quirks();
@@ -289,6 +299,12 @@ private:
     unsigned int _dummy_and_mode_cycles; // Number of Dummy and Mode Bits required by Current Bus Mode
     uint32_t _init_ref_count;
     bool _is_initialized;
+
+#if DEVICE_SPI_ASYNCH && MBED_CONF_SPIF_DRIVER_DMA_ENABLED
+    // Released from the interrupt which ends an asynchronous transfer
+    rtos::Semaphore _transfer_sem;
+    void _transfer_complete(int event);
+#endif
 };
 
 #endif  /* MBED_SPIF_BLOCK_DEVICE_H */
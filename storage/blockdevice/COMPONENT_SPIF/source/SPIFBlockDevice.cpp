@@ -18,10 +18,13 @@
 #include "blockdevice/internal/SFDP.h"
 #include "SPIFBlockDevice.h"
 #include "rtos/ThisThread.h"
+#include "drivers/Timer.h"
+#include "platform/mbed_wait_api.h"
 #include "mbed_critical.h"
 
 #include <string.h>
 #include <inttypes.h>
+#include <algorithm>
 
 #include "mbed_trace.h"
 #define TRACE_GROUP "SPIF"
@@ -59,7 +62,11 @@ using namespace mbed;
 #define SPIF_INST_LEGACY_ERASE_DEFAULT  (-1)
 
 
-#define IS_MEM_READY_MAX_RETRIES 10000
+// Give up on a busy device after this long, at least as long as the slowest chip erase
+#define IS_MEM_READY_TIMEOUT 10s
+// Bounds of the status polling interval once the typical time of an operation has elapsed
+#define IS_MEM_READY_MIN_POLL 10us
+#define IS_MEM_READY_MAX_POLL 1ms
 
 enum spif_default_instructions {
     SPIF_NOP = 0x00, // No operation
@@ -98,8 +105,16 @@ SPIFBlockDevice::SPIFBlockDevice(PinName mosi, PinName miso, PinName sclk, PinNa
     _write_dummy_and_mode_cycles = 0;
     _dummy_and_mode_cycles = _read_dummy_and_mode_cycles;
 
+#if DEVICE_SPI_ASYNCH && MBED_CONF_SPIF_DRIVER_DMA_ENABLED
+    _spi.set_dma_usage(DMA_USAGE_OPPORTUNISTIC);
+#endif
+
     _sfdp_info.bptbl.device_size_bytes = 0;
     _sfdp_info.bptbl.legacy_erase_instruction = SPIF_INST_LEGACY_ERASE_DEFAULT;
+    _sfdp_info.bptbl.page_program_time_us = 0;
+    for (int i = 0; i < SFDP_MAX_NUM_OF_ERASE_TYPES; i++) {
+        _sfdp_info.bptbl.erase_type_time_us[i] = 0;
+    }
     _sfdp_info.smptbl.regions_min_common_erase_size = 0;
     _sfdp_info.smptbl.region_cnt = 1;
     _sfdp_info.smptbl.region_erase_types_bitfld[0] = SFDP_ERASE_BITMASK_NONE;
@@ -282,7 +297,8 @@ int SPIFBlockDevice::program(const void *buffer, bd_addr_t addr, bd_size_t size)
         addr += chunk;
         size -= chunk;
 
-        if (false == _is_mem_ready()) {
+        // A partial page programs in about its share of the typical page time
+        if (false == _is_mem_ready(microseconds(_sfdp_info.bptbl.page_program_time_us * chunk / _page_size_bytes))) {
             tr_error("Device not ready after write, failed");
             program_failed = true;
             status = SPIF_BD_ERROR_READY_FAILED;
@@ -371,7 +387,7 @@ int SPIFBlockDevice::erase(bd_addr_t addr, bd_size_t size)
             bitfield = _sfdp_info.smptbl.region_erase_types_bitfld[region];
         }
 
-        if (false == _is_mem_ready()) {
+        if (false == _is_mem_ready(microseconds(_sfdp_info.bptbl.erase_type_time_us[type]))) {
             tr_error("SPI After Erase Device not ready - failed");
             erase_failed = true;
             status = SPIF_BD_ERROR_READY_FAILED;
@@ -487,9 +503,7 @@ spif_bd_error SPIFBlockDevice::_spi_send_read_command(int read_inst, uint8_t *bu
     }
 
     // Read Data
-    for (bd_size_t i = 0; i < size; i++) {
-        buffer[i] = _spi.write(0);
-    }
+    _spi_block(NULL, buffer, size);
 
     _spi.deselect();
 
@@ -534,15 +548,35 @@ spif_bd_error SPIFBlockDevice::_spi_send_program_command(int prog_inst, const vo
     }
 
     // Write Data
-    for (bd_size_t i = 0; i < size; i++) {
-        _spi.write(data[i]);
-    }
+    _spi_block(data, NULL, size);
 
     _spi.deselect();
 
     return SPIF_BD_ERROR_OK;
 }
 
+void SPIFBlockDevice::_spi_block(const uint8_t *tx_buffer, uint8_t *rx_buffer, bd_size_t length)
+{
+#if DEVICE_SPI_ASYNCH && MBED_CONF_SPIF_DRIVER_DMA_ENABLED
+    // Device stays selected across the transfer, as it's done within select()/deselect()
+    if (0 == _spi.transfer(tx_buffer, tx_buffer ? (int)length : 0, rx_buffer, rx_buffer ? (int)length : 0,
+                           mbed::callback(this, &SPIFBlockDevice::_transfer_complete), SPI_EVENT_COMPLETE)) {
+        // The thread sleeps while the DMA moves the data
+        _transfer_sem.acquire();
+        return;
+    }
+    // SPI is busy with another asynchronous transfer, so fall back to a blocking one
+#endif
+    _spi.write((const char *)tx_buffer, tx_buffer ? (int)length : 0, (char *)rx_buffer, rx_buffer ? (int)length : 0);
+}
+
+#if DEVICE_SPI_ASYNCH && MBED_CONF_SPIF_DRIVER_DMA_ENABLED
+void SPIFBlockDevice::_transfer_complete(int event)
+{
+    _transfer_sem.release();
+}
+#endif
+
 spif_bd_error SPIFBlockDevice::_spi_send_erase_command(int erase_inst, bd_addr_t addr, bd_size_t size)
 {
     tr_debug("Erase Inst: 0x%xh, addr: %llu, size: %llu", erase_inst, addr, size);
@@ -623,6 +657,9 @@ int SPIFBlockDevice::_sfdp_parse_basic_param_table(Callback<int(bd_addr_t, void
         return -1;
     }
 
+    // Typical program and erase times, used to wait for completion
+    sfdp_detect_typical_times(param_table, sfdp_info.bptbl);
+
     _erase_instruction = sfdp_info.bptbl.legacy_erase_instruction;
 
     // Detect and Set fastest Bus mode (default 1-1-1)
@@ -688,22 +725,44 @@ int SPIFBlockDevice::_reset_flash_mem()
     return status;
 }
 
-bool SPIFBlockDevice::_is_mem_ready()
+bool SPIFBlockDevice::_is_mem_ready(microseconds typical_time)
 {
     // Check Status Register Busy Bit to Verify the Device isn't Busy
     char status_value[2];
-    int retries = 0;
     bool mem_ready = true;
-
-    do {
+    microseconds interval = IS_MEM_READY_MAX_POLL;
+    Timer timer;
+
+    timer.start();
+    if (typical_time > 0us) {
+        // Sleep through the whole milliseconds of the typical time, and spin for the rest
+        milliseconds typical_ms = duration_cast<milliseconds>(typical_time);
+        if (typical_ms > 0ms) {
+            rtos::ThisThread::sleep_for(typical_ms);
+        }
+        wait_us((typical_time - typical_ms).count());
+        interval = std::min(std::max(typical_time / 8, microseconds(IS_MEM_READY_MIN_POLL)),
+                            microseconds(IS_MEM_READY_MAX_POLL));
+    } else {
+        // Unknown operation time, keep the whole millisecond first wait
         rtos::ThisThread::sleep_for(1ms);
-        retries++;
+    }
+
+    while (true) {
         //Read the Status Register from device
         if (SPIF_BD_ERROR_OK != _spi_send_general_command(SPIF_RDSR, SPI_NO_ADDRESS_COMMAND, NULL, 0, status_value,
                                                           1)) {   // store received values in status_value
             tr_error("Reading Status Register failed");
         }
-    } while ((status_value[0] & SPIF_STATUS_BIT_WIP) != 0 && retries < IS_MEM_READY_MAX_RETRIES);
+        if ((status_value[0] & SPIF_STATUS_BIT_WIP) == 0 || timer.elapsed_time() >= IS_MEM_READY_TIMEOUT) {
+            break;
+        }
+        if (interval < 1ms) {
+            wait_us(interval.count());
+        } else {
+            rtos::ThisThread::sleep_for(duration_cast<milliseconds>(interval));
+        }
+    }
 
     if ((status_value[0] & SPIF_STATUS_BIT_WIP) != 0) {
         tr_error("_is_mem_ready FALSE");
@@ -0,0 +1,259 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/** \addtogroup storage */
+/** @{*/
+
+#ifndef MBED_ASYNC_BLOCK_DEVICE_H
+#define MBED_ASYNC_BLOCK_DEVICE_H
+
+#include "BlockDevice.h"
+
+#if MBED_CONF_RTOS_PRESENT || defined(DOXYGEN_ONLY)
+
+#include "rtos/Thread.h"
+#include "rtos/Mail.h"
+
+/** Number of operations that can be queued before read_async, program_async
+ *  and erase_async start blocking
+ */
+#ifndef MBED_CONF_ASYNC_BLOCK_DEVICE_QUEUE_SIZE
+#define MBED_CONF_ASYNC_BLOCK_DEVICE_QUEUE_SIZE 4
+#endif
+
+/** Stack size of the worker thread, which also runs the completion callbacks */
+#ifndef MBED_CONF_ASYNC_BLOCK_DEVICE_THREAD_STACK_SIZE
+#define MBED_CONF_ASYNC_BLOCK_DEVICE_THREAD_STACK_SIZE 1536
+#endif
+
+namespace mbed {
+
+/** Block device adapter running operations on a worker thread
+ *
+ *  Gives any block device a non-blocking read_async, program_async and erase_async.
+ *  Operations are executed in the order they were issued, and completion callbacks
+ *  are called from the worker thread. Blocking calls are queued behind pending
+ *  operations, so they observe all earlier asynchronous writes.
+ *
+ *  Completion callbacks may issue further operations. A blocking call made from a
+ *  callback runs immediately, and an asynchronous one fails with
+ *  BD_ERROR_DEVICE_ERROR if the queue is full.
+ */
+class AsyncBlockDevice : public BlockDevice {
+public:
+    /** Lifetime of the block device
+     *
+     *  @param bd           Block device to run operations on
+     *  @param priority     Priority of the worker thread
+     *  @param stack_size   Stack size of the worker thread
+     */
+    AsyncBlockDevice(BlockDevice *bd, osPriority priority = osPriorityNormal,
+                     uint32_t stack_size = MBED_CONF_ASYNC_BLOCK_DEVICE_THREAD_STACK_SIZE);
+    virtual ~AsyncBlockDevice();
+
+    /** Initialize a block device and start the worker thread
+     *
+     *  @return         0 on success or a negative error code on failure
+     */
+    virtual int init();
+
+    /** Wait for pending operations, stop the worker thread and deinitialize the block device
+     *
+     *  @return         0 on success or a negative error code on failure
+     */
+    virtual int deinit();
+
+    /** Wait for pending operations and ensure data on storage is in sync with the driver
+     *
+     *  @return         0 on success or a negative error code on failure
+     */
+    virtual int sync();
+
+    /** Read blocks from a block device
+     *
+     *  @param buffer   Buffer to read blocks into
+     *  @param addr     Address of block to begin reading from
+     *  @param size     Size to read in bytes, must be a multiple of read block size
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual int read(void *buffer, bd_addr_t addr, bd_size_t size);
+
+    /** Program blocks to a block device
+     *
+     *  The blocks must have been erased prior to being programmed
+     *
+     *  @param buffer   Buffer of data to write to blocks
+     *  @param addr     Address of block to begin writing to
+     *  @param size     Size to write in bytes, must be a multiple of program block size
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual int program(const void *buffer, bd_addr_t addr, bd_size_t size);
+
+    /** Erase blocks on a block device
+     *
+     *  The state of an erased block is undefined until it has been programmed,
+     *  unless get_erase_value returns a non-negative byte value
+     *
+     *  @param addr     Address of block to begin erasing
+     *  @param size     Size to erase in bytes, must be a multiple of erase block size
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual int erase(bd_addr_t addr, bd_size_t size);
+
+    /** Mark blocks as no longer in use
+     *
+     *  @param addr     Address of block to mark as unused
+     *  @param size     Size to mark as unused in bytes, must be a multiple of the erase block size
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual int trim(bd_addr_t addr, bd_size_t size);
+
+    /** Queue a read on the worker thread
+     *
+     *  @param buffer   Buffer to read blocks into, must stay valid until the callback is called
+     *  @param addr     Address of block to begin reading from
+     *  @param size     Size to read in bytes, must be a multiple of read block size
+     *  @param callback Function called from the worker thread with the result of the read
+     *  @return         0 if the read was queued, negative error code on failure
+     */
+    virtual int read_async(void *buffer, bd_addr_t addr, bd_size_t size, mbed::Callback<void(int)> callback);
+
+    /** Queue a program on the worker thread
+     *
+     *  @param buffer   Buffer of data to write to blocks, must stay valid until the callback is called
+     *  @param addr     Address of block to begin writing to
+     *  @param size     Size to write in bytes, must be a multiple of program block size
+     *  @param callback Function called from the worker thread with the result of the program
+     *  @return         0 if the program was queued, negative error code on failure
+     */
+    virtual int program_async(const void *buffer, bd_addr_t addr, bd_size_t size, mbed::Callback<void(int)> callback);
+
+    /** Queue an erase on the worker thread
+     *
+     *  @param addr     Address of block to begin erasing
+     *  @param size     Size to erase in bytes, must be a multiple of erase block size
+     *  @param callback Function called from the worker thread with the result of the erase
+     *  @return         0 if the erase was queued, negative error code on failure
+     */
+    virtual int erase_async(bd_addr_t addr, bd_size_t size, mbed::Callback<void(int)> callback);
+
+    /** Get the size of a readable block
+     *
+     *  @return         Size of a readable block in bytes
+     */
+    virtual bd_size_t get_read_size() const;
+
+    /** Get the size of a programmable block
+     *
+     *  @return         Size of a programmable block in bytes
+     */
+    virtual bd_size_t get_program_size() const;
+
+    /** Get the size of an erasable block
+     *
+     *  @return         Size of an erasable block in bytes
+     */
+    virtual bd_size_t get_erase_size() const;
+
+    /** Get the size of an erasable block given address
+     *
+     *  @param addr     Address within the erasable block
+     *  @return         Size of an erasable block in bytes
+     *  @note Must be a multiple of the program size
+     */
+    virtual bd_size_t get_erase_size(bd_addr_t addr) const;
+
+    /** Get the value of storage when erased
+     *
+     *  If get_erase_value returns a non-negative byte value, the underlying
+     *  storage is set to that value when erased, and storage containing
+     *  that value can be programmed without another erase.
+     *
+     *  @return         The value of storage when erased, or -1 if you can't
+     *                  rely on the value of erased storage
+     */
+    virtual int get_erase_value() const;
+
+    /** Get the optional capabilities of the block device
+     *
+     *  @return         BD_CAPABILITY_ASYNC, plus BD_CAPABILITY_TRIM if the underlying block device has it
+     */
+    virtual uint32_t get_capabilities() const;
+
+    /** Get the total size of the underlying device
+     *
+     *  @return         Size of the underlying device in bytes
+     */
+    virtual bd_size_t size() const;
+
+    /** Get the BlockDevice class type.
+     *
+     *  @return         A string represent the BlockDevice class type.
+     */
+    virtual const char *get_type() const;
+
+private:
+    enum op_type_t {
+        OP_READ,
+        OP_PROGRAM,
+        OP_ERASE,
+        OP_TRIM,
+        OP_SYNC,
+        OP_EXIT,
+    };
+
+    struct op_t {
+        op_type_t type;
+        void *buffer;
+        bd_addr_t addr;
+        bd_size_t size;
+        mbed::Callback<void(int)> callback;
+    };
+
+    // Queue an operation, blocking while the queue is full unless called from the worker thread
+    int queue_op(op_type_t type, void *buffer, bd_addr_t addr, bd_size_t size, mbed::Callback<void(int)> callback);
+
+    // Queue an operation and wait for its result
+    int run_op(op_type_t type, void *buffer, bd_addr_t addr, bd_size_t size);
+
+    // Execute an operation on the underlying block device
+    int execute_op(op_type_t type, void *buffer, bd_addr_t addr, bd_size_t size);
+
+    bool on_worker_thread() const;
+    void worker();
+
+    BlockDevice *_bd;
+    rtos::Thread *_thread;
+    rtos::Mail<op_t, MBED_CONF_ASYNC_BLOCK_DEVICE_QUEUE_SIZE> _ops;
+    osPriority _priority;
+    uint32_t _stack_size;
+    uint32_t _init_ref_count;
+    bool _is_initialized;
+};
+
+} // namespace mbed
+
+// Added "using" for backwards compatibility
+#ifndef MBED_NO_GLOBAL_USING_DIRECTIVE
+using mbed::AsyncBlockDevice;
+#endif
+
+#endif // MBED_CONF_RTOS_PRESENT || defined(DOXYGEN_ONLY)
+
+#endif
+
+/** @}*/
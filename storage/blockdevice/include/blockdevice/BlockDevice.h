@@ -22,6 +22,7 @@
 #define MBED_BLOCK_DEVICE_H
 
 #include <stdint.h>
+#include "platform/Callback.h"
 
 namespace mbed {
 
@@ -34,6 +35,17 @@ enum bd_error {
     BD_ERROR_DEVICE_ERROR       = -4001, /*!< device specific error */
 };
 
+/** Optional capabilities of a block device, as returned by get_capabilities
+ *
+ *  @enum bd_capability
+ */
+enum bd_capability {
+    BD_CAPABILITY_ASYNC         = (1 << 0), /*!< read_async, program_async and erase_async return before completion */
+    BD_CAPABILITY_MAPPED        = (1 << 1), /*!< get_mapped_address can return memory mapped contents */
+    BD_CAPABILITY_TRIM          = (1 << 2), /*!< trim hints reach the storage */
+    BD_CAPABILITY_ERASE_STATE   = (1 << 3), /*!< is_erased can report blocks known to be erased */
+};
+
 /** Type representing the address of a specific block
  */
 typedef uint64_t bd_addr_t;
@@ -139,6 +151,73 @@ public:
         return 0;
     }
 
+    /** Read blocks from a block device without waiting for completion
+     *
+     *  The callback is called with the result of the read once it has completed,
+     *  possibly from another thread or before this function returns. The buffer
+     *  must stay valid until then. The default implementation performs a blocking
+     *  read and calls the callback before returning.
+     *
+     *  @param buffer   Buffer to write blocks to
+     *  @param addr     Address of block to begin reading from
+     *  @param size     Size to read in bytes, must be a multiple of the read block size
+     *  @param callback Function called with 0 on success or a negative error code on failure
+     *  @return         0 if the read was started, or a negative error code on failure,
+     *                  in which case the callback is not called
+     */
+    virtual int read_async(void *buffer, bd_addr_t addr, bd_size_t size, mbed::Callback<void(int)> callback)
+    {
+        int err = read(buffer, addr, size);
+        if (callback) {
+            callback(err);
+        }
+        return BD_ERROR_OK;
+    }
+
+    /** Program blocks to a block device without waiting for completion
+     *
+     *  The callback is called with the result of the program once it has completed,
+     *  possibly from another thread or before this function returns. The buffer
+     *  must stay valid until then. The default implementation performs a blocking
+     *  program and calls the callback before returning.
+     *
+     *  @param buffer   Buffer of data to write to blocks
+     *  @param addr     Address of block to begin writing to
+     *  @param size     Size to write in bytes, must be a multiple of the program block size
+     *  @param callback Function called with 0 on success or a negative error code on failure
+     *  @return         0 if the program was started, or a negative error code on failure,
+     *                  in which case the callback is not called
+     */
+    virtual int program_async(const void *buffer, bd_addr_t addr, bd_size_t size, mbed::Callback<void(int)> callback)
+    {
+        int err = program(buffer, addr, size);
+        if (callback) {
+            callback(err);
+        }
+        return BD_ERROR_OK;
+    }
+
+    /** Erase blocks on a block device without waiting for completion
+     *
+     *  The callback is called with the result of the erase once it has completed,
+     *  possibly from another thread or before this function returns. The default
+     *  implementation performs a blocking erase and calls the callback before returning.
+     *
+     *  @param addr     Address of block to begin erasing
+     *  @param size     Size to erase in bytes, must be a multiple of the erase block size
+     *  @param callback Function called with 0 on success or a negative error code on failure
+     *  @return         0 if the erase was started, or a negative error code on failure,
+     *                  in which case the callback is not called
+     */
+    virtual int erase_async(bd_addr_t addr, bd_size_t size, mbed::Callback<void(int)> callback)
+    {
+        int err = erase(addr, size);
+        if (callback) {
+            callback(err);
+        }
+        return BD_ERROR_OK;
+    }
+
     /** Get the size of a readable block
      *
      *  @return         Size of a readable block in bytes
@@ -235,6 +314,49 @@ public:
                    addr + size <= this->size());
     }
 
+    /** Get a pointer to memory-mapped (XIP) contents of the block device
+     *
+     *  Devices whose storage can be read directly through the memory map
+     *  (such as internal flash) may return a pointer instead of copying
+     *  the data in read. The pointer stays valid until the region is
+     *  programmed or erased.
+     *
+     *  @param addr     Address of block to begin reading from
+     *  @param size     Size of the region in bytes
+     *  @return         Pointer to the region, or NULL if the region is not memory mapped
+     */
+    virtual const void *get_mapped_address(bd_addr_t addr, bd_size_t size) const
+    {
+        return nullptr;
+    }
+
+    /** Check whether a region is known to be erased
+     *
+     *  Lets callers skip erasing blocks the device knows are still erased.
+     *
+     *  @param addr     Address of block to begin checking
+     *  @param size     Size of the region in bytes, must be a multiple of the erase block size
+     *  @return         True if the whole region is known to be erased, false if it may
+     *                  hold data or the device doesn't track it
+     */
+    virtual bool is_erased(bd_addr_t addr, bd_size_t size) const
+    {
+        return false;
+    }
+
+    /** Get the optional capabilities of the block device
+     *
+     *  Block devices built over other block devices report the capabilities
+     *  they pass through, so a fast path on the raw device can be found
+     *  behind partitions and slices.
+     *
+     *  @return         Bitmask of bd_capability flags
+     */
+    virtual uint32_t get_capabilities() const
+    {
+        return 0;
+    }
+
     /** Get the BlockDevice class type.
      *
      *  @return         A string represent the BlockDevice class type.
@@ -251,6 +373,10 @@ using mbed::bd_addr_t;
 using mbed::bd_size_t;
 using mbed::BD_ERROR_OK;
 using mbed::BD_ERROR_DEVICE_ERROR;
+using mbed::BD_CAPABILITY_ASYNC;
+using mbed::BD_CAPABILITY_MAPPED;
+using mbed::BD_CAPABILITY_TRIM;
+using mbed::BD_CAPABILITY_ERASE_STATE;
 #endif
 
 #endif
@@ -23,6 +23,28 @@
 
 #include "BlockDevice.h"
 
+/** Default number of program units held in the write cache of a BufferedBlockDevice
+ *
+ *  With more than one entry, partially programmed units stay in the cache (least
+ *  recently used one is evicted first) until they are completed, evicted or synced.
+ */
+#ifndef MBED_CONF_BUFFERED_BLOCK_DEVICE_CACHE_ENTRIES
+#define MBED_CONF_BUFFERED_BLOCK_DEVICE_CACHE_ENTRIES 1
+#endif
+
+/** Default for letting a BufferedBlockDevice write cached units back out of program order
+ *
+ *  When disabled, the underlying block device is programmed in the order the data was
+ *  programmed: going back to a cached unit after programming another one writes back
+ *  the whole cache first. TDBStore and LittleFileSystem rely on this order to survive
+ *  power loss. When enabled, interleaved programs to several units stay in the cache,
+ *  and a unit may reach the device before data programmed earlier to another one. Only
+ *  enable it for users which sync before relying on what they programmed.
+ */
+#ifndef MBED_CONF_BUFFERED_BLOCK_DEVICE_WRITE_REORDER
+#define MBED_CONF_BUFFERED_BLOCK_DEVICE_WRITE_REORDER 0
+#endif
+
 namespace mbed {
 
 /** Block device for allowing minimal read and program sizes (of 1) for the underlying BD,
@@ -32,9 +54,13 @@ class BufferedBlockDevice : public BlockDevice {
 public:
     /** Lifetime of a memory-buffered block device wrapping an underlying block device
      *
-     *  @param bd        Block device to back the BufferedBlockDevice
+     *  @param bd            Block device to back the BufferedBlockDevice
+     *  @param cache_entries Number of program units held in the write cache
+     *  @param write_reorder Let cached units be written back out of program order,
+     *                       see MBED_CONF_BUFFERED_BLOCK_DEVICE_WRITE_REORDER
      */
-    BufferedBlockDevice(BlockDevice *bd);
+    BufferedBlockDevice(BlockDevice *bd, uint32_t cache_entries = MBED_CONF_BUFFERED_BLOCK_DEVICE_CACHE_ENTRIES,
+                        bool write_reorder = MBED_CONF_BUFFERED_BLOCK_DEVICE_WRITE_REORDER);
 
     /** Lifetime of the memory-buffered block device
      */
@@ -142,6 +168,22 @@ public:
      */
     virtual int get_erase_value() const;
 
+    /** Get a pointer to memory-mapped contents of the underlying block device
+     *
+     *  Regions overlapping data still held in the write cache are not mapped.
+     *
+     *  @param addr     Address of block to begin reading from
+     *  @param size     Size of the region in bytes
+     *  @return         Pointer to the region, or NULL if the region is not memory mapped
+     */
+    virtual const void *get_mapped_address(bd_addr_t addr, bd_size_t size) const;
+
+    /** Get the optional capabilities of the underlying block device
+     *
+     *  @return         Bitmask of the bd_capability flags passed through
+     */
+    virtual uint32_t get_capabilities() const;
+
     /** Get the total size of the underlying device
      *
      *  @return         Size of the underlying device in bytes
@@ -154,15 +196,47 @@ public:
      */
     virtual const char *get_type() const;
 
+    /** Reset the cache hit and miss counts to zero
+     */
+    void reset_cache_counts();
+
+    /** Get the number of reads and partial programs served by the cache
+     *
+     *  @return         The number of cache hits
+     */
+    bd_size_t get_cache_hit_count() const;
+
+    /** Get the number of reads and partial programs that missed the cache
+     *
+     *  Reads while no cached unit overlaps them don't consult the cache, and
+     *  are counted neither as hits nor as misses.
+     *
+     *  @return         The number of cache misses
+     */
+    bd_size_t get_cache_miss_count() const;
+
 protected:
+#if !(DOXYGEN_ONLY)
+    struct cache_entry_t {
+        bd_addr_t addr;
+        uint32_t last_used;
+        bool dirty;
+        uint8_t *buf;
+    };
+#endif //#if !(DOXYGEN_ONLY)
+
     BlockDevice *_bd;
     bd_size_t _bd_program_size;
     bd_size_t _bd_read_size;
     bd_size_t _bd_size;
-    bd_size_t _write_cache_addr;
-    bool _write_cache_valid;
+    uint32_t _cache_entries;
+    bool _write_reorder;
+    cache_entry_t *_cache;
     uint8_t *_write_cache;
     uint8_t *_read_buf;
+    uint32_t _cache_tick;
+    bd_size_t _cache_hit_count;
+    bd_size_t _cache_miss_count;
     uint32_t _init_ref_count;
     bool _is_initialized;
 
@@ -173,11 +247,41 @@ protected:
      */
     int flush();
 
+    /** Write back a single cache entry and invalidate it
+     *
+     *  @param entry    Cache entry
+     *  @return         0 on success or a negative error code on failure
+     */
+    int flush_entry(cache_entry_t *entry);
+
     /** Invalidate write cache
      *
      *  @return         none
      */
     void invalidate_write_cache();
+
+    /** Find the cache entry holding a program unit
+     *
+     *  @param addr     Address of the program unit
+     *  @return         Cache entry, or NULL if the unit is not cached
+     */
+    cache_entry_t *find_entry(bd_addr_t addr) const;
+
+    /** Get a cache entry for a program unit, evicting the least recently used one if needed
+     *
+     *  @param addr     Address of the program unit
+     *  @param entry    Returned cache entry
+     *  @return         0 on success or a negative error code on failure
+     */
+    int get_entry(bd_addr_t addr, cache_entry_t *&entry);
+
+    /** Invalidate cache entries in a given range
+     *
+     *  @param addr     Start address of the range
+     *  @param size     Range size in bytes
+     *  @return         none
+     */
+    void invalidate_range(bd_addr_t addr, bd_size_t size);
 #endif //#if !(DOXYGEN_ONLY)
 };
 } // namespace mbed
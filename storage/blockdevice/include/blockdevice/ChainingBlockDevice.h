@@ -45,26 +45,49 @@ namespace mbed {
  *  BlockDevice *bds[] = {&mem1, &mem2};
  *  ChainingBlockDevice chainmem(bds);
  *  @endcode
+ *
+ *  Two independent chips can also be striped, so that consecutive erase
+ *  units alternate between them, and driven at the same time when the
+ *  sub-devices implement the asynchronous API (for example by wrapping
+ *  each of them in an AsyncBlockDevice):
+ *
+ *  @code
+ *  AsyncBlockDevice async1(&flash1);
+ *  AsyncBlockDevice async2(&flash2);
+ *  BlockDevice *bds[] = {&async1, &async2};
+ *  ChainingBlockDevice stripedmem(bds, ChainingBlockDevice::CHAIN_STRIPED | ChainingBlockDevice::CHAIN_PARALLEL);
+ *  @endcode
  */
 class ChainingBlockDevice : public BlockDevice {
 public:
+    /** Flags controlling how the block devices are combined
+     */
+    enum chain_mode {
+        CHAIN_SEQUENTIAL = 0,      /*!< block devices follow each other in the address space */
+        CHAIN_STRIPED    = 1 << 0, /*!< erase units are interleaved across equally sized block devices */
+        CHAIN_PARALLEL   = 1 << 1, /*!< operations spanning several block devices are issued to all of them before waiting */
+    };
+
     /** Lifetime of the memory block device
      *
      *  @param bds         Array of block devices to chain with sequential block addresses
      *  @param bd_count    Number of block devices to chain
+     *  @param mode        Combination of chain_mode flags
      *  @note All block devices must have the same block size
      */
-    ChainingBlockDevice(BlockDevice **bds, size_t bd_count);
+    ChainingBlockDevice(BlockDevice **bds, size_t bd_count, int mode = CHAIN_SEQUENTIAL);
 
     /** Lifetime of the memory block device
      *
      *  @param bds          Array of block devices to chain with sequential block addresses
+     *  @param mode         Combination of chain_mode flags
      *  @note All block devices must have the same block size
      */
     template <size_t Size>
-    ChainingBlockDevice(BlockDevice * (&bds)[Size])
-        : _bds(bds), _bd_count(sizeof(bds) / sizeof(bds[0]))
-        , _read_size(0), _program_size(0), _erase_size(0), _size(0),  _init_ref_count(0)
+    ChainingBlockDevice(BlockDevice * (&bds)[Size], int mode = CHAIN_SEQUENTIAL)
+        : _bds(bds), _bd_count(sizeof(bds) / sizeof(bds[0])), _mode(mode)
+        , _read_size(0), _program_size(0), _erase_size(0), _size(0)
+        , _erase_value(-1), _init_ref_count(0), _is_initialized(false)
     {
     }
 
@@ -174,8 +197,28 @@ public:
     virtual const char *get_type() const;
 
 protected:
+    enum op_type {
+        OP_READ,
+        OP_PROGRAM,
+        OP_ERASE,
+    };
+
+    // Find the block device holding addr, the address within it and how
+    // much of size lies in the same contiguous piece of that block device
+    void find_segment(bd_addr_t addr, bd_size_t size, size_t *index, bd_addr_t *bd_addr, bd_size_t *bd_size) const;
+
+    struct pending_segments;
+
+    // Split an operation into segments and run them on the block devices,
+    // waiting for all of them in parallel mode
+    int dispatch(op_type type, uint8_t *buffer, bd_addr_t addr, bd_size_t size);
+
+    // Run or start, if pending is given, every segment of an operation
+    int run_segments(op_type type, uint8_t *buffer, bd_addr_t addr, bd_size_t size, pending_segments *pending);
+
     BlockDevice **_bds;
     size_t _bd_count;
+    int _mode;
     bd_size_t _read_size;
     bd_size_t _program_size;
     bd_size_t _erase_size;
@@ -26,10 +26,49 @@
 namespace mbed {
 
 
+/** Number of regions the address space is split into for access heatmaps
+ */
+#ifndef MBED_CONF_PROFILING_BLOCK_DEVICE_REGIONS
+#define MBED_CONF_PROFILING_BLOCK_DEVICE_REGIONS    32
+#endif
+
 /** Block device for measuring storage operations of another block device
+ *
+ *  Besides the byte counts, each operation is recorded in histograms of its
+ *  latency and size, in powers of two, and in a heatmap of how many
+ *  operations touched each region of the device.
  */
 class ProfilingBlockDevice : public BlockDevice {
 public:
+    /** Operations profiled separately
+     */
+    enum profile_op {
+        PROFILE_READ = 0,
+        PROFILE_PROGRAM,
+        PROFILE_ERASE,
+        PROFILE_OPS,
+    };
+
+    /** Number of buckets in the latency and size histograms
+     *
+     *  Bucket n counts the operations that took 2^n to 2^(n+1)-1 us, or
+     *  were 2^n to 2^(n+1)-1 bytes long. The last bucket counts longer ones.
+     */
+    static const int PROFILE_BUCKETS = 24;
+
+    /** Statistics of one operation
+     */
+    struct op_stats {
+        uint32_t count;                             /**< Successful operations */
+        uint32_t error_count;                       /**< Operations that returned an error */
+        uint32_t latency_min_us;                    /**< Shortest operation */
+        uint32_t latency_max_us;                    /**< Longest operation */
+        uint64_t latency_total_us;                  /**< Time spent in successful operations */
+        uint32_t latency_cnt[PROFILE_BUCKETS];      /**< Operations by latency */
+        uint32_t size_cnt[PROFILE_BUCKETS];         /**< Operations by size */
+        uint32_t region_cnt[MBED_CONF_PROFILING_BLOCK_DEVICE_REGIONS]; /**< Operations touching each region */
+    };
+
     /** Lifetime of the memory block device
      *
      *  @param bd       Block device to back the ProfilingBlockDevice
@@ -136,7 +175,7 @@ public:
      */
     virtual bd_size_t size() const;
 
-    /** Reset the current profile counts to zero
+    /** Reset the current profile counts and statistics to zero
      */
     void reset();
 
@@ -158,6 +197,55 @@ public:
      */
     bd_size_t get_erase_count() const;
 
+    /** Get the statistics of an operation
+     *
+     *  @param op       Operation to get the statistics of
+     *  @param stats    Copy of the statistics
+     */
+    void get_op_stats(profile_op op, op_stats *stats) const;
+
+    /** Get the average latency of an operation
+     *
+     *  @param op       Operation to get the latency of
+     *  @return         Average latency of successful operations in us
+     */
+    uint32_t get_latency_avg(profile_op op) const;
+
+    /** Get a percentile of the latency of an operation
+     *
+     *  The latency is only known to the resolution of the histogram, so
+     *  this is the upper bound of the bucket holding the percentile, capped
+     *  by the longest operation seen.
+     *
+     *  @param op       Operation to get the latency of
+     *  @param percent  Percentile, from 0 to 100, for example 99
+     *  @return         Latency in us below which that many percent of the
+     *                  successful operations completed
+     */
+    uint32_t get_latency_percentile(profile_op op, uint32_t percent) const;
+
+    /** Get the size of a region of the heatmaps
+     *
+     *  The regions are a whole number of erase blocks, so hot regions of the
+     *  erase heatmap are hot erase blocks.
+     *
+     *  @return         Size of a region in bytes, 0 before init
+     */
+    bd_size_t get_region_size() const;
+
+    /** Write a compact binary snapshot of the statistics, for a host tool
+     *
+     *  The snapshot is little endian 32-bit words: the magic "BDP1", the
+     *  number of operations, of histogram buckets and of regions, the
+     *  region size in bytes, then for each operation, the fields of
+     *  op_stats in order, with latency_total_us as two words, low first.
+     *
+     *  @param buf      Buffer for the snapshot, or NULL to get its size
+     *  @param size     Size of the buffer in bytes
+     *  @return         Size of the snapshot in bytes, or 0 if it did not fit
+     */
+    size_t snapshot(uint8_t *buf, size_t size) const;
+
     /** Get the BlockDevice class type.
      *
      *  @return         A string represent the BlockDevice class type.
@@ -169,6 +257,10 @@ private:
     bd_size_t _read_count;
     bd_size_t _program_count;
     bd_size_t _erase_count;
+    bd_size_t _region_size;
+    op_stats _stats[PROFILE_OPS];
+
+    void record(profile_op op, int err, uint32_t start, bd_addr_t addr, bd_size_t size);
 };
 
 } // namespace mbed
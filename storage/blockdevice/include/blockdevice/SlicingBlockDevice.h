@@ -95,6 +95,43 @@ public:
      */
     virtual int erase(bd_addr_t addr, bd_size_t size);
 
+    /** Mark blocks as no longer in use
+     *
+     *  @param addr     Address of block to mark as unused
+     *  @param size     Size to mark as unused in bytes, must be a multiple of the erase block size
+     *  @return         0 on success or a negative error code on failure
+     */
+    virtual int trim(bd_addr_t addr, bd_size_t size);
+
+    /** Read blocks from the slice without waiting for completion
+     *
+     *  @param buffer   Buffer to read blocks into, must stay valid until the callback is called
+     *  @param addr     Address of block to begin reading from
+     *  @param size     Size to read in bytes, must be a multiple of read block size
+     *  @param callback Function called with the result of the read
+     *  @return         0 if the read was started or a negative error code on failure
+     */
+    virtual int read_async(void *buffer, bd_addr_t addr, bd_size_t size, mbed::Callback<void(int)> callback);
+
+    /** Program blocks to the slice without waiting for completion
+     *
+     *  @param buffer   Buffer of data to write to blocks, must stay valid until the callback is called
+     *  @param addr     Address of block to begin writing to
+     *  @param size     Size to write in bytes, must be a multiple of program block size
+     *  @param callback Function called with the result of the program
+     *  @return         0 if the program was started or a negative error code on failure
+     */
+    virtual int program_async(const void *buffer, bd_addr_t addr, bd_size_t size, mbed::Callback<void(int)> callback);
+
+    /** Erase blocks on the slice without waiting for completion
+     *
+     *  @param addr     Address of block to begin erasing
+     *  @param size     Size to erase in bytes, must be a multiple of erase block size
+     *  @param callback Function called with the result of the erase
+     *  @return         0 if the erase was started or a negative error code on failure
+     */
+    virtual int erase_async(bd_addr_t addr, bd_size_t size, mbed::Callback<void(int)> callback);
+
     /** Get the size of a readable block
      *
      *  @return         Size of a readable block in bytes
@@ -134,6 +171,28 @@ public:
      */
     virtual int get_erase_value() const;
 
+    /** Get a pointer to memory-mapped contents of the underlying block device
+     *
+     *  @param addr     Address of block to begin reading from
+     *  @param size     Size of the region in bytes
+     *  @return         Pointer to the region, or NULL if the region is not memory mapped
+     */
+    virtual const void *get_mapped_address(bd_addr_t addr, bd_size_t size) const;
+
+    /** Check whether a region of the slice is known to be erased
+     *
+     *  @param addr     Address of block to begin checking
+     *  @param size     Size of the region in bytes
+     *  @return         True if the underlying block device knows the region is erased
+     */
+    virtual bool is_erased(bd_addr_t addr, bd_size_t size) const;
+
+    /** Get the optional capabilities of the underlying block device
+     *
+     *  @return         Bitmask of bd_capability flags
+     */
+    virtual uint32_t get_capabilities() const;
+
     /** Get the total size of the underlying device
      *
      *  @return         Size of the underlying device in bytes
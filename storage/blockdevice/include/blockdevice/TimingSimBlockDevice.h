@@ -0,0 +1,234 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/** \addtogroup storage */
+/** @{*/
+
+#ifndef MBED_TIMING_SIM_BLOCK_DEVICE_H
+#define MBED_TIMING_SIM_BLOCK_DEVICE_H
+
+#include "BlockDevice.h"
+
+namespace mbed {
+
+/** Block device simulating the timing of a storage technology over another block device
+ *
+ *  Each operation is charged a time from a timing profile and added to a
+ *  simulated clock, so file systems and key value stores running over a
+ *  HeapBlockDevice can be timed on the host before the hardware exists.
+ *  Optionally the time is also spent for real.
+ *
+ *  @code
+ *  HeapBlockDevice heap(64 * 1024, 1, 256, 4096);
+ *  TimingSimBlockDevice bd(&heap, TimingSimBlockDevice::NOR_FLASH);
+ *  ...
+ *  printf("%llu us spent erasing\n", bd.get_erase_time());
+ *  @endcode
+ */
+class TimingSimBlockDevice : public BlockDevice {
+public:
+    /** Timing of a storage technology
+     *
+     *  Bandwidths of 0 leave the transfer time out.
+     */
+    struct timing_profile_t {
+        uint32_t read_latency_us;       /**< Time to first byte of every read */
+        uint32_t read_bandwidth;        /**< Read throughput, in bytes per second */
+        uint32_t program_page_size;     /**< Size programmed at once, in bytes */
+        uint32_t program_page_us;       /**< Time to program a page */
+        uint32_t program_bandwidth;     /**< Throughput of the data sent for programming, in bytes per second */
+        uint32_t erase_block_size;      /**< Size erased at once, in bytes */
+        uint32_t erase_block_us;        /**< Time to erase a block */
+        uint32_t sync_us;               /**< Time to flush the device's own cache */
+    };
+
+    /** Typical SPI NOR flash, quad reads at 50MHz, 256 byte pages and 4kB sectors */
+    static const timing_profile_t NOR_FLASH;
+
+    /** Typical SLC NAND flash, 2kB pages and 128kB blocks */
+    static const timing_profile_t NAND_FLASH;
+
+    /** Typical SD card in SPI mode at 25MHz, with 512 byte blocks */
+    static const timing_profile_t SD_CARD;
+
+    /** Typical internal MCU flash, 8 byte double words and 2kB pages */
+    static const timing_profile_t INTERNAL_FLASH;
+
+    /** Lifetime of the timing simulation block device
+     *
+     *  @param bd       Block device to back the TimingSimBlockDevice
+     *  @param profile  Timing charged for the operations
+     *  @param delay    Also wait for the simulated time of each operation
+     */
+    TimingSimBlockDevice(BlockDevice *bd, const timing_profile_t &profile, bool delay = false);
+
+    /** Lifetime of a block device
+     */
+    virtual ~TimingSimBlockDevice() {};
+
+    /** Initialize a block device
+     *
+     *  @return         0 on success or a negative error code on failure
+     *  @note The init and deinit functions are not timed
+     */
+    virtual int init();
+
+    /** Deinitialize a block device
+     *
+     *  @return         0 on success or a negative error code on failure
+     *  @note The init and deinit functions are not timed
+     */
+    virtual int deinit();
+
+    /** Ensure data on storage is in sync with the driver
+     *
+     *  @return         0 on success or a negative error code on failure
+     */
+    virtual int sync();
+
+    /** Read blocks from a block device
+     *
+     *  @param buffer   Buffer to read blocks into
+     *  @param addr     Address of block to begin reading from
+     *  @param size     Size to read in bytes, must be a multiple of read block size
+     *  @return         0 on success or a negative error code on failure
+     */
+    virtual int read(void *buffer, bd_addr_t addr, bd_size_t size);
+
+    /** Program blocks to a block device
+     *
+     *  The blocks must have been erased prior to being programmed
+     *
+     *  @param buffer   Buffer of data to write to blocks
+     *  @param addr     Address of block to begin writing to
+     *  @param size     Size to write in bytes, must be a multiple of program block size
+     *  @return         0 on success or a negative error code on failure
+     */
+    virtual int program(const void *buffer, bd_addr_t addr, bd_size_t size);
+
+    /** Erase blocks on a block device
+     *
+     *  The state of an erased block is undefined until it has been programmed,
+     *  unless get_erase_value returns a non-negative byte value
+     *
+     *  @param addr     Address of block to begin erasing
+     *  @param size     Size to erase in bytes, must be a multiple of erase block size
+     *  @return         0 on success or a negative error code on failure
+     */
+    virtual int erase(bd_addr_t addr, bd_size_t size);
+
+    /** Get the size of a readable block
+     *
+     *  @return         Size of a readable block in bytes
+     */
+    virtual bd_size_t get_read_size() const;
+
+    /** Get the size of a programmable block
+     *
+     *  @return         Size of a programmable block in bytes
+     *  @note Must be a multiple of the read size
+     */
+    virtual bd_size_t get_program_size() const;
+
+    /** Get the size of an erasable block
+     *
+     *  @return         Size of an erasable block in bytes
+     *  @note Must be a multiple of the program size
+     */
+    virtual bd_size_t get_erase_size() const;
+
+    /** Get the size of an erasable block given address
+     *
+     *  @param addr     Address within the erasable block
+     *  @return         Size of an erasable block in bytes
+     *  @note Must be a multiple of the program size
+     */
+    virtual bd_size_t get_erase_size(bd_addr_t addr) const;
+
+    /** Get the value of storage when erased
+     *
+     *  If get_erase_value returns a non-negative byte value, the underlying
+     *  storage is set to that value when erased, and you can program storage
+     *  containing that value without another erase.
+     *
+     *  @return         The value of storage when erased, or -1 if you can't
+     *                  rely on the value of erased storage
+     */
+    virtual int get_erase_value() const;
+
+    /** Get the total size of the underlying device
+     *
+     *  @return         Size of the underlying device in bytes
+     */
+    virtual bd_size_t size() const;
+
+    /** Reset the simulated times to zero
+     */
+    void reset();
+
+    /** Get the simulated time spent reading
+     *
+     *  @return         Time in microseconds
+     */
+    uint64_t get_read_time() const;
+
+    /** Get the simulated time spent programming
+     *
+     *  @return         Time in microseconds
+     */
+    uint64_t get_program_time() const;
+
+    /** Get the simulated time spent erasing
+     *
+     *  @return         Time in microseconds
+     */
+    uint64_t get_erase_time() const;
+
+    /** Get the total simulated time, including syncs
+     *
+     *  @return         Time in microseconds
+     */
+    uint64_t get_elapsed_time() const;
+
+    /** Get the BlockDevice class type.
+     *
+     *  @return         A string represent the BlockDevice class type.
+     */
+    virtual const char *get_type() const;
+
+private:
+    void charge(uint64_t &counter, uint64_t time_us);
+
+    BlockDevice *_bd;
+    timing_profile_t _profile;
+    bool _delay;
+    uint64_t _read_time;
+    uint64_t _program_time;
+    uint64_t _erase_time;
+    uint64_t _sync_time;
+};
+
+} // namespace mbed
+
+// Added "using" for backwards compatibility
+#ifndef MBED_NO_GLOBAL_USING_DIRECTIVE
+using mbed::TimingSimBlockDevice;
+#endif
+
+#endif
+
+/** @}*/
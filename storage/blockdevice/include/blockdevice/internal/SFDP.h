@@ -53,6 +53,8 @@ struct sfdp_bptbl_info {
     size_t size; ///< Size
     bd_size_t device_size_bytes;
     int legacy_erase_instruction; ///< Legacy 4K erase instruction
+    uint32_t page_program_time_us; ///< Typical page program time in microseconds, 0 if unknown
+    uint32_t erase_type_time_us[SFDP_MAX_NUM_OF_ERASE_TYPES]; ///< Typical time of each erase type in microseconds, 0 if unknown
 };
 
 /** JEDEC Sector Map Table info */
@@ -167,6 +169,18 @@ int sfdp_detect_device_density(uint8_t *bptbl_ptr, sfdp_bptbl_info &bptbl_info);
  */
 int sfdp_detect_addressability(uint8_t *bptbl_ptr, sfdp_bptbl_info &bptbl_info);
 
+/** Detect typical page program and erase times
+ *
+ * Times are left at 0 if the Basic Parameter Table is too short to hold them
+ * (JESD216 before revision A).
+ *
+ * @param         bptbl_ptr  Pointer to memory holding a Basic Parameter Table structure
+ * @param[in,out] bptbl_info Basic Parameter Table information structure, size must be set
+ *
+ * @return 0 on success, negative error code on failure
+ */
+int sfdp_detect_typical_times(uint8_t *bptbl_ptr, sfdp_bptbl_info &bptbl_info);
+
 /** @}*/
 } /* namespace mbed */
 #endif
@@ -0,0 +1,293 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "blockdevice/AsyncBlockDevice.h"
+
+#if MBED_CONF_RTOS_PRESENT
+
+#include "platform/mbed_atomic.h"
+#include "rtos/Semaphore.h"
+#include "rtos/ThisThread.h"
+
+namespace mbed {
+
+namespace {
+// Result of an operation a blocking call waits for
+struct completion_t {
+    rtos::Semaphore done;
+    int err;
+
+    completion_t() : done(0), err(BD_ERROR_OK) {}
+
+    void complete(int result)
+    {
+        err = result;
+        done.release();
+    }
+};
+}
+
+AsyncBlockDevice::AsyncBlockDevice(BlockDevice *bd, osPriority priority, uint32_t stack_size)
+    : _bd(bd), _thread(0), _priority(priority), _stack_size(stack_size), _init_ref_count(0), _is_initialized(false)
+{
+}
+
+AsyncBlockDevice::~AsyncBlockDevice()
+{
+    deinit();
+}
+
+int AsyncBlockDevice::init()
+{
+    uint32_t val = core_util_atomic_incr_u32(&_init_ref_count, 1);
+
+    if (val != 1) {
+        return BD_ERROR_OK;
+    }
+
+    int err = _bd->init();
+    if (err) {
+        goto fail;
+    }
+
+    _thread = new rtos::Thread(_priority, _stack_size, NULL, "async_bd");
+    if (_thread->start(mbed::callback(this, &AsyncBlockDevice::worker)) != osOK) {
+        delete _thread;
+        _thread = 0;
+        _bd->deinit();
+        err = BD_ERROR_DEVICE_ERROR;
+        goto fail;
+    }
+
+    _is_initialized = true;
+    return BD_ERROR_OK;
+
+fail:
+    _is_initialized = false;
+    _init_ref_count = 0;
+    return err;
+}
+
+int AsyncBlockDevice::deinit()
+{
+    if (!_is_initialized) {
+        return BD_ERROR_OK;
+    }
+
+    uint32_t val = core_util_atomic_decr_u32(&_init_ref_count, 1);
+
+    if (val) {
+        return BD_ERROR_OK;
+    }
+
+    // The worker finishes everything queued before it sees the exit request
+    queue_op(OP_EXIT, NULL, 0, 0, NULL);
+    _thread->join();
+    delete _thread;
+    _thread = 0;
+
+    _is_initialized = false;
+    return _bd->deinit();
+}
+
+int AsyncBlockDevice::sync()
+{
+    return run_op(OP_SYNC, NULL, 0, 0);
+}
+
+int AsyncBlockDevice::read(void *buffer, bd_addr_t addr, bd_size_t size)
+{
+    return run_op(OP_READ, buffer, addr, size);
+}
+
+int AsyncBlockDevice::program(const void *buffer, bd_addr_t addr, bd_size_t size)
+{
+    return run_op(OP_PROGRAM, const_cast<void *>(buffer), addr, size);
+}
+
+int AsyncBlockDevice::erase(bd_addr_t addr, bd_size_t size)
+{
+    return run_op(OP_ERASE, NULL, addr, size);
+}
+
+int AsyncBlockDevice::trim(bd_addr_t addr, bd_size_t size)
+{
+    return run_op(OP_TRIM, NULL, addr, size);
+}
+
+int AsyncBlockDevice::read_async(void *buffer, bd_addr_t addr, bd_size_t size, mbed::Callback<void(int)> callback)
+{
+    return queue_op(OP_READ, buffer, addr, size, callback);
+}
+
+int AsyncBlockDevice::program_async(const void *buffer, bd_addr_t addr, bd_size_t size, mbed::Callback<void(int)> callback)
+{
+    return queue_op(OP_PROGRAM, const_cast<void *>(buffer), addr, size, callback);
+}
+
+int AsyncBlockDevice::erase_async(bd_addr_t addr, bd_size_t size, mbed::Callback<void(int)> callback)
+{
+    return queue_op(OP_ERASE, NULL, addr, size, callback);
+}
+
+bd_size_t AsyncBlockDevice::get_read_size() const
+{
+    return _bd->get_read_size();
+}
+
+bd_size_t AsyncBlockDevice::get_program_size() const
+{
+    return _bd->get_program_size();
+}
+
+bd_size_t AsyncBlockDevice::get_erase_size() const
+{
+    return _bd->get_erase_size();
+}
+
+bd_size_t AsyncBlockDevice::get_erase_size(bd_addr_t addr) const
+{
+    return _bd->get_erase_size(addr);
+}
+
+int AsyncBlockDevice::get_erase_value() const
+{
+    return _bd->get_erase_value();
+}
+
+uint32_t AsyncBlockDevice::get_capabilities() const
+{
+    // Programs are queued, so mapped contents and erase states could be stale
+    return BD_CAPABILITY_ASYNC | (_bd->get_capabilities() & BD_CAPABILITY_TRIM);
+}
+
+bd_size_t AsyncBlockDevice::size() const
+{
+    return _bd->size();
+}
+
+const char *AsyncBlockDevice::get_type() const
+{
+    if (_bd != NULL) {
+        return _bd->get_type();
+    }
+
+    return NULL;
+}
+
+int AsyncBlockDevice::queue_op(op_type_t type, void *buffer, bd_addr_t addr, bd_size_t size,
+                               mbed::Callback<void(int)> callback)
+{
+    if (!_is_initialized) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    // The worker can't wait for itself to make room in the queue
+    op_t *op;
+    if (on_worker_thread()) {
+        op = _ops.try_alloc();
+    } else {
+        op = _ops.try_alloc_for(rtos::Kernel::wait_for_u32_forever);
+    }
+
+    if (!op) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    op->type = type;
+    op->buffer = buffer;
+    op->addr = addr;
+    op->size = size;
+    op->callback = callback;
+    _ops.put(op);
+
+    return BD_ERROR_OK;
+}
+
+int AsyncBlockDevice::run_op(op_type_t type, void *buffer, bd_addr_t addr, bd_size_t size)
+{
+    if (!_is_initialized) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    // Earlier operations queued by a callback haven't run yet, but waiting
+    // for them here would deadlock the worker
+    if (on_worker_thread()) {
+        return execute_op(type, buffer, addr, size);
+    }
+
+    completion_t completion;
+    int err = queue_op(type, buffer, addr, size, mbed::callback(&completion, &completion_t::complete));
+    if (err) {
+        return err;
+    }
+
+    completion.done.acquire();
+    return completion.err;
+}
+
+int AsyncBlockDevice::execute_op(op_type_t type, void *buffer, bd_addr_t addr, bd_size_t size)
+{
+    switch (type) {
+        case OP_READ:
+            return _bd->read(buffer, addr, size);
+        case OP_PROGRAM:
+            return _bd->program(buffer, addr, size);
+        case OP_ERASE:
+            return _bd->erase(addr, size);
+        case OP_TRIM:
+            return _bd->trim(addr, size);
+        case OP_SYNC:
+            return _bd->sync();
+        default:
+            return BD_ERROR_DEVICE_ERROR;
+    }
+}
+
+bool AsyncBlockDevice::on_worker_thread() const
+{
+    return _thread && (rtos::ThisThread::get_id() == _thread->get_id());
+}
+
+void AsyncBlockDevice::worker()
+{
+    while (true) {
+        op_t *op = _ops.try_get_for(rtos::Kernel::wait_for_u32_forever);
+        if (!op) {
+            continue;
+        }
+
+        if (op->type == OP_EXIT) {
+            _ops.free(op);
+            return;
+        }
+
+        int err = execute_op(op->type, op->buffer, op->addr, op->size);
+
+        // Release the slot first so the callback can queue the next operation
+        mbed::Callback<void(int)> callback = op->callback;
+        _ops.free(op);
+
+        if (callback) {
+            callback(err);
+        }
+    }
+}
+
+} // namespace mbed
+
+#endif // MBED_CONF_RTOS_PRESENT
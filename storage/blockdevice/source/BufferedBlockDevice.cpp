@@ -28,11 +28,14 @@ static inline uint32_t align_down(bd_size_t val, bd_size_t size)
     return val / size * size;
 }
 
-BufferedBlockDevice::BufferedBlockDevice(BlockDevice *bd)
-    : _bd(bd), _bd_program_size(0), _bd_read_size(0), _bd_size(0), _write_cache_addr(0), _write_cache_valid(false),
-      _write_cache(0), _read_buf(0), _init_ref_count(0), _is_initialized(false)
+BufferedBlockDevice::BufferedBlockDevice(BlockDevice *bd, uint32_t cache_entries, bool write_reorder)
+    : _bd(bd), _bd_program_size(0), _bd_read_size(0), _bd_size(0), _cache_entries(cache_entries),
+      _write_reorder(write_reorder), _cache(0),
+      _write_cache(0), _read_buf(0), _cache_tick(0), _cache_hit_count(0), _cache_miss_count(0),
+      _init_ref_count(0), _is_initialized(false)
 {
     MBED_ASSERT(_bd);
+    MBED_ASSERT(_cache_entries);
 }
 
 BufferedBlockDevice::~BufferedBlockDevice()
@@ -58,7 +61,11 @@ int BufferedBlockDevice::init()
     _bd_size = _bd->size();
 
     if (!_write_cache) {
-        _write_cache = new uint8_t[_bd_program_size];
+        _write_cache = new uint8_t[_bd_program_size * _cache_entries];
+        _cache = new cache_entry_t[_cache_entries];
+        for (uint32_t i = 0; i < _cache_entries; i++) {
+            _cache[i].buf = _write_cache + i * _bd_program_size;
+        }
     }
 
     if (!_read_buf) {
@@ -91,12 +98,27 @@ int BufferedBlockDevice::deinit()
 
     delete[] _write_cache;
     _write_cache = 0;
+    delete[] _cache;
+    _cache = 0;
     delete[] _read_buf;
     _read_buf = 0;
     _is_initialized = false;
     return _bd->deinit();
 }
 
+int BufferedBlockDevice::flush_entry(cache_entry_t *entry)
+{
+    if (entry->dirty) {
+        int ret = _bd->program(entry->buf, entry->addr, _bd_program_size);
+        if (ret) {
+            return ret;
+        }
+        entry->addr = _bd_size;
+        entry->dirty = false;
+    }
+    return 0;
+}
+
 int BufferedBlockDevice::flush()
 {
     MBED_ASSERT(_write_cache);
@@ -104,20 +126,99 @@ int BufferedBlockDevice::flush()
         return BD_ERROR_DEVICE_ERROR;
     }
 
-    if (_write_cache_valid) {
-        int ret = _bd->program(_write_cache, _write_cache_addr, _bd_program_size);
+    // Write back in the order units were last touched. Unless reordering is allowed,
+    // only the last touched unit takes new data, so this is the program order.
+    while (true) {
+        cache_entry_t *oldest = 0;
+        for (uint32_t i = 0; i < _cache_entries; i++) {
+            if (_cache[i].dirty && (!oldest || (_cache[i].last_used < oldest->last_used))) {
+                oldest = &_cache[i];
+            }
+        }
+        if (!oldest) {
+            break;
+        }
+        int ret = flush_entry(oldest);
         if (ret) {
             return ret;
         }
-        invalidate_write_cache();
     }
     return 0;
 }
 
 void BufferedBlockDevice::invalidate_write_cache()
 {
-    _write_cache_addr = _bd_size;
-    _write_cache_valid = false;
+    for (uint32_t i = 0; i < _cache_entries; i++) {
+        _cache[i].addr = _bd_size;
+        _cache[i].dirty = false;
+        _cache[i].last_used = 0;
+    }
+}
+
+BufferedBlockDevice::cache_entry_t *BufferedBlockDevice::find_entry(bd_addr_t addr) const
+{
+    for (uint32_t i = 0; i < _cache_entries; i++) {
+        if (_cache[i].dirty && (_cache[i].addr == addr)) {
+            return &_cache[i];
+        }
+    }
+    return 0;
+}
+
+int BufferedBlockDevice::get_entry(bd_addr_t addr, cache_entry_t *&entry)
+{
+    entry = find_entry(addr);
+    if (entry && !_write_reorder && (entry->last_used != _cache_tick)) {
+        // Other units were programmed since, write them all back first, so that the
+        // new data doesn't reach the underlying BD before theirs
+        int ret = flush();
+        if (ret) {
+            return ret;
+        }
+        entry = 0;
+    }
+    if (entry) {
+        _cache_hit_count++;
+        entry->last_used = ++_cache_tick;
+        return 0;
+    }
+
+    _cache_miss_count++;
+
+    // Prefer a free entry, otherwise evict the least recently used one
+    for (uint32_t i = 0; i < _cache_entries; i++) {
+        if (!_cache[i].dirty) {
+            entry = &_cache[i];
+            break;
+        }
+        if (!entry || (_cache[i].last_used < entry->last_used)) {
+            entry = &_cache[i];
+        }
+    }
+
+    int ret = flush_entry(entry);
+    if (ret) {
+        return ret;
+    }
+
+    // Program doesn't cover an entire unit, so the rest of it must be read from the underlying BD
+    ret = _bd->read(entry->buf, addr, _bd_program_size);
+    if (ret) {
+        return ret;
+    }
+    entry->addr = addr;
+    entry->last_used = ++_cache_tick;
+    return 0;
+}
+
+void BufferedBlockDevice::invalidate_range(bd_addr_t addr, bd_size_t size)
+{
+    for (uint32_t i = 0; i < _cache_entries; i++) {
+        if (_cache[i].dirty && (_cache[i].addr + _bd_program_size > addr) && (_cache[i].addr < addr + size)) {
+            _cache[i].addr = _bd_size;
+            _cache[i].dirty = false;
+        }
+    }
 }
 
 int BufferedBlockDevice::sync()
@@ -146,27 +247,42 @@ int BufferedBlockDevice::read(void *b, bd_addr_t addr, bd_size_t size)
         return BD_ERROR_DEVICE_ERROR;
     }
 
+    // Find the first cached unit overlapping the read
+    bd_addr_t next_cached_addr = _bd_size;
+    for (uint32_t i = 0; i < _cache_entries; i++) {
+        if (_cache[i].dirty && (_cache[i].addr + _bd_program_size > addr) && (_cache[i].addr < addr + size)) {
+            next_cached_addr = std::min(next_cached_addr, _cache[i].addr);
+        }
+    }
+
     // Common case - no need to involve write cache or read buffer
-    if (_bd->is_valid_read(addr, size) &&
-            ((addr + size <= _write_cache_addr) || (addr > _write_cache_addr + _bd_program_size))) {
+    if (_bd->is_valid_read(addr, size) && (next_cached_addr == _bd_size)) {
         return _bd->read(b, addr, size);
     }
 
     uint8_t *buf = static_cast<uint8_t *>(b);
 
-    // Read logic: Split read to chunks, according to whether we cross the write cache
+    // Read logic: Split read to chunks, according to whether we cross cached units
     while (size) {
         bd_size_t chunk;
         bool read_from_bd = true;
-        if (_write_cache_valid && addr < _write_cache_addr) {
-            chunk = std::min(size, _write_cache_addr - addr);
-        } else if (_write_cache_valid && (addr >= _write_cache_addr) && (addr < _write_cache_addr + _bd_program_size)) {
+        cache_entry_t *entry = find_entry(align_down(addr, _bd_program_size));
+        if (entry) {
             // One case we need to take our data from cache
             chunk = std::min(size, _bd_program_size - addr % _bd_program_size);
-            memcpy(buf, _write_cache + addr % _bd_program_size, chunk);
+            memcpy(buf, entry->buf + addr % _bd_program_size, chunk);
             read_from_bd = false;
+            _cache_hit_count++;
         } else {
-            chunk = size;
+            // Read from the BD up to the next cached unit
+            next_cached_addr = _bd_size;
+            for (uint32_t i = 0; i < _cache_entries; i++) {
+                if (_cache[i].dirty && (_cache[i].addr > addr)) {
+                    next_cached_addr = std::min(next_cached_addr, _cache[i].addr);
+                }
+            }
+            chunk = std::min(size, next_cached_addr - addr);
+            _cache_miss_count++;
         }
 
         // Now, in case we read from the BD, make sure we are aligned with its read size.
@@ -205,23 +321,13 @@ int BufferedBlockDevice::program(const void *b, bd_addr_t addr, bd_size_t size)
 
     int ret;
 
-    bd_addr_t aligned_addr = align_down(addr, _bd_program_size);
-
     const uint8_t *buf = static_cast <const uint8_t *>(b);
 
-    // Need to flush if moved to another program unit
-    if (aligned_addr != _write_cache_addr) {
-        ret = flush();
-        if (ret) {
-            return ret;
-        }
-    }
-
     // Write logic: Keep data in cache as long as we don't reach the end of the program unit.
     // Otherwise, program to the underlying BD.
     while (size) {
-        _write_cache_addr = align_down(addr, _bd_program_size);
-        bd_addr_t offs_in_buf = addr - _write_cache_addr;
+        bd_addr_t unit_addr = align_down(addr, _bd_program_size);
+        bd_addr_t offs_in_buf = addr - unit_addr;
         bd_size_t chunk;
         if (offs_in_buf) {
             chunk = std::min(_bd_program_size - offs_in_buf, size);
@@ -232,34 +338,47 @@ int BufferedBlockDevice::program(const void *b, bd_addr_t addr, bd_size_t size)
         }
 
         const uint8_t *prog_buf;
+        cache_entry_t *entry = 0;
         if (chunk < _bd_program_size) {
-            // If cache not valid, and program doesn't cover an entire unit, it means we need to
-            // read it from the underlying BD
-            if (!_write_cache_valid) {
-                ret = _bd->read(_write_cache, _write_cache_addr, _bd_program_size);
-                if (ret) {
-                    return ret;
-                }
+            ret = get_entry(unit_addr, entry);
+            if (ret) {
+                return ret;
             }
-            memcpy(_write_cache + offs_in_buf, buf, chunk);
-            prog_buf = _write_cache;
+            memcpy(entry->buf + offs_in_buf, buf, chunk);
+            prog_buf = entry->buf;
         } else {
+            // Whole units supersede anything cached for them. Write back the rest first,
+            // so the underlying BD is programmed in the same order as this one.
+            invalidate_range(unit_addr, chunk);
+            ret = flush();
+            if (ret) {
+                return ret;
+            }
             prog_buf = buf;
         }
 
         // Only program if we reached the end of a program unit
         if (!((offs_in_buf + chunk) % _bd_program_size)) {
-            ret = _bd->program(prog_buf, _write_cache_addr, std::max(chunk, _bd_program_size));
+            if (entry && !_write_reorder) {
+                // After the units programmed before this one
+                entry->dirty = true;
+                ret = flush();
+            } else {
+                ret = _bd->program(prog_buf, unit_addr, std::max(chunk, _bd_program_size));
+            }
             if (ret) {
                 return ret;
             }
-            invalidate_write_cache();
+            if (entry) {
+                entry->addr = _bd_size;
+                entry->dirty = false;
+            }
             ret = _bd->sync();
             if (ret) {
                 return ret;
             }
         } else {
-            _write_cache_valid = true;
+            entry->dirty = true;
         }
 
         buf += chunk;
@@ -280,9 +399,7 @@ int BufferedBlockDevice::erase(bd_addr_t addr, bd_size_t size)
         return BD_ERROR_DEVICE_ERROR;
     }
 
-    if ((_write_cache_addr >= addr) && (_write_cache_addr <= addr + size)) {
-        invalidate_write_cache();
-    }
+    invalidate_range(addr, size);
     return _bd->erase(addr, size);
 }
 
@@ -296,9 +413,7 @@ int BufferedBlockDevice::trim(bd_addr_t addr, bd_size_t size)
         return BD_ERROR_DEVICE_ERROR;
     }
 
-    if ((_write_cache_addr >= addr) && (_write_cache_addr <= addr + size)) {
-        invalidate_write_cache();
-    }
+    invalidate_range(addr, size);
     return _bd->trim(addr, size);
 }
 
@@ -339,6 +454,32 @@ int BufferedBlockDevice::get_erase_value() const
     return _bd->get_erase_value();
 }
 
+const void *BufferedBlockDevice::get_mapped_address(bd_addr_t addr, bd_size_t size) const
+{
+    if (!_is_initialized) {
+        return NULL;
+    }
+
+    // Data still in the write cache hasn't reached the underlying device
+    for (uint32_t i = 0; i < _cache_entries; i++) {
+        if (_cache[i].dirty && (_cache[i].addr + _bd_program_size > addr) && (_cache[i].addr < addr + size)) {
+            return NULL;
+        }
+    }
+
+    return _bd->get_mapped_address(addr, size);
+}
+
+uint32_t BufferedBlockDevice::get_capabilities() const
+{
+    if (!_is_initialized) {
+        return 0;
+    }
+
+    // Operations are not asynchronous and erase state is hidden by the write cache
+    return _bd->get_capabilities() & (BD_CAPABILITY_MAPPED | BD_CAPABILITY_TRIM);
+}
+
 bd_size_t BufferedBlockDevice::size() const
 {
     if (!_is_initialized) {
@@ -353,4 +494,20 @@ const char *BufferedBlockDevice::get_type() const
     return _bd->get_type();
 }
 
+void BufferedBlockDevice::reset_cache_counts()
+{
+    _cache_hit_count = 0;
+    _cache_miss_count = 0;
+}
+
+bd_size_t BufferedBlockDevice::get_cache_hit_count() const
+{
+    return _cache_hit_count;
+}
+
+bd_size_t BufferedBlockDevice::get_cache_miss_count() const
+{
+    return _cache_miss_count;
+}
+
 } // namespace mbed
@@ -18,11 +18,31 @@
 #include "blockdevice/ChainingBlockDevice.h"
 #include "platform/mbed_atomic.h"
 #include "platform/mbed_assert.h"
+#include "rtos/Semaphore.h"
 
 namespace mbed {
 
-ChainingBlockDevice::ChainingBlockDevice(BlockDevice **bds, size_t bd_count)
-    : _bds(bds), _bd_count(bd_count)
+// Tracks the asynchronous segments of a parallel operation
+struct ChainingBlockDevice::pending_segments {
+    rtos::Semaphore done;
+    uint32_t issued;
+    int32_t err;
+
+    pending_segments() : done(0), issued(0), err(BD_ERROR_OK) {}
+
+    void complete(int result)
+    {
+        if (result) {
+            // Keep the first error
+            int32_t expected = BD_ERROR_OK;
+            core_util_atomic_cas_s32(&err, &expected, result);
+        }
+        done.release();
+    }
+};
+
+ChainingBlockDevice::ChainingBlockDevice(BlockDevice **bds, size_t bd_count, int mode)
+    : _bds(bds), _bd_count(bd_count), _mode(mode)
     , _read_size(0), _program_size(0), _erase_size(0), _size(0)
     , _erase_value(-1), _init_ref_count(0), _is_initialized(false)
 {
@@ -47,6 +67,7 @@ int ChainingBlockDevice::init()
     _erase_size = 0;
     _erase_value = -1;
     _size = 0;
+    bd_size_t min_size = 0;
 
     // Initialize children block devices, find all sizes and
     // assert that block sizes are similar. We can't do this in
@@ -86,7 +107,16 @@ int ChainingBlockDevice::init()
             _erase_value = -1;
         }
 
-        _size += _bds[i]->size();
+        bd_size_t bdsize = _bds[i]->size();
+        if (i == 0 || bdsize < min_size) {
+            min_size = bdsize;
+        }
+        _size += bdsize;
+    }
+
+    if (_mode & CHAIN_STRIPED) {
+        // Only whole stripes present on every block device are usable
+        _size = _bd_count * (min_size - (min_size % _erase_size));
     }
 
     _is_initialized = true;
@@ -147,105 +177,134 @@ int ChainingBlockDevice::read(void *b, bd_addr_t addr, bd_size_t size)
         return BD_ERROR_DEVICE_ERROR;
     }
 
-    uint8_t *buffer = static_cast<uint8_t *>(b);
-
-    // Find block devices containing blocks, may span multiple block devices
-    for (size_t i = 0; i < _bd_count && size > 0; i++) {
-        bd_size_t bdsize = _bds[i]->size();
-
-        if (addr < bdsize) {
-            bd_size_t read = size;
-            if (addr + read > bdsize) {
-                read = bdsize - addr;
-            }
-
-            int err = _bds[i]->read(buffer, addr, read);
-            if (err) {
-                return err;
-            }
+    return dispatch(OP_READ, static_cast<uint8_t *>(b), addr, size);
+}
 
-            buffer += read;
-            addr += read;
-            size -= read;
-        }
+int ChainingBlockDevice::program(const void *b, bd_addr_t addr, bd_size_t size)
+{
+    if (!_is_initialized) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
 
-        addr -= bdsize;
+    if (!is_valid_program(addr, size)) {
+        return BD_ERROR_DEVICE_ERROR;
     }
 
-    return 0;
+    return dispatch(OP_PROGRAM, static_cast<uint8_t *>(const_cast<void *>(b)), addr, size);
 }
 
-int ChainingBlockDevice::program(const void *b, bd_addr_t addr, bd_size_t size)
+int ChainingBlockDevice::erase(bd_addr_t addr, bd_size_t size)
 {
     if (!_is_initialized) {
         return BD_ERROR_DEVICE_ERROR;
     }
 
-    if (!is_valid_program(addr, size)) {
+    if (!is_valid_erase(addr, size)) {
         return BD_ERROR_DEVICE_ERROR;
     }
 
-    const uint8_t *buffer = static_cast<const uint8_t *>(b);
+    return dispatch(OP_ERASE, NULL, addr, size);
+}
+
+void ChainingBlockDevice::find_segment(bd_addr_t addr, bd_size_t size,
+                                       size_t *index, bd_addr_t *bd_addr, bd_size_t *bd_size) const
+{
+    if (_mode & CHAIN_STRIPED) {
+        // Stripes of one erase unit are dealt out to the block devices in turn
+        bd_addr_t stripe = addr / _erase_size;
+        bd_addr_t offset = addr % _erase_size;
+
+        *index = stripe % _bd_count;
+        *bd_addr = (stripe / _bd_count) * _erase_size + offset;
+        *bd_size = (size < _erase_size - offset) ? size : _erase_size - offset;
+        return;
+    }
 
     // Find block devices containing blocks, may span multiple block devices
-    for (size_t i = 0; i < _bd_count && size > 0; i++) {
+    for (size_t i = 0; i < _bd_count; i++) {
         bd_size_t bdsize = _bds[i]->size();
 
         if (addr < bdsize) {
-            bd_size_t program = size;
-            if (addr + program > bdsize) {
-                program = bdsize - addr;
-            }
-
-            int err = _bds[i]->program(buffer, addr, program);
-            if (err) {
-                return err;
-            }
-
-            buffer += program;
-            addr += program;
-            size -= program;
+            *index = i;
+            *bd_addr = addr;
+            *bd_size = (addr + size > bdsize) ? bdsize - addr : size;
+            return;
         }
 
         addr -= bdsize;
     }
 
-    return 0;
+    // Getting here implies an illegal address
+    MBED_ASSERT(0);
 }
 
-int ChainingBlockDevice::erase(bd_addr_t addr, bd_size_t size)
+int ChainingBlockDevice::dispatch(op_type type, uint8_t *buffer, bd_addr_t addr, bd_size_t size)
 {
-    if (!_is_initialized) {
-        return BD_ERROR_DEVICE_ERROR;
+    if (!(_mode & CHAIN_PARALLEL)) {
+        return run_segments(type, buffer, addr, size, NULL);
     }
 
-    if (!is_valid_erase(addr, size)) {
-        return BD_ERROR_DEVICE_ERROR;
+    pending_segments pending;
+    int err = run_segments(type, buffer, addr, size, &pending);
+
+    // Segments already started still use the buffer, so wait for all of them
+    for (uint32_t n = 0; n < pending.issued; n++) {
+        pending.done.acquire();
     }
 
-    // Find block devices containing blocks, may span multiple block devices
-    for (size_t i = 0; i < _bd_count && size > 0; i++) {
-        bd_size_t bdsize = _bds[i]->size();
+    if (!err) {
+        err = pending.err;
+    }
 
-        if (addr < bdsize) {
-            bd_size_t erase = size;
-            if (addr + erase > bdsize) {
-                erase = bdsize - addr;
+    return err;
+}
+
+int ChainingBlockDevice::run_segments(op_type type, uint8_t *buffer, bd_addr_t addr, bd_size_t size,
+                                      pending_segments *pending)
+{
+    while (size > 0) {
+        size_t i;
+        bd_addr_t bd_addr;
+        bd_size_t bd_size;
+        find_segment(addr, size, &i, &bd_addr, &bd_size);
+
+        int err;
+        if (pending) {
+            // Start the segment and move on to the next block device without waiting
+            mbed::Callback<void(int)> done = mbed::callback(pending, &pending_segments::complete);
+            if (type == OP_READ) {
+                err = _bds[i]->read_async(buffer, bd_addr, bd_size, done);
+            } else if (type == OP_PROGRAM) {
+                err = _bds[i]->program_async(buffer, bd_addr, bd_size, done);
+            } else {
+                err = _bds[i]->erase_async(bd_addr, bd_size, done);
             }
 
-            int err = _bds[i]->erase(addr, erase);
-            if (err) {
-                return err;
+            if (!err) {
+                pending->issued++;
+            }
+        } else {
+            if (type == OP_READ) {
+                err = _bds[i]->read(buffer, bd_addr, bd_size);
+            } else if (type == OP_PROGRAM) {
+                err = _bds[i]->program(buffer, bd_addr, bd_size);
+            } else {
+                err = _bds[i]->erase(bd_addr, bd_size);
             }
+        }
 
-            addr += erase;
-            size -= erase;
+        if (err) {
+            return err;
         }
 
-        addr -= bdsize;
+        if (buffer) {
+            buffer += bd_size;
+        }
+        addr += bd_size;
+        size -= bd_size;
     }
 
-    return 0;
+    return BD_ERROR_OK;
 }
 
 bd_size_t ChainingBlockDevice::get_read_size() const
@@ -269,6 +328,10 @@ bd_size_t ChainingBlockDevice::get_erase_size(bd_addr_t addr) const
         return 0;
     }
 
+    if (_mode & CHAIN_STRIPED) {
+        return _erase_size;
+    }
+
     bd_addr_t bd_start_addr = 0;
     for (size_t i = 0; i < _bd_count; i++) {
         bd_size_t bdsize = _bds[i]->size();
@@ -374,6 +374,58 @@ int MBRBlockDevice::erase(bd_addr_t addr, bd_size_t size)
     return _bd->erase(addr + _offset, size);
 }
 
+int MBRBlockDevice::trim(bd_addr_t addr, bd_size_t size)
+{
+    if (!_is_initialized) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    if (!is_valid_erase(addr, size)) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    return _bd->trim(addr + _offset, size);
+}
+
+int MBRBlockDevice::read_async(void *b, bd_addr_t addr, bd_size_t size, mbed::Callback<void(int)> callback)
+{
+    if (!_is_initialized) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    if (!is_valid_read(addr, size)) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    return _bd->read_async(b, addr + _offset, size, callback);
+}
+
+int MBRBlockDevice::program_async(const void *b, bd_addr_t addr, bd_size_t size, mbed::Callback<void(int)> callback)
+{
+    if (!_is_initialized) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    if (!is_valid_program(addr, size)) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    return _bd->program_async(b, addr + _offset, size, callback);
+}
+
+int MBRBlockDevice::erase_async(bd_addr_t addr, bd_size_t size, mbed::Callback<void(int)> callback)
+{
+    if (!_is_initialized) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    if (!is_valid_erase(addr, size)) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+
+    return _bd->erase_async(addr + _offset, size, callback);
+}
+
 bd_size_t MBRBlockDevice::get_read_size() const
 {
     if (!_is_initialized) {
@@ -419,6 +471,33 @@ int MBRBlockDevice::get_erase_value() const
     return _bd->get_erase_value();
 }
 
+const void *MBRBlockDevice::get_mapped_address(bd_addr_t addr, bd_size_t size) const
+{
+    if (!_is_initialized || addr + size > _size) {
+        return NULL;
+    }
+
+    return _bd->get_mapped_address(addr + _offset, size);
+}
+
+bool MBRBlockDevice::is_erased(bd_addr_t addr, bd_size_t size) const
+{
+    if (!_is_initialized || addr + size > _size) {
+        return false;
+    }
+
+    return _bd->is_erased(addr + _offset, size);
+}
+
+uint32_t MBRBlockDevice::get_capabilities() const
+{
+    if (!_is_initialized) {
+        return 0;
+    }
+
+    return _bd->get_capabilities();
+}
+
 bd_size_t MBRBlockDevice::size() const
 {
     return _size;
@@ -17,20 +17,74 @@
 
 #include "blockdevice/ProfilingBlockDevice.h"
 #include "stddef.h"
+#include <string.h>
+#include "device.h"
+#include "platform/mbed_assert.h"
+#if DEVICE_USTICKER
+#include "hal/us_ticker_api.h"
+#endif
+
+#define PROFILE_MAGIC       0x31504442  // "BDP1" in little endian
+#define PROFILE_HEADER_WORDS    5
+#define PROFILE_OP_WORDS    (6 + 2 * ProfilingBlockDevice::PROFILE_BUCKETS + MBED_CONF_PROFILING_BLOCK_DEVICE_REGIONS)
 
 namespace mbed {
 
+const int ProfilingBlockDevice::PROFILE_BUCKETS;
+
+static uint32_t profile_now()
+{
+#if DEVICE_USTICKER
+    return us_ticker_read();
+#else
+    return 0;
+#endif
+}
+
+static int profile_bucket(uint64_t value)
+{
+    int bucket = 0;
+    while (value > 1 && bucket < ProfilingBlockDevice::PROFILE_BUCKETS - 1) {
+        value >>= 1;
+        bucket++;
+    }
+    return bucket;
+}
+
+static uint8_t *profile_put_word(uint8_t *buf, uint32_t value)
+{
+    buf[0] = (uint8_t)value;
+    buf[1] = (uint8_t)(value >> 8);
+    buf[2] = (uint8_t)(value >> 16);
+    buf[3] = (uint8_t)(value >> 24);
+    return buf + 4;
+}
+
 ProfilingBlockDevice::ProfilingBlockDevice(BlockDevice *bd)
     : _bd(bd)
     , _read_count(0)
     , _program_count(0)
     , _erase_count(0)
+    , _region_size(0)
 {
+    reset();
 }
 
 int ProfilingBlockDevice::init()
 {
-    return _bd->init();
+    int err = _bd->init();
+    if (err) {
+        return err;
+    }
+
+    // Regions are whole erase blocks, enough of them to cover the device
+    bd_size_t erase_size = _bd->get_erase_size();
+    bd_size_t regions = MBED_CONF_PROFILING_BLOCK_DEVICE_REGIONS;
+    _region_size = (_bd->size() + regions - 1) / regions;
+    if (erase_size > 0) {
+        _region_size = ((_region_size + erase_size - 1) / erase_size) * erase_size;
+    }
+    return 0;
 }
 
 int ProfilingBlockDevice::deinit()
@@ -45,28 +99,34 @@ int ProfilingBlockDevice::sync()
 
 int ProfilingBlockDevice::read(void *b, bd_addr_t addr, bd_size_t size)
 {
+    uint32_t start = profile_now();
     int err = _bd->read(b, addr, size);
     if (!err) {
         _read_count += size;
     }
+    record(PROFILE_READ, err, start, addr, size);
     return err;
 }
 
 int ProfilingBlockDevice::program(const void *b, bd_addr_t addr, bd_size_t size)
 {
+    uint32_t start = profile_now();
     int err = _bd->program(b, addr, size);
     if (!err) {
         _program_count += size;
     }
+    record(PROFILE_PROGRAM, err, start, addr, size);
     return err;
 }
 
 int ProfilingBlockDevice::erase(bd_addr_t addr, bd_size_t size)
 {
+    uint32_t start = profile_now();
     int err = _bd->erase(addr, size);
     if (!err) {
         _erase_count += size;
     }
+    record(PROFILE_ERASE, err, start, addr, size);
     return err;
 }
 
@@ -105,6 +165,10 @@ void ProfilingBlockDevice::reset()
     _read_count = 0;
     _program_count = 0;
     _erase_count = 0;
+    memset(_stats, 0, sizeof(_stats));
+    for (int i = 0; i < PROFILE_OPS; i++) {
+        _stats[i].latency_min_us = UINT32_MAX;
+    }
 }
 
 bd_size_t ProfilingBlockDevice::get_read_count() const
@@ -122,6 +186,116 @@ bd_size_t ProfilingBlockDevice::get_erase_count() const
     return _erase_count;
 }
 
+void ProfilingBlockDevice::get_op_stats(profile_op op, op_stats *stats) const
+{
+    MBED_ASSERT(op < PROFILE_OPS);
+    *stats = _stats[op];
+    if (stats->count == 0) {
+        stats->latency_min_us = 0;
+    }
+}
+
+uint32_t ProfilingBlockDevice::get_latency_avg(profile_op op) const
+{
+    MBED_ASSERT(op < PROFILE_OPS);
+    const op_stats &stats = _stats[op];
+    if (stats.count == 0) {
+        return 0;
+    }
+    return (uint32_t)(stats.latency_total_us / stats.count);
+}
+
+uint32_t ProfilingBlockDevice::get_latency_percentile(profile_op op, uint32_t percent) const
+{
+    MBED_ASSERT(op < PROFILE_OPS && percent <= 100);
+    const op_stats &stats = _stats[op];
+    if (stats.count == 0) {
+        return 0;
+    }
+
+    // Rank of the operation at that percentile, rounded up
+    uint64_t rank = ((uint64_t)stats.count * percent + 99) / 100;
+    uint64_t seen = 0;
+    for (int i = 0; i < PROFILE_BUCKETS - 1; i++) {
+        seen += stats.latency_cnt[i];
+        if (seen >= rank) {
+            uint32_t bound = (2UL << i) - 1;
+            return bound < stats.latency_max_us ? bound : stats.latency_max_us;
+        }
+    }
+    return stats.latency_max_us;
+}
+
+bd_size_t ProfilingBlockDevice::get_region_size() const
+{
+    return _region_size;
+}
+
+size_t ProfilingBlockDevice::snapshot(uint8_t *buf, size_t size) const
+{
+    size_t needed = 4 * (PROFILE_HEADER_WORDS + PROFILE_OP_WORDS * PROFILE_OPS);
+    if (buf == NULL || size < needed) {
+        return buf == NULL ? needed : 0;
+    }
+
+    buf = profile_put_word(buf, PROFILE_MAGIC);
+    buf = profile_put_word(buf, PROFILE_OPS);
+    buf = profile_put_word(buf, PROFILE_BUCKETS);
+    buf = profile_put_word(buf, MBED_CONF_PROFILING_BLOCK_DEVICE_REGIONS);
+    buf = profile_put_word(buf, (uint32_t)_region_size);
+    for (int i = 0; i < PROFILE_OPS; i++) {
+        op_stats stats;
+        get_op_stats((profile_op)i, &stats);
+        buf = profile_put_word(buf, stats.count);
+        buf = profile_put_word(buf, stats.error_count);
+        buf = profile_put_word(buf, stats.latency_min_us);
+        buf = profile_put_word(buf, stats.latency_max_us);
+        buf = profile_put_word(buf, (uint32_t)stats.latency_total_us);
+        buf = profile_put_word(buf, (uint32_t)(stats.latency_total_us >> 32));
+        for (int j = 0; j < PROFILE_BUCKETS; j++) {
+            buf = profile_put_word(buf, stats.latency_cnt[j]);
+        }
+        for (int j = 0; j < PROFILE_BUCKETS; j++) {
+            buf = profile_put_word(buf, stats.size_cnt[j]);
+        }
+        for (int j = 0; j < MBED_CONF_PROFILING_BLOCK_DEVICE_REGIONS; j++) {
+            buf = profile_put_word(buf, stats.region_cnt[j]);
+        }
+    }
+
+    return needed;
+}
+
+void ProfilingBlockDevice::record(profile_op op, int err, uint32_t start, bd_addr_t addr, bd_size_t size)
+{
+    op_stats &stats = _stats[op];
+    if (err) {
+        stats.error_count++;
+        return;
+    }
+
+    uint32_t latency = profile_now() - start;
+    stats.count++;
+    stats.latency_total_us += latency;
+    if (latency < stats.latency_min_us) {
+        stats.latency_min_us = latency;
+    }
+    if (latency > stats.latency_max_us) {
+        stats.latency_max_us = latency;
+    }
+    stats.latency_cnt[profile_bucket(latency)]++;
+    stats.size_cnt[profile_bucket(size)]++;
+
+    if (_region_size == 0 || size == 0) {
+        return;
+    }
+    bd_size_t first = addr / _region_size;
+    bd_size_t last = (addr + size - 1) / _region_size;
+    for (bd_size_t i = first; i <= last && i < MBED_CONF_PROFILING_BLOCK_DEVICE_REGIONS; i++) {
+        stats.region_cnt[i]++;
+    }
+}
+
 const char *ProfilingBlockDevice::get_type() const
 {
     if (_bd != NULL) {
@@ -436,6 +436,44 @@ int sfdp_detect_device_density(uint8_t *bptbl_ptr, sfdp_bptbl_info &bptbl_info)
     return 0;
 }
 
+int sfdp_detect_typical_times(uint8_t *bptbl_ptr, sfdp_bptbl_info &bptbl_info)
+{
+    constexpr size_t SFDP_BASIC_PARAM_TABLE_ERASE_TIMES_BYTE = 36; // DWORD 10
+    constexpr size_t SFDP_BASIC_PARAM_TABLE_PROGRAM_TIMES_BYTE = 40; // DWORD 11
+    // Erase time units for the 2-bit unit field: 1ms, 16ms, 128ms and 1s
+    constexpr uint32_t erase_time_units_us[] = {1000, 16000, 128000, 1000000};
+
+    bptbl_info.page_program_time_us = 0;
+    for (int idx = 0; idx < SFDP_MAX_NUM_OF_ERASE_TYPES; idx++) {
+        bptbl_info.erase_type_time_us[idx] = 0;
+    }
+
+    if (bptbl_info.size < SFDP_BASIC_PARAM_TABLE_PROGRAM_TIMES_BYTE + 4) {
+        tr_debug("Typical program and erase times are not available");
+        return 0;
+    }
+
+    uint32_t erase_times = (
+                               (bptbl_ptr[SFDP_BASIC_PARAM_TABLE_ERASE_TIMES_BYTE + 3] << 24) |
+                               (bptbl_ptr[SFDP_BASIC_PARAM_TABLE_ERASE_TIMES_BYTE + 2] << 16) |
+                               (bptbl_ptr[SFDP_BASIC_PARAM_TABLE_ERASE_TIMES_BYTE + 1] << 8) |
+                               bptbl_ptr[SFDP_BASIC_PARAM_TABLE_ERASE_TIMES_BYTE]);
+
+    // Each erase type has a 7-bit field from bit 4: 5-bit count (time is count + 1 units) and 2-bit unit
+    for (int idx = 0; idx < SFDP_MAX_NUM_OF_ERASE_TYPES; idx++) {
+        uint32_t field = (erase_times >> (4 + 7 * idx)) & 0x7F;
+        bptbl_info.erase_type_time_us[idx] = ((field & 0x1F) + 1) * erase_time_units_us[field >> 5];
+        tr_debug("Erase Type %d - Typical time: %" PRIu32 "us", (idx + 1), bptbl_info.erase_type_time_us[idx]);
+    }
+
+    // Page program time is bits 13:8: 5-bit count (time is count + 1 units) and 1-bit unit of 8us or 64us
+    uint8_t program_time = bptbl_ptr[SFDP_BASIC_PARAM_TABLE_PROGRAM_TIMES_BYTE + 1] & 0x3F;
+    bptbl_info.page_program_time_us = ((program_time & 0x1F) + 1) * ((program_time & 0x20) ? 64 : 8);
+    tr_debug("Typical page program time: %" PRIu32 "us", bptbl_info.page_program_time_us);
+
+    return 0;
+}
+
 #if (DEVICE_QSPI || DEVICE_OSPI)
 int sfdp_detect_addressability(uint8_t *bptbl_ptr, sfdp_bptbl_info &bptbl_info)
 {
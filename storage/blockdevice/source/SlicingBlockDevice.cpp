@@ -106,6 +106,38 @@ int SlicingBlockDevice::erase(bd_addr_t addr, bd_size_t size)
     return _bd->erase(addr + _start, size);
 }
 
+int SlicingBlockDevice::trim(bd_addr_t addr, bd_size_t size)
+{
+    if (!is_valid_erase(addr, size)) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+    return _bd->trim(addr + _start, size);
+}
+
+int SlicingBlockDevice::read_async(void *b, bd_addr_t addr, bd_size_t size, mbed::Callback<void(int)> callback)
+{
+    if (!is_valid_read(addr, size)) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+    return _bd->read_async(b, addr + _start, size, callback);
+}
+
+int SlicingBlockDevice::program_async(const void *b, bd_addr_t addr, bd_size_t size, mbed::Callback<void(int)> callback)
+{
+    if (!is_valid_program(addr, size)) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+    return _bd->program_async(b, addr + _start, size, callback);
+}
+
+int SlicingBlockDevice::erase_async(bd_addr_t addr, bd_size_t size, mbed::Callback<void(int)> callback)
+{
+    if (!is_valid_erase(addr, size)) {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+    return _bd->erase_async(addr + _start, size, callback);
+}
+
 bool SlicingBlockDevice::is_valid_read(bd_addr_t addr, bd_size_t size) const
 {
     return _bd->is_valid_read(_start + addr, size) && _start + addr + size <= _stop;
@@ -146,6 +178,27 @@ int SlicingBlockDevice::get_erase_value() const
     return _bd->get_erase_value();
 }
 
+const void *SlicingBlockDevice::get_mapped_address(bd_addr_t addr, bd_size_t size) const
+{
+    if (_start + addr + size > _stop) {
+        return NULL;
+    }
+    return _bd->get_mapped_address(addr + _start, size);
+}
+
+bool SlicingBlockDevice::is_erased(bd_addr_t addr, bd_size_t size) const
+{
+    if (_start + addr + size > _stop) {
+        return false;
+    }
+    return _bd->is_erased(addr + _start, size);
+}
+
+uint32_t SlicingBlockDevice::get_capabilities() const
+{
+    return _bd->get_capabilities();
+}
+
 bd_size_t SlicingBlockDevice::size() const
 {
     return _stop - _start;
@@ -0,0 +1,217 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "blockdevice/TimingSimBlockDevice.h"
+#include "platform/mbed_wait_api.h"
+#include "stddef.h"
+
+#if MBED_CONF_RTOS_PRESENT
+#include "rtos/ThisThread.h"
+#endif
+
+namespace mbed {
+
+// Datasheet typical values
+const TimingSimBlockDevice::timing_profile_t TimingSimBlockDevice::NOR_FLASH = {
+    1, 25000000,
+    256, 700, 25000000,
+    4096, 45000,
+    0
+};
+
+const TimingSimBlockDevice::timing_profile_t TimingSimBlockDevice::NAND_FLASH = {
+    25, 40000000,
+    2048, 250, 40000000,
+    128 * 1024, 2000,
+    0
+};
+
+const TimingSimBlockDevice::timing_profile_t TimingSimBlockDevice::SD_CARD = {
+    500, 3125000,
+    512, 1000, 3125000,
+    512, 250,
+    0
+};
+
+const TimingSimBlockDevice::timing_profile_t TimingSimBlockDevice::INTERNAL_FLASH = {
+    0, 100000000,
+    8, 80, 0,
+    2048, 22000,
+    0
+};
+
+// Number of units of the given size spanned by an operation, 1 for a size of 0
+static uint64_t units_spanned(bd_addr_t addr, bd_size_t size, uint32_t unit_size)
+{
+    if (!unit_size) {
+        return 1;
+    }
+    return (addr + size - 1) / unit_size - addr / unit_size + 1;
+}
+
+static uint64_t transfer_time(bd_size_t size, uint32_t bandwidth)
+{
+    if (!bandwidth) {
+        return 0;
+    }
+    return (size * 1000000 + bandwidth - 1) / bandwidth;
+}
+
+TimingSimBlockDevice::TimingSimBlockDevice(BlockDevice *bd, const timing_profile_t &profile, bool delay)
+    : _bd(bd)
+    , _profile(profile)
+    , _delay(delay)
+    , _read_time(0)
+    , _program_time(0)
+    , _erase_time(0)
+    , _sync_time(0)
+{
+}
+
+int TimingSimBlockDevice::init()
+{
+    return _bd->init();
+}
+
+int TimingSimBlockDevice::deinit()
+{
+    return _bd->deinit();
+}
+
+int TimingSimBlockDevice::sync()
+{
+    int err = _bd->sync();
+    if (!err) {
+        charge(_sync_time, _profile.sync_us);
+    }
+    return err;
+}
+
+int TimingSimBlockDevice::read(void *b, bd_addr_t addr, bd_size_t size)
+{
+    int err = _bd->read(b, addr, size);
+    if (!err) {
+        charge(_read_time, _profile.read_latency_us + transfer_time(size, _profile.read_bandwidth));
+    }
+    return err;
+}
+
+int TimingSimBlockDevice::program(const void *b, bd_addr_t addr, bd_size_t size)
+{
+    int err = _bd->program(b, addr, size);
+    if (!err && size) {
+        charge(_program_time, units_spanned(addr, size, _profile.program_page_size) * _profile.program_page_us +
+               transfer_time(size, _profile.program_bandwidth));
+    }
+    return err;
+}
+
+int TimingSimBlockDevice::erase(bd_addr_t addr, bd_size_t size)
+{
+    int err = _bd->erase(addr, size);
+    if (!err && size) {
+        charge(_erase_time, units_spanned(addr, size, _profile.erase_block_size) * _profile.erase_block_us);
+    }
+    return err;
+}
+
+bd_size_t TimingSimBlockDevice::get_read_size() const
+{
+    return _bd->get_read_size();
+}
+
+bd_size_t TimingSimBlockDevice::get_program_size() const
+{
+    return _bd->get_program_size();
+}
+
+bd_size_t TimingSimBlockDevice::get_erase_size() const
+{
+    return _bd->get_erase_size();
+}
+
+bd_size_t TimingSimBlockDevice::get_erase_size(bd_addr_t addr) const
+{
+    return _bd->get_erase_size(addr);
+}
+
+int TimingSimBlockDevice::get_erase_value() const
+{
+    return _bd->get_erase_value();
+}
+
+bd_size_t TimingSimBlockDevice::size() const
+{
+    return _bd->size();
+}
+
+void TimingSimBlockDevice::reset()
+{
+    _read_time = 0;
+    _program_time = 0;
+    _erase_time = 0;
+    _sync_time = 0;
+}
+
+uint64_t TimingSimBlockDevice::get_read_time() const
+{
+    return _read_time;
+}
+
+uint64_t TimingSimBlockDevice::get_program_time() const
+{
+    return _program_time;
+}
+
+uint64_t TimingSimBlockDevice::get_erase_time() const
+{
+    return _erase_time;
+}
+
+uint64_t TimingSimBlockDevice::get_elapsed_time() const
+{
+    return _read_time + _program_time + _erase_time + _sync_time;
+}
+
+const char *TimingSimBlockDevice::get_type() const
+{
+    if (_bd != NULL) {
+        return _bd->get_type();
+    }
+
+    return NULL;
+}
+
+void TimingSimBlockDevice::charge(uint64_t &counter, uint64_t time_us)
+{
+    counter += time_us;
+
+    if (_delay) {
+#if MBED_CONF_RTOS_PRESENT
+        // Sleep the whole milliseconds, so that long erases let other threads run
+        if (time_us >= 1000) {
+            rtos::ThisThread::sleep_for(std::chrono::milliseconds(time_us / 1000));
+            time_us %= 1000;
+        }
+#endif
+        if (time_us) {
+            wait_us(time_us);
+        }
+    }
+}
+
+} // namespace mbed
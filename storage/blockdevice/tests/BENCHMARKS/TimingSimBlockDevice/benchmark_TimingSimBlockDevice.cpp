@@ -0,0 +1,233 @@
+/* Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* Storage stacks timed over simulated storage technologies.
+ *
+ * The wall clock time only measures the host; the sim_us, read_us,
+ * program_us and erase_us counters are the simulated time per iteration
+ * on the technology given by the benchmark argument.
+ */
+
+#include "benchmark/benchmark.h"
+#include "blockdevice/HeapBlockDevice.h"
+#include "blockdevice/TimingSimBlockDevice.h"
+#include "tdbstore/TDBStore.h"
+#include "littlefs/LittleFileSystem.h"
+#include "fat/FATFileSystem.h"
+#include "filesystem/File.h"
+#include <stdio.h>
+#include <string.h>
+
+#define ERASE_BLOCKS (128)
+#define KEYS         (64)
+#define FILE_SIZE    (16 * 1024)
+
+using namespace mbed;
+
+namespace {
+
+struct technology_t {
+    const char *name;
+    const TimingSimBlockDevice::timing_profile_t *profile;
+    bd_size_t read_size;
+};
+
+const technology_t technologies[] = {
+    {"nor", &TimingSimBlockDevice::NOR_FLASH, 1},
+    {"nand", &TimingSimBlockDevice::NAND_FLASH, 2048},
+    {"sd", &TimingSimBlockDevice::SD_CARD, 512},
+    {"internal", &TimingSimBlockDevice::INTERNAL_FLASH, 1},
+};
+
+// Heap block device with the geometry of a technology, timed by it
+class SimulatedStorage {
+public:
+    SimulatedStorage(const technology_t &tech) :
+        heap(ERASE_BLOCKS * tech.profile->erase_block_size, tech.read_size,
+             tech.profile->program_page_size, tech.profile->erase_block_size),
+        bd(&heap, *tech.profile)
+    {
+    }
+
+    // Report the simulated time, averaged over the iterations
+    void report(benchmark::State &state)
+    {
+        state.counters["sim_us"] = benchmark::Counter(bd.get_elapsed_time(), benchmark::Counter::kAvgIterations);
+        state.counters["read_us"] = benchmark::Counter(bd.get_read_time(), benchmark::Counter::kAvgIterations);
+        state.counters["program_us"] = benchmark::Counter(bd.get_program_time(), benchmark::Counter::kAvgIterations);
+        state.counters["erase_us"] = benchmark::Counter(bd.get_erase_time(), benchmark::Counter::kAvgIterations);
+    }
+
+    HeapBlockDevice heap;
+    TimingSimBlockDevice bd;
+};
+
+const technology_t &technology(benchmark::State &state)
+{
+    const technology_t &tech = technologies[state.range(0)];
+    state.SetLabel(tech.name);
+    return tech;
+}
+
+void key_name(char *key, int i)
+{
+    snprintf(key, 16, "key%d", i);
+}
+
+// Write a file and read it back, in chunks of the given size
+void file_write_read(benchmark::State &state, FileSystem &fs, SimulatedStorage &storage)
+{
+    uint8_t chunk[512] = {};
+    size_t chunk_size = state.range(1);
+
+    storage.bd.reset();
+    for (auto _ : state) {
+        File file;
+        file.open(&fs, "file", O_WRONLY | O_CREAT | O_TRUNC);
+        for (size_t i = 0; i < FILE_SIZE; i += chunk_size) {
+            file.write(chunk, chunk_size);
+        }
+        file.close();
+
+        file.open(&fs, "file", O_RDONLY);
+        for (size_t i = 0; i < FILE_SIZE; i += chunk_size) {
+            file.read(chunk, chunk_size);
+        }
+        file.close();
+    }
+
+    state.SetBytesProcessed(state.iterations() * FILE_SIZE);
+    storage.report(state);
+}
+
+} // anonymous namespace
+
+// Set keys in turn, including the garbage collections they trigger
+static void BM_TimingSim_TDBStore_set(benchmark::State &state)
+{
+    SimulatedStorage storage{technology(state)};
+    TDBStore tdb{&storage.bd};
+    uint8_t data[1024] = {};
+    char key[16];
+    int i = 0;
+
+    if (tdb.init() || tdb.reset()) {
+        state.SkipWithError("TDBStore init failed");
+        return;
+    }
+
+    storage.bd.reset();
+    for (auto _ : state) {
+        key_name(key, i++ % KEYS);
+        tdb.set(key, data, state.range(1), 0);
+    }
+
+    state.SetBytesProcessed(state.iterations() * state.range(1));
+    storage.report(state);
+    tdb.deinit();
+}
+BENCHMARK(BM_TimingSim_TDBStore_set)->ArgsProduct({{0, 1, 2, 3}, {16, 1024}});
+
+// Get keys from a store holding KEYS of them
+static void BM_TimingSim_TDBStore_get(benchmark::State &state)
+{
+    SimulatedStorage storage{technology(state)};
+    TDBStore tdb{&storage.bd};
+    uint8_t data[1024] = {};
+    char key[16];
+
+    if (tdb.init() || tdb.reset()) {
+        state.SkipWithError("TDBStore init failed");
+        return;
+    }
+    for (int i = 0; i < KEYS; i++) {
+        key_name(key, i);
+        tdb.set(key, data, state.range(1), 0);
+    }
+    int i = 0;
+
+    storage.bd.reset();
+    for (auto _ : state) {
+        size_t size;
+        key_name(key, i++ % KEYS);
+        tdb.get(key, data, sizeof(data), &size);
+        benchmark::DoNotOptimize(size);
+    }
+
+    state.SetBytesProcessed(state.iterations() * state.range(1));
+    storage.report(state);
+    tdb.deinit();
+}
+BENCHMARK(BM_TimingSim_TDBStore_get)->ArgsProduct({{0, 1, 2, 3}, {16, 1024}});
+
+// Mount a store holding KEYS keys
+static void BM_TimingSim_TDBStore_init(benchmark::State &state)
+{
+    SimulatedStorage storage{technology(state)};
+    TDBStore tdb{&storage.bd};
+    uint8_t data[64] = {};
+    char key[16];
+
+    if (tdb.init() || tdb.reset()) {
+        state.SkipWithError("TDBStore init failed");
+        return;
+    }
+    for (int i = 0; i < KEYS; i++) {
+        key_name(key, i);
+        tdb.set(key, data, sizeof(data), 0);
+    }
+    tdb.deinit();
+
+    storage.bd.reset();
+    for (auto _ : state) {
+        tdb.init();
+        tdb.deinit();
+    }
+
+    storage.report(state);
+}
+BENCHMARK(BM_TimingSim_TDBStore_init)->DenseRange(0, 3);
+
+static void BM_TimingSim_LittleFS_file(benchmark::State &state)
+{
+    SimulatedStorage storage{technology(state)};
+    LittleFileSystem fs{NULL};
+
+    if (fs.reformat(&storage.bd)) {
+        state.SkipWithError("LittleFS format failed");
+        return;
+    }
+
+    file_write_read(state, fs, storage);
+    fs.unmount();
+}
+BENCHMARK(BM_TimingSim_LittleFS_file)->ArgsProduct({{0, 1, 2, 3}, {64, 512}});
+
+// Not on NAND flash, its erase blocks are larger than the largest FAT sector
+static void BM_TimingSim_FAT_file(benchmark::State &state)
+{
+    SimulatedStorage storage{technology(state)};
+    FATFileSystem fs{NULL};
+
+    if (fs.reformat(&storage.bd)) {
+        state.SkipWithError("FAT format failed");
+        return;
+    }
+
+    file_write_read(state, fs, storage);
+    fs.unmount();
+}
+BENCHMARK(BM_TimingSim_FAT_file)->ArgsProduct({{0, 2, 3}, {64, 512}});
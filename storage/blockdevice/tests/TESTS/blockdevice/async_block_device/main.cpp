@@ -0,0 +1,155 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "mbed.h"
+#include "greentea-client/test_env.h"
+#include "unity.h"
+#include "utest.h"
+
+#include "AsyncBlockDevice.h"
+#include "HeapBlockDevice.h"
+#include <stdlib.h>
+
+using namespace utest::v1;
+
+#if !defined(MBED_CONF_RTOS_PRESENT)
+#error [NOT_SUPPORTED] Async block device test cases require a RTOS to run.
+#else
+
+#define TEST_BLOCK_SIZE 128
+#define TEST_BLOCK_DEVICE_SIZE 32*TEST_BLOCK_SIZE
+#define TEST_BLOCK_COUNT 8
+
+#if ((MBED_RAM_SIZE - MBED_CONF_TARGET_BOOT_STACK_SIZE) <= TEST_BLOCK_DEVICE_SIZE)
+#error [NOT_SUPPORTED] Insufficient heap for async block device tests
+#endif
+
+// Counts completions and records the first failure
+struct completion_counter {
+    Semaphore done;
+    int err;
+    osThreadId_t thread;
+
+    completion_counter() : done(0), err(0), thread(0) {}
+
+    void complete(int result)
+    {
+        if (result && !err) {
+            err = result;
+        }
+        thread = ThisThread::get_id();
+        done.release();
+    }
+};
+
+// Queue several erase/program pairs without waiting, then verify them
+void test_async_erase_program_read()
+{
+    uint8_t *dummy = new (std::nothrow) uint8_t[TEST_BLOCK_DEVICE_SIZE];
+    TEST_SKIP_UNLESS_MESSAGE(dummy, "Not enough memory for test");
+    delete[] dummy;
+
+    HeapBlockDevice heap(TEST_BLOCK_DEVICE_SIZE, TEST_BLOCK_SIZE);
+    AsyncBlockDevice bd(&heap);
+
+    int err = bd.init();
+    TEST_ASSERT_EQUAL(0, err);
+
+    uint8_t *write_blocks = new (std::nothrow) uint8_t[TEST_BLOCK_COUNT * TEST_BLOCK_SIZE];
+    uint8_t *read_block = new (std::nothrow) uint8_t[TEST_BLOCK_SIZE];
+    TEST_SKIP_UNLESS_MESSAGE(write_blocks && read_block, "Not enough memory for test");
+
+    for (int i = 0; i < TEST_BLOCK_COUNT * TEST_BLOCK_SIZE; i++) {
+        write_blocks[i] = 0xff & rand();
+    }
+
+    completion_counter counter;
+    for (int b = 0; b < TEST_BLOCK_COUNT; b++) {
+        err = bd.erase_async(b * TEST_BLOCK_SIZE, TEST_BLOCK_SIZE, callback(&counter, &completion_counter::complete));
+        TEST_ASSERT_EQUAL(0, err);
+        err = bd.program_async(write_blocks + b * TEST_BLOCK_SIZE, b * TEST_BLOCK_SIZE, TEST_BLOCK_SIZE,
+                               callback(&counter, &completion_counter::complete));
+        TEST_ASSERT_EQUAL(0, err);
+    }
+
+    // A blocking read is ordered after everything queued before it
+    err = bd.read(read_block, (TEST_BLOCK_COUNT - 1) * TEST_BLOCK_SIZE, TEST_BLOCK_SIZE);
+    TEST_ASSERT_EQUAL(0, err);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(write_blocks + (TEST_BLOCK_COUNT - 1) * TEST_BLOCK_SIZE, read_block, TEST_BLOCK_SIZE);
+
+    for (int i = 0; i < 2 * TEST_BLOCK_COUNT; i++) {
+        TEST_ASSERT_TRUE(counter.done.try_acquire_for(1s));
+    }
+    TEST_ASSERT_EQUAL(0, counter.err);
+    TEST_ASSERT_NOT_EQUAL(ThisThread::get_id(), counter.thread);
+
+    for (int b = 0; b < TEST_BLOCK_COUNT; b++) {
+        err = bd.read_async(read_block, b * TEST_BLOCK_SIZE, TEST_BLOCK_SIZE,
+                            callback(&counter, &completion_counter::complete));
+        TEST_ASSERT_EQUAL(0, err);
+        TEST_ASSERT_TRUE(counter.done.try_acquire_for(1s));
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(write_blocks + b * TEST_BLOCK_SIZE, read_block, TEST_BLOCK_SIZE);
+    }
+
+    // Errors from the underlying device are reported through the callback
+    err = bd.read_async(read_block, TEST_BLOCK_DEVICE_SIZE, TEST_BLOCK_SIZE,
+                        callback(&counter, &completion_counter::complete));
+    TEST_ASSERT_EQUAL(0, err);
+    TEST_ASSERT_TRUE(counter.done.try_acquire_for(1s));
+    TEST_ASSERT_NOT_EQUAL(0, counter.err);
+
+    err = bd.deinit();
+    TEST_ASSERT_EQUAL(0, err);
+
+    // Nothing is queued once deinitialized
+    err = bd.erase_async(0, TEST_BLOCK_SIZE, callback(&counter, &completion_counter::complete));
+    TEST_ASSERT_EQUAL(BD_ERROR_DEVICE_ERROR, err);
+
+    delete[] write_blocks;
+    delete[] read_block;
+}
+
+void test_get_type_functionality()
+{
+    HeapBlockDevice heap(TEST_BLOCK_DEVICE_SIZE, TEST_BLOCK_SIZE);
+    AsyncBlockDevice bd(&heap);
+
+    const char *bd_type = bd.get_type();
+    TEST_ASSERT_NOT_EQUAL(0, bd_type);
+    TEST_ASSERT_EQUAL(0, strcmp(bd_type, "HEAP"));
+}
+
+
+// Test setup
+utest::v1::status_t test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(30, "default_auto");
+    return verbose_test_setup_handler(number_of_cases);
+}
+
+Case cases[] = {
+    Case("Testing async erase, program and read", test_async_erase_program_read),
+    Case("Testing get type functionality", test_get_type_functionality)
+};
+
+Specification specification(test_setup, cases);
+
+int main()
+{
+    return !Harness::run(specification);
+}
+
+#endif // !defined(MBED_CONF_RTOS_PRESENT)
@@ -99,3 +99,37 @@ TEST_F(TestSFDP, TestEraseTypeAlgorithm)
                 smptbl);
     EXPECT_EQ(type, -1); // Invalid erase
 }
+
+/**
+ * Test if sfdp_detect_typical_times() decodes the typical erase and
+ * page program times of DWORDs 10 and 11 of the Basic Parameter Table.
+ */
+TEST_F(TestSFDP, TestTypicalTimes)
+{
+    uint8_t bptbl[mbed::SFDP_BASIC_PARAMS_TBL_SIZE] = {};
+    mbed::sfdp_bptbl_info bptbl_info;
+
+    // Erase types 1 to 3 take 15 x 1ms, 8 x 16ms and 2 x 128ms, type 4 is left at 1 x 1ms
+    uint32_t erase_times = (14 << 4) | ((0x20 | 7) << 11) | ((0x40 | 1) << 18);
+    bptbl[36] = erase_times & 0xFF;
+    bptbl[37] = (erase_times >> 8) & 0xFF;
+    bptbl[38] = (erase_times >> 16) & 0xFF;
+    bptbl[39] = (erase_times >> 24) & 0xFF;
+    // Page size 2^8, page program in 6 x 64us
+    bptbl[40] = 0x80;
+    bptbl[41] = 0x20 | 5;
+
+    bptbl_info.size = mbed::SFDP_BASIC_PARAMS_TBL_SIZE;
+    EXPECT_EQ(0, sfdp_detect_typical_times(bptbl, bptbl_info));
+    EXPECT_EQ(384u, bptbl_info.page_program_time_us);
+    EXPECT_EQ(15000u, bptbl_info.erase_type_time_us[0]);
+    EXPECT_EQ(128000u, bptbl_info.erase_type_time_us[1]);
+    EXPECT_EQ(256000u, bptbl_info.erase_type_time_us[2]);
+    EXPECT_EQ(1000u, bptbl_info.erase_type_time_us[3]);
+
+    // JESD216 tables of 9 DWORDs have no times
+    bptbl_info.size = 36;
+    EXPECT_EQ(0, sfdp_detect_typical_times(bptbl, bptbl_info));
+    EXPECT_EQ(0u, bptbl_info.page_program_time_us);
+    EXPECT_EQ(0u, bptbl_info.erase_type_time_us[0]);
+}
@@ -316,3 +316,115 @@ TEST_F(BufferedBlockModuleTest, flush_automatically)
     .Times(1)
     .WillOnce(Return(BD_ERROR_OK));
 }
+
+TEST_F(BufferedBlockModuleTest, multi_entry_cache_lru)
+{
+    BufferedBlockDevice b(&bd_mock, 2, true);
+
+    EXPECT_CALL(bd_mock, init());
+    EXPECT_CALL(bd_mock, get_read_size()).WillOnce(Return(BLOCK_SIZE));
+    EXPECT_CALL(bd_mock, get_program_size()).WillOnce(Return(BLOCK_SIZE));
+    EXPECT_CALL(bd_mock, size()).WillOnce(Return(DEVICE_SIZE));
+    ASSERT_EQ(b.init(), 0);
+
+    // Fill both entries with partial programs to two units
+    EXPECT_CALL(bd_mock, read(_, 0, BLOCK_SIZE))
+    .Times(1)
+    .WillOnce(DoAll(SetArg0ToCharPtr(magic, BLOCK_SIZE), Return(BD_ERROR_OK)));
+    EXPECT_CALL(bd_mock, read(_, BLOCK_SIZE * 4, BLOCK_SIZE))
+    .Times(1)
+    .WillOnce(DoAll(SetArg0ToCharPtr(magic, BLOCK_SIZE), Return(BD_ERROR_OK)));
+
+    EXPECT_EQ(b.program("a", 0, 1), 0);
+    EXPECT_EQ(b.program("b", BLOCK_SIZE * 4, 1), 0);
+    // Interleaved access hits the cache without touching the device
+    EXPECT_EQ(b.program("c", 1, 1), 0);
+    EXPECT_EQ(b.program("d", BLOCK_SIZE * 4 + 1, 1), 0);
+    EXPECT_EQ(b.program("e", 2, 1), 0);
+    EXPECT_EQ(b.get_cache_miss_count(), 2);
+    EXPECT_EQ(b.get_cache_hit_count(), 3);
+
+    EXPECT_CALL(bd_mock, is_valid_read(BLOCK_SIZE * 4, 2)).WillOnce(Return(true));
+    EXPECT_EQ(b.read(buf, BLOCK_SIZE * 4, 2), 0);
+    EXPECT_EQ(0, memcmp(buf, "bd", 2));
+    EXPECT_EQ(b.get_cache_hit_count(), 4);
+
+    // Third unit evicts the least recently used one
+    EXPECT_CALL(bd_mock, program(_, BLOCK_SIZE * 4, BLOCK_SIZE))
+    .Times(1)
+    .WillOnce(Return(BD_ERROR_OK));
+    EXPECT_CALL(bd_mock, read(_, BLOCK_SIZE * 2, BLOCK_SIZE))
+    .Times(1)
+    .WillOnce(DoAll(SetArg0ToCharPtr(magic, BLOCK_SIZE), Return(BD_ERROR_OK)));
+
+    EXPECT_EQ(b.program("f", BLOCK_SIZE * 2, 1), 0);
+    EXPECT_EQ(b.get_cache_miss_count(), 3);
+
+    b.reset_cache_counts();
+    EXPECT_EQ(b.get_cache_miss_count(), 0);
+    EXPECT_EQ(b.get_cache_hit_count(), 0);
+
+    // Remaining units are written back on sync
+    EXPECT_CALL(bd_mock, program(_, 0, BLOCK_SIZE))
+    .Times(1)
+    .WillOnce(Return(BD_ERROR_OK));
+    EXPECT_CALL(bd_mock, program(_, BLOCK_SIZE * 2, BLOCK_SIZE))
+    .Times(1)
+    .WillOnce(Return(BD_ERROR_OK));
+    EXPECT_CALL(bd_mock, sync());
+    EXPECT_EQ(b.sync(), 0);
+
+    EXPECT_CALL(bd_mock, deinit()); // Called in b's destructor
+    EXPECT_CALL(bd_mock, sync()); // Called on b's deinit
+}
+
+TEST_F(BufferedBlockModuleTest, multi_entry_cache_program_order)
+{
+    BufferedBlockDevice b(&bd_mock, 2);
+
+    EXPECT_CALL(bd_mock, init());
+    EXPECT_CALL(bd_mock, get_read_size()).WillOnce(Return(BLOCK_SIZE));
+    EXPECT_CALL(bd_mock, get_program_size()).WillOnce(Return(BLOCK_SIZE));
+    EXPECT_CALL(bd_mock, size()).WillOnce(Return(DEVICE_SIZE));
+    ASSERT_EQ(b.init(), 0);
+
+    {
+        ::testing::InSequence seq;
+        EXPECT_CALL(bd_mock, read(_, 0, BLOCK_SIZE))
+        .WillOnce(DoAll(SetArg0ToCharPtr(magic, BLOCK_SIZE), Return(BD_ERROR_OK)));
+        EXPECT_CALL(bd_mock, read(_, BLOCK_SIZE * 4, BLOCK_SIZE))
+        .WillOnce(DoAll(SetArg0ToCharPtr(magic, BLOCK_SIZE), Return(BD_ERROR_OK)));
+        // Going back to the first unit writes both back in program order
+        EXPECT_CALL(bd_mock, program(_, 0, BLOCK_SIZE)).WillOnce(Return(BD_ERROR_OK));
+        EXPECT_CALL(bd_mock, program(_, BLOCK_SIZE * 4, BLOCK_SIZE)).WillOnce(Return(BD_ERROR_OK));
+        EXPECT_CALL(bd_mock, read(_, 0, BLOCK_SIZE))
+        .WillOnce(DoAll(SetArg0ToCharPtr(magic, BLOCK_SIZE), Return(BD_ERROR_OK)));
+        // Completing a unit writes back the units programmed before it first
+        EXPECT_CALL(bd_mock, read(_, BLOCK_SIZE * 2, BLOCK_SIZE))
+        .WillOnce(DoAll(SetArg0ToCharPtr(magic, BLOCK_SIZE), Return(BD_ERROR_OK)));
+        EXPECT_CALL(bd_mock, program(_, 0, BLOCK_SIZE)).WillOnce(Return(BD_ERROR_OK));
+        EXPECT_CALL(bd_mock, program(_, BLOCK_SIZE * 2, BLOCK_SIZE)).WillOnce(Return(BD_ERROR_OK));
+        EXPECT_CALL(bd_mock, sync());
+    }
+
+    EXPECT_EQ(b.program("a", 0, 1), 0);
+    EXPECT_EQ(b.program("b", BLOCK_SIZE * 4, 1), 0);
+    EXPECT_EQ(b.program("c", 1, 1), 0);
+    EXPECT_EQ(b.get_cache_miss_count(), 3);
+    EXPECT_EQ(b.get_cache_hit_count(), 0);
+
+    EXPECT_EQ(b.program(magic, BLOCK_SIZE * 3 - 1, 1), 0);
+
+    EXPECT_CALL(bd_mock, deinit()); // Called in b's destructor
+    EXPECT_CALL(bd_mock, sync()); // Called on b's deinit
+}
+
+TEST_F(BufferedBlockModuleTest, uncached_read_not_counted)
+{
+    EXPECT_CALL(bd_mock, is_valid_read(0, BLOCK_SIZE)).WillOnce(Return(true));
+    EXPECT_CALL(bd_mock, read(buf, 0, BLOCK_SIZE)).WillOnce(Return(BD_ERROR_OK));
+
+    EXPECT_EQ(bd.read(buf, 0, BLOCK_SIZE), 0);
+    EXPECT_EQ(bd.get_cache_miss_count(), 0);
+    EXPECT_EQ(bd.get_cache_hit_count(), 0);
+}
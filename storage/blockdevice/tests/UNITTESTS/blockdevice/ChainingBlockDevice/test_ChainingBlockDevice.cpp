@@ -17,6 +17,7 @@
 #include "gtest/gtest.h"
 #include "ChainingBlockDevice.cpp"
 #include "stubs/BlockDevice_mock.h"
+#include "blockdevice/HeapBlockDevice.h"
 
 using ::testing::_;
 using ::testing::Return;
@@ -160,3 +161,36 @@ TEST_F(ChainingBlockModuleTest, memory_overlap)
 
     EXPECT_EQ(bd.erase((SECTORS_NUM / 2 - 2) * BLOCK_SIZE, 4 * BLOCK_SIZE), BD_ERROR_OK);
 }
+
+TEST_F(ChainingBlockModuleTest, striped_parallel)
+{
+    mbed::HeapBlockDevice heap1(SECTORS_NUM * BLOCK_SIZE, BLOCK_SIZE);
+    mbed::HeapBlockDevice heap2((SECTORS_NUM - 2) * BLOCK_SIZE, BLOCK_SIZE);
+    BlockDevice *heaps[] = {&heap1, &heap2};
+    ChainingBlockDevice striped(heaps, ChainingBlockDevice::CHAIN_STRIPED | ChainingBlockDevice::CHAIN_PARALLEL);
+
+    ASSERT_EQ(striped.init(), BD_ERROR_OK);
+    // Only the stripes present on both devices are used
+    EXPECT_EQ(striped.size(), 2 * (SECTORS_NUM - 2) * BLOCK_SIZE);
+    EXPECT_EQ(striped.get_erase_size(BLOCK_SIZE), BLOCK_SIZE);
+
+    EXPECT_EQ(striped.erase(BLOCK_SIZE, 4 * BLOCK_SIZE), BD_ERROR_OK);
+    EXPECT_EQ(striped.program(magic, BLOCK_SIZE, 4 * BLOCK_SIZE), BD_ERROR_OK);
+
+    // Consecutive erase units alternate between the devices
+    EXPECT_EQ(heap2.read(buf, 0, BLOCK_SIZE), BD_ERROR_OK);
+    EXPECT_EQ(memcmp(magic, buf, BLOCK_SIZE), 0);
+    EXPECT_EQ(heap1.read(buf, BLOCK_SIZE, BLOCK_SIZE), BD_ERROR_OK);
+    EXPECT_EQ(memcmp(magic + BLOCK_SIZE, buf, BLOCK_SIZE), 0);
+    EXPECT_EQ(heap2.read(buf, BLOCK_SIZE, BLOCK_SIZE), BD_ERROR_OK);
+    EXPECT_EQ(memcmp(magic + 2 * BLOCK_SIZE, buf, BLOCK_SIZE), 0);
+    EXPECT_EQ(heap1.read(buf, 2 * BLOCK_SIZE, BLOCK_SIZE), BD_ERROR_OK);
+    EXPECT_EQ(memcmp(magic + 3 * BLOCK_SIZE, buf, BLOCK_SIZE), 0);
+
+    memset(buf, 0, BLOCK_SIZE * 4);
+    EXPECT_EQ(striped.read(buf, BLOCK_SIZE, 4 * BLOCK_SIZE), BD_ERROR_OK);
+    EXPECT_EQ(memcmp(magic, buf, BLOCK_SIZE * 4), 0);
+
+    EXPECT_EQ(striped.read(buf, striped.size(), BLOCK_SIZE), BD_ERROR_DEVICE_ERROR);
+    EXPECT_EQ(striped.deinit(), BD_ERROR_OK);
+}
@@ -14,6 +14,7 @@ set(unittest-sources
   ../storage/blockdevice/source/HeapBlockDevice.cpp
   stubs/mbed_atomic_stub.c
   stubs/mbed_assert_stub.cpp
+  stubs/Semaphore_stub.cpp
 )
 
 set(unittest-test-sources
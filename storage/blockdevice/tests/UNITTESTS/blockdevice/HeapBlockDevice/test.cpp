@@ -124,3 +124,35 @@ TEST_F(HeapBlockDeviceTest, read_unprogrammed)
     // Ignore the content, it is now zero, but does not need to be.
     delete[] buf;
 }
+
+static void store_result(int *result, int err)
+{
+    *result = err;
+}
+
+TEST_F(HeapBlockDeviceTest, async_default_implementation)
+{
+    uint8_t *block = new uint8_t[BLOCK_SIZE] {0xaa,0xbb,0xcc};
+    uint8_t *buf = new uint8_t[BLOCK_SIZE];
+    int result = 1;
+
+    // The default implementation completes before returning
+    EXPECT_EQ(bd.erase_async(0, BLOCK_SIZE, mbed::callback(store_result, &result)), BD_ERROR_OK);
+    EXPECT_EQ(result, BD_ERROR_OK);
+    result = 1;
+    EXPECT_EQ(bd.program_async(block, 0, BLOCK_SIZE, mbed::callback(store_result, &result)), BD_ERROR_OK);
+    EXPECT_EQ(result, BD_ERROR_OK);
+    result = 1;
+    EXPECT_EQ(bd.read_async(buf, 0, BLOCK_SIZE, mbed::callback(store_result, &result)), BD_ERROR_OK);
+    EXPECT_EQ(result, BD_ERROR_OK);
+    EXPECT_EQ(0, memcmp(block, buf, BLOCK_SIZE));
+
+    // Errors are reported through the callback
+    EXPECT_EQ(bd.read_async(buf, DEVICE_SIZE, BLOCK_SIZE, mbed::callback(store_result, &result)), BD_ERROR_OK);
+    EXPECT_EQ(result, BD_ERROR_DEVICE_ERROR);
+
+    // A null callback is allowed
+    EXPECT_EQ(bd.erase_async(0, BLOCK_SIZE, NULL), BD_ERROR_OK);
+    delete[] block;
+    delete[] buf;
+}
@@ -123,6 +123,8 @@ TEST_F(MBRBlockModuleTest, init)
     EXPECT_EQ(b.read(buf, 0, BLOCK_SIZE), BD_ERROR_DEVICE_ERROR);
     EXPECT_EQ(b.deinit(), BD_ERROR_OK);
     EXPECT_EQ(b.sync(), BD_ERROR_DEVICE_ERROR);
+    EXPECT_EQ(b.trim(0, BLOCK_SIZE), BD_ERROR_DEVICE_ERROR);
+    EXPECT_EQ(b.get_capabilities(), 0);
 
     EXPECT_CALL(bd_mock, read(_, 0, BLOCK_SIZE))
     .Times(1)
@@ -221,6 +223,36 @@ TEST_F(MBRBlockModuleTest, program_read_erase)
     EXPECT_EQ(bd.erase(0, BLOCK_SIZE), BD_ERROR_OK);
 }
 
+TEST_F(MBRBlockModuleTest, capabilities_pass_through)
+{
+    constexpr uint32_t partition_offset = BLOCK_SIZE * 3 * SECTORS_NUM / PARTITIONS;
+    static const uint8_t mapped[DEVICE_SIZE] = {};
+
+    EXPECT_CALL(bd_mock, get_capabilities())
+    .WillOnce(Return(BD_CAPABILITY_MAPPED | BD_CAPABILITY_TRIM | BD_CAPABILITY_ERASE_STATE));
+    EXPECT_EQ(bd.get_capabilities(), BD_CAPABILITY_MAPPED | BD_CAPABILITY_TRIM | BD_CAPABILITY_ERASE_STATE);
+
+    EXPECT_CALL(bd_mock, trim(partition_offset + BLOCK_SIZE, BLOCK_SIZE))
+    .Times(1)
+    .WillOnce(Return(BD_ERROR_OK));
+    EXPECT_EQ(bd.trim(BLOCK_SIZE, BLOCK_SIZE), BD_ERROR_OK);
+
+    EXPECT_CALL(bd_mock, is_erased(partition_offset, BLOCK_SIZE))
+    .Times(1)
+    .WillOnce(Return(true));
+    EXPECT_TRUE(bd.is_erased(0, BLOCK_SIZE));
+
+    EXPECT_CALL(bd_mock, get_mapped_address(partition_offset, BLOCK_SIZE))
+    .Times(1)
+    .WillOnce(Return(mapped + partition_offset));
+    EXPECT_EQ(bd.get_mapped_address(0, BLOCK_SIZE), mapped + partition_offset);
+
+    // Regions past the end of the partition never reach the underlying device
+    EXPECT_FALSE(bd.is_erased(DEVICE_SIZE / 4, BLOCK_SIZE));
+    EXPECT_EQ(bd.get_mapped_address(DEVICE_SIZE / 4, BLOCK_SIZE), nullptr);
+    EXPECT_EQ(bd.trim(DEVICE_SIZE / 4, BLOCK_SIZE), BD_ERROR_DEVICE_ERROR);
+}
+
 TEST_F(MBRBlockModuleTest, partitioning)
 {
     uint8_t MBRbuf2[BLOCK_SIZE];
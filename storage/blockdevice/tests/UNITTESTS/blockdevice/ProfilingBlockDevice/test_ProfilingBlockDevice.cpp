@@ -92,3 +92,72 @@ TEST_F(ProfilingBlockModuleTest, count) {
     EXPECT_EQ(bd.get_program_count(), 0);
     EXPECT_EQ(bd.get_erase_count(), 0);
 }
+
+TEST_F(ProfilingBlockModuleTest, stats)
+{
+    ProfilingBlockDevice::op_stats stats;
+
+    EXPECT_EQ(bd.get_region_size(), BLOCK_SIZE);
+    EXPECT_EQ(bd.get_latency_avg(ProfilingBlockDevice::PROFILE_READ), 0);
+    EXPECT_EQ(bd.get_latency_percentile(ProfilingBlockDevice::PROFILE_READ, 99), 0);
+
+    EXPECT_EQ(bd.read(buf, 0, BLOCK_SIZE), 0);
+    EXPECT_EQ(bd.read(buf, BLOCK_SIZE, 4), 0);
+    EXPECT_EQ(bd.erase(2 * BLOCK_SIZE, 2 * BLOCK_SIZE), 0);
+
+    EXPECT_CALL(bd_mock, program(_, 0, BLOCK_SIZE))
+    .WillOnce(Return(BD_ERROR_DEVICE_ERROR));
+    EXPECT_EQ(bd.program(magic, 0, BLOCK_SIZE), BD_ERROR_DEVICE_ERROR);
+
+    bd.get_op_stats(ProfilingBlockDevice::PROFILE_READ, &stats);
+    EXPECT_EQ(stats.count, 2);
+    EXPECT_EQ(stats.error_count, 0);
+    EXPECT_EQ(stats.size_cnt[9], 1);    // 512 bytes
+    EXPECT_EQ(stats.size_cnt[2], 1);    // 4 bytes
+    EXPECT_EQ(stats.region_cnt[0], 1);
+    EXPECT_EQ(stats.region_cnt[1], 1);
+    EXPECT_EQ(stats.region_cnt[2], 0);
+
+    bd.get_op_stats(ProfilingBlockDevice::PROFILE_ERASE, &stats);
+    EXPECT_EQ(stats.count, 1);
+    EXPECT_EQ(stats.region_cnt[1], 0);
+    EXPECT_EQ(stats.region_cnt[2], 1);
+    EXPECT_EQ(stats.region_cnt[3], 1);
+    EXPECT_EQ(stats.region_cnt[4], 0);
+
+    bd.get_op_stats(ProfilingBlockDevice::PROFILE_PROGRAM, &stats);
+    EXPECT_EQ(stats.count, 0);
+    EXPECT_EQ(stats.error_count, 1);
+    EXPECT_EQ(bd.get_program_count(), 0);
+
+    bd.reset();
+
+    bd.get_op_stats(ProfilingBlockDevice::PROFILE_READ, &stats);
+    EXPECT_EQ(stats.count, 0);
+    EXPECT_EQ(stats.size_cnt[9], 0);
+    EXPECT_EQ(stats.region_cnt[0], 0);
+}
+
+TEST_F(ProfilingBlockModuleTest, snapshot)
+{
+    size_t size = bd.snapshot(NULL, 0);
+    ASSERT_GT(size, 20);
+
+    EXPECT_EQ(bd.erase(0, BLOCK_SIZE), 0);
+
+    uint8_t *snapshot = new uint8_t[size];
+    EXPECT_EQ(bd.snapshot(snapshot, size - 1), 0);
+    EXPECT_EQ(bd.snapshot(snapshot, size), size);
+
+    // Magic, then the operation, bucket and region counts
+    EXPECT_EQ(memcmp(snapshot, "BDP1", 4), 0);
+    EXPECT_EQ(snapshot[4], ProfilingBlockDevice::PROFILE_OPS);
+    EXPECT_EQ(snapshot[8], ProfilingBlockDevice::PROFILE_BUCKETS);
+    EXPECT_EQ(snapshot[12], MBED_CONF_PROFILING_BLOCK_DEVICE_REGIONS);
+    EXPECT_EQ(snapshot[16] | (snapshot[17] << 8), BLOCK_SIZE);
+
+    // The erase is the count of the last operation
+    size_t op_size = (size - 20) / ProfilingBlockDevice::PROFILE_OPS;
+    EXPECT_EQ(snapshot[20 + 2 * op_size], 1);
+    delete[] snapshot;
+}
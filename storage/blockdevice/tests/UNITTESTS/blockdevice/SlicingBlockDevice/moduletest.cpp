@@ -218,3 +218,98 @@ TEST_F(SlicingBlockModuleTest, too_big_to_init)
     // Just a pass through
     EXPECT_EQ(slice.init(), BD_ERROR_DEVICE_ERROR);
 }
+
+static void store_result(int *result, int err)
+{
+    *result = err;
+}
+
+TEST_F(SlicingBlockModuleTest, async_offsets)
+{
+    int result = 1;
+    mbed::SlicingBlockDevice slice(&bd, BLOCK_SIZE, BLOCK_SIZE * 3);
+    EXPECT_EQ(slice.init(), BD_ERROR_OK);
+
+    EXPECT_EQ(slice.erase_async(BLOCK_SIZE, BLOCK_SIZE, mbed::callback(store_result, &result)), BD_ERROR_OK);
+    EXPECT_EQ(result, BD_ERROR_OK);
+    result = 1;
+    EXPECT_EQ(slice.program_async(magic, BLOCK_SIZE, BLOCK_SIZE, mbed::callback(store_result, &result)), BD_ERROR_OK);
+    EXPECT_EQ(result, BD_ERROR_OK);
+
+    // The program landed at the slice offset on the underlying device
+    bd.read(buf, BLOCK_SIZE * 2, BLOCK_SIZE);
+    EXPECT_EQ(0, memcmp(buf, magic, BLOCK_SIZE));
+
+    memset(buf, 0, BLOCK_SIZE);
+    result = 1;
+    EXPECT_EQ(slice.read_async(buf, BLOCK_SIZE, BLOCK_SIZE, mbed::callback(store_result, &result)), BD_ERROR_OK);
+    EXPECT_EQ(result, BD_ERROR_OK);
+    EXPECT_EQ(0, memcmp(buf, magic, BLOCK_SIZE));
+
+    // Out of range operations are rejected without calling back
+    result = 1;
+    EXPECT_EQ(slice.read_async(buf, BLOCK_SIZE * 2, BLOCK_SIZE, mbed::callback(store_result, &result)), BD_ERROR_DEVICE_ERROR);
+    EXPECT_EQ(result, 1);
+    EXPECT_EQ(bd.borders_crossed, false);
+}
+
+// Heap block device reporting every capability, recording where requests land
+class Capable_HeapBlockDevice : public VerifyBorders_HeapBlockDevice {
+public:
+    bd_addr_t trimmed;
+    mutable bd_addr_t checked;
+    uint8_t mapped[DEVICE_SIZE];
+
+    Capable_HeapBlockDevice(bd_size_t size)
+        : VerifyBorders_HeapBlockDevice(size), trimmed(0), checked(0)
+    {
+    }
+
+    virtual int trim(bd_addr_t addr, bd_size_t size)
+    {
+        trimmed = addr;
+        return BD_ERROR_OK;
+    }
+
+    virtual bool is_erased(bd_addr_t addr, bd_size_t size) const
+    {
+        checked = addr;
+        return true;
+    }
+
+    virtual const void *get_mapped_address(bd_addr_t addr, bd_size_t size) const
+    {
+        return mapped + addr;
+    }
+
+    virtual uint32_t get_capabilities() const
+    {
+        return BD_CAPABILITY_MAPPED | BD_CAPABILITY_TRIM | BD_CAPABILITY_ERASE_STATE;
+    }
+};
+
+TEST_F(SlicingBlockModuleTest, capabilities_pass_through)
+{
+    Capable_HeapBlockDevice capable{DEVICE_SIZE};
+    EXPECT_EQ(capable.init(), BD_ERROR_OK);
+    mbed::SlicingBlockDevice slice(&capable, BLOCK_SIZE, BLOCK_SIZE * 3);
+    EXPECT_EQ(slice.init(), BD_ERROR_OK);
+
+    EXPECT_EQ(slice.get_capabilities(), capable.get_capabilities());
+
+    EXPECT_EQ(slice.trim(BLOCK_SIZE, BLOCK_SIZE), BD_ERROR_OK);
+    EXPECT_EQ(capable.trimmed, BLOCK_SIZE * 2);
+
+    EXPECT_TRUE(slice.is_erased(BLOCK_SIZE, BLOCK_SIZE));
+    EXPECT_EQ(capable.checked, BLOCK_SIZE * 2);
+
+    EXPECT_EQ(slice.get_mapped_address(0, BLOCK_SIZE), capable.mapped + BLOCK_SIZE);
+
+    // Regions outside the slice are not passed on
+    EXPECT_EQ(slice.trim(BLOCK_SIZE * 2, BLOCK_SIZE), BD_ERROR_DEVICE_ERROR);
+    EXPECT_FALSE(slice.is_erased(BLOCK_SIZE * 2, BLOCK_SIZE));
+    EXPECT_EQ(slice.get_mapped_address(BLOCK_SIZE * 2, BLOCK_SIZE), nullptr);
+    EXPECT_EQ(capable.borders_crossed, false);
+
+    capable.deinit();
+}
@@ -0,0 +1,107 @@
+/* Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+#include "blockdevice/HeapBlockDevice.h"
+#include "blockdevice/TimingSimBlockDevice.h"
+
+#define PAGE_SIZE (256)
+#define BLOCK_SIZE (4096)
+#define DEVICE_SIZE (BLOCK_SIZE*4)
+
+static const TimingSimBlockDevice::timing_profile_t profile = {
+    10, 1000000,
+    PAGE_SIZE, 500, 2000000,
+    BLOCK_SIZE, 40000,
+    7
+};
+
+class TimingSimBlockModuleTest : public testing::Test {
+protected:
+    HeapBlockDevice heap{DEVICE_SIZE, 1, PAGE_SIZE, BLOCK_SIZE};
+    TimingSimBlockDevice bd{&heap, profile};
+    uint8_t buf[BLOCK_SIZE];
+
+    virtual void SetUp()
+    {
+        ASSERT_EQ(bd.init(), 0);
+        memset(buf, 0xaa, sizeof(buf));
+    }
+
+    virtual void TearDown()
+    {
+        ASSERT_EQ(bd.deinit(), 0);
+    }
+};
+
+TEST_F(TimingSimBlockModuleTest, init)
+{
+    EXPECT_EQ(bd.get_read_size(), 1);
+    EXPECT_EQ(bd.get_program_size(), PAGE_SIZE);
+    EXPECT_EQ(bd.get_erase_size(), BLOCK_SIZE);
+    EXPECT_EQ(bd.size(), DEVICE_SIZE);
+    EXPECT_EQ(bd.get_elapsed_time(), 0);
+    EXPECT_STREQ(bd.get_type(), "HEAP");
+}
+
+TEST_F(TimingSimBlockModuleTest, read)
+{
+    EXPECT_EQ(bd.read(buf, 0, 1000), 0);
+    EXPECT_EQ(bd.get_read_time(), 10 + 1000);
+    EXPECT_EQ(bd.read(buf, 0, 1), 0);
+    EXPECT_EQ(bd.get_read_time(), 10 + 1000 + 10 + 1);
+    EXPECT_EQ(bd.get_elapsed_time(), bd.get_read_time());
+}
+
+TEST_F(TimingSimBlockModuleTest, program)
+{
+    EXPECT_EQ(bd.program(buf, 0, PAGE_SIZE * 2), 0);
+    EXPECT_EQ(bd.get_program_time(), 2 * 500 + 256);
+    bd.reset();
+    EXPECT_EQ(bd.get_program_time(), 0);
+
+    // Pages are counted from the address
+    EXPECT_EQ(bd.program(buf, PAGE_SIZE * 3, PAGE_SIZE), 0);
+    EXPECT_EQ(bd.get_program_time(), 500 + 128);
+}
+
+TEST_F(TimingSimBlockModuleTest, erase_sync)
+{
+    EXPECT_EQ(bd.erase(0, BLOCK_SIZE * 2), 0);
+    EXPECT_EQ(bd.get_erase_time(), 2 * 40000);
+    EXPECT_EQ(bd.sync(), 0);
+    EXPECT_EQ(bd.get_elapsed_time(), 2 * 40000 + 7);
+}
+
+TEST_F(TimingSimBlockModuleTest, failed_operations)
+{
+    EXPECT_NE(bd.read(buf, DEVICE_SIZE, PAGE_SIZE), 0);
+    EXPECT_NE(bd.program(buf, DEVICE_SIZE, PAGE_SIZE), 0);
+    EXPECT_NE(bd.erase(DEVICE_SIZE, BLOCK_SIZE), 0);
+    EXPECT_EQ(bd.get_elapsed_time(), 0);
+}
+
+TEST_F(TimingSimBlockModuleTest, presets)
+{
+    TimingSimBlockDevice nor{&heap, TimingSimBlockDevice::NOR_FLASH};
+    EXPECT_EQ(nor.erase(0, BLOCK_SIZE), 0);
+    EXPECT_EQ(nor.get_erase_time(), TimingSimBlockDevice::NOR_FLASH.erase_block_us);
+
+    // No bandwidth, only the page time
+    TimingSimBlockDevice internal{&heap, TimingSimBlockDevice::INTERNAL_FLASH};
+    EXPECT_EQ(internal.program(buf, 0, PAGE_SIZE), 0);
+    EXPECT_EQ(internal.get_program_time(), (PAGE_SIZE / 8) * TimingSimBlockDevice::INTERNAL_FLASH.program_page_us);
+}
@@ -56,13 +56,29 @@ public:
      *    This is the number of bytes per cluster. A larger cluster size decreases
      *    the overhead of the FAT table, but also increases the minimum file size. The
      *    cluster size must be a multiple of the underlying device's allocation unit
-     *    and is currently limited to a max of 32,768 bytes. If the cluster size is set to zero, a cluster size
+     *    and is limited to a max of 32,768 bytes for FAT, or 32MB for exFAT. If the cluster size is set to zero, a cluster size
      *    is determined from the device's allocation unit. Defaults to zero.
      *
      *  @return         0 on success, negative error code on failure.
      */
     static int format(BlockDevice *bd, bd_size_t cluster_size = 0);
 
+    /** Format a logical drive aligned to the erase blocks of the media.
+     *
+     *  The FAT and the data area start on an erase block boundary, so that
+     *  writing a cluster does not cross erase blocks, such as the allocation
+     *  units of an SD card, usually 4MB on SDXC cards. Volumes from 32GB,
+     *  or with clusters over 64KB, are formatted as exFAT when it is enabled
+     *  with the fat_chan.ff_fs_exfat config.
+     *
+     *  @param bd               Block device to format.
+     *  @param cluster_size     Number of bytes per cluster, as for format(), or zero.
+     *  @param erase_block_size Size in bytes of the erase blocks of the media, a power of
+     *                          two number of sectors up to 32768, or zero if not known.
+     *  @return                 0 on success, negative error code on failure.
+     */
+    static int format(BlockDevice *bd, bd_size_t cluster_size, bd_size_t erase_block_size);
+
     /** Mount a file system to a block device.
      *
      *  @param bd       Block device to mount to.
@@ -231,6 +247,29 @@ protected:
      */
     virtual int file_truncate(mbed::fs_file_t file, off_t length);
 
+    /** Allocate contiguous storage for an empty file.
+     *
+     *  Requires the fat_chan.ff_use_expand option. The file must be open for writing.
+     *
+     *  @param file     File handle.
+     *  @param length   The length to allocate.
+     *
+     *  @return         0 on success, negative error code on failure.
+     */
+    virtual int file_preallocate(mbed::fs_file_t file, off_t length);
+
+    /** Enable or disable the cluster link map table of a file.
+     *
+     *  Requires the fat_chan.ff_use_fastseek option. The table is allocated
+     *  from the heap, sized to the number of fragments of the file.
+     *
+     *  @param file     File handle.
+     *  @param enable   True to build the table, false to release it.
+     *
+     *  @return         0 on success, negative error code on failure.
+     */
+    virtual int file_fast_seek(mbed::fs_file_t file, bool enable);
+
     /** Open a directory on the file system.
      *
      *  @param dir      Destination for the handle to the directory.
@@ -24,6 +24,7 @@
 
 #include <errno.h>
 #include <stdlib.h>
+#include <new>
 
 namespace mbed {
 
@@ -139,6 +140,9 @@ static Deferred<const char *> fat_path_prefix(int id, const char *path)
 static mbed::BlockDevice *_ffs[FF_VOLUMES] = {0};
 static SingletonPtr<PlatformMutex> _ffs_mutex;
 
+// Erase block size in sectors f_mkfs aligns the volume to, set while formatting
+static DWORD _ffs_block_size = 1;
+
 // FAT driver functions
 extern "C" DWORD get_fattime(void)
 {
@@ -254,7 +258,7 @@ extern "C" DRESULT disk_ioctl(BYTE pdrv, BYTE cmd, void *buff)
                 return RES_OK;
             }
         case GET_BLOCK_SIZE:
-            *((DWORD *)buff) = 1; // default when not known
+            *((DWORD *)buff) = _ffs_block_size; // 1 when not known
             return RES_OK;
         case CTRL_TRIM:
             if (_ffs[pdrv] == NULL) {
@@ -344,6 +348,11 @@ int FATFileSystem::unmount()
 /* See http://elm-chan.org/fsw/ff/en/mkfs.html for details of f_mkfs() and
  * associated arguments. */
 int FATFileSystem::format(BlockDevice *bd, bd_size_t cluster_size)
+{
+    return format(bd, cluster_size, 0);
+}
+
+int FATFileSystem::format(BlockDevice *bd, bd_size_t cluster_size, bd_size_t erase_block_size)
 {
     FATFileSystem fs;
     fs.lock();
@@ -408,8 +417,19 @@ int FATFileSystem::format(BlockDevice *bd, bd_size_t cluster_size)
         return err;
     }
 
-    // Logical drive number, Partitioning rule, Allocation unit size (bytes per cluster)
+    // The FAT and the data area start on an erase block, so that no cluster
+    // straddles two, from a power of two number of sectors up to 32768
+    WORD ssize = disk_get_sector_size(fs._id);
+    DWORD block_size = erase_block_size / ssize;
+    if (block_size == 0 || block_size > 32768 || (block_size & (block_size - 1))) {
+        block_size = 1;
+    }
+    _ffs_block_size = block_size;
+
+    // Logical drive number, Partitioning rule, Allocation unit size (bytes per cluster).
+    // FM_ANY picks exFAT, when enabled, for volumes from 32GB or clusters over 64KB
     FRESULT res = f_mkfs(fs._fsid, FM_ANY | FM_SFD, cluster_size, NULL, 0);
+    _ffs_block_size = 1;
     if (res != FR_OK) {
         fs.unmount();
         fs.unlock();
@@ -544,8 +564,8 @@ int FATFileSystem::statvfs(const char *path, struct statvfs *buf)
 
     buf->f_bsize = fs->ssize;
     buf->f_frsize = fs->ssize;
-    buf->f_blocks = (fs->n_fatent - 2) * fs->csize;
-    buf->f_bfree = fre_clust * fs->csize;
+    buf->f_blocks = (fsblkcnt_t)(fs->n_fatent - 2) * fs->csize;
+    buf->f_bfree = (fsblkcnt_t)fre_clust * fs->csize;
     buf->f_bavail = buf->f_bfree;
 #if FF_USE_LFN
     buf->f_namemax = FF_LFN_BUF;
@@ -622,6 +642,9 @@ int FATFileSystem::file_close(fs_file_t file)
     FRESULT res = f_close(fh);
     unlock();
 
+#if FF_USE_FASTSEEK
+    delete[] fh->cltbl;
+#endif
     delete fh;
     return fat_error_remap(res);
 }
@@ -750,6 +773,69 @@ int FATFileSystem::file_truncate(fs_file_t file, off_t length)
     return 0;
 }
 
+int FATFileSystem::file_preallocate(fs_file_t file, off_t length)
+{
+#if FF_USE_EXPAND && !FF_FS_READONLY
+    FIL *fh = static_cast<FIL *>(file);
+
+    lock();
+    FRESULT res = f_expand(fh, length, 1);
+    unlock();
+
+    if (res != FR_OK) {
+        debug_if(FFS_DBG, "f_expand() failed: %d\n", res);
+    }
+
+    return fat_error_remap(res);
+#else
+    return -ENOSYS;
+#endif
+}
+
+int FATFileSystem::file_fast_seek(fs_file_t file, bool enable)
+{
+#if FF_USE_FASTSEEK
+    FIL *fh = static_cast<FIL *>(file);
+
+    lock();
+    delete[] fh->cltbl;
+    fh->cltbl = NULL;
+
+    FRESULT res = FR_OK;
+    if (enable) {
+        // A contiguous file needs 4 entries, FatFs reports the size a
+        // fragmented file needs if the table is too small
+        DWORD entries = 4;
+        do {
+            fh->cltbl = new (std::nothrow) DWORD[entries];
+            if (!fh->cltbl) {
+                res = FR_NOT_ENOUGH_CORE;
+                break;
+            }
+
+            fh->cltbl[0] = entries;
+            res = f_lseek(fh, CREATE_LINKMAP);
+            if (res == FR_NOT_ENOUGH_CORE) {
+                entries = fh->cltbl[0];
+                delete[] fh->cltbl;
+                fh->cltbl = NULL;
+            }
+        } while (res == FR_NOT_ENOUGH_CORE);
+
+        if (res != FR_OK) {
+            debug_if(FFS_DBG, "Creating cluster link map failed: %d\n", res);
+            delete[] fh->cltbl;
+            fh->cltbl = NULL;
+        }
+    }
+    unlock();
+
+    return fat_error_remap(res);
+#else
+    return -ENOSYS;
+#endif
+}
+
 
 ////// Dir operations //////
 int FATFileSystem::dir_open(fs_dir_t *dir, const char *path)
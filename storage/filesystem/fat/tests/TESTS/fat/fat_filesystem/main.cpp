@@ -107,6 +107,58 @@ void test_read_write()
 }
 
 
+// Test contiguous preallocation and fast seek
+void test_preallocate_fast_seek()
+{
+    TEST_SKIP_UNLESS_MESSAGE(bd, "Not enough heap memory to run test. Test skipped.");
+
+    FATFileSystem fs("fat");
+
+    int err = fs.mount(bd);
+    TEST_ASSERT_EQUAL(0, err);
+
+    File file;
+    err = file.open(&fs, "test_fast_seek.dat", O_RDWR | O_CREAT);
+    TEST_ASSERT_EQUAL(0, err);
+
+    err = file.preallocate(8 * BLOCK_SIZE);
+    if (err == -ENOSYS) {
+        file.close();
+        fs.unmount();
+        TEST_IGNORE_MESSAGE("fat_chan.ff_use_expand not enabled. Test skipped.");
+    }
+    TEST_ASSERT_EQUAL(0, err);
+    TEST_ASSERT_EQUAL(8 * BLOCK_SIZE, file.size());
+
+    uint8_t buffer[BLOCK_SIZE / 4];
+    for (int i = 0; i < 8; i++) {
+        memset(buffer, i, sizeof(buffer));
+        TEST_ASSERT_EQUAL(i * BLOCK_SIZE, file.seek(i * BLOCK_SIZE, SEEK_SET));
+        TEST_ASSERT_EQUAL(sizeof(buffer), file.write(buffer, sizeof(buffer)));
+    }
+
+    err = file.fast_seek(true);
+    if (err != -ENOSYS) {
+        TEST_ASSERT_EQUAL(0, err);
+    }
+
+    // Seek backwards through the file, served from the link map when fast seek is enabled
+    for (int i = 7; i >= 0; i--) {
+        TEST_ASSERT_EQUAL(i * BLOCK_SIZE, file.seek(i * BLOCK_SIZE, SEEK_SET));
+        TEST_ASSERT_EQUAL(sizeof(buffer), file.read(buffer, sizeof(buffer)));
+        for (size_t j = 0; j < sizeof(buffer); j++) {
+            TEST_ASSERT_EQUAL(i, buffer[j]);
+        }
+    }
+
+    err = file.close();
+    TEST_ASSERT_EQUAL(0, err);
+
+    err = fs.unmount();
+    TEST_ASSERT_EQUAL(0, err);
+}
+
+
 // Simple test for iterating dir entries
 void test_read_dir()
 {
@@ -173,6 +225,42 @@ void test_read_dir()
     bd = 0;
 }
 
+// Test formatting aligned to erase blocks
+void test_format_aligned()
+{
+    const int erase_block_sectors = 8;
+
+    HeapBlockDevice *heap_bd = new (std::nothrow) HeapBlockDevice(BLOCK_COUNT * BLOCK_SIZE, BLOCK_SIZE);
+    TEST_SKIP_UNLESS_MESSAGE(heap_bd, "Not enough heap memory to run test. Test skipped.");
+
+    int err = FATFileSystem::format(heap_bd, 0, erase_block_sectors * BLOCK_SIZE);
+    TEST_ASSERT_EQUAL(0, err);
+
+    // The data area follows the reserved sectors, the FATs and the root directory
+    uint8_t sector[BLOCK_SIZE];
+    err = heap_bd->init();
+    TEST_ASSERT_EQUAL(0, err);
+    err = heap_bd->read(sector, 0, BLOCK_SIZE);
+    TEST_ASSERT_EQUAL(0, err);
+    err = heap_bd->deinit();
+    TEST_ASSERT_EQUAL(0, err);
+
+    uint32_t reserved = sector[14] | (sector[15] << 8);
+    uint32_t fats = sector[16];
+    uint32_t root_entries = sector[17] | (sector[18] << 8);
+    uint32_t fat_size = sector[22] | (sector[23] << 8);
+    uint32_t data_start = reserved + fats * fat_size + root_entries * 32 / BLOCK_SIZE;
+    TEST_ASSERT_EQUAL(0, data_start % erase_block_sectors);
+
+    FATFileSystem fs("fat");
+    err = fs.mount(heap_bd);
+    TEST_ASSERT_EQUAL(0, err);
+    err = fs.unmount();
+    TEST_ASSERT_EQUAL(0, err);
+
+    delete heap_bd;
+}
+
 
 // Test setup
 utest::v1::status_t test_setup(const size_t number_of_cases)
@@ -185,7 +273,9 @@ Case cases[] = {
     Case("Testing formating", test_format),
     Case("Testing read write < block", test_read_write < BLOCK_SIZE / 2 >),
     Case("Testing read write > block", test_read_write<2 * BLOCK_SIZE>),
+    Case("Testing preallocate and fast seek", test_preallocate_fast_seek),
     Case("Testing dir iteration", test_read_dir),
+    Case("Testing aligned formating", test_format_aligned),
 };
 
 Specification specification(test_setup, cases);
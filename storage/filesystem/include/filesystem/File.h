@@ -86,6 +86,25 @@ public:
      */
     virtual ssize_t write(const void *buffer, size_t size);
 
+    /** Read the contents of a file into several buffers
+     *
+     *  @param iov      The buffers to read in to
+     *  @param iovcnt   The number of buffers
+     *  @return         The number of bytes read, 0 at end of file, negative error on failure
+     */
+    virtual ssize_t readv(const struct iovec *iov, int iovcnt);
+
+    /** Write the contents of several buffers to a file
+     *
+     *  The buffers are passed to the file system in one call, so they are
+     *  written under a single lock.
+     *
+     *  @param iov      The buffers to write from
+     *  @param iovcnt   The number of buffers
+     *  @return         The number of bytes written, negative error on failure
+     */
+    virtual ssize_t writev(const struct iovec *iov, int iovcnt);
+
     /** Flush any buffers associated with the file
      *
      *  @return         0 on success, negative error code on failure
@@ -139,6 +158,49 @@ public:
      */
     virtual int truncate(off_t length);
 
+    /** Allocate contiguous storage for an empty file.
+     *
+     * The file's length is set to the specified value, so sequential writes
+     * of up to that size don't need any further allocation. The contents of
+     * the allocated area are undefined until written; truncate the file if
+     * less data ends up being written.
+     *
+     *  @param length   The length to allocate
+     *
+     *  @return         Zero on success, -ENOSYS if not supported by the file system,
+     *                  or other negative error code on failure
+     */
+    virtual int preallocate(off_t length);
+
+    /** Enable or disable constant time seeks.
+     *
+     * When enabled, the file system indexes the file's storage so that seeks
+     * don't have to walk the allocation chain. The file can't grow while
+     * the index is in use.
+     *
+     *  @param enable   True to enable fast seeks, false to disable them
+     *
+     *  @return         Zero on success, -ENOSYS if not supported by the file system,
+     *                  or other negative error code on failure
+     */
+    virtual int fast_seek(bool enable);
+
+    /** Get a pointer to the contents of the file in memory.
+     *
+     * File systems whose storage is memory mapped, such as a read-only image
+     * in internal flash or QSPI XIP, can return a pointer to the data instead
+     * of copying it with read. The pointer stays valid while the file system
+     * is mounted.
+     *
+     *  @param offset   Offset of the region in the file
+     *  @param size     Size of the region in bytes
+     *  @param ptr      Destination for the pointer to the region
+     *
+     *  @return         Zero on success, -ENOSYS if not supported by the file system
+     *                  or its storage, or other negative error code on failure
+     */
+    virtual int mmap(off_t offset, size_t size, const void **ptr);
+
 private:
     FileSystem *_fs;
     fs_file_t _file;
@@ -173,6 +173,28 @@ protected:
      */
     virtual ssize_t file_write(fs_file_t file, const void *buffer, size_t size) = 0;
 
+    /** Read the contents of a file into several buffers.
+     *
+     *  The default implementation calls file_read for each buffer in turn.
+     *
+     *  @param file     File handle.
+     *  @param iov      The buffers to read in to.
+     *  @param iovcnt   The number of buffers.
+     *  @return         The number of bytes read, 0 at end of file, negative error on failure.
+     */
+    virtual ssize_t file_readv(fs_file_t file, const struct iovec *iov, int iovcnt);
+
+    /** Write the contents of several buffers to a file.
+     *
+     *  The default implementation calls file_write for each buffer in turn.
+     *
+     *  @param file     File handle.
+     *  @param iov      The buffers to write from.
+     *  @param iovcnt   The number of buffers.
+     *  @return         The number of bytes written, negative error on failure.
+     */
+    virtual ssize_t file_writev(fs_file_t file, const struct iovec *iov, int iovcnt);
+
     /** Flush any buffers associated with the file.
      *
      *  @param file     File handle.
@@ -234,6 +256,38 @@ protected:
      */
     virtual int file_truncate(fs_file_t file, off_t length);
 
+    /** Allocate contiguous storage for an empty file.
+     *
+     *  The file's length is set to the specified value and the contents of
+     *  the allocated area are undefined until written.
+     *
+     *  @param file     File handle.
+     *  @param length   The length to allocate.
+     *
+     *  @return         0 on success, negative error code on failure.
+     */
+    virtual int file_preallocate(fs_file_t file, off_t length);
+
+    /** Enable or disable indexing of a file's storage for constant time seeks.
+     *
+     *  @param file     File handle.
+     *  @param enable   True to build the index, false to release it.
+     *
+     *  @return         0 on success, negative error code on failure.
+     */
+    virtual int file_fast_seek(fs_file_t file, bool enable);
+
+    /** Get a pointer to the contents of a file in memory mapped storage.
+     *
+     *  @param file     File handle.
+     *  @param offset   Offset of the region in the file.
+     *  @param size     Size of the region in bytes.
+     *  @param ptr      Destination for the pointer to the region.
+     *
+     *  @return         0 on success, negative error code on failure.
+     */
+    virtual int file_mmap(fs_file_t file, off_t offset, size_t size, const void **ptr);
+
     /** Open a directory on the file system.
      *
      *  @param dir      Destination for the handle to the directory.
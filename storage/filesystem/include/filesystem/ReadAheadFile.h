@@ -0,0 +1,223 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef READ_AHEAD_FILE_H
+#define READ_AHEAD_FILE_H
+
+#include "filesystem/File.h"
+
+#if MBED_CONF_RTOS_PRESENT || defined(DOXYGEN_ONLY)
+
+#include "rtos/Thread.h"
+#include "rtos/Mutex.h"
+#include "rtos/ConditionVariable.h"
+
+/** Size of each block fetched ahead of the reader */
+#ifndef MBED_CONF_READ_AHEAD_FILE_BLOCK_SIZE
+#define MBED_CONF_READ_AHEAD_FILE_BLOCK_SIZE 512
+#endif
+
+/** Number of blocks buffered ahead of the reader */
+#ifndef MBED_CONF_READ_AHEAD_FILE_BLOCK_COUNT
+#define MBED_CONF_READ_AHEAD_FILE_BLOCK_COUNT 4
+#endif
+
+/** Number of back-to-back sequential reads before prefetching starts */
+#ifndef MBED_CONF_READ_AHEAD_FILE_TRIGGER
+#define MBED_CONF_READ_AHEAD_FILE_TRIGGER 2
+#endif
+
+/** Stack size of the prefetch thread */
+#ifndef MBED_CONF_READ_AHEAD_FILE_THREAD_STACK_SIZE
+#define MBED_CONF_READ_AHEAD_FILE_THREAD_STACK_SIZE 1024
+#endif
+
+namespace mbed {
+/** \addtogroup filesystem */
+/** @{*/
+
+
+/** File with sequential read-ahead
+ *
+ *  Once a file is being read sequentially, a worker thread fetches the
+ *  following blocks into a buffer, so reads are served from memory while
+ *  the file system is busy with the next block. Any seek to another position,
+ *  write or truncate drops the buffered data and prefetching restarts only
+ *  when the reads become sequential again.
+ *
+ *  Works with any FileSystem, as the underlying file is only accessed
+ *  through the regular File interface.
+ */
+class ReadAheadFile : public File {
+public:
+    /** Create an uninitialized file
+     *
+     *  Must call open to initialize the file on a file system
+     *
+     *  @param block_size   Size of each block fetched ahead
+     *  @param block_count  Number of blocks buffered ahead
+     *  @param priority     Priority of the prefetch thread
+     *  @param stack_size   Stack size of the prefetch thread
+     */
+    ReadAheadFile(size_t block_size = MBED_CONF_READ_AHEAD_FILE_BLOCK_SIZE,
+                  size_t block_count = MBED_CONF_READ_AHEAD_FILE_BLOCK_COUNT,
+                  osPriority priority = osPriorityAboveNormal,
+                  uint32_t stack_size = MBED_CONF_READ_AHEAD_FILE_THREAD_STACK_SIZE);
+
+    /** Destroy a file
+     *
+     *  Closes file if the file is still open
+     */
+    virtual ~ReadAheadFile();
+
+    /** Open a file on the filesystem and start the prefetch thread
+     *
+     *  @param fs       Filesystem as target for the file
+     *  @param path     The name of the file to open
+     *  @param flags    The flags to open the file in, one of O_RDONLY, O_WRONLY, O_RDWR,
+     *                  bitwise or'd with one of O_CREAT, O_TRUNC, O_APPEND
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual int open(FileSystem *fs, const char *path, int flags = O_RDONLY);
+
+    /** Stop the prefetch thread and close the file
+     *
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual int close();
+
+    /** Read the contents of a file into a buffer
+     *
+     *  @param buffer   The buffer to read in to
+     *  @param size     The number of bytes to read
+     *  @return         The number of bytes read, 0 at end of file, negative error on failure
+     */
+    virtual ssize_t read(void *buffer, size_t size);
+
+    /** Write the contents of a buffer to a file
+     *
+     *  @param buffer   The buffer to write from
+     *  @param size     The number of bytes to write
+     *  @return         The number of bytes written, negative error on failure
+     */
+    virtual ssize_t write(const void *buffer, size_t size);
+
+    /** Flush any buffers associated with the file
+     *
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual int sync();
+
+    /** Set the file position indicator
+     *
+     *  Seeking inside the data already fetched keeps it buffered.
+     *
+     *  @param offset   The offset from whence to move to
+     *  @param whence   The start of where to seek
+     *      SEEK_SET to start from beginning of file,
+     *      SEEK_CUR to start from current position in file,
+     *      SEEK_END to start from end of file
+     *  @return         The new offset of the file, negative error code on failure
+     */
+    virtual off_t seek(off_t offset, int whence = SEEK_SET);
+
+    /** Get the file position indicator
+     *
+     *  @return         The current offset in the file
+     */
+    virtual off_t tell();
+
+    /** Rewind the file position indicator to the beginning of the file
+     */
+    virtual void rewind();
+
+    /** Get the size of the file
+     *
+     *  @return         Size of the file in bytes
+     */
+    virtual off_t size();
+
+    /** Truncate or extend a file
+     *
+     *  @param length   The requested new length for the file
+     *  @return         Zero on success, negative error code on failure
+     */
+    virtual int truncate(off_t length);
+
+    /** Allocate contiguous storage for an empty file
+     *
+     *  @param length   The length to allocate
+     *  @return         Zero on success, -ENOSYS if not supported by the file system,
+     *                  or other negative error code on failure
+     */
+    virtual int preallocate(off_t length);
+
+    /** Enable or disable constant time seeks
+     *
+     *  @param enable   True to enable fast seeks, false to disable them
+     *  @return         Zero on success, -ENOSYS if not supported by the file system,
+     *                  or other negative error code on failure
+     */
+    virtual int fast_seek(bool enable);
+
+private:
+    // Drop buffered data and stop prefetching, called with _mutex held
+    void flush_ahead();
+
+    // Copy buffered data out, called with _mutex held
+    size_t read_ahead(uint8_t *buffer, size_t size);
+
+    // Position the underlying file at the reader's offset, called with _io_mutex held
+    int sync_position();
+
+    void worker();
+
+    // Protects the buffer state below
+    rtos::Mutex _mutex;
+    rtos::ConditionVariable _cond;
+    // Serializes access to the underlying file
+    rtos::Mutex _io_mutex;
+    rtos::Thread *_thread;
+
+    const size_t _block_size;
+    const size_t _block_count;
+    osPriority _priority;
+    uint32_t _stack_size;
+
+    uint8_t *_buffer;
+    size_t *_lengths;
+
+    off_t _pos;
+    off_t _fetch_pos;
+    uint32_t _generation;
+    size_t _head;
+    size_t _head_offset;
+    size_t _filled;
+    int _sequential;
+    int _err;
+    bool _streaming;
+    bool _eof;
+    bool _exit;
+};
+
+
+/** @}*/
+} // namespace mbed
+
+#endif // MBED_CONF_RTOS_PRESENT || defined(DOXYGEN_ONLY)
+
+#endif
@@ -24,6 +24,7 @@
 #include "FileSystem.h"
 #include "BlockDevice.h"
 #include "PlatformMutex.h"
+#include "Callback.h"
 #include "lfs2.h"
 
 namespace mbed {
@@ -35,6 +36,81 @@ namespace mbed {
  */
 class LittleFileSystem2 : public mbed::FileSystem {
 public:
+    /** Tuning of a single LittleFileSystem2 instance
+     *
+     *  Defaults to the values from the configuration system, so only the
+     *  fields that differ between mounts need to be set.
+     */
+    struct mount_config {
+        /** Size of a logical block, see the constructor */
+        lfs2_size_t block_size = MBED_LFS2_BLOCK_SIZE;
+        /** Number of erase cycles before a block is forcefully evicted, see the constructor */
+        uint32_t block_cycles = MBED_LFS2_BLOCK_CYCLES;
+        /** Size of read/program caches, see the constructor */
+        lfs2_size_t cache_size = MBED_LFS2_CACHE_SIZE;
+        /** Size of the lookahead buffer, see the constructor */
+        lfs2_size_t lookahead_size = MBED_LFS2_LOOKAHEAD_SIZE;
+        /** Optional 32-bit aligned buffer holding the lookahead buffer and the
+         *  read and program caches, so that mounting doesn't allocate them from
+         *  the heap. Must be at least lookahead + 2 * cache bytes after the sizes
+         *  are adjusted to the block device. Per-file caches are still allocated.
+         */
+        void *buffer = NULL;
+        /** Size of buffer in bytes */
+        lfs2_size_t buffer_size = 0;
+        /** Number of free blocks pre_erase() keeps erased ahead of the allocator,
+         *  so that writes don't wait for erases. 0 disables the pool.
+         */
+        lfs2_size_t erased_pool_size = 0;
+        /** Count the erases of each block since mount, see get_erase_histogram() */
+        bool erase_stats = false;
+        /** Number of paths whose stat() result, including their absence, is
+         *  kept in RAM until the next change to the file system. Also lets
+         *  opening a missing file fail without reading the storage. Paths of
+         *  cache_path_size or more characters are not cached. 0 disables the cache.
+         */
+        lfs2_size_t stat_cache_entries = 0;
+        /** Bytes of RAM holding the listing of the last directory read to its
+         *  end, until the next change to the file system. Later reads of that
+         *  directory and stat() of its entries are answered from it. Each entry
+         *  takes 6 bytes plus its name. 0 disables the cache.
+         */
+        lfs2_size_t dir_cache_size = 0;
+    };
+
+    /** Space usage of a mounted file system
+     */
+    struct usage_stats {
+        lfs2_size_t block_size;     /*!< size of a logical block in bytes */
+        lfs2_size_t block_count;    /*!< number of logical blocks on the block device */
+        lfs2_size_t blocks_used;    /*!< number of blocks in use, may overestimate because of shared blocks */
+        lfs2_size_t cache_size;     /*!< size of each read/program/file cache in bytes */
+        lfs2_size_t lookahead_size; /*!< size of the lookahead buffer in bytes */
+    };
+
+    /** Erase activity since mount, tracked if erased_pool_size or erase_stats is set
+     */
+    struct wear_stats {
+        uint64_t erases;            /*!< number of blocks erased, including by pre_erase() */
+        uint64_t erases_avoided;    /*!< number of erases skipped as the block was in the erased pool */
+        uint32_t min_erases;        /*!< lowest erase count of a block, if erase_stats is set */
+        uint32_t max_erases;        /*!< highest erase count of a block, if erase_stats is set */
+        lfs2_size_t erased_blocks;  /*!< number of blocks currently in the erased pool */
+    };
+
+    /** Activity of the metadata caches since mount, see stat_cache_entries and dir_cache_size
+     */
+    struct cache_stats {
+        uint32_t stat_hits;         /*!< number of stat() calls, and opens that failed, answered from RAM */
+        uint32_t stat_misses;       /*!< number of stat() calls that read the storage */
+        uint32_t dir_hits;          /*!< number of directories opened from the listing cache */
+        uint32_t dir_misses;        /*!< number of directories opened from the storage */
+        uint32_t invalidations;     /*!< number of changes to the file system that emptied the caches */
+    };
+
+    /** Longest path kept by the metadata caches, including the terminating null */
+    static const size_t cache_path_size = 64;
+
     /** Lifetime of the LittleFileSystem2
      *
      *  @param name     Name of the file system in the tree.
@@ -64,6 +140,14 @@ public:
                       lfs2_size_t cache_size = MBED_LFS2_CACHE_SIZE,
                       lfs2_size_t lookahead = MBED_LFS2_LOOKAHEAD_SIZE);
 
+    /** Lifetime of the LittleFileSystem2
+     *
+     *  @param name     Name of the file system in the tree.
+     *  @param bd       Block device to mount. Mounted immediately if not NULL.
+     *  @param config   Cache, lookahead and wear-leveling tuning of this instance.
+     */
+    LittleFileSystem2(const char *name, mbed::BlockDevice *bd, const mount_config &config);
+
     virtual ~LittleFileSystem2();
 
     /** Format a block device with the LittleFileSystem2.
@@ -96,6 +180,14 @@ public:
                       lfs2_size_t cache_size = MBED_LFS2_CACHE_SIZE,
                       lfs2_size_t lookahead_size = MBED_LFS2_LOOKAHEAD_SIZE);
 
+    /** Format a block device with the LittleFileSystem2.
+     *
+     *  @param bd       This is the block device that will be formatted.
+     *  @param config   Tuning to format with, see mount_config.
+     *  @return         0 on success, negative error code on failure
+     */
+    static int format(mbed::BlockDevice *bd, const mount_config &config);
+
     /** Mount a file system to a block device.
      *
      *  @param bd       Block device to mount to.
@@ -103,6 +195,16 @@ public:
      */
     virtual int mount(mbed::BlockDevice *bd);
 
+    /** Mount a file system to a block device with new tuning.
+     *
+     *  The configuration is kept for later mounts and reformats.
+     *
+     *  @param bd       Block device to mount to.
+     *  @param config   Cache, lookahead and wear-leveling tuning of this instance.
+     *  @return         0 on success, negative error code on failure.
+     */
+    int mount(mbed::BlockDevice *bd, const mount_config &config);
+
     /** Unmount a file system from the underlying block device.
      *
      *  @return         0 on success, negative error code on failure
@@ -160,6 +262,66 @@ public:
      */
     virtual int statvfs(const char *path, struct statvfs *buf);
 
+    /** Get the space usage and buffer sizes of the mounted file system.
+     *
+     *  @param stats    The structure to fill in.
+     *  @return         0 on success, negative error code on failure
+     */
+    int get_usage(usage_stats *stats);
+
+    /** Call a function for every block in use by the mounted file system.
+     *
+     *  Blocks may be reported more than once. The file system is locked
+     *  during the traversal, so the callback must not access it.
+     *
+     *  @param cb       Function called with each block, a non-zero return stops the traversal.
+     *  @return         0 on success, the value returned by cb, or negative error code on failure
+     */
+    int traverse(mbed::Callback<int(lfs2_block_t)> cb);
+
+    /** Erase free blocks ahead of the allocator into the erased pool.
+     *
+     *  Meant to be called when the system is idle, for instance from a low
+     *  priority thread or event queue. Later erases of these blocks by the
+     *  file system are skipped, until they are programmed. The pool is
+     *  forgotten on unmount, as erased blocks can't be told apart on all
+     *  block devices.
+     *
+     *  @param max_erases  Most blocks to erase in this call, bounding its duration.
+     *  @return            Number of blocks erased, 0 once the pool is full or if
+     *                     erased_pool_size is 0, or negative error code on failure
+     */
+    int pre_erase(lfs2_size_t max_erases = 1);
+
+    /** Get the erase activity since mount.
+     *
+     *  @param stats    The structure to fill in.
+     *  @return         0 on success, -ENOTSUP if erases are not tracked,
+     *                  or negative error code on failure
+     */
+    int get_wear_stats(wear_stats *stats);
+
+    /** Get a histogram of the erase count of the blocks since mount.
+     *
+     *  Block erase counts from 0 to bin_width - 1 go to bins[0], and so on.
+     *  The last bin also holds all higher counts.
+     *
+     *  @param bins       Array of bin_count bins to fill in.
+     *  @param bin_count  Number of bins.
+     *  @param bin_width  Number of erase counts per bin.
+     *  @return           0 on success, -ENOTSUP if erase_stats is not set,
+     *                    or negative error code on failure
+     */
+    int get_erase_histogram(lfs2_size_t *bins, size_t bin_count, uint32_t bin_width = 1);
+
+    /** Get the activity of the metadata caches since mount.
+     *
+     *  @param stats    The structure to fill in.
+     *  @return         0 on success, -ENOTSUP if neither cache is enabled,
+     *                  or negative error code on failure
+     */
+    int get_cache_stats(cache_stats *stats);
+
 protected:
 #if !(DOXYGEN_ONLY)
     /** Open a file on the file system.
@@ -197,6 +359,15 @@ protected:
      */
     virtual ssize_t file_write(mbed::fs_file_t file, const void *buffer, size_t size);
 
+    /** Write the contents of several buffers to a file
+     *
+     *  @param file     File handle.
+     *  @param iov      The buffers to write from.
+     *  @param iovcnt   The number of buffers.
+     *  @return         The number of bytes written, negative error on failure
+     */
+    virtual ssize_t file_writev(mbed::fs_file_t file, const struct iovec *iov, int iovcnt);
+
     /** Flush any buffers associated with the file
      *
      *  @param file     File handle.
@@ -289,10 +460,52 @@ protected:
 #endif //!(DOXYGEN_ONLY)
 
 private:
+    // Block device operations, when tracking erases
+    static int _tracked_read(const struct lfs2_config *c, lfs2_block_t block,
+                             lfs2_off_t off, void *buffer, lfs2_size_t size);
+    static int _tracked_prog(const struct lfs2_config *c, lfs2_block_t block,
+                             lfs2_off_t off, const void *buffer, lfs2_size_t size);
+    static int _tracked_erase(const struct lfs2_config *c, lfs2_block_t block);
+    static int _tracked_sync(const struct lfs2_config *c);
+
+    int _setup_tracking();
+    void _free_tracking();
+
+    // Metadata caches, see mount_config
+    struct stat_cache_entry;
+    struct dir_handle;
+
+    int _setup_caches();
+    void _free_caches();
+    void _invalidate_caches();
+    bool _cached_stat(const char *path, struct lfs2_info *info, int *err);
+    void _cache_stat(const char *path, int err, const struct lfs2_info *info);
+    void _dir_cache_append(const struct lfs2_info *info);
+
     lfs2_t _lfs; // The actual file system
     struct lfs2_config _config;
+    mount_config _mount_config; // Tuning as requested, before adjusting to the block device
     mbed::BlockDevice *_bd; // The block device
 
+    // Erase tracking, see mount_config
+    uint32_t *_erased; // Bitmap of the blocks erased and not programmed since, NULL without a pool
+    uint32_t *_erase_counts; // Erases per block, NULL without erase_stats
+    lfs2_size_t _erased_blocks;
+    uint64_t _erases;
+    uint64_t _erases_avoided;
+
+    // Metadata caches, see mount_config. A listing being replayed by an open
+    // directory is left untouched until that directory is closed
+    stat_cache_entry *_stat_cache; // NULL without a stat cache
+    uint32_t _stat_cache_clock; // Stamp of the latest use, for evicting the least recently used entry
+    uint8_t *_dir_cache; // Listing records, NULL without a directory cache
+    lfs2_size_t _dir_cache_used;
+    char _dir_cache_path[cache_path_size];
+    bool _dir_cache_valid;
+    dir_handle *_dir_cache_filler; // Directory recording its entries into the listing, if any
+    uint32_t _dir_cache_readers; // Directories replaying the listing
+    cache_stats _cache_stats;
+
     // thread-safe locking
     PlatformMutex _mutex;
 };
@@ -20,6 +20,7 @@
 #include "lfs2.h"
 #include "lfs2_util.h"
 #include "MbedCRC.h"
+#include <new>
 
 namespace mbed {
 
@@ -140,6 +141,313 @@ static int lfs2_bd_sync(const struct lfs2_config *c)
     return bd->sync();
 }
 
+// Fill in the littlefs configuration for a block device, placing the lookahead
+// buffer and the read/program caches in the caller's buffer if there is one
+static int lfs2_setup_config(struct lfs2_config *cfg, BlockDevice *bd,
+                             const LittleFileSystem2::mount_config &config)
+{
+    memset(cfg, 0, sizeof(*cfg));
+    cfg->context         = bd;
+    cfg->read            = lfs2_bd_read;
+    cfg->prog            = lfs2_bd_prog;
+    cfg->erase           = lfs2_bd_erase;
+    cfg->sync            = lfs2_bd_sync;
+    cfg->read_size       = bd->get_read_size();
+    cfg->prog_size       = bd->get_program_size();
+    cfg->block_size      = lfs2_max(config.block_size, (lfs2_size_t)bd->get_erase_size());
+    cfg->block_count     = bd->size() / cfg->block_size;
+    cfg->block_cycles    = config.block_cycles;
+    cfg->cache_size      = lfs2_max(config.cache_size, cfg->prog_size);
+    cfg->lookahead_size  = lfs2_min(config.lookahead_size, 8 * ((cfg->block_count + 63) / 64));
+
+    if (config.buffer) {
+        // The lookahead buffer goes first as it needs 32-bit alignment
+        if (((uintptr_t)config.buffer % 4) != 0 ||
+                config.buffer_size < cfg->lookahead_size + 2 * cfg->cache_size) {
+            return -EINVAL;
+        }
+
+        uint8_t *buffer = static_cast<uint8_t *>(config.buffer);
+        cfg->lookahead_buffer = buffer;
+        cfg->read_buffer = buffer + cfg->lookahead_size;
+        cfg->prog_buffer = buffer + cfg->lookahead_size + cfg->cache_size;
+    }
+
+    return 0;
+}
+
+static int lfs2_traverse_cb(void *data, lfs2_block_t block)
+{
+    return (*static_cast<mbed::Callback<int(lfs2_block_t)> *>(data))(block);
+}
+
+static int lfs2_mark_block_cb(void *data, lfs2_block_t block)
+{
+    uint32_t *bitmap = static_cast<uint32_t *>(data);
+    bitmap[block / 32] |= 1U << (block % 32);
+    return 0;
+}
+
+static inline bool lfs2_test_block(const uint32_t *bitmap, lfs2_block_t block)
+{
+    return bitmap[block / 32] & (1U << (block % 32));
+}
+
+// Records of the listing cache: type, size, then the null terminated name
+static const lfs2_size_t LFS2_RECORD_HEADER = 1 + sizeof(lfs2_size_t);
+
+static const uint8_t *lfs2_next_record(const uint8_t *record)
+{
+    return record + LFS2_RECORD_HEADER + strlen((const char *)record + LFS2_RECORD_HEADER) + 1;
+}
+
+static const uint8_t *lfs2_read_record(const uint8_t *record, struct lfs2_info *info)
+{
+    info->type = record[0];
+    memcpy(&info->size, record + 1, sizeof(info->size));
+    strcpy(info->name, (const char *)record + LFS2_RECORD_HEADER);
+    return lfs2_next_record(record);
+}
+
+
+////// Block device operations, when tracking erases //////
+int LittleFileSystem2::_tracked_read(const struct lfs2_config *c, lfs2_block_t block,
+                                     lfs2_off_t off, void *buffer, lfs2_size_t size)
+{
+    LittleFileSystem2 *fs = (LittleFileSystem2 *)c->context;
+    return fs->_bd->read(buffer, (bd_addr_t)block * c->block_size + off, size);
+}
+
+int LittleFileSystem2::_tracked_prog(const struct lfs2_config *c, lfs2_block_t block,
+                                     lfs2_off_t off, const void *buffer, lfs2_size_t size)
+{
+    LittleFileSystem2 *fs = (LittleFileSystem2 *)c->context;
+    if (fs->_erased && lfs2_test_block(fs->_erased, block)) {
+        fs->_erased[block / 32] &= ~(1U << (block % 32));
+        fs->_erased_blocks--;
+    }
+    return fs->_bd->program(buffer, (bd_addr_t)block * c->block_size + off, size);
+}
+
+int LittleFileSystem2::_tracked_erase(const struct lfs2_config *c, lfs2_block_t block)
+{
+    LittleFileSystem2 *fs = (LittleFileSystem2 *)c->context;
+    if (fs->_erased && lfs2_test_block(fs->_erased, block)) {
+        // Still erased since pre_erase(), only the first program takes it out of the pool
+        fs->_erased[block / 32] &= ~(1U << (block % 32));
+        fs->_erased_blocks--;
+        fs->_erases_avoided++;
+        return 0;
+    }
+
+    int err = fs->_bd->erase((bd_addr_t)block * c->block_size, c->block_size);
+    if (!err) {
+        fs->_erases++;
+        if (fs->_erase_counts) {
+            fs->_erase_counts[block]++;
+        }
+    }
+    return err;
+}
+
+int LittleFileSystem2::_tracked_sync(const struct lfs2_config *c)
+{
+    LittleFileSystem2 *fs = (LittleFileSystem2 *)c->context;
+    return fs->_bd->sync();
+}
+
+// Switch the block device operations to the tracked ones if the mount config asks for it
+int LittleFileSystem2::_setup_tracking()
+{
+    _erased_blocks = 0;
+    _erases = 0;
+    _erases_avoided = 0;
+
+    if (!_mount_config.erased_pool_size && !_mount_config.erase_stats) {
+        return 0;
+    }
+
+    if (_mount_config.erased_pool_size) {
+        _erased = new (std::nothrow) uint32_t[(_config.block_count + 31) / 32]();
+        if (!_erased) {
+            return -ENOMEM;
+        }
+    }
+
+    if (_mount_config.erase_stats) {
+        _erase_counts = new (std::nothrow) uint32_t[_config.block_count]();
+        if (!_erase_counts) {
+            _free_tracking();
+            return -ENOMEM;
+        }
+    }
+
+    _config.context = this;
+    _config.read = _tracked_read;
+    _config.prog = _tracked_prog;
+    _config.erase = _tracked_erase;
+    _config.sync = _tracked_sync;
+    return 0;
+}
+
+void LittleFileSystem2::_free_tracking()
+{
+    delete[] _erased;
+    _erased = NULL;
+    delete[] _erase_counts;
+    _erase_counts = NULL;
+    _erased_blocks = 0;
+}
+
+
+////// Metadata caches //////
+struct LittleFileSystem2::stat_cache_entry {
+    char path[cache_path_size]; // Empty when unused
+    uint32_t used;              // _stat_cache_clock at the latest use
+    lfs2_size_t size;
+    int err;                    // 0, or -ENOENT if the path doesn't exist
+    uint8_t type;
+};
+
+struct LittleFileSystem2::dir_handle {
+    lfs2_dir_t dir;             // Unused when replaying the listing cache
+    bool cached;
+    const uint8_t *record;      // Next record of the listing cache
+    lfs2_soff_t pos;            // Position in the listing cache, as lfs2_dir_tell counts
+};
+
+int LittleFileSystem2::_setup_caches()
+{
+    memset(&_cache_stats, 0, sizeof(_cache_stats));
+    _stat_cache_clock = 0;
+    _dir_cache_used = 0;
+    _dir_cache_valid = false;
+    _dir_cache_filler = NULL;
+    _dir_cache_readers = 0;
+
+    if (_mount_config.stat_cache_entries) {
+        _stat_cache = new (std::nothrow) stat_cache_entry[_mount_config.stat_cache_entries]();
+        if (!_stat_cache) {
+            return -ENOMEM;
+        }
+    }
+
+    if (_mount_config.dir_cache_size) {
+        _dir_cache = new (std::nothrow) uint8_t[_mount_config.dir_cache_size];
+        if (!_dir_cache) {
+            _free_caches();
+            return -ENOMEM;
+        }
+    }
+
+    return 0;
+}
+
+void LittleFileSystem2::_free_caches()
+{
+    delete[] _stat_cache;
+    _stat_cache = NULL;
+    delete[] _dir_cache;
+    _dir_cache = NULL;
+    _dir_cache_valid = false;
+    _dir_cache_filler = NULL;
+}
+
+// Forget everything cached, called before or after each operation that may commit metadata
+void LittleFileSystem2::_invalidate_caches()
+{
+    if (!_stat_cache && !_dir_cache) {
+        return;
+    }
+
+    for (lfs2_size_t i = 0; _stat_cache && i < _mount_config.stat_cache_entries; i++) {
+        _stat_cache[i].path[0] = '\0';
+    }
+    _dir_cache_valid = false;
+    _dir_cache_filler = NULL;
+    _cache_stats.invalidations++;
+}
+
+// Look a path up in the stat cache, then in the cached listing of its directory
+bool LittleFileSystem2::_cached_stat(const char *path, struct lfs2_info *info, int *err)
+{
+    for (lfs2_size_t i = 0; _stat_cache && i < _mount_config.stat_cache_entries; i++) {
+        stat_cache_entry *entry = &_stat_cache[i];
+        if (entry->path[0] && strcmp(entry->path, path) == 0) {
+            entry->used = ++_stat_cache_clock;
+            info->type = entry->type;
+            info->size = entry->size;
+            *err = entry->err;
+            return true;
+        }
+    }
+
+    if (!_dir_cache_valid) {
+        return false;
+    }
+
+    const char *name = strrchr(path, '/');
+    size_t dir_len = name ? name - path : 0;
+    name = name ? name + 1 : path;
+    if (!*name || dir_len != strlen(_dir_cache_path) || strncmp(path, _dir_cache_path, dir_len) != 0) {
+        return false;
+    }
+
+    const uint8_t *end = _dir_cache + _dir_cache_used;
+    for (const uint8_t *record = _dir_cache; record < end;) {
+        record = lfs2_read_record(record, info);
+        if (strcmp(info->name, name) == 0) {
+            *err = 0;
+            return true;
+        }
+    }
+
+    // The listing is complete, so the name doesn't exist
+    *err = -ENOENT;
+    return true;
+}
+
+// Keep the result of a stat, evicting the least recently used entry
+void LittleFileSystem2::_cache_stat(const char *path, int err, const struct lfs2_info *info)
+{
+    if (!_stat_cache || (err && err != -ENOENT) || strlen(path) >= cache_path_size) {
+        return;
+    }
+
+    stat_cache_entry *entry = &_stat_cache[0];
+    for (lfs2_size_t i = 0; i < _mount_config.stat_cache_entries; i++) {
+        if (!_stat_cache[i].path[0]) {
+            entry = &_stat_cache[i];
+            break;
+        }
+        if (_stat_cache[i].used < entry->used) {
+            entry = &_stat_cache[i];
+        }
+    }
+
+    strcpy(entry->path, path);
+    entry->used = ++_stat_cache_clock;
+    entry->err = err;
+    entry->type = err ? 0 : info->type;
+    entry->size = err ? 0 : info->size;
+}
+
+// Record an entry read by the filler, giving up on the listing if it doesn't fit
+void LittleFileSystem2::_dir_cache_append(const struct lfs2_info *info)
+{
+    lfs2_size_t size = LFS2_RECORD_HEADER + strlen(info->name) + 1;
+    if (_dir_cache_used + size > _mount_config.dir_cache_size) {
+        _dir_cache_filler = NULL;
+        return;
+    }
+
+    uint8_t *record = _dir_cache + _dir_cache_used;
+    record[0] = info->type;
+    memcpy(record + 1, &info->size, sizeof(info->size));
+    strcpy((char *)record + LFS2_RECORD_HEADER, info->name);
+    _dir_cache_used += size;
+}
+
 
 ////// Generic filesystem operations //////
 
@@ -147,13 +455,28 @@ static int lfs2_bd_sync(const struct lfs2_config *c)
 LittleFileSystem2::LittleFileSystem2(const char *name, BlockDevice *bd,
                                      lfs2_size_t block_size, uint32_t block_cycles,
                                      lfs2_size_t cache_size, lfs2_size_t lookahead_size)
-    : FileSystem(name)
+    : FileSystem(name), _bd(NULL), _erased(NULL), _erase_counts(NULL),
+      _erased_blocks(0), _erases(0), _erases_avoided(0),
+      _stat_cache(NULL), _stat_cache_clock(0), _dir_cache(NULL), _dir_cache_used(0),
+      _dir_cache_valid(false), _dir_cache_filler(NULL), _dir_cache_readers(0)
+{
+    memset(&_config, 0, sizeof(_config));
+    _mount_config.block_size = block_size;
+    _mount_config.block_cycles = block_cycles;
+    _mount_config.cache_size = cache_size;
+    _mount_config.lookahead_size = lookahead_size;
+    if (bd) {
+        mount(bd);
+    }
+}
+
+LittleFileSystem2::LittleFileSystem2(const char *name, BlockDevice *bd, const mount_config &config)
+    : FileSystem(name), _mount_config(config), _bd(NULL), _erased(NULL), _erase_counts(NULL),
+      _erased_blocks(0), _erases(0), _erases_avoided(0),
+      _stat_cache(NULL), _stat_cache_clock(0), _dir_cache(NULL), _dir_cache_used(0),
+      _dir_cache_valid(false), _dir_cache_filler(NULL), _dir_cache_readers(0)
 {
     memset(&_config, 0, sizeof(_config));
-    _config.block_size = block_size;
-    _config.block_cycles = block_cycles;
-    _config.cache_size = cache_size;
-    _config.lookahead_size = lookahead_size;
     if (bd) {
         mount(bd);
     }
@@ -176,21 +499,27 @@ int LittleFileSystem2::mount(BlockDevice *bd)
         return err;
     }
 
-    _config.context         = bd;
-    _config.read            = lfs2_bd_read;
-    _config.prog            = lfs2_bd_prog;
-    _config.erase           = lfs2_bd_erase;
-    _config.sync            = lfs2_bd_sync;
-    _config.read_size       = bd->get_read_size();
-    _config.prog_size       = bd->get_program_size();
-    _config.block_size      = lfs2_max(_config.block_size, (lfs2_size_t)bd->get_erase_size());
-    _config.block_count     = bd->size() / _config.block_size;
-    _config.block_cycles    = _config.block_cycles;
-    _config.cache_size      = lfs2_max(_config.cache_size, _config.prog_size);
-    _config.lookahead_size  = lfs2_min(_config.lookahead_size, 8 * ((_config.block_count + 63) / 64));
+    err = lfs2_setup_config(&_config, bd, _mount_config);
+    if (!err) {
+        err = _setup_tracking();
+    }
+    if (!err) {
+        err = _setup_caches();
+        if (err) {
+            _free_tracking();
+        }
+    }
+    if (err) {
+        _bd->deinit();
+        _bd = NULL;
+        _mutex.unlock();
+        return err;
+    }
 
     err = lfs2_mount(&_lfs, &_config);
     if (err) {
+        _free_tracking();
+        _free_caches();
         _bd = NULL;
         _mutex.unlock();
         return lfs2_toerror(err);
@@ -200,6 +529,15 @@ int LittleFileSystem2::mount(BlockDevice *bd)
     return 0;
 }
 
+int LittleFileSystem2::mount(BlockDevice *bd, const mount_config &config)
+{
+    _mutex.lock();
+    _mount_config = config;
+    int err = mount(bd);
+    _mutex.unlock();
+    return err;
+}
+
 int LittleFileSystem2::unmount()
 {
     _mutex.lock();
@@ -209,6 +547,8 @@ int LittleFileSystem2::unmount()
         if (err && !res) {
             res = lfs2_toerror(err);
         }
+        _free_tracking();
+        _free_caches();
 
         err = _bd->deinit();
         if (err && !res) {
@@ -225,6 +565,16 @@ int LittleFileSystem2::unmount()
 int LittleFileSystem2::format(BlockDevice *bd,
                               lfs2_size_t block_size, uint32_t block_cycles,
                               lfs2_size_t cache_size, lfs2_size_t lookahead_size)
+{
+    mount_config config;
+    config.block_size = block_size;
+    config.block_cycles = block_cycles;
+    config.cache_size = cache_size;
+    config.lookahead_size = lookahead_size;
+    return format(bd, config);
+}
+
+int LittleFileSystem2::format(BlockDevice *bd, const mount_config &config)
 {
     int err = bd->init();
     if (err) {
@@ -234,19 +584,11 @@ int LittleFileSystem2::format(BlockDevice *bd,
     lfs2_t _lfs;
     struct lfs2_config _config;
 
-    memset(&_config, 0, sizeof(_config));
-    _config.context         = bd;
-    _config.read            = lfs2_bd_read;
-    _config.prog            = lfs2_bd_prog;
-    _config.erase           = lfs2_bd_erase;
-    _config.sync            = lfs2_bd_sync;
-    _config.read_size       = bd->get_read_size();
-    _config.prog_size       = bd->get_program_size();
-    _config.block_size      = lfs2_max(block_size, (lfs2_size_t)bd->get_erase_size());
-    _config.block_count     = bd->size() / _config.block_size;
-    _config.block_cycles    = block_cycles;
-    _config.cache_size      = lfs2_max(cache_size, _config.prog_size);
-    _config.lookahead_size  = lfs2_min(lookahead_size, 8 * ((_config.block_count + 63) / 64));
+    err = lfs2_setup_config(&_config, bd, config);
+    if (err) {
+        bd->deinit();
+        return err;
+    }
 
     err = lfs2_format(&_lfs, &_config);
     if (err) {
@@ -281,11 +623,7 @@ int LittleFileSystem2::reformat(BlockDevice *bd)
         return -ENODEV;
     }
 
-    int err = LittleFileSystem2::format(bd,
-                                        _config.block_size,
-                                        _config.block_cycles,
-                                        _config.cache_size,
-                                        _config.lookahead_size);
+    int err = LittleFileSystem2::format(bd, _mount_config);
     if (err) {
         _mutex.unlock();
         return err;
@@ -305,6 +643,7 @@ int LittleFileSystem2::remove(const char *filename)
 {
     _mutex.lock();
     int err = lfs2_remove(&_lfs, filename);
+    _invalidate_caches();
     _mutex.unlock();
     return lfs2_toerror(err);
 }
@@ -313,6 +652,7 @@ int LittleFileSystem2::rename(const char *oldname, const char *newname)
 {
     _mutex.lock();
     int err = lfs2_rename(&_lfs, oldname, newname);
+    _invalidate_caches();
     _mutex.unlock();
     return lfs2_toerror(err);
 }
@@ -321,6 +661,7 @@ int LittleFileSystem2::mkdir(const char *name, mode_t mode)
 {
     _mutex.lock();
     int err = lfs2_mkdir(&_lfs, name);
+    _invalidate_caches();
     _mutex.unlock();
     return lfs2_toerror(err);
 }
@@ -328,12 +669,19 @@ int LittleFileSystem2::mkdir(const char *name, mode_t mode)
 int LittleFileSystem2::stat(const char *name, struct stat *st)
 {
     struct lfs2_info info;
+    int err;
     _mutex.lock();
-    int err = lfs2_stat(&_lfs, name, &info);
+    if (_cached_stat(name, &info, &err)) {
+        _cache_stats.stat_hits++;
+    } else {
+        err = lfs2_toerror(lfs2_stat(&_lfs, name, &info));
+        _cache_stats.stat_misses++;
+        _cache_stat(name, err, &info);
+    }
     _mutex.unlock();
     st->st_size = info.size;
     st->st_mode = lfs2_tomode(info.type);
-    return lfs2_toerror(err);
+    return err;
 }
 
 int LittleFileSystem2::statvfs(const char *name, struct statvfs *st)
@@ -357,25 +705,212 @@ int LittleFileSystem2::statvfs(const char *name, struct statvfs *st)
     return 0;
 }
 
+int LittleFileSystem2::get_usage(usage_stats *stats)
+{
+    _mutex.lock();
+    if (!_bd) {
+        _mutex.unlock();
+        return -ENODEV;
+    }
+
+    lfs2_ssize_t in_use = lfs2_fs_size(&_lfs);
+    if (in_use < 0) {
+        _mutex.unlock();
+        return lfs2_toerror(in_use);
+    }
+
+    stats->block_size = _config.block_size;
+    stats->block_count = _config.block_count;
+    stats->blocks_used = in_use;
+    stats->cache_size = _config.cache_size;
+    stats->lookahead_size = _config.lookahead_size;
+    _mutex.unlock();
+    return 0;
+}
+
+int LittleFileSystem2::traverse(mbed::Callback<int(lfs2_block_t)> cb)
+{
+    _mutex.lock();
+    if (!_bd) {
+        _mutex.unlock();
+        return -ENODEV;
+    }
+
+    int err = lfs2_fs_traverse(&_lfs, lfs2_traverse_cb, &cb);
+    _mutex.unlock();
+    return lfs2_toerror(err);
+}
+
+int LittleFileSystem2::pre_erase(lfs2_size_t max_erases)
+{
+    _mutex.lock();
+    if (!_bd) {
+        _mutex.unlock();
+        return -ENODEV;
+    }
+
+    if (!_erased || _erased_blocks >= _mount_config.erased_pool_size) {
+        _mutex.unlock();
+        return 0;
+    }
+
+    uint32_t *in_use = new (std::nothrow) uint32_t[(_config.block_count + 31) / 32]();
+    if (!in_use) {
+        _mutex.unlock();
+        return -ENOMEM;
+    }
+
+    // Open files are included, so every block left is free until the next file system operation
+    int err = lfs2_fs_traverse(&_lfs, lfs2_mark_block_cb, in_use);
+    if (err) {
+        delete[] in_use;
+        _mutex.unlock();
+        return lfs2_toerror(err);
+    }
+
+    // The allocator hands out free blocks in order from its lookahead position,
+    // so erase the ones it reaches first
+    lfs2_block_t start = (_lfs.free.off + _lfs.free.i) % _config.block_count;
+    lfs2_size_t erased = 0;
+    for (lfs2_block_t i = 0; i < _config.block_count; i++) {
+        if (erased >= max_erases || _erased_blocks >= _mount_config.erased_pool_size) {
+            break;
+        }
+
+        lfs2_block_t block = (start + i) % _config.block_count;
+        if (lfs2_test_block(in_use, block) || lfs2_test_block(_erased, block)) {
+            continue;
+        }
+
+        err = _bd->erase((bd_addr_t)block * _config.block_size, _config.block_size);
+        if (err) {
+            break;
+        }
+
+        _erases++;
+        if (_erase_counts) {
+            _erase_counts[block]++;
+        }
+        lfs2_mark_block_cb(_erased, block);
+        _erased_blocks++;
+        erased++;
+    }
+
+    delete[] in_use;
+    _mutex.unlock();
+    return err ? err : erased;
+}
+
+int LittleFileSystem2::get_wear_stats(wear_stats *stats)
+{
+    _mutex.lock();
+    if (!_bd) {
+        _mutex.unlock();
+        return -ENODEV;
+    }
+
+    if (!_erased && !_erase_counts) {
+        _mutex.unlock();
+        return -ENOTSUP;
+    }
+
+    stats->erases = _erases;
+    stats->erases_avoided = _erases_avoided;
+    stats->min_erases = 0;
+    stats->max_erases = 0;
+    if (_erase_counts) {
+        stats->min_erases = UINT32_MAX;
+        for (lfs2_block_t i = 0; i < _config.block_count; i++) {
+            stats->min_erases = lfs2_min(stats->min_erases, _erase_counts[i]);
+            stats->max_erases = lfs2_max(stats->max_erases, _erase_counts[i]);
+        }
+    }
+    stats->erased_blocks = _erased_blocks;
+    _mutex.unlock();
+    return 0;
+}
+
+int LittleFileSystem2::get_erase_histogram(lfs2_size_t *bins, size_t bin_count, uint32_t bin_width)
+{
+    if (!bins || !bin_count || !bin_width) {
+        return -EINVAL;
+    }
+
+    _mutex.lock();
+    if (!_bd) {
+        _mutex.unlock();
+        return -ENODEV;
+    }
+
+    if (!_erase_counts) {
+        _mutex.unlock();
+        return -ENOTSUP;
+    }
+
+    memset(bins, 0, bin_count * sizeof(lfs2_size_t));
+    for (lfs2_block_t i = 0; i < _config.block_count; i++) {
+        size_t bin = _erase_counts[i] / bin_width;
+        bins[bin < bin_count ? bin : bin_count - 1]++;
+    }
+    _mutex.unlock();
+    return 0;
+}
+
+int LittleFileSystem2::get_cache_stats(cache_stats *stats)
+{
+    _mutex.lock();
+    if (!_bd) {
+        _mutex.unlock();
+        return -ENODEV;
+    }
+
+    if (!_stat_cache && !_dir_cache) {
+        _mutex.unlock();
+        return -ENOTSUP;
+    }
+
+    *stats = _cache_stats;
+    _mutex.unlock();
+    return 0;
+}
+
 ////// File operations //////
 int LittleFileSystem2::file_open(fs_file_t *file, const char *path, int flags)
 {
     lfs2_file_t *f = new lfs2_file_t;
+    struct lfs2_info info;
+    int err;
     _mutex.lock();
-    int err = lfs2_file_open(&_lfs, f, path, lfs2_fromflags(flags));
+    bool cached = _cached_stat(path, &info, &err);
+    bool exists = cached && !err && info.type == LFS2_TYPE_REG;
+    if (cached && !exists && !(flags & O_CREAT)) {
+        // Fails without reading the storage
+        err = err ? err : -EISDIR;
+        _cache_stats.stat_hits++;
+    } else {
+        err = lfs2_toerror(lfs2_file_open(&_lfs, f, path, lfs2_fromflags(flags)));
+        // Committed at once if the file is created
+        if ((flags & O_CREAT) && !exists) {
+            _invalidate_caches();
+        }
+    }
     _mutex.unlock();
     if (!err) {
         *file = f;
     } else {
         delete f;
     }
-    return lfs2_toerror(err);
+    return err;
 }
 
 int LittleFileSystem2::file_close(fs_file_t file)
 {
     lfs2_file_t *f = (lfs2_file_t *)file;
     _mutex.lock();
+    // Any change to the file is committed by closing it
+    if (f->flags & (LFS2_F_DIRTY | LFS2_F_WRITING)) {
+        _invalidate_caches();
+    }
     int err = lfs2_file_close(&_lfs, f);
     _mutex.unlock();
     delete f;
@@ -400,10 +935,37 @@ ssize_t LittleFileSystem2::file_write(fs_file_t file, const void *buffer, size_t
     return lfs2_toerror(res);
 }
 
+ssize_t LittleFileSystem2::file_writev(fs_file_t file, const struct iovec *iov, int iovcnt)
+{
+    lfs2_file_t *f = (lfs2_file_t *)file;
+    lfs2_ssize_t total = 0;
+    // One lock for the whole record, so writes from other threads can't
+    // land between its buffers
+    _mutex.lock();
+    for (int i = 0; i < iovcnt; i++) {
+        lfs2_ssize_t res = lfs2_file_write(&_lfs, f, iov[i].iov_base, iov[i].iov_len);
+        if (res < 0) {
+            if (total == 0) {
+                total = res;
+            }
+            break;
+        }
+        total += res;
+        if ((size_t)res < iov[i].iov_len) {
+            break;
+        }
+    }
+    _mutex.unlock();
+    return lfs2_toerror(total);
+}
+
 int LittleFileSystem2::file_sync(fs_file_t file)
 {
     lfs2_file_t *f = (lfs2_file_t *)file;
     _mutex.lock();
+    if (f->flags & (LFS2_F_DIRTY | LFS2_F_WRITING)) {
+        _invalidate_caches();
+    }
     int err = lfs2_file_sync(&_lfs, f);
     _mutex.unlock();
     return lfs2_toerror(err);
@@ -449,23 +1011,57 @@ int LittleFileSystem2::file_truncate(fs_file_t file, off_t length)
 ////// Dir operations //////
 int LittleFileSystem2::dir_open(fs_dir_t *dir, const char *path)
 {
-    lfs2_dir_t *d = new lfs2_dir_t;
+    dir_handle *d = new dir_handle;
+    d->cached = false;
+    d->record = NULL;
+    d->pos = 0;
+    struct lfs2_info info;
+    int err;
     _mutex.lock();
-    int err = lfs2_dir_open(&_lfs, d, path);
+    if (_dir_cache_valid && strcmp(path, _dir_cache_path) == 0) {
+        d->cached = true;
+        d->record = _dir_cache;
+        _dir_cache_readers++;
+        _cache_stats.dir_hits++;
+        err = 0;
+    } else if (_cached_stat(path, &info, &err) && (err || info.type != LFS2_TYPE_DIR)) {
+        // Fails without reading the storage
+        err = err ? err : -ENOTDIR;
+        _cache_stats.stat_hits++;
+    } else {
+        err = lfs2_toerror(lfs2_dir_open(&_lfs, &d->dir, path));
+        _cache_stats.dir_misses++;
+        // Record the listing while it is read, unless it is being replayed
+        if (!err && _dir_cache && !_dir_cache_filler && !_dir_cache_readers &&
+                strlen(path) < cache_path_size) {
+            strcpy(_dir_cache_path, path);
+            _dir_cache_used = 0;
+            _dir_cache_valid = false;
+            _dir_cache_filler = d;
+        }
+    }
     _mutex.unlock();
     if (!err) {
         *dir = d;
     } else {
         delete d;
     }
-    return lfs2_toerror(err);
+    return err;
 }
 
 int LittleFileSystem2::dir_close(fs_dir_t dir)
 {
-    lfs2_dir_t *d = (lfs2_dir_t *)dir;
+    dir_handle *d = (dir_handle *)dir;
+    int err = 0;
     _mutex.lock();
-    int err = lfs2_dir_close(&_lfs, d);
+    if (d->cached) {
+        _dir_cache_readers--;
+    } else {
+        if (d == _dir_cache_filler) {
+            _dir_cache_filler = NULL;
+        }
+        err = lfs2_dir_close(&_lfs, &d->dir);
+    }
     _mutex.unlock();
     delete d;
     return lfs2_toerror(err);
@@ -473,10 +1069,28 @@ int LittleFileSystem2::dir_close(fs_dir_t dir)
 
 ssize_t LittleFileSystem2::dir_read(fs_dir_t dir, struct dirent *ent)
 {
-    lfs2_dir_t *d = (lfs2_dir_t *)dir;
+    dir_handle *d = (dir_handle *)dir;
     struct lfs2_info info;
+    int res = 0;
     _mutex.lock();
-    int res = lfs2_dir_read(&_lfs, d, &info);
+    if (d->cached) {
+        if (d->record < _dir_cache + _dir_cache_used) {
+            d->record = lfs2_read_record(d->record, &info);
+            d->pos++;
+            res = 1;
+        }
+    } else {
+        res = lfs2_dir_read(&_lfs, &d->dir, &info);
+        if (d == _dir_cache_filler) {
+            if (res == 1) {
+                _dir_cache_append(&info);
+            } else {
+                // Complete once read to the end
+                _dir_cache_valid = (res == 0);
+                _dir_cache_filler = NULL;
+            }
+        }
+    }
     _mutex.unlock();
     if (res == 1) {
         ent->d_type = lfs2_totype(info.type);
@@ -487,26 +1101,48 @@ ssize_t LittleFileSystem2::dir_read(fs_dir_t dir, struct dirent *ent)
 
 void LittleFileSystem2::dir_seek(fs_dir_t dir, off_t offset)
 {
-    lfs2_dir_t *d = (lfs2_dir_t *)dir;
+    dir_handle *d = (dir_handle *)dir;
     _mutex.lock();
-    lfs2_dir_seek(&_lfs, d, offset);
+    if (d->cached) {
+        const uint8_t *end = _dir_cache + _dir_cache_used;
+        d->record = _dir_cache;
+        d->pos = 0;
+        while (d->pos < offset && d->record < end) {
+            d->record = lfs2_next_record(d->record);
+            d->pos++;
+        }
+    } else {
+        if (d == _dir_cache_filler) {
+            _dir_cache_filler = NULL;
+        }
+        lfs2_dir_seek(&_lfs, &d->dir, offset);
+    }
     _mutex.unlock();
 }
 
 off_t LittleFileSystem2::dir_tell(fs_dir_t dir)
 {
-    lfs2_dir_t *d = (lfs2_dir_t *)dir;
+    dir_handle *d = (dir_handle *)dir;
     _mutex.lock();
-    lfs2_soff_t res = lfs2_dir_tell(&_lfs, d);
+    lfs2_soff_t res = d->cached ? d->pos : lfs2_dir_tell(&_lfs, &d->dir);
     _mutex.unlock();
     return lfs2_toerror(res);
 }
 
 void LittleFileSystem2::dir_rewind(fs_dir_t dir)
 {
-    lfs2_dir_t *d = (lfs2_dir_t *)dir;
+    dir_handle *d = (dir_handle *)dir;
     _mutex.lock();
-    lfs2_dir_rewind(&_lfs, d);
+    if (d->cached) {
+        d->record = _dir_cache;
+        d->pos = 0;
+    } else {
+        // The filler starts recording over
+        if (d == _dir_cache_filler) {
+            _dir_cache_used = 0;
+        }
+        lfs2_dir_rewind(&_lfs, &d->dir);
+    }
     _mutex.unlock();
 }
 
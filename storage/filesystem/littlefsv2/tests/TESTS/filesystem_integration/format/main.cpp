@@ -177,6 +177,228 @@ void test_good_mount_then_reformat()
 }
 
 
+void test_mount_with_static_buffers()
+{
+    int res = bd.init();
+    TEST_ASSERT_EQUAL(0, res);
+
+    {
+        static uint32_t fs_buffer[(2 * 512 + 64) / sizeof(uint32_t)];
+        MBED_TEST_FILESYSTEM::mount_config config;
+        config.cache_size = bd.get_program_size();
+        config.lookahead_size = 64;
+        config.buffer = fs_buffer;
+        config.buffer_size = sizeof(fs_buffer);
+        TEST_SKIP_UNLESS_MESSAGE(2 * bd.get_program_size() + 64 <= sizeof(fs_buffer),
+                                 "Program size too large for test buffer");
+
+        MBED_TEST_FILESYSTEM tuned("tuned", NULL, config);
+        res = tuned.mount(&bd);
+        TEST_ASSERT_EQUAL(0, res);
+
+        MBED_TEST_FILESYSTEM::usage_stats stats;
+        res = tuned.get_usage(&stats);
+        TEST_ASSERT_EQUAL(0, res);
+        TEST_ASSERT_EQUAL(bd.get_program_size(), stats.cache_size);
+        TEST_ASSERT(stats.blocks_used > 0 && stats.blocks_used <= stats.block_count);
+
+        res = tuned.unmount();
+        TEST_ASSERT_EQUAL(0, res);
+
+        // Too small a buffer is refused
+        config.buffer_size = bd.get_program_size();
+        res = tuned.mount(&bd, config);
+        TEST_ASSERT_EQUAL(-EINVAL, res);
+    }
+
+    res = bd.deinit();
+    TEST_ASSERT_EQUAL(0, res);
+}
+
+void test_erased_pool_and_erase_stats()
+{
+    int res = bd.init();
+    TEST_ASSERT_EQUAL(0, res);
+
+    {
+        MBED_TEST_FILESYSTEM::mount_config config;
+        config.erased_pool_size = 4;
+        config.erase_stats = true;
+
+        MBED_TEST_FILESYSTEM tuned("tuned", NULL, config);
+        res = tuned.reformat(&bd);
+        TEST_ASSERT_EQUAL(0, res);
+
+        // The pool fills up, then pre_erase has nothing left to do
+        res = tuned.pre_erase(3);
+        TEST_ASSERT_EQUAL(3, res);
+        res = tuned.pre_erase(3);
+        TEST_ASSERT_EQUAL(1, res);
+        res = tuned.pre_erase(3);
+        TEST_ASSERT_EQUAL(0, res);
+
+        MBED_TEST_FILESYSTEM::wear_stats stats;
+        res = tuned.get_wear_stats(&stats);
+        TEST_ASSERT_EQUAL(0, res);
+        TEST_ASSERT_EQUAL(4, stats.erased_blocks);
+        TEST_ASSERT_EQUAL(0, stats.erases_avoided);
+
+        // Writing a file takes blocks from the pool
+        res = file[0].open(&tuned, "pooled", O_WRONLY | O_CREAT);
+        TEST_ASSERT_EQUAL(0, res);
+        memset(wbuffer, 0x5a, sizeof(wbuffer));
+        size = 4 * bd.get_erase_size();
+        for (size_t i = 0; i < size; i += sizeof(wbuffer)) {
+            res = file[0].write(wbuffer, sizeof(wbuffer));
+            TEST_ASSERT_EQUAL(sizeof(wbuffer), res);
+        }
+        res = file[0].close();
+        TEST_ASSERT_EQUAL(0, res);
+
+        res = tuned.get_wear_stats(&stats);
+        TEST_ASSERT_EQUAL(0, res);
+        TEST_ASSERT(stats.erases_avoided > 0);
+        TEST_ASSERT(stats.erased_blocks < 4);
+
+        MBED_TEST_FILESYSTEM::usage_stats usage;
+        res = tuned.get_usage(&usage);
+        TEST_ASSERT_EQUAL(0, res);
+
+        lfs2_size_t bins[4];
+        res = tuned.get_erase_histogram(bins, 4);
+        TEST_ASSERT_EQUAL(0, res);
+        TEST_ASSERT_EQUAL(usage.block_count, bins[0] + bins[1] + bins[2] + bins[3]);
+        TEST_ASSERT(bins[1] + bins[2] + bins[3] > 0);
+
+        // The file reads back as written
+        res = file[0].open(&tuned, "pooled", O_RDONLY);
+        TEST_ASSERT_EQUAL(0, res);
+        for (size_t i = 0; i < size; i += sizeof(rbuffer)) {
+            res = file[0].read(rbuffer, sizeof(rbuffer));
+            TEST_ASSERT_EQUAL(sizeof(rbuffer), res);
+            TEST_ASSERT_EQUAL_MEMORY(wbuffer, rbuffer, sizeof(rbuffer));
+        }
+        res = file[0].close();
+        TEST_ASSERT_EQUAL(0, res);
+
+        res = tuned.unmount();
+        TEST_ASSERT_EQUAL(0, res);
+    }
+
+    res = bd.deinit();
+    TEST_ASSERT_EQUAL(0, res);
+}
+
+void test_metadata_caches()
+{
+    int res = bd.init();
+    TEST_ASSERT_EQUAL(0, res);
+
+    {
+        MBED_TEST_FILESYSTEM::mount_config config;
+        config.stat_cache_entries = 4;
+        config.dir_cache_size = 256;
+
+        MBED_TEST_FILESYSTEM tuned("tuned", NULL, config);
+        res = tuned.reformat(&bd);
+        TEST_ASSERT_EQUAL(0, res);
+
+        res = tuned.mkdir("shards", 0777);
+        TEST_ASSERT_EQUAL(0, res);
+        for (int i = 0; i < 8; i++) {
+            sprintf((char *)buffer, "shards/shard%d", i);
+            res = file[0].open(&tuned, (char *)buffer, O_WRONLY | O_CREAT);
+            TEST_ASSERT_EQUAL(0, res);
+            res = file[0].write("data", 4);
+            TEST_ASSERT_EQUAL(4, res);
+            res = file[0].close();
+            TEST_ASSERT_EQUAL(0, res);
+        }
+
+        // Repeated stats, also of a missing file, are answered from RAM
+        struct stat st;
+        for (int i = 0; i < 2; i++) {
+            res = tuned.stat("shards/shard0", &st);
+            TEST_ASSERT_EQUAL(0, res);
+            TEST_ASSERT_EQUAL(4, st.st_size);
+            res = tuned.stat("shards/missing", &st);
+            TEST_ASSERT_EQUAL(-ENOENT, res);
+        }
+        res = file[0].open(&tuned, "shards/missing", O_RDONLY);
+        TEST_ASSERT_EQUAL(-ENOENT, res);
+
+        MBED_TEST_FILESYSTEM::cache_stats stats;
+        res = tuned.get_cache_stats(&stats);
+        TEST_ASSERT_EQUAL(0, res);
+        TEST_ASSERT_EQUAL(2, stats.stat_misses);
+        TEST_ASSERT_EQUAL(3, stats.stat_hits);
+
+        // The second listing is replayed, and answers stats of its entries
+        for (int i = 0; i < 2; i++) {
+            res = dir[0].open(&tuned, "shards");
+            TEST_ASSERT_EQUAL(0, res);
+            size = 0;
+            while (dir[0].read(&ent) == 1) {
+                size++;
+            }
+            TEST_ASSERT_EQUAL(2 + 8, size);
+            res = dir[0].close();
+            TEST_ASSERT_EQUAL(0, res);
+        }
+        res = tuned.stat("shards/shard7", &st);
+        TEST_ASSERT_EQUAL(0, res);
+        TEST_ASSERT_EQUAL(4, st.st_size);
+
+        res = tuned.get_cache_stats(&stats);
+        TEST_ASSERT_EQUAL(0, res);
+        TEST_ASSERT_EQUAL(1, stats.dir_misses);
+        TEST_ASSERT_EQUAL(1, stats.dir_hits);
+        TEST_ASSERT_EQUAL(2, stats.stat_misses);
+
+        // Changes are seen at once
+        res = file[0].open(&tuned, "shards/shard0", O_WRONLY | O_APPEND);
+        TEST_ASSERT_EQUAL(0, res);
+        res = file[0].write("more", 4);
+        TEST_ASSERT_EQUAL(4, res);
+        res = file[0].close();
+        TEST_ASSERT_EQUAL(0, res);
+        res = tuned.stat("shards/shard0", &st);
+        TEST_ASSERT_EQUAL(0, res);
+        TEST_ASSERT_EQUAL(8, st.st_size);
+
+        res = tuned.rename("shards/shard1", "shards/missing");
+        TEST_ASSERT_EQUAL(0, res);
+        res = tuned.stat("shards/missing", &st);
+        TEST_ASSERT_EQUAL(0, res);
+        res = tuned.stat("shards/shard1", &st);
+        TEST_ASSERT_EQUAL(-ENOENT, res);
+
+        res = tuned.remove("shards/shard2");
+        TEST_ASSERT_EQUAL(0, res);
+        res = dir[0].open(&tuned, "shards");
+        TEST_ASSERT_EQUAL(0, res);
+        size = 0;
+        while (dir[0].read(&ent) == 1) {
+            TEST_ASSERT_NOT_EQUAL(0, strcmp(ent.d_name, "shard2"));
+            size++;
+        }
+        TEST_ASSERT_EQUAL(2 + 7, size);
+        res = dir[0].close();
+        TEST_ASSERT_EQUAL(0, res);
+
+        res = tuned.get_cache_stats(&stats);
+        TEST_ASSERT_EQUAL(0, res);
+        TEST_ASSERT(stats.invalidations >= 3);
+
+        res = tuned.unmount();
+        TEST_ASSERT_EQUAL(0, res);
+    }
+
+    res = bd.deinit();
+    TEST_ASSERT_EQUAL(0, res);
+}
+
+
 // test setup
 utest::v1::status_t test_setup(const size_t number_of_cases)
 {
@@ -190,6 +412,9 @@ Case cases[] = {
     Case("Test bad mount", test_bad_mount),
     Case("Test bad mount than reformat", test_bad_mount_then_reformat),
     Case("Test good mount than reformat", test_good_mount_then_reformat),
+    Case("Test mount with static buffers", test_mount_with_static_buffers),
+    Case("Test erased pool and erase stats", test_erased_pool_and_erase_stats),
+    Case("Test metadata caches", test_metadata_caches),
 };
 
 Specification specification(test_setup, cases);
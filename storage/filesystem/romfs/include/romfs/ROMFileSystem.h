@@ -0,0 +1,290 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/** \addtogroup storage */
+/** @{*/
+
+#ifndef MBED_ROMFILESYSTEM_H
+#define MBED_ROMFILESYSTEM_H
+
+#include "filesystem/FileSystem.h"
+#include "blockdevice/BlockDevice.h"
+#include "platform/PlatformMutex.h"
+
+namespace mbed {
+
+/**
+ * Read-only file system over a packed image, for static assets.
+ *
+ * The image is built on the host with storage/filesystem/romfs/tools/mkromfs.py
+ * and written to the start of a block device. It holds a table of every file
+ * and directory, sorted by path, so that a lookup is a single binary search,
+ * followed by the data of each file, aligned.
+ *
+ * When the block device is memory mapped (see BlockDevice::get_mapped_address),
+ * the table is used in place and File::mmap() or map() return pointers to
+ * the file data, without copying. Otherwise the table is read into the heap
+ * at mount, and reads go through the block device.
+ *
+ * Image layout, all little endian 32-bit words:
+ * - Header: magic "RMFS", version, image size, entry count, offset of the
+ *   entries, offset and size of the names, alignment of the file data.
+ * - Entries, 4 words each: offset of the path in the names, flags (bit 0 set
+ *   for a directory), then for a file the offset and size of its data, for a
+ *   directory 0 and the number of its descendants.
+ * - Names: paths without a leading '/', each followed by a NUL.
+ * - File data, starting at aligned offsets.
+ *
+ * The entries are sorted by path, with '/' comparing lower than any other
+ * character, so that the descendants of a directory immediately follow it.
+ */
+class ROMFileSystem : public mbed::FileSystem {
+public:
+    /** Lifetime of the ROMFileSystem
+     *
+     *  @param name     Name of the file system in the tree.
+     *  @param bd       Block device holding the image, mounted
+     *                  immediately if not NULL.
+     */
+    ROMFileSystem(const char *name = NULL, mbed::BlockDevice *bd = NULL);
+
+    virtual ~ROMFileSystem();
+
+    /** Mount the image on a block device.
+     *
+     *  @param bd       Block device holding the image at address 0.
+     *  @return         0 on success, -EILSEQ if the device does not hold a valid
+     *                  image, or other negative error code on failure.
+     */
+    virtual int mount(mbed::BlockDevice *bd);
+
+    /** Unmount the file system from the underlying block device.
+     *
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual int unmount();
+
+    /** Remove a file from the file system.
+     *
+     *  @param path     The name of the file to remove.
+     *  @return         -EROFS, the file system is read-only
+     */
+    virtual int remove(const char *path);
+
+    /** Rename a file in the file system.
+     *
+     *  @param path     The name of the file to rename.
+     *  @param newpath  The name to rename it to.
+     *  @return         -EROFS, the file system is read-only
+     */
+    virtual int rename(const char *path, const char *newpath);
+
+    /** Create a directory in the file system.
+     *
+     *  @param path     The name of the directory to create.
+     *  @param mode     The permissions with which to create the directory.
+     *  @return         -EROFS, the file system is read-only
+     */
+    virtual int mkdir(const char *path, mode_t mode);
+
+    /** Store information about the file in a stat structure
+     *
+     *  @param path     The name of the file to find information about.
+     *  @param st       The stat buffer to write to.
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual int stat(const char *path, struct stat *st);
+
+    /** Store information about the mounted file system in a statvfs structure.
+     *
+     *  @param path     The name of the file to find information about.
+     *  @param buf      The stat buffer to write to.
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual int statvfs(const char *path, struct statvfs *buf);
+
+    /** Get a pointer to the whole contents of a file.
+     *
+     *  @param path     The name of the file.
+     *  @param size     Destination for the size of the file, may be NULL.
+     *  @return         Pointer to the file data, or NULL if the file does not
+     *                  exist or the image is not memory mapped.
+     */
+    const void *map(const char *path, size_t *size = NULL);
+
+    /** Check whether the image is memory mapped.
+     *
+     *  @return         True if map() and File::mmap() return pointers into the image.
+     */
+    bool is_mapped() const;
+
+protected:
+#if !(DOXYGEN_ONLY)
+    /** Open a file on the file system.
+     *
+     *  @param file     Destination of the newly created handle to the referenced file.
+     *  @param path     The name of the file to open.
+     *  @param flags    The flags that trigger opening of the file, only O_RDONLY is supported.
+     *  @return         0 on success, negative error code on failure.
+     */
+    virtual int file_open(mbed::fs_file_t *file, const char *path, int flags);
+
+    /** Close a file
+     *
+     *  @param file     File handle.
+     *  return          0 on success, negative error code on failure
+     */
+    virtual int file_close(mbed::fs_file_t file);
+
+    /** Read the contents of a file into a buffer
+     *
+     *  @param file     File handle.
+     *  @param buffer   The buffer to read in to.
+     *  @param size     The number of bytes to read.
+     *  @return         The number of bytes read, 0 at end of file, negative error on failure
+     */
+    virtual ssize_t file_read(mbed::fs_file_t file, void *buffer, size_t size);
+
+    /** Write the contents of a buffer to a file
+     *
+     *  @param file     File handle.
+     *  @param buffer   The buffer to write from.
+     *  @param size     The number of bytes to write.
+     *  @return         -EBADF, as files can't be opened for writing
+     */
+    virtual ssize_t file_write(mbed::fs_file_t file, const void *buffer, size_t size);
+
+    /** Move the file position to a given offset from a given location
+     *
+     *  @param file     File handle.
+     *  @param offset   The offset from whence to move to.
+     *  @param whence   The start of where to seek.
+     *      SEEK_SET to start from beginning of file,
+     *      SEEK_CUR to start from current position in file,
+     *      SEEK_END to start from end of file.
+     *  @return         The new offset of the file
+     */
+    virtual off_t file_seek(mbed::fs_file_t file, off_t offset, int whence);
+
+    /** Get the file position of the file
+     *
+     *  @param file     File handle.
+     *  @return         The current offset in the file
+     */
+    virtual off_t file_tell(mbed::fs_file_t file);
+
+    /** Get the size of the file
+     *
+     *  @param file     File handle.
+     *  @return         Size of the file in bytes
+     */
+    virtual off_t file_size(mbed::fs_file_t file);
+
+    /** Get a pointer to the contents of a file in the memory mapped image.
+     *
+     *  @param file     File handle.
+     *  @param offset   Offset of the region in the file.
+     *  @param size     Size of the region in bytes.
+     *  @param ptr      Destination for the pointer to the region.
+     *
+     *  @return         0 on success, -ENOSYS if the image is not memory mapped,
+     *                  -EINVAL if the region is outside the file.
+     */
+    virtual int file_mmap(mbed::fs_file_t file, off_t offset, size_t size, const void **ptr);
+
+    /** Open a directory on the file system.
+     *
+     *  @param dir      Destination for the handle to the directory.
+     *  @param path     Name of the directory to open.
+     *  @return         0 on success, negative error code on failure
+     */
+    virtual int dir_open(mbed::fs_dir_t *dir, const char *path);
+
+    /** Close a directory
+     *
+     *  @param dir      Dir handle.
+     *  return          0 on success, negative error code on failure
+     */
+    virtual int dir_close(mbed::fs_dir_t dir);
+
+    /** Read the next directory entry
+     *
+     *  @param dir      Dir handle.
+     *  @param ent      The directory entry to fill out.
+     *  @return         1 on reading a filename, 0 at end of directory, negative error on failure
+     */
+    virtual ssize_t dir_read(mbed::fs_dir_t dir, struct dirent *ent);
+
+    /** Set the current position of the directory
+     *
+     *  @param dir      Dir handle.
+     *  @param offset   Offset of the location to seek to,
+     *                  must be a value returned from dir_tell
+     */
+    virtual void dir_seek(mbed::fs_dir_t dir, off_t offset);
+
+    /** Get the current position of the directory
+     *
+     *  @param dir      Dir handle.
+     *  @return         Position of the directory that can be passed to dir_rewind
+     */
+    virtual off_t dir_tell(mbed::fs_dir_t dir);
+
+    /** Rewind the current position to the beginning of the directory
+     *
+     *  @param dir      Dir handle
+     */
+    virtual void dir_rewind(mbed::fs_dir_t dir);
+#endif //!(DOXYGEN_ONLY)
+
+private:
+    struct entry_t {
+        uint32_t name;
+        uint32_t flags;
+        uint32_t offset;
+        uint32_t size;
+    };
+
+    mbed::BlockDevice *_bd; // The block device
+    const uint8_t *_image;  // The whole image if memory mapped
+    const entry_t *_entries;
+    const char *_names;
+    uint8_t *_tables;       // The entries and names if not memory mapped
+    uint8_t *_cache;        // One read block for unaligned reads
+    uint32_t _entry_count;
+    uint32_t _image_size;
+    uint32_t _alignment;
+    entry_t _root;
+
+    // thread-safe locking
+    PlatformMutex _mutex;
+
+    const entry_t *lookup(const char *path) const;
+    int read_image(uint32_t addr, void *buffer, uint32_t size);
+    void release();
+};
+
+} // namespace mbed
+
+// Added "using" for backwards compatibility
+#ifndef MBED_NO_GLOBAL_USING_DIRECTIVE
+using mbed::ROMFileSystem;
+#endif
+
+#endif
+
+/** @}*/
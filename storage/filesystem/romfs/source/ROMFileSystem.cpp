@@ -0,0 +1,571 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <string.h>
+#include <new>
+#include "filesystem/mbed_filesystem.h"
+#include "romfs/ROMFileSystem.h"
+#include "errno.h"
+
+#define ROMFS_MAGIC         0x53464D52  // "RMFS" in little endian
+#define ROMFS_VERSION       1
+#define ROMFS_HEADER_SIZE   32
+#define ROMFS_ENTRY_SIZE    16
+#define ROMFS_FLAG_DIR      0x1
+
+namespace mbed {
+
+struct romfs_file_t {
+    uint32_t offset;
+    uint32_t size;
+    uint32_t pos;
+};
+
+struct romfs_dir_t {
+    uint32_t first;
+    uint32_t end;
+    uint32_t pos;
+    uint32_t prefix;
+};
+
+static uint32_t romfs_word(const uint8_t *buf, int index)
+{
+    buf += 4 * index;
+    return buf[0] | (buf[1] << 8) | (buf[2] << 16) | ((uint32_t)buf[3] << 24);
+}
+
+// Compare a stored path with the first len characters of a key, with '/'
+// lower than any other character so that subtrees are contiguous
+static int romfs_compare(const char *name, const char *key, size_t len)
+{
+    for (size_t i = 0; i < len; i++) {
+        unsigned a = (unsigned char)name[i];
+        unsigned b = (unsigned char)key[i];
+        a = (a == '/') ? 1 : a;
+        b = (b == '/') ? 1 : b;
+        if (a != b) {
+            return a < b ? -1 : 1;
+        }
+    }
+    return name[len] ? 1 : 0;
+}
+
+ROMFileSystem::ROMFileSystem(const char *name, BlockDevice *bd)
+    : FileSystem(name)
+    , _bd(NULL)
+    , _image(NULL)
+    , _entries(NULL)
+    , _names(NULL)
+    , _tables(NULL)
+    , _cache(NULL)
+    , _entry_count(0)
+    , _image_size(0)
+    , _alignment(0)
+    , _root()
+{
+    if (bd) {
+        mount(bd);
+    }
+}
+
+ROMFileSystem::~ROMFileSystem()
+{
+    // nop if unmounted
+    unmount();
+}
+
+int ROMFileSystem::mount(BlockDevice *bd)
+{
+    _mutex.lock();
+    if (_bd) {
+        _mutex.unlock();
+        return -EBUSY;
+    }
+
+    int err = bd->init();
+    if (err) {
+        _mutex.unlock();
+        return err;
+    }
+    _bd = bd;
+
+    _cache = new (std::nothrow) uint8_t[_bd->get_read_size()];
+    if (!_cache) {
+        err = -ENOMEM;
+        goto fail;
+    }
+
+    uint8_t header[ROMFS_HEADER_SIZE];
+    if (_bd->size() < ROMFS_HEADER_SIZE) {
+        err = -EILSEQ;
+        goto fail;
+    }
+    err = read_image(0, header, sizeof(header));
+    if (err) {
+        goto fail;
+    }
+
+    {
+        uint32_t image_size = romfs_word(header, 2);
+        uint32_t entry_count = romfs_word(header, 3);
+        uint32_t entries = romfs_word(header, 4);
+        uint32_t names = romfs_word(header, 5);
+        uint32_t names_size = romfs_word(header, 6);
+        uint32_t alignment = romfs_word(header, 7);
+
+        if (romfs_word(header, 0) != ROMFS_MAGIC || romfs_word(header, 1) != ROMFS_VERSION
+                || image_size > _bd->size() || entries % 4 != 0
+                || entry_count > (image_size - entries) / ROMFS_ENTRY_SIZE
+                || entries < ROMFS_HEADER_SIZE || entries > image_size
+                || names > image_size || names_size > image_size - names || names_size == 0
+                || alignment == 0 || (alignment & (alignment - 1)) != 0) {
+            err = -EILSEQ;
+            goto fail;
+        }
+
+        _image_size = image_size;
+        _entry_count = entry_count;
+        _alignment = alignment;
+
+        // Use the tables in place if the whole image is memory mapped
+        _image = static_cast<const uint8_t *>(_bd->get_mapped_address(0, image_size));
+        if (_image) {
+            _entries = reinterpret_cast<const entry_t *>(_image + entries);
+            _names = reinterpret_cast<const char *>(_image + names);
+        } else {
+            uint32_t entries_size = entry_count * ROMFS_ENTRY_SIZE;
+            _tables = new (std::nothrow) uint8_t[entries_size + names_size];
+            if (!_tables) {
+                err = -ENOMEM;
+                goto fail;
+            }
+            err = read_image(entries, _tables, entries_size);
+            if (!err) {
+                err = read_image(names, _tables + entries_size, names_size);
+            }
+            if (err) {
+                goto fail;
+            }
+            _entries = reinterpret_cast<const entry_t *>(_tables);
+            _names = reinterpret_cast<const char *>(_tables + entries_size);
+        }
+
+        // Check every entry once, so that lookups can trust the tables
+        if (_names[names_size - 1] != '\0') {
+            err = -EILSEQ;
+            goto fail;
+        }
+        for (uint32_t i = 0; i < _entry_count; i++) {
+            const entry_t &e = _entries[i];
+            bool bad = e.name >= names_size;
+            if (e.flags & ROMFS_FLAG_DIR) {
+                bad = bad || e.size > _entry_count - i - 1;
+            } else {
+                bad = bad || e.offset > image_size || e.size > image_size - e.offset;
+            }
+            if (bad) {
+                err = -EILSEQ;
+                goto fail;
+            }
+        }
+
+        _root.name = names_size - 1;
+        _root.flags = ROMFS_FLAG_DIR;
+        _root.offset = 0;
+        _root.size = _entry_count;
+    }
+
+    _mutex.unlock();
+    return 0;
+
+fail:
+    release();
+    _bd->deinit();
+    _bd = NULL;
+    _mutex.unlock();
+    return err;
+}
+
+int ROMFileSystem::unmount()
+{
+    _mutex.lock();
+    int res = 0;
+    if (_bd) {
+        release();
+        res = _bd->deinit();
+        _bd = NULL;
+    }
+    _mutex.unlock();
+    return res;
+}
+
+void ROMFileSystem::release()
+{
+    delete[] _tables;
+    delete[] _cache;
+    _tables = NULL;
+    _cache = NULL;
+    _image = NULL;
+    _entries = NULL;
+    _names = NULL;
+    _entry_count = 0;
+    _image_size = 0;
+}
+
+int ROMFileSystem::read_image(uint32_t addr, void *buffer, uint32_t size)
+{
+    uint8_t *data = static_cast<uint8_t *>(buffer);
+    if (_image) {
+        memcpy(data, _image + addr, size);
+        return 0;
+    }
+
+    // Read whole blocks straight into the buffer, and the unaligned
+    // head and tail through the cache
+    bd_size_t read_size = _bd->get_read_size();
+    while (size > 0) {
+        uint32_t off = addr % read_size;
+        uint32_t chunk;
+        int err;
+        if (off == 0 && size >= read_size) {
+            chunk = size - size % read_size;
+            err = _bd->read(data, addr, chunk);
+        } else {
+            chunk = read_size - off;
+            if (chunk > size) {
+                chunk = size;
+            }
+            err = _bd->read(_cache, addr - off, read_size);
+            memcpy(data, _cache + off, chunk);
+        }
+        if (err) {
+            return err;
+        }
+        addr += chunk;
+        data += chunk;
+        size -= chunk;
+    }
+    return 0;
+}
+
+const ROMFileSystem::entry_t *ROMFileSystem::lookup(const char *path) const
+{
+    if (!_entries) {
+        return NULL;
+    }
+
+    while (*path == '/') {
+        path++;
+    }
+    size_t len = strlen(path);
+    while (len > 0 && path[len - 1] == '/') {
+        len--;
+    }
+    if (len == 0) {
+        return &_root;
+    }
+
+    uint32_t low = 0;
+    uint32_t high = _entry_count;
+    while (low < high) {
+        uint32_t mid = low + (high - low) / 2;
+        int cmp = romfs_compare(_names + _entries[mid].name, path, len);
+        if (cmp == 0) {
+            return &_entries[mid];
+        } else if (cmp < 0) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return NULL;
+}
+
+int ROMFileSystem::remove(const char *path)
+{
+    return -EROFS;
+}
+
+int ROMFileSystem::rename(const char *path, const char *newpath)
+{
+    return -EROFS;
+}
+
+int ROMFileSystem::mkdir(const char *path, mode_t mode)
+{
+    return -EROFS;
+}
+
+int ROMFileSystem::stat(const char *path, struct stat *st)
+{
+    _mutex.lock();
+    const entry_t *e = lookup(path);
+    if (!e) {
+        _mutex.unlock();
+        return -ENOENT;
+    }
+
+    memset(st, 0, sizeof(struct stat));
+    if (e->flags & ROMFS_FLAG_DIR) {
+        st->st_mode = S_IFDIR | S_IRUSR | S_IXUSR | S_IRGRP | S_IXGRP | S_IROTH | S_IXOTH;
+    } else {
+        st->st_mode = S_IFREG | S_IRUSR | S_IRGRP | S_IROTH;
+        st->st_size = e->size;
+    }
+    _mutex.unlock();
+    return 0;
+}
+
+int ROMFileSystem::statvfs(const char *path, struct statvfs *st)
+{
+    memset(st, 0, sizeof(struct statvfs));
+
+    _mutex.lock();
+    if (!_bd) {
+        _mutex.unlock();
+        return -ENODEV;
+    }
+    st->f_bsize  = _alignment;
+    st->f_frsize = _alignment;
+    st->f_blocks = (_image_size + _alignment - 1) / _alignment;
+    st->f_bfree  = 0;
+    st->f_bavail = 0;
+    st->f_namemax = NAME_MAX;
+    _mutex.unlock();
+    return 0;
+}
+
+const void *ROMFileSystem::map(const char *path, size_t *size)
+{
+    _mutex.lock();
+    const entry_t *e = lookup(path);
+    const void *ptr = NULL;
+    if (_image && e && !(e->flags & ROMFS_FLAG_DIR)) {
+        ptr = _image + e->offset;
+        if (size) {
+            *size = e->size;
+        }
+    }
+    _mutex.unlock();
+    return ptr;
+}
+
+bool ROMFileSystem::is_mapped() const
+{
+    return _image != NULL;
+}
+
+////// File operations //////
+int ROMFileSystem::file_open(fs_file_t *file, const char *path, int flags)
+{
+    if ((flags & O_ACCMODE) != O_RDONLY || (flags & O_TRUNC)) {
+        return -EROFS;
+    }
+
+    _mutex.lock();
+    const entry_t *e = lookup(path);
+    if (!e) {
+        _mutex.unlock();
+        return (flags & O_CREAT) ? -EROFS : -ENOENT;
+    }
+    if (e->flags & ROMFS_FLAG_DIR) {
+        _mutex.unlock();
+        return -EISDIR;
+    }
+
+    romfs_file_t *f = new (std::nothrow) romfs_file_t;
+    if (!f) {
+        _mutex.unlock();
+        return -ENOMEM;
+    }
+    f->offset = e->offset;
+    f->size = e->size;
+    f->pos = 0;
+    _mutex.unlock();
+
+    *file = f;
+    return 0;
+}
+
+int ROMFileSystem::file_close(fs_file_t file)
+{
+    delete static_cast<romfs_file_t *>(file);
+    return 0;
+}
+
+ssize_t ROMFileSystem::file_read(fs_file_t file, void *buffer, size_t len)
+{
+    romfs_file_t *f = static_cast<romfs_file_t *>(file);
+    if (f->pos >= f->size) {
+        return 0;
+    }
+    if (len > f->size - f->pos) {
+        len = f->size - f->pos;
+    }
+
+    _mutex.lock();
+    int err = read_image(f->offset + f->pos, buffer, len);
+    _mutex.unlock();
+    if (err) {
+        return err;
+    }
+
+    f->pos += len;
+    return len;
+}
+
+ssize_t ROMFileSystem::file_write(fs_file_t file, const void *buffer, size_t len)
+{
+    return -EBADF;
+}
+
+off_t ROMFileSystem::file_seek(fs_file_t file, off_t offset, int whence)
+{
+    romfs_file_t *f = static_cast<romfs_file_t *>(file);
+    off_t pos;
+    switch (whence) {
+        case SEEK_SET:
+            pos = offset;
+            break;
+        case SEEK_CUR:
+            pos = (off_t)f->pos + offset;
+            break;
+        case SEEK_END:
+            pos = (off_t)f->size + offset;
+            break;
+        default:
+            return -EINVAL;
+    }
+    if (pos < 0 || (uint64_t)pos > UINT32_MAX) {
+        return -EINVAL;
+    }
+
+    f->pos = (uint32_t)pos;
+    return pos;
+}
+
+off_t ROMFileSystem::file_tell(fs_file_t file)
+{
+    return static_cast<romfs_file_t *>(file)->pos;
+}
+
+off_t ROMFileSystem::file_size(fs_file_t file)
+{
+    return static_cast<romfs_file_t *>(file)->size;
+}
+
+int ROMFileSystem::file_mmap(fs_file_t file, off_t offset, size_t size, const void **ptr)
+{
+    romfs_file_t *f = static_cast<romfs_file_t *>(file);
+    if (!_image) {
+        return -ENOSYS;
+    }
+    if (offset < 0 || (uint64_t)offset > f->size || size > f->size - offset) {
+        return -EINVAL;
+    }
+
+    *ptr = _image + f->offset + offset;
+    return 0;
+}
+
+
+////// Dir operations //////
+int ROMFileSystem::dir_open(fs_dir_t *dir, const char *path)
+{
+    _mutex.lock();
+    const entry_t *e = lookup(path);
+    if (!e) {
+        _mutex.unlock();
+        return -ENOENT;
+    }
+    if (!(e->flags & ROMFS_FLAG_DIR)) {
+        _mutex.unlock();
+        return -ENOTDIR;
+    }
+
+    romfs_dir_t *d = new (std::nothrow) romfs_dir_t;
+    if (!d) {
+        _mutex.unlock();
+        return -ENOMEM;
+    }
+    if (e == &_root) {
+        d->first = 0;
+        d->prefix = 0;
+    } else {
+        // The descendants follow the directory, and their paths start
+        // with the path of the directory and a '/'
+        d->first = (e - _entries) + 1;
+        d->prefix = strlen(_names + e->name) + 1;
+    }
+    d->end = d->first + e->size;
+    d->pos = d->first;
+    _mutex.unlock();
+
+    *dir = d;
+    return 0;
+}
+
+int ROMFileSystem::dir_close(fs_dir_t dir)
+{
+    delete static_cast<romfs_dir_t *>(dir);
+    return 0;
+}
+
+ssize_t ROMFileSystem::dir_read(fs_dir_t dir, struct dirent *ent)
+{
+    romfs_dir_t *d = static_cast<romfs_dir_t *>(dir);
+    _mutex.lock();
+    if (!_entries || d->pos >= d->end) {
+        _mutex.unlock();
+        return 0;
+    }
+
+    const entry_t &e = _entries[d->pos];
+    strncpy(ent->d_name, _names + e.name + d->prefix, NAME_MAX);
+    ent->d_name[NAME_MAX] = '\0';
+    if (e.flags & ROMFS_FLAG_DIR) {
+        ent->d_type = DT_DIR;
+        // Skip the subdirectory's own descendants
+        d->pos += 1 + e.size;
+    } else {
+        ent->d_type = DT_REG;
+        d->pos += 1;
+    }
+    _mutex.unlock();
+    return 1;
+}
+
+void ROMFileSystem::dir_seek(fs_dir_t dir, off_t offset)
+{
+    romfs_dir_t *d = static_cast<romfs_dir_t *>(dir);
+    if (offset >= 0 && (uint64_t)offset <= d->end - d->first) {
+        d->pos = d->first + offset;
+    }
+}
+
+off_t ROMFileSystem::dir_tell(fs_dir_t dir)
+{
+    romfs_dir_t *d = static_cast<romfs_dir_t *>(dir);
+    return d->pos - d->first;
+}
+
+void ROMFileSystem::dir_rewind(fs_dir_t dir)
+{
+    romfs_dir_t *d = static_cast<romfs_dir_t *>(dir);
+    d->pos = d->first;
+}
+
+} // namespace mbed
@@ -0,0 +1,231 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "greentea-client/test_env.h"
+#include "unity/unity.h"
+#include "utest/utest.h"
+
+#include "HeapBlockDevice.h"
+#include "ROMFileSystem.h"
+#include <string.h>
+
+using namespace utest::v1;
+using namespace mbed;
+
+#define BLOCK_SIZE 512
+
+// mkromfs.py --c-array of index.html, css/site.css and an empty fonts/README
+MBED_ALIGN(16) static const uint8_t romfs_image[224] = {
+    0x52, 0x4d, 0x46, 0x53, 0x01, 0x00, 0x00, 0x00, 0xe0, 0x00, 0x00, 0x00,
+    0x05, 0x00, 0x00, 0x00, 0x20, 0x00, 0x00, 0x00, 0x70, 0x00, 0x00, 0x00,
+    0x30, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00,
+    0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xa0, 0x00, 0x00, 0x00,
+    0x14, 0x00, 0x00, 0x00, 0x11, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x17, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0xc0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x24, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xc0, 0x00, 0x00, 0x00,
+    0x13, 0x00, 0x00, 0x00, 0x63, 0x73, 0x73, 0x00, 0x63, 0x73, 0x73, 0x2f,
+    0x73, 0x69, 0x74, 0x65, 0x2e, 0x63, 0x73, 0x73, 0x00, 0x66, 0x6f, 0x6e,
+    0x74, 0x73, 0x00, 0x66, 0x6f, 0x6e, 0x74, 0x73, 0x2f, 0x52, 0x45, 0x41,
+    0x44, 0x4d, 0x45, 0x00, 0x69, 0x6e, 0x64, 0x65, 0x78, 0x2e, 0x68, 0x74,
+    0x6d, 0x6c, 0x00, 0x00, 0x62, 0x6f, 0x64, 0x79, 0x20, 0x7b, 0x20, 0x6d,
+    0x61, 0x72, 0x67, 0x69, 0x6e, 0x3a, 0x20, 0x30, 0x3b, 0x20, 0x7d, 0x0a,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x3c, 0x68, 0x74, 0x6d, 0x6c, 0x3e, 0x68, 0x65, 0x6c, 0x6c, 0x6f, 0x3c,
+    0x2f, 0x68, 0x74, 0x6d, 0x6c, 0x3e, 0x0a, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+};
+
+static const char index_html[] = "<html>hello</html>\n";
+static const char site_css[] = "body { margin: 0; }\n";
+
+// Block device over the image in memory, as internal flash would be
+class MappedBlockDevice : public BlockDevice {
+public:
+    virtual int init()
+    {
+        return 0;
+    }
+    virtual int deinit()
+    {
+        return 0;
+    }
+    virtual int read(void *buffer, bd_addr_t addr, bd_size_t size)
+    {
+        memcpy(buffer, romfs_image + addr, size);
+        return 0;
+    }
+    virtual int program(const void *buffer, bd_addr_t addr, bd_size_t size)
+    {
+        return BD_ERROR_DEVICE_ERROR;
+    }
+    virtual bd_size_t get_read_size() const
+    {
+        return 1;
+    }
+    virtual bd_size_t get_program_size() const
+    {
+        return 1;
+    }
+    virtual bd_size_t size() const
+    {
+        return sizeof(romfs_image);
+    }
+    virtual const void *get_mapped_address(bd_addr_t addr, bd_size_t size) const
+    {
+        return romfs_image + addr;
+    }
+    virtual const char *get_type() const
+    {
+        return "MAPPED";
+    }
+};
+
+static void check_contents(ROMFileSystem &fs)
+{
+    struct stat st;
+    TEST_ASSERT_EQUAL(0, fs.stat("/index.html", &st));
+    TEST_ASSERT_EQUAL(sizeof(index_html) - 1, st.st_size);
+    TEST_ASSERT(S_ISREG(st.st_mode));
+    TEST_ASSERT_EQUAL(0, fs.stat("css/", &st));
+    TEST_ASSERT(S_ISDIR(st.st_mode));
+    TEST_ASSERT_EQUAL(-ENOENT, fs.stat("css/site", &st));
+
+    File file;
+    char buffer[32];
+    TEST_ASSERT_EQUAL(0, file.open(&fs, "css/site.css", O_RDONLY));
+    TEST_ASSERT_EQUAL(5, file.seek(5, SEEK_SET));
+    TEST_ASSERT_EQUAL(sizeof(site_css) - 6, file.read(buffer, sizeof(buffer)));
+    TEST_ASSERT_EQUAL_MEMORY(site_css + 5, buffer, sizeof(site_css) - 6);
+    TEST_ASSERT_EQUAL(0, file.read(buffer, sizeof(buffer)));
+    TEST_ASSERT_EQUAL(-EBADF, file.write(buffer, 1));
+    TEST_ASSERT_EQUAL(0, file.close());
+
+    TEST_ASSERT_EQUAL(-EROFS, file.open(&fs, "index.html", O_RDWR));
+    TEST_ASSERT_EQUAL(-EROFS, file.open(&fs, "new.txt", O_WRONLY | O_CREAT));
+    TEST_ASSERT_EQUAL(-EISDIR, file.open(&fs, "fonts", O_RDONLY));
+    TEST_ASSERT_EQUAL(-ENOENT, file.open(&fs, "fonts/LICENSE", O_RDONLY));
+    TEST_ASSERT_EQUAL(-EROFS, fs.remove("index.html"));
+    TEST_ASSERT_EQUAL(-EROFS, fs.mkdir("js", 0777));
+
+    // Only the direct children are listed, in image order
+    Dir dir;
+    struct dirent ent;
+    const char *names[] = {"css", "fonts", "index.html"};
+    TEST_ASSERT_EQUAL(0, dir.open(&fs, "/"));
+    for (int i = 0; i < 3; i++) {
+        TEST_ASSERT_EQUAL(1, dir.read(&ent));
+        TEST_ASSERT_EQUAL_STRING(names[i], ent.d_name);
+        TEST_ASSERT_EQUAL(i < 2 ? DT_DIR : DT_REG, ent.d_type);
+    }
+    TEST_ASSERT_EQUAL(0, dir.read(&ent));
+    TEST_ASSERT_EQUAL(0, dir.close());
+
+    TEST_ASSERT_EQUAL(0, dir.open(&fs, "fonts"));
+    TEST_ASSERT_EQUAL(1, dir.read(&ent));
+    TEST_ASSERT_EQUAL_STRING("README", ent.d_name);
+    TEST_ASSERT_EQUAL(0, dir.read(&ent));
+    TEST_ASSERT_EQUAL(0, dir.close());
+}
+
+// Mount an image programmed into a device that isn't memory mapped
+void test_block_device()
+{
+    HeapBlockDevice bd(2 * BLOCK_SIZE, BLOCK_SIZE);
+    TEST_ASSERT_EQUAL(0, bd.init());
+    uint8_t *block = new (std::nothrow) uint8_t[BLOCK_SIZE];
+    TEST_SKIP_UNLESS_MESSAGE(block, "Not enough heap memory to run test. Test skipped.");
+    memset(block, 0, BLOCK_SIZE);
+    memcpy(block, romfs_image, sizeof(romfs_image));
+    TEST_ASSERT_EQUAL(0, bd.program(block, 0, BLOCK_SIZE));
+    delete[] block;
+
+    ROMFileSystem fs("rom");
+    TEST_ASSERT_EQUAL(0, fs.mount(&bd));
+    TEST_ASSERT_FALSE(fs.is_mapped());
+    check_contents(fs);
+
+    File file;
+    const void *ptr;
+    TEST_ASSERT_NULL(fs.map("index.html"));
+    TEST_ASSERT_EQUAL(0, file.open(&fs, "index.html", O_RDONLY));
+    TEST_ASSERT_EQUAL(-ENOSYS, file.mmap(0, 1, &ptr));
+    TEST_ASSERT_EQUAL(0, file.close());
+    TEST_ASSERT_EQUAL(0, fs.unmount());
+}
+
+// Mount an image in memory and access it without copying
+void test_mapped()
+{
+    MappedBlockDevice bd;
+    ROMFileSystem fs("rom");
+    TEST_ASSERT_EQUAL(0, fs.mount(&bd));
+    TEST_ASSERT_TRUE(fs.is_mapped());
+    check_contents(fs);
+
+    size_t size = 0;
+    const char *data = static_cast<const char *>(fs.map("/index.html", &size));
+    TEST_ASSERT_NOT_NULL(data);
+    TEST_ASSERT_EQUAL(sizeof(index_html) - 1, size);
+    TEST_ASSERT_EQUAL_MEMORY(index_html, data, size);
+    TEST_ASSERT_NULL(fs.map("css"));
+
+    File file;
+    const void *ptr;
+    TEST_ASSERT_EQUAL(0, file.open(&fs, "css/site.css", O_RDONLY));
+    TEST_ASSERT_EQUAL(0, file.mmap(5, 4, &ptr));
+    TEST_ASSERT_EQUAL_MEMORY(site_css + 5, ptr, 4);
+    TEST_ASSERT_EQUAL(-EINVAL, file.mmap(5, sizeof(site_css), &ptr));
+    TEST_ASSERT_EQUAL(0, file.close());
+    TEST_ASSERT_EQUAL(0, fs.unmount());
+}
+
+// Anything but a valid image is refused
+void test_bad_image()
+{
+    HeapBlockDevice bd(2 * BLOCK_SIZE, BLOCK_SIZE);
+    TEST_ASSERT_EQUAL(0, bd.init());
+    uint8_t *block = new (std::nothrow) uint8_t[BLOCK_SIZE];
+    TEST_SKIP_UNLESS_MESSAGE(block, "Not enough heap memory to run test. Test skipped.");
+    memset(block, 0, BLOCK_SIZE);
+    memcpy(block, romfs_image, sizeof(romfs_image));
+    block[0] = 'X';
+    TEST_ASSERT_EQUAL(0, bd.program(block, 0, BLOCK_SIZE));
+    delete[] block;
+
+    ROMFileSystem fs("rom");
+    TEST_ASSERT_EQUAL(-EILSEQ, fs.mount(&bd));
+}
+
+utest::v1::status_t greentea_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(30, "default_auto");
+    return greentea_test_setup_handler(number_of_cases);
+}
+
+Case cases[] = {
+    Case("ROMFS: block device", test_block_device),
+    Case("ROMFS: memory mapped", test_mapped),
+    Case("ROMFS: bad image", test_bad_image),
+};
+
+Specification specification(greentea_setup, cases);
+
+int main()
+{
+    return !Harness::run(specification);
+}
@@ -0,0 +1,126 @@
+#!/usr/bin/env python3
+"""
+Pack a directory into an image for ROMFileSystem.
+
+    python3 mkromfs.py [--align 16] [--c-array name] html/ romfs.bin
+
+The image goes at the start of a block device, for example a slice of
+internal flash, or can be output as a C array to link into the firmware
+and mount with a memory-mapped block device. The layout is described in
+ROMFileSystem.h.
+
+Copyright (c) 2021, Arm Limited, All Rights Reserved
+SPDX-License-Identifier: Apache-2.0
+"""
+
+import argparse
+import os
+import struct
+import sys
+
+MAGIC = 0x53464D52  # "RMFS"
+VERSION = 1
+HEADER_SIZE = 32
+ENTRY_SIZE = 16
+FLAG_DIR = 0x1
+NAME_MAX = 255
+
+
+def sort_key(path):
+    # '/' sorts lower than any other character, so that the descendants
+    # of a directory immediately follow it
+    return path.encode('utf-8').replace(b'/', b'\x01')
+
+
+def collect(root):
+    """Return the relative paths of every directory and file under root."""
+    paths = []
+    for dirpath, dirnames, filenames in os.walk(root):
+        rel = os.path.relpath(dirpath, root)
+        rel = '' if rel == '.' else rel.replace(os.sep, '/')
+        for name in dirnames + filenames:
+            if len(name.encode('utf-8')) > NAME_MAX:
+                sys.exit('name too long: %s' % name)
+            path = rel + '/' + name if rel else name
+            paths.append((path, name in dirnames))
+    return sorted(paths, key=lambda p: sort_key(p[0]))
+
+
+def align_up(value, alignment):
+    return (value + alignment - 1) & ~(alignment - 1)
+
+
+def build(root, alignment):
+    paths = collect(root)
+
+    names = b''
+    name_offsets = []
+    for path, _ in paths:
+        name_offsets.append(len(names))
+        names += path.encode('utf-8') + b'\0'
+    names += b'\0'   # the root directory's empty name
+
+    entries_offset = HEADER_SIZE
+    names_offset = entries_offset + ENTRY_SIZE * len(paths)
+    offset = align_up(names_offset + len(names), alignment)
+
+    entries = b''
+    data = b''
+    for i, (path, is_dir) in enumerate(paths):
+        if is_dir:
+            prefix = path + '/'
+            count = 0
+            while i + 1 + count < len(paths) and paths[i + 1 + count][0].startswith(prefix):
+                count += 1
+            entries += struct.pack('<4I', name_offsets[i], FLAG_DIR, 0, count)
+        else:
+            with open(os.path.join(root, path), 'rb') as f:
+                contents = f.read()
+            entries += struct.pack('<4I', name_offsets[i], 0, offset + len(data), len(contents))
+            data += contents
+            data += b'\0' * (align_up(len(data), alignment) - len(data))
+
+    image_size = offset + len(data)
+    header = struct.pack('<8I', MAGIC, VERSION, image_size, len(paths),
+                         entries_offset, names_offset, len(names), alignment)
+    image = header + entries + names
+    image += b'\0' * (offset - len(image))
+    return image + data
+
+
+def c_array(image, name):
+    lines = ['/* Generated by mkromfs.py */',
+             '#include <stdint.h>',
+             '',
+             '__attribute__((aligned(16)))',
+             'const uint8_t %s[%d] = {' % (name, len(image))]
+    for i in range(0, len(image), 12):
+        lines.append('    ' + ' '.join('0x%02x,' % b for b in image[i:i + 12]))
+    lines.append('};')
+    return '\n'.join(lines) + '\n'
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Pack a directory into a ROMFileSystem image')
+    parser.add_argument('root', help='directory to pack')
+    parser.add_argument('output', help='image to write')
+    parser.add_argument('--align', type=int, default=16,
+                        help='alignment of the file data, a power of two (default 16)')
+    parser.add_argument('--c-array', metavar='NAME',
+                        help='write the image as a C array of that name instead of binary')
+    args = parser.parse_args()
+
+    if args.align < 4 or args.align & (args.align - 1):
+        sys.exit('alignment must be a power of two, at least 4')
+
+    image = build(args.root, args.align)
+    if args.c_array:
+        with open(args.output, 'w') as f:
+            f.write(c_array(image, args.c_array))
+    else:
+        with open(args.output, 'wb') as f:
+            f.write(image)
+
+
+if __name__ == '__main__':
+    main()
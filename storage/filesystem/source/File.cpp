@@ -75,6 +75,18 @@ ssize_t File::write(const void *buffer, size_t len)
     return _fs->file_write(_file, buffer, len);
 }
 
+ssize_t File::readv(const struct iovec *iov, int iovcnt)
+{
+    MBED_ASSERT(_fs);
+    return _fs->file_readv(_file, iov, iovcnt);
+}
+
+ssize_t File::writev(const struct iovec *iov, int iovcnt)
+{
+    MBED_ASSERT(_fs);
+    return _fs->file_writev(_file, iov, iovcnt);
+}
+
 int File::sync()
 {
     MBED_ASSERT(_fs);
@@ -117,4 +129,22 @@ int File::truncate(off_t length)
     return _fs->file_truncate(_file, length);
 }
 
+int File::preallocate(off_t length)
+{
+    MBED_ASSERT(_fs);
+    return _fs->file_preallocate(_file, length);
+}
+
+int File::fast_seek(bool enable)
+{
+    MBED_ASSERT(_fs);
+    return _fs->file_fast_seek(_file, enable);
+}
+
+int File::mmap(off_t offset, size_t size, const void **ptr)
+{
+    MBED_ASSERT(_fs);
+    return _fs->file_mmap(_file, offset, size, ptr);
+}
+
 } // namespace mbed
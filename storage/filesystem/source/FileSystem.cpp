@@ -57,6 +57,38 @@ int FileSystem::statvfs(const char *path, struct statvfs *buf)
     return -ENOSYS;
 }
 
+ssize_t FileSystem::file_readv(fs_file_t file, const struct iovec *iov, int iovcnt)
+{
+    ssize_t total = 0;
+    for (int i = 0; i < iovcnt; i++) {
+        ssize_t res = file_read(file, iov[i].iov_base, iov[i].iov_len);
+        if (res < 0) {
+            return total != 0 ? total : res;
+        }
+        total += res;
+        if ((size_t)res < iov[i].iov_len) {
+            break;
+        }
+    }
+    return total;
+}
+
+ssize_t FileSystem::file_writev(fs_file_t file, const struct iovec *iov, int iovcnt)
+{
+    ssize_t total = 0;
+    for (int i = 0; i < iovcnt; i++) {
+        ssize_t res = file_write(file, iov[i].iov_base, iov[i].iov_len);
+        if (res < 0) {
+            return total != 0 ? total : res;
+        }
+        total += res;
+        if ((size_t)res < iov[i].iov_len) {
+            break;
+        }
+    }
+    return total;
+}
+
 int FileSystem::file_sync(fs_file_t file)
 {
     return 0;
@@ -90,6 +122,21 @@ int FileSystem::file_truncate(fs_file_t file, off_t length)
     return -ENOSYS;
 }
 
+int FileSystem::file_preallocate(fs_file_t file, off_t length)
+{
+    return -ENOSYS;
+}
+
+int FileSystem::file_fast_seek(fs_file_t file, bool enable)
+{
+    return -ENOSYS;
+}
+
+int FileSystem::file_mmap(fs_file_t file, off_t offset, size_t size, const void **ptr)
+{
+    return -ENOSYS;
+}
+
 int FileSystem::dir_open(fs_dir_t *dir, const char *path)
 {
     return -ENOSYS;
@@ -0,0 +1,375 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "filesystem/ReadAheadFile.h"
+
+#if MBED_CONF_RTOS_PRESENT
+
+#include <errno.h>
+#include <string.h>
+#include <new>
+
+namespace mbed {
+
+ReadAheadFile::ReadAheadFile(size_t block_size, size_t block_count, osPriority priority, uint32_t stack_size)
+    : _cond(_mutex), _thread(NULL), _block_size(block_size), _block_count(block_count),
+      _priority(priority), _stack_size(stack_size), _buffer(NULL), _lengths(NULL),
+      _pos(0), _fetch_pos(0), _generation(0), _head(0), _head_offset(0), _filled(0),
+      _sequential(0), _err(0), _streaming(false), _eof(false), _exit(false)
+{
+}
+
+ReadAheadFile::~ReadAheadFile()
+{
+    if (_thread) {
+        close();
+    }
+}
+
+int ReadAheadFile::open(FileSystem *fs, const char *path, int flags)
+{
+    if (!_block_size || !_block_count) {
+        return -EINVAL;
+    }
+
+    int err = File::open(fs, path, flags);
+    if (err) {
+        return err;
+    }
+
+    _buffer = new (std::nothrow) uint8_t[_block_size * _block_count];
+    _lengths = new (std::nothrow) size_t[_block_count];
+    if (!_buffer || !_lengths) {
+        err = -ENOMEM;
+        goto fail;
+    }
+
+    _pos = File::tell();
+    _exit = false;
+    flush_ahead();
+
+    _thread = new (std::nothrow) rtos::Thread(_priority, _stack_size, NULL, "read_ahead");
+    if (!_thread || _thread->start(mbed::callback(this, &ReadAheadFile::worker)) != osOK) {
+        delete _thread;
+        _thread = NULL;
+        err = -ENOMEM;
+        goto fail;
+    }
+
+    return 0;
+
+fail:
+    delete[] _buffer;
+    _buffer = NULL;
+    delete[] _lengths;
+    _lengths = NULL;
+    File::close();
+    return err;
+}
+
+int ReadAheadFile::close()
+{
+    if (!_thread) {
+        return -EINVAL;
+    }
+
+    _mutex.lock();
+    flush_ahead();
+    _exit = true;
+    _cond.notify_all();
+    _mutex.unlock();
+
+    _thread->join();
+    delete _thread;
+    _thread = NULL;
+
+    delete[] _buffer;
+    _buffer = NULL;
+    delete[] _lengths;
+    _lengths = NULL;
+
+    return File::close();
+}
+
+ssize_t ReadAheadFile::read(void *buffer, size_t size)
+{
+    uint8_t *data = static_cast<uint8_t *>(buffer);
+
+    _mutex.lock();
+    if (_streaming) {
+        size_t count = read_ahead(data, size);
+        if (count || !_err) {
+            _mutex.unlock();
+            return count;
+        }
+
+        // Prefetch failed, retry directly so the caller gets the error
+        flush_ahead();
+    }
+
+    _io_mutex.lock();
+    ssize_t res = sync_position();
+    if (!res) {
+        res = File::read(data, size);
+    }
+    if (res > 0) {
+        _pos += res;
+    }
+    _io_mutex.unlock();
+
+    // A short read means we hit the end of the file, nothing to prefetch
+    if (res > 0 && (size_t)res == size) {
+        _sequential += 1;
+        if (_sequential >= MBED_CONF_READ_AHEAD_FILE_TRIGGER) {
+            _streaming = true;
+            _fetch_pos = _pos;
+            _cond.notify_all();
+        }
+    }
+    _mutex.unlock();
+
+    return res;
+}
+
+ssize_t ReadAheadFile::write(const void *buffer, size_t size)
+{
+    _mutex.lock();
+    flush_ahead();
+
+    _io_mutex.lock();
+    ssize_t res = sync_position();
+    if (!res) {
+        res = File::write(buffer, size);
+    }
+    // Files opened with O_APPEND write at the end regardless of our position
+    off_t pos = File::tell();
+    if (pos >= 0) {
+        _pos = pos;
+    }
+    _io_mutex.unlock();
+
+    _mutex.unlock();
+    return res;
+}
+
+int ReadAheadFile::sync()
+{
+    _io_mutex.lock();
+    int err = File::sync();
+    _io_mutex.unlock();
+    return err;
+}
+
+off_t ReadAheadFile::seek(off_t offset, int whence)
+{
+    _mutex.lock();
+    if (whence == SEEK_CUR) {
+        offset += _pos;
+        whence = SEEK_SET;
+    }
+
+    if (whence == SEEK_SET && offset == _pos) {
+        _mutex.unlock();
+        return _pos;
+    }
+
+    // Seeking forward into buffered data just skips over it
+    if (_streaming && whence == SEEK_SET && offset > _pos) {
+        size_t buffered = 0;
+        for (size_t i = 0; i < _filled; i++) {
+            buffered += _lengths[(_head + i) % _block_count];
+        }
+        buffered -= _head_offset;
+
+        if ((size_t)(offset - _pos) <= buffered) {
+            read_ahead(NULL, offset - _pos);
+            _mutex.unlock();
+            return _pos;
+        }
+    }
+
+    flush_ahead();
+
+    _io_mutex.lock();
+    off_t res = File::seek(offset, whence);
+    if (res >= 0) {
+        _pos = res;
+    }
+    _io_mutex.unlock();
+
+    _mutex.unlock();
+    return res;
+}
+
+off_t ReadAheadFile::tell()
+{
+    _mutex.lock();
+    off_t pos = _pos;
+    _mutex.unlock();
+    return pos;
+}
+
+void ReadAheadFile::rewind()
+{
+    seek(0, SEEK_SET);
+}
+
+off_t ReadAheadFile::size()
+{
+    _io_mutex.lock();
+    off_t size = File::size();
+    _io_mutex.unlock();
+    return size;
+}
+
+int ReadAheadFile::truncate(off_t length)
+{
+    _mutex.lock();
+    flush_ahead();
+
+    _io_mutex.lock();
+    int err = File::truncate(length);
+    _io_mutex.unlock();
+
+    _mutex.unlock();
+    return err;
+}
+
+int ReadAheadFile::preallocate(off_t length)
+{
+    _mutex.lock();
+    flush_ahead();
+
+    _io_mutex.lock();
+    int err = File::preallocate(length);
+    _io_mutex.unlock();
+
+    _mutex.unlock();
+    return err;
+}
+
+int ReadAheadFile::fast_seek(bool enable)
+{
+    _io_mutex.lock();
+    int err = File::fast_seek(enable);
+    _io_mutex.unlock();
+    return err;
+}
+
+void ReadAheadFile::flush_ahead()
+{
+    // Anything the worker is fetching right now is discarded when it sees
+    // the generation change
+    _generation += 1;
+    _streaming = false;
+    _sequential = 0;
+    _head = 0;
+    _head_offset = 0;
+    _filled = 0;
+    _eof = false;
+    _err = 0;
+}
+
+size_t ReadAheadFile::read_ahead(uint8_t *buffer, size_t size)
+{
+    size_t count = 0;
+
+    while (count < size) {
+        if (_filled) {
+            size_t len = _lengths[_head] - _head_offset;
+            if (len > size - count) {
+                len = size - count;
+            }
+
+            if (buffer) {
+                memcpy(&buffer[count], &_buffer[_head * _block_size + _head_offset], len);
+            }
+            count += len;
+            _pos += len;
+            _head_offset += len;
+
+            if (_head_offset == _lengths[_head]) {
+                _head = (_head + 1) % _block_count;
+                _head_offset = 0;
+                _filled -= 1;
+                _cond.notify_all();
+            }
+        } else if (_eof || _err) {
+            break;
+        } else {
+            _cond.wait();
+        }
+    }
+
+    return count;
+}
+
+int ReadAheadFile::sync_position()
+{
+    // The worker moves the underlying file around while prefetching
+    off_t res = File::seek(_pos, SEEK_SET);
+    return res < 0 ? res : 0;
+}
+
+void ReadAheadFile::worker()
+{
+    _mutex.lock();
+    while (!_exit) {
+        if (!_streaming || _eof || _err || _filled == _block_count) {
+            _cond.wait();
+            continue;
+        }
+
+        uint32_t generation = _generation;
+        off_t pos = _fetch_pos;
+        size_t slot = (_head + _filled) % _block_count;
+        _mutex.unlock();
+
+        // Only the worker writes to free slots, so the buffer can be
+        // filled without holding the state lock
+        _io_mutex.lock();
+        ssize_t res = File::seek(pos, SEEK_SET);
+        if (res >= 0) {
+            res = File::read(&_buffer[slot * _block_size], _block_size);
+        }
+        _io_mutex.unlock();
+
+        _mutex.lock();
+        if (generation != _generation) {
+            continue;
+        }
+
+        if (res < 0) {
+            _err = res;
+        } else {
+            if (res > 0) {
+                _lengths[slot] = res;
+                _filled += 1;
+                _fetch_pos += res;
+            }
+            if ((size_t)res < _block_size) {
+                _eof = true;
+            }
+        }
+        _cond.notify_all();
+    }
+    _mutex.unlock();
+}
+
+} // namespace mbed
+
+#endif // MBED_CONF_RTOS_PRESENT
@@ -0,0 +1,155 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "greentea-client/test_env.h"
+#include "unity/unity.h"
+#include "utest/utest.h"
+
+#include "HeapBlockDevice.h"
+#include "LittleFileSystem2.h"
+#include "ReadAheadFile.h"
+#include <stdlib.h>
+
+using namespace utest::v1;
+using namespace mbed;
+
+#if !MBED_CONF_RTOS_PRESENT
+#error [NOT_SUPPORTED] Read-ahead requires RTOS
+#else
+
+#define BLOCK_SIZE 512
+#define BLOCK_COUNT 64
+#define FILE_SIZE (10 * 512 + 100)
+#define CHUNK_SIZE 37
+
+static HeapBlockDevice *bd = NULL;
+static LittleFileSystem2 *fs = NULL;
+
+static uint8_t pattern(off_t pos)
+{
+    return (uint8_t)(pos * 7 + (pos >> 8));
+}
+
+// Create a file with a known pattern to read back
+void test_setup_file()
+{
+    bd = new (std::nothrow) HeapBlockDevice(BLOCK_COUNT * BLOCK_SIZE, BLOCK_SIZE);
+    TEST_SKIP_UNLESS_MESSAGE(bd, "Not enough heap memory to run test. Test skipped.");
+
+    fs = new LittleFileSystem2("lfs");
+    TEST_ASSERT_EQUAL(0, LittleFileSystem2::format(bd));
+    TEST_ASSERT_EQUAL(0, fs->mount(bd));
+
+    File file;
+    TEST_ASSERT_EQUAL(0, file.open(fs, "stream", O_WRONLY | O_CREAT));
+    for (off_t i = 0; i < FILE_SIZE; i++) {
+        uint8_t c = pattern(i);
+        TEST_ASSERT_EQUAL(1, file.write(&c, 1));
+    }
+    TEST_ASSERT_EQUAL(0, file.close());
+}
+
+// Read the whole file sequentially in odd sized chunks
+void test_sequential_read()
+{
+    TEST_SKIP_UNLESS_MESSAGE(bd, "Not enough heap memory to run test. Test skipped.");
+
+    ReadAheadFile file(128, 3);
+    TEST_ASSERT_EQUAL(0, file.open(fs, "stream", O_RDONLY));
+
+    uint8_t buffer[CHUNK_SIZE];
+    off_t pos = 0;
+    while (true) {
+        ssize_t res = file.read(buffer, sizeof(buffer));
+        TEST_ASSERT(res >= 0);
+        if (res == 0) {
+            break;
+        }
+
+        for (ssize_t i = 0; i < res; i++) {
+            TEST_ASSERT_EQUAL(pattern(pos + i), buffer[i]);
+        }
+        pos += res;
+        TEST_ASSERT_EQUAL(pos, file.tell());
+    }
+    TEST_ASSERT_EQUAL(FILE_SIZE, pos);
+
+    TEST_ASSERT_EQUAL(0, file.close());
+}
+
+// Seeks inside and outside the prefetched data
+void test_seek_while_streaming()
+{
+    TEST_SKIP_UNLESS_MESSAGE(bd, "Not enough heap memory to run test. Test skipped.");
+
+    ReadAheadFile file(128, 3);
+    TEST_ASSERT_EQUAL(0, file.open(fs, "stream", O_RDWR));
+
+    uint8_t buffer[CHUNK_SIZE];
+    for (int i = 0; i < 4; i++) {
+        TEST_ASSERT_EQUAL(sizeof(buffer), file.read(buffer, sizeof(buffer)));
+    }
+
+    const off_t targets[] = {4 * CHUNK_SIZE + 10, 3000, 100, FILE_SIZE - 5};
+    for (size_t t = 0; t < sizeof(targets) / sizeof(targets[0]); t++) {
+        TEST_ASSERT_EQUAL(targets[t], file.seek(targets[t], SEEK_SET));
+
+        ssize_t res = file.read(buffer, sizeof(buffer));
+        TEST_ASSERT(res > 0);
+        for (ssize_t i = 0; i < res; i++) {
+            TEST_ASSERT_EQUAL(pattern(targets[t] + i), buffer[i]);
+        }
+    }
+
+    // Writes must be visible to reads that follow
+    uint8_t c = 0x5a;
+    TEST_ASSERT_EQUAL(200, file.seek(200, SEEK_SET));
+    TEST_ASSERT_EQUAL(1, file.write(&c, 1));
+    TEST_ASSERT_EQUAL(199, file.seek(-2, SEEK_CUR));
+    TEST_ASSERT_EQUAL(3, file.read(buffer, 3));
+    TEST_ASSERT_EQUAL(pattern(199), buffer[0]);
+    TEST_ASSERT_EQUAL(0x5a, buffer[1]);
+    TEST_ASSERT_EQUAL(pattern(201), buffer[2]);
+
+    TEST_ASSERT_EQUAL(0, file.close());
+
+    TEST_ASSERT_EQUAL(0, fs->unmount());
+    delete fs;
+    fs = NULL;
+    delete bd;
+    bd = NULL;
+}
+
+utest::v1::status_t test_setup(const size_t number_of_cases)
+{
+    GREENTEA_SETUP(30, "default_auto");
+    return verbose_test_setup_handler(number_of_cases);
+}
+
+Case cases[] = {
+    Case("Read ahead: setup file", test_setup_file),
+    Case("Read ahead: sequential read", test_sequential_read),
+    Case("Read ahead: seek while streaming", test_seek_while_streaming),
+};
+
+Specification specification(test_setup, cases);
+
+int main()
+{
+    return !Harness::run(specification);
+}
+
+#endif // !MBED_CONF_RTOS_PRESENT
@@ -21,12 +21,29 @@
 #include "kvstore/KVStore.h"
 #include "filesystem/FileSystem.h"
 
+/** Values of at most this size (in bytes) are appended to a single packed file,
+ *  next to the FileSystemStore folder, instead of taking a file each.
+ *  0 keeps a file per key. Values already in the packed file stay readable either way.
+ */
+#ifndef MBED_CONF_FILESYSTEMSTORE_PACKED_VALUE_MAX_SIZE
+#define MBED_CONF_FILESYSTEMSTORE_PACKED_VALUE_MAX_SIZE 0
+#endif
+
+/** Packed file size (in bytes) from which it is compacted, once at least half of it is stale. */
+#ifndef MBED_CONF_FILESYSTEMSTORE_PACKED_COMPACT_THRESHOLD
+#define MBED_CONF_FILESYSTEMSTORE_PACKED_COMPACT_THRESHOLD 4096
+#endif
+
 namespace mbed {
 
 /** FileSystemStore for Secure Store.
  *  This class implements the KVStore interface to
  *  create a key value store over FileSystem.
  *
+ *  All keys are listed in a RAM directory, sorted by name and built on init,
+ *  so get_info() and lookups of missing keys don't touch the file system.
+ *  It costs strlen(key) + 1 bytes of heap, plus a 16-byte entry, per key.
+ *
  *  @code
  *  ...
  *  @endcode
@@ -253,6 +270,54 @@ private:
      */
     int _verify_key_file(const char *key, key_metadata_t *key_metadata, File *kv_file);
 
+    // Entry of the RAM key directory
+    typedef struct {
+        char *key;
+        uint32_t data_size;
+        uint32_t user_flags;
+        uint32_t packed_offset; /* Offset of the value in the packed file, or a key file marker */
+    } key_entry_t;
+
+    /**
+     * @brief Binary search the key directory
+     *
+     * @param[in]  key                  Key.
+     * @param[out] index                Index of the key, or where to insert it if not found.
+     *
+     * @returns MBED_SUCCESS or MBED_ERROR_ITEM_NOT_FOUND
+     */
+    int _find_key(const char *key, size_t &index);
+
+    // Insert a key in the directory at the index returned by _find_key(), leaving its other fields to the caller
+    key_entry_t *_insert_key(size_t index, const char *key);
+
+    // Remove a key from the directory
+    void _remove_key(size_t index);
+
+    // Build the key directory from the packed file and the key files
+    int _build_key_dir();
+
+    // Free the key directory and close the packed file
+    void _free_resources();
+
+    // Open the packed file, finishing an interrupted compaction, and read its records
+    int _open_packed_file();
+
+    // Apply one record read from the packed file to the key directory
+    void _apply_packed_record(const char *key, uint32_t flags, uint32_t data_size, uint32_t data_offset);
+
+    // Append a record to the packed file, returning the offset of its value
+    int _packed_append(const char *key, const void *data, uint32_t data_size, uint32_t flags, uint32_t &data_offset);
+
+    // Store a value in the packed file and update its key directory entry
+    int _packed_set(const char *key, const void *data, uint32_t data_size, uint32_t flags);
+
+    // Remove a packed key, appending a delete record
+    int _packed_remove(size_t index);
+
+    // Copy the live records to a new packed file, if at least half of the current one is stale
+    int _packed_compact();
+
     FileSystem *_fs;
     PlatformMutex _mutex;
     PlatformMutex _inc_data_add_mutex;
@@ -263,6 +328,14 @@ private:
     char *_full_path_key; /* Full name of Key file currently working on */
     size_t _cur_inc_data_size; /* Amount of data added to Key file so far, during incremental add data */
     set_handle_t _cur_inc_set_handle; /* handle of currently key file under incremental set process */
+    key_entry_t *_key_dir; /* RAM key directory, sorted by key */
+    size_t _num_keys;
+    size_t _max_keys;
+    char *_packed_path; /* Packed file path name on FileSystem */
+    char *_packed_tmp_path; /* Path name of the packed file being written by a compaction */
+    File *_packed_file; /* Open packed file, NULL if there is none */
+    uint32_t _packed_size; /* End of the last valid record of the packed file */
+    uint32_t _packed_live_size; /* Total size of the records of the keys still packed */
 #endif
 };
 
@@ -21,7 +21,9 @@
 #include "filesystem/Dir.h"
 #include "filesystem/File.h"
 #include "blockdevice/BlockDevice.h"
+#include "MbedCRC.h"
 #include "mbed_error.h"
+#include <algorithm>
 #include <string.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -32,7 +34,12 @@
 #define FSST_REVISION 1
 #define FSST_MAGIC 0x46535354 // "FSST" hex 'magic' signature
 
+#define FSST_PACKED_MAGIC 0x46535350 // "FSSP" hex 'magic' signature of packed file records
+
 #define FSST_DEFAULT_FOLDER_PATH "kvstore" //default FileSystemStore folder path on fs
+// Packed file and compaction output, next to the folder so they are never listed as keys
+#define FSST_PACKED_FILE_SUFFIX ".pack"
+#define FSST_PACKED_TMP_FILE_SUFFIX ".pack.tmp"
 
 // Only write once flag is supported, other two are kept in storage but ignored
 static const uint32_t supported_flags = mbed::KVStore::WRITE_ONCE_FLAG | mbed::KVStore::REQUIRE_CONFIDENTIALITY_FLAG |
@@ -48,24 +55,62 @@ typedef struct {
     uint32_t create_flags;
     size_t data_size;
     File *file_handle;
+    uint8_t *packed_buf; // Value collected in RAM, for the packed file
 } inc_set_handle_t;
 
 // iterator handle
 typedef struct {
-    void *dir_handle;
     char *prefix;
+    char *last_key; // Key returned by the previous iterator_next, NULL before the first one
 } key_iterator_handle_t;
 
+// Packed file record, followed by the key and the value
+typedef struct {
+    uint32_t magic;
+    uint16_t key_size;
+    uint16_t reserved;
+    uint32_t flags;
+    uint32_t data_size;
+    uint32_t crc; // Of the record with this field zeroed, the key and the value
+} packed_record_t;
+
+// Key directory locations other than a packed file offset
+const uint32_t key_in_file = 0xFFFFFFFF;
+const uint32_t key_in_invalid_file = 0xFFFFFFFE;
+
+// Packed record of a removed key
+const uint32_t packed_delete_flag = (1UL << 31);
+
+const size_t initial_max_keys = 16;
+const size_t copy_chunk_size = 64;
+const uint32_t initial_crc = 0xFFFFFFFF;
+
 } // anonymous namespace
 
 // Local Functions
 static char *string_ndup(const char *src, size_t size);
+static char *path_with_suffix(const char *path, size_t path_size, const char *suffix);
+
+static uint32_t calc_crc(uint32_t init_crc, uint32_t data_size, const void *data_buf)
+{
+    uint32_t crc;
+    MbedCRC<POLY_32BIT_ANSI, 32> ct(init_crc, 0x0, true, false);
+    ct.compute(data_buf, data_size, &crc);
+    return crc;
+}
+
+static uint32_t packed_record_size(size_t key_size, uint32_t data_size)
+{
+    return sizeof(packed_record_t) + key_size + data_size;
+}
 
 
 // Class Functions
 FileSystemStore::FileSystemStore(FileSystem *fs) : _fs(fs),
     _is_initialized(false), _cfg_fs_path(NULL), _cfg_fs_path_size(0),
-    _full_path_key(NULL), _cur_inc_data_size(0), _cur_inc_set_handle(NULL)
+    _full_path_key(NULL), _cur_inc_data_size(0), _cur_inc_set_handle(NULL),
+    _key_dir(NULL), _num_keys(0), _max_keys(0), _packed_path(NULL), _packed_tmp_path(NULL),
+    _packed_file(NULL), _packed_size(0), _packed_live_size(0)
 {
 
 }
@@ -75,6 +120,11 @@ int FileSystemStore::init()
     int status = MBED_SUCCESS;
 
     _mutex.lock();
+    if (_is_initialized) {
+        _mutex.unlock();
+        return status;
+    }
+
     const char *temp_path = get_filesystemstore_folder_path();
     if (temp_path == NULL) {
         _cfg_fs_path_size = strlen(FSST_DEFAULT_FOLDER_PATH);
@@ -88,24 +138,36 @@ int FileSystemStore::init()
     memset(_full_path_key, 0, (_cfg_fs_path_size + KVStore::MAX_KEY_SIZE + 1));
     strncpy(_full_path_key, _cfg_fs_path, _cfg_fs_path_size);
     _full_path_key[_cfg_fs_path_size] = '/';
+    _packed_path = path_with_suffix(_cfg_fs_path, _cfg_fs_path_size, FSST_PACKED_FILE_SUFFIX);
+    _packed_tmp_path = path_with_suffix(_cfg_fs_path, _cfg_fs_path_size, FSST_PACKED_TMP_FILE_SUFFIX);
     _cur_inc_data_size = 0;
     _cur_inc_set_handle = NULL;
-    Dir kv_dir;
 
-    if (kv_dir.open(_fs, _cfg_fs_path) != 0) {
-        tr_info("KV Dir: %s, doesnt exist - creating new.. ", _cfg_fs_path); //TBD verify ERRNO NOEXIST
-        if (_fs->mkdir(_cfg_fs_path,/* which flags ? */0777) != 0) {
-            tr_error("KV Dir: %s, mkdir failed.. ", _cfg_fs_path); //TBD verify ERRNO NOEXIST
-            status = MBED_ERROR_FAILED_OPERATION;
-            goto exit_point;
-        }
-    } else {
-        tr_info("KV Dir: %s, exists(verified) - now closing it", _cfg_fs_path);
-        if (kv_dir.close() != 0) {
-            tr_error("KV Dir: %s, dir_close failed", _cfg_fs_path); //TBD verify ERRNO NOEXIST
+    {
+        Dir kv_dir;
+
+        if (kv_dir.open(_fs, _cfg_fs_path) != 0) {
+            tr_info("KV Dir: %s, doesnt exist - creating new.. ", _cfg_fs_path); //TBD verify ERRNO NOEXIST
+            if (_fs->mkdir(_cfg_fs_path,/* which flags ? */0777) != 0) {
+                tr_error("KV Dir: %s, mkdir failed.. ", _cfg_fs_path); //TBD verify ERRNO NOEXIST
+                status = MBED_ERROR_FAILED_OPERATION;
+                goto exit_point;
+            }
+        } else {
+            tr_info("KV Dir: %s, exists(verified) - now closing it", _cfg_fs_path);
+            if (kv_dir.close() != 0) {
+                tr_error("KV Dir: %s, dir_close failed", _cfg_fs_path); //TBD verify ERRNO NOEXIST
+            }
         }
     }
 
+    status = _build_key_dir();
+    if (status != MBED_SUCCESS) {
+        tr_error("KV Dir: %s, building key directory failed", _cfg_fs_path);
+        _free_resources();
+        goto exit_point;
+    }
+
     _is_initialized = true;
 exit_point:
 
@@ -119,8 +181,7 @@ int FileSystemStore::deinit()
 {
     _mutex.lock();
     _is_initialized = false;
-    delete[] _cfg_fs_path;
-    delete[] _full_path_key;
+    _free_resources();
     _mutex.unlock();
     return MBED_SUCCESS;
 
@@ -151,6 +212,18 @@ int FileSystemStore::reset()
 
     kv_dir.close();
 
+    while (_num_keys) {
+        _remove_key(_num_keys - 1);
+    }
+
+    if (_packed_file != NULL) {
+        if ((_packed_file->truncate(0) != 0) || (_packed_file->sync() != 0)) {
+            status = MBED_ERROR_FAILED_OPERATION;
+        }
+        _packed_size = 0;
+        _packed_live_size = 0;
+    }
+
 exit_point:
     _mutex.unlock();
     return status;
@@ -202,6 +275,8 @@ int FileSystemStore::get(const char *key, void *buffer, size_t buffer_size, size
     File kv_file;
     size_t kv_file_size = 0;
     size_t value_actual_size = 0;
+    size_t index;
+    key_entry_t *entry;
 
     _mutex.lock();
 
@@ -210,14 +285,32 @@ int FileSystemStore::get(const char *key, void *buffer, size_t buffer_size, size
         goto exit_point;
     }
 
-    key_metadata_t key_metadata;
+    if (!is_valid_key(key)) {
+        status = MBED_ERROR_INVALID_ARGUMENT;
+        goto exit_point;
+    }
 
-    if ((status = _verify_key_file(key, &key_metadata, &kv_file)) != MBED_SUCCESS) {
-        tr_debug("File Verification failed, status: %d", status);
+    if (_find_key(key, index) != MBED_SUCCESS) {
+        status = MBED_ERROR_ITEM_NOT_FOUND;
         goto exit_point;
     }
+    entry = &_key_dir[index];
+
+    key_metadata_t key_metadata;
+
+    if (entry->packed_offset < key_in_invalid_file) {
+        // Packed value, read straight from the already open packed file
+        key_metadata.metadata_size = 0;
+        kv_file_size = entry->data_size;
+    } else {
+        if ((status = _verify_key_file(key, &key_metadata, &kv_file)) != MBED_SUCCESS) {
+            tr_debug("File Verification failed, status: %d", status);
+            goto exit_point;
+        }
+
+        kv_file_size = kv_file.size() - key_metadata.metadata_size;
+    }
 
-    kv_file_size = kv_file.size() - key_metadata.metadata_size;
     // Actual size is the minimum of buffer_size and remainder of data in file (file's data size - offset)
     value_actual_size = buffer_size;
     if (offset > kv_file_size) {
@@ -236,6 +329,14 @@ int FileSystemStore::get(const char *key, void *buffer, size_t buffer_size, size
         *actual_size = value_actual_size;
     }
 
+    if (entry->packed_offset < key_in_invalid_file) {
+        _packed_file->seek(entry->packed_offset + offset, SEEK_SET);
+        if (_packed_file->read(buffer, value_actual_size) != (ssize_t) value_actual_size) {
+            status = MBED_ERROR_READ_FAILED;
+        }
+        goto exit_point;
+    }
+
     kv_file.seek(key_metadata.metadata_size + offset, SEEK_SET);
     // Read remainder of data
     kv_file.read(buffer, value_actual_size);
@@ -253,7 +354,7 @@ exit_point:
 int FileSystemStore::get_info(const char *key, info_t *info)
 {
     int status = MBED_SUCCESS;
-    File kv_file;
+    size_t index;
 
     _mutex.lock();
 
@@ -262,23 +363,28 @@ int FileSystemStore::get_info(const char *key, info_t *info)
         goto exit_point;
     }
 
-    key_metadata_t key_metadata;
+    if (!is_valid_key(key)) {
+        status = MBED_ERROR_INVALID_ARGUMENT;
+        goto exit_point;
+    }
 
-    if ((status = _verify_key_file(key, &key_metadata, &kv_file)) != MBED_SUCCESS) {
-        tr_debug("File Verification failed, status: %d", status);
+    // Served from the key directory, without opening the key file
+    if (_find_key(key, index) != MBED_SUCCESS) {
+        status = MBED_ERROR_ITEM_NOT_FOUND;
+        goto exit_point;
+    }
+
+    if (_key_dir[index].packed_offset == key_in_invalid_file) {
+        status = MBED_ERROR_INVALID_DATA_DETECTED;
         goto exit_point;
     }
 
     if (info != NULL) {
-        info->size = kv_file.size() - key_metadata.metadata_size;
-        info->flags = key_metadata.user_flags;
+        info->size = _key_dir[index].data_size;
+        info->flags = _key_dir[index].user_flags;
     }
 
 exit_point:
-    if ((status == MBED_SUCCESS) ||
-            (status == MBED_ERROR_INVALID_DATA_DETECTED)) {
-        kv_file.close();
-    }
     _mutex.unlock();
 
     return status;
@@ -286,8 +392,8 @@ exit_point:
 
 int FileSystemStore::remove(const char *key)
 {
-    File kv_file;
-    key_metadata_t key_metadata;
+    size_t index;
+    key_entry_t *entry;
 
     _mutex.lock();
 
@@ -298,24 +404,36 @@ int FileSystemStore::remove(const char *key)
         goto exit_point;
     }
 
-    /* If File Exists and is Valid, then check its Write Once Flag to verify its disabled before removing */
-    /* If File exists and is not valid, or is Valid and not Write-Onced then remove it */
-    if ((status = _verify_key_file(key, &key_metadata, &kv_file)) == MBED_SUCCESS) {
-        if (key_metadata.user_flags & KVStore::WRITE_ONCE_FLAG) {
-            kv_file.close();
-            tr_error("File: %s, Exists but write protected", _full_path_key);
-            status = MBED_ERROR_WRITE_PROTECTED;
-            goto exit_point;
-        }
-    } else if ((status == MBED_ERROR_ITEM_NOT_FOUND) ||
-               (status == MBED_ERROR_INVALID_ARGUMENT)) {
+    if (!is_valid_key(key)) {
+        status = MBED_ERROR_INVALID_ARGUMENT;
+        goto exit_point;
+    }
+
+    if (_find_key(key, index) != MBED_SUCCESS) {
+        status = MBED_ERROR_ITEM_NOT_FOUND;
         goto exit_point;
     }
-    kv_file.close();
+    entry = &_key_dir[index];
 
+    /* If Key is Valid, then check its Write Once Flag to verify its disabled before removing */
+    /* If File is not valid, or is Valid and not Write-Onced then remove it */
+    if ((entry->packed_offset != key_in_invalid_file) && (entry->user_flags & KVStore::WRITE_ONCE_FLAG)) {
+        tr_error("Key: %s, Exists but write protected", key);
+        status = MBED_ERROR_WRITE_PROTECTED;
+        goto exit_point;
+    }
+
+    if (entry->packed_offset < key_in_invalid_file) {
+        status = _packed_remove(index);
+        goto exit_point;
+    }
+
+    _build_full_path_key(key);
     if (0 != _fs->remove(_full_path_key)) {
         status =  MBED_ERROR_FAILED_OPERATION;
+        goto exit_point;
     }
+    _remove_key(index);
 
 exit_point:
     _mutex.unlock();
@@ -327,9 +445,11 @@ int FileSystemStore::set_start(set_handle_t *handle, const char *key, size_t fin
 {
     int status = MBED_SUCCESS;
     inc_set_handle_t *set_handle = NULL;
-    File *kv_file;
+    File *kv_file = NULL;
     key_metadata_t key_metadata;
     int key_len = 0;
+    size_t index;
+    bool key_found;
 
     if (create_flags & ~supported_flags) {
         return MBED_ERROR_INVALID_ARGUMENT;
@@ -338,60 +458,65 @@ int FileSystemStore::set_start(set_handle_t *handle, const char *key, size_t fin
     // Only a single key file can be incrementaly editted at a time
     _mutex.lock();
 
-    kv_file = new File;
-
-    if (handle == NULL) {
+    if ((handle == NULL) || !is_valid_key(key)) {
         status = MBED_ERROR_INVALID_ARGUMENT;
         goto exit_point;
     }
 
-    /* If File Exists and is Valid, then check its Write Once Flag to verify its disabled before setting */
-    /* If File exists and is not valid, or is Valid and not Write-Onced then erase it */
-    status = _verify_key_file(key, &key_metadata, kv_file);
-
-    if (status == MBED_ERROR_INVALID_ARGUMENT) {
-        tr_error("File Verification failed, status: %d", status);
+    /* If Key Exists and is Valid, then check its Write Once Flag to verify its disabled before setting */
+    key_found = (_find_key(key, index) == MBED_SUCCESS);
+    if (key_found && (_key_dir[index].packed_offset != key_in_invalid_file) &&
+            (_key_dir[index].user_flags & KVStore::WRITE_ONCE_FLAG)) {
+        status = MBED_ERROR_WRITE_PROTECTED;
         goto exit_point;
     }
 
-    if (status == MBED_SUCCESS) {
-        if (key_metadata.user_flags & KVStore::WRITE_ONCE_FLAG) {
-            kv_file->close();
-            status = MBED_ERROR_WRITE_PROTECTED;
+    if ((MBED_CONF_FILESYSTEMSTORE_PACKED_VALUE_MAX_SIZE > 0) &&
+            (final_data_size <= MBED_CONF_FILESYSTEMSTORE_PACKED_VALUE_MAX_SIZE)) {
+        // Small value, collected in RAM and appended to the packed file by set_finalize
+        set_handle = new inc_set_handle_t;
+        set_handle->file_handle = NULL;
+        set_handle->packed_buf = new uint8_t[final_data_size];
+    } else {
+        // Going to a key file, so drop the packed value first: the packed file wins over key files on init
+        if (key_found && (_key_dir[index].packed_offset < key_in_invalid_file)) {
+            status = _packed_remove(index);
+            if (status != MBED_SUCCESS) {
+                goto exit_point;
+            }
+        }
+
+        /* If File exists and is not valid, or is Valid and not Write-Onced then truncate it */
+        kv_file = new File;
+        _build_full_path_key(key);
+        if ((status = kv_file->open(_fs, _full_path_key, O_WRONLY | O_CREAT | O_TRUNC)) != MBED_SUCCESS) {
+            tr_info("set_start failed to open: %s, for writing, err: %d", _full_path_key, status);
+            status = MBED_ERROR_FAILED_OPERATION ;
+            delete kv_file;
             goto exit_point;
         }
-    }
 
-    /* For Success (not write_once) and for corrupted data close file before recreating it as a new file */
-    if (status != MBED_ERROR_ITEM_NOT_FOUND) {
-        kv_file->close();
-    }
+        key_metadata.magic = FSST_MAGIC;
+        key_metadata.metadata_size = sizeof(key_metadata_t);
+        key_metadata.revision = FSST_REVISION;
+        key_metadata.user_flags = create_flags;
+        kv_file->write(&key_metadata, sizeof(key_metadata_t));
 
-    if ((status = kv_file->open(_fs, _full_path_key, O_WRONLY | O_CREAT | O_TRUNC)) != MBED_SUCCESS) {
-        tr_info("set_start failed to open: %s, for writing, err: %d", _full_path_key, status);
-        status = MBED_ERROR_FAILED_OPERATION ;
-        goto exit_point;
+        set_handle = new inc_set_handle_t;
+        set_handle->file_handle = kv_file;
+        set_handle->packed_buf = NULL;
     }
     _cur_inc_data_size = 0;
 
-    set_handle = new inc_set_handle_t;
     set_handle->create_flags = create_flags;
     set_handle->data_size = final_data_size;
-    set_handle->file_handle = kv_file;
     key_len = strlen(key);
     set_handle->key = string_ndup(key, key_len);
     *handle = (set_handle_t)set_handle;
     _cur_inc_set_handle = *handle;
 
-    key_metadata.magic = FSST_MAGIC;
-    key_metadata.metadata_size = sizeof(key_metadata_t);
-    key_metadata.revision = FSST_REVISION;
-    key_metadata.user_flags = create_flags;
-    kv_file->write(&key_metadata, sizeof(key_metadata_t));
-
 exit_point:
     if (status != MBED_SUCCESS) {
-        delete kv_file;
         _mutex.unlock();
     }
     return status;
@@ -412,12 +537,18 @@ int FileSystemStore::set_add_data(set_handle_t handle, const void *value_data, s
     // Single key incrementally edited, can be edited from multiple threads - lock to protect
     _inc_data_add_mutex.lock();
     if ((_cur_inc_data_size + data_size) > set_handle->data_size) {
-        tr_warning("Added Data(%d) will exceed set_start final size(%d) - not adding data to file: %s",
-                   _cur_inc_data_size + data_size, set_handle->data_size, _full_path_key);
+        tr_warning("Added Data(%d) will exceed set_start final size(%d) - not adding data to key: %s",
+                   _cur_inc_data_size + data_size, set_handle->data_size, set_handle->key);
         status = MBED_ERROR_INVALID_SIZE;
         goto exit_point;
     }
 
+    if (set_handle->packed_buf != NULL) {
+        memcpy(set_handle->packed_buf + _cur_inc_data_size, value_data, data_size);
+        _cur_inc_data_size += data_size;
+        goto exit_point;
+    }
+
     kv_file = set_handle->file_handle;
 
     added_data = kv_file->write(value_data, data_size);
@@ -438,6 +569,8 @@ int FileSystemStore::set_finalize(set_handle_t handle)
 {
     int status = MBED_SUCCESS;
     inc_set_handle_t *set_handle = NULL;
+    size_t index;
+    key_entry_t *entry;
 
     if ((handle == NULL) || (handle != _cur_inc_set_handle)) {
         status =  MBED_ERROR_INVALID_ARGUMENT;
@@ -446,20 +579,43 @@ int FileSystemStore::set_finalize(set_handle_t handle)
 
     set_handle = (inc_set_handle_t *)handle;
 
+    if (set_handle->file_handle != NULL) {
+        set_handle->file_handle->close();
+        delete set_handle->file_handle;
+    }
+
     if (set_handle->key == NULL) {
         status = MBED_ERROR_INVALID_DATA_DETECTED;
     } else {
         if (_cur_inc_data_size != set_handle->data_size) {
-            tr_error("Accumulated Data (%d) size doesn't match set_start final size (%d) - file: %s", _cur_inc_data_size,
-                     set_handle->data_size, _full_path_key);
+            tr_error("Accumulated Data (%d) size doesn't match set_start final size (%d) - key: %s", _cur_inc_data_size,
+                     set_handle->data_size, set_handle->key);
             status = MBED_ERROR_INVALID_SIZE;
-            _fs->remove(_full_path_key);
+            if (set_handle->packed_buf == NULL) {
+                // The key file was already truncated
+                _build_full_path_key(set_handle->key);
+                _fs->remove(_full_path_key);
+                if (_find_key(set_handle->key, index) == MBED_SUCCESS) {
+                    _remove_key(index);
+                }
+            }
+        } else if (set_handle->packed_buf != NULL) {
+            status = _packed_set(set_handle->key, set_handle->packed_buf, set_handle->data_size,
+                                 set_handle->create_flags);
+        } else {
+            if (_find_key(set_handle->key, index) == MBED_SUCCESS) {
+                entry = &_key_dir[index];
+            } else {
+                entry = _insert_key(index, set_handle->key);
+            }
+            entry->data_size = set_handle->data_size;
+            entry->user_flags = set_handle->create_flags;
+            entry->packed_offset = key_in_file;
         }
         delete[] set_handle->key;
     }
 
-    set_handle->file_handle->close();
-    delete set_handle->file_handle;
+    delete[] set_handle->packed_buf;
     delete set_handle;
     _cur_inc_data_size = 0;
     _cur_inc_set_handle = NULL;
@@ -475,7 +631,6 @@ exit_point:
 int FileSystemStore::iterator_open(iterator_t *it, const char *prefix)
 {
     int status = MBED_SUCCESS;
-    Dir *kv_dir = NULL;
     key_iterator_handle_t *key_it = NULL;
 
     if (it == NULL) {
@@ -488,26 +643,12 @@ int FileSystemStore::iterator_open(iterator_t *it, const char *prefix)
         goto exit_point;
     }
     key_it = new key_iterator_handle_t;
-    key_it->dir_handle = NULL;
     key_it->prefix = NULL;
+    key_it->last_key = NULL;
     if (prefix != NULL) {
         key_it->prefix = string_ndup(prefix, KVStore::MAX_KEY_SIZE);
     }
 
-    kv_dir = new Dir;
-    if (kv_dir->open(_fs, _cfg_fs_path) != 0) {
-        tr_error("KV Dir: %s, doesnt exist", _cfg_fs_path); //TBD verify ERRNO NOEXIST
-        delete kv_dir;
-        if (key_it->prefix != NULL) {
-            delete[] key_it->prefix;
-        }
-        delete key_it;
-        status = MBED_ERROR_ITEM_NOT_FOUND;
-        goto exit_point;
-    }
-
-    key_it->dir_handle = kv_dir;
-
     *it = (iterator_t)key_it;
 
 exit_point:
@@ -518,11 +659,11 @@ exit_point:
 
 int FileSystemStore::iterator_next(iterator_t it, char *key, size_t key_size)
 {
-    Dir *kv_dir;
-    struct dirent kv_dir_ent;
     int status = MBED_ERROR_ITEM_NOT_FOUND;
     key_iterator_handle_t *key_it;
     size_t key_name_size = KVStore::MAX_KEY_SIZE;
+    size_t prefix_size = 0;
+    size_t index = 0;
     if (key_size < key_name_size) {
         key_name_size = key_size;
     }
@@ -535,29 +676,35 @@ int FileSystemStore::iterator_next(iterator_t it, char *key, size_t key_size)
 
     key_it = (key_iterator_handle_t *)it;
 
-    if ((key_it->prefix != NULL) && (key_name_size < strlen(key_it->prefix))) {
-        status = MBED_ERROR_INVALID_SIZE;
-        goto exit_point;
+    if (key_it->prefix != NULL) {
+        prefix_size = strlen(key_it->prefix);
+        if (key_name_size < prefix_size) {
+            status = MBED_ERROR_INVALID_SIZE;
+            goto exit_point;
+        }
     }
 
-    kv_dir = (Dir *)key_it->dir_handle;
-
-    while (kv_dir->read(&kv_dir_ent) != 0) {
-        if (kv_dir_ent.d_type != DT_REG) {
-            continue;
+    // The directory is sorted, so continue after the last key returned, which also
+    // copes with keys set or removed since then. Keys with the prefix are contiguous.
+    if (key_it->last_key != NULL) {
+        if (_find_key(key_it->last_key, index) == MBED_SUCCESS) {
+            index++;
         }
+    } else if (key_it->prefix != NULL) {
+        _find_key(key_it->prefix, index);
+    }
 
-        if ((key_it->prefix == NULL) ||
-                (strncmp(kv_dir_ent.d_name, key_it->prefix, strlen(key_it->prefix)) == 0)) {
-            if (key_name_size < strlen(kv_dir_ent.d_name)) {
-                status = MBED_ERROR_INVALID_SIZE;
-                break;
-            }
-            strncpy(key, kv_dir_ent.d_name, key_name_size);
-            key[key_name_size - 1] = '\0';
-            status = MBED_SUCCESS;
-            break;
+    if ((index < _num_keys) &&
+            ((key_it->prefix == NULL) || (strncmp(_key_dir[index].key, key_it->prefix, prefix_size) == 0))) {
+        if (key_name_size < strlen(_key_dir[index].key)) {
+            status = MBED_ERROR_INVALID_SIZE;
+            goto exit_point;
         }
+        strncpy(key, _key_dir[index].key, key_name_size);
+        key[key_name_size - 1] = '\0';
+        delete[] key_it->last_key;
+        key_it->last_key = string_ndup(_key_dir[index].key, strlen(_key_dir[index].key));
+        status = MBED_SUCCESS;
     }
 
 exit_point:
@@ -580,10 +727,7 @@ int FileSystemStore::iterator_close(iterator_t it)
         delete[] key_it->prefix;
     }
 
-    if (key_it->dir_handle != NULL) {
-        ((Dir *)(key_it->dir_handle))->close();
-        delete ((Dir *)(key_it->dir_handle));
-    }
+    delete[] key_it->last_key;
     delete key_it;
 
 exit_point:
@@ -627,6 +771,419 @@ int FileSystemStore::_build_full_path_key(const char *key_src)
     return 0;
 }
 
+int FileSystemStore::_find_key(const char *key, size_t &index)
+{
+    size_t low = 0;
+    size_t high = _num_keys;
+
+    while (low < high) {
+        size_t mid = low + (high - low) / 2;
+        int cmp = strcmp(key, _key_dir[mid].key);
+        if (cmp == 0) {
+            index = mid;
+            return MBED_SUCCESS;
+        }
+        if (cmp < 0) {
+            high = mid;
+        } else {
+            low = mid + 1;
+        }
+    }
+
+    index = low;
+    return MBED_ERROR_ITEM_NOT_FOUND;
+}
+
+FileSystemStore::key_entry_t *FileSystemStore::_insert_key(size_t index, const char *key)
+{
+    if (_num_keys == _max_keys) {
+        size_t new_max_keys = _max_keys ? 2 * _max_keys : initial_max_keys;
+        key_entry_t *new_key_dir = new key_entry_t[new_max_keys];
+        if (_num_keys) {
+            memcpy(new_key_dir, _key_dir, _num_keys * sizeof(key_entry_t));
+        }
+        delete[] _key_dir;
+        _key_dir = new_key_dir;
+        _max_keys = new_max_keys;
+    }
+
+    memmove(&_key_dir[index + 1], &_key_dir[index], (_num_keys - index) * sizeof(key_entry_t));
+    _num_keys++;
+
+    key_entry_t *entry = &_key_dir[index];
+    entry->key = string_ndup(key, strlen(key));
+    return entry;
+}
+
+void FileSystemStore::_remove_key(size_t index)
+{
+    delete[] _key_dir[index].key;
+    memmove(&_key_dir[index], &_key_dir[index + 1], (_num_keys - index - 1) * sizeof(key_entry_t));
+    _num_keys--;
+}
+
+int FileSystemStore::_build_key_dir()
+{
+    int status = MBED_SUCCESS;
+    Dir kv_dir;
+    struct dirent dir_ent;
+    File kv_file;
+    key_metadata_t key_metadata;
+    key_entry_t *entry;
+    size_t index;
+
+    // The packed file goes first, its values take precedence over key files
+    status = _open_packed_file();
+    if (status != MBED_SUCCESS) {
+        return status;
+    }
+
+    if (kv_dir.open(_fs, _cfg_fs_path) != 0) {
+        return MBED_ERROR_FAILED_OPERATION;
+    }
+
+    while (kv_dir.read(&dir_ent) != 0) {
+        if ((dir_ent.d_type != DT_REG) || !is_valid_key(dir_ent.d_name)) {
+            continue;
+        }
+
+        if (_find_key(dir_ent.d_name, index) == MBED_SUCCESS) {
+            // Left behind by a set that moved the key to the packed file
+            tr_info("Key: %s, packed value supersedes key file - removing it", dir_ent.d_name);
+            _build_full_path_key(dir_ent.d_name);
+            _fs->remove(_full_path_key);
+            continue;
+        }
+
+        status = _verify_key_file(dir_ent.d_name, &key_metadata, &kv_file);
+        if (status == MBED_ERROR_ITEM_NOT_FOUND) {
+            continue;
+        }
+        kv_file.close();
+
+        entry = _insert_key(index, dir_ent.d_name);
+        if (status == MBED_SUCCESS) {
+            _verify_key_file(dir_ent.d_name, &key_metadata, &kv_file);
+            entry->data_size = kv_file.size() - key_metadata.metadata_size;
+            entry->user_flags = key_metadata.user_flags;
+            entry->packed_offset = key_in_file;
+            kv_file.close();
+        } else {
+            entry->data_size = 0;
+            entry->user_flags = 0;
+            entry->packed_offset = key_in_invalid_file;
+        }
+    }
+
+    kv_dir.close();
+
+    return MBED_SUCCESS;
+}
+
+void FileSystemStore::_free_resources()
+{
+    if (_packed_file != NULL) {
+        _packed_file->close();
+        delete _packed_file;
+        _packed_file = NULL;
+    }
+    _packed_size = 0;
+    _packed_live_size = 0;
+
+    while (_num_keys) {
+        _remove_key(_num_keys - 1);
+    }
+    delete[] _key_dir;
+    _key_dir = NULL;
+    _max_keys = 0;
+
+    delete[] _cfg_fs_path;
+    _cfg_fs_path = NULL;
+    delete[] _full_path_key;
+    _full_path_key = NULL;
+    delete[] _packed_path;
+    _packed_path = NULL;
+    delete[] _packed_tmp_path;
+    _packed_tmp_path = NULL;
+}
+
+int FileSystemStore::_open_packed_file()
+{
+    struct stat st;
+    packed_record_t record;
+    char key[KVStore::MAX_KEY_SIZE];
+    uint8_t chunk[copy_chunk_size];
+    uint32_t offset = 0;
+    uint32_t file_size;
+    uint32_t rec_crc;
+    uint32_t crc;
+    bool packed_exists = (_fs->stat(_packed_path, &st) == 0);
+
+    // Finish or roll back an interrupted compaction: the old packed file is only removed once the new one is complete
+    if (_fs->stat(_packed_tmp_path, &st) == 0) {
+        if (packed_exists) {
+            _fs->remove(_packed_tmp_path);
+        } else if (_fs->rename(_packed_tmp_path, _packed_path) == 0) {
+            packed_exists = true;
+        }
+    }
+
+    if (!packed_exists && (MBED_CONF_FILESYSTEMSTORE_PACKED_VALUE_MAX_SIZE == 0)) {
+        return MBED_SUCCESS;
+    }
+
+    _packed_file = new File;
+    if (_packed_file->open(_fs, _packed_path, O_RDWR | O_CREAT) != 0) {
+        tr_error("Packed file: %s, open failed", _packed_path);
+        delete _packed_file;
+        _packed_file = NULL;
+        return MBED_ERROR_FAILED_OPERATION;
+    }
+
+    file_size = _packed_file->size();
+    _packed_size = 0;
+    _packed_live_size = 0;
+
+    // Replay the records up to the first invalid one, which is where a power loss hit an append
+    while (file_size - offset >= sizeof(packed_record_t)) {
+        _packed_file->seek(offset, SEEK_SET);
+        if (_packed_file->read(&record, sizeof(record)) != sizeof(record)) {
+            break;
+        }
+
+        if ((record.magic != FSST_PACKED_MAGIC) || !record.key_size || (record.key_size >= KVStore::MAX_KEY_SIZE) ||
+                (record.data_size > file_size - offset - sizeof(packed_record_t) - record.key_size) ||
+                (record.key_size > file_size - offset - sizeof(packed_record_t))) {
+            break;
+        }
+
+        if (_packed_file->read(key, record.key_size) != record.key_size) {
+            break;
+        }
+        key[record.key_size] = '\0';
+
+        rec_crc = record.crc;
+        record.crc = 0;
+        crc = calc_crc(initial_crc, sizeof(record), &record);
+        crc = calc_crc(crc, record.key_size, key);
+        for (uint32_t left = record.data_size; left;) {
+            uint32_t chunk_size = std::min<uint32_t>(left, copy_chunk_size);
+            if (_packed_file->read(chunk, chunk_size) != (ssize_t) chunk_size) {
+                break;
+            }
+            crc = calc_crc(crc, chunk_size, chunk);
+            left -= chunk_size;
+        }
+        if ((crc != rec_crc) || !is_valid_key(key)) {
+            break;
+        }
+
+        _apply_packed_record(key, record.flags, record.data_size, offset + sizeof(packed_record_t) + record.key_size);
+        offset += packed_record_size(record.key_size, record.data_size);
+    }
+
+    if (offset < file_size) {
+        tr_info("Packed file: %s, dropping %lu bytes of invalid records", _packed_path, (unsigned long)(file_size - offset));
+        if ((_packed_file->truncate(offset) != 0) || (_packed_file->sync() != 0)) {
+            return MBED_ERROR_FAILED_OPERATION;
+        }
+    }
+    _packed_size = offset;
+
+    return MBED_SUCCESS;
+}
+
+void FileSystemStore::_apply_packed_record(const char *key, uint32_t flags, uint32_t data_size, uint32_t data_offset)
+{
+    size_t index;
+    size_t key_size = strlen(key);
+    key_entry_t *entry = NULL;
+
+    if (_find_key(key, index) == MBED_SUCCESS) {
+        entry = &_key_dir[index];
+        if (entry->packed_offset < key_in_invalid_file) {
+            _packed_live_size -= packed_record_size(key_size, entry->data_size);
+        }
+    }
+
+    if (flags & packed_delete_flag) {
+        if (entry != NULL) {
+            _remove_key(index);
+        }
+        return;
+    }
+
+    if (entry == NULL) {
+        entry = _insert_key(index, key);
+    }
+    entry->data_size = data_size;
+    entry->user_flags = flags;
+    entry->packed_offset = data_offset;
+    _packed_live_size += packed_record_size(key_size, data_size);
+}
+
+int FileSystemStore::_packed_append(const char *key, const void *data, uint32_t data_size, uint32_t flags,
+                                    uint32_t &data_offset)
+{
+    packed_record_t record;
+
+    if (_packed_file == NULL) {
+        return MBED_ERROR_NOT_READY;
+    }
+
+    record.magic = FSST_PACKED_MAGIC;
+    record.key_size = strlen(key);
+    record.reserved = 0;
+    record.flags = flags;
+    record.data_size = data_size;
+    record.crc = 0;
+    record.crc = calc_crc(initial_crc, sizeof(record), &record);
+    record.crc = calc_crc(record.crc, record.key_size, key);
+    record.crc = calc_crc(record.crc, data_size, data);
+
+    // A partly written record is dropped on the next init, and overwritten by the next append
+    _packed_file->seek(_packed_size, SEEK_SET);
+    if ((_packed_file->write(&record, sizeof(record)) != sizeof(record)) ||
+            (_packed_file->write(key, record.key_size) != record.key_size) ||
+            (_packed_file->write(data, data_size) != (ssize_t) data_size) ||
+            (_packed_file->sync() != 0)) {
+        tr_error("Packed file: %s, append failed", _packed_path);
+        return MBED_ERROR_FAILED_OPERATION;
+    }
+
+    data_offset = _packed_size + sizeof(packed_record_t) + record.key_size;
+    _packed_size += packed_record_size(record.key_size, data_size);
+    return MBED_SUCCESS;
+}
+
+int FileSystemStore::_packed_set(const char *key, const void *data, uint32_t data_size, uint32_t flags)
+{
+    int status;
+    size_t index;
+    uint32_t data_offset;
+    bool in_key_file = false;
+
+    if (_find_key(key, index) == MBED_SUCCESS) {
+        in_key_file = (_key_dir[index].packed_offset >= key_in_invalid_file);
+    }
+
+    status = _packed_append(key, data, data_size, flags, data_offset);
+    if (status != MBED_SUCCESS) {
+        return status;
+    }
+    _apply_packed_record(key, flags, data_size, data_offset);
+
+    // Removed only now, so that a power loss always leaves one of the values behind
+    if (in_key_file) {
+        _build_full_path_key(key);
+        _fs->remove(_full_path_key);
+    }
+
+    if (_packed_compact() != MBED_SUCCESS) {
+        tr_error("Packed file: %s, compaction failed", _packed_path);
+    }
+
+    return MBED_SUCCESS;
+}
+
+int FileSystemStore::_packed_remove(size_t index)
+{
+    int status;
+    uint32_t data_offset;
+
+    status = _packed_append(_key_dir[index].key, NULL, 0, packed_delete_flag, data_offset);
+    if (status != MBED_SUCCESS) {
+        return status;
+    }
+    _apply_packed_record(_key_dir[index].key, packed_delete_flag, 0, data_offset);
+
+    if (_packed_compact() != MBED_SUCCESS) {
+        tr_error("Packed file: %s, compaction failed", _packed_path);
+    }
+
+    return MBED_SUCCESS;
+}
+
+int FileSystemStore::_packed_compact()
+{
+    int status = MBED_SUCCESS;
+    File tmp_file;
+    uint8_t chunk[copy_chunk_size];
+    uint32_t *new_offsets = NULL;
+    uint32_t new_size = 0;
+
+    if ((_packed_size < MBED_CONF_FILESYSTEMSTORE_PACKED_COMPACT_THRESHOLD) ||
+            (_packed_size < 2 * _packed_live_size)) {
+        return MBED_SUCCESS;
+    }
+
+    if (tmp_file.open(_fs, _packed_tmp_path, O_WRONLY | O_CREAT | O_TRUNC) != 0) {
+        return MBED_ERROR_FAILED_OPERATION;
+    }
+
+    // Live records are copied as they are, only their offsets change
+    new_offsets = new uint32_t[_num_keys];
+    for (size_t i = 0; i < _num_keys; i++) {
+        if (_key_dir[i].packed_offset >= key_in_invalid_file) {
+            continue;
+        }
+        uint32_t key_size = strlen(_key_dir[i].key);
+        uint32_t rec_size = packed_record_size(key_size, _key_dir[i].data_size);
+        _packed_file->seek(_key_dir[i].packed_offset - key_size - sizeof(packed_record_t), SEEK_SET);
+        for (uint32_t left = rec_size; left;) {
+            uint32_t chunk_size = std::min<uint32_t>(left, copy_chunk_size);
+            if ((_packed_file->read(chunk, chunk_size) != (ssize_t) chunk_size) ||
+                    (tmp_file.write(chunk, chunk_size) != (ssize_t) chunk_size)) {
+                status = MBED_ERROR_FAILED_OPERATION;
+                goto exit_point;
+            }
+            left -= chunk_size;
+        }
+        new_offsets[i] = new_size + sizeof(packed_record_t) + key_size;
+        new_size += rec_size;
+    }
+
+    if ((tmp_file.sync() != 0) || (tmp_file.close() != 0)) {
+        status = MBED_ERROR_FAILED_OPERATION;
+        goto exit_point;
+    }
+
+    // From here on init completes the compaction if power is lost
+    _packed_file->close();
+    if ((_fs->remove(_packed_path) != 0) || (_fs->rename(_packed_tmp_path, _packed_path) != 0) ||
+            (_packed_file->open(_fs, _packed_path, O_RDWR) != 0)) {
+        tr_error("Packed file: %s, replacing by compacted file failed", _packed_path);
+        // Packed values are out of reach until the next init
+        for (size_t i = _num_keys; i > 0; i--) {
+            if (_key_dir[i - 1].packed_offset < key_in_invalid_file) {
+                _remove_key(i - 1);
+            }
+        }
+        delete _packed_file;
+        _packed_file = NULL;
+        _packed_size = 0;
+        _packed_live_size = 0;
+        delete[] new_offsets;
+        return MBED_ERROR_FAILED_OPERATION;
+    }
+
+    for (size_t i = 0; i < _num_keys; i++) {
+        if (_key_dir[i].packed_offset < key_in_invalid_file) {
+            _key_dir[i].packed_offset = new_offsets[i];
+        }
+    }
+    _packed_size = new_size;
+    _packed_live_size = new_size;
+
+exit_point:
+    if (status != MBED_SUCCESS) {
+        tmp_file.close();
+        _fs->remove(_packed_tmp_path);
+    }
+    delete[] new_offsets;
+    return status;
+}
+
 // Local Functions
 static char *string_ndup(const char *src, size_t size)
 {
@@ -635,3 +1192,12 @@ static char *string_ndup(const char *src, size_t size)
     string_copy[size] = '\0';
     return string_copy;
 }
+
+static char *path_with_suffix(const char *path, size_t path_size, const char *suffix)
+{
+    size_t suffix_size = strlen(suffix);
+    char *new_path = new char[path_size + suffix_size + 1];
+    memcpy(new_path, path, path_size);
+    memcpy(new_path + path_size, suffix, suffix_size + 1);
+    return new_path;
+}
@@ -21,7 +21,7 @@
 #include "mbed_error.h"
 #include <stdlib.h>
 
-#define HEAPBLOCK_SIZE (4096)
+#define HEAPBLOCK_SIZE (16 * 1024)
 
 using namespace mbed;
 
@@ -109,3 +109,86 @@ TEST_F(FileSystemStoreModuleTest, set_multiple_iterate)
     EXPECT_EQ(store->iterator_next(iterator, buf, 100), MBED_ERROR_ITEM_NOT_FOUND);
     EXPECT_EQ(store->iterator_close(iterator), MBED_SUCCESS);
 }
+
+TEST_F(FileSystemStoreModuleTest, set_get_info_remove)
+{
+    KVStore::info_t info;
+    EXPECT_EQ(store->get_info("key", &info), MBED_ERROR_ITEM_NOT_FOUND);
+    EXPECT_EQ(store->set("key", "data", 5, KVStore::REQUIRE_CONFIDENTIALITY_FLAG), MBED_SUCCESS);
+    EXPECT_EQ(store->get_info("key", &info), MBED_SUCCESS);
+    EXPECT_EQ(info.size, 5);
+    EXPECT_EQ(info.flags, KVStore::REQUIRE_CONFIDENTIALITY_FLAG);
+    EXPECT_EQ(store->remove("key"), MBED_SUCCESS);
+    EXPECT_EQ(store->get_info("key", &info), MBED_ERROR_ITEM_NOT_FOUND);
+    EXPECT_EQ(store->remove("key"), MBED_ERROR_ITEM_NOT_FOUND);
+}
+
+TEST_F(FileSystemStoreModuleTest, write_once)
+{
+    EXPECT_EQ(store->set("key", "data", 5, KVStore::WRITE_ONCE_FLAG), MBED_SUCCESS);
+    EXPECT_EQ(store->set("key", "value", 6, 0), MBED_ERROR_WRITE_PROTECTED);
+    EXPECT_EQ(store->remove("key"), MBED_ERROR_WRITE_PROTECTED);
+    EXPECT_EQ(store->reset(), MBED_SUCCESS);
+    EXPECT_EQ(store->set("key", "value", 6, 0), MBED_SUCCESS);
+}
+
+TEST_F(FileSystemStoreModuleTest, small_and_large_values)
+{
+    char large[200];
+    char buf[200];
+    size_t size;
+    KVStore::info_t info;
+    memset(large, 'x', sizeof(large));
+
+    // Key moves from a small value to a large one and back
+    EXPECT_EQ(store->set("key", "data", 5, 0), MBED_SUCCESS);
+    EXPECT_EQ(store->set("key", large, sizeof(large), 0), MBED_SUCCESS);
+    EXPECT_EQ(store->deinit(), MBED_SUCCESS);
+    EXPECT_EQ(store->init(), MBED_SUCCESS);
+    EXPECT_EQ(store->get_info("key", &info), MBED_SUCCESS);
+    EXPECT_EQ(info.size, sizeof(large));
+    EXPECT_EQ(store->get("key", buf, sizeof(buf), &size), MBED_SUCCESS);
+    EXPECT_EQ(size, sizeof(large));
+    EXPECT_EQ(memcmp(buf, large, sizeof(large)), 0);
+
+    EXPECT_EQ(store->set("key", "data", 5, 0), MBED_SUCCESS);
+    EXPECT_EQ(store->deinit(), MBED_SUCCESS);
+    EXPECT_EQ(store->init(), MBED_SUCCESS);
+    EXPECT_EQ(store->get("key", buf, sizeof(buf), &size, 1), MBED_SUCCESS);
+    EXPECT_EQ(size, 4);
+    EXPECT_STREQ("ata", buf);
+    EXPECT_EQ(store->get("key", buf, sizeof(buf), &size, 6), MBED_ERROR_INVALID_SIZE);
+}
+
+TEST_F(FileSystemStoreModuleTest, overwrite_deinit_init_get)
+{
+    char buf[100];
+    size_t size;
+    KVStore::iterator_t iterator;
+
+    // Enough stale values to compact the packed file several times
+    for (int i = 0; i < 200; ++i) {
+        snprintf(buf, sizeof(buf), "data%d", i);
+        EXPECT_EQ(store->set("key", buf, strlen(buf) + 1, 0), MBED_SUCCESS);
+        EXPECT_EQ(store->set("other", buf, strlen(buf) + 1, 0), MBED_SUCCESS);
+        EXPECT_EQ(store->remove("other"), MBED_SUCCESS);
+    }
+    EXPECT_EQ(store->set("another", "value", 6, 0), MBED_SUCCESS);
+    EXPECT_EQ(store->deinit(), MBED_SUCCESS);
+    EXPECT_EQ(store->init(), MBED_SUCCESS);
+
+    EXPECT_EQ(store->get("key", buf, sizeof(buf), &size), MBED_SUCCESS);
+    EXPECT_STREQ("data199", buf);
+    EXPECT_EQ(store->get("other", buf, sizeof(buf), &size), MBED_ERROR_ITEM_NOT_FOUND);
+    EXPECT_EQ(store->get("another", buf, sizeof(buf), &size), MBED_SUCCESS);
+    EXPECT_STREQ("value", buf);
+
+    // Keys come in order
+    EXPECT_EQ(store->iterator_open(&iterator, NULL), MBED_SUCCESS);
+    EXPECT_EQ(store->iterator_next(iterator, buf, sizeof(buf)), MBED_SUCCESS);
+    EXPECT_STREQ("another", buf);
+    EXPECT_EQ(store->iterator_next(iterator, buf, sizeof(buf)), MBED_SUCCESS);
+    EXPECT_STREQ("key", buf);
+    EXPECT_EQ(store->iterator_next(iterator, buf, sizeof(buf)), MBED_ERROR_ITEM_NOT_FOUND);
+    EXPECT_EQ(store->iterator_close(iterator), MBED_SUCCESS);
+}
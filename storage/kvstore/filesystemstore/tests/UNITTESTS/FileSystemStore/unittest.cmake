@@ -37,4 +37,6 @@ set(unittest-test-flags
   -DMBED_LFS_PROG_SIZE=64
   -DMBED_LFS_BLOCK_SIZE=512
   -DMBED_LFS_LOOKAHEAD=512
+  -DMBED_CONF_FILESYSTEMSTORE_PACKED_VALUE_MAX_SIZE=64
+  -DMBED_CONF_FILESYSTEMSTORE_PACKED_COMPACT_THRESHOLD=512
 )
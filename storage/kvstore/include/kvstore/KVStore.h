@@ -20,6 +20,8 @@
 #include <stdint.h>
 #include <stdio.h>
 #include <string.h>
+#include "platform/Span.h"
+#include "platform/mbed_error.h"
 
 namespace mbed {
 
@@ -108,6 +110,40 @@ public:
      */
     virtual int get(const char *key, void *buffer, size_t buffer_size, size_t *actual_size = NULL, size_t offset = 0) = 0;
 
+    /**
+     * @brief Get a read-only view of a KVStore item's data, given key.
+     *
+     *        Stores backed by memory-mapped storage may point the view straight at the stored data.
+     *        Otherwise the data is copied to the given buffer and the view points at it.
+     *        A view into the store is only valid until the store is next modified or deinitialized.
+     *
+     * @param[in]  key                  Key - must not include '*' '/' '?' ':' ';' '\' '"' '|' ' ' '<' '>' '\'.
+     * @param[out] view                 View of the value data.
+     * @param[in]  buffer               Fallback value data buffer (NULL if not given).
+     * @param[in]  buffer_size          Fallback value data buffer size.
+     *
+     * @returns MBED_SUCCESS on success or an error code on failure
+     *          (MBED_ERROR_INVALID_SIZE if the data can't be viewed in place and doesn't fit the buffer)
+     */
+    virtual int get_view(const char *key, Span<const uint8_t> &view, void *buffer = NULL, size_t buffer_size = 0)
+    {
+        info_t info;
+        size_t actual_size = 0;
+        int ret = get_info(key, &info);
+        if (ret) {
+            return ret;
+        }
+        if (info.size > buffer_size) {
+            return MBED_ERROR_INVALID_SIZE;
+        }
+        ret = get(key, buffer, buffer_size, &actual_size);
+        if (ret) {
+            return ret;
+        }
+        view = Span<const uint8_t>(static_cast<const uint8_t *>(buffer), actual_size);
+        return MBED_SUCCESS;
+    }
+
     /**
      * @brief Get information of a given key.
      *
@@ -231,6 +231,7 @@ private:
     // Attachment table
     kv_map_entry_t _kv_map_table[MAX_ATTACHED_KVS];
     int _kv_num_attached_kvs;
+    int _kv_last_lookup_index; // Index of the partition found by the last lookup with a partition name
     int _is_initialized;
     SingletonPtr<PlatformMutex> _mutex;
 #endif
@@ -39,6 +39,7 @@ int KVMap::init()
     }
 
     _kv_num_attached_kvs = 0;
+    _kv_last_lookup_index = 0;
     memset(&_kv_map_table, 0, sizeof(_kv_map_table));
 
     _is_initialized = 1;
@@ -129,6 +130,7 @@ int KVMap::detach(const char *partition_name)
         _kv_map_table[MAX_ATTACHED_KVS - 1].partition_name = NULL;
         _kv_map_table[MAX_ATTACHED_KVS - 1].kv_config->kvstore_main_instance = NULL;
         _kv_num_attached_kvs--;
+        _kv_last_lookup_index = 0;
         ret = MBED_SUCCESS;
         break;
     }
@@ -221,6 +223,15 @@ int KVMap::config_lookup(const char *full_name, kvstore_config_t **kv_config, si
 
 
     delimiter_index = delimiter_position - temp_str;
+
+    // Calls mostly go to the same partition, so try the last one found first
+    i = _kv_last_lookup_index;
+    if ((i < _kv_num_attached_kvs) && (strncmp(temp_str, _kv_map_table[i].partition_name, delimiter_index) == 0)
+            && (_kv_map_table[i].partition_name[delimiter_index] == '\0')) {
+        *kv_config = _kv_map_table[i].kv_config;
+        goto exit;
+    }
+
     for (i = 0; i < _kv_num_attached_kvs; i++) {
 
         if (strncmp(temp_str, _kv_map_table[i].partition_name, delimiter_index) != 0) {
@@ -228,6 +239,7 @@ int KVMap::config_lookup(const char *full_name, kvstore_config_t **kv_config, si
         }
 
         *kv_config = _kv_map_table[i].kv_config;
+        _kv_last_lookup_index = i;
         break;
     }
     if (i == _kv_num_attached_kvs) {
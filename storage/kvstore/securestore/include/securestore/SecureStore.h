@@ -35,6 +35,16 @@
 
 #if SECURESTORE_ENABLED || defined(DOXYGEN_ONLY)
 
+/** Number of keys whose derived encryption and authentication keys are kept in RAM.
+ *
+ *  Deriving the per key AES-CTR and CMAC keys through DeviceKey dominates the cost
+ *  of small gets and sets. The most recently used derived keys are cached (and wiped
+ *  on deinit). Set to 0 to derive them on every operation.
+ */
+#ifndef MBED_CONF_SECURESTORE_DERIVED_KEY_CACHE_SIZE
+#define MBED_CONF_SECURESTORE_DERIVED_KEY_CACHE_SIZE 4
+#endif
+
 #include <stdint.h>
 #include <stdio.h>
 #include "KVStore.h"
@@ -274,6 +284,7 @@ public:
 private:
     // Forward declaration
     struct inc_set_handle_t;
+    struct derived_keys_t;
 
     PlatformMutex _mutex;
     bool _is_initialized;
@@ -281,6 +292,30 @@ private:
     mbedtls_entropy_context *_entropy;
     inc_set_handle_t *_ih;
     uint8_t *_scratch_buf;
+    derived_keys_t *_key_cache;
+    uint32_t _key_cache_tick;
+
+    /**
+     * @brief Get the encryption and authentication keys derived for a given key,
+     *        from the cache if possible.
+     *
+     * @param[in]  key                  Key - must not include '*' '/' '?' ':' ';' '\' '"' '|' ' ' '<' '>' '\'.
+     * @param[out] enc_key              Derived encryption key (nullptr if not needed).
+     * @param[out] auth_key             Derived authentication key.
+     *
+     * @returns 0 on success or a negative error code on failure
+     */
+    int get_derived_keys(const char *key, uint8_t *enc_key, uint8_t *auth_key);
+
+    /**
+     * @brief Wipe the entries of the derived keys cache, keeping it allocated.
+     */
+    void wipe_derived_keys_cache();
+
+    /**
+     * @brief Wipe and release the derived keys cache.
+     */
+    void clear_derived_keys_cache();
 
     /**
      * @brief Actual get function, serving get and get_info APIs.
@@ -23,6 +23,7 @@
 #include "aes.h"
 #include "cmac.h"
 #include "mbedtls/platform.h"
+#include "mbedtls/platform_util.h"
 #include "entropy.h"
 #include "DeviceKey.h"
 #include "mbed_assert.h"
@@ -65,6 +66,15 @@ typedef struct {
 
 }
 
+// derived keys cache entry
+struct SecureStore::derived_keys_t {
+    char *key = nullptr;
+    uint32_t last_used = 0u;
+    bool enc_key_valid = false;
+    uint8_t enc_key[derived_key_size] = { 0u };
+    uint8_t auth_key[derived_key_size] = { 0u };
+};
+
 // incremental set handle
 struct SecureStore::inc_set_handle_t {
     record_metadata_t metadata;
@@ -80,21 +90,20 @@ struct SecureStore::inc_set_handle_t {
 
 // -------------------------------------------------- Functions Implementation ----------------------------------------------------
 
-int encrypt_decrypt_start(mbedtls_aes_context &enc_aes_ctx, uint8_t *iv, const char *key,
-                          uint8_t *ctr_buf, uint8_t *salt_buf, int salt_buf_size)
+int derive_key(const char *prefix, const char *key, uint8_t *derived_key, uint8_t *salt_buf, int salt_buf_size)
 {
     DeviceKey &devkey = DeviceKey::get_instance();
     char *salt = reinterpret_cast<char *>(salt_buf);
-    uint8_t encrypt_key[derived_key_size];
-    strcpy(salt, enc_prefix);
-    int pos = strlen(enc_prefix);
+    strcpy(salt, prefix);
+    int pos = strlen(prefix);
     strncpy(salt + pos, key, salt_buf_size - pos - 1);
     salt_buf[salt_buf_size - 1] = 0;
-    int os_ret = devkey.generate_derived_key(salt_buf, strlen(salt), encrypt_key,  DEVICE_KEY_16BYTE);
-    if (os_ret) {
-        return os_ret;
-    }
+    return devkey.generate_derived_key(salt_buf, strlen(salt), derived_key, DEVICE_KEY_16BYTE);
+}
 
+int encrypt_decrypt_start(mbedtls_aes_context &enc_aes_ctx, uint8_t *iv, const uint8_t *encrypt_key,
+                          uint8_t *ctr_buf)
+{
     mbedtls_aes_init(&enc_aes_ctx);
     mbedtls_aes_setkey_enc(&enc_aes_ctx, encrypt_key, enc_block_size * 8);
 
@@ -113,20 +122,9 @@ int encrypt_decrypt_data(mbedtls_aes_context &enc_aes_ctx, const uint8_t *in_buf
                                  stream_block, in_buf, out_buf);
 }
 
-int cmac_calc_start(mbedtls_cipher_context_t &auth_ctx, const char *key, uint8_t *salt_buf, int salt_buf_size)
+int cmac_calc_start(mbedtls_cipher_context_t &auth_ctx, const uint8_t *auth_key)
 {
-    DeviceKey &devkey = DeviceKey::get_instance();
-    char *salt = reinterpret_cast<char *>(salt_buf);
-    uint8_t auth_key[derived_key_size];
-    strcpy(salt, auth_prefix);
-    int pos = strlen(auth_prefix);
-    strncpy(salt + pos, key, salt_buf_size - pos - 1);
-    salt_buf[salt_buf_size - 1] = 0;
-    int os_ret = devkey.generate_derived_key(salt_buf, strlen(salt), auth_key, DEVICE_KEY_16BYTE);
-    if (os_ret) {
-        return os_ret;
-    }
-
+    int os_ret;
     const mbedtls_cipher_info_t *cipher_info = mbedtls_cipher_info_from_type(MBEDTLS_CIPHER_AES_128_ECB);
 
     mbedtls_cipher_init(&auth_ctx);
@@ -167,10 +165,85 @@ int cmac_calc_finish(mbedtls_cipher_context_t &auth_ctx, uint8_t *output)
 
 SecureStore::SecureStore(KVStore *underlying_kv, KVStore *rbp_kv) :
     _is_initialized(false), _underlying_kv(underlying_kv), _rbp_kv(rbp_kv), _entropy(0),
-    _ih(0), _scratch_buf(0)
+    _ih(0), _scratch_buf(0), _key_cache(0), _key_cache_tick(0)
 {
 }
 
+int SecureStore::get_derived_keys(const char *key, uint8_t *enc_key, uint8_t *auth_key)
+{
+    derived_keys_t *entry = nullptr;
+    int os_ret;
+
+    if (!MBED_CONF_SECURESTORE_DERIVED_KEY_CACHE_SIZE) {
+        if (enc_key) {
+            os_ret = derive_key(enc_prefix, key, enc_key, _scratch_buf, scratch_buf_size);
+            if (os_ret) {
+                return os_ret;
+            }
+        }
+        return derive_key(auth_prefix, key, auth_key, _scratch_buf, scratch_buf_size);
+    }
+
+    // Look for the key, or else pick the least recently used (or an empty) entry
+    for (int i = 0; i < MBED_CONF_SECURESTORE_DERIVED_KEY_CACHE_SIZE; i++) {
+        derived_keys_t *curr = &_key_cache[i];
+        if (curr->key && !strcmp(curr->key, key)) {
+            entry = curr;
+            break;
+        }
+        if (!entry || (entry->key && (!curr->key || (curr->last_used < entry->last_used)))) {
+            entry = curr;
+        }
+    }
+
+    if (!entry->key || strcmp(entry->key, key)) {
+        delete[] entry->key;
+        entry->key = nullptr;
+        entry->enc_key_valid = false;
+        os_ret = derive_key(auth_prefix, key, entry->auth_key, _scratch_buf, scratch_buf_size);
+        if (os_ret) {
+            return os_ret;
+        }
+        entry->key = new char[strlen(key) + 1];
+        strcpy(entry->key, key);
+    }
+
+    // Encryption key is only derived for keys requiring confidentiality
+    if (enc_key && !entry->enc_key_valid) {
+        os_ret = derive_key(enc_prefix, key, entry->enc_key, _scratch_buf, scratch_buf_size);
+        if (os_ret) {
+            return os_ret;
+        }
+        entry->enc_key_valid = true;
+    }
+
+    entry->last_used = ++_key_cache_tick;
+    if (enc_key) {
+        memcpy(enc_key, entry->enc_key, derived_key_size);
+    }
+    memcpy(auth_key, entry->auth_key, derived_key_size);
+    return 0;
+}
+
+void SecureStore::wipe_derived_keys_cache()
+{
+    if (!_key_cache) {
+        return;
+    }
+    for (int i = 0; i < MBED_CONF_SECURESTORE_DERIVED_KEY_CACHE_SIZE; i++) {
+        delete[] _key_cache[i].key;
+    }
+    mbedtls_platform_zeroize(_key_cache, sizeof(derived_keys_t) * MBED_CONF_SECURESTORE_DERIVED_KEY_CACHE_SIZE);
+    _key_cache_tick = 0;
+}
+
+void SecureStore::clear_derived_keys_cache()
+{
+    wipe_derived_keys_cache();
+    delete[] _key_cache;
+    _key_cache = nullptr;
+}
+
 SecureStore::~SecureStore()
 {
     deinit();
@@ -183,6 +256,7 @@ int SecureStore::set_start(set_handle_t *handle, const char *key, size_t final_d
     int ret, os_ret;
     info_t info;
     bool enc_started = false, auth_started = false;
+    uint8_t enc_key[derived_key_size], auth_key[derived_key_size];
 
     if (!_is_initialized) {
         return MBED_ERROR_NOT_READY;
@@ -237,6 +311,12 @@ int SecureStore::set_start(set_handle_t *handle, const char *key, size_t final_d
     _ih->metadata.metadata_size = sizeof(record_metadata_t);
     _ih->metadata.revision = securestore_revision;
 
+    os_ret = get_derived_keys(key, (create_flags & REQUIRE_CONFIDENTIALITY_FLAG) ? enc_key : nullptr, auth_key);
+    if (os_ret) {
+        ret = MBED_ERROR_FAILED_OPERATION;
+        goto fail;
+    }
+
     if (create_flags & REQUIRE_CONFIDENTIALITY_FLAG) {
         // generate a new random iv
         os_ret = mbedtls_entropy_func(_entropy, _ih->metadata.iv, iv_size);
@@ -244,8 +324,7 @@ int SecureStore::set_start(set_handle_t *handle, const char *key, size_t final_d
             ret = MBED_ERROR_FAILED_OPERATION;
             goto fail;
         }
-        os_ret = encrypt_decrypt_start(_ih->enc_ctx, _ih->metadata.iv, key, _ih->ctr_buf, _scratch_buf,
-                                       scratch_buf_size);
+        os_ret = encrypt_decrypt_start(_ih->enc_ctx, _ih->metadata.iv, enc_key, _ih->ctr_buf);
         if (os_ret) {
             ret = MBED_ERROR_FAILED_OPERATION;
             goto fail;
@@ -255,7 +334,7 @@ int SecureStore::set_start(set_handle_t *handle, const char *key, size_t final_d
         memset(_ih->metadata.iv, 0, iv_size);
     }
 
-    os_ret = cmac_calc_start(_ih->auth_ctx, key, _scratch_buf, scratch_buf_size);
+    os_ret = cmac_calc_start(_ih->auth_ctx, auth_key);
     if (os_ret) {
         ret = MBED_ERROR_FAILED_OPERATION;
         goto fail;
@@ -311,6 +390,8 @@ fail:
     _mutex.unlock();
 
 end:
+    mbedtls_platform_zeroize(enc_key, sizeof(enc_key));
+    mbedtls_platform_zeroize(auth_key, sizeof(auth_key));
     return ret;
 }
 
@@ -528,6 +609,7 @@ int SecureStore::do_get(const char *key, void *buffer, size_t buffer_size, size_
     uint32_t create_flags;
     size_t read_len;
     info_t rbp_info;
+    uint8_t enc_key[derived_key_size], auth_key[derived_key_size];
 
     if (!is_valid_key(key)) {
         return MBED_ERROR_INVALID_ARGUMENT;
@@ -576,7 +658,13 @@ int SecureStore::do_get(const char *key, void *buffer, size_t buffer_size, size_
         goto end;
     }
 
-    os_ret = cmac_calc_start(_ih->auth_ctx, key, _scratch_buf, scratch_buf_size);
+    os_ret = get_derived_keys(key, (create_flags & REQUIRE_CONFIDENTIALITY_FLAG) ? enc_key : nullptr, auth_key);
+    if (os_ret) {
+        ret = MBED_ERROR_FAILED_OPERATION;
+        goto end;
+    }
+
+    os_ret = cmac_calc_start(_ih->auth_ctx, auth_key);
     if (os_ret) {
         ret = MBED_ERROR_FAILED_OPERATION;
         goto end;
@@ -596,8 +684,7 @@ int SecureStore::do_get(const char *key, void *buffer, size_t buffer_size, size_
     }
 
     if (create_flags & REQUIRE_CONFIDENTIALITY_FLAG) {
-        os_ret = encrypt_decrypt_start(_ih->enc_ctx, _ih->metadata.iv, key, _ih->ctr_buf, _scratch_buf,
-                                       scratch_buf_size);
+        os_ret = encrypt_decrypt_start(_ih->enc_ctx, _ih->metadata.iv, enc_key, _ih->ctr_buf);
         if (os_ret) {
             ret = MBED_ERROR_FAILED_OPERATION;
             goto end;
@@ -715,6 +802,8 @@ end:
         mbedtls_cipher_free(&_ih->auth_ctx);
     }
 
+    mbedtls_platform_zeroize(enc_key, sizeof(enc_key));
+    mbedtls_platform_zeroize(auth_key, sizeof(auth_key));
     return ret;
 }
 
@@ -760,6 +849,9 @@ int SecureStore::init()
 
     _scratch_buf = new uint8_t[scratch_buf_size];
     _ih = new inc_set_handle_t;
+    if (MBED_CONF_SECURESTORE_DERIVED_KEY_CACHE_SIZE) {
+        _key_cache = new derived_keys_t[MBED_CONF_SECURESTORE_DERIVED_KEY_CACHE_SIZE];
+    }
 
     ret = _underlying_kv->init();
     if (ret) {
@@ -792,6 +884,7 @@ int SecureStore::deinit()
             delete _scratch_buf;
             _entropy = nullptr;
         }
+        clear_derived_keys_cache();
         ret = _underlying_kv->deinit();
         if (ret) {
             goto END;
@@ -825,6 +918,9 @@ int SecureStore::reset()
     }
 
     _mutex.lock();
+    // Keys derived before the reset must not outlive it
+    wipe_derived_keys_cache();
+
     ret = _underlying_kv->reset();
     if (ret) {
         goto end;
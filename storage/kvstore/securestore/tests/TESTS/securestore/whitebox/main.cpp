@@ -509,6 +509,72 @@ static void multi_set_test()
 
 
 
+static void encrypted_get_timing_test()
+{
+    const int num_keys = MBED_CONF_SECURESTORE_DERIVED_KEY_CACHE_SIZE + 4;
+    const int num_gets = 20;
+    char key_name[16];
+    uint8_t get_buf[32];
+    size_t actual_data_size;
+    int result;
+    mbed::Timer timer;
+    int elapsed;
+
+    uint8_t *dummy = new (std::nothrow) uint8_t[heap_alloc_threshold_size];
+    TEST_SKIP_UNLESS_MESSAGE(dummy, "Not enough heap to run test");
+    delete[] dummy;
+
+    TDBStore *ul_kv = new TDBStore(&ul_bd);
+    SecureStore *sec_kv = new SecureStore(ul_kv);
+
+    result = sec_kv->init();
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+    result = sec_kv->reset();
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+#if DEVICEKEY_ENABLED
+    DeviceKey::get_instance().generate_root_of_trust();
+#endif
+
+    for (int i = 0; i < num_keys; i++) {
+        sprintf(key_name, "enc_key%d", i);
+        result = sec_kv->set(key_name, key1_val1, strlen(key1_val1), KVStore::REQUIRE_CONFIDENTIALITY_FLAG);
+        TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+    }
+
+#if defined(MBEDTLS_AES_ALT)
+    printf("AES implementation: target (MBEDTLS_AES_ALT)\n");
+#else
+    printf("AES implementation: mbed TLS software\n");
+#endif
+
+    // Cycle through more keys than the cache holds, so every get derives its keys
+    timer.start();
+    for (int i = 0; i < num_gets; i++) {
+        sprintf(key_name, "enc_key%d", i % num_keys);
+        result = sec_kv->get(key_name, get_buf, sizeof(get_buf), &actual_data_size);
+        TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+        TEST_ASSERT_EQUAL_STRING_LEN(key1_val1, get_buf, strlen(key1_val1));
+    }
+    elapsed = timer.read_us();
+    printf("Average uncached encrypted get: %d us\n", elapsed / num_gets);
+
+    // Same key over and over - derived keys come from the cache
+    timer.reset();
+    for (int i = 0; i < num_gets; i++) {
+        result = sec_kv->get("enc_key0", get_buf, sizeof(get_buf), &actual_data_size);
+        TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+        TEST_ASSERT_EQUAL_STRING_LEN(key1_val1, get_buf, strlen(key1_val1));
+    }
+    elapsed = timer.read_us();
+    printf("Average cached encrypted get: %d us\n", elapsed / num_gets);
+
+    result = sec_kv->deinit();
+    TEST_ASSERT_EQUAL_ERROR_CODE(MBED_SUCCESS, result);
+
+    delete sec_kv;
+    delete ul_kv;
+}
+
 utest::v1::status_t greentea_failure_handler(const Case *const source, const failure_t reason)
 {
     greentea_case_failure_abort_handler(source, reason);
@@ -517,6 +583,7 @@ utest::v1::status_t greentea_failure_handler(const Case *const source, const fai
 
 Case cases[] = {
     Case("SecureStore: White box test",     white_box_test,    greentea_failure_handler),
+    Case("SecureStore: Encrypted get timing", encrypted_get_timing_test, greentea_failure_handler),
 };
 
 utest::v1::status_t greentea_test_setup(const size_t number_of_cases)
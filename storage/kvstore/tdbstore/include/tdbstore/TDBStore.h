@@ -23,8 +23,38 @@
 #include "blockdevice/BlockDevice.h"
 #include "blockdevice/BufferedBlockDevice.h"
 #include "PlatformMutex.h"
+#if MBED_CONF_RTOS_PRESENT
+#include "rtos/Mutex.h"
+#include "rtos/ConditionVariable.h"
+#endif
+#include "platform/Callback.h"
 #include "mbed_error.h"
 
+/** Keep a RAM copy of every key name next to its RAM table entry.
+ *
+ *  When enabled, key lookups are resolved in RAM instead of reading the key
+ *  back from the block device, so a get() costs a single record read. This
+ *  costs strlen(key) + 1 bytes of heap per stored key.
+ */
+#ifndef MBED_CONF_TDBSTORE_KEY_CACHE_ENABLED
+#define MBED_CONF_TDBSTORE_KEY_CACHE_ENABLED 0
+#endif
+
+/** Active area usage (in percent) above which the GC request callback is called. */
+#ifndef MBED_CONF_TDBSTORE_GC_REQUEST_THRESHOLD
+#define MBED_CONF_TDBSTORE_GC_REQUEST_THRESHOLD 75
+#endif
+
+/** Number of records written between two checkpoints of the RAM table (0 to disable).
+ *  A checkpoint is also written on each garbage collection, and the master record
+ *  points to it. init() then loads the RAM table from the last checkpoint, and only
+ *  verifies the records written after it, instead of scanning the whole area.
+ *  Each checkpoint takes 8 bytes of storage per key.
+ */
+#ifndef MBED_CONF_TDBSTORE_CHECKPOINT_INTERVAL
+#define MBED_CONF_TDBSTORE_CHECKPOINT_INTERVAL 0
+#endif
+
 namespace mbed {
 
 /** TDBStore class
@@ -37,6 +67,14 @@ public:
 
     static const uint32_t RESERVED_AREA_SIZE = 64;
 
+    /** One item of a set_batch() transaction. */
+    typedef struct {
+        const char *key;        /**< Key - must not include '*' '/' '?' ':' ';' '\' '"' '|' ' ' '<' '>' '\'. */
+        const void *buffer;     /**< Value data buffer. */
+        size_t size;            /**< Value data size. */
+        uint32_t create_flags;  /**< Flag mask. */
+    } batch_item_t;
+
     /**
      * @brief Class constructor
      *
@@ -120,6 +158,28 @@ public:
     virtual int get(const char *key, void *buffer, size_t buffer_size, size_t *actual_size = NULL,
                     size_t offset = 0);
 
+    /**
+     * @brief Get a read-only view of a TDBStore item's data, given key.
+     *        If the underlying block device is memory mapped, the view points straight at the
+     *        record data (valid until the store is next modified), otherwise data is copied
+     *        to the given buffer.
+     *
+     * @param[in]  key                  Key - must not include '*' '/' '?' ':' ';' '\' '"' '|' ' ' '<' '>' '\'.
+     * @param[out] view                 View of the value data.
+     * @param[in]  buffer               Fallback value data buffer (NULL if not given).
+     * @param[in]  buffer_size          Fallback value data buffer size.
+     *
+     * @returns MBED_SUCCESS                        Success.
+     *          MBED_ERROR_NOT_READY                Not initialized.
+     *          MBED_ERROR_READ_FAILED              Unable to read from media.
+     *          MBED_ERROR_INVALID_ARGUMENT         Invalid argument given in function arguments.
+     *          MBED_ERROR_INVALID_SIZE             Data not mapped and doesn't fit the buffer.
+     *          MBED_ERROR_INVALID_DATA_DETECTED    Data is corrupt.
+     *          MBED_ERROR_ITEM_NOT_FOUND           No such key.
+     */
+    virtual int get_view(const char *key, mbed::Span<const uint8_t> &view, void *buffer = NULL,
+                         size_t buffer_size = 0);
+
     /**
      * @brief Get information of a given key. The returned info contains size and flags
      *
@@ -152,6 +212,26 @@ public:
     virtual int remove(const char *key);
 
 
+    /**
+     * @brief Set several TDBStore items as a single transaction.
+     *        All records are appended to the media and committed with a single flush,
+     *        and become visible together. If power is lost before the last record is
+     *        committed, none of them is found by the next init. If a key appears more
+     *        than once, the last item wins.
+     *
+     * @param[in]  items                Items to set.
+     * @param[in]  num_items            Number of items.
+     *
+     * @returns MBED_SUCCESS                        Success.
+     *          MBED_ERROR_NOT_READY                Not initialized.
+     *          MBED_ERROR_READ_FAILED              Unable to read from media.
+     *          MBED_ERROR_WRITE_FAILED             Unable to write to media.
+     *          MBED_ERROR_INVALID_ARGUMENT         Invalid argument given in function arguments.
+     *          MBED_ERROR_MEDIA_FULL               Not enough room on media.
+     *          MBED_ERROR_WRITE_PROTECTED          One of the keys already stored with "write once" flag.
+     */
+    int set_batch(const batch_item_t *items, size_t num_items);
+
     /**
      * @brief Start an incremental TDBStore set sequence. This operation is blocking other operations.
      *        Any get/set/remove/iterator operation will be blocked until set_finalize is called.
@@ -277,6 +357,38 @@ public:
     virtual int reserved_data_get(void *reserved_data, size_t reserved_data_buf_size,
                                   size_t *actual_data_size = 0);
 
+    /**
+     * @brief Perform one step of an incremental garbage collection.
+     *        The first call starts a new garbage collection cycle, moving at most
+     *        max_records live records to the standby area. Subsequent calls continue it,
+     *        and the call that moves the last record switches over to the standby area.
+     *        Other operations may be freely interleaved with the steps. Until the switch,
+     *        the standby area has no valid master record, so a power failure leaves
+     *        the active area in use.
+     *
+     * @param[in]  max_records          Maximum number of records to move in this step.
+     *
+     * @returns Number of records still to be moved (0 if cycle has completed) on success.
+     *          MBED_ERROR_NOT_READY                Not initialized.
+     *          MBED_ERROR_READ_FAILED              Unable to read from media.
+     *          MBED_ERROR_WRITE_FAILED             Unable to write to media.
+     *          MBED_ERROR_MEDIA_FULL               Standby area is full (cycle aborted).
+     */
+    int gc_step(size_t max_records);
+
+    /**
+     * @brief Attach a callback, called when active area usage crosses
+     *        MBED_CONF_TDBSTORE_GC_REQUEST_THRESHOLD percent and no incremental
+     *        garbage collection is running. It is called once per cycle,
+     *        with TDBStore locked, so it should only defer the work, typically by
+     *        posting gc_step() calls to a low priority EventQueue.
+     *
+     * @param[in]  cb                   Callback (or nullptr to detach).
+     *
+     * @returns none
+     */
+    void attach_gc_request(mbed::Callback<void()> cb);
+
 #if !defined(DOXYGEN_ONLY)
 private:
 
@@ -288,7 +400,39 @@ private:
     static const int _num_areas = 2;
     static const int _max_open_iterators = 16;
 
-    PlatformMutex _mutex;
+    /**
+     * Reader/writer lock. Any number of threads may hold it shared, or one thread
+     * exclusively. A thread holding it exclusively may lock it again, either way,
+     * as with a recursive mutex. Waiting writers hold back new readers.
+     * All methods are noop when the RTOS is absent.
+     */
+    class RWLock : private mbed::NonCopyable<RWLock> {
+    public:
+        RWLock();
+        void lock();
+        void unlock();
+        void lock_shared();
+        void unlock_shared();
+
+    private:
+#if MBED_CONF_RTOS_PRESENT
+        rtos::Mutex _state_mutex;
+        rtos::ConditionVariable _cond;
+        osThreadId_t _writer;
+        uint32_t _writer_depth;
+        uint32_t _readers;
+        uint32_t _writers_waiting;
+#endif
+    };
+
+    // Exclusive for operations changing the store, shared for get(), get_view() and get_info()
+    RWLock _mutex;
+    // Serializes accesses to the buffered block device (and its read buffer) between readers
+    PlatformMutex _read_mutex;
+#if MBED_CONF_RTOS_PRESENT
+    // Taken by the reader using the work buffer in read_record()
+    rtos::Mutex _work_buf_mutex;
+#endif
     PlatformMutex _inc_set_mutex;
     void *_ram_table;
     size_t _max_keys;
@@ -309,6 +453,12 @@ private:
     char *_key_buf;
     void *_inc_set_handle;
     void *_iterator_table[_max_open_iterators];
+    uint32_t *_gc_offsets;
+    uint32_t _gc_to_offset;
+    bool _gc_requested;
+    mbed::Callback<void()> _gc_request_cb;
+    uint32_t _checkpoint_offset;
+    uint32_t _records_since_checkpoint;
 
     /**
      * @brief Read a block from an area.
@@ -386,16 +536,43 @@ private:
                     bool copy_data, bool check_expected_key, bool calc_hash,
                     uint32_t &hash, uint32_t &flags, uint32_t &next_offset);
 
+    /**
+     * @brief Write a complete TDBStore record (data first, header last) to the active area.
+     *
+     * @param[in]  offset                 Offset of record in area.
+     * @param[in]  key                    Key - must not include '*' '/' '?' ':' ';' '\' '"' '|' ' ' '<' '>' '\'.
+     * @param[in]  data_buf               Data buffer.
+     * @param[in]  data_size              Data size.
+     * @param[in]  flags                  Record flags.
+     * @param[out] next_offset            Offset of next record.
+     *
+     * @returns 0 for success, nonzero for failure.
+     */
+    int write_record(uint32_t offset, const char *key, const void *data_buf, uint32_t data_size,
+                     uint32_t flags, uint32_t &next_offset);
+
+    /**
+     * @brief Check that all records of a batch, starting at given offset, are valid.
+     *
+     * @param[in]  offset                 Offset of first batch record in active area.
+     * @param[out] end_offset             Offset following the last batch record.
+     *
+     * @returns 0 for success, nonzero for failure.
+     */
+    int validate_batch(uint32_t offset, uint32_t &end_offset);
+
     /**
      * @brief Write a master record of a given area.
      *
      * @param[in]  area                   Area.
      * @param[in]  version                Area version.
      * @param[out] next_offset            Offset of next record.
+     * @param[in]  checkpoint_offset      Offset of the checkpoint in area (0 if none).
      *
      * @returns 0 for success, nonzero for failure.
      */
-    int write_master_record(uint8_t area, uint16_t version, uint32_t &next_offset);
+    int write_master_record(uint8_t area, uint16_t version, uint32_t &next_offset,
+                            uint32_t checkpoint_offset = 0);
 
     /**
      * @brief Copy a record from one area to the opposite one.
@@ -417,6 +594,41 @@ private:
      */
     int garbage_collection();
 
+    /**
+     * @brief Incremental garbage collection step (mutex must be held).
+     *
+     * @param[in]  max_records            Maximum number of records to move.
+     *
+     * @returns Number of records still to move, negative error code on failure.
+     */
+    int do_gc_step(size_t max_records);
+
+    /**
+     * @brief Drop the state of an in progress incremental garbage collection.
+     *
+     * @returns none
+     */
+    void gc_abort();
+
+    /**
+     * @brief Update incremental garbage collection state after a record was written.
+     *
+     * @param[in]  ram_table_ind          RAM table index of the record.
+     * @param[in]  bd_offset              Offset of the record in active area.
+     * @param[in]  new_key                True if the record added a key.
+     * @param[in]  deleted                True if the record deleted the key.
+     *
+     * @returns none
+     */
+    void gc_track_update(uint32_t ram_table_ind, uint32_t bd_offset, bool new_key, bool deleted);
+
+    /**
+     * @brief Call the GC request callback if active area usage crossed the threshold.
+     *
+     * @returns none
+     */
+    void check_gc_request();
+
     /**
      * @brief Return record size given key and data size.
      *
@@ -428,7 +640,9 @@ private:
     uint32_t record_size(const char *key, uint32_t data_size);
 
     /**
-     * @brief Find a record given key
+     * @brief Find a record given key.
+     *        RAM table is kept sorted by hash, so the lookup is a binary search
+     *        followed by a key comparison on the (rare) entries sharing the hash.
      *
      * @param[in]  area                   Area.
      * @param[in]  key                    Key - must not include '*' '/' '?' ':' ';' '\' '"' '|' ' ' '<' '>' '\'.
@@ -469,11 +683,41 @@ private:
     int do_set(const char *key, const void *data_buf, uint32_t data_buf_size, uint32_t flags);
 
     /**
-     * @brief Build RAM table and update _free_space_offset (scanning all the records in the area).
+     * @brief Build RAM table and update _free_space_offset (scanning all the records in the area,
+     *        or only those following the last checkpoint).
+     *
+     * @param[in]  checkpoint_offset     Offset of the checkpoint the master record points to (0 if none).
+     *
+     * @returns 0 for success, nonzero for failure.
+     */
+    int build_ram_table(uint32_t checkpoint_offset);
+
+    /**
+     * @brief Write a checkpoint of the RAM table at the free space offset of the active area,
+     *        chained to the previous one (_checkpoint_offset), and make it the last one.
      *
      * @returns 0 for success, nonzero for failure.
      */
-    int build_ram_table();
+    int write_checkpoint();
+
+    /**
+     * @brief Write a checkpoint if MBED_CONF_TDBSTORE_CHECKPOINT_INTERVAL records were written since the last one.
+     *
+     * @param[in]  num_records           Number of records just written.
+     *
+     * @returns 0 for success (or no room for a checkpoint), nonzero for failure.
+     */
+    int check_checkpoint(uint32_t num_records);
+
+    /**
+     * @brief Find the last checkpoint, hopping over record headers, and load the RAM table from it.
+     *
+     * @param[in]  start_offset          Offset to start looking from.
+     * @param[out] next_offset           Offset of the record following the checkpoint.
+     *
+     * @returns 0 for success, nonzero for failure (RAM table left empty).
+     */
+    int load_checkpoint(uint32_t start_offset, uint32_t &next_offset);
 
     /**
      * @brief Increment maximum number of keys and reallocate RAM table accordingly.
@@ -540,6 +784,13 @@ private:
      */
     void update_all_iterators(bool added, uint32_t ram_table_ind);
 
+    /**
+     * @brief Release all key names held by the RAM table key cache.
+     *
+     * @returns none
+     */
+    void free_cached_keys();
+
 #endif
 
 };
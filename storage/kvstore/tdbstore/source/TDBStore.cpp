@@ -26,6 +26,9 @@
 #include "mbed_wait_api.h"
 #include "MbedCRC.h"
 #include "FlashIAP.h"
+#if MBED_CONF_RTOS_PRESENT
+#include "rtos/ThisThread.h"
+#endif
 
 using namespace mbed;
 
@@ -33,6 +36,13 @@ using namespace mbed;
 
 static const uint32_t delete_flag = (1UL << 31);
 static const uint32_t internal_flags = delete_flag;
+// Marks all records of a set_batch() transaction except the last one
+static const uint32_t batch_flag = (1UL << 30);
+// Marks a standby area copy (incremental GC) superseded by a newer record
+static const uint32_t gc_stale_flag = (1UL << 31);
+// Marks a checkpoint of the RAM table. Checkpoints also carry the delete flag,
+// so a scan not aware of them skips them as deletions of a nonexistent key.
+static const uint32_t checkpoint_flag = (1UL << 29);
 // Only write once flag is supported, other two are kept in storage but ignored
 static const uint32_t supported_flags = KVStore::WRITE_ONCE_FLAG | KVStore::REQUIRE_CONFIDENTIALITY_FLAG | KVStore::REQUIRE_REPLAY_PROTECTION_FLAG;
 
@@ -52,18 +62,37 @@ typedef struct {
 typedef struct {
     uint32_t  hash;
     bd_size_t bd_offset;
+#if MBED_CONF_TDBSTORE_KEY_CACHE_ENABLED
+    char     *key;
+#endif
 } ram_table_entry_t;
 
 static const char *master_rec_key = "TDBS";
+// Not a valid user key, so it can't clash with one
+static const char *checkpoint_key = "*TDBC";
 static const uint32_t tdbstore_magic = 0x54686683;
 static const uint32_t tdbstore_revision = 1;
 
 typedef struct {
     uint16_t version;
     uint16_t tdbstore_revision;
-    uint32_t reserved;
+    uint32_t checkpoint_offset;     // Last written as reserved (zero) field
 } master_record_data_t;
 
+// Checkpoint record data, followed by num_keys entries
+typedef struct {
+    uint32_t offset;                // Offset of the checkpoint itself
+    uint32_t prev_offset;           // Offset of the previous checkpoint in area (0 if none)
+    uint16_t version;               // Area version
+    uint16_t reserved;
+    uint32_t num_keys;
+} checkpoint_data_t;
+
+typedef struct {
+    uint32_t hash;
+    uint32_t bd_offset;
+} checkpoint_entry_t;
+
 typedef enum {
     TDBSTORE_AREA_STATE_NONE = 0,
     TDBSTORE_AREA_STATE_ERASED,
@@ -125,12 +154,22 @@ static uint32_t calc_crc(uint32_t init_crc, uint32_t data_size, const void *data
     return crc;
 }
 
+#if MBED_CONF_TDBSTORE_KEY_CACHE_ENABLED
+static char *dup_key(const char *key)
+{
+    char *copy = new char[strlen(key) + 1];
+    strcpy(copy, key);
+    return copy;
+}
+#endif
+
 // Class member functions
 
 TDBStore::TDBStore(BlockDevice *bd) : _ram_table(0), _max_keys(0),
     _num_keys(0), _bd(bd), _buff_bd(0),  _free_space_offset(0), _master_record_offset(0),
     _master_record_size(0), _is_initialized(false), _active_area(0), _active_area_version(0), _size(0),
-    _area_params{}, _prog_size(0), _work_buf(0), _work_buf_size(0), _key_buf(0), _inc_set_handle(0)
+    _area_params{}, _prog_size(0), _work_buf(0), _work_buf_size(0), _key_buf(0), _inc_set_handle(0),
+    _gc_offsets(0), _gc_to_offset(0), _gc_requested(false), _checkpoint_offset(0), _records_since_checkpoint(0)
 {
     for (int i = 0; i < _num_areas; i++) {
         _area_params[i] = { 0 };
@@ -145,13 +184,100 @@ TDBStore::~TDBStore()
     deinit();
 }
 
+#if MBED_CONF_RTOS_PRESENT
+TDBStore::RWLock::RWLock() :
+    _cond(_state_mutex), _writer(nullptr), _writer_depth(0), _readers(0), _writers_waiting(0)
+{
+}
+
+void TDBStore::RWLock::lock()
+{
+    osThreadId_t self = rtos::ThisThread::get_id();
+
+    _state_mutex.lock();
+    if (_writer != self) {
+        _writers_waiting++;
+        while (_writer || _readers) {
+            _cond.wait();
+        }
+        _writers_waiting--;
+        _writer = self;
+    }
+    _writer_depth++;
+    _state_mutex.unlock();
+}
+
+void TDBStore::RWLock::unlock()
+{
+    _state_mutex.lock();
+    if (--_writer_depth == 0) {
+        _writer = nullptr;
+        _cond.notify_all();
+    }
+    _state_mutex.unlock();
+}
+
+void TDBStore::RWLock::lock_shared()
+{
+    osThreadId_t self = rtos::ThisThread::get_id();
+
+    _state_mutex.lock();
+    if (_writer == self) {
+        // Already exclusive, count it as a nested exclusive lock
+        _writer_depth++;
+    } else {
+        while (_writer || _writers_waiting) {
+            _cond.wait();
+        }
+        _readers++;
+    }
+    _state_mutex.unlock();
+}
+
+void TDBStore::RWLock::unlock_shared()
+{
+    _state_mutex.lock();
+    if (_writer == rtos::ThisThread::get_id()) {
+        if (--_writer_depth == 0) {
+            _writer = nullptr;
+            _cond.notify_all();
+        }
+    } else if (--_readers == 0) {
+        _cond.notify_all();
+    }
+    _state_mutex.unlock();
+}
+#else
+TDBStore::RWLock::RWLock()
+{
+}
+
+void TDBStore::RWLock::lock()
+{
+}
+
+void TDBStore::RWLock::unlock()
+{
+}
+
+void TDBStore::RWLock::lock_shared()
+{
+}
+
+void TDBStore::RWLock::unlock_shared()
+{
+}
+#endif
+
 int TDBStore::read_area(uint8_t area, uint32_t offset, uint32_t size, void *buf)
 {
     //Check that we are not crossing area boundary
     if (offset + size > _size) {
         return MBED_ERROR_READ_FAILED;
     }
+    _read_mutex.lock();
     int os_ret = _buff_bd->read(buf, _area_params[area].address + offset, size);
+    _read_mutex.unlock();
 
     if (os_ret) {
         return MBED_ERROR_READ_FAILED;
@@ -251,6 +377,12 @@ int TDBStore::read_record(uint8_t area, uint32_t offset, char *key,
     uint32_t curr_data_offset;
     char *user_key_ptr;
     uint32_t crc = initial_crc;
+    // Concurrent get() calls may only use the work buffer one at a time,
+    // the others read through a small buffer on the stack
+    uint8_t scratch_buf[min_work_buf_size];
+    uint8_t *read_buf = scratch_buf;
+    size_t read_buf_size = sizeof(scratch_buf);
+    bool own_work_buf = true;
     // Upper layers typically use non zero offsets for reading the records chunk by chunk,
     // so only validate entire record at first chunk (otherwise we'll have a serious performance penalty).
     bool validate = (data_offset == 0);
@@ -285,7 +417,7 @@ int TDBStore::read_record(uint8_t area, uint32_t offset, char *key,
         return MBED_ERROR_INVALID_DATA_DETECTED;
     }
 
-    if (offset + total_size >= _size) {
+    if (offset + total_size > _size) {
         return MBED_ERROR_INVALID_DATA_DETECTED;
     }
 
@@ -316,6 +448,14 @@ int TDBStore::read_record(uint8_t area, uint32_t offset, char *key,
     user_key_ptr = key;
     hash = initial_crc;
 
+#if MBED_CONF_RTOS_PRESENT
+    own_work_buf = _work_buf_mutex.trylock();
+#endif
+    if (own_work_buf) {
+        read_buf = _work_buf;
+        read_buf_size = _work_buf_size;
+    }
+
     while (total_size) {
         uint8_t *dest_buf;
         uint32_t chunk_size;
@@ -326,8 +466,8 @@ int TDBStore::read_record(uint8_t area, uint32_t offset, char *key,
                 chunk_size = key_size;
                 user_key_ptr[key_size] = '\0';
             } else {
-                dest_buf = _work_buf;
-                chunk_size = std::min<size_t>(key_size, _work_buf_size);
+                dest_buf = read_buf;
+                chunk_size = std::min<size_t>(key_size, read_buf_size);
             }
         } else {
             // This means that we're on the data part
@@ -337,14 +477,14 @@ int TDBStore::read_record(uint8_t area, uint32_t offset, char *key,
             // 3. After actual part is finished - read to work buffer
             // 4. Copy data flag not set - read to work buffer
             if (curr_data_offset < data_offset) {
-                chunk_size = std::min<size_t>(_work_buf_size, (data_offset - curr_data_offset));
-                dest_buf = _work_buf;
+                chunk_size = std::min<size_t>(read_buf_size, (data_offset - curr_data_offset));
+                dest_buf = read_buf;
             } else if (copy_data && (curr_data_offset < data_offset + actual_data_size)) {
                 chunk_size = actual_data_size;
                 dest_buf = static_cast<uint8_t *>(data_buf);
             } else {
-                chunk_size = std::min<size_t>(_work_buf_size, total_size);
-                dest_buf = _work_buf;
+                chunk_size = std::min<size_t>(read_buf_size, total_size);
+                dest_buf = read_buf;
             }
         }
         ret = read_area(area, offset, chunk_size, dest_buf);
@@ -390,6 +530,11 @@ int TDBStore::read_record(uint8_t area, uint32_t offset, char *key,
     next_offset = align_up(offset, _prog_size);
 
 end:
+#if MBED_CONF_RTOS_PRESENT
+    if (own_work_buf) {
+        _work_buf_mutex.unlock();
+    }
+#endif
     return ret;
 }
 
@@ -405,15 +550,32 @@ int TDBStore::find_record(uint8_t area, const char *key, uint32_t &offset,
 
     hash = calc_crc(initial_crc, strlen(key), key);
 
-    for (ram_table_ind = 0; ram_table_ind < _num_keys; ram_table_ind++) {
+    // RAM table is sorted by descending hash. Find the first entry whose hash
+    // is not greater than ours - this is also the insertion point if key is not found.
+    uint32_t low = 0, high = _num_keys;
+    while (low < high) {
+        uint32_t mid = low + (high - low) / 2;
+        if (ram_table[mid].hash > hash) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+
+    for (ram_table_ind = low; ram_table_ind < _num_keys; ram_table_ind++) {
         entry = &ram_table[ram_table_ind];
         offset = entry->bd_offset;
-        if (hash < entry->hash)  {
-            continue;
-        }
         if (hash > entry->hash)  {
             return MBED_ERROR_ITEM_NOT_FOUND;
         }
+#if MBED_CONF_TDBSTORE_KEY_CACHE_ENABLED
+        if (entry->key) {
+            if (!strcmp(entry->key, key)) {
+                return MBED_SUCCESS;
+            }
+            continue;
+        }
+#endif
         ret = read_record(_active_area, offset, const_cast<char *>(key), 0, 0, actual_data_size, 0,
                           false, false, true, false, dummy_hash, flags, next_offset);
         // not found return code here means that hash doesn't belong to name. Continue searching.
@@ -472,8 +634,12 @@ int TDBStore::set_start(set_handle_t *handle, const char *key, size_t final_data
             }
         }
 
-        // If we have no room for the record, perform garbage collection
+        // If we have no room for the record, perform garbage collection.
+        // Finish a running incremental one first, as part of its work is already done.
         uint32_t rec_size = record_size(key, final_data_size);
+        if ((_free_space_offset + rec_size > _size) && _gc_offsets) {
+            do_gc_step((size_t) -1);
+        }
         if (_free_space_offset + rec_size > _size) {
             ret = garbage_collection();
             if (ret) {
@@ -507,6 +673,10 @@ int TDBStore::set_start(set_handle_t *handle, const char *key, size_t final_data
                 increment_max_keys();
             }
             ih->new_key = true;
+#if MBED_CONF_TDBSTORE_KEY_CACHE_ENABLED
+            // Finalize phase only has the handle, keep the key for the RAM table
+            strcpy(_key_buf, key);
+#endif
         } else {
             goto fail;
         }
@@ -662,8 +832,13 @@ int TDBStore::set_finalize(set_handle_t handle)
         goto end;
     }
 
+    gc_track_update(ih->ram_table_ind, ih->bd_base_offset, ih->new_key, ih->header.flags & delete_flag);
+
     // Update RAM table
     if (ih->header.flags & delete_flag) {
+#if MBED_CONF_TDBSTORE_KEY_CACHE_ENABLED
+        delete[] ram_table[ih->ram_table_ind].key;
+#endif
         _num_keys--;
         if (ih->ram_table_ind < _num_keys) {
             memmove(&ram_table[ih->ram_table_ind], &ram_table[ih->ram_table_ind + 1],
@@ -678,6 +853,9 @@ int TDBStore::set_finalize(set_handle_t handle)
             }
             _num_keys++;
             update_all_iterators(true, ih->ram_table_ind);
+#if MBED_CONF_TDBSTORE_KEY_CACHE_ENABLED
+            ram_table[ih->ram_table_ind].key = dup_key(_key_buf);
+#endif
         }
         entry = &ram_table[ih->ram_table_ind];
         entry->hash = ih->hash;
@@ -695,6 +873,12 @@ int TDBStore::set_finalize(set_handle_t handle)
         check_erase_before_write(_active_area, _free_space_offset, sizeof(record_header_t));
     }
 
+    if (check_checkpoint(1)) {
+        need_gc = true;
+    }
+
+    check_gc_request();
+
 end:
     // mark handle as invalid by clearing magic field in header
     ih->header.magic = 0;
@@ -710,6 +894,209 @@ end:
     return ret;
 }
 
+int TDBStore::write_record(uint32_t offset, const char *key, const void *data_buf, uint32_t data_size,
+                           uint32_t flags, uint32_t &next_offset)
+{
+    record_header_t header;
+    uint32_t key_offset = offset + align_up(sizeof(record_header_t), _prog_size);
+    int ret;
+
+    ret = check_erase_before_write(_active_area, offset, record_size(key, data_size));
+    if (ret) {
+        return ret;
+    }
+
+    header.magic = tdbstore_magic;
+    header.header_size = sizeof(record_header_t);
+    header.revision = tdbstore_revision;
+    header.flags = flags;
+    header.key_size = strlen(key);
+    header.reserved = 0;
+    header.data_size = data_size;
+    header.crc = calc_crc(initial_crc, sizeof(record_header_t) - sizeof(header.crc), &header);
+    header.crc = calc_crc(header.crc, header.key_size, key);
+    header.crc = calc_crc(header.crc, data_size, data_buf);
+
+    ret = write_area(_active_area, key_offset, header.key_size, key);
+    if (ret) {
+        return ret;
+    }
+    ret = write_area(_active_area, key_offset + header.key_size, data_size, data_buf);
+    if (ret) {
+        return ret;
+    }
+    ret = write_area(_active_area, offset, sizeof(record_header_t), &header);
+    if (ret) {
+        return ret;
+    }
+
+    next_offset = align_up(key_offset + header.key_size + data_size, _prog_size);
+    return MBED_SUCCESS;
+}
+
+int TDBStore::validate_batch(uint32_t offset, uint32_t &end_offset)
+{
+    uint32_t actual_data_size, hash, flags, next_offset;
+    int ret;
+
+    // Batch ends with the first record not carrying the batch flag
+    do {
+        ret = read_record(_active_area, offset, 0, 0, (uint32_t) -1, actual_data_size, 0,
+                          false, false, false, false, hash, flags, next_offset);
+        if (ret) {
+            return ret;
+        }
+        offset = next_offset;
+    } while (flags & batch_flag);
+
+    end_offset = offset;
+    return MBED_SUCCESS;
+}
+
+int TDBStore::set_batch(const batch_item_t *items, size_t num_items)
+{
+    ram_table_entry_t *ram_table;
+    uint32_t batch_size = 0;
+    uint32_t base_offset, offset, next_offset;
+    uint32_t ram_table_ind, hash, flags, actual_data_size;
+    record_header_t header;
+    bool need_gc = false;
+    size_t i;
+    int os_ret, ret = MBED_SUCCESS;
+
+    if (!_is_initialized) {
+        return MBED_ERROR_NOT_READY;
+    }
+
+    if (!items || !num_items) {
+        return MBED_ERROR_INVALID_ARGUMENT;
+    }
+
+    for (i = 0; i < num_items; i++) {
+        if (!is_valid_key(items[i].key) || (!items[i].buffer && items[i].size) ||
+                (items[i].create_flags & ~supported_flags)) {
+            return MBED_ERROR_INVALID_ARGUMENT;
+        }
+        batch_size += record_size(items[i].key, items[i].size);
+    }
+
+    _mutex.lock();
+
+    // Check all keys first, so nothing is written if a single one is write protected
+    for (i = 0; i < num_items; i++) {
+        ret = find_record(_active_area, items[i].key, offset, ram_table_ind, hash);
+        if (ret == MBED_ERROR_ITEM_NOT_FOUND) {
+            continue;
+        }
+        if (ret == MBED_SUCCESS) {
+            ret = read_area(_active_area, offset, sizeof(header), &header);
+        }
+        if (!ret && (header.flags & WRITE_ONCE_FLAG)) {
+            ret = MBED_ERROR_WRITE_PROTECTED;
+        }
+        if (ret) {
+            goto end;
+        }
+    }
+    ret = MBED_SUCCESS;
+
+    if ((_free_space_offset + batch_size > _size) && _gc_offsets) {
+        do_gc_step((size_t) -1);
+    }
+    if (_free_space_offset + batch_size > _size) {
+        ret = garbage_collection();
+        if (ret) {
+            goto end;
+        }
+    }
+    if (_free_space_offset + batch_size > _size) {
+        ret = MBED_ERROR_MEDIA_FULL;
+        goto end;
+    }
+
+    // Write all records. Each one, except the last, carries the batch flag.
+    base_offset = _free_space_offset;
+    offset = base_offset;
+    for (i = 0; i < num_items; i++) {
+        flags = items[i].create_flags | ((i < num_items - 1) ? batch_flag : 0);
+        ret = write_record(offset, items[i].key, items[i].buffer, items[i].size, flags, next_offset);
+        if (ret) {
+            need_gc = true;
+            goto end;
+        }
+        offset = next_offset;
+    }
+
+    // Single flush for the whole batch - this is the commit point
+    os_ret = _buff_bd->sync();
+    if (os_ret) {
+        ret = MBED_ERROR_WRITE_FAILED;
+        need_gc = true;
+        goto end;
+    }
+
+    // Writes may fail without returning a failure, so reread the batch
+    ret = validate_batch(base_offset, next_offset);
+    if (ret) {
+        need_gc = true;
+        goto end;
+    }
+
+    // Update RAM table
+    offset = base_offset;
+    for (i = 0; i < num_items; i++) {
+        uint32_t dummy_offset;
+        ret = find_record(_active_area, items[i].key, dummy_offset, ram_table_ind, hash);
+        if ((ret != MBED_SUCCESS) && (ret != MBED_ERROR_ITEM_NOT_FOUND)) {
+            need_gc = true;
+            goto end;
+        }
+        bool new_key = (ret == MBED_ERROR_ITEM_NOT_FOUND);
+        if (new_key && (_num_keys >= _max_keys)) {
+            increment_max_keys();
+        }
+        ram_table = (ram_table_entry_t *) _ram_table;
+        gc_track_update(ram_table_ind, offset, new_key, false);
+        if (new_key) {
+            if (ram_table_ind < _num_keys) {
+                memmove(&ram_table[ram_table_ind + 1], &ram_table[ram_table_ind],
+                        sizeof(ram_table_entry_t) * (_num_keys - ram_table_ind));
+            }
+            _num_keys++;
+            update_all_iterators(true, ram_table_ind);
+#if MBED_CONF_TDBSTORE_KEY_CACHE_ENABLED
+            ram_table[ram_table_ind].key = dup_key(items[i].key);
+#endif
+        }
+        ram_table[ram_table_ind].hash = hash;
+        ram_table[ram_table_ind].bd_offset = offset;
+        offset += record_size(items[i].key, items[i].size);
+    }
+    ret = MBED_SUCCESS;
+
+    _free_space_offset = offset;
+
+    // Same safety check as in set_finalize
+    os_ret = read_record(_active_area, _free_space_offset, 0, 0, 0, actual_data_size, 0,
+                         false, false, false, false, hash, flags, next_offset);
+    if (os_ret == MBED_SUCCESS) {
+        check_erase_before_write(_active_area, _free_space_offset, sizeof(record_header_t));
+    }
+
+    if (check_checkpoint(num_items)) {
+        need_gc = true;
+    }
+
+    check_gc_request();
+
+end:
+    if (need_gc) {
+        garbage_collection();
+    }
+    _mutex.unlock();
+    return ret;
+}
+
 int TDBStore::set(const char *key, const void *buffer, size_t size, uint32_t create_flags)
 {
     int ret;
@@ -750,7 +1137,7 @@ int TDBStore::get(const char *key, void *buffer, size_t buffer_size, size_t *act
         return MBED_ERROR_INVALID_ARGUMENT;
     }
 
-    _mutex.lock();
+    _mutex.lock_shared();
 
     ret = find_record(_active_area, key, bd_offset, ram_table_ind, hash);
 
@@ -766,7 +1153,60 @@ int TDBStore::get(const char *key, void *buffer, size_t buffer_size, size_t *act
     }
 
 end:
-    _mutex.unlock();
+    _mutex.unlock_shared();
+    return ret;
+}
+
+int TDBStore::get_view(const char *key, mbed::Span<const uint8_t> &view, void *buffer, size_t buffer_size)
+{
+    int ret;
+    uint32_t actual_data_size;
+    uint32_t bd_offset, next_bd_offset;
+    uint32_t flags, hash, ram_table_ind;
+    const void *mapped;
+
+    if (!is_valid_key(key)) {
+        return MBED_ERROR_INVALID_ARGUMENT;
+    }
+
+    _mutex.lock_shared();
+
+    ret = find_record(_active_area, key, bd_offset, ram_table_ind, hash);
+
+    if (ret != MBED_SUCCESS) {
+        goto end;
+    }
+
+    // Validate the record without copying its data
+    ret = read_record(_active_area, bd_offset, const_cast<char *>(key), 0, (uint32_t) -1,
+                      actual_data_size, 0, false, false, false, false, hash, flags, next_bd_offset);
+    if (ret) {
+        goto end;
+    }
+
+    mapped = _buff_bd->get_mapped_address(_area_params[_active_area].address + bd_offset +
+                                          align_up(sizeof(record_header_t), _prog_size) + strlen(key),
+                                          actual_data_size);
+    if (mapped) {
+        view = mbed::Span<const uint8_t>(static_cast<const uint8_t *>(mapped), actual_data_size);
+        goto end;
+    }
+
+    if (actual_data_size > buffer_size) {
+        ret = MBED_ERROR_INVALID_SIZE;
+        goto end;
+    }
+
+    ret = read_record(_active_area, bd_offset, const_cast<char *>(key), buffer, buffer_size,
+                      actual_data_size, 0, false, true, false, false, hash, flags, next_bd_offset);
+    if (ret) {
+        goto end;
+    }
+
+    view = mbed::Span<const uint8_t>(static_cast<const uint8_t *>(buffer), actual_data_size);
+
+end:
+    _mutex.unlock_shared();
     return ret;
 }
 
@@ -781,7 +1221,7 @@ int TDBStore::get_info(const char *key, info_t *info)
         return MBED_ERROR_INVALID_ARGUMENT;
     }
 
-    _mutex.lock();
+    _mutex.lock_shared();
 
     ret = find_record(_active_area, key, bd_offset, ram_table_ind, hash);
 
@@ -800,22 +1240,23 @@ int TDBStore::get_info(const char *key, info_t *info)
     }
 
     if (info) {
-        info->flags = flags;
+        info->flags = flags & ~batch_flag;
         info->size = actual_data_size;
     }
 
 end:
-    _mutex.unlock();
+    _mutex.unlock_shared();
     return ret;
 }
 
-int TDBStore::write_master_record(uint8_t area, uint16_t version, uint32_t &next_offset)
+int TDBStore::write_master_record(uint8_t area, uint16_t version, uint32_t &next_offset,
+                                  uint32_t checkpoint_offset)
 {
     master_record_data_t master_rec;
 
     master_rec.version = version;
     master_rec.tdbstore_revision = tdbstore_revision;
-    master_rec.reserved = 0;
+    master_rec.checkpoint_offset = checkpoint_offset;
     next_offset = _master_record_offset + _master_record_size;
     return set(master_rec_key, &master_rec, sizeof(master_rec), 0);
 }
@@ -825,16 +1266,19 @@ int TDBStore::copy_record(uint8_t from_area, uint32_t from_offset, uint32_t to_o
 {
     int ret;
     record_header_t header;
-    uint32_t total_size;
+    uint32_t total_size, header_size, crc_size;
+    uint32_t header_offset = to_offset;
+    uint32_t crc = initial_crc;
     uint16_t chunk_size;
+    bool strip_batch_flag;
 
     ret = read_area(from_area, from_offset, sizeof(header), &header);
     if (ret) {
         return ret;
     }
 
-    total_size = align_up(sizeof(record_header_t), _prog_size) +
-                 align_up(header.key_size + header.data_size, _prog_size);;
+    header_size = align_up(sizeof(record_header_t), _prog_size);
+    total_size = header_size + align_up(header.key_size + header.data_size, _prog_size);
 
 
     if (to_offset + total_size > _size) {
@@ -846,18 +1290,18 @@ int TDBStore::copy_record(uint8_t from_area, uint32_t from_offset, uint32_t to_o
         return ret;
     }
 
-    chunk_size = align_up(sizeof(record_header_t), _prog_size);
-    // The record header takes up whole program units
-    memset(_work_buf, 0, chunk_size);
-    memcpy(_work_buf, &header, sizeof(record_header_t));
-    ret = write_area(1 - from_area, to_offset, chunk_size, _work_buf);
-    if (ret) {
-        return ret;
+    // Once copied, a batch record stands on its own (its batch may not be copied as a whole),
+    // so clear its batch flag, recalculating the CRC on the way.
+    strip_batch_flag = header.flags & batch_flag;
+    if (strip_batch_flag) {
+        header.flags &= ~batch_flag;
+        crc = calc_crc(crc, sizeof(record_header_t) - sizeof(crc), &header);
     }
+    crc_size = header.key_size + header.data_size;
 
-    from_offset += chunk_size;
-    to_offset += chunk_size;
-    total_size -= chunk_size;
+    from_offset += header_size;
+    to_offset += header_size;
+    total_size -= header_size;
 
     while (total_size) {
         chunk_size = std::min<size_t>(total_size, _work_buf_size);
@@ -866,6 +1310,12 @@ int TDBStore::copy_record(uint8_t from_area, uint32_t from_offset, uint32_t to_o
             return ret;
         }
 
+        if (strip_batch_flag && crc_size) {
+            uint32_t crc_chunk_size = std::min<uint32_t>(chunk_size, crc_size);
+            crc = calc_crc(crc, crc_chunk_size, _work_buf);
+            crc_size -= crc_chunk_size;
+        }
+
         ret = write_area(1 - from_area, to_offset, chunk_size, _work_buf);
         if (ret) {
             return ret;
@@ -876,6 +1326,18 @@ int TDBStore::copy_record(uint8_t from_area, uint32_t from_offset, uint32_t to_o
         total_size -= chunk_size;
     }
 
+    if (strip_batch_flag) {
+        header.crc = crc;
+    }
+
+    // Header is written last, as in a regular set. It takes up whole program units.
+    memset(_work_buf, 0, header_size);
+    memcpy(_work_buf, &header, sizeof(record_header_t));
+    ret = write_area(1 - from_area, header_offset, header_size, _work_buf);
+    if (ret) {
+        return ret;
+    }
+
     to_next_offset = align_up(to_offset, _prog_size);
     return MBED_SUCCESS;
 }
@@ -887,6 +1349,9 @@ int TDBStore::garbage_collection()
     int ret;
     size_t ind;
 
+    // Full collection supersedes any incremental one in progress
+    gc_abort();
+
     // Reset the standby area
     ret = reset_area(1 - _active_area);
     if (ret) {
@@ -916,9 +1381,14 @@ int TDBStore::garbage_collection()
     // Now we can switch to the new active area
     _active_area = 1 - _active_area;
 
-    // Now write master record, with version incremented by 1.
+    // Now write master record, with version incremented by 1,
+    // pointing to a checkpoint of the compacted RAM table.
     _active_area_version++;
-    ret = write_master_record(_active_area, _active_area_version, to_offset);
+    _checkpoint_offset = 0;
+#if MBED_CONF_TDBSTORE_CHECKPOINT_INTERVAL
+    write_checkpoint();
+#endif
+    ret = write_master_record(_active_area, _active_area_version, to_offset, _checkpoint_offset);
     if (ret) {
         return ret;
     }
@@ -926,20 +1396,379 @@ int TDBStore::garbage_collection()
     return MBED_SUCCESS;
 }
 
+int TDBStore::do_gc_step(size_t max_records)
+{
+    ram_table_entry_t *ram_table = (ram_table_entry_t *) _ram_table;
+    uint32_t to_next_offset;
+    size_t remaining = 0;
+    size_t ind;
+    int ret;
+
+    if (!_gc_offsets) {
+        // Start a new cycle. Standby area only gets a master record once all
+        // records are copied, so it stays invalid until then.
+        ret = reset_area(1 - _active_area);
+        if (ret) {
+            return ret;
+        }
+        _gc_offsets = new uint32_t[_max_keys];
+        memset(_gc_offsets, 0, sizeof(uint32_t) * _max_keys);
+        _gc_to_offset = _master_record_offset + _master_record_size;
+    }
+
+    for (ind = 0; ind < _num_keys; ind++) {
+        if (_gc_offsets[ind] && !(_gc_offsets[ind] & gc_stale_flag)) {
+            continue;
+        }
+        if (!max_records) {
+            remaining++;
+            continue;
+        }
+        ret = copy_record(_active_area, ram_table[ind].bd_offset, _gc_to_offset, to_next_offset);
+        if (ret) {
+            gc_abort();
+            return ret;
+        }
+        _gc_offsets[ind] = _gc_to_offset;
+        _gc_to_offset = to_next_offset;
+        max_records--;
+    }
+
+    if (remaining) {
+        return remaining;
+    }
+
+    // All live records are on the standby area - switch to it
+    for (ind = 0; ind < _num_keys; ind++) {
+        ram_table[ind].bd_offset = _gc_offsets[ind];
+    }
+    _free_space_offset = _gc_to_offset;
+    gc_abort();
 
-int TDBStore::build_ram_table()
+    _active_area = 1 - _active_area;
+
+    _active_area_version++;
+    _checkpoint_offset = 0;
+#if MBED_CONF_TDBSTORE_CHECKPOINT_INTERVAL
+    write_checkpoint();
+#endif
+    return write_master_record(_active_area, _active_area_version, to_next_offset, _checkpoint_offset);
+}
+
+void TDBStore::gc_abort()
+{
+    delete[] _gc_offsets;
+    _gc_offsets = nullptr;
+    _gc_requested = false;
+}
+
+void TDBStore::gc_track_update(uint32_t ram_table_ind, uint32_t bd_offset, bool new_key, bool deleted)
+{
+    uint32_t to_next_offset;
+
+    if (!_gc_offsets) {
+        return;
+    }
+
+    if (deleted) {
+        // If standby area already holds this key, it has to see the deletion as well
+        if (_gc_offsets[ram_table_ind]) {
+            if (copy_record(_active_area, bd_offset, _gc_to_offset, to_next_offset)) {
+                gc_abort();
+                return;
+            }
+            _gc_to_offset = to_next_offset;
+        }
+        memmove(&_gc_offsets[ram_table_ind], &_gc_offsets[ram_table_ind + 1],
+                sizeof(uint32_t) * (_num_keys - ram_table_ind - 1));
+    } else if (new_key) {
+        memmove(&_gc_offsets[ram_table_ind + 1], &_gc_offsets[ram_table_ind],
+                sizeof(uint32_t) * (_num_keys - ram_table_ind));
+        _gc_offsets[ram_table_ind] = 0;
+    } else if (_gc_offsets[ram_table_ind]) {
+        // Copy on standby area is outdated, will be copied again by a later step
+        _gc_offsets[ram_table_ind] |= gc_stale_flag;
+    }
+}
+
+void TDBStore::check_gc_request()
+{
+    if (_gc_request_cb && !_gc_offsets && !_gc_requested &&
+            (_free_space_offset > _size / 100 * MBED_CONF_TDBSTORE_GC_REQUEST_THRESHOLD)) {
+        _gc_requested = true;
+        _gc_request_cb();
+    }
+}
+
+int TDBStore::gc_step(size_t max_records)
+{
+    if (!_is_initialized) {
+        return MBED_ERROR_NOT_READY;
+    }
+
+    _mutex.lock();
+    int ret = do_gc_step(max_records);
+    _mutex.unlock();
+    return ret;
+}
+
+void TDBStore::attach_gc_request(mbed::Callback<void()> cb)
+{
+    _mutex.lock();
+    _gc_request_cb = cb;
+    _mutex.unlock();
+}
+
+
+int TDBStore::write_checkpoint()
 {
     ram_table_entry_t *ram_table = (ram_table_entry_t *) _ram_table;
+    checkpoint_entry_t *entries = reinterpret_cast<checkpoint_entry_t *>(_work_buf);
+    checkpoint_data_t cp_data;
+    record_header_t header;
+    uint32_t offset = _free_space_offset;
+    uint32_t key_size = strlen(checkpoint_key);
+    uint32_t data_size = sizeof(cp_data) + sizeof(checkpoint_entry_t) * _num_keys;
+    uint32_t rec_size = record_size(checkpoint_key, data_size);
+    uint32_t max_chunk_entries = _work_buf_size / sizeof(checkpoint_entry_t);
+    uint32_t chunk_entries, chunk_size, data_offset, ind;
+    uint32_t actual_data_size, hash, flags, next_offset;
+    int ret;
+
+    if (offset + rec_size > _size) {
+        return MBED_ERROR_MEDIA_FULL;
+    }
+
+    ret = check_erase_before_write(_active_area, offset, rec_size);
+    if (ret) {
+        return ret;
+    }
+
+    cp_data.offset = offset;
+    cp_data.prev_offset = _checkpoint_offset;
+    cp_data.version = _active_area_version;
+    cp_data.reserved = 0;
+    cp_data.num_keys = _num_keys;
+
+    header.magic = tdbstore_magic;
+    header.header_size = sizeof(record_header_t);
+    header.revision = tdbstore_revision;
+    header.flags = delete_flag | checkpoint_flag;
+    header.key_size = key_size;
+    header.reserved = 0;
+    header.data_size = data_size;
+    header.crc = calc_crc(initial_crc, sizeof(record_header_t) - sizeof(header.crc), &header);
+    header.crc = calc_crc(header.crc, key_size, checkpoint_key);
+    header.crc = calc_crc(header.crc, sizeof(cp_data), &cp_data);
+
+    data_offset = offset + align_up(sizeof(record_header_t), _prog_size);
+    ret = write_area(_active_area, data_offset, key_size, checkpoint_key);
+    if (ret) {
+        return ret;
+    }
+    data_offset += key_size;
+    ret = write_area(_active_area, data_offset, sizeof(cp_data), &cp_data);
+    if (ret) {
+        return ret;
+    }
+    data_offset += sizeof(cp_data);
+
+    // Entries go through the work buffer, one chunk at a time
+    for (ind = 0; ind < _num_keys; ind += chunk_entries) {
+        chunk_entries = std::min<uint32_t>(max_chunk_entries, _num_keys - ind);
+        for (uint32_t i = 0; i < chunk_entries; i++) {
+            entries[i].hash = ram_table[ind + i].hash;
+            entries[i].bd_offset = ram_table[ind + i].bd_offset;
+        }
+        chunk_size = chunk_entries * sizeof(checkpoint_entry_t);
+        header.crc = calc_crc(header.crc, chunk_size, entries);
+        ret = write_area(_active_area, data_offset, chunk_size, entries);
+        if (ret) {
+            return ret;
+        }
+        data_offset += chunk_size;
+    }
+
+    ret = write_area(_active_area, offset, sizeof(record_header_t), &header);
+    if (ret) {
+        return ret;
+    }
+
+    if (_buff_bd->sync()) {
+        return MBED_ERROR_WRITE_FAILED;
+    }
+
+    // Reread the record to ensure write success, as in set_finalize
+    ret = read_record(_active_area, offset, 0, 0, (uint32_t) -1, actual_data_size, 0,
+                      false, false, false, false, hash, flags, next_offset);
+    if (ret) {
+        return ret;
+    }
+
+    _free_space_offset = next_offset;
+    _checkpoint_offset = offset;
+    _records_since_checkpoint = 0;
+
+    // Same safety check as in set_finalize
+    ret = read_record(_active_area, _free_space_offset, 0, 0, 0, actual_data_size, 0,
+                      false, false, false, false, hash, flags, next_offset);
+    if (ret == MBED_SUCCESS) {
+        check_erase_before_write(_active_area, _free_space_offset, sizeof(record_header_t));
+    }
+
+    return MBED_SUCCESS;
+}
+
+int TDBStore::check_checkpoint(uint32_t num_records)
+{
+#if MBED_CONF_TDBSTORE_CHECKPOINT_INTERVAL
+    _records_since_checkpoint += num_records;
+    if (_records_since_checkpoint >= MBED_CONF_TDBSTORE_CHECKPOINT_INTERVAL) {
+        int ret = write_checkpoint();
+        // With no room left, the garbage collection to come writes one anyway
+        if (ret != MBED_ERROR_MEDIA_FULL) {
+            return ret;
+        }
+    }
+#else
+    (void) num_records;
+#endif
+    return MBED_SUCCESS;
+}
+
+int TDBStore::load_checkpoint(uint32_t start_offset, uint32_t &next_offset)
+{
+    ram_table_entry_t *ram_table;
+    checkpoint_entry_t *entries = reinterpret_cast<checkpoint_entry_t *>(_work_buf);
+    checkpoint_data_t cp_data;
+    record_header_t header;
+    uint32_t header_size = align_up(sizeof(record_header_t), _prog_size);
+    uint32_t key_size = strlen(checkpoint_key);
+    uint32_t max_chunk_entries = _work_buf_size / sizeof(checkpoint_entry_t);
+    uint32_t offset = start_offset, checkpoint_offset = 0;
+    uint32_t chunk_entries, chunk_size, data_offset, ind, crc;
+    int ret;
+
+    // Hop over the record headers, without reading (nor verifying) the records, to the last
+    // checkpoint. Records before it were verified when it was written. Only follow checkpoints
+    // chaining back to the start one, so stale records of an older use of the area are left out.
+    while (offset + sizeof(header) < _free_space_offset) {
+        if (read_area(_active_area, offset, sizeof(header), &header) ||
+                (header.magic != tdbstore_magic) || !header.key_size || (header.key_size >= MAX_KEY_SIZE) ||
+                (header.data_size >= _size)) {
+            break;
+        }
+        if ((header.flags & checkpoint_flag) && (header.key_size == key_size) &&
+                (header.data_size >= sizeof(cp_data))) {
+            if (read_area(_active_area, offset + header_size + key_size, sizeof(cp_data), &cp_data)) {
+                break;
+            }
+            if ((cp_data.offset == offset) && (cp_data.prev_offset == checkpoint_offset) &&
+                    (cp_data.version == _active_area_version)) {
+                checkpoint_offset = offset;
+            }
+        }
+        offset += header_size + align_up(header.key_size + header.data_size, _prog_size);
+    }
+
+    if (!checkpoint_offset) {
+        return MBED_ERROR_ITEM_NOT_FOUND;
+    }
+
+    // Now read and verify the checkpoint itself
+    ret = read_area(_active_area, checkpoint_offset, sizeof(header), &header);
+    if (ret) {
+        return ret;
+    }
+    crc = calc_crc(initial_crc, sizeof(record_header_t) - sizeof(header.crc), &header);
+    data_offset = checkpoint_offset + header_size;
+
+    ret = read_area(_active_area, data_offset, key_size, _key_buf);
+    if (ret) {
+        return ret;
+    }
+    crc = calc_crc(crc, key_size, _key_buf);
+    data_offset += key_size;
+
+    ret = read_area(_active_area, data_offset, sizeof(cp_data), &cp_data);
+    if (ret) {
+        return ret;
+    }
+    crc = calc_crc(crc, sizeof(cp_data), &cp_data);
+    data_offset += sizeof(cp_data);
+
+    if (memcmp(_key_buf, checkpoint_key, key_size) || (cp_data.num_keys > _size / sizeof(checkpoint_entry_t)) ||
+            (header.data_size != sizeof(cp_data) + sizeof(checkpoint_entry_t) * cp_data.num_keys)) {
+        return MBED_ERROR_INVALID_DATA_DETECTED;
+    }
+
+    ram_table = (ram_table_entry_t *) _ram_table;
+    if (cp_data.num_keys > _max_keys) {
+        // RAM table is still empty, no need to copy it
+        delete[] ram_table;
+        _max_keys = cp_data.num_keys;
+        ram_table = new ram_table_entry_t[_max_keys];
+        memset(ram_table, 0, sizeof(ram_table_entry_t) * _max_keys);
+        _ram_table = ram_table;
+    }
+
+    for (ind = 0; ind < cp_data.num_keys; ind += chunk_entries) {
+        chunk_entries = std::min<uint32_t>(max_chunk_entries, cp_data.num_keys - ind);
+        chunk_size = chunk_entries * sizeof(checkpoint_entry_t);
+        ret = read_area(_active_area, data_offset, chunk_size, entries);
+        if (ret) {
+            return ret;
+        }
+        crc = calc_crc(crc, chunk_size, entries);
+        for (uint32_t i = 0; i < chunk_entries; i++) {
+            // Records precede the checkpoint, and RAM table is sorted by descending hash
+            if ((entries[i].bd_offset < _master_record_offset) || (entries[i].bd_offset >= checkpoint_offset) ||
+                    (ind + i && (entries[i].hash > ram_table[ind + i - 1].hash))) {
+                return MBED_ERROR_INVALID_DATA_DETECTED;
+            }
+            ram_table[ind + i].hash = entries[i].hash;
+            ram_table[ind + i].bd_offset = entries[i].bd_offset;
+        }
+        data_offset += chunk_size;
+    }
+
+    if (crc != header.crc) {
+        return MBED_ERROR_INVALID_DATA_DETECTED;
+    }
+
+    _num_keys = cp_data.num_keys;
+    _checkpoint_offset = checkpoint_offset;
+    next_offset = align_up(data_offset, _prog_size);
+    return MBED_SUCCESS;
+}
+
+int TDBStore::build_ram_table(uint32_t checkpoint_offset)
+{
+    ram_table_entry_t *ram_table;
     uint32_t offset, next_offset = 0, dummy;
     int ret = MBED_SUCCESS;
     uint32_t hash;
     uint32_t flags;
     uint32_t actual_data_size;
     uint32_t ram_table_ind;
+    uint32_t batch_end_offset = 0;
 
     _num_keys = 0;
+    _checkpoint_offset = 0;
+    _records_since_checkpoint = 0;
     offset = _master_record_offset;
 
+    // Skip the records covered by the last checkpoint. The one the master record points to
+    // was written by the last garbage collection, so later ones can only follow it.
+    if (checkpoint_offset || MBED_CONF_TDBSTORE_CHECKPOINT_INTERVAL) {
+        if (load_checkpoint(checkpoint_offset ? checkpoint_offset : _master_record_offset,
+                            next_offset) == MBED_SUCCESS) {
+            offset = next_offset;
+        }
+    }
+    // Loading may have reallocated it
+    ram_table = (ram_table_entry_t *) _ram_table;
+
     while (offset + sizeof(record_header_t) < _free_space_offset) {
         ret = read_record(_active_area, offset, _key_buf, 0, 0, actual_data_size, 0,
                           true, false, false, true, hash, flags, next_offset);
@@ -948,6 +1777,24 @@ int TDBStore::build_ram_table()
             goto end;
         }
 
+        // Only the last checkpoint is loaded, earlier ones are outdated
+        if (flags & checkpoint_flag) {
+            offset = next_offset;
+            continue;
+        }
+        _records_since_checkpoint++;
+
+        // A batch is applied only if all its records made it to the media.
+        // Otherwise, treat its first record as the end of valid data.
+        if ((flags & batch_flag) && (offset >= batch_end_offset)) {
+            ret = validate_batch(offset, batch_end_offset);
+            if (ret) {
+                ret = MBED_ERROR_INVALID_DATA_DETECTED;
+                next_offset = offset;
+                goto end;
+            }
+        }
+
         ret = find_record(_active_area, _key_buf, dummy, ram_table_ind, hash);
 
         if ((ret != MBED_SUCCESS) && (ret != MBED_ERROR_ITEM_NOT_FOUND)) {
@@ -973,7 +1820,13 @@ int TDBStore::build_ram_table()
                     sizeof(ram_table_entry_t) * (_num_keys - ram_table_ind));
 
             _num_keys++;
+#if MBED_CONF_TDBSTORE_KEY_CACHE_ENABLED
+            ram_table[ram_table_ind].key = dup_key(_key_buf);
+#endif
         } else if (flags & delete_flag) {
+#if MBED_CONF_TDBSTORE_KEY_CACHE_ENABLED
+            delete[] ram_table[ram_table_ind].key;
+#endif
             _num_keys--;
             memmove(&ram_table[ram_table_ind], &ram_table[ram_table_ind + 1],
                     sizeof(ram_table_entry_t) * (_num_keys - ram_table_ind));
@@ -1000,6 +1853,14 @@ int TDBStore::increment_max_keys(void **ram_table)
 
     // Copy old content to new table
     memcpy(new_ram_table, old_ram_table, sizeof(ram_table_entry_t) * _max_keys);
+
+    if (_gc_offsets) {
+        uint32_t *new_gc_offsets = new uint32_t[_max_keys + 1];
+        memcpy(new_gc_offsets, _gc_offsets, sizeof(uint32_t) * _max_keys);
+        new_gc_offsets[_max_keys] = 0;
+        delete[] _gc_offsets;
+        _gc_offsets = new_gc_offsets;
+    }
     _max_keys++;
 
     _ram_table = new_ram_table;
@@ -1021,6 +1882,7 @@ int TDBStore::init()
     uint32_t actual_data_size;
     int ret = MBED_SUCCESS;
     uint16_t versions[_num_areas];
+    uint32_t checkpoint_offsets[_num_areas];
 
     _mutex.lock();
 
@@ -1064,6 +1926,7 @@ int TDBStore::init()
     for (uint8_t area = 0; area < _num_areas; area++) {
         area_state[area] = TDBSTORE_AREA_STATE_NONE;
         versions[area] = 0;
+        checkpoint_offsets[area] = 0;
 
         _size = std::min(_size, _area_params[area].size);
 
@@ -1083,6 +1946,7 @@ int TDBStore::init()
         }
 
         versions[area] = master_rec.version;
+        checkpoint_offsets[area] = master_rec.checkpoint_offset;
 
         area_state[area] = TDBSTORE_AREA_STATE_VALID;
 
@@ -1120,7 +1984,7 @@ int TDBStore::init()
     // Currently set free space offset pointer to the end of free space.
     // Ram table build process needs it, but will update it.
     _free_space_offset = _size;
-    ret = build_ram_table();
+    ret = build_ram_table(checkpoint_offsets[_active_area]);
 
     // build_ram_table() scans all keys, until invalid data found.
     // Therefore INVALID_DATA is not considered error.
@@ -1133,6 +1997,9 @@ end:
     _mutex.unlock();
     return MBED_SUCCESS;
 fail:
+    free_cached_keys();
+    // Building the RAM table may have reallocated it
+    ram_table = (ram_table_entry_t *) _ram_table;
     delete[] ram_table;
     delete _buff_bd;
     delete[] _work_buf;
@@ -1151,9 +2018,11 @@ int TDBStore::deinit()
 {
     _mutex.lock();
     if (_is_initialized) {
+        gc_abort();
         _buff_bd->deinit();
         delete _buff_bd;
 
+        free_cached_keys();
         ram_table_entry_t *ram_table = (ram_table_entry_t *) _ram_table;
         delete[] ram_table;
         delete[] _work_buf;
@@ -1194,6 +2063,8 @@ int TDBStore::reset()
 
     _mutex.lock();
 
+    gc_abort();
+
     // Reset both areas
     for (area = 0; area < _num_areas; area++) {
         ret = check_erase_before_write(area, 0, _master_record_offset + _master_record_size + _prog_size, true);
@@ -1202,10 +2073,13 @@ int TDBStore::reset()
         }
     }
 
+    free_cached_keys();
     _active_area = 0;
     _num_keys = 0;
     _free_space_offset = _master_record_offset;
     _active_area_version = 1;
+    _checkpoint_offset = 0;
+    _records_since_checkpoint = 0;
     memset(_ram_table, 0, sizeof(ram_table_entry_t) * _max_keys);
     // Write an initial master record on active area
     ret = write_master_record(_active_area, _active_area_version, _free_space_offset);
@@ -1278,10 +2152,18 @@ int TDBStore::iterator_next(iterator_t it, char *key, size_t key_size)
     ret = MBED_ERROR_ITEM_NOT_FOUND;
 
     while (ret && (handle->ram_table_ind < _num_keys)) {
-        ret = read_record(_active_area, ram_table[handle->ram_table_ind].bd_offset, _key_buf,
-                          0, 0, actual_data_size, 0, true, false, false, false, hash, flags, next_offset);
-        if (ret) {
-            goto end;
+#if MBED_CONF_TDBSTORE_KEY_CACHE_ENABLED
+        if (ram_table[handle->ram_table_ind].key) {
+            strcpy(_key_buf, ram_table[handle->ram_table_ind].key);
+            ret = MBED_SUCCESS;
+        } else
+#endif
+        {
+            ret = read_record(_active_area, ram_table[handle->ram_table_ind].bd_offset, _key_buf,
+                              0, 0, actual_data_size, 0, true, false, false, false, hash, flags, next_offset);
+            if (ret) {
+                goto end;
+            }
         }
         if (!handle->prefix || (strstr(_key_buf, handle->prefix) == _key_buf)) {
             if (strlen(_key_buf) >= key_size) {
@@ -1320,6 +2202,17 @@ int TDBStore::iterator_close(iterator_t it)
     return MBED_SUCCESS;
 }
 
+void TDBStore::free_cached_keys()
+{
+#if MBED_CONF_TDBSTORE_KEY_CACHE_ENABLED
+    ram_table_entry_t *ram_table = (ram_table_entry_t *) _ram_table;
+    for (size_t ind = 0; ind < _num_keys; ind++) {
+        delete[] ram_table[ind].key;
+        ram_table[ind].key = nullptr;
+    }
+#endif
+}
+
 void TDBStore::update_all_iterators(bool added, uint32_t ram_table_ind)
 {
     for (int it_num = 0; it_num < _max_open_iterators; it_num++) {
@@ -1363,6 +2256,7 @@ int TDBStore::reserved_data_set(const void *reserved_data, size_t reserved_data_
 
     // Erase the header of non-active area, just to make sure that we can write to it
     // In case garbage collection has not yet been run, the area can be un-erased
+    gc_abort();
     ret = reset_area(1 - _active_area);
     if (ret) {
         goto end;
@@ -0,0 +1,21 @@
+
+####################
+# BENCHMARKS
+####################
+
+set(benchmark-includes ${benchmark-includes}
+  .
+  ..
+  ../platform/mbed-trace/mbed-trace
+)
+
+set(benchmark-sources
+  ../storage/blockdevice/source/HeapBlockDevice.cpp
+  ../storage/blockdevice/source/BufferedBlockDevice.cpp
+  ../storage/kvstore/tdbstore/source/TDBStore.cpp
+  ../platform/mbed-trace/source/mbed_trace.c
+  stubs/mbed_atomic_stub.c
+  stubs/mbed_assert_stub.cpp
+  stubs/mbed_error.c
+  ../storage/kvstore/tdbstore/tests/BENCHMARKS/TDBStore/benchmark_TDBStore.cpp
+)
@@ -0,0 +1,102 @@
+/* Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "benchmark/benchmark.h"
+#include "blockdevice/HeapBlockDevice.h"
+#include "tdbstore/TDBStore.h"
+#include <stdio.h>
+#include <string.h>
+
+#define BLOCK_SIZE  (4096)
+#define DEVICE_SIZE (BLOCK_SIZE * 32)
+#define KEYS        (64)
+
+using namespace mbed;
+
+static void key_name(char *key, int i)
+{
+    snprintf(key, 16, "key%d", i);
+}
+
+// Set keys in turn, which also counts the garbage collections they trigger
+static void BM_TDBStore_set(benchmark::State &state)
+{
+    HeapBlockDevice heap{DEVICE_SIZE, BLOCK_SIZE};
+    TDBStore tdb{&heap};
+    tdb.init();
+    tdb.reset();
+    uint8_t data[1024] = {};
+    char key[16];
+    int i = 0;
+
+    for (auto _ : state) {
+        key_name(key, i++ % KEYS);
+        tdb.set(key, data, state.range(0), 0);
+    }
+
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+    tdb.deinit();
+}
+BENCHMARK(BM_TDBStore_set)->Arg(16)->Arg(256)->Arg(1024);
+
+// Get keys from a store holding KEYS of them
+static void BM_TDBStore_get(benchmark::State &state)
+{
+    HeapBlockDevice heap{DEVICE_SIZE, BLOCK_SIZE};
+    TDBStore tdb{&heap};
+    tdb.init();
+    tdb.reset();
+    uint8_t data[1024] = {};
+    char key[16];
+    for (int i = 0; i < KEYS; i++) {
+        key_name(key, i);
+        tdb.set(key, data, state.range(0), 0);
+    }
+    int i = 0;
+
+    for (auto _ : state) {
+        size_t size;
+        key_name(key, i++ % KEYS);
+        tdb.get(key, data, sizeof(data), &size);
+        benchmark::DoNotOptimize(size);
+    }
+
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+    tdb.deinit();
+}
+BENCHMARK(BM_TDBStore_get)->Arg(16)->Arg(256)->Arg(1024);
+
+// Mount a store holding KEYS keys, which rebuilds the RAM table
+static void BM_TDBStore_init(benchmark::State &state)
+{
+    HeapBlockDevice heap{DEVICE_SIZE, BLOCK_SIZE};
+    TDBStore tdb{&heap};
+    tdb.init();
+    tdb.reset();
+    uint8_t data[64] = {};
+    char key[16];
+    for (int i = 0; i < KEYS; i++) {
+        key_name(key, i);
+        tdb.set(key, data, sizeof(data), 0);
+    }
+    tdb.deinit();
+
+    for (auto _ : state) {
+        tdb.init();
+        tdb.deinit();
+    }
+}
+BENCHMARK(BM_TDBStore_init);
@@ -18,6 +18,7 @@
 #include "blockdevice/HeapBlockDevice.h"
 #include "tdbstore/TDBStore.h"
 #include <stdlib.h>
+#include <string.h>
 
 #define BLOCK_SIZE (256)
 #define DEVICE_SIZE (BLOCK_SIZE*200)
@@ -41,6 +42,76 @@ protected:
     }
 };
 
+// Flat RAM block device, readable in place like memory-mapped internal flash
+class MappedRamBlockDevice : public BlockDevice {
+public:
+    MappedRamBlockDevice(bd_size_t size, bd_size_t erase_size) : _size(size), _erase_size(erase_size)
+    {
+        _mem = new uint8_t[size];
+        memset(_mem, 0xFF, size);
+    }
+    virtual ~MappedRamBlockDevice()
+    {
+        delete[] _mem;
+    }
+    virtual int init()
+    {
+        return BD_ERROR_OK;
+    }
+    virtual int deinit()
+    {
+        return BD_ERROR_OK;
+    }
+    virtual int read(void *buffer, bd_addr_t addr, bd_size_t size)
+    {
+        memcpy(buffer, _mem + addr, size);
+        return BD_ERROR_OK;
+    }
+    virtual int program(const void *buffer, bd_addr_t addr, bd_size_t size)
+    {
+        memcpy(_mem + addr, buffer, size);
+        return BD_ERROR_OK;
+    }
+    virtual int erase(bd_addr_t addr, bd_size_t size)
+    {
+        memset(_mem + addr, 0xFF, size);
+        return BD_ERROR_OK;
+    }
+    virtual bd_size_t get_read_size() const
+    {
+        return 1;
+    }
+    virtual bd_size_t get_program_size() const
+    {
+        return 1;
+    }
+    virtual bd_size_t get_erase_size() const
+    {
+        return _erase_size;
+    }
+    virtual int get_erase_value() const
+    {
+        return 0xFF;
+    }
+    virtual bd_size_t size() const
+    {
+        return _size;
+    }
+    virtual const void *get_mapped_address(bd_addr_t addr, bd_size_t size) const
+    {
+        return (addr + size <= _size) ? _mem + addr : NULL;
+    }
+    virtual const char *get_type() const
+    {
+        return "MAPPEDRAM";
+    }
+
+private:
+    uint8_t *_mem;
+    bd_size_t _size;
+    bd_size_t _erase_size;
+};
+
 TEST_F(TDBStoreModuleTest, init)
 {
     EXPECT_EQ(tdb.deinit(), MBED_SUCCESS);
@@ -90,6 +161,130 @@ TEST_F(TDBStoreModuleTest, set_deinit_init_get)
     }
 }
 
+TEST_F(TDBStoreModuleTest, set_get_many_keys)
+{
+    // Small program unit, so a few hundred records fit in one area
+    HeapBlockDevice small_prog_heap{64 * 1024, 1, 1, 4096};
+    TDBStore store{&small_prog_heap};
+    const int num_keys = 300;
+    char key[16];
+    char buf[16];
+    size_t size;
+    EXPECT_EQ(store.init(), MBED_SUCCESS);
+    for (int i = 0; i < num_keys; ++i) {
+        snprintf(key, sizeof(key), "key%d", i);
+        EXPECT_EQ(store.set(key, &i, sizeof(i), 0), MBED_SUCCESS);
+    }
+    // Remove every other key, then check all of them both before and after re-init
+    for (int i = 0; i < num_keys; i += 2) {
+        snprintf(key, sizeof(key), "key%d", i);
+        EXPECT_EQ(store.remove(key), MBED_SUCCESS);
+    }
+    for (int pass = 0; pass < 2; ++pass) {
+        for (int i = 0; i < num_keys; ++i) {
+            snprintf(key, sizeof(key), "key%d", i);
+            if (i % 2) {
+                EXPECT_EQ(store.get(key, buf, sizeof(buf), &size), MBED_SUCCESS);
+                EXPECT_EQ(size, sizeof(i));
+                EXPECT_EQ(0, memcmp(buf, &i, sizeof(i)));
+            } else {
+                EXPECT_EQ(store.get(key, buf, sizeof(buf), &size), MBED_ERROR_ITEM_NOT_FOUND);
+            }
+        }
+        EXPECT_EQ(store.deinit(), MBED_SUCCESS);
+        EXPECT_EQ(store.init(), MBED_SUCCESS);
+    }
+    EXPECT_EQ(store.deinit(), MBED_SUCCESS);
+}
+
+static void check_checkpoint_keys(TDBStore &store)
+{
+    char key[16];
+    int val;
+    for (int i = 0; i < 20; ++i) {
+        snprintf(key, sizeof(key), "key%d", i);
+        if (i % 5 == 0) {
+            EXPECT_EQ(store.get(key, &val, sizeof(val)), MBED_ERROR_ITEM_NOT_FOUND);
+            continue;
+        }
+        EXPECT_EQ(store.get(key, &val, sizeof(val)), MBED_SUCCESS);
+        EXPECT_EQ(val, i % 3 ? i : -i);
+    }
+}
+
+static void set_checkpoint_keys(TDBStore &store)
+{
+    char key[16];
+    for (int i = 0; i < 20; ++i) {
+        snprintf(key, sizeof(key), "key%d", i);
+        EXPECT_EQ(store.set(key, &i, sizeof(i), 0), MBED_SUCCESS);
+    }
+    for (int i = 0; i < 20; ++i) {
+        snprintf(key, sizeof(key), "key%d", i);
+        int val = -i;
+        if (i % 5 == 0) {
+            EXPECT_EQ(store.remove(key), MBED_SUCCESS);
+        } else if (i % 3 == 0) {
+            EXPECT_EQ(store.set(key, &val, sizeof(val), 0), MBED_SUCCESS);
+        }
+    }
+}
+
+TEST_F(TDBStoreModuleTest, checkpoint_init)
+{
+    // Enough records for a few checkpoints, with the last one followed by some more records
+    set_checkpoint_keys(tdb);
+    for (int pass = 0; pass < 2; ++pass) {
+        check_checkpoint_keys(tdb);
+        EXPECT_EQ(tdb.deinit(), MBED_SUCCESS);
+        EXPECT_EQ(tdb.init(), MBED_SUCCESS);
+    }
+
+    // Garbage collection writes a checkpoint the master record points to
+    int ret;
+    while ((ret = tdb.gc_step(4)) > 0) {
+    }
+    EXPECT_EQ(ret, MBED_SUCCESS);
+    int val = 1;
+    EXPECT_EQ(tdb.set("other", &val, sizeof(val), 0), MBED_SUCCESS);
+    for (int pass = 0; pass < 2; ++pass) {
+        check_checkpoint_keys(tdb);
+        EXPECT_EQ(tdb.get("other", &val, sizeof(val)), MBED_SUCCESS);
+        EXPECT_EQ(tdb.deinit(), MBED_SUCCESS);
+        EXPECT_EQ(tdb.init(), MBED_SUCCESS);
+    }
+}
+
+TEST_F(TDBStoreModuleTest, checkpoint_corrupted)
+{
+    char key[16];
+    int val;
+    EXPECT_EQ(heap.init(), MBED_SUCCESS); // Extra init, so the heap will not be deinitialized
+    // Checkpoint follows the 8th record
+    for (int i = 0; i < 8; ++i) {
+        snprintf(key, sizeof(key), "key%d", i);
+        EXPECT_EQ(tdb.set(key, &i, sizeof(i), 0), MBED_SUCCESS);
+    }
+    EXPECT_EQ(tdb.deinit(), MBED_SUCCESS);
+
+    // Corrupt the first entry of the checkpoint - init must not use it, but scan the records instead
+    char *contents = new char[DEVICE_SIZE];
+    EXPECT_EQ(heap.read(contents, 0, DEVICE_SIZE), MBED_SUCCESS);
+    char *checkpoint = static_cast<char *>(memmem(contents, DEVICE_SIZE, "*TDBC", 5));
+    ASSERT_NE(checkpoint, nullptr);
+    checkpoint[5 + 16] ^= 0x55;
+    EXPECT_EQ(heap.program(contents, 0, DEVICE_SIZE), MBED_SUCCESS);
+    delete[] contents;
+
+    EXPECT_EQ(tdb.init(), MBED_SUCCESS);
+    for (int i = 0; i < 8; ++i) {
+        snprintf(key, sizeof(key), "key%d", i);
+        EXPECT_EQ(tdb.get(key, &val, sizeof(val)), MBED_SUCCESS);
+        EXPECT_EQ(val, i);
+    }
+    EXPECT_EQ(heap.deinit(), MBED_SUCCESS);
+}
+
 TEST_F(TDBStoreModuleTest, corrupted_set_deinit_init_get)
 {
     char buf[100];
@@ -138,6 +333,162 @@ TEST_F(TDBStoreModuleTest, set_multiple_iterate)
     EXPECT_EQ(tdb.iterator_close(iterator), MBED_SUCCESS);
 }
 
+TEST_F(TDBStoreModuleTest, incremental_gc)
+{
+    char key[16];
+    int val;
+    size_t size;
+    for (int i = 0; i < 10; ++i) {
+        snprintf(key, sizeof(key), "key%d", i);
+        EXPECT_EQ(tdb.set(key, &i, sizeof(i), 0), MBED_SUCCESS);
+    }
+    EXPECT_EQ(tdb.gc_step(3), 7);
+
+    // Modify the store between steps: new key, updated and removed keys on both sides of the cycle
+    int new_val = 100;
+    EXPECT_EQ(tdb.set("new_key", &new_val, sizeof(new_val), 0), MBED_SUCCESS);
+    EXPECT_EQ(tdb.set("key1", &new_val, sizeof(new_val), 0), MBED_SUCCESS);
+    EXPECT_EQ(tdb.remove("key2"), MBED_SUCCESS);
+    EXPECT_EQ(tdb.remove("key8"), MBED_SUCCESS);
+
+    int ret;
+    while ((ret = tdb.gc_step(2)) > 0) {
+    }
+    EXPECT_EQ(ret, MBED_SUCCESS);
+
+    for (int pass = 0; pass < 2; ++pass) {
+        for (int i = 0; i < 10; ++i) {
+            snprintf(key, sizeof(key), "key%d", i);
+            if (i == 2 || i == 8) {
+                EXPECT_EQ(tdb.get(key, &val, sizeof(val), &size), MBED_ERROR_ITEM_NOT_FOUND);
+                continue;
+            }
+            EXPECT_EQ(tdb.get(key, &val, sizeof(val), &size), MBED_SUCCESS);
+            EXPECT_EQ(val, i == 1 ? new_val : i);
+        }
+        EXPECT_EQ(tdb.get("new_key", &val, sizeof(val), &size), MBED_SUCCESS);
+        EXPECT_EQ(val, new_val);
+        EXPECT_EQ(tdb.deinit(), MBED_SUCCESS);
+        EXPECT_EQ(tdb.init(), MBED_SUCCESS);
+    }
+}
+
+TEST_F(TDBStoreModuleTest, incremental_gc_interrupted)
+{
+    int val = 5;
+    size_t size;
+    EXPECT_EQ(tdb.set("key1", &val, sizeof(val), 0), MBED_SUCCESS);
+    EXPECT_EQ(tdb.set("key2", &val, sizeof(val), 0), MBED_SUCCESS);
+    EXPECT_EQ(tdb.gc_step(1), 1);
+    // Cycle never completes - data must survive on the original area
+    EXPECT_EQ(tdb.deinit(), MBED_SUCCESS);
+    EXPECT_EQ(tdb.init(), MBED_SUCCESS);
+    val = 0;
+    EXPECT_EQ(tdb.get("key2", &val, sizeof(val), &size), MBED_SUCCESS);
+    EXPECT_EQ(val, 5);
+    int ret;
+    while ((ret = tdb.gc_step(1)) > 0) {
+    }
+    EXPECT_EQ(ret, MBED_SUCCESS);
+    EXPECT_EQ(tdb.get("key1", &val, sizeof(val), &size), MBED_SUCCESS);
+}
+
+static int gc_requests;
+
+static void gc_request()
+{
+    gc_requests++;
+}
+
+TEST_F(TDBStoreModuleTest, gc_request_callback)
+{
+    char buf[BLOCK_SIZE] = {0};
+    gc_requests = 0;
+    tdb.attach_gc_request(gc_request);
+    // Each record takes two program units, so this crosses the threshold
+    for (int i = 0; i < 60 && !gc_requests; ++i) {
+        EXPECT_EQ(tdb.set("key", buf, sizeof(buf), 0), MBED_SUCCESS);
+    }
+    EXPECT_EQ(gc_requests, 1);
+    EXPECT_EQ(tdb.set("key", buf, sizeof(buf), 0), MBED_SUCCESS);
+    EXPECT_EQ(gc_requests, 1);
+    EXPECT_EQ(tdb.gc_step(10), MBED_SUCCESS);
+    EXPECT_EQ(tdb.get("key", buf, sizeof(buf)), MBED_SUCCESS);
+    tdb.attach_gc_request(nullptr);
+}
+
+TEST_F(TDBStoreModuleTest, set_batch)
+{
+    int vals[3] = {1, 2, 3};
+    int val;
+    TDBStore::batch_item_t items[] = {
+        {"key1", &vals[0], sizeof(int), 0},
+        {"key2", &vals[1], sizeof(int), 0},
+        {"key1", &vals[2], sizeof(int), 0},
+    };
+    KVStore::info_t info;
+    EXPECT_EQ(tdb.set_batch(items, 3), MBED_SUCCESS);
+    for (int pass = 0; pass < 2; ++pass) {
+        EXPECT_EQ(tdb.get("key1", &val, sizeof(val)), MBED_SUCCESS);
+        EXPECT_EQ(val, 3);
+        EXPECT_EQ(tdb.get("key2", &val, sizeof(val)), MBED_SUCCESS);
+        EXPECT_EQ(val, 2);
+        EXPECT_EQ(tdb.get_info("key2", &info), MBED_SUCCESS);
+        EXPECT_EQ(info.flags, 0);
+        EXPECT_EQ(tdb.deinit(), MBED_SUCCESS);
+        EXPECT_EQ(tdb.init(), MBED_SUCCESS);
+    }
+    // Garbage collection turns batch records into standalone ones
+    EXPECT_EQ(tdb.gc_step(10), MBED_SUCCESS);
+    EXPECT_EQ(tdb.remove("key1"), MBED_SUCCESS);
+    EXPECT_EQ(tdb.deinit(), MBED_SUCCESS);
+    EXPECT_EQ(tdb.init(), MBED_SUCCESS);
+    EXPECT_EQ(tdb.get("key2", &val, sizeof(val)), MBED_SUCCESS);
+    EXPECT_EQ(val, 2);
+}
+
+TEST_F(TDBStoreModuleTest, set_batch_write_once)
+{
+    int val = 1;
+    TDBStore::batch_item_t items[] = {
+        {"key1", &val, sizeof(val), 0},
+        {"key2", &val, sizeof(val), 0},
+    };
+    EXPECT_EQ(tdb.set("key2", &val, sizeof(val), KVStore::WRITE_ONCE_FLAG), MBED_SUCCESS);
+    EXPECT_EQ(tdb.set_batch(items, 2), MBED_ERROR_WRITE_PROTECTED);
+    EXPECT_EQ(tdb.get("key1", &val, sizeof(val)), MBED_ERROR_ITEM_NOT_FOUND);
+}
+
+TEST_F(TDBStoreModuleTest, set_batch_torn)
+{
+    int val = 1;
+    TDBStore::batch_item_t items[] = {
+        {"batch_first", &val, sizeof(val), 0},
+        {"batch_last", &val, sizeof(val), 0},
+    };
+    EXPECT_EQ(heap.init(), MBED_SUCCESS); // Extra init, so the heap will not be deinitialized
+    EXPECT_EQ(tdb.set("key", &val, sizeof(val), 0), MBED_SUCCESS);
+    EXPECT_EQ(tdb.set_batch(items, 2), MBED_SUCCESS);
+    EXPECT_EQ(tdb.deinit(), MBED_SUCCESS);
+
+    // Simulate power loss before the last record of the batch was fully written
+    char *contents = new char[DEVICE_SIZE];
+    EXPECT_EQ(heap.read(contents, 0, DEVICE_SIZE), MBED_SUCCESS);
+    char *last = static_cast<char *>(memmem(contents, DEVICE_SIZE, "batch_last", 10));
+    ASSERT_NE(last, nullptr);
+    *last = 'X';
+    EXPECT_EQ(heap.program(contents, 0, DEVICE_SIZE), MBED_SUCCESS);
+    delete[] contents;
+
+    EXPECT_EQ(tdb.init(), MBED_SUCCESS);
+    EXPECT_EQ(tdb.get("key", &val, sizeof(val)), MBED_SUCCESS);
+    EXPECT_EQ(tdb.get("batch_first", &val, sizeof(val)), MBED_ERROR_ITEM_NOT_FOUND);
+    EXPECT_EQ(tdb.get("batch_last", &val, sizeof(val)), MBED_ERROR_ITEM_NOT_FOUND);
+    EXPECT_EQ(tdb.set_batch(items, 2), MBED_SUCCESS);
+    EXPECT_EQ(tdb.get("batch_first", &val, sizeof(val)), MBED_SUCCESS);
+    EXPECT_EQ(heap.deinit(), MBED_SUCCESS);
+}
+
 TEST_F(TDBStoreModuleTest, reserved_data_set_get)
 {
     char reserved_key[] = "value";
@@ -149,3 +500,44 @@ TEST_F(TDBStoreModuleTest, reserved_data_set_get)
     EXPECT_EQ(size, 6);
     EXPECT_EQ(tdb.reserved_data_set(reserved_key, 6), MBED_ERROR_WRITE_FAILED);
 }
+
+TEST_F(TDBStoreModuleTest, get_view_copy_fallback)
+{
+    char buf[100];
+    Span<const uint8_t> view;
+    EXPECT_EQ(tdb.set("key", "data", 5, 0), MBED_SUCCESS);
+    // Heap block device isn't memory mapped, so data must be copied
+    EXPECT_EQ(tdb.get_view("key", view), MBED_ERROR_INVALID_SIZE);
+    EXPECT_EQ(tdb.get_view("key", view, buf, 4), MBED_ERROR_INVALID_SIZE);
+    EXPECT_EQ(tdb.get_view("key", view, buf, sizeof(buf)), MBED_SUCCESS);
+    EXPECT_EQ(view.data(), reinterpret_cast<const uint8_t *>(buf));
+    EXPECT_EQ(view.size(), 5);
+    EXPECT_STREQ("data", buf);
+    EXPECT_EQ(tdb.get_view("nokey", view, buf, sizeof(buf)), MBED_ERROR_ITEM_NOT_FOUND);
+}
+
+TEST_F(TDBStoreModuleTest, get_view_mapped)
+{
+    MappedRamBlockDevice mapped_bd{64 * 1024, 4096};
+    TDBStore store{&mapped_bd};
+    Span<const uint8_t> view;
+    char data[300];
+    for (size_t i = 0; i < sizeof(data); i++) {
+        data[i] = 'a' + i % 26;
+    }
+    EXPECT_EQ(store.init(), MBED_SUCCESS);
+    EXPECT_EQ(store.reset(), MBED_SUCCESS);
+    EXPECT_EQ(store.set("cert", data, sizeof(data), 0), MBED_SUCCESS);
+    EXPECT_EQ(store.set("other", "x", 1, 0), MBED_SUCCESS);
+
+    // No buffer given - view must point straight into the device
+    EXPECT_EQ(store.get_view("cert", view), MBED_SUCCESS);
+    EXPECT_EQ(view.size(), sizeof(data));
+    EXPECT_EQ(memcmp(view.data(), data, sizeof(data)), 0);
+
+    EXPECT_EQ(store.set("empty", NULL, 0, 0), MBED_SUCCESS);
+    EXPECT_EQ(store.get_view("empty", view), MBED_SUCCESS);
+    EXPECT_EQ(view.size(), 0);
+
+    EXPECT_EQ(store.deinit(), MBED_SUCCESS);
+}
@@ -23,4 +23,8 @@ set(unittest-test-sources
   ${CMAKE_CURRENT_LIST_DIR}/moduletest.cpp
 )
 
+set(unittest-test-flags
+  -DMBED_CONF_TDBSTORE_CHECKPOINT_INTERVAL=8
+)
+
 set(CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS}")
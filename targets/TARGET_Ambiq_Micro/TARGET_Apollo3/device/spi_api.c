@@ -72,6 +72,7 @@ void spi_get_capabilities(PinName ssel, bool slave, spi_capabilities_t *cap)
     cap->clk_modes = 0x0F;
     cap->support_slave_mode = (iom_ssel == IOM_ANY) ? true : false;
     cap->hw_cs_handle = false;
+    cap->hw_cs_hold = false;
     cap->async_mode = false;
     cap->tx_rx_buffers_equal_length = false;
 }
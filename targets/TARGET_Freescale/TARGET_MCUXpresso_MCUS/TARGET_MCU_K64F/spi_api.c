@@ -119,6 +119,9 @@ void spi_format(spi_t *obj, int bits, int mode, int slave)
     /* Bits: values between 4 and 16 are valid */
     MBED_ASSERT(bits >= 4 && bits <= 16);
     obj->spi.bits = bits;
+#if DEVICE_SPI_ASYNCH
+    obj->spi.slave = slave;
+#endif
 
     if (slave) {
         /* Slave config */
@@ -305,10 +308,17 @@ static bool spi_allocate_dma(spi_t *obj, uint32_t handler)
                       obj->spi.spiDmaMasterIntermediary.dmaChannel);
     EDMA_CreateHandle(&(obj->spi.spiDmaMasterTx.handle), DMA0, obj->spi.spiDmaMasterTx.dmaChannel);
 
-    DSPI_MasterTransferCreateHandleEDMA(spi_address[obj->spi.instance], &obj->spi.spi_dma_master_handle, (dspi_master_edma_transfer_callback_t)handler,
-                                        NULL, &obj->spi.spiDmaMasterRx.handle,
-                                        &obj->spi.spiDmaMasterIntermediary.handle,
-                                        &obj->spi.spiDmaMasterTx.handle);
+    if (obj->spi.slave) {
+        /* The slave moves the frames straight between the FIFOs and the buffers */
+        DSPI_SlaveTransferCreateHandleEDMA(spi_address[obj->spi.instance], &obj->spi.spi_dma_slave_handle, (dspi_slave_edma_transfer_callback_t)handler,
+                                           NULL, &obj->spi.spiDmaMasterRx.handle,
+                                           &obj->spi.spiDmaMasterTx.handle);
+    } else {
+        DSPI_MasterTransferCreateHandleEDMA(spi_address[obj->spi.instance], &obj->spi.spi_dma_master_handle, (dspi_master_edma_transfer_callback_t)handler,
+                                            NULL, &obj->spi.spiDmaMasterRx.handle,
+                                            &obj->spi.spiDmaMasterIntermediary.handle,
+                                            &obj->spi.spiDmaMasterTx.handle);
+    }
     return true;
 }
 
@@ -346,6 +356,17 @@ static void spi_enable_dma(spi_t *obj, uint32_t handler, DMAUsage state)
     }
 }
 
+/* Release the dma channels if they were opportunistically allocated */
+static void spi_release_dma(spi_t *obj)
+{
+    if (obj->spi.spiDmaMasterRx.dmaUsageState == DMA_USAGE_TEMPORARY_ALLOCATED) {
+        dma_channel_free(obj->spi.spiDmaMasterRx.dmaChannel);
+        dma_channel_free(obj->spi.spiDmaMasterTx.dmaChannel);
+        dma_channel_free(obj->spi.spiDmaMasterIntermediary.dmaChannel);
+        obj->spi.spiDmaMasterRx.dmaUsageState = DMA_USAGE_OPPORTUNISTIC;
+    }
+}
+
 static void spi_buffer_set(spi_t *obj, const void *tx, uint32_t tx_length, void *rx, uint32_t rx_length, uint8_t bit_width)
 {
     obj->tx_buff.buffer = (void *)tx;
@@ -402,11 +423,74 @@ void spi_master_transfer(spi_t *obj, const void *tx, size_t tx_length, void *rx,
     }
 }
 
+bool spi_slave_transfer(spi_t *obj, const void *tx, size_t tx_length, void *rx, size_t rx_length, uint8_t bit_width, uint32_t handler, uint32_t event, DMAUsage hint)
+{
+    dspi_transfer_t slaveXfer;
+    status_t status;
+
+    if (spi_active(obj)) {
+        return false;
+    }
+
+    /* Both buffers are moved at once, transfer the shorter one */
+    if (tx_length == 0) {
+        tx_length = rx_length;
+        tx = (void *) 0;
+    } else if (rx_length == 0) {
+        rx = (void *) 0;
+    } else if (rx_length < tx_length) {
+        tx_length = rx_length;
+    }
+
+    spi_buffer_set(obj, tx, tx_length, rx, tx_length, bit_width);
+
+    /* The master does not wait for the slave, so unlike the master transfer
+     * a slave transfer can not be split in several DMA transfers: the
+     * buffers too long for one are refused */
+    spi_enable_dma(obj, handler, hint);
+
+    slaveXfer.txData = (uint8_t *)tx;
+    slaveXfer.rxData = (uint8_t *)rx;
+    slaveXfer.dataSize = tx_length;
+    slaveXfer.configFlags = kDSPI_SlaveCtar0;
+    obj->spi.status = kDSPI_Busy;
+
+    if (obj->spi.spiDmaMasterRx.dmaUsageState == DMA_USAGE_ALLOCATED ||
+            obj->spi.spiDmaMasterRx.dmaUsageState == DMA_USAGE_TEMPORARY_ALLOCATED) {
+        status = DSPI_SlaveTransferEDMA(spi_address[obj->spi.instance], &obj->spi.spi_dma_slave_handle, &slaveXfer);
+    } else {
+        /* Set up an interrupt transfer as DMA is unavailable or not requested */
+        DSPI_SlaveTransferCreateHandle(spi_address[obj->spi.instance], &obj->spi.spi_slave_handle, (dspi_slave_transfer_callback_t)handler, NULL);
+        status = DSPI_SlaveTransferNonBlocking(spi_address[obj->spi.instance], &obj->spi.spi_slave_handle, &slaveXfer);
+    }
+
+    if (status != kStatus_Success) {
+        spi_release_dma(obj);
+        obj->spi.status = kDSPI_Idle;
+        return false;
+    }
+
+    // Can't enter deep sleep as long as SPI transfer is active
+    sleep_manager_lock_deep_sleep();
+    return true;
+}
+
 uint32_t spi_irq_handler_asynch(spi_t *obj)
 {
     uint32_t transferSize;
     dspi_transfer_t masterXfer;
 
+    /* A slave transfer is done at once, either by DMA or interrupts */
+    if (obj->spi.slave) {
+        spi_release_dma(obj);
+        obj->spi.status = kDSPI_Idle;
+
+        // SPI transfer done, can enter deep sleep
+        sleep_manager_unlock_deep_sleep();
+
+        return SPI_EVENT_COMPLETE;
+    }
+
     /* Determine whether the current scenario is DMA or IRQ, and act accordingly */
     if (obj->spi.spiDmaMasterRx.dmaUsageState == DMA_USAGE_ALLOCATED || obj->spi.spiDmaMasterRx.dmaUsageState == DMA_USAGE_TEMPORARY_ALLOCATED) {
         /* DMA implementation */
@@ -482,7 +566,15 @@ void spi_abort_asynch(spi_t *obj)
     }
 
     // Determine whether we're running DMA or interrupt
-    if (obj->spi.spiDmaMasterRx.dmaUsageState == DMA_USAGE_ALLOCATED ||
+    if (obj->spi.slave) {
+        if (obj->spi.spiDmaMasterRx.dmaUsageState == DMA_USAGE_ALLOCATED ||
+                obj->spi.spiDmaMasterRx.dmaUsageState == DMA_USAGE_TEMPORARY_ALLOCATED) {
+            DSPI_SlaveTransferAbortEDMA(spi_address[obj->spi.instance], &obj->spi.spi_dma_slave_handle);
+        } else {
+            DSPI_SlaveTransferAbort(spi_address[obj->spi.instance], &obj->spi.spi_slave_handle);
+        }
+        spi_release_dma(obj);
+    } else if (obj->spi.spiDmaMasterRx.dmaUsageState == DMA_USAGE_ALLOCATED ||
             obj->spi.spiDmaMasterRx.dmaUsageState == DMA_USAGE_TEMPORARY_ALLOCATED) {
         DSPI_MasterTransferAbortEDMA(spi_address[obj->spi.instance], &obj->spi.spi_dma_master_handle);
         /* Release the dma channels if they were opportunistically allocated */
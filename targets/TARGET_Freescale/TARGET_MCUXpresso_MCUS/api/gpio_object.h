@@ -30,6 +30,47 @@ static inline int gpio_is_connected(const gpio_t *obj)
     return obj->pin != (PinName)NC;
 }
 
+/*
+ * Access without gpio_t, for a pin or port known at compile time: once
+ * inlined, the port and the mask are constants and an access is a single
+ * register read or write. The pins are set up with gpio_init and port_init.
+ */
+#define GPIO_FAST_READY 1
+
+static inline GPIO_Type *gpio_fast_gpio(uint32_t port)
+{
+    static GPIO_Type *const gpio_addrs[] = GPIO_BASE_PTRS;
+    return gpio_addrs[port];
+}
+
+static inline void gpio_fast_write(PinName pin, int value)
+{
+    GPIO_Type *base = gpio_fast_gpio(pin >> GPIO_PORT_SHIFT);
+    uint32_t mask = 1U << (pin & 0xFF);
+    if (value) {
+        base->PSOR = mask;
+    } else {
+        base->PCOR = mask;
+    }
+}
+
+static inline int gpio_fast_read(PinName pin)
+{
+    return (gpio_fast_gpio(pin >> GPIO_PORT_SHIFT)->PDIR >> (pin & 0xFF)) & 1;
+}
+
+static inline void gpio_fast_port_write(PortName port, uint32_t mask, uint32_t value)
+{
+    GPIO_Type *base = gpio_fast_gpio(port);
+    base->PSOR = value & mask;
+    base->PCOR = ~value & mask;
+}
+
+static inline uint32_t gpio_fast_port_read(PortName port, uint32_t mask)
+{
+    return gpio_fast_gpio(port)->PDOR & mask;
+}
+
 #ifdef __cplusplus
 }
 #endif
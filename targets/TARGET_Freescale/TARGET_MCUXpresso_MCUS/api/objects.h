@@ -76,8 +76,11 @@ struct spi_s {
     uint8_t bits;
 #if DEVICE_SPI_ASYNCH
     status_t status;
+    bool slave;
     dspi_master_handle_t spi_master_handle;
     dspi_master_edma_handle_t spi_dma_master_handle;
+    dspi_slave_handle_t spi_slave_handle;
+    dspi_slave_edma_handle_t spi_dma_slave_handle;
     dma_options_t spiDmaMasterRx;
     dma_options_t spiDmaMasterTx;
     dma_options_t spiDmaMasterIntermediary;
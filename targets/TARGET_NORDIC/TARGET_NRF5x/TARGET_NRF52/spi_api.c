@@ -186,6 +186,7 @@ void spi_get_capabilities(PinName ssel, bool slave, spi_capabilities_t *cap)
         cap->word_length = 0x00000080;              // 8 bit symbols
         cap->support_slave_mode = false;            // to be determined later based on ssel
         cap->hw_cs_handle = false;                  // irrelevant in slave mode
+        cap->hw_cs_hold = false;                    // no chip select hold between transfers
         cap->slave_delay_between_symbols_ns = 2500; // 2.5 us
         cap->clk_modes = 0x0f;                      // all clock modes
         cap->tx_rx_buffers_equal_length = false;    // rx/tx buffers can have different sizes
@@ -200,6 +201,7 @@ void spi_get_capabilities(PinName ssel, bool slave, spi_capabilities_t *cap)
         cap->word_length = 0x00000080;            // 8 bit symbols
         cap->support_slave_mode = false;          // to be determined later based on ssel
         cap->hw_cs_handle = false;                // to be determined later based on ssel
+        cap->hw_cs_hold = false;                  // no chip select hold between transfers
         cap->slave_delay_between_symbols_ns = 0;  // irrelevant in master mode
         cap->clk_modes = 0x0f;                    // all clock modes
         cap->tx_rx_buffers_equal_length = false;  // rx/tx buffers can have different sizes
@@ -0,0 +1,128 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_INTERCOREQUEUE_H
+#define MBED_INTERCOREQUEUE_H
+
+#include "stm32h7_ipc.h"
+
+#if defined(DUAL_CORE)
+
+#include <type_traits>
+#include "events/EventQueue.h"
+#include "platform/Callback.h"
+#include "platform/NonCopyable.h"
+#include "platform/mbed_atomic.h"
+
+namespace mbed {
+
+/** Messages of type T between the two cores of STM32H745/H747
+ *
+ *  Messages are received in interrupt context, and the callback is then
+ *  called from the event queue, so the other core can post work to a
+ *  thread of this one, the way Mail does between threads:
+ *
+ *  @code
+ *  struct packet {
+ *      void *data;         // in memory shared by both cores
+ *      uint32_t size;
+ *  };
+ *
+ *  void packet_received(const packet &p);
+ *
+ *  InterCoreQueue<packet> packets(mbed_event_queue(), packet_received);
+ *  @endcode
+ *
+ *  Only one InterCoreQueue may exist on each core, as it owns the rings.
+ *
+ *  @tparam T   Trivially copyable message, at most MBED_CONF_TARGET_IPC_MESSAGE_SIZE bytes
+ */
+template <typename T>
+class InterCoreQueue : private NonCopyable<InterCoreQueue<T> > {
+public:
+    static_assert(sizeof(T) <= MBED_CONF_TARGET_IPC_MESSAGE_SIZE, "Message too large");
+    static_assert(std::is_trivially_copyable<T>::value, "Message must be trivially copyable");
+
+    /** Initialize the rings with the other core
+     *
+     *  On the CM4, this waits for the CM7 to create its InterCoreQueue.
+     *
+     *  @param queue    Event queue calling the callback, or nullptr to only poll try_get()
+     *  @param callback Function called for each message received
+     */
+    InterCoreQueue(events::EventQueue *queue, Callback<void(const T &)> callback = nullptr) :
+        _queue(queue), _callback(callback), _pending(false)
+    {
+        stm32h7_ipc_init(queue ? irq : nullptr, this);
+    }
+
+    /** Send a message to the other core
+     *
+     *  @param message  Message to send
+     *  @return         true on success, false if the ring is full
+     *
+     *  @note This function may be called from ISR context.
+     */
+    bool put(const T &message)
+    {
+        return stm32h7_ipc_send(&message, sizeof(T)) == 0;
+    }
+
+    /** Receive a message from the other core without waiting
+     *
+     *  @param message  Message received
+     *  @return         true if a message was received
+     *
+     *  @note This function may be called from ISR context.
+     */
+    bool try_get(T &message)
+    {
+        return stm32h7_ipc_receive(&message, sizeof(T)) == sizeof(T);
+    }
+
+private:
+    static void irq(void *context)
+    {
+        InterCoreQueue *self = static_cast<InterCoreQueue *>(context);
+        // A single event drains every message received before it runs
+        if (!core_util_atomic_exchange_bool(&self->_pending, true)) {
+            if (self->_queue->call(self, &InterCoreQueue::dispatch) == 0) {
+                core_util_atomic_store_bool(&self->_pending, false);
+            }
+        }
+    }
+
+    void dispatch()
+    {
+        T message;
+        core_util_atomic_store_bool(&_pending, false);
+        while (try_get(message)) {
+            if (_callback) {
+                _callback(message);
+            }
+        }
+    }
+
+    events::EventQueue *_queue;
+    Callback<void(const T &)> _callback;
+    volatile bool _pending;
+};
+
+} // namespace mbed
+
+#endif /* DUAL_CORE */
+
+#endif
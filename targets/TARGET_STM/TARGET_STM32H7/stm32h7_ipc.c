@@ -0,0 +1,177 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#if defined(DUAL_CORE)
+#include <string.h>
+#include "cmsis.h"
+#include "stm32h7_ipc.h"
+#include "platform/mbed_assert.h"
+#include "platform/mbed_critical.h"
+#include "platform/mbed_dcache.h"
+
+#define IPC_COUNT           MBED_CONF_TARGET_IPC_MESSAGE_COUNT
+
+MBED_STATIC_ASSERT((MBED_CONF_TARGET_IPC_MESSAGE_SIZE + 4) % 32 == 0,
+                   "IPC message size must be a multiple of the cache line size minus 4");
+MBED_STATIC_ASSERT(IPC_COUNT > 0 && (IPC_COUNT & (IPC_COUNT - 1)) == 0,
+                   "IPC message count must be a power of 2");
+MBED_STATIC_ASSERT((MBED_CONF_TARGET_IPC_SHARED_RAM_ADDRESS & 31) == 0,
+                   "IPC shared memory must be cache line aligned");
+
+typedef struct {
+    uint32_t size;
+    uint8_t data[MBED_CONF_TARGET_IPC_MESSAGE_SIZE];
+} ipc_slot_t;
+
+/* Each index is written by one core only, and has a cache line of its own
+ * so that the CM7 never writes back a line holding the other core's index.
+ */
+typedef struct {
+    volatile uint32_t head;     /* Messages sent, written by the producer */
+    uint32_t head_pad[7];
+    volatile uint32_t tail;     /* Messages received, written by the consumer */
+    uint32_t tail_pad[7];
+    ipc_slot_t slots[IPC_COUNT];
+} ipc_ring_t;
+
+typedef struct {
+    ipc_ring_t to_cm4;
+    ipc_ring_t to_cm7;
+} ipc_shared_t;
+
+#define IPC_SHARED          ((ipc_shared_t *)MBED_CONF_TARGET_IPC_SHARED_RAM_ADDRESS)
+
+#if defined(CORE_CM4)
+#define IPC_TX_RING         (&IPC_SHARED->to_cm7)
+#define IPC_RX_RING         (&IPC_SHARED->to_cm4)
+#define IPC_TX_SEMID        CFG_HW_IPC_TO_CM7_SEMID
+#define IPC_RX_SEMID        CFG_HW_IPC_TO_CM4_SEMID
+#define IPC_IRQn            HSEM2_IRQn
+#define IPC_IER             (HSEM->C2IER)
+#define IPC_ICR             (HSEM->C2ICR)
+#else
+#define IPC_TX_RING         (&IPC_SHARED->to_cm4)
+#define IPC_RX_RING         (&IPC_SHARED->to_cm7)
+#define IPC_TX_SEMID        CFG_HW_IPC_TO_CM4_SEMID
+#define IPC_RX_SEMID        CFG_HW_IPC_TO_CM7_SEMID
+#define IPC_IRQn            HSEM1_IRQn
+#define IPC_IER             (HSEM->C1IER)
+#define IPC_ICR             (HSEM->C1ICR)
+#endif
+
+static stm32h7_ipc_handler_t ipc_handler;
+static void *ipc_context;
+
+static void ipc_irq(void)
+{
+    IPC_ICR = 1UL << IPC_RX_SEMID;
+    if (ipc_handler) {
+        ipc_handler(ipc_context);
+    }
+}
+
+void stm32h7_ipc_init(stm32h7_ipc_handler_t handler, void *context)
+{
+    /* SRAM4 keeps its contents across a reset, so a flag in it could be left
+     * from the previous boot. The CM7 holds a hardware semaphore instead once
+     * the rings are initialized: every reset frees the semaphores.
+     */
+#if defined(CORE_CM4)
+    while (!LL_HSEM_IsSemaphoreLocked(HSEM, CFG_HW_IPC_READY_SEMID)) {
+    }
+    __DMB();
+#else
+    LL_HSEM_ReleaseLock(HSEM, CFG_HW_IPC_READY_SEMID, 0);
+    memset(IPC_SHARED, 0, sizeof(ipc_shared_t));
+    mbed_dcache_clean_invalidate(IPC_SHARED, sizeof(ipc_shared_t));
+
+    // The rings must be cleared before the CM4 is told to use them
+    __DMB();
+    (void)LL_HSEM_1StepLock(HSEM, CFG_HW_IPC_READY_SEMID);
+#endif
+
+    ipc_handler = handler;
+    ipc_context = context;
+    NVIC_SetVector(IPC_IRQn, (uint32_t)ipc_irq);
+    NVIC_EnableIRQ(IPC_IRQn);
+    IPC_ICR = 1UL << IPC_RX_SEMID;
+    IPC_IER |= 1UL << IPC_RX_SEMID;
+}
+
+int stm32h7_ipc_send(const void *data, uint32_t size)
+{
+    ipc_ring_t *ring = IPC_TX_RING;
+    int ret = -1;
+
+    if (size == 0 || size > MBED_CONF_TARGET_IPC_MESSAGE_SIZE) {
+        return -1;
+    }
+
+    core_util_critical_section_enter();
+    uint32_t head = ring->head;
+    mbed_dcache_invalidate((void *)&ring->tail, sizeof(uint32_t));
+    if (head - ring->tail < IPC_COUNT) {
+        ipc_slot_t *slot = &ring->slots[head & (IPC_COUNT - 1)];
+        slot->size = size;
+        memcpy(slot->data, data, size);
+        mbed_dcache_clean(slot, sizeof(uint32_t) + size);
+
+        // The message must be visible before the index that publishes it
+        __DMB();
+        ring->head = head + 1;
+        mbed_dcache_clean((const void *)&ring->head, sizeof(uint32_t));
+
+        // Freeing the semaphore interrupts the other core
+        (void)LL_HSEM_1StepLock(HSEM, IPC_TX_SEMID);
+        LL_HSEM_ReleaseLock(HSEM, IPC_TX_SEMID, 0);
+        ret = 0;
+    }
+    core_util_critical_section_exit();
+
+    return ret;
+}
+
+int stm32h7_ipc_receive(void *data, uint32_t size)
+{
+    ipc_ring_t *ring = IPC_RX_RING;
+    int ret = 0;
+
+    core_util_critical_section_enter();
+    uint32_t tail = ring->tail;
+    mbed_dcache_invalidate((void *)&ring->head, sizeof(uint32_t));
+    if (ring->head != tail) {
+        __DMB();
+        ipc_slot_t *slot = &ring->slots[tail & (IPC_COUNT - 1)];
+        mbed_dcache_invalidate(slot, sizeof(ipc_slot_t));
+        if (slot->size > size) {
+            ret = -1;
+        } else {
+            memcpy(data, slot->data, slot->size);
+            ret = slot->size;
+
+            // The slot must be read before the producer may reuse it
+            __DMB();
+            ring->tail = tail + 1;
+            mbed_dcache_clean((const void *)&ring->tail, sizeof(uint32_t));
+        }
+    }
+    core_util_critical_section_exit();
+
+    return ret;
+}
+
+#endif /* DUAL_CORE */
@@ -0,0 +1,96 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 ARM Limited
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef STM32H7_IPC_H
+#define STM32H7_IPC_H
+
+#include <stdint.h>
+
+#if defined(DUAL_CORE)
+
+/* Messages between the Cortex-M7 and the Cortex-M4 of STM32H745/H747.
+ *
+ * Each direction is a single producer, single consumer ring of fixed size
+ * messages in SRAM4, which both cores reach at the same address. A message
+ * sent releases a hardware semaphore, whose interrupt tells the other core.
+ *
+ * Messages are copied into the ring, so they should be small: to hand over
+ * large data without copying it, send a pointer to memory both cores use.
+ */
+
+/* Start of the shared memory, 0x38000000 is SRAM4 in the D3 domain */
+#ifndef MBED_CONF_TARGET_IPC_SHARED_RAM_ADDRESS
+#define MBED_CONF_TARGET_IPC_SHARED_RAM_ADDRESS     0x38000000
+#endif
+
+/* Largest message, a multiple of the cache line size minus 4 */
+#ifndef MBED_CONF_TARGET_IPC_MESSAGE_SIZE
+#define MBED_CONF_TARGET_IPC_MESSAGE_SIZE           60
+#endif
+
+/* Messages each ring holds, a power of 2 */
+#ifndef MBED_CONF_TARGET_IPC_MESSAGE_COUNT
+#define MBED_CONF_TARGET_IPC_MESSAGE_COUNT          16
+#endif
+
+/* Hardware semaphores released to notify the CM4 and the CM7 */
+#define CFG_HW_IPC_TO_CM4_SEMID                     6
+#define CFG_HW_IPC_TO_CM7_SEMID                     7
+
+/* Hardware semaphore held by the CM7 once the rings are initialized */
+#define CFG_HW_IPC_READY_SEMID                      8
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Called in interrupt context when messages arrive */
+typedef void (*stm32h7_ipc_handler_t)(void *context);
+
+/** Initialize the messages with the other core
+ *
+ *  The CM7 sets up the rings, so the CM4 waits for it to be initialized
+ *  first. The CM7 must not call it again once the CM4 uses the rings.
+ *
+ *  @param handler  Function called when messages arrive, or NULL
+ *  @param context  Argument passed to handler
+ */
+void stm32h7_ipc_init(stm32h7_ipc_handler_t handler, void *context);
+
+/** Send a message to the other core
+ *
+ *  @param data     Message
+ *  @param size     Size of the message, at most MBED_CONF_TARGET_IPC_MESSAGE_SIZE
+ *  @return         0 on success, -1 if the message is too large or the ring is full
+ */
+int stm32h7_ipc_send(const void *data, uint32_t size);
+
+/** Receive the oldest message from the other core
+ *
+ *  @param data     Buffer for the message
+ *  @param size     Size of the buffer
+ *  @return         Size of the message, 0 if there is none, or -1 if it's
+ *                  larger than the buffer, in which case it is left in the ring
+ */
+int stm32h7_ipc_receive(void *data, uint32_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DUAL_CORE */
+
+#endif
@@ -0,0 +1,115 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2021 STMicroelectronics
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "clock_scaling_api.h"
+
+#if DEVICE_CLOCK_SCALING
+
+#include "cmsis.h"
+#include "mbed_critical.h"
+
+extern void save_timer_ctx(void);
+extern void restore_timer_ctx(void);
+extern int mbed_sdk_inited;
+
+/* The levels divide the system clock set by SetSysClock() with the AHB
+ * prescaler. The PLL keeps running, so that going back to full speed is
+ * immediate, and the flash latency is kept at the full speed value. */
+static const uint32_t ahb_dividers[] = {
+    RCC_SYSCLK_DIV1,
+    RCC_SYSCLK_DIV2,
+    RCC_SYSCLK_DIV4,
+    RCC_SYSCLK_DIV8,
+    RCC_SYSCLK_DIV16
+};
+
+static uint8_t current_level = 0;
+
+static HAL_StatusTypeDef apply_level(uint8_t level)
+{
+    RCC_ClkInitTypeDef RCC_ClkInitStruct;
+    uint32_t flash_latency;
+
+    HAL_RCC_GetClockConfig(&RCC_ClkInitStruct, &flash_latency);
+    RCC_ClkInitStruct.ClockType = RCC_CLOCKTYPE_HCLK;
+    RCC_ClkInitStruct.AHBCLKDivider = ahb_dividers[level];
+
+    /* Also calls HAL_InitTick(), which sets the us_ticker prescaler for the
+     * new timer clock */
+    return HAL_RCC_ClockConfig(&RCC_ClkInitStruct, flash_latency);
+}
+
+uint8_t clock_scaling_level_count(void)
+{
+    uint32_t sysclk = HAL_RCC_GetSysClockFreq();
+    uint8_t count = 1;
+
+    /* The us_ticker needs a timer clock of a whole number of MHz */
+    while (count < sizeof(ahb_dividers) / sizeof(ahb_dividers[0])
+            && (sysclk >> count) % 1000000 == 0) {
+        count++;
+    }
+    return count;
+}
+
+uint32_t clock_scaling_frequency(uint8_t level)
+{
+    if (level >= clock_scaling_level_count()) {
+        return 0;
+    }
+    return HAL_RCC_GetSysClockFreq() >> level;
+}
+
+uint8_t clock_scaling_get_level(void)
+{
+    return current_level;
+}
+
+int clock_scaling_set_level(uint8_t level)
+{
+    if (level >= clock_scaling_level_count()) {
+        return -1;
+    }
+
+    core_util_critical_section_enter();
+
+    /* As in deep sleep, keep HAL_GetTick() off the us_ticker while it is
+     * set up again, then restore its counter and pending interrupt */
+    save_timer_ctx();
+    mbed_sdk_inited = 0;
+    HAL_StatusTypeDef status = apply_level(level);
+    restore_timer_ctx();
+    mbed_sdk_inited = 1;
+
+    if (status == HAL_OK) {
+        current_level = level;
+    }
+
+    core_util_critical_section_exit();
+
+    return status == HAL_OK ? 0 : -1;
+}
+
+/* Called from hal_deepsleep() after SetSysClock(), us_ticker context saved */
+void clock_scaling_resume(void)
+{
+    if (current_level != 0) {
+        apply_level(current_level);
+    }
+}
+
+#endif /* DEVICE_CLOCK_SCALING */
@@ -87,6 +87,86 @@ static inline int gpio_is_connected(const gpio_t *obj)
     return obj->pin != (PinName)NC;
 }
 
+#if !(defined(DUAL_CORE) && (TARGET_STM32H7))
+/*
+ * Access without gpio_t, for a pin or port known at compile time: once
+ * inlined, the port and the mask are constants and an access is a single
+ * register read or write. The pins are set up with gpio_init and port_init.
+ */
+#define GPIO_FAST_READY 1
+
+static inline GPIO_TypeDef *gpio_fast_gpio(uint32_t port_idx)
+{
+    switch (port_idx) {
+        case PortA:
+            return (GPIO_TypeDef *)GPIOA_BASE;
+        case PortB:
+            return (GPIO_TypeDef *)GPIOB_BASE;
+#if defined GPIOC_BASE
+        case PortC:
+            return (GPIO_TypeDef *)GPIOC_BASE;
+#endif
+#if defined GPIOD_BASE
+        case PortD:
+            return (GPIO_TypeDef *)GPIOD_BASE;
+#endif
+#if defined GPIOE_BASE
+        case PortE:
+            return (GPIO_TypeDef *)GPIOE_BASE;
+#endif
+#if defined GPIOF_BASE
+        case PortF:
+            return (GPIO_TypeDef *)GPIOF_BASE;
+#endif
+#if defined GPIOG_BASE
+        case PortG:
+            return (GPIO_TypeDef *)GPIOG_BASE;
+#endif
+#if defined GPIOH_BASE
+        case PortH:
+            return (GPIO_TypeDef *)GPIOH_BASE;
+#endif
+#if defined GPIOI_BASE
+        case PortI:
+            return (GPIO_TypeDef *)GPIOI_BASE;
+#endif
+#if defined GPIOJ_BASE
+        case PortJ:
+            return (GPIO_TypeDef *)GPIOJ_BASE;
+#endif
+#if defined GPIOK_BASE
+        case PortK:
+            return (GPIO_TypeDef *)GPIOK_BASE;
+#endif
+        default:
+            return (GPIO_TypeDef *)GPIOA_BASE;
+    }
+}
+
+static inline void gpio_fast_write(PinName pin, int value)
+{
+    uint32_t mask = 1U << STM_PIN(pin);
+    // The upper half of BSRR resets, on the families with BRR as well
+    gpio_fast_gpio(STM_PORT(pin))->BSRR = value ? mask : mask << 16;
+}
+
+static inline int gpio_fast_read(PinName pin)
+{
+    return (gpio_fast_gpio(STM_PORT(pin))->IDR >> STM_PIN(pin)) & 1;
+}
+
+static inline void gpio_fast_port_write(PortName port, uint32_t mask, uint32_t value)
+{
+    mask &= 0xFFFF;
+    gpio_fast_gpio(port)->BSRR = (value & mask) | ((~value & mask) << 16);
+}
+
+static inline uint32_t gpio_fast_port_read(PortName port, uint32_t mask)
+{
+    return gpio_fast_gpio(port)->ODR & mask;
+}
+#endif
+
 
 #ifdef __cplusplus
 }
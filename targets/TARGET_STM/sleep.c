@@ -38,6 +38,9 @@
 extern void save_timer_ctx(void);
 extern void restore_timer_ctx(void);
 extern void SetSysClock(void);
+#if DEVICE_CLOCK_SCALING
+extern void clock_scaling_resume(void);
+#endif
 
 /*  Wait loop - assuming tick is 1 us */
 static void wait_loop(uint32_t timeout)
@@ -272,6 +275,11 @@ __WEAK void hal_deepsleep(void)
     SetSysClock();
 #endif
 
+#if DEVICE_CLOCK_SCALING
+    /* SetSysClock() restored the boot clock, go back to the selected level */
+    clock_scaling_resume();
+#endif
+
     /*  Wait for clock to be stabilized.
      *  TO DO: a better way of doing this, would be to rely on
      *  HW Flag. At least this ensures proper operation out of
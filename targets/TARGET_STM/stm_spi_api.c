@@ -87,6 +87,7 @@ void spi_get_capabilities(PinName ssel, bool slave, spi_capabilities_t *cap)
         cap->word_length = 0x00008080;              // 8 and 16 bit symbols
         cap->support_slave_mode = false;            // to be determined later based on ssel
         cap->hw_cs_handle = false;                  // irrelevant in slave mode
+        cap->hw_cs_hold = false;                    // no chip select hold between transfers
         cap->slave_delay_between_symbols_ns = 2500; // 2.5 us
         cap->clk_modes = 0x0f;                      // all clock modes
         cap->tx_rx_buffers_equal_length = false;    // rx/tx buffers can have different sizes
@@ -101,6 +102,7 @@ void spi_get_capabilities(PinName ssel, bool slave, spi_capabilities_t *cap)
         cap->word_length = STM32_SPI_CAPABILITY_WORD_LENGTH;            // Defined in spi_device.h
         cap->support_slave_mode = false;          // to be determined later based on ssel
         cap->hw_cs_handle = false;                // to be determined later based on ssel
+        cap->hw_cs_hold = false;                  // no chip select hold between transfers
         cap->slave_delay_between_symbols_ns = 0;  // irrelevant in master mode
         cap->clk_modes = 0x0f;                    // all clock modes
         cap->tx_rx_buffers_equal_length = false;  // rx/tx buffers can have different sizes
@@ -1032,15 +1034,12 @@ static int spi_master_start_asynch_transfer(spi_t *obj, transfer_type_t transfer
     return length;
 }
 
-// asynchronous API
-void spi_master_transfer(spi_t *obj, const void *tx, size_t tx_length, void *rx, size_t rx_length, uint8_t bit_width, uint32_t handler, uint32_t event, DMAUsage hint)
+/// @returns the number of bytes transferred, or `0` if nothing transferred
+static int spi_start_transfer(spi_t *obj, const void *tx, size_t tx_length, void *rx, size_t rx_length, uint32_t handler, uint32_t event)
 {
     struct spi_s *spiobj = SPI_S(obj);
     SPI_HandleTypeDef *handle = &(spiobj->handle);
 
-    // TODO: DMA usage is currently ignored
-    (void) hint;
-
     // check which use-case we have
     bool use_tx = (tx != NULL && tx_length > 0);
     bool use_rx = (rx != NULL && rx_length > 0);
@@ -1049,7 +1048,7 @@ void spi_master_transfer(spi_t *obj, const void *tx, size_t tx_length, void *rx,
 
     // don't do anything, if the buffers aren't valid
     if (!use_tx && !use_rx) {
-        return;
+        return 0;
     }
 
     // copy the buffers to the SPI object
@@ -1080,12 +1079,35 @@ void spi_master_transfer(spi_t *obj, const void *tx, size_t tx_length, void *rx,
             obj->tx_buff.length = size;
             obj->rx_buff.length = size;
         }
-        spi_master_start_asynch_transfer(obj, SPI_TRANSFER_TYPE_TXRX, tx, rx, size);
+        return spi_master_start_asynch_transfer(obj, SPI_TRANSFER_TYPE_TXRX, tx, rx, size);
     } else if (use_tx) {
-        spi_master_start_asynch_transfer(obj, SPI_TRANSFER_TYPE_TX, tx, NULL, tx_length);
-    } else if (use_rx) {
-        spi_master_start_asynch_transfer(obj, SPI_TRANSFER_TYPE_RX, NULL, rx, rx_length);
+        return spi_master_start_asynch_transfer(obj, SPI_TRANSFER_TYPE_TX, tx, NULL, tx_length);
+    } else {
+        return spi_master_start_asynch_transfer(obj, SPI_TRANSFER_TYPE_RX, NULL, rx, rx_length);
+    }
+}
+
+// asynchronous API
+void spi_master_transfer(spi_t *obj, const void *tx, size_t tx_length, void *rx, size_t rx_length, uint8_t bit_width, uint32_t handler, uint32_t event, DMAUsage hint)
+{
+    // TODO: DMA usage is currently ignored
+    (void) hint;
+
+    spi_start_transfer(obj, tx, tx_length, rx, rx_length, handler, event);
+}
+
+bool spi_slave_transfer(spi_t *obj, const void *tx, size_t tx_length, void *rx, size_t rx_length, uint8_t bit_width, uint32_t handler, uint32_t event, DMAUsage hint)
+{
+    // No SPI DMA support on STM32, the frames are moved by the SPI interrupt
+    (void) hint;
+
+    if (spi_active(obj)) {
+        return false;
     }
+
+    // The handle was set up for slave mode by spi_format, the HAL transfer
+    // functions are the same
+    return spi_start_transfer(obj, tx, tx_length, rx, rx_length, handler, event) > 0;
 }
 
 inline uint32_t spi_irq_handler_asynch(spi_t *obj)